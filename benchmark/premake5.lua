@@ -0,0 +1,20 @@
+minko.project.application "minko-benchmarks"
+	removeplatforms { "html5" }
+
+	files {
+		"src/**.hpp",
+		"src/**.cpp"
+	}
+	includedirs {
+		"src",
+		-- the baselines are read with the jsoncpp embedded in the framework
+		minko.sdk.path("/framework/lib/jsoncpp/src")
+	}
+	defines { "JSON_IS_AMALGAMATION" }
+
+	-- plugin
+	minko.plugin.enable("sdl")
+	minko.plugin.enable("serializer")
+
+	configuration { "linux" }
+		links { "pthread" }
@@ -0,0 +1,23 @@
+if minko.platform.supports("linux") then
+
+minko.project.application "minko-benchmark-scenes"
+
+	removeplatforms { "android", "ios", "win", "osx", "html5" }
+
+	files {
+		"src/**.hpp",
+		"src/**.cpp"
+	}
+	includedirs {
+		"src",
+		-- the report is written with the jsoncpp embedded in the framework
+		minko.sdk.path("/framework/lib/jsoncpp/src")
+	}
+	defines { "JSON_IS_AMALGAMATION" }
+
+	-- plugins
+	minko.plugin.enable("offscreen")
+	minko.plugin.enable("particles")
+	minko.plugin.enable("bullet")
+
+end
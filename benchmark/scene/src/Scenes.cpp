@@ -0,0 +1,312 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Scenes.hpp"
+
+#include "minko/component/Skinning.hpp"
+#include "minko/geometry/Skin.hpp"
+#include "minko/geometry/Bone.hpp"
+#include "minko/MinkoParticles.hpp"
+#include "minko/MinkoBullet.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::math;
+using namespace minko::scene;
+
+namespace
+{
+	const float PI_F = (float)PI;
+
+	// deterministic: every run places the same objects
+	float
+	random(uint& seed)
+	{
+		seed = seed * 1664525u + 1013904223u;
+
+		return (float)(seed >> 8) / (float)(1 << 24);
+	}
+
+	// 10k cubes with their own material: one draw call each
+	void
+	buildCubes(Node::Ptr root, file::AssetLibrary::Ptr assets)
+	{
+		const int size = 100;
+
+		for (int x = 0; x < size; ++x)
+			for (int z = 0; z < size; ++z)
+				root->addChild(Node::create()
+					->addComponent(Transform::create(
+						Matrix4x4::create()->appendTranslation((x - size / 2) * 1.5f, 0.f, (z - size / 2) * 1.5f)
+					))
+					->addComponent(Surface::create(
+						assets->geometry("cube"),
+						material::BasicMaterial::create()->diffuseColor(Color::hslaToRgba(x / (float)size, 1.f, .5f, 1.f)),
+						assets->effect("effect/Basic.effect")
+					))
+				);
+	}
+
+	void
+	addChildren(Node::Ptr parent, file::AssetLibrary::Ptr assets, uint depth)
+	{
+		const uint branching = 6;
+
+		for (uint i = 0; i < branching; ++i)
+		{
+			const auto angle = 2.f * PI_F * i / branching;
+			auto child = Node::create()->addComponent(Transform::create(
+				Matrix4x4::create()
+					->appendScale(.45f)
+					->appendTranslation(cosf(angle) * 2.f, .5f, sinf(angle) * 2.f)
+			));
+
+			parent->addChild(child);
+
+			// 1296 visible nodes at the 4th level, the 46656 leaves are only transforms
+			if (depth == 4)
+				child->addComponent(Surface::create(
+					assets->geometry("cube"),
+					material::BasicMaterial::create()->diffuseColor(0x3399ffff),
+					assets->effect("effect/Basic.effect")
+				));
+
+			if (depth < 6)
+				addChildren(child, assets, depth + 1);
+		}
+	}
+
+	// 55986 nodes, all moved every frame
+	void
+	buildHierarchy(Node::Ptr root, file::AssetLibrary::Ptr assets)
+	{
+		auto top = Node::create("top")->addComponent(Transform::create(Matrix4x4::create()->appendScale(20.f)));
+
+		root->addChild(top);
+		addChildren(top, assets, 1);
+	}
+
+	void
+	updateHierarchy(Node::Ptr root, uint frameId)
+	{
+		for (auto& child : root->children())
+			if (child->name() == "top")
+				for (auto& branch : child->children())
+					branch->component<Transform>()->matrix()->prependRotationY(.01f);
+	}
+
+	// 64 point lights over a floor of Phong spheres
+	void
+	buildLights(Node::Ptr root, file::AssetLibrary::Ptr assets)
+	{
+		const int	size	= 16;
+		uint		seed	= 64;
+
+		for (int x = 0; x < size; ++x)
+			for (int z = 0; z < size; ++z)
+				root->addChild(Node::create()
+					->addComponent(Transform::create(
+						Matrix4x4::create()->appendTranslation((x - size / 2) * 2.f, 0.f, (z - size / 2) * 2.f)
+					))
+					->addComponent(Surface::create(
+						assets->geometry("sphere"),
+						material::PhongMaterial::create()->shininess(16.f)->diffuseColor(0xccccccff),
+						assets->effect("effect/Phong.effect")
+					))
+				);
+
+		root->addChild(Node::create()->addComponent(AmbientLight::create(.1f)));
+
+		for (uint i = 0; i < 64; ++i)
+		{
+			auto light = PointLight::create(1.f, 1.f, 1.f, .2f, .05f);
+
+			light->color(Color::hslaToRgba(random(seed), 1.f, .5f, 1.f));
+			root->addChild(Node::create("light")
+				->addComponent(light)
+				->addComponent(Transform::create(Matrix4x4::create()->appendTranslation(
+					(random(seed) - .5f) * size * 2.f, 1.5f, (random(seed) - .5f) * size * 2.f
+				)))
+			);
+		}
+	}
+
+	void
+	updateLights(Node::Ptr root, uint frameId)
+	{
+		for (auto& child : root->children())
+			if (child->name() == "light")
+				child->component<Transform>()->matrix()->appendRotationY(.005f);
+	}
+
+	// a sphere bent by two bones, its upper half swinging back and forth
+	Skinning::Ptr
+	createSkinning(geometry::Geometry::Ptr geometry, render::AbstractContext::Ptr context)
+	{
+		const uint	numFrames	= 30;
+		const uint	duration	= 1000;
+		auto		positions	= geometry->vertexBuffer("position");
+		const auto	vertexSize	= positions->vertexSize();
+		const auto	offset		= std::get<2>(*positions->attribute("position"));
+		auto		skin		= geometry::Skin::create(2, duration, numFrames);
+
+		std::vector<uint> lowerVertexIds;
+		std::vector<uint> upperVertexIds;
+
+		for (uint i = 0; i < positions->numVertices(); ++i)
+			(positions->data()[i * vertexSize + offset + 1] < 0.f ? lowerVertexIds : upperVertexIds).push_back(i);
+
+		skin->bone(0, geometry::Bone::create(
+			Node::create(), Matrix4x4::create(), lowerVertexIds, std::vector<float>(lowerVertexIds.size(), 1.f)
+		));
+		skin->bone(1, geometry::Bone::create(
+			Node::create(), Matrix4x4::create(), upperVertexIds, std::vector<float>(upperVertexIds.size(), 1.f)
+		));
+
+		for (uint frameId = 0; frameId < numFrames; ++frameId)
+		{
+			skin->matrix(frameId, 0, Matrix4x4::create());
+			skin->matrix(frameId, 1, Matrix4x4::create()->appendRotationZ(sinf(2.f * PI_F * frameId / numFrames) * .5f));
+		}
+
+		skin->reorganizeByVertices()->transposeMatrices()->disposeBones();
+
+		return Skinning::create(skin, SkinningMethod::HARDWARE, context, std::vector<Animation::Ptr>());
+	}
+
+	// 100 hardware skinned characters
+	void
+	buildSkinning(Node::Ptr root, file::AssetLibrary::Ptr assets)
+	{
+		const int size = 10;
+
+		for (int x = 0; x < size; ++x)
+			for (int z = 0; z < size; ++z)
+			{
+				auto geometry = geometry::SphereGeometry::create(assets->context(), 24, 24);
+
+				root->addChild(Node::create()
+					->addComponent(Transform::create(
+						Matrix4x4::create()->appendTranslation((x - size / 2) * 2.f, 0.f, (z - size / 2) * 2.f)
+					))
+					->addComponent(Surface::create(
+						geometry,
+						material::BasicMaterial::create()->diffuseColor(0xff9933ff),
+						assets->effect("effect/Basic.effect")
+					))
+					->addComponent(createSkinning(geometry, assets->context()))
+				);
+			}
+	}
+
+	// 16384 particles, the maximum of a ParticleSystem, already emitted when the measures start
+	void
+	buildParticles(Node::Ptr root, file::AssetLibrary::Ptr assets)
+	{
+		auto particles = ParticleSystem::create(
+			assets,
+			8192.f,
+			particle::sampler::Constant<float>::create(2.f),
+			particle::shape::Sphere::create(2.f),
+			particle::StartDirection::UP,
+			particle::sampler::Constant<float>::create(1.f)
+		);
+
+		particles->countLimit(16384);
+		particles->material()->diffuseColor(0xffffffff);
+		particles
+			->add(particle::modifier::StartSize::create(particle::sampler::Constant<float>::create(.1f)))
+			->add(particle::modifier::SizeOverTime::create(
+				particle::sampler::LinearlyInterpolatedValue<float>::create(1.f, 3.f, 0.f, 1.f)
+			))
+			->play();
+		particles->fastForward(2.f, 60);
+
+		root->addChild(Node::create()->addComponent(Transform::create())->addComponent(particles));
+	}
+
+	// 2000 bodies falling on a static ground, with most of the pile resting by the end
+	void
+	buildPhysics(Node::Ptr root, file::AssetLibrary::Ptr assets)
+	{
+		uint seed = 2000;
+
+		root->addComponent(bullet::PhysicsWorld::create());
+
+		root->addChild(Node::create()
+			->addComponent(Transform::create(Matrix4x4::create()->appendScale(40.f, 1.f, 40.f)))
+			->addComponent(Surface::create(
+				assets->geometry("cube"),
+				material::BasicMaterial::create()->diffuseColor(0x555555ff),
+				assets->effect("effect/Basic.effect")
+			))
+			->addComponent(bullet::Collider::create(
+				bullet::ColliderData::create(0.f, bullet::BoxShape::create(20.f, .5f, 20.f))
+			))
+		);
+
+		for (uint i = 0; i < 2000; ++i)
+		{
+			const auto isCube = i % 2 == 0;
+			auto shape = isCube
+				? std::static_pointer_cast<bullet::AbstractPhysicsShape>(bullet::BoxShape::create(.25f, .25f, .25f))
+				: std::static_pointer_cast<bullet::AbstractPhysicsShape>(bullet::SphereShape::create(.25f));
+
+			root->addChild(Node::create()
+				->addComponent(Transform::create(
+					Matrix4x4::create()
+						->appendScale(.5f)
+						->appendTranslation(
+							(random(seed) - .5f) * 10.f, 2.f + (i / 100) * .6f, (random(seed) - .5f) * 10.f
+						)
+				))
+				->addComponent(Surface::create(
+					assets->geometry(isCube ? "cube" : "sphere"),
+					material::BasicMaterial::create()->diffuseColor(Color::hslaToRgba(random(seed), 1.f, .5f, 1.f)),
+					assets->effect("effect/Basic.effect")
+				))
+				->addComponent(bullet::Collider::create(bullet::ColliderData::create(1.f, shape)))
+			);
+		}
+	}
+}
+
+std::vector<std::string>
+benchmark::assets()
+{
+	return {
+		"effect/Basic.effect",
+		"effect/Phong.effect",
+		"effect/Particles.effect"
+	};
+}
+
+std::vector<benchmark::Scene>
+benchmark::scenes()
+{
+	return {
+		{ "cubes",		buildCubes,		nullptr,			150.f,	80.f },
+		{ "hierarchy",	buildHierarchy,	updateHierarchy,	80.f,	40.f },
+		{ "lights",		buildLights,	updateLights,		30.f,	15.f },
+		{ "skinning",	buildSkinning,	nullptr,			25.f,	10.f },
+		{ "particles",	buildParticles,	nullptr,			12.f,	4.f },
+		{ "physics",	buildPhysics,	nullptr,			30.f,	15.f }
+	};
+}
@@ -0,0 +1,47 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "minko/Minko.hpp"
+
+namespace benchmark
+{
+	// A scripted scene: built once, then driven frame by frame at a fixed time step along a fixed
+	// camera orbit, so that two runs render exactly the same frames.
+	struct Scene
+	{
+		typedef std::function<void(minko::scene::Node::Ptr, minko::file::AssetLibrary::Ptr)>	BuildFunction;
+		typedef std::function<void(minko::scene::Node::Ptr, minko::uint)>						UpdateFunction;
+
+		std::string		name;
+		BuildFunction	build;
+		UpdateFunction	update;			// optional, called before each frame with its index
+		float			cameraDistance;
+		float			cameraHeight;
+	};
+
+	// assets queued before the scenes are built
+	std::vector<std::string>
+	assets();
+
+	std::vector<Scene>
+	scenes();
+}
@@ -0,0 +1,212 @@
+#include "minko/Minko.hpp"
+#include "minko/MinkoOffscreen.hpp"
+
+#include "json/json.h"
+
+#include "Scenes.hpp"
+
+#include <iomanip>
+#include <numeric>
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::math;
+
+static const float FRAME_TIME = 1000.f / 60.f; // fixed time step, in milliseconds
+
+struct SceneResult
+{
+	std::vector<double>	frameTimes; // milliseconds, sorted
+	render::RenderStats	renderStats; // summed over the measured frames
+};
+
+static
+double
+percentile(const std::vector<double>& sortedValues, double p)
+{
+	if (sortedValues.empty())
+		return 0.;
+
+	return sortedValues[std::min(sortedValues.size() - 1, (size_t)(p * sortedValues.size()))];
+}
+
+static
+void
+addStats(render::RenderStats& sum, const render::RenderStats& value)
+{
+	sum.numDrawCalls += value.numDrawCalls;
+	sum.numTriangles += value.numTriangles;
+	sum.numProgramSwitches += value.numProgramSwitches;
+	sum.numTextureBinds += value.numTextureBinds;
+	sum.numBufferBinds += value.numBufferBinds;
+	sum.numUniformCalls += value.numUniformCalls;
+	sum.numFrameBufferSwitches += value.numFrameBufferSwitches;
+	sum.numBytesUploaded += value.numBytesUploaded;
+}
+
+static
+SceneResult
+runScene(const benchmark::Scene& scene, uint width, uint height, uint numWarmupFrames, uint numFrames)
+{
+	auto context		= MinkoOffscreen::context();
+	auto sceneManager	= SceneManager::create(context);
+
+	sceneManager->assets()
+		->geometry("cube", geometry::CubeGeometry::create(context))
+		->geometry("sphere", geometry::SphereGeometry::create(context, 16, 16));
+	for (auto& filename : benchmark::assets())
+		sceneManager->assets()->queue(filename);
+	sceneManager->assets()->load();
+
+	auto root	= scene::Node::create("root")->addComponent(sceneManager);
+	auto camera	= scene::Node::create("camera")
+		->addComponent(Renderer::create(0x7f7f7fff))
+		->addComponent(Transform::create())
+		->addComponent(PerspectiveCamera::create((float)width / (float)height, (float)PI * .25f, .1f, 1000.f));
+
+	root->addChild(camera);
+	scene.build(root, sceneManager->assets());
+
+	SceneResult		result;
+	unsigned char	pixel[4];
+
+	for (uint frameId = 0; frameId < numWarmupFrames + numFrames; ++frameId)
+	{
+		// one orbit around the scene over the measured frames
+		const auto angle = 2.f * (float)PI * frameId / numFrames;
+
+		camera->component<Transform>()->matrix()->lookAt(
+			Vector3::zero(),
+			Vector3::create(cosf(angle) * scene.cameraDistance, scene.cameraHeight, sinf(angle) * scene.cameraDistance)
+		);
+		if (scene.update)
+			scene.update(root, frameId);
+
+		const auto start = std::chrono::steady_clock::now();
+
+		sceneManager->nextFrame(frameId * FRAME_TIME, FRAME_TIME);
+		// reading a pixel back waits for the GPU to be done with the frame
+		context->readPixels(0, 0, 1, 1, pixel);
+
+		const auto end = std::chrono::steady_clock::now();
+
+		if (frameId < numWarmupFrames)
+			continue;
+
+		result.frameTimes.push_back(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() * 1e-3);
+		addStats(result.renderStats, sceneManager->renderStats());
+	}
+
+	std::sort(result.frameTimes.begin(), result.frameTimes.end());
+
+	return result;
+}
+
+static
+Json::Value
+toJSON(const std::string& name, const SceneResult& result)
+{
+	Json::Value	scene(Json::objectValue);
+	Json::Value	frameTime(Json::objectValue);
+	Json::Value	renderStats(Json::objectValue);
+	const auto	numFrames	= (double)std::max<size_t>(1, result.frameTimes.size());
+	const auto&	stats		= result.renderStats;
+
+	frameTime["mean"] = std::accumulate(result.frameTimes.begin(), result.frameTimes.end(), 0.) / numFrames;
+	frameTime["p50"] = percentile(result.frameTimes, .5);
+	frameTime["p90"] = percentile(result.frameTimes, .9);
+	frameTime["p99"] = percentile(result.frameTimes, .99);
+	frameTime["max"] = result.frameTimes.empty() ? 0. : result.frameTimes.back();
+
+	// per frame averages
+	renderStats["numDrawCalls"] = stats.numDrawCalls / numFrames;
+	renderStats["numTriangles"] = stats.numTriangles / numFrames;
+	renderStats["numProgramSwitches"] = stats.numProgramSwitches / numFrames;
+	renderStats["numTextureBinds"] = stats.numTextureBinds / numFrames;
+	renderStats["numBufferBinds"] = stats.numBufferBinds / numFrames;
+	renderStats["numUniformCalls"] = stats.numUniformCalls / numFrames;
+	renderStats["numFrameBufferSwitches"] = stats.numFrameBufferSwitches / numFrames;
+	renderStats["numBytesUploaded"] = stats.numBytesUploaded / numFrames;
+
+	scene["name"] = name;
+	scene["numFrames"] = (uint)result.frameTimes.size();
+	scene["frameTimeMs"] = frameTime;
+	scene["renderStats"] = renderStats;
+
+	return scene;
+}
+
+// minko-benchmark-scenes [--scene=name] [--frames=600] [--warmup=60] [--width=1280] [--height=720]
+//                        [--json=report.json]
+int main(int argc, char** argv)
+{
+	std::string	sceneFilter;
+	std::string	jsonFilename;
+	uint		numFrames		= 600;
+	uint		numWarmupFrames	= 60;
+	uint		width			= 1280;
+	uint		height			= 720;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string	arg		= argv[i];
+		const auto			equal	= arg.find('=');
+		const auto			key		= arg.substr(0, equal);
+		const auto			value	= equal == std::string::npos ? std::string() : arg.substr(equal + 1);
+
+		if (key == "--scene")
+			sceneFilter = value;
+		else if (key == "--frames")
+			numFrames = std::max(1, std::atoi(value.c_str()));
+		else if (key == "--warmup")
+			numWarmupFrames = std::atoi(value.c_str());
+		else if (key == "--width")
+			width = std::atoi(value.c_str());
+		else if (key == "--height")
+			height = std::atoi(value.c_str());
+		else if (key == "--json")
+			jsonFilename = value;
+		else
+		{
+			std::cerr << "unknown option: " << arg << std::endl;
+
+			return 1;
+		}
+	}
+
+	MinkoOffscreen::initialize("Minko Benchmark Scenes", width, height);
+
+	Json::Value report(Json::objectValue);
+	Json::Value scenes(Json::arrayValue);
+
+	report["width"] = width;
+	report["height"] = height;
+	report["driver"] = MinkoOffscreen::context()->driverInfo();
+
+	for (auto& scene : benchmark::scenes())
+	{
+		if (!sceneFilter.empty() && scene.name != sceneFilter)
+			continue;
+
+		auto result = runScene(scene, width, height, numWarmupFrames, numFrames);
+
+		scenes.append(toJSON(scene.name, result));
+
+		std::cout << std::left << std::setw(12) << scene.name << std::right << std::fixed << std::setprecision(2)
+			<< " p50 " << std::setw(8) << percentile(result.frameTimes, .5) << " ms"
+			<< " p90 " << std::setw(8) << percentile(result.frameTimes, .9) << " ms"
+			<< " p99 " << std::setw(8) << percentile(result.frameTimes, .99) << " ms"
+			<< std::setprecision(0)
+			<< " draw calls " << std::setw(7) << result.renderStats.numDrawCalls / (double)numFrames << std::endl;
+	}
+	report["scenes"] = scenes;
+
+	if (!jsonFilename.empty())
+	{
+		std::ofstream file(jsonFilename.c_str(), std::ios::out | std::ios::binary);
+
+		file << Json::StyledWriter().write(report);
+	}
+
+	return 0;
+}
@@ -0,0 +1,75 @@
+#include "minko/Minko.hpp"
+#include "minko/MinkoSDL.hpp"
+#include "minko/Benchmark.hpp"
+
+using namespace minko;
+
+// minko-benchmarks [--filter=name] [--min-time=ms] [--repetitions=n] [--json=output.json]
+//                  [--baseline=baseline.json] [--max-regression=0.1]
+int main(int argc, char **argv)
+{
+	std::string	filter;
+	std::string	jsonFilename;
+	std::string	baselineFilename;
+	double		maxRegression	= .1;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string	arg		= argv[i];
+		const auto			equal	= arg.find('=');
+		const auto			key		= arg.substr(0, equal);
+		const auto			value	= equal == std::string::npos ? std::string() : arg.substr(equal + 1);
+
+		if (key == "--filter")
+			filter = value;
+		else if (key == "--min-time")
+			Benchmark::minTime(std::atof(value.c_str()));
+		else if (key == "--repetitions")
+			Benchmark::repetitions(std::atoi(value.c_str()));
+		else if (key == "--json")
+			jsonFilename = value;
+		else if (key == "--baseline")
+			baselineFilename = value;
+		else if (key == "--max-regression")
+			maxRegression = std::atof(value.c_str());
+		else
+		{
+			std::cerr << "unknown option: " << arg << std::endl;
+
+			return 1;
+		}
+	}
+
+	auto canvas = Canvas::create("Minko Benchmarks", 640, 480);
+
+	Benchmark::context(canvas->context());
+
+	auto results = Benchmark::run(filter);
+
+	if (!jsonFilename.empty())
+	{
+		std::ofstream file(jsonFilename.c_str(), std::ios::out | std::ios::binary);
+
+		file << Benchmark::toJSON(results);
+	}
+
+	if (!baselineFilename.empty())
+	{
+		std::ifstream		file(baselineFilename.c_str(), std::ios::in | std::ios::binary);
+		std::stringstream	baseline;
+
+		if (!file.is_open())
+		{
+			std::cerr << "cannot open the baseline " << baselineFilename << std::endl;
+
+			return 1;
+		}
+
+		baseline << file.rdbuf();
+
+		if (!Benchmark::compare(results, baseline.str(), maxRegression))
+			return 2;
+	}
+
+	return 0;
+}
@@ -0,0 +1,182 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/Benchmark.hpp"
+
+#include "json/json.h"
+
+#include <iomanip>
+
+using namespace minko;
+
+double Benchmark::_minTime = 100.;
+uint Benchmark::_repetitions = 5;
+render::AbstractContext::Ptr Benchmark::_context = nullptr;
+
+#if defined(_MSC_VER)
+const void* volatile Benchmark::_sink = nullptr;
+#endif
+
+static const uint MAX_NUM_ITERATIONS = 1000000000;
+
+std::vector<std::pair<std::string, Benchmark::Function>>&
+Benchmark::benchmarks()
+{
+	// registered from static initializers: constructed on first use
+	static std::vector<std::pair<std::string, Function>> benchmarks;
+
+	return benchmarks;
+}
+
+bool
+Benchmark::add(const std::string& name, Function function)
+{
+	benchmarks().push_back(std::make_pair(name, function));
+
+	return true;
+}
+
+void
+Benchmark::repetitions(uint value)
+{
+	if (value == 0)
+		throw std::invalid_argument("value");
+
+	_repetitions = value;
+}
+
+double
+Benchmark::measure(Function function, uint iterations)
+{
+	State state(iterations);
+
+	function(state);
+
+	if (state.keepRunning())
+		throw std::logic_error("a benchmark must loop until State::keepRunning() returns false");
+
+	return state.elapsed();
+}
+
+std::vector<Benchmark::Result>
+Benchmark::run(const std::string& filter)
+{
+	std::vector<Result> results;
+
+	for (auto& benchmark : benchmarks())
+	{
+		if (benchmark.first.find(filter) == std::string::npos)
+			continue;
+
+		// grows the number of iterations until a run lasts at least minTime()
+		const auto	minTime		= _minTime * 1e6;
+		uint		iterations	= 1;
+		auto		elapsed		= measure(benchmark.second, iterations);
+
+		while (elapsed < minTime && iterations < MAX_NUM_ITERATIONS)
+		{
+			auto scale = elapsed > 0. ? minTime * 1.4 / elapsed : 10.;
+
+			iterations = (uint)std::min(
+				(double)MAX_NUM_ITERATIONS, iterations * std::max(2., std::min(scale, 10.))
+			);
+			elapsed = measure(benchmark.second, iterations);
+		}
+
+		std::vector<double> times(1, elapsed / iterations);
+
+		for (uint i = 1; i < _repetitions; ++i)
+			times.push_back(measure(benchmark.second, iterations) / iterations);
+		std::sort(times.begin(), times.end());
+
+		Result result;
+
+		result.name = benchmark.first;
+		result.iterations = iterations;
+		result.median = times[times.size() / 2];
+		result.min = times.front();
+		results.push_back(result);
+
+		std::cout << std::left << std::setw(48) << result.name << std::right
+			<< std::setw(12) << iterations << " iterations"
+			<< std::fixed << std::setprecision(1) << std::setw(14) << result.median << " ns"
+			<< std::setw(14) << result.min << " ns (min)" << std::endl;
+	}
+
+	return results;
+}
+
+std::string
+Benchmark::toJSON(const std::vector<Result>& results)
+{
+	Json::Value root(Json::objectValue);
+	Json::Value benchmarks(Json::arrayValue);
+
+	for (auto& result : results)
+	{
+		Json::Value benchmark(Json::objectValue);
+
+		benchmark["name"] = result.name;
+		benchmark["iterations"] = result.iterations;
+		benchmark["median_ns"] = result.median;
+		benchmark["min_ns"] = result.min;
+		benchmarks.append(benchmark);
+	}
+	root["benchmarks"] = benchmarks;
+
+	return Json::StyledWriter().write(root);
+}
+
+bool
+Benchmark::compare(const std::vector<Result>& results, const std::string& baseline, double maxRegression)
+{
+	Json::Value root;
+
+	if (!Json::Reader().parse(baseline, root, false) || !root.isMember("benchmarks"))
+		throw std::invalid_argument("baseline");
+
+	std::unordered_map<std::string, double> baselineTimes;
+
+	for (auto& benchmark : root["benchmarks"])
+		baselineTimes[benchmark["name"].asString()] = benchmark["median_ns"].asDouble();
+
+	auto success = true;
+
+	for (auto& result : results)
+	{
+		auto baselineIt = baselineTimes.find(result.name);
+
+		if (baselineIt == baselineTimes.end() || baselineIt->second <= 0.)
+			continue;
+
+		const auto change		= result.median / baselineIt->second - 1.;
+		const auto regression	= change > maxRegression;
+
+		std::cout << std::left << std::setw(48) << result.name << std::right
+			<< std::fixed << std::setprecision(1) << std::setw(14) << baselineIt->second << " ns ->"
+			<< std::setw(14) << result.median << " ns"
+			<< std::showpos << std::setw(10) << change * 100. << std::noshowpos << " %"
+			<< (regression ? "  REGRESSION" : "") << std::endl;
+
+		success = success && !regression;
+	}
+
+	return success;
+}
@@ -0,0 +1,201 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "minko/Minko.hpp"
+
+#define MINKO_BENCHMARK_CONCAT(a, b)	a ## b
+// registers a benchmark, its body times the iterations of a while (state.keepRunning()) loop
+#define MINKO_BENCHMARK(name)																	\
+	static void MINKO_BENCHMARK_CONCAT(name, Benchmark)(minko::Benchmark::State& state);			\
+	static const bool MINKO_BENCHMARK_CONCAT(name, Registered) =									\
+		minko::Benchmark::add(#name, &MINKO_BENCHMARK_CONCAT(name, Benchmark));					\
+	static void MINKO_BENCHMARK_CONCAT(name, Benchmark)(minko::Benchmark::State& state)
+
+namespace minko
+{
+	// Minimal microbenchmark harness: each benchmark is calibrated to run for at least minTime(),
+	// then repeated, and the median time per iteration is reported and compared to a baseline.
+	class Benchmark
+	{
+	public:
+		typedef std::chrono::steady_clock	Clock;
+
+		class State
+		{
+		private:
+			uint				_iterations;
+			uint				_remaining;
+			bool				_started;
+			Clock::time_point	_start;
+			Clock::time_point	_end;
+
+		public:
+			explicit
+			State(uint iterations) :
+				_iterations(iterations),
+				_remaining(iterations),
+				_started(false)
+			{
+			}
+
+			// the setup before the first call is not timed
+			inline
+			bool
+			keepRunning()
+			{
+				if (!_started)
+				{
+					_started = true;
+					_start = Clock::now();
+				}
+
+				if (_remaining == 0)
+				{
+					_end = Clock::now();
+
+					return false;
+				}
+
+				--_remaining;
+
+				return true;
+			}
+
+			inline
+			uint
+			iterations() const
+			{
+				return _iterations;
+			}
+
+			// in nanoseconds
+			inline
+			double
+			elapsed() const
+			{
+				return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(_end - _start).count();
+			}
+		};
+
+		typedef std::function<void(State&)>	Function;
+
+		struct Result
+		{
+			std::string	name;
+			uint		iterations;
+			double		median; // nanoseconds per iteration
+			double		min;
+		};
+
+	private:
+		static double							_minTime;
+		static uint								_repetitions;
+		static render::AbstractContext::Ptr		_context;
+
+	public:
+		// the context of the benchmarks creating GPU resources
+		inline static
+		render::AbstractContext::Ptr
+		context()
+		{
+			return _context;
+		}
+
+		inline static
+		void
+		context(render::AbstractContext::Ptr context)
+		{
+			_context = context;
+		}
+
+		static
+		bool
+		add(const std::string& name, Function function);
+
+		// in milliseconds
+		inline static
+		double
+		minTime()
+		{
+			return _minTime;
+		}
+
+		inline static
+		void
+		minTime(double value)
+		{
+			_minTime = value;
+		}
+
+		inline static
+		uint
+		repetitions()
+		{
+			return _repetitions;
+		}
+
+		static
+		void
+		repetitions(uint value);
+
+		// runs the benchmarks whose name contains the filter, in their registration order
+		static
+		std::vector<Result>
+		run(const std::string& filter = "");
+
+		static
+		std::string
+		toJSON(const std::vector<Result>& results);
+
+		// prints the relative change of each result present in the baseline written by toJSON(),
+		// returns false if any is slower by more than maxRegression (0.1 for 10%)
+		static
+		bool
+		compare(const std::vector<Result>& results, const std::string& baseline, double maxRegression);
+
+		// keeps the compiler from discarding a value computed for nothing but the benchmark
+		template <typename T>
+		inline static
+		void
+		doNotOptimize(const T& value)
+		{
+#if defined(_MSC_VER)
+			_sink = &value;
+#else
+			asm volatile("" : : "g"(&value) : "memory");
+#endif
+		}
+
+	private:
+#if defined(_MSC_VER)
+		static const void* volatile _sink;
+#endif
+
+		static
+		std::vector<std::pair<std::string, Function>>&
+		benchmarks();
+
+		static
+		double
+		measure(Function function, uint iterations);
+	};
+}
@@ -0,0 +1,55 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/Benchmark.hpp"
+
+using namespace minko;
+
+static
+void
+executeSignal(Benchmark::State& state, uint numSlots)
+{
+	auto								signal	= Signal<int>::create();
+	std::vector<Signal<int>::Slot>		slots;
+	int									sum		= 0;
+
+	for (uint i = 0; i < numSlots; ++i)
+		slots.push_back(signal->connect([&](int value) { sum += value; }));
+
+	while (state.keepRunning())
+		signal->execute(1);
+
+	Benchmark::doNotOptimize(sum);
+}
+
+MINKO_BENCHMARK(SignalExecute1Slot)
+{
+	executeSignal(state, 1);
+}
+
+MINKO_BENCHMARK(SignalExecute16Slots)
+{
+	executeSignal(state, 16);
+}
+
+MINKO_BENCHMARK(SignalExecute256Slots)
+{
+	executeSignal(state, 256);
+}
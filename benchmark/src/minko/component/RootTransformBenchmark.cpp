@@ -0,0 +1,81 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/Benchmark.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::scene;
+
+static
+void
+addChildren(Node::Ptr parent, uint branching, uint depth)
+{
+	if (depth == 0)
+		return;
+
+	for (uint i = 0; i < branching; ++i)
+	{
+		auto child = Node::create()->addComponent(Transform::create());
+
+		child->component<Transform>()->matrix()->appendTranslation((float)i, 0.f, 1.f);
+		parent->addChild(child);
+		addChildren(child, branching, depth - 1);
+	}
+}
+
+// SceneManager::nextFrame() without any renderer is mostly RootTransform::updateTransforms()
+static
+void
+updateTransforms(Benchmark::State& state, uint branching, uint depth, bool moveRoot)
+{
+	auto sceneManager	= SceneManager::create(Benchmark::context());
+	auto root			= Node::create()->addComponent(sceneManager);
+	auto top			= Node::create()->addComponent(Transform::create());
+
+	root->addChild(top);
+	addChildren(top, branching, depth);
+	sceneManager->nextFrame(0.f, 0.f);
+
+	auto matrix = top->component<Transform>()->matrix();
+
+	while (state.keepRunning())
+	{
+		if (moveRoot)
+			matrix->appendTranslation(.1f);
+		sceneManager->nextFrame(0.f, 0.f);
+	}
+}
+
+// 5461 nodes
+MINKO_BENCHMARK(RootTransformUpdateWideHierarchy)
+{
+	updateTransforms(state, 4, 6, true);
+}
+
+MINKO_BENCHMARK(RootTransformUpdateDeepHierarchy)
+{
+	updateTransforms(state, 2, 12, true);
+}
+
+MINKO_BENCHMARK(RootTransformUpdateStaticHierarchy)
+{
+	updateTransforms(state, 4, 6, false);
+}
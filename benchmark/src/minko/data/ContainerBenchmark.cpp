@@ -0,0 +1,74 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/Benchmark.hpp"
+
+using namespace minko;
+using namespace minko::data;
+
+static const uint NUM_PROPERTIES = 32;
+
+static
+Container::Ptr
+createContainer(Provider::Ptr provider)
+{
+	auto container = Container::create();
+
+	for (uint i = 0; i < NUM_PROPERTIES; ++i)
+		provider->set("property" + std::to_string(i), (float)i);
+	container->addProvider(provider);
+
+	return container;
+}
+
+MINKO_BENCHMARK(ProviderSet)
+{
+	auto	provider	= Provider::create();
+	auto	container	= createContainer(provider);
+	float	value		= 0.f;
+
+	while (state.keepRunning())
+		provider->set("property7", value += 1.f);
+
+	Benchmark::doNotOptimize(container);
+}
+
+MINKO_BENCHMARK(ContainerGetByName)
+{
+	auto	container	= createContainer(Provider::create());
+	float	sum			= 0.f;
+
+	while (state.keepRunning())
+		sum += container->get<float>("property7");
+
+	Benchmark::doNotOptimize(sum);
+}
+
+MINKO_BENCHMARK(ContainerGetById)
+{
+	auto		container	= createContainer(Provider::create());
+	const auto	propertyId	= PropertyName::id("property7");
+	float		sum			= 0.f;
+
+	while (state.keepRunning())
+		sum += container->get<float>(propertyId);
+
+	Benchmark::doNotOptimize(sum);
+}
@@ -0,0 +1,64 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/Benchmark.hpp"
+
+using namespace minko;
+using namespace minko::geometry;
+using namespace minko::math;
+
+MINKO_BENCHMARK(GeometryCast)
+{
+	auto	geometry	= SphereGeometry::create(Benchmark::context(), 64, 64);
+	auto	ray			= Ray::create(Vector3::create(.1f, .2f, -5.f), Vector3::create(0.f, 0.f, 1.f));
+	float	distance	= 0.f;
+	uint	triangle	= 0;
+	uint	numHits		= 0;
+
+	// builds the BVH out of the timed loop
+	geometry->cast(ray, distance, triangle);
+
+	while (state.keepRunning())
+		numHits += geometry->cast(ray, distance, triangle);
+
+	Benchmark::doNotOptimize(numHits);
+}
+
+MINKO_BENCHMARK(GeometryCastBatch)
+{
+	auto							geometry	= SphereGeometry::create(Benchmark::context(), 64, 64);
+	std::vector<Ray::Ptr>			rays;
+	std::vector<float>				distances;
+	std::vector<int>				triangles;
+
+	for (uint i = 0; i < 64; ++i)
+		rays.push_back(Ray::create(
+			Vector3::create((float)(i % 8) * .1f - .4f, (float)(i / 8) * .1f - .4f, -5.f),
+			Vector3::create(0.f, 0.f, 1.f)
+		));
+	geometry->cast(rays, distances, triangles);
+
+	uint numHits = 0;
+
+	while (state.keepRunning())
+		numHits += geometry->cast(rays, distances, triangles);
+
+	Benchmark::doNotOptimize(numHits);
+}
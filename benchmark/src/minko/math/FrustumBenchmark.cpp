@@ -0,0 +1,109 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/Benchmark.hpp"
+
+using namespace minko;
+using namespace minko::math;
+
+static const uint NUM_BOXES = 1024;
+
+static
+float
+randomCoordinate()
+{
+	return (float)rand() / (float)RAND_MAX * 200.f - 100.f;
+}
+
+static
+Frustum::Ptr
+createFrustum()
+{
+	auto frustum = Frustum::create();
+
+	frustum->updateFromMatrix(
+		Matrix4x4::create()
+			->view(Vector3::create(0.f, 0.f, -5.f), Vector3::create(0.3f, 0.f, 0.f))
+			->append(Matrix4x4::create()->perspective(.8f, 1.3f, .1f, 100.f))
+	);
+
+	return frustum;
+}
+
+MINKO_BENCHMARK(FrustumTestBoundingBox)
+{
+	auto						frustum	= createFrustum();
+	std::vector<Box::Ptr>		boxes;
+
+	for (uint i = 0; i < NUM_BOXES; ++i)
+	{
+		auto center = Vector3::create(randomCoordinate(), randomCoordinate(), randomCoordinate());
+
+		boxes.push_back(Box::create(
+			Vector3::create(center->x() + 1.f, center->y() + 1.f, center->z() + 1.f),
+			Vector3::create(center->x() - 1.f, center->y() - 1.f, center->z() - 1.f)
+		));
+	}
+
+	uint numInside = 0;
+
+	while (state.keepRunning())
+		for (auto& box : boxes)
+		{
+			const auto position = frustum->testBoundingBox(box);
+
+			numInside += position == ShapePosition::INSIDE || position == ShapePosition::AROUND;
+		}
+
+	Benchmark::doNotOptimize(numInside);
+}
+
+MINKO_BENCHMARK(FrustumTestBoundingBoxes)
+{
+	auto								frustum	= createFrustum();
+	std::array<std::vector<float>, 6>	bounds;
+	std::vector<uint>					visibility;
+
+	for (auto& b : bounds)
+		b.resize(NUM_BOXES);
+
+	for (uint i = 0; i < NUM_BOXES; ++i)
+	{
+		auto x = randomCoordinate();
+		auto y = randomCoordinate();
+		auto z = randomCoordinate();
+
+		bounds[0][i] = x - 1.f;
+		bounds[1][i] = y - 1.f;
+		bounds[2][i] = z - 1.f;
+		bounds[3][i] = x + 1.f;
+		bounds[4][i] = y + 1.f;
+		bounds[5][i] = z + 1.f;
+	}
+
+	while (state.keepRunning())
+		frustum->testBoundingBoxes(
+			&bounds[0][0], &bounds[1][0], &bounds[2][0], &bounds[3][0], &bounds[4][0], &bounds[5][0],
+			NUM_BOXES,
+			visibility
+		);
+
+	Benchmark::doNotOptimize(visibility);
+}
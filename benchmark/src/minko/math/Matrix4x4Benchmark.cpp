@@ -0,0 +1,45 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/Benchmark.hpp"
+
+using namespace minko;
+using namespace minko::math;
+
+MINKO_BENCHMARK(Matrix4x4Append)
+{
+	auto a = Matrix4x4::create()->appendRotationY(.3f)->appendTranslation(1.f, 2.f, 3.f);
+	auto b = Matrix4x4::create()->appendRotationX(.1f);
+
+	while (state.keepRunning())
+		a->append(b);
+
+	Benchmark::doNotOptimize(a->data());
+}
+
+MINKO_BENCHMARK(Matrix4x4Invert)
+{
+	auto a = Matrix4x4::create()->appendRotationY(.3f)->appendScale(2.f, 2.f, 2.f)->appendTranslation(1.f, 2.f, 3.f);
+
+	while (state.keepRunning())
+		a->invert();
+
+	Benchmark::doNotOptimize(a->data());
+}
@@ -0,0 +1,124 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/Benchmark.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::math;
+using namespace minko::scene;
+
+static const uint NUM_NODES = 1024;
+
+static
+float
+randomCoordinate()
+{
+	return (float)rand() / (float)RAND_MAX * 40.f - 20.f;
+}
+
+static
+std::vector<Node::Ptr>
+createNodes(Node::Ptr root)
+{
+	std::vector<Node::Ptr> nodes;
+
+	for (uint i = 0; i < NUM_NODES; ++i)
+	{
+		auto node = Node::create()
+			->addComponent(Transform::create())
+			->addComponent(BoundingBox::create(1.f, Vector3::create(0.f, 0.f, 0.f)));
+
+		node->component<Transform>()->matrix()->appendTranslation(
+			randomCoordinate(), randomCoordinate(), randomCoordinate()
+		);
+		root->addChild(node);
+		nodes.push_back(node);
+	}
+
+	return nodes;
+}
+
+MINKO_BENCHMARK(OctTreeInsert)
+{
+	auto sceneManager	= SceneManager::create(Benchmark::context());
+	auto root			= Node::create()->addComponent(sceneManager);
+	auto nodes			= createNodes(root);
+
+	sceneManager->nextFrame(0.f, 0.f);
+
+	while (state.keepRunning())
+	{
+		auto octTree = OctTree::create(50, 7, Vector3::create(0.f, 0.f, 0.f), 0, true);
+
+		for (auto& node : nodes)
+			octTree->insert(node);
+
+		Benchmark::doNotOptimize(octTree);
+	}
+}
+
+MINKO_BENCHMARK(OctTreeTestFrustum)
+{
+	auto sceneManager	= SceneManager::create(Benchmark::context());
+	auto root			= Node::create()->addComponent(sceneManager);
+	auto nodes			= createNodes(root);
+	auto octTree		= OctTree::create(50, 7, Vector3::create(0.f, 0.f, 0.f), 0, true);
+	auto frustum		= Frustum::create();
+
+	sceneManager->nextFrame(0.f, 0.f);
+	for (auto& node : nodes)
+		octTree->insert(node);
+
+	frustum->updateFromMatrix(
+		Matrix4x4::create()
+			->view(Vector3::create(0.f, 0.f, -30.f), Vector3::create(0.f, 0.f, 0.f))
+			->append(Matrix4x4::create()->perspective(.8f, 1.3f, .1f, 100.f))
+	);
+
+	uint numVisible = 0;
+
+	while (state.keepRunning())
+		numVisible += octTree->testFrustum(frustum);
+
+	Benchmark::doNotOptimize(numVisible);
+}
+
+MINKO_BENCHMARK(OctTreeTestRay)
+{
+	auto									sceneManager	= SceneManager::create(Benchmark::context());
+	auto									root			= Node::create()->addComponent(sceneManager);
+	auto									nodes			= createNodes(root);
+	auto									octTree			= OctTree::create(50, 7, Vector3::create(0.f, 0.f, 0.f), 0, true);
+	auto									ray				= Ray::create(Vector3::create(0.f, 0.f, -30.f), Vector3::create(0.f, 0.f, 1.f));
+	std::vector<std::pair<float, Node::Ptr>>	hits;
+
+	sceneManager->nextFrame(0.f, 0.f);
+	for (auto& node : nodes)
+		octTree->insert(node);
+
+	while (state.keepRunning())
+	{
+		hits.clear();
+		octTree->testRay(ray, hits);
+	}
+
+	Benchmark::doNotOptimize(hits);
+}
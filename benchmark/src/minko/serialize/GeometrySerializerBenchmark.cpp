@@ -0,0 +1,75 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/Benchmark.hpp"
+#include "minko/file/GeometryParser.hpp"
+#include "minko/file/GeometryWriter.hpp"
+#include "minko/file/Options.hpp"
+#include "minko/file/Dependency.hpp"
+
+using namespace minko;
+
+static
+std::vector<unsigned char>
+pack(file::GeometryWriter::Ptr writer, file::AssetLibrary::Ptr assetLibrary, file::Options::Ptr options)
+{
+	const auto packed = writer->serialize(assetLibrary, options);
+
+	return std::vector<unsigned char>(packed.begin(), packed.end());
+}
+
+MINKO_BENCHMARK(GeometrySerialization)
+{
+	auto geometry		= geometry::SphereGeometry::create(Benchmark::context(), 64, 64);
+	auto assetLibrary	= file::AssetLibrary::create(Benchmark::context());
+	auto options		= file::Options::create(Benchmark::context());
+	auto writer			= file::GeometryWriter::create();
+
+	assetLibrary->geometry("sphere", geometry);
+	writer->data(geometry);
+
+	size_t size = 0;
+
+	while (state.keepRunning())
+		size += pack(writer, assetLibrary, options).size();
+
+	Benchmark::doNotOptimize(size);
+}
+
+MINKO_BENCHMARK(GeometryDeserialization)
+{
+	auto geometry		= geometry::SphereGeometry::create(Benchmark::context(), 64, 64);
+	auto assetLibrary	= file::AssetLibrary::create(Benchmark::context());
+	auto options		= file::Options::create(Benchmark::context());
+	auto writer			= file::GeometryWriter::create();
+
+	assetLibrary->geometry("sphere", geometry);
+	writer->data(geometry);
+
+	auto data = pack(writer, assetLibrary, options);
+
+	while (state.keepRunning())
+	{
+		auto outputAssetLibrary = file::AssetLibrary::create(Benchmark::context());
+
+		file::GeometryParser::create()->parse("sphere", "sphere", options, data, outputAssetLibrary);
+		Benchmark::doNotOptimize(outputAssetLibrary);
+	}
+}
@@ -9,9 +9,18 @@
 attribute vec3 position;
 attribute vec2 uv;
 
+#ifdef INSTANCING
+attribute mat4 instanceModelToWorldMatrix;
+#endif
+
 uniform mat4 modelToWorldMatrix;
 uniform mat4 worldToScreenMatrix;
 
+#ifdef DIFFUSE_MAP_UV_RECT
+// offset and scale of the diffuse map in a texture atlas
+uniform vec4 diffuseMapUVRect;
+#endif
+
 varying vec2 vertexUV;
 varying vec3 vertexUVW;
 
@@ -19,6 +28,9 @@ void main(void)
 {
 	#ifdef DIFFUSE_MAP
 		vertexUV = uv;
+		#ifdef DIFFUSE_MAP_UV_RECT
+			vertexUV = diffuseMapUVRect.xy + vertexUV * diffuseMapUVRect.zw;
+		#endif
 	#endif
 
 	#ifdef DIFFUSE_CUBEMAP
@@ -31,7 +43,10 @@ void main(void)
 		pos = skinning_moveVertex(pos);
 	#endif // NUM_BONES
 	
-	#ifdef MODEL_TO_WORLD
+	#if defined(INSTANCING) && defined(MODEL_TO_WORLD)
+		// per-instance matrices are stored row-major
+		pos = pos * instanceModelToWorldMatrix;
+	#elif defined(MODEL_TO_WORLD)
 		pos = modelToWorldMatrix * pos;
 	#endif
 	
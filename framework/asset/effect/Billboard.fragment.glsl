@@ -0,0 +1,34 @@
+#ifdef FRAGMENT_SHADER
+
+#ifdef GL_ES
+	precision mediump float;
+#endif
+
+varying vec4 vColor;
+
+#ifdef DIFFUSE_MAP
+	uniform sampler2D uDiffuseMap;
+	
+	varying vec2 vUV;
+#endif
+
+#ifdef DIFFUSE_TINT
+	uniform vec4 uDiffuseTint;
+#endif
+
+void main()
+{
+	vec4 diffuse = vColor;
+	
+	#ifdef DIFFUSE_MAP
+		diffuse *= texture2D(uDiffuseMap, vUV);
+	#endif
+	
+	#ifdef DIFFUSE_TINT
+		diffuse *= uDiffuseTint;
+	#endif
+	
+	gl_FragColor = diffuse;
+}
+
+#endif
@@ -0,0 +1,39 @@
+#ifdef VERTEX_SHADER
+
+#ifdef GL_ES
+	precision mediump float;
+#endif
+
+attribute vec3 	aPosition;
+attribute vec2 	aOffset;
+attribute vec4 	aColor;
+
+uniform mat4 	uModelToWorldMatrix;
+uniform mat4	uViewMatrix;
+uniform mat4	uProjectionMatrix;
+
+varying vec4 	vColor;
+
+#ifdef DIFFUSE_MAP
+	attribute vec2 aUV;
+
+	varying vec2 vUV;
+#endif
+
+void main()
+{
+	vec4 pos = uViewMatrix * uModelToWorldMatrix * vec4(aPosition, 1.);
+
+	// the corners are moved in view space for the quad to face the camera
+	pos.xy += aOffset;
+
+	vColor = aColor;
+
+	#ifdef DIFFUSE_MAP
+		vUV = aUV;
+	#endif
+
+	gl_Position = uProjectionMatrix * pos;
+}
+
+#endif
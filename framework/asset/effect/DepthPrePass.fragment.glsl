@@ -0,0 +1,12 @@
+#ifdef FRAGMENT_SHADER
+
+#ifdef GL_ES
+	precision mediump float;
+#endif
+
+void main(void)
+{
+	gl_FragColor = vec4(0.0);
+}
+
+#endif // FRAGMENT_SHADER
@@ -0,0 +1,30 @@
+#ifdef VERTEX_SHADER
+
+#ifdef GL_ES
+	precision highp float;
+#endif
+
+#pragma include("Skinning.function.glsl")
+
+attribute vec3 position;
+
+uniform mat4 modelToWorldMatrix;
+uniform mat4 worldToScreenMatrix;
+
+void main(void)
+{
+	vec4 pos = vec4(position, 1.0);
+
+	#ifdef NUM_BONES
+		pos = skinning_moveVertex(pos);
+	#endif // NUM_BONES
+	
+	// same transforms as Basic.vertex.glsl and Phong.vertex.glsl for the depths to match
+	#ifdef MODEL_TO_WORLD
+		pos = modelToWorldMatrix * pos;
+	#endif // MODEL_TO_WORLD
+	
+	gl_Position = worldToScreenMatrix * pos;
+}
+
+#endif // VERTEX_SHADER
@@ -0,0 +1,16 @@
+#ifdef FRAGMENT_SHADER
+
+#ifdef GL_ES
+	precision mediump float;
+#endif
+
+uniform sampler2D colorTexture;
+
+varying vec2 vertexUV;
+
+void main(void)
+{
+	gl_FragColor = texture2D(colorTexture, vertexUV);
+}
+
+#endif // FRAGMENT_SHADER
@@ -0,0 +1,23 @@
+#ifdef VERTEX_SHADER
+
+#ifdef GL_ES
+	precision highp float;
+#endif
+
+attribute vec3 position;
+attribute vec2 uv;
+
+// part of the offscreen target rendered at the current scale
+uniform vec2 uvScale;
+
+varying vec2 vertexUV;
+
+void main(void)
+{
+	vertexUV = vec2(uv.x, 1.0 - uv.y) * uvScale;
+
+	// the quad is centered and 1 unit wide
+	gl_Position = vec4(position.xy * 2.0, 0.0, 1.0);
+}
+
+#endif // VERTEX_SHADER
@@ -0,0 +1,136 @@
+#ifdef CLUSTERED_LIGHTS
+
+// the half floats and the light offsets need more than mediump
+#if defined(GL_ES) && defined(GL_FRAGMENT_PRECISION_HIGH)
+	#define LIGHT_CLUSTERS_HIGHP highp
+#else
+	#define LIGHT_CLUSTERS_HIGHP
+#endif
+
+// same as ClusteredLighting::MAX_NUM_LIGHTS_PER_CLUSTER
+#define LIGHT_CLUSTERS_MAX_LIGHTS 32
+
+uniform sampler2D	lightClustersMap;
+uniform sampler2D	lightClustersIndices;
+uniform sampler2D	lightClustersLights;
+uniform vec3		lightClustersGrid;			// tiles along x and y, depth slices
+uniform vec4		lightClustersProjection;	// x and y scales, z near, slices / log(z far / z near)
+uniform vec4		lightClustersTextureSizes;	// indices width and height, lights width and height
+uniform mat4		viewMatrix;
+
+LIGHT_CLUSTERS_HIGHP float
+lightClusters_unpackShort(vec2 bytes)
+{
+	return floor(bytes.x * 255.0 + 0.5) + floor(bytes.y * 255.0 + 0.5) * 256.0;
+}
+
+// same encoding as ClusteredLighting::packHalf(), high byte first
+LIGHT_CLUSTERS_HIGHP float
+lightClusters_unpackHalf(vec2 bytes)
+{
+	LIGHT_CLUSTERS_HIGHP float high		= floor(bytes.x * 255.0 + 0.5);
+	LIGHT_CLUSTERS_HIGHP float low		= floor(bytes.y * 255.0 + 0.5);
+	LIGHT_CLUSTERS_HIGHP float sign		= high >= 128.0 ? -1.0 : 1.0;
+	LIGHT_CLUSTERS_HIGHP float exponent	= mod(floor(high / 4.0), 32.0);
+	LIGHT_CLUSTERS_HIGHP float mantissa	= mod(high, 4.0) * 256.0 + low;
+
+	return exponent == 0.0
+		? sign * mantissa * exp2(-24.0)
+		: sign * (1.0 + mantissa / 1024.0) * exp2(exponent - 15.0);
+}
+
+LIGHT_CLUSTERS_HIGHP vec2
+lightClusters_lightRow(LIGHT_CLUSTERS_HIGHP float lightIndex, float row)
+{
+	vec4 texel = texture2D(lightClustersLights, vec2(
+		(lightIndex + 0.5) / lightClustersTextureSizes.z,
+		(row + 0.5) / lightClustersTextureSizes.w
+	));
+
+	return vec2(lightClusters_unpackHalf(texel.rg), lightClusters_unpackHalf(texel.ba));
+}
+
+void
+lightClusters_accumulate(vec3		position,
+						 vec3		normal,
+						 vec3		eyePosition,
+						 vec3		eyeVector,
+						 vec3		specularColor,
+						 float		shininessCoeff,
+						 inout vec3	diffuseAccum,
+						 inout vec3	specularAccum)
+{
+	LIGHT_CLUSTERS_HIGHP vec4	viewPosition	= viewMatrix * vec4(position, 1.0);
+	LIGHT_CLUSTERS_HIGHP float	depth			= max(-viewPosition.z, lightClustersProjection.z);
+	vec2						ndc				= viewPosition.xy * lightClustersProjection.xy / depth;
+	vec2						tile			= clamp(floor((ndc * 0.5 + 0.5) * lightClustersGrid.xy), vec2(0.0), lightClustersGrid.xy - 1.0);
+	float						slice			= clamp(floor(log(depth / lightClustersProjection.z) * lightClustersProjection.w), 0.0, lightClustersGrid.z - 1.0);
+	vec4						cluster			= texture2D(lightClustersMap, vec2(
+		(tile.x + tile.y * lightClustersGrid.x + 0.5) / (lightClustersGrid.x * lightClustersGrid.y),
+		(slice + 0.5) / lightClustersGrid.z
+	));
+	LIGHT_CLUSTERS_HIGHP float	offset			= lightClusters_unpackShort(cluster.rg);
+	float						numLights		= floor(cluster.b * 255.0 + 0.5);
+
+	for (int i = 0; i < LIGHT_CLUSTERS_MAX_LIGHTS; ++i)
+	{
+		if (float(i) >= numLights)
+			break;
+
+		LIGHT_CLUSTERS_HIGHP float	entry		= offset + float(i);
+		vec4						index		= texture2D(lightClustersIndices, vec2(
+			(mod(entry, lightClustersTextureSizes.x) + 0.5) / lightClustersTextureSizes.x,
+			(floor(entry / lightClustersTextureSizes.x) + 0.5) / lightClustersTextureSizes.y
+		));
+		LIGHT_CLUSTERS_HIGHP float	lightIndex	= lightClusters_unpackShort(index.rg);
+
+		LIGHT_CLUSTERS_HIGHP vec2	positionXY			= lightClusters_lightRow(lightIndex, 0.0);
+		LIGHT_CLUSTERS_HIGHP vec2	positionZDiffuse	= lightClusters_lightRow(lightIndex, 1.0);
+		vec2						specularConstant	= lightClusters_lightRow(lightIndex, 2.0);
+		vec2						linearQuadratic		= lightClusters_lightRow(lightIndex, 3.0);
+		vec2						colorRG				= lightClusters_lightRow(lightIndex, 4.0);
+		vec2						colorBType			= lightClusters_lightRow(lightIndex, 5.0);
+
+		vec3	lightColor				= vec3(colorRG, colorBType.x);
+		vec3	lightAttenuationCoeffs	= vec3(specularConstant.y, linearQuadratic);
+		vec3	lightDirection			= eyePosition + vec3(positionXY, positionZDiffuse.x) - position;
+		float	distanceToLight			= length(lightDirection);
+
+		lightDirection /= distanceToLight;
+
+		vec3	distVec		= vec3(1.0, distanceToLight, distanceToLight * distanceToLight);
+		float	attenuation	= any(lessThan(lightAttenuationCoeffs, vec3(0.0)))
+			? 1.0
+			: max(0.0, 1.0 - distanceToLight / dot(lightAttenuationCoeffs, distVec));
+
+		// spot lights, same cone as in Phong.fragment.glsl
+		if (colorBType.y > 0.5)
+		{
+			vec2	directionXY			= lightClusters_lightRow(lightIndex, 6.0);
+			vec2	directionZInner		= lightClusters_lightRow(lightIndex, 7.0);
+			float	lightCosOuterAng	= lightClusters_lightRow(lightIndex, 8.0).x;
+			float	lightCosInnerAng	= directionZInner.y;
+			float	cosSpot				= dot(-lightDirection, normalize(-vec3(directionXY, directionZInner.x)));
+
+			attenuation *= lightCosOuterAng < cosSpot
+				? (cosSpot < lightCosInnerAng && lightCosOuterAng < lightCosInnerAng
+					? (cosSpot - lightCosOuterAng) / (lightCosInnerAng - lightCosOuterAng)
+					: 1.0)
+				: 0.0;
+		}
+
+		diffuseAccum	+= phong_diffuseReflection(normal, lightDirection)
+			* lightColor
+			* (positionZDiffuse.y * attenuation);
+
+		#ifdef SHININESS
+			specularAccum	+=
+				phong_specularReflection(normal, lightDirection, eyeVector, shininessCoeff)
+				* phong_fresnel(specularColor, lightDirection, eyeVector)
+				* lightColor
+				* (specularConstant.x * attenuation);
+		#endif // SHININESS
+	}
+}
+
+#endif // CLUSTERED_LIGHTS
@@ -7,12 +7,33 @@
 #pragma include("Phong.function.glsl")
 #pragma include("Envmap.function.glsl")
 #pragma include("Fog.function.glsl")
+#pragma include("LightClusters.function.glsl")
+#pragma include("ShadowMapping.function.glsl")
 
 #ifdef PRECOMPUTED_AMBIENT
 	uniform vec3 sumAmbients;
 #endif // PRECOMPUTED_AMBIENT
 
-#ifndef MINKO_NO_GLSL_STRUCT
+#if defined(PACKED_LIGHTS)
+
+	// see LightPacking for the layout of the vec4s of each light
+	#ifdef NUM_AMBIENT_LIGHTS
+		uniform vec4	packedAmbientLights[NUM_AMBIENT_LIGHTS];
+	#endif // NUM_AMBIENT_LIGHTS
+
+	#ifdef NUM_DIRECTIONAL_LIGHTS
+		uniform vec4	packedDirectionalLights[NUM_DIRECTIONAL_LIGHTS * 2];
+	#endif // NUM_DIRECTIONAL_LIGHTS
+
+	#ifdef NUM_POINT_LIGHTS
+		uniform vec4	packedPointLights[NUM_POINT_LIGHTS * 3];
+	#endif // NUM_POINT_LIGHTS
+
+	#ifdef NUM_SPOT_LIGHTS
+		uniform vec4	packedSpotLights[NUM_SPOT_LIGHTS * 4];
+	#endif // NUM_SPOT_LIGHTS
+
+#elif !defined(MINKO_NO_GLSL_STRUCT)
 
 	#pragma include("Phong.struct.glsl")
 
@@ -65,7 +86,7 @@
 		uniform float	spotLights_cosOuterConeAngle[NUM_SPOT_LIGHTS];
 	#endif // NUM_SPOT_LIGHTS
 	
-#endif // MINKO_NO_GLSL_STRUCT
+#endif // PACKED_LIGHTS
 	
 // diffuse
 uniform vec4 		diffuseColor;
@@ -135,24 +156,26 @@ void main(void)
 		#ifdef NUM_AMBIENT_LIGHTS
 			for (int i = 0; i < NUM_AMBIENT_LIGHTS; ++i)
 			{
-				#ifndef MINKO_NO_GLSL_STRUCT
+				#if defined(PACKED_LIGHTS)
+					ambientAccum	+= packedAmbientLights[i].rgb * packedAmbientLights[i].a;
+				#elif !defined(MINKO_NO_GLSL_STRUCT)
 					ambientAccum 	+= ambientLights[i].color * ambientLights[i].ambient;
 				#else
 					ambientAccum	+= ambientLights_color[i] * ambientLights_ambient[i];
-				#endif // MINKO_NO_GLSL_STRUCT
+				#endif // PACKED_LIGHTS
 			}
 		#endif // NUM_AMBIENT_LIGHTS
 
 	#endif // PRECOMPUTED_AMBIENT
 	
 
-	#if defined NUM_DIRECTIONAL_LIGHTS || defined NUM_POINT_LIGHTS || defined NUM_SPOT_LIGHTS || defined ENVIRONMENT_MAP_2D || defined ENVIRONMENT_CUBE_MAP
+	#if defined NUM_DIRECTIONAL_LIGHTS || defined NUM_POINT_LIGHTS || defined NUM_SPOT_LIGHTS || defined CLUSTERED_LIGHTS || defined ENVIRONMENT_MAP_2D || defined ENVIRONMENT_CUBE_MAP
 
 	vec3 eyeVector	= normalize(cameraPosition - vertexPosition); // always in world-space
 
-	#endif // NUM_DIRECTIONAL_LIGHTS || NUM_POINT_LIGHTS || NUM_SPOT_LIGHTS || ENVIRONMENT_MAP_2D || ENVIRONMENT_CUBE_MAP
+	#endif // NUM_DIRECTIONAL_LIGHTS || NUM_POINT_LIGHTS || NUM_SPOT_LIGHTS || CLUSTERED_LIGHTS || ENVIRONMENT_MAP_2D || ENVIRONMENT_CUBE_MAP
 
-	#if defined NUM_DIRECTIONAL_LIGHTS || defined NUM_POINT_LIGHTS || defined NUM_SPOT_LIGHTS
+	#if defined NUM_DIRECTIONAL_LIGHTS || defined NUM_POINT_LIGHTS || defined NUM_SPOT_LIGHTS || defined CLUSTERED_LIGHTS
 		
 		vec3	lightColor				= vec3(0.0);
 		vec3 	lightDirection			= vec3(0.0);
@@ -178,7 +201,12 @@ void main(void)
 		//---------------------------
 		for (int i = 0; i < NUM_DIRECTIONAL_LIGHTS; ++i)
 		{
-			#ifndef MINKO_NO_GLSL_STRUCT
+			#if defined(PACKED_LIGHTS)
+				lightColor			= packedDirectionalLights[i * 2].rgb;
+				lightDiffuseCoeff	= packedDirectionalLights[i * 2].a;
+				lightDirection		= packedDirectionalLights[i * 2 + 1].xyz;
+				lightSpecularCoeff	= packedDirectionalLights[i * 2 + 1].w;
+			#elif !defined(MINKO_NO_GLSL_STRUCT)
 				lightColor			= directionalLights[i].color;
 				lightDiffuseCoeff	= directionalLights[i].diffuse;
 				lightSpecularCoeff	= directionalLights[i].specular;
@@ -188,9 +216,14 @@ void main(void)
 				lightDiffuseCoeff	= directionalLights_diffuse[i];
 				lightSpecularCoeff	= directionalLights_specular[i];
 				lightDirection		= directionalLights_direction[i];
-			#endif // MINKO_NO_GLSL_STRUCT
+			#endif // PACKED_LIGHTS
 	
 			lightDirection	= normalize(-lightDirection);
+
+			#ifdef DIRECTIONAL_SHADOW_CASCADES
+				if (i == directionalShadowLightId)
+					lightColor *= shadowMapping_directional(vertexPosition);
+			#endif // DIRECTIONAL_SHADOW_CASCADES
 			
 			diffuseAccum		+= phong_diffuseReflection(normalVector, lightDirection)
 				* lightColor
@@ -210,7 +243,13 @@ void main(void)
 		//---------------------
 		for (int i = 0; i < NUM_POINT_LIGHTS; ++i)
 		{
-			#ifndef MINKO_NO_GLSL_STRUCT
+			#if defined(PACKED_LIGHTS)
+				lightColor				= packedPointLights[i * 3].rgb;
+				lightDiffuseCoeff		= packedPointLights[i * 3].a;
+				lightPosition			= packedPointLights[i * 3 + 1].xyz;
+				lightSpecularCoeff		= packedPointLights[i * 3 + 1].w;
+				lightAttenuationCoeffs	= packedPointLights[i * 3 + 2].xyz;
+			#elif !defined(MINKO_NO_GLSL_STRUCT)
 				lightColor				= pointLights[i].color;
 				lightDiffuseCoeff		= pointLights[i].diffuse;
 				lightSpecularCoeff		= pointLights[i].specular;
@@ -222,7 +261,7 @@ void main(void)
 				lightSpecularCoeff		= pointLights_specular[i];
 				lightAttenuationCoeffs	= pointLights_attenuationCoeffs[i];
 				lightPosition			= pointLights_position[i];
-			#endif // MINKO_NO_GLSL_STRUCT
+			#endif // PACKED_LIGHTS
 		
 			lightDirection			= lightPosition - vertexPosition;
 			float distanceToLight 	= length(lightDirection);
@@ -251,7 +290,16 @@ void main(void)
 		//--------------------
 		for (int i = 0; i < NUM_SPOT_LIGHTS; ++i)
 		{
-			#ifndef MINKO_NO_GLSL_STRUCT
+			#if defined(PACKED_LIGHTS)
+				lightColor				= packedSpotLights[i * 4].rgb;
+				lightDiffuseCoeff		= packedSpotLights[i * 4].a;
+				lightPosition			= packedSpotLights[i * 4 + 1].xyz;
+				lightSpecularCoeff		= packedSpotLights[i * 4 + 1].w;
+				lightAttenuationCoeffs	= packedSpotLights[i * 4 + 2].xyz;
+				lightCosInnerAng		= packedSpotLights[i * 4 + 2].w;
+				lightSpotDirection		= packedSpotLights[i * 4 + 3].xyz;
+				lightCosOuterAng		= packedSpotLights[i * 4 + 3].w;
+			#elif !defined(MINKO_NO_GLSL_STRUCT)
 				lightColor				= spotLights[i].color;
 				lightDiffuseCoeff		= spotLights[i].diffuse;
 				lightSpecularCoeff		= spotLights[i].specular;
@@ -269,7 +317,7 @@ void main(void)
 				lightSpotDirection		= spotLights_direction[i];
 				lightCosInnerAng		= spotLights_cosInnerConeAngle[i];
 				lightCosOuterAng		= spotLights_cosOuterConeAngle[i];
-			#endif // MINKO_NO_GLSL_STRUCT
+			#endif // PACKED_LIGHTS
 			
 			
 			lightDirection			= lightPosition - vertexPosition;
@@ -279,6 +327,11 @@ void main(void)
 			lightSpotDirection	= normalize(-lightSpotDirection);						
 			float cosSpot		= dot(-lightDirection, lightSpotDirection);
 
+			#ifdef SPOT_SHADOW
+				if (i == spotShadowLightId && lightCosOuterAng < cosSpot)
+					lightColor *= shadowMapping_spot(vertexPosition);
+			#endif // SPOT_SHADOW
+
 			if (lightCosOuterAng < cosSpot)
 			{
 				vec3	distVec 	= vec3(1.0, distanceToLight, distanceToLight * distanceToLight);
@@ -305,8 +358,22 @@ void main(void)
 			}
 		}
 		#endif // NUM_SPOT_LIGHTS
+
+		#ifdef CLUSTERED_LIGHTS
+		//---------------------
+		lightClusters_accumulate(
+			vertexPosition,
+			normalVector,
+			cameraPosition,
+			eyeVector,
+			specular.rgb,
+			shininessCoeff,
+			diffuseAccum,
+			specularAccum
+		);
+		#endif // CLUSTERED_LIGHTS
 		
-	#endif // defined NUM_DIRECTIONAL_LIGHTS || defined NUM_POINT_LIGHTS || defined NUM_SPOT_LIGHTS
+	#endif // defined NUM_DIRECTIONAL_LIGHTS || defined NUM_POINT_LIGHTS || defined NUM_SPOT_LIGHTS || defined CLUSTERED_LIGHTS
 
 	#if defined(ENVIRONMENT_MAP_2D) || defined(ENVIRONMENT_CUBE_MAP)
 
@@ -0,0 +1,20 @@
+#ifdef FRAGMENT_SHADER
+
+#ifdef GL_ES
+	#ifdef GL_FRAGMENT_PRECISION_HIGH
+		precision highp float;
+	#else
+		precision mediump float;
+	#endif
+#endif
+
+#pragma include("ShadowMapping.function.glsl")
+
+varying vec2 vertexDepth;
+
+void main(void)
+{
+	gl_FragColor = shadowMapping_packDepth(vertexDepth.x / vertexDepth.y * 0.5 + 0.5);
+}
+
+#endif // FRAGMENT_SHADER
@@ -0,0 +1,34 @@
+#ifdef VERTEX_SHADER
+
+#ifdef GL_ES
+	precision highp float;
+#endif
+
+#pragma include("Skinning.function.glsl")
+
+attribute vec3 position;
+
+uniform mat4 modelToWorldMatrix;
+uniform mat4 worldToScreenMatrix;
+
+varying vec2 vertexDepth;
+
+void main(void)
+{
+	vec4 pos = vec4(position, 1.0);
+
+	#ifdef NUM_BONES
+		pos = skinning_moveVertex(pos);
+	#endif // NUM_BONES
+	
+	#ifdef MODEL_TO_WORLD
+		pos = modelToWorldMatrix * pos;
+	#endif // MODEL_TO_WORLD
+	
+	gl_Position = worldToScreenMatrix * pos;
+
+	// w is 1 for the orthographic cascades, spot lights need the perspective divide
+	vertexDepth = gl_Position.zw;
+}
+
+#endif // VERTEX_SHADER
@@ -0,0 +1,131 @@
+// the depth packed in 4 bytes needs more than mediump
+#if defined(GL_ES) && defined(GL_FRAGMENT_PRECISION_HIGH)
+	#define SHADOW_MAPPING_HIGHP highp
+#else
+	#define SHADOW_MAPPING_HIGHP
+#endif
+
+// stores 1 - depth so that the texels of a cleared map are as far as possible
+vec4
+shadowMapping_packDepth(SHADOW_MAPPING_HIGHP float depth)
+{
+	SHADOW_MAPPING_HIGHP vec4 bytes = fract(
+		vec4(1.0, 255.0, 65025.0, 16581375.0) * clamp(1.0 - depth, 0.0, 0.999999)
+	);
+
+	return bytes - bytes.yzww * vec4(1.0 / 255.0, 1.0 / 255.0, 1.0 / 255.0, 0.0);
+}
+
+SHADOW_MAPPING_HIGHP float
+shadowMapping_unpackDepth(vec4 bytes)
+{
+	return 1.0 - dot(bytes, vec4(1.0, 1.0 / 255.0, 1.0 / 65025.0, 1.0 / 16581375.0));
+}
+
+#if defined(DIRECTIONAL_SHADOW_CASCADES) || defined(SPOT_SHADOW)
+
+SHADOW_MAPPING_HIGHP vec3
+shadowMapping_coordinates(mat4 viewProjection, vec3 position)
+{
+	SHADOW_MAPPING_HIGHP vec4 coordinates = viewProjection * vec4(position, 1.0);
+
+	return coordinates.xyz / coordinates.w * 0.5 + 0.5;
+}
+
+bool
+shadowMapping_inside(SHADOW_MAPPING_HIGHP vec3 coordinates)
+{
+	return all(greaterThan(coordinates.xy, vec2(0.0))) && all(lessThan(coordinates, vec3(1.0)));
+}
+
+// 1.0 when lit, 0.0 in the shadow, averaged over the 4 texels around the coordinates
+float
+shadowMapping_lookup(sampler2D						map,
+					 SHADOW_MAPPING_HIGHP vec3		coordinates,
+					 float							texelSize,
+					 float							bias)
+{
+	SHADOW_MAPPING_HIGHP float depth = coordinates.z - bias;
+	float lit = 0.0;
+
+	lit += depth <= shadowMapping_unpackDepth(texture2D(map, coordinates.xy + vec2(-0.5, -0.5) * texelSize)) ? 1.0 : 0.0;
+	lit += depth <= shadowMapping_unpackDepth(texture2D(map, coordinates.xy + vec2(0.5, -0.5) * texelSize)) ? 1.0 : 0.0;
+	lit += depth <= shadowMapping_unpackDepth(texture2D(map, coordinates.xy + vec2(-0.5, 0.5) * texelSize)) ? 1.0 : 0.0;
+	lit += depth <= shadowMapping_unpackDepth(texture2D(map, coordinates.xy + vec2(0.5, 0.5) * texelSize)) ? 1.0 : 0.0;
+
+	return lit * 0.25;
+}
+
+#endif // defined(DIRECTIONAL_SHADOW_CASCADES) || defined(SPOT_SHADOW)
+
+#ifdef DIRECTIONAL_SHADOW_CASCADES
+
+uniform sampler2D	directionalShadowMap0;
+uniform mat4		directionalShadowViewProjection0;
+
+#if DIRECTIONAL_SHADOW_CASCADES > 1
+	uniform sampler2D	directionalShadowMap1;
+	uniform mat4		directionalShadowViewProjection1;
+#endif
+#if DIRECTIONAL_SHADOW_CASCADES > 2
+	uniform sampler2D	directionalShadowMap2;
+	uniform mat4		directionalShadowViewProjection2;
+#endif
+#if DIRECTIONAL_SHADOW_CASCADES > 3
+	uniform sampler2D	directionalShadowMap3;
+	uniform mat4		directionalShadowViewProjection3;
+#endif
+
+uniform float		directionalShadowBias;
+uniform float		directionalShadowTexelSize;
+uniform int			directionalShadowLightId;	// index of the shadowed light in directionalLights
+
+// the cascades are sorted from the camera: the first one containing the position is the sharpest
+float
+shadowMapping_directional(vec3 position)
+{
+	SHADOW_MAPPING_HIGHP vec3 coordinates = shadowMapping_coordinates(directionalShadowViewProjection0, position);
+
+	if (shadowMapping_inside(coordinates))
+		return shadowMapping_lookup(directionalShadowMap0, coordinates, directionalShadowTexelSize, directionalShadowBias);
+
+	#if DIRECTIONAL_SHADOW_CASCADES > 1
+		coordinates = shadowMapping_coordinates(directionalShadowViewProjection1, position);
+		if (shadowMapping_inside(coordinates))
+			return shadowMapping_lookup(directionalShadowMap1, coordinates, directionalShadowTexelSize, directionalShadowBias);
+	#endif
+	#if DIRECTIONAL_SHADOW_CASCADES > 2
+		coordinates = shadowMapping_coordinates(directionalShadowViewProjection2, position);
+		if (shadowMapping_inside(coordinates))
+			return shadowMapping_lookup(directionalShadowMap2, coordinates, directionalShadowTexelSize, directionalShadowBias);
+	#endif
+	#if DIRECTIONAL_SHADOW_CASCADES > 3
+		coordinates = shadowMapping_coordinates(directionalShadowViewProjection3, position);
+		if (shadowMapping_inside(coordinates))
+			return shadowMapping_lookup(directionalShadowMap3, coordinates, directionalShadowTexelSize, directionalShadowBias);
+	#endif
+
+	return 1.0;
+}
+
+#endif // DIRECTIONAL_SHADOW_CASCADES
+
+#ifdef SPOT_SHADOW
+
+uniform sampler2D	spotShadowMap;
+uniform mat4		spotShadowViewProjection;
+uniform float		spotShadowBias;
+uniform float		spotShadowTexelSize;
+uniform int			spotShadowLightId;	// index of the shadowed light in spotLights
+
+float
+shadowMapping_spot(vec3 position)
+{
+	SHADOW_MAPPING_HIGHP vec3 coordinates = shadowMapping_coordinates(spotShadowViewProjection, position);
+
+	return shadowMapping_inside(coordinates)
+		? shadowMapping_lookup(spotShadowMap, coordinates, spotShadowTexelSize, spotShadowBias)
+		: 1.0;
+}
+
+#endif // SPOT_SHADOW
@@ -1,22 +1,43 @@
 #if defined(VERTEX_SHADER) && defined(NUM_BONES)
 
+#ifdef BONE_MATRICES_TEXTURE
+	// one row of 4 texels per bone, each texel is a column of the matrix
+	uniform		sampler2D	boneMatricesTexture;
+#else
 	uniform 	mat4	boneMatrices[NUM_BONES];
+#endif // BONE_MATRICES_TEXTURE
 	attribute	vec4	boneIdsA;
 	attribute	vec4	boneIdsB;
 	attribute	vec4	boneWeightsA;
 	attribute	vec4	boneWeightsB;
 
+	mat4 skinning_boneMatrix(float boneId)
+	{
+	#ifdef BONE_MATRICES_TEXTURE
+		float v = (boneId + 0.5) / float(NUM_BONES);
+
+		return mat4(
+			texture2D(boneMatricesTexture, vec2(0.125, v)),
+			texture2D(boneMatricesTexture, vec2(0.375, v)),
+			texture2D(boneMatricesTexture, vec2(0.625, v)),
+			texture2D(boneMatricesTexture, vec2(0.875, v))
+		);
+	#else
+		return boneMatrices[int(boneId)];
+	#endif // BONE_MATRICES_TEXTURE
+	}
+
 	vec4 skinning_moveVertex(vec4 inputVec)
 	{
 		return ( 
-			boneWeightsA.x * boneMatrices[int(boneIdsA.x)] + 
-			boneWeightsA.y * boneMatrices[int(boneIdsA.y)] + 
-			boneWeightsA.z * boneMatrices[int(boneIdsA.z)] + 
-			boneWeightsA.w * boneMatrices[int(boneIdsA.w)] + 
-			boneWeightsB.x * boneMatrices[int(boneIdsB.x)] + 
-			boneWeightsB.y * boneMatrices[int(boneIdsB.y)] + 
-			boneWeightsB.z * boneMatrices[int(boneIdsB.z)] + 
-			boneWeightsB.w * boneMatrices[int(boneIdsB.w)] 
+			boneWeightsA.x * skinning_boneMatrix(boneIdsA.x) + 
+			boneWeightsA.y * skinning_boneMatrix(boneIdsA.y) + 
+			boneWeightsA.z * skinning_boneMatrix(boneIdsA.z) + 
+			boneWeightsA.w * skinning_boneMatrix(boneIdsA.w) + 
+			boneWeightsB.x * skinning_boneMatrix(boneIdsB.x) + 
+			boneWeightsB.y * skinning_boneMatrix(boneIdsB.y) + 
+			boneWeightsB.z * skinning_boneMatrix(boneIdsB.z) + 
+			boneWeightsB.w * skinning_boneMatrix(boneIdsB.w) 
 			) * inputVec;	
 	}
 
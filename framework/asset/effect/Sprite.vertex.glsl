@@ -16,6 +16,10 @@ uniform mat4	uProjectionMatrix;
 	varying vec2 vUV;
 #endif
 
+#ifdef DIFFUSE_MAP_UV_RECT
+	uniform vec4 uDiffuseMapUVRect;
+#endif
+
 void main()
 {
 	vec4 pos = uViewMatrix * uModelToWorldMatrix * vec4(0., 0., 0., 1.);
@@ -24,6 +28,9 @@ void main()
 	
 	#ifdef DIFFUSE_MAP
 		vUV = aUV;
+		#ifdef DIFFUSE_MAP_UV_RECT
+			vUV = uDiffuseMapUVRect.xy + vUV * uDiffuseMapUVRect.zw;
+		#endif
 	#endif
 
 	gl_Position = uProjectionMatrix * pos;
@@ -0,0 +1,31 @@
+#ifdef FRAGMENT_SHADER
+
+#ifdef GL_ES
+	precision mediump float;
+#endif
+
+#pragma include("Fog.function.glsl")
+
+uniform vec4		diffuseColor;
+uniform sampler2D	diffuseMap;
+uniform vec3		lightDirection;
+
+varying vec2 vertexUV;
+varying vec3 vertexNormal;
+
+void main(void)
+{
+	#ifdef DIFFUSE_MAP
+		vec4 color = texture2D(diffuseMap, vertexUV);
+	#else
+		vec4 color = diffuseColor;
+	#endif
+
+	#ifdef LIGHT_DIRECTION
+		color.rgb *= 0.3 + 0.7 * max(dot(normalize(vertexNormal), -normalize(lightDirection)), 0.0);
+	#endif
+
+	gl_FragColor = fog_sampleFog(color, gl_FragCoord);
+}
+
+#endif // FRAGMENT_SHADER
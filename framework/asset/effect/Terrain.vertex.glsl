@@ -0,0 +1,81 @@
+#ifdef VERTEX_SHADER
+
+#ifdef GL_ES
+	precision highp float;
+#endif
+
+// xz in [0, 1] over the chunk grid, y is -1 on the skirts
+attribute vec3 position;
+
+uniform mat4 modelToWorldMatrix;
+uniform mat4 worldToScreenMatrix;
+uniform vec3 cameraPosition;
+
+// heights stored on 16 bits in the red and green channels, one texel per sample
+uniform sampler2D heightMap;
+// number of samples, size of the texture
+uniform vec4 heightMapSize;
+// spacing between the samples, min height, height range, skirt depth
+uniform vec4 terrainSize;
+// first sample and number of samples covered by the chunk, number of quads of the grid
+uniform vec4 chunkRect;
+// distances over which the vertices move to the grid of the parent level
+uniform vec2 chunkMorphRange;
+
+varying vec2 vertexUV;
+varying vec3 vertexNormal;
+
+float
+terrain_height(vec2 coords)
+{
+	vec4 texel = texture2D(heightMap, (coords + 0.5) / heightMapSize.zw);
+
+	return terrainSize.y + terrainSize.z * (texel.r * 65280.0 + texel.g * 255.0) / 65535.0;
+}
+
+vec4
+terrain_toWorld(vec2 coords, float height)
+{
+	vec4 pos = vec4(coords.x * terrainSize.x, height, coords.y * terrainSize.x, 1.0);
+
+	#ifdef MODEL_TO_WORLD
+		pos = modelToWorldMatrix * pos;
+	#endif
+
+	return pos;
+}
+
+void main(void)
+{
+	float	gridSize	= chunkRect.w;
+	vec2	gridPos		= position.xz * gridSize;
+	vec2	fineSample	= chunkRect.xy + position.xz * chunkRect.z;
+	// the odd vertices collapse on their even neighbour, which matches the grid of the parent level
+	vec2	coarseSample	= chunkRect.xy + (gridPos - fract(gridPos * 0.5) * 2.0) / gridSize * chunkRect.z;
+
+	fineSample		= min(fineSample, heightMapSize.xy - 1.0);
+	coarseSample	= min(coarseSample, heightMapSize.xy - 1.0);
+
+	float	fineHeight	= terrain_height(fineSample);
+	float	eyeDistance	= length(terrain_toWorld(fineSample, fineHeight).xyz - cameraPosition);
+	float	morph		= clamp((eyeDistance - chunkMorphRange.x) / max(chunkMorphRange.y - chunkMorphRange.x, 0.0001), 0.0, 1.0);
+	vec2	coords		= mix(fineSample, coarseSample, morph);
+	float	height		= mix(fineHeight, terrain_height(coarseSample), morph);
+
+	// the skirts hide the cracks between chunks of different levels
+	height += position.y * terrainSize.w;
+
+	vec2	step	= vec2(chunkRect.z / gridSize, 0.0);
+	float	dx		= terrain_height(min(fineSample + step.xy, heightMapSize.xy - 1.0)) - terrain_height(max(fineSample - step.xy, 0.0));
+	float	dz		= terrain_height(min(fineSample + step.yx, heightMapSize.xy - 1.0)) - terrain_height(max(fineSample - step.yx, 0.0));
+
+	vertexNormal	= normalize(vec3(-dx, 2.0 * step.x * terrainSize.x, -dz));
+	#ifdef MODEL_TO_WORLD
+		vertexNormal	= mat3(modelToWorldMatrix) * vertexNormal;
+	#endif
+	vertexUV		= coords / max(heightMapSize.xy - 1.0, 1.0);
+
+	gl_Position = worldToScreenMatrix * terrain_toWorld(coords, height);
+}
+
+#endif // VERTEX_SHADER
@@ -23,6 +23,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/Signal.hpp"
 
+#include <atomic>
+
 namespace minko
 {
 	class AbstractCanvas
@@ -84,6 +86,64 @@ namespace minko
 		bool
 		isWorkerRegistered(const std::string& name) = 0;
 
+		// created on first use, shared by all the workers of the canvas
+		std::shared_ptr<async::ThreadPool>
+		threadPool();
+
+		inline
+		bool
+		onDemand() const
+		{
+			return _onDemand;
+		}
+
+		// on demand, a frame is only executed when one was requested or an input event was received,
+		// otherwise the previous frame is kept and the canvas waits for events
+		inline
+		void
+		onDemand(bool value)
+		{
+			_onDemand = value;
+			_frameRequested = true;
+		}
+
+		inline
+		bool
+		frameRequested() const
+		{
+			return _frameRequested;
+		}
+
+		// can be called from any thread
+		virtual
+		void
+		requestFrame()
+		{
+			_frameRequested = true;
+		}
+
+		// executed on the main thread before each frame once the input events were dispatched, for the devices
+		// sampled on other threads to dispatch their events once per frame too
+		inline
+		Signal<Ptr>::Ptr
+		inputsPolled() const
+		{
+			return _inputsPolled;
+		}
+
+		// created on first use when the platform supports sharing GL objects between contexts, nullptr otherwise:
+		// resources can then be uploaded with uploadAsync() without stalling the render thread
+		virtual
+		std::shared_ptr<render::UploadThread>
+		uploadThread()
+		{
+			return nullptr;
+		}
+
+		// created on first use, the canvas records the duration of every frame once it exists
+		std::shared_ptr<FrameTimeHistogram>
+		frameTimeHistogram();
+
 		template <typename T>
 		void
 		registerWorker(const std::string& type)
@@ -109,7 +169,35 @@ namespace minko
 			_defaultCanvas = value;
 		}
 
+		// called when the scene changed: the default canvas executes a new frame if it renders on demand
+		static
+		void
+		invalidateDefaultCanvas()
+		{
+			if (_defaultCanvas && _defaultCanvas->_onDemand)
+				_defaultCanvas->requestFrame();
+		}
+
+	protected:
+		AbstractCanvas() :
+			_onDemand(false),
+			_frameRequested(true),
+			_inputsPolled(Signal<Ptr>::create())
+		{
+		}
+
+		virtual
+		~AbstractCanvas()
+		{
+		}
+
 	protected:
+		bool												_onDemand;
+		std::atomic<bool>									_frameRequested;
+		std::shared_ptr<async::ThreadPool>					_threadPool;
+		std::shared_ptr<FrameTimeHistogram>					_frameTimeHistogram;
+		Signal<Ptr>::Ptr									_inputsPolled;
+
 		static
 		std::unordered_map<std::string, WorkerHandler>		_workers;
 		
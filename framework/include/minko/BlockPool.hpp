@@ -0,0 +1,208 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+#if defined(_MSC_VER)
+# define MINKO_BLOCK_POOL_THREAD_LOCAL	__declspec(thread)
+#else
+# define MINKO_BLOCK_POOL_THREAD_LOCAL	__thread
+#endif
+
+namespace minko
+{
+	// keeps up to MAX_NUM_FREE_BLOCKS released blocks of BlockSize bytes per thread for the next allocations of
+	// that thread: a block released by another thread than the one which allocated it joins the free list of the
+	// releasing thread, the blocks kept by a thread are not freed when it exits
+	template <std::size_t BlockSize>
+	class BlockPool
+	{
+	public:
+		static const unsigned int MAX_NUM_FREE_BLOCKS = 4096;
+
+	private:
+		struct FreeBlock
+		{
+			FreeBlock* next;
+		};
+
+		static MINKO_BLOCK_POOL_THREAD_LOCAL FreeBlock*		_freeBlocks;
+		static MINKO_BLOCK_POOL_THREAD_LOCAL unsigned int	_numFreeBlocks;
+
+	public:
+		inline static
+		void*
+		allocate()
+		{
+#ifndef MINKO_NO_BLOCK_POOL
+			if (_freeBlocks != nullptr)
+			{
+				auto block = _freeBlocks;
+
+				_freeBlocks = block->next;
+				--_numFreeBlocks;
+
+				return block;
+			}
+#endif
+
+			return ::operator new(BlockSize < sizeof(FreeBlock) ? sizeof(FreeBlock) : BlockSize);
+		}
+
+		inline static
+		void
+		release(void* block)
+		{
+#ifndef MINKO_NO_BLOCK_POOL
+			if (_numFreeBlocks < MAX_NUM_FREE_BLOCKS)
+			{
+				auto freeBlock = static_cast<FreeBlock*>(block);
+
+				freeBlock->next = _freeBlocks;
+				_freeBlocks = freeBlock;
+				++_numFreeBlocks;
+
+				return;
+			}
+#endif
+
+			::operator delete(block);
+		}
+
+		// on the calling thread
+		inline static
+		unsigned int
+		numFreeBlocks()
+		{
+			return _numFreeBlocks;
+		}
+	};
+
+	template <std::size_t BlockSize>
+	MINKO_BLOCK_POOL_THREAD_LOCAL typename BlockPool<BlockSize>::FreeBlock* BlockPool<BlockSize>::_freeBlocks = nullptr;
+
+	template <std::size_t BlockSize>
+	MINKO_BLOCK_POOL_THREAD_LOCAL unsigned int BlockPool<BlockSize>::_numFreeBlocks = 0;
+
+	// draws the single element allocations of a container, such as the nodes of a std::list, from a BlockPool
+	template <typename T>
+	class BlockAllocator
+	{
+	public:
+		typedef T			value_type;
+		typedef T*			pointer;
+		typedef const T*	const_pointer;
+		typedef T&			reference;
+		typedef const T&	const_reference;
+		typedef std::size_t	size_type;
+		typedef std::ptrdiff_t	difference_type;
+
+		template <typename U>
+		struct rebind
+		{
+			typedef BlockAllocator<U> other;
+		};
+
+	public:
+		BlockAllocator()
+		{
+		}
+
+		template <typename U>
+		BlockAllocator(const BlockAllocator<U>&)
+		{
+		}
+
+		inline
+		T*
+		allocate(std::size_t n)
+		{
+			return static_cast<T*>(n == 1 ? BlockPool<sizeof(T)>::allocate() : ::operator new(n * sizeof(T)));
+		}
+
+		inline
+		void
+		deallocate(T* p, std::size_t n)
+		{
+			if (n == 1)
+				BlockPool<sizeof(T)>::release(p);
+			else
+				::operator delete(p);
+		}
+
+		template <typename U, typename... Args>
+		inline
+		void
+		construct(U* p, Args&&... args)
+		{
+			::new(static_cast<void*>(p)) U(std::forward<Args>(args)...);
+		}
+
+		template <typename U>
+		inline
+		void
+		destroy(U* p)
+		{
+			p->~U();
+		}
+
+		inline
+		std::size_t
+		max_size() const
+		{
+			return std::size_t(-1) / sizeof(T);
+		}
+	};
+
+	template <typename T, typename U>
+	inline
+	bool
+	operator==(const BlockAllocator<T>&, const BlockAllocator<U>&)
+	{
+		return true;
+	}
+
+	template <typename T, typename U>
+	inline
+	bool
+	operator!=(const BlockAllocator<T>&, const BlockAllocator<U>&)
+	{
+		return false;
+	}
+}
+
+// class-specific new and delete operators drawing the instances of Type from the BlockPool of its size, derived
+// classes of another size use the global operators
+#define MINKO_POOLED_ALLOCATION(Type)																\
+	static void* operator new(std::size_t size)														\
+	{																								\
+		return size == sizeof(Type) ? minko::BlockPool<sizeof(Type)>::allocate() : ::operator new(size);	\
+	}																								\
+																									\
+	static void operator delete(void* block, std::size_t size)										\
+	{																								\
+		if (size == sizeof(Type))																	\
+			minko::BlockPool<sizeof(Type)>::release(block);											\
+		else																						\
+			::operator delete(block);																\
+	}
@@ -42,18 +42,27 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include <cassert>
 #include <ctime>
 #include <type_traits>
+#include <typeindex>
 #include <cfloat>
+#include <cstdint>
 #include <climits>
 #include <future>
 #include <thread>
 #include <chrono>
 
+#include "minko/BlockPool.hpp"
 #include "minko/math/Convertible.hpp"
 
 #define PI 3.1415926535897932384626433832795
 
 #define MINKO_VERSION "3.0"
 
+// Emscripten builds without pthreads (-s USE_PTHREADS=1) cannot start threads: the workers run in web workers
+// and the parallel code paths run on the calling thread
+#if defined(EMSCRIPTEN) && !defined(__EMSCRIPTEN_PTHREADS__)
+# define MINKO_NO_THREADS
+#endif
+
 namespace minko
 {
     typedef unsigned int uint;
@@ -63,6 +72,7 @@ namespace minko
 	class Signal;
 	class Color;
 	class AbstractCanvas;
+	class FrameTimeHistogram;
     
 	namespace render
 	{
@@ -77,21 +87,37 @@ namespace minko
         enum class TextureFilter;
         enum class MipFilter;
 		enum class StencilOperation;
+		enum class VertexAttributeType;
+		enum class BufferUsage;
         typedef std::tuple<WrapMode, TextureFilter, MipFilter>	SamplerState;
 
         class States;
 		class DrawCall;
 		class Pass;
 		class Effect;
+		class EffectVariantsJob;
 		class ProgramInputs;
 
 		class AbstractResource;
 		class Shader;
 		class Program;
+		class ProgramCache;
+		class ShaderOptimizer;
+		class RenderTargetPool;
+		class GPUTimer;
+		class DynamicResolution;
+		class PixelReadback;
+		class RenderGraph;
+		class TextureAtlas;
+		class TextureStreamer;
+		class MemoryBudget;
+		class ContextRestorer;
+		struct RenderStats;
 		class ProgramSignature;
 		class VertexFormat;
 		class VertexBuffer;
 		class IndexBuffer;
+		class UploadThread;
 
 		enum class TextureType
 		{
@@ -109,7 +135,21 @@ namespace minko
 		enum class TextureFormat
 		{
 			RGB,
-			RGBA
+			RGBA,
+
+			// GPU compressed formats, uploaded as is
+			RGB_DXT1,
+			RGBA_DXT1,
+			RGBA_DXT3,
+			RGBA_DXT5,
+			RGB_ETC1,
+			RGB_ETC2,
+			RGBA_ETC2,
+			RGB_PVRTC_2BPP,
+			RGB_PVRTC_4BPP,
+			RGBA_PVRTC_2BPP,
+			RGBA_PVRTC_4BPP,
+			RGBA_ASTC_4x4
 		};
 		class AbstractTexture;
 		class Texture;
@@ -139,6 +179,8 @@ namespace minko
 	{
 		class Node;
 		class NodeSet;
+		class Prefab;
+		class NodePool;
 	}
 
 	namespace component
@@ -152,8 +194,13 @@ namespace minko
 		class Renderer;
 		class PerspectiveCamera;
 		class Culling;
+		class LOD;
 		class Picking;
 		class JobManager;
+		class StaticBatcher;
+		class Terrain;
+		class BillboardBatch;
+		class Impostor;
 
         class LightManager;
         class AbstractLight;
@@ -162,6 +209,11 @@ namespace minko
         class DirectionalLight;
 		class SpotLight;
 		class PointLight;
+		class LightCulling;
+		class ClusteredLighting;
+		class LightPacking;
+		class ShadowMapping;
+		class ReflectionProbe;
 
 		class BoundingBox;
 
@@ -173,11 +225,13 @@ namespace minko
 		class AbstractAnimation;
 		class MasterAnimation;
 		class Animation;
+		class AnimationBatcher;
 		class Skinning;
 	}
 
 	namespace data
 	{
+		class PropertyName;
 		class Provider;
 		class ArrayProvider;
 		class StructureProvider;
@@ -234,6 +288,10 @@ namespace minko
 		class SphereGeometry;
         class QuadGeometry;
 		class TeapotGeometry;
+		class TriangleBVH;
+		class MeshAdjacency;
+		class MeshOptimizer;
+		class TangentSpaceJob;
 	}
 
 	namespace animation
@@ -254,6 +312,7 @@ namespace minko
 		class Box;
 		class Frustum;
 		class OctTree;
+		class OcclusionBuffer;
 
 		inline
 		bool
@@ -311,6 +370,8 @@ namespace minko
 		class AbstractLoader;
 		class AbstractParser;
 		class EffectParser;
+		class KTXParser;
+		class PackedArchive;
         class AssetLibrary;
 
         class ParserError : public std::runtime_error
@@ -338,6 +399,8 @@ namespace minko
 	namespace async
 	{
 		class Worker;
+		class ThreadPool;
+		class SystemScheduler;
 	}
 }
 
@@ -0,0 +1,116 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+	class FrameTimeHistogram
+	{
+	public:
+		typedef std::shared_ptr<FrameTimeHistogram>	Ptr;
+
+	private:
+		float				_bucketWidth;
+		std::vector<uint>	_buckets;
+		uint				_numFrames;
+		float				_totalTime;
+		float				_minTime;
+		float				_maxTime;
+
+	public:
+		// frame times are in milliseconds, the last bucket holds the frames longer than the histogram
+		inline static
+		Ptr
+		create(float bucketWidth = 1.f, uint numBuckets = 100)
+		{
+			if (bucketWidth <= 0.f)
+				throw std::invalid_argument("bucketWidth");
+			if (numBuckets == 0)
+				throw std::invalid_argument("numBuckets");
+
+			return std::shared_ptr<FrameTimeHistogram>(new FrameTimeHistogram(bucketWidth, numBuckets));
+		}
+
+		inline
+		float
+		bucketWidth() const
+		{
+			return _bucketWidth;
+		}
+
+		inline
+		uint
+		numBuckets() const
+		{
+			return _buckets.size();
+		}
+
+		inline
+		uint
+		bucket(uint index) const
+		{
+			return _buckets[index];
+		}
+
+		inline
+		uint
+		numFrames() const
+		{
+			return _numFrames;
+		}
+
+		inline
+		float
+		minTime() const
+		{
+			return _numFrames ? _minTime : 0.f;
+		}
+
+		inline
+		float
+		maxTime() const
+		{
+			return _maxTime;
+		}
+
+		inline
+		float
+		averageTime() const
+		{
+			return _numFrames ? _totalTime / (float)_numFrames : 0.f;
+		}
+
+		void
+		record(float frameTime);
+
+		// upper bound of the bucket under which 'ratio' of the frames fall, e.g. 0.99f for the 99th percentile
+		float
+		percentile(float ratio) const;
+
+		void
+		reset();
+
+	private:
+		FrameTimeHistogram(float bucketWidth, uint numBuckets);
+	};
+}
@@ -24,6 +24,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/Color.hpp"
 #include "minko/render/AbstractContext.hpp"
 #include "minko/render/OpenGLES2Context.hpp"
+#include "minko/render/UploadThread.hpp"
 #include "minko/render/ProgramInputs.hpp"
 #include "minko/render/Pass.hpp"
 #include "minko/render/Shader.hpp"
@@ -36,13 +37,22 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/math/Vector3.hpp"
 #include "minko/math/Vector4.hpp"
 #include "minko/math/Matrix4x4.hpp"
+#include "minko/math/CPUFeatures.hpp"
 #include "minko/math/AbstractShape.hpp"
 #include "minko/math/Box.hpp"
 #include "minko/math/Ray.hpp"
 #include "minko/math/Frustum.hpp"
+#include "minko/math/OcclusionBuffer.hpp"
+#include "minko/math/OctTree.hpp"
 #include "minko/Signal.hpp"
+#include "minko/FrameTimeHistogram.hpp"
+#include "minko/Profiler.hpp"
+#include "minko/SignalStats.hpp"
 #include "minko/scene/Node.hpp"
 #include "minko/scene/NodeSet.hpp"
+#include "minko/scene/Prefab.hpp"
+#include "minko/scene/NodePool.hpp"
+#include "minko/data/PropertyName.hpp"
 #include "minko/data/Provider.hpp"
 #include "minko/data/ArrayProvider.hpp"
 #include "minko/data/StructureProvider.hpp"
@@ -62,20 +72,44 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/component/DirectionalLight.hpp"
 #include "minko/component/SpotLight.hpp"
 #include "minko/component/PointLight.hpp"
+#include "minko/component/LightCulling.hpp"
+#include "minko/component/ClusteredLighting.hpp"
+#include "minko/component/LightPacking.hpp"
+#include "minko/component/ShadowMapping.hpp"
+#include "minko/component/ReflectionProbe.hpp"
 #include "minko/component/BoundingBox.hpp"
 #include "minko/component/MousePicking.hpp"
 #include "minko/component/MouseManager.hpp"
 #include "minko/component/SkinningMethod.hpp"
 #include "minko/component/Culling.hpp"
+#include "minko/component/LOD.hpp"
 #include "minko/component/Picking.hpp"
 #include "minko/component/AbstractAnimation.hpp"
 #include "minko/component/MasterAnimation.hpp"
 #include "minko/component/Animation.hpp"
+#include "minko/component/AnimationBatcher.hpp"
 #include "minko/animation/AbstractTimeline.hpp"
 #include "minko/animation/Matrix4x4Timeline.hpp"
 #include "minko/component/JobManager.hpp"
+#include "minko/component/StaticBatcher.hpp"
+#include "minko/component/Terrain.hpp"
+#include "minko/component/BillboardBatch.hpp"
+#include "minko/component/Impostor.hpp"
 #include "minko/render/AbstractResource.hpp"
 #include "minko/render/Program.hpp"
+#include "minko/render/ProgramCache.hpp"
+#include "minko/render/ShaderOptimizer.hpp"
+#include "minko/render/RenderTargetPool.hpp"
+#include "minko/render/GPUTimer.hpp"
+#include "minko/render/DynamicResolution.hpp"
+#include "minko/render/PixelReadback.hpp"
+#include "minko/render/RenderStats.hpp"
+#include "minko/render/RenderGraph.hpp"
+#include "minko/render/TextureAtlas.hpp"
+#include "minko/render/EffectVariantsJob.hpp"
+#include "minko/render/TextureStreamer.hpp"
+#include "minko/render/MemoryBudget.hpp"
+#include "minko/render/ContextRestorer.hpp"
 #include "minko/render/VertexBuffer.hpp"
 #include "minko/render/IndexBuffer.hpp"
 #include "minko/render/AbstractTexture.hpp"
@@ -88,11 +122,17 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/geometry/QuadGeometry.hpp"
 #include "minko/geometry/TeapotGeometry.hpp"
 #include "minko/geometry/LineGeometry.hpp"
+#include "minko/geometry/TriangleBVH.hpp"
+#include "minko/geometry/MeshAdjacency.hpp"
+#include "minko/geometry/MeshOptimizer.hpp"
+#include "minko/geometry/TangentSpaceJob.hpp"
 #include "minko/file/Options.hpp"
 #include "minko/file/AbstractLoader.hpp"
 #include "minko/file/FileLoader.hpp"
+#include "minko/file/PackedArchive.hpp"
 #include "minko/file/AbstractParser.hpp"
 #include "minko/file/EffectParser.hpp"
+#include "minko/file/KTXParser.hpp"
 #include "minko/file/AssetLibrary.hpp"
 #include "minko/material/Material.hpp"
 #include "minko/material/BasicMaterial.hpp"
@@ -0,0 +1,188 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include <atomic>
+
+#if defined(MINKO_NO_PROFILER)
+# define MINKO_PROFILE_SCOPE(name)
+#else
+# define MINKO_PROFILE_CONCAT(a, b)		a ## b
+# define MINKO_PROFILE_VARIABLE(line)	MINKO_PROFILE_CONCAT(minkoProfileScope, line)
+// times the rest of the enclosing block; name is kept as is: a string literal or Profiler::intern()
+# define MINKO_PROFILE_SCOPE(name)		minko::Profiler::Scope MINKO_PROFILE_VARIABLE(__LINE__)(name)
+#endif
+
+namespace minko
+{
+	// Hierarchical CPU timers, recorded in a ring buffer per thread when the scopes end. The profiler
+	// is disabled by default: a disabled scope only reads an atomic flag, and defining MINKO_NO_PROFILER
+	// compiles the scopes out.
+	class Profiler
+	{
+	public:
+		// times are in nanoseconds since the first use of the profiler
+		struct Event
+		{
+			const char*			name;
+			uint				thread;
+			uint				depth;
+			unsigned long long	start;
+			unsigned long long	duration;
+		};
+
+		// value of a counter sampled at a given time, such as the render stats of a frame
+		struct CounterSample
+		{
+			const char*			name;
+			unsigned long long	time;
+			unsigned long long	value;
+		};
+
+		class Scope
+		{
+		private:
+			bool	_active;
+
+		public:
+			inline explicit
+			Scope(const char* name) :
+				_active(Profiler::enabled())
+			{
+				if (_active)
+					Profiler::begin(name);
+			}
+
+			inline
+			~Scope()
+			{
+				if (_active)
+					Profiler::end();
+			}
+		};
+
+	private:
+		static std::atomic<bool>	_enabled;
+
+	public:
+		inline static
+		bool
+		enabled()
+		{
+			return _enabled.load(std::memory_order_relaxed);
+		}
+
+		static
+		void
+		enabled(bool value);
+
+		// events kept per thread, the oldest ones are overwritten first
+		static
+		uint
+		bufferSize();
+
+		// clears the recorded events
+		static
+		void
+		bufferSize(uint value);
+
+		static
+		void
+		begin(const char* name);
+
+		static
+		void
+		end();
+
+		// nanoseconds since the first use of the profiler
+		static
+		unsigned long long
+		time();
+
+		// GPU times are measured asynchronously: they are recorded at depth 0 on a thread of their own
+		static
+		void
+		gpuEvent(const char* name, unsigned long long start, unsigned long long duration);
+
+		// id of the thread of the GPU events
+		static
+		uint
+		gpuThread();
+
+		// the last bufferSize() samples are kept, whatever the thread sampling them
+		static
+		void
+		counter(const char* name, unsigned long long value);
+
+		// sorted by time
+		static
+		std::vector<CounterSample>
+		counters();
+
+		// stable name for the scopes named at runtime
+		static
+		const char*
+		intern(const std::string& name);
+
+		// the recorded events of all the threads, sorted by start time
+		static
+		std::vector<Event>
+		events();
+
+		// the events of the calling thread nested in the last completed scope with that name
+		static
+		std::vector<Event>
+		lastFrame(const std::string& frameScope = "SceneManager::nextFrame");
+
+		// the events of all the threads until the end of the first scope with that name, provided the buffers
+		// did not wrap around meanwhile: defining MINKO_PROFILE_STARTUP enables the profiler from the static
+		// initialization on
+		static
+		std::vector<Event>
+		startup(const std::string& frameScope = "SceneManager::nextFrame");
+
+		static
+		void
+		clear();
+
+		// Chrome tracing "complete" and "counter" events, to load in chrome://tracing or Perfetto
+		static
+		std::string
+		exportChromeTrace();
+
+		static
+		void
+		exportChromeTrace(const std::string& filename);
+
+		// one line per scope of lastFrame(), indented by depth, for in-app overlays and logs
+		static
+		std::string
+		report(const std::string& frameScope = "SceneManager::nextFrame");
+
+		// one line per scope of startup() followed by the time to the end of the first frame
+		static
+		std::string
+		startupReport(const std::string& frameScope = "SceneManager::nextFrame");
+	};
+}
@@ -20,6 +20,9 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #pragma once
 
 #include "minko/Common.hpp"
+#include "minko/SignalStats.hpp"
+
+#include <typeinfo>
 
 namespace minko
 {
@@ -28,10 +31,24 @@ namespace minko
 		public std::enable_shared_from_this<Signal<A...>>
 	{
 	private:
-		typedef std::function<void(A...)>										CallbackFunction;
-		typedef std::pair<float, CallbackFunction>								Callback;
-		typedef typename std::list<Callback>::iterator							CallbackIterator;
-		typedef typename std::list<std::pair<float, unsigned int>>::iterator	SlotIterator;
+		typedef std::function<void(A...)>	CallbackFunction;
+
+		// std::function stores small callables such as the std::bind() of a member function inline
+		struct Callback
+		{
+			float				priority;
+			unsigned int		id;
+			bool				removed;
+			CallbackFunction	function;
+
+			Callback(float priority, unsigned int id, const CallbackFunction& function) :
+				priority(priority),
+				id(id),
+				removed(false),
+				function(function)
+			{
+			}
+		};
 
 		template <typename... B>
 		class SignalSlot;
@@ -41,64 +58,78 @@ namespace minko
 		typedef std::shared_ptr<SignalSlot<A...>>		Slot;
 
 	private:
-		std::list<Callback>										_callbacks;
-		std::list<std::pair<float, unsigned int>>				_slotIds;
+		// sorted by decreasing priority, in connection order for equal priorities
+		std::vector<Callback>									_callbacks;
+		unsigned int											_numCallbacks;
 		unsigned int 											_nextSlotId;
 
-		bool													_locked;
-		std::list<std::pair<Callback, uint>>					_toAdd;
-		std::list<std::pair<CallbackIterator, SlotIterator>>	_toRemove;
-		std::list<unsigned int>									_toRemoveSlotId;
-		bool													_signalListDirty;
+		// number of nested execute() calls, callbacks are only moved when it is 0
+		unsigned int											_locked;
+		std::vector<Callback>									_toAdd;
+		bool													_hasRemoved;
+
+		// key of the SignalStats counters, the type of the signal when null
+		const char*												_name;
 
 	private:
 		Signal() :
 			std::enable_shared_from_this<Signal<A...>>(),
+			_numCallbacks(0),
             _nextSlotId(0),
-			_locked(false),
-			_signalListDirty(false)
+			_locked(0),
+			_hasRemoved(false),
+			_name(nullptr)
 		{
 		}
 
 		void
-		removeConnectionById(const unsigned int connectionId)
+		insertCallback(const Callback& callback)
 		{
-			auto connectionIdIt = _slotIds.begin();
-			auto callbackIt 	= _callbacks.begin();
+			auto position = _callbacks.end();
 
-			while ((*connectionIdIt).second != connectionId)
-			{
-				connectionIdIt++;
-				callbackIt++;
-			}
+			while (position != _callbacks.begin() && std::prev(position)->priority < callback.priority)
+				--position;
 
-			removeConnectionByIterator(connectionIdIt, callbackIt);
+			_callbacks.insert(position, callback);
+			++_numCallbacks;
 		}
 
 		void
-		removeConnectionByIterator(SlotIterator		 connectionIdIt,
-								   CallbackIterator	 callbackIt)
+		removeConnectionById(const unsigned int connectionId)
 		{
 			if (_locked)
 			{
-				auto addIt = std::find_if(_toAdd.begin(), _toAdd.end(), [&](std::pair<Callback, unsigned int>& add)
+				auto addIt = std::find_if(_toAdd.begin(), _toAdd.end(), [&](const Callback& add)
 				{
-					return add.second == (*connectionIdIt).second;
+					return add.id == connectionId;
 				});
 
 				if (addIt != _toAdd.end())
-					_toAdd.erase(addIt);
-				else
 				{
-					_toRemove.push_back(std::pair<CallbackIterator, SlotIterator>(callbackIt, connectionIdIt));
-					_toRemoveSlotId.push_back(connectionIdIt->second);
+					_toAdd.erase(addIt);
+
+					return;
 				}
 			}
-			else
+
+			auto callbackIt = std::find_if(_callbacks.begin(), _callbacks.end(), [&](const Callback& callback)
 			{
-				_callbacks.erase(callbackIt);
-				_slotIds.erase(connectionIdIt);
+				return callback.id == connectionId && !callback.removed;
+			});
+
+			if (callbackIt == _callbacks.end())
+				return;
+
+			--_numCallbacks;
+
+			// the callback might be running, it is erased once the outermost execute() returns
+			if (_locked)
+			{
+				callbackIt->removed = true;
+				_hasRemoved = true;
 			}
+			else
+				_callbacks.erase(callbackIt);
 		}
 
 	public:
@@ -113,20 +144,33 @@ namespace minko
 		uint
 		numCallbacks() const
 		{
-			return _callbacks.size();
+			return _numCallbacks;
+		}
+
+		inline
+		const char*
+		name() const
+		{
+			return _name;
+		}
+
+		// tells this signal apart from the other signals of the same type in the SignalStats,
+		// the name must outlive the signal: a string literal or Profiler::intern()
+		inline
+		Ptr
+		name(const char* value)
+		{
+			_name = value;
+
+			return Signal<A...>::shared_from_this();
 		}
 
 		void
 		sortSignals()
 		{
-			_callbacks.sort([&](const Callback& callback1, const Callback& callback2) -> bool
+			std::stable_sort(_callbacks.begin(), _callbacks.end(), [](const Callback& callback1, const Callback& callback2) -> bool
 			{
-				return callback1.first > callback2.first;
-			});
-
-			_slotIds.sort([&](const std::pair<float, unsigned int>& slot1, const std::pair<float, unsigned int>& slot2) -> bool
-			{
-				return slot1.first > slot2.first;
+				return callback1.priority > callback2.priority;
 			});
 		}
 
@@ -136,21 +180,9 @@ namespace minko
 			auto connection = SignalSlot<A...>::create(Signal<A...>::shared_from_this(), _nextSlotId++);
 			
 			if (_locked)
-				_toAdd.push_back(std::pair<Callback, unsigned int>(std::pair<float, CallbackFunction>(priority, callback), connection->_id));
+				_toAdd.push_back(Callback(priority, connection->_id, callback));
 			else
-			{
-
-				_callbacks.push_back(std::pair<float, CallbackFunction>(priority, callback));
-				_slotIds.push_back(std::pair<float, unsigned int>(priority, connection->_id));
-				
-				if (_callbacks.size() >= 2)
-				{
-					auto prec = std::prev(_callbacks.end(), 2);
-
-					if (priority > prec->first)
-						sortSignals();
-				}
-			}
+				insertCallback(Callback(priority, connection->_id, callback));
 
 			return connection;
 		}
@@ -158,41 +190,47 @@ namespace minko
 		void
 		execute(A... arguments)
 		{
+			// callbacks connected meanwhile wait in _toAdd so the storage does not move, the ones
+			// disconnected meanwhile are still called during this execution
+			const auto numCallbacks = _callbacks.size();
+#if !defined(MINKO_NO_PROFILER)
+			const auto instrumented = SignalStats::enabled();
+			const auto start = instrumented ? SignalStats::time() : 0;
+#endif
+
+			++_locked;
+			for (unsigned int i = 0; i < numCallbacks; ++i)
+				_callbacks[i].function(arguments...);
+			--_locked;
+
+#if !defined(MINKO_NO_PROFILER)
+			if (instrumented)
+				SignalStats::record(
+					_name ? _name : typeid(Signal<A...>).name(), numCallbacks, SignalStats::time() - start
+				);
+#endif
 
-			_locked = true;
-			for (auto& callback : _callbacks)
-				callback.second(arguments...);
-			_locked = false;
+			if (_locked)
+				return;
 
-			for (auto& callbackIt : _toRemove)
+			if (_hasRemoved)
 			{
-				_callbacks.erase(callbackIt.first);
-				_slotIds.erase(callbackIt.second);
+				_hasRemoved = false;
+				_callbacks.erase(
+					std::remove_if(_callbacks.begin(), _callbacks.end(), [](const Callback& callback)
+					{
+						return callback.removed;
+					}),
+					_callbacks.end()
+				);
 			}
 
-			for (auto& callbackAndConnectionId : _toAdd)
+			if (!_toAdd.empty())
 			{
-
-				_callbacks.push_back(callbackAndConnectionId.first);
-				_slotIds.push_back(std::pair<float, unsigned int>(callbackAndConnectionId.first.first, callbackAndConnectionId.second));
-
-				if (_callbacks.size() >= 2)
-				{
-					auto prec = std::prev(_callbacks.end(), 2);
-
-					if (callbackAndConnectionId.first.first > prec->first)
-						_signalListDirty = true;
-				}
-			}
-			
-			if (_signalListDirty)
-			{
-				_signalListDirty = false;
-				sortSignals();
+				for (auto& callback : _toAdd)
+					insertCallback(callback);
+				_toAdd.clear();
 			}
-
-			_toAdd.clear();
-			_toRemove.clear();
 		}
 
 	private:
@@ -205,6 +243,8 @@ namespace minko
 		public:
 			typedef std::shared_ptr<SignalSlot<T...>>	Ptr;
 
+			MINKO_POOLED_ALLOCATION(SignalSlot)
+
 		public:
 			std::shared_ptr<Signal<T...>>
 			signal()
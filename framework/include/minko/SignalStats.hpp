@@ -0,0 +1,89 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include <atomic>
+
+namespace minko
+{
+	// Opt-in counters of the Signal executions: how many times each signal executed, how many callbacks it
+	// called and how long they took, aggregated per frame by the SceneManager. Signals are counted under
+	// their name() when they have one, under their type otherwise. The counters are disabled by default and
+	// compiled out with the Profiler when MINKO_NO_PROFILER is defined.
+	class SignalStats
+	{
+	public:
+		struct Entry
+		{
+			const char*			name;
+			uint				numExecutions;
+			uint				numCallbacks;
+			// nanoseconds spent in the callbacks, including the signals they executed in turn
+			unsigned long long	time;
+		};
+
+	private:
+		static std::atomic<bool>	_enabled;
+
+	public:
+		inline static
+		bool
+		enabled()
+		{
+			return _enabled.load(std::memory_order_relaxed);
+		}
+
+		static
+		void
+		enabled(bool value);
+
+		// name must outlive the counters: a string literal, a type name or Profiler::intern()
+		static
+		void
+		record(const char* name, uint numCallbacks, unsigned long long time);
+
+		// nanoseconds, on the clock of the Profiler
+		static
+		unsigned long long
+		time();
+
+		// ends the current frame: its counters replace the ones of lastFrame() and their totals are sent to
+		// the Profiler as the numSignalExecutions and numSignalCallbacks counters
+		static
+		void
+		nextFrame();
+
+		// the signals executed during the last frame, the most expensive first
+		static
+		std::vector<Entry>
+		lastFrame();
+
+		// one line per signal of lastFrame(), at most maxNumLines, to find the cascades worth batching
+		static
+		std::string
+		report(uint maxNumLines = 20);
+
+		static
+		void
+		clear();
+	};
+}
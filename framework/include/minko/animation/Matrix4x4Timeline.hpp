@@ -36,8 +36,16 @@ namespace minko
 			typedef std::shared_ptr<math::Matrix4x4>			Matrix4x4Ptr;
 			typedef std::vector<std::pair<uint, Matrix4x4Ptr>>	MatrixTimetable;
 		private:
-			MatrixTimetable	_matrices;
-			bool			_interpolate;
+			MatrixTimetable		_matrices;
+			bool				_interpolate;
+
+			// QR decomposition of each key, rotations are stored as (i, j, k, r) and the
+			// upper triangular matrices as 16 row-major values
+			std::vector<float>	_keyRotations;
+			std::vector<float>	_keyUpperTriangulars;
+
+			// index of the key found by the last lookup, only used as a starting point
+			mutable uint		_keyCursor;
 
 		public:
 			inline static
@@ -67,6 +75,14 @@ namespace minko
             Matrix4x4Ptr
             interpolate(uint time, Matrix4x4Ptr output = nullptr) const;
 
+			// writes the 16 row-major values at the specified time, keyCursor is the starting point
+			// of the key lookup and is updated to the key found
+			void
+			evaluate(uint time, float* output, uint& keyCursor) const
+			{
+				evaluate(time, _interpolate, output, keyCursor);
+			}
+
 		private:
 			Matrix4x4Timeline(const std::string&,
 							  uint,
@@ -74,6 +90,9 @@ namespace minko
 							  const std::vector<Matrix4x4Ptr>&,
 							  bool);
 
+			void
+			evaluate(uint time, bool interpolate, float* output, uint& keyCursor) const;
+
 			void
 			initializeMatrixTimetable(const std::vector<uint>&,
 									  const std::vector<Matrix4x4Ptr>&);
@@ -0,0 +1,60 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#if !defined(MINKO_NO_THREADS)
+# include <future>
+#endif
+
+namespace minko
+{
+	namespace async
+	{
+		// calls f(begin, end, worker) over ranges of [0, numItems), the calling thread takes the first one
+		template <typename F>
+		void
+		runInParallel(uint numItems, uint numWorkers, F f)
+		{
+			const uint rangeSize = (numItems + numWorkers - 1) / numWorkers;
+
+#if !defined(MINKO_NO_THREADS)
+			std::vector<std::future<void>> workers;
+
+			for (uint i = 1; i < numWorkers && i * rangeSize < numItems; ++i)
+			{
+				const uint begin	= i * rangeSize;
+				const uint end		= std::min(begin + rangeSize, numItems);
+
+				workers.push_back(std::async(std::launch::async, [&f, begin, end, i]() { f(begin, end, i); }));
+			}
+#endif
+
+			f(0, std::min(rangeSize, numItems), 0);
+
+#if !defined(MINKO_NO_THREADS)
+			for (auto& worker : workers)
+				worker.get();
+#endif
+		}
+	}
+}
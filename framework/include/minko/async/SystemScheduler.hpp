@@ -0,0 +1,140 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+	namespace async
+	{
+		// runs per-frame systems according to the data they declare to read and write: a system runs after the
+		// ones registered before it that write what it reads or writes, or that read what it writes, and after
+		// the systems it explicitly follows; independent systems run concurrently on the thread pool, the
+		// calling thread executes its share of them and the main thread systems
+		class SystemScheduler
+		{
+		public:
+			typedef std::shared_ptr<SystemScheduler>			Ptr;
+			typedef std::function<void(float, float)>			Update;
+
+		private:
+			typedef std::shared_ptr<ThreadPool>					ThreadPoolPtr;
+
+			struct System
+			{
+				std::string					name;
+				Update						update;
+				std::set<std::string>		reads;
+				std::set<std::string>		writes;
+				std::vector<std::string>	after;
+				bool						mainThread;
+			};
+
+			struct Execution;
+
+		private:
+			ThreadPoolPtr						_threadPool;
+			std::vector<System>					_systems;
+			bool								_invalidGraph;
+			std::vector<std::vector<uint>>		_successors;
+			std::vector<uint>					_numPredecessors;
+			std::vector<uint>					_order;
+
+		public:
+			// without thread pool, the systems are executed in order by the calling thread
+			inline static
+			Ptr
+			create(ThreadPoolPtr threadPool = nullptr)
+			{
+				return std::shared_ptr<SystemScheduler>(new SystemScheduler(threadPool));
+			}
+
+			inline
+			ThreadPoolPtr
+			threadPool() const
+			{
+				return _threadPool;
+			}
+
+			inline
+			void
+			threadPool(ThreadPoolPtr value)
+			{
+				_threadPool = value;
+			}
+
+			inline
+			uint
+			numSystems() const
+			{
+				return _systems.size();
+			}
+
+			// reads and writes name the data shared by the systems (ex: "transform", "physics"), after names
+			// systems that may not be registered; main thread systems are never executed by the thread pool
+			void
+			addSystem(const std::string&				name,
+					  Update							update,
+					  const std::vector<std::string>&	reads,
+					  const std::vector<std::string>&	writes,
+					  const std::vector<std::string>&	after		= std::vector<std::string>(),
+					  bool								mainThread	= false);
+
+			bool
+			hasSystem(const std::string& name) const;
+
+			void
+			removeSystem(const std::string& name);
+
+			// the systems that have to complete before the given one starts
+			std::vector<std::string>
+			dependencies(const std::string& name);
+
+			// a valid serial order of the systems
+			std::vector<std::string>
+			order();
+
+			// returns once every system was executed, the first exception thrown by a system is rethrown;
+			// systems must not be added or removed meanwhile
+			void
+			execute(float time, float deltaTime);
+
+		private:
+			SystemScheduler(ThreadPoolPtr threadPool);
+
+			int
+			indexOf(const std::string& name) const;
+
+			static
+			bool
+			conflict(const System& a, const System& b);
+
+			void
+			updateGraph();
+
+			void
+			schedule(std::shared_ptr<Execution> execution, uint index);
+
+			void
+			run(std::shared_ptr<Execution> execution, uint index);
+		};
+	}
+}
@@ -0,0 +1,191 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+namespace minko
+{
+	namespace async
+	{
+		// fixed set of threads, each with its own priority queue, idle threads steal from the others;
+		// completion callbacks are queued without locks and executed by update() on the calling thread
+		class ThreadPool
+		{
+		public:
+			typedef std::shared_ptr<ThreadPool>	Ptr;
+
+			class Task
+			{
+				friend class ThreadPool;
+
+			public:
+				typedef std::shared_ptr<Task>	Ptr;
+
+			private:
+				std::function<void()>	_run;
+				std::function<void()>	_complete;
+				int						_priority;
+				uint					_order;
+				std::atomic<bool>		_cancelled;
+				std::exception_ptr		_exception;
+
+			public:
+				inline
+				int
+				priority() const
+				{
+					return _priority;
+				}
+
+				// the task is skipped if it did not start yet, its completion callback is never executed
+				inline
+				void
+				cancel()
+				{
+					_cancelled = true;
+				}
+
+				inline
+				bool
+				cancelled() const
+				{
+					return _cancelled;
+				}
+
+			private:
+				Task(std::function<void()> run, std::function<void()> complete, int priority, uint order) :
+					_run(run),
+					_complete(complete),
+					_priority(priority),
+					_order(order),
+					_cancelled(false)
+				{
+				}
+			};
+
+		private:
+			struct Queue
+			{
+				std::mutex				mutex;
+				std::vector<Task::Ptr>	tasks; // heap, highest priority first
+			};
+
+			struct CompletedTask
+			{
+				Task::Ptr		task;
+				CompletedTask*	next;
+			};
+
+		private:
+			std::vector<std::unique_ptr<Queue>>		_queues;
+			std::vector<std::thread>				_threads;
+			std::atomic<uint>						_nextQueue;
+			std::atomic<uint>						_nextOrder;
+			std::atomic<uint>						_numPendingTasks;
+			std::atomic<uint>						_numRunningTasks;
+			std::atomic<bool>						_stopping;
+			std::mutex								_sleepMutex;
+			std::condition_variable					_wakeUp;
+			std::atomic<CompletedTask*>				_completedTasks;
+			std::atomic<uint>						_numWaiters;
+			std::mutex								_completedMutex;
+			std::condition_variable					_completed;
+
+		public:
+			// without threads, the tasks are executed by update()
+			inline static
+			Ptr
+			create(uint numThreads = defaultNumThreads())
+			{
+				return std::shared_ptr<ThreadPool>(new ThreadPool(numThreads));
+			}
+
+			~ThreadPool();
+
+			static
+			uint
+			defaultNumThreads();
+
+			inline
+			uint
+			numThreads() const
+			{
+				return _threads.size();
+			}
+
+			inline
+			uint
+			numPendingTasks() const
+			{
+				return _numPendingTasks;
+			}
+
+			inline
+			uint
+			numRunningTasks() const
+			{
+				return _numRunningTasks;
+			}
+
+			Task::Ptr
+			run(std::function<void()> task, std::function<void()> complete = nullptr, int priority = 0);
+
+			// executes the completion callbacks of the tasks done since the last call, usually once per frame
+			void
+			update();
+
+			// queues a callback executed by update() on the calling thread, can be called from any thread
+			void
+			post(std::function<void()> callback);
+
+			// blocks until a task completes or a callback is posted, then executes the callbacks like update();
+			// returns false without blocking when no task is left
+			bool
+			waitForCompletion();
+
+		private:
+			ThreadPool(uint numThreads);
+
+			void
+			threadLoop(uint queueId);
+
+			Task::Ptr
+			pop(uint queueId);
+
+			void
+			execute(Task::Ptr task);
+
+			void
+			pushCompleted(Task::Ptr task);
+
+			void
+			notifyWaiters();
+
+			static
+			bool
+			lowerPriority(const Task::Ptr& a, const Task::Ptr& b);
+		};
+	}
+}
@@ -23,7 +23,11 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/Signal.hpp"
 
-#if EMSCRIPTEN
+#if !defined(MINKO_NO_THREADS)
+#include "minko/async/ThreadPool.hpp"
+#endif
+
+#if defined(MINKO_NO_THREADS)
 #include "emscripten/emscripten.h"
 #endif
 
@@ -51,20 +55,24 @@ namespace minko
 			bool										_busy;
 			bool										_finished;
 
-#if defined(EMSCRIPTEN)
+#if defined(MINKO_NO_THREADS)
+			std::string									_script;
 			int											_handle;
 #else
 			std::shared_future<MessagePtr>				_future;
 			std::promise<MessagePtr>					_promise;
-			float										_ratio;
+			std::atomic<float>							_ratio;
 			float										_oldRatio;
-			std::mutex									_ratioMutex;
+			std::weak_ptr<ThreadPool>					_threadPool;
+			std::shared_ptr<ThreadPool::Task>			_task;
 #endif
 
 		public:
 			void
 			start();
 
+			// starts the worker; once running on the canvas thread pool, its progress and completion are
+			// delivered by ThreadPool::update() and calling update() again is not needed
 			void
 			update();
 
@@ -74,6 +82,18 @@ namespace minko
 				return _busy;
 			}
 
+			bool
+			finished() const
+			{
+				return _finished;
+			}
+
+#if !defined(MINKO_NO_THREADS)
+			// a worker that did not start running yet is dropped, its complete signal is never executed
+			void
+			cancel();
+#endif
+
 			virtual
 			void
 			run() = 0;
@@ -128,8 +148,36 @@ namespace minko
 		private:
 			MessagePtr _input;
 			MessagePtr _output;
+			const char* _profileName;
+
+#if !defined(MINKO_NO_THREADS)
+			void
+			profiledRun();
+
+			void
+			finish();
+#endif
+
+#if defined(MINKO_NO_THREADS)
+			// the web workers are shared by all the workers running the same script
+			struct WebWorker
+			{
+				int		handle;
+				uint	numCalls;
+			};
+
+			static std::unordered_map<std::string, std::vector<WebWorker>>	_webWorkers;
+			static std::unordered_map<uint, Ptr>							_calls;
+			static uint														_nextCallId;
+
+			static
+			int
+			acquireWebWorker(const std::string& script);
+
+			static
+			void
+			releaseWebWorker(const std::string& script, int handle);
 
-#if defined(EMSCRIPTEN)
 			static
 			void
 			messageHandler(char* data, int size, void* arg);
@@ -138,7 +186,7 @@ namespace minko
 	}
 }
 
-#if defined(EMSCRIPTEN)
+#if defined(MINKO_NO_THREADS)
 
 # define MINKO_WORKER(Name, Class, Code)										\
 void minkoWorkerEntryPoint(char* data, int size)								\
@@ -67,6 +67,12 @@ namespace minko
 			bool		_isReversed;
 			bool		_canUpdateOnce;
 
+			float		_lodScreenSize;
+			uint		_lodUpdateInterval;
+			float		_screenSize;
+			uint		_screenSizeFrameId;
+			uint		_timeSinceUpdate;
+			bool		_updateWhenCulled;
 
 			clock_t		_clockStart;
 
@@ -215,6 +221,57 @@ namespace minko
 			void
 			isReversed(bool);
 
+			inline
+			float
+			lodScreenSize() const
+			{
+				return _lodScreenSize;
+			}
+
+			inline
+			uint
+			lodUpdateInterval() const
+			{
+				return _lodUpdateInterval;
+			}
+
+			// below screenSize, the animation is only evaluated every updateInterval milliseconds
+			// (time, loops and labels still advance every frame)
+			inline
+			Ptr
+			lod(float screenSize, uint updateInterval)
+			{
+				_lodScreenSize		= screenSize;
+				_lodUpdateInterval	= updateInterval;
+
+				return shared_from_this();
+			}
+
+			inline
+			float
+			screenSize() const
+			{
+				return _screenSize;
+			}
+
+			// set by Culling, the largest size of the targets within the same frame is kept
+			void
+			screenSize(float value);
+
+			inline
+			bool
+			updateWhenCulled() const
+			{
+				return _updateWhenCulled;
+			}
+
+			inline
+			void
+			updateWhenCulled(bool value)
+			{
+				_updateWhenCulled = value;
+			}
+
 			inline
 			void
 			timeFunction(const std::function<uint(uint)>& func)
@@ -324,6 +381,9 @@ namespace minko
 
 			uint
 			getNewLoopTime(uint time, int deltaTime) const;
+
+			bool
+			visible() const;
 		};
 	}
 }
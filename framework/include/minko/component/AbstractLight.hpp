@@ -45,6 +45,9 @@ namespace minko
 
 		private:
 			std::shared_ptr<math::Vector3>			_color;
+			bool									_enabled;
+			// bound as the color of the light while it is disabled
+			std::shared_ptr<math::Vector3>			_black;
 
 			Signal<AbsCmpPtr, NodePtr>::Slot 		_targetAddedSlot;
 			Signal<AbsCmpPtr, NodePtr>::Slot 		_targetRemovedSlot;
@@ -68,6 +71,27 @@ namespace minko
 			Ptr
 			color(uint color);
 
+			inline
+			bool
+			enabled() const
+			{
+				return _enabled;
+			}
+
+			// a disabled light keeps its slot in the arrays of the root data but lights nothing: unlike
+			// removing the light, it neither shifts the other lights nor changes the NUM_*_LIGHTS macros,
+			// so the draw calls are left untouched
+			Ptr
+			enabled(bool value);
+
+			// index of the light in its array of the root data
+			inline
+			uint
+			arrayIndex() const
+			{
+				return data()->index();
+			}
+
 		protected:
 			AbstractLight(const std::string& arrayName);
 		};
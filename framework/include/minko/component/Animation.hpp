@@ -29,6 +29,7 @@ namespace minko
 		class Animation: public AbstractAnimation
 		{
 			friend class MasterAnimation;
+			friend class AnimationBatcher;
 
 		public:
 			typedef std::shared_ptr<Animation>						Ptr;
@@ -41,6 +42,10 @@ namespace minko
 			const std::vector<AbsTimelinePtr>						_timelines;
 			MasterAnimationPtr										_master;
 
+			// evaluated by an AnimationBatcher, update() only flags the animation
+			bool													_batched;
+			bool													_evaluationPending;
+
 		public:
 			inline static
 			Ptr
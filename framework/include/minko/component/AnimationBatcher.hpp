@@ -0,0 +1,138 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include "minko/component/AbstractComponent.hpp"
+#include "minko/Signal.hpp"
+
+namespace minko
+{
+	namespace component
+	{
+		// Evaluates the Matrix4x4Timelines of all the Animations below the target in a single pass
+		// at the end of SceneManager::frameBegin(). Target matrices are resolved when the sub-scene
+		// changes instead of being looked up by name every frame. Animations using other kinds of
+		// timelines keep evaluating themselves.
+		class AnimationBatcher :
+			public AbstractComponent,
+			public std::enable_shared_from_this<AnimationBatcher>
+		{
+		public:
+			typedef std::shared_ptr<AnimationBatcher>	Ptr;
+
+		private:
+			typedef std::shared_ptr<scene::Node>					NodePtr;
+			typedef std::shared_ptr<AbstractComponent>				AbsCtrlPtr;
+			typedef std::shared_ptr<SceneManager>					SceneManagerPtr;
+			typedef std::shared_ptr<Animation>						AnimationPtr;
+			typedef std::shared_ptr<animation::Matrix4x4Timeline>	TimelinePtr;
+			typedef std::shared_ptr<math::Matrix4x4>				MatrixPtr;
+
+		private:
+			static const uint									PARALLEL_MIN_NUM_MATRICES;
+
+			std::vector<AnimationPtr>							_animations;
+			bool												_invalidBindings;
+
+			// one entry per timeline and target of the batched animations
+			std::vector<uint>									_entryAnimationIds;
+			std::vector<TimelinePtr>							_entryTimelines;
+			std::vector<MatrixPtr>								_entryTargets;
+			std::vector<uint>									_entryKeyCursors;
+
+			std::vector<uint>									_pendingEntries;
+			std::vector<uint>									_pendingTimes;
+			std::vector<float>									_matrices;
+
+			Signal<AbsCtrlPtr, NodePtr>::Slot					_targetAddedSlot;
+			Signal<AbsCtrlPtr, NodePtr>::Slot					_targetRemovedSlot;
+			Signal<NodePtr, NodePtr, NodePtr>::Slot				_addedSlot;
+			Signal<NodePtr, NodePtr, NodePtr>::Slot				_removedSlot;
+			Signal<NodePtr, NodePtr, AbsCtrlPtr>::Slot			_componentAddedSlot;
+			Signal<NodePtr, NodePtr, AbsCtrlPtr>::Slot			_componentRemovedSlot;
+			Signal<SceneManagerPtr, float, float>::Slot			_frameBeginSlot;
+
+		public:
+			inline static
+			Ptr
+			create()
+			{
+				Ptr batcher = std::shared_ptr<AnimationBatcher>(new AnimationBatcher());
+
+				batcher->initialize();
+
+				return batcher;
+			}
+
+			inline
+			uint
+			numAnimations() const
+			{
+				return _animations.size();
+			}
+
+			inline
+			uint
+			numTimelines() const
+			{
+				return _entryTimelines.size();
+			}
+
+		private:
+			AnimationBatcher();
+
+			void
+			initialize();
+
+			void
+			targetAddedHandler(AbsCtrlPtr ctrl, NodePtr target);
+
+			void
+			targetRemovedHandler(AbsCtrlPtr ctrl, NodePtr target);
+
+			void
+			componentAddedHandler(NodePtr node, NodePtr target, AbsCtrlPtr ctrl);
+
+			void
+			componentRemovedHandler(NodePtr node, NodePtr target, AbsCtrlPtr ctrl);
+
+			void
+			setSceneManager(SceneManagerPtr sceneManager);
+
+			void
+			frameBeginHandler(SceneManagerPtr sceneManager, float time, float deltaTime);
+
+			void
+			bind();
+
+			void
+			bind(AnimationPtr animation);
+
+			void
+			unbind();
+
+			void
+			evaluate();
+		};
+	}
+}
@@ -0,0 +1,207 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include "minko/component/AbstractComponent.hpp"
+#include "minko/Signal.hpp"
+
+namespace minko
+{
+	namespace component
+	{
+		// camera facing quads stored in a single dynamic geometry drawn by one Surface added to the target
+		// in a child node; the quads of the billboards changed since the last update() are the only ones
+		// uploaded and the index buffer only references the billboards inside the frustum
+		class BillboardBatch :
+			public AbstractComponent,
+			public std::enable_shared_from_this<BillboardBatch>
+		{
+		public:
+			typedef std::shared_ptr<BillboardBatch>	Ptr;
+
+			static const uint						MAX_NUM_SHORT_INDEXED_BILLBOARDS;
+
+		private:
+			typedef std::shared_ptr<scene::Node>				NodePtr;
+			typedef std::shared_ptr<AbstractComponent>			AbsCmpPtr;
+			typedef std::shared_ptr<render::AbstractContext>	ContextPtr;
+			typedef std::shared_ptr<render::Effect>				EffectPtr;
+			typedef std::shared_ptr<material::Material>			MaterialPtr;
+			typedef std::shared_ptr<geometry::Geometry>			GeometryPtr;
+
+			struct Billboard
+			{
+				float	position[3];
+				float	size[2];
+				float	color[4];
+				float	uvRect[4];
+				bool	alive;
+			};
+
+		private:
+			ContextPtr								_context;
+			MaterialPtr								_material;
+			EffectPtr								_effect;
+
+			std::vector<Billboard>					_billboards;
+			std::vector<uint>						_freeBillboards;
+			bool									_billboardsChanged; // added or removed
+
+			GeometryPtr								_geometry;
+			std::shared_ptr<render::VertexBuffer>	_vertexBuffer;
+			std::shared_ptr<render::IndexBuffer>	_indexBuffer;
+			NodePtr									_batchNode;
+			float									_bounds[6];
+			bool									_boundsChanged;
+
+			std::shared_ptr<math::Frustum>			_frustum;
+			std::shared_ptr<math::Matrix4x4>		_localToScreen;
+			std::array<std::vector<float>, 6>		_cullingBounds;
+			std::vector<uint>						_cullingIds;
+			std::vector<uint>						_visibility;
+			std::vector<uint>						_visible;
+
+			Signal<AbsCmpPtr, NodePtr>::Slot		_targetAddedSlot;
+			Signal<AbsCmpPtr, NodePtr>::Slot		_targetRemovedSlot;
+
+		public:
+			inline static
+			Ptr
+			create(ContextPtr context, EffectPtr effect, MaterialPtr material = nullptr)
+			{
+				auto batch = std::shared_ptr<BillboardBatch>(new BillboardBatch(context, effect, material));
+
+				batch->initialize();
+
+				return batch;
+			}
+
+			inline
+			GeometryPtr
+			geometry() const
+			{
+				return _geometry;
+			}
+
+			inline
+			MaterialPtr
+			material() const
+			{
+				return _material;
+			}
+
+			inline
+			uint
+			numBillboards() const
+			{
+				return _billboards.size() - _freeBillboards.size();
+			}
+
+			// number of billboards referenced by the index buffer after the last update()
+			inline
+			uint
+			numVisible() const
+			{
+				return _visible.size();
+			}
+
+			// returns the id of the billboard, the ids of the removed billboards are reused; the uv rect is
+			// stored as (u, v, width, height) and defaults to the whole texture, the color to white
+			uint
+			add(std::shared_ptr<math::Vector3>	position,
+				std::shared_ptr<math::Vector2>	size,
+				std::shared_ptr<math::Vector4>	color	= nullptr,
+				std::shared_ptr<math::Vector4>	uvRect	= nullptr);
+
+			Ptr
+			remove(uint id);
+
+			Ptr
+			clear();
+
+			bool
+			contains(uint id) const;
+
+			std::shared_ptr<math::Vector3>
+			position(uint id) const;
+
+			Ptr
+			position(uint id, std::shared_ptr<math::Vector3> value);
+
+			std::shared_ptr<math::Vector2>
+			size(uint id) const;
+
+			Ptr
+			size(uint id, std::shared_ptr<math::Vector2> value);
+
+			std::shared_ptr<math::Vector4>
+			color(uint id) const;
+
+			Ptr
+			color(uint id, std::shared_ptr<math::Vector4> value);
+
+			std::shared_ptr<math::Vector4>
+			uvRect(uint id) const;
+
+			Ptr
+			uvRect(uint id, std::shared_ptr<math::Vector4> value);
+
+			// uploads the changed billboards and, when worldToScreenMatrix is set, only keeps in the index
+			// buffer the billboards inside the frustum; usually once per frame with the matrix of the camera
+			void
+			update(std::shared_ptr<math::Matrix4x4> worldToScreenMatrix = nullptr);
+
+		private:
+			BillboardBatch(ContextPtr context, EffectPtr effect, MaterialPtr material);
+
+			void
+			initialize();
+
+			void
+			targetAddedHandler(AbsCmpPtr cmp, NodePtr target);
+
+			void
+			targetRemovedHandler(AbsCmpPtr cmp, NodePtr target);
+
+			Billboard&
+			billboard(uint id);
+
+			const Billboard&
+			billboard(uint id) const;
+
+			void
+			writeVertices(uint id);
+
+			void
+			reserve(uint numBillboards);
+
+			void
+			updateBoundingBox();
+
+			void
+			cull(std::shared_ptr<math::Matrix4x4> worldToScreenMatrix, std::vector<uint>& visible);
+
+			void
+			updateIndices(const std::vector<uint>& visible);
+		};
+	}
+}
@@ -0,0 +1,186 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include "minko/component/AbstractComponent.hpp"
+#include "minko/Signal.hpp"
+
+namespace minko
+{
+	namespace component
+	{
+		// Bins the point and spot lights of the scene into a grid of clusters splitting the frustum
+		// of the target camera in screen tiles and exponential depth slices. The lights of each
+		// cluster and the parameters of the lights are packed every frame into the "lightClusters"
+		// textures read by the "*-clustered" techniques of Phong.effect, so that a fragment only
+		// iterates over the lights that can reach its cluster.
+		class ClusteredLighting :
+			public AbstractComponent,
+			public std::enable_shared_from_this<ClusteredLighting>
+		{
+		public:
+			typedef std::shared_ptr<ClusteredLighting>	Ptr;
+
+		private:
+			typedef std::shared_ptr<scene::Node>					NodePtr;
+			typedef std::shared_ptr<AbstractComponent>				AbsCtrlPtr;
+			typedef std::shared_ptr<SceneManager>					SceneManagerPtr;
+			typedef std::shared_ptr<render::Texture>				TexturePtr;
+
+		public:
+			static const uint									NUM_TILES_X;
+			static const uint									NUM_TILES_Y;
+			static const uint									NUM_SLICES;
+			// must match LIGHT_CLUSTERS_MAX_LIGHTS in LightClusters.function.glsl
+			static const uint									MAX_NUM_LIGHTS_PER_CLUSTER;
+			static const uint									MAX_NUM_LIGHTS;
+			static const uint									MAX_NUM_LIGHT_INDICES;
+
+		private:
+			static const uint									NUM_LIGHT_ROWS;
+			static const uint									INDICES_TEXTURE_WIDTH;
+
+			std::shared_ptr<render::AbstractContext>			_context;
+			std::shared_ptr<data::StructureProvider>			_data;
+			NodePtr												_root;
+			std::shared_ptr<PerspectiveCamera>					_camera;
+
+			std::vector<std::shared_ptr<PointLight>>			_pointLights;
+			std::vector<std::shared_ptr<SpotLight>>				_spotLights;
+			bool												_invalidLights;
+
+			TexturePtr											_clusterMap;
+			TexturePtr											_lightIndices;
+			TexturePtr											_lights;
+			std::shared_ptr<math::Vector3>						_grid;
+			std::shared_ptr<math::Vector4>						_projection;
+			std::shared_ptr<math::Vector4>						_textureSizes;
+
+			// projection the cluster bounds were computed for
+			float												_fov;
+			float												_aspectRatio;
+			float												_zNear;
+			float												_zFar;
+
+			// view space bounds of the clusters, slice after slice
+			std::array<std::vector<float>, 6>					_clusterBounds;
+			std::vector<uint>									_clusterNumLights;
+			std::vector<unsigned short>							_clusterLights;
+			std::vector<uint>									_sliceMask;
+			uint												_numLights;
+			uint												_numLightIndices;
+
+			Signal<AbsCtrlPtr, NodePtr>::Slot					_targetAddedSlot;
+			Signal<AbsCtrlPtr, NodePtr>::Slot					_targetRemovedSlot;
+			Signal<NodePtr, NodePtr, NodePtr>::Slot				_targetAddedToNodeSlot;
+			Signal<NodePtr, NodePtr, NodePtr>::Slot				_targetRemovedFromNodeSlot;
+			Signal<NodePtr, NodePtr, NodePtr>::Slot				_addedSlot;
+			Signal<NodePtr, NodePtr, NodePtr>::Slot				_removedSlot;
+			Signal<NodePtr, NodePtr, AbsCtrlPtr>::Slot			_componentAddedSlot;
+			Signal<NodePtr, NodePtr, AbsCtrlPtr>::Slot			_componentRemovedSlot;
+			Signal<SceneManagerPtr>::Slot						_cullingBeginSlot;
+
+		public:
+			inline static
+			Ptr
+			create(std::shared_ptr<render::AbstractContext> context)
+			{
+				Ptr clusteredLighting = std::shared_ptr<ClusteredLighting>(new ClusteredLighting(context));
+
+				clusteredLighting->initialize();
+
+				return clusteredLighting;
+			}
+
+			// lights packed during the last update, up to MAX_NUM_LIGHTS
+			inline
+			uint
+			numLights() const
+			{
+				return _numLights;
+			}
+
+			inline
+			uint
+			numLightIndices() const
+			{
+				return _numLightIndices;
+			}
+
+			// number of lights binned in the cluster of the tile (x, y) and the depth slice z
+			uint
+			numClusterLights(uint x, uint y, uint z) const;
+
+			// called before each culling of the scene of the target
+			void
+			update();
+
+			static
+			unsigned short
+			packHalf(float value);
+
+			static
+			float
+			unpackHalf(unsigned short value);
+
+		private:
+			ClusteredLighting(std::shared_ptr<render::AbstractContext> context);
+
+			void
+			initialize();
+
+			void
+			targetAddedHandler(AbsCtrlPtr ctrl, NodePtr target);
+
+			void
+			targetRemovedHandler(AbsCtrlPtr ctrl, NodePtr target);
+
+			void
+			setRoot(NodePtr root);
+
+			void
+			setSceneManager(SceneManagerPtr sceneManager);
+
+			void
+			bindLights();
+
+			void
+			updateClusterBounds();
+
+			void
+			addLight(uint											lightId,
+					 std::shared_ptr<math::Vector3>					position,
+					 float											radius);
+
+			void
+			packLight(uint											lightId,
+					  std::shared_ptr<AbstractDiscreteLight>		light,
+					  std::shared_ptr<math::Vector3>				position,
+					  std::shared_ptr<math::Vector3>				attenuationCoeffs,
+					  std::shared_ptr<SpotLight>					spotLight);
+
+			void
+			packClusters();
+		};
+	}
+}
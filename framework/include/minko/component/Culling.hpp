@@ -21,6 +21,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/Common.hpp"
 #include "minko/component/AbstractComponent.hpp"
+#include "minko/component/Transform.hpp"
 #include "minko/Signal.hpp"
 
 namespace minko
@@ -37,10 +38,44 @@ namespace minko
 		private:
 			typedef std::shared_ptr<scene::Node>			NodePtr;
 			typedef std::shared_ptr<math::AbstractShape>	ShapePtr;
+			typedef std::shared_ptr<Renderer>				RendererPtr;
+
+			struct OcclusionQuery
+			{
+				int		query;
+				bool	pending;
+				bool	occluded;
+				bool	inFrustum;
+				uint	phase;
+
+				OcclusionQuery() :
+					query(-1),
+					pending(false),
+					occluded(false),
+					inFrustum(false),
+					phase(0)
+				{
+				}
+			};
 
 		private:
-			static std::shared_ptr<math::OctTree>	_octTree;
+			std::shared_ptr<math::OctTree>			_octTree;
 			std::shared_ptr<math::AbstractShape>	_frustum;
+			std::shared_ptr<math::Matrix4x4>		_worldToScreen;
+			std::vector<NodePtr>					_occluders;
+			// renderers of other nodes looking through the same frustum
+			std::vector<RendererPtr>				_renderers;
+			std::shared_ptr<math::OcclusionBuffer>	_occlusionBuffer;
+
+			bool									_occlusionQueriesEnabled;
+			uint									_occlusionQueryInterval;
+			uint									_occlusionQueryMinNumTriangles;
+			std::unordered_map<NodePtr, OcclusionQuery>	_occlusionQueries;
+			uint									_occlusionFrame;
+			uint									_nextOcclusionPhase;
+			std::shared_ptr<render::Program>		_boxProgram;
+			std::shared_ptr<render::VertexBuffer>	_boxVertices;
+			std::shared_ptr<render::IndexBuffer>	_boxIndices;
 
 			Signal<AbstractComponent::Ptr, NodePtr>::Slot						_targetAddedSlot;
             Signal<AbstractComponent::Ptr, NodePtr>::Slot						_targetRemovedSlot;
@@ -48,8 +83,12 @@ namespace minko
 			Signal<NodePtr, NodePtr, NodePtr>::Slot								_addedToSceneSlot;
 			Signal<NodePtr, NodePtr>::Slot										_layoutChangedSlot;
 			Signal<std::shared_ptr<data::Container>, const std::string&>::Slot	_viewMatrixChangedSlot;
+			Transform::RootTransform::ModelToWorldChangedSignal::Slot			_modelToWorldChangedSlot;
+			Signal<RendererPtr>::Slot											_beforePresentSlot;
 
 			std::string		_bindProperty;
+			bool			_frustumReady;
+			uint			_cullingRevision;
 
 		public:
 			inline static
@@ -63,6 +102,83 @@ namespace minko
 				return CullingComponent;
 			}
 
+			// surfaces of the occluders are rasterized in a low resolution depth buffer
+			// that hides the nodes behind them
+			Ptr
+			addOccluder(NodePtr node);
+
+			Ptr
+			removeOccluder(NodePtr node);
+
+			inline
+			const std::vector<NodePtr>&
+			occluders() const
+			{
+				return _occluders;
+			}
+
+			// the visibility computed for the camera is also given to this renderer instead of
+			// culling the scene again for the same frustum
+			Ptr
+			addRenderer(RendererPtr renderer);
+
+			Ptr
+			removeRenderer(RendererPtr renderer);
+
+			inline
+			const std::vector<RendererPtr>&
+			renderers() const
+			{
+				return _renderers;
+			}
+
+			inline
+			std::shared_ptr<math::OcclusionBuffer>
+			occlusionBuffer() const
+			{
+				return _occlusionBuffer;
+			}
+
+			// the bounding boxes of the nodes in the frustum are drawn against the depth buffer of the
+			// previous frame: the results are read one or more frames later so the CPU never waits for the GPU
+			inline
+			bool
+			occlusionQueries() const
+			{
+				return _occlusionQueriesEnabled;
+			}
+
+			Ptr
+			occlusionQueries(bool enabled);
+
+			// the visible nodes are tested again every interval frames, the hidden ones every frame
+			inline
+			uint
+			occlusionQueryInterval() const
+			{
+				return _occlusionQueryInterval;
+			}
+
+			Ptr
+			occlusionQueryInterval(uint interval);
+
+			// testing smaller nodes would cost more than drawing them
+			inline
+			uint
+			occlusionQueryMinNumTriangles() const
+			{
+				return _occlusionQueryMinNumTriangles;
+			}
+
+			inline
+			Ptr
+			occlusionQueryMinNumTriangles(uint numTriangles)
+			{
+				_occlusionQueryMinNumTriangles = numTriangles;
+
+				return shared_from_this();
+			}
+
 		private:
 
 			void
@@ -83,6 +199,27 @@ namespace minko
 			void
 			worldToScreenChanged(std::shared_ptr<data::Container> data, const std::string& propertyName);
 
+			void
+			cull();
+
+			void
+			rasterizeOccluders();
+
+			void
+			setVisibility(NodePtr node, RendererPtr renderer, bool visible);
+
+			bool
+			occlusionQueryCandidate(NodePtr node);
+
+			void
+			issueOcclusionQueries(RendererPtr renderer);
+
+			void
+			drawBoundingBox(std::shared_ptr<render::AbstractContext> context, NodePtr node);
+
+			void
+			releaseOcclusionQueries(bool all);
+
 			void
 			targetAddedToScene(NodePtr node, NodePtr target, NodePtr ancestor);
 
@@ -54,6 +54,13 @@ namespace minko
 		    {
 		    }
 
+			inline
+			std::shared_ptr<math::Vector3>
+			worldDirection() const
+			{
+				return _worldDirection;
+			}
+
 		protected:
 			void
             updateModelToWorldMatrix(std::shared_ptr<math::Matrix4x4> modelToWorld);
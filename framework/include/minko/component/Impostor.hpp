@@ -0,0 +1,168 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include "minko/component/AbstractComponent.hpp"
+#include "minko/Signal.hpp"
+
+namespace minko
+{
+	namespace component
+	{
+		// replaces the Surface of the target by a camera facing quad once it covers less than screenSize of
+		// the viewport height; the quad shows one of numViews pictures of the surface taken around its up axis
+		// and baked side by side in an atlas, the one taken the closest to the direction of the camera
+		class Impostor :
+			public AbstractComponent,
+			public std::enable_shared_from_this<Impostor>
+		{
+		public:
+			typedef std::shared_ptr<Impostor>	Ptr;
+
+		private:
+			typedef std::shared_ptr<scene::Node>				NodePtr;
+			typedef std::shared_ptr<AbstractComponent>			AbsCmpPtr;
+			typedef std::shared_ptr<render::AbstractContext>	ContextPtr;
+			typedef std::shared_ptr<render::Effect>				EffectPtr;
+			typedef std::shared_ptr<render::Texture>			TexturePtr;
+
+		private:
+			ContextPtr								_context;
+			EffectPtr								_effect;
+			uint									_numViews;
+			uint									_viewSize;
+			float									_screenSize;
+
+			TexturePtr								_atlas;
+			std::shared_ptr<material::BasicMaterial>	_material;
+			std::shared_ptr<render::VertexBuffer>	_vertexBuffer;
+			std::shared_ptr<Surface>				_surface;
+			// model space bounding sphere of the baked surface
+			float									_center[3];
+			float									_radius;
+			bool									_active;
+			int										_view;
+
+			Signal<AbsCmpPtr, NodePtr>::Slot		_targetAddedSlot;
+			Signal<AbsCmpPtr, NodePtr>::Slot		_targetRemovedSlot;
+
+		public:
+			// the effect draws the quad, usually effect/Billboard.effect; the number of views and their
+			// size in pixels are powers of two
+			inline static
+			Ptr
+			create(ContextPtr	context,
+				   EffectPtr	effect,
+				   uint			numViews	= 8,
+				   uint			viewSize	= 128,
+				   float		screenSize	= .05f)
+			{
+				auto impostor = std::shared_ptr<Impostor>(new Impostor(context, effect, numViews, viewSize, screenSize));
+
+				impostor->initialize();
+
+				return impostor;
+			}
+
+			inline
+			uint
+			numViews() const
+			{
+				return _numViews;
+			}
+
+			inline
+			uint
+			viewSize() const
+			{
+				return _viewSize;
+			}
+
+			inline
+			float
+			screenSize() const
+			{
+				return _screenSize;
+			}
+
+			inline
+			Ptr
+			screenSize(float value)
+			{
+				_screenSize = value;
+
+				return shared_from_this();
+			}
+
+			// nullptr until the surface is baked
+			inline
+			TexturePtr
+			atlas() const
+			{
+				return _atlas;
+			}
+
+			// true while the quad is drawn instead of the surface
+			inline
+			bool
+			active() const
+			{
+				return _active;
+			}
+
+			// view of the atlas shown by the quad, -1 before the first update()
+			inline
+			int
+			view() const
+			{
+				return _view;
+			}
+
+			// renders the first Surface of the target into the atlas with its own material and effect,
+			// without lights; done by the first update() unless called at load time
+			void
+			bake();
+
+			// called by the Culling of the camera with the LOD of the target
+			void
+			update(std::shared_ptr<math::Vector3> eyePosition, float projectionScale);
+
+		private:
+			Impostor(ContextPtr context, EffectPtr effect, uint numViews, uint viewSize, float screenSize);
+
+			void
+			initialize();
+
+			void
+			targetAddedHandler(AbsCmpPtr cmp, NodePtr target);
+
+			void
+			targetRemovedHandler(AbsCmpPtr cmp, NodePtr target);
+
+			void
+			activate(bool active);
+
+			void
+			writeVertices(float scale);
+		};
+	}
+}
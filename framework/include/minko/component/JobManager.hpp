@@ -44,6 +44,11 @@ namespace minko
 			protected :
 				std::shared_ptr<JobManager>		_jobManager;
 				bool							_running;
+
+			private:
+				float							_priority;
+				uint							_order;
+				std::function<void()>			_asyncTask;
 				
 			public:
 
@@ -67,6 +72,14 @@ namespace minko
 				void
 				afterLastStep() = 0;
 
+				// lets a job with a budget of its own give the rest of the frame back
+				virtual
+				bool
+				yieldFrame()
+				{
+					return false;
+				}
+
 				inline
 				bool
 				running()
@@ -89,6 +102,15 @@ namespace minko
 				}
 			protected :
 				Job();
+
+				// called from step(): task runs on the thread pool of the default canvas and the job is not
+				// stepped again until it is done, without canvas the task runs right after the step
+				inline
+				void
+				runAsync(std::function<void()> task)
+				{
+					_asyncTask = task;
+				}
 			};
 
 		public:
@@ -97,11 +119,16 @@ namespace minko
 		private:
 			typedef std::shared_ptr<scene::Node> NodePtr;
 		
+		private:
+			typedef std::chrono::steady_clock	Clock;
+
 		private:
 			unsigned int			_loadingFramerate;
 			float					_frameTime;
-			std::vector<Job::Ptr>	_jobs;
-			clock_t					_frameStartTime;
+			std::vector<Job::Ptr>	_jobs; // heap, highest priority first
+			uint					_numPushedJobs;
+			uint					_numAsyncJobs;
+			Clock::time_point		_frameStartTime;
 
 		public:
 			static
@@ -115,9 +142,18 @@ namespace minko
 				return taskManager;
 			};
 
+			// the priority of the job is read once, jobs of equal priorities run in the order they are pushed
 			Ptr
 			pushJob(Job::Ptr task);
 
+			// pending jobs, including the ones running on the thread pool
+			inline
+			uint
+			numJobs() const
+			{
+				return _jobs.size() + _numAsyncJobs;
+			}
+
 			void
 			update(NodePtr target);
 
@@ -126,6 +162,16 @@ namespace minko
 
 		private:
 			JobManager(unsigned int loadingFramerate);
+
+			void
+			insertJob(Job::Ptr job);
+
+			void
+			removeJob(Job::Ptr job);
+
+			static
+			bool
+			lowerPriority(const Job::Ptr& a, const Job::Ptr& b);
 		};
 	}
 }
\ No newline at end of file
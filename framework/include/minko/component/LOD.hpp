@@ -0,0 +1,143 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include "minko/component/AbstractComponent.hpp"
+#include "minko/Signal.hpp"
+
+namespace minko
+{
+	namespace component
+	{
+		// switches the geometry of the target's Surface according to the fraction of the viewport height
+		// covered by its bounding sphere, levels are selected by the Culling of the camera
+		class LOD :
+			public AbstractComponent,
+			public std::enable_shared_from_this<LOD>
+		{
+		public:
+			typedef std::shared_ptr<LOD>	Ptr;
+
+		private:
+			typedef std::shared_ptr<scene::Node>			NodePtr;
+			typedef std::shared_ptr<AbstractComponent>		AbsCmpPtr;
+			typedef std::shared_ptr<geometry::Geometry>		GeometryPtr;
+			typedef std::pair<float, GeometryPtr>			Level;
+
+		private:
+			// sorted by decreasing screen size
+			std::vector<Level>						_levels;
+			int										_level;
+
+			std::shared_ptr<Signal<Ptr, uint>>		_levelChanged;
+
+			Signal<AbsCmpPtr, NodePtr>::Slot		_targetAddedSlot;
+			Signal<AbsCmpPtr, NodePtr>::Slot		_targetRemovedSlot;
+
+		public:
+			inline static
+			Ptr
+			create()
+			{
+				auto lod = std::shared_ptr<LOD>(new LOD());
+
+				lod->initialize();
+
+				return lod;
+			}
+
+			// builds numLevels levels by simplifying geometry, each one with ratio times the triangles of the
+			// previous one and drawn below ratio times its screen size
+			static
+			Ptr
+			create(GeometryPtr geometry, uint numLevels, float ratio = .5f, float screenSize = .5f);
+
+			// geometry is drawn while the target covers at least screenSize of the viewport height
+			Ptr
+			addLevel(GeometryPtr geometry, float screenSize);
+
+			inline
+			uint
+			numLevels() const
+			{
+				return _levels.size();
+			}
+
+			inline
+			GeometryPtr
+			levelGeometry(uint level) const
+			{
+				return _levels[level].second;
+			}
+
+			inline
+			float
+			levelScreenSize(uint level) const
+			{
+				return _levels[level].first;
+			}
+
+			inline
+			int
+			level() const
+			{
+				return _level;
+			}
+
+			void
+			level(uint value);
+
+			inline
+			std::shared_ptr<Signal<Ptr, uint>>
+			levelChanged() const
+			{
+				return _levelChanged;
+			}
+
+			// fraction of the viewport height covered by the BoundingBox of the target
+			float
+			screenSize(std::shared_ptr<math::Vector3> eyePosition, float projectionScale);
+
+			static
+			float
+			screenSize(NodePtr target, std::shared_ptr<math::Vector3> eyePosition, float projectionScale);
+
+			void
+			update(std::shared_ptr<math::Vector3> eyePosition, float projectionScale);
+
+		private:
+			LOD();
+
+			void
+			initialize();
+
+			void
+			targetAddedHandler(AbsCmpPtr cmp, NodePtr target);
+
+			void
+			targetRemovedHandler(AbsCmpPtr cmp, NodePtr target);
+
+			void
+			applyLevel();
+		};
+	}
+}
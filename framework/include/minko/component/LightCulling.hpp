@@ -0,0 +1,175 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include "minko/component/AbstractComponent.hpp"
+#include "minko/component/Transform.hpp"
+#include "minko/Signal.hpp"
+
+namespace minko
+{
+	namespace component
+	{
+		// Binds to each Surface node below the target the point and spot lights that contribute
+		// the most to it, in a fixed number of "localPointLights" and "localSpotLights" slots read by
+		// the "*-light-culling" techniques of Phong.effect. Lights are bounded by the sphere past which
+		// their attenuation reaches zero and tested against the world bounding boxes of the surfaces
+		// in an octree. Empty slots hold black lights so that the shaders never have to be recompiled.
+		class LightCulling :
+			public AbstractComponent,
+			public std::enable_shared_from_this<LightCulling>
+		{
+		public:
+			typedef std::shared_ptr<LightCulling>	Ptr;
+
+		private:
+			typedef std::shared_ptr<scene::Node>					NodePtr;
+			typedef std::shared_ptr<AbstractComponent>				AbsCtrlPtr;
+			typedef std::shared_ptr<SceneManager>					SceneManagerPtr;
+			typedef std::shared_ptr<data::ArrayProvider>			ArrayProviderPtr;
+			typedef std::shared_ptr<math::Vector3>					Vector3Ptr;
+			typedef std::vector<std::pair<float, uint>>				Candidates;
+
+			struct SurfaceLights
+			{
+				std::vector<ArrayProviderPtr>				pointLightSlots;
+				std::vector<ArrayProviderPtr>				spotLightSlots;
+				// light bound to each slot, nullptr for an empty slot
+				std::vector<std::shared_ptr<PointLight>>	pointLights;
+				std::vector<std::shared_ptr<SpotLight>>		spotLights;
+				Candidates									pointCandidates;
+				Candidates									spotCandidates;
+			};
+
+		public:
+			static const uint									MAX_NUM_POINT_LIGHTS;
+			static const uint									MAX_NUM_SPOT_LIGHTS;
+
+		private:
+			std::shared_ptr<math::OctTree>						_octTree;
+			std::vector<std::shared_ptr<PointLight>>			_pointLights;
+			std::vector<std::shared_ptr<SpotLight>>				_spotLights;
+			std::unordered_map<NodePtr, SurfaceLights>			_surfaces;
+			std::vector<NodePtr>								_hits;
+			std::vector<std::shared_ptr<PointLight>>			_selectedPointLights;
+			std::vector<std::shared_ptr<SpotLight>>				_selectedSpotLights;
+			bool												_invalidBindings;
+
+			Vector3Ptr											_emptyColor;
+			Vector3Ptr											_emptyAttenuation;
+			Vector3Ptr											_emptyPosition;
+			Vector3Ptr											_emptyDirection;
+
+			Signal<AbsCtrlPtr, NodePtr>::Slot					_targetAddedSlot;
+			Signal<AbsCtrlPtr, NodePtr>::Slot					_targetRemovedSlot;
+			Signal<NodePtr, NodePtr, NodePtr>::Slot				_addedSlot;
+			Signal<NodePtr, NodePtr, NodePtr>::Slot				_removedSlot;
+			Signal<NodePtr, NodePtr, AbsCtrlPtr>::Slot			_componentAddedSlot;
+			Signal<NodePtr, NodePtr, AbsCtrlPtr>::Slot			_componentRemovedSlot;
+			Signal<SceneManagerPtr>::Slot						_cullingBeginSlot;
+			Transform::RootTransform::ModelToWorldChangedSignal::Slot	_modelToWorldChangedSlot;
+
+		public:
+			inline static
+			Ptr
+			create()
+			{
+				Ptr lightCulling = std::shared_ptr<LightCulling>(new LightCulling());
+
+				lightCulling->initialize();
+
+				return lightCulling;
+			}
+
+			inline
+			uint
+			numSurfaces() const
+			{
+				return _surfaces.size();
+			}
+
+			// lights bound to the slots of the node, nullptr for the empty slots
+			std::shared_ptr<PointLight>
+			pointLight(NodePtr node, uint slot) const;
+
+			std::shared_ptr<SpotLight>
+			spotLight(NodePtr node, uint slot) const;
+
+			// called before each culling of the scene of the target
+			void
+			update();
+
+			// distance past which a light with those attenuation coefficients has no effect, FLT_MAX if none
+			static
+			float
+			range(Vector3Ptr attenuationCoeffs);
+
+		private:
+			LightCulling();
+
+			void
+			initialize();
+
+			void
+			targetAddedHandler(AbsCtrlPtr ctrl, NodePtr target);
+
+			void
+			targetRemovedHandler(AbsCtrlPtr ctrl, NodePtr target);
+
+			void
+			componentAddedHandler(NodePtr node, NodePtr target, AbsCtrlPtr ctrl);
+
+			void
+			componentRemovedHandler(NodePtr node, NodePtr target, AbsCtrlPtr ctrl);
+
+			void
+			setSceneManager(SceneManagerPtr sceneManager);
+
+			void
+			bind();
+
+			void
+			addSurface(NodePtr node);
+
+			void
+			removeSurface(NodePtr node);
+
+			void
+			unbind();
+
+			template <typename L>
+			void
+			addCandidates(const std::vector<std::shared_ptr<L>>& lights, Candidates SurfaceLights::* candidates);
+
+			void
+			assignPointLight(SurfaceLights& surface, uint slot, std::shared_ptr<PointLight> light);
+
+			void
+			assignSpotLight(SurfaceLights& surface, uint slot, std::shared_ptr<SpotLight> light);
+
+			static
+			float
+			attenuation(Vector3Ptr attenuationCoeffs, float distance);
+		};
+	}
+}
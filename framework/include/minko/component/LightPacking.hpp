@@ -0,0 +1,124 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include "minko/component/AbstractComponent.hpp"
+#include "minko/Signal.hpp"
+
+namespace minko
+{
+	namespace component
+	{
+		// Packs the lights of the scene every frame into the flat vec4 arrays of the "packedLights"
+		// provider of the root, so that the PACKED_LIGHTS variants of Phong.effect upload each type
+		// of light with a single glUniform4fv instead of one call per member of each light.
+		// Layout, in vec4s per light:
+		// - ambient:		[color, ambient]
+		// - directional:	[color, diffuse] [direction, specular]
+		// - point:			[color, diffuse] [position, specular] [attenuationCoeffs, 0]
+		// - spot:			[color, diffuse] [position, specular] [attenuationCoeffs, cosInnerConeAngle] [direction, cosOuterConeAngle]
+		class LightPacking :
+			public AbstractComponent,
+			public std::enable_shared_from_this<LightPacking>
+		{
+		public:
+			typedef std::shared_ptr<LightPacking>	Ptr;
+
+		private:
+			typedef std::shared_ptr<scene::Node>					NodePtr;
+			typedef std::shared_ptr<AbstractComponent>				AbsCtrlPtr;
+			typedef std::shared_ptr<SceneManager>					SceneManagerPtr;
+
+		public:
+			static const uint									AMBIENT_LIGHT_SIZE;
+			static const uint									DIRECTIONAL_LIGHT_SIZE;
+			static const uint									POINT_LIGHT_SIZE;
+			static const uint									SPOT_LIGHT_SIZE;
+
+		private:
+			std::shared_ptr<data::StructureProvider>			_data;
+			NodePtr												_root;
+
+			std::vector<std::shared_ptr<AmbientLight>>			_ambientLights;
+			std::vector<std::shared_ptr<DirectionalLight>>		_directionalLights;
+			std::vector<std::shared_ptr<PointLight>>			_pointLights;
+			std::vector<std::shared_ptr<SpotLight>>				_spotLights;
+			bool												_invalidLights;
+
+			std::vector<float>									_ambient;
+			std::vector<float>									_directional;
+			std::vector<float>									_point;
+			std::vector<float>									_spot;
+
+			Signal<AbsCtrlPtr, NodePtr>::Slot					_targetAddedSlot;
+			Signal<AbsCtrlPtr, NodePtr>::Slot					_targetRemovedSlot;
+			Signal<NodePtr, NodePtr, NodePtr>::Slot				_targetAddedToNodeSlot;
+			Signal<NodePtr, NodePtr, NodePtr>::Slot				_targetRemovedFromNodeSlot;
+			Signal<NodePtr, NodePtr, NodePtr>::Slot				_addedSlot;
+			Signal<NodePtr, NodePtr, NodePtr>::Slot				_removedSlot;
+			Signal<NodePtr, NodePtr, AbsCtrlPtr>::Slot			_componentAddedSlot;
+			Signal<NodePtr, NodePtr, AbsCtrlPtr>::Slot			_componentRemovedSlot;
+			Signal<SceneManagerPtr>::Slot						_cullingBeginSlot;
+
+		public:
+			inline static
+			Ptr
+			create()
+			{
+				Ptr lightPacking = std::shared_ptr<LightPacking>(new LightPacking());
+
+				lightPacking->initialize();
+
+				return lightPacking;
+			}
+
+			// called before each culling of the scene of the target
+			void
+			update();
+
+		private:
+			LightPacking();
+
+			void
+			initialize();
+
+			void
+			targetAddedHandler(AbsCtrlPtr ctrl, NodePtr target);
+
+			void
+			targetRemovedHandler(AbsCtrlPtr ctrl, NodePtr target);
+
+			void
+			setRoot(NodePtr root);
+
+			void
+			setSceneManager(SceneManagerPtr sceneManager);
+
+			void
+			bindLights();
+
+			void
+			publish(const std::string& propertyName, std::vector<float>& values);
+		};
+	}
+}
@@ -22,6 +22,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/Common.hpp"
 #include "minko/Signal.hpp"
 #include "minko/component/AbstractComponent.hpp"
+#include "minko/component/Transform.hpp"
 #include "minko/data/ArrayProvider.hpp"
 
 namespace minko
@@ -46,6 +47,20 @@ namespace minko
 			typedef std::shared_ptr<data::ArrayProvider>		ArrayProviderPtr;
 			typedef std::shared_ptr<data::StructureProvider>	StructureProviderPtr;
 			typedef std::shared_ptr<AbstractCanvas>				AbstractCanvasPtr;
+			typedef Signal<Ptr, const std::vector<NodePtr>&>	AreaPickedSignal;
+
+			// number of frames between a read back and its resolution when pixel buffers are supported
+			static const uint									PIXEL_BUFFER_RING_SIZE = 3;
+
+		private:
+			struct Readback
+			{
+				uint	pixelBuffer;
+				uint	size;
+				uint	numPixels;
+				bool	pending;
+				bool	area;
+			};
 
 		private:
 			TexturePtr									_renderTarget;
@@ -79,6 +94,22 @@ namespace minko
 			unsigned char								_lastColor[4];
 			SurfacePtr									_lastPickedSurface;
 
+			std::vector<Readback>						_readbacks;
+			uint										_readbackIndex;
+			std::vector<unsigned char>					_pixels;
+			bool										_areaRequested;
+			bool										_renderingArea;
+			uint										_areaX;
+			uint										_areaY;
+			uint										_areaWidth;
+			uint										_areaHeight;
+			render::ScissorBox							_readRegion;
+			std::shared_ptr<AreaPickedSignal>			_areaPicked;
+			bool										_frameRendered;
+
+			Signal<SceneManagerPtr, float, float>::Slot							_frameEndSlot;
+			Transform::RootTransform::ModelToWorldChangedSignal::Slot			_modelToWorldChangedSlot;
+
 			Signal<MousePtr, int, int>::Slot			_mouseMoveSlot;
 			Signal<MousePtr>::Slot						_mouseRightClickSlot;
 			Signal<MousePtr>::Slot						_mouseLeftClickSlot;
@@ -137,6 +168,23 @@ namespace minko
 				return _lastPickedSurface;
 			}
 
+			// nodes with a surface visible in the area, in pixels from the top left corner of the viewport
+			inline
+			std::shared_ptr<AreaPickedSignal>
+			areaPicked()
+			{
+				return _areaPicked;
+			}
+
+			void
+			pickArea(uint x, uint y, uint width, uint height);
+
+			// the picking pass only renders when the mouse or a transform moved, forces it to render next frame
+			void
+			invalidate();
+
+			~Picking();
+
 		private:
 
 			void
@@ -172,6 +220,12 @@ namespace minko
 			void
 			renderingEnd(RendererPtr renderer);
 
+			void
+			resolve(Readback& readback);
+
+			void
+			frameEndHandler(SceneManagerPtr sceneManager, float time, float deltaTime);
+
 			Picking(SceneManagerPtr sceneManager, AbstractCanvasPtr canvas, NodePtr camera);
 
 			void
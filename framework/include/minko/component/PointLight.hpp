@@ -63,6 +63,13 @@ namespace minko
 		    {
 		    }
 
+			inline
+			std::shared_ptr<math::Vector3>
+			worldPosition() const
+			{
+				return _worldPosition;
+			}
+
 			bool
 			attenuationEnabled() const;
 
@@ -0,0 +1,274 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include "minko/component/AbstractComponent.hpp"
+#include "minko/render/CubeTexture.hpp"
+#include "minko/Signal.hpp"
+
+namespace minko
+{
+	namespace component
+	{
+		// Renders the scene seen from the target into a CubeTexture, to be set as the environmentCubemap of
+		// the reflecting materials. Each face is drawn by a Renderer of its own into a pooled render target
+		// then copied into the cube texture, only with the surfaces in the frustum of the face. A dynamic
+		// probe refreshes a few faces per frame in turn, and less often when it is far from the camera or of
+		// little importance: reflections cost a fraction of a scene render per frame. A static probe renders
+		// its six faces once, then again only when it moves or when invalidate() is called.
+		class ReflectionProbe :
+			public AbstractComponent,
+			public std::enable_shared_from_this<ReflectionProbe>
+		{
+		public:
+			typedef std::shared_ptr<ReflectionProbe>	Ptr;
+
+		private:
+			typedef std::shared_ptr<scene::Node>					NodePtr;
+			typedef std::shared_ptr<AbstractComponent>				AbsCtrlPtr;
+			typedef std::shared_ptr<SceneManager>					SceneManagerPtr;
+			typedef std::shared_ptr<render::Texture>				TexturePtr;
+			typedef std::shared_ptr<render::CubeTexture>			CubeTexturePtr;
+			typedef std::shared_ptr<render::RenderTargetPool>		RenderTargetPoolPtr;
+			typedef std::shared_ptr<math::Matrix4x4>				Matrix4x4Ptr;
+			typedef Signal<SceneManagerPtr, uint, std::shared_ptr<render::AbstractTexture>>	RenderingBeginSignal;
+
+			struct Face
+			{
+				NodePtr									node;
+				std::shared_ptr<Renderer>				renderer;
+				std::shared_ptr<data::StructureProvider>	camera;
+				Matrix4x4Ptr							view;
+				Matrix4x4Ptr							viewProjection;
+				std::shared_ptr<math::Frustum>			frustum;
+				// acquired from the pool until the face is copied into the cube texture
+				TexturePtr								target;
+				bool									invalid;
+				Signal<std::shared_ptr<Renderer>>::Slot	beforePresentSlot;
+			};
+
+		public:
+			static const uint									NUM_FACES;
+
+		private:
+			std::shared_ptr<render::AbstractContext>			_context;
+			uint												_size;
+			RenderTargetPoolPtr									_renderTargets;
+			CubeTexturePtr										_texture;
+			bool												_dynamic;
+			uint												_numFacesPerUpdate;
+			float												_importance;
+			float												_updateDistance;
+			NodePtr												_camera;
+			float												_zFar;
+			uint												_layoutMask;
+
+			std::shared_ptr<math::Vector3>						_position;
+			Matrix4x4Ptr										_projection;
+			std::vector<Face>									_faces;
+			uint												_nextFace;
+			// updates earned by the dynamic probe, it refreshes faces when it reaches 1
+			float												_credit;
+			uint												_numRenderedFaces;
+
+			NodePtr												_root;
+			std::vector<NodePtr>								_surfaceNodes;
+			bool												_invalidSurfaces;
+
+			Signal<AbsCtrlPtr, NodePtr>::Slot					_targetAddedSlot;
+			Signal<AbsCtrlPtr, NodePtr>::Slot					_targetRemovedSlot;
+			Signal<NodePtr, NodePtr, NodePtr>::Slot				_targetAddedToNodeSlot;
+			Signal<NodePtr, NodePtr, NodePtr>::Slot				_targetRemovedFromNodeSlot;
+			Signal<NodePtr, NodePtr, NodePtr>::Slot				_addedSlot;
+			Signal<NodePtr, NodePtr, NodePtr>::Slot				_removedSlot;
+			Signal<NodePtr, NodePtr, AbsCtrlPtr>::Slot			_componentAddedSlot;
+			Signal<NodePtr, NodePtr, AbsCtrlPtr>::Slot			_componentRemovedSlot;
+			RenderingBeginSignal::Slot							_renderingBeginSlot;
+
+		public:
+			// the render targets of the faces are acquired from renderTargets when given, usually the pool
+			// of the RenderGraph, and from a pool of the probe otherwise
+			inline static
+			Ptr
+			create(std::shared_ptr<render::AbstractContext>	context,
+				   uint										size			= 256,
+				   RenderTargetPoolPtr						renderTargets	= nullptr)
+			{
+				Ptr probe = std::shared_ptr<ReflectionProbe>(new ReflectionProbe(context, size, renderTargets));
+
+				probe->initialize();
+
+				return probe;
+			}
+
+			inline
+			CubeTexturePtr
+			texture() const
+			{
+				return _texture;
+			}
+
+			inline
+			uint
+			size() const
+			{
+				return _size;
+			}
+
+			inline
+			bool
+			dynamic() const
+			{
+				return _dynamic;
+			}
+
+			Ptr
+			dynamic(bool dynamic);
+
+			// faces refreshed by each update of a dynamic probe
+			inline
+			uint
+			numFacesPerUpdate() const
+			{
+				return _numFacesPerUpdate;
+			}
+
+			Ptr
+			numFacesPerUpdate(uint numFaces);
+
+			// updates per frame of a dynamic probe within updateDistance() of the camera, 1 by default
+			inline
+			float
+			importance() const
+			{
+				return _importance;
+			}
+
+			Ptr
+			importance(float importance);
+
+			// beyond this distance from the camera, the updates are spaced out in proportion to the distance
+			inline
+			float
+			updateDistance() const
+			{
+				return _updateDistance;
+			}
+
+			inline
+			Ptr
+			updateDistance(float updateDistance)
+			{
+				_updateDistance = updateDistance;
+
+				return shared_from_this();
+			}
+
+			// the node of the camera the distance is measured from, none to ignore the distance
+			inline
+			NodePtr
+			camera() const
+			{
+				return _camera;
+			}
+
+			inline
+			Ptr
+			camera(NodePtr camera)
+			{
+				_camera = camera;
+
+				return shared_from_this();
+			}
+
+			// distance up to which the surfaces are rendered in the faces
+			inline
+			float
+			zFar() const
+			{
+				return _zFar;
+			}
+
+			Ptr
+			zFar(float zFar);
+
+			// only the surfaces of the nodes in one of these layouts are rendered in the faces
+			inline
+			uint
+			layoutMask() const
+			{
+				return _layoutMask;
+			}
+
+			Ptr
+			layoutMask(uint layoutMask);
+
+			// renders the six faces again during the next update
+			Ptr
+			invalidate();
+
+			// faces rendered during the last update
+			inline
+			uint
+			numRenderedFaces() const
+			{
+				return _numRenderedFaces;
+			}
+
+			// called when a frame begins to be rendered, once the world matrices of the frame are up to date
+			void
+			update();
+
+		private:
+			ReflectionProbe(std::shared_ptr<render::AbstractContext>	context,
+							uint										size,
+							RenderTargetPoolPtr							renderTargets);
+
+			void
+			initialize();
+
+			void
+			targetAddedHandler(AbsCtrlPtr ctrl, NodePtr target);
+
+			void
+			targetRemovedHandler(AbsCtrlPtr ctrl, NodePtr target);
+
+			void
+			setRoot(NodePtr root);
+
+			void
+			setSceneManager(SceneManagerPtr sceneManager);
+
+			void
+			bindSurfaces();
+
+			bool
+			placeFaces();
+
+			void
+			render(uint faceId);
+
+			void
+			copyFace(uint faceId);
+		};
+	}
+}
@@ -21,6 +21,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/Common.hpp"
 #include "minko/component/AbstractComponent.hpp"
+#include "minko/render/DrawCall.hpp"
+#include "minko/render/RenderStats.hpp"
 
 namespace minko
 {
@@ -33,6 +35,15 @@ namespace minko
 		public:
 			typedef std::shared_ptr<Renderer>							Ptr;
 
+			// the matrices replace the ones of the camera of the renderer while the view is drawn, the
+			// projection mapping the view to its region of the render target
+			struct View
+			{
+				render::ScissorBox					region;
+				std::shared_ptr<math::Matrix4x4>	viewMatrix;
+				std::shared_ptr<math::Matrix4x4>	projectionMatrix;
+			};
+
 		private:
 			typedef std::shared_ptr<scene::Node>						NodePtr;
 			typedef std::shared_ptr<AbstractComponent>					AbsCtrlPtr;
@@ -40,6 +51,7 @@ namespace minko
 			typedef std::shared_ptr<Surface>							SurfacePtr;
 			typedef std::shared_ptr<render::DrawCall>					DrawCallPtr;
 			typedef std::list<DrawCallPtr>								DrawCallList;
+			typedef std::vector<DrawCallPtr>							DrawCallQueue;
 			typedef std::shared_ptr<SceneManager>						SceneManagerPtr;
 			typedef std::shared_ptr<render::AbstractTexture>			AbsTexturePtr;
 			typedef std::shared_ptr<render::Effect>						EffectPtr;
@@ -47,7 +59,12 @@ namespace minko
 			typedef Signal<SurfacePtr, const std::string&, bool>::Slot	SurfaceTechniqueChangedSlot;
 
 		private:
-			DrawCallList												_drawCalls;
+			// owned by the draw call pool, not copied every frame
+			const DrawCallQueue*										_drawCalls;
+			// enabled draw calls of the frame and their changes compared to the previous one
+			std::vector<render::DrawCall*>								_submittedDrawCalls;
+			std::vector<render::DrawCall::Changes>						_drawCallChanges;
+			unsigned int												_numWorkers;
 			std::unordered_map<SurfacePtr, DrawCallList>				_surfaceDrawCalls; 
 
 			unsigned int												_backgroundColor;
@@ -60,6 +77,34 @@ namespace minko
 			std::set<std::shared_ptr<Surface>>							_toCollect;
 			EffectPtr													_effect;
 			float														_priority;
+			bool														_instancing;
+			bool														_instancingEnabled;
+			bool														_enabled;
+			bool														_scissorTest;
+			render::ScissorBox											_scissorBox;
+			std::shared_ptr<data::StructureProvider>					_instancingData;
+			bool														_frontToBack;
+			uint														_layoutMask;
+			std::vector<unsigned char>									_layoutTests;
+			EffectPtr													_depthPrePassEffect;
+			DrawCallFactoryPtr											_depthPrePassPool;
+			std::vector<render::DrawCall*>								_depthPrePassDrawCalls;
+			// created once the Profiler or the dynamic resolution is enabled, if the context supports timer queries
+			std::shared_ptr<render::GPUTimer>							_gpuTimer;
+			std::shared_ptr<render::DynamicResolution>					_dynamicResolution;
+			// full-screen quad upscaling the offscreen target of the dynamic resolution
+			NodePtr														_upscaleQuad;
+			std::shared_ptr<math::Matrix4x4>							_scaledProjection;
+			// frame times are measured between the calls to render() without timer queries
+			unsigned long long											_lastRenderTime;
+			// false for the renderers drawing as a part of another one, which presents the frame
+			bool														_present;
+			render::RenderStats											_renderStats;
+			std::vector<View>											_views;
+			// world to screen matrix of each view, updated before each render()
+			std::vector<std::shared_ptr<math::Matrix4x4>>				_viewWorldToScreen;
+			// view, projection and world to screen matrices of the camera, overwritten by the views
+			std::vector<std::shared_ptr<math::Matrix4x4>>				_cameraMatrices;
 
 
 			Signal<AbsCtrlPtr, NodePtr>::Slot							_targetAddedSlot;
@@ -76,6 +121,7 @@ namespace minko
 			DrawCallFactoryPtr											_drawCallPool;
 
 			static const unsigned int									NUM_FALLBACK_ATTEMPTS;
+			static const unsigned int									PARALLEL_RECORD_MIN_NUM_DRAWCALLS = 1024;
 
 		public:
 			inline static
@@ -119,9 +165,120 @@ namespace minko
 			unsigned int
 			numDrawCalls()
 			{
-				return _drawCalls.size();
+				return _drawCalls ? _drawCalls->size() : 0;
+			}
+
+			// GL calls issued by the context during the last render()
+			inline
+			const render::RenderStats&
+			renderStats() const
+			{
+				return _renderStats;
+			}
+
+			inline
+			bool
+			instancing() const
+			{
+				return _instancing;
+			}
+
+			// when supported by the context, surfaces sharing the same geometry and material are
+			// drawn with a single instanced draw call (effects opt in with the INSTANCING macro)
+			inline
+			void
+			instancing(bool value)
+			{
+				_instancing = value;
+			}
+
+			inline
+			bool
+			frontToBack() const
+			{
+				return _frontToBack;
+			}
+
+			// sorts the opaque draw calls of each priority by coarse view depth buckets, nearest first
+			void
+			frontToBack(bool value);
+
+			inline
+			uint
+			layoutMask() const
+			{
+				return _layoutMask;
+			}
+
+			// only the surfaces of the nodes in one of these layouts are drawn, the draw calls are
+			// filtered when the frame is submitted: showing or hiding a layout does not touch the scene
+			inline
+			void
+			layoutMask(uint value)
+			{
+				_layoutMask = value;
+			}
+
+			inline
+			EffectPtr
+			depthPrePass() const
+			{
+				return _depthPrePassEffect;
+			}
+
+			// the opaque surfaces are first rendered with this depth-only effect so that the fragments
+			// hidden behind them are not shaded: their effects should test depth with "less_equal"
+			void
+			depthPrePass(EffectPtr effect);
+
+			// a disabled renderer does not render when the scene manager renders a frame
+			inline
+			bool
+			enabled() const
+			{
+				return _enabled;
+			}
+
+			inline
+			void
+			enabled(bool value)
+			{
+				_enabled = value;
+			}
+
+			// restricts the whole rendering, clear included, to a region in pixels from the bottom left corner
+			inline
+			void
+			scissor(bool scissorTest, const render::ScissorBox& scissorBox = render::ScissorBox())
+			{
+				_scissorTest = scissorTest;
+				_scissorBox = scissorBox;
+			}
+
+			inline
+			const std::vector<View>&
+			views() const
+			{
+				return _views;
 			}
 
+			// stereo or multi-view rendering: the draw calls are recorded once and each of them is issued
+			// for every view back to back, the camera position is left unchanged
+			void
+			views(const std::vector<View>& views);
+
+			inline
+			std::shared_ptr<render::DynamicResolution>
+			dynamicResolution() const
+			{
+				return _dynamicResolution;
+			}
+
+			// when rendering to the back buffer, the scene is first drawn to an offscreen target at the scale of
+			// the dynamic resolution and then upscaled, the scale following the GPU time of the renderer
+			void
+			dynamicResolution(std::shared_ptr<render::DynamicResolution> value);
+
 			inline
 			unsigned int
 			backgroundColor()
@@ -150,9 +307,11 @@ namespace minko
 				_renderTarget = target;
 			}
 
+			// without clear, the draw calls are added to what was already rendered in the bound render target
 			void
 			render(std::shared_ptr<render::AbstractContext> context,
-				   AbsTexturePtr 		renderTarget = nullptr);
+				   AbsTexturePtr 		renderTarget	= nullptr,
+				   bool					clear			= true);
 
 			inline
 			Signal<Ptr>::Ptr
@@ -213,6 +372,32 @@ namespace minko
 			void
 			removeSurface(SurfacePtr);
 
+			void
+			recordDrawCallChanges(const AbsTexturePtr& renderTarget);
+
+			void
+			renderDepthPrePass(const AbsContext&		context,
+							   const AbsTexturePtr&		renderTarget,
+							   const render::ScissorBox*	scissorBox);
+
+			void
+			renderDrawCall(const AbsContext&			context,
+						   const AbsTexturePtr&			renderTarget,
+						   uint							drawCallIndex,
+						   const render::ScissorBox*	scissorBox);
+
+			void
+			renderViews(const AbsContext& context, const AbsTexturePtr& renderTarget, uint drawCallIndex);
+
+			void
+			updateDynamicResolution(const AbsContext& context, render::GPUTimer* gpuTimer);
+
+			render::ScissorBox
+			scaleCamera(const AbsTexturePtr& renderTarget, std::vector<float>& cameraMatrices);
+
+			void
+			upscale(const AbsContext& context, const AbsTexturePtr& renderTarget);
+
 			void
 			geometryChanged(SurfacePtr ctrl);
 
@@ -227,6 +412,9 @@ namespace minko
 			void
 			findSceneManager();
 
+			void
+			enableInstancing(bool enabled);
+
 			void
 			setSceneManager(std::shared_ptr<SceneManager> sceneManager);
 		};
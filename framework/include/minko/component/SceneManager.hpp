@@ -23,6 +23,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/component/AbstractComponent.hpp"
 #include "minko/Signal.hpp"
+#include "minko/render/RenderStats.hpp"
 
 namespace minko
 {
@@ -34,15 +35,27 @@ namespace minko
 	    {
 	    public:
 		    typedef std::shared_ptr<SceneManager> Ptr;
+            typedef std::pair<std::shared_ptr<scene::Node>, float>   RaycastHit;
 
         private:
             typedef std::shared_ptr<scene::Node>				NodePtr;
 			typedef std::shared_ptr<render::AbstractTexture>	AbsTexturePtr;
+            typedef Signal<std::shared_ptr<data::Provider>, const std::string&>::Slot  MaterialPropertyChangedSlot;
 
         private:
             uint                                            _frameId;
             float                                           _time;
+            bool                                            _pipelined;
+            bool                                            _nextFrameSimulated;
             std::shared_ptr<file::AssetLibrary>             _assets;
+            std::shared_ptr<math::OctTree>                  _octTree;
+            std::vector<std::pair<float, NodePtr>>          _rayCandidates;
+            std::shared_ptr<async::SystemScheduler>         _systems;
+
+            float                                           _animationTime;
+            uint                                            _numAnimationUpdates;
+            uint                                            _numSkippedAnimationUpdates;
+            render::RenderStats                             _renderStats;
 
             Signal<Ptr, float, float>::Ptr                  _frameBegin;
             Signal<Ptr, float, float>::Ptr                  _frameEnd;
@@ -54,6 +67,13 @@ namespace minko
             Signal<AbstractComponent::Ptr, NodePtr>::Slot   _targetAddedSlot;
             Signal<AbstractComponent::Ptr, NodePtr>::Slot   _targetRemovedSlot;
             Signal<NodePtr, NodePtr, NodePtr>::Slot         _addedSlot;
+            Signal<NodePtr, NodePtr, NodePtr>::Slot         _removedSlot;
+            Signal<NodePtr, NodePtr, AbstractComponent::Ptr>::Slot  _componentAddedSlot;
+            Signal<NodePtr, NodePtr, AbstractComponent::Ptr>::Slot  _componentRemovedSlot;
+            // matrix changes of the transforms, material changes of the surfaces and property changes of their materials
+            std::unordered_map<AbstractComponent::Ptr, Signal<std::shared_ptr<data::Value>>::Slot>  _matrixChangedSlots;
+            std::unordered_map<AbstractComponent::Ptr, Signal<std::shared_ptr<Surface>>::Slot>      _materialChangedSlots;
+            std::unordered_map<AbstractComponent::Ptr, std::list<MaterialPropertyChangedSlot>>      _materialPropertyChangedSlots;
 
 	    public:
 		    inline static
@@ -85,6 +105,22 @@ namespace minko
                 return _assets;
             }
 
+            // spatial index shared by every Culling of the scene, grows with the scene bounds
+            inline
+            std::shared_ptr<math::OctTree>
+            octTree()
+            {
+                return _octTree;
+            }
+
+            // executed right after frameBegin, set its thread pool for independent systems to run concurrently
+            inline
+            std::shared_ptr<async::SystemScheduler>
+            systems() const
+            {
+                return _systems;
+            }
+
             inline
             Signal<Ptr, float, float>::Ptr
             frameBegin() const
@@ -134,12 +170,83 @@ namespace minko
                 return _time; // in milliseconds
             }
 
+            // time spent evaluating animations during the last simulated frame, in milliseconds
+            inline
+            float
+            animationTime() const
+            {
+                return _animationTime;
+            }
+
+            inline
+            uint
+            numAnimationUpdates() const
+            {
+                return _numAnimationUpdates;
+            }
+
+            // animations which only advanced their time, because they were culled or throttled
+            inline
+            uint
+            numSkippedAnimationUpdates() const
+            {
+                return _numSkippedAnimationUpdates;
+            }
+
+            // GL calls issued by the context during the last nextFrame()
+            inline
+            const render::RenderStats&
+            renderStats() const
+            {
+                return _renderStats;
+            }
+
+            inline
+            void
+            animationUpdated(float time)
+            {
+                _animationTime += time;
+                ++_numAnimationUpdates;
+
+                invalidate();
+            }
+
+            // marks the scene as changed: a canvas rendering on demand will execute the next frame
+            void
+            invalidate();
+
+            inline
+            void
+            animationSkipped()
+            {
+                ++_numSkippedAnimationUpdates;
+            }
+
+            inline
+            bool
+            pipelined() const
+            {
+                return _pipelined;
+            }
+
+            // when pipelined, frame N+1 is simulated (frameBegin) right after frame N is submitted and
+            // before it is presented, so the simulation overlaps the GPU work at the cost of one frame of latency
+            void
+            pipelined(bool value);
+
             void
             initialize();
 
             void
             nextFrame(float time, float deltaTime, AbsTexturePtr target = nullptr);
 
+            // closest hits first, only the nodes indexed by the octree are tested (see Culling)
+            uint
+            raycast(std::shared_ptr<math::Ray>   ray,
+                    std::vector<RaycastHit>&     hits,
+                    uint                         layoutMask = 0xffffffff,
+                    uint                         maxHits    = 1);
+
 	    private:
 		    SceneManager(const std::shared_ptr<render::AbstractContext>& context);
 
@@ -151,6 +258,27 @@ namespace minko
 
             void
             addedHandler(NodePtr node, NodePtr target, NodePtr ancestor);
+
+            void
+            removedHandler(NodePtr node, NodePtr target, NodePtr ancestor);
+
+            void
+            watchComponent(AbstractComponent::Ptr component);
+
+            void
+            unwatchComponent(AbstractComponent::Ptr component);
+
+            void
+            watchMaterial(std::shared_ptr<Surface> surface);
+
+            void
+            resetAnimationStats();
+
+            void
+            simulate(float time, float deltaTime);
+
+            void
+            profileRenderStats();
 	    };
     }
 }
@@ -0,0 +1,274 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include "minko/component/AbstractComponent.hpp"
+#include "minko/component/Transform.hpp"
+#include "minko/Signal.hpp"
+
+namespace minko
+{
+	namespace component
+	{
+		// Renders the depth of the scene seen from the DirectionalLight or the SpotLight of the target
+		// into the shadow maps read by Phong.effect, with a Renderer and an effect of their own. The maps
+		// of a directional light are cascades fit to the bounding spheres of slices of the frustum of a
+		// camera and snapped to their texels, so that shadows do not shimmer when the camera moves. A map
+		// only renders the casters in its volume and is only rendered again when that volume moved or
+		// when a caster entered, left or moved inside it.
+		class ShadowMapping :
+			public AbstractComponent,
+			public std::enable_shared_from_this<ShadowMapping>
+		{
+		public:
+			typedef std::shared_ptr<ShadowMapping>	Ptr;
+
+		private:
+			typedef std::shared_ptr<scene::Node>					NodePtr;
+			typedef std::shared_ptr<AbstractComponent>				AbsCtrlPtr;
+			typedef std::shared_ptr<SceneManager>					SceneManagerPtr;
+			typedef std::shared_ptr<render::Texture>				TexturePtr;
+			typedef std::shared_ptr<math::Matrix4x4>				Matrix4x4Ptr;
+			typedef Signal<SceneManagerPtr, uint, std::shared_ptr<render::AbstractTexture>>	RenderingBeginSignal;
+
+			struct ShadowMap
+			{
+				NodePtr									node;
+				std::shared_ptr<Renderer>				renderer;
+				TexturePtr								texture;
+				std::shared_ptr<data::StructureProvider>	camera;
+				Matrix4x4Ptr							view;
+				Matrix4x4Ptr							projection;
+				Matrix4x4Ptr							viewProjection;
+				std::shared_ptr<math::Frustum>			frustum;
+				// light space center and half size of the volume of a cascade
+				float									x;
+				float									y;
+				float									z;
+				float									halfSize;
+				bool									invalid;
+				// casters rendered the last time, one bit per caster
+				std::vector<uint>						casters;
+				uint									numCasters;
+			};
+
+		public:
+			static const uint									MAX_NUM_CASCADES;
+			// the cascades are this much larger than the spheres they are fit to
+			static const float									CASCADE_PADDING;
+
+		private:
+			std::shared_ptr<render::AbstractContext>			_context;
+			std::shared_ptr<render::Effect>						_effect;
+			uint												_size;
+			uint												_numCascades;
+			NodePtr												_camera;
+			float												_shadowDistance;
+			float												_splitLambda;
+			float												_bias;
+
+			std::shared_ptr<DirectionalLight>					_directionalLight;
+			std::shared_ptr<SpotLight>							_spotLight;
+			std::shared_ptr<data::ArrayProvider>				_data;
+			NodePtr												_root;
+			std::vector<ShadowMap>								_maps;
+			uint												_numRenderedMaps;
+
+			std::vector<NodePtr>								_casters;
+			std::unordered_map<NodePtr, uint>					_casterIds;
+			// world bounding boxes of the casters: min x, y, z then max x, y, z
+			std::array<std::vector<float>, 6>					_casterBounds;
+			std::vector<NodePtr>								_movedCasters;
+			bool												_invalidCasters;
+
+			// rows of the rotation from world space to the light space of the cascades
+			float												_lightBasis[9];
+			// direction of a directional light, or position, direction, cone and range of a spot light
+			float												_lightState[8];
+
+			Signal<AbsCtrlPtr, NodePtr>::Slot					_targetAddedSlot;
+			Signal<AbsCtrlPtr, NodePtr>::Slot					_targetRemovedSlot;
+			Signal<NodePtr, NodePtr, NodePtr>::Slot				_targetAddedToNodeSlot;
+			Signal<NodePtr, NodePtr, NodePtr>::Slot				_targetRemovedFromNodeSlot;
+			Signal<NodePtr, NodePtr, NodePtr>::Slot				_addedSlot;
+			Signal<NodePtr, NodePtr, NodePtr>::Slot				_removedSlot;
+			Signal<NodePtr, NodePtr, AbsCtrlPtr>::Slot			_componentAddedSlot;
+			Signal<NodePtr, NodePtr, AbsCtrlPtr>::Slot			_componentRemovedSlot;
+			RenderingBeginSignal::Slot							_renderingBeginSlot;
+			Transform::RootTransform::ModelToWorldChangedSignal::Slot	_modelToWorldChangedSlot;
+
+		public:
+			// the effect renders the depth of the casters, usually effect/ShadowMap.effect
+			inline static
+			Ptr
+			create(std::shared_ptr<render::AbstractContext>	context,
+				   std::shared_ptr<render::Effect>			effect,
+				   uint										size		= 1024,
+				   uint										numCascades	= 4)
+			{
+				Ptr shadowMapping = std::shared_ptr<ShadowMapping>(
+					new ShadowMapping(context, effect, size, numCascades)
+				);
+
+				shadowMapping->initialize();
+
+				return shadowMapping;
+			}
+
+			// the node of the PerspectiveCamera the cascades of a directional light are fit to
+			inline
+			NodePtr
+			camera() const
+			{
+				return _camera;
+			}
+
+			inline
+			Ptr
+			camera(NodePtr camera)
+			{
+				_camera = camera;
+
+				return shared_from_this();
+			}
+
+			// distance from the camera past which directional lights cast no shadow
+			inline
+			float
+			shadowDistance() const
+			{
+				return _shadowDistance;
+			}
+
+			inline
+			Ptr
+			shadowDistance(float shadowDistance)
+			{
+				_shadowDistance = shadowDistance;
+
+				return shared_from_this();
+			}
+
+			// 0 for uniform cascade splits, 1 for logarithmic ones
+			inline
+			float
+			splitLambda() const
+			{
+				return _splitLambda;
+			}
+
+			inline
+			Ptr
+			splitLambda(float splitLambda)
+			{
+				_splitLambda = splitLambda;
+
+				return shared_from_this();
+			}
+
+			float
+			bias() const;
+
+			Ptr
+			bias(float bias);
+
+			// the cascades of a directional light or the single map of a spot light
+			inline
+			uint
+			numMaps() const
+			{
+				return _maps.size();
+			}
+
+			TexturePtr
+			map(uint mapId) const;
+
+			Matrix4x4Ptr
+			viewProjection(uint mapId) const;
+
+			// casters drawn the last time the map was rendered
+			uint
+			numCasters(uint mapId) const;
+
+			// maps rendered during the last update
+			inline
+			uint
+			numRenderedMaps() const
+			{
+				return _numRenderedMaps;
+			}
+
+			// called when a frame begins to be rendered, once the world matrices of the frame are up to date
+			void
+			update();
+
+		private:
+			ShadowMapping(std::shared_ptr<render::AbstractContext>	context,
+						  std::shared_ptr<render::Effect>			effect,
+						  uint										size,
+						  uint										numCascades);
+
+			void
+			initialize();
+
+			void
+			targetAddedHandler(AbsCtrlPtr ctrl, NodePtr target);
+
+			void
+			targetRemovedHandler(AbsCtrlPtr ctrl, NodePtr target);
+
+			void
+			createMaps(NodePtr target);
+
+			void
+			removeMaps(NodePtr target);
+
+			void
+			setRoot(NodePtr root);
+
+			void
+			setSceneManager(SceneManagerPtr sceneManager);
+
+			void
+			bindCasters();
+
+			void
+			updateCasterBounds(uint casterId);
+
+			bool
+			updateLightBasis();
+
+			void
+			placeCascades();
+
+			void
+			placeSpotMap();
+
+			void
+			invalidateMovedCasters();
+
+			void
+			render(ShadowMap& map, bool cascade);
+		};
+	}
+}
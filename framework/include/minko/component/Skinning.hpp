@@ -62,12 +62,16 @@ namespace minko
 		public:
 			static const std::string								PNAME_NUM_BONES;
 			static const std::string								PNAME_BONE_MATRICES;
+			static const std::string								PNAME_BONE_MATRICES_TEXTURE;
 			static const std::string								ATTRNAME_BONE_IDS_A;
 			static const std::string								ATTRNAME_BONE_IDS_B;
 			static const std::string								ATTRNAME_BONE_WEIGHTS_A;
 			static const std::string								ATTRNAME_BONE_WEIGHTS_B;
 			static const unsigned int								MAX_NUM_BONES_PER_VERTEX;
 
+			// software skinning of smaller meshes stays on the calling thread
+			static const uint										PARALLEL_MIN_NUM_VERTICES = 4096;
+
 		private:
 			static const std::string								ATTRNAME_POSITION;
 			static const std::string								ATTRNAME_NORMAL;
@@ -78,12 +82,35 @@ namespace minko
 			SkinningMethod											_method;
 
 			render::VertexBuffer::Ptr								_boneVertexBuffer; // vertex buffer storing vertex attributes
+			std::shared_ptr<render::Texture>						_boneTexture; // one row of 4 texels per bone, shared by the targets
 
 			std::unordered_map<NodePtr, GeometryPtr>				_targetGeometry;
 			std::unordered_map<NodePtr,	std::vector<float>>			_targetInputPositions;	// only for software skinning
 			std::unordered_map<NodePtr,	std::vector<float>>			_targetInputNormals;	// only for software skinning
 
+			// only for software skinning, numVertexBones ids and weights per vertex, unused ones have a null weight
+			uint													_numVertexBones;
+			std::vector<uint>										_vertexBoneIds;
+			std::vector<float>										_vertexBoneWeights;
+
+			std::vector<float>										_boneMatrices;	// interpolated, for compressed skins only
+
 		public:
+			inline
+			SkinPtr
+			skin() const
+			{
+				return _skin;
+			}
+
+			// might differ from the requested method when the skin or the context does not support it
+			inline
+			SkinningMethod
+			method() const
+			{
+				return _method;
+			}
+
 			inline static
 			Ptr
 			create(const SkinPtr						skin, 
@@ -119,17 +146,13 @@ namespace minko
 			update();
 
 			void
-			updateFrame(uint frameId, NodePtr);
+			updateFrame(const std::vector<float>& boneMatrices, NodePtr);
 
 			void
 			performSoftwareSkinning(NodePtr, const std::vector<float>&);
 
 			void
-			performSoftwareSkinning(render::VertexBuffer::AttributePtr, 
-									render::VertexBuffer::Ptr, 
-									const std::vector<float>&, 
-									const std::vector<float>&, 
-									bool doDeltaTransform);
+			initializeVertexBoneData();
 
 			render::VertexBuffer::Ptr
 			createVertexBufferForBones() const;
@@ -28,7 +28,8 @@ namespace minko
 		enum class SkinningMethod
 		{
 			SOFTWARE = 0,
-			HARDWARE
+			HARDWARE,
+			HARDWARE_TEXTURE // bone matrices in a float texture instead of uniforms, HARDWARE without float textures
 		};
 	}
 }
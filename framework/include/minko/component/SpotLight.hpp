@@ -86,6 +86,20 @@ namespace minko
 			Ptr
 			outerConeAngle(float radians);
 
+			inline
+			std::shared_ptr<math::Vector3>
+			worldPosition() const
+			{
+				return _worldPosition;
+			}
+
+			inline
+			std::shared_ptr<math::Vector3>
+			worldDirection() const
+			{
+				return _worldDirection;
+			}
+
 			bool
 			attenuationEnabled() const;
 
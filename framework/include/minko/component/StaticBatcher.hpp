@@ -0,0 +1,109 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include "minko/component/AbstractComponent.hpp"
+#include "minko/Signal.hpp"
+
+namespace minko
+{
+	namespace component
+	{
+		// Merges the surfaces of the target's descendants whose Transform is static and which share
+		// the same material, effect and technique into geometries baked in the target's space.
+		// Merged geometries hold at most 65536 vertices unless the context supports 32 bits indices.
+		class StaticBatcher :
+			public AbstractComponent,
+			public std::enable_shared_from_this<StaticBatcher>
+		{
+		public:
+			typedef std::shared_ptr<StaticBatcher>	Ptr;
+
+		private:
+			typedef std::shared_ptr<scene::Node>					NodePtr;
+			typedef std::shared_ptr<AbstractComponent>				AbsCtrlPtr;
+			typedef std::shared_ptr<Surface>						SurfacePtr;
+			typedef std::shared_ptr<math::Matrix4x4>				MatrixPtr;
+			typedef std::vector<std::pair<std::string, uint>>		VertexLayout;
+
+			struct Batch
+			{
+				SurfacePtr					reference;
+				VertexLayout				layout;
+				std::list<SurfacePtr>		surfaces;
+			};
+
+		private:
+			static const uint					MAX_NUM_VERTICES;
+
+			std::list<NodePtr>					_batches;
+
+			Signal<AbsCtrlPtr, NodePtr>::Slot	_targetAddedSlot;
+			Signal<AbsCtrlPtr, NodePtr>::Slot	_targetRemovedSlot;
+
+		public:
+			inline static
+			Ptr
+			create()
+			{
+				Ptr batcher = std::shared_ptr<StaticBatcher>(new StaticBatcher());
+
+				batcher->initialize();
+
+				return batcher;
+			}
+
+			inline
+			const std::list<NodePtr>&
+			batches() const
+			{
+				return _batches;
+			}
+
+			void
+			batch();
+
+		private:
+			StaticBatcher();
+
+			void
+			initialize();
+
+			void
+			targetAddedHandler(AbsCtrlPtr ctrl, NodePtr target);
+
+			void
+			targetRemovedHandler(AbsCtrlPtr ctrl, NodePtr target);
+
+			static
+			VertexLayout
+			getVertexLayout(std::shared_ptr<geometry::Geometry> geometry);
+
+			static
+			bool
+			canBeBatched(SurfacePtr surface);
+
+			NodePtr
+			mergeSurfaces(const Batch& batch, const std::vector<SurfacePtr>& surfaces, MatrixPtr worldToTarget);
+		};
+	}
+}
@@ -39,6 +39,7 @@ namespace minko
 			typedef std::shared_ptr<Surface>									Ptr;
 			typedef Signal<Ptr, const std::string&, bool>						TechniqueChangedSignal;	
 			typedef Signal<Ptr, std::shared_ptr<component::Renderer>, bool>		VisibilityChangedSignal;
+			typedef Signal<Ptr>													MaterialChangedSignal;
 
 		private:
 			typedef std::shared_ptr<data::ArrayProvider>					ArrayProviderPtr;
@@ -60,6 +61,7 @@ namespace minko
 			
 			std::string 															_technique;
 			std::list<ArrayProviderIndexChangedSlot>								_dataProviderIndexChangedSlots;
+			ArrayProviderIndexChangedSlot											_materialIndexChangedSlot;
 
 			int																		_geometryId;
 			int																		_materialId;
@@ -78,6 +80,7 @@ namespace minko
 
 			VisibilityChangedSignal::Ptr											_visibilityChanged;
 			VisibilityChangedSignal::Ptr											_computedVisibilityChanged;
+			MaterialChangedSignal::Ptr												_materialChanged;
 
 		public:
 			static
@@ -160,6 +163,21 @@ namespace minko
 			void
 			computedVisibility(std::shared_ptr<component::Renderer>, bool value);
 
+			// false when the surface is hidden or culled by every renderer
+			inline
+			bool
+			computedVisibility() const
+			{
+				if (!_visible)
+					return false;
+
+				for (auto& visibility : _rendererToComputedVisibility)
+					if (visibility.second)
+						return true;
+
+				return _rendererToComputedVisibility.empty();
+			}
+
 			inline
 			VisibilityChangedSignal::Ptr
 			computedVisibilityChanged()
@@ -198,6 +216,16 @@ namespace minko
 				return _material;
 			}
 
+			void
+			material(std::shared_ptr<data::Provider> newMaterial);
+
+			inline
+			MaterialChangedSignal::Ptr
+			materialChanged() const
+			{
+				return _materialChanged;
+			}
+
 			inline
 			std::shared_ptr<render::Effect>
 			effect()
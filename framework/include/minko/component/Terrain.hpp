@@ -0,0 +1,305 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include "minko/component/AbstractComponent.hpp"
+#include "minko/Signal.hpp"
+
+namespace minko
+{
+	namespace component
+	{
+		// heightmap terrain drawn as chunks added to the target, each one a Surface sharing the same grid
+		// geometry displaced in the vertex shader; the chunks are the cut of a quadtree selected by update()
+		// according to the distance to the eye (CDLOD), the chunks of a level moving their vertices to the grid
+		// of the next one before it is selected and being extended downward by skirts to hide the cracks
+		class Terrain :
+			public AbstractComponent,
+			public std::enable_shared_from_this<Terrain>
+		{
+		public:
+			typedef std::shared_ptr<Terrain>	Ptr;
+
+			static const uint					DEFAULT_CHUNK_RESOLUTION;
+			static const uint					MAX_CHUNK_RESOLUTION;
+
+		private:
+			typedef std::shared_ptr<scene::Node>				NodePtr;
+			typedef std::shared_ptr<AbstractComponent>			AbsCmpPtr;
+			typedef std::shared_ptr<render::AbstractContext>	ContextPtr;
+			typedef std::shared_ptr<render::Effect>				EffectPtr;
+			typedef std::shared_ptr<render::Texture>			TexturePtr;
+			typedef std::shared_ptr<material::Material>			MaterialPtr;
+			typedef std::shared_ptr<geometry::Geometry>			GeometryPtr;
+
+			// square of size x size quads, level 0 for the finest chunks
+			struct QuadNode
+			{
+				uint	x;
+				uint	z;
+				uint	size;
+				uint	level;
+				int		children[4];
+				float	minHeight;
+				float	maxHeight;
+				bool	inside; // fully covered by the heightmap, the other nodes are never drawn
+			};
+
+		private:
+			ContextPtr								_context;
+			std::vector<float>						_heights;
+			uint									_width;
+			uint									_depth;
+			float									_spacing;
+			float									_minHeight;
+			float									_maxHeight;
+			uint									_chunkResolution;
+			float									_lodDistance;
+			float									_skirtDepth;
+
+			std::vector<QuadNode>					_quadTree;
+			uint									_numLevels;
+			GeometryPtr								_grid;
+			TexturePtr								_heightMap;
+			MaterialPtr								_material;
+			EffectPtr								_effect;
+
+			std::unordered_map<uint, NodePtr>		_chunks; // by quadtree node
+			std::vector<NodePtr>					_freeChunks;
+			std::unordered_map<NodePtr, std::shared_ptr<data::StructureProvider>>	_chunkToData;
+			std::vector<uint>						_selection;
+
+			std::shared_ptr<Signal<Ptr>>			_selectionChanged;
+
+			Signal<AbsCmpPtr, NodePtr>::Slot		_targetAddedSlot;
+			Signal<AbsCmpPtr, NodePtr>::Slot		_targetRemovedSlot;
+
+		public:
+			// width x depth heights stored row by row, separated by spacing on the x and z axes; (width - 1) and
+			// (depth - 1) must be multiples of chunkResolution, a power of 2
+			inline static
+			Ptr
+			create(ContextPtr					context,
+				   const std::vector<float>&	heights,
+				   uint							width,
+				   uint							depth,
+				   float						spacing,
+				   EffectPtr					effect,
+				   MaterialPtr					material			= nullptr,
+				   uint							chunkResolution		= DEFAULT_CHUNK_RESOLUTION)
+			{
+				auto terrain = std::shared_ptr<Terrain>(new Terrain(context, effect, material));
+
+				terrain->initialize(heights, width, depth, spacing, chunkResolution);
+
+				return terrain;
+			}
+
+			// heights read from the red channel of the CPU-side data of a texture loaded by the AssetLibrary,
+			// mapped from [0, 255] to [minHeight, maxHeight]
+			static
+			Ptr
+			create(ContextPtr	context,
+				   TexturePtr	heightMap,
+				   float		spacing,
+				   float		minHeight,
+				   float		maxHeight,
+				   EffectPtr	effect,
+				   MaterialPtr	material			= nullptr,
+				   uint			chunkResolution		= DEFAULT_CHUNK_RESOLUTION);
+
+			inline
+			const std::vector<float>&
+			heights() const
+			{
+				return _heights;
+			}
+
+			inline
+			uint
+			width() const
+			{
+				return _width;
+			}
+
+			inline
+			uint
+			depth() const
+			{
+				return _depth;
+			}
+
+			inline
+			float
+			spacing() const
+			{
+				return _spacing;
+			}
+
+			inline
+			float
+			minHeight() const
+			{
+				return _minHeight;
+			}
+
+			inline
+			float
+			maxHeight() const
+			{
+				return _maxHeight;
+			}
+
+			inline
+			uint
+			chunkResolution() const
+			{
+				return _chunkResolution;
+			}
+
+			inline
+			uint
+			numLevels() const
+			{
+				return _numLevels;
+			}
+
+			// the finest chunks are drawn closer than lodDistance, each level doubling the distance of the previous one
+			inline
+			float
+			lodDistance() const
+			{
+				return _lodDistance;
+			}
+
+			inline
+			void
+			lodDistance(float value)
+			{
+				if (value <= 0.f)
+					throw std::invalid_argument("value");
+
+				_lodDistance = value;
+			}
+
+			inline
+			float
+			skirtDepth() const
+			{
+				return _skirtDepth;
+			}
+
+			void
+			skirtDepth(float value);
+
+			inline
+			GeometryPtr
+			grid() const
+			{
+				return _grid;
+			}
+
+			inline
+			TexturePtr
+			heightMap() const
+			{
+				return _heightMap;
+			}
+
+			inline
+			MaterialPtr
+			material() const
+			{
+				return _material;
+			}
+
+			inline
+			uint
+			numChunks() const
+			{
+				return _selection.size();
+			}
+
+			// level of the i-th chunk drawn
+			inline
+			uint
+			chunkLevel(uint chunk) const
+			{
+				return _quadTree[_selection.at(chunk)].level;
+			}
+
+			inline
+			std::shared_ptr<Signal<Ptr>>
+			selectionChanged() const
+			{
+				return _selectionChanged;
+			}
+
+			// bilinear height at x, z in the local space of the target
+			float
+			height(float x, float z) const;
+
+			// usually once per frame with the position of the camera in world space
+			void
+			update(std::shared_ptr<math::Vector3> eyePosition);
+
+		private:
+			Terrain(ContextPtr context, EffectPtr effect, MaterialPtr material);
+
+			void
+			initialize(const std::vector<float>& heights, uint width, uint depth, float spacing, uint chunkResolution);
+
+			void
+			targetAddedHandler(AbsCmpPtr cmp, NodePtr target);
+
+			void
+			targetRemovedHandler(AbsCmpPtr cmp, NodePtr target);
+
+			int
+			buildQuadNode(uint x, uint z, uint size, uint level);
+
+			void
+			computeHeightBounds();
+
+			void
+			createGrid();
+
+			void
+			createHeightMap();
+
+			float
+			lodRange(uint level) const;
+
+			float
+			distance(const QuadNode& node, const float* eye) const;
+
+			void
+			select(uint node, const float* eye);
+
+			NodePtr
+			createChunk(uint node);
+
+			void
+			releaseChunk(NodePtr chunk);
+		};
+	}
+}
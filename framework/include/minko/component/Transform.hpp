@@ -48,6 +48,7 @@ namespace minko
 			std::shared_ptr<math::Matrix4x4>			_modelToWorld;
 			std::shared_ptr<math::Matrix4x4>			_worldToModel;
 			std::shared_ptr<data::StructureProvider>	_data;
+			bool										_static;
 
 			Signal<AbsCtrlPtr, NodePtr>::Slot 			_targetAddedSlot;
 			Signal<AbsCtrlPtr, NodePtr>::Slot 			_targetRemovedSlot;
@@ -88,6 +89,21 @@ namespace minko
 				return _matrix;
 			}
 
+			// static transforms are never expected to move: their surfaces can be baked by the StaticBatcher
+			inline
+			bool
+			isStatic() const
+			{
+				return _static;
+			}
+
+			inline
+			void
+			isStatic(bool value)
+			{
+				_static = value;
+			}
+
 			inline
 			std::shared_ptr<math::Vector3>
 			modelToWorld(std::shared_ptr<math::Vector3> v, std::shared_ptr<math::Vector3> out = nullptr)
@@ -174,17 +190,16 @@ namespace minko
 			void
 			addedOrRemovedHandler(NodePtr node, NodePtr target, NodePtr ancestor);
 
-#ifdef MINKO_TEST
 		public:
-#else
-		private:
-#endif // MINKO_TEST
 			class RootTransform :
 				public std::enable_shared_from_this<RootTransform>,
 				public AbstractComponent
 			{
 			public:
-				typedef std::shared_ptr<RootTransform> Ptr;
+				typedef std::shared_ptr<RootTransform>					Ptr;
+				typedef Signal<Ptr, const std::vector<NodePtr>&>		ModelToWorldChangedSignal;
+
+				static const unsigned int PARALLEL_UPDATE_MIN_NUM_NODES = 4096;
 
 			private:
 				typedef std::shared_ptr<Renderer>		RendererCtrlPtr;
@@ -205,22 +220,59 @@ namespace minko
 				void
 				forceUpdate(NodePtr node, bool updateTransformLists = false);
 
+				// preallocates the slots of numNodes more nodes, before adding a large subtree
+				void
+				reserve(unsigned int numNodes);
+
+				// the nodes whose world matrix changed during the last update, in hierarchy order
+				inline
+				const std::vector<NodePtr>&
+				changedNodes() const
+				{
+					return _changedNodes;
+				}
+
+				// executed once per frame with changedNodes(), when it is not empty
+				inline
+				std::shared_ptr<ModelToWorldChangedSignal>
+				modelToWorldChanged() const
+				{
+					return _modelToWorldChanged;
+				}
+
 			private:
 				std::vector<std::shared_ptr<math::Matrix4x4>>	_transforms;
 				std::vector<std::shared_ptr<math::Matrix4x4>>	_modelToWorld;
 				//std::vector<std::shared_ptr<Matrix4x4>>		_worldToModel;
 
-				std::map<NodePtr, unsigned int>					_nodeToId;
+				std::unordered_map<NodePtr, unsigned int>		_nodeToId;
 				std::vector<NodePtr>							_idToNode;
+				// a parent always has a lower id than its children, free slots have no node
 				std::vector<int>		 						_parentId;
-				std::vector<unsigned int> 						_firstChildId;
-				std::vector<unsigned int>						_numChildren;
+				std::vector<unsigned int>						_freeIds;
+				// not a std::vector<bool> so workers can write adjacent entries
+				std::vector<unsigned char>						_worldChanged;
 				bool											_invalidLists;
 
+				// world matrices are computed by the workers, then flushed serially
+				unsigned int									_numWorkers;
+				bool											_invalidUpdateJobs;
+				std::vector<unsigned int>						_serialUpdateJob;
+				std::vector<std::vector<unsigned int>>			_parallelUpdateJobs;
+
+				std::vector<NodePtr>							_changedNodes;
+				std::shared_ptr<ModelToWorldChangedSignal>		_modelToWorldChanged;
+
+				// contiguous copy of the world matrices, 16 floats per node, 16 bytes aligned
+				std::vector<float>								_worldMatrices;
+				unsigned int									_worldMatricesOffset;
+
 				std::list<Any>									_targetSlots;
 				Signal<std::shared_ptr<SceneManager>, uint, std::shared_ptr<render::AbstractTexture>>::Slot		_renderingBeginSlot;
 
 			private:
+				RootTransform();
+
 				void
 				initialize();
 
@@ -242,14 +294,39 @@ namespace minko
 				void
 				addedHandler(NodePtr node, NodePtr target, NodePtr parent);
 
+				inline
+				float*
+				worldMatrix(unsigned int nodeId)
+				{
+					return &_worldMatrices[_worldMatricesOffset + (nodeId << 4)];
+				}
+
+				void
+				resizeWorldMatrices(unsigned int numNodes);
+
+				unsigned int
+				allocateId(int parentId);
+
+				void
+				addToTransformsList(NodePtr node);
+
+				void
+				removeFromTransformsList(NodePtr node);
+
+				void
+				compactTransformsList();
+
 				void
 				updateTransformsList();
 
 				void
-				updateTransforms();
+				buildUpdateJobs();
+
+				void
+				updateWorldMatrix(unsigned int nodeId);
 
 				void
-				updateTransformPath(const std::vector<unsigned int>& path);
+				updateTransforms();
 
 				void
 				renderingBeginHandler(std::shared_ptr<SceneManager> sceneManager, 
@@ -42,15 +42,25 @@ namespace minko
 
 			std::list<ProviderPtr>											_providers;
 			std::unordered_map<std::string, ProviderPtr>					_propertyNameToProvider;
+			std::unordered_map<PropertyName::Id, ProviderPtr>				_propertyIdToProvider;
 			std::unordered_map<ProviderPtr, uint>							_providersToNumUse;
 
 			std::shared_ptr<Provider>										_arrayLengths;
+			// the providers of each array by index: the last one takes the slot of a removed one
+			std::unordered_map<std::string, std::vector<std::shared_ptr<ArrayProvider>>>	_arrayProviders;
 
 			PropertyChangedSignalPtr										_propertyAdded;
 			PropertyChangedSignalPtr										_propertyRemoved;
 			std::unordered_map<std::string, PropertyChangedSignalPtr>		_propValueChanged;
 			std::unordered_map<std::string, PropertyChangedSignalPtr>		_propReferenceChanged;
 
+			// changes coalesced per property while deferred, in the order they first happened
+			bool															_deferChanges;
+			std::vector<std::string>										_pendingValueChanges;
+			std::vector<std::string>										_pendingReferenceChanges;
+			std::unordered_set<std::string>									_pendingValueChanged;
+			std::unordered_set<std::string>									_pendingReferenceChanged;
+
 			std::unordered_map<ProviderPtr, std::list<Any>>					_propertyAddedOrRemovedSlots;
 			std::unordered_map<ProviderPtr, ProviderPropertyChangedSlot>	_providerValueChangedSlot;
 			std::unordered_map<ProviderPtr, ProviderPropertyChangedSlot>	_providerReferenceChangedSlot;
@@ -88,6 +98,13 @@ namespace minko
 			bool
 			hasProperty(const std::string& propertyName) const;
 
+			inline
+			bool
+			hasProperty(PropertyName::Id propertyId) const
+			{
+				return _propertyIdToProvider.count(propertyId) != 0;
+			}
+
 			template <typename T>
 			T
 			get(const std::string& propertyName) const
@@ -99,6 +116,18 @@ namespace minko
 				return provider->get<T>(propertyName, true);
 			}
 
+			template <typename T>
+			T
+			get(PropertyName::Id propertyId) const
+			{
+				auto providerIt = _propertyIdToProvider.find(propertyId);
+
+				if (providerIt == _propertyIdToProvider.end())
+					throw std::invalid_argument(PropertyName::name(propertyId));
+
+				return providerIt->second->get<T>(propertyId);
+			}
+
 			template <typename T>
 			void
 			set(const std::string& propertyName, T value)
@@ -146,9 +175,33 @@ namespace minko
 				return _providers;
 			}
 
+			inline
+			bool
+			deferChanges() const
+			{
+				return _deferChanges;
+			}
+
+			// while deferred, value and reference changes are executed once per property by flushChanges(),
+			// turning deferring off flushes the pending changes
+			void
+			deferChanges(bool value);
+
+			void
+			flushChanges();
+
+			// flushes every deferred container with pending changes, called before rendering
+			static
+			void
+			flushAllChanges();
+
 		private:
 			Container();
 
+			static
+			std::list<std::weak_ptr<Container>>&
+			containersWithPendingChanges();
+
 			void
 			assertPropertyExists(const std::string& propertyName) const;
 
@@ -23,6 +23,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/Any.hpp"
 #include "minko/Signal.hpp"
 #include "minko/data/Value.hpp"
+#include "minko/data/PropertyName.hpp"
 
 namespace minko
 {
@@ -43,6 +44,7 @@ namespace minko
 		private:
 			std::vector<std::string>								_names;
 			std::unordered_map<std::string, Any>					_values;
+			std::unordered_map<PropertyName::Id, Any*>				_idToValue;
 			std::unordered_map<std::string, ChangedSignalSlot>		_valueChangedSlots;
 			std::unordered_map<std::string, ChangedSignalSlot>		_referenceChangedSlots;
 
@@ -80,6 +82,14 @@ namespace minko
 			bool 
 			hasProperty(const std::string&, bool skipPropertyNameFormatting = false) const;
 
+			// ids are the ones of the formatted property names
+			inline
+			bool
+			hasProperty(PropertyName::Id propertyId) const
+			{
+				return _idToValue.count(propertyId) != 0;
+			}
+
 			inline
 			const std::unordered_map<std::string, Any>&
 			values() const
@@ -143,6 +153,18 @@ namespace minko
 				return get<T>(propertyName, false);
 			}
 
+			template <typename T>
+			T
+			get(PropertyName::Id propertyId) const
+			{
+				auto foundIt = _idToValue.find(propertyId);
+
+				if (foundIt == _idToValue.end())
+					throw std::invalid_argument("propertyId");
+
+				return Any::unsafe_cast<T>(*foundIt->second);
+			}
+
 			template <typename T>
 			bool
 			propertyHasType(const std::string& propertyName, bool skipPropertyNameFormatting = false) const
@@ -171,15 +193,24 @@ namespace minko
 			{
 				auto		formattedName	= skipPropertyNameFormatting ? propertyName : formatPropertyName(propertyName);
 				
-				const auto	foundValueIt	= _values.find(formattedName);
+				auto		foundValueIt	= _values.find(formattedName);
 				const bool	isNewValue		= foundValueIt == _values.end();
 				//const bool	changed			= !isNewValue;// || !((*value) == (*foundValueIt->second));
-	
-				_values[formattedName] = value;
+
+				// a value of the same type is overwritten in place instead of reallocating its holder
+				T*			heldValue		= isNewValue ? nullptr : Any::cast<T>(&foundValueIt->second);
+
+				if (heldValue)
+					*heldValue = value;
+				else if (!isNewValue)
+					foundValueIt->second = value;
 		
 				if (isNewValue)
 				{
+					auto& storedValue = _values.emplace(formattedName, value).first->second;
+
 					_names.push_back(formattedName);
+					_idToValue[PropertyName::id(formattedName)] = &storedValue;
 
 					_propertyAdded->execute(shared_from_this(), formattedName);
 				}
@@ -203,10 +234,14 @@ namespace minko
 				const bool	isNewValue		= (foundValueIt == _values.end());
 				//const bool	changed			= !isNewValue;// || !((*value) == (*foundValueIt->second));
 	
-				_values[formattedName] = value;
+				auto&		storedValue		= _values[formattedName];
+
+				storedValue = value;
 				
 				if (isNewValue)
 				{
+					_idToValue[PropertyName::id(formattedName)] = &storedValue;
+
 #if defined(EMSCRIPTEN)
 					auto that = shared_from_this();
 					_valueChangedSlots[formattedName] = value->changed()->connect([&, that, formattedName, this](Value::Ptr)
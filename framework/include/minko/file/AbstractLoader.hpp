@@ -27,6 +27,7 @@ namespace minko
 
             Signal<Ptr>::Ptr                                _complete;
             Signal<Ptr, float>::Ptr                         _progress;
+            Signal<Ptr, uint, uint>::Ptr                    _chunk;
             Signal<Ptr>::Ptr                                _error;
             Signal<Ptr, AbsParserPtr, AssetLibraryPtr>::Ptr _parserComplete;
 
@@ -40,6 +41,18 @@ namespace minko
                 return _data;
             }
 
+            // moves the loaded bytes out of the loader instead of copying them, data() is empty afterwards
+            inline
+            std::vector<unsigned char>
+            releaseData()
+            {
+                std::vector<unsigned char> data;
+
+                data.swap(_data);
+
+                return data;
+            }
+
             inline
             std::shared_ptr<Options>
             options()
@@ -82,6 +95,14 @@ namespace minko
                 return _progress;
             }
 
+            // executed with the offset and size of each block appended to data() while loading
+            inline
+            std::shared_ptr<Signal<Ptr, uint, uint>>
+            chunk()
+            {
+                return _chunk;
+            }
+
             inline
             std::shared_ptr<Signal<Ptr>>
             error()
@@ -96,6 +117,7 @@ namespace minko
             AbstractLoader():
                 _complete(Signal<Ptr>::create()),
                 _progress(Signal<Ptr, float>::create()),
+                _chunk(Signal<Ptr, uint, uint>::create()),
                 _error(Signal<Ptr>::create()),
                 _parserComplete(Signal<Ptr, AbsParserPtr, AssetLibraryPtr>::create())
             {
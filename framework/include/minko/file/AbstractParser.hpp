@@ -42,6 +42,42 @@ namespace minko
 				return _complete;
 			}
 
+			// parsers overriding decode() have it called by a worker thread before parse() when the file is loaded
+			// asynchronously: it only fills the parser's own buffers, parse() then creates the resources from them
+			virtual
+			bool
+			decodesAsynchronously() const
+			{
+				return false;
+			}
+
+			virtual
+			void
+			decode(const std::string&					filename,
+				   std::shared_ptr<Options>				options,
+				   const std::vector<unsigned char>&	data)
+			{
+			}
+
+			// parsers overriding parseChunk() are fed each block as soon as it is loaded: the first offset + size
+			// bytes of data are available, parse() is still called once the whole file is loaded
+			virtual
+			bool
+			parsesIncrementally() const
+			{
+				return false;
+			}
+
+			virtual
+			void
+			parseChunk(const std::string&					filename,
+					   std::shared_ptr<Options>				options,
+					   const std::vector<unsigned char>&	data,
+					   uint									offset,
+					   uint									size)
+			{
+			}
+
 			virtual
 			void
 			parse(const std::string&				filename,
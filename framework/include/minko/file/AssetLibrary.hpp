@@ -36,6 +36,32 @@ namespace minko
 		public:
 			typedef std::shared_ptr<AssetLibrary>				Ptr;
 
+			// bytes kept on the CPU by the assets of the library, and allocated on the GPU by its context
+			struct MemoryReport
+			{
+				unsigned long long	geometries;
+				unsigned long long	textures;
+				unsigned long long	skins;
+				unsigned long long	materials;	// estimated from the types of their values
+				unsigned long long	blobs;
+				unsigned long long	gpuBuffers;
+				unsigned long long	gpuTextures;
+
+				inline
+				unsigned long long
+				cpu() const
+				{
+					return geometries + textures + skins + materials + blobs;
+				}
+
+				inline
+				unsigned long long
+				gpu() const
+				{
+					return gpuBuffers + gpuTextures;
+				}
+			};
+
 		private:
 			typedef std::shared_ptr<render::AbstractContext>	AbsContextPtr;
 			typedef std::shared_ptr<render::Effect>				EffectPtr;
@@ -48,6 +74,33 @@ namespace minko
 			typedef std::shared_ptr<scene::Node>				NodePtr;
             typedef std::shared_ptr<component::AbstractScript>  AbsScriptPtr;
 			typedef std::shared_ptr<data::Provider>				MaterialPtr;
+			typedef std::function<void(AbsLoaderPtr)>			FetchHandler;
+
+		private:
+			struct Fetch
+			{
+				std::string								filename;
+				std::shared_ptr<file::Options>			options;
+				AbsLoaderPtr							loader;
+				uint									order;
+				bool									done;
+				std::list<FetchHandler>					completeHandlers;
+				std::list<FetchHandler>					errorHandlers;
+				Signal<AbsLoaderPtr>::Slot				completeSlot;
+				Signal<AbsLoaderPtr>::Slot				errorSlot;
+			};
+
+			typedef std::shared_ptr<Fetch>						FetchPtr;
+
+			// names of the assets registered while the bundle was the current one
+			struct Bundle
+			{
+				std::set<std::string>	geometries;
+				std::set<std::string>	textures;
+				std::set<std::string>	materials;
+				std::set<std::string>	symbols;
+				std::set<std::string>	blobs;
+			};
 
 		private:
 			AbsContextPtr															_context;
@@ -56,21 +109,43 @@ namespace minko
 			std::unordered_map<std::string, LoaderHandler>							_loaders;
 
 			std::unordered_map<std::string, MaterialPtr>							_materials;
+			// shared materials by properties key
+			std::unordered_map<std::string, MaterialPtr>							_internedMaterials;
 			std::unordered_map<std::string, GeometryPtr>							_geometries;
 			std::unordered_map<std::string, EffectPtr>								_effects;
 			std::unordered_map<std::string, AbsTexturePtr>							_textures;
 			std::unordered_map<std::string, NodePtr>								_symbols;
 			std::unordered_map<std::string, std::vector<unsigned char>>				_blobs;
             std::unordered_map<std::string, AbsScriptPtr>                           _scripts;
+			// names of the assets loaded from serialized files, by hash of their serialized content
+			std::unordered_map<uint64_t, std::string>								_hashedAssetNames;
 
             std::unordered_map<std::string, uint>									_layouts;
 
+			std::unordered_map<std::string, Bundle>									_bundles;
+			std::string																_currentBundle;
+
+			std::shared_ptr<render::MemoryBudget>									_memoryBudget;
+
+			// parsers decoded by the thread pool, waiting for their main thread phase
+			std::list<std::pair<std::shared_ptr<AbstractLoader>, std::shared_ptr<AbstractParser>>>	_decodedParsers;
+			bool																	_parseDecodedScheduled;
+			float																	_parseBudget;
+
 			std::list<std::string>													_filesQueue;
 			std::list<std::string>													_loading;
 			std::unordered_map<std::string, std::shared_ptr<file::Options>>			_filenameToOptions;
 			std::unordered_map<std::string, std::shared_ptr<file::AbstractLoader>>	_filenameToLoader;
+			std::unordered_map<std::string, std::shared_ptr<file::AbstractParser>>	_filenameToParser;
+
+			std::vector<Signal<std::shared_ptr<file::AbstractLoader>, uint, uint>::Slot>	_loaderChunkSlots;
 
-			std::vector<Signal<std::shared_ptr<file::AbstractLoader>>::Slot>		_loaderSlots;
+			// every file loaded by the library or its parsers, by filename and include paths
+			std::unordered_map<std::string, FetchPtr>								_fetches;
+			std::vector<FetchPtr>													_pendingFetches;
+			uint																	_numRunningFetches;
+			uint																	_numFetches;
+			uint																	_maxConcurrentLoads;
 			std::vector<Signal<std::shared_ptr<file::AbstractParser>>::Slot>	_parserSlots;
 
             Signal<Ptr>::Ptr											            _complete;
@@ -88,6 +163,57 @@ namespace minko
 				return _context;
 			}
 
+			// when set, the textures and geometries of the library are accounted for and can be evicted
+			inline
+			std::shared_ptr<render::MemoryBudget>
+			memoryBudget() const
+			{
+				return _memoryBudget;
+			}
+
+			inline
+			Ptr
+			memoryBudget(std::shared_ptr<render::MemoryBudget> budget)
+			{
+				_memoryBudget = budget;
+
+				return shared_from_this();
+			}
+
+			// milliseconds per frame spent creating the resources of the files decoded off the main thread
+			inline
+			float
+			parseBudget() const
+			{
+				return _parseBudget;
+			}
+
+			inline
+			Ptr
+			parseBudget(float value)
+			{
+				_parseBudget = value;
+
+				return shared_from_this();
+			}
+
+			// number of files loading at the same time, 0 for no limit
+			inline
+			uint
+			maxConcurrentLoads() const
+			{
+				return _maxConcurrentLoads;
+			}
+
+			inline
+			Ptr
+			maxConcurrentLoads(uint value)
+			{
+				_maxConcurrentLoads = value;
+
+				return shared_from_this();
+			}
+
 			inline
 			std::shared_ptr<file::Options>
 			defaultOptions()
@@ -131,6 +257,13 @@ namespace minko
 
 			const std::string&
 			geometryName(GeometryPtr geometry);
+
+			inline
+			const std::unordered_map<std::string, GeometryPtr>&
+			geometries() const
+			{
+				return _geometries;
+			}
 			
 			Ptr
 			texture(const std::string& name, AbsTexturePtr texture);
@@ -141,6 +274,13 @@ namespace minko
 			const std::string&
 			textureName(AbsTexturePtr texture);
 
+			inline
+			const std::unordered_map<std::string, AbsTexturePtr>&
+			textures() const
+			{
+				return _textures;
+			}
+
 			std::shared_ptr<material::Material>
 			material(const std::string& name);
 
@@ -150,6 +290,89 @@ namespace minko
 			const std::string&
 			materialName(MaterialPtr material);
 
+			inline
+			const std::unordered_map<std::string, MaterialPtr>&
+			materials() const
+			{
+				return _materials;
+			}
+
+			// the material previously interned with the same type and properties if there is one, the material
+			// itself otherwise: since they are shared, interned materials should be copied before being modified
+			MaterialPtr
+			internMaterial(MaterialPtr material);
+
+			inline
+			uint
+			numInternedMaterials() const
+			{
+				return _internedMaterials.size();
+			}
+
+			// the name of the asset already loaded from a serialized file with the same content, empty if there is
+			// none: the parsers reference it instead of decoding and uploading the same content again
+			inline
+			std::string
+			hashedAssetName(uint64_t contentHash) const
+			{
+				auto it = _hashedAssetNames.find(contentHash);
+
+				return it != _hashedAssetNames.end() ? it->second : std::string();
+			}
+
+			inline
+			Ptr
+			hashedAssetName(uint64_t contentHash, const std::string& name)
+			{
+				_hashedAssetNames[contentHash] = name;
+
+				return shared_from_this();
+			}
+
+			// the geometries, materials and textures registered from now on belong to the bundle, as well as the
+			// symbols and blobs, until another one is set; an empty name stops grouping the assets
+			inline
+			const std::string&
+			currentBundle() const
+			{
+				return _currentBundle;
+			}
+
+			inline
+			Ptr
+			currentBundle(const std::string& name)
+			{
+				_currentBundle = name;
+
+				return shared_from_this();
+			}
+
+			// releases all the assets of the bundle, see release*()
+			Ptr
+			unloadBundle(const std::string& name);
+
+			// removes the asset from the library: its GPU resources are disposed unless it is still referenced
+			// outside of the library, by a surface or another asset for example
+			Ptr
+			releaseGeometry(const std::string& name);
+
+			Ptr
+			releaseTexture(const std::string& name);
+
+			Ptr
+			releaseMaterial(const std::string& name);
+
+			Ptr
+			releaseSymbol(const std::string& name);
+
+			Ptr
+			releaseBlob(const std::string& name);
+
+			// releases the materials, geometries and textures referenced by the library only, and returns
+			// their number
+			uint
+			unloadUnused();
+
 			NodePtr
 			symbol(const std::string& name);
 
@@ -168,6 +391,13 @@ namespace minko
 			const std::string&
 			effectName(EffectPtr effect);
 
+			inline
+			const std::unordered_map<std::string, EffectPtr>&
+			effects() const
+			{
+				return _effects;
+			}
+
 			const std::vector<unsigned char>&
 			blob(const std::string& name);
 
@@ -186,6 +416,10 @@ namespace minko
 			const unsigned int
 			layout(const std::string& name);
 
+			// also emitted as profiler counters when the profiler is enabled
+			MemoryReport
+			memoryReport() const;
+
 			Ptr
 			layout(const std::string& name, const unsigned int mask);
 
@@ -271,15 +505,65 @@ namespace minko
 			Ptr
 			load(bool executeCompleteSignal = true);
 
+			// loads filename once for every caller asking for it with the same include paths until the library
+			// completes, by decreasing options->loadPriority(): parsers should load their dependencies with it
+			Ptr
+			fetch(const std::string&				filename,
+				  std::shared_ptr<file::Options>	options,
+				  FetchHandler						complete,
+				  FetchHandler						error);
+
 		private:
 			AssetLibrary(AbsContextPtr context);
 
+			// references held by the library and its memory budget
+			uint
+			internalUseCount(std::shared_ptr<render::AbstractResource> resource) const;
+
+			void
+			disposeResource(std::shared_ptr<render::AbstractResource> resource, uint numOwners);
+
+			void
+			forgetHashedAsset(const std::string& name);
+
 			void
 			loaderErrorHandler(std::shared_ptr<file::AbstractLoader> loader);
 
 			void
 			loaderCompleteHandler(std::shared_ptr<file::AbstractLoader> loader);
 
+			void
+			loaderChunkHandler(std::shared_ptr<file::AbstractLoader> loader, uint offset, uint size);
+
+			std::shared_ptr<file::AbstractParser>
+			getParser(std::shared_ptr<file::AbstractLoader> loader);
+
+			void
+			parse(std::shared_ptr<AbstractLoader> loader, std::shared_ptr<AbstractParser> parser);
+
+			void
+			fetch(const std::string&				filename,
+				  std::shared_ptr<file::Options>	options,
+				  AbsLoaderPtr						loader,
+				  FetchHandler						complete,
+				  FetchHandler						error);
+
+			void
+			startPendingFetches();
+
+			void
+			fetchComplete(FetchPtr fetch, bool succeeded);
+
+			static
+			bool
+			lowerFetchPriority(const FetchPtr& a, const FetchPtr& b);
+
+			void
+			parseDecoded();
+
+			void
+			scheduleParseDecoded();
+
 			void
 			finalize(const std::string& filename);
 		};
@@ -27,6 +27,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/render/Blending.hpp"
 #include "minko/render/Shader.hpp"
 
+#include <mutex>
+
 namespace Json
 {
 	class Value;
@@ -46,7 +48,9 @@ namespace minko
 			enum class GLSLBlockType
 			{
 				TEXT,
-				FILE
+				FILE,
+				// include resolved to a file of the GLSL cache
+				INCLUDE
 			};
 
 		private:
@@ -83,11 +87,31 @@ namespace minko
 			typedef std::forward_list<GLSLBlock> 							GLSLBlockList;
 			typedef std::shared_ptr<GLSLBlockList>							GLSLBlockListPtr;
 
+			struct GLSLInclude
+			{
+				GLSLBlockListPtr		blocks;
+				// used to resolve the includes of the file
+				std::list<std::string>	includePaths;
+			};
+
+			typedef std::shared_ptr<GLSLInclude>							GLSLIncludePtr;
+
+			struct PassShaders
+			{
+				std::weak_ptr<render::Pass>	pass;
+				GLSLBlockListPtr			vertexBlocks;
+				GLSLBlockListPtr			fragmentBlocks;
+			};
+
 		private:
-			static std::unordered_map<std::string, unsigned int>				_blendFactorMap;
-			static std::unordered_map<std::string, render::CompareMode>			_compareFuncMap;
-			static std::unordered_map<std::string, render::StencilOperation>	_stencilOpMap;
-			static std::unordered_map<std::string, float>						_priorityMap;
+			// parsed GLSL files by resolved filename, shared by all the effects
+			static std::unordered_map<std::string, GLSLIncludePtr>				_glslIncludeCache;
+			// resolved filenames by include filename and include paths
+			static std::unordered_map<std::string, std::string>				_glslResolvedFilenames;
+			// passes to update when one of their includes is reloaded
+			static std::list<PassShaders>										_glslPasses;
+			// the effects can be parsed by the threads of different contexts
+			static std::recursive_mutex										_glslCacheMutex;
 
 		private:
             std::string                                                 _filename;
@@ -111,6 +135,8 @@ namespace minko
 			unsigned int												_numLoadedDependencies;
 
 			std::unordered_map<ShaderPtr, GLSLBlockListPtr>				_glslBlocks;
+			// includes parsed by this effect, added to the cache once all of them are loaded
+			std::unordered_map<std::string, GLSLIncludePtr>				_glslIncludes;
 
 			std::vector<PassPtr>										_globalPasses;
 			std::unordered_map<std::string, AbstractTexturePtr>					_globalTargets;
@@ -118,8 +144,6 @@ namespace minko
 			std::unordered_map<std::string, std::vector<PassPtr>>		_techniquePasses;
 			std::unordered_map<std::string, std::string>				_techniqueFallback;
 			
-			std::unordered_map<LoaderPtr, Signal<LoaderPtr>::Slot>		_loaderCompleteSlots;
-			std::unordered_map<LoaderPtr, Signal<LoaderPtr>::Slot>		_loaderErrorSlots;
 
 		public:
 			inline static
@@ -150,6 +174,25 @@ namespace minko
 				  const std::vector<unsigned char>&	data,
 				  std::shared_ptr<AssetLibrary>		assetLibrary);
 
+			inline static
+			bool
+			hasCachedGLSL(const std::string& resolvedFilename)
+			{
+				return _glslIncludeCache.count(resolvedFilename) != 0;
+			}
+
+			// replaces a cached GLSL file and updates the shaders of the passes including it, which
+			// are returned; the files it includes must have already been loaded by an effect
+			static
+			std::vector<PassPtr>
+			reloadGLSL(const std::string& resolvedFilename, const std::vector<unsigned char>& data);
+
+			// the effects parsed afterwards load their includes again, the passes created before can
+			// no longer be reloaded
+			static
+			void
+			clearGLSLCache();
+
 		private:
 			EffectParser();
 
@@ -189,11 +232,9 @@ namespace minko
 						std::shared_ptr<file::Options>  options,
 						render::Shader::Type 			type);
 
+			static
 			void
-			parseGLSL(std::string 						glsl,
-					  std::shared_ptr<file::Options>	options,
-					  GLSLBlockListPtr 					blocks,
-	 				  GLSLBlockList::iterator 			fileBlock);
+			parseGLSL(const std::string& glsl, GLSLBlockListPtr blocks);
 
 			void
 			loadGLSLDependencies(GLSLBlockListPtr				blocks,
@@ -202,7 +243,15 @@ namespace minko
 			void
 			glslIncludeCompleteHandler(LoaderPtr 				loader,
 									   GLSLBlockListPtr 		blocks,
-	 								   GLSLBlockList::iterator 	fileBlock);
+	 								   GLSLBlockList::iterator 	fileBlock,
+									   const std::string&		includeKey);
+
+			static
+			std::string
+			glslIncludeKey(const std::string& filename, const std::list<std::string>& includePaths);
+
+			GLSLIncludePtr
+			findGLSLInclude(const std::string& resolvedFilename);
 
 			void
 			parseBindingNameAndSource(const Json::Value& contextNode, std::string& name, data::BindingSource& source);
@@ -309,6 +358,23 @@ namespace minko
 			std::string
 			concatenateIncludes(std::vector<LoaderPtr>& store);
 
+			// the maps are built on their first use rather than during the static initialization
+			static
+			std::unordered_map<std::string, unsigned int>&
+			blendFactorMap();
+
+			static
+			std::unordered_map<std::string, render::CompareMode>&
+			compareFuncMap();
+
+			static
+			std::unordered_map<std::string, render::StencilOperation>&
+			stencilOpMap();
+
+			static
+			std::unordered_map<std::string, float>&
+			priorityMap();
+
 			static
 			std::unordered_map<std::string, unsigned int>
 			initializeBlendFactorMap();
@@ -329,9 +395,14 @@ namespace minko
 			float
 			priority(const std::string&);
 
+			static
 			std::string
 			concatenateGLSLBlocks(GLSLBlockListPtr blocks);
 
+			static
+			bool
+			includesGLSL(GLSLBlockListPtr blocks, const std::string& resolvedFilename);
+
 			void
 			finalize();
 
@@ -39,6 +39,9 @@ namespace minko
             }
 
 			typedef std::shared_ptr<FileLoader>	Ptr;
+
+			static const uint CHUNK_SIZE;
+
 			void
 			load(const std::string& filename, std::shared_ptr<Options> options);
 
@@ -48,6 +51,9 @@ namespace minko
 		private:
 			std::list<Any>
 			_workerSlots;
+
+			bool
+			loadFromArchive(const std::string& filename);
 		};
 	}
 }
@@ -51,6 +51,7 @@ namespace minko
 		private:
 			std::shared_ptr<render::AbstractContext>	_context;
 			std::list<std::string>						_includePaths;
+			std::list<std::shared_ptr<PackedArchive>>	_archives;
 			std::list<std::string>						_platforms;
 			std::list<std::string>						_userFlags;
 
@@ -59,10 +60,18 @@ namespace minko
 			bool										_isCubeTexture;
 			bool										_startAnimation;
 			bool										_loadAsynchronously;
+			bool										_optimizeGeometries;
+			bool										_compressGeometries;
+			bool										_disposeGeometryData;
+			bool										_shareMaterials;
+			int											_loadPriority;
+			uint										_maxTextureSize;
 			unsigned int								_skinningFramerate;
 			component::SkinningMethod					_skinningMethod;
+			float										_skinningCompressionTolerance;
             std::shared_ptr<render::Effect>             _effect;
 			MaterialPtr									_material;
+			std::shared_ptr<render::TextureStreamer>	_textureStreamer;
 			MaterialFunction							_materialFunction;
 			GeometryFunction							_geometryFunction;
 			LoaderFunction								_loaderFunction;
@@ -85,19 +94,28 @@ namespace minko
 				auto opt = std::shared_ptr<Options>(new Options(options->_context));
 				
 				opt->_includePaths				= options->_includePaths;
+				opt->_archives					= options->_archives;
                 opt->_generateMipMaps			= options->_generateMipMaps;
 				opt->_resizeSmoothly			= options->_resizeSmoothly;
 				opt->_isCubeTexture				= options->_isCubeTexture;
 				opt->_startAnimation			= options->_startAnimation;
 				opt->_skinningFramerate			= options->_skinningFramerate;
 				opt->_skinningMethod			= options->_skinningMethod;
+				opt->_skinningCompressionTolerance	= options->_skinningCompressionTolerance;
                 opt->_effect					= options->_effect;
+				opt->_textureStreamer			= options->_textureStreamer;
 				opt->_materialFunction			= options->_materialFunction;
 				opt->_geometryFunction			= options->_geometryFunction;
 				opt->_loaderFunction			= options->_loaderFunction;
 				opt->_uriFunction				= options->_uriFunction;
 				opt->_nodeFunction				= options->_nodeFunction;
 				opt->_loadAsynchronously		= options->_loadAsynchronously;
+				opt->_optimizeGeometries		= options->_optimizeGeometries;
+				opt->_compressGeometries		= options->_compressGeometries;
+				opt->_disposeGeometryData		= options->_disposeGeometryData;
+				opt->_shareMaterials			= options->_shareMaterials;
+				opt->_loadPriority				= options->_loadPriority;
+				opt->_maxTextureSize			= options->_maxTextureSize;
 
 				return opt;
 			}
@@ -116,6 +134,14 @@ namespace minko
 				return _includePaths;
 			}
 
+			// mounted archives are searched before the file system, by file name and then include path
+			inline
+			std::list<std::shared_ptr<PackedArchive>>&
+			archives()
+			{
+				return _archives;
+			}
+
 			inline
 			std::list<std::string>&
 			platforms()
@@ -178,6 +204,109 @@ namespace minko
 				return shared_from_this();
 			}
 
+			// imported and serialized geometries go through Geometry::optimize()
+			inline
+			bool
+			optimizeGeometries() const
+			{
+				return _optimizeGeometries;
+			}
+
+			inline
+			Ptr
+			optimizeGeometries(bool value)
+			{
+				_optimizeGeometries = value;
+
+				return shared_from_this();
+			}
+
+			// serialized geometries are quantized and delta encoded, positions and uvs lose precision
+			inline
+			bool
+			compressGeometries() const
+			{
+				return _compressGeometries;
+			}
+
+			inline
+			Ptr
+			compressGeometries(bool value)
+			{
+				_compressGeometries = value;
+
+				return shared_from_this();
+			}
+
+			// parsed geometries free their CPU-side vertices and indices once uploaded, see Geometry::disposeData()
+			inline
+			bool
+			disposeGeometryData() const
+			{
+				return _disposeGeometryData;
+			}
+
+			inline
+			Ptr
+			disposeGeometryData(bool value)
+			{
+				_disposeGeometryData = value;
+
+				return shared_from_this();
+			}
+
+			// parsed materials with the same type and properties are replaced by a single one interned in the
+			// asset library, see AssetLibrary::internMaterial()
+			inline
+			bool
+			shareMaterials() const
+			{
+				return _shareMaterials;
+			}
+
+			inline
+			Ptr
+			shareMaterials(bool value)
+			{
+				_shareMaterials = value;
+
+				return shared_from_this();
+			}
+
+			// files with higher priorities are loaded first, dependencies inherit the priority of their parent file
+			inline
+			int
+			loadPriority() const
+			{
+				return _loadPriority;
+			}
+
+			inline
+			Ptr
+			loadPriority(int value)
+			{
+				_loadPriority = value;
+
+				return shared_from_this();
+			}
+
+			// images larger than this are downscaled while they are decoded, 0 keeps their size
+			inline
+			uint
+			maxTextureSize() const
+			{
+				return _maxTextureSize;
+			}
+
+			inline
+			Ptr
+			maxTextureSize(uint value)
+			{
+				_maxTextureSize = value;
+
+				return shared_from_this();
+			}
+
 			inline
 			bool
 			resizeSmoothly() const
@@ -242,6 +371,23 @@ namespace minko
 				return shared_from_this();
 			}
 
+			// when positive, skin animations are stored as key reduced tracks deviating at most by this value
+			inline
+			float
+			skinningCompressionTolerance() const
+			{
+				return _skinningCompressionTolerance;
+			}
+
+			inline
+			Ptr
+			skinningCompressionTolerance(float value)
+			{
+				_skinningCompressionTolerance = value;
+
+				return shared_from_this();
+			}
+
             inline
             std::shared_ptr<render::Effect>
             effect() const
@@ -274,6 +420,23 @@ namespace minko
 				return shared_from_this();
 			}
 
+			// when set, parsers stream the precomputed mipmaps of textures instead of uploading them at once
+			inline
+			std::shared_ptr<render::TextureStreamer>
+			textureStreamer() const
+			{
+				return _textureStreamer;
+			}
+
+			inline
+			Ptr
+			textureStreamer(std::shared_ptr<render::TextureStreamer> streamer)
+			{
+				_textureStreamer = streamer;
+
+				return shared_from_this();
+			}
+
 			inline
 			const LoaderFunction&
 			loaderFunction() const
@@ -0,0 +1,138 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+	namespace file
+	{
+		// read-only archive packing many asset files into one: a table of contents followed by the file
+		// contents, each aligned on ALIGNMENT bytes and optionally compressed, the archive is memory mapped
+		// when the platform allows it and names are resolved with a single hash lookup
+		class PackedArchive
+		{
+		public:
+			typedef std::shared_ptr<PackedArchive>	Ptr;
+
+			// inflates the size bytes at data into output, whose size is already the uncompressed size
+			typedef std::function<bool(const unsigned char*, uint, std::vector<unsigned char>&)>	Decompressor;
+			typedef std::function<bool(const std::vector<unsigned char>&, std::vector<unsigned char>&)>	Compressor;
+
+			enum class Compression
+			{
+				NONE	= 0,
+				DEFLATE	= 1
+			};
+
+			struct Entry
+			{
+				uint64_t	offset;
+				uint		size;
+				uint		storedSize;
+				Compression	compression;
+			};
+
+			static const uint MAGIC;
+			static const uint VERSION;
+			static const uint ALIGNMENT;
+
+		private:
+			std::string								_filename;
+			std::unordered_map<std::string, Entry>	_entries;
+			const unsigned char*					_mapping;
+			uint64_t								_mappingSize;
+			std::vector<unsigned char>				_buffer;
+			Decompressor							_decompressor;
+
+		public:
+			~PackedArchive();
+
+			// returns nullptr when the file cannot be opened or is not an archive
+			static
+			Ptr
+			open(const std::string& filename);
+
+			// packs the files as named entries, those the compressor shrinks are stored compressed
+			static
+			bool
+			write(const std::string&										filename,
+				  const std::map<std::string, std::vector<unsigned char>>&	files,
+				  Compressor												compressor = nullptr);
+
+			inline
+			const std::string&
+			filename() const
+			{
+				return _filename;
+			}
+
+			inline
+			uint
+			numEntries() const
+			{
+				return _entries.size();
+			}
+
+			inline
+			const std::unordered_map<std::string, Entry>&
+			entries() const
+			{
+				return _entries;
+			}
+
+			inline
+			bool
+			hasEntry(const std::string& name) const
+			{
+				return _entries.count(normalize(name)) != 0;
+			}
+
+			// required to read the entries stored with Compression::DEFLATE
+			inline
+			void
+			decompressor(Decompressor decompressor)
+			{
+				_decompressor = decompressor;
+			}
+
+			// the stored bytes of an uncompressed entry, pointing inside the mapped archive, or nullptr
+			const unsigned char*
+			slice(const std::string& name, uint& size) const;
+
+			bool
+			read(const std::string& name, std::vector<unsigned char>& output) const;
+
+			static
+			std::string
+			normalize(const std::string& name);
+
+		private:
+			PackedArchive(const std::string& filename);
+
+			bool
+			map();
+
+			bool
+			readTableOfContents();
+		};
+	}
+}
@@ -38,7 +38,7 @@ namespace minko
 		private:
 			const NodePtr								_node;
 			const Matrix4x4Ptr							_offsetMatrix;
-			const std::vector<unsigned short>			_vertexIds;
+			const std::vector<uint>						_vertexIds;
 			const std::vector<float>					_vertexWeights;
 		
 		public:
@@ -47,7 +47,7 @@ namespace minko
 			Ptr
 			create(NodePtr								node, 
 				   Matrix4x4Ptr							offsetMatrix, 
-				   const std::vector<unsigned short>&	vertexIds, 
+				   const std::vector<uint>&				vertexIds, 
 				   const std::vector<float>&			vertexWeights)
 			{
 				return std::shared_ptr<Bone>(new Bone(node, offsetMatrix, vertexIds, vertexWeights));
@@ -68,7 +68,7 @@ namespace minko
 			}
 
 			inline
-			const std::vector<unsigned short>&
+			const std::vector<uint>&
 			vertexIds() const
 			{
 				return _vertexIds;
@@ -82,7 +82,7 @@ namespace minko
 			}
 
 		private:
-			Bone(NodePtr, Matrix4x4Ptr, const std::vector<unsigned short>&, const std::vector<float>&);
+			Bone(NodePtr, Matrix4x4Ptr, const std::vector<uint>&, const std::vector<float>&);
 		};
 	}
 }
@@ -33,6 +33,8 @@ namespace minko
 		public:
 			typedef std::shared_ptr<Geometry> Ptr;
 
+			static const uint PARALLEL_MIN_NUM_TRIANGLES = 65536;
+
 		private:
 			typedef std::shared_ptr<render::VertexBuffer> VBPtr;
 			typedef std::shared_ptr<data::ArrayProvider>  ProviderPtr;
@@ -46,6 +48,12 @@ namespace minko
 
 			std::unordered_map<VBPtr, Signal<VBPtr, int>::Slot>	_vbToVertexSizeChangedSlot;
 
+			// built on the first cast, dropped when the positions or the indices change
+			std::shared_ptr<TriangleBVH>			_bvh;
+			std::shared_ptr<MeshAdjacency>			_adjacency;
+			std::shared_ptr<math::Box>				_boundingBox;
+			Signal<VBPtr>::Slot						_positionChangedSlot;
+
 		public:
 			virtual
 			~Geometry()
@@ -109,6 +117,9 @@ namespace minko
 			indices(std::shared_ptr<render::IndexBuffer> indices)
 			{
 				_indexBuffer = indices;
+				_bvh = nullptr;
+				_adjacency = nullptr;
+				_boundingBox = nullptr;
 				_data->set("indices", indices);
 			}
 
@@ -148,14 +159,49 @@ namespace minko
 			Ptr
 			computeTangentSpace(bool computeNormals);
 
+			// area weighted vertex normals, computed over several threads for large meshes
+			static
 			void
-			removeDuplicatedVertices();
+			computeNormals(const std::vector<float>&	xyzData,
+						   uint							xyzSize,
+						   uint							xyzOffset,
+						   const std::vector<uint>&		indices,
+						   std::vector<float>&			normals);
 
 			static
 			void
-			removeDuplicatedVertices(std::vector<unsigned short>&		indices,
+			computeTangents(const std::vector<float>&	xyzData,
+							uint						xyzSize,
+							uint						xyzOffset,
+							const std::vector<float>&	uvData,
+							uint						uvSize,
+							uint						uvOffset,
+							const std::vector<uint>&	indices,
+							std::vector<float>&			tangents);
+
+			// vertices closer than epsilon on every component of every vertex buffer are welded
+			void
+			removeDuplicatedVertices(float epsilon = 0.f);
+
+			// packs the static vertex buffers into a single one
+			Ptr
+			interleave();
+
+			// removes the duplicated vertices, reorders the triangles for the vertex cache and to reduce
+			// overdraw, renumbers the vertices in fetch order and interleaves the vertex buffers
+			Ptr
+			optimize(uint cacheSize = 32);
+
+			// new geometry with about ratio times the triangles, sharing the vertex buffers of this one
+			Ptr
+			simplify(float ratio);
+
+			static
+			void
+			removeDuplicatedVertices(std::vector<uint>&					indices,
 									 std::vector<std::vector<float>>&	vertices,
-									 uint								numVertices);
+									 uint								numVertices,
+									 float								epsilon = 0.f);
 
 			bool
 			cast(std::shared_ptr<math::Ray>		ray,
@@ -165,9 +211,32 @@ namespace minko
 				 std::shared_ptr<math::Vector2>	hitUv 		= nullptr,
 				 std::shared_ptr<math::Vector3>	hitNormal 	= nullptr);
 
+			// casts all the rays, distances and triangles of the rays that miss are set to -1
+			uint
+			cast(const std::vector<std::shared_ptr<math::Ray>>&	rays,
+				 std::vector<float>&							distances,
+				 std::vector<int>&								triangles);
+
+			std::shared_ptr<TriangleBVH>
+			bvh();
+
+			// built on the first call over the welded positions, shared by all the adjacency queries
+			std::shared_ptr<MeshAdjacency>
+			adjacency();
+
+			// model space bounds of the positions, cached until they change
+			std::shared_ptr<math::Box>
+			boundingBox();
+
 			void
 			upload();
 
+			// frees the CPU-side copies of the uploaded vertices and indices, the bounding box and the BVH are
+			// built beforehand when keepCastData is true so that the geometry can still be cast, without hit uvs
+			// and normals: the data has to be restored in the buffers before any other CPU-side processing
+			void
+			disposeData(bool keepCastData = true);
+
 			inline
 			bool
 			equals(Ptr geom)
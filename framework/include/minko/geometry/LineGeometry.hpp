@@ -33,7 +33,8 @@ namespace minko
 			typedef std::shared_ptr<LineGeometry> Ptr;
 	
 		private:
-			static const uint						MAX_NUM_LINES;
+			static const uint						MIN_CAPACITY;
+			static const uint						MAX_NUM_SHORT_INDEXED_LINES;
 			static const std::string				ATTRNAME_START_POS;
 			static const std::string				ATTRNAME_STOP_POS;
 			static const std::string				ATTRNAME_WEIGHTS;
@@ -68,6 +69,13 @@ namespace minko
 				return _numLines;
 			}
 
+			// number of lines the GPU buffers are allocated for, it doubles when lines are appended beyond it
+			uint
+			capacity() const;
+
+			Ptr
+			reserve(uint numLines);
+
 			inline
 			Ptr
 			moveTo(float x, float y, float z)
@@ -88,12 +96,33 @@ namespace minko
 			Ptr
 			lineTo(std::shared_ptr<math::Vector3>, unsigned int numSegments = 1);
 
+			// appends numLines independent lines, stored as start and stop xyz positions in points, the
+			// buffers are uploaded once and only for the appended lines
+			Ptr
+			lines(const float* points, uint numLines);
+
+			inline
+			Ptr
+			lines(const std::vector<float>& points)
+			{
+				return lines(points.empty() ? nullptr : &points[0], points.size() / 6);
+			}
+
+			// removes all the lines but keeps the capacity, to rebuild the lines every frame
+			Ptr
+			clear();
 
 		private:
 			LineGeometry();
 
 			void
 			initialize(std::shared_ptr<render::AbstractContext>);
+
+			std::pair<float*, uint*>
+			appendLines(uint numLines);
+
+			void
+			uploadLines(uint firstLine);
 		};
 	}
 }
@@ -0,0 +1,184 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+	namespace geometry
+	{
+		// edge adjacency of an indexed triangle mesh as flat arrays: half-edge h goes from the corner
+		// h to the next corner of the triangle h / 3, the vertices sharing a position are welded so that
+		// the seams of the normals or the uvs do not split the surface
+		class MeshAdjacency
+		{
+		public:
+			typedef std::shared_ptr<MeshAdjacency>	Ptr;
+
+			static const int						NO_HALF_EDGE = -1;
+
+		private:
+			std::vector<uint>	_indices;
+			std::vector<uint>	_weldedVertices;	// first vertex with the same position, per vertex
+			std::vector<int>	_opposites;			// per half-edge, NO_HALF_EDGE on the boundaries
+			std::vector<int>	_vertexHalfEdges;	// one half-edge leaving each welded vertex
+			uint				_numBoundaryEdges;
+			uint				_numNonManifoldEdges;
+
+		public:
+			// positions can be null to use the indices as they are
+			inline static
+			Ptr
+			create(const std::vector<uint>&		indices,
+				   uint							numVertices,
+				   const float*					positions		= nullptr,
+				   uint							vertexSize		= 3)
+			{
+				auto adjacency = std::shared_ptr<MeshAdjacency>(new MeshAdjacency());
+
+				adjacency->build(indices, numVertices, positions, vertexSize);
+
+				return adjacency;
+			}
+
+			inline
+			uint
+			numTriangles() const
+			{
+				return _opposites.size() / 3;
+			}
+
+			inline
+			uint
+			numHalfEdges() const
+			{
+				return _opposites.size();
+			}
+
+			inline
+			uint
+			numBoundaryEdges() const
+			{
+				return _numBoundaryEdges;
+			}
+
+			// edges shared by more than two triangles, only two of their half-edges are paired
+			inline
+			uint
+			numNonManifoldEdges() const
+			{
+				return _numNonManifoldEdges;
+			}
+
+			inline
+			uint
+			triangle(uint halfEdge) const
+			{
+				return halfEdge / 3;
+			}
+
+			inline
+			uint
+			next(uint halfEdge) const
+			{
+				return halfEdge % 3 == 2 ? halfEdge - 2 : halfEdge + 1;
+			}
+
+			inline
+			uint
+			previous(uint halfEdge) const
+			{
+				return halfEdge % 3 == 0 ? halfEdge + 2 : halfEdge - 1;
+			}
+
+			inline
+			int
+			opposite(uint halfEdge) const
+			{
+				return _opposites[halfEdge];
+			}
+
+			inline
+			bool
+			isBoundary(uint halfEdge) const
+			{
+				return _opposites[halfEdge] == NO_HALF_EDGE;
+			}
+
+			// vertex of the index buffer the half-edge starts from
+			inline
+			uint
+			startVertex(uint halfEdge) const
+			{
+				return _indices[halfEdge];
+			}
+
+			inline
+			uint
+			endVertex(uint halfEdge) const
+			{
+				return _indices[next(halfEdge)];
+			}
+
+			inline
+			uint
+			weldedVertex(uint vertex) const
+			{
+				return _weldedVertices[vertex];
+			}
+
+			// triangle across the edge-th edge of a triangle, -1 on the boundaries
+			inline
+			int
+			adjacentTriangle(uint triangle, uint edge) const
+			{
+				const int opposite = _opposites[3 * triangle + edge];
+
+				return opposite == NO_HALF_EDGE ? -1 : opposite / 3;
+			}
+
+			// a half-edge leaving the vertex, NO_HALF_EDGE when no triangle uses it
+			inline
+			int
+			vertexHalfEdge(uint vertex) const
+			{
+				return _vertexHalfEdges[_weldedVertices[vertex]];
+			}
+
+			// half-edges leaving the vertex, turning around it until a boundary is met on both sides
+			void
+			vertexHalfEdges(uint vertex, std::vector<uint>& halfEdges) const;
+
+			// sets the id of the connected surface of each triangle, returns the number of surfaces
+			uint
+			connectedComponents(std::vector<uint>& triangleComponents) const;
+
+		private:
+			MeshAdjacency();
+
+			void
+			build(const std::vector<uint>& indices, uint numVertices, const float* positions, uint vertexSize);
+
+			void
+			weldVertices(uint numVertices, const float* positions, uint vertexSize);
+		};
+	}
+}
@@ -0,0 +1,76 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+	namespace geometry
+	{
+		// index and vertex reordering passes for indexed triangle lists
+		class MeshOptimizer
+		{
+		public:
+			static const uint DEFAULT_CACHE_SIZE = 32;
+
+		public:
+			// reorders the triangles for the post-transform vertex cache (Tom Forsyth's linear-speed algorithm)
+			static
+			void
+			optimizeVertexCache(std::vector<uint>& indices, uint numVertices, uint cacheSize = DEFAULT_CACHE_SIZE);
+
+			// splits the triangles in clusters where the cache would be flushed and draws the outward facing
+			// clusters first, to be called after optimizeVertexCache()
+			static
+			void
+			optimizeOverdraw(std::vector<uint>&			indices,
+							 const std::vector<float>&	vertices,
+							 uint						vertexSize,
+							 uint						positionOffset,
+							 uint						cacheSize = DEFAULT_CACHE_SIZE);
+
+			// renumbers the vertices in the order they are first used and returns the old to new vertex ids,
+			// unused vertices are moved at the end
+			static
+			std::vector<uint>
+			optimizeVertexFetch(std::vector<uint>& indices, uint numVertices);
+
+			// collapses edges by increasing quadric error until at most targetNumIndices are left, vertices are
+			// only merged into one another so the vertex buffers can be shared with the original mesh
+			static
+			std::vector<uint>
+			simplify(const std::vector<uint>&	indices,
+					 const std::vector<float>&	vertices,
+					 uint						vertexSize,
+					 uint						positionOffset,
+					 uint						targetNumIndices);
+
+			static
+			void
+			remapVertices(std::vector<float>& vertices, uint vertexSize, const std::vector<uint>& remap);
+
+			// average number of vertex shader invocations per triangle with a FIFO cache
+			static
+			float
+			averageCacheMissRatio(const std::vector<uint>& indices, uint numVertices, uint cacheSize = DEFAULT_CACHE_SIZE);
+		};
+	}
+}
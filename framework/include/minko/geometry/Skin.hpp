@@ -37,13 +37,29 @@ namespace minko
 			typedef std::shared_ptr<Bone>					BonePtr;
 			typedef std::shared_ptr<math::Matrix4x4>		Matrix4x4Ptr;
 
+			// keys of a bone's translation, rotation or scale, quantized on 16 bits within [min, min + 65535 * step]
+			struct Track
+			{
+				std::vector<unsigned short>	frames;
+				std::vector<unsigned short>	values;		// numComponents per key
+				std::vector<float>			min;
+				std::vector<float>			step;
+			};
+
+			typedef std::pair<uint, std::vector<float>>		CachedMatrices;
+
+			static const unsigned int						NUM_CACHED_MATRICES = 8;
+
 		private:
 			const unsigned int				_numBones;
 			std::vector<BonePtr>			_bones;
 
 			const uint						_duration;				// in milliseconds
 			const float						_timeFactor;
-			std::vector<std::vector<float>>	_boneMatricesPerFrame;
+			const unsigned int				_numFrames;
+			std::vector<std::vector<float>>	_boneMatricesPerFrame;	// empty once compressed
+			std::vector<Track>				_tracks;				// translation, rotation and scale of each bone
+			mutable std::list<CachedMatrices>	_cachedMatrices;		// last interpolated times, most recent first
 
 			unsigned int					_maxNumVertexBones;
 			std::vector<unsigned int>		_numVertexBones;		// size = #vertices
@@ -108,7 +124,7 @@ namespace minko
 			unsigned int
 			numFrames() const
 			{
-				return _boneMatricesPerFrame.size();
+				return _numFrames;
 			}
 
 			inline
@@ -118,6 +134,17 @@ namespace minko
 				return _boneMatricesPerFrame[frameId];
 			}
 
+			inline
+			bool
+			compressed() const
+			{
+				return !_tracks.empty();
+			}
+
+			// fills output with the bone matrices at the given time, in the layout of matrices()
+			void
+			interpolateMatrices(uint time, std::vector<float>& output) const;
+
 			void
 			matrix(unsigned int frameId, unsigned int boneId, Matrix4x4Ptr);
 
@@ -157,12 +184,32 @@ namespace minko
 			Ptr
 			transposeMatrices();
 
+			// replaces the sampled matrices by key reduced translation, rotation and scale tracks
+			// interpolated at runtime, expects transposed matrices without shear
+			Ptr
+			compressMatrices(float tolerance);
+
+			// bytes of bone matrices, tracks and vertex weights kept on the CPU
+			uint
+			memorySize() const;
+
 		private:
 			Skin(unsigned int numBones, unsigned int duration, unsigned int numFrames);
 
-			unsigned short
+			uint
 			lastVertexId() const;
 
+			static
+			void
+			compressTrack(const std::vector<float>& values, unsigned int numComponents, float tolerance, Track& track);
+
+			void
+			evaluateMatrices(uint time, float* output) const;
+
+			static
+			void
+			interpolateTrack(const Track& track, float frame, unsigned int numComponents, float* output);
+
 			inline
 			unsigned int
 			vertexArraysIndex(unsigned int vertexId, unsigned int j) const
@@ -0,0 +1,105 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include "minko/Signal.hpp"
+#include "minko/component/JobManager.hpp"
+
+namespace minko
+{
+	namespace geometry
+	{
+		// computes the normals and/or the tangents of a geometry off the main thread, the vertex buffers are
+		// created and added to the geometry by the last step
+		class TangentSpaceJob :
+			public component::JobManager::Job,
+			public std::enable_shared_from_this<TangentSpaceJob>
+		{
+		public:
+			typedef std::shared_ptr<TangentSpaceJob>	Ptr;
+
+		private:
+			typedef std::shared_ptr<Geometry>			GeometryPtr;
+
+		private:
+			GeometryPtr							_geometry;
+			bool								_computeNormals;
+			bool								_computeTangents;
+
+			std::vector<float>					_normals;
+			std::vector<float>					_tangents;
+			std::future<void>					_result;
+			bool								_done;
+
+			Signal<Ptr, GeometryPtr>::Ptr		_finished;
+
+		public:
+			inline static
+			Ptr
+			create(GeometryPtr geometry, bool computeNormals = true, bool computeTangents = false)
+			{
+				return std::shared_ptr<TangentSpaceJob>(new TangentSpaceJob(geometry, computeNormals, computeTangents));
+			}
+
+			inline
+			Signal<Ptr, GeometryPtr>::Ptr
+			finished() const
+			{
+				return _finished;
+			}
+
+			bool
+			complete();
+
+			void
+			beforeFirstStep();
+
+			void
+			step();
+
+			float
+			priority();
+
+			void
+			afterLastStep();
+
+			// the computation runs on its own, nothing to do in the rest of the frame
+			bool
+			yieldFrame()
+			{
+				return true;
+			}
+
+		private:
+			TangentSpaceJob(GeometryPtr geometry, bool computeNormals, bool computeTangents);
+
+			void
+			compute(std::vector<float>	xyzData,
+					uint				xyzSize,
+					uint				xyzOffset,
+					std::vector<float>	uvData,
+					uint				uvSize,
+					uint				uvOffset,
+					std::vector<uint>	indices);
+		};
+	}
+}
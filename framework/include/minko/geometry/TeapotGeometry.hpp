@@ -59,7 +59,7 @@ namespace minko
 			genPatchVertices(std::vector<std::vector<float>>& patch, const uint divs, std::vector<float>& vertices);
 
 			void
-			genPatchIndices(const uint offset, const uint divs, std::vector<unsigned short>& indices);
+			genPatchIndices(const uint offset, const uint divs, std::vector<uint>& indices);
 
 			void
 			bernstein(float					u,
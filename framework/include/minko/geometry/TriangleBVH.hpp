@@ -0,0 +1,136 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+	namespace geometry
+	{
+		// bounding volume hierarchy over the triangles of an indexed mesh, leaves hold packets of
+		// up to 4 triangles tested at once
+		class TriangleBVH
+		{
+		public:
+			typedef std::shared_ptr<TriangleBVH>	Ptr;
+
+			static const uint						PACKET_SIZE = 4;
+
+		private:
+			struct Node
+			{
+				float	min[3];
+				float	max[3];
+				// inner nodes: index of the second child, the first one follows its parent
+				// leaves: index of the packet
+				uint	offset;
+				bool	leaf;
+			};
+
+			// triangles as a vertex and two edges, one component per lane
+			struct Packet
+			{
+				float	v0[3][PACKET_SIZE];
+				float	e1[3][PACKET_SIZE];
+				float	e2[3][PACKET_SIZE];
+				uint	triangle[PACKET_SIZE];
+			};
+
+		private:
+			std::vector<Node>		_nodes;
+			std::vector<Packet>		_packets;
+			uint					_numTriangles;
+
+		public:
+			inline static
+			Ptr
+			create(const std::vector<float>&	vertices,
+				   uint							vertexSize,
+				   uint							positionOffset,
+				   const std::vector<uint>&		indices)
+			{
+				auto bvh = std::shared_ptr<TriangleBVH>(new TriangleBVH());
+
+				bvh->build(vertices, vertexSize, positionOffset, indices);
+
+				return bvh;
+			}
+
+			inline
+			uint
+			numTriangles() const
+			{
+				return _numTriangles;
+			}
+
+			inline
+			uint
+			numNodes() const
+			{
+				return _nodes.size();
+			}
+
+			// closest hit in front of the origin, triangle is the offset of its first index
+			bool
+			cast(const float*	origin,
+				 const float*	direction,
+				 float&			distance,
+				 uint&			triangle,
+				 float&			u,
+				 float&			v) const;
+
+			// casts numRays rays stored as xyz triplets, distances are set to -1 and triangles
+			// to -1 for the rays that do not hit, returns the number of hits
+			uint
+			cast(uint			numRays,
+				 const float*	origins,
+				 const float*	directions,
+				 float*			distances,
+				 int*			triangles) const;
+
+		private:
+			TriangleBVH();
+
+			void
+			build(const std::vector<float>&	vertices,
+				  uint						vertexSize,
+				  uint						positionOffset,
+				  const std::vector<uint>&	indices);
+
+			void
+			buildNode(const std::vector<float>&	bounds,
+					  const std::vector<float>&	centroids,
+					  const std::vector<float>&	edges,
+					  std::vector<uint>&		triangles,
+					  uint						begin,
+					  uint						end);
+
+			void
+			intersectPacket(const Packet&	packet,
+							const float*	origin,
+							const float*	direction,
+							float&			distance,
+							int&			lane,
+							float&			u,
+							float&			v) const;
+		};
+	}
+}
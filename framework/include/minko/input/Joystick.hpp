@@ -27,7 +27,8 @@ namespace minko
 {
 	namespace input
 	{
-		class Joystick
+		class Joystick :
+			public std::enable_shared_from_this<Joystick>
 		{
 		public:
 			typedef std::shared_ptr<Joystick> Ptr;
@@ -42,6 +43,9 @@ namespace minko
 
 			int									_joystickId;
 
+			bool								_coalesceAxisMotion;
+			std::map<int, int>					_pendingAxisMotion; // latest value by axis
+
 		public:
 			inline
 			int
@@ -79,8 +83,27 @@ namespace minko
 				return _joystickButtonUp;
 			}
 
+			// when enabled, joystickAxisMotion() is executed once per frame and per moved axis with its latest
+			// value, right before the frame or the next button event
+			inline
+			bool
+			coalesceAxisMotion() const
+			{
+				return _coalesceAxisMotion;
+			}
+
+			void
+			coalesceAxisMotion(bool value);
+
 		protected:
 			Joystick(std::shared_ptr<AbstractCanvas> canvas, int joystickId);
+
+			// called by the canvas for each axis motion event
+			void
+			axisMotion(int axis, int value);
+
+			void
+			flushAxisMotion();
 		};
 	}
 }
@@ -29,11 +29,20 @@ namespace minko
 {
 	namespace input
 	{
-		class Mouse
+		class Mouse :
+			public std::enable_shared_from_this<Mouse>
 		{
 		public:
 			typedef std::shared_ptr<Mouse>	Ptr;
 
+			// one raw motion event, time in milliseconds
+			struct MotionSample
+			{
+				int		x;
+				int		y;
+				uint	time;
+			};
+
 		protected:
 			std::shared_ptr<AbstractCanvas>	_canvas;
 			
@@ -54,6 +63,15 @@ namespace minko
 
 			std::list<Any>					_slots;
 
+			bool							_coalesceMoves;
+			bool							_movePending;
+			int								_pendingDx;
+			int								_pendingDy;
+
+			bool							_recordHistory;
+			std::vector<MotionSample>		_history;
+			std::vector<MotionSample>		_pendingHistory;
+
 		public:
 			inline static
 			Ptr
@@ -160,8 +178,56 @@ namespace minko
 				return _mouseMiddleButtonUp;
 			}
 
+			// when enabled, all the motion events of a frame execute move() only once with the accumulated deltas,
+			// right before the frame or the next button or wheel event
+			inline
+			bool
+			coalesceMoves() const
+			{
+				return _coalesceMoves;
+			}
+
+			void
+			coalesceMoves(bool value);
+
+			inline
+			bool
+			recordHistory() const
+			{
+				return _recordHistory;
+			}
+
+			inline
+			void
+			recordHistory(bool value)
+			{
+				_recordHistory = value;
+				_pendingHistory.clear();
+				_history.clear();
+			}
+
+			// the raw motion events received during the previous frame when recordHistory() is enabled, for the
+			// consumers that need every sample of a high polling rate mouse
+			inline
+			const std::vector<MotionSample>&
+			history() const
+			{
+				return _history;
+			}
+
 		protected:
 			Mouse(std::shared_ptr<AbstractCanvas> canvas);
+
+			// called by the canvas for each motion event
+			void
+			motion(int x, int y, uint time);
+
+			void
+			flushMove();
+
+			// called by the canvas once the events of the frame were dispatched
+			void
+			nextFrame();
 		};
 	}
 }
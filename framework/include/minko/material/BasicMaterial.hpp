@@ -74,6 +74,13 @@ namespace minko
 			TexturePtr
 			diffuseMap() const;
 
+			// the diffuse map is the atlas of the texture, see TextureAtlas::uvRect()
+			Ptr
+			diffuseMap(std::shared_ptr<render::TextureAtlas> atlas, TexturePtr texture);
+
+			Vector4Ptr
+			diffuseMapUVRect() const;
+
 			Ptr
 			diffuseCubeMap(AbsTexturePtr);
 
@@ -53,6 +53,11 @@ namespace minko
 				return mat;
 			}
 
+			// canonical encoding of the type and the property values of the material, textures being compared
+			// by reference: false when a property has a type that cannot be compared
+			bool
+			propertiesKey(std::string& key) const;
+
 		protected:
 			Material();
 		};
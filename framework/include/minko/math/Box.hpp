@@ -117,10 +117,18 @@ namespace minko
 			std::array<std::shared_ptr<Vector3>, 8>
 			getVertices();
 
+			// axis aligned box around this box transformed by matrix, computed from its center and extents
+			Ptr
+			transform(std::shared_ptr<Matrix4x4> matrix, Ptr output = nullptr);
+
 			
 			ShapePosition
 			testBoundingBox(std::shared_ptr<math::Box> box);
 
+			// squared distance from the point to the closest point of the box, 0 inside the box
+			float
+			squaredDistance(std::shared_ptr<Vector3> point) const;
+
 			void
 			updateFromMatrix(std::shared_ptr<math::Matrix4x4> matrix);
 
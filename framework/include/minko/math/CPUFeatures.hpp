@@ -0,0 +1,93 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+	namespace math
+	{
+		// vector instruction sets of the math and geometry kernels, the x86 ones sorted by increasing width
+		enum class InstructionSet
+		{
+			SCALAR,		// reference implementation, always available
+			SSE2,
+			SSE41,
+			AVX2,
+			NEON
+		};
+
+		// The instruction sets of the CPU are detected at startup, the kernels then branch on the one
+		// selected by instructionSet() instead of relying on the compiler flags. The SSE2 and NEON kernels
+		// are built with the baseline flags of their architecture, the AVX2 ones with a target attribute.
+		class CPUFeatures
+		{
+		private:
+			static InstructionSet	_best;
+			static InstructionSet	_instructionSet;
+
+		public:
+			static
+			bool
+			supports(InstructionSet instructionSet);
+
+			// the widest instruction set supported by both the CPU and the build
+			inline static
+			InstructionSet
+			best()
+			{
+				return _best;
+			}
+
+			inline static
+			InstructionSet
+			instructionSet()
+			{
+				return _instructionSet;
+			}
+
+			// SCALAR runs the reference kernels, for instance to compare them with the vector ones in tests
+			static
+			void
+			instructionSet(InstructionSet instructionSet);
+
+			// true when the kernels written for instructionSet can run
+			inline static
+			bool
+			enabled(InstructionSet instructionSet)
+			{
+				if (instructionSet == InstructionSet::NEON || _instructionSet == InstructionSet::NEON)
+					return instructionSet == _instructionSet;
+
+				return instructionSet <= _instructionSet;
+			}
+
+			static
+			std::string
+			name(InstructionSet instructionSet);
+
+		private:
+			static
+			InstructionSet
+			detect();
+		};
+	}
+}
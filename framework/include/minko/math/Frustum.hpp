@@ -33,6 +33,8 @@ namespace minko
 		public:
 			typedef std::shared_ptr<Frustum> Ptr;
 
+			static const uint ALL_PLANES = 0x3f;
+
 		private:
 			std::vector<std::shared_ptr<math::Vector3>>							_points;
 			std::array<std::shared_ptr<math::Vector4>, 6> _planes;
@@ -63,6 +65,24 @@ namespace minko
 			ShapePosition
 			testBoundingBox(std::shared_ptr<math::Box> box);
 
+			// removes from planeMask the planes the box is fully inside of, starts with firstPlane
+			// and sets it to the plane that rejected the box for the next test
+			ShapePosition
+			testBoundingBox(std::shared_ptr<math::Box> box, uint& planeMask, uint& firstPlane);
+
+			// tests numBoxes boxes stored as separate min/max arrays against the planes in planeMask,
+			// sets the bit of each box that is not outside the frustum in visibility
+			void
+			testBoundingBoxes(const float*			minX,
+							  const float*			minY,
+							  const float*			minZ,
+							  const float*			maxX,
+							  const float*			maxY,
+							  const float*			maxZ,
+							  uint					numBoxes,
+							  std::vector<uint>&	visibility,
+							  uint					planeMask = ALL_PLANES);
+
 		private:
 			Frustum();
 		};
@@ -39,6 +39,8 @@ namespace minko
 		public:
 			typedef std::shared_ptr<Matrix4x4>	Ptr;
 
+			MINKO_POOLED_ALLOCATION(Matrix4x4)
+
 		private:
 			typedef std::shared_ptr<Vector3>	Vector3Ptr;
 			typedef std::shared_ptr<Quaternion>	QuaternionPtr;
@@ -47,6 +49,8 @@ namespace minko
 			std::vector<float>	_m;
 			bool				_lock;
 			bool				_hasChanged;
+			float				_changeEpsilon;
+			std::vector<float>	_notifiedM;
 
 		public:
 			inline static
@@ -330,6 +334,9 @@ namespace minko
 				_m[7] = y;
 				_m[11] = z;
 
+				if (!exceedsChangeEpsilon())
+					return shared_from_this();
+
 				changed()->execute(shared_from_this());
 				_hasChanged = true;		
 
@@ -362,7 +369,57 @@ namespace minko
 			Ptr
 			copyFrom(Matrix4x4::Ptr source);
 
+			// copies the 16 row-major values with a single change notification
+			Ptr
+			setRaw(const float* values);
+
+			inline
+			float
+			changeEpsilon() const
+			{
+				return _changeEpsilon;
+			}
+
+			// when positive or zero, writes are always stored but only notify once a component moved
+			// by more than epsilon since the last notification, so small writes accumulate instead of
+			// being lost; negative (the default) notifies every write
+			inline
+			Ptr
+			changeEpsilon(float epsilon)
+			{
+				_changeEpsilon = epsilon;
+				if (epsilon >= 0.f)
+					_notifiedM = _m;
+				else
+					_notifiedM.clear();
+
+				return shared_from_this();
+			}
+
+			// out = lhs appended with rhs, out may alias lhs or rhs
+			static
+			void
+			multiply(const float* lhs, const float* rhs, float* out);
+
+			// out = inverse of m, out may alias m
+			static
+			void
+			invert(const float* m, float* out);
+
+			// out = m * (v[0], v[1], v[2], w), out may alias v
+			static
+			void
+			transform(const float* m, const float* v, float w, float* out);
+
+			// out = from + (to - from) * ratio, out may alias from or to
+			static
+			void
+			lerp(const float* from, const float* to, float ratio, float* out);
+
 		private:
+			bool
+			exceedsChangeEpsilon();
+
 			Matrix4x4();
 
 			Matrix4x4(Ptr value);
@@ -0,0 +1,117 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+	namespace math
+	{
+		class OcclusionBuffer :
+			public std::enable_shared_from_this<OcclusionBuffer>
+		{
+		public:
+			typedef std::shared_ptr<OcclusionBuffer>	Ptr;
+
+		private:
+			typedef std::shared_ptr<Matrix4x4>			MatrixPtr;
+
+		private:
+			const uint								_width;
+			const uint								_height;
+
+			std::vector<float>						_worldToScreen;
+			// level 0 holds the nearest depth of the occluders, each level above the farthest of 2x2 texels
+			std::vector<std::vector<float>>			_levels;
+			std::vector<uint>						_levelWidth;
+			std::vector<uint>						_levelHeight;
+			bool									_invalidPyramid;
+
+			std::vector<float>						_clipVertices;
+
+		public:
+			inline static
+			Ptr
+			create(uint width = 128, uint height = 64)
+			{
+				if (width == 0 || height == 0)
+					throw std::invalid_argument("width, height");
+
+				auto buffer = std::shared_ptr<OcclusionBuffer>(new OcclusionBuffer(width, height));
+
+				buffer->initialize();
+
+				return buffer;
+			}
+
+			inline
+			uint
+			width() const
+			{
+				return _width;
+			}
+
+			inline
+			uint
+			height() const
+			{
+				return _height;
+			}
+
+			inline
+			uint
+			numLevels() const
+			{
+				return _levels.size();
+			}
+
+			float
+			depth(uint x, uint y, uint level = 0);
+
+			Ptr
+			clear(MatrixPtr worldToScreen);
+
+			// rasterizes the triangles of an occluder, positions are read at positionOffset in each vertex
+			Ptr
+			rasterize(const std::vector<float>&	vertices,
+					  uint						vertexSize,
+					  uint						positionOffset,
+					  const std::vector<uint>&	indices,
+					  MatrixPtr					modelToWorld);
+
+			// true when the world space box is entirely behind the rasterized occluders
+			bool
+			occluded(std::shared_ptr<Box> box);
+
+		private:
+			OcclusionBuffer(uint width, uint height);
+
+			void
+			initialize();
+
+			void
+			rasterizeTriangle(const float* v0, const float* v1, const float* v2);
+
+			void
+			buildPyramid();
+		};
+	}
+}
@@ -50,9 +50,20 @@ namespace minko
 			float																		_worldSize;
 			std::shared_ptr<math::Vector3>												_center;
 			std::unordered_map<NodePtr, Ptr>											_nodeToOctant;
-			std::unordered_map<NodePtr, data::Container::PropertyChangedSignal::Slot>	_nodeToTransformChangedSlot;
 			std::unordered_map<std::shared_ptr<math::Matrix4x4>, NodePtr>				_matrixToNode;
 			std::shared_ptr<math::Box>													_octantBox;
+			// loose octants are tested with their bounds inflated x2 so that nodes can move inside them
+			bool																		_loose;
+			std::shared_ptr<math::Box>													_looseBox;
+			std::vector<NodePtr>														_invalidNodes;
+			uint																		_revision;
+			// plane that rejected this octant last time, tested first next time
+			uint																		_outsidePlane;
+
+			// nodes whose own box must be tested, filled by the root during a frustum test
+			std::vector<NodePtr>														_candidates;
+			std::array<std::vector<float>, 6>											_candidateBounds;
+			std::vector<uint>															_candidateVisibility;
 
 
 			bool _inside;
@@ -64,9 +75,25 @@ namespace minko
 			create(float							worldSize,
 				   uint								maxDepth,
 				   std::shared_ptr<math::Vector3>	center,
-				   uint								depth = 0)
+				   uint								depth = 0,
+				   bool								loose = false)
+			{
+				return std::shared_ptr<OctTree>(new OctTree(worldSize, maxDepth, center, depth, loose));
+			}
+
+			inline
+			bool
+			loose() const
+			{
+				return _loose;
+			}
+
+			// incremented every time nodes are moved to another octant
+			inline
+			uint
+			revision() const
 			{
-				return std::shared_ptr<OctTree>(new OctTree(worldSize, maxDepth, center, depth));
+				return _revision;
 			}
 
 			Ptr
@@ -78,6 +105,14 @@ namespace minko
 			uint
 			computeDepth(NodePtr node);
 
+			// queues the nodes of a batch published by RootTransform, see update()
+			void
+			nodesModelToWorldChanged(const std::vector<NodePtr>& nodes);
+
+			// moves the queued nodes that left their octant, returns true if any did
+			bool
+			update();
+
 			NodePtr
 			generateVisual(std::shared_ptr<file::AssetLibrary>	assetLibrary, 
 						   NodePtr			rootNode = nullptr);
@@ -90,18 +125,38 @@ namespace minko
 						std::function<void(std::shared_ptr<scene::Node>)>	insideFrustumCallback,
 						std::function<void(std::shared_ptr<scene::Node>)>	outsideFustumCallback);
 
+			// appends the nodes whose world bounding box is hit by the ray, with the distance to the box
+			void
+			testRay(std::shared_ptr<math::Ray>						ray,
+					std::vector<std::pair<float, NodePtr>>&			hits);
+
+			// appends the nodes whose world bounding box intersects the sphere
+			void
+			testSphere(std::shared_ptr<math::Vector3>	center,
+					   float							radius,
+					   std::vector<NodePtr>&			nodes);
+
 		private:
 
 			bool
 			nodeChangedOctant(NodePtr node);
 
 			void
-			nodeModelToWorldChanged(std::shared_ptr<data::Container>	data,
-									const std::string&					propertyName);
+			testFrustum(std::shared_ptr<math::Frustum>						frustum,
+						uint												planeMask,
+						std::vector<NodePtr>&								candidates,
+						std::function<void(std::shared_ptr<scene::Node>)>&	insideFrustumCallback,
+						std::function<void(std::shared_ptr<scene::Node>)>&	outsideFustumCallback);
 
 			void
 			split();
 
+			bool
+			contains(std::shared_ptr<math::Box> box);
+
+			void
+			grow(std::shared_ptr<math::Box> box);
+
 			float
 			computeRadius(std::shared_ptr<component::BoundingBox> boundingBox);
 
@@ -114,10 +169,14 @@ namespace minko
 			float
 			edgeLength();
 
+			void
+			updateOctantBoxes();
+
 			OctTree(float							worldSize,
 					 uint							maxDepth,
 					 std::shared_ptr<math::Vector3> center,
-					 uint							depth);
+					 uint							depth,
+					 bool							loose);
 		};
 	}
 }
@@ -31,6 +31,8 @@ namespace minko
 		public:
 			typedef std::shared_ptr<Quaternion> Ptr;
 
+			MINKO_POOLED_ALLOCATION(Quaternion)
+
 			typedef std::shared_ptr<Matrix4x4>			Matrix4x4Ptr;
 			typedef std::shared_ptr<const Matrix4x4>	Matrix4x4ConstPtr;
 			typedef std::shared_ptr<Vector3>			Vector3Ptr;
@@ -120,6 +122,17 @@ namespace minko
 			Ptr
 			slerp(Ptr target, float ratio);
 
+			// slerps numQuaternions pairs at once, from, to and out are SoA buffers holding all
+			// the i components, then all the j, k and r components; out may alias from or to
+			static
+			void
+			slerp(uint numQuaternions, const float* from, const float* to, const float* ratios, float* out);
+
+			// writes the 16 row-major values of the rotation matrix of the (i, j, k, r) quaternion q
+			static
+			void
+			toMatrix(const float* q, float* out);
+
 			std::string
 			toString()
 			{
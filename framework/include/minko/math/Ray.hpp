@@ -32,6 +32,8 @@ namespace minko
 		public:
 			typedef std::shared_ptr<Ray>	Ptr;
 
+			MINKO_POOLED_ALLOCATION(Ray)
+
 		private:
 			typedef std::shared_ptr<Vector3>	Vector3Ptr;
 
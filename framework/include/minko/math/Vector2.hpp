@@ -32,6 +32,8 @@ namespace minko
 		public:
 			typedef std::shared_ptr<Vector2>	Ptr;
 
+			MINKO_POOLED_ALLOCATION(Vector2)
+
 		protected:
 			float _x;
 			float _y;
@@ -34,6 +34,8 @@ namespace minko
 			typedef std::shared_ptr<Vector3>	Ptr;
 			typedef std::shared_ptr<Vector3>	ConstPtr;
 
+			MINKO_POOLED_ALLOCATION(Vector3)
+
 		protected:
 			float _z;
 
@@ -33,6 +33,8 @@ namespace minko
 		public:
 			typedef std::shared_ptr<Vector4>	Ptr;
 
+			MINKO_POOLED_ALLOCATION(Vector4)
+
 		protected:
 			float _w;
 
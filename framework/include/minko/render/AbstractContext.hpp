@@ -22,7 +22,10 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/Common.hpp"
 
 #include "minko/render/Blending.hpp"
+#include "minko/render/VertexAttributeType.hpp"
+#include "minko/render/BufferUsage.hpp"
 #include "minko/render/CubeTexture.hpp"
+#include "minko/render/RenderStats.hpp"
 
 namespace minko
 {
@@ -92,17 +95,53 @@ namespace minko
 			void
 			drawTriangles(const uint indexBuffer, const int numTriangles) = 0;
 
+			virtual
+			bool
+			supportsInstancing() = 0;
+
+			virtual
+			void
+			drawTrianglesInstanced(const uint indexBuffer, const int numTriangles, const uint numInstances) = 0;
+
 			virtual
 			const uint
-			createVertexBuffer(const uint size) = 0;
+			createVertexBuffer(const uint size, BufferUsage usage = BufferUsage::STATIC) = 0;
 
+			// stride and offset are in 4 bytes words
 			virtual
 			void
-			setVertexBufferAt(const uint	position,
-						      const uint	vertexBuffer,
-							  const uint	size,
-							  const uint	stride,
-							  const uint	offset) = 0;
+			setVertexBufferAt(const uint				position,
+						      const uint				vertexBuffer,
+							  const uint				size,
+							  const uint				stride,
+							  const uint				offset,
+							  VertexAttributeType		type = VertexAttributeType::FLOAT) = 0;
+
+			virtual
+			bool
+			supportsVertexAttributeType(VertexAttributeType type) = 0;
+
+			virtual
+			void
+			setVertexAttributeDivisor(const uint position, const uint divisor) = 0;
+
+			// vertex array objects record the vertex attributes and the index buffer bound while they are
+			// bound themselves, 0 is the default vertex array
+			virtual
+			bool
+			supportsVertexArrays() = 0;
+
+			virtual
+			const uint
+			createVertexArray() = 0;
+
+			virtual
+			void
+			setVertexArray(const uint vertexArray) = 0;
+
+			virtual
+			void
+			deleteVertexArray(const uint vertexArray) = 0;
 
 			virtual
 			void
@@ -115,9 +154,18 @@ namespace minko
 			void
 			deleteVertexBuffer(const uint vertexBuffer) = 0;
 				
+			virtual
+			bool
+			supportsUnsignedIntIndices() = 0;
+
 			virtual
 			const uint
-			createIndexBuffer(const uint size) = 0;
+			createIndexBuffer(const uint size, const bool useUnsignedInt = false, BufferUsage usage = BufferUsage::STATIC) = 0;
+
+			// changes the usage of an existing vertex or index buffer without changing its id
+			virtual
+			void
+			setBufferUsage(uint buffer, BufferUsage usage) = 0;
 
 			virtual
 			void
@@ -146,6 +194,48 @@ namespace minko
 							    unsigned int 	mipLevel,
 							    void*			data) = 0;
 
+			// NPOT textures without mipmaps only support the CLAMP wrap mode unless full support is available
+			virtual
+			bool
+			supportsNonPowerOfTwoTextures(bool mipMapping) = 0;
+
+			// true for RGB and RGBA, compressed formats depend on the extensions of the driver
+			virtual
+			bool
+			supportsTextureFormat(TextureFormat format) = 0;
+
+			// true when RGBA 32 bit float textures can be sampled with the nearest filter, including in vertex shaders
+			virtual
+			bool
+			supportsFloatTextures() = 0;
+
+			// 4 floats per texel, the texture must not have mipmaps
+			virtual
+			void
+			uploadFloatTexture2dData(uint			texture,
+									 unsigned int	width,
+									 unsigned int	height,
+									 const float*	data) = 0;
+
+			virtual
+			void
+			uploadCompressedTexture2dData(uint			texture,
+										  TextureFormat	format,
+										  unsigned int	width,
+										  unsigned int	height,
+										  unsigned int	mipLevel,
+										  void*			data) = 0;
+
+			// frees the memory of a texture but keeps its id valid, it samples as transparent black until uploaded again
+			virtual
+			void
+			releaseTextureStorage(uint texture) = 0;
+
+			// first mip level sampled, levels above it can be uploaded later
+			virtual
+			void
+			setTextureBaseLevel(uint texture, uint level) = 0;
+
 			virtual
 			void
 			uploadCubeTextureData(uint				texture,
@@ -155,6 +245,12 @@ namespace minko
 							      unsigned int		mipLevel,
 							      void*				data) = 0;
 
+			// copies the bottom left width x height pixels of the current render target into a face of a cube
+			// texture, so that faces can be rendered one by one into a 2D render target
+			virtual
+			void
+			copyToCubeTexture(uint texture, CubeTexture::Face face, unsigned int width, unsigned int height) = 0;
+
 			virtual
 			void
 			deleteTexture(uint	texture) = 0;
@@ -184,6 +280,30 @@ namespace minko
 			void
 			linkProgram(const uint program) = 0;
 
+			// true when programs are linked in the background and isProgramLinked() does not block
+			virtual
+			bool
+			supportsParallelShaderCompile() = 0;
+
+			// false while a program passed to linkProgram() is still being compiled and linked
+			virtual
+			bool
+			isProgramLinked(const uint program) = 0;
+
+			virtual
+			bool
+			supportsProgramBinaries() = 0;
+
+			// reads the binary of a linked program, returns false if the driver cannot provide it
+			virtual
+			bool
+			getProgramBinary(const uint program, uint& format, std::vector<unsigned char>& binary) = 0;
+
+			// links program from a binary returned by getProgramBinary(), returns false if it is rejected
+			virtual
+			bool
+			setProgramBinary(const uint program, const uint format, const std::vector<unsigned char>& binary) = 0;
+
 			virtual
 			void
 			deleteProgram(const uint program) = 0;
@@ -324,6 +444,126 @@ namespace minko
 			void
 			readPixels(unsigned int x, unsigned int y, unsigned int width, unsigned int height, unsigned char* pixels) = 0;
 
+			// true when readPixelsAsync() does not wait for the GPU
+			virtual
+			bool
+			supportsPixelBuffers() = 0;
+
+			virtual
+			const uint
+			createPixelBuffer(const uint size) = 0;
+
+			virtual
+			void
+			deletePixelBuffer(const uint pixelBuffer) = 0;
+
+			// starts copying the RGBA pixels of a region in a pixel buffer
+			virtual
+			void
+			readPixelsAsync(unsigned int x, unsigned int y, unsigned int width, unsigned int height, const uint pixelBuffer) = 0;
+
+			// copies the content of a pixel buffer, waits for the pending readPixelsAsync() if any
+			virtual
+			void
+			pixelBufferData(const uint pixelBuffer, const uint size, unsigned char* pixels) = 0;
+
+			// true when the completion of the GPU commands can be polled, fenceSignaled() is always true otherwise
+			virtual
+			bool
+			supportsFences() = 0;
+
+			// inserted after the commands issued so far
+			virtual
+			const uint
+			createFence() = 0;
+
+			virtual
+			void
+			deleteFence(const uint fence) = 0;
+
+			// true once the GPU has executed the commands issued before the fence, does not wait
+			virtual
+			bool
+			fenceSignaled(const uint fence) = 0;
+
+			// true when the GPU time of the commands can be measured without stalling
+			virtual
+			bool
+			supportsTimerQueries() = 0;
+
+			virtual
+			const uint
+			createTimerQuery() = 0;
+
+			virtual
+			void
+			deleteTimerQuery(const uint query) = 0;
+
+			// times the GPU commands issued until endTimerQuery(), timer queries cannot be nested
+			virtual
+			void
+			beginTimerQuery(const uint query) = 0;
+
+			virtual
+			void
+			endTimerQuery() = 0;
+
+			// never waits for the GPU: false while the commands timed by the query are not executed
+			virtual
+			bool
+			isTimerQueryAvailable(const uint query) = 0;
+
+			// GPU time in nanoseconds of an available query, false if the GPU timer was disjoint meanwhile
+			virtual
+			bool
+			getTimerQueryResult(const uint query, uint64_t& nanoseconds) = 0;
+
+			// true when the GPU can tell whether any sample of a draw call passed the depth test
+			virtual
+			bool
+			supportsOcclusionQueries() = 0;
+
+			virtual
+			const uint
+			createOcclusionQuery() = 0;
+
+			virtual
+			void
+			deleteOcclusionQuery(const uint query) = 0;
+
+			// tests the draw calls issued until endOcclusionQuery(), occlusion queries cannot be nested
+			virtual
+			void
+			beginOcclusionQuery(const uint query) = 0;
+
+			virtual
+			void
+			endOcclusionQuery() = 0;
+
+			// never waits for the GPU: false while the commands tested by the query are not executed
+			virtual
+			bool
+			isOcclusionQueryAvailable(const uint query) = 0;
+
+			// true if at least one sample passed the depth test, only meaningful once the query is available
+			virtual
+			bool
+			getOcclusionQueryResult(const uint query) = 0;
+
+			// counts the GL calls issued since the creation of the context
+			virtual
+			const RenderStats&
+			renderStats() const = 0;
+
+			// bytes currently allocated on the GPU by the buffers and the textures of the context
+			virtual
+			unsigned long long
+			bufferMemory() const = 0;
+
+			virtual
+			unsigned long long
+			textureMemory() const = 0;
+
             virtual
             void
             setTriangleCulling(TriangleCulling triangleCulling) = 0;
@@ -339,6 +579,12 @@ namespace minko
             virtual
             void
             generateMipmaps(unsigned int texture) = 0;
+
+			// forgets the objects and the states of a lost GPU context, to be called once the new one is current
+			// and before any resource is uploaded again: the ids of the lost objects must not be deleted
+			virtual
+			void
+			contextRestored() = 0;
 		};
 	}	
 }
@@ -67,6 +67,15 @@ namespace minko
 			void
 			upload() = 0;
 
+			// the GPU object died with a lost context: its id is forgotten, upload() creates it again in the
+			// new context
+			virtual
+			void
+			contextRestored()
+			{
+				_id = -1;
+			}
+
 		protected:
 			AbstractResource(std::shared_ptr<render::AbstractContext> context) :
 				_context(context),
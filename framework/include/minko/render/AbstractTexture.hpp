@@ -43,8 +43,8 @@ namespace minko
 			const TextureType	_type;
 			unsigned int		_width;		
 			unsigned int		_height;	
-			unsigned int		_widthGPU;	// always power of 2
-			unsigned int		_heightGPU;	// always power of 2
+			unsigned int		_widthGPU;	// power of 2 unless the context supports NPOT textures
+			unsigned int		_heightGPU;	// power of 2 unless the context supports NPOT textures
             bool				_mipMapping;
 			bool				_resizeSmoothly;
 			bool				_optimizeForRenderToTexture;
@@ -102,6 +102,26 @@ namespace minko
 			void
 			disposeData() = 0;
 
+			static
+			bool
+			isCompressed(TextureFormat format);
+
+			// size in bytes of one mipmap level
+			static
+			uint
+			dataSize(TextureFormat format, uint width, uint height);
+
+			// resamples RGBA pixels into newData
+			static
+			void
+			resizeData(unsigned int width, 
+					   unsigned int height, 
+					   std::vector<unsigned char>&	data, 
+			           unsigned int newWidth, 
+					   unsigned int newHeight,
+					   bool resizeSmoothly,
+					   std::vector<unsigned char>&	newData);
+
 		protected:
 			AbstractTexture(TextureType			type,
 							AbstractContextPtr	context,
@@ -116,16 +136,6 @@ namespace minko
 			{
 			}
 
-			static
-			void
-			resizeData(unsigned int width, 
-					   unsigned int height, 
-					   std::vector<unsigned char>&	data, 
-			           unsigned int newWidth, 
-					   unsigned int newHeight,
-					   bool resizeSmoothly,
-					   std::vector<unsigned char>&	newData);
-
 			uint
 			getMipmapWidth(uint level) const;
 
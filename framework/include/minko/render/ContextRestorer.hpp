@@ -0,0 +1,157 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include "minko/Signal.hpp"
+#include "minko/component/JobManager.hpp"
+
+namespace minko
+{
+	namespace render
+	{
+		// restores the GPU resources once a lost context is replaced: the buffers and the textures get an empty
+		// GPU object at once so that the draw calls can bind them, then their content is uploaded again from
+		// their CPU-side data within a per-frame budget, the resources of the visible surfaces first; the
+		// programs are linked again on demand, from the program binary cache when there is one
+		class ContextRestorer :
+			public component::JobManager::Job,
+			public std::enable_shared_from_this<ContextRestorer>
+		{
+		public:
+			typedef std::shared_ptr<ContextRestorer>	Ptr;
+
+		private:
+			typedef std::shared_ptr<AbstractContext>	AbstractContextPtr;
+			typedef std::shared_ptr<AbstractResource>	AbstractResourcePtr;
+			typedef std::shared_ptr<Effect>				EffectPtr;
+			typedef std::shared_ptr<scene::Node>		NodePtr;
+
+		private:
+			AbstractContextPtr								_context;
+			uint											_bytesPerFrame;
+			uint											_frameBytes;
+			std::list<std::weak_ptr<AbstractResource>>		_resources;
+			std::list<std::weak_ptr<Effect>>				_effects;
+			std::list<std::weak_ptr<AbstractResource>>		_pendingResources; // visible surfaces first
+			uint											_numRestored;
+
+			Signal<Ptr, AbstractResourcePtr>::Ptr			_dataLost;
+			Signal<Ptr, uint>::Ptr							_restored;
+
+		public:
+			inline static
+			Ptr
+			create(AbstractContextPtr context, uint bytesPerFrame = 1 << 20)
+			{
+				return std::shared_ptr<ContextRestorer>(new ContextRestorer(context, bytesPerFrame));
+			}
+
+			inline
+			uint
+			bytesPerFrame() const
+			{
+				return _bytesPerFrame;
+			}
+
+			inline
+			void
+			bytesPerFrame(uint value)
+			{
+				_bytesPerFrame = value;
+			}
+
+			inline
+			uint
+			numPendingResources() const
+			{
+				return _pendingResources.size();
+			}
+
+			// resources uploaded again since the last call to contextRestored()
+			inline
+			uint
+			numRestored() const
+			{
+				return _numRestored;
+			}
+
+			// executed for each resource whose CPU-side data was disposed: it can be bound but its content has
+			// to be loaded and uploaded again
+			inline
+			Signal<Ptr, AbstractResourcePtr>::Ptr
+			dataLost() const
+			{
+				return _dataLost;
+			}
+
+			// executed once all the pending resources are handled, with the number of restored ones
+			inline
+			Signal<Ptr, uint>::Ptr
+			restored() const
+			{
+				return _restored;
+			}
+
+			// resources are weakly referenced: a released one is simply not restored
+			void
+			track(AbstractResourcePtr resource);
+
+			void
+			track(EffectPtr effect);
+
+			// the textures, the buffers of the geometries and the effects of the library
+			void
+			track(std::shared_ptr<file::AssetLibrary> assets);
+
+			// to be called once the new context is current, before the next frame: the resources and the
+			// effects of the surfaces below root are restored as well, tracked or not
+			void
+			contextRestored(NodePtr root = nullptr);
+
+			bool
+			complete();
+
+			void
+			beforeFirstStep();
+
+			void
+			step();
+
+			float
+			priority();
+
+			bool
+			yieldFrame();
+
+			void
+			afterLastStep();
+
+		private:
+			ContextRestorer(AbstractContextPtr context, uint bytesPerFrame);
+
+			// uploads the CPU-side data of the resource, false if it was disposed
+			static
+			bool
+			uploadData(AbstractResourcePtr resource, uint& numBytes);
+		};
+	}
+}
@@ -82,6 +82,11 @@ namespace minko
 				 int			widthGPU	= -1,
 				 int			heightGPU	= -1);
 
+			// takes the RGBA pixels of a face of (width() / 4) x (height() / 3), they are moved instead of copied
+			// when they already have the GPU size
+			void
+			data(Face face, std::vector<unsigned char>&& rgba);
+
 			void
 			upload();
 
@@ -95,6 +100,23 @@ namespace minko
 			void
 			disposeData();
 
+			// allocates the same storage in the new context, upload() restores the faces
+			void
+			contextRestored();
+
+			// bytes of pixel data kept on the CPU for the six faces
+			inline
+			uint
+			memorySize() const
+			{
+				uint size = 0;
+
+				for (const auto& face : _data)
+					size += face.size();
+
+				return size;
+			}
+
 			~CubeTexture()
 			{
 				dispose();
@@ -29,6 +29,13 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/render/States.hpp"
 #include "minko/render/AbstractTexture.hpp"
 #include "minko/render/Priority.hpp"
+#include "minko/render/VertexAttributeType.hpp"
+
+#if defined(_MSC_VER)
+# define MINKO_DRAW_CALL_THREAD_LOCAL	__declspec(thread)
+#else
+# define MINKO_DRAW_CALL_THREAD_LOCAL	__thread
+#endif
 
 namespace minko
 {
@@ -42,6 +49,38 @@ namespace minko
 		public:
 			typedef std::shared_ptr<DrawCall>	Ptr;
 
+			MINKO_POOLED_ALLOCATION(DrawCall)
+
+			// program input resolved against the bindings of a pass, identical for all its draw calls
+			struct InputBinding
+			{
+				std::string					inputName;
+				ProgramInputs::Type			type;
+				int							location;
+				bool						bound;
+				data::Binding				binding;
+				// the binding name of an element of an uniform array and its "[i]..." suffix
+				bool						isArray;
+				std::string					arraySuffix;
+				// names without draw call variables are formatted and interned once
+				bool						hasVariables;
+				std::string					propertyName;
+				data::PropertyName::Id		propertyId;
+			};
+
+			typedef std::vector<InputBinding>		BindingPlan;
+			typedef std::shared_ptr<BindingPlan>	BindingPlanPtr;
+
+			// what must be set on the context compared to the previous draw call of the queue, recorded
+			// without the context so that worker threads can do it, then replayed by render()
+			struct Changes
+			{
+				bool						full; // the previous draw call is of no use
+				uint						textures; // one bit per texture slot
+				uint						vertexBuffers; // one bit per vertex buffer slot
+				bool						states;
+			};
+
 		private:
             typedef std::shared_ptr<AbstractContext>									AbsCtxPtr;
 			typedef std::shared_ptr<AbstractTexture>									AbsTexturePtr;
@@ -55,9 +94,45 @@ namespace minko
 			typedef std::tuple<int, int, int>							Int3;
 			typedef std::tuple<int, int, int, int>						Int4;					
 
+			// uniform values are stored in flat lists, in the order of the program inputs, so that two
+			// draw calls sharing the same program can be diffed element-wise
+			template <typename T>
+			using UniformList = std::vector<std::pair<uint, T>>;
+
+			struct UniformValues
+			{
+				UniformList<float>								float1;
+				UniformList<std::shared_ptr<math::Vector2>>		float2;
+				UniformList<std::shared_ptr<math::Vector3>>		float3;
+				UniformList<std::shared_ptr<math::Vector4>>		float4;
+				UniformList<const float*>						float16;
+				UniformList<int>								int1;
+				UniformList<Int2>								int2;
+				UniformList<Int3>								int3;
+				UniformList<Int4>								int4;
+				UniformList<data::UniformArrayPtr<float>>		floats;
+				UniformList<data::UniformArrayPtr<float>>		floats2;
+				UniformList<data::UniformArrayPtr<float>>		floats3;
+				UniformList<data::UniformArrayPtr<float>>		floats4;
+				UniformList<data::UniformArrayPtr<float>>		floats16;
+				UniformList<data::UniformArrayPtr<int>>			ints;
+				UniformList<data::UniformArrayPtr<int>>			ints2;
+				UniformList<data::UniformArrayPtr<int>>			ints3;
+				UniformList<data::UniformArrayPtr<int>>			ints4;
+
+				void
+				clear();
+
+				bool
+				operator==(const UniformValues& other) const;
+			};
+
 		private:
 			static const unsigned int									MAX_NUM_TEXTURES;
 			static const unsigned int									MAX_NUM_VERTEXBUFFERS;
+			// incremented before each rendering pass, shared uniforms are uploaded once per program and pass;
+			// one counter per thread since the programs of a context are only used by its thread
+			static MINKO_DRAW_CALL_THREAD_LOCAL unsigned int			_pass;
 
             static SamplerState                                         _defaultSamplerState;
 
@@ -76,6 +151,7 @@ namespace minko
             std::vector<int>                                            _vertexSizes;
             std::vector<int>                                            _vertexAttributeSizes;
             std::vector<int>                                            _vertexAttributeOffsets;
+			std::vector<VertexAttributeType>							_vertexAttributeTypes;
             std::vector<int>                                            _textureIds;
             std::vector<int>                                            _textureLocations;
             std::vector<WrapMode>                                       _textureWrapMode;
@@ -100,24 +176,32 @@ namespace minko
 			render::ScissorBox											_scissorBox;
 			float														_priority;
 			bool														_zsorted;
-            std::unordered_map<uint, float>                             _uniformFloat;
-            std::unordered_map<uint, std::shared_ptr<math::Vector2>>    _uniformFloat2;
-            std::unordered_map<uint, std::shared_ptr<math::Vector3>>    _uniformFloat3;
-            std::unordered_map<uint, std::shared_ptr<math::Vector4>>    _uniformFloat4;
-            std::unordered_map<uint, const float*>                      _uniformFloat16;
-			std::unordered_map<uint, int>								_uniformInt;
-			std::unordered_map<uint, Int2>								_uniformInt2;
-			std::unordered_map<uint, Int3>								_uniformInt3;
-			std::unordered_map<uint, Int4>								_uniformInt4;
-			std::unordered_map<uint, data::UniformArrayPtr<float>>		_uniformFloats;
-			std::unordered_map<uint, data::UniformArrayPtr<float>>		_uniformFloats2;
-			std::unordered_map<uint, data::UniformArrayPtr<float>>		_uniformFloats3;
-			std::unordered_map<uint, data::UniformArrayPtr<float>>		_uniformFloats4;
-			std::unordered_map<uint, data::UniformArrayPtr<float>>		_uniformFloats16;
-			std::unordered_map<uint, data::UniformArrayPtr<int>>		_uniformInts;
-			std::unordered_map<uint, data::UniformArrayPtr<int>>		_uniformInts2;
-			std::unordered_map<uint, data::UniformArrayPtr<int>>		_uniformInts3;
-			std::unordered_map<uint, data::UniformArrayPtr<int>>		_uniformInts4;
+			bool														_enabled;
+			// layouts of the node of the surface, filtered by the layout mask of the renderer
+			uint														_layouts;
+			// name of the GPU time of the pass of the draw call in the Profiler
+			const char*													_profileName;
+			UniformValues												_uniforms;
+			// read from the renderer or the root data, so identical for all the draw calls of a program during a pass
+			UniformValues												_sharedUniforms;
+
+			// per-instance model to world matrix, bound to a mat4 attribute when the program uses instancing
+			int															_instanceAttributeLocation;
+			std::shared_ptr<math::Matrix4x4>							_instanceMatrix;
+			std::vector<Ptr>											_instances;
+			std::shared_ptr<VertexBuffer>								_instanceBuffer;
+			// instances that could no longer be instanced were drawn on their own with their own bindings
+			bool														_renderedFallbacks;
+
+			// records the vertex attributes of the draw call once when the context supports vertex array objects
+			uint														_vertexArray;
+			bool														_vertexArrayChanged;
+
+			BindingPlanPtr												_bindingPlan;
+
+			// uniform location to the source and id of its formatted property name and whether it is shared,
+			// filled on the first bind
+			std::unordered_map<int, std::tuple<data::BindingSource, data::PropertyName::Id, bool>>	_uniformLocationToProperty;
 
 			std::unordered_map<std::string, std::list<Any>>				_referenceChangedSlots; // Any = ContainerPropertyChangedSlot
 
@@ -150,6 +234,22 @@ namespace minko
 				return ptr;
 			}
 
+			~DrawCall();
+
+			static
+			BindingPlanPtr
+			createBindingPlan(std::shared_ptr<Program>	program,
+							  const data::BindingMap&	attributeBindings,
+							  const data::BindingMap&	uniformBindings);
+
+			// the renderer and root data can change between two passes
+			static inline
+			void
+			invalidateSharedUniforms()
+			{
+				++_pass;
+			}
+
 			inline
 			ContainerPtr
 			targetData() const
@@ -193,6 +293,41 @@ namespace minko
                 return _target;
             }
 
+			inline
+			std::shared_ptr<Program>
+			program() const
+			{
+				return _program;
+			}
+
+			inline
+			const char*
+			profileName() const
+			{
+				return _profileName;
+			}
+
+			inline
+			void
+			profileName(const char* name)
+			{
+				_profileName = name;
+			}
+
+			inline
+			const std::vector<int>&
+			textureIds() const
+			{
+				return _textureIds;
+			}
+
+			inline
+			uint
+			indexBuffer() const
+			{
+				return _indexBuffer;
+			}
+
 			inline
 			float
 			priority() const
@@ -214,14 +349,92 @@ namespace minko
 				return _zsortNeeded;
 			}
 
+			// disabled draw calls keep their bindings but are skipped by the renderer
+			inline
+			bool
+			enabled() const
+			{
+				return _enabled;
+			}
+
+			inline
+			void
+			enabled(bool value)
+			{
+				_enabled = value;
+			}
+
+			inline
+			uint
+			layouts() const
+			{
+				return _layouts;
+			}
+
+			inline
+			void
+			layouts(uint value)
+			{
+				_layouts = value;
+			}
+
+			inline
+			bool
+			instanced() const
+			{
+				return _instanceAttributeLocation >= 0;
+			}
+
+			inline
+			const std::vector<Ptr>&
+			instances() const
+			{
+				return _instances;
+			}
+
+			inline
+			void
+			addInstance(Ptr drawCall)
+			{
+				_instances.push_back(drawCall);
+			}
+
+			inline
+			void
+			clearInstances()
+			{
+				_instances.clear();
+			}
+
+			bool
+			canBeInstancedWith(const DrawCall& other) const;
+
+			// true if the last render() left the bindings of another draw call in the context: the next
+			// draw call cannot be diffed against this one
+			inline
+			bool
+			renderedFallbacks() const
+			{
+				return _renderedFallbacks;
+			}
+
             void
             configure(std::shared_ptr<Program>  program,
                       ContainerPtr              data,
 					  ContainerPtr              rendererData,
-                      ContainerPtr              rootData);
+                      ContainerPtr              rootData,
+					  BindingPlanPtr			bindingPlan = nullptr);
+
+			// thread-safe as long as the bindings of both draw calls do not change meanwhile
+			void
+			recordChanges(const DrawCall* previous, const AbsTexturePtr& renderTarget, Changes& changes) const;
 
 			void
-			render(const std::shared_ptr<AbstractContext>& context, AbsTexturePtr renderTarget);
+			render(const std::shared_ptr<AbstractContext>&	context,
+				   const AbsTexturePtr&						renderTarget,
+				   const DrawCall*							previous	= nullptr,
+				   const ScissorBox*						scissorBox	= nullptr,
+				   const Changes*							changes		= nullptr);
 
 			void
 			initialize(ContainerPtr				                    data,
@@ -230,6 +443,9 @@ namespace minko
 			std::shared_ptr<math::Vector3>
 			getEyeSpacePosition(std::shared_ptr<math::Vector3> output = nullptr);
 
+			float
+			getEyeSpaceDepth();
+
 		private:
 			DrawCall(const data::BindingMap&	attributeBindings,
 				     const data::BindingMap&	uniformBindings,
@@ -255,22 +471,31 @@ namespace minko
 			bindStates();
 			
 			void
-			bindVertexAttribute(const std::string& propertyName, int location, uint& vertexBufferIndex);
+			bindVertexAttribute(uint inputId, uint& vertexBufferIndex);
 			
 			void
-			bindTextureSampler(const std::string& propertyName, int location, uint& textureIndex, const SamplerState&, bool = true);
+			bindTextureSampler(uint inputId, uint& textureIndex, const SamplerState&, bool = true);
+
+			void
+			bindUniform(uint inputId);
 
 			void
-			bindUniform(const std::string& propertyName, ProgramInputs::Type, int location);
+			bindUniformValue(UniformValues&, ContainerPtr, data::PropertyName::Id, ProgramInputs::Type, int location);
 
 			void
-			bindUniformArray(const std::string&	propertyName, ContainerPtr, ProgramInputs::Type, int location);
+			bindUniformArray(UniformValues&, const std::string& propertyName, ContainerPtr, ProgramInputs::Type, int location);
 
 			void
-			bindFloatUniformArray(const std::string& propertyName, ContainerPtr, ProgramInputs::Type, int location);
+			bindFloatUniformArray(UniformValues&, const std::string& propertyName, ContainerPtr, ProgramInputs::Type, int location);
 
 			void
-			bindIntegerUniformArray(const std::string& propertyName, ContainerPtr, ProgramInputs::Type, int location);
+			bindIntegerUniformArray(UniformValues&, const std::string& propertyName, ContainerPtr, ProgramInputs::Type, int location);
+
+			static
+			void
+			applyUniformValues(const std::shared_ptr<AbstractContext>&	context,
+							   const UniformValues&						uniforms,
+							   const UniformValues*						previous);
 
 			void
 			watchUniformRefChange(ContainerPtr, const std::string& propertyName, ProgramInputs::Type, int location);
@@ -278,6 +503,45 @@ namespace minko
 			ContainerPtr
 			getDataContainer(const data::BindingSource& source) const;
 
+			bool
+			hasSameStates(const DrawCall& other) const;
+
+			bool
+			hasSameUniforms(const DrawCall& other) const;
+
+			void
+			renderInstances(const std::shared_ptr<AbstractContext>&	context,
+							const AbsTexturePtr&					renderTarget,
+							uint									indexBuffer,
+							uint									numTriangles);
+
+			template <typename T, typename V>
+			static
+			void
+			setUniformValue(UniformList<T>& uniforms, uint location, const V& value)
+			{
+				for (auto& uniform : uniforms)
+					if (uniform.first == location)
+					{
+						uniform.second = value;
+
+						return;
+					}
+
+				uniforms.push_back(std::pair<uint, T>(location, T(value)));
+			}
+
+			template <typename T, typename F>
+			static
+			void
+			applyUniforms(const UniformList<T>& uniforms, const UniformList<T>* previous, F upload)
+			{
+				// only upload the values that differ from the ones the previous draw call left in the program
+				for (uint i = 0; i < uniforms.size(); ++i)
+					if (previous == nullptr || i >= previous->size() || (*previous)[i] != uniforms[i])
+						upload(uniforms[i].first, uniforms[i].second);
+			}
+
 			template <typename T>
 			void
 			bindState(const std::string& stateName, T defaultValue, T& stateValue)
@@ -315,7 +579,7 @@ namespace minko
 							shared_from_this(),
 							stateName, 
 							defaultValue, 
-							stateValue
+							std::ref(stateValue)
 						)));
 #endif
 					}
@@ -72,7 +72,9 @@ namespace minko
 
 			typedef std::pair<std::string, PassPtr>														TechniqueNameAndPass;
 			typedef std::pair<SurfacePtr, NodePtr>														SurfaceAndTarget;
-			typedef std::list<DrawCallPtr>																DrawCallList;
+			typedef std::list<DrawCallPtr, BlockAllocator<DrawCallPtr>>									DrawCallList;
+			typedef std::vector<DrawCallPtr>															DrawCallQueue;
+			typedef std::pair<uint64_t, uint>															SortKeyAndIndex;
 			typedef std::function <std::string(const std::string&, StringToStringMap&)>					FormatFunction;
 
 			typedef Signal<ContainerPtr, const std::string&>											PropertyChangedSignal;
@@ -81,6 +83,8 @@ namespace minko
 			typedef Signal<SurfacePtr, const std::string&, bool>::Slot									TechniqueChangeSlot;
 			typedef Signal<SurfacePtr, RendererPtr, bool>::Slot											VisibilityChangedSlot;
 			typedef Signal<DrawCallPtr>::Slot															ZSortNeededSlot;
+			typedef Signal<PassPtr>::Slot																PassReloadedSlot;
+			typedef Signal<NodePtr, NodePtr>::Slot														LayoutsChangedSlot;
 			typedef Signal<std::shared_ptr<data::ArrayProvider>, uint>::Slot							ArrayProviderIndexChangedSlot;
 			typedef PropertyChangedSignal::Slot															PropertyChangedSlot;
 
@@ -96,16 +100,18 @@ namespace minko
 			
 		private:
 			static const unsigned int											NUM_FALLBACK_ATTEMPTS;
-			static std::unordered_map<std::string, std::pair<std::string, int>>	_variablePropertyNameToPosition;
-			static std::unordered_map<DrawCallPtr, Vector3Ptr>					_cachedDrawcallPositions; // in eye space
 
 			RendererPtr															_renderer;
+			// replaces the effects of the surfaces when set
+			std::shared_ptr<Effect>												_effect;
 
 			// std::unordered_map<SurfaceAndTarget, uint> _test;
 
 			std::unordered_map<SurfacePtr, TechniqueChangeSlot>					_surfaceToTechniqueChangedSlot;
+			std::unordered_map<PassPtr, PassReloadedSlot>						_passToReloadedSlot;
 			std::unordered_multimap<SurfacePtr, VisibilityChangedSlot>			_surfaceToVisibilityChangedSlot;
 			std::unordered_multimap<SurfacePtr, ArrayProviderIndexChangedSlot>	_surfaceToIndexChangedSlot;
+			std::unordered_map<SurfacePtr, LayoutsChangedSlot>					_surfaceToLayoutsChangedSlot;
 
 			DrawCallChangedSignal::Ptr											_drawCallAdded;
 			DrawCallChangedSignal::Ptr											_drawCallRemoved;
@@ -127,7 +133,10 @@ namespace minko
 			// surface that will generate new draw call next frame
 			std::set<SurfacePtr>												_toCollect;
 			std::set<SurfacePtr>												_toRemove;
-			std::set<SurfacePtr>												_invisibleSurfaces;
+			// draw calls whose macros changed, switched to their new program variant next frame
+			std::unordered_map<SurfacePtr, std::unordered_set<DrawCallPtr>>	_toRetarget;
+			// draw calls rendering with a fallback until their program variant is linked
+			std::list<std::tuple<std::shared_ptr<Program>, SurfacePtr, DrawCallPtr>>	_pendingPrograms;
 
 			// drawcall z-sorting
 			bool																_mustZSort; // forces z-sorting at next frame
@@ -135,15 +144,27 @@ namespace minko
 			// draw call list for renderer
 			std::unordered_map<SurfacePtr, DrawCallList>						_surfaceToDrawCalls;
 			DrawCallList														_drawCalls;
+
+			// render queue, sorted by packed 64-bit keys
+			bool																_mustSort; // forces the render queue to be rebuilt at next frame
+			DrawCallQueue														_renderQueue;
+			std::vector<SortKeyAndIndex>										_sortKeys;
+			std::vector<SortKeyAndIndex>										_sortKeysBuffer;
+			std::vector<float>													_depths; // eye space depth of the z-sorted draw calls
+			// layouts of each draw call of the render queue, masked by the renderer without touching the draw calls
+			std::vector<uint>													_layouts;
+			bool																_mustUpdateLayouts;
 			FormatFunction														_formatFunction;
+			// per pool so that the renderers of different threads never share it
+			std::unordered_map<std::string, std::pair<std::string, int>>		_variablePropertyNameToPosition;
 
 
 		public:
 			inline static
 			Ptr
-			create(RendererPtr renderer)
+			create(RendererPtr renderer, std::shared_ptr<Effect> effect = nullptr)
 			{
-				Ptr drawCallPool(new DrawCallPool(renderer));
+				Ptr drawCallPool(new DrawCallPool(renderer, effect));
 
 				drawCallPool->_formatFunction = std::bind(
 					&DrawCallPool::formatPropertyName,
@@ -154,18 +175,38 @@ namespace minko
 				return drawCallPool;
 			}
 
-			const std::list<std::shared_ptr<DrawCall>>&
+			const std::vector<std::shared_ptr<DrawCall>>&
 			drawCalls();
 
+			// layouts of each draw call returned by the last call to drawCalls(), at the same index
+			inline
+			const std::vector<uint>&
+			layouts() const
+			{
+				return _layouts;
+			}
+
 			void
 			addSurface(SurfacePtr);
 
+			// bulk version of addSurface(), for whole scenes or sub-trees
+			void
+			addSurfaces(const std::vector<SurfacePtr>& surfaces);
+
 			void
 			removeSurface(SurfacePtr);
+
+			// the render queue is sorted again at next frame
+			inline
+			void
+			invalidateRenderQueue()
+			{
+				_mustSort = true;
+			}
 			
 		private:
 			
-			DrawCallPool(RendererPtr renderer);
+			DrawCallPool(RendererPtr renderer, std::shared_ptr<Effect> effect);
 
 			void
 			techniqueChanged(SurfacePtr surface, const std::string& technique, bool updateDrawCall);
@@ -173,6 +214,18 @@ namespace minko
 			void
 			visibilityChanged(SurfacePtr surface, RendererPtr renderer, bool visibility);
 
+			void
+			updateDrawCallsEnabled(SurfacePtr surface);
+
+			void
+			layoutsChanged(SurfacePtr surface);
+
+			void
+			updateLayouts();
+
+			void
+			watchSurface(SurfacePtr surface, Ptr that);
+
 			// generate draw call for one mesh
 			std::shared_ptr<DrawCall>
 			initializeDrawCall(std::shared_ptr<render::Pass>	pass, 
@@ -188,7 +241,17 @@ namespace minko
 							  ContainerPtr							rootData,
 						      std::list<data::ContainerProperty>&	booleanMacros,
 						      std::list<data::ContainerProperty>&	integerMacros,
-						      std::list<data::ContainerProperty>&	incorrectIntegerMacros);
+						      std::list<data::ContainerProperty>&	incorrectIntegerMacros,
+							  std::shared_ptr<Program>&				pendingProgram);
+
+			void
+			updatePendingPrograms();
+
+			void
+			retargetDrawCalls();
+
+			void
+			passReloadedHandler(PassPtr pass);
 						
 			DrawCallList&
 			generateDrawCall(SurfacePtr, unsigned int numAttempts); 
@@ -227,13 +290,12 @@ namespace minko
 			void
 			zsortNeededHandler(SurfacePtr, DrawCallPtr);
 
-			static
-			bool
-			compareDrawCalls(DrawCallPtr, DrawCallPtr);
+			void
+			buildRenderQueue();
 
 			static
-			Vector3Ptr
-			getDrawcallEyePosition(DrawCallPtr, Vector3Ptr output = nullptr);
+			void
+			radixSort(std::vector<SortKeyAndIndex>& keys, std::vector<SortKeyAndIndex>& buffer);
 
 			void
 			dataProviderIndexChanged(std::shared_ptr<data::ArrayProvider> provider, uint index, SurfacePtr surface);
@@ -0,0 +1,195 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+	namespace render
+	{
+		// scale of the offscreen resolution a Renderer draws at before upscaling to the back buffer, adjusted from
+		// the measured GPU frame times to hold a target frame time: it decreases as soon as the frames are too
+		// long and increases step by step while they are short enough, waiting a few frames after each change
+		// for its effect to be measured
+		class DynamicResolution
+		{
+		public:
+			typedef std::shared_ptr<DynamicResolution>	Ptr;
+
+		private:
+			typedef std::shared_ptr<AbstractContext>	AbstractContextPtr;
+			typedef std::shared_ptr<Texture>			TexturePtr;
+			typedef std::shared_ptr<Effect>				EffectPtr;
+
+		public:
+			// frames without change after a new scale, longer than the latency of the GPU timer queries
+			static const uint	NUM_COOLDOWN_FRAMES;
+			static const float	DEFAULT_MIN_SCALE;
+			static const float	DEFAULT_MAX_SCALE;
+
+		private:
+			EffectPtr			_effect;
+			float				_targetFrameTime;
+			float				_minScale;
+			float				_maxScale;
+			float				_step;
+			float				_hysteresis;
+			float				_scale;
+			float				_averageFrameTime;
+			uint				_numFrames;
+			uint				_cooldown;
+			TexturePtr			_target;
+			uint				_targetWidth;
+			uint				_targetHeight;
+
+		public:
+			// effect is the upscaling effect, "effect/DynamicResolution.effect", frame times are in milliseconds
+			inline static
+			Ptr
+			create(EffectPtr effect, float targetFrameTime = 1000.f / 60.f)
+			{
+				if (!effect)
+					throw std::invalid_argument("effect");
+				if (targetFrameTime <= 0.f)
+					throw std::invalid_argument("targetFrameTime");
+
+				return std::shared_ptr<DynamicResolution>(new DynamicResolution(effect, targetFrameTime));
+			}
+
+			inline
+			EffectPtr
+			effect() const
+			{
+				return _effect;
+			}
+
+			inline
+			float
+			targetFrameTime() const
+			{
+				return _targetFrameTime;
+			}
+
+			inline
+			void
+			targetFrameTime(float value)
+			{
+				_targetFrameTime = value;
+			}
+
+			inline
+			float
+			minScale() const
+			{
+				return _minScale;
+			}
+
+			void
+			minScale(float value);
+
+			inline
+			float
+			maxScale() const
+			{
+				return _maxScale;
+			}
+
+			void
+			maxScale(float value);
+
+			// the scale is always a multiple of the step, so that the resolution does not change every frame
+			inline
+			float
+			step() const
+			{
+				return _step;
+			}
+
+			inline
+			void
+			step(float value)
+			{
+				_step = value;
+			}
+
+			// the scale only increases when the frames are shorter than the target by this fraction
+			inline
+			float
+			hysteresis() const
+			{
+				return _hysteresis;
+			}
+
+			inline
+			void
+			hysteresis(float value)
+			{
+				_hysteresis = value;
+			}
+
+			inline
+			float
+			scale() const
+			{
+				return _scale;
+			}
+
+			// forces the scale, the measured frame times adjust it again afterwards
+			void
+			scale(float value);
+
+			inline
+			float
+			averageFrameTime() const
+			{
+				return _averageFrameTime;
+			}
+
+			// size in pixels of the part of the target rendered at the current scale, from its bottom left corner
+			inline
+			uint
+			regionWidth() const
+			{
+				return std::max(1u, (uint)(_targetWidth * _scale));
+			}
+
+			inline
+			uint
+			regionHeight() const
+			{
+				return std::max(1u, (uint)(_targetHeight * _scale));
+			}
+
+			// frameTime is the GPU time of a past frame, in milliseconds
+			void
+			update(float frameTime);
+
+			// the offscreen render target, recreated when the back buffer is resized
+			TexturePtr
+			target(AbstractContextPtr context, uint width, uint height);
+
+			~DynamicResolution();
+
+		private:
+			DynamicResolution(EffectPtr effect, float targetFrameTime);
+		};
+	}
+}
@@ -32,7 +32,8 @@ namespace minko
 			public std::enable_shared_from_this<Effect>
 		{
 		public:
-			typedef std::shared_ptr<Effect>	Ptr;
+			typedef std::shared_ptr<Effect>							Ptr;
+			typedef std::tuple<std::shared_ptr<Pass>, ProgramSignature, std::string>	Variant;
 
 		private:
 			typedef std::shared_ptr<Pass>										PassPtr;
@@ -138,7 +139,7 @@ namespace minko
 		private:
 			inline
 			void
-			setIndexBuffer(const std::vector<unsigned short>& indices)
+			setIndexBuffer(const std::vector<uint>& indices)
 			{
 				_indexFunction = std::make_shared<std::function<void(PassPtr)>>(std::bind(
 					&Effect::setIndexBufferOnPass, std::placeholders::_1, indices
@@ -211,6 +212,16 @@ namespace minko
             void
             removeTechnique(const std::string& name);
 
+			// JSON list of the program variants created so far, to be replayed with precompileVariants()
+			std::string
+			variantsManifest();
+
+			std::list<Variant>
+			variantsFromManifest(const std::string& manifest);
+
+			uint
+			precompileVariants(const std::string& manifest);
+
 		private:
 			Effect();
 
@@ -231,7 +242,7 @@ namespace minko
 
 			inline static
 			void
-			setIndexBufferOnPass(std::shared_ptr<Pass> pass, const std::vector<unsigned short>& indices)
+			setIndexBufferOnPass(std::shared_ptr<Pass> pass, const std::vector<uint>& indices)
 			{
 				pass->setIndexBuffer(indices);
 			}
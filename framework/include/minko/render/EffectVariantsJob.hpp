@@ -0,0 +1,92 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include "minko/Signal.hpp"
+#include "minko/component/JobManager.hpp"
+#include "minko/render/Effect.hpp"
+
+namespace minko
+{
+	namespace render
+	{
+		// precompiles the variants of an effect manifest, one per step, usually during a loading screen
+		class EffectVariantsJob :
+			public component::JobManager::Job,
+			public std::enable_shared_from_this<EffectVariantsJob>
+		{
+		public:
+			typedef std::shared_ptr<EffectVariantsJob>	Ptr;
+
+		private:
+			typedef std::shared_ptr<Effect>				EffectPtr;
+
+		private:
+			EffectPtr							_effect;
+			std::string							_manifest;
+			std::list<Effect::Variant>			_variants;
+			uint								_numCompiled;
+
+			Signal<Ptr, uint>::Ptr				_finished;
+
+		public:
+			inline static
+			Ptr
+			create(EffectPtr effect, const std::string& manifest)
+			{
+				return std::shared_ptr<EffectVariantsJob>(new EffectVariantsJob(effect, manifest));
+			}
+
+			inline
+			uint
+			numCompiled() const
+			{
+				return _numCompiled;
+			}
+
+			inline
+			Signal<Ptr, uint>::Ptr
+			finished() const
+			{
+				return _finished;
+			}
+
+			bool
+			complete();
+
+			void
+			beforeFirstStep();
+
+			void
+			step();
+
+			float
+			priority();
+
+			void
+			afterLastStep();
+
+		private:
+			EffectVariantsJob(EffectPtr effect, const std::string& manifest);
+		};
+	}
+}
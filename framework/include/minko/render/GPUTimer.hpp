@@ -0,0 +1,121 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+	namespace render
+	{
+		// GPU timer queries read back without stalling: the results usually arrive a few frames after
+		// their commands were issued and are recorded in the Profiler as GPU events
+		class GPUTimer
+		{
+		public:
+			typedef std::shared_ptr<GPUTimer>	Ptr;
+
+		private:
+			typedef std::shared_ptr<AbstractContext>	AbstractContextPtr;
+
+			struct Query
+			{
+				uint				id;
+				const char*			name;
+				unsigned long long	start;
+				uint				frame;
+			};
+
+		public:
+			// queries waiting for their results past which the new ones are dropped
+			static const uint							MAX_NUM_PENDING_QUERIES;
+
+		private:
+			AbstractContextPtr							_context;
+			std::vector<uint>							_freeQueries;
+			std::list<Query>							_pendingQueries;
+			bool										_running;
+			unsigned long long							_gpuTime;
+			uint										_frameId;
+			uint										_accumulatedFrameId;
+			unsigned long long							_accumulatedTime;
+			unsigned long long							_frameTime;
+
+		public:
+			inline static
+			Ptr
+			create(AbstractContextPtr context)
+			{
+				if (!context)
+					throw std::invalid_argument("context");
+
+				return std::shared_ptr<GPUTimer>(new GPUTimer(context));
+			}
+
+			inline
+			uint
+			numPendingQueries() const
+			{
+				return _pendingQueries.size();
+			}
+
+			inline
+			bool
+			running() const
+			{
+				return _running;
+			}
+
+			// GPU time in nanoseconds of the queries of the last frame whose results all arrived, 0 until then
+			inline
+			unsigned long long
+			frameTime() const
+			{
+				return _frameTime;
+			}
+
+			// the next queries belong to a new frame
+			inline
+			void
+			nextFrame()
+			{
+				++_frameId;
+			}
+
+			// ends the running query if any, name is kept as is like the names of Profiler scopes
+			void
+			begin(const char* name);
+
+			void
+			end();
+
+			// records the results available in the Profiler while it is enabled, in the order their queries
+			// were issued
+			void
+			update();
+
+			~GPUTimer();
+
+		private:
+			GPUTimer(AbstractContextPtr context);
+		};
+	}
+}
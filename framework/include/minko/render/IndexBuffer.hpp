@@ -22,6 +22,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/Common.hpp"
 
 #include "minko/render/AbstractResource.hpp"
+#include "minko/render/BufferUsage.hpp"
 
 namespace minko
 {
@@ -35,7 +36,13 @@ namespace minko
 			typedef std::shared_ptr<IndexBuffer>	Ptr;
 
 		private:
-			std::vector<unsigned short>	_data;
+			// indices are stored as 32 bits integers but uploaded as 16 bits ones whenever they fit
+			std::vector<uint>			_data;
+			uint						_indexSize;
+			BufferUsage					_usage;
+			uint						_numDisposedIndices; // uploaded before disposeData()
+			uint						_capacity; // indices the GPU buffer is allocated for, see reserve()
+			uint						_gpuSize;
 
 		public:
 			~IndexBuffer()
@@ -53,26 +60,91 @@ namespace minko
 			inline static
 			Ptr
 			create(std::shared_ptr<render::AbstractContext> context,
-				   const std::vector<unsigned short>&		data)
+				   const std::vector<uint>&					data)
 			{
 				return std::shared_ptr<IndexBuffer>(new IndexBuffer(context, data));
 			}
 
+			// the indices are moved into the buffer instead of being copied
+			inline static
+			Ptr
+			create(std::shared_ptr<render::AbstractContext> context,
+				   std::vector<uint>&&						data)
+			{
+				return std::shared_ptr<IndexBuffer>(new IndexBuffer(context, std::move(data)));
+			}
+
+			inline static
+			Ptr
+			create(std::shared_ptr<render::AbstractContext> context,
+				   const std::vector<unsigned short>&		data)
+			{
+				return create(context, data.begin(), data.end());
+			}
+
 			template <typename T>
 			inline static
 			Ptr
-			create(std::shared_ptr<render::AbstractContext> context, T* begin, T* end)
+			create(std::shared_ptr<render::AbstractContext> context, T begin, T end)
 			{
 				return std::shared_ptr<IndexBuffer>(new IndexBuffer(context, begin, end));
 			}
 
 			inline
-			std::vector<unsigned short>&
+			std::vector<uint>&
 			data()
 			{
 				return _data;
 			}
 
+			inline
+			uint
+			numIndices() const
+			{
+				return _data.empty() ? _numDisposedIndices : _data.size();
+			}
+
+			inline
+			bool
+			dataDisposed() const
+			{
+				return _data.empty() && _numDisposedIndices != 0;
+			}
+
+			// size in bytes of the indices on the GPU: 2 or 4, 0 until uploaded
+			inline
+			uint
+			indexSize() const
+			{
+				return _indexSize;
+			}
+
+			inline
+			BufferUsage
+			usage() const
+			{
+				return _usage;
+			}
+
+			void
+			usage(BufferUsage value);
+
+			inline
+			uint
+			capacity() const
+			{
+				return _capacity;
+			}
+
+			// allocates the GPU buffer for at least numIndices on the next upload, so that indices can be
+			// appended and uploaded with upload(offset, count) without re-creating it
+			inline
+			void
+			reserve(uint numIndices)
+			{
+				_capacity = numIndices;
+			}
+
 			inline
 			void
 			upload()
@@ -83,35 +155,84 @@ namespace minko
 			void
 			upload(uint offset, uint count = 0);
 
+			// uploads all the indices from the upload thread when there is one, the buffer must not be used to
+			// render until complete is executed
+			void
+			uploadAsync(std::shared_ptr<UploadThread> uploadThread, std::function<void()> complete = nullptr);
+
 			void
 			dispose();
 
+			// frees the CPU-side copy of the uploaded indices, they have to be set again in data() before
+			// any other upload
+			void
+			disposeData();
+
+			// allocates a buffer of the same size and index size in the new context so that it can be bound at
+			// once, upload() restores the indices
+			void
+			contextRestored();
+
 			bool
 			equals(std::shared_ptr<IndexBuffer> indexBuffer)
 			{
 				return _data == indexBuffer->_data;
 			}
+
+		private:
+			// (re-)creates the GPU buffer if needed, returns true when it was created
+			bool
+			allocate(bool useUnsignedInt);
+
 		protected:
 			IndexBuffer(std::shared_ptr<render::AbstractContext> context) :
-				AbstractResource(context)
+				AbstractResource(context),
+				_indexSize(0),
+				_usage(BufferUsage::STATIC),
+				_numDisposedIndices(0),
+				_capacity(0),
+				_gpuSize(0)
 			{
 
 			}
 
 			IndexBuffer(std::shared_ptr<render::AbstractContext>	context,
-						const std::vector<unsigned short>&			data) :
+						const std::vector<uint>&					data) :
+				AbstractResource(context),
+				_data(data),
+				_indexSize(0),
+				_usage(BufferUsage::STATIC),
+				_numDisposedIndices(0),
+				_capacity(0),
+				_gpuSize(0)
+			{
+				upload();
+			}
+
+			IndexBuffer(std::shared_ptr<render::AbstractContext>	context,
+						std::vector<uint>&&							data) :
 				AbstractResource(context),
-				_data(data)
+				_data(std::move(data)),
+				_indexSize(0),
+				_usage(BufferUsage::STATIC),
+				_numDisposedIndices(0),
+				_capacity(0),
+				_gpuSize(0)
 			{
 				upload();
 			}
 
 			template <typename T>
 			IndexBuffer(std::shared_ptr<render::AbstractContext>	context,
-						T*											begin,
-						T*											end) :
+						T											begin,
+						T											end) :
 				AbstractResource(context),
-				_data(begin, end)
+				_data(begin, end),
+				_indexSize(0),
+				_usage(BufferUsage::STATIC),
+				_numDisposedIndices(0),
+				_capacity(0),
+				_gpuSize(0)
 			{
 				upload();
 			}
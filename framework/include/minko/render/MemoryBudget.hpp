@@ -0,0 +1,117 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+	namespace render
+	{
+		// accounts for the GPU memory of textures and buffers and evicts the least recently rendered
+		// textures when over budget, evicted textures are uploaded again from their CPU data when rendered
+		class MemoryBudget
+		{
+		public:
+			typedef std::shared_ptr<MemoryBudget>		Ptr;
+
+		private:
+			typedef std::shared_ptr<AbstractTexture>	AbsTexturePtr;
+			typedef std::shared_ptr<AbstractResource>	AbsResourcePtr;
+
+			struct TextureResidency
+			{
+				AbsTexturePtr	texture;
+				uint			size;
+				uint			lastFrame;
+				bool			resident;
+			};
+
+		private:
+			uint										_budget;
+			uint										_usedBytes;
+			uint										_frameId;
+			std::unordered_map<int, TextureResidency>	_textures;
+			std::unordered_map<AbsResourcePtr, uint>	_buffers;
+
+		public:
+			inline static
+			Ptr
+			create(uint budget)
+			{
+				return std::shared_ptr<MemoryBudget>(new MemoryBudget(budget));
+			}
+
+			inline
+			uint
+			budget() const
+			{
+				return _budget;
+			}
+
+			inline
+			void
+			budget(uint value)
+			{
+				_budget = value;
+			}
+
+			inline
+			uint
+			usedBytes() const
+			{
+				return _usedBytes;
+			}
+
+			void
+			track(AbsTexturePtr texture);
+
+			void
+			track(std::shared_ptr<VertexBuffer> vertexBuffer);
+
+			void
+			track(std::shared_ptr<IndexBuffer> indexBuffer);
+
+			void
+			untrack(AbsResourcePtr resource);
+
+			bool
+			tracked(AbsResourcePtr resource) const;
+
+			bool
+			resident(AbsTexturePtr texture) const;
+
+			// marks a texture as rendered during the current frame and uploads it again if it was evicted
+			void
+			touch(int textureId);
+
+			// evicts the textures unused for the longest time until the budget is met
+			void
+			nextFrame();
+
+			static
+			uint
+			textureSize(AbsTexturePtr texture);
+
+		private:
+			MemoryBudget(uint budget);
+		};
+	}
+}
@@ -24,6 +24,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/render/AbstractContext.hpp"
 #include "minko/render/ProgramInputs.hpp"
 #include "minko/render/Blending.hpp"
+#include "minko/render/VertexAttributeType.hpp"
+#include "minko/render/BufferUsage.hpp"
 
 namespace minko
 {
@@ -40,15 +42,47 @@ namespace minko
             typedef std::unordered_map<unsigned int, unsigned int>		BlendFactorsMap;
 			typedef std::unordered_map<CompareMode, unsigned int>		CompareFuncsMap;
 			typedef std::unordered_map<StencilOperation, unsigned int>	StencilOperationMap;
+			typedef std::unordered_map<TextureFormat, unsigned int>		TextureFormatMap;
             typedef std::unordered_map<unsigned int, unsigned int>		TextureToBufferMap;
 			typedef std::pair<uint, uint>								TextureSize;
+			typedef std::vector<unsigned char>							UniformValue;
+			typedef std::unordered_map<uint, UniformValue>				LocationToUniformValueMap;
 
 		protected:
-	        static BlendFactorsMap					_blendingFactors;
-			static CompareFuncsMap					_compareFuncs;
-			static StencilOperationMap				_stencilOps;
+			// sampler state of a texture object and what the texture allows
+			struct TextureSampler
+			{
+				uint			glTarget;
+				bool			hasMipmaps;
+				bool			repeatable;
+				WrapMode		wrapMode;
+				TextureFilter	textureFilter;
+				MipFilter		mipFilter;
+			};
+
+		protected:
+			// read-only once initialized, shared by the contexts of all the threads
+	        static const BlendFactorsMap			_blendingFactors;
+			static const CompareFuncsMap			_compareFuncs;
+			static const StencilOperationMap		_stencilOps;
 
 			bool									_errorsEnabled;
+			bool									_instancingSupported;
+			bool									_unsignedIntIndicesSupported;
+			bool									_pixelBuffersSupported;
+			bool									_fencesSupported;
+			bool									_parallelShaderCompileSupported;
+			bool									_programBinariesSupported;
+			bool									_timerQueriesSupported;
+			bool									_disjointTimerQueries; // EXT_disjoint_timer_query
+			bool									_occlusionQueriesSupported;
+			bool									_npotTexturesSupported; // with mipmaps and REPEAT
+			bool									_halfFloatVerticesSupported;
+			bool									_packedVerticesSupported; // 2_10_10_10_REV
+			bool									_vertexArraysSupported;
+			bool									_floatTexturesSupported; // with vertex texture fetch
+			TextureFormatMap						_compressedTextureFormats; // only the formats supported by the driver
+			std::unordered_map<uint, std::pair<uint, BufferUsage>>	_dynamicBuffers; // size in bytes and usage
 
 			std::list<uint>							_textures;
             std::unordered_map<uint, TextureSize>	_textureSizes;
@@ -62,9 +96,21 @@ namespace minko
 			std::list<unsigned int>                 _programs;
 			std::list<unsigned int>                 _vertexShaders;
 			std::list<unsigned int>                 _fragmentShaders;
+			// pixel buffers are emulated in main memory without GL_PIXEL_PACK_BUFFER
+			std::unordered_map<uint, std::vector<unsigned char>>	_pixelBuffers;
+			uint									_nextPixelBufferId;
+			std::unordered_map<uint, void*>			_fences; // GLsync objects
+			uint									_nextFenceId;
+			std::list<uint>							_timerQueries;
+			std::list<uint>							_occlusionQueries;
+			std::list<uint>							_vertexArrays;
+			// the index buffer bound to each vertex array the last time it was bound
+			std::unordered_map<uint, int>			_vertexArrayIndexBuffers;
 
             TextureToBufferMap                      _frameBuffers;
             TextureToBufferMap                      _renderBuffers;
+            // depth buffers are shared by the render targets of the same size: size to buffer and number of targets
+            std::unordered_map<uint64_t, std::pair<uint, uint>>	_depthBuffers;
 
 			unsigned int			                _viewportX;
 			unsigned int			                _viewportY;
@@ -73,15 +119,20 @@ namespace minko
 
             unsigned int                            _currentTarget;
 			int						                _currentIndexBuffer;
+			uint									_currentIndexSize;
+			std::unordered_map<uint, uint>			_indexBufferIndexSize;
 			std::vector<int>		                _currentVertexBuffer;
 			std::vector<int>		                _currentVertexSize;
 			std::vector<int>		                _currentVertexStride;
 			std::vector<int>		                _currentVertexOffset;
+			std::vector<VertexAttributeType>		_currentVertexType;
+			std::vector<uint>		                _currentVertexDivisor;
+			uint									_currentVertexArray;
 			uint									_currentBoundTexture;
 			std::vector<int>		                _currentTexture;
-            std::unordered_map<uint, WrapMode>      _currentWrapMode;
-            std::unordered_map<uint, TextureFilter> _currentTextureFilter;
-            std::unordered_map<uint, MipFilter>     _currentMipFilter;
+			std::unordered_map<uint, TextureSampler>	_textureSamplers;
+			// sampler of the texture bound to each unit, looked up again only when another texture is bound
+			std::vector<std::pair<int, TextureSampler*>>	_currentSampler;
 			int						                _currentProgram;
 			Blending::Mode			                _currentBlendMode;
 			bool									_currentColorMask;
@@ -95,6 +146,15 @@ namespace minko
 			StencilOperation						_currentStencilZFailOp;
 			StencilOperation						_currentStencilZPassOp;
 
+			std::unordered_map<uint, LocationToUniformValueMap>	_programUniformValues;
+			LocationToUniformValueMap*							_currentUniformValues;
+
+			RenderStats												_stats;
+			std::unordered_map<uint, unsigned long long>			_bufferMemorySizes;
+			std::unordered_map<uint, unsigned long long>			_textureMemorySizes;
+			unsigned long long										_bufferMemory;
+			unsigned long long										_textureMemory;
+
 		public:
 			~OpenGLES2Context();
 
@@ -175,15 +235,54 @@ namespace minko
 			void
 			drawTriangles(const uint indexBuffer, const int numTriangles);
 
+			inline
+			bool
+			supportsInstancing()
+			{
+				return _instancingSupported;
+			}
+
+			void
+			drawTrianglesInstanced(const uint indexBuffer, const int numTriangles, const uint numInstances);
+
 			const uint
-			createVertexBuffer(const uint size);
+			createVertexBuffer(const uint size, BufferUsage usage = BufferUsage::STATIC);
 
 			void
-			setVertexBufferAt(const uint	position,
-							  const uint	vertexBuffer,
-							  const uint	size,
-							  const uint	stride,
-							  const uint	offset);
+			setVertexBufferAt(const uint			position,
+							  const uint			vertexBuffer,
+							  const uint			size,
+							  const uint			stride,
+							  const uint			offset,
+							  VertexAttributeType	type = VertexAttributeType::FLOAT);
+
+			inline
+			bool
+			supportsVertexAttributeType(VertexAttributeType type)
+			{
+				return (type != VertexAttributeType::HALF_FLOAT || _halfFloatVerticesSupported)
+					&& (type != VertexAttributeType::INT_2_10_10_10_NORMALIZED || _packedVerticesSupported);
+			}
+
+			void
+			setVertexAttributeDivisor(const uint position, const uint divisor);
+
+			inline
+			bool
+			supportsVertexArrays()
+			{
+				return _vertexArraysSupported;
+			}
+
+			const uint
+			createVertexArray();
+
+			void
+			setVertexArray(const uint vertexArray);
+
+			void
+			deleteVertexArray(const uint vertexArray);
+
 			void
 			uploadVertexBufferData(const uint 	vertexBuffer,
 								   const uint 	offset,
@@ -193,8 +292,18 @@ namespace minko
 			void
 			deleteVertexBuffer(const uint vertexBuffer);
 
+			inline
+			bool
+			supportsUnsignedIntIndices()
+			{
+				return _unsignedIntIndicesSupported;
+			}
+
 			const uint
-			createIndexBuffer(const uint size);
+			createIndexBuffer(const uint size, const bool useUnsignedInt = false, BufferUsage usage = BufferUsage::STATIC);
+
+			void
+			setBufferUsage(uint buffer, BufferUsage usage);
 
 			void
 			uploaderIndexBufferData(const uint 	indexBuffer,
@@ -219,6 +328,50 @@ namespace minko
 							    unsigned int 	mipLevel,
 							    void*			data);
 
+			inline
+			bool
+			supportsNonPowerOfTwoTextures(bool mipMapping)
+			{
+				// OpenGL ES 2.0 and WebGL always support NPOT textures without mipmaps
+				return !mipMapping || _npotTexturesSupported;
+			}
+
+			inline
+			bool
+			supportsTextureFormat(TextureFormat format)
+			{
+				return format == TextureFormat::RGB
+					|| format == TextureFormat::RGBA
+					|| _compressedTextureFormats.count(format) != 0;
+			}
+
+			inline
+			bool
+			supportsFloatTextures()
+			{
+				return _floatTexturesSupported;
+			}
+
+			void
+			uploadFloatTexture2dData(uint			texture,
+									 unsigned int	width,
+									 unsigned int	height,
+									 const float*	data);
+
+			void
+			uploadCompressedTexture2dData(uint			texture,
+										  TextureFormat	format,
+										  unsigned int	width,
+										  unsigned int	height,
+										  unsigned int	mipLevel,
+										  void*			data);
+
+			void
+			setTextureBaseLevel(uint texture, uint level);
+
+			void
+			releaseTextureStorage(uint texture);
+
 			void
 			uploadCubeTextureData(uint				texture,
 								  CubeTexture::Face face,
@@ -227,6 +380,9 @@ namespace minko
 							      unsigned int 		mipLevel,
 							      void*				data);
 
+			void
+			copyToCubeTexture(uint texture, CubeTexture::Face face, unsigned int width, unsigned int height);
+
 			void
 			deleteTexture(uint texture);
 
@@ -250,6 +406,29 @@ namespace minko
 			void
 			linkProgram(const uint program);
 
+			inline
+			bool
+			supportsParallelShaderCompile()
+			{
+				return _parallelShaderCompileSupported;
+			}
+
+			bool
+			isProgramLinked(const uint program);
+
+			inline
+			bool
+			supportsProgramBinaries()
+			{
+				return _programBinariesSupported;
+			}
+
+			bool
+			getProgramBinary(const uint program, uint& format, std::vector<unsigned char>& binary);
+
+			bool
+			setProgramBinary(const uint program, const uint format, const std::vector<unsigned char>& binary);
+
 			void
 			deleteProgram(const uint program);
 
@@ -365,6 +544,141 @@ namespace minko
 			void
 			readPixels(unsigned char* pixels);
 
+			inline
+			bool
+			supportsPixelBuffers()
+			{
+				return _pixelBuffersSupported;
+			}
+
+			const uint
+			createPixelBuffer(const uint size);
+
+			void
+			deletePixelBuffer(const uint pixelBuffer);
+
+			void
+			readPixelsAsync(unsigned int x, unsigned int y, unsigned int width, unsigned int height, const uint pixelBuffer);
+
+			void
+			pixelBufferData(const uint pixelBuffer, const uint size, unsigned char* pixels);
+
+			inline
+			bool
+			supportsFences()
+			{
+				return _fencesSupported;
+			}
+
+			const uint
+			createFence();
+
+			void
+			deleteFence(const uint fence);
+
+			bool
+			fenceSignaled(const uint fence);
+
+			// GL calls for the thread of an UploadThread, whose context shares the objects of this one: they leave
+			// the states, statistics and memory sizes of this context untouched, the storage of the texture or
+			// buffer being already allocated
+			static
+			void
+			uploadTexture2dDataShared(uint			texture,
+									  uint			width,
+									  uint			height,
+									  uint			mipLevel,
+									  const void*	data,
+									  bool			generateMipmaps);
+
+			static
+			void
+			uploadBufferDataShared(bool indices, uint buffer, uint offset, uint size, const void* data);
+
+			// nullptr without fences, once the calls of the thread were executed
+			static
+			void*
+			createFenceShared(bool fencesSupported);
+
+			static
+			bool
+			fenceSignaledShared(void* fence);
+
+			static
+			void
+			deleteFenceShared(void* fence);
+
+			inline
+			bool
+			supportsTimerQueries()
+			{
+				return _timerQueriesSupported;
+			}
+
+			const uint
+			createTimerQuery();
+
+			void
+			deleteTimerQuery(const uint query);
+
+			void
+			beginTimerQuery(const uint query);
+
+			void
+			endTimerQuery();
+
+			bool
+			isTimerQueryAvailable(const uint query);
+
+			bool
+			getTimerQueryResult(const uint query, uint64_t& nanoseconds);
+
+			inline
+			bool
+			supportsOcclusionQueries()
+			{
+				return _occlusionQueriesSupported;
+			}
+
+			const uint
+			createOcclusionQuery();
+
+			void
+			deleteOcclusionQuery(const uint query);
+
+			void
+			beginOcclusionQuery(const uint query);
+
+			void
+			endOcclusionQuery();
+
+			bool
+			isOcclusionQueryAvailable(const uint query);
+
+			bool
+			getOcclusionQueryResult(const uint query);
+
+			inline
+			const RenderStats&
+			renderStats() const
+			{
+				return _stats;
+			}
+
+			inline
+			unsigned long long
+			bufferMemory() const
+			{
+				return _bufferMemory;
+			}
+
+			inline
+			unsigned long long
+			textureMemory() const
+			{
+				return _textureMemory;
+			}
+
             void
             setTriangleCulling(TriangleCulling triangleCulling);
 
@@ -377,6 +691,10 @@ namespace minko
             void
             generateMipmaps(unsigned int texture);
 
+			virtual
+			void
+			contextRestored();
+
 		protected:
 			OpenGLES2Context();
 
@@ -410,6 +728,18 @@ namespace minko
 			StencilOperationMap
 			initializeStencilOperationsMap();
 
+			void
+			initializeCompressedTextureFormats(const std::string& extensions);
+
+			void
+			uploadBufferData(uint target, uint buffer, uint offset, uint size, void* data);
+
+			void
+			setMemorySize(std::unordered_map<uint, unsigned long long>&	sizes,
+						  unsigned long long&							total,
+						  uint											id,
+						  unsigned long long							size);
+
             void
             createRTTBuffers(TextureType	type,
 							 uint			texture, 
@@ -440,6 +770,51 @@ namespace minko
 
 			TextureType
 			getTextureType(uint textureId) const;
+
+			// sampler of the texture bound at this position, the states are restricted to what the texture supports
+			TextureSampler*
+			currentSampler(uint position, WrapMode& wrapping, MipFilter& mipFiltering);
+
+			static
+			int
+			getGLWrapMode(WrapMode wrapping);
+
+			static
+			int
+			getGLMinFilter(TextureFilter filtering, MipFilter mipFiltering);
+
+			static
+			int
+			getGLMagFilter(TextureFilter filtering);
+
+			static
+			uint
+			getGLCubeFace(CubeTexture::Face face);
+
+			// returns false if the value is the one already stored for this location in the current program
+			inline
+			bool
+			uniformValueChanged(uint location, const void* values, uint numBytes, unsigned char tag = 0)
+			{
+				if (_currentUniformValues != nullptr)
+				{
+					auto&		currentValue	= (*_currentUniformValues)[location];
+					const auto	bytes			= reinterpret_cast<const unsigned char*>(values);
+
+					if (currentValue.size() == numBytes + 1
+						&& currentValue[numBytes] == tag
+						&& std::memcmp(&currentValue[0], bytes, numBytes) == 0)
+						return false;
+
+					currentValue.assign(bytes, bytes + numBytes);
+					currentValue.push_back(tag);
+				}
+
+				// the caller issues the glUniform call
+				++_stats.numUniformCalls;
+
+				return true;
+			}
 		};
 	}
 }
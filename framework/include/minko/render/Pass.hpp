@@ -21,11 +21,13 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/Common.hpp"
 
+#include "minko/Signal.hpp"
 #include "minko/render/Blending.hpp"
 #include "minko/render/CompareMode.hpp"
 #include "minko/render/TriangleCulling.hpp"
 #include "minko/render/ProgramSignature.hpp"
 #include "minko/render/Program.hpp"
+#include "minko/render/DrawCall.hpp"
 #include "minko/render/States.hpp"
 #include "minko/math/Vector2.hpp"
 #include "minko/math/Vector3.hpp"
@@ -48,11 +50,14 @@ namespace minko
             typedef std::unordered_map<std::string, SamplerState>						SamplerStatesMap;
 			typedef std::shared_ptr<States>												StatesPtr;
 			typedef std::unordered_map<ProgramSignature, ProgramPtr>					SignatureProgramMap;
+			typedef std::unordered_map<ProgramSignature, std::string>					SignatureDefinesMap;
+			typedef std::unordered_set<ProgramSignature>								SignatureSet;
 			typedef std::shared_ptr<std::function<void(ProgramPtr)>>					OnProgramFunctionPtr;
 			typedef std::list<std::function<void(ProgramPtr)>>							OnProgramFunctionList;	
 			typedef std::unordered_map<std::string, data::MacroBinding>					MacroBindingsMap;
 			typedef std::unordered_map<std::string, std::string>						StringToStringMap;
 			typedef std::function<std::string(const std::string&, StringToStringMap&)>	FormatFunction;
+			typedef Signal<Ptr>															ReloadedSignal;
 
 		private:
 			const std::string						_name;
@@ -64,6 +69,10 @@ namespace minko
             StatesPtr								_states;
 			std::string								_fallback;
 			SignatureProgramMap						_signatureToProgram;
+			SignatureDefinesMap						_signatureToDefines;
+			// variants that failed to compile, the technique falls back without compiling them again
+			SignatureSet							_failedSignatures;
+			std::unordered_map<ProgramPtr, DrawCall::BindingPlanPtr>	_programToBindingPlan;
 
 			OnProgramFunctionList					_uniformFunctions;
 			OnProgramFunctionList					_attributeFunctions;
@@ -72,6 +81,8 @@ namespace minko
 			std::set<std::string>					_definedBoolMacros;
 			std::unordered_map<std::string, int>	_definedIntMacros;
 
+			std::shared_ptr<ReloadedSignal>			_reloaded;
+
 		public:
 			inline static
 			Ptr
@@ -112,6 +123,8 @@ namespace minko
 				);
 
 				p->_signatureToProgram = pass->_signatureToProgram;
+				p->_signatureToDefines = pass->_signatureToDefines;
+				p->_failedSignatures = pass->_failedSignatures;
 
 				p->_uniformFunctions = pass->_uniformFunctions;
 				p->_attributeFunctions = pass->_attributeFunctions;
@@ -186,6 +199,8 @@ namespace minko
 				return _fallback;
 			}
 
+			// when the selected variant is still being compiled in the background, the program template
+			// is returned instead and pendingProgram is set to the variant
 			std::shared_ptr<Program>
 			selectProgram(std::shared_ptr<render::DrawCall>		drawCall,
 						  std::shared_ptr<data::Container>		targetData,
@@ -193,8 +208,42 @@ namespace minko
 						  std::shared_ptr<data::Container>		rootData,
 						  std::list<data::ContainerProperty>&	booleanMacros,
 						  std::list<data::ContainerProperty>&	integerMacros,
-						  std::list<data::ContainerProperty>&	incorrectIntegerMacros);
+						  std::list<data::ContainerProperty>&	incorrectIntegerMacros,
+						  std::shared_ptr<Program>&				pendingProgram);
 			
+			// macro definitions of every program variant created so far, by signature
+			inline
+			const SignatureDefinesMap&
+			variants() const
+			{
+				return _signatureToDefines;
+			}
+
+			// replaces the shaders of the template and drops the variants, which are recompiled on demand
+			void
+			reload(const std::string& vertexShaderSource, const std::string& fragmentShaderSource);
+
+			// the programs died with a lost GPU context: reloads the same shaders, the variants are linked again
+			// on demand from the program binary cache when there is one
+			void
+			contextRestored();
+
+			// executed by reload(), for the draw calls of the pass to select their programs again
+			inline
+			std::shared_ptr<ReloadedSignal>
+			reloaded() const
+			{
+				return _reloaded;
+			}
+
+			// program inputs resolved against the bindings of the pass, shared by all its draw calls
+			DrawCall::BindingPlanPtr
+			bindingPlan(ProgramPtr program);
+
+			// creates the variant ahead of its first use, returns false if it already exists
+			bool
+			precompileVariant(const ProgramSignature& signature, const std::string& defines);
+
 			template <typename... T>
 			void
 			setUniform(const std::string& name, const T&... values)
@@ -225,7 +274,7 @@ namespace minko
 
 			inline
 			void
-			setIndexBuffer(const std::vector<unsigned short>& indices)
+			setIndexBuffer(const std::vector<uint>& indices)
 			{
 				_indexFunction = std::make_shared<std::function<void(ProgramPtr)>>(std::bind(
 					&Pass::setIndexBufferOnProgram, std::placeholders::_1, indices
@@ -298,11 +347,19 @@ namespace minko
 
 			static 
 			void
-			setIndexBufferOnProgram(std::shared_ptr<Program> program, const std::vector<unsigned short>& indices)
+			setIndexBufferOnProgram(std::shared_ptr<Program> program, const std::vector<uint>& indices)
 			{
 				program->setIndexBuffer(indices);
 			}
 
+			// starts linking program and returns the program to render with meanwhile, or nullptr
+			// when program must be completed synchronously
+			ProgramPtr
+			linkInBackground(ProgramPtr program);
+
+			ProgramPtr
+			createVariant(const ProgramSignature& signature, std::string defines);
+
 			ProgramPtr
 			finalizeProgram(ProgramPtr program);
 		};
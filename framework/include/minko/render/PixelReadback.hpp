@@ -0,0 +1,138 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+	namespace render
+	{
+		// reads back regions of the render target without waiting for the GPU: each read() copies the pixels in one
+		// of a ring of pixel buffers, update() polls the fences of the pending reads and executes their callbacks
+		// once the copies are done, usually a few frames later; without fences a read is considered done once the
+		// rest of the ring was used
+		class PixelReadback :
+			public std::enable_shared_from_this<PixelReadback>
+		{
+		public:
+			typedef std::shared_ptr<PixelReadback>	Ptr;
+
+			// RGBA pixels, the first row is the bottom one
+			struct Image
+			{
+				uint						x;
+				uint						y;
+				uint						width;
+				uint						height;
+				std::vector<unsigned char>	pixels;
+			};
+
+			typedef std::shared_ptr<Image>				ImagePtr;
+			typedef std::function<void(ImagePtr)>		Callback;
+
+			static const uint							DEFAULT_RING_SIZE;
+
+		private:
+			typedef std::shared_ptr<AbstractContext>	ContextPtr;
+
+			struct Read
+			{
+				uint		pixelBuffer;
+				uint		size;
+				int			fence;
+				uint		frame;
+				bool		pending;
+				ImagePtr	image;
+				Callback	encoder;
+				Callback	callback;
+			};
+
+		private:
+			ContextPtr							_context;
+			std::shared_ptr<async::ThreadPool>	_threadPool;
+			std::vector<Read>					_reads;
+			uint								_nextRead;
+			uint								_frame;
+			uint								_numStalls;
+
+		public:
+			inline static
+			Ptr
+			create(ContextPtr							context,
+				   std::shared_ptr<async::ThreadPool>	threadPool	= nullptr,
+				   uint									ringSize	= DEFAULT_RING_SIZE)
+			{
+				if (context == nullptr)
+					throw std::invalid_argument("context");
+				if (ringSize == 0)
+					throw std::invalid_argument("ringSize");
+
+				return std::shared_ptr<PixelReadback>(new PixelReadback(context, threadPool, ringSize));
+			}
+
+			~PixelReadback();
+
+			inline
+			uint
+			ringSize() const
+			{
+				return _reads.size();
+			}
+
+			uint
+			numPendingReads() const;
+
+			// reads that had to wait for the GPU because all the pixel buffers of the ring were pending
+			inline
+			uint
+			numStalls() const
+			{
+				return _numStalls;
+			}
+
+			// callback is executed on the calling thread of update(); when encoder is set, it is executed first
+			// with the same image, on the thread pool if any, for example to compress a captured frame
+			void
+			read(uint x, uint y, uint width, uint height, Callback callback, Callback encoder = nullptr);
+
+			// the whole viewport
+			void
+			read(Callback callback, Callback encoder = nullptr);
+
+			// usually once per frame, after the frame was rendered
+			void
+			update();
+
+			// waits for all the pending reads and executes their callbacks, the encoders might still be running
+			void
+			flush();
+
+		private:
+			PixelReadback(ContextPtr context, std::shared_ptr<async::ThreadPool> threadPool, uint ringSize);
+
+			bool
+			done(const Read& read);
+
+			void
+			resolve(Read& read);
+		};
+	}
+}
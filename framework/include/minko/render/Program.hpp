@@ -54,6 +54,16 @@ namespace minko
 			std::unordered_map<int, VertexBufferPtr>			_vertexBuffers;
 			IndexBufferPtr										_indexBuffer;
 
+			// last rendering pass in which the shared uniforms of the program were uploaded
+			uint												_sharedUniformsPass;
+			// id of the program between link() and upload(), while the driver may still be linking it
+			int													_linkingId;
+			// key of the binary to store in the cache once linked, empty if it was loaded from it
+			std::string											_binaryKey;
+
+			static std::shared_ptr<ProgramCache>				_binaryCache;
+			static std::shared_ptr<ShaderOptimizer>				_optimizer;
+
 		public:
 			inline static
 			Ptr
@@ -141,12 +151,77 @@ namespace minko
 				return _indexBuffer;
 			}
 
+			inline
+			uint
+			sharedUniformsPass() const
+			{
+				return _sharedUniformsPass;
+			}
+
+			inline
+			void
+			sharedUniformsPass(uint pass)
+			{
+				_sharedUniformsPass = pass;
+			}
+
+			// when set, programs are linked from the binaries stored in the cache when possible and
+			// the binaries of newly compiled programs are added to it
+			inline static
+			std::shared_ptr<ProgramCache>
+			binaryCache()
+			{
+				return _binaryCache;
+			}
+
+			inline static
+			void
+			binaryCache(std::shared_ptr<ProgramCache> cache)
+			{
+				_binaryCache = cache;
+			}
+
+			// when set, the shaders are optimized right before being compiled, the binary cache is
+			// still keyed by the sources they had before to skip the optimization as well
+			inline static
+			std::shared_ptr<ShaderOptimizer>
+			optimizer()
+			{
+				return _optimizer;
+			}
+
+			inline static
+			void
+			optimizer(std::shared_ptr<ShaderOptimizer> optimizer)
+			{
+				_optimizer = optimizer;
+			}
+
+			// starts compiling and linking the program, upload() then completes it
+			void
+			link();
+
+			inline
+			bool
+			isLinking() const
+			{
+				return _linkingId != -1;
+			}
+
+			// true when upload() can complete the program without waiting for the driver
+			bool
+			isLinked();
+
 			void
 			upload();
 
 			void
 			dispose();
 
+			// forgets the program and its shaders, link() compiles them again or loads the binary from the cache
+			void
+			contextRestored();
+
 			template <typename... T>
 			void
 			setUniform(const std::string& name, const T&... values)
@@ -175,7 +250,7 @@ namespace minko
 			setVertexAttribute(const std::string& name, unsigned int attributeSize, const std::vector<float>& data);
 
 			void
-			setIndexBuffer(const std::vector<unsigned short>&);
+			setIndexBuffer(const std::vector<uint>&);
 
 		private:
 			Program(AbstractContextPtr context);
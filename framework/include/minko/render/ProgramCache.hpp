@@ -0,0 +1,80 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+	namespace render
+	{
+		// stores linked program binaries on disk so that later runs do not have to compile them again
+		class ProgramCache
+		{
+		public:
+			typedef std::shared_ptr<ProgramCache>	Ptr;
+
+		private:
+			typedef std::shared_ptr<AbstractContext>	AbstractContextPtr;
+
+		private:
+			std::string	_directory;
+
+		public:
+			inline static
+			Ptr
+			create(const std::string& directory)
+			{
+				return std::shared_ptr<ProgramCache>(new ProgramCache(directory));
+			}
+
+			inline
+			const std::string&
+			directory() const
+			{
+				return _directory;
+			}
+
+			// identifies a program from the driver and its preprocessed sources, defines included
+			static
+			std::string
+			key(AbstractContextPtr		context,
+				const std::string&		vertexShaderSource,
+				const std::string&		fragmentShaderSource);
+
+			// links program from the binary stored for key, returns false if there is none or if
+			// the driver rejected it
+			bool
+			load(AbstractContextPtr context, const uint program, const std::string& key);
+
+			void
+			store(AbstractContextPtr context, const uint program, const std::string& key);
+
+		private:
+			ProgramCache(const std::string& directory) :
+				_directory(directory)
+			{
+			}
+
+			std::string
+			filename(const std::string& key) const;
+		};
+	}
+}
@@ -27,33 +27,56 @@ namespace minko
 	{
 		class ProgramSignature
 		{
-		private:
-			static const uint	MAX_NUM_BINDINGS;
+		public:
+			static const uint MAX_NUM_BINDINGS = 32;
+
+			typedef std::array<int, MAX_NUM_BINDINGS> Values;
 
+		private:
 			uint				_mask;
-			std::vector<int>	_values;
+			Values				_values;
+			uint64_t			_hash;
 
 		public:
 			inline
 			ProgramSignature():
 				_mask(0),
-				_values(MAX_NUM_BINDINGS, 0)
+				_values(),
+				_hash(0)
+			{
+				_values.fill(0);
+				updateHash();
+			}
+
+			inline
+			ProgramSignature(uint mask, const std::vector<int>& values):
+				_mask(mask),
+				_values(),
+				_hash(0)
 			{
+				_values.fill(0);
+				std::copy(values.begin(), values.begin() + std::min<std::size_t>(values.size(), MAX_NUM_BINDINGS), _values.begin());
+				updateHash();
 			}
-			
+
+			// the defines are only generated when a pointer is given, ie. when the variant must be compiled
 			void
 			build(std::shared_ptr<render::Pass>			pass,
 				  std::shared_ptr<render::DrawCall>		drawCall,
 				  std::shared_ptr<data::Container>		targetData,
 				  std::shared_ptr<data::Container>		rendererData,
 				  std::shared_ptr<data::Container>		rootData,
-				  std::string&							defines,
+				  std::string*							defines,
 				  std::list<data::ContainerProperty>&	booleanMacros,
 				  std::list<data::ContainerProperty>&	integerMacros,
 				  std::list<data::ContainerProperty>&	incorrectIntegerMacros);
 
-			bool 
-			operator==(const ProgramSignature&) const;
+			inline
+			bool
+			operator==(const ProgramSignature& x) const
+			{
+				return _hash == x._hash && _mask == x._mask && _values == x._values;
+			}
 
 			inline
 			uint
@@ -63,11 +86,22 @@ namespace minko
 			}
 
 			inline
-			const std::vector<int>&
+			const Values&
 			values() const
 			{
 				return _values;
 			}
+
+			inline
+			uint64_t
+			hash() const
+			{
+				return _hash;
+			}
+
+		private:
+			void
+			updateHash();
 		};
 	}
 }
@@ -80,18 +114,7 @@ namespace std
 		size_t 
 		operator()(const minko::render::ProgramSignature& x) const
 		{
-			size_t seed = std::hash<minko::uint>()(x.mask());
-
-			for (unsigned int i=0; i < x.values().size(); ++i)
-			{
-				const int value = (x.mask() >> i) != 0 
-					? x.values()[i]
-					: 0;
-
-				hash_combine(seed, value);
-			}
-
-			return seed;
+			return static_cast<size_t>(x.hash());
 		}
 	};
 }
@@ -0,0 +1,175 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+	namespace render
+	{
+		// named passes declaring the render targets they read and the one they write: passes that do not
+		// contribute to an output are culled, transient targets are shared through a RenderTargetPool by
+		// the passes whose lifetimes do not overlap and consecutive passes writing the same target are merged
+		class RenderGraph :
+			public std::enable_shared_from_this<RenderGraph>
+		{
+		public:
+			typedef std::shared_ptr<RenderGraph>								Ptr;
+
+		private:
+			typedef std::shared_ptr<AbstractContext>							AbstractContextPtr;
+			typedef std::shared_ptr<Texture>									TexturePtr;
+			typedef std::shared_ptr<Effect>										EffectPtr;
+			typedef std::shared_ptr<RenderTargetPool>							RenderTargetPoolPtr;
+			typedef std::shared_ptr<component::Renderer>						RendererPtr;
+
+		public:
+			// the target is nullptr for the back buffer, a merged pass must not clear it
+			typedef std::function<void(Ptr graph, TexturePtr target, bool clear)>	ExecuteFunction;
+
+			static const std::string											BACK_BUFFER;
+
+		private:
+			struct Resource
+			{
+				uint		width;
+				uint		height;
+				TexturePtr	texture;
+				bool		transient;
+				bool		output;
+			};
+
+			struct RenderPass
+			{
+				std::string					name;
+				std::vector<std::string>	reads;
+				std::string					write;
+				ExecuteFunction				execute;
+			};
+
+			struct CompiledPass
+			{
+				uint						pass;
+				bool						clear;
+				bool						merged;
+				// transient targets which are not used anymore once the pass is executed
+				std::vector<std::string>	released;
+			};
+
+			AbstractContextPtr													_context;
+			RenderTargetPoolPtr													_pool;
+			std::unordered_map<std::string, Resource>							_resources;
+			std::vector<RenderPass>												_passes;
+			bool																_compiled;
+			std::vector<CompiledPass>											_compiledPasses;
+
+		public:
+			inline static
+			Ptr
+			create(AbstractContextPtr context)
+			{
+				if (!context)
+					throw std::invalid_argument("context");
+
+				return std::shared_ptr<RenderGraph>(new RenderGraph(context));
+			}
+
+			// a render target allocated from the pool only while the passes using it are executed
+			Ptr
+			transientTexture(const std::string& name, uint width, uint height);
+
+			// a render target owned by the caller, the passes writing it are never culled
+			Ptr
+			importTexture(const std::string& name, TexturePtr texture);
+
+			// keeps a transient render target until the next execution for it to be read outside of the graph
+			Ptr
+			output(const std::string& name);
+
+			Ptr
+			addPass(const std::string&				name,
+					const std::vector<std::string>&	reads,
+					const std::string&				write,
+					const ExecuteFunction&			execute);
+
+			// renders the scene of a renderer, which is disabled for the scene manager not to render it again
+			Ptr
+			addPass(const std::string&				name,
+					RendererPtr						renderer,
+					const std::vector<std::string>&	reads,
+					const std::string&				write);
+
+			// renders a full-screen quad with the effect, each of its texture uniforms is set to the render
+			// target it is mapped to before the pass is executed
+			Ptr
+			addPass(const std::string&							name,
+					EffectPtr									effect,
+					const std::map<std::string, std::string>&	uniformToTexture,
+					const std::string&							write);
+
+			Ptr
+			removePass(const std::string& name);
+
+			inline
+			uint
+			numPasses() const
+			{
+				return _passes.size();
+			}
+
+			uint
+			numExecutedPasses();
+
+			uint
+			numMergedPasses();
+
+			bool
+			culled(const std::string& passName);
+
+			inline
+			RenderTargetPoolPtr
+			pool() const
+			{
+				return _pool;
+			}
+
+			// the render target behind a resource, transient ones are only available to the passes using them
+			TexturePtr
+			texture(const std::string& name) const;
+
+			void
+			compile();
+
+			void
+			execute();
+
+		private:
+			RenderGraph(AbstractContextPtr context);
+
+			void
+			addResource(const std::string& name, const Resource& resource);
+
+			const Resource&
+			resource(const std::string& name) const;
+		};
+	}
+}
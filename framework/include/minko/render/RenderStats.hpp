@@ -0,0 +1,73 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+	namespace render
+	{
+		// GL calls actually issued by a context, the redundant state changes it filters out are not counted;
+		// the counters only grow: the stats of a frame are the difference between two snapshots
+		struct RenderStats
+		{
+			uint				numDrawCalls;
+			unsigned long long	numTriangles;
+			uint				numProgramSwitches;
+			uint				numTextureBinds;
+			uint				numBufferBinds;
+			uint				numUniformCalls;
+			uint				numFrameBufferSwitches;
+			unsigned long long	numBytesUploaded; // vertices, indices and textures
+
+			RenderStats() :
+				numDrawCalls(0),
+				numTriangles(0),
+				numProgramSwitches(0),
+				numTextureBinds(0),
+				numBufferBinds(0),
+				numUniformCalls(0),
+				numFrameBufferSwitches(0),
+				numBytesUploaded(0)
+			{
+			}
+
+			inline
+			RenderStats
+			operator-(const RenderStats& value) const
+			{
+				RenderStats stats;
+
+				stats.numDrawCalls = numDrawCalls - value.numDrawCalls;
+				stats.numTriangles = numTriangles - value.numTriangles;
+				stats.numProgramSwitches = numProgramSwitches - value.numProgramSwitches;
+				stats.numTextureBinds = numTextureBinds - value.numTextureBinds;
+				stats.numBufferBinds = numBufferBinds - value.numBufferBinds;
+				stats.numUniformCalls = numUniformCalls - value.numUniformCalls;
+				stats.numFrameBufferSwitches = numFrameBufferSwitches - value.numFrameBufferSwitches;
+				stats.numBytesUploaded = numBytesUploaded - value.numBytesUploaded;
+
+				return stats;
+			}
+		};
+	}
+}
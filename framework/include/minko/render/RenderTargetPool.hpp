@@ -0,0 +1,87 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+	namespace render
+	{
+		// transient render targets (post-processing, shadow maps...) valid until the next call to nextFrame(),
+		// after which they are reused by the acquisitions of the same size
+		class RenderTargetPool :
+			public std::enable_shared_from_this<RenderTargetPool>
+		{
+		public:
+			typedef std::shared_ptr<RenderTargetPool>	Ptr;
+
+		private:
+			typedef std::shared_ptr<AbstractContext>	AbstractContextPtr;
+			typedef std::shared_ptr<Texture>			TexturePtr;
+			typedef std::pair<TexturePtr, uint>			TextureAndFrame;
+
+		private:
+			AbstractContextPtr										_context;
+			uint													_maxUnusedFrames;
+			uint													_frameId;
+			std::unordered_map<uint64_t, std::list<TextureAndFrame>>	_available;
+			std::list<std::pair<uint64_t, TexturePtr>>				_acquired;
+
+		public:
+			inline static
+			Ptr
+			create(AbstractContextPtr context, uint maxUnusedFrames = 2)
+			{
+				if (!context)
+					throw std::invalid_argument("context");
+
+				return std::shared_ptr<RenderTargetPool>(new RenderTargetPool(context, maxUnusedFrames));
+			}
+
+			inline
+			uint
+			numAcquired() const
+			{
+				return _acquired.size();
+			}
+
+			uint
+			numAvailable() const;
+
+			TexturePtr
+			acquire(uint width, uint height);
+
+			// gives back a render target before the end of the frame so that it can be acquired again
+			void
+			release(TexturePtr texture);
+
+			// releases the render targets acquired during the frame and disposes the ones unused for too long
+			void
+			nextFrame();
+
+			void
+			clear();
+
+		private:
+			RenderTargetPool(AbstractContextPtr context, uint maxUnusedFrames);
+		};
+	}
+}
@@ -0,0 +1,126 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include "minko/render/Shader.hpp"
+
+namespace minko
+{
+	namespace render
+	{
+		// rewrites preprocessed GLSL sources before they are compiled: conditional blocks known from
+		// the defines of the variant, unused functions and uniforms are removed, a default float
+		// precision is declared for fragment shaders lacking one and the code is minified
+		class ShaderOptimizer
+		{
+		public:
+			typedef std::shared_ptr<ShaderOptimizer>	Ptr;
+
+		private:
+			bool		_stripDeadCode;
+			bool		_stripUnusedUniforms;
+			bool		_minify;
+			std::string	_defaultPrecision;
+
+		public:
+			inline static
+			Ptr
+			create()
+			{
+				return std::shared_ptr<ShaderOptimizer>(new ShaderOptimizer());
+			}
+
+			inline
+			bool
+			stripDeadCode() const
+			{
+				return _stripDeadCode;
+			}
+
+			inline
+			void
+			stripDeadCode(bool value)
+			{
+				_stripDeadCode = value;
+			}
+
+			inline
+			bool
+			stripUnusedUniforms() const
+			{
+				return _stripUnusedUniforms;
+			}
+
+			inline
+			void
+			stripUnusedUniforms(bool value)
+			{
+				_stripUnusedUniforms = value;
+			}
+
+			inline
+			bool
+			minify() const
+			{
+				return _minify;
+			}
+
+			inline
+			void
+			minify(bool value)
+			{
+				_minify = value;
+			}
+
+			// "lowp", "mediump" or "highp", empty not to declare any
+			inline
+			const std::string&
+			defaultPrecision() const
+			{
+				return _defaultPrecision;
+			}
+
+			inline
+			void
+			defaultPrecision(const std::string& value)
+			{
+				if (!value.empty() && value != "lowp" && value != "mediump" && value != "highp")
+					throw std::invalid_argument("value");
+
+				_defaultPrecision = value;
+			}
+
+			std::string
+			optimize(const std::string& source, Shader::Type type) const;
+
+		private:
+			ShaderOptimizer() :
+				_stripDeadCode(true),
+				_stripUnusedUniforms(true),
+				_minify(true),
+				_defaultPrecision("mediump")
+			{
+			}
+		};
+	}
+}
@@ -28,16 +28,19 @@ namespace minko
 	namespace render
 	{
 		class Texture :
-			public AbstractTexture
+			public AbstractTexture,
+			public std::enable_shared_from_this<Texture>
 		{
 		public:
 			typedef std::shared_ptr<Texture>			Ptr;
 
 		private:
 			typedef std::shared_ptr<AbstractContext>	AbstractContextPtr;
+			typedef std::shared_ptr<UploadThread>		UploadThreadPtr;
 
 		private:
 			std::vector<unsigned char>	_data;
+			TextureFormat				_format; // RGBA unless compressed data was set
 		
 		public:
 			inline static
@@ -63,6 +66,13 @@ namespace minko
 				);
 			}
 
+			inline
+			TextureFormat
+			format() const
+			{
+				return _format;
+			}
+
 			std::vector<unsigned char>&
 			data()
 			{
@@ -81,6 +91,18 @@ namespace minko
 				 int			widthGPU	= -1,
 				 int			heightGPU	= -1);
 
+			// takes the RGBA pixels of a width() x height() image, rgba is left empty: the pixels decoded by a
+			// worker are not copied again on the main thread unless they have to be resized
+			void
+			data(std::vector<unsigned char>& rgba);
+
+			inline
+			void
+			data(std::vector<unsigned char>&& rgba)
+			{
+				data(rgba);
+			}
+
 			void
 			dispose();
 
@@ -90,6 +112,24 @@ namespace minko
 			void
 			upload();
 
+			// uploads the pixels from the upload thread when there is one and the texture was never uploaded, the
+			// data must not be changed and the texture must not be used to render until complete is executed
+			void
+			uploadAsync(UploadThreadPtr uploadThread, std::function<void()> complete = nullptr);
+
+			// the GPU memory can be released only if the texture can be uploaded again from its data
+			bool
+			evictable() const;
+
+			// releases the GPU memory but keeps the same id, upload() restores the texture
+			void
+			evict();
+
+			// allocates the same storage in the new context so that the texture can be bound at once,
+			// upload() restores its pixels
+			void
+			contextRestored();
+
 			void
 			uploadMipLevel(uint				level,
 						   unsigned char*	data);
@@ -100,6 +140,9 @@ namespace minko
 			}
 
 		private:
+			void
+			allocate();
+
 			Texture(AbstractContextPtr	context,
 					unsigned int		width,
 					unsigned int		height,
@@ -0,0 +1,108 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+	namespace render
+	{
+		// packs small RGBA textures into a single one so that the surfaces using them can share a texture
+		// binding (and a material once their UVs are remapped): each texture keeps its UV rect in the atlas
+		class TextureAtlas :
+			public std::enable_shared_from_this<TextureAtlas>
+		{
+		public:
+			typedef std::shared_ptr<TextureAtlas>		Ptr;
+
+		private:
+			typedef std::shared_ptr<AbstractContext>	AbstractContextPtr;
+			typedef std::shared_ptr<Texture>			TexturePtr;
+			typedef std::shared_ptr<math::Vector4>		Vector4Ptr;
+			typedef std::shared_ptr<geometry::Geometry>	GeometryPtr;
+
+		private:
+			AbstractContextPtr							_context;
+			uint										_width;
+			uint										_height;
+			uint										_padding;
+			std::vector<TexturePtr>						_textures;
+			std::unordered_map<TexturePtr, Vector4Ptr>	_uvRects;
+			TexturePtr									_texture;
+
+		public:
+			inline static
+			Ptr
+			create(AbstractContextPtr	context,
+				   uint					width	= 1024,
+				   uint					height	= 1024,
+				   uint					padding	= 2)
+			{
+				if (!context)
+					throw std::invalid_argument("context");
+
+				return std::shared_ptr<TextureAtlas>(new TextureAtlas(context, width, height, padding));
+			}
+
+			// the pixels of the texture must still be available, textures are packed by build()
+			Ptr
+			add(TexturePtr texture);
+
+			inline
+			uint
+			numTextures() const
+			{
+				return _textures.size();
+			}
+
+			// packs all the added textures in a new texture, false when they do not fit
+			bool
+			build();
+
+			inline
+			TexturePtr
+			texture() const
+			{
+				return _texture;
+			}
+
+			inline
+			bool
+			hasTexture(TexturePtr texture) const
+			{
+				return _uvRects.count(texture) != 0;
+			}
+
+			// offset (x, y) and scale (z, w) of the UVs of a packed texture inside the atlas
+			Vector4Ptr
+			uvRect(TexturePtr texture) const;
+
+			// rewrites the UVs of a geometry mapped to a packed texture to sample it in the atlas:
+			// repeated UVs (out of [0, 1]) cannot be remapped
+			void
+			remapUVs(GeometryPtr geometry, TexturePtr texture, const std::string& attributeName = "uv") const;
+
+		private:
+			TextureAtlas(AbstractContextPtr context, uint width, uint height, uint padding);
+		};
+	}
+}
@@ -0,0 +1,119 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include "minko/Signal.hpp"
+#include "minko/component/JobManager.hpp"
+
+namespace minko
+{
+	namespace render
+	{
+		// uploads precomputed mipmaps from the lowest to the highest resolution within a per-frame budget
+		class TextureStreamer :
+			public component::JobManager::Job,
+			public std::enable_shared_from_this<TextureStreamer>
+		{
+		public:
+			typedef std::shared_ptr<TextureStreamer>	Ptr;
+
+		private:
+			typedef std::shared_ptr<Texture>			TexturePtr;
+
+			struct MipLevel
+			{
+				TexturePtr					texture;
+				uint						level;
+				std::vector<unsigned char>	data;
+			};
+
+		private:
+			uint								_bytesPerFrame;
+			uint								_frameBytes;
+			std::multimap<uint, MipLevel>		_levels; // smallest first
+
+			Signal<Ptr, TexturePtr>::Ptr		_textureStreamed;
+
+		public:
+			inline static
+			Ptr
+			create(uint bytesPerFrame = 1 << 20)
+			{
+				return std::shared_ptr<TextureStreamer>(new TextureStreamer(bytesPerFrame));
+			}
+
+			inline
+			uint
+			bytesPerFrame() const
+			{
+				return _bytesPerFrame;
+			}
+
+			inline
+			void
+			bytesPerFrame(uint value)
+			{
+				_bytesPerFrame = value;
+			}
+
+			inline
+			uint
+			numPendingLevels() const
+			{
+				return _levels.size();
+			}
+
+			// executed once level 0 of a texture is uploaded
+			inline
+			Signal<Ptr, TexturePtr>::Ptr
+			textureStreamed() const
+			{
+				return _textureStreamed;
+			}
+
+			// levels[i] holds mip level i in the format of the texture, the data is moved into the streamer
+			void
+			stream(TexturePtr texture, std::vector<std::vector<unsigned char>>& levels);
+
+			bool
+			complete();
+
+			void
+			beforeFirstStep();
+
+			void
+			step();
+
+			float
+			priority();
+
+			bool
+			yieldFrame();
+
+			void
+			afterLastStep();
+
+		private:
+			TextureStreamer(uint bytesPerFrame);
+		};
+	}
+}
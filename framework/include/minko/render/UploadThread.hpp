@@ -0,0 +1,122 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include <mutex>
+#include <condition_variable>
+
+namespace minko
+{
+	namespace render
+	{
+		// uploads textures and buffers from a thread whose GL context shares its objects with the one used to
+		// render, created by the canvas when the platform allows it (see AbstractCanvas::uploadThread()): the
+		// completion callbacks are executed by update() on the render thread once the GPU executed the upload,
+		// the texture or buffer must not be used to render before that
+		class UploadThread
+		{
+		public:
+			typedef std::shared_ptr<UploadThread>	Ptr;
+			typedef std::function<void()>			ContextFunction;
+
+		private:
+			struct Upload
+			{
+				std::function<void()>	transfer;
+				std::function<void()>	complete;
+				void*					fence;
+			};
+
+		private:
+			bool									_fencesSupported;
+			ContextFunction							_makeCurrent;
+			ContextFunction							_releaseCurrent;
+			std::thread								_thread;
+			std::mutex								_mutex;
+			std::condition_variable					_wakeUp;
+			bool									_stopping;
+			std::list<Upload>						_queued;
+			std::list<Upload>						_transferred;
+			// only accessed by the render thread
+			std::list<Upload>						_pending;
+			uint									_numUploads;
+
+		public:
+			// makeCurrent and releaseCurrent are executed by the upload thread when it starts and stops
+			inline static
+			Ptr
+			create(std::shared_ptr<AbstractContext>	context,
+				   ContextFunction					makeCurrent,
+				   ContextFunction					releaseCurrent)
+			{
+				if (!context)
+					throw std::invalid_argument("context");
+
+				return std::shared_ptr<UploadThread>(new UploadThread(context, makeCurrent, releaseCurrent));
+			}
+
+			~UploadThread();
+
+			// uploads queued, transferred or waiting for the GPU
+			inline
+			uint
+			numPendingUploads() const
+			{
+				return _numUploads;
+			}
+
+			// the data must remain valid and unchanged until complete is executed
+			void
+			uploadTexture2dData(uint					texture,
+								uint					width,
+								uint					height,
+								uint					mipLevel,
+								const void*				data,
+								bool					generateMipmaps,
+								std::function<void()>	complete);
+
+			// offset and size are in bytes
+			void
+			uploadBufferData(bool					indices,
+							 uint					buffer,
+							 uint					offset,
+							 uint					size,
+							 const void*			data,
+							 std::function<void()>	complete);
+
+			// executes the completion callbacks of the uploads the GPU is done with, in their order
+			void
+			update();
+
+		private:
+			UploadThread(std::shared_ptr<AbstractContext>	context,
+						 ContextFunction					makeCurrent,
+						 ContextFunction					releaseCurrent);
+
+			void
+			queue(std::function<void()> transfer, std::function<void()> complete);
+
+			void
+			run();
+		};
+	}
+}
@@ -22,6 +22,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/Common.hpp"
 
 #include "minko/render/AbstractResource.hpp"
+#include "minko/render/VertexAttributeType.hpp"
+#include "minko/render/BufferUsage.hpp"
 #include "minko/math/Convertible.hpp"
 
 namespace minko
@@ -43,10 +45,20 @@ namespace minko
 			std::vector<float>					_data;
 			std::list<AttributePtr>				_attributes;
 			uint								_vertexSize;
+			std::unordered_map<std::string, VertexAttributeType>	_attributeTypes; // non float attributes only
+			std::unordered_map<std::string, uint>	_gpuAttributeOffsets; // empty unless some attributes are packed
+			uint								_gpuVertexSize;
+			uint								_gpuSize;
+			BufferUsage							_usage;
+			uint								_dirtyBegin; // first modified vertex
+			uint								_dirtyEnd;
 			Vector3Ptr							_minPosition;
 			Vector3Ptr							_maxPosition;
+			uint								_numDisposedVertices; // uploaded before disposeData()
+			uint								_capacity; // vertices the GPU buffer is allocated for, see reserve()
 
 			std::shared_ptr<Signal<Ptr, int>>	_vertexSizeChanged;
+			std::shared_ptr<Signal<Ptr>>		_dataChanged;
 
 		public:
 			~VertexBuffer()
@@ -101,6 +113,15 @@ namespace minko
 				return create(context, data.begin(), data.end());
 			}
 
+			// the vertices are moved into the buffer instead of being copied
+			inline static
+			Ptr
+			create(std::shared_ptr<render::AbstractContext>	context,
+				   std::vector<float>&&						data)
+			{
+				return std::shared_ptr<VertexBuffer>(new VertexBuffer(context, std::move(data)));
+			}
+
 			inline
 			std::vector<float>&
 			data()
@@ -122,6 +143,20 @@ namespace minko
 				return _vertexSize;
 			}
 
+			// size in 4 bytes words of a vertex on the GPU, equal to vertexSize() unless some attributes are packed
+			inline
+			uint
+			gpuVertexSize() const
+			{
+				return _gpuVertexSize;
+			}
+
+			uint
+			gpuAttributeOffset(const std::string& attributeName) const;
+
+			VertexAttributeType
+			attributeType(const std::string& attributeName) const;
+
 			inline
 			std::shared_ptr<Signal<Ptr, int>>
 			vertexSizeChanged()
@@ -129,11 +164,55 @@ namespace minko
 				return _vertexSizeChanged;
 			}
 
+			// executed when the data is uploaded after having been modified
+			inline
+			std::shared_ptr<Signal<Ptr>>
+			dataChanged()
+			{
+				return _dataChanged;
+			}
+
 			inline
 			uint
 			numVertices() const
 			{
-				return _vertexSize > 0 ? _data.size() / _vertexSize : 0;
+				if (_vertexSize == 0)
+					return 0;
+
+				return _data.empty() ? _numDisposedVertices : _data.size() / _vertexSize;
+			}
+
+			inline
+			bool
+			dataDisposed() const
+			{
+				return _data.empty() && _numDisposedVertices != 0;
+			}
+
+			inline
+			BufferUsage
+			usage() const
+			{
+				return _usage;
+			}
+
+			void
+			usage(BufferUsage value);
+
+			inline
+			uint
+			capacity() const
+			{
+				return _capacity;
+			}
+
+			// allocates the GPU buffer for at least numVertices on the next upload, so that vertices can be
+			// appended and uploaded with upload(offset, numVertices) without re-creating it
+			inline
+			void
+			reserve(uint numVertices)
+			{
+				_capacity = numVertices;
 			}
 
 			inline
@@ -143,14 +222,40 @@ namespace minko
 				upload(0, 0);
 			}
 
+			// marks vertices as modified, uploadDirty() uploads the span covering all of them
+			void
+			markDirty(uint offset, uint numVertices);
+
+			void
+			uploadDirty();
+
 			void
 			upload(uint offset, uint numVertices = 0);
 
+			// uploads all the vertices from the upload thread when there is one, the data must not be changed and
+			// the buffer must not be used to render until complete is executed
+			void
+			uploadAsync(std::shared_ptr<UploadThread> uploadThread, std::function<void()> complete = nullptr);
+
 			void
 			dispose();
 
+			// frees the CPU-side copy of the uploaded vertices, the position bounds are computed beforehand and
+			// kept, the vertices have to be set again in data() before any other upload
+			void
+			disposeData();
+
+			// allocates a buffer of the same size in the new context so that it can be bound at once, upload()
+			// restores the vertices
 			void
-			addAttribute(const std::string& name, const unsigned int size, const unsigned int offset = 0);
+			contextRestored();
+
+			// types the context does not support fall back to FLOAT
+			void
+			addAttribute(const std::string&		name,
+						 const unsigned int		size,
+						 const unsigned int		offset	= 0,
+						 VertexAttributeType	type	= VertexAttributeType::FLOAT);
 
 			void
 			removeAttribute(const std::string& name);
@@ -192,9 +297,22 @@ namespace minko
 						 float*										begin,
 						 float*										end);
 
+			VertexBuffer(std::shared_ptr<render::AbstractContext>	context,
+						 std::vector<float>&&						data);
+
 			void
 			vertexSize(unsigned int value);
 
+			void
+			updateGPULayout();
+
+			// (re-)creates the GPU buffer if needed, returns true when it was created
+			bool
+			allocate();
+
+			void
+			uploadPacked(uint offset, uint numVertices);
+
 			void
 			invalidatePositionBounds();
 
@@ -22,6 +22,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/Common.hpp"
 #include "minko/Signal.hpp"
 
+#include <atomic>
+
 namespace minko
 {
 	namespace scene
@@ -40,13 +42,15 @@ namespace minko
 			std::vector<Ptr>								_children;
 
 		private:
-			static unsigned int								_id;
+			static std::atomic<unsigned int>				_id;
 
 			uint											_layouts;
 			Ptr 											_root;
 			Ptr												_parent;
 			std::shared_ptr<data::Container>				_container;
 			std::list<AbsCtrlPtr>							_components;
+			// components matching each queried type, filled lazily and cleared on add/remove
+			std::unordered_map<std::type_index, std::vector<std::shared_ptr<void>>>	_typeToComponents;
 
 			uint											_depth;
 
@@ -231,15 +235,12 @@ namespace minko
 			std::vector<std::shared_ptr<T>>
 			components()
 			{
+				const auto& typedComponents = componentsOfType<T>();
 				std::vector<std::shared_ptr<T>> result;
 
-				for (auto component : _components)
-				{
-					std::shared_ptr<T> typedComponent = std::dynamic_pointer_cast<T>(component);
-
-					if (typedComponent != nullptr)
-						result.push_back(typedComponent);
-				}
+				result.reserve(typedComponents.size());
+				for (const auto& component : typedComponents)
+					result.push_back(std::static_pointer_cast<T>(component));
 
 				return result;
 			}
@@ -248,22 +249,11 @@ namespace minko
 			std::shared_ptr<T>
 			component(const unsigned int position = 0)
 			{
-				unsigned int counter = 0;
+				const auto& typedComponents = componentsOfType<T>();
 
-				for (auto component : _components)
-				{
-					std::shared_ptr<T> typedComponent = std::dynamic_pointer_cast<T>(component);
-
-					if (typedComponent != nullptr)
-					{
-						if (counter == position)
-							return typedComponent;
-						else
-							++counter;
-					}
-				}
-
-				return nullptr;
+				return position < typedComponents.size()
+					? std::static_pointer_cast<T>(typedComponents[position])
+					: nullptr;
 			}
 
 			virtual
@@ -276,6 +266,30 @@ namespace minko
 
 			void
 			updateRoot();
+
+		private:
+			template <typename T>
+			const std::vector<std::shared_ptr<void>>&
+			componentsOfType()
+			{
+				const std::type_index type(typeid(T));
+				auto it = _typeToComponents.find(type);
+
+				if (it != _typeToComponents.end())
+					return it->second;
+
+				auto& typedComponents = _typeToComponents[type];
+
+				for (const auto& component : _components)
+				{
+					std::shared_ptr<T> typedComponent = std::dynamic_pointer_cast<T>(component);
+
+					if (typedComponent != nullptr)
+						typedComponents.push_back(typedComponent);
+				}
+
+				return typedComponents;
+			}
 		};
 	}
 }
@@ -0,0 +1,105 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+	namespace scene
+	{
+		// recycles the instances of a prefab: a released instance keeps its signals, data container and
+		// components, only their state is reset when it is acquired again
+		class NodePool
+		{
+		public:
+			typedef std::shared_ptr<NodePool>	Ptr;
+
+		private:
+			typedef std::shared_ptr<Node>		NodePtr;
+
+		private:
+			std::shared_ptr<Prefab>				_prefab;
+			std::vector<NodePtr>				_freeNodes;
+			std::unordered_set<NodePtr>			_acquiredNodes;
+
+		public:
+			inline static
+			Ptr
+			create(std::shared_ptr<Prefab> prefab, uint capacity = 0)
+			{
+				if (!prefab)
+					throw std::invalid_argument("prefab");
+
+				auto pool = std::shared_ptr<NodePool>(new NodePool(prefab));
+
+				pool->reserve(capacity);
+
+				return pool;
+			}
+
+			inline
+			std::shared_ptr<Prefab>
+			prefab() const
+			{
+				return _prefab;
+			}
+
+			inline
+			uint
+			numFreeNodes() const
+			{
+				return _freeNodes.size();
+			}
+
+			inline
+			uint
+			numAcquiredNodes() const
+			{
+				return _acquiredNodes.size();
+			}
+
+			// instantiates the prefab until numNodes instances are free
+			void
+			reserve(uint numNodes);
+
+			NodePtr
+			acquire(NodePtr parent = nullptr);
+
+			// removes the instance from its parent and keeps it for the next acquire()
+			void
+			release(NodePtr node);
+
+			// lets the free instances be destroyed
+			inline
+			void
+			clear()
+			{
+				_freeNodes.clear();
+			}
+
+		private:
+			NodePool(std::shared_ptr<Prefab> prefab) :
+				_prefab(prefab)
+			{
+			}
+		};
+	}
+}
@@ -28,7 +28,8 @@ namespace minko
 		class NodeSet
 		{
 		public:
-			typedef std::shared_ptr<NodeSet> Ptr;
+			typedef std::shared_ptr<NodeSet>							Ptr;
+			typedef std::function<void(const std::shared_ptr<Node>&)>	Visitor;
 
 		private:
 			std::vector<std::shared_ptr<Node>> _nodes;
@@ -96,6 +97,15 @@ namespace minko
 			Ptr
 			roots(Ptr result = nullptr);
 
+			// calls visitor on each descendant of node, in the same order as descendants() but without
+			// building a set; the visitor may change components but must not add or remove nodes
+			static
+			void
+			visitDescendants(const std::shared_ptr<Node>&	node,
+							 const Visitor&					visitor,
+							 bool							andSelf		= false,
+							 bool							depthFirst	= true);
+
 		private:
 			NodeSet() :
 				_nodes()
@@ -0,0 +1,100 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+	namespace scene
+	{
+		// snapshot of a subtree, usually a symbol of the AssetLibrary, that can be instantiated many times;
+		// the instances share the geometries, materials and effects of the source
+		class Prefab :
+			public std::enable_shared_from_this<Prefab>
+		{
+		public:
+			typedef std::shared_ptr<Prefab>													Ptr;
+			typedef std::shared_ptr<component::AbstractComponent>							AbsCmpPtr;
+			typedef std::function<AbsCmpPtr(AbsCmpPtr)>										ComponentCloner;
+
+		private:
+			typedef std::shared_ptr<Node>													NodePtr;
+
+			// nodes of the source in depth first order, so a parent always comes before its children
+			struct Entry
+			{
+				int										parent;
+				std::string								name;
+				uint									layouts;
+				std::vector<AbsCmpPtr>					components;
+			};
+
+		private:
+			std::vector<Entry>								_entries;
+			uint											_numTransforms;
+			std::unordered_map<std::type_index, ComponentCloner>	_cloners;
+
+		public:
+			// the components without a cloner are not instantiated, Transform and Surface have one by default
+			static
+			Ptr
+			create(NodePtr source);
+
+			inline
+			uint
+			numNodes() const
+			{
+				return _entries.size();
+			}
+
+			template <typename T>
+			void
+			cloner(std::function<std::shared_ptr<T>(std::shared_ptr<T>)> func)
+			{
+				_cloners[std::type_index(typeid(T))] = [=](AbsCmpPtr component) -> AbsCmpPtr
+				{
+					return func(std::static_pointer_cast<T>(component));
+				};
+			}
+
+			NodePtr
+			instantiate();
+
+			// builds the instances as the children of a single node, then adds that node to parent in one go:
+			// surfaces are registered by a single batch and the transform slots are allocated ahead
+			NodePtr
+			instantiate(uint numInstances, NodePtr parent = nullptr);
+
+			// restores the names, layouts, matrices and visibilities of the source on an instance
+			void
+			reset(NodePtr instance);
+
+		private:
+			Prefab();
+
+			void
+			initialize(NodePtr source);
+
+			NodePtr
+			instantiate(NodePtr parent);
+		};
+	}
+}
@@ -20,6 +20,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/Common.hpp"
 
 #include "minko/AbstractCanvas.hpp"
+#include "minko/async/ThreadPool.hpp"
+#include "minko/FrameTimeHistogram.hpp"
 
 using namespace minko;
 
@@ -28,3 +30,21 @@ AbstractCanvas::_defaultCanvas;
 
 std::unordered_map<std::string, std::function<std::shared_ptr<async::Worker>()>>
 AbstractCanvas::_workers;
+
+std::shared_ptr<async::ThreadPool>
+AbstractCanvas::threadPool()
+{
+	if (!_threadPool)
+		_threadPool = async::ThreadPool::create();
+
+	return _threadPool;
+}
+
+std::shared_ptr<FrameTimeHistogram>
+AbstractCanvas::frameTimeHistogram()
+{
+	if (!_frameTimeHistogram)
+		_frameTimeHistogram = FrameTimeHistogram::create();
+
+	return _frameTimeHistogram;
+}
@@ -0,0 +1,79 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/FrameTimeHistogram.hpp"
+
+using namespace minko;
+
+FrameTimeHistogram::FrameTimeHistogram(float bucketWidth, uint numBuckets) :
+	_bucketWidth(bucketWidth),
+	_buckets(numBuckets, 0),
+	_numFrames(0),
+	_totalTime(0.f),
+	_minTime(0.f),
+	_maxTime(0.f)
+{
+}
+
+void
+FrameTimeHistogram::record(float frameTime)
+{
+	auto index = frameTime > 0.f ? (uint)(frameTime / _bucketWidth) : 0;
+
+	++_buckets[std::min(index, (uint)_buckets.size() - 1)];
+
+	_minTime = _numFrames ? std::min(_minTime, frameTime) : frameTime;
+	_maxTime = _numFrames ? std::max(_maxTime, frameTime) : frameTime;
+	_totalTime += frameTime;
+	++_numFrames;
+}
+
+float
+FrameTimeHistogram::percentile(float ratio) const
+{
+	if (ratio < 0.f || ratio > 1.f)
+		throw std::invalid_argument("ratio");
+
+	if (_numFrames == 0)
+		return 0.f;
+
+	auto threshold = std::max(1.f, ratio * (float)_numFrames);
+	auto numFrames = 0u;
+
+	for (uint i = 0; i < _buckets.size() - 1; ++i)
+	{
+		numFrames += _buckets[i];
+
+		if ((float)numFrames >= threshold)
+			return std::min((float)(i + 1) * _bucketWidth, _maxTime);
+	}
+
+	return _maxTime;
+}
+
+void
+FrameTimeHistogram::reset()
+{
+	std::fill(_buckets.begin(), _buckets.end(), 0);
+	_numFrames = 0;
+	_totalTime = 0.f;
+	_minTime = 0.f;
+	_maxTime = 0.f;
+}
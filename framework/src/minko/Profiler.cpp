@@ -0,0 +1,458 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#include "minko/Profiler.hpp"
+
+#include <mutex>
+#include <iomanip>
+
+#if defined(_MSC_VER)
+# define MINKO_PROFILER_THREAD_LOCAL	__declspec(thread)
+#else
+# define MINKO_PROFILER_THREAD_LOCAL	__thread
+#endif
+
+using namespace minko;
+
+struct ThreadBuffer
+{
+	uint												id;
+	std::mutex											mutex;
+	std::vector<Profiler::Event>						events;
+	uint												next;
+	uint												size;
+	// only touched by the thread of the buffer
+	std::vector<std::pair<const char*, unsigned long long>>	stack;
+};
+
+std::atomic<bool> Profiler::_enabled(false);
+
+static const uint DEFAULT_BUFFER_SIZE = 1 << 14;
+
+static std::mutex									registryMutex;
+static std::vector<std::shared_ptr<ThreadBuffer>>	registry;
+static uint											registryBufferSize = DEFAULT_BUFFER_SIZE;
+static std::unordered_set<std::string>				internedNames;
+static std::vector<Profiler::CounterSample>			counterSamples;
+static uint											nextCounterSample = 0;
+
+static MINKO_PROFILER_THREAD_LOCAL ThreadBuffer*	currentBuffer = nullptr;
+
+static
+unsigned long long
+now()
+{
+	static const auto epoch = std::chrono::steady_clock::now();
+
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+void
+Profiler::enabled(bool value)
+{
+	// starts the clock before the first scope
+	now();
+	_enabled = value;
+}
+
+#if defined(MINKO_PROFILE_STARTUP)
+// records from the static initialization of this file on, for startupReport()
+static struct StartupProfiling
+{
+	StartupProfiling()
+	{
+		Profiler::enabled(true);
+	}
+} startupProfiling;
+#endif
+
+uint
+Profiler::bufferSize()
+{
+	std::lock_guard<std::mutex> lock(registryMutex);
+
+	return registryBufferSize;
+}
+
+void
+Profiler::bufferSize(uint value)
+{
+	if (value == 0)
+		throw std::invalid_argument("value");
+
+	std::lock_guard<std::mutex> lock(registryMutex);
+
+	registryBufferSize = value;
+	counterSamples.clear();
+	nextCounterSample = 0;
+
+	for (auto& buffer : registry)
+	{
+		auto& threadBuffer = *buffer;
+		std::lock_guard<std::mutex> bufferLock(threadBuffer.mutex);
+
+		threadBuffer.events.assign(value, Profiler::Event());
+		threadBuffer.next = 0;
+		threadBuffer.size = 0;
+	}
+}
+
+static
+ThreadBuffer*
+createBuffer()
+{
+	auto buffer = std::make_shared<ThreadBuffer>();
+	std::lock_guard<std::mutex> lock(registryMutex);
+
+	// the buffers outlive their threads so that their events can still be exported
+	buffer->id = registry.size();
+	buffer->events.assign(registryBufferSize, Profiler::Event());
+	buffer->next = 0;
+	buffer->size = 0;
+	registry.push_back(buffer);
+
+	return buffer.get();
+}
+
+static
+ThreadBuffer&
+threadBuffer()
+{
+	if (!currentBuffer)
+		currentBuffer = createBuffer();
+
+	return *currentBuffer;
+}
+
+static
+ThreadBuffer&
+gpuBuffer()
+{
+	static ThreadBuffer* buffer = createBuffer();
+
+	return *buffer;
+}
+
+static
+void
+record(ThreadBuffer& buffer, const Profiler::Event& event)
+{
+	std::lock_guard<std::mutex> lock(buffer.mutex);
+	const auto capacity = (uint)buffer.events.size();
+
+	buffer.events[buffer.next] = event;
+	buffer.next = (buffer.next + 1) % capacity;
+	buffer.size = std::min(buffer.size + 1, capacity);
+}
+
+void
+Profiler::begin(const char* name)
+{
+	threadBuffer().stack.push_back(std::make_pair(name, now()));
+}
+
+void
+Profiler::end()
+{
+	auto		end		= now();
+	auto&		buffer	= threadBuffer();
+
+	if (buffer.stack.empty())
+		throw std::logic_error("Profiler::end() without a matching Profiler::begin().");
+
+	auto		scope	= buffer.stack.back();
+	Event		event;
+
+	buffer.stack.pop_back();
+	event.name = scope.first;
+	event.thread = buffer.id;
+	event.depth = buffer.stack.size();
+	event.start = scope.second;
+	event.duration = end - scope.second;
+
+	record(buffer, event);
+}
+
+unsigned long long
+Profiler::time()
+{
+	return now();
+}
+
+void
+Profiler::gpuEvent(const char* name, unsigned long long start, unsigned long long duration)
+{
+	auto&	buffer	= gpuBuffer();
+	Event	event;
+
+	event.name = name;
+	event.thread = buffer.id;
+	event.depth = 0;
+	event.start = start;
+	event.duration = duration;
+
+	record(buffer, event);
+}
+
+uint
+Profiler::gpuThread()
+{
+	return gpuBuffer().id;
+}
+
+void
+Profiler::counter(const char* name, unsigned long long value)
+{
+	CounterSample sample;
+
+	sample.name = name;
+	sample.time = now();
+	sample.value = value;
+
+	std::lock_guard<std::mutex> lock(registryMutex);
+
+	if (counterSamples.size() < registryBufferSize)
+		counterSamples.push_back(sample);
+	else
+		counterSamples[nextCounterSample] = sample;
+	nextCounterSample = (nextCounterSample + 1) % registryBufferSize;
+}
+
+std::vector<Profiler::CounterSample>
+Profiler::counters()
+{
+	std::vector<CounterSample> samples;
+
+	{
+		std::lock_guard<std::mutex> lock(registryMutex);
+
+		samples = counterSamples;
+	}
+
+	std::stable_sort(samples.begin(), samples.end(), [](const CounterSample& a, const CounterSample& b)
+	{
+		return a.time < b.time;
+	});
+
+	return samples;
+}
+
+const char*
+Profiler::intern(const std::string& name)
+{
+	std::lock_guard<std::mutex> lock(registryMutex);
+
+	return internedNames.insert(name).first->c_str();
+}
+
+std::vector<Profiler::Event>
+Profiler::events()
+{
+	std::vector<Event> events;
+	std::lock_guard<std::mutex> lock(registryMutex);
+
+	for (auto& buffer : registry)
+	{
+		auto& threadBuffer = *buffer;
+		std::lock_guard<std::mutex> bufferLock(threadBuffer.mutex);
+		const auto capacity = (uint)threadBuffer.events.size();
+		const auto first = (threadBuffer.next + capacity - threadBuffer.size) % capacity;
+
+		for (uint i = 0; i < threadBuffer.size; ++i)
+			events.push_back(threadBuffer.events[(first + i) % capacity]);
+	}
+
+	// the parents end after their children but start before them
+	std::stable_sort(events.begin(), events.end(), [](const Event& a, const Event& b)
+	{
+		return a.start < b.start || (a.start == b.start && a.depth < b.depth);
+	});
+
+	return events;
+}
+
+std::vector<Profiler::Event>
+Profiler::lastFrame(const std::string& frameScope)
+{
+	const auto	thread	= threadBuffer().id;
+	auto		events	= Profiler::events();
+	auto		frame	= events.end();
+
+	for (auto eventIt = events.begin(); eventIt != events.end(); ++eventIt)
+		if (eventIt->thread == thread && frameScope == eventIt->name)
+			frame = eventIt;
+
+	if (frame == events.end())
+		return std::vector<Event>();
+
+	std::vector<Event> frameEvents;
+	const auto frameEnd = frame->start + frame->duration;
+
+	for (auto eventIt = frame; eventIt != events.end() && eventIt->start <= frameEnd; ++eventIt)
+		if (eventIt->thread == thread && eventIt->depth >= frame->depth)
+			frameEvents.push_back(*eventIt);
+
+	return frameEvents;
+}
+
+std::vector<Profiler::Event>
+Profiler::startup(const std::string& frameScope)
+{
+	auto events = Profiler::events();
+	auto firstFrame = std::find_if(events.begin(), events.end(), [&](const Event& event)
+	{
+		return frameScope == event.name;
+	});
+
+	if (firstFrame == events.end())
+		return std::vector<Event>();
+
+	// the first frame is part of the startup
+	const auto firstFrameEnd = firstFrame->start + firstFrame->duration;
+	const auto gpu = gpuThread();
+
+	events.erase(
+		std::remove_if(events.begin(), events.end(), [&](const Event& event)
+		{
+			return event.start > firstFrameEnd || event.thread == gpu;
+		}),
+		events.end()
+	);
+
+	return events;
+}
+
+void
+Profiler::clear()
+{
+	std::lock_guard<std::mutex> lock(registryMutex);
+
+	for (auto& buffer : registry)
+	{
+		auto& threadBuffer = *buffer;
+		std::lock_guard<std::mutex> bufferLock(threadBuffer.mutex);
+
+		threadBuffer.next = 0;
+		threadBuffer.size = 0;
+	}
+
+	counterSamples.clear();
+	nextCounterSample = 0;
+}
+
+static
+void
+writeName(std::ostringstream& json, const char* name)
+{
+	for (auto c = name; *c; ++c)
+		if (*c == '"' || *c == '\\')
+			json << '\\' << *c;
+		else if ((unsigned char)*c >= 0x20)
+			json << *c;
+}
+
+std::string
+Profiler::exportChromeTrace()
+{
+	std::ostringstream json;
+	auto first = true;
+
+	json << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+
+	for (auto& event : events())
+	{
+		json << (first ? "" : ",") << "{\"name\":\"";
+		first = false;
+		writeName(json, event.name);
+
+		// Chrome expects microseconds
+		json << "\",\"cat\":\"minko\",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.thread
+			<< ",\"ts\":" << (double)event.start * 1e-3
+			<< ",\"dur\":" << (double)event.duration * 1e-3 << "}";
+	}
+
+	for (auto& sample : counters())
+	{
+		json << (first ? "" : ",") << "{\"name\":\"";
+		first = false;
+		writeName(json, sample.name);
+
+		json << "\",\"cat\":\"minko\",\"ph\":\"C\",\"pid\":0"
+			<< ",\"ts\":" << (double)sample.time * 1e-3
+			<< ",\"args\":{\"value\":" << sample.value << "}}";
+	}
+
+	json << "],\"displayTimeUnit\":\"ms\"}";
+
+	return json.str();
+}
+
+void
+Profiler::exportChromeTrace(const std::string& filename)
+{
+	std::ofstream file(filename.c_str(), std::ios::out | std::ios::binary);
+
+	if (!file.is_open())
+		throw std::invalid_argument("filename");
+
+	file << exportChromeTrace();
+}
+
+std::string
+Profiler::report(const std::string& frameScope)
+{
+	std::ostringstream report;
+	auto events = lastFrame(frameScope);
+
+	report << std::fixed << std::setprecision(3);
+
+	for (auto& event : events)
+		report << std::string((event.depth - events.front().depth) * 2, ' ')
+			<< event.name << " " << (double)event.duration * 1e-6 << " ms" << std::endl;
+
+	return report.str();
+}
+
+std::string
+Profiler::startupReport(const std::string& frameScope)
+{
+	std::ostringstream report;
+	auto events = startup(frameScope);
+
+	if (events.empty())
+		return "";
+
+	report << std::fixed << std::setprecision(3);
+
+	for (auto& event : events)
+		report << std::string(event.depth * 2, ' ') << event.name
+			<< (event.thread != events.front().thread ? " [thread " + std::to_string(event.thread) + "]" : "")
+			<< " " << (double)event.duration * 1e-6 << " ms" << std::endl;
+
+	unsigned long long end = 0;
+
+	for (auto& event : events)
+		end = std::max(end, event.start + event.duration);
+
+	report << "time to first frame " << (double)end * 1e-6 << " ms" << std::endl;
+
+	return report.str();
+}
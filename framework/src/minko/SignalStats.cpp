@@ -0,0 +1,170 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/SignalStats.hpp"
+
+#include "minko/Profiler.hpp"
+
+#include <mutex>
+#include <iomanip>
+
+#if defined(__GNUC__)
+# include <cxxabi.h>
+#endif
+
+using namespace minko;
+
+std::atomic<bool> SignalStats::_enabled(false);
+
+static std::mutex										statsMutex;
+static std::unordered_map<const char*, SignalStats::Entry>	currentFrame;
+static std::vector<SignalStats::Entry>					previousFrame;
+
+void
+SignalStats::enabled(bool value)
+{
+	_enabled = value;
+}
+
+void
+SignalStats::record(const char* name, uint numCallbacks, unsigned long long time)
+{
+	std::lock_guard<std::mutex> lock(statsMutex);
+	auto entryIt = currentFrame.find(name);
+
+	if (entryIt == currentFrame.end())
+	{
+		Entry entry;
+
+		entry.name = name;
+		entry.numExecutions = 0;
+		entry.numCallbacks = 0;
+		entry.time = 0;
+		entryIt = currentFrame.insert(std::make_pair(name, entry)).first;
+	}
+
+	auto& entry = entryIt->second;
+
+	++entry.numExecutions;
+	entry.numCallbacks += numCallbacks;
+	entry.time += time;
+}
+
+unsigned long long
+SignalStats::time()
+{
+	return Profiler::time();
+}
+
+void
+SignalStats::nextFrame()
+{
+	std::vector<Entry> frame;
+	unsigned long long numExecutions = 0;
+	unsigned long long numCallbacks = 0;
+
+	{
+		std::lock_guard<std::mutex> lock(statsMutex);
+
+		for (auto& nameAndEntry : currentFrame)
+			frame.push_back(nameAndEntry.second);
+		currentFrame.clear();
+	}
+
+	for (auto& entry : frame)
+	{
+		numExecutions += entry.numExecutions;
+		numCallbacks += entry.numCallbacks;
+	}
+
+	std::sort(frame.begin(), frame.end(), [](const Entry& a, const Entry& b)
+	{
+		return a.time > b.time || (a.time == b.time && a.numExecutions > b.numExecutions);
+	});
+
+	{
+		std::lock_guard<std::mutex> lock(statsMutex);
+
+		previousFrame.swap(frame);
+	}
+
+	if (Profiler::enabled())
+	{
+		Profiler::counter("numSignalExecutions", numExecutions);
+		Profiler::counter("numSignalCallbacks", numCallbacks);
+	}
+}
+
+std::vector<SignalStats::Entry>
+SignalStats::lastFrame()
+{
+	std::lock_guard<std::mutex> lock(statsMutex);
+
+	return previousFrame;
+}
+
+static
+std::string
+readableName(const char* name)
+{
+#if defined(__GNUC__)
+	// the unnamed signals are counted under the mangled name of their type
+	auto status = 0;
+	auto demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+
+	if (status == 0 && demangled)
+	{
+		std::string result(demangled);
+
+		free(demangled);
+
+		return result;
+	}
+#endif
+
+	return name;
+}
+
+std::string
+SignalStats::report(uint maxNumLines)
+{
+	std::ostringstream report;
+	auto entries = lastFrame();
+
+	report << std::fixed << std::setprecision(3);
+
+	for (uint i = 0; i < entries.size() && i < maxNumLines; ++i)
+	{
+		auto& entry = entries[i];
+
+		report << (entry.time * 1e-6) << " ms\t" << entry.numExecutions << " executions\t"
+			<< entry.numCallbacks << " callbacks\t" << readableName(entry.name) << std::endl;
+	}
+
+	return report.str();
+}
+
+void
+SignalStats::clear()
+{
+	std::lock_guard<std::mutex> lock(statsMutex);
+
+	currentFrame.clear();
+	previousFrame.clear();
+}
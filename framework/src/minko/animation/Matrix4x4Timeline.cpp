@@ -20,6 +20,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/animation/Matrix4x4Timeline.hpp"
 #include "minko/data/Container.hpp"
 #include "minko/math/Matrix4x4.hpp"
+#include "minko/math/Quaternion.hpp"
 #include "timeline_lookup.hpp"
 
 using namespace minko;
@@ -34,7 +35,10 @@ Matrix4x4Timeline::Matrix4x4Timeline(const std::string& propertyName,
 									 bool interpolate):
 	AbstractTimeline(propertyName, duration),
 	_matrices(),
-	_interpolate(interpolate)
+	_interpolate(interpolate),
+	_keyRotations(),
+	_keyUpperTriangulars(),
+	_keyCursor(0)
 {
 	initializeMatrixTimetable(timetable, matrices);
 }
@@ -61,6 +65,23 @@ Matrix4x4Timeline::initializeMatrixTimetable(const std::vector<uint>& timetable,
 	}
 
 	std::sort(_matrices.begin(), _matrices.end());
+
+	// keys are decomposed once so that interpolating only has to slerp and lerp
+	auto rotation	= Quaternion::create();
+	auto matrixR	= Matrix4x4::create();
+
+	_keyRotations.resize(numKeys << 2);
+	_keyUpperTriangulars.resize(numKeys << 4);
+	for (uint keyId = 0; keyId < numKeys; ++keyId)
+	{
+		_matrices[keyId].second->decomposeQR(rotation, matrixR);
+
+		_keyRotations[(keyId << 2)]		= rotation->i();
+		_keyRotations[(keyId << 2) + 1]	= rotation->j();
+		_keyRotations[(keyId << 2) + 2]	= rotation->k();
+		_keyRotations[(keyId << 2) + 3]	= rotation->r();
+		std::copy(matrixR->data().begin(), matrixR->data().end(), _keyUpperTriangulars.begin() + (keyId << 4));
+	}
 }
 
 void
@@ -79,30 +100,42 @@ Matrix4x4Timeline::update(uint time,
 	if (matrix == nullptr)
 		return;
 
-    if (_interpolate)
-        matrix = interpolate(time, matrix);
-    else
-    {
-        const uint	t		= getTimeInRange(time, _duration + 1);
-	    const uint	keyId	= getIndexForTime(t, _matrices);
+	float values[16];
 
-   		matrix->copyFrom(_matrices[keyId].second);
-    }
+	evaluate(time, values, _keyCursor);
+	matrix->setRaw(values);
 }
 
 Matrix4x4::Ptr
 Matrix4x4Timeline::interpolate(uint             time, 
                                Matrix4x4::Ptr   output) const
 {
-    const uint	t		= getTimeInRange(time, _duration + 1);
-	const uint	keyId	= getIndexForTime(t, _matrices);
+    float values[16];
+
+    evaluate(time, true, values, _keyCursor);
 
     if (output == nullptr)
         output = Matrix4x4::create();
 
+    return output->setRaw(values);
+}
+
+void
+Matrix4x4Timeline::evaluate(uint	time,
+							bool	interpolate,
+							float*	output,
+							uint&	keyCursor) const
+{
+    const uint	t		= getTimeInRange(time, _duration + 1);
+	const uint	keyId	= getIndexForTime(t, _matrices, keyCursor);
+
     // all matrices are sorted in order of increasing time
-    if (t < _matrices.front().first || t >= _matrices.back().first)
-        output->copyFrom(_matrices[keyId].second);
+    if (!interpolate || t < _matrices.front().first || t >= _matrices.back().first)
+    {
+        const auto& values = _matrices[keyId].second->data();
+
+        std::copy(values.begin(), values.end(), output);
+    }
     else
     {
 		assert(keyId + 1 < (int)_matrices.size());
@@ -114,10 +147,13 @@ Matrix4x4Timeline::interpolate(uint             time,
 			? (t - current.first) / (float)(next.first - current.first)
 			: 0.0f;
 
-		output
-			->copyFrom(current.second)
-			->interpolateTo(next.second, ratio);
-    }
+		// same as Matrix4x4::interpolateTo, on the decompositions computed at creation
+		float rotation[4];
+		float matrixQ[16];
 
-    return output;
-}
\ No newline at end of file
+		Quaternion::slerp(1, &_keyRotations[keyId << 2], &_keyRotations[(keyId + 1) << 2], &ratio, rotation);
+		Quaternion::toMatrix(rotation, matrixQ);
+		Matrix4x4::lerp(&_keyUpperTriangulars[keyId << 4], &_keyUpperTriangulars[(keyId + 1) << 4], ratio, output);
+		Matrix4x4::multiply(output, matrixQ, output);
+    }
+}
@@ -12,6 +12,12 @@ namespace minko
 		template<typename T>
 		uint
 		getIndexForTime(uint time, const std::vector<std::pair<uint,T>>& timetable);
+
+		// starts from the key found by the previous lookup and only falls back to a binary
+		// search when the time jumps further than a few keys (seek, loop, reversed playback)
+		template<typename T>
+		uint
+		getIndexForTime(uint time, const std::vector<std::pair<uint,T>>& timetable, uint& cursor);
 	}
 
 	uint
@@ -53,7 +59,32 @@ namespace minko
 
 		return lowerId;
 	}
+
+	template<typename T>
+	uint
+	animation::getIndexForTime(uint time, const std::vector<std::pair<uint,T>>& timetable, uint& cursor)
+	{
+		static const uint MAX_NUM_SCANNED_KEYS = 4;
+
+		const uint numKeys = timetable.size();
+		if (numKeys == 0)
+			return 0;
+
+		if (cursor < numKeys && timetable[cursor].first <= time)
+			for (uint i = 0; i < MAX_NUM_SCANNED_KEYS; ++i)
+			{
+				if (cursor + 1 == numKeys || timetable[cursor + 1].first > time)
+					return cursor;
+
+				++cursor;
+			}
+
+		cursor = getIndexForTime(time, timetable);
+
+		return cursor;
+	}
 }
 
 
 
+
@@ -0,0 +1,345 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/async/SystemScheduler.hpp"
+
+#include "minko/async/ThreadPool.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+using namespace minko;
+using namespace minko::async;
+
+// shared with the pool tasks, which may outlive execute() when the calling thread ran their system first
+struct SystemScheduler::Execution
+{
+	std::vector<std::atomic<uint>>	numPredecessors;
+	std::vector<std::atomic<bool>>	claimed;
+	std::mutex						mutex;
+	std::condition_variable			changed;
+	std::list<uint>					ready;
+	std::list<uint>					mainThreadReady;
+	uint							numCompleted;
+	std::exception_ptr				exception;
+	float							time;
+	float							deltaTime;
+
+	Execution(uint numSystems, float time, float deltaTime) :
+		numPredecessors(numSystems),
+		claimed(numSystems),
+		numCompleted(0),
+		time(time),
+		deltaTime(deltaTime)
+	{
+	}
+};
+
+SystemScheduler::SystemScheduler(ThreadPoolPtr threadPool) :
+	_threadPool(threadPool),
+	_invalidGraph(true)
+{
+}
+
+void
+SystemScheduler::addSystem(const std::string&				name,
+						   Update							update,
+						   const std::vector<std::string>&	reads,
+						   const std::vector<std::string>&	writes,
+						   const std::vector<std::string>&	after,
+						   bool								mainThread)
+{
+	if (!update)
+		throw std::invalid_argument("update");
+	if (hasSystem(name))
+		throw std::invalid_argument("name");
+
+	System system;
+
+	system.name = name;
+	system.update = update;
+	system.reads.insert(reads.begin(), reads.end());
+	system.writes.insert(writes.begin(), writes.end());
+	system.after = after;
+	system.mainThread = mainThread;
+
+	_systems.push_back(system);
+	_invalidGraph = true;
+}
+
+bool
+SystemScheduler::hasSystem(const std::string& name) const
+{
+	return indexOf(name) >= 0;
+}
+
+void
+SystemScheduler::removeSystem(const std::string& name)
+{
+	const auto index = indexOf(name);
+
+	if (index < 0)
+		throw std::invalid_argument("name");
+
+	_systems.erase(_systems.begin() + index);
+	_invalidGraph = true;
+}
+
+std::vector<std::string>
+SystemScheduler::dependencies(const std::string& name)
+{
+	const auto index = indexOf(name);
+
+	if (index < 0)
+		throw std::invalid_argument("name");
+
+	updateGraph();
+
+	std::vector<std::string> names;
+
+	for (uint i = 0; i < _systems.size(); ++i)
+		if (std::find(_successors[i].begin(), _successors[i].end(), (uint)index) != _successors[i].end())
+			names.push_back(_systems[i].name);
+
+	return names;
+}
+
+std::vector<std::string>
+SystemScheduler::order()
+{
+	updateGraph();
+
+	std::vector<std::string> names;
+
+	for (auto index : _order)
+		names.push_back(_systems[index].name);
+
+	return names;
+}
+
+int
+SystemScheduler::indexOf(const std::string& name) const
+{
+	for (uint i = 0; i < _systems.size(); ++i)
+		if (_systems[i].name == name)
+			return i;
+
+	return -1;
+}
+
+/*static*/
+bool
+SystemScheduler::conflict(const System& a, const System& b)
+{
+	for (auto& data : a.writes)
+		if (b.reads.count(data) || b.writes.count(data))
+			return true;
+	for (auto& data : a.reads)
+		if (b.writes.count(data))
+			return true;
+
+	return false;
+}
+
+void
+SystemScheduler::updateGraph()
+{
+	if (!_invalidGraph)
+		return;
+
+	const uint numSystems = _systems.size();
+	std::vector<std::set<uint>> successors(numSystems);
+	std::set<std::pair<uint, uint>> explicitOrder;
+
+	// the explicit order wins over the registration order
+	for (uint i = 0; i < numSystems; ++i)
+		for (auto& name : _systems[i].after)
+		{
+			const auto predecessor = indexOf(name);
+
+			if (predecessor >= 0 && (uint)predecessor != i)
+			{
+				successors[predecessor].insert(i);
+				explicitOrder.insert(std::make_pair(std::min<uint>(predecessor, i), std::max<uint>(predecessor, i)));
+			}
+		}
+
+	for (uint i = 0; i < numSystems; ++i)
+		for (uint j = i + 1; j < numSystems; ++j)
+			if (!explicitOrder.count(std::make_pair(i, j)) && conflict(_systems[i], _systems[j]))
+				successors[i].insert(j);
+
+	_successors.assign(numSystems, std::vector<uint>());
+	_numPredecessors.assign(numSystems, 0);
+	for (uint i = 0; i < numSystems; ++i)
+		for (auto successor : successors[i])
+		{
+			_successors[i].push_back(successor);
+			++_numPredecessors[successor];
+		}
+
+	// Kahn's algorithm, ties are broken by registration order
+	std::set<uint> ready;
+	auto numPredecessors = _numPredecessors;
+
+	_order.clear();
+	for (uint i = 0; i < numSystems; ++i)
+		if (numPredecessors[i] == 0)
+			ready.insert(i);
+
+	while (!ready.empty())
+	{
+		const auto index = *ready.begin();
+
+		ready.erase(ready.begin());
+		_order.push_back(index);
+		for (auto successor : _successors[index])
+			if (--numPredecessors[successor] == 0)
+				ready.insert(successor);
+	}
+
+	if (_order.size() != numSystems)
+		throw std::logic_error("the systems cannot be ordered: their explicit dependencies form a cycle");
+
+	_invalidGraph = false;
+}
+
+void
+SystemScheduler::execute(float time, float deltaTime)
+{
+	updateGraph();
+
+	const uint numSystems = _systems.size();
+
+	if (!_threadPool || _threadPool->numThreads() == 0)
+	{
+		for (auto index : _order)
+			_systems[index].update(time, deltaTime);
+
+		return;
+	}
+
+	auto execution = std::make_shared<Execution>(numSystems, time, deltaTime);
+
+	for (uint i = 0; i < numSystems; ++i)
+	{
+		execution->numPredecessors[i] = _numPredecessors[i];
+		execution->claimed[i] = false;
+	}
+	for (uint i = 0; i < numSystems; ++i)
+		if (_numPredecessors[i] == 0)
+			schedule(execution, i);
+
+	while (true)
+	{
+		std::unique_lock<std::mutex> lock(execution->mutex);
+
+		execution->changed.wait(lock, [&]()
+		{
+			return execution->numCompleted == numSystems
+				|| !execution->mainThreadReady.empty()
+				|| !execution->ready.empty();
+		});
+
+		uint index;
+
+		if (!execution->mainThreadReady.empty())
+		{
+			index = execution->mainThreadReady.front();
+			execution->mainThreadReady.pop_front();
+		}
+		else if (!execution->ready.empty())
+		{
+			index = execution->ready.front();
+			execution->ready.pop_front();
+			if (execution->claimed[index].exchange(true))
+				continue;
+		}
+		else
+			break;
+
+		lock.unlock();
+		run(execution, index);
+	}
+
+	if (execution->exception)
+		std::rethrow_exception(execution->exception);
+}
+
+void
+SystemScheduler::schedule(std::shared_ptr<Execution> execution, uint index)
+{
+	const auto mainThread = _systems[index].mainThread;
+
+	{
+		std::lock_guard<std::mutex> lock(execution->mutex);
+
+		if (mainThread)
+			execution->mainThreadReady.push_back(index);
+		else
+			execution->ready.push_back(index);
+		execution->changed.notify_all();
+	}
+
+	if (mainThread)
+		return;
+
+	// whoever claims the system first runs it: the calling thread does not wait for busy pool threads, and
+	// a task starting once execute() returned finds its system already claimed
+	std::weak_ptr<Execution> weakExecution = execution;
+
+	_threadPool->run(
+		[this, weakExecution, index]()
+		{
+			auto execution = weakExecution.lock();
+
+			if (execution && !execution->claimed[index].exchange(true))
+				run(execution, index);
+		},
+		nullptr,
+		std::numeric_limits<int>::max()
+	);
+}
+
+void
+SystemScheduler::run(std::shared_ptr<Execution> execution, uint index)
+{
+	try
+	{
+		_systems[index].update(execution->time, execution->deltaTime);
+	}
+	catch (...)
+	{
+		std::lock_guard<std::mutex> lock(execution->mutex);
+
+		if (!execution->exception)
+			execution->exception = std::current_exception();
+	}
+
+	for (auto successor : _successors[index])
+		if (--execution->numPredecessors[successor] == 0)
+			schedule(execution, successor);
+
+	// the scheduler must not be accessed anymore once the last system completed
+	std::lock_guard<std::mutex> lock(execution->mutex);
+
+	++execution->numCompleted;
+	execution->changed.notify_all();
+}
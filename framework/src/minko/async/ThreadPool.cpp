@@ -0,0 +1,280 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/async/ThreadPool.hpp"
+
+using namespace minko;
+using namespace minko::async;
+
+ThreadPool::ThreadPool(uint numThreads) :
+	_queues(),
+	_threads(),
+	_nextQueue(0),
+	_nextOrder(0),
+	_numPendingTasks(0),
+	_numRunningTasks(0),
+	_stopping(false),
+	_completedTasks(nullptr),
+	_numWaiters(0)
+{
+	for (uint i = 0; i < std::max(1u, numThreads); ++i)
+		_queues.push_back(std::unique_ptr<Queue>(new Queue()));
+
+	for (uint i = 0; i < numThreads; ++i)
+		_threads.push_back(std::thread(&ThreadPool::threadLoop, this, i));
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(_sleepMutex);
+
+		_stopping = true;
+	}
+	_wakeUp.notify_all();
+
+	for (auto& thread : _threads)
+		thread.join();
+
+	auto completedTask = _completedTasks.exchange(nullptr);
+
+	while (completedTask)
+	{
+		auto next = completedTask->next;
+
+		delete completedTask;
+		completedTask = next;
+	}
+}
+
+uint
+ThreadPool::defaultNumThreads()
+{
+#if defined(MINKO_NO_THREADS)
+	return 0;
+#else
+	return std::max(1u, std::thread::hardware_concurrency());
+#endif
+}
+
+ThreadPool::Task::Ptr
+ThreadPool::run(std::function<void()> task, std::function<void()> complete, int priority)
+{
+	if (!task)
+		throw std::invalid_argument("task");
+
+	auto t		= Task::Ptr(new Task(task, complete, priority, _nextOrder++));
+	auto& queue	= *_queues[_nextQueue++ % _queues.size()];
+
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex);
+
+		// counted under the queue lock before the push so pop() can never decrement it first
+		++_numPendingTasks;
+		queue.tasks.push_back(t);
+		std::push_heap(queue.tasks.begin(), queue.tasks.end(), lowerPriority);
+	}
+
+	{
+		// a worker checks the counter under this lock before sleeping: taking it avoids a lost wake up
+		std::lock_guard<std::mutex> lock(_sleepMutex);
+	}
+	_wakeUp.notify_one();
+
+	return t;
+}
+
+void
+ThreadPool::update()
+{
+	// no thread to run them
+	if (_threads.empty())
+		while (auto task = pop(0))
+			execute(task);
+
+	auto completedTask = _completedTasks.exchange(nullptr);
+
+	// the tasks were pushed on a stack, take them back in completion order
+	CompletedTask* ordered = nullptr;
+
+	while (completedTask)
+	{
+		auto next = completedTask->next;
+
+		completedTask->next = ordered;
+		ordered = completedTask;
+		completedTask = next;
+	}
+
+	std::exception_ptr exception;
+
+	while (ordered)
+	{
+		auto task = ordered->task;
+		auto next = ordered->next;
+
+		delete ordered;
+		ordered = next;
+
+		if (task->_exception && !exception)
+			exception = task->_exception;
+		else if (!task->_cancelled && task->_complete)
+			task->_complete();
+	}
+
+	if (exception)
+		std::rethrow_exception(exception);
+}
+
+void
+ThreadPool::post(std::function<void()> callback)
+{
+	if (!callback)
+		throw std::invalid_argument("callback");
+
+	pushCompleted(Task::Ptr(new Task(nullptr, callback, 0, 0)));
+	notifyWaiters();
+}
+
+bool
+ThreadPool::waitForCompletion()
+{
+	if (_threads.empty())
+	{
+		if (auto task = pop(0))
+			execute(task);
+	}
+	else if (!_completedTasks.load())
+	{
+		std::unique_lock<std::mutex> lock(_completedMutex);
+
+		++_numWaiters;
+		_completed.wait(lock, [&]()
+		{
+			return _completedTasks.load() || (_numPendingTasks == 0 && _numRunningTasks == 0);
+		});
+		--_numWaiters;
+	}
+
+	auto completed = _completedTasks.load() != nullptr;
+
+	update();
+
+	return completed;
+}
+
+void
+ThreadPool::threadLoop(uint queueId)
+{
+	while (!_stopping)
+	{
+		auto task = pop(queueId);
+
+		if (task)
+		{
+			execute(task);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(_sleepMutex);
+
+		_wakeUp.wait(lock, [&]() { return _stopping || _numPendingTasks > 0; });
+	}
+}
+
+ThreadPool::Task::Ptr
+ThreadPool::pop(uint queueId)
+{
+	// own queue first, then steal from the next ones
+	for (uint i = 0; i < _queues.size(); ++i)
+	{
+		auto& queue = *_queues[(queueId + i) % _queues.size()];
+
+		std::lock_guard<std::mutex> lock(queue.mutex);
+
+		if (queue.tasks.empty())
+			continue;
+
+		std::pop_heap(queue.tasks.begin(), queue.tasks.end(), lowerPriority);
+
+		auto task = queue.tasks.back();
+
+		queue.tasks.pop_back();
+		++_numRunningTasks;
+		--_numPendingTasks;
+
+		return task;
+	}
+
+	return nullptr;
+}
+
+void
+ThreadPool::execute(Task::Ptr task)
+{
+	if (task->_cancelled)
+	{
+		--_numRunningTasks;
+		notifyWaiters();
+
+		return;
+	}
+
+	try
+	{
+		task->_run();
+	}
+	catch (...)
+	{
+		task->_exception = std::current_exception();
+	}
+
+	pushCompleted(task);
+	--_numRunningTasks;
+	notifyWaiters();
+}
+
+void
+ThreadPool::pushCompleted(Task::Ptr task)
+{
+	auto completedTask = new CompletedTask { task, _completedTasks.load() };
+
+	while (!_completedTasks.compare_exchange_weak(completedTask->next, completedTask))
+		;
+}
+
+void
+ThreadPool::notifyWaiters()
+{
+	// the lock is only taken when a thread is blocked in waitForCompletion()
+	if (_numWaiters == 0)
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(_completedMutex);
+	}
+	_completed.notify_all();
+}
+
+bool
+ThreadPool::lowerPriority(const Task::Ptr& a, const Task::Ptr& b)
+{
+	// same priority: first submitted first
+	return a->_priority != b->_priority ? a->_priority < b->_priority : a->_order > b->_order;
+}
@@ -19,8 +19,10 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/async/Worker.hpp"
 #include "minko/AbstractCanvas.hpp"
+#include "minko/async/ThreadPool.hpp"
+#include "minko/Profiler.hpp"
 
-#if defined(EMSCRIPTEN)
+#if defined(MINKO_NO_THREADS)
 # include "emscripten/emscripten.h"
 #else
 #endif
@@ -32,11 +34,12 @@ Worker::Worker(const std::string& name) :
 	_progress(Signal<float>::create()),
 	_complete(Signal<MessagePtr>::create()),
 	_busy(false),
-	_finished(false)
+	_finished(false),
+	_profileName(Profiler::intern("Worker::run " + name))
 {
-#if defined(EMSCRIPTEN)
-	std::string path = "minko-worker-" + name + ".js";
-	_handle = emscripten_create_worker(path.c_str());
+#if defined(MINKO_NO_THREADS)
+	_script = "minko-worker-" + name + ".js";
+	_handle = -1;
 #else
 	_ratio = 0;
 	_oldRatio = 0;
@@ -47,30 +50,72 @@ Worker::Worker(const std::string& name) :
 void
 Worker::start()
 {
-	std::cout << "Worker::start()" << std::endl;;
-
 	_busy = true;
 
-#if defined(EMSCRIPTEN)
-	emscripten_call_worker(_handle, "minkoWorkerEntryPoint", &*_input->begin(), _input->size(), &messageHandler, this);
+#if defined(MINKO_NO_THREADS)
+	_handle = acquireWebWorker(_script);
+
+	// the worker is kept alive until it responds, the handler only receives the id of the call
+	const auto callId = _nextCallId++;
+
+	_calls[callId] = shared_from_this();
+	emscripten_call_worker(
+		_handle,
+		"minkoWorkerEntryPoint",
+		&*_input->begin(),
+		_input->size(),
+		&messageHandler,
+		reinterpret_cast<void*>(static_cast<intptr_t>(callId))
+	);
 #else
-	std::thread(&Worker::run, shared_from_this()).detach();
+	auto canvas = AbstractCanvas::defaultCanvas();
+
+	if (canvas)
+	{
+		auto that = shared_from_this();
+
+		// completion comes from the pool, drained once per frame by the canvas
+		_threadPool = canvas->threadPool();
+		_task = canvas->threadPool()->run(
+			[that]() { that->profiledRun(); },
+			[that]() { that->finish(); }
+		);
+	}
+	else
+		std::thread(&Worker::profiledRun, shared_from_this()).detach();
 #endif
 }
 
+#if !defined(MINKO_NO_THREADS)
+void
+Worker::profiledRun()
+{
+	MINKO_PROFILE_SCOPE(_profileName);
+
+	run();
+}
+#endif
+
 void
 Worker::progress(float value)
 {
-#if defined(EMSCRIPTEN)
+#if defined(MINKO_NO_THREADS)
 	std::string script = "postMessage(" + std::to_string(value) + ")";
 	emscripten_run_script(script.c_str());
 	// EM_ASM(
 	// 	postMessage(0.5);
 	// );
 #else
-	std::lock_guard<std::mutex> lock(_ratioMutex);
-	_ratio = value;
-	std::cout << "Worker::progress(): " << _ratio << std::endl;
+	auto threadPool = _threadPool.lock();
+
+	if (threadPool)
+	{
+		auto that = shared_from_this();
+
+		threadPool->post([that, value]() { that->_progress->execute(value); });
+	}
+	else
+		_ratio = value;
 #endif
 }
 
@@ -80,49 +125,116 @@ Worker::update()
 	if (_finished)
 		return;
 
-	std::cout << "Worker::update()" << std::endl;;
-
 	if (!_busy)
 		start();
 
-#if !defined(EMSCRIPTEN)
-	std::lock_guard<std::mutex> lock(_ratioMutex);
-	
-	if (_ratio != _oldRatio)
+#if !defined(MINKO_NO_THREADS)
+	// only a worker running on its own thread has to be polled
+	if (_task)
+		return;
+
+	float ratio = _ratio;
+
+	if (ratio != _oldRatio)
 	{
-		std::cout << "Worker::update(): progress execute" << std::endl;
-		_progress->execute(_ratio);
-		_oldRatio = _ratio;
+		_progress->execute(ratio);
+		_oldRatio = ratio;
 	}
 
 	if (_future.valid() && _future.wait_for(std::chrono::milliseconds(0)) == std::future_status::ready)
+		finish();
+#endif
+}
+
+#if !defined(MINKO_NO_THREADS)
+void
+Worker::finish()
+{
+	if (_finished)
+		return;
+
+	_busy = false;
+	_finished = true;
+	_task = nullptr;
+	_complete->execute(_future.get());
+}
+
+void
+Worker::cancel()
+{
+	if (_task)
+		_task->cancel();
+	_task = nullptr;
+	_finished = true;
+	_busy = false;
+}
+#endif
+
+#if defined(MINKO_NO_THREADS)
+std::unordered_map<std::string, std::vector<Worker::WebWorker>>	Worker::_webWorkers;
+std::unordered_map<uint, Worker::Ptr>							Worker::_calls;
+uint															Worker::_nextCallId = 0;
+
+/*static*/
+int
+Worker::acquireWebWorker(const std::string& script)
+{
+	static const uint maxNumWebWorkers = std::max(1, emscripten_run_script_int("navigator.hardwareConcurrency || 4"));
+
+	auto& webWorkers = _webWorkers[script];
+	WebWorker* leastBusy = nullptr;
+
+	for (auto& webWorker : webWorkers)
+		if (!leastBusy || webWorker.numCalls < leastBusy->numCalls)
+			leastBusy = &webWorker;
+
+	// creating a web worker downloads and compiles its script again: idle ones are reused, busy ones only
+	// queue calls once there are as many as cores
+	if (!leastBusy || (leastBusy->numCalls != 0 && webWorkers.size() < maxNumWebWorkers))
 	{
-		std::cout << "Worker::update(): complete execute" << std::endl;
-		_busy = false;
-		_finished = true;
-		_complete->execute(_future.get());
+		webWorkers.push_back({ emscripten_create_worker(script.c_str()), 0 });
+		leastBusy = &webWorkers.back();
 	}
-#endif
+
+	++leastBusy->numCalls;
+
+	return leastBusy->handle;
+}
+
+/*static*/
+void
+Worker::releaseWebWorker(const std::string& script, int handle)
+{
+	for (auto& webWorker : _webWorkers[script])
+		if (webWorker.handle == handle)
+			--webWorker.numCalls;
 }
 
-#if defined(EMSCRIPTEN)
 void
 Worker::messageHandler(char* data, int size, void* arg)
 {
-	Worker* worker = static_cast<Worker*>(arg);
+	const auto callId = static_cast<uint>(reinterpret_cast<intptr_t>(arg));
+	auto callIt = _calls.find(callId);
+
+	if (callIt == _calls.end())
+		return;
 
-	std::cout << "Worker::messageHandler(): " << size << std::endl;;
+	auto worker = callIt->second;
 
 	if (size == sizeof(float))
 	{
-		std::cout << "Worker::messageHandler(): progress execute" << std::endl;
 		float ratio = reinterpret_cast<float*>(data)[0];
 		worker->progress()->execute(ratio);
 
 	}
 	else
 	{
-		std::cout << "Worker::messageHandler(): complete execute" << std::endl;
+		_calls.erase(callIt);
+		releaseWebWorker(worker->_script, worker->_handle);
+		worker->_handle = -1;
+		worker->_busy = false;
+		worker->_finished = true;
+
 		auto output = std::make_shared<std::vector<char>>(data, data + size);
 		worker->complete()->execute(output);
 	}
@@ -131,8 +243,4 @@ Worker::messageHandler(char* data, int size, void* arg)
 
 Worker::~Worker()
 {
-	std::cout << "Worker::~Worker()" << std::endl;;
-#if defined(EMSCRIPTEN)
-	emscripten_destroy_worker(_handle);
-#endif
-}
\ No newline at end of file
+}
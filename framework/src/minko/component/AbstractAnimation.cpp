@@ -18,11 +18,14 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 */
 
 #include <climits>
+#include <chrono>
+#include <limits>
 
 #include "minko/component/AbstractAnimation.hpp"
 #include "minko/scene/Node.hpp"
 #include "minko/scene/NodeSet.hpp"
 #include "minko/component/SceneManager.hpp"
+#include "minko/component/Surface.hpp"
 
 using namespace minko;
 using namespace minko::component;
@@ -41,6 +44,12 @@ AbstractAnimation::AbstractAnimation(bool isLooping):
 	_isLooping(isLooping),
 	_isReversed(false),
 	_canUpdateOnce(false),
+	_lodScreenSize(0.f),
+	_lodUpdateInterval(0),
+	_screenSize(std::numeric_limits<float>::max()),
+	_screenSizeFrameId(0),
+	_timeSinceUpdate(0),
+	_updateWhenCulled(true),
 	_clockStart(clock()),
 	_timeFunction(),
 	_labels(),
@@ -343,6 +352,33 @@ AbstractAnimation::isReversed(bool value)
 	_isReversed = value;
 }
 
+void
+AbstractAnimation::screenSize(float value)
+{
+	const uint frameId = _sceneManager ? _sceneManager->frameId() : 0;
+
+	if (frameId != _screenSizeFrameId || value > _screenSize)
+		_screenSize = value;
+	_screenSizeFrameId = frameId;
+}
+
+bool
+AbstractAnimation::visible() const
+{
+	for (auto& target : targets())
+	{
+		auto surfaces = target->components<Surface>();
+
+		if (surfaces.empty())
+			return true;
+		for (auto& surface : surfaces)
+			if (surface->computedVisibility())
+				return true;
+	}
+
+	return targets().empty();
+}
+
 void
 AbstractAnimation::updateNextLabelIds(uint time)
 {
@@ -486,6 +522,8 @@ AbstractAnimation::update(uint rawGlobalTime)
 	if (!_isPlaying && !_canUpdateOnce)
 		return false;
 
+	const bool forceUpdate = _canUpdateOnce;
+
 	_canUpdateOnce = false;
 
 	const uint	globalTime		= _timeFunction(rawGlobalTime);
@@ -514,7 +552,31 @@ AbstractAnimation::update(uint rawGlobalTime)
 		}
 	}
 
-	update();
+	_timeSinceUpdate += globalDeltaTime;
+
+	// the last pose of a stopped animation is always evaluated
+	const bool skipUpdate = _isPlaying && !forceUpdate && (
+		(!_updateWhenCulled && !visible())
+		|| (_screenSize < _lodScreenSize && _timeSinceUpdate < _lodUpdateInterval)
+	);
+
+	if (skipUpdate)
+	{
+		if (_sceneManager)
+			_sceneManager->animationSkipped();
+	}
+	else
+	{
+		const auto start = std::chrono::steady_clock::now();
+
+		update();
+		_timeSinceUpdate = 0;
+
+		if (_sceneManager)
+			_sceneManager->animationUpdated(std::chrono::duration<float, std::milli>(
+				std::chrono::steady_clock::now() - start
+			).count());
+	}
 
 	checkLabelHit(_previousTime, _currentTime);
 
@@ -29,11 +29,25 @@ using namespace minko::component;
 
 AbstractLight::AbstractLight(const std::string& arrayName) :
 	AbstractRootDataComponent<data::ArrayProvider>(data::ArrayProvider::create(arrayName)),
-	_color(math::Vector3::create(1.0f, 1.0f, 1.0f))
+	_color(math::Vector3::create(1.0f, 1.0f, 1.0f)),
+	_enabled(true),
+	_black(math::Vector3::create(0.f, 0.f, 0.f))
 {
 	data()->set("color", _color);
 }
 
+AbstractLight::Ptr
+AbstractLight::enabled(bool value)
+{
+	if (value != _enabled)
+	{
+		_enabled = value;
+		data()->set("color", value ? _color : _black);
+	}
+
+	return std::static_pointer_cast<AbstractLight>(shared_from_this());
+}
+
 AbstractLight::Ptr
 AbstractLight::color(math::Vector3::Ptr color)
 {
@@ -30,7 +30,9 @@ Animation::Animation(const std::vector<AbstractTimeline::Ptr>& timelines,
 					 bool isLooping):
 	AbstractAnimation(isLooping),
 	_timelines(timelines),
-	_master(nullptr)
+	_master(nullptr),
+	_batched(false),
+	_evaluationPending(false)
 {
 }
 
@@ -49,6 +51,13 @@ Animation::initialize()
 void
 Animation::update()
 {
+	if (_batched)
+	{
+		_evaluationPending = true;
+
+		return;
+	}
+
 	for (auto& target : targets())
 	{
 		auto container = target->data();
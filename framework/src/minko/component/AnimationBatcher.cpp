@@ -0,0 +1,282 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/component/AnimationBatcher.hpp"
+
+#include "minko/scene/Node.hpp"
+#include "minko/scene/NodeSet.hpp"
+#include "minko/component/SceneManager.hpp"
+#include "minko/component/Animation.hpp"
+#include "minko/animation/Matrix4x4Timeline.hpp"
+#include "minko/data/Container.hpp"
+#include "minko/math/Matrix4x4.hpp"
+#include "minko/async/Parallel.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::animation;
+using namespace minko::math;
+
+const uint AnimationBatcher::PARALLEL_MIN_NUM_MATRICES = 256;
+
+AnimationBatcher::AnimationBatcher() :
+	_animations(),
+	_invalidBindings(false),
+	_entryAnimationIds(),
+	_entryTimelines(),
+	_entryTargets(),
+	_entryKeyCursors(),
+	_pendingEntries(),
+	_pendingTimes(),
+	_matrices()
+{
+}
+
+void
+AnimationBatcher::initialize()
+{
+	_targetAddedSlot = targetAdded()->connect(std::bind(
+		&AnimationBatcher::targetAddedHandler,
+		shared_from_this(),
+		std::placeholders::_1,
+		std::placeholders::_2
+	));
+
+	_targetRemovedSlot = targetRemoved()->connect(std::bind(
+		&AnimationBatcher::targetRemovedHandler,
+		shared_from_this(),
+		std::placeholders::_1,
+		std::placeholders::_2
+	));
+}
+
+void
+AnimationBatcher::targetAddedHandler(AbsCtrlPtr ctrl, NodePtr target)
+{
+	if (targets().size() > 1)
+		throw std::logic_error("AnimationBatcher cannot have more than one target.");
+
+	auto invalidate = [this](NodePtr, NodePtr, NodePtr)
+	{
+		_invalidBindings = true;
+	};
+
+	_addedSlot = target->added()->connect(invalidate);
+	_removedSlot = target->removed()->connect(invalidate);
+	_componentAddedSlot = target->componentAdded()->connect(std::bind(
+		&AnimationBatcher::componentAddedHandler,
+		shared_from_this(),
+		std::placeholders::_1,
+		std::placeholders::_2,
+		std::placeholders::_3
+	));
+	_componentRemovedSlot = target->componentRemoved()->connect(std::bind(
+		&AnimationBatcher::componentRemovedHandler,
+		shared_from_this(),
+		std::placeholders::_1,
+		std::placeholders::_2,
+		std::placeholders::_3
+	));
+
+	setSceneManager(target->root()->component<SceneManager>());
+	_invalidBindings = true;
+}
+
+void
+AnimationBatcher::targetRemovedHandler(AbsCtrlPtr ctrl, NodePtr target)
+{
+	_addedSlot = nullptr;
+	_removedSlot = nullptr;
+	_componentAddedSlot = nullptr;
+	_componentRemovedSlot = nullptr;
+	_frameBeginSlot = nullptr;
+
+	unbind();
+}
+
+void
+AnimationBatcher::componentAddedHandler(NodePtr node, NodePtr target, AbsCtrlPtr ctrl)
+{
+	auto sceneManager = std::dynamic_pointer_cast<SceneManager>(ctrl);
+
+	if (sceneManager)
+		setSceneManager(sceneManager);
+
+	// target matrices might have been added or replaced
+	_invalidBindings = true;
+}
+
+void
+AnimationBatcher::componentRemovedHandler(NodePtr node, NodePtr target, AbsCtrlPtr ctrl)
+{
+	if (std::dynamic_pointer_cast<SceneManager>(ctrl))
+		setSceneManager(nullptr);
+
+	_invalidBindings = true;
+}
+
+void
+AnimationBatcher::setSceneManager(SceneManagerPtr sceneManager)
+{
+	// after the handlers of the animations, which only flag themselves during frameBegin()
+	if (sceneManager)
+		_frameBeginSlot = sceneManager->frameBegin()->connect(std::bind(
+			&AnimationBatcher::frameBeginHandler,
+			shared_from_this(),
+			std::placeholders::_1,
+			std::placeholders::_2,
+			std::placeholders::_3
+		), -1000.f);
+	else
+		_frameBeginSlot = nullptr;
+}
+
+void
+AnimationBatcher::frameBeginHandler(SceneManagerPtr sceneManager, float time, float deltaTime)
+{
+	if (_invalidBindings)
+		bind();
+
+	evaluate();
+}
+
+void
+AnimationBatcher::unbind()
+{
+	// animations flagged during this frame are evaluated before they stop being batched
+	for (auto& animation : _animations)
+	{
+		animation->_batched = false;
+		if (animation->_evaluationPending)
+		{
+			animation->_evaluationPending = false;
+			animation->update();
+		}
+	}
+
+	_animations.clear();
+	_entryAnimationIds.clear();
+	_entryTimelines.clear();
+	_entryTargets.clear();
+	_entryKeyCursors.clear();
+}
+
+void
+AnimationBatcher::bind()
+{
+	unbind();
+	_invalidBindings = false;
+
+	if (targets().empty())
+		return;
+
+	scene::NodeSet::visitDescendants(
+		targets()[0],
+		[&](const NodePtr& descendant)
+		{
+			for (auto& animation : descendant->components<Animation>())
+				if (!animation->_batched)
+					bind(animation);
+		},
+		true
+	);
+}
+
+void
+AnimationBatcher::bind(AnimationPtr animation)
+{
+	for (auto& timeline : animation->timelines())
+		if (!std::dynamic_pointer_cast<Matrix4x4Timeline>(timeline))
+			return;
+
+	for (auto& target : animation->targets())
+		for (auto& timeline : animation->timelines())
+		{
+			auto& propertyName = timeline->propertyName();
+
+			if (timeline->duration() == 0 || !target->data()->hasProperty(propertyName))
+				continue;
+
+			auto matrix = target->data()->get<Matrix4x4::Ptr>(propertyName);
+
+			if (matrix == nullptr)
+				continue;
+
+			_entryAnimationIds.push_back(_animations.size());
+			_entryTimelines.push_back(std::static_pointer_cast<Matrix4x4Timeline>(timeline));
+			_entryTargets.push_back(matrix);
+			_entryKeyCursors.push_back(0);
+		}
+
+	animation->_batched = true;
+	_animations.push_back(animation);
+}
+
+void
+AnimationBatcher::evaluate()
+{
+	_pendingEntries.clear();
+	_pendingTimes.clear();
+
+	for (uint entryId = 0; entryId < _entryTimelines.size(); ++entryId)
+	{
+		auto& animation	= _animations[_entryAnimationIds[entryId]];
+		auto& timeline	= _entryTimelines[entryId];
+
+		if (!animation->_evaluationPending || timeline->isLocked())
+			continue;
+
+		_pendingEntries.push_back(entryId);
+		_pendingTimes.push_back(animation->_currentTime % (timeline->duration() + 1));
+	}
+
+	for (auto& animation : _animations)
+		animation->_evaluationPending = false;
+
+	const uint numMatrices = _pendingEntries.size();
+
+	if (numMatrices == 0)
+		return;
+
+	_matrices.resize(numMatrices << 4);
+
+#if defined(MINKO_NO_THREADS)
+	const uint numWorkers = 1;
+#else
+	const uint numWorkers = numMatrices < PARALLEL_MIN_NUM_MATRICES
+		? 1
+		: std::max(1u, std::thread::hardware_concurrency());
+#endif
+
+	// each entry has its own key cursor so shared timelines can be evaluated concurrently
+	async::runInParallel(numMatrices, numWorkers, [&](uint begin, uint end, uint worker)
+	{
+		for (uint i = begin; i < end; ++i)
+		{
+			const uint entryId = _pendingEntries[i];
+
+			_entryTimelines[entryId]->evaluate(_pendingTimes[i], &_matrices[i << 4], _entryKeyCursors[entryId]);
+		}
+	});
+
+	// change notifications are executed on the calling thread
+	for (uint i = 0; i < numMatrices; ++i)
+		_entryTargets[_pendingEntries[i]]->setRaw(&_matrices[i << 4]);
+}
@@ -0,0 +1,537 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/component/BillboardBatch.hpp"
+
+#include "minko/scene/Node.hpp"
+#include "minko/component/Transform.hpp"
+#include "minko/component/Surface.hpp"
+#include "minko/component/BoundingBox.hpp"
+#include "minko/geometry/Geometry.hpp"
+#include "minko/material/Material.hpp"
+#include "minko/math/Vector2.hpp"
+#include "minko/math/Vector3.hpp"
+#include "minko/math/Vector4.hpp"
+#include "minko/math/Matrix4x4.hpp"
+#include "minko/math/Frustum.hpp"
+#include "minko/render/AbstractContext.hpp"
+#include "minko/render/VertexBuffer.hpp"
+#include "minko/render/IndexBuffer.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::math;
+
+/*static*/ const uint BillboardBatch::MAX_NUM_SHORT_INDEXED_BILLBOARDS = 0x10000 >> 2;
+
+namespace
+{
+	// center xyz, corner offset xy, uv and rgba color
+	const uint	BILLBOARD_VERTEX_SIZE	= 11;
+	const uint	BILLBOARD_SIZE			= 4 * BILLBOARD_VERTEX_SIZE;
+	const uint	MIN_CAPACITY			= 64;
+
+	// corners of the quad in [0, 1], v going down like the uvs of the QuadGeometry
+	const float	BILLBOARD_CORNERS[8]	= { 0.f, 0.f, 1.f, 0.f, 1.f, 1.f, 0.f, 1.f };
+}
+
+BillboardBatch::BillboardBatch(ContextPtr context, EffectPtr effect, MaterialPtr material) :
+	_context(context),
+	_material(material ? material : material::Material::create()),
+	_effect(effect),
+	_billboards(),
+	_freeBillboards(),
+	_billboardsChanged(false),
+	_geometry(nullptr),
+	_vertexBuffer(nullptr),
+	_indexBuffer(nullptr),
+	_batchNode(nullptr),
+	_boundsChanged(false),
+	_frustum(Frustum::create()),
+	_localToScreen(Matrix4x4::create()),
+	_cullingBounds(),
+	_cullingIds(),
+	_visibility(),
+	_visible()
+{
+	for (uint i = 0; i < 3; ++i)
+	{
+		_bounds[i] = std::numeric_limits<float>::max();
+		_bounds[3 + i] = -std::numeric_limits<float>::max();
+	}
+}
+
+void
+BillboardBatch::initialize()
+{
+	if (!_context)
+		throw std::invalid_argument("context");
+	if (!_effect)
+		throw std::invalid_argument("effect");
+
+	_vertexBuffer	= render::VertexBuffer::create(_context);
+	_indexBuffer	= render::IndexBuffer::create(_context);
+
+	_vertexBuffer->usage(render::BufferUsage::DYNAMIC);
+	_indexBuffer->usage(render::BufferUsage::DYNAMIC);
+
+	// the "position" attribute is the center of the quad, expanded in view space by the vertex shader
+	_vertexBuffer->addAttribute("position", 3, 0);
+	_vertexBuffer->addAttribute("offset", 2, 3);
+	_vertexBuffer->addAttribute("uv", 2, 5);
+	_vertexBuffer->addAttribute("color", 4, 7, render::VertexAttributeType::UNSIGNED_BYTE_NORMALIZED);
+
+	_geometry = geometry::Geometry::create();
+	_geometry->addVertexBuffer(_vertexBuffer);
+	_geometry->indices(_indexBuffer);
+
+	reserve(MIN_CAPACITY);
+
+	_targetAddedSlot = targetAdded()->connect(std::bind(
+		&BillboardBatch::targetAddedHandler,
+		shared_from_this(),
+		std::placeholders::_1,
+		std::placeholders::_2
+	));
+
+	_targetRemovedSlot = targetRemoved()->connect(std::bind(
+		&BillboardBatch::targetRemovedHandler,
+		shared_from_this(),
+		std::placeholders::_1,
+		std::placeholders::_2
+	));
+}
+
+void
+BillboardBatch::targetAddedHandler(AbsCmpPtr cmp, NodePtr target)
+{
+	if (targets().size() > 1)
+		throw std::logic_error("The same BillboardBatch cannot have 2 different targets");
+
+	if (_batchNode == nullptr)
+		_batchNode = scene::Node::create("billboardBatch")
+			->addComponent(Transform::create())
+			->addComponent(Surface::create(_geometry, _material, _effect));
+
+	_boundsChanged = true;
+	updateBoundingBox();
+
+	_batchNode->layouts(target->layouts());
+	target->addChild(_batchNode);
+}
+
+void
+BillboardBatch::targetRemovedHandler(AbsCmpPtr cmp, NodePtr target)
+{
+	if (_batchNode->parent())
+		_batchNode->parent()->removeChild(_batchNode);
+}
+
+BillboardBatch::Billboard&
+BillboardBatch::billboard(uint id)
+{
+	if (!contains(id))
+		throw std::invalid_argument("id");
+
+	return _billboards[id];
+}
+
+const BillboardBatch::Billboard&
+BillboardBatch::billboard(uint id) const
+{
+	if (!contains(id))
+		throw std::invalid_argument("id");
+
+	return _billboards[id];
+}
+
+bool
+BillboardBatch::contains(uint id) const
+{
+	return id < _billboards.size() && _billboards[id].alive;
+}
+
+uint
+BillboardBatch::add(Vector3::Ptr position, Vector2::Ptr size, Vector4::Ptr color, Vector4::Ptr uvRect)
+{
+	if (position == nullptr)
+		throw std::invalid_argument("position");
+	if (size == nullptr)
+		throw std::invalid_argument("size");
+
+	uint id = 0;
+
+	if (_freeBillboards.empty())
+	{
+		id = _billboards.size();
+
+		if (id >= MAX_NUM_SHORT_INDEXED_BILLBOARDS && !_context->supportsUnsignedIntIndices())
+			throw std::logic_error("Maximal number of billboards (" + std::to_string(id) + ") for billboard batch reached.");
+
+		if (id >= _vertexBuffer->capacity() >> 2)
+			reserve(id << 1);
+
+		_billboards.resize(id + 1);
+		_vertexBuffer->data().resize((id + 1) * BILLBOARD_SIZE);
+	}
+	else
+	{
+		id = _freeBillboards.back();
+		_freeBillboards.pop_back();
+	}
+
+	auto& billboard = _billboards[id];
+
+	billboard.alive = true;
+	billboard.position[0] = position->x();
+	billboard.position[1] = position->y();
+	billboard.position[2] = position->z();
+	billboard.size[0] = size->x();
+	billboard.size[1] = size->y();
+	billboard.color[0] = color ? color->x() : 1.f;
+	billboard.color[1] = color ? color->y() : 1.f;
+	billboard.color[2] = color ? color->z() : 1.f;
+	billboard.color[3] = color ? color->w() : 1.f;
+	billboard.uvRect[0] = uvRect ? uvRect->x() : 0.f;
+	billboard.uvRect[1] = uvRect ? uvRect->y() : 0.f;
+	billboard.uvRect[2] = uvRect ? uvRect->z() : 1.f;
+	billboard.uvRect[3] = uvRect ? uvRect->w() : 1.f;
+
+	writeVertices(id);
+	_billboardsChanged = true;
+
+	return id;
+}
+
+BillboardBatch::Ptr
+BillboardBatch::remove(uint id)
+{
+	billboard(id).alive = false;
+	_freeBillboards.push_back(id);
+	_billboardsChanged = true;
+
+	return shared_from_this();
+}
+
+BillboardBatch::Ptr
+BillboardBatch::clear()
+{
+	// the buffers keep their capacity
+	_billboards.clear();
+	_freeBillboards.clear();
+	_vertexBuffer->data().clear();
+	_billboardsChanged = true;
+
+	for (uint i = 0; i < 3; ++i)
+	{
+		_bounds[i] = std::numeric_limits<float>::max();
+		_bounds[3 + i] = -std::numeric_limits<float>::max();
+	}
+	_boundsChanged = true;
+
+	return shared_from_this();
+}
+
+Vector3::Ptr
+BillboardBatch::position(uint id) const
+{
+	const auto& p = billboard(id).position;
+
+	return Vector3::create(p[0], p[1], p[2]);
+}
+
+BillboardBatch::Ptr
+BillboardBatch::position(uint id, Vector3::Ptr value)
+{
+	if (value == nullptr)
+		throw std::invalid_argument("value");
+
+	auto& p = billboard(id).position;
+
+	p[0] = value->x();
+	p[1] = value->y();
+	p[2] = value->z();
+	writeVertices(id);
+
+	return shared_from_this();
+}
+
+Vector2::Ptr
+BillboardBatch::size(uint id) const
+{
+	const auto& s = billboard(id).size;
+
+	return Vector2::create(s[0], s[1]);
+}
+
+BillboardBatch::Ptr
+BillboardBatch::size(uint id, Vector2::Ptr value)
+{
+	if (value == nullptr)
+		throw std::invalid_argument("value");
+
+	auto& s = billboard(id).size;
+
+	s[0] = value->x();
+	s[1] = value->y();
+	writeVertices(id);
+
+	return shared_from_this();
+}
+
+Vector4::Ptr
+BillboardBatch::color(uint id) const
+{
+	const auto& c = billboard(id).color;
+
+	return Vector4::create(c[0], c[1], c[2], c[3]);
+}
+
+BillboardBatch::Ptr
+BillboardBatch::color(uint id, Vector4::Ptr value)
+{
+	if (value == nullptr)
+		throw std::invalid_argument("value");
+
+	auto& c = billboard(id).color;
+
+	c[0] = value->x();
+	c[1] = value->y();
+	c[2] = value->z();
+	c[3] = value->w();
+	writeVertices(id);
+
+	return shared_from_this();
+}
+
+Vector4::Ptr
+BillboardBatch::uvRect(uint id) const
+{
+	const auto& r = billboard(id).uvRect;
+
+	return Vector4::create(r[0], r[1], r[2], r[3]);
+}
+
+BillboardBatch::Ptr
+BillboardBatch::uvRect(uint id, Vector4::Ptr value)
+{
+	if (value == nullptr)
+		throw std::invalid_argument("value");
+
+	auto& r = billboard(id).uvRect;
+
+	r[0] = value->x();
+	r[1] = value->y();
+	r[2] = value->z();
+	r[3] = value->w();
+	writeVertices(id);
+
+	return shared_from_this();
+}
+
+void
+BillboardBatch::writeVertices(uint id)
+{
+	const auto&	billboard	= _billboards[id];
+	float*		vertices	= &_vertexBuffer->data()[id * BILLBOARD_SIZE];
+
+	for (uint k = 0; k < 4; ++k)
+	{
+		float*		vertex	= vertices + k * BILLBOARD_VERTEX_SIZE;
+		const float	u		= BILLBOARD_CORNERS[2 * k];
+		const float	v		= BILLBOARD_CORNERS[2 * k + 1];
+
+		for (uint i = 0; i < 3; ++i)
+			vertex[i] = billboard.position[i];
+		vertex[3] = (u - .5f) * billboard.size[0];
+		vertex[4] = (.5f - v) * billboard.size[1];
+		vertex[5] = billboard.uvRect[0] + u * billboard.uvRect[2];
+		vertex[6] = billboard.uvRect[1] + v * billboard.uvRect[3];
+		for (uint i = 0; i < 4; ++i)
+			vertex[7 + i] = billboard.color[i];
+	}
+
+	_vertexBuffer->markDirty(id << 2, 4);
+
+	// the quad can face any direction, its bounds are those of the sphere around it
+	const float radius = .5f * sqrtf(billboard.size[0] * billboard.size[0] + billboard.size[1] * billboard.size[1]);
+
+	for (uint i = 0; i < 3; ++i)
+	{
+		if (billboard.position[i] - radius < _bounds[i])
+		{
+			_bounds[i] = billboard.position[i] - radius;
+			_boundsChanged = true;
+		}
+		if (billboard.position[i] + radius > _bounds[3 + i])
+		{
+			_bounds[3 + i] = billboard.position[i] + radius;
+			_boundsChanged = true;
+		}
+	}
+}
+
+void
+BillboardBatch::reserve(uint numBillboards)
+{
+	if (!_context->supportsUnsignedIntIndices())
+		numBillboards = std::min(numBillboards, MAX_NUM_SHORT_INDEXED_BILLBOARDS);
+
+	_vertexBuffer->reserve(numBillboards << 2);
+	_indexBuffer->reserve(6 * numBillboards);
+	_vertexBuffer->data().reserve(numBillboards * BILLBOARD_SIZE);
+	_indexBuffer->data().reserve(6 * numBillboards);
+}
+
+void
+BillboardBatch::update(Matrix4x4::Ptr worldToScreenMatrix)
+{
+	const auto vertexBufferId = _vertexBuffer->id();
+
+	// only the span of the modified billboards is uploaded unless the buffer had to grow
+	if (!_billboards.empty())
+		_vertexBuffer->uploadDirty();
+
+	// the draw calls bind the new buffer when it was re-created
+	if (_vertexBuffer->id() != vertexBufferId)
+		for (auto& attribute : _vertexBuffer->attributes())
+			_geometry->data()->set(std::get<0>(*attribute), _vertexBuffer);
+
+	std::vector<uint> visible;
+
+	if (worldToScreenMatrix)
+		cull(worldToScreenMatrix, visible);
+	else
+	{
+		for (uint id = 0; id < _billboards.size(); ++id)
+			if (_billboards[id].alive)
+				visible.push_back(id);
+	}
+
+	if (visible != _visible || _billboardsChanged)
+		updateIndices(visible);
+
+	_billboardsChanged = false;
+	updateBoundingBox();
+}
+
+void
+BillboardBatch::cull(Matrix4x4::Ptr worldToScreenMatrix, std::vector<uint>& visible)
+{
+	if (!targets().empty() && targets()[0]->hasComponent<Transform>())
+		_localToScreen->lock()
+			->copyFrom(targets()[0]->component<Transform>()->modelToWorldMatrix(true))
+			->append(worldToScreenMatrix)
+			->unlock();
+	else
+		_localToScreen->copyFrom(worldToScreenMatrix);
+
+	_frustum->updateFromMatrix(_localToScreen);
+
+	_cullingIds.clear();
+	for (auto& bounds : _cullingBounds)
+		bounds.clear();
+
+	for (uint id = 0; id < _billboards.size(); ++id)
+	{
+		const auto& billboard = _billboards[id];
+
+		if (!billboard.alive)
+			continue;
+
+		const float radius = .5f * sqrtf(billboard.size[0] * billboard.size[0] + billboard.size[1] * billboard.size[1]);
+
+		_cullingIds.push_back(id);
+		for (uint i = 0; i < 3; ++i)
+		{
+			_cullingBounds[i].push_back(billboard.position[i] - radius);
+			_cullingBounds[3 + i].push_back(billboard.position[i] + radius);
+		}
+	}
+
+	if (_cullingIds.empty())
+		return;
+
+	_frustum->testBoundingBoxes(
+		_cullingBounds[0].data(), _cullingBounds[1].data(), _cullingBounds[2].data(),
+		_cullingBounds[3].data(), _cullingBounds[4].data(), _cullingBounds[5].data(),
+		_cullingIds.size(),
+		_visibility
+	);
+
+	for (uint i = 0; i < _cullingIds.size(); ++i)
+		if ((_visibility[i >> 5] & (1u << (i & 31))) != 0)
+			visible.push_back(_cullingIds[i]);
+}
+
+void
+BillboardBatch::updateIndices(const std::vector<uint>& visible)
+{
+	auto& indexData = _indexBuffer->data();
+
+	indexData.resize(6 * visible.size());
+
+	for (uint i = 0; i < visible.size(); ++i)
+	{
+		const uint	offset	= visible[i] << 2;
+		uint*		indices	= &indexData[6 * i];
+
+		indices[0] = offset;
+		indices[1] = offset + 1;
+		indices[2] = offset + 3;
+		indices[3] = offset + 1;
+		indices[4] = offset + 2;
+		indices[5] = offset + 3;
+	}
+
+	_indexBuffer->upload();
+	_visible = visible;
+
+	// the draw calls read the new number of indices
+	_geometry->indices(_indexBuffer);
+}
+
+void
+BillboardBatch::updateBoundingBox()
+{
+	if (!_boundsChanged || _batchNode == nullptr)
+		return;
+
+	_boundsChanged = false;
+
+	auto parent = _batchNode->parent();
+
+	// the node is added again for the octree of the scene to insert it with its new bounds
+	if (parent)
+		parent->removeChild(_batchNode);
+
+	if (_batchNode->hasComponent<BoundingBox>())
+		_batchNode->removeComponent(_batchNode->component<BoundingBox>());
+
+	if (_bounds[0] <= _bounds[3])
+		_batchNode->addComponent(BoundingBox::create(
+			Vector3::create(_bounds[3], _bounds[4], _bounds[5]),
+			Vector3::create(_bounds[0], _bounds[1], _bounds[2])
+		));
+	else
+		_batchNode->addComponent(BoundingBox::create(Vector3::create(), Vector3::create()));
+
+	if (parent)
+		parent->addChild(_batchNode);
+}
@@ -100,12 +100,12 @@ BoundingBox::update()
 	{
 		if (!surfaces.empty())
 		{
-			auto min = Vector3::create(
+			auto min = _box->bottomLeft()->setTo(
 				std::numeric_limits<float>::max(),
 				std::numeric_limits<float>::max(),
 				std::numeric_limits<float>::max()
 			);
-			auto max = Vector3::create(
+			auto max = _box->topRight()->setTo(
 				-std::numeric_limits<float>::max(),
 				-std::numeric_limits<float>::max(),
 				-std::numeric_limits<float>::max()
@@ -113,36 +113,19 @@ BoundingBox::update()
 
 			for (auto& surface : surfaces)
 			{
-				auto geom = surface->geometry();
-				auto xyzBuffer = geom->vertexBuffer("position");
-				auto attr = xyzBuffer->attribute("position");
-				auto offset = std::get<2>(*attr);
-
-				for (uint i = 0; i < xyzBuffer->numVertices(); ++i)
-				{
-					auto x = xyzBuffer->data()[i * xyzBuffer->vertexSize() + offset];
-					auto y = xyzBuffer->data()[i * xyzBuffer->vertexSize() + offset + 1];
-					auto z = xyzBuffer->data()[i * xyzBuffer->vertexSize() + offset + 2];
-
-					if (x < min->x())
-						min->x(x);
-					if (x > max->x())
-						max->x(x);
-
-					if (y < min->y())
-						min->y(y);
-					if (y > max->y())
-						max->y(y);
-
-					if (z < min->z())
-						min->z(z);
-					if (z > max->z())
-						max->z(z);
-				}
+				auto box = surface->geometry()->boundingBox();
+
+				min->setTo(
+					std::min(min->x(), box->bottomLeft()->x()),
+					std::min(min->y(), box->bottomLeft()->y()),
+					std::min(min->z(), box->bottomLeft()->z())
+				);
+				max->setTo(
+					std::max(max->x(), box->topRight()->x()),
+					std::max(max->y(), box->topRight()->y()),
+					std::max(max->z(), box->topRight()->z())
+				);
 			}
-
-			_box->bottomLeft()->copyFrom(min);
-			_box->topRight()->copyFrom(max);
 		}
 		else
 		{
@@ -170,38 +153,7 @@ BoundingBox::updateWorldSpaceBox()
 	else
 	{
 		auto t = targets()[0]->data()->get<Matrix4x4::Ptr>("transform.modelToWorldMatrix");
-		auto vertices = _box->getVertices();
-
-		for (auto& vertex : vertices)
-			t->transform(vertex, vertex);
 
-		auto max = _worldSpaceBox->topRight()->setTo(
-			-std::numeric_limits<float>::max(),
-			-std::numeric_limits<float>::max(),
-			-std::numeric_limits<float>::max()
-		);
-		auto min = _worldSpaceBox->bottomLeft()->setTo(
-			std::numeric_limits<float>::max(),
-			std::numeric_limits<float>::max(),
-			std::numeric_limits<float>::max()
-		);
-
-		for (auto& vertex : vertices)
-		{
-			if (vertex->x() > max->x())
-				max->x(vertex->x());
-			if (vertex->x() < min->x())
-				min->x(vertex->x());
-
-			if (vertex->y() > max->y())
-				max->y(vertex->y());
-			if (vertex->y() < min->y())
-				min->y(vertex->y());
-
-			if (vertex->z() > max->z())
-				max->z(vertex->z());
-			if (vertex->z() < min->z())
-				min->z(vertex->z());
-		}
+		_box->transform(t, _worldSpaceBox);
 	}
 }
@@ -0,0 +1,586 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/component/ClusteredLighting.hpp"
+
+#include "minko/scene/Node.hpp"
+#include "minko/scene/NodeSet.hpp"
+#include "minko/component/SceneManager.hpp"
+#include "minko/component/PerspectiveCamera.hpp"
+#include "minko/component/PointLight.hpp"
+#include "minko/component/SpotLight.hpp"
+#include "minko/component/LightCulling.hpp"
+#include "minko/data/Container.hpp"
+#include "minko/data/StructureProvider.hpp"
+#include "minko/render/Texture.hpp"
+#include "minko/render/AbstractTexture.hpp"
+#include "minko/math/Matrix4x4.hpp"
+#include "minko/math/Vector3.hpp"
+#include "minko/math/Vector4.hpp"
+
+#include "../math/SIMD.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::math;
+
+const uint ClusteredLighting::NUM_TILES_X					= 16;
+const uint ClusteredLighting::NUM_TILES_Y					= 8;
+const uint ClusteredLighting::NUM_SLICES					= 16;
+const uint ClusteredLighting::MAX_NUM_LIGHTS_PER_CLUSTER	= 32;
+const uint ClusteredLighting::MAX_NUM_LIGHTS				= 256;
+const uint ClusteredLighting::MAX_NUM_LIGHT_INDICES			= 16384;
+const uint ClusteredLighting::NUM_LIGHT_ROWS				= 16;
+const uint ClusteredLighting::INDICES_TEXTURE_WIDTH			= 256;
+
+// sets in mask the bits of the clusters in [0, numClusters) whose bounds intersect the sphere
+static
+void
+testSphere(const float*	bounds[6],
+		   uint			numClusters,
+		   float		x,
+		   float		y,
+		   float		z,
+		   float		squaredRadius,
+		   uint*		mask)
+{
+	const float* minX = bounds[0];
+	const float* maxX = bounds[1];
+	const float* minY = bounds[2];
+	const float* maxY = bounds[3];
+	const float* minZ = bounds[4];
+	const float* maxZ = bounds[5];
+	uint i = 0;
+
+#if defined(MINKO_SIMD_SSE)
+	const __m128 vx		= _mm_set1_ps(x);
+	const __m128 vy		= _mm_set1_ps(y);
+	const __m128 vz		= _mm_set1_ps(z);
+	const __m128 vr		= _mm_set1_ps(squaredRadius);
+	const __m128 zero	= _mm_setzero_ps();
+
+	for (; i + 4 <= numClusters; i += 4)
+	{
+		__m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(minX + i), vx), _mm_sub_ps(vx, _mm_loadu_ps(maxX + i))), zero);
+		__m128 dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(minY + i), vy), _mm_sub_ps(vy, _mm_loadu_ps(maxY + i))), zero);
+		__m128 dz = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(minZ + i), vz), _mm_sub_ps(vz, _mm_loadu_ps(maxZ + i))), zero);
+		__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+		mask[i >> 5] |= uint(_mm_movemask_ps(_mm_cmple_ps(distance, vr))) << (i & 31);
+	}
+#elif defined(MINKO_SIMD_NEON)
+	const float32x4_t	vx		= vdupq_n_f32(x);
+	const float32x4_t	vy		= vdupq_n_f32(y);
+	const float32x4_t	vz		= vdupq_n_f32(z);
+	const float32x4_t	vr		= vdupq_n_f32(squaredRadius);
+	const float32x4_t	zero	= vdupq_n_f32(0.f);
+	static const uint32_t bitsData[4] = { 1, 2, 4, 8 };
+	const uint32x4_t	bits	= vld1q_u32(bitsData);
+
+	for (; i + 4 <= numClusters; i += 4)
+	{
+		float32x4_t dx = vmaxq_f32(vmaxq_f32(vsubq_f32(vld1q_f32(minX + i), vx), vsubq_f32(vx, vld1q_f32(maxX + i))), zero);
+		float32x4_t dy = vmaxq_f32(vmaxq_f32(vsubq_f32(vld1q_f32(minY + i), vy), vsubq_f32(vy, vld1q_f32(maxY + i))), zero);
+		float32x4_t dz = vmaxq_f32(vmaxq_f32(vsubq_f32(vld1q_f32(minZ + i), vz), vsubq_f32(vz, vld1q_f32(maxZ + i))), zero);
+		float32x4_t distance = vmlaq_f32(vmlaq_f32(vmulq_f32(dx, dx), dy, dy), dz, dz);
+
+		uint32x4_t inside = vandq_u32(vcleq_f32(distance, vr), bits);
+		uint32x2_t sum = vadd_u32(vget_low_u32(inside), vget_high_u32(inside));
+
+		mask[i >> 5] |= (vget_lane_u32(sum, 0) | vget_lane_u32(sum, 1)) << (i & 31);
+	}
+#endif
+
+	for (; i < numClusters; ++i)
+	{
+		auto dx = std::max(0.f, std::max(minX[i] - x, x - maxX[i]));
+		auto dy = std::max(0.f, std::max(minY[i] - y, y - maxY[i]));
+		auto dz = std::max(0.f, std::max(minZ[i] - z, z - maxZ[i]));
+
+		if (dx * dx + dy * dy + dz * dz <= squaredRadius)
+			mask[i >> 5] |= 1u << (i & 31);
+	}
+}
+
+ClusteredLighting::ClusteredLighting(std::shared_ptr<render::AbstractContext> context) :
+	_context(context),
+	_data(data::StructureProvider::create("lightClusters")),
+	_root(nullptr),
+	_camera(nullptr),
+	_pointLights(),
+	_spotLights(),
+	_invalidLights(false),
+	_grid(Vector3::create((float)NUM_TILES_X, (float)NUM_TILES_Y, (float)NUM_SLICES)),
+	_projection(Vector4::create(1.f, 1.f, 1.f, 1.f)),
+	_textureSizes(Vector4::create(
+		(float)INDICES_TEXTURE_WIDTH,
+		(float)(MAX_NUM_LIGHT_INDICES / INDICES_TEXTURE_WIDTH),
+		(float)MAX_NUM_LIGHTS,
+		(float)NUM_LIGHT_ROWS
+	)),
+	_fov(0.f),
+	_aspectRatio(0.f),
+	_zNear(0.f),
+	_zFar(0.f),
+	_clusterNumLights(NUM_TILES_X * NUM_TILES_Y * NUM_SLICES, 0),
+	_clusterLights(NUM_TILES_X * NUM_TILES_Y * NUM_SLICES * MAX_NUM_LIGHTS_PER_CLUSTER, 0),
+	_sliceMask((NUM_TILES_X * NUM_TILES_Y + 31) / 32, 0),
+	_numLights(0),
+	_numLightIndices(0)
+{
+	for (auto& bounds : _clusterBounds)
+		bounds.resize(NUM_TILES_X * NUM_TILES_Y * NUM_SLICES, 0.f);
+}
+
+void
+ClusteredLighting::initialize()
+{
+	// power of 2 sizes, read texel by texel with nearest filtering
+	_clusterMap = render::Texture::create(_context, NUM_TILES_X * NUM_TILES_Y, NUM_SLICES);
+	_lightIndices = render::Texture::create(
+		_context, INDICES_TEXTURE_WIDTH, MAX_NUM_LIGHT_INDICES / INDICES_TEXTURE_WIDTH
+	);
+	_lights = render::Texture::create(_context, MAX_NUM_LIGHTS, NUM_LIGHT_ROWS);
+
+	for (auto& texture : { _clusterMap, _lightIndices, _lights })
+		texture->data().resize(texture->width() * texture->height() * 4, 0);
+
+	_data
+		->set<render::AbstractTexture::Ptr>("clusterMap",	_clusterMap)
+		->set<render::AbstractTexture::Ptr>("lightIndices",	_lightIndices)
+		->set<render::AbstractTexture::Ptr>("lights",		_lights)
+		->set("grid",										_grid)
+		->set("projection",									_projection)
+		->set("textureSizes",								_textureSizes);
+
+	_targetAddedSlot = targetAdded()->connect(std::bind(
+		&ClusteredLighting::targetAddedHandler,
+		shared_from_this(),
+		std::placeholders::_1,
+		std::placeholders::_2
+	));
+
+	_targetRemovedSlot = targetRemoved()->connect(std::bind(
+		&ClusteredLighting::targetRemovedHandler,
+		shared_from_this(),
+		std::placeholders::_1,
+		std::placeholders::_2
+	));
+}
+
+void
+ClusteredLighting::targetAddedHandler(AbsCtrlPtr ctrl, NodePtr target)
+{
+	if (targets().size() > 1)
+		throw std::logic_error("ClusteredLighting cannot have more than one target.");
+	if (!target->hasComponent<PerspectiveCamera>())
+		throw std::logic_error("ClusteredLighting must be added to a camera.");
+
+	_camera = target->component<PerspectiveCamera>();
+	target->data()->addProvider(_data);
+
+	auto rootChanged = [this](NodePtr node, NodePtr target, NodePtr ancestor)
+	{
+		setRoot(node->root());
+	};
+
+	_targetAddedToNodeSlot = target->added()->connect(rootChanged);
+	_targetRemovedFromNodeSlot = target->removed()->connect(rootChanged);
+
+	setRoot(target->root());
+}
+
+void
+ClusteredLighting::targetRemovedHandler(AbsCtrlPtr ctrl, NodePtr target)
+{
+	_targetAddedToNodeSlot = nullptr;
+	_targetRemovedFromNodeSlot = nullptr;
+
+	target->data()->removeProvider(_data);
+	_camera = nullptr;
+
+	setRoot(nullptr);
+}
+
+void
+ClusteredLighting::setRoot(NodePtr root)
+{
+	if (root == _root)
+		return;
+
+	_root = root;
+	_invalidLights = true;
+
+	if (!root)
+	{
+		_addedSlot = nullptr;
+		_removedSlot = nullptr;
+		_componentAddedSlot = nullptr;
+		_componentRemovedSlot = nullptr;
+		setSceneManager(nullptr);
+		_pointLights.clear();
+		_spotLights.clear();
+
+		return;
+	}
+
+	auto invalidate = [this](NodePtr, NodePtr, NodePtr)
+	{
+		_invalidLights = true;
+	};
+
+	_addedSlot = root->added()->connect(invalidate);
+	_removedSlot = root->removed()->connect(invalidate);
+	_componentAddedSlot = root->componentAdded()->connect([this](NodePtr node, NodePtr target, AbsCtrlPtr ctrl)
+	{
+		auto sceneManager = std::dynamic_pointer_cast<SceneManager>(ctrl);
+
+		if (sceneManager)
+			setSceneManager(sceneManager);
+
+		_invalidLights = true;
+	});
+	_componentRemovedSlot = root->componentRemoved()->connect([this](NodePtr node, NodePtr target, AbsCtrlPtr ctrl)
+	{
+		if (std::dynamic_pointer_cast<SceneManager>(ctrl))
+			setSceneManager(nullptr);
+
+		_invalidLights = true;
+	});
+
+	setSceneManager(root->component<SceneManager>());
+}
+
+void
+ClusteredLighting::setSceneManager(SceneManagerPtr sceneManager)
+{
+	// after frameBegin(), when the camera and the lights of the frame are up to date
+	if (sceneManager)
+		_cullingBeginSlot = sceneManager->cullingBegin()->connect(std::bind(
+			&ClusteredLighting::update,
+			shared_from_this()
+		));
+	else
+		_cullingBeginSlot = nullptr;
+}
+
+void
+ClusteredLighting::bindLights()
+{
+	_invalidLights = false;
+	_pointLights.clear();
+	_spotLights.clear();
+
+	if (!_root)
+		return;
+
+	scene::NodeSet::visitDescendants(
+		_root,
+		[&](const NodePtr& descendant)
+		{
+			for (auto& light : descendant->components<PointLight>())
+				_pointLights.push_back(light);
+			for (auto& light : descendant->components<SpotLight>())
+				_spotLights.push_back(light);
+		},
+		true
+	);
+}
+
+void
+ClusteredLighting::updateClusterBounds()
+{
+	_fov = _camera->fieldOfView();
+	_aspectRatio = _camera->aspectRatio();
+	_zNear = _camera->zNear();
+	_zFar = _camera->zFar();
+
+	const auto tanHalfFov	= tanf(_fov * .5f);
+	const auto xScale		= 1.f / (tanHalfFov * _aspectRatio);
+	const auto yScale		= 1.f / tanHalfFov;
+	const auto numTiles		= NUM_TILES_X * NUM_TILES_Y;
+
+	_projection->setTo(xScale, yScale, _zNear, (float)NUM_SLICES / logf(_zFar / _zNear));
+
+	for (uint z = 0; z < NUM_SLICES; ++z)
+	{
+		// exponential slices keep the clusters about as deep as they are wide
+		auto nearDepth	= _zNear * powf(_zFar / _zNear, (float)z / (float)NUM_SLICES);
+		auto farDepth	= _zNear * powf(_zFar / _zNear, (float)(z + 1) / (float)NUM_SLICES);
+
+		for (uint y = 0; y < NUM_TILES_Y; ++y)
+			for (uint x = 0; x < NUM_TILES_X; ++x)
+			{
+				auto cluster	= z * numTiles + y * NUM_TILES_X + x;
+				auto left		= (-1.f + 2.f * (float)x / (float)NUM_TILES_X) / xScale;
+				auto right		= (-1.f + 2.f * (float)(x + 1) / (float)NUM_TILES_X) / xScale;
+				auto bottom		= (-1.f + 2.f * (float)y / (float)NUM_TILES_Y) / yScale;
+				auto top		= (-1.f + 2.f * (float)(y + 1) / (float)NUM_TILES_Y) / yScale;
+
+				_clusterBounds[0][cluster] = std::min(left * nearDepth, left * farDepth);
+				_clusterBounds[1][cluster] = std::max(right * nearDepth, right * farDepth);
+				_clusterBounds[2][cluster] = std::min(bottom * nearDepth, bottom * farDepth);
+				_clusterBounds[3][cluster] = std::max(top * nearDepth, top * farDepth);
+				_clusterBounds[4][cluster] = -farDepth;
+				_clusterBounds[5][cluster] = -nearDepth;
+			}
+	}
+}
+
+void
+ClusteredLighting::update()
+{
+	if (!_camera || !_root)
+		return;
+
+	if (_invalidLights)
+		bindLights();
+
+	if (_fov != _camera->fieldOfView() || _aspectRatio != _camera->aspectRatio()
+		|| _zNear != _camera->zNear() || _zFar != _camera->zFar())
+		updateClusterBounds();
+
+	auto data				= targets()[0]->data();
+	auto view				= data->get<Matrix4x4::Ptr>("camera.viewMatrix");
+	auto cameraPosition		= data->get<Vector3::Ptr>("camera.position");
+	auto viewPosition		= Vector3::create();
+	auto relativePosition	= Vector3::create();
+
+	std::fill(_clusterNumLights.begin(), _clusterNumLights.end(), 0);
+	_numLights = 0;
+
+	// the disabled lights are left out: only the number of lights and the packed data change
+	for (auto& light : _pointLights)
+	{
+		if (_numLights == MAX_NUM_LIGHTS)
+			break;
+		if (!light->enabled())
+			continue;
+
+		auto attenuationCoeffs = light->attenuationCoefficients();
+
+		relativePosition->copyFrom(light->worldPosition())->subtract(cameraPosition);
+		packLight(_numLights, light, relativePosition, attenuationCoeffs, nullptr);
+		view->transform(light->worldPosition(), viewPosition);
+		addLight(_numLights++, viewPosition, LightCulling::range(attenuationCoeffs));
+	}
+
+	for (auto& light : _spotLights)
+	{
+		if (_numLights == MAX_NUM_LIGHTS)
+			break;
+		if (!light->enabled())
+			continue;
+
+		auto attenuationCoeffs = light->attenuationCoefficients();
+
+		relativePosition->copyFrom(light->worldPosition())->subtract(cameraPosition);
+		packLight(_numLights, light, relativePosition, attenuationCoeffs, light);
+		view->transform(light->worldPosition(), viewPosition);
+		addLight(_numLights++, viewPosition, LightCulling::range(attenuationCoeffs));
+	}
+
+	packClusters();
+
+	_clusterMap->upload();
+	_lightIndices->upload();
+	_lights->upload();
+}
+
+void
+ClusteredLighting::addLight(uint lightId, Vector3::Ptr position, float radius)
+{
+	const auto numTiles = NUM_TILES_X * NUM_TILES_Y;
+
+	auto addToCluster = [&](uint cluster)
+	{
+		auto& numLights = _clusterNumLights[cluster];
+
+		// the lights past the capacity of a cluster are dropped
+		if (numLights < MAX_NUM_LIGHTS_PER_CLUSTER)
+			_clusterLights[cluster * MAX_NUM_LIGHTS_PER_CLUSTER + numLights++] = (unsigned short)lightId;
+	};
+
+	if (radius == FLT_MAX)
+	{
+		for (uint cluster = 0; cluster < numTiles * NUM_SLICES; ++cluster)
+			addToCluster(cluster);
+
+		return;
+	}
+
+	const auto depth		= -position->z();
+	const auto minDepth		= depth - radius;
+	const auto maxDepth		= depth + radius;
+	const auto sliceScale	= _projection->w();
+
+	if (maxDepth < _zNear || minDepth > _zFar)
+		return;
+
+	auto sliceOf = [&](float d)
+	{
+		return d <= _zNear ? 0u : std::min(NUM_SLICES - 1, (uint)(logf(d / _zNear) * sliceScale));
+	};
+
+	for (uint z = sliceOf(minDepth), lastSlice = sliceOf(maxDepth); z <= lastSlice; ++z)
+	{
+		const auto		first		= z * numTiles;
+		const float*	bounds[6]	= {
+			&_clusterBounds[0][first], &_clusterBounds[1][first], &_clusterBounds[2][first],
+			&_clusterBounds[3][first], &_clusterBounds[4][first], &_clusterBounds[5][first]
+		};
+
+		std::fill(_sliceMask.begin(), _sliceMask.end(), 0);
+		testSphere(bounds, numTiles, position->x(), position->y(), position->z(), radius * radius, &_sliceMask[0]);
+
+		for (uint tile = 0; tile < numTiles; ++tile)
+			if (_sliceMask[tile >> 5] & (1u << (tile & 31)))
+				addToCluster(first + tile);
+	}
+}
+
+void
+ClusteredLighting::packLight(uint									lightId,
+							 std::shared_ptr<AbstractDiscreteLight>	light,
+							 Vector3::Ptr							position,
+							 Vector3::Ptr							attenuationCoeffs,
+							 SpotLight::Ptr							spotLight)
+{
+	auto& data = _lights->data();
+
+	// one texel per row holds 2 half floats
+	auto setTexel = [&](uint row, float a, float b)
+	{
+		auto texel	= &data[(row * MAX_NUM_LIGHTS + lightId) * 4];
+		auto ha		= packHalf(a);
+		auto hb		= packHalf(b);
+
+		texel[0] = (unsigned char)(ha >> 8);
+		texel[1] = (unsigned char)(ha & 0xff);
+		texel[2] = (unsigned char)(hb >> 8);
+		texel[3] = (unsigned char)(hb & 0xff);
+	};
+
+	auto color = light->color();
+
+	// positions are relative to the camera so that their precision is best near it
+	setTexel(0, position->x(), position->y());
+	setTexel(1, position->z(), light->diffuse());
+	setTexel(2, light->specular(), attenuationCoeffs->x());
+	setTexel(3, attenuationCoeffs->y(), attenuationCoeffs->z());
+	setTexel(4, color->x(), color->y());
+	setTexel(5, color->z(), spotLight ? 1.f : 0.f);
+
+	if (spotLight)
+	{
+		auto direction = spotLight->worldDirection();
+
+		setTexel(6, direction->x(), direction->y());
+		setTexel(7, direction->z(), spotLight->cosInnerConeAngle());
+		setTexel(8, spotLight->cosOuterConeAngle(), 0.f);
+	}
+}
+
+void
+ClusteredLighting::packClusters()
+{
+	auto&	clusterMap		= _clusterMap->data();
+	auto&	lightIndices	= _lightIndices->data();
+	uint	offset			= 0;
+
+	for (uint cluster = 0; cluster < _clusterNumLights.size(); ++cluster)
+	{
+		auto numLights		= std::min(_clusterNumLights[cluster], MAX_NUM_LIGHT_INDICES - offset);
+		auto clusterTexel	= &clusterMap[cluster * 4];
+
+		clusterTexel[0] = (unsigned char)(offset & 0xff);
+		clusterTexel[1] = (unsigned char)(offset >> 8);
+		clusterTexel[2] = (unsigned char)numLights;
+		clusterTexel[3] = 0;
+
+		for (uint i = 0; i < numLights; ++i)
+		{
+			auto lightId	= _clusterLights[cluster * MAX_NUM_LIGHTS_PER_CLUSTER + i];
+			auto indexTexel	= &lightIndices[(offset + i) * 4];
+
+			indexTexel[0] = (unsigned char)(lightId & 0xff);
+			indexTexel[1] = (unsigned char)(lightId >> 8);
+		}
+
+		offset += numLights;
+	}
+
+	_numLightIndices = offset;
+}
+
+uint
+ClusteredLighting::numClusterLights(uint x, uint y, uint z) const
+{
+	if (x >= NUM_TILES_X || y >= NUM_TILES_Y || z >= NUM_SLICES)
+		throw std::invalid_argument("cluster");
+
+	return _clusterNumLights[(z * NUM_TILES_Y + y) * NUM_TILES_X + x];
+}
+
+unsigned short
+ClusteredLighting::packHalf(float value)
+{
+	// 1 sign bit, 5 exponent bits and 10 mantissa bits, decoded by LightClusters.function.glsl
+	unsigned short	sign		= value < 0.f ? 0x8000 : 0;
+	float			magnitude	= std::min(fabsf(value), 65504.f);
+	int				exponent	= 0;
+	float			mantissa	= frexpf(magnitude, &exponent);
+
+	if (magnitude == 0.f)
+		return sign;
+
+	exponent += 14;
+
+	// subnormal values are multiples of 2^-24, rounding up to 1024 gives the smallest normal value
+	if (exponent <= 0)
+		return sign | (unsigned short)floorf(magnitude * 16777216.f + .5f);
+
+	auto bits = (uint)floorf((mantissa * 2.f - 1.f) * 1024.f + .5f);
+
+	if (bits == 1024)
+	{
+		bits = 0;
+		++exponent;
+	}
+	if (exponent >= 31)
+	{
+		exponent = 30;
+		bits = 1023;
+	}
+
+	return sign | (unsigned short)(exponent << 10) | (unsigned short)bits;
+}
+
+float
+ClusteredLighting::unpackHalf(unsigned short value)
+{
+	auto sign		= (value & 0x8000) ? -1.f : 1.f;
+	auto exponent	= (int)((value >> 10) & 0x1f);
+	auto mantissa	= (float)(value & 0x3ff);
+
+	return exponent == 0
+		? sign * mantissa * powf(2.f, -24.f)
+		: sign * (1.f + mantissa / 1024.f) * powf(2.f, (float)(exponent - 15));
+}
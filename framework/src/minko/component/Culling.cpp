@@ -23,20 +23,64 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/math/Frustum.hpp"
 #include "minko/scene/NodeSet.hpp"
 #include "minko/math/OctTree.hpp"
+#include "minko/math/OcclusionBuffer.hpp"
+#include "minko/math/Matrix4x4.hpp"
 #include "minko/math/Vector3.hpp"
 #include "minko/component/PerspectiveCamera.hpp"
 #include "minko/component/SceneManager.hpp"
 #include "minko/component/Surface.hpp"
 #include "minko/component/Renderer.hpp"
+#include "minko/component/Transform.hpp"
+#include "minko/component/BoundingBox.hpp"
+#include "minko/component/LOD.hpp"
+#include "minko/component/Impostor.hpp"
+#include "minko/component/AbstractAnimation.hpp"
+#include "minko/geometry/Geometry.hpp"
+#include "minko/render/VertexBuffer.hpp"
+#include "minko/render/IndexBuffer.hpp"
+#include "minko/render/Program.hpp"
+#include "minko/render/Shader.hpp"
+#include "minko/render/ProgramInputs.hpp"
+#include "minko/render/AbstractContext.hpp"
+#include "minko/render/CompareMode.hpp"
+#include "minko/render/TriangleCulling.hpp"
+#include "minko/file/AssetLibrary.hpp"
+#include "minko/math/Box.hpp"
+#include "minko/Profiler.hpp"
 
 using namespace minko;
 using namespace minko::component;
 
-std::shared_ptr<math::OctTree>	Culling::_octTree;
+static const std::string BOX_VERTEX_SHADER =
+	"attribute vec3 position;\n"
+	"uniform mat4 worldToScreenMatrix;\n"
+	"uniform vec3 boxMin;\n"
+	"uniform vec3 boxMax;\n"
+	"void main()\n"
+	"{\n"
+	"	gl_Position = worldToScreenMatrix * vec4(mix(boxMin, boxMax, position), 1.0);\n"
+	"}\n";
+
+static const std::string BOX_FRAGMENT_SHADER =
+	"#ifdef GL_ES\n"
+	"precision mediump float;\n"
+	"#endif\n"
+	"void main()\n"
+	"{\n"
+	"	gl_FragColor = vec4(1.0);\n"
+	"}\n";
 
 Culling::Culling(ShapePtr shape, std::string bindProperty):
 _frustum(shape),
-_bindProperty(bindProperty)
+_occlusionBuffer(math::OcclusionBuffer::create()),
+_occlusionQueriesEnabled(false),
+_occlusionQueryInterval(4),
+_occlusionQueryMinNumTriangles(256),
+_occlusionFrame(0),
+_nextOcclusionPhase(0),
+_bindProperty(bindProperty),
+_frustumReady(false),
+_cullingRevision(0)
 {
 }
 
@@ -60,11 +104,6 @@ Culling::targetAddedHandler(AbstractComponent::Ptr ctrl, NodePtr target)
 		throw std::logic_error("Culling must be added to a camera");
 
 
-	// compute scene bounding box
-
-	if (_octTree == nullptr)
-		_octTree = math::OctTree::create(50, 7, math::Vector3::create(0, 0, 0));
-	
 	if (target->root()->hasComponent<SceneManager>())
 		targetAddedToScene(nullptr, target, nullptr);
 	else
@@ -86,8 +125,10 @@ Culling::targetAddedHandler(AbstractComponent::Ptr ctrl, NodePtr target)
 void
 Culling::targetRemovedHandler(AbstractComponent::Ptr ctrl, NodePtr target)
 {
-	_addedSlot			= nullptr;
-	_layoutChangedSlot	= nullptr;
+	_addedSlot					= nullptr;
+	_layoutChangedSlot			= nullptr;
+	_modelToWorldChangedSlot	= nullptr;
+	_octTree					= nullptr;
 }
 
 void
@@ -96,6 +137,7 @@ Culling::targetAddedToScene(NodePtr node, NodePtr target, NodePtr ancestor)
 	if (target->root()->hasComponent<SceneManager>())
 	{
 		_addedToSceneSlot = nullptr;
+		_octTree = target->root()->component<SceneManager>()->octTree();
 
 		_layoutChangedSlot = target->root()->layoutsChanged()->connect(std::bind(
 			&Culling::layoutChanged,
@@ -111,19 +153,37 @@ Culling::targetAddedToScene(NodePtr node, NodePtr target, NodePtr ancestor)
 			std::placeholders::_2,
 			std::placeholders::_3
 		));
+
+		// one batch per frame instead of one callback per moving node
+		auto rootTransform = target->root()->component<Transform::RootTransform>();
+
+		if (rootTransform)
+			_modelToWorldChangedSlot = rootTransform->modelToWorldChanged()->connect(
+				[&](Transform::RootTransform::Ptr rootTransform, const std::vector<NodePtr>& nodes)
+				{
+					_octTree->nodesModelToWorldChanged(nodes);
+					_octTree->update();
+
+					// only nodes that changed octant can change visibility, unless they can hide each other
+					if (_frustumReady && (_cullingRevision != _octTree->revision() || !_occluders.empty()))
+						cull();
+				}
+			);
 	}
 }
 
 void
 Culling::addedHandler(NodePtr node, NodePtr target, NodePtr ancestor)
 {
-	scene::NodeSet::Ptr nodeSet = scene::NodeSet::create(target)->descendants(true)->where([](NodePtr descendant)
-	{
-		return (descendant->layouts() & (1u << 17)) != 0;
-	});
-
-	for (auto n : nodeSet->nodes())
-		_octTree->insert(n);
+	scene::NodeSet::visitDescendants(
+		target,
+		[&](const NodePtr& descendant)
+		{
+			if ((descendant->layouts() & (1u << 17)) != 0)
+				_octTree->insert(descendant);
+		},
+		true
+	);
 }
 
 void
@@ -132,24 +192,423 @@ Culling::layoutChanged(NodePtr node, NodePtr target)
 	if (target->layouts() & (1u << 17))
 		_octTree->insert(target);
 	else
+	{
 		_octTree->remove(target);
+
+		auto queryIt = _occlusionQueries.find(target);
+
+		if (queryIt != _occlusionQueries.end())
+		{
+			if (queryIt->second.query != -1)
+				_boxProgram->context()->deleteOcclusionQuery(queryIt->second.query);
+			_occlusionQueries.erase(queryIt);
+		}
+	}
 }
 
 void
 Culling::worldToScreenChanged(std::shared_ptr<data::Container> data, const std::string& propertyName)
 {
-	_frustum->updateFromMatrix(data->get<std::shared_ptr<math::Matrix4x4>>(propertyName));
-	
-	auto renderer = targets()[0]->component<Renderer>();
+	if (!_octTree)
+		return;
+
+	_worldToScreen = data->get<std::shared_ptr<math::Matrix4x4>>(propertyName);
+	_frustum->updateFromMatrix(_worldToScreen);
+	_frustumReady = true;
+	_octTree->update();
+
+	cull();
+}
+
+Culling::Ptr
+Culling::addOccluder(NodePtr node)
+{
+	if (std::find(_occluders.begin(), _occluders.end(), node) == _occluders.end())
+		_occluders.push_back(node);
+
+	return shared_from_this();
+}
+
+Culling::Ptr
+Culling::removeOccluder(NodePtr node)
+{
+	auto it = std::find(_occluders.begin(), _occluders.end(), node);
+
+	if (it == _occluders.end())
+		throw std::invalid_argument("node");
+
+	_occluders.erase(it);
+
+	return shared_from_this();
+}
+
+Culling::Ptr
+Culling::addRenderer(RendererPtr renderer)
+{
+	if (!renderer)
+		throw std::invalid_argument("renderer");
+
+	if (std::find(_renderers.begin(), _renderers.end(), renderer) != _renderers.end())
+		return shared_from_this();
+
+	_renderers.push_back(renderer);
+
+	if (_frustumReady && _octTree)
+		cull();
+
+	return shared_from_this();
+}
+
+Culling::Ptr
+Culling::removeRenderer(RendererPtr renderer)
+{
+	auto it = std::find(_renderers.begin(), _renderers.end(), renderer);
+
+	if (it == _renderers.end())
+		throw std::invalid_argument("renderer");
+
+	_renderers.erase(it);
+
+	// the surfaces culled for the camera are shown again to this renderer
+	if (!targets().empty())
+		scene::NodeSet::visitDescendants(
+			targets()[0]->root(),
+			[&](const NodePtr& descendant)
+			{
+				for (auto& surface : descendant->components<Surface>())
+					surface->computedVisibility(renderer, true);
+			},
+			true
+		);
+
+	return shared_from_this();
+}
+
+Culling::Ptr
+Culling::occlusionQueries(bool enabled)
+{
+	if (enabled == _occlusionQueriesEnabled)
+		return shared_from_this();
+
+	_occlusionQueriesEnabled = enabled;
+
+	if (!enabled)
+	{
+		_beforePresentSlot = nullptr;
+		releaseOcclusionQueries(true);
+	}
+
+	// the nodes hidden by a query are only shown again by the next culling
+	if (_frustumReady && _octTree)
+		cull();
+
+	return shared_from_this();
+}
+
+Culling::Ptr
+Culling::occlusionQueryInterval(uint interval)
+{
+	if (interval == 0)
+		throw std::invalid_argument("interval");
+
+	_occlusionQueryInterval = interval;
+
+	return shared_from_this();
+}
+
+void
+Culling::cull()
+{
+	MINKO_PROFILE_SCOPE("Culling::cull");
+
+	auto target			= targets()[0];
+	auto renderer		= target->component<Renderer>();
+	auto testOcclusion	= !_occluders.empty();
+	auto eyePosition	= target->data()->get<std::shared_ptr<math::Vector3>>("camera.position");
+	auto projectionScale	= 1.f / tanf(target->component<PerspectiveCamera>()->fieldOfView() * .5f);
+
+	_cullingRevision = _octTree->revision();
+
+	if (testOcclusion)
+		rasterizeOccluders();
+
+	if (_occlusionQueriesEnabled)
+	{
+		// the queries are drawn once the renderer has filled the depth buffer
+		if (!_beforePresentSlot && renderer)
+			_beforePresentSlot = renderer->beforePresent()->connect(std::bind(
+				&Culling::issueOcclusionQueries,
+				shared_from_this(),
+				std::placeholders::_1
+			));
+
+		for (auto& occlusionQuery : _occlusionQueries)
+			occlusionQuery.second.inFrustum = false;
+	}
 
 	_octTree->testFrustum(
 		_frustum, 
 		[&](NodePtr node)
 		{
-			node->component<Surface>()->computedVisibility(renderer, true);
+			auto visible = !testOcclusion
+				|| !node->hasComponent<BoundingBox>()
+				|| std::find(_occluders.begin(), _occluders.end(), node) != _occluders.end()
+				|| !_occlusionBuffer->occluded(node->component<BoundingBox>()->box());
+
+			if (visible && node->hasComponent<LOD>())
+				node->component<LOD>()->update(eyePosition, projectionScale);
+
+			if (visible && node->hasComponent<Impostor>())
+				node->component<Impostor>()->update(eyePosition, projectionScale);
+
+			if (visible && node->hasComponent<AbstractAnimation>())
+			{
+				const auto size = LOD::screenSize(node, eyePosition, projectionScale);
+
+				for (auto& animation : node->components<AbstractAnimation>())
+					animation->screenSize(size);
+			}
+
+			// the nodes entering the frustum are drawn until a query proves they are hidden
+			if (visible && _occlusionQueriesEnabled && occlusionQueryCandidate(node))
+			{
+				auto& occlusionQuery = _occlusionQueries[node];
+
+				if (!occlusionQuery.inFrustum && occlusionQuery.query == -1 && !occlusionQuery.pending)
+					occlusionQuery.phase = _nextOcclusionPhase++;
+				occlusionQuery.inFrustum = true;
+				visible = !occlusionQuery.occluded;
+			}
+
+			setVisibility(node, renderer, visible);
 		},
 		[&](NodePtr node)
 		{
-			node->component<Surface>()->computedVisibility(renderer, false);
+			setVisibility(node, renderer, false);
 		});
-}
\ No newline at end of file
+
+	if (_occlusionQueriesEnabled)
+		releaseOcclusionQueries(false);
+}
+
+void
+Culling::setVisibility(NodePtr node, RendererPtr renderer, bool visible)
+{
+	// the quad of an Impostor is a second surface of the node
+	for (auto& surface : node->components<Surface>())
+	{
+		surface->computedVisibility(renderer, visible);
+		for (auto& sharedRenderer : _renderers)
+			surface->computedVisibility(sharedRenderer, visible);
+	}
+}
+
+void
+Culling::rasterizeOccluders()
+{
+	_occlusionBuffer->clear(_worldToScreen);
+
+	for (auto& occluder : _occluders)
+	{
+		if (!occluder->data()->hasProperty("transform.modelToWorldMatrix"))
+			continue;
+
+		auto modelToWorld = occluder->data()->get<std::shared_ptr<math::Matrix4x4>>("transform.modelToWorldMatrix");
+
+		for (auto& surface : occluder->components<Surface>())
+		{
+			auto geometry = surface->geometry();
+
+			if (!geometry->hasVertexAttribute("position") || !geometry->indices())
+				continue;
+
+			auto vertexBuffer	= geometry->vertexBuffer("position");
+			auto attribute		= vertexBuffer->attribute("position");
+
+			_occlusionBuffer->rasterize(
+				vertexBuffer->data(),
+				vertexBuffer->vertexSize(),
+				std::get<2>(*attribute),
+				geometry->indices()->data(),
+				modelToWorld
+			);
+		}
+	}
+}
+
+bool
+Culling::occlusionQueryCandidate(NodePtr node)
+{
+	if (!node->hasComponent<BoundingBox>())
+		return false;
+
+	uint numTriangles = 0;
+
+	for (auto& surface : node->components<Surface>())
+		if (surface->geometry()->indices())
+			numTriangles += surface->geometry()->indices()->numIndices() / 3;
+
+	return numTriangles >= _occlusionQueryMinNumTriangles;
+}
+
+void
+Culling::issueOcclusionQueries(RendererPtr renderer)
+{
+	// the depth buffer of the upscaled frame is not the one of the scene
+	if (_occlusionQueries.empty() || renderer->dynamicResolution() || !_worldToScreen)
+		return;
+
+	auto target		= targets()[0];
+	auto context	= target->root()->component<SceneManager>()->assets()->context();
+
+	if (!context->supportsOcclusionQueries())
+		return;
+
+	MINKO_PROFILE_SCOPE("Culling::issueOcclusionQueries");
+
+	auto eyePosition	= target->data()->get<std::shared_ptr<math::Vector3>>("camera.position");
+	auto margin			= target->component<PerspectiveCamera>()->zNear() * 2.f;
+	auto drawing		= false;
+
+	++_occlusionFrame;
+
+	for (auto& nodeAndQuery : _occlusionQueries)
+	{
+		auto node			= nodeAndQuery.first;
+		auto& occlusionQuery	= nodeAndQuery.second;
+
+		// pending results are read later instead of stalling the pipeline
+		if (occlusionQuery.pending)
+		{
+			if (!context->isOcclusionQueryAvailable(occlusionQuery.query))
+				continue;
+
+			auto occluded = !context->getOcclusionQueryResult(occlusionQuery.query);
+
+			occlusionQuery.pending = false;
+			if (occluded != occlusionQuery.occluded)
+			{
+				occlusionQuery.occluded = occluded;
+				setVisibility(node, renderer, !occluded);
+			}
+		}
+
+		// temporal coherence: the visible nodes are staggered over the frames of the interval
+		if (!occlusionQuery.occluded && (_occlusionFrame + occlusionQuery.phase) % _occlusionQueryInterval != 0)
+			continue;
+
+		// the faces of a box around the camera are clipped by the near plane
+		auto box = node->component<BoundingBox>()->box();
+
+		if (eyePosition->x() > box->bottomLeft()->x() - margin && eyePosition->x() < box->topRight()->x() + margin
+			&& eyePosition->y() > box->bottomLeft()->y() - margin && eyePosition->y() < box->topRight()->y() + margin
+			&& eyePosition->z() > box->bottomLeft()->z() - margin && eyePosition->z() < box->topRight()->z() + margin)
+		{
+			if (occlusionQuery.occluded)
+			{
+				occlusionQuery.occluded = false;
+				setVisibility(node, renderer, true);
+			}
+
+			continue;
+		}
+
+		if (!drawing)
+		{
+			drawBoundingBox(context, nullptr);
+			drawing = true;
+		}
+
+		if (occlusionQuery.query == -1)
+			occlusionQuery.query = context->createOcclusionQuery();
+
+		context->beginOcclusionQuery(occlusionQuery.query);
+		drawBoundingBox(context, node);
+		context->endOcclusionQuery();
+
+		occlusionQuery.pending = true;
+	}
+
+	// the next draw calls expect the default write masks
+	if (drawing)
+	{
+		context->setColorMask(true);
+		context->setDepthTest(true, render::CompareMode::LESS_EQUAL);
+	}
+}
+
+void
+Culling::drawBoundingBox(std::shared_ptr<render::AbstractContext> context, NodePtr node)
+{
+	if (!_boxProgram)
+	{
+		// a unit cube scaled to each bounding box by the vertex shader
+		std::vector<float> vertices = {
+			0.f, 0.f, 0.f,	1.f, 0.f, 0.f,	1.f, 1.f, 0.f,	0.f, 1.f, 0.f,
+			0.f, 0.f, 1.f,	1.f, 0.f, 1.f,	1.f, 1.f, 1.f,	0.f, 1.f, 1.f
+		};
+		std::vector<unsigned short> indices = {
+			0, 2, 1,	0, 3, 2,	4, 5, 6,	4, 6, 7,
+			0, 1, 5,	0, 5, 4,	3, 6, 2,	3, 7, 6,
+			0, 4, 7,	0, 7, 3,	1, 2, 6,	1, 6, 5
+		};
+
+		_boxVertices = render::VertexBuffer::create(context, std::move(vertices));
+		_boxVertices->addAttribute("position", 3, 0);
+		_boxVertices->upload();
+		_boxIndices = render::IndexBuffer::create(context, indices.begin(), indices.end());
+		_boxIndices->upload();
+
+		_boxProgram = render::Program::create(
+			context,
+			render::Shader::create(context, render::Shader::Type::VERTEX_SHADER, BOX_VERTEX_SHADER),
+			render::Shader::create(context, render::Shader::Type::FRAGMENT_SHADER, BOX_FRAGMENT_SHADER)
+		);
+		_boxProgram->upload();
+	}
+
+	auto inputs = _boxProgram->inputs();
+
+	// the state shared by all the queries of the frame
+	if (!node)
+	{
+		if (context->supportsVertexArrays())
+			context->setVertexArray(0);
+
+		context->setProgram(_boxProgram->id());
+		context->setColorMask(false);
+		context->setDepthTest(false, render::CompareMode::LESS_EQUAL);
+		context->setTriangleCulling(render::TriangleCulling::NONE);
+		context->setVertexBufferAt(inputs->location("position"), _boxVertices->id(), 3, 3, 0);
+		context->setUniform(inputs->location("worldToScreenMatrix"), 1, true, &_worldToScreen->data()[0]);
+
+		return;
+	}
+
+	auto box = node->component<BoundingBox>()->box();
+
+	context->setUniform(
+		inputs->location("boxMin"), box->bottomLeft()->x(), box->bottomLeft()->y(), box->bottomLeft()->z()
+	);
+	context->setUniform(
+		inputs->location("boxMax"), box->topRight()->x(), box->topRight()->y(), box->topRight()->z()
+	);
+	context->drawTriangles(_boxIndices->id(), 12);
+}
+
+void
+Culling::releaseOcclusionQueries(bool all)
+{
+	for (auto queryIt = _occlusionQueries.begin(); queryIt != _occlusionQueries.end();)
+	{
+		if (!all && queryIt->second.inFrustum)
+		{
+			++queryIt;
+			continue;
+		}
+
+		if (queryIt->second.query != -1)
+			_boxProgram->context()->deleteOcclusionQuery(queryIt->second.query);
+		queryIt = _occlusionQueries.erase(queryIt);
+	}
+}
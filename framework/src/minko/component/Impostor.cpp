@@ -0,0 +1,311 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/component/Impostor.hpp"
+
+#include "minko/scene/Node.hpp"
+#include "minko/component/Transform.hpp"
+#include "minko/component/Surface.hpp"
+#include "minko/component/Renderer.hpp"
+#include "minko/component/LOD.hpp"
+#include "minko/geometry/Geometry.hpp"
+#include "minko/material/BasicMaterial.hpp"
+#include "minko/data/StructureProvider.hpp"
+#include "minko/math/Vector3.hpp"
+#include "minko/math/Matrix4x4.hpp"
+#include "minko/render/AbstractContext.hpp"
+#include "minko/render/Texture.hpp"
+#include "minko/render/VertexBuffer.hpp"
+#include "minko/render/IndexBuffer.hpp"
+#include "minko/render/Blending.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::math;
+
+namespace
+{
+	// center xyz, corner offset xy, uv and rgba color, like the quads of the BillboardBatch
+	const uint	IMPOSTOR_VERTEX_SIZE	= 11;
+
+	// corners of the quad in [0, 1], v going down like the uvs of the QuadGeometry
+	const float	IMPOSTOR_CORNERS[8]		= { 0.f, 0.f, 1.f, 0.f, 1.f, 1.f, 0.f, 1.f };
+}
+
+Impostor::Impostor(ContextPtr context, EffectPtr effect, uint numViews, uint viewSize, float screenSize) :
+	_context(context),
+	_effect(effect),
+	_numViews(numViews),
+	_viewSize(viewSize),
+	_screenSize(screenSize),
+	_atlas(nullptr),
+	_material(nullptr),
+	_vertexBuffer(nullptr),
+	_surface(nullptr),
+	_radius(0.f),
+	_active(false),
+	_view(-1)
+{
+	_center[0] = _center[1] = _center[2] = 0.f;
+}
+
+void
+Impostor::initialize()
+{
+	if (!_context)
+		throw std::invalid_argument("context");
+	if (!_effect)
+		throw std::invalid_argument("effect");
+	// the atlas must be a power of two texture to be filtered on every OpenGL ES 2.0 device
+	if (_numViews == 0 || (_numViews & (_numViews - 1)) != 0)
+		throw std::invalid_argument("numViews");
+	if (_viewSize == 0 || (_viewSize & (_viewSize - 1)) != 0)
+		throw std::invalid_argument("viewSize");
+
+	_targetAddedSlot = targetAdded()->connect(std::bind(
+		&Impostor::targetAddedHandler,
+		shared_from_this(),
+		std::placeholders::_1,
+		std::placeholders::_2
+	));
+
+	_targetRemovedSlot = targetRemoved()->connect(std::bind(
+		&Impostor::targetRemovedHandler,
+		shared_from_this(),
+		std::placeholders::_1,
+		std::placeholders::_2
+	));
+}
+
+void
+Impostor::targetAddedHandler(AbsCmpPtr cmp, NodePtr target)
+{
+	if (targets().size() > 1)
+		throw std::logic_error("The same Impostor cannot have 2 different targets");
+
+	if (_surface)
+		target->addComponent(_surface);
+}
+
+void
+Impostor::targetRemovedHandler(AbsCmpPtr cmp, NodePtr target)
+{
+	activate(false);
+
+	if (_surface)
+		target->removeComponent(_surface);
+}
+
+void
+Impostor::bake()
+{
+	if (targets().empty() || !targets()[0]->hasComponent<Surface>())
+		throw std::logic_error("The target of an Impostor must have a Surface.");
+
+	auto target			= targets()[0];
+	auto surface		= target->component<Surface>();
+	auto vertexBuffer	= surface->geometry()->vertexBuffer("position");
+
+	if (!vertexBuffer || vertexBuffer->data().empty())
+		throw std::logic_error("The surface of an Impostor must have vertex positions.");
+
+	auto&		data		= vertexBuffer->data();
+	const uint	vertexSize	= vertexBuffer->vertexSize();
+	const uint	offset		= std::get<2>(*vertexBuffer->attribute("position"));
+	float		bounds[6]	= {
+		std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+		-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max()
+	};
+
+	for (uint i = offset; i + 2 < data.size(); i += vertexSize)
+		for (uint j = 0; j < 3; ++j)
+		{
+			bounds[j] = std::min(bounds[j], data[i + j]);
+			bounds[3 + j] = std::max(bounds[3 + j], data[i + j]);
+		}
+
+	for (uint j = 0; j < 3; ++j)
+		_center[j] = (bounds[j] + bounds[3 + j]) * .5f;
+	_radius = std::max(
+		.5f * sqrtf(
+			(bounds[3] - bounds[0]) * (bounds[3] - bounds[0])
+			+ (bounds[4] - bounds[1]) * (bounds[4] - bounds[1])
+			+ (bounds[5] - bounds[2]) * (bounds[5] - bounds[2])
+		),
+		1e-6f
+	);
+
+	if (!_atlas)
+		_atlas = render::Texture::create(_context, _numViews * _viewSize, _viewSize, false, true);
+
+	// one view per region of the atlas, the orthographic projection of each view is moved to its region
+	auto center		= Vector3::create(_center[0], _center[1], _center[2]);
+	auto camera		= data::StructureProvider::create("camera");
+	auto renderer	= Renderer::create(0x00000000, _atlas);
+	auto r			= _radius;
+	std::vector<Renderer::View> views(_numViews);
+
+	for (uint i = 0; i < _numViews; ++i)
+	{
+		const float angle = 2.f * float(M_PI) * float(i) / float(_numViews);
+
+		views[i].viewMatrix = Matrix4x4::create()->view(
+			center,
+			Vector3::create(_center[0] - sinf(angle), _center[1], _center[2] - cosf(angle)),
+			Vector3::create(0.f, 1.f, 0.f)
+		);
+		views[i].projectionMatrix = Matrix4x4::create()
+			->orthographic(-r, r, r, -r, -r, r)
+			->appendScale(1.f / float(_numViews), 1.f, 1.f)
+			->appendTranslation(-1.f + float(2 * i + 1) / float(_numViews));
+		views[i].region.x		= i * _viewSize;
+		views[i].region.y		= 0;
+		views[i].region.width	= _viewSize;
+		views[i].region.height	= _viewSize;
+	}
+
+	camera
+		->set("viewMatrix",				Matrix4x4::create())
+		->set("projectionMatrix",		Matrix4x4::create())
+		->set("worldToScreenMatrix",	Matrix4x4::create());
+	renderer->views(views);
+
+	auto bakeSurface	= Surface::create(surface->geometry(), surface->material(), surface->effect());
+	auto bakeNode		= scene::Node::create("impostorBake")
+		->addComponent(Transform::create())
+		->addComponent(renderer)
+		->addComponent(bakeSurface);
+
+	bakeNode->data()->addProvider(camera);
+	renderer->render(_context);
+	bakeNode->removeComponent(bakeSurface);
+
+	if (!_surface)
+	{
+		std::vector<float> vertices(4 * IMPOSTOR_VERTEX_SIZE, 1.f);
+		std::vector<unsigned short> indices = { 0, 1, 2, 0, 2, 3 };
+		auto geometry = geometry::Geometry::create();
+
+		_vertexBuffer = render::VertexBuffer::create(_context, std::move(vertices));
+		// the "position" attribute is the center of the quad, expanded in view space by the vertex shader
+		_vertexBuffer->addAttribute("position", 3, 0);
+		_vertexBuffer->addAttribute("offset", 2, 3);
+		_vertexBuffer->addAttribute("uv", 2, 5);
+		_vertexBuffer->addAttribute("color", 4, 7);
+		_vertexBuffer->usage(render::BufferUsage::DYNAMIC);
+		geometry->addVertexBuffer(_vertexBuffer);
+		geometry->indices(render::IndexBuffer::create(_context, indices.begin(), indices.end()));
+		geometry->indices()->upload();
+
+		_material = material::BasicMaterial::create();
+		_material->diffuseMap(_atlas);
+		_material->blendingMode(render::Blending::Mode::ALPHA);
+		// the quads hide each other like the surfaces they replace
+		_material->depthMask(true);
+
+		_surface = Surface::create(geometry, _material, _effect);
+		_surface->visible(false);
+		target->addComponent(_surface);
+	}
+
+	_view = -1;
+}
+
+void
+Impostor::update(std::shared_ptr<Vector3> eyePosition, float projectionScale)
+{
+	if (targets().empty())
+		return;
+
+	auto target = targets()[0];
+
+	if (LOD::screenSize(target, eyePosition, projectionScale) >= _screenSize)
+	{
+		activate(false);
+
+		return;
+	}
+
+	if (!_surface)
+		bake();
+
+	// the direction of the camera in model space selects the view
+	auto eye	= eyePosition;
+	auto scale	= 1.f;
+
+	if (target->data()->hasProperty("transform.modelToWorldMatrix"))
+	{
+		auto modelToWorld = target->data()->get<Matrix4x4::Ptr>("transform.modelToWorldMatrix");
+
+		eye = Matrix4x4::create(modelToWorld)->invert()->transform(eyePosition);
+		scale = modelToWorld->deltaTransform(Vector3::create(1.f, 0.f, 0.f))->length();
+	}
+
+	const float	step	= 2.f * float(M_PI) / float(_numViews);
+	const float	angle	= atan2f(eye->x() - _center[0], eye->z() - _center[2]);
+	const int	view	= (int(floorf(angle / step + .5f)) % int(_numViews) + int(_numViews)) % int(_numViews);
+
+	if (view != _view)
+	{
+		_view = view;
+		writeVertices(scale);
+	}
+
+	activate(true);
+}
+
+void
+Impostor::activate(bool active)
+{
+	if (active == _active)
+		return;
+
+	_active = active;
+
+	if (targets().empty() || !_surface)
+		return;
+
+	targets()[0]->component<Surface>()->visible(!active);
+	_surface->visible(active);
+}
+
+void
+Impostor::writeVertices(float scale)
+{
+	auto&		vertices	= _vertexBuffer->data();
+	const float	size		= 2.f * _radius * scale;
+	const float	u			= float(_view) / float(_numViews);
+
+	for (uint k = 0; k < 4; ++k)
+	{
+		float*		vertex	= &vertices[k * IMPOSTOR_VERTEX_SIZE];
+		const float	cu		= IMPOSTOR_CORNERS[2 * k];
+		const float	cv		= IMPOSTOR_CORNERS[2 * k + 1];
+
+		for (uint i = 0; i < 3; ++i)
+			vertex[i] = _center[i];
+		vertex[3] = (cu - .5f) * size;
+		vertex[4] = (.5f - cv) * size;
+		// the rows of a render target are stored bottom up
+		vertex[5] = u + cu / float(_numViews);
+		vertex[6] = 1.f - cv;
+	}
+
+	_vertexBuffer->upload();
+}
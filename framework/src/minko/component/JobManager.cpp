@@ -22,78 +22,124 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/scene/Node.hpp"
 #include "minko/scene/NodeSet.hpp"
 #include "minko/component/SceneManager.hpp"
+#include "minko/AbstractCanvas.hpp"
+#include "minko/async/ThreadPool.hpp"
 
 using namespace minko;
 using namespace minko::component;
 
-JobManager::Job::Job()
+JobManager::Job::Job() :
+	_running(false),
+	_priority(0.f),
+	_order(0)
 {
-	_running = false;
 }
 
 JobManager::JobManager(unsigned int loadingFramerate):
-	_loadingFramerate(loadingFramerate)
+	_loadingFramerate(loadingFramerate),
+	_numPushedJobs(0),
+	_numAsyncJobs(0)
 {
 	_frameTime = 1.f / loadingFramerate;
 }
 
 JobManager::Ptr
-JobManager::pushJob(Job::Ptr Job)
+JobManager::pushJob(Job::Ptr job)
 {
-	float JobPriority	= Job->priority();
-	bool inserted		= false;
-	uint i				= 0;
-	
-	for (; i < _jobs.size() && inserted; ++i)
-	{
-		if (_jobs[i]->priority() > JobPriority)
-			inserted = true;
-	}
+	job->_priority = job->priority();
+	job->_order = _numPushedJobs++;
 
-	_jobs.insert(_jobs.begin() + i, Job);
+	insertJob(job);
 
 	return std::dynamic_pointer_cast<JobManager>(shared_from_this());
 }
 
+bool
+JobManager::lowerPriority(const Job::Ptr& a, const Job::Ptr& b)
+{
+	return a->_priority < b->_priority || (a->_priority == b->_priority && a->_order > b->_order);
+}
+
+void
+JobManager::insertJob(Job::Ptr job)
+{
+	_jobs.push_back(job);
+	std::push_heap(_jobs.begin(), _jobs.end(), &JobManager::lowerPriority);
+}
+
+void
+JobManager::removeJob(Job::Ptr job)
+{
+	// the step might have pushed jobs with higher priorities
+	if (_jobs.front() == job)
+	{
+		std::pop_heap(_jobs.begin(), _jobs.end(), &JobManager::lowerPriority);
+		_jobs.pop_back();
+	}
+	else
+	{
+		_jobs.erase(std::find(_jobs.begin(), _jobs.end(), job));
+		std::make_heap(_jobs.begin(), _jobs.end(), &JobManager::lowerPriority);
+	}
+}
+
 void
 JobManager::update(NodePtr target)
 {
-	_frameStartTime = std::clock();
+	_frameStartTime = Clock::now();
 }
 
 void
 JobManager::end(NodePtr target)
 {
-	if (_jobs.size() == 0)
-		return;
-
-	float consumeTime	= (float(std::clock() - _frameStartTime) / CLOCKS_PER_SEC);
-	Job::Ptr currentJob	= nullptr;
+	auto that = std::dynamic_pointer_cast<JobManager>(shared_from_this());
+	auto elapsed = [&]()
+	{
+		return std::chrono::duration_cast<std::chrono::duration<float>>(Clock::now() - _frameStartTime).count();
+	};
 
-	while (consumeTime < _frameTime)
+	// the job with the highest priority is stepped each time, so jobs pushed meanwhile can take over
+	while (!_jobs.empty() && elapsed() < _frameTime)
 	{
-		if (currentJob == nullptr)
+		auto job = _jobs.front();
+
+		if (!job->running())
 		{
-			currentJob = _jobs.back();
-			if (!currentJob->running())
-			{
-				currentJob->_jobManager = std::dynamic_pointer_cast<JobManager>(shared_from_this());
-				currentJob->running(true);
-				currentJob->beforeFirstStep();
-			}
+			job->_jobManager = that;
+			job->running(true);
+			job->beforeFirstStep();
 		}
 
-		currentJob->step();
+		job->step();
 
-		if (currentJob->complete())
+		if (job->_asyncTask)
 		{
-			_jobs.pop_back();
-			currentJob->afterLastStep();
-			currentJob = nullptr;
-			if (_jobs.size() == 0)
-				return;
+			auto task = job->_asyncTask;
+			auto canvas = AbstractCanvas::defaultCanvas();
+
+			job->_asyncTask = nullptr;
+			if (canvas)
+			{
+				removeJob(job);
+				++_numAsyncJobs;
+				canvas->threadPool()->run(task, [=]()
+				{
+					--that->_numAsyncJobs;
+					that->insertJob(job);
+				});
+
+				continue;
+			}
+
+			task();
 		}
 
-		consumeTime = (float(std::clock() - _frameStartTime) / CLOCKS_PER_SEC);
+		if (job->complete())
+		{
+			removeJob(job);
+			job->afterLastStep();
+		}
+		else if (job->yieldFrame())
+			return;
 	}
-}
\ No newline at end of file
+}
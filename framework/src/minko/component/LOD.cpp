@@ -0,0 +1,186 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/component/LOD.hpp"
+
+#include "minko/scene/Node.hpp"
+#include "minko/math/Box.hpp"
+#include "minko/math/Vector3.hpp"
+#include "minko/component/Surface.hpp"
+#include "minko/component/BoundingBox.hpp"
+#include "minko/geometry/Geometry.hpp"
+
+using namespace minko;
+using namespace minko::component;
+
+LOD::LOD() :
+	_levels(),
+	_level(-1),
+	_levelChanged(Signal<Ptr, uint>::create())
+{
+}
+
+LOD::Ptr
+LOD::create(GeometryPtr geometry, uint numLevels, float ratio, float screenSize)
+{
+	if (numLevels == 0)
+		throw std::invalid_argument("numLevels");
+	if (ratio <= 0.0f || ratio >= 1.0f)
+		throw std::invalid_argument("ratio");
+
+	auto lod			= create();
+	auto levelGeometry	= geometry;
+
+	lod->addLevel(geometry, screenSize);
+
+	for (uint i = 1; i < numLevels; ++i)
+	{
+		screenSize *= ratio;
+		levelGeometry = levelGeometry->simplify(ratio);
+
+		// the last level is drawn however small the target is
+		lod->addLevel(levelGeometry, i == numLevels - 1 ? 0.0f : screenSize);
+	}
+
+	return lod;
+}
+
+void
+LOD::initialize()
+{
+	_targetAddedSlot = targetAdded()->connect(std::bind(
+		&LOD::targetAddedHandler,
+		shared_from_this(),
+		std::placeholders::_1,
+		std::placeholders::_2
+	));
+
+	_targetRemovedSlot = targetRemoved()->connect(std::bind(
+		&LOD::targetRemovedHandler,
+		shared_from_this(),
+		std::placeholders::_1,
+		std::placeholders::_2
+	));
+}
+
+void
+LOD::targetAddedHandler(AbsCmpPtr cmp, NodePtr target)
+{
+	if (targets().size() > 1)
+		throw std::logic_error("The same LOD cannot have 2 different targets");
+
+	applyLevel();
+}
+
+void
+LOD::targetRemovedHandler(AbsCmpPtr cmp, NodePtr target)
+{
+	_level = -1;
+}
+
+LOD::Ptr
+LOD::addLevel(GeometryPtr geometry, float screenSize)
+{
+	if (geometry == nullptr)
+		throw std::invalid_argument("geometry");
+
+	auto levelIt = std::find_if(_levels.begin(), _levels.end(), [&](const Level& l) { return l.first < screenSize; });
+
+	_levels.insert(levelIt, Level(screenSize, geometry));
+	_level = -1;
+	applyLevel();
+
+	return shared_from_this();
+}
+
+void
+LOD::level(uint value)
+{
+	if (value >= _levels.size())
+		throw std::invalid_argument("value");
+
+	if (_level == int(value))
+		return;
+
+	_level = value;
+	applyLevel();
+	_levelChanged->execute(shared_from_this(), value);
+}
+
+float
+LOD::screenSize(std::shared_ptr<math::Vector3> eyePosition, float projectionScale)
+{
+	if (targets().empty())
+		return std::numeric_limits<float>::max();
+
+	return screenSize(targets()[0], eyePosition, projectionScale);
+}
+
+float
+LOD::screenSize(NodePtr target, std::shared_ptr<math::Vector3> eyePosition, float projectionScale)
+{
+	if (!target->hasComponent<BoundingBox>())
+		return std::numeric_limits<float>::max();
+
+	auto box		= target->component<BoundingBox>()->box();
+	auto topRight	= box->topRight();
+	auto bottomLeft	= box->bottomLeft();
+
+	const float dx = eyePosition->x() - (topRight->x() + bottomLeft->x()) * .5f;
+	const float dy = eyePosition->y() - (topRight->y() + bottomLeft->y()) * .5f;
+	const float dz = eyePosition->z() - (topRight->z() + bottomLeft->z()) * .5f;
+
+	const float radius		= (topRight - bottomLeft)->length() * .5f;
+	const float distance	= sqrtf(dx * dx + dy * dy + dz * dz);
+
+	if (distance <= radius)
+		return std::numeric_limits<float>::max();
+
+	return radius * projectionScale / distance;
+}
+
+void
+LOD::update(std::shared_ptr<math::Vector3> eyePosition, float projectionScale)
+{
+	if (_levels.empty())
+		return;
+
+	const auto	size	= screenSize(eyePosition, projectionScale);
+	uint		level	= 0;
+
+	while (level < _levels.size() - 1 && size < _levels[level].first)
+		++level;
+
+	this->level(level);
+}
+
+void
+LOD::applyLevel()
+{
+	if (targets().empty() || _levels.empty() || !targets()[0]->hasComponent<Surface>())
+		return;
+
+	if (_level < 0)
+		_level = 0;
+
+	auto surface = targets()[0]->component<Surface>();
+
+	if (surface->geometry() != _levels[_level].second)
+		surface->geometry(_levels[_level].second);
+}
@@ -0,0 +1,507 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/component/LightCulling.hpp"
+
+#include "minko/scene/Node.hpp"
+#include "minko/scene/NodeSet.hpp"
+#include "minko/component/SceneManager.hpp"
+#include "minko/component/Surface.hpp"
+#include "minko/component/BoundingBox.hpp"
+#include "minko/component/PointLight.hpp"
+#include "minko/component/SpotLight.hpp"
+#include "minko/data/Container.hpp"
+#include "minko/data/ArrayProvider.hpp"
+#include "minko/math/OctTree.hpp"
+#include "minko/math/Box.hpp"
+#include "minko/math/Vector3.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::math;
+
+const uint LightCulling::MAX_NUM_POINT_LIGHTS	= 4;
+const uint LightCulling::MAX_NUM_SPOT_LIGHTS	= 4;
+
+// keeps the lights that are still selected in their slot so that their bindings are not touched
+template <typename L>
+static
+void
+sortSlots(const std::vector<std::shared_ptr<L>>&	current,
+		  std::vector<std::shared_ptr<L>>&			selected)
+{
+	std::vector<std::shared_ptr<L>> slots(current.size(), nullptr);
+
+	for (uint i = 0; i < current.size(); ++i)
+	{
+		auto selectedIt = std::find(selected.begin(), selected.end(), current[i]);
+
+		if (current[i] != nullptr && selectedIt != selected.end())
+		{
+			slots[i] = current[i];
+			*selectedIt = nullptr;
+		}
+	}
+
+	auto selectedIt = selected.begin();
+
+	for (auto& slot : slots)
+	{
+		while (slot == nullptr && selectedIt != selected.end())
+			slot = *selectedIt++;
+	}
+
+	selected.swap(slots);
+}
+
+LightCulling::LightCulling() :
+	_octTree(OctTree::create(50, 7, Vector3::create(0.f, 0.f, 0.f), 0, true)),
+	_pointLights(),
+	_spotLights(),
+	_surfaces(),
+	_hits(),
+	_selectedPointLights(),
+	_selectedSpotLights(),
+	_invalidBindings(false),
+	_emptyColor(Vector3::create(0.f, 0.f, 0.f)),
+	_emptyAttenuation(Vector3::create(-1.f, -1.f, -1.f)),
+	// far enough for the direction from a vertex to never be degenerate
+	_emptyPosition(Vector3::create(0.f, 1e6f, 0.f)),
+	_emptyDirection(Vector3::create(0.f, 0.f, 1.f))
+{
+}
+
+void
+LightCulling::initialize()
+{
+	_targetAddedSlot = targetAdded()->connect(std::bind(
+		&LightCulling::targetAddedHandler,
+		shared_from_this(),
+		std::placeholders::_1,
+		std::placeholders::_2
+	));
+
+	_targetRemovedSlot = targetRemoved()->connect(std::bind(
+		&LightCulling::targetRemovedHandler,
+		shared_from_this(),
+		std::placeholders::_1,
+		std::placeholders::_2
+	));
+}
+
+void
+LightCulling::targetAddedHandler(AbsCtrlPtr ctrl, NodePtr target)
+{
+	if (targets().size() > 1)
+		throw std::logic_error("LightCulling cannot have more than one target.");
+
+	auto invalidate = [this](NodePtr, NodePtr, NodePtr)
+	{
+		_invalidBindings = true;
+	};
+
+	_addedSlot = target->added()->connect(invalidate);
+	_removedSlot = target->removed()->connect(invalidate);
+	_componentAddedSlot = target->componentAdded()->connect(std::bind(
+		&LightCulling::componentAddedHandler,
+		shared_from_this(),
+		std::placeholders::_1,
+		std::placeholders::_2,
+		std::placeholders::_3
+	));
+	_componentRemovedSlot = target->componentRemoved()->connect(std::bind(
+		&LightCulling::componentRemovedHandler,
+		shared_from_this(),
+		std::placeholders::_1,
+		std::placeholders::_2,
+		std::placeholders::_3
+	));
+
+	setSceneManager(target->root()->component<SceneManager>());
+	_invalidBindings = true;
+}
+
+void
+LightCulling::targetRemovedHandler(AbsCtrlPtr ctrl, NodePtr target)
+{
+	_addedSlot = nullptr;
+	_removedSlot = nullptr;
+	_componentAddedSlot = nullptr;
+	_componentRemovedSlot = nullptr;
+	_cullingBeginSlot = nullptr;
+	_modelToWorldChangedSlot = nullptr;
+
+	unbind();
+}
+
+void
+LightCulling::componentAddedHandler(NodePtr node, NodePtr target, AbsCtrlPtr ctrl)
+{
+	auto sceneManager = std::dynamic_pointer_cast<SceneManager>(ctrl);
+
+	if (sceneManager)
+		setSceneManager(sceneManager);
+
+	_invalidBindings = true;
+}
+
+void
+LightCulling::componentRemovedHandler(NodePtr node, NodePtr target, AbsCtrlPtr ctrl)
+{
+	if (std::dynamic_pointer_cast<SceneManager>(ctrl))
+		setSceneManager(nullptr);
+
+	_invalidBindings = true;
+}
+
+void
+LightCulling::setSceneManager(SceneManagerPtr sceneManager)
+{
+	// after frameBegin(), when the transforms of the frame are up to date
+	if (sceneManager)
+		_cullingBeginSlot = sceneManager->cullingBegin()->connect(std::bind(
+			&LightCulling::update,
+			shared_from_this()
+		));
+	else
+		_cullingBeginSlot = nullptr;
+}
+
+void
+LightCulling::bind()
+{
+	_invalidBindings = false;
+
+	if (targets().empty())
+		return;
+
+	auto							target = targets()[0];
+	std::unordered_set<NodePtr>		surfaces;
+	std::vector<NodePtr>			removedSurfaces;
+
+	_pointLights.clear();
+	_spotLights.clear();
+
+	scene::NodeSet::visitDescendants(
+		target,
+		[&](const NodePtr& descendant)
+		{
+			for (auto& light : descendant->components<PointLight>())
+				_pointLights.push_back(light);
+			for (auto& light : descendant->components<SpotLight>())
+				_spotLights.push_back(light);
+
+			if (descendant->hasComponent<Surface>() && descendant->hasComponent<Transform>())
+				surfaces.insert(descendant);
+		},
+		true
+	);
+
+	for (auto& nodeAndLights : _surfaces)
+		if (surfaces.count(nodeAndLights.first) == 0)
+			removedSurfaces.push_back(nodeAndLights.first);
+	for (auto& node : removedSurfaces)
+		removeSurface(node);
+
+	for (auto& node : surfaces)
+		if (_surfaces.count(node) == 0)
+			addSurface(node);
+
+	// one batch per frame instead of one callback per moving node
+	auto rootTransform = target->root()->component<Transform::RootTransform>();
+
+	if (rootTransform)
+		_modelToWorldChangedSlot = rootTransform->modelToWorldChanged()->connect(
+			[&](Transform::RootTransform::Ptr rootTransform, const std::vector<NodePtr>& nodes)
+			{
+				_octTree->nodesModelToWorldChanged(nodes);
+			}
+		);
+	else
+		_modelToWorldChangedSlot = nullptr;
+}
+
+void
+LightCulling::addSurface(NodePtr node)
+{
+	auto& surface = _surfaces[node];
+
+	for (uint i = 0; i < MAX_NUM_POINT_LIGHTS; ++i)
+	{
+		auto slot = data::ArrayProvider::create("localPointLights");
+
+		slot
+			->set("color",				_emptyColor)
+			->set("diffuse",			0.f)
+			->set("specular",			0.f)
+			->set("attenuationCoeffs",	_emptyAttenuation)
+			->set("position",			_emptyPosition);
+
+		node->data()->addProvider(slot);
+		surface.pointLightSlots.push_back(slot);
+		surface.pointLights.push_back(nullptr);
+	}
+
+	for (uint i = 0; i < MAX_NUM_SPOT_LIGHTS; ++i)
+	{
+		auto slot = data::ArrayProvider::create("localSpotLights");
+
+		// an outer cone of angle 0 lights nothing
+		slot
+			->set("color",				_emptyColor)
+			->set("diffuse",			0.f)
+			->set("specular",			0.f)
+			->set("attenuationCoeffs",	_emptyAttenuation)
+			->set("position",			_emptyPosition)
+			->set("direction",			_emptyDirection)
+			->set("cosInnerConeAngle",	1.f)
+			->set("cosOuterConeAngle",	1.f);
+
+		node->data()->addProvider(slot);
+		surface.spotLightSlots.push_back(slot);
+		surface.spotLights.push_back(nullptr);
+	}
+
+	_octTree->insert(node);
+}
+
+void
+LightCulling::removeSurface(NodePtr node)
+{
+	auto& surface = _surfaces[node];
+
+	// from the last index so that the other slots keep theirs
+	for (auto slotIt = surface.pointLightSlots.rbegin(); slotIt != surface.pointLightSlots.rend(); ++slotIt)
+		node->data()->removeProvider(*slotIt);
+	for (auto slotIt = surface.spotLightSlots.rbegin(); slotIt != surface.spotLightSlots.rend(); ++slotIt)
+		node->data()->removeProvider(*slotIt);
+
+	_octTree->remove(node);
+	_surfaces.erase(node);
+}
+
+void
+LightCulling::unbind()
+{
+	while (!_surfaces.empty())
+		removeSurface(_surfaces.begin()->first);
+
+	_pointLights.clear();
+	_spotLights.clear();
+}
+
+void
+LightCulling::update()
+{
+	if (_invalidBindings)
+		bind();
+
+	if (_surfaces.empty())
+		return;
+
+	_octTree->update();
+
+	for (auto& nodeAndLights : _surfaces)
+	{
+		nodeAndLights.second.pointCandidates.clear();
+		nodeAndLights.second.spotCandidates.clear();
+	}
+
+	addCandidates(_pointLights, &SurfaceLights::pointCandidates);
+	addCandidates(_spotLights, &SurfaceLights::spotCandidates);
+
+	for (auto& nodeAndLights : _surfaces)
+	{
+		auto& surface			= nodeAndLights.second;
+		auto& pointCandidates	= surface.pointCandidates;
+		auto& spotCandidates	= surface.spotCandidates;
+		auto numPointLights		= std::min<uint>(MAX_NUM_POINT_LIGHTS, pointCandidates.size());
+		auto numSpotLights		= std::min<uint>(MAX_NUM_SPOT_LIGHTS, spotCandidates.size());
+
+		std::partial_sort(
+			pointCandidates.begin(), pointCandidates.begin() + numPointLights, pointCandidates.end(),
+			std::greater<std::pair<float, uint>>()
+		);
+		std::partial_sort(
+			spotCandidates.begin(), spotCandidates.begin() + numSpotLights, spotCandidates.end(),
+			std::greater<std::pair<float, uint>>()
+		);
+
+		_selectedPointLights.clear();
+		for (uint i = 0; i < numPointLights; ++i)
+			_selectedPointLights.push_back(_pointLights[pointCandidates[i].second]);
+		sortSlots(surface.pointLights, _selectedPointLights);
+
+		_selectedSpotLights.clear();
+		for (uint i = 0; i < numSpotLights; ++i)
+			_selectedSpotLights.push_back(_spotLights[spotCandidates[i].second]);
+		sortSlots(surface.spotLights, _selectedSpotLights);
+
+		for (uint i = 0; i < MAX_NUM_POINT_LIGHTS; ++i)
+			assignPointLight(surface, i, _selectedPointLights[i]);
+		for (uint i = 0; i < MAX_NUM_SPOT_LIGHTS; ++i)
+			assignSpotLight(surface, i, _selectedSpotLights[i]);
+	}
+}
+
+template <typename L>
+void
+LightCulling::addCandidates(const std::vector<std::shared_ptr<L>>& lights, Candidates SurfaceLights::* candidates)
+{
+	for (uint lightId = 0; lightId < lights.size(); ++lightId)
+	{
+		auto& light				= lights[lightId];
+		auto color				= light->color();
+		auto position			= light->worldPosition();
+		auto attenuationCoeffs	= light->attenuationCoefficients();
+		auto intensity			= (light->diffuse() + light->specular())
+			* std::max(color->x(), std::max(color->y(), color->z()));
+		auto radius				= range(attenuationCoeffs);
+
+		if (intensity <= 0.f || !light->enabled())
+			continue;
+
+		auto addCandidate = [&](const NodePtr& node, SurfaceLights& surface)
+		{
+			auto distance	= sqrtf(node->component<BoundingBox>()->box()->squaredDistance(position));
+			auto score		= intensity * attenuation(attenuationCoeffs, distance);
+
+			if (score > 0.f)
+				(surface.*candidates).push_back(std::pair<float, uint>(score, lightId));
+		};
+
+		if (radius == FLT_MAX)
+		{
+			for (auto& nodeAndLights : _surfaces)
+				addCandidate(nodeAndLights.first, nodeAndLights.second);
+		}
+		else
+		{
+			_hits.clear();
+			_octTree->testSphere(position, radius, _hits);
+
+			for (auto& node : _hits)
+				addCandidate(node, _surfaces[node]);
+		}
+	}
+}
+
+void
+LightCulling::assignPointLight(SurfaceLights& surface, uint slotId, std::shared_ptr<PointLight> light)
+{
+	auto& slot		= surface.pointLightSlots[slotId];
+	auto diffuse	= light ? light->diffuse() : 0.f;
+	auto specular	= light ? light->specular() : 0.f;
+
+	// the uniforms point to the vectors of the light, only a new light has to be rebound
+	if (surface.pointLights[slotId] != light)
+	{
+		surface.pointLights[slotId] = light;
+
+		slot
+			->set("color",				light ? light->color() : _emptyColor)
+			->set("attenuationCoeffs",	light ? light->attenuationCoefficients() : _emptyAttenuation)
+			->set("position",			light ? light->worldPosition() : _emptyPosition);
+	}
+
+	if (slot->get<float>("diffuse") != diffuse)
+		slot->set("diffuse", diffuse);
+	if (slot->get<float>("specular") != specular)
+		slot->set("specular", specular);
+}
+
+void
+LightCulling::assignSpotLight(SurfaceLights& surface, uint slotId, std::shared_ptr<SpotLight> light)
+{
+	auto& slot				= surface.spotLightSlots[slotId];
+	auto diffuse			= light ? light->diffuse() : 0.f;
+	auto specular			= light ? light->specular() : 0.f;
+	auto cosInnerConeAngle	= light ? light->cosInnerConeAngle() : 1.f;
+	auto cosOuterConeAngle	= light ? light->cosOuterConeAngle() : 1.f;
+
+	if (surface.spotLights[slotId] != light)
+	{
+		surface.spotLights[slotId] = light;
+
+		slot
+			->set("color",				light ? light->color() : _emptyColor)
+			->set("attenuationCoeffs",	light ? light->attenuationCoefficients() : _emptyAttenuation)
+			->set("position",			light ? light->worldPosition() : _emptyPosition)
+			->set("direction",			light ? light->worldDirection() : _emptyDirection);
+	}
+
+	if (slot->get<float>("diffuse") != diffuse)
+		slot->set("diffuse", diffuse);
+	if (slot->get<float>("specular") != specular)
+		slot->set("specular", specular);
+	if (slot->get<float>("cosInnerConeAngle") != cosInnerConeAngle)
+		slot->set("cosInnerConeAngle", cosInnerConeAngle);
+	if (slot->get<float>("cosOuterConeAngle") != cosOuterConeAngle)
+		slot->set("cosOuterConeAngle", cosOuterConeAngle);
+}
+
+PointLight::Ptr
+LightCulling::pointLight(NodePtr node, uint slot) const
+{
+	auto surfaceIt = _surfaces.find(node);
+
+	if (surfaceIt == _surfaces.end())
+		throw std::invalid_argument("node");
+	if (slot >= MAX_NUM_POINT_LIGHTS)
+		throw std::invalid_argument("slot");
+
+	return surfaceIt->second.pointLights[slot];
+}
+
+SpotLight::Ptr
+LightCulling::spotLight(NodePtr node, uint slot) const
+{
+	auto surfaceIt = _surfaces.find(node);
+
+	if (surfaceIt == _surfaces.end())
+		throw std::invalid_argument("node");
+	if (slot >= MAX_NUM_SPOT_LIGHTS)
+		throw std::invalid_argument("slot");
+
+	return surfaceIt->second.spotLights[slot];
+}
+
+float
+LightCulling::attenuation(Vector3Ptr attenuationCoeffs, float distance)
+{
+	// same as Phong.fragment.glsl
+	if (attenuationCoeffs->x() < 0.f || attenuationCoeffs->y() < 0.f || attenuationCoeffs->z() < 0.f)
+		return 1.f;
+
+	auto denominator = attenuationCoeffs->x() + distance * (attenuationCoeffs->y() + distance * attenuationCoeffs->z());
+
+	return denominator > 0.f ? std::max(0.f, 1.f - distance / denominator) : 0.f;
+}
+
+float
+LightCulling::range(Vector3Ptr attenuationCoeffs)
+{
+	// the attenuation never reaches 0 for good when the quadratic term wins over the distance
+	if (attenuationCoeffs->x() < 0.f || attenuationCoeffs->y() < 0.f || attenuationCoeffs->z() < 0.f
+		|| attenuationCoeffs->z() > 0.f || attenuationCoeffs->y() >= 1.f)
+		return FLT_MAX;
+
+	return attenuationCoeffs->x() / (1.f - attenuationCoeffs->y());
+}
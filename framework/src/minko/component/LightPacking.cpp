@@ -0,0 +1,293 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/component/LightPacking.hpp"
+
+#include "minko/scene/Node.hpp"
+#include "minko/scene/NodeSet.hpp"
+#include "minko/component/SceneManager.hpp"
+#include "minko/component/AmbientLight.hpp"
+#include "minko/component/DirectionalLight.hpp"
+#include "minko/component/PointLight.hpp"
+#include "minko/component/SpotLight.hpp"
+#include "minko/data/Container.hpp"
+#include "minko/data/StructureProvider.hpp"
+#include "minko/math/Vector3.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::math;
+
+const uint LightPacking::AMBIENT_LIGHT_SIZE		= 1;
+const uint LightPacking::DIRECTIONAL_LIGHT_SIZE	= 2;
+const uint LightPacking::POINT_LIGHT_SIZE		= 3;
+const uint LightPacking::SPOT_LIGHT_SIZE		= 4;
+
+static
+void
+packVector4(float* values, Vector3::Ptr xyz, float w)
+{
+	values[0] = xyz->x();
+	values[1] = xyz->y();
+	values[2] = xyz->z();
+	values[3] = w;
+}
+
+// the color of the disabled lights is black: their slot is kept so that the arrays do not move
+static
+Vector3::Ptr
+lightColor(std::shared_ptr<AbstractLight> light)
+{
+	static const auto black = Vector3::create(0.f, 0.f, 0.f);
+
+	return light->enabled() ? light->color() : black;
+}
+
+LightPacking::LightPacking() :
+	_data(data::StructureProvider::create("packedLights")),
+	_root(nullptr),
+	_ambientLights(),
+	_directionalLights(),
+	_pointLights(),
+	_spotLights(),
+	_invalidLights(false)
+{
+}
+
+void
+LightPacking::initialize()
+{
+	for (auto propertyName : { "ambient", "directional", "point", "spot" })
+		_data->set<data::UniformArrayPtr<float>>(
+			propertyName, data::UniformArrayPtr<float>(new data::UniformArray<float>(0, nullptr))
+		);
+
+	_targetAddedSlot = targetAdded()->connect(std::bind(
+		&LightPacking::targetAddedHandler,
+		shared_from_this(),
+		std::placeholders::_1,
+		std::placeholders::_2
+	));
+
+	_targetRemovedSlot = targetRemoved()->connect(std::bind(
+		&LightPacking::targetRemovedHandler,
+		shared_from_this(),
+		std::placeholders::_1,
+		std::placeholders::_2
+	));
+}
+
+void
+LightPacking::targetAddedHandler(AbsCtrlPtr ctrl, NodePtr target)
+{
+	if (targets().size() > 1)
+		throw std::logic_error("LightPacking cannot have more than one target.");
+
+	auto rootChanged = [this](NodePtr node, NodePtr target, NodePtr ancestor)
+	{
+		setRoot(node->root());
+	};
+
+	_targetAddedToNodeSlot = target->added()->connect(rootChanged);
+	_targetRemovedFromNodeSlot = target->removed()->connect(rootChanged);
+
+	setRoot(target->root());
+}
+
+void
+LightPacking::targetRemovedHandler(AbsCtrlPtr ctrl, NodePtr target)
+{
+	_targetAddedToNodeSlot = nullptr;
+	_targetRemovedFromNodeSlot = nullptr;
+
+	setRoot(nullptr);
+}
+
+void
+LightPacking::setRoot(NodePtr root)
+{
+	if (root == _root)
+		return;
+
+	// the packed arrays are bound with "source" : "root" like the lights themselves
+	if (_root)
+		_root->data()->removeProvider(_data);
+
+	_root = root;
+	_invalidLights = true;
+
+	if (!root)
+	{
+		_addedSlot = nullptr;
+		_removedSlot = nullptr;
+		_componentAddedSlot = nullptr;
+		_componentRemovedSlot = nullptr;
+		setSceneManager(nullptr);
+		_ambientLights.clear();
+		_directionalLights.clear();
+		_pointLights.clear();
+		_spotLights.clear();
+
+		return;
+	}
+
+	root->data()->addProvider(_data);
+
+	auto invalidate = [this](NodePtr, NodePtr, NodePtr)
+	{
+		_invalidLights = true;
+	};
+
+	_addedSlot = root->added()->connect(invalidate);
+	_removedSlot = root->removed()->connect(invalidate);
+	_componentAddedSlot = root->componentAdded()->connect([this](NodePtr node, NodePtr target, AbsCtrlPtr ctrl)
+	{
+		auto sceneManager = std::dynamic_pointer_cast<SceneManager>(ctrl);
+
+		if (sceneManager)
+			setSceneManager(sceneManager);
+
+		_invalidLights = true;
+	});
+	_componentRemovedSlot = root->componentRemoved()->connect([this](NodePtr node, NodePtr target, AbsCtrlPtr ctrl)
+	{
+		if (std::dynamic_pointer_cast<SceneManager>(ctrl))
+			setSceneManager(nullptr);
+
+		_invalidLights = true;
+	});
+
+	setSceneManager(root->component<SceneManager>());
+}
+
+void
+LightPacking::setSceneManager(SceneManagerPtr sceneManager)
+{
+	// after frameBegin(), when the lights of the frame are up to date
+	if (sceneManager)
+		_cullingBeginSlot = sceneManager->cullingBegin()->connect(std::bind(
+			&LightPacking::update,
+			shared_from_this()
+		));
+	else
+		_cullingBeginSlot = nullptr;
+}
+
+void
+LightPacking::bindLights()
+{
+	_invalidLights = false;
+	_ambientLights.clear();
+	_directionalLights.clear();
+	_pointLights.clear();
+	_spotLights.clear();
+
+	if (!_root)
+		return;
+
+	scene::NodeSet::visitDescendants(
+		_root,
+		[&](const NodePtr& descendant)
+		{
+			for (auto& light : descendant->components<AmbientLight>())
+				_ambientLights.push_back(light);
+			for (auto& light : descendant->components<DirectionalLight>())
+				_directionalLights.push_back(light);
+			for (auto& light : descendant->components<PointLight>())
+				_pointLights.push_back(light);
+			for (auto& light : descendant->components<SpotLight>())
+				_spotLights.push_back(light);
+		},
+		true
+	);
+}
+
+void
+LightPacking::update()
+{
+	if (!_root)
+		return;
+
+	if (_invalidLights)
+		bindLights();
+
+	// the lights are stored at their index in the arrays of the root so that the packed arrays
+	// follow the order of the NUM_*_LIGHTS loops of the shaders
+	_ambient.assign(_ambientLights.size() * AMBIENT_LIGHT_SIZE * 4, 0.f);
+	for (auto& light : _ambientLights)
+	{
+		auto values = &_ambient[light->arrayIndex() * AMBIENT_LIGHT_SIZE * 4];
+
+		packVector4(values, lightColor(light), light->ambient());
+	}
+
+	_directional.assign(_directionalLights.size() * DIRECTIONAL_LIGHT_SIZE * 4, 0.f);
+	for (auto& light : _directionalLights)
+	{
+		auto values = &_directional[light->arrayIndex() * DIRECTIONAL_LIGHT_SIZE * 4];
+
+		packVector4(values, lightColor(light), light->diffuse());
+		packVector4(values + 4, light->worldDirection(), light->specular());
+	}
+
+	_point.assign(_pointLights.size() * POINT_LIGHT_SIZE * 4, 0.f);
+	for (auto& light : _pointLights)
+	{
+		auto values = &_point[light->arrayIndex() * POINT_LIGHT_SIZE * 4];
+
+		packVector4(values, lightColor(light), light->diffuse());
+		packVector4(values + 4, light->worldPosition(), light->specular());
+		packVector4(values + 8, light->attenuationCoefficients(), 0.f);
+	}
+
+	_spot.assign(_spotLights.size() * SPOT_LIGHT_SIZE * 4, 0.f);
+	for (auto& light : _spotLights)
+	{
+		auto values = &_spot[light->arrayIndex() * SPOT_LIGHT_SIZE * 4];
+
+		packVector4(values, lightColor(light), light->diffuse());
+		packVector4(values + 4, light->worldPosition(), light->specular());
+		packVector4(values + 8, light->attenuationCoefficients(), light->cosInnerConeAngle());
+		packVector4(values + 12, light->worldDirection(), light->cosOuterConeAngle());
+	}
+
+	publish("ambient", _ambient);
+	publish("directional", _directional);
+	publish("point", _point);
+	publish("spot", _spot);
+}
+
+void
+LightPacking::publish(const std::string& propertyName, std::vector<float>& values)
+{
+	const auto&	uniformArray	= _data->get<data::UniformArrayPtr<float>>(propertyName);
+	const auto	numVectors		= (uint)values.size() / 4;
+	const auto	pointer			= values.empty() ? nullptr : &values[0];
+
+	const auto	resized			= uniformArray->first != numVectors;
+
+	uniformArray->first = numVectors;
+	uniformArray->second = pointer;
+
+	// the draw calls skip the arrays that were empty when they were bound: setting the property
+	// again makes them rebind it
+	if (resized)
+		_data->set<data::UniformArrayPtr<float>>(propertyName, uniformArray);
+}
@@ -24,6 +24,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/scene/NodeSet.hpp"
 #include "minko/component/SceneManager.hpp"
 #include "minko/component/PerspectiveCamera.hpp"
+#include "minko/component/Culling.hpp"
 #include "minko/file/AssetLibrary.hpp"
 #include "minko/render/AbstractContext.hpp"
 #include "minko/input/Mouse.hpp"
@@ -55,14 +56,35 @@ Picking::Picking(SceneManagerPtr	sceneManager,
 	_mouseLeftClick(Signal<NodePtr>::create()),
 	_mouseRightClick(Signal<NodePtr>::create()),
 	_mouseOut(Signal<NodePtr>::create()),
-	_mouseOver(Signal<NodePtr>::create())
+	_mouseOver(Signal<NodePtr>::create()),
+	_readbackIndex(0),
+	_areaRequested(false),
+	_renderingArea(false),
+	_areaX(0),
+	_areaY(0),
+	_areaWidth(0),
+	_areaHeight(0),
+	_areaPicked(AreaPickedSignal::create()),
+	_frameRendered(false)
 {
 	_renderer	= Renderer::create(0xFFFF00FF, nullptr, sceneManager->assets()->effect("effect/Picking.effect"), 1000.f);
 }
 
+Picking::~Picking()
+{
+	for (auto& readback : _readbacks)
+		if (readback.size > 0)
+			_context->deletePixelBuffer(readback.pixelBuffer);
+}
+
 void
 Picking::initialize()
 {
+	// without pixel buffers the read back is synchronous anyway, it is resolved in the same frame
+	Readback readback = { 0, 0, 0, false, false };
+
+	_readbacks.resize(_context->supportsPixelBuffers() ? PIXEL_BUFFER_RING_SIZE : 1, readback);
+
 	_pickingProvider->set("projection", _pickingProjection);
 
 	_mouseMoveSlot = _mouse->move()->connect(std::bind(
@@ -83,6 +105,14 @@ Picking::initialize()
 		shared_from_this(),
 		std::placeholders::_1));
 
+	_frameEndSlot = _sceneManager->frameEnd()->connect(std::bind(
+		&Picking::frameEndHandler,
+		shared_from_this(),
+		std::placeholders::_1,
+		std::placeholders::_2,
+		std::placeholders::_3
+	));
+
 	_targetAddedSlot = targetAdded()->connect(std::bind(
 		&Picking::targetAddedHandler,
 		shared_from_this(),
@@ -127,6 +157,10 @@ Picking::targetAddedHandler(AbsCtrlPtr ctrl, NodePtr target)
 
 	target->data()->addProvider(_pickingProvider);
 	target->data()->addProvider(perspectiveCamera->data());
+
+	// only what the camera sees can be picked: its culling is reused instead of drawing every surface
+	if (_camera->hasComponent<Culling>())
+		_camera->component<Culling>()->addRenderer(_renderer);
 	
 	auto surfaces = scene::NodeSet::create(target->root())
 		->descendants(true)
@@ -145,6 +179,15 @@ Picking::targetRemovedHandler(AbsCtrlPtr ctrl, NodePtr target)
 {
 	_addedSlot = nullptr;
 	_removedSlot = nullptr;
+	_modelToWorldChangedSlot = nullptr;
+
+	if (_camera->hasComponent<Culling>())
+	{
+		auto culling = _camera->component<Culling>();
+
+		if (std::find(culling->renderers().begin(), culling->renderers().end(), _renderer) != culling->renderers().end())
+			culling->removeRenderer(_renderer);
+	}
 	
 	removedHandler(target->root(), target, target->parent());
 }
@@ -259,6 +302,7 @@ Picking::addSurface(SurfacePtr surface)
 	));
 
 	surface->targets()[0]->data()->addProvider(_surfaceToProvider[surface]);
+	invalidate();
 }
 
 void
@@ -270,6 +314,7 @@ Picking::removeSurface(SurfacePtr surface)
 	_surfaceToPickingId.erase(surface);
 	_surfaceToProvider.erase(surface);
 	_pickingIdToSurface.erase(surfacePickingId);
+	invalidate();
 }
 
 void
@@ -279,6 +324,26 @@ Picking::removedHandler(NodePtr node, NodePtr target, NodePtr parent)
 	_renderingEndSlot	= nullptr;
 }
 
+void
+Picking::pickArea(uint x, uint y, uint width, uint height)
+{
+	if (width == 0 || height == 0)
+		throw std::invalid_argument("width, height");
+
+	_areaRequested = true;
+	_areaX = x;
+	_areaY = y;
+	_areaWidth = width;
+	_areaHeight = height;
+	invalidate();
+}
+
+void
+Picking::invalidate()
+{
+	_renderer->enabled(true);
+}
+
 void
 Picking::renderingBegin(RendererPtr renderer)
 {
@@ -288,6 +353,36 @@ Picking::renderingBegin(RendererPtr renderer)
 	auto perspectiveCamera	= _camera->component<component::PerspectiveCamera>();
 	auto projection			= math::Matrix4x4::create()->perspective(perspectiveCamera->fieldOfView(), perspectiveCamera->aspectRatio(), perspectiveCamera->zNear(), perspectiveCamera->zFar());
 
+	_renderingArea = _areaRequested;
+	_areaRequested = false;
+
+	// fragments outside of the region that is read back are not rendered
+	_readRegion.x		= 0;
+	_readRegion.y		= 0;
+	_readRegion.width	= 1;
+	_readRegion.height	= 1;
+
+	// an area is read where it is on screen, the picked pixel is moved to the origin otherwise
+	if (_renderingArea)
+	{
+		const uint viewportWidth	= _context->viewportWidth();
+		const uint viewportHeight	= _context->viewportHeight();
+		const uint top				= std::min(_areaY, viewportHeight - 1);
+
+		_readRegion.x		= std::min(_areaX, viewportWidth - 1);
+		_readRegion.width	= std::min(_areaWidth, viewportWidth - _readRegion.x);
+		_readRegion.height	= std::min(_areaHeight, viewportHeight - top);
+		// bottom left origin
+		_readRegion.y		= viewportHeight - top - _readRegion.height;
+
+		_pickingProjection->copyFrom(projection);
+		_renderer->scissor(true, _readRegion);
+
+		return;
+	}
+
+	_renderer->scissor(true, _readRegion);
+
 	std::vector<float> pickingProjectionData(projection->data());
 	
 	pickingProjectionData[2] = mouseX / _context->viewportWidth() * 2.f;
@@ -299,16 +394,111 @@ Picking::renderingBegin(RendererPtr renderer)
 void
 Picking::renderingEnd(RendererPtr renderer)
 {
-	_context->readPixels(0, 0, 1, 1, &_lastColor[0]);
+	auto&		readback	= _readbacks[_readbackIndex];
+	const uint	x			= _readRegion.x;
+	const uint	y			= _readRegion.y;
+	const uint	width		= _readRegion.width;
+	const uint	height		= _readRegion.height;
+
+	const uint size = width * height * 4;
+
+	if (readback.size < size)
+	{
+		if (readback.size > 0)
+			_context->deletePixelBuffer(readback.pixelBuffer);
+		readback.pixelBuffer = _context->createPixelBuffer(size);
+		readback.size = size;
+	}
+
+	_context->readPixelsAsync(x, y, width, height, readback.pixelBuffer);
+	readback.numPixels = width * height;
+	readback.area = _renderingArea;
+	readback.pending = true;
 
-	uint pickedSurfaceId = (_lastColor[0] << 16) + (_lastColor[1] << 8) + _lastColor[2];
+	// nothing to render next frame until something moves
+	_frameRendered = true;
+	_renderer->enabled(_areaRequested);
+
+	// the oldest read back has had PIXEL_BUFFER_RING_SIZE - 1 frames to complete
+	_readbackIndex = (_readbackIndex + 1) % _readbacks.size();
+	if (_readbacks[_readbackIndex].pending)
+		resolve(_readbacks[_readbackIndex]);
+}
 
-	if (_lastPickedSurface != _pickingIdToSurface[pickedSurfaceId])
+void
+Picking::frameEndHandler(SceneManagerPtr sceneManager, float time, float deltaTime)
+{
+	// the pending read backs still have to be resolved when the picking pass does not render
+	if (!_frameRendered)
+		for (uint i = 0; i < _readbacks.size(); ++i)
+		{
+			auto& readback = _readbacks[(_readbackIndex + i) % _readbacks.size()];
+
+			if (readback.pending)
+			{
+				resolve(readback);
+				break;
+			}
+		}
+	_frameRendered = false;
+
+	// the root transform is only created once the scene has transforms
+	if (!_modelToWorldChangedSlot && !targets().empty())
+	{
+		auto rootTransform = targets()[0]->root()->component<Transform::RootTransform>();
+
+		if (rootTransform)
+			_modelToWorldChangedSlot = rootTransform->modelToWorldChanged()->connect(
+				[&](Transform::RootTransform::Ptr rootTransform, const std::vector<NodePtr>& nodes)
+				{
+					invalidate();
+				}
+			);
+	}
+}
+
+void
+Picking::resolve(Readback& readback)
+{
+	_pixels.resize(readback.numPixels * 4);
+	_context->pixelBufferData(readback.pixelBuffer, readback.numPixels * 4, &_pixels[0]);
+	readback.pending = false;
+
+	if (readback.area)
+	{
+		std::vector<NodePtr> nodes;
+
+		for (uint i = 0; i < readback.numPixels; ++i)
+		{
+			uint pickingId		= (_pixels[i * 4] << 16) + (_pixels[i * 4 + 1] << 8) + _pixels[i * 4 + 2];
+			auto pickingIdIt	= _pickingIdToSurface.find(pickingId);
+
+			if (pickingIdIt == _pickingIdToSurface.end())
+				continue;
+
+			auto node = pickingIdIt->second->targets()[0];
+
+			if (std::find(nodes.begin(), nodes.end(), node) == nodes.end())
+				nodes.push_back(node);
+		}
+
+		_areaPicked->execute(shared_from_this(), nodes);
+
+		return;
+	}
+
+	std::copy(_pixels.begin(), _pixels.begin() + 4, _lastColor);
+
+	uint pickedSurfaceId	= (_lastColor[0] << 16) + (_lastColor[1] << 8) + _lastColor[2];
+	auto pickingIdIt		= _pickingIdToSurface.find(pickedSurfaceId);
+	auto pickedSurface		= pickingIdIt != _pickingIdToSurface.end() ? pickingIdIt->second : nullptr;
+
+	if (_lastPickedSurface != pickedSurface)
 	{
 		if (_lastPickedSurface)
 			_mouseOut->execute(_lastPickedSurface->targets()[0]);
 
-		_lastPickedSurface = _pickingIdToSurface[pickedSurfaceId];
+		_lastPickedSurface = pickedSurface;
 
 		if (_lastPickedSurface)
 			_mouseOver->execute(_lastPickedSurface->targets()[0]);
@@ -318,6 +508,8 @@ Picking::renderingEnd(RendererPtr renderer)
 void
 Picking::mouseMoveHandler(MousePtr mouse, int dx, int dy)
 {
+	invalidate();
+
 	if (_lastPickedSurface)
 		_mouseMove->execute(_lastPickedSurface->targets()[0]);
 }
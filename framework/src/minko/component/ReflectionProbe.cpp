@@ -0,0 +1,479 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/component/ReflectionProbe.hpp"
+
+#include "minko/scene/Node.hpp"
+#include "minko/scene/NodeSet.hpp"
+#include "minko/component/SceneManager.hpp"
+#include "minko/component/Renderer.hpp"
+#include "minko/component/Surface.hpp"
+#include "minko/component/BoundingBox.hpp"
+#include "minko/component/Transform.hpp"
+#include "minko/data/StructureProvider.hpp"
+#include "minko/render/AbstractContext.hpp"
+#include "minko/render/CubeTexture.hpp"
+#include "minko/render/RenderTargetPool.hpp"
+#include "minko/render/Texture.hpp"
+#include "minko/math/Box.hpp"
+#include "minko/math/Frustum.hpp"
+#include "minko/math/Matrix4x4.hpp"
+#include "minko/math/Vector3.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::math;
+
+const uint	ReflectionProbe::NUM_FACES	= 6;
+
+// after RootTransform, before the renderers of the scene
+static const float UPDATE_PRIORITY			= 900.f;
+static const float RENDERERS_PRIORITY		= 800.f;
+
+// direction and up vector of each face, in the order of CubeTexture::Face
+static const float FACE_AXES[6][6] = {
+	{  1.f,  0.f,  0.f,		0.f, -1.f,  0.f },
+	{ -1.f,  0.f,  0.f,		0.f, -1.f,  0.f },
+	{  0.f,  1.f,  0.f,		0.f,  0.f,  1.f },
+	{  0.f, -1.f,  0.f,		0.f,  0.f, -1.f },
+	{  0.f,  0.f,  1.f,		0.f, -1.f,  0.f },
+	{  0.f,  0.f, -1.f,		0.f, -1.f,  0.f }
+};
+
+ReflectionProbe::ReflectionProbe(std::shared_ptr<render::AbstractContext>	context,
+								 uint										size,
+								 RenderTargetPoolPtr						renderTargets) :
+	_context(context),
+	_size(size),
+	_renderTargets(renderTargets),
+	_texture(nullptr),
+	_dynamic(true),
+	_numFacesPerUpdate(1),
+	_importance(1.f),
+	_updateDistance(10.f),
+	_camera(nullptr),
+	_zFar(100.f),
+	_layoutMask(0xffffffff),
+	_position(nullptr),
+	_projection(Matrix4x4::create()),
+	_faces(),
+	_nextFace(0),
+	_credit(0.f),
+	_numRenderedFaces(0),
+	_root(nullptr),
+	_surfaceNodes(),
+	_invalidSurfaces(false)
+{
+	if (!context)
+		throw std::invalid_argument("context");
+	// the faces are copied whole from the render targets
+	if (size == 0 || (size & (size - 1)) != 0)
+		throw std::invalid_argument("size");
+
+	if (!_renderTargets)
+		_renderTargets = render::RenderTargetPool::create(context);
+
+	// the faces are only allocated, update() copies the rendered faces into them
+	_texture = render::CubeTexture::create(context, size * 4, size * 3);
+	_texture->upload();
+
+	_projection->perspective((float)PI * .5f, 1.f, _zFar * .001f, _zFar);
+}
+
+void
+ReflectionProbe::initialize()
+{
+	_targetAddedSlot = targetAdded()->connect(std::bind(
+		&ReflectionProbe::targetAddedHandler,
+		shared_from_this(),
+		std::placeholders::_1,
+		std::placeholders::_2
+	));
+
+	_targetRemovedSlot = targetRemoved()->connect(std::bind(
+		&ReflectionProbe::targetRemovedHandler,
+		shared_from_this(),
+		std::placeholders::_1,
+		std::placeholders::_2
+	));
+}
+
+void
+ReflectionProbe::targetAddedHandler(AbsCtrlPtr ctrl, NodePtr target)
+{
+	if (targets().size() > 1)
+		throw std::logic_error("ReflectionProbe cannot have more than one target.");
+
+	for (uint faceId = 0; faceId < NUM_FACES; ++faceId)
+	{
+		Face face;
+
+		face.view			= Matrix4x4::create();
+		face.viewProjection	= Matrix4x4::create();
+		face.frustum		= Frustum::create();
+		face.target			= nullptr;
+		face.invalid		= true;
+		face.camera			= data::StructureProvider::create("camera");
+		// only rendered when update() picks the face, into a render target acquired for the frame
+		face.renderer		= Renderer::create(0, nullptr, nullptr, RENDERERS_PRIORITY);
+		face.renderer->enabled(false);
+		face.renderer->layoutMask(_layoutMask);
+		face.node			= scene::Node::create("reflectionProbeFace" + std::to_string(faceId));
+
+		face.camera
+			->set("viewMatrix",				face.view)
+			->set("projectionMatrix",		_projection)
+			->set("worldToScreenMatrix",	face.viewProjection)
+			->set("position",				Vector3::create());
+		face.node->data()->addProvider(face.camera);
+
+		// the render target is still bound before the renderer presents
+		face.beforePresentSlot = face.renderer->beforePresent()->connect(std::bind(
+			&ReflectionProbe::copyFace,
+			shared_from_this(),
+			faceId
+		));
+
+		_faces.push_back(face);
+	}
+
+	for (auto& face : _faces)
+	{
+		face.node->addComponent(face.renderer);
+		target->addChild(face.node);
+	}
+
+	_position = nullptr;
+
+	auto rootChanged = [this](NodePtr node, NodePtr target, NodePtr ancestor)
+	{
+		setRoot(node->root());
+	};
+
+	_targetAddedToNodeSlot = target->added()->connect(rootChanged);
+	_targetRemovedFromNodeSlot = target->removed()->connect(rootChanged);
+
+	setRoot(target->root());
+}
+
+void
+ReflectionProbe::targetRemovedHandler(AbsCtrlPtr ctrl, NodePtr target)
+{
+	_targetAddedToNodeSlot = nullptr;
+	_targetRemovedFromNodeSlot = nullptr;
+
+	setRoot(nullptr);
+
+	for (auto& face : _faces)
+	{
+		if (face.target)
+			_renderTargets->release(face.target);
+
+		target->removeChild(face.node);
+		face.node->removeComponent(face.renderer);
+	}
+
+	_faces.clear();
+}
+
+void
+ReflectionProbe::setRoot(NodePtr root)
+{
+	if (root == _root)
+		return;
+
+	_root = root;
+	_invalidSurfaces = true;
+
+	if (!root)
+	{
+		_addedSlot = nullptr;
+		_removedSlot = nullptr;
+		_componentAddedSlot = nullptr;
+		_componentRemovedSlot = nullptr;
+		setSceneManager(nullptr);
+		_surfaceNodes.clear();
+
+		return;
+	}
+
+	auto invalidate = [this](NodePtr, NodePtr, NodePtr)
+	{
+		_invalidSurfaces = true;
+	};
+
+	_addedSlot = root->added()->connect(invalidate);
+	_removedSlot = root->removed()->connect(invalidate);
+	_componentAddedSlot = root->componentAdded()->connect([this](NodePtr node, NodePtr target, AbsCtrlPtr ctrl)
+	{
+		auto sceneManager = std::dynamic_pointer_cast<SceneManager>(ctrl);
+
+		if (sceneManager)
+			setSceneManager(sceneManager);
+		if (std::dynamic_pointer_cast<Surface>(ctrl))
+			_invalidSurfaces = true;
+	});
+	_componentRemovedSlot = root->componentRemoved()->connect([this](NodePtr node, NodePtr target, AbsCtrlPtr ctrl)
+	{
+		if (std::dynamic_pointer_cast<SceneManager>(ctrl))
+			setSceneManager(nullptr);
+		if (std::dynamic_pointer_cast<Surface>(ctrl))
+			_invalidSurfaces = true;
+	});
+
+	setSceneManager(root->component<SceneManager>());
+}
+
+void
+ReflectionProbe::setSceneManager(SceneManagerPtr sceneManager)
+{
+	if (sceneManager)
+		_renderingBeginSlot = sceneManager->renderingBegin()->connect(std::bind(
+			&ReflectionProbe::update,
+			shared_from_this()
+		), UPDATE_PRIORITY);
+	else
+		_renderingBeginSlot = nullptr;
+}
+
+void
+ReflectionProbe::bindSurfaces()
+{
+	_invalidSurfaces = false;
+	_surfaceNodes.clear();
+
+	scene::NodeSet::visitDescendants(
+		_root,
+		[&](const NodePtr& descendant)
+		{
+			if (descendant->hasComponent<Surface>())
+				_surfaceNodes.push_back(descendant);
+		},
+		true
+	);
+
+	for (auto& node : _surfaceNodes)
+		if (!node->hasComponent<BoundingBox>())
+			node->addComponent(BoundingBox::create());
+}
+
+bool
+ReflectionProbe::placeFaces()
+{
+	auto target		= targets()[0];
+	auto position	= target->data()->hasProperty("transform.modelToWorldMatrix")
+		? target->data()->get<Matrix4x4Ptr>("transform.modelToWorldMatrix")->translation()
+		: Vector3::create();
+
+	if (_position && _position->equals(position))
+		return false;
+
+	_position = position;
+
+	for (uint faceId = 0; faceId < NUM_FACES; ++faceId)
+	{
+		auto& face	= _faces[faceId];
+		auto& axes	= FACE_AXES[faceId];
+		auto lookAt	= Vector3::create(
+			position->x() + axes[0], position->y() + axes[1], position->z() + axes[2]
+		);
+
+		face.view->lock()->view(position, lookAt, Vector3::create(axes[3], axes[4], axes[5]))->unlock();
+		face.viewProjection->lock()->copyFrom(face.view)->append(_projection)->unlock();
+		face.frustum->updateFromMatrix(face.viewProjection);
+		face.camera->get<Vector3::Ptr>("position")->copyFrom(position);
+	}
+
+	return true;
+}
+
+void
+ReflectionProbe::render(uint faceId)
+{
+	auto& face		= _faces[faceId];
+	auto target		= targets()[0];
+
+	if (!face.target)
+		face.target = _renderTargets->acquire(_size, _size);
+
+	face.renderer->target(face.target);
+
+	for (auto& node : _surfaceNodes)
+	{
+		// the surfaces of the probe would hide everything around it
+		auto visible = node != target;
+
+		if (visible)
+		{
+			uint planeMask	= Frustum::ALL_PLANES;
+			uint firstPlane	= 0;
+			auto result		= face.frustum->testBoundingBox(node->component<BoundingBox>()->box(), planeMask, firstPlane);
+
+			visible = result == ShapePosition::INSIDE || result == ShapePosition::AROUND;
+		}
+
+		for (auto& surface : node->components<Surface>())
+			surface->computedVisibility(face.renderer, visible);
+	}
+
+	face.renderer->enabled(true);
+	face.invalid = false;
+	++_numRenderedFaces;
+}
+
+void
+ReflectionProbe::copyFace(uint faceId)
+{
+	auto& face = _faces[faceId];
+
+	_context->copyToCubeTexture(_texture->id(), static_cast<render::CubeTexture::Face>(faceId), _size, _size);
+
+	face.renderer->enabled(false);
+	face.renderer->target(nullptr);
+	_renderTargets->release(face.target);
+	face.target = nullptr;
+}
+
+void
+ReflectionProbe::update()
+{
+	_numRenderedFaces = 0;
+
+	if (!_root || _faces.empty())
+		return;
+
+	// a face that was not rendered during the last frame is rendered again
+	for (auto& face : _faces)
+		if (face.target)
+		{
+			face.renderer->enabled(false);
+			face.renderer->target(nullptr);
+			_renderTargets->release(face.target);
+			face.target = nullptr;
+			face.invalid = true;
+		}
+
+	if (_invalidSurfaces)
+		bindSurfaces();
+
+	if (placeFaces() && !_dynamic)
+		for (auto& face : _faces)
+			face.invalid = true;
+
+	std::vector<bool> rendered(NUM_FACES, false);
+
+	for (uint faceId = 0; faceId < NUM_FACES; ++faceId)
+		rendered[faceId] = _faces[faceId].invalid;
+
+	if (_dynamic)
+	{
+		auto rate = _importance;
+
+		if (_camera && _camera->data()->hasProperty("camera.position"))
+		{
+			auto cameraPosition	= _camera->data()->get<Vector3::Ptr>("camera.position");
+			auto distance		= Vector3::create()->copyFrom(cameraPosition)->subtract(_position)->length();
+
+			if (distance > _updateDistance)
+				rate *= _updateDistance / distance;
+		}
+
+		// the probes far from the camera refresh their faces every few frames, without bursts of updates
+		_credit = std::min(_credit + rate, std::max(1.f, rate));
+
+		auto numFaces = 0u;
+
+		for (; _credit >= 1.f && numFaces < NUM_FACES; _credit -= 1.f)
+			for (uint i = 0; i < _numFacesPerUpdate && numFaces < NUM_FACES; ++i, ++numFaces)
+			{
+				rendered[_nextFace] = true;
+				_nextFace = (_nextFace + 1) % NUM_FACES;
+			}
+	}
+
+	for (uint faceId = 0; faceId < NUM_FACES; ++faceId)
+		if (rendered[faceId])
+			render(faceId);
+}
+
+ReflectionProbe::Ptr
+ReflectionProbe::dynamic(bool dynamic)
+{
+	_dynamic = dynamic;
+	_credit = 0.f;
+
+	return shared_from_this();
+}
+
+ReflectionProbe::Ptr
+ReflectionProbe::numFacesPerUpdate(uint numFaces)
+{
+	if (numFaces == 0 || numFaces > NUM_FACES)
+		throw std::invalid_argument("numFaces");
+
+	_numFacesPerUpdate = numFaces;
+
+	return shared_from_this();
+}
+
+ReflectionProbe::Ptr
+ReflectionProbe::importance(float importance)
+{
+	if (importance < 0.f)
+		throw std::invalid_argument("importance");
+
+	_importance = importance;
+
+	return shared_from_this();
+}
+
+ReflectionProbe::Ptr
+ReflectionProbe::zFar(float zFar)
+{
+	if (zFar <= 0.f)
+		throw std::invalid_argument("zFar");
+
+	_zFar = zFar;
+	_projection->perspective((float)PI * .5f, 1.f, zFar * .001f, zFar);
+	// the faces are placed and rendered again with the new projection
+	_position = nullptr;
+
+	return invalidate();
+}
+
+ReflectionProbe::Ptr
+ReflectionProbe::layoutMask(uint layoutMask)
+{
+	_layoutMask = layoutMask;
+
+	for (auto& face : _faces)
+		face.renderer->layoutMask(layoutMask);
+
+	return invalidate();
+}
+
+ReflectionProbe::Ptr
+ReflectionProbe::invalidate()
+{
+	for (auto& face : _faces)
+		face.invalid = true;
+
+	return shared_from_this();
+}
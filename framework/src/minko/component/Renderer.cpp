@@ -25,11 +25,22 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/render/DrawCall.hpp"
 #include "minko/render/Effect.hpp"
 #include "minko/render/Pass.hpp"
+#include "minko/render/Priority.hpp"
 #include "minko/render/AbstractTexture.hpp"
+#include "minko/render/Texture.hpp"
 #include "minko/render/AbstractContext.hpp"
 #include "minko/component/SceneManager.hpp"
 #include "minko/file/AssetLibrary.hpp"
 #include "minko/render/DrawCallPool.hpp"
+#include "minko/render/MemoryBudget.hpp"
+#include "minko/data/StructureProvider.hpp"
+#include "minko/Profiler.hpp"
+#include "minko/render/GPUTimer.hpp"
+#include "minko/render/DynamicResolution.hpp"
+#include "minko/geometry/QuadGeometry.hpp"
+#include "minko/material/Material.hpp"
+#include "minko/math/Matrix4x4.hpp"
+#include "minko/math/Vector2.hpp"
 
 using namespace minko;
 using namespace minko::component;
@@ -42,15 +53,38 @@ const unsigned int Renderer::NUM_FALLBACK_ATTEMPTS = 32;
 Renderer::Renderer(std::shared_ptr<render::AbstractTexture> renderTarget,
 				   EffectPtr								effect,
 				   float									priority) :
-    _backgroundColor(0),
+	_drawCalls(nullptr),
+#if defined(MINKO_NO_THREADS)
+	_numWorkers(1),
+#else
+	_numWorkers(std::thread::hardware_concurrency()),
+#endif
+	_surfaceDrawCalls(),
+	_backgroundColor(0),
 	_renderingBegin(Signal<Ptr>::create()),
 	_renderingEnd(Signal<Ptr>::create()),
 	_beforePresent(Signal<Ptr>::create()),
-	_surfaceDrawCalls(),
 	_surfaceTechniqueChangedSlot(),
 	_effect(effect),
-	_priority(priority)
+	_priority(priority),
+	_instancing(false),
+	_instancingEnabled(false),
+	_enabled(true),
+	_scissorTest(false),
+	_instancingData(data::StructureProvider::create("instancing")),
+	_frontToBack(false),
+	_layoutMask(0xffffffff),
+	_depthPrePassEffect(nullptr),
+	_depthPrePassPool(nullptr),
+	_gpuTimer(nullptr),
+	_dynamicResolution(nullptr),
+	_upscaleQuad(nullptr),
+	_scaledProjection(math::Matrix4x4::create()),
+	_lastRenderTime(0),
+	_present(true)
 {
+	_instancingData->set("enabled", true);
+
 	if (renderTarget)
 	{
 		renderTarget->upload();
@@ -111,6 +145,12 @@ Renderer::targetRemovedHandler(std::shared_ptr<AbstractComponent> 	ctrl,
 	_addedSlot = nullptr;
 	_removedSlot = nullptr;
 
+	if (_instancingEnabled)
+	{
+		target->data()->removeProvider(_instancingData);
+		_instancingEnabled = false;
+	}
+
 	removedHandler(target->root(), target, target->parent());
 }
 
@@ -176,16 +216,22 @@ Renderer::rootDescendantAddedHandler(std::shared_ptr<Node> node,
 									  std::shared_ptr<Node> target,
 									  std::shared_ptr<Node> parent)
 {
-    auto surfaceNodes = NodeSet::create(target)
-		->descendants(true)
-        ->where([](scene::Node::Ptr node)
-        {
-            return node->hasComponent<Surface>();
-        });
-
-	for (auto surfaceNode : surfaceNodes->nodes())
-		for (auto surface : surfaceNode->components<Surface>())
-			addSurface(surface);
+	std::vector<Surface::Ptr> surfaces;
+
+	NodeSet::visitDescendants(
+		target,
+		[&](const scene::Node::Ptr& descendant)
+		{
+			const auto& descendantSurfaces = descendant->components<Surface>();
+
+			surfaces.insert(surfaces.end(), descendantSurfaces.begin(), descendantSurfaces.end());
+		},
+		true
+	);
+
+	_drawCallPool->addSurfaces(surfaces);
+	if (_depthPrePassPool)
+		_depthPrePassPool->addSurfaces(surfaces);
 }
 
 void
@@ -193,16 +239,15 @@ Renderer::rootDescendantRemovedHandler(std::shared_ptr<Node> node,
 									    std::shared_ptr<Node> target,
 									    std::shared_ptr<Node> parent)
 {
-	auto surfaceNodes = NodeSet::create(target)
-		->descendants(true)
-        ->where([](scene::Node::Ptr node)
-        {
-            return node->hasComponent<Surface>();
-        });
-
-	for (auto surfaceNode : surfaceNodes->nodes())
-		for (auto surface : surfaceNode->components<Surface>())
-			removeSurface(surface);
+	NodeSet::visitDescendants(
+		target,
+		[&](const scene::Node::Ptr& descendant)
+		{
+			for (auto surface : descendant->components<Surface>())
+				removeSurface(surface);
+		},
+		true
+	);
 }
 
 void
@@ -237,38 +282,490 @@ void
 Renderer::addSurface(Surface::Ptr surface)
 {
 	_drawCallPool->addSurface(surface);
+	if (_depthPrePassPool)
+		_depthPrePassPool->addSurface(surface);
 }
 
 void
 Renderer::removeSurface(Surface::Ptr surface)
 {
 	_drawCallPool->removeSurface(surface);
+	if (_depthPrePassPool)
+		_depthPrePassPool->removeSurface(surface);
+}
+
+void
+Renderer::frontToBack(bool value)
+{
+	if (value == _frontToBack)
+		return;
+
+	_frontToBack = value;
+	_drawCallPool->invalidateRenderQueue();
+	if (_depthPrePassPool)
+		_depthPrePassPool->invalidateRenderQueue();
+}
+
+void
+Renderer::depthPrePass(EffectPtr effect)
+{
+	if (effect == _depthPrePassEffect)
+		return;
+
+	_depthPrePassEffect = effect;
+	_depthPrePassPool = nullptr;
+	_depthPrePassDrawCalls.clear();
+
+	if (!effect)
+		return;
+
+	// the depth-only draw calls are generated from the same surfaces with the depth effect
+	_depthPrePassPool = DrawCallPool::create(shared_from_this(), effect);
+
+	if (targets().empty())
+		return;
+
+	std::vector<Surface::Ptr> surfaces;
+
+	NodeSet::visitDescendants(
+		targets()[0]->root(),
+		[&](const scene::Node::Ptr& descendant)
+		{
+			const auto& descendantSurfaces = descendant->components<Surface>();
+
+			surfaces.insert(surfaces.end(), descendantSurfaces.begin(), descendantSurfaces.end());
+		},
+		true
+	);
+
+	_depthPrePassPool->addSurfaces(surfaces);
+}
+
+void
+Renderer::views(const std::vector<View>& views)
+{
+	if (!views.empty() && _dynamicResolution)
+		throw std::logic_error("Views cannot be rendered with a dynamic resolution.");
+
+	for (auto& view : views)
+		if (!view.viewMatrix || !view.projectionMatrix || view.region.width < 0 || view.region.height < 0)
+			throw std::invalid_argument("views");
+
+	_views = views;
+	_viewWorldToScreen.resize(views.size());
+	for (auto& worldToScreen : _viewWorldToScreen)
+		if (!worldToScreen)
+			worldToScreen = math::Matrix4x4::create();
+}
+
+void
+Renderer::renderDrawCall(const AbsContext&			context,
+						 const AbsTexturePtr&		renderTarget,
+						 uint						drawCallIndex,
+						 const render::ScissorBox*	scissorBox)
+{
+	auto previous = drawCallIndex > 0 ? _submittedDrawCalls[drawCallIndex - 1] : nullptr;
+
+	// the recorded changes were diffed against the previous draw call, not against the instances it
+	// drew on their own
+	if (previous && previous->renderedFallbacks())
+		_submittedDrawCalls[drawCallIndex]->render(context, renderTarget, nullptr, scissorBox, nullptr);
+	else
+		_submittedDrawCalls[drawCallIndex]->render(
+			context,
+			renderTarget,
+			previous,
+			scissorBox,
+			&_drawCallChanges[drawCallIndex]
+		);
+}
+
+void
+Renderer::renderViews(const AbsContext& context, const AbsTexturePtr& renderTarget, uint drawCallIndex)
+{
+	// the textures, vertex buffers and states of the draw call remain bound for its other views
+	const render::DrawCall::Changes unchanged = { false, 0u, 0u, false };
+	auto drawCall = _submittedDrawCalls[drawCallIndex];
+
+	for (uint i = 0; i < _views.size(); ++i)
+	{
+		const auto& view = _views[i];
+
+		// the matrices are overwritten in place: the draw calls point to their values
+		std::copy(view.viewMatrix->data().begin(), view.viewMatrix->data().end(), _cameraMatrices[0]->data().begin());
+		std::copy(view.projectionMatrix->data().begin(), view.projectionMatrix->data().end(), _cameraMatrices[1]->data().begin());
+		std::copy(_viewWorldToScreen[i]->data().begin(), _viewWorldToScreen[i]->data().end(), _cameraMatrices[2]->data().begin());
+		render::DrawCall::invalidateSharedUniforms();
+
+		context->setScissorTest(true, view.region);
+		if (i == 0)
+			renderDrawCall(context, renderTarget, drawCallIndex, &view.region);
+		// the instances drawn on their own left their bindings in the context
+		else if (drawCall->renderedFallbacks())
+			drawCall->render(context, renderTarget, nullptr, &view.region, nullptr);
+		else
+			drawCall->render(context, renderTarget, drawCall, &view.region, &unchanged);
+	}
+}
+
+void
+Renderer::dynamicResolution(std::shared_ptr<render::DynamicResolution> value)
+{
+	if (value && !_views.empty())
+		throw std::logic_error("Views cannot be rendered with a dynamic resolution.");
+
+	_dynamicResolution = value;
+	_lastRenderTime = 0;
+	// created with the context given to render()
+	_upscaleQuad = nullptr;
+}
+
+void
+Renderer::upscale(const AbsContext& context, const AbsTexturePtr& renderTarget)
+{
+	if (!_upscaleQuad)
+	{
+		auto upscaleRenderer = Renderer::create(0);
+		auto material = material::Material::create();
+
+		material->set("colorTexture", AbsTexturePtr());
+		material->set("uvScale", math::Vector2::create(1.f, 1.f));
+
+		// the upscaled frame is presented by the renderer owning the quad, after its beforePresent() signal
+		upscaleRenderer->_present = false;
+		_upscaleQuad = scene::Node::create()
+			->addComponent(upscaleRenderer)
+			->addComponent(Surface::create(
+				geometry::QuadGeometry::create(context),
+				material,
+				_dynamicResolution->effect()
+			));
+	}
+
+	auto material = _upscaleQuad->component<Surface>()->material();
+	auto uvScale = material->get<math::Vector2::Ptr>("uvScale");
+	const float scaleX = (float)_dynamicResolution->regionWidth() / (float)renderTarget->width();
+	const float scaleY = (float)_dynamicResolution->regionHeight() / (float)renderTarget->height();
+
+	if (material->get<AbsTexturePtr>("colorTexture") != renderTarget)
+		material->set("colorTexture", renderTarget);
+	if (uvScale->x() != scaleX || uvScale->y() != scaleY)
+		material->set("uvScale", math::Vector2::create(scaleX, scaleY));
+
+	_upscaleQuad->component<Renderer>()->render(context, nullptr, true);
+}
+
+void
+Renderer::updateDynamicResolution(const AbsContext& context, render::GPUTimer* gpuTimer)
+{
+	if (gpuTimer)
+	{
+		// the results arrive a few frames late: the same frame can be measured twice
+		if (gpuTimer->frameTime() != 0)
+			_dynamicResolution->update(gpuTimer->frameTime() / 1e6f);
+
+		return;
+	}
+
+	// without timer queries, a fill rate bound GPU stalls the frames as a whole
+	auto time = Profiler::time();
+
+	if (_lastRenderTime != 0)
+		_dynamicResolution->update((time - _lastRenderTime) / 1e6f);
+	_lastRenderTime = time;
+}
+
+render::ScissorBox
+Renderer::scaleCamera(const AbsTexturePtr& renderTarget, std::vector<float>& cameraMatrices)
+{
+	if (targets().empty() || !targets()[0]->data()->hasProperty("camera.viewMatrix"))
+		throw std::logic_error("The dynamic resolution scales the projection of the camera of the renderer.");
+
+	auto data	= targets()[0]->data();
+	auto region	= render::ScissorBox();
+
+	region.width = _dynamicResolution->regionWidth();
+	region.height = _dynamicResolution->regionHeight();
+
+	_cameraMatrices = {
+		data->get<math::Matrix4x4::Ptr>("camera.viewMatrix"),
+		data->get<math::Matrix4x4::Ptr>("camera.projectionMatrix"),
+		data->get<math::Matrix4x4::Ptr>("camera.worldToScreenMatrix")
+	};
+	for (auto& matrix : _cameraMatrices)
+		cameraMatrices.insert(cameraMatrices.end(), matrix->data().begin(), matrix->data().end());
+
+	// the clip space is mapped to the bottom left region of the target
+	const float scaleX = (float)region.width / (float)renderTarget->width();
+	const float scaleY = (float)region.height / (float)renderTarget->height();
+
+	_scaledProjection->lock()
+		->copyFrom(_cameraMatrices[1])
+		->appendScale(scaleX, scaleY, 1.f)
+		->appendTranslation(scaleX - 1.f, scaleY - 1.f)
+		->unlock();
+
+	// the matrices are overwritten in place like the ones of the views
+	std::copy(_scaledProjection->data().begin(), _scaledProjection->data().end(), _cameraMatrices[1]->data().begin());
+	_scaledProjection->lock()->copyFrom(_cameraMatrices[0])->append(_cameraMatrices[1])->unlock();
+	std::copy(_scaledProjection->data().begin(), _scaledProjection->data().end(), _cameraMatrices[2]->data().begin());
+	render::DrawCall::invalidateSharedUniforms();
+
+	return region;
+}
+
+void
+Renderer::renderDepthPrePass(const AbsContext&			context,
+							 const AbsTexturePtr&		renderTarget,
+							 const render::ScissorBox*	scissorBox)
+{
+	const auto& drawCalls	= _depthPrePassPool->drawCalls();
+	const auto& layouts		= _depthPrePassPool->layouts();
+
+	_depthPrePassDrawCalls.clear();
+	for (uint i = 0; i < drawCalls.size(); ++i)
+	{
+		const auto& drawCall = drawCalls[i];
+		const auto priority = drawCall->priority();
+
+		// transparent and background surfaces do not occlude anything
+		if (drawCall->enabled() && (_layoutMask == 0xffffffff || (layouts[i] & _layoutMask) != 0) && !drawCall->zSorted()
+			&& priority > render::priority::TRANSPARENT && priority < render::priority::BACKGROUND)
+			_depthPrePassDrawCalls.push_back(drawCall.get());
+	}
+
+	for (uint i = 0; i < _depthPrePassDrawCalls.size(); ++i)
+		_depthPrePassDrawCalls[i]->render(
+			context,
+			renderTarget,
+			i > 0 ? _depthPrePassDrawCalls[i - 1] : nullptr,
+			scissorBox
+		);
+}
+
+void
+Renderer::recordDrawCallChanges(const AbsTexturePtr& renderTarget)
+{
+	const auto& drawCalls	= *_drawCalls;
+	const auto& layouts		= _drawCallPool->layouts();
+
+	_submittedDrawCalls.clear();
+	if (_layoutMask == 0xffffffff)
+	{
+		for (auto& drawCall : drawCalls)
+			if (drawCall->enabled())
+				_submittedDrawCalls.push_back(drawCall.get());
+	}
+	else
+	{
+		// the layouts are ANDed with the mask in a dense pass, the draw calls are only read if they pass
+		_layoutTests.resize(drawCalls.size());
+		for (uint i = 0; i < drawCalls.size(); ++i)
+			_layoutTests[i] = (layouts[i] & _layoutMask) != 0;
+
+		for (uint i = 0; i < drawCalls.size(); ++i)
+			if (_layoutTests[i] && drawCalls[i]->enabled())
+				_submittedDrawCalls.push_back(drawCalls[i].get());
+	}
+
+	const uint numDrawCalls = _submittedDrawCalls.size();
+
+	_drawCallChanges.resize(numDrawCalls);
+
+	auto record = [this, renderTarget](uint begin, uint end)
+	{
+		for (uint i = begin; i < end; ++i)
+			_submittedDrawCalls[i]->recordChanges(
+				i > 0 ? _submittedDrawCalls[i - 1] : nullptr, renderTarget, _drawCallChanges[i]
+			);
+	};
+
+	// only the context calls have to be made by the rendering thread
+	if (numDrawCalls >= PARALLEL_RECORD_MIN_NUM_DRAWCALLS && _numWorkers > 1)
+	{
+		const uint rangeSize = (numDrawCalls + _numWorkers - 1) / _numWorkers;
+
+#if !defined(MINKO_NO_THREADS)
+		std::vector<std::future<void>> workers;
+
+		for (uint begin = rangeSize; begin < numDrawCalls; begin += rangeSize)
+			workers.push_back(std::async(std::launch::async, record, begin, std::min(begin + rangeSize, numDrawCalls)));
+#endif
+
+		record(0, std::min(rangeSize, numDrawCalls));
+
+#if !defined(MINKO_NO_THREADS)
+		for (auto& worker : workers)
+			worker.get();
+#endif
+	}
+	else
+		record(0, numDrawCalls);
 }
 
 void
 Renderer::render(render::AbstractContext::Ptr	context, 
-				 render::AbstractTexture::Ptr	renderTarget)
+				 render::AbstractTexture::Ptr	renderTarget,
+				 bool							clear)
 {
-	_drawCalls = _drawCallPool->drawCalls();
+	MINKO_PROFILE_SCOPE("Renderer::render");
+
+	const auto renderStats = context->renderStats();
+
+	// deferred property changes can rebind or regenerate draw calls
+	data::Container::flushAllChanges();
+	render::DrawCall::invalidateSharedUniforms();
+
+	if (_instancingEnabled != (_instancing && context->supportsInstancing()))
+		enableInstancing(!_instancingEnabled);
+
+	_drawCalls = &_drawCallPool->drawCalls();
 	
 	_renderingBegin->execute(shared_from_this());
 
 	if (!renderTarget)
 		renderTarget = _renderTarget;
 
-	context->clear(
-		((_backgroundColor >> 24) & 0xff) / 255.f,
-		((_backgroundColor >> 16) & 0xff) / 255.f,
-		((_backgroundColor >> 8) & 0xff) / 255.f,
-		(_backgroundColor & 0xff) / 255.f
-	);
+	// the back buffer is replaced by the offscreen target of the dynamic resolution
+	const bool dynamicResolution = _dynamicResolution && !renderTarget;
 
-	for (auto& drawCall : _drawCalls)
-		drawCall->render(context, renderTarget);
+	if (dynamicResolution)
+		renderTarget = _dynamicResolution->target(context, context->viewportWidth(), context->viewportHeight());
+
+	// the GPU times are only measured while the profiler records or for the dynamic resolution
+	render::GPUTimer* gpuTimer = nullptr;
+
+	if ((Profiler::enabled() || dynamicResolution) && context->supportsTimerQueries())
+	{
+		if (!_gpuTimer)
+			_gpuTimer = render::GPUTimer::create(context);
+
+		gpuTimer = _gpuTimer.get();
+		gpuTimer->update();
+		gpuTimer->nextFrame();
+		gpuTimer->begin("Renderer::render");
+	}
+
+	if (dynamicResolution)
+		updateDynamicResolution(context, gpuTimer);
+
+	// the views share the render target: it is bound first to be cleared once for all of them
+	std::vector<float> cameraMatrices;
+
+	if (!_views.empty())
+	{
+		if (targets().empty() || !targets()[0]->data()->hasProperty("camera.viewMatrix"))
+			throw std::logic_error("The views of a renderer replace the matrices of its camera.");
+
+		auto data = targets()[0]->data();
+
+		_cameraMatrices = {
+			data->get<math::Matrix4x4::Ptr>("camera.viewMatrix"),
+			data->get<math::Matrix4x4::Ptr>("camera.projectionMatrix"),
+			data->get<math::Matrix4x4::Ptr>("camera.worldToScreenMatrix")
+		};
+		for (auto& matrix : _cameraMatrices)
+			cameraMatrices.insert(cameraMatrices.end(), matrix->data().begin(), matrix->data().end());
+
+		for (uint i = 0; i < _views.size(); ++i)
+			_viewWorldToScreen[i]->lock()->copyFrom(_views[i].viewMatrix)->append(_views[i].projectionMatrix)->unlock();
+
+		if (renderTarget)
+			context->setRenderToTexture(renderTarget->id(), true);
+		else
+			context->setRenderToBackBuffer();
+	}
+
+	// only the scaled region of the offscreen target is cleared and rendered
+	render::ScissorBox dynamicResolutionRegion;
+	const render::ScissorBox* scissorBox = _scissorTest ? &_scissorBox : nullptr;
+
+	if (dynamicResolution)
+	{
+		dynamicResolutionRegion = scaleCamera(renderTarget, cameraMatrices);
+		scissorBox = &dynamicResolutionRegion;
+		context->setRenderToTexture(renderTarget->id(), true);
+	}
+
+	if (scissorBox)
+		context->setScissorTest(true, *scissorBox);
+
+	if (clear)
+		context->clear(
+			((_backgroundColor >> 24) & 0xff) / 255.f,
+			((_backgroundColor >> 16) & 0xff) / 255.f,
+			((_backgroundColor >> 8) & 0xff) / 255.f,
+			(_backgroundColor & 0xff) / 255.f
+		);
+
+	// the pre-pass is rendered with the camera of the renderer, not the ones of the views
+	if (_depthPrePassPool && _views.empty())
+		renderDepthPrePass(context, renderTarget, scissorBox);
+
+	recordDrawCallChanges(renderTarget);
+
+	// evicted textures are uploaded again before being rendered
+	if (_sceneManager && _sceneManager->assets()->memoryBudget())
+	{
+		auto memoryBudget = _sceneManager->assets()->memoryBudget();
+
+		for (auto drawCall : _submittedDrawCalls)
+			for (auto textureId : drawCall->textureIds())
+				if (textureId > 0)
+					memoryBudget->touch(textureId);
+	}
+
+	const char* gpuTimerName = "Renderer::render";
+
+	for (uint i = 0; i < _submittedDrawCalls.size(); ++i)
+	{
+		// timer queries cannot be nested: the draw calls of each pass are timed one after the other
+		if (gpuTimer && _submittedDrawCalls[i]->profileName()
+			&& _submittedDrawCalls[i]->profileName() != gpuTimerName)
+		{
+			gpuTimerName = _submittedDrawCalls[i]->profileName();
+			gpuTimer->begin(gpuTimerName);
+		}
+
+		if (!_views.empty())
+		{
+			renderViews(context, renderTarget, i);
+
+			continue;
+		}
+
+		renderDrawCall(context, renderTarget, i, scissorBox);
+	}
+
+	if (gpuTimer)
+		gpuTimer->end();
+
+	if (!cameraMatrices.empty())
+	{
+		auto value = cameraMatrices.begin();
+
+		for (auto& matrix : _cameraMatrices)
+		{
+			std::copy(value, value + 16, matrix->data().begin());
+			value += 16;
+		}
+		_cameraMatrices.clear();
+		render::DrawCall::invalidateSharedUniforms();
+	}
+
+	if (scissorBox || !_views.empty())
+		context->setScissorTest(false, _scissorBox);
+
+	if (dynamicResolution)
+		upscale(context, renderTarget);
 
 	_beforePresent->execute(shared_from_this());
 
-	context->present();
+	// pipelined scene managers present once the next frame is simulated
+	if (_present && (!_sceneManager || !_sceneManager->pipelined()))
+		context->present();
+
+	_renderStats = context->renderStats() - renderStats;
 
 	_renderingEnd->execute(shared_from_this());
 }
@@ -291,6 +788,21 @@ Renderer::findSceneManager()
 		setSceneManager(nullptr);
 }
 
+void
+Renderer::enableInstancing(bool enabled)
+{
+	if (targets().empty())
+		return;
+
+	// the INSTANCING macro is bound to the renderer's data: the draw calls will be rebuilt accordingly
+	if (enabled)
+		targets()[0]->data()->addProvider(_instancingData);
+	else
+		targets()[0]->data()->removeProvider(_instancingData);
+
+	_instancingEnabled = enabled;
+}
+
 void
 Renderer::setSceneManager(std::shared_ptr<SceneManager> sceneManager)
 {
@@ -320,5 +832,8 @@ Renderer::sceneManagerRenderingBeginHandler(std::shared_ptr<SceneManager>	sceneM
 										    uint							frameId,
 										    AbstractTexture::Ptr			renderTarget)
 {
+	if (!_enabled)
+		return;
+
 	render(sceneManager->assets()->context(), renderTarget);
 }
\ No newline at end of file
@@ -22,13 +22,37 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/file/AssetLibrary.hpp"
 #include "minko/scene/Node.hpp"
 #include "minko/render/AbstractTexture.hpp"
+#include "minko/math/OctTree.hpp"
+#include "minko/math/Vector3.hpp"
+#include "minko/math/Matrix4x4.hpp"
+#include "minko/math/Ray.hpp"
+#include "minko/component/Surface.hpp"
+#include "minko/component/Transform.hpp"
+#include "minko/scene/NodeSet.hpp"
+#include "minko/data/Provider.hpp"
+#include "minko/geometry/Geometry.hpp"
+#include "minko/data/Container.hpp"
+#include "minko/render/AbstractContext.hpp"
+#include "minko/render/MemoryBudget.hpp"
+#include "minko/AbstractCanvas.hpp"
+#include "minko/Profiler.hpp"
+#include "minko/SignalStats.hpp"
+#include "minko/async/SystemScheduler.hpp"
 
 using namespace minko;
 using namespace minko::component;
 
 SceneManager::SceneManager(const std::shared_ptr<render::AbstractContext>& context) :
     _frameId(0),
+    _time(0.f),
+    _pipelined(false),
+    _nextFrameSimulated(false),
 	_assets(file::AssetLibrary::create(context)),
+	_octTree(math::OctTree::create(50, 7, math::Vector3::create(0.f, 0.f, 0.f), 0, true)),
+	_systems(async::SystemScheduler::create()),
+    _animationTime(0.f),
+    _numAnimationUpdates(0),
+    _numSkippedAnimationUpdates(0),
     _frameBegin(Signal<Ptr, float, float>::create()),
     _frameEnd(Signal<Ptr, float, float>::create()),
 	_cullBegin(Signal<Ptr>::create()),
@@ -64,12 +88,43 @@ SceneManager::targetAddedHandler(AbstractComponent::Ptr ctrl, NodePtr target)
         std::placeholders::_2,
         std::placeholders::_3
     ));
+    _removedSlot = target->removed()->connect(std::bind(
+        &SceneManager::removedHandler,
+        shared_from_this(),
+        std::placeholders::_1,
+        std::placeholders::_2,
+        std::placeholders::_3
+    ));
+    _componentAddedSlot = target->componentAdded()->connect([this](NodePtr node, NodePtr target, AbstractComponent::Ptr ctrl)
+    {
+        watchComponent(ctrl);
+    });
+    _componentRemovedSlot = target->componentRemoved()->connect([this](NodePtr node, NodePtr target, AbstractComponent::Ptr ctrl)
+    {
+        unwatchComponent(ctrl);
+    });
+
+    scene::NodeSet::visitDescendants(
+        target,
+        [&](const NodePtr& descendant)
+        {
+            for (auto& component : descendant->components<AbstractComponent>())
+                watchComponent(component);
+        },
+        true
+    );
 }
 
 void
 SceneManager::targetRemovedHandler(AbstractComponent::Ptr ctrl, NodePtr target)
 {
     _addedSlot = nullptr;
+    _removedSlot = nullptr;
+    _componentAddedSlot = nullptr;
+    _componentRemovedSlot = nullptr;
+    _matrixChangedSlots.clear();
+    _materialChangedSlots.clear();
+    _materialPropertyChangedSlots.clear();
 }
 
 void
@@ -77,19 +132,251 @@ SceneManager::addedHandler(NodePtr node, NodePtr target, NodePtr ancestor)
 {
     if (target == targets()[0])
         throw std::logic_error("SceneManager must be on the root node only.");
+
+    // the components of the added nodes do not execute componentAdded on the root
+    scene::NodeSet::visitDescendants(
+        target,
+        [&](const NodePtr& descendant)
+        {
+            for (auto& component : descendant->components<AbstractComponent>())
+                watchComponent(component);
+        },
+        true
+    );
+
+    invalidate();
+}
+
+void
+SceneManager::removedHandler(NodePtr node, NodePtr target, NodePtr ancestor)
+{
+    scene::NodeSet::visitDescendants(
+        target,
+        [&](const NodePtr& descendant)
+        {
+            for (auto& component : descendant->components<AbstractComponent>())
+                unwatchComponent(component);
+        },
+        true
+    );
+
+    invalidate();
+}
+
+void
+SceneManager::watchComponent(AbstractComponent::Ptr component)
+{
+    // moving nodes and material changes show a new frame on a canvas rendering on demand
+    if (auto transform = std::dynamic_pointer_cast<Transform>(component))
+    {
+        if (_matrixChangedSlots.count(component) == 0)
+            _matrixChangedSlots[component] = transform->matrix()->changed()->connect(
+                [this](data::Value::Ptr)
+                {
+                    invalidate();
+                }
+            );
+    }
+    else if (auto surface = std::dynamic_pointer_cast<Surface>(component))
+    {
+        if (_materialChangedSlots.count(component) != 0)
+            return;
+
+        // the material that replaces the previous one is watched in its place
+        _materialChangedSlots[component] = surface->materialChanged()->connect(
+            [this](Surface::Ptr surface)
+            {
+                watchMaterial(surface);
+                invalidate();
+            }
+        );
+        watchMaterial(surface);
+    }
+}
+
+void
+SceneManager::unwatchComponent(AbstractComponent::Ptr component)
+{
+    _matrixChangedSlots.erase(component);
+    _materialChangedSlots.erase(component);
+    _materialPropertyChangedSlots.erase(component);
+}
+
+void
+SceneManager::watchMaterial(Surface::Ptr surface)
+{
+    auto materialChanged = [this](data::Provider::Ptr, const std::string&)
+    {
+        invalidate();
+    };
+    auto& slots = _materialPropertyChangedSlots[surface];
+
+    slots.clear();
+    slots.push_back(surface->material()->propertyValueChanged()->connect(materialChanged));
+    slots.push_back(surface->material()->propertyReferenceChanged()->connect(materialChanged));
+}
+
+void
+SceneManager::invalidate()
+{
+    AbstractCanvas::invalidateDefaultCanvas();
+}
+
+void
+SceneManager::pipelined(bool value)
+{
+    _pipelined = value;
+    _nextFrameSimulated = false;
 }
 
 void
 SceneManager::nextFrame(float time, float deltaTime, render::AbstractTexture::Ptr renderTarget)
 {
-    _time = time;
+	MINKO_PROFILE_SCOPE("SceneManager::nextFrame");
+
+	const auto renderStats = _assets->context()->renderStats();
+
+    // a pipelined frame was already simulated at the end of the previous call
+    if (!_nextFrameSimulated)
+    {
+        _time = time;
+        simulate(time, deltaTime);
+    }
+    _nextFrameSimulated = false;
 
-	_frameBegin->execute(shared_from_this(), time, deltaTime);
 	_cullBegin->execute(shared_from_this());
 	_cullEnd->execute(shared_from_this());
 	_renderBegin->execute(shared_from_this(), _frameId, renderTarget);
 	_renderEnd->execute(shared_from_this(), _frameId, renderTarget);
-    _frameEnd->execute(shared_from_this(), time, deltaTime);
+    _frameEnd->execute(shared_from_this(), _time, deltaTime);
+
+	if (_assets->memoryBudget())
+		_assets->memoryBudget()->nextFrame();
 
 	++_frameId;
+
+    if (_pipelined)
+    {
+        // the draw calls of this frame are already submitted: the scene can be updated while the GPU
+        // renders them, presenting is what waits for the GPU
+        _time += deltaTime;
+        simulate(_time, deltaTime);
+        _nextFrameSimulated = true;
+
+        _assets->context()->present();
+    }
+
+	_renderStats = _assets->context()->renderStats() - renderStats;
+
+	if (Profiler::enabled())
+		profileRenderStats();
+
+	if (SignalStats::enabled())
+		SignalStats::nextFrame();
+}
+
+void
+SceneManager::simulate(float time, float deltaTime)
+{
+    resetAnimationStats();
+    _frameBegin->execute(shared_from_this(), time, deltaTime);
+    _systems->execute(time, deltaTime);
+}
+
+uint
+SceneManager::raycast(std::shared_ptr<math::Ray>	ray,
+					  std::vector<RaycastHit>&		hits,
+					  uint							layoutMask,
+					  uint							maxHits)
+{
+	hits.clear();
+	if (maxHits == 0)
+		return 0;
+
+	_rayCandidates.clear();
+	_octTree->testRay(ray, _rayCandidates);
+
+	std::sort(
+		_rayCandidates.begin(),
+		_rayCandidates.end(),
+		[](const std::pair<float, NodePtr>& a, const std::pair<float, NodePtr>& b) { return a.first < b.first; }
+	);
+
+	auto worldToModel	= math::Matrix4x4::create();
+	auto localRay		= math::Ray::create();
+
+	for (auto& candidate : _rayCandidates)
+	{
+		auto node = candidate.second;
+
+		// the rest of the candidates start behind the farthest hit kept
+		if (hits.size() == maxHits && candidate.first > hits.back().second)
+			break;
+
+		if ((node->layouts() & layoutMask) == 0)
+			continue;
+
+		if (node->data()->hasProperty("transform.modelToWorldMatrix"))
+			worldToModel->copyFrom(node->data()->get<std::shared_ptr<math::Matrix4x4>>("transform.modelToWorldMatrix"))->invert();
+		else
+			worldToModel->identity();
+
+		// the direction is not normalized so that distances along the ray stay in world units
+		worldToModel->transform(ray->origin(), localRay->origin());
+		worldToModel->deltaTransform(ray->direction(), localRay->direction());
+
+		auto	hit			= false;
+		auto	minDistance	= std::numeric_limits<float>::max();
+
+		for (auto& surface : node->components<Surface>())
+		{
+			auto	distance	= 0.f;
+			uint	triangle	= 0;
+
+			if (surface->geometry()->cast(localRay, distance, triangle) && distance < minDistance)
+			{
+				minDistance = distance;
+				hit = true;
+			}
+		}
+
+		if (!hit || (hits.size() == maxHits && minDistance >= hits.back().second))
+			continue;
+
+		auto hitIt = std::upper_bound(
+			hits.begin(),
+			hits.end(),
+			minDistance,
+			[](float distance, const RaycastHit& hit) { return distance < hit.second; }
+		);
+
+		hits.insert(hitIt, RaycastHit(node, minDistance));
+		if (hits.size() > maxHits)
+			hits.pop_back();
+	}
+
+	return hits.size();
+}
+
+void
+SceneManager::resetAnimationStats()
+{
+    _animationTime = 0.f;
+    _numAnimationUpdates = 0;
+    _numSkippedAnimationUpdates = 0;
+}
+
+void
+SceneManager::profileRenderStats()
+{
+	Profiler::counter("numDrawCalls", _renderStats.numDrawCalls);
+	Profiler::counter("numTriangles", _renderStats.numTriangles);
+	Profiler::counter("numProgramSwitches", _renderStats.numProgramSwitches);
+	Profiler::counter("numTextureBinds", _renderStats.numTextureBinds);
+	Profiler::counter("numBufferBinds", _renderStats.numBufferBinds);
+	Profiler::counter("numUniformCalls", _renderStats.numUniformCalls);
+	Profiler::counter("numFrameBufferSwitches", _renderStats.numFrameBufferSwitches);
+	Profiler::counter("numBytesUploaded", _renderStats.numBytesUploaded);
+	Profiler::counter("bufferMemory", _assets->context()->bufferMemory());
+	Profiler::counter("textureMemory", _assets->context()->textureMemory());
 }
@@ -0,0 +1,672 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/component/ShadowMapping.hpp"
+
+#include "minko/scene/Node.hpp"
+#include "minko/scene/NodeSet.hpp"
+#include "minko/component/SceneManager.hpp"
+#include "minko/component/Renderer.hpp"
+#include "minko/component/Surface.hpp"
+#include "minko/component/BoundingBox.hpp"
+#include "minko/component/PerspectiveCamera.hpp"
+#include "minko/component/DirectionalLight.hpp"
+#include "minko/component/SpotLight.hpp"
+#include "minko/component/LightCulling.hpp"
+#include "minko/data/ArrayProvider.hpp"
+#include "minko/data/StructureProvider.hpp"
+#include "minko/render/AbstractContext.hpp"
+#include "minko/render/Texture.hpp"
+#include "minko/math/Box.hpp"
+#include "minko/math/Frustum.hpp"
+#include "minko/math/Matrix4x4.hpp"
+#include "minko/math/Vector3.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::math;
+
+const uint	ShadowMapping::MAX_NUM_CASCADES	= 4;
+const float	ShadowMapping::CASCADE_PADDING	= .2f;
+
+// after RootTransform, before the renderers of the scene
+static const float UPDATE_PRIORITY			= 900.f;
+static const float RENDERERS_PRIORITY		= 800.f;
+
+// the near plane of the maps is not tested: casters between the light and the volume still cast shadows
+static const uint CULLING_PLANES = Frustum::ALL_PLANES & ~(1u << (uint)PlanePosition::NEAR);
+
+ShadowMapping::ShadowMapping(std::shared_ptr<render::AbstractContext>	context,
+							 std::shared_ptr<render::Effect>			effect,
+							 uint										size,
+							 uint										numCascades) :
+	_context(context),
+	_effect(effect),
+	_size(size),
+	_numCascades(numCascades),
+	_camera(nullptr),
+	_shadowDistance(100.f),
+	_splitLambda(.75f),
+	_bias(.002f),
+	_directionalLight(nullptr),
+	_spotLight(nullptr),
+	_data(nullptr),
+	_root(nullptr),
+	_maps(),
+	_numRenderedMaps(0),
+	_casters(),
+	_casterIds(),
+	_movedCasters(),
+	_invalidCasters(false)
+{
+	if (numCascades == 0 || numCascades > MAX_NUM_CASCADES)
+		throw std::invalid_argument("numCascades");
+
+	std::fill(_lightBasis, _lightBasis + 9, 0.f);
+	std::fill(_lightState, _lightState + 8, 0.f);
+}
+
+void
+ShadowMapping::initialize()
+{
+	_targetAddedSlot = targetAdded()->connect(std::bind(
+		&ShadowMapping::targetAddedHandler,
+		shared_from_this(),
+		std::placeholders::_1,
+		std::placeholders::_2
+	));
+
+	_targetRemovedSlot = targetRemoved()->connect(std::bind(
+		&ShadowMapping::targetRemovedHandler,
+		shared_from_this(),
+		std::placeholders::_1,
+		std::placeholders::_2
+	));
+}
+
+void
+ShadowMapping::targetAddedHandler(AbsCtrlPtr ctrl, NodePtr target)
+{
+	if (targets().size() > 1)
+		throw std::logic_error("ShadowMapping cannot have more than one target.");
+
+	_directionalLight = target->component<DirectionalLight>();
+	_spotLight = target->component<SpotLight>();
+
+	if (!_directionalLight && !_spotLight)
+		throw std::logic_error("ShadowMapping must be added to a DirectionalLight or a SpotLight.");
+
+	createMaps(target);
+
+	auto rootChanged = [this](NodePtr node, NodePtr target, NodePtr ancestor)
+	{
+		setRoot(node->root());
+	};
+
+	_targetAddedToNodeSlot = target->added()->connect(rootChanged);
+	_targetRemovedFromNodeSlot = target->removed()->connect(rootChanged);
+
+	setRoot(target->root());
+}
+
+void
+ShadowMapping::targetRemovedHandler(AbsCtrlPtr ctrl, NodePtr target)
+{
+	_targetAddedToNodeSlot = nullptr;
+	_targetRemovedFromNodeSlot = nullptr;
+
+	setRoot(nullptr);
+	removeMaps(target);
+
+	_directionalLight = nullptr;
+	_spotLight = nullptr;
+}
+
+void
+ShadowMapping::createMaps(NodePtr target)
+{
+	auto numMaps = _directionalLight ? _numCascades : 1;
+
+	_data = data::ArrayProvider::create(_directionalLight ? "directionalShadows" : "spotShadows");
+	_data
+		->set("bias",		_bias)
+		->set("texelSize",	1.f / (float)_size)
+		->set("lightId",	0);
+
+	if (_directionalLight)
+		_data->set("numCascades", (int)numMaps);
+
+	for (uint mapId = 0; mapId < numMaps; ++mapId)
+	{
+		ShadowMap map;
+
+		map.texture			= render::Texture::create(_context, _size, _size, false, true);
+		map.view			= Matrix4x4::create();
+		map.projection		= Matrix4x4::create();
+		map.viewProjection	= Matrix4x4::create();
+		map.frustum			= Frustum::create();
+		map.camera			= data::StructureProvider::create("camera");
+		// only rendered when update() finds the map invalid
+		map.renderer		= Renderer::create(0, map.texture, _effect, RENDERERS_PRIORITY);
+		map.renderer->enabled(false);
+		map.node			= scene::Node::create("shadowMap" + std::to_string(mapId));
+		map.x				= 0.f;
+		map.y				= 0.f;
+		map.z				= 0.f;
+		map.halfSize		= 0.f;
+		map.invalid			= true;
+		map.numCasters		= 0;
+
+		map.camera
+			->set("viewMatrix",				map.view)
+			->set("projectionMatrix",		map.projection)
+			->set("worldToScreenMatrix",	map.viewProjection);
+		map.node->data()->addProvider(map.camera);
+
+		auto suffix = _directionalLight ? std::to_string(mapId) : std::string();
+
+		_data
+			->set<render::AbstractTexture::Ptr>("map" + suffix,	map.texture)
+			->set("viewProjection" + suffix,					map.viewProjection);
+
+		_maps.push_back(map);
+	}
+
+	for (auto& map : _maps)
+	{
+		map.node->addComponent(map.renderer);
+		target->addChild(map.node);
+	}
+}
+
+void
+ShadowMapping::removeMaps(NodePtr target)
+{
+	for (auto& map : _maps)
+	{
+		target->removeChild(map.node);
+		map.node->removeComponent(map.renderer);
+	}
+
+	_maps.clear();
+	_data = nullptr;
+}
+
+void
+ShadowMapping::setRoot(NodePtr root)
+{
+	if (root == _root)
+		return;
+
+	if (_root)
+		_root->data()->removeProvider(_data);
+
+	_root = root;
+	_invalidCasters = true;
+
+	if (!root)
+	{
+		_addedSlot = nullptr;
+		_removedSlot = nullptr;
+		_componentAddedSlot = nullptr;
+		_componentRemovedSlot = nullptr;
+		_modelToWorldChangedSlot = nullptr;
+		setSceneManager(nullptr);
+		_casters.clear();
+		_casterIds.clear();
+		_movedCasters.clear();
+
+		return;
+	}
+
+	root->data()->addProvider(_data);
+
+	auto invalidate = [this](NodePtr, NodePtr, NodePtr)
+	{
+		_invalidCasters = true;
+	};
+
+	_addedSlot = root->added()->connect(invalidate);
+	_removedSlot = root->removed()->connect(invalidate);
+	_componentAddedSlot = root->componentAdded()->connect([this](NodePtr node, NodePtr target, AbsCtrlPtr ctrl)
+	{
+		auto sceneManager = std::dynamic_pointer_cast<SceneManager>(ctrl);
+
+		if (sceneManager)
+			setSceneManager(sceneManager);
+		if (std::dynamic_pointer_cast<Surface>(ctrl) || std::dynamic_pointer_cast<Transform::RootTransform>(ctrl))
+			_invalidCasters = true;
+	});
+	_componentRemovedSlot = root->componentRemoved()->connect([this](NodePtr node, NodePtr target, AbsCtrlPtr ctrl)
+	{
+		if (std::dynamic_pointer_cast<SceneManager>(ctrl))
+			setSceneManager(nullptr);
+		if (std::dynamic_pointer_cast<Surface>(ctrl) || std::dynamic_pointer_cast<Transform::RootTransform>(ctrl))
+			_invalidCasters = true;
+	});
+
+	setSceneManager(root->component<SceneManager>());
+}
+
+void
+ShadowMapping::setSceneManager(SceneManagerPtr sceneManager)
+{
+	if (sceneManager)
+		_renderingBeginSlot = sceneManager->renderingBegin()->connect(std::bind(
+			&ShadowMapping::update,
+			shared_from_this()
+		), UPDATE_PRIORITY);
+	else
+		_renderingBeginSlot = nullptr;
+}
+
+void
+ShadowMapping::bindCasters()
+{
+	_invalidCasters = false;
+
+	std::vector<NodePtr> casters;
+
+	scene::NodeSet::visitDescendants(
+		_root,
+		[&](const NodePtr& descendant)
+		{
+			if (descendant->hasComponent<Surface>())
+				casters.push_back(descendant);
+		},
+		true
+	);
+
+	auto rootTransform = _root->component<Transform::RootTransform>();
+
+	if (rootTransform)
+		_modelToWorldChangedSlot = rootTransform->modelToWorldChanged()->connect(
+			[this](Transform::RootTransform::Ptr rootTransform, const std::vector<NodePtr>& nodes)
+			{
+				for (auto& node : nodes)
+					if (_casterIds.count(node) != 0)
+						_movedCasters.push_back(node);
+			}
+		);
+	else
+		_modelToWorldChangedSlot = nullptr;
+
+	// nodes added or removed without a caster among them keep the maps as they are
+	auto changed = casters.size() != _casters.size();
+
+	for (auto casterIt = casters.begin(); casterIt != casters.end() && !changed; ++casterIt)
+		changed = _casterIds.count(*casterIt) == 0;
+
+	if (!changed)
+		return;
+
+	_casters.swap(casters);
+	_casterIds.clear();
+	_movedCasters.clear();
+
+	for (auto& bounds : _casterBounds)
+		bounds.resize(_casters.size());
+
+	for (uint casterId = 0; casterId < _casters.size(); ++casterId)
+	{
+		auto& caster = _casters[casterId];
+
+		if (!caster->hasComponent<BoundingBox>())
+			caster->addComponent(BoundingBox::create());
+
+		_casterIds[caster] = casterId;
+		updateCasterBounds(casterId);
+	}
+
+	for (auto& map : _maps)
+		map.invalid = true;
+}
+
+void
+ShadowMapping::updateCasterBounds(uint casterId)
+{
+	auto box		= _casters[casterId]->component<BoundingBox>()->box();
+	auto bottomLeft	= box->bottomLeft();
+	auto topRight	= box->topRight();
+
+	_casterBounds[0][casterId] = bottomLeft->x();
+	_casterBounds[1][casterId] = bottomLeft->y();
+	_casterBounds[2][casterId] = bottomLeft->z();
+	_casterBounds[3][casterId] = topRight->x();
+	_casterBounds[4][casterId] = topRight->y();
+	_casterBounds[5][casterId] = topRight->z();
+}
+
+bool
+ShadowMapping::updateLightBasis()
+{
+	auto direction = _directionalLight->worldDirection();
+
+	if (direction->x() == _lightState[0] && direction->y() == _lightState[1] && direction->z() == _lightState[2])
+		return false;
+
+	_lightState[0] = direction->x();
+	_lightState[1] = direction->y();
+	_lightState[2] = direction->z();
+
+	// same axes as Matrix4x4::view() looking along the direction of the light
+	auto zAxis	= Vector3::create(-direction->x(), -direction->y(), -direction->z())->normalize();
+	auto upAxis	= fabsf(zAxis->y()) > .99f ? Vector3::xAxis() : Vector3::yAxis();
+	auto xAxis	= Vector3::create()->copyFrom(upAxis)->cross(zAxis)->normalize();
+	auto yAxis	= Vector3::create()->copyFrom(zAxis)->cross(xAxis)->normalize();
+
+	_lightBasis[0] = xAxis->x();
+	_lightBasis[1] = xAxis->y();
+	_lightBasis[2] = xAxis->z();
+	_lightBasis[3] = yAxis->x();
+	_lightBasis[4] = yAxis->y();
+	_lightBasis[5] = yAxis->z();
+	_lightBasis[6] = zAxis->x();
+	_lightBasis[7] = zAxis->y();
+	_lightBasis[8] = zAxis->z();
+
+	return true;
+}
+
+void
+ShadowMapping::placeCascades()
+{
+	if (!_camera || !_camera->hasComponent<PerspectiveCamera>())
+		return;
+
+	auto perspectiveCamera	= _camera->component<PerspectiveCamera>();
+	auto view				= _camera->data()->get<Matrix4x4Ptr>("camera.viewMatrix")->data();
+	auto position			= _camera->data()->get<Vector3::Ptr>("camera.position");
+	auto tanHalfFov			= tanf(perspectiveCamera->fieldOfView() * .5f);
+	auto aspectRatio		= perspectiveCamera->aspectRatio();
+	// squared slope of the corners of the frustum
+	auto k2					= tanHalfFov * tanHalfFov * (1.f + aspectRatio * aspectRatio);
+	auto zNear				= perspectiveCamera->zNear();
+	auto zFar				= std::max(zNear, std::min(perspectiveCamera->zFar(), _shadowDistance));
+	auto numCascades		= _maps.size();
+
+	auto split = [&](uint splitId)
+	{
+		auto ratio = (float)splitId / (float)numCascades;
+
+		return _splitLambda * zNear * powf(zFar / zNear, ratio) + (1.f - _splitLambda) * (zNear + (zFar - zNear) * ratio);
+	};
+
+	for (uint cascadeId = 0; cascadeId < numCascades; ++cascadeId)
+	{
+		auto& map	= _maps[cascadeId];
+		auto n		= split(cascadeId);
+		auto f		= split(cascadeId + 1);
+		// the sphere only depends on the projection of the camera: rotating the camera does not resize it
+		auto depth	= std::min(f, (f + n) * (1.f + k2) * .5f);
+		auto radius	= sqrtf(std::max(
+			(depth - n) * (depth - n) + n * n * k2,
+			(f - depth) * (f - depth) + f * f * k2
+		));
+		// the camera looks along -z, the third row of its view matrix
+		auto cx		= position->x() - view[8] * depth;
+		auto cy		= position->y() - view[9] * depth;
+		auto cz		= position->z() - view[10] * depth;
+		auto sx		= _lightBasis[0] * cx + _lightBasis[1] * cy + _lightBasis[2] * cz;
+		auto sy		= _lightBasis[3] * cx + _lightBasis[4] * cy + _lightBasis[5] * cz;
+		auto sz		= _lightBasis[6] * cx + _lightBasis[7] * cy + _lightBasis[8] * cz;
+		auto halfSize	= radius * (1.f + CASCADE_PADDING);
+
+		// the cascade only moves when the sphere leaves it, and then by whole texels
+		if (halfSize != map.halfSize
+			|| fabsf(sx - map.x) + radius > map.halfSize
+			|| fabsf(sy - map.y) + radius > map.halfSize
+			|| fabsf(sz - map.z) + radius > map.halfSize)
+		{
+			auto texelSize = 2.f * halfSize / (float)_size;
+
+			map.halfSize	= halfSize;
+			map.x			= floorf(sx / texelSize + .5f) * texelSize;
+			map.y			= floorf(sy / texelSize + .5f) * texelSize;
+			map.z			= floorf(sz / texelSize + .5f) * texelSize;
+			map.invalid		= true;
+		}
+	}
+}
+
+void
+ShadowMapping::placeSpotMap()
+{
+	auto& map		= _maps[0];
+	auto position	= _spotLight->worldPosition();
+	// Phong lights along the opposite of the world direction of spot lights
+	auto direction	= _spotLight->worldDirection();
+	auto zFar		= std::min(LightCulling::range(_spotLight->attenuationCoefficients()), _shadowDistance);
+	float state[8]	= {
+		position->x(), position->y(), position->z(),
+		direction->x(), direction->y(), direction->z(),
+		_spotLight->cosOuterConeAngle(), zFar
+	};
+
+	if (std::equal(state, state + 8, _lightState))
+		return;
+
+	std::copy(state, state + 8, _lightState);
+
+	auto fov	= std::max(.01f, std::min(.9f * (float)PI, 2.f * acosf(_spotLight->cosOuterConeAngle())));
+	auto lookAt	= Vector3::create()->copyFrom(position)->subtract(direction);
+
+	map.view->lock()->view(position, lookAt)->unlock();
+	map.projection->perspective(fov, 1.f, zFar * .001f, zFar);
+	map.viewProjection->lock()->copyFrom(map.view)->append(map.projection)->unlock();
+	map.frustum->updateFromMatrix(map.viewProjection);
+	map.invalid = true;
+}
+
+void
+ShadowMapping::invalidateMovedCasters()
+{
+	for (auto& node : _movedCasters)
+	{
+		auto casterIt = _casterIds.find(node);
+
+		if (casterIt == _casterIds.end())
+			continue;
+
+		auto casterId	= casterIt->second;
+		auto box		= node->component<BoundingBox>()->box();
+
+		updateCasterBounds(casterId);
+
+		// a map is invalid if the caster was drawn in it or if it now enters it
+		for (auto& map : _maps)
+		{
+			if (map.invalid)
+				continue;
+
+			uint planeMask	= CULLING_PLANES;
+			uint firstPlane	= 0;
+			auto wasDrawn	= (casterId >> 5) < map.casters.size()
+				&& (map.casters[casterId >> 5] & (1u << (casterId & 31))) != 0;
+			auto result		= map.frustum->testBoundingBox(box, planeMask, firstPlane);
+
+			map.invalid = wasDrawn || result == ShapePosition::INSIDE || result == ShapePosition::AROUND;
+		}
+	}
+
+	_movedCasters.clear();
+}
+
+void
+ShadowMapping::render(ShadowMap& map, bool cascade)
+{
+	auto h = map.halfSize;
+
+	if (cascade)
+	{
+		// the receivers are in [-h, h] along the light direction, the near plane is pulled to the casters
+		map.view->lock()->initialize(
+			_lightBasis[0],	_lightBasis[1],	_lightBasis[2],	-map.x,
+			_lightBasis[3],	_lightBasis[4],	_lightBasis[5],	-map.y,
+			_lightBasis[6],	_lightBasis[7],	_lightBasis[8],	-map.z,
+			0.f,			0.f,			0.f,			1.f
+		)->unlock();
+		map.projection->orthographic(-h, h, h, -h, -h, h);
+		map.viewProjection->lock()->copyFrom(map.view)->append(map.projection)->unlock();
+		map.frustum->updateFromMatrix(map.viewProjection);
+	}
+
+	map.frustum->testBoundingBoxes(
+		_casterBounds[0].data(), _casterBounds[1].data(), _casterBounds[2].data(),
+		_casterBounds[3].data(), _casterBounds[4].data(), _casterBounds[5].data(),
+		_casters.size(),
+		map.casters,
+		CULLING_PLANES
+	);
+
+	auto maxLightDepth = -FLT_MAX;
+
+	map.numCasters = 0;
+
+	for (uint casterId = 0; casterId < _casters.size(); ++casterId)
+	{
+		auto visible = (map.casters[casterId >> 5] & (1u << (casterId & 31))) != 0;
+
+		if (visible)
+		{
+			++map.numCasters;
+
+			if (cascade)
+			{
+				// the corner of the box the closest to the light
+				auto cx = (_casterBounds[0][casterId] + _casterBounds[3][casterId]) * .5f;
+				auto cy = (_casterBounds[1][casterId] + _casterBounds[4][casterId]) * .5f;
+				auto cz = (_casterBounds[2][casterId] + _casterBounds[5][casterId]) * .5f;
+				auto ex = (_casterBounds[3][casterId] - _casterBounds[0][casterId]) * .5f;
+				auto ey = (_casterBounds[4][casterId] - _casterBounds[1][casterId]) * .5f;
+				auto ez = (_casterBounds[5][casterId] - _casterBounds[2][casterId]) * .5f;
+
+				maxLightDepth = std::max(
+					maxLightDepth,
+					_lightBasis[6] * cx + _lightBasis[7] * cy + _lightBasis[8] * cz
+					+ fabsf(_lightBasis[6]) * ex + fabsf(_lightBasis[7]) * ey + fabsf(_lightBasis[8]) * ez
+				);
+			}
+		}
+
+		for (auto& surface : _casters[casterId]->components<Surface>())
+			surface->computedVisibility(map.renderer, visible);
+	}
+
+	if (cascade && map.numCasters != 0)
+	{
+		map.projection->orthographic(-h, h, h, -h, std::min(-h, map.z - maxLightDepth), h);
+		map.viewProjection->lock()->copyFrom(map.view)->append(map.projection)->unlock();
+	}
+
+	// a map without casters is never drawn by its renderer, it is cleared right away
+	if (map.numCasters == 0)
+	{
+		_context->setRenderToTexture(map.texture->id(), true);
+		_context->clear();
+		_context->setRenderToBackBuffer();
+	}
+
+	map.renderer->enabled(map.numCasters != 0);
+	map.invalid = false;
+	++_numRenderedMaps;
+}
+
+void
+ShadowMapping::update()
+{
+	_numRenderedMaps = 0;
+
+	if (!_root || _maps.empty())
+		return;
+
+	if (_invalidCasters)
+		bindCasters();
+
+	if (_directionalLight)
+	{
+		// a new light space moves all the cascades
+		if (updateLightBasis())
+			for (auto& map : _maps)
+				map.halfSize = 0.f;
+
+		placeCascades();
+	}
+	else
+		placeSpotMap();
+
+	invalidateMovedCasters();
+
+	for (auto& map : _maps)
+		// cascades are not placed until there is a camera
+		if (map.invalid && (_spotLight || map.halfSize > 0.f))
+			render(map, _directionalLight != nullptr);
+		else
+			map.renderer->enabled(false);
+
+	auto lightId = (int)(_directionalLight ? _directionalLight->arrayIndex() : _spotLight->arrayIndex());
+
+	if (_data->get<int>("lightId") != lightId)
+		_data->set("lightId", lightId);
+}
+
+float
+ShadowMapping::bias() const
+{
+	return _bias;
+}
+
+ShadowMapping::Ptr
+ShadowMapping::bias(float bias)
+{
+	_bias = bias;
+
+	if (_data)
+		_data->set("bias", bias);
+
+	return shared_from_this();
+}
+
+render::Texture::Ptr
+ShadowMapping::map(uint mapId) const
+{
+	if (mapId >= _maps.size())
+		throw std::invalid_argument("mapId");
+
+	return _maps[mapId].texture;
+}
+
+Matrix4x4::Ptr
+ShadowMapping::viewProjection(uint mapId) const
+{
+	if (mapId >= _maps.size())
+		throw std::invalid_argument("mapId");
+
+	return _maps[mapId].viewProjection;
+}
+
+uint
+ShadowMapping::numCasters(uint mapId) const
+{
+	if (mapId >= _maps.size())
+		throw std::invalid_argument("mapId");
+
+	return _maps[mapId].numCasters;
+}
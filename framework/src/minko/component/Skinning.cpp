@@ -26,10 +26,14 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include <minko/geometry/Bone.hpp>
 #include <minko/geometry/Skin.hpp>
 #include <minko/render/AbstractContext.hpp>
+#include <minko/render/Texture.hpp>
 #include <minko/math/Matrix4x4.hpp>
 #include <minko/component/Surface.hpp>
 #include <minko/component/SceneManager.hpp>
 #include <minko/component/Animation.hpp>
+#include <minko/async/Parallel.hpp>
+
+#include "../math/SIMD.hpp"
 
 using namespace minko;
 using namespace minko::data;
@@ -42,6 +46,7 @@ using namespace minko::render;
 /*static*/ const unsigned int	Skinning::MAX_NUM_BONES_PER_VERTEX	= 8;
 /*static*/ const std::string	Skinning::PNAME_NUM_BONES			= "numBones";
 /*static*/ const std::string	Skinning::PNAME_BONE_MATRICES		= "boneMatrices";
+/*static*/ const std::string	Skinning::PNAME_BONE_MATRICES_TEXTURE	= "boneMatricesTexture";
 /*static*/ const std::string	Skinning::ATTRNAME_POSITION			= "position";
 /*static*/ const std::string	Skinning::ATTRNAME_NORMAL			= "normal";
 /*static*/ const std::string	Skinning::ATTRNAME_BONE_IDS_A		= "boneIdsA";
@@ -59,10 +64,17 @@ Skinning::Skinning(const Skin::Ptr						skin,
 	_context(context),
 	_method(method),
 	_boneVertexBuffer(nullptr),
+	_boneTexture(nullptr),
 	_targetGeometry(),
 	_targetInputPositions(),
-	_targetInputNormals()
+	_targetInputNormals(),
+	_numVertexBones(0),
+	_vertexBoneIds(),
+	_vertexBoneWeights(),
+	_boneMatrices()
 {
+	// skinning only deforms its targets, it never moves them back into view
+	updateWhenCulled(false);
 }
 
 void
@@ -85,10 +97,32 @@ Skinning::initialize()
 		_method	= SkinningMethod::SOFTWARE;
 	}
 
+	if (_method == SkinningMethod::HARDWARE_TEXTURE)
+	{
+		// the bone matrices are read with the nearest filter, the texture must keep its actual size
+		if (_context->supportsFloatTextures()
+			&& _skin->numBones() > 0
+			&& _skin->numBones() <= AbstractTexture::MAX_SIZE
+			&& _context->supportsNonPowerOfTwoTextures(false))
+		{
+			_boneTexture = Texture::create(_context, 4, _skin->numBones(), false, false, false);
+			_boneTexture->upload();
+		}
+		else
+		{
+			std::cerr << "Float textures are not supported, the bone matrices are stored in uniforms" << std::endl;
+
+			_method = SkinningMethod::HARDWARE;
+		}
+	}
+
 	_boneVertexBuffer	= _method == SkinningMethod::SOFTWARE 
 		? nullptr 
 		: createVertexBufferForBones();
 
+	if (_method == SkinningMethod::SOFTWARE)
+		initializeVertexBoneData();
+
 	_maxTime = _skin->duration();
 
 	setPlaybackWindow(0, _maxTime)->seek(0)->play();
@@ -124,11 +158,23 @@ Skinning::addedHandler(Node::Ptr node, Node::Ptr target, Node::Ptr parent)
 			if (_method != SkinningMethod::SOFTWARE)
 			{
 				geometry->addVertexBuffer(_boneVertexBuffer);
-			
-				UniformArrayPtr<float>	uniformArray(new UniformArray<float>(0, nullptr));
-				geometry->data()->set<UniformArrayPtr<float>>(PNAME_BONE_MATRICES,	uniformArray);
+
+				if (_method == SkinningMethod::HARDWARE_TEXTURE)
+					geometry->data()->set<AbstractTexture::Ptr>(PNAME_BONE_MATRICES_TEXTURE, _boneTexture);
+				else
+				{
+					UniformArrayPtr<float>	uniformArray(new UniformArray<float>(0, nullptr));
+					geometry->data()->set<UniformArrayPtr<float>>(PNAME_BONE_MATRICES,	uniformArray);
+				}
 				geometry->data()->set<int>					 (PNAME_NUM_BONES,		0);
 			}
+			else
+			{
+				// skinned positions and normals are re-uploaded every frame
+				geometry->vertexBuffer(ATTRNAME_POSITION)->usage(BufferUsage::STREAM);
+				if (_targetInputNormals.count(node))
+					geometry->vertexBuffer(ATTRNAME_NORMAL)->usage(BufferUsage::STREAM);
+			}
 		}
 	}
 }
@@ -145,7 +191,9 @@ Skinning::removedHandler(Node::Ptr node, Node::Ptr target, Node::Ptr parent)
 		if (_method != SkinningMethod::SOFTWARE)
 		{
 			geometry->removeVertexBuffer(_boneVertexBuffer);
-			geometry->data()->unset(PNAME_BONE_MATRICES);
+			geometry->data()->unset(_method == SkinningMethod::HARDWARE_TEXTURE
+				? PNAME_BONE_MATRICES_TEXTURE
+				: PNAME_BONE_MATRICES);
 			geometry->data()->unset(PNAME_NUM_BONES);
 		}
 
@@ -193,7 +241,7 @@ Skinning::createVertexBufferForBones() const
 	assert(index == vertexData.size());
 #endif // DEBUG_SKINNING
 
-	auto vertexBuffer	= VertexBuffer::create(_context, vertexData);
+	auto vertexBuffer	= VertexBuffer::create(_context, std::move(vertexData));
 
 	vertexBuffer->addAttribute(ATTRNAME_BONE_IDS_A,		4, 0);
 	vertexBuffer->addAttribute(ATTRNAME_BONE_IDS_B,		4, 4);
@@ -208,30 +256,39 @@ Skinning::update()
 {
 	MasterAnimation::update();
 
-	const uint frameId = _skin->getFrameId(_currentTime);
+	if (_skin->compressed())
+		_skin->interpolateMatrices(_currentTime, _boneMatrices);
+
+	const auto& boneMatrices = _skin->compressed()
+		? _boneMatrices
+		: _skin->matrices(_skin->getFrameId(_currentTime));
+
+	// the matrices are stored column by column: each bone is one row of the texture, uploaded once for all the targets
+	if (_method == SkinningMethod::HARDWARE_TEXTURE && !_targetGeometry.empty())
+		_context->uploadFloatTexture2dData(_boneTexture->id(), 4, _skin->numBones(), &boneMatrices[0]);
 
 	for (auto& target : targets())
-		updateFrame(frameId, target);
+		updateFrame(boneMatrices, target);
 }
 
 void
-Skinning::updateFrame(unsigned int	frameId,
-					  Node::Ptr		target)
+Skinning::updateFrame(const std::vector<float>&	boneMatrices,
+					  Node::Ptr					target)
 {
 	if (_targetGeometry.count(target) == 0)
 		return;
 
-	assert(frameId < _skin->numFrames());
+	auto& geometry = _targetGeometry[target];
 
-	auto&						geometry		= _targetGeometry[target];
-	const std::vector<float>&	boneMatrices	= _skin->matrices(frameId);
-
-	if (_method == SkinningMethod::HARDWARE)
+	if (_method != SkinningMethod::SOFTWARE)
 	{
 		if (!geometry->data()->hasProperty(PNAME_NUM_BONES) ||
 			geometry->data()->get<int>(PNAME_NUM_BONES) != _skin->numBones())
 			geometry->data()->set<int>(PNAME_NUM_BONES, _skin->numBones());
-	
+
+		if (_method == SkinningMethod::HARDWARE_TEXTURE)
+			return;
+
 		const auto& uniformArray	= geometry->data()->get<UniformArrayPtr<float>>	(PNAME_BONE_MATRICES);
 		uniformArray->first			= _skin->numBones();
 		uniformArray->second		= &(boneMatrices[0]); 
@@ -241,99 +298,216 @@ Skinning::updateFrame(unsigned int	frameId,
 }
 
 void
-Skinning::performSoftwareSkinning(Node::Ptr					target, 
-								 const std::vector<float>&	boneMatrices)
+Skinning::initializeVertexBoneData()
 {
-#ifdef DEBUG_SKINNING
-	assert(target && _targetGeometry.count(target) > 0 && _targetInputPositions.count(target) > 0);
-#endif //DEBUG_SKINNING
-	
-	auto geometry	= _targetGeometry[target];
+	const unsigned int numVertices = _skin->numVertices();
 
-	// transform positions
-	auto						xyzBuffer	= geometry->vertexBuffer(ATTRNAME_POSITION);
-	VertexBuffer::AttributePtr	xyzAttr		= nullptr;
-	for (auto& attr : xyzBuffer->attributes())
-		if (std::get<0>(*attr) == ATTRNAME_POSITION)
-			xyzAttr = attr;
+	_numVertexBones = std::max(1u, _skin->maxNumVertexBones());
+	_vertexBoneIds.assign(numVertices * _numVertexBones, 0);
+	_vertexBoneWeights.assign(numVertices * _numVertexBones, 0.0f);
 
-	performSoftwareSkinning(xyzAttr, xyzBuffer, _targetInputPositions[target], boneMatrices, false);
+	for (unsigned int vId = 0; vId < numVertices; ++vId)
+		for (unsigned int j = 0; j < _skin->numVertexBones(vId); ++j)
+			_skin->vertexBoneData(
+				vId, j, _vertexBoneIds[vId * _numVertexBones + j], _vertexBoneWeights[vId * _numVertexBones + j]
+			);
+}
 
-	// transform normals
-	if (geometry->hasVertexAttribute(ATTRNAME_NORMAL) && _targetInputNormals.count(target) > 0)
+namespace
+{
+	struct SkinnedAttribute
 	{
-		auto						normalBuffer	= geometry->vertexBuffer(ATTRNAME_NORMAL);
-		VertexBuffer::AttributePtr	normalAttr		= nullptr;
-		for (auto& attr : normalBuffer->attributes())
-			if (std::get<0>(*attr) == ATTRNAME_NORMAL)
-				normalAttr = attr;
+		const float*	input;
+		float*			output;
+		unsigned int	stride;
+	};
+
+	// blends the bone matrices of each vertex, then transforms its position and normal with the result
+	void
+	skinVertices(unsigned int				begin,
+				 unsigned int				end,
+				 unsigned int				numVertexBones,
+				 const unsigned int*		vertexBoneIds,
+				 const float*				vertexBoneWeights,
+				 const float*				boneMatrices,
+				 const SkinnedAttribute&	position,
+				 const SkinnedAttribute*	normal)
+	{
+#if defined(MINKO_SIMD_SSE)
+		const bool simd = CPUFeatures::enabled(InstructionSet::SSE2);
+#elif defined(MINKO_SIMD_NEON)
+		const bool simd = CPUFeatures::enabled(InstructionSet::NEON);
+#endif
 
-		performSoftwareSkinning(normalAttr, normalBuffer, _targetInputNormals[target], boneMatrices, true);
+		for (unsigned int vId = begin; vId < end; ++vId)
+		{
+			const unsigned int*	boneIds		= vertexBoneIds + vId * numVertexBones;
+			const float*		boneWeights	= vertexBoneWeights + vId * numVertexBones;
+			const float*		p			= position.input + vId * position.stride;
+			float*				pOut		= position.output + vId * position.stride;
+			const float*		n			= normal ? normal->input + vId * normal->stride : nullptr;
+			float*				nOut		= normal ? normal->output + vId * normal->stride : nullptr;
+
+#if defined(MINKO_SIMD_SSE)
+			if (simd)
+			{
+				__m128	c0		= _mm_setzero_ps();
+				__m128	c1		= _mm_setzero_ps();
+				__m128	c2		= _mm_setzero_ps();
+				__m128	c3		= _mm_setzero_ps();
+				float	result[4];
+
+				for (unsigned int j = 0; j < numVertexBones; ++j)
+				{
+					const float*	m = boneMatrices + (boneIds[j] << 4);
+					const __m128	w = _mm_set1_ps(boneWeights[j]);
+
+					c0 = _mm_add_ps(c0, _mm_mul_ps(w, _mm_loadu_ps(m)));
+					c1 = _mm_add_ps(c1, _mm_mul_ps(w, _mm_loadu_ps(m + 4)));
+					c2 = _mm_add_ps(c2, _mm_mul_ps(w, _mm_loadu_ps(m + 8)));
+					c3 = _mm_add_ps(c3, _mm_mul_ps(w, _mm_loadu_ps(m + 12)));
+				}
+
+				_mm_storeu_ps(result, _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(p[0])), _mm_mul_ps(c1, _mm_set1_ps(p[1]))),
+					_mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(p[2])), c3)
+				));
+				pOut[0] = result[0];
+				pOut[1] = result[1];
+				pOut[2] = result[2];
+
+				if (n)
+				{
+					_mm_storeu_ps(result, _mm_add_ps(
+						_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(n[0])), _mm_mul_ps(c1, _mm_set1_ps(n[1]))),
+						_mm_mul_ps(c2, _mm_set1_ps(n[2]))
+					));
+					nOut[0] = result[0];
+					nOut[1] = result[1];
+					nOut[2] = result[2];
+				}
+
+				continue;
+			}
+#elif defined(MINKO_SIMD_NEON)
+			if (simd)
+			{
+				float32x4_t	c0		= vdupq_n_f32(0.0f);
+				float32x4_t	c1		= vdupq_n_f32(0.0f);
+				float32x4_t	c2		= vdupq_n_f32(0.0f);
+				float32x4_t	c3		= vdupq_n_f32(0.0f);
+				float		result[4];
+
+				for (unsigned int j = 0; j < numVertexBones; ++j)
+				{
+					const float* m = boneMatrices + (boneIds[j] << 4);
+
+					c0 = vmlaq_n_f32(c0, vld1q_f32(m), boneWeights[j]);
+					c1 = vmlaq_n_f32(c1, vld1q_f32(m + 4), boneWeights[j]);
+					c2 = vmlaq_n_f32(c2, vld1q_f32(m + 8), boneWeights[j]);
+					c3 = vmlaq_n_f32(c3, vld1q_f32(m + 12), boneWeights[j]);
+				}
+
+				vst1q_f32(result, vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(c3, c0, p[0]), c1, p[1]), c2, p[2]));
+				pOut[0] = result[0];
+				pOut[1] = result[1];
+				pOut[2] = result[2];
+
+				if (n)
+				{
+					vst1q_f32(result, vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(c0, n[0]), c1, n[1]), c2, n[2]));
+					nOut[0] = result[0];
+					nOut[1] = result[1];
+					nOut[2] = result[2];
+				}
+
+				continue;
+			}
+#endif
+
+			float m[12] = { 0.0f };
+
+			for (unsigned int j = 0; j < numVertexBones; ++j)
+			{
+				const float*	boneMatrix	= boneMatrices + (boneIds[j] << 4);
+				const float		w			= boneWeights[j];
+
+				for (unsigned int i = 0; i < 4; ++i)
+				{
+					m[i * 3]		+= w * boneMatrix[i << 2];
+					m[i * 3 + 1]	+= w * boneMatrix[(i << 2) + 1];
+					m[i * 3 + 2]	+= w * boneMatrix[(i << 2) + 2];
+				}
+			}
+
+			const float x = p[0], y = p[1], z = p[2];
+
+			pOut[0] = m[0] * x + m[3] * y + m[6] * z + m[9];
+			pOut[1] = m[1] * x + m[4] * y + m[7] * z + m[10];
+			pOut[2] = m[2] * x + m[5] * y + m[8] * z + m[11];
+
+			if (n)
+			{
+				const float nx = n[0], ny = n[1], nz = n[2];
+
+				nOut[0] = m[0] * nx + m[3] * ny + m[6] * nz;
+				nOut[1] = m[1] * nx + m[4] * ny + m[7] * nz;
+				nOut[2] = m[2] * nx + m[5] * ny + m[8] * nz;
+			}
+		}
 	}
 }
 
 void
-Skinning::performSoftwareSkinning(VertexBuffer::AttributePtr		attr,
-								 VertexBuffer::Ptr					vertexBuffer, 
-								 const std::vector<float>&			inputData,
-								 const std::vector<float>&			boneMatrices,
-								 bool								doDeltaTransform)
+Skinning::performSoftwareSkinning(Node::Ptr					target, 
+								 const std::vector<float>&	boneMatrices)
 {
 #ifdef DEBUG_SKINNING
-	assert(vertexBuffer && vertexBuffer->data().size() == inputData.size());
-	assert(attr && std::get<1>(*attr) == 3);
+	assert(target && _targetGeometry.count(target) > 0 && _targetInputPositions.count(target) > 0);
 	assert(boneMatrices.size() == (_skin->numBones() << 4));
-#endif // DEBUG_SKINNING
-
-	const unsigned int	vertexSize		= vertexBuffer->vertexSize();
-	std::vector<float>&	outputData		= vertexBuffer->data();
-	const unsigned int	numVertices		= outputData.size() / vertexSize;
+#endif //DEBUG_SKINNING
 	
-#ifdef DEBUG_SKINNING
-	assert(numVertices == _skin->numVertices());
-#endif // DEBUG_SKINNING
+	auto				geometry		= _targetGeometry[target];
+	auto				xyzBuffer		= geometry->vertexBuffer(ATTRNAME_POSITION);
+	VertexBuffer::Ptr	normalBuffer	= nullptr;
+	SkinnedAttribute	position		= {
+		&_targetInputPositions[target][std::get<2>(*xyzBuffer->attribute(ATTRNAME_POSITION))],
+		&xyzBuffer->data()[std::get<2>(*xyzBuffer->attribute(ATTRNAME_POSITION))],
+		xyzBuffer->vertexSize()
+	};
+	SkinnedAttribute	normal			= { nullptr, nullptr, 0 };
 
-	unsigned int index = std::get<2>(*attr);
-	for (unsigned int vId = 0; vId < numVertices; ++vId)
+	if (geometry->hasVertexAttribute(ATTRNAME_NORMAL) && _targetInputNormals.count(target) > 0)
 	{
-		const float x1 = inputData[index];
-		const float y1 = inputData[index+1];
-		const float z1 = inputData[index+2];
+		normalBuffer = geometry->vertexBuffer(ATTRNAME_NORMAL);
 
-		float x2 = 0.0f;
-		float y2 = 0.0f;
-		float z2 = 0.0f;
+		const auto offset = std::get<2>(*normalBuffer->attribute(ATTRNAME_NORMAL));
 
-		const unsigned int numVertexBones = _skin->numVertexBones(vId);
-		for (unsigned int j = 0; j < numVertexBones; ++j)
-		{
-			unsigned int	boneId		= 0;
-			float			boneWeight	= 0.0f;
-
-			_skin->vertexBoneData(vId, j, boneId, boneWeight);
-
-			const float*	boneMatrix	= &(boneMatrices[boneId << 4]);
-
-			if (!doDeltaTransform)
-			{
-				x2 += boneWeight * (boneMatrix[0] * x1 + boneMatrix[4] * y1 + boneMatrix[8]  * z1 + boneMatrix[12]);
-				y2 += boneWeight * (boneMatrix[1] * x1 + boneMatrix[5] * y1 + boneMatrix[9]  * z1 + boneMatrix[13]);
-				z2 += boneWeight * (boneMatrix[2] * x1 + boneMatrix[6] * y1 + boneMatrix[10] * z1 + boneMatrix[14]);
-			}
-			else
-			{
-				x2 += boneWeight * (boneMatrix[0] * x1 + boneMatrix[4] * y1 + boneMatrix[8]  * z1);
-				y2 += boneWeight * (boneMatrix[1] * x1 + boneMatrix[5] * y1 + boneMatrix[9]  * z1);
-				z2 += boneWeight * (boneMatrix[2] * x1 + boneMatrix[6] * y1 + boneMatrix[10] * z1);
-			}
-		}
+		normal.input	= &_targetInputNormals[target][offset];
+		normal.output	= &normalBuffer->data()[offset];
+		normal.stride	= normalBuffer->vertexSize();
+	}
 
-		outputData[index]	= x2;
-		outputData[index+1]	= y2;
-		outputData[index+2]	= z2;
+	const unsigned int numVertices = std::min(_skin->numVertices(), xyzBuffer->numVertices());
 
-		index += vertexSize;
-	}
+#if defined(MINKO_NO_THREADS)
+	const unsigned int numWorkers = 1;
+#else
+	const unsigned int numWorkers = numVertices < PARALLEL_MIN_NUM_VERTICES
+		? 1
+		: std::max(1u, std::thread::hardware_concurrency());
+#endif
 
-	vertexBuffer->upload();
+	async::runInParallel(numVertices, numWorkers, [&](uint begin, uint end, uint worker)
+	{
+		skinVertices(
+			begin, end, _numVertexBones, &_vertexBoneIds[0], &_vertexBoneWeights[0], &boneMatrices[0],
+			position, normalBuffer ? &normal : nullptr
+		);
+	});
+
+	// the buffers use BufferUsage::STREAM, their storage is orphaned by the context
+	xyzBuffer->upload();
+	if (normalBuffer && normalBuffer != xyzBuffer)
+		normalBuffer->upload();
 }
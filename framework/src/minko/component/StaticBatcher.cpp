@@ -0,0 +1,306 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/component/StaticBatcher.hpp"
+
+#include "minko/scene/Node.hpp"
+#include "minko/scene/NodeSet.hpp"
+#include "minko/component/Surface.hpp"
+#include "minko/component/Transform.hpp"
+#include "minko/geometry/Geometry.hpp"
+#include "minko/render/VertexBuffer.hpp"
+#include "minko/render/IndexBuffer.hpp"
+#include "minko/render/AbstractContext.hpp"
+#include "minko/math/Matrix4x4.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::math;
+
+const uint StaticBatcher::MAX_NUM_VERTICES = 65536;
+
+StaticBatcher::StaticBatcher() :
+	_batches()
+{
+}
+
+void
+StaticBatcher::initialize()
+{
+	_targetAddedSlot = targetAdded()->connect(std::bind(
+		&StaticBatcher::targetAddedHandler,
+		shared_from_this(),
+		std::placeholders::_1,
+		std::placeholders::_2
+	));
+
+	_targetRemovedSlot = targetRemoved()->connect(std::bind(
+		&StaticBatcher::targetRemovedHandler,
+		shared_from_this(),
+		std::placeholders::_1,
+		std::placeholders::_2
+	));
+}
+
+void
+StaticBatcher::targetAddedHandler(AbsCtrlPtr ctrl, NodePtr target)
+{
+	if (targets().size() > 1)
+		throw std::logic_error("StaticBatcher cannot have more than one target.");
+
+	batch();
+}
+
+void
+StaticBatcher::targetRemovedHandler(AbsCtrlPtr ctrl, NodePtr target)
+{
+	_batches.clear();
+}
+
+void
+StaticBatcher::batch()
+{
+	if (targets().empty())
+		return;
+
+	auto target			= targets()[0];
+	auto worldToTarget	= Matrix4x4::create();
+
+	if (target->hasComponent<Transform>())
+		worldToTarget->copyFrom(target->component<Transform>()->modelToWorldMatrix(true))->invert();
+
+	auto staticNodes = scene::NodeSet::create(target)
+		->descendants(false)
+		->where([](NodePtr node)
+		{
+			return node->hasComponent<Surface>()
+				&& node->hasComponent<Transform>()
+				&& node->component<Transform>()->isStatic();
+		});
+
+	std::list<Batch> batches;
+
+	for (auto& node : staticNodes->nodes())
+		for (auto& surface : node->components<Surface>())
+		{
+			if (!canBeBatched(surface))
+				continue;
+
+			auto layout		= getVertexLayout(surface->geometry());
+			auto batchIt	= std::find_if(batches.begin(), batches.end(), [&](const Batch& batch)
+			{
+				return batch.reference->material() == surface->material()
+					&& batch.reference->effect() == surface->effect()
+					&& batch.reference->technique() == surface->technique()
+					&& batch.layout == layout;
+			});
+
+			if (batchIt == batches.end())
+			{
+				Batch batch;
+
+				batch.reference = surface;
+				batch.layout = layout;
+				batches.push_back(batch);
+				batchIt = std::prev(batches.end());
+			}
+
+			batchIt->surfaces.push_back(surface);
+		}
+
+	for (auto& batch : batches)
+	{
+		// merging a single surface would not save any draw call
+		if (batch.surfaces.size() < 2)
+			continue;
+
+		auto					context			= batch.reference->geometry()->indices()->context();
+		const uint				maxNumVertices	= context->supportsUnsignedIntIndices()
+			? std::numeric_limits<uint>::max()
+			: MAX_NUM_VERTICES;
+		std::vector<SurfacePtr>	surfaces;
+		uint					numVertices		= 0;
+
+		for (auto& surface : batch.surfaces)
+		{
+			auto surfaceNumVertices = surface->geometry()->numVertices();
+
+			if (numVertices + surfaceNumVertices > maxNumVertices)
+			{
+				// the pending list is empty when a single surface exceeds the limit on its own
+				if (surfaces.size() > 1)
+					_batches.push_back(mergeSurfaces(batch, surfaces, worldToTarget));
+				surfaces.clear();
+				numVertices = 0;
+			}
+
+			surfaces.push_back(surface);
+			numVertices += surfaceNumVertices;
+		}
+
+		if (surfaces.size() > 1)
+			_batches.push_back(mergeSurfaces(batch, surfaces, worldToTarget));
+	}
+
+	for (auto& batchNode : _batches)
+		if (batchNode->parent() != target)
+			target->addChild(batchNode);
+}
+
+/*static*/
+StaticBatcher::VertexLayout
+StaticBatcher::getVertexLayout(std::shared_ptr<geometry::Geometry> geometry)
+{
+	VertexLayout layout;
+
+	for (auto& vertexBuffer : geometry->vertexBuffers())
+		for (auto& attribute : vertexBuffer->attributes())
+			layout.push_back(std::pair<std::string, uint>(std::get<0>(*attribute), std::get<1>(*attribute)));
+
+	std::sort(layout.begin(), layout.end());
+
+	return layout;
+}
+
+/*static*/
+bool
+StaticBatcher::canBeBatched(SurfacePtr surface)
+{
+	auto geometry = surface->geometry();
+
+	// skinned geometries are deformed at runtime
+	return geometry
+		&& geometry->indices()
+		&& geometry->numVertices() > 0
+		&& geometry->hasVertexAttribute("position")
+		&& !geometry->hasVertexAttribute("boneIdsA");
+}
+
+StaticBatcher::NodePtr
+StaticBatcher::mergeSurfaces(const Batch&					batch,
+							 const std::vector<SurfacePtr>&	surfaces,
+							 MatrixPtr						worldToTarget)
+{
+	auto				context		= batch.reference->geometry()->indices()->context();
+	uint				vertexSize	= 0;
+	std::vector<float>	vertices;
+	std::vector<uint>	indices;
+	auto				modelToTarget	= Matrix4x4::create();
+	auto				targetToModel	= Matrix4x4::create();
+
+	for (auto& attribute : batch.layout)
+		vertexSize += attribute.second;
+
+	for (auto& surface : surfaces)
+	{
+		auto		geometry		= surface->geometry();
+		auto		node			= surface->targets()[0];
+		const uint	vertexOffset	= vertices.size() / vertexSize;
+		const uint	numVertices		= geometry->numVertices();
+
+		modelToTarget
+			->copyFrom(node->component<Transform>()->modelToWorldMatrix(true))
+			->append(worldToTarget);
+		targetToModel->copyFrom(modelToTarget)->invert();
+
+		const auto& m	= modelToTarget->data();
+		const auto& n	= targetToModel->data();
+
+		vertices.resize(vertices.size() + numVertices * vertexSize, 0.f);
+
+		uint attributeOffset = 0;
+
+		for (auto& layoutAttribute : batch.layout)
+		{
+			const auto&	name			= layoutAttribute.first;
+			const uint	size			= layoutAttribute.second;
+			auto		vertexBuffer	= geometry->vertexBuffer(name);
+			auto&		data			= vertexBuffer->data();
+			const uint	srcVertexSize	= vertexBuffer->vertexSize();
+			const uint	srcOffset		= std::get<2>(*vertexBuffer->attribute(name));
+			const bool	isPosition		= name == "position" && size >= 3;
+			const bool	isDirection		= (name == "normal" || name == "tangent") && size >= 3;
+
+			for (uint i = 0; i < numVertices; ++i)
+			{
+				const float*	src = &data[i * srcVertexSize + srcOffset];
+				float*			dst = &vertices[(vertexOffset + i) * vertexSize + attributeOffset];
+
+				std::copy(src, src + size, dst);
+
+				if (isPosition)
+				{
+					dst[0] = src[0] * m[0] + src[1] * m[1] + src[2] * m[2] + m[3];
+					dst[1] = src[0] * m[4] + src[1] * m[5] + src[2] * m[6] + m[7];
+					dst[2] = src[0] * m[8] + src[1] * m[9] + src[2] * m[10] + m[11];
+				}
+				else if (isDirection)
+				{
+					// directions are transformed by the inverse transpose to support non-uniform scales
+					float x = src[0] * n[0] + src[1] * n[4] + src[2] * n[8];
+					float y = src[0] * n[1] + src[1] * n[5] + src[2] * n[9];
+					float z = src[0] * n[2] + src[1] * n[6] + src[2] * n[10];
+					float l = sqrtf(x * x + y * y + z * z);
+
+					if (l != 0.f)
+						l = 1.f / l;
+
+					dst[0] = x * l;
+					dst[1] = y * l;
+					dst[2] = z * l;
+				}
+			}
+
+			attributeOffset += size;
+		}
+
+		for (auto index : geometry->indices()->data())
+			indices.push_back(vertexOffset + index);
+
+		node->removeComponent(surface);
+	}
+
+	auto vertexBuffer	= render::VertexBuffer::create(context, std::move(vertices));
+	auto geometry		= geometry::Geometry::create();
+	uint attributeOffset	= 0;
+
+	for (auto& attribute : batch.layout)
+	{
+		vertexBuffer->addAttribute(attribute.first, attribute.second, attributeOffset);
+		attributeOffset += attribute.second;
+	}
+
+	geometry->addVertexBuffer(vertexBuffer);
+	geometry->indices(render::IndexBuffer::create(context, std::move(indices)));
+
+	auto batchNode = scene::Node::create("staticBatch");
+
+	// vertices are baked in the target space and the batch node is added as a child of the target:
+	// an identity transform makes it inherit the target's modelToWorld
+	batchNode->addComponent(Transform::create());
+	batchNode->addComponent(Surface::create(
+		batch.reference->name(),
+		geometry,
+		batch.reference->material(),
+		batch.reference->effect(),
+		batch.reference->technique()
+	));
+
+	return batchNode;
+}
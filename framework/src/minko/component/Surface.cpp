@@ -50,7 +50,8 @@ Surface::Surface(std::string				name,
 	_geometryId(-1),
 	_materialId(-1),
 	_name(name),
-	_visible(true)
+	_visible(true),
+	_materialChanged(MaterialChangedSignal::create())
 {
 }
 
@@ -81,12 +82,12 @@ Surface::initialize()
 	auto arrayProviderMaterial = std::dynamic_pointer_cast<ArrayProvider>(_material);
 
 	if (arrayProviderMaterial)
-	_dataProviderIndexChangedSlots.push_back(arrayProviderMaterial->indexChanged()->connect(std::bind(
-		&Surface::materialProviderIndexChanged,
-		shared_from_this(),
-		std::placeholders::_1,
-		std::placeholders::_2
-		), 10.f));
+		_materialIndexChangedSlot = arrayProviderMaterial->indexChanged()->connect(std::bind(
+			&Surface::materialProviderIndexChanged,
+			shared_from_this(),
+			std::placeholders::_1,
+			std::placeholders::_2
+		), 10.f);
 
 	if (_effect->techniques().count(_technique) == 0)
 		throw std::logic_error("The technique '" + _technique + "' does not exist.");
@@ -126,6 +127,40 @@ Surface::geometry(std::shared_ptr<geometry::Geometry> newGeometry)
 	_geometry = newGeometry;
 }
 
+void
+Surface::material(std::shared_ptr<data::Provider> newMaterial)
+{
+	if (newMaterial == _material)
+		return;
+
+	auto arrayProviderMaterial = std::dynamic_pointer_cast<data::ArrayProvider>(newMaterial);
+
+	for (auto& target : targets())
+	{
+		target->data()->removeProvider(_material);
+
+		if (arrayProviderMaterial)
+		{
+			target->data()->addProvider(arrayProviderMaterial);
+			_materialId = arrayProviderMaterial->index();
+		}
+		else
+			target->data()->addProvider(newMaterial);
+	}
+
+	_material = newMaterial;
+	_materialIndexChangedSlot = arrayProviderMaterial
+		? arrayProviderMaterial->indexChanged()->connect(std::bind(
+			&Surface::materialProviderIndexChanged,
+			shared_from_this(),
+			std::placeholders::_1,
+			std::placeholders::_2
+		), 10.f)
+		: nullptr;
+
+	_materialChanged->execute(shared_from_this());
+}
+
 void
 Surface::targetAddedHandler(AbstractComponent::Ptr	ctrl,
 							scene::Node::Ptr		target)
@@ -0,0 +1,526 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/component/Terrain.hpp"
+
+#include "minko/scene/Node.hpp"
+#include "minko/component/Transform.hpp"
+#include "minko/component/Surface.hpp"
+#include "minko/component/BoundingBox.hpp"
+#include "minko/data/StructureProvider.hpp"
+#include "minko/geometry/Geometry.hpp"
+#include "minko/material/Material.hpp"
+#include "minko/math/Vector2.hpp"
+#include "minko/math/Vector3.hpp"
+#include "minko/math/Vector4.hpp"
+#include "minko/math/Matrix4x4.hpp"
+#include "minko/render/Texture.hpp"
+#include "minko/render/VertexBuffer.hpp"
+#include "minko/render/IndexBuffer.hpp"
+#include "minko/async/Parallel.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::math;
+
+/*static*/ const uint Terrain::DEFAULT_CHUNK_RESOLUTION	= 32;
+/*static*/ const uint Terrain::MAX_CHUNK_RESOLUTION		= 128;
+
+namespace
+{
+	// the morphing to the next level starts at this fraction of the range of a level
+	const float MORPH_START				= .7f;
+	// the coarsest level never morphs
+	const float NO_MORPH_DISTANCE		= 1e30f;
+
+	uint
+	nextPowerOfTwo(uint value)
+	{
+		uint result = 1;
+
+		while (result < value)
+			result <<= 1;
+
+		return result;
+	}
+}
+
+Terrain::Terrain(ContextPtr context, EffectPtr effect, MaterialPtr material) :
+	_context(context),
+	_heights(),
+	_width(0),
+	_depth(0),
+	_spacing(1.f),
+	_minHeight(0.f),
+	_maxHeight(0.f),
+	_chunkResolution(DEFAULT_CHUNK_RESOLUTION),
+	_lodDistance(50.f),
+	_skirtDepth(1.f),
+	_quadTree(),
+	_numLevels(0),
+	_grid(nullptr),
+	_heightMap(nullptr),
+	_material(material ? material : material::Material::create()),
+	_effect(effect),
+	_chunks(),
+	_freeChunks(),
+	_chunkToData(),
+	_selection(),
+	_selectionChanged(Signal<Ptr>::create())
+{
+}
+
+/*static*/
+Terrain::Ptr
+Terrain::create(ContextPtr	context,
+				TexturePtr	heightMap,
+				float		spacing,
+				float		minHeight,
+				float		maxHeight,
+				EffectPtr	effect,
+				MaterialPtr	material,
+				uint		chunkResolution)
+{
+	if (heightMap == nullptr || heightMap->data().empty())
+		throw std::invalid_argument("heightMap");
+
+	const auto&			rgba		= heightMap->data();
+	const uint			numTexels	= heightMap->width() * heightMap->height();
+	std::vector<float>	heights		(numTexels);
+
+	for (uint i = 0; i < numTexels; ++i)
+		heights[i] = minHeight + (maxHeight - minHeight) * rgba[i << 2] / 255.f;
+
+	return create(context, heights, heightMap->width(), heightMap->height(), spacing, effect, material, chunkResolution);
+}
+
+void
+Terrain::initialize(const std::vector<float>& heights, uint width, uint depth, float spacing, uint chunkResolution)
+{
+	if (!_context)
+		throw std::invalid_argument("context");
+	if (!_effect)
+		throw std::invalid_argument("effect");
+	if (chunkResolution < 2 || chunkResolution > MAX_CHUNK_RESOLUTION || (chunkResolution & (chunkResolution - 1)) != 0)
+		throw std::invalid_argument("chunkResolution");
+	if (width < 2 || (width - 1) % chunkResolution != 0)
+		throw std::invalid_argument("width");
+	if (depth < 2 || (depth - 1) % chunkResolution != 0)
+		throw std::invalid_argument("depth");
+	if (heights.size() != width * depth)
+		throw std::invalid_argument("heights");
+	if (spacing <= 0.f)
+		throw std::invalid_argument("spacing");
+
+	_heights = heights;
+	_width = width;
+	_depth = depth;
+	_spacing = spacing;
+	_chunkResolution = chunkResolution;
+
+	const uint numQuads = std::max(width, depth) - 1;
+
+	_numLevels = 1;
+	while ((chunkResolution << (_numLevels - 1)) < numQuads)
+		++_numLevels;
+
+	buildQuadNode(0, 0, chunkResolution << (_numLevels - 1), _numLevels - 1);
+	computeHeightBounds();
+
+	_minHeight = _quadTree[0].minHeight;
+	_maxHeight = _quadTree[0].maxHeight;
+
+	createGrid();
+	createHeightMap();
+
+	_targetAddedSlot = targetAdded()->connect(std::bind(
+		&Terrain::targetAddedHandler,
+		shared_from_this(),
+		std::placeholders::_1,
+		std::placeholders::_2
+	));
+
+	_targetRemovedSlot = targetRemoved()->connect(std::bind(
+		&Terrain::targetRemovedHandler,
+		shared_from_this(),
+		std::placeholders::_1,
+		std::placeholders::_2
+	));
+}
+
+void
+Terrain::targetAddedHandler(AbsCmpPtr cmp, NodePtr target)
+{
+	if (targets().size() > 1)
+		throw std::logic_error("The same Terrain cannot have 2 different targets");
+}
+
+void
+Terrain::targetRemovedHandler(AbsCmpPtr cmp, NodePtr target)
+{
+	for (auto& nodeAndChunk : _chunks)
+		releaseChunk(nodeAndChunk.second);
+	_chunks.clear();
+	_selection.clear();
+}
+
+int
+Terrain::buildQuadNode(uint x, uint z, uint size, uint level)
+{
+	if (x >= _width - 1 || z >= _depth - 1)
+		return -1;
+
+	const int id = _quadTree.size();
+
+	_quadTree.push_back(QuadNode());
+
+	auto& node = _quadTree.back();
+
+	node.x = x;
+	node.z = z;
+	node.size = size;
+	node.level = level;
+	node.inside = x + size <= _width - 1 && z + size <= _depth - 1;
+	node.minHeight = std::numeric_limits<float>::max();
+	node.maxHeight = -std::numeric_limits<float>::max();
+
+	const uint halfSize = size >> 1;
+
+	for (uint i = 0; i < 4; ++i)
+	{
+		// the vector can grow while building the children
+		const int child = level == 0 ? -1 : buildQuadNode(x + (i & 1) * halfSize, z + (i >> 1) * halfSize, halfSize, level - 1);
+
+		_quadTree[id].children[i] = child;
+	}
+
+	return id;
+}
+
+void
+Terrain::computeHeightBounds()
+{
+	std::vector<uint> leaves;
+
+	for (uint i = 0; i < _quadTree.size(); ++i)
+		if (_quadTree[i].level == 0)
+			leaves.push_back(i);
+
+	// the leaves scan all the heights, the other nodes only merge their children
+#if defined(MINKO_NO_THREADS)
+	const uint numWorkers = 1;
+#else
+	const uint numWorkers = std::max(1u, std::thread::hardware_concurrency());
+#endif
+
+	async::runInParallel(leaves.size(), numWorkers, [&](uint begin, uint end, uint worker)
+	{
+		for (uint i = begin; i < end; ++i)
+		{
+			auto& node = _quadTree[leaves[i]];
+
+			for (uint z = node.z; z <= node.z + node.size; ++z)
+				for (uint x = node.x; x <= node.x + node.size; ++x)
+				{
+					const float height = _heights[z * _width + x];
+
+					node.minHeight = std::min(node.minHeight, height);
+					node.maxHeight = std::max(node.maxHeight, height);
+				}
+		}
+	});
+
+	// the children are always stored after their parent
+	for (int i = _quadTree.size() - 1; i >= 0; --i)
+		for (auto child : _quadTree[i].children)
+			if (_quadTree[i].level != 0 && child >= 0)
+			{
+				_quadTree[i].minHeight = std::min(_quadTree[i].minHeight, _quadTree[child].minHeight);
+				_quadTree[i].maxHeight = std::max(_quadTree[i].maxHeight, _quadTree[child].maxHeight);
+			}
+}
+
+void
+Terrain::createGrid()
+{
+	const uint			n			= _chunkResolution;
+	const uint			numGrid		= (n + 1) * (n + 1);
+	std::vector<float>	vertices;
+	std::vector<uint>	indices;
+
+	vertices.reserve(3 * (numGrid + 4 * (n + 1)));
+	indices.reserve(6 * (n * n + 8 * n));
+
+	for (uint z = 0; z <= n; ++z)
+		for (uint x = 0; x <= n; ++x)
+		{
+			vertices.push_back(float(x) / n);
+			vertices.push_back(0.f);
+			vertices.push_back(float(z) / n);
+		}
+
+	for (uint z = 0; z < n; ++z)
+		for (uint x = 0; x < n; ++x)
+		{
+			const uint i = z * (n + 1) + x;
+
+			indices.push_back(i);
+			indices.push_back(i + n + 1);
+			indices.push_back(i + 1);
+			indices.push_back(i + 1);
+			indices.push_back(i + n + 1);
+			indices.push_back(i + n + 2);
+		}
+
+	// the skirts copy the border vertices with y = -1 and are drawn on both sides
+	const uint borderStarts[4]	= { 0, n, n * (n + 1), 0 };
+	const uint borderSteps[4]	= { 1, n + 1, 1, n + 1 };
+
+	for (uint border = 0; border < 4; ++border)
+	{
+		const uint firstSkirtVertex = vertices.size() / 3;
+
+		for (uint i = 0; i <= n; ++i)
+		{
+			const uint vertex = borderStarts[border] + i * borderSteps[border];
+
+			vertices.push_back(vertices[3 * vertex]);
+			vertices.push_back(-1.f);
+			vertices.push_back(vertices[3 * vertex + 2]);
+		}
+
+		for (uint i = 0; i < n; ++i)
+		{
+			const uint top0		= borderStarts[border] + i * borderSteps[border];
+			const uint top1		= top0 + borderSteps[border];
+			const uint bottom0	= firstSkirtVertex + i;
+			const uint bottom1	= bottom0 + 1;
+			const uint quad[12]	= {
+				top0, bottom0, top1, top1, bottom0, bottom1,
+				top0, top1, bottom0, top1, bottom1, bottom0
+			};
+
+			indices.insert(indices.end(), quad, quad + 12);
+		}
+	}
+
+	auto vertexBuffer = render::VertexBuffer::create(_context, std::move(vertices));
+
+	vertexBuffer->addAttribute("position", 3, 0);
+
+	_grid = geometry::Geometry::create();
+	_grid->addVertexBuffer(vertexBuffer);
+	_grid->indices(render::IndexBuffer::create(_context, std::move(indices)));
+}
+
+void
+Terrain::createHeightMap()
+{
+	const uint					textureWidth	= nextPowerOfTwo(_width);
+	const uint					textureHeight	= nextPowerOfTwo(_depth);
+	const float					range			= std::max(_maxHeight - _minHeight, 1e-6f);
+	std::vector<unsigned char>	rgba			(4 * textureWidth * textureHeight, 0);
+
+	// 16 bits per height, one texel per height so that they are read without any filtering
+	for (uint z = 0; z < _depth; ++z)
+		for (uint x = 0; x < _width; ++x)
+		{
+			const uint	value	= uint((_heights[z * _width + x] - _minHeight) / range * 65535.f + .5f);
+			auto		texel	= &rgba[4 * (z * textureWidth + x)];
+
+			texel[0] = value >> 8;
+			texel[1] = value & 0xff;
+			texel[3] = 255;
+		}
+
+	_heightMap = render::Texture::create(_context, textureWidth, textureHeight, false, false, false);
+	_heightMap->data(&rgba[0]);
+	_heightMap->upload();
+
+	_material->set("heightMap", _heightMap);
+	_material->set("heightMapSize", Vector4::create(float(_width), float(_depth), float(textureWidth), float(textureHeight)));
+	_material->set("terrainSize", Vector4::create(_spacing, _minHeight, _maxHeight - _minHeight, _skirtDepth));
+	if (!_material->hasProperty("diffuseColor"))
+		_material->set("diffuseColor", Vector4::create(1.f, 1.f, 1.f, 1.f));
+}
+
+void
+Terrain::skirtDepth(float value)
+{
+	if (value < 0.f)
+		throw std::invalid_argument("value");
+
+	_skirtDepth = value;
+	_material->set("terrainSize", Vector4::create(_spacing, _minHeight, _maxHeight - _minHeight, _skirtDepth));
+}
+
+float
+Terrain::height(float x, float z) const
+{
+	const float fx = std::max(0.f, std::min(x / _spacing, float(_width - 1)));
+	const float fz = std::max(0.f, std::min(z / _spacing, float(_depth - 1)));
+	const uint	x0 = std::min(uint(fx), _width - 2);
+	const uint	z0 = std::min(uint(fz), _depth - 2);
+	const float	u = fx - x0;
+	const float	v = fz - z0;
+	const float* h = &_heights[z0 * _width + x0];
+
+	return (1.f - v) * ((1.f - u) * h[0] + u * h[1]) + v * ((1.f - u) * h[_width] + u * h[_width + 1]);
+}
+
+float
+Terrain::lodRange(uint level) const
+{
+	return _lodDistance * float(1u << level);
+}
+
+float
+Terrain::distance(const QuadNode& node, const float* eye) const
+{
+	const float min[3] = { node.x * _spacing, node.minHeight, node.z * _spacing };
+	const float max[3] = { (node.x + node.size) * _spacing, node.maxHeight, (node.z + node.size) * _spacing };
+	float		squaredDistance = 0.f;
+
+	for (uint i = 0; i < 3; ++i)
+	{
+		const float d = std::max(std::max(min[i] - eye[i], eye[i] - max[i]), 0.f);
+
+		squaredDistance += d * d;
+	}
+
+	return sqrtf(squaredDistance);
+}
+
+void
+Terrain::select(uint nodeId, const float* eye)
+{
+	const auto& node = _quadTree[nodeId];
+
+	// a node partially outside of the heightmap is always split, the leaves never are
+	if (node.level == 0 || (node.inside && distance(node, eye) > lodRange(node.level - 1)))
+	{
+		_selection.push_back(nodeId);
+
+		return;
+	}
+
+	for (auto child : node.children)
+		if (child >= 0)
+			select(child, eye);
+}
+
+void
+Terrain::update(std::shared_ptr<math::Vector3> eyePosition)
+{
+	if (targets().empty())
+		return;
+
+	auto target	= targets()[0];
+	auto eye	= Vector3::create(eyePosition);
+
+	if (target->hasComponent<Transform>())
+		Matrix4x4::create(target->component<Transform>()->modelToWorldMatrix(true))->invert()->transform(eye, eye);
+
+	const float localEye[3] = { eye->x(), eye->y(), eye->z() };
+	auto		previousSelection = _selection;
+
+	_selection.clear();
+	select(0, localEye);
+
+	if (_selection == previousSelection)
+		return;
+
+	// the chunks that are still selected are kept, the others are recycled
+	std::unordered_map<uint, NodePtr> chunks;
+
+	for (auto node : _selection)
+	{
+		auto chunkIt = _chunks.find(node);
+
+		if (chunkIt != _chunks.end())
+		{
+			chunks[node] = chunkIt->second;
+			_chunks.erase(chunkIt);
+		}
+	}
+	for (auto& nodeAndChunk : _chunks)
+		releaseChunk(nodeAndChunk.second);
+
+	for (auto node : _selection)
+		if (chunks.count(node) == 0)
+		{
+			auto chunk = createChunk(node);
+
+			chunk->layouts(target->layouts());
+			target->addChild(chunk);
+			chunks[node] = chunk;
+		}
+
+	_chunks.swap(chunks);
+	_selectionChanged->execute(shared_from_this());
+}
+
+Terrain::NodePtr
+Terrain::createChunk(uint nodeId)
+{
+	const auto&	node		= _quadTree[nodeId];
+	NodePtr		chunk		= nullptr;
+
+	if (_freeChunks.empty())
+	{
+		auto chunkData = data::StructureProvider::create("terrainChunk");
+
+		chunk = scene::Node::create("terrainChunk")
+			->addComponent(Transform::create())
+			->addComponent(Surface::create(_grid, _material, _effect));
+		chunk->data()->addProvider(chunkData);
+		_chunkToData[chunk] = chunkData;
+	}
+	else
+	{
+		chunk = _freeChunks.back();
+		_freeChunks.pop_back();
+		chunk->removeComponent(chunk->component<BoundingBox>());
+	}
+
+	// the grid is flat, the bounds used by the culling come from the heights
+	const float skirtBottom = node.minHeight - _skirtDepth;
+
+	chunk->addComponent(BoundingBox::create(
+		Vector3::create((node.x + node.size) * _spacing, node.maxHeight, (node.z + node.size) * _spacing),
+		Vector3::create(node.x * _spacing, skirtBottom, node.z * _spacing)
+	));
+
+	const float morphEnd	= node.level + 1 < _numLevels ? lodRange(node.level) : NO_MORPH_DISTANCE;
+	auto		chunkData	= _chunkToData[chunk];
+
+	chunkData->set("rect", Vector4::create(float(node.x), float(node.z), float(node.size), float(_chunkResolution)));
+	chunkData->set("morphRange", Vector2::create(morphEnd * MORPH_START, morphEnd));
+
+	return chunk;
+}
+
+void
+Terrain::releaseChunk(NodePtr chunk)
+{
+	if (chunk->parent())
+		chunk->parent()->removeChild(chunk);
+
+	_freeChunks.push_back(chunk);
+}
@@ -25,6 +25,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/data/Container.hpp"
 #include "minko/data/StructureProvider.hpp"
 #include "minko/component/SceneManager.hpp"
+#include "minko/Profiler.hpp"
 
 using namespace minko;
 using namespace minko::component;
@@ -35,7 +36,8 @@ Transform::Transform() :
 	_matrix(Matrix4x4::create()),
 	_modelToWorld(Matrix4x4::create()),
 	_worldToModel(Matrix4x4::create()),
-	_data(data::StructureProvider::create("transform"))
+	_data(data::StructureProvider::create("transform")),
+	_static(false)
 {
 }
 
@@ -105,6 +107,19 @@ Transform::targetRemovedHandler(AbstractComponent::Ptr ctrl,
 	_removedSlot = nullptr;
 }
 
+Transform::RootTransform::RootTransform() :
+	_invalidLists(true),
+#if defined(MINKO_NO_THREADS)
+	_numWorkers(1),
+#else
+	_numWorkers(std::thread::hardware_concurrency()),
+#endif
+	_invalidUpdateJobs(true),
+	_modelToWorldChanged(ModelToWorldChangedSignal::create()),
+	_worldMatricesOffset(0)
+{
+}
+
 void
 Transform::RootTransform::initialize()
 {
@@ -185,8 +200,12 @@ Transform::RootTransform::componentAddedHandler(scene::Node::Ptr		node,
 		_renderingBeginSlot = sceneManager->renderingBegin()->connect(std::bind(
 			&Transform::RootTransform::renderingBeginHandler, shared_from_this(), std::placeholders::_1, std::placeholders::_2, std::placeholders::_3
 		), 1000.f);
-	else if (std::dynamic_pointer_cast<Transform>(ctrl) != nullptr)
-		_invalidLists = true;
+	else if (std::dynamic_pointer_cast<Transform>(ctrl) != nullptr && !_invalidLists)
+	{
+		// the nodes below might now have a different parent transform
+		removeFromTransformsList(target);
+		addToTransformsList(target);
+	}
 }
 
 void
@@ -198,8 +217,12 @@ Transform::RootTransform::componentRemovedHandler(scene::Node::Ptr			node,
 
 	if (sceneManager)
 		_renderingBeginSlot = nullptr;
-	else if (std::dynamic_pointer_cast<Transform>(ctrl) != nullptr)
-		_invalidLists = true;
+	else if (std::dynamic_pointer_cast<Transform>(ctrl) != nullptr && !_invalidLists)
+	{
+		// the nodes below might now have a different parent transform
+		removeFromTransformsList(target);
+		addToTransformsList(target);
+	}
 }
 
 void
@@ -207,16 +230,31 @@ Transform::RootTransform::addedHandler(scene::Node::Ptr node,
 									   scene::Node::Ptr target,
 									   scene::Node::Ptr ancestor)
 {
-	auto descendants = scene::NodeSet::create(target->root())->descendants(false);
-	for (auto descendant : descendants->nodes())
-	{
-		auto rootTransformCtrl = descendant->component<RootTransform>();
+	if (targets().empty())
+		return;
 
-		if (rootTransformCtrl)
-			descendant->removeComponent(rootTransformCtrl);
-	}
+	auto root = target->root();
 
-	_invalidLists = true;
+	// only the added subtree can hold nested RootTransforms
+	scene::NodeSet::visitDescendants(
+		target,
+		[&](const scene::Node::Ptr& descendant)
+		{
+			auto rootTransformCtrl = descendant->component<RootTransform>();
+
+			if (rootTransformCtrl && descendant != root)
+				descendant->removeComponent(rootTransformCtrl);
+		},
+		true
+	);
+
+	if (targets().empty() || targets()[0] != root)
+		return;
+
+	if (target == root)
+		_invalidLists = true;
+	else if (!_invalidLists)
+		addToTransformsList(target);
 }
 
 void
@@ -224,104 +262,350 @@ Transform::RootTransform::removedHandler(scene::Node::Ptr node,
 									     scene::Node::Ptr target,
 										 scene::Node::Ptr ancestor)
 {
-	_invalidLists = true;
+	if (!_invalidLists)
+		removeFromTransformsList(target);
 }
 
 void
-Transform::RootTransform::updateTransformsList()
+Transform::RootTransform::resizeWorldMatrices(unsigned int numNodes)
+{
+	auto numFloats	= std::min(_worldMatrices.size() - _worldMatricesOffset, std::size_t(numNodes << 4));
+	auto oldOffset	= _worldMatricesOffset;
+
+	// over-allocate by 3 floats so the first matrix can start on a 16 bytes boundary
+	_worldMatrices.resize((numNodes << 4) + 3);
+	_worldMatricesOffset = ((16 - (reinterpret_cast<std::size_t>(&_worldMatrices[0]) & 15)) & 15) >> 2;
+
+	if (oldOffset != _worldMatricesOffset && numFloats != 0)
+		std::memmove(
+			&_worldMatrices[_worldMatricesOffset],
+			&_worldMatrices[oldOffset],
+			numFloats * sizeof(float)
+		);
+}
+
+void
+Transform::RootTransform::reserve(unsigned int numNodes)
+{
+	auto capacity = _idToNode.size() + numNodes;
+
+	_idToNode.reserve(capacity);
+	_transforms.reserve(capacity);
+	_modelToWorld.reserve(capacity);
+	_parentId.reserve(capacity);
+	_worldChanged.reserve(capacity);
+	_nodeToId.reserve(capacity);
+	// the matrices do not have to be moved to a new alignment while the slots are allocated
+	_worldMatrices.reserve((capacity << 4) + 3);
+}
+
+unsigned int
+Transform::RootTransform::allocateId(int parentId)
+{
+	// a free slot can be reused as long as it comes after the parent
+	if (!_freeIds.empty() && static_cast<int>(_freeIds.back()) > parentId)
+	{
+		auto nodeId = _freeIds.back();
+
+		_freeIds.pop_back();
+
+		return nodeId;
+	}
+
+	unsigned int nodeId = _idToNode.size();
+
+	_idToNode.push_back(nullptr);
+	_transforms.push_back(nullptr);
+	_modelToWorld.push_back(nullptr);
+	_parentId.push_back(-1);
+	_worldChanged.push_back(0);
+	resizeWorldMatrices(nodeId + 1);
+
+	return nodeId;
+}
+
+void
+Transform::RootTransform::addToTransformsList(scene::Node::Ptr node)
 {
-	unsigned int nodeId = 0;
+	scene::NodeSet::visitDescendants(
+		node,
+		[&](const scene::Node::Ptr& descendant)
+		{
+			auto transformCtrl = descendant->component<Transform>();
+
+			if (transformCtrl == nullptr || _nodeToId.count(descendant) != 0)
+				return;
+
+			auto ancestor = descendant->parent();
+			while (ancestor != nullptr && _nodeToId.count(ancestor) == 0)
+				ancestor = ancestor->parent();
+
+			auto parentId	= ancestor != nullptr ? static_cast<int>(_nodeToId[ancestor]) : -1;
+			auto nodeId		= allocateId(parentId);
+
+			_nodeToId[descendant] = nodeId;
+			_idToNode[nodeId] = descendant;
+			_transforms[nodeId] = transformCtrl->_matrix;
+			_modelToWorld[nodeId] = transformCtrl->_modelToWorld;
+			_parentId[nodeId] = parentId;
+
+			// the new parent might not have changed, force the update
+			transformCtrl->_modelToWorld->_hasChanged = true;
+			_invalidUpdateJobs = true;
+		},
+		true,
+		false
+	);
+}
 
+void
+Transform::RootTransform::removeFromTransformsList(scene::Node::Ptr node)
+{
+	scene::NodeSet::visitDescendants(
+		node,
+		[&](const scene::Node::Ptr& descendant)
+		{
+			auto it = _nodeToId.find(descendant);
+
+			if (it == _nodeToId.end())
+				return;
+
+			auto nodeId = it->second;
+
+			_nodeToId.erase(it);
+			_idToNode[nodeId] = nullptr;
+			_transforms[nodeId] = nullptr;
+			_modelToWorld[nodeId] = nullptr;
+			_parentId[nodeId] = -1;
+			_worldChanged[nodeId] = 0;
+			_freeIds.push_back(nodeId);
+			_invalidUpdateJobs = true;
+		},
+		true
+	);
+}
+
+void
+Transform::RootTransform::compactTransformsList()
+{
+	std::vector<int>	newIds(_idToNode.size(), -1);
+	unsigned int		numNodes = 0;
+
+	// keeping the order preserves the parent-before-children invariant
+	for (unsigned int nodeId = 0; nodeId < _idToNode.size(); ++nodeId)
+	{
+		if (_idToNode[nodeId] == nullptr)
+			continue;
+
+		auto parentId = _parentId[nodeId];
+
+		newIds[nodeId] = numNodes;
+		if (numNodes != nodeId)
+		{
+			_idToNode[numNodes] = _idToNode[nodeId];
+			_transforms[numNodes] = _transforms[nodeId];
+			_modelToWorld[numNodes] = _modelToWorld[nodeId];
+			std::copy(worldMatrix(nodeId), worldMatrix(nodeId) + 16, worldMatrix(numNodes));
+			_nodeToId[_idToNode[numNodes]] = numNodes;
+		}
+		_parentId[numNodes] = parentId != -1 ? newIds[parentId] : -1;
+		++numNodes;
+	}
+
+	_idToNode.resize(numNodes);
+	_transforms.resize(numNodes);
+	_modelToWorld.resize(numNodes);
+	_parentId.resize(numNodes);
+	_worldChanged.resize(numNodes);
+	_freeIds.clear();
+	resizeWorldMatrices(numNodes);
+	_invalidUpdateJobs = true;
+}
+
+void
+Transform::RootTransform::updateTransformsList()
+{
+	_nodeToId.clear();
 	_idToNode.clear();
 	_transforms.clear();
 	_modelToWorld.clear();
-	_numChildren.clear();
-	_firstChildId.clear();
 	_parentId.clear();
+	_freeIds.clear();
+	_worldChanged.clear();
 
-	auto descendants = scene::NodeSet::create(targets())
-		->descendants(true, false)
-		->where([](scene::Node::Ptr node)
-		{
-			return node->hasComponent<Transform>();
-		});
+	_invalidLists = false;
+	_invalidUpdateJobs = true;
+
+	for (auto target : targets())
+		addToTransformsList(target);
+}
+
+void
+Transform::RootTransform::buildUpdateJobs()
+{
+	unsigned int				numNodes = _idToNode.size();
+	std::vector<unsigned int>	depth(numNodes, 0);
+	std::vector<unsigned int>	numNodesPerDepth;
+
+	_serialUpdateJob.clear();
+	_parallelUpdateJobs.clear();
+	_invalidUpdateJobs = false;
 
-	for (auto node : descendants->nodes())
+	for (unsigned int nodeId = 0; nodeId < numNodes; ++nodeId)
 	{
-		auto transformCtrl  = node->component<Transform>();
+		if (_idToNode[nodeId] == nullptr)
+			continue;
 
-		_nodeToId[node] = nodeId;
+		auto parentId = _parentId[nodeId];
 
-		_idToNode.push_back(node);
-		_transforms.push_back(transformCtrl->_matrix);
-		_modelToWorld.push_back(transformCtrl->_modelToWorld);
-		_numChildren.push_back(0);
-		_firstChildId.push_back(0);
+		depth[nodeId] = parentId != -1 ? depth[parentId] + 1 : 0;
+		if (numNodesPerDepth.size() <= depth[nodeId])
+			numNodesPerDepth.resize(depth[nodeId] + 1, 0);
+		numNodesPerDepth[depth[nodeId]]++;
+	}
 
-		auto ancestor = node->parent();
-		while (ancestor != nullptr && _nodeToId.count(ancestor) == 0)
-			ancestor = ancestor->parent();
+	// split on the first depth that has enough independent subtrees to balance the workers
+	unsigned int splitDepth = 0;
 
-		if (ancestor != nullptr)
-		{
-			auto ancestorId = _nodeToId[ancestor];
+	while (splitDepth < numNodesPerDepth.size() && numNodesPerDepth[splitDepth] < (_numWorkers << 2))
+		++splitDepth;
 
-			_parentId.push_back(ancestorId);
-			if (_numChildren[ancestorId] == 0)
-				_firstChildId[ancestorId] = nodeId;
-			_numChildren[ancestorId]++;
-		}
+	if (splitDepth == numNodesPerDepth.size())
+		return;
+
+	std::vector<int>						subtreeId(numNodes, -1);
+	std::vector<std::vector<unsigned int>>	subtrees;
+
+	for (unsigned int nodeId = 0; nodeId < numNodes; ++nodeId)
+	{
+		if (_idToNode[nodeId] == nullptr)
+			continue;
+
+		if (depth[nodeId] < splitDepth)
+			_serialUpdateJob.push_back(nodeId);
 		else
-			_parentId.push_back(-1);
+		{
+			if (depth[nodeId] == splitDepth)
+			{
+				subtreeId[nodeId] = subtrees.size();
+				subtrees.push_back(std::vector<unsigned int>());
+			}
+			else
+				subtreeId[nodeId] = subtreeId[_parentId[nodeId]];
+
+			subtrees[subtreeId[nodeId]].push_back(nodeId);
+		}
+	}
 
-		++nodeId;
+	// biggest subtrees first, each one goes to the least loaded worker
+	std::sort(subtrees.begin(), subtrees.end(), [](const std::vector<unsigned int>& a, const std::vector<unsigned int>& b)
+	{
+		return a.size() > b.size();
+	});
+
+	_parallelUpdateJobs.resize(_numWorkers);
+	for (auto& subtree : subtrees)
+	{
+		auto job = std::min_element(
+			_parallelUpdateJobs.begin(),
+			_parallelUpdateJobs.end(),
+			[](const std::vector<unsigned int>& a, const std::vector<unsigned int>& b)
+			{
+				return a.size() < b.size();
+			}
+		);
+
+		job->insert(job->end(), subtree.begin(), subtree.end());
 	}
+}
 
-	_invalidLists = false;
+void
+Transform::RootTransform::updateWorldMatrix(unsigned int nodeId)
+{
+	const auto& transform = _transforms[nodeId];
+
+	if (transform == nullptr)
+	{
+		_worldChanged[nodeId] = 0;
+
+		return;
+	}
+
+	auto parentId	= _parentId[nodeId];
+	auto changed	= transform->_hasChanged || _modelToWorld[nodeId]->_hasChanged
+		|| (parentId != -1 && _worldChanged[parentId]);
+
+	_worldChanged[nodeId] = changed;
+
+	if (!changed)
+		return;
+
+	if (parentId != -1)
+		math::Matrix4x4::multiply(&transform->_m[0], worldMatrix(parentId), worldMatrix(nodeId));
+	else
+		std::copy(transform->_m.begin(), transform->_m.end(), worldMatrix(nodeId));
 }
 
 void
 Transform::RootTransform::updateTransforms()
 {
-	unsigned int numNodes 	= _transforms.size();
-	unsigned int nodeId 	= 0;
+	MINKO_PROFILE_SCOPE("RootTransform::updateTransforms");
+
+	unsigned int numNodes = _transforms.size();
 
-	while (nodeId < numNodes)
+	if (numNodes >= PARALLEL_UPDATE_MIN_NUM_NODES && _numWorkers > 1 && _invalidUpdateJobs)
+		buildUpdateJobs();
+
+	if (numNodes >= PARALLEL_UPDATE_MIN_NUM_NODES && !_parallelUpdateJobs.empty())
 	{
-		auto parentModelToWorldMatrix 	= _modelToWorld[nodeId];
-		auto numChildren 				= _numChildren[nodeId];
-		auto firstChildId 				= _firstChildId[nodeId];
-		auto lastChildId 				= firstChildId + numChildren;
-		auto parentId 					= _parentId[nodeId];
-        auto parentTransformChanged     = parentModelToWorldMatrix->_hasChanged;
+		for (auto nodeId : _serialUpdateJob)
+			updateWorldMatrix(nodeId);
 
-        parentModelToWorldMatrix->_hasChanged = false;
+#if !defined(MINKO_NO_THREADS)
+		std::vector<std::future<void>> workers;
 
-		if (parentId == -1)
+		for (unsigned int i = 1; i < _parallelUpdateJobs.size(); ++i)
 		{
-            auto parentTransform = _transforms[nodeId];
-	        
-            if (parentTransformChanged)
-            {
-			    parentModelToWorldMatrix->copyFrom(parentTransform);
-                parentTransform->_hasChanged = false;
-            }
-		}
+			const auto& job = _parallelUpdateJobs[i];
 
-		for (auto childId = firstChildId; childId < lastChildId; ++childId)
-		{
-			auto modelToWorld   = _modelToWorld[childId];
-            auto transform      = _transforms[childId];
-
-            if (transform->_hasChanged || parentTransformChanged)
-            {
-			    modelToWorld->copyFrom(transform)->append(parentModelToWorldMatrix);
-			    transform->_hasChanged = false;
-            }
+			workers.push_back(std::async(std::launch::async, [this, &job]()
+			{
+				for (auto nodeId : job)
+					updateWorldMatrix(nodeId);
+			}));
 		}
+#endif
+
+		for (auto nodeId : _parallelUpdateJobs[0])
+			updateWorldMatrix(nodeId);
 
-		++nodeId;
+#if !defined(MINKO_NO_THREADS)
+		for (auto& worker : workers)
+			worker.get();
+#endif
 	}
+	else
+		for (unsigned int nodeId = 0; nodeId < numNodes; ++nodeId)
+			updateWorldMatrix(nodeId);
+
+	_changedNodes.clear();
+
+	// the changed signals are executed in a deterministic order, outside of the workers
+	for (unsigned int nodeId = 0; nodeId < numNodes; ++nodeId)
+	{
+		if (!_worldChanged[nodeId])
+			continue;
+
+		const auto& modelToWorld = _modelToWorld[nodeId];
+
+		modelToWorld->setRaw(worldMatrix(nodeId));
+		modelToWorld->_hasChanged = false;
+		_transforms[nodeId]->_hasChanged = false;
+		_changedNodes.push_back(_idToNode[nodeId]);
+	}
+
+	if (!_changedNodes.empty())
+		_modelToWorldChanged->execute(shared_from_this(), _changedNodes);
 }
 
 void
@@ -352,11 +636,14 @@ Transform::RootTransform::forceUpdate(scene::Node::Ptr node, bool updateTransfor
 	{
 		auto dirtyNodeId	= path[i];
 		auto parentId		= _parentId[dirtyNodeId];
-		auto modelToWorld	= _modelToWorld[dirtyNodeId];
+		const auto& modelToWorld	= _modelToWorld[dirtyNodeId];
+		auto world					= worldMatrix(dirtyNodeId);
 
-		modelToWorld->copyFrom(_transforms[dirtyNodeId]);
 		if (parentId != -1)
-			modelToWorld->append(_modelToWorld[parentId]);
+			math::Matrix4x4::multiply(&_transforms[dirtyNodeId]->_m[0], worldMatrix(parentId), world);
+		else
+			std::copy(_transforms[dirtyNodeId]->_m.begin(), _transforms[dirtyNodeId]->_m.end(), world);
+		modelToWorld->setRaw(world);
 		modelToWorld->_hasChanged = false;
 	}
 }
@@ -368,6 +655,8 @@ Transform::RootTransform::renderingBeginHandler(std::shared_ptr<SceneManager>
 {
 	if (_invalidLists)
 		updateTransformsList();
+	else if (_freeIds.size() > _nodeToId.size())
+		compactTransformsList();
 
 	updateTransforms();
 }
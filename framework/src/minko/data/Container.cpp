@@ -29,11 +29,17 @@ Container::Container() :
 	std::enable_shared_from_this<Container>(),
 	_providers(),
 	_propertyNameToProvider(),
+	_propertyIdToProvider(),
 	_arrayLengths(data::Provider::create()),
 	_propertyAdded(Container::PropertyChangedSignal::create()),
 	_propertyRemoved(Container::PropertyChangedSignal::create()),
 	_propValueChanged(),
 	_propReferenceChanged(),
+	_deferChanges(false),
+	_pendingValueChanges(),
+	_pendingReferenceChanges(),
+	_pendingValueChanged(),
+	_pendingReferenceChanged(),
 	_propertyAddedOrRemovedSlots(),
 	_providerValueChangedSlot(),
 	_providerReferenceChangedSlot()
@@ -123,15 +129,14 @@ Container::addProvider(std::shared_ptr<ArrayProvider> provider)
 	else
 	{
 		_providersToNumUse[provider] = 1;
-		const auto	lengthPropertyName = provider->arrayName() + ".length";
-		int			length = _arrayLengths->hasProperty(lengthPropertyName)
-			? _arrayLengths->get<int>(lengthPropertyName)
-			: 0;
+		const auto	lengthPropertyName	= provider->arrayName() + ".length";
+		auto&		array				= _arrayProviders[provider->arrayName()];
 
-		provider->index(length);
+		provider->index(array.size());
+		array.push_back(provider);
 		addProvider(std::dynamic_pointer_cast<Provider>(provider));
 
-		_arrayLengths->set<int>(lengthPropertyName, ++length);
+		_arrayLengths->set<int>(lengthPropertyName, array.size());
 	}
 }
 
@@ -144,39 +149,32 @@ Container::removeProvider(std::shared_ptr<ArrayProvider> provider)
 	{
 		auto	index				= provider->index();
 		auto	lengthPropertyName	= provider->arrayName() + ".length";
-		int		length				= _arrayLengths->hasProperty(lengthPropertyName)
-			? _arrayLengths->get<int>(lengthPropertyName)
-			: 0;
+		auto&	array				= _arrayProviders[provider->arrayName()];
 
 		removeProvider(std::dynamic_pointer_cast<Provider>(provider));
 
 #ifdef DEBUG
-		if (index >= (uint)length)
+		if (index >= array.size() || array[index] != provider)
 			throw std::logic_error("ArrayProvider index is greater-equal than the array length");
 #endif
 
-		if (index != length - 1)
-		{
-			auto lastIt = std::find_if(
-				_providers.begin(),
-				_providers.end(),
-				[&](Provider::Ptr p)
-				{
-					auto arrayProvider = std::dynamic_pointer_cast<ArrayProvider>(p);
-
-					return arrayProvider && arrayProvider->index() == length - 1
-						&& arrayProvider->arrayName() == provider->arrayName();
-				});
-			auto last = std::dynamic_pointer_cast<ArrayProvider>(*lastIt);
+		// only the last provider moves, the other ones and their bindings keep their index
+		auto last = array.back();
 
+		array.pop_back();
+		if (last != provider)
+		{
+			array[index] = last;
 			last->index(index);
 		}
 
-		--length;
-		if (length == 0)
+		if (array.empty())
+		{
 			_arrayLengths->unset(lengthPropertyName);
+			_arrayProviders.erase(provider->arrayName());
+		}
 		else
-			_arrayLengths->set<int>(lengthPropertyName, length);
+			_arrayLengths->set<int>(lengthPropertyName, array.size());
 	}
 }
 
@@ -199,7 +197,8 @@ Container::propertyValueChanged(const std::string& propertyName)
 
 	if (_propValueChanged.count(propertyName) == 0)
 	{
-		_propValueChanged[propertyName] = Signal<Container::Ptr, const std::string&>::create();
+		_propValueChanged[propertyName] = Signal<Container::Ptr, const std::string&>::create()
+			->name("Container::propertyValueChanged");
 
 		if (_propertyNameToProvider.count(propertyName) != 0)
 		{
@@ -223,7 +222,8 @@ Container::propertyReferenceChanged(const std::string& propertyName)
 {
 	if (_propReferenceChanged.count(propertyName) == 0)
 	{
-		_propReferenceChanged[propertyName] = Signal<Container::Ptr, const std::string&>::create();
+		_propReferenceChanged[propertyName] = Signal<Container::Ptr, const std::string&>::create()
+			->name("Container::propertyReferenceChanged");
 
 		if (_propertyNameToProvider.count(propertyName) != 0)
 		{
@@ -255,7 +255,17 @@ void
 Container::providerValueChangedHandler(Provider::Ptr		provider,
 									   const std::string& 	propertyName)
 {
-	if (_propValueChanged.count(propertyName) != 0)
+	if (_propValueChanged.count(propertyName) == 0)
+		return;
+
+	if (_deferChanges)
+	{
+		if (_pendingValueChanges.empty() && _pendingReferenceChanges.empty())
+			containersWithPendingChanges().push_back(shared_from_this());
+		if (_pendingValueChanged.insert(propertyName).second)
+			_pendingValueChanges.push_back(propertyName);
+	}
+	else
 		propertyValueChanged(propertyName)->execute(shared_from_this(), propertyName);
 }
 
@@ -263,10 +273,81 @@ void
 Container::providerReferenceChangedHandler(Provider::Ptr		provider,
 										   const std::string&	propertyName)
 {
-	if (_propReferenceChanged.count(propertyName))
+	if (_propReferenceChanged.count(propertyName) == 0)
+		return;
+
+	if (_deferChanges)
+	{
+		if (_pendingValueChanges.empty() && _pendingReferenceChanges.empty())
+			containersWithPendingChanges().push_back(shared_from_this());
+		if (_pendingReferenceChanged.insert(propertyName).second)
+			_pendingReferenceChanges.push_back(propertyName);
+	}
+	else
 		propertyReferenceChanged(propertyName)->execute(shared_from_this(), propertyName);
 }
 
+void
+Container::deferChanges(bool value)
+{
+	_deferChanges = value;
+
+	if (!value)
+		flushChanges();
+}
+
+void
+Container::flushChanges()
+{
+	if (_pendingValueChanges.empty() && _pendingReferenceChanges.empty())
+		return;
+
+	auto that				= shared_from_this();
+	auto referenceChanges	= std::move(_pendingReferenceChanges);
+	auto valueChanges		= std::move(_pendingValueChanges);
+
+	// listeners may set properties again, those changes will be pending for the next flush
+	_pendingReferenceChanges.clear();
+	_pendingValueChanges.clear();
+	_pendingReferenceChanged.clear();
+	_pendingValueChanged.clear();
+
+	// references first, like providers do
+	for (auto& propertyName : referenceChanges)
+		if (_propReferenceChanged.count(propertyName) != 0)
+			_propReferenceChanged[propertyName]->execute(that, propertyName);
+
+	for (auto& propertyName : valueChanges)
+		if (_propValueChanged.count(propertyName) != 0)
+			_propValueChanged[propertyName]->execute(that, propertyName);
+}
+
+/*static*/
+void
+Container::flushAllChanges()
+{
+	auto containers = std::move(containersWithPendingChanges());
+
+	containersWithPendingChanges().clear();
+
+	for (auto& weakContainer : containers)
+	{
+		auto container = weakContainer.lock();
+
+		if (container)
+			container->flushChanges();
+	}
+}
+
+/*static*/
+std::list<std::weak_ptr<Container>>&
+Container::containersWithPendingChanges()
+{
+	static std::list<std::weak_ptr<Container>> containers;
+
+	return containers;
+}
+
 void
 Container::providerPropertyAddedHandler(std::shared_ptr<Provider> 	provider,
 										const std::string& 			propertyName)
@@ -275,6 +356,7 @@ Container::providerPropertyAddedHandler(std::shared_ptr<Provider> 	provider,
 		throw std::logic_error("duplicate property name: " + propertyName);
 	
 	_propertyNameToProvider[propertyName] = provider;
+	_propertyIdToProvider[PropertyName::id(propertyName)] = provider;
 
 	if (_propValueChanged.count(propertyName) != 0)
 		_providerValueChangedSlot[provider] = provider->propertyValueChanged()->connect(std::bind(
@@ -296,6 +378,7 @@ Container::providerPropertyRemovedHandler(std::shared_ptr<Provider> provider,
 	if (_propertyNameToProvider.count(propertyName) != 0)
 	{
 		_propertyNameToProvider.erase(propertyName);
+		_propertyIdToProvider.erase(PropertyName::id(propertyName));
 	
 		if (_propValueChanged.count(propertyName) && _propValueChanged[propertyName]->numCallbacks() == 0)
 			_propValueChanged.erase(propertyName);
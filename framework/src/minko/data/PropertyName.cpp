@@ -0,0 +1,71 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/data/PropertyName.hpp"
+
+using namespace minko;
+using namespace minko::data;
+
+/*static*/ const PropertyName::Id PropertyName::INVALID_ID = -1;
+
+PropertyName::Id
+PropertyName::id(const std::string& name)
+{
+	auto& ids	= nameToId();
+	auto  idIt	= ids.find(name);
+
+	if (idIt != ids.end())
+		return idIt->second;
+
+	auto& names = idToName();
+	Id	  id	= names.size();
+
+	names.push_back(name);
+	ids[name] = id;
+
+	return id;
+}
+
+const std::string&
+PropertyName::name(Id id)
+{
+	auto& names = idToName();
+
+	if (id >= names.size())
+		throw std::invalid_argument("id");
+
+	return names[id];
+}
+
+std::unordered_map<std::string, PropertyName::Id>&
+PropertyName::nameToId()
+{
+	// function statics so that ids can be requested during static initialization
+	static std::unordered_map<std::string, Id> ids;
+
+	return ids;
+}
+
+std::vector<std::string>&
+PropertyName::idToName()
+{
+	static std::vector<std::string> names;
+
+	return names;
+}
@@ -28,12 +28,13 @@ Provider::Provider() :
 	enable_shared_from_this(),
 	_names(),
 	_values(),
+	_idToValue(),
 	_valueChangedSlots(),
 	_referenceChangedSlots(),
-	_propertyAdded(Signal<Ptr, const std::string&>::create()),
-	_propValueChanged(Signal<Ptr, const std::string&>::create()),
-	_propReferenceChanged(Signal<Ptr, const std::string&>::create()),
-	_propertyRemoved(Signal<Ptr, const std::string&>::create())
+	_propertyAdded(Signal<Ptr, const std::string&>::create()->name("Provider::propertyAdded")),
+	_propValueChanged(Signal<Ptr, const std::string&>::create()->name("Provider::propertyValueChanged")),
+	_propReferenceChanged(Signal<Ptr, const std::string&>::create()->name("Provider::propertyReferenceChanged")),
+	_propertyRemoved(Signal<Ptr, const std::string&>::create()->name("Provider::propertyRemoved"))
 {
 }
 
@@ -46,6 +47,7 @@ Provider::unset(const std::string& propertyName)
 	{
 		_names.erase(std::find(_names.begin(), _names.end(), formattedPropertyName));
 		_values.erase(formattedPropertyName);
+		_idToValue.erase(PropertyName::id(formattedPropertyName));
 		_valueChangedSlots.erase(formattedPropertyName);
 		_referenceChangedSlots.erase(formattedPropertyName);
 
@@ -74,6 +76,8 @@ Provider::swap(const std::string& propertyName1, const std::string& propertyName
 
 		_values[destination] = _values[source];
 		_values.erase(source);
+		_idToValue.erase(PropertyName::id(source));
+		_idToValue[PropertyName::id(destination)] = &_values[destination];
 
 		_valueChangedSlots[destination] = _valueChangedSlots[source];
 		_valueChangedSlots.erase(source);
@@ -104,13 +108,7 @@ Provider::swap(const std::string& propertyName1, const std::string& propertyName
 bool 
 Provider::hasProperty(const std::string& name, bool skipPropertyNameFormatting) const
 {
-	auto it = std::find(
-		_names.begin(),
-		_names.end(),
-		skipPropertyNameFormatting ? name : formatPropertyName(name)
-	);
-
-	return it != _names.end();
+	return _values.count(skipPropertyNameFormatting ? name : formatPropertyName(name)) != 0;
 }
 
 Provider::Ptr
@@ -119,5 +117,9 @@ Provider::copyFrom(Provider::Ptr source)
 	_names = source->_names;
 	_values = source->_values;
 
+	_idToValue.clear();
+	for (auto& value : _values)
+		_idToValue[PropertyName::id(value.first)] = &value.second;
+
 	return shared_from_this();
 }
@@ -25,11 +25,22 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/file/Options.hpp"
 #include "minko/file/AbstractParser.hpp"
 #include "minko/file/EffectParser.hpp"
+#include "minko/file/KTXParser.hpp"
 #include "minko/render/Texture.hpp"
 #include "minko/render/CubeTexture.hpp"
 #include "minko/render/Effect.hpp"
+#include "minko/render/MemoryBudget.hpp"
+#include "minko/render/VertexBuffer.hpp"
+#include "minko/render/IndexBuffer.hpp"
 #include "minko/geometry/Geometry.hpp"
+#include "minko/geometry/Skin.hpp"
+#include "minko/component/Skinning.hpp"
+#include "minko/scene/NodeSet.hpp"
+#include "minko/AbstractCanvas.hpp"
+#include "minko/async/ThreadPool.hpp"
+#include "minko/Profiler.hpp"
 #include <regex>
+#include <chrono>
 
 using namespace minko;
 using namespace minko::render;
@@ -42,6 +53,7 @@ AssetLibrary::create(AbsContextPtr context)
 	auto al = std::shared_ptr<AssetLibrary>(new AssetLibrary(context));
 
 	al->registerParser<file::EffectParser>("effect");
+	al->registerParser<file::KTXParser>("ktx");
 	al->registerProtocol<FileLoader>("file");
 
 	return al;
@@ -50,6 +62,11 @@ AssetLibrary::create(AbsContextPtr context)
 AssetLibrary::AssetLibrary(std::shared_ptr<AbstractContext> context) :
 	_context(context),
 	_defaultOptions(file::Options::create(context)),
+	_parseDecodedScheduled(false),
+	_parseBudget(8.f),
+	_numRunningFetches(0),
+	_numFetches(0),
+	_maxConcurrentLoads(8),
 	_complete(Signal<Ptr>::create())
 {
 }
@@ -64,6 +81,16 @@ AssetLibrary::Ptr
 AssetLibrary::geometry(const std::string& name, std::shared_ptr<Geometry> geometry)
 {
 	_geometries[name] = geometry;
+	if (!_currentBundle.empty())
+		_bundles[_currentBundle].geometries.insert(name);
+
+	if (_memoryBudget)
+	{
+		for (auto& vertexBuffer : geometry->vertexBuffers())
+			_memoryBudget->track(vertexBuffer);
+		if (geometry->indices())
+			_memoryBudget->track(geometry->indices());
+	}
 
 	return shared_from_this();
 }
@@ -96,6 +123,11 @@ AssetLibrary::Ptr
 AssetLibrary::texture(const std::string& name, render::AbstractTexture::Ptr texture)
 {
 	_textures[name] = texture;
+	if (!_currentBundle.empty())
+		_bundles[_currentBundle].textures.insert(name);
+
+	if (_memoryBudget && texture->isReady())
+		_memoryBudget->track(texture);
 
 	return shared_from_this();
 }
@@ -127,6 +159,8 @@ AssetLibrary::Ptr
 AssetLibrary::symbol(const std::string& name, scene::Node::Ptr node)
 {
 	_symbols[name] = node;
+	if (!_currentBundle.empty())
+		_bundles[_currentBundle].symbols.insert(name);
 
 	return shared_from_this();
 }
@@ -162,6 +196,8 @@ AssetLibrary::material(const std::string& name, MaterialPtr material)
 #endif
 
 	_materials[name] = material;
+	if (!_currentBundle.empty())
+		_bundles[_currentBundle].materials.insert(name);
 
 	return shared_from_this();
 }
@@ -180,6 +216,232 @@ AssetLibrary::materialName(MaterialPtr material)
 	throw new std::logic_error("AssetLibrary does not reference this material.");
 }
 
+AssetLibrary::MaterialPtr
+AssetLibrary::internMaterial(MaterialPtr material)
+{
+	auto		mat = std::dynamic_pointer_cast<material::Material>(material);
+	std::string	key;
+
+	if (!mat || !mat->propertiesKey(key))
+		return material;
+
+	auto internedIt = _internedMaterials.find(key);
+
+	if (internedIt != _internedMaterials.end())
+	{
+		std::string internedKey;
+
+		// the interned material may have been modified since then
+		if (std::static_pointer_cast<material::Material>(internedIt->second)->propertiesKey(internedKey)
+			&& internedKey == key)
+			return internedIt->second;
+	}
+
+	_internedMaterials[key] = material;
+
+	return material;
+}
+
+AssetLibrary::Ptr
+AssetLibrary::unloadBundle(const std::string& name)
+{
+	auto bundleIt = _bundles.find(name);
+
+	if (bundleIt == _bundles.end())
+		return shared_from_this();
+
+	auto bundle = bundleIt->second;
+
+	_bundles.erase(bundleIt);
+
+	// the symbols and materials first, the geometries and textures they reference can then be disposed
+	for (const auto& symbolName : bundle.symbols)
+		releaseSymbol(symbolName);
+	for (const auto& materialName : bundle.materials)
+		releaseMaterial(materialName);
+	for (const auto& geometryName : bundle.geometries)
+		releaseGeometry(geometryName);
+	for (const auto& textureName : bundle.textures)
+		releaseTexture(textureName);
+	for (const auto& blobName : bundle.blobs)
+		releaseBlob(blobName);
+
+	return shared_from_this();
+}
+
+uint
+AssetLibrary::internalUseCount(std::shared_ptr<AbstractResource> resource) const
+{
+	return _memoryBudget && _memoryBudget->tracked(resource) ? 1 : 0;
+}
+
+void
+AssetLibrary::disposeResource(std::shared_ptr<AbstractResource> resource, uint numOwners)
+{
+	const auto numInternalReferences = internalUseCount(resource);
+
+	// numOwners references are held by the released asset, and one by the resource argument
+	if (resource.use_count() > numOwners + 1 + numInternalReferences)
+		return;
+
+	if (_memoryBudget)
+		_memoryBudget->untrack(resource);
+	resource->dispose();
+}
+
+void
+AssetLibrary::forgetHashedAsset(const std::string& name)
+{
+	for (auto hashIt = _hashedAssetNames.begin(); hashIt != _hashedAssetNames.end();)
+		if (hashIt->second == name)
+			hashIt = _hashedAssetNames.erase(hashIt);
+		else
+			++hashIt;
+}
+
+AssetLibrary::Ptr
+AssetLibrary::releaseGeometry(const std::string& name)
+{
+	auto geometryIt = _geometries.find(name);
+
+	if (geometryIt == _geometries.end())
+		return shared_from_this();
+
+	auto geometry = geometryIt->second;
+
+	_geometries.erase(geometryIt);
+	forgetHashedAsset(name);
+
+	// the same geometry can be registered under several names
+	for (const auto& nameAndGeometry : _geometries)
+		if (nameAndGeometry.second == geometry)
+			return shared_from_this();
+
+	if (geometry.use_count() == 1)
+	{
+		for (const auto& vertexBuffer : geometry->vertexBuffers())
+			disposeResource(vertexBuffer, 1);
+		if (geometry->indices())
+			disposeResource(geometry->indices(), 1);
+	}
+
+	return shared_from_this();
+}
+
+AssetLibrary::Ptr
+AssetLibrary::releaseTexture(const std::string& name)
+{
+	auto textureIt = _textures.find(name);
+
+	if (textureIt == _textures.end())
+		return shared_from_this();
+
+	auto texture = textureIt->second;
+
+	_textures.erase(textureIt);
+	forgetHashedAsset(name);
+
+	for (const auto& nameAndTexture : _textures)
+		if (nameAndTexture.second == texture)
+			return shared_from_this();
+
+	disposeResource(texture, 1);
+
+	return shared_from_this();
+}
+
+AssetLibrary::Ptr
+AssetLibrary::releaseMaterial(const std::string& name)
+{
+	auto materialIt = _materials.find(name);
+
+	if (materialIt == _materials.end())
+		return shared_from_this();
+
+	auto material = materialIt->second;
+
+	_materials.erase(materialIt);
+	forgetHashedAsset(name);
+
+	for (auto internedIt = _internedMaterials.begin(); internedIt != _internedMaterials.end();)
+		if (internedIt->second == material)
+			internedIt = _internedMaterials.erase(internedIt);
+		else
+			++internedIt;
+
+	return shared_from_this();
+}
+
+AssetLibrary::Ptr
+AssetLibrary::releaseSymbol(const std::string& name)
+{
+	_symbols.erase(name);
+
+	return shared_from_this();
+}
+
+AssetLibrary::Ptr
+AssetLibrary::releaseBlob(const std::string& name)
+{
+	_blobs.erase(name);
+
+	return shared_from_this();
+}
+
+uint
+AssetLibrary::unloadUnused()
+{
+	std::vector<std::string> unused;
+	std::unordered_map<MaterialPtr, uint> numMaterialNames;
+
+	for (const auto& nameAndMaterial : _materials)
+		++numMaterialNames[nameAndMaterial.second];
+	for (const auto& keyAndMaterial : _internedMaterials)
+		++numMaterialNames[keyAndMaterial.second];
+
+	// the map and the copy in numMaterialNames
+	for (const auto& nameAndMaterial : _materials)
+		if (nameAndMaterial.second.use_count() == numMaterialNames[nameAndMaterial.second] + 1)
+			unused.push_back(nameAndMaterial.first);
+	numMaterialNames.clear();
+	for (const auto& materialName : unused)
+		releaseMaterial(materialName);
+
+	auto numUnused = unused.size();
+	std::unordered_map<GeometryPtr, uint> numGeometryNames;
+
+	unused.clear();
+	for (const auto& nameAndGeometry : _geometries)
+		++numGeometryNames[nameAndGeometry.second];
+	for (const auto& nameAndGeometry : _geometries)
+		if (nameAndGeometry.second.use_count() == numGeometryNames[nameAndGeometry.second] + 1)
+			unused.push_back(nameAndGeometry.first);
+	numGeometryNames.clear();
+	for (const auto& geometryName : unused)
+		releaseGeometry(geometryName);
+
+	numUnused += unused.size();
+
+	std::unordered_map<AbsTexturePtr, uint> numTextureNames;
+
+	unused.clear();
+	for (const auto& nameAndTexture : _textures)
+		++numTextureNames[nameAndTexture.second];
+	for (const auto& nameAndTexture : _textures)
+	{
+		const auto& texture = nameAndTexture.second;
+		const auto numInternalReferences = internalUseCount(texture);
+
+		if (texture.use_count() == numTextureNames[texture] + 1 + numInternalReferences)
+			unused.push_back(nameAndTexture.first);
+	}
+	numTextureNames.clear();
+	for (const auto& textureName : unused)
+		releaseTexture(textureName);
+
+	return numUnused + unused.size();
+}
+
 AssetLibrary::EffectPtr
 AssetLibrary::effect(const std::string& name)
 {
@@ -221,6 +483,8 @@ AssetLibrary::Ptr
 AssetLibrary::blob(const std::string& name, const std::vector<unsigned char>& blob)
 {
 	_blobs[name] = blob;
+	if (!_currentBundle.empty())
+		_bundles[_currentBundle].blobs.insert(name);
 
 	return shared_from_this();
 }
@@ -284,6 +548,76 @@ AssetLibrary::layout(const std::string& name, const unsigned int mask)
 	return shared_from_this();
 }
 
+AssetLibrary::MemoryReport
+AssetLibrary::memoryReport() const
+{
+	MemoryReport report = { 0, 0, 0, 0, 0, _context->bufferMemory(), _context->textureMemory() };
+	// geometries share buffers and symbols share skins
+	std::set<const void*> counted;
+
+	for (const auto& nameAndGeometry : _geometries)
+	{
+		for (const auto& vertexBuffer : nameAndGeometry.second->vertexBuffers())
+			if (counted.insert(vertexBuffer.get()).second)
+				report.geometries += vertexBuffer->data().size() * sizeof(float);
+
+		const auto indices = nameAndGeometry.second->indices();
+
+		if (indices && counted.insert(indices.get()).second)
+			report.geometries += indices->data().size() * sizeof(uint);
+	}
+
+	for (const auto& nameAndTexture : _textures)
+	{
+		const auto& texture = nameAndTexture.second;
+
+		if (texture->type() == TextureType::Texture2D)
+			report.textures += std::static_pointer_cast<Texture>(texture)->data().size();
+		else
+			report.textures += std::static_pointer_cast<CubeTexture>(texture)->memorySize();
+	}
+
+	for (const auto& nameAndSymbol : _symbols)
+	{
+		auto descendants = scene::NodeSet::create(nameAndSymbol.second)->descendants(true);
+
+		for (const auto& descendant : descendants->nodes())
+			for (const auto& skinning : descendant->components<component::Skinning>())
+				if (skinning->skin() && counted.insert(skinning->skin().get()).second)
+					report.skins += skinning->skin()->memorySize();
+	}
+
+	for (const auto& nameAndMaterial : _materials)
+		for (const auto& nameAndValue : nameAndMaterial.second->values())
+		{
+			const auto& value = nameAndValue.second;
+
+			report.materials += nameAndValue.first.size() + sizeof(Any);
+			if (Any::cast<std::shared_ptr<math::Matrix4x4>>(&value))
+				report.materials += 16 * sizeof(float);
+			else if (Any::cast<std::shared_ptr<math::Vector4>>(&value))
+				report.materials += 4 * sizeof(float);
+			else if (Any::cast<std::shared_ptr<math::Vector3>>(&value))
+				report.materials += 3 * sizeof(float);
+			else if (Any::cast<std::shared_ptr<math::Vector2>>(&value))
+				report.materials += 2 * sizeof(float);
+		}
+
+	for (const auto& nameAndBlob : _blobs)
+		report.blobs += nameAndBlob.second.size();
+
+	if (Profiler::enabled())
+	{
+		Profiler::counter("geometryMemory", report.geometries);
+		Profiler::counter("textureDataMemory", report.textures);
+		Profiler::counter("skinMemory", report.skins);
+		Profiler::counter("materialMemory", report.materials);
+		Profiler::counter("blobMemory", report.blobs);
+	}
+
+	return report;
+}
+
 AssetLibrary::Ptr
 AssetLibrary::queue(const std::string& filename)
 {
@@ -337,21 +671,145 @@ AssetLibrary::load(bool	executeCompleteSignal)
 			_filesQueue.erase(std::find(_filesQueue.begin(), _filesQueue.end(), filename));
 			_loading.push_back(filename);
 
-			_loaderSlots.push_back(loader->error()->connect(std::bind(
-				&AssetLibrary::loaderErrorHandler, shared_from_this(), std::placeholders::_1
+			_loaderChunkSlots.push_back(loader->chunk()->connect(std::bind(
+				&AssetLibrary::loaderChunkHandler,
+				shared_from_this(),
+				std::placeholders::_1,
+				std::placeholders::_2,
+				std::placeholders::_3
 			)));
-			_loaderSlots.push_back(loader->complete()->connect(std::bind(
-				&AssetLibrary::loaderCompleteHandler, shared_from_this(), std::placeholders::_1
-			)));
-			std::cout << "AssetLibrary::load(): before " << filename << std::endl;
-			loader->load(filename, options);
-			std::cout << "AssetLibrary::load(): after " << filename << std::endl;
+			fetch(
+				filename,
+				options,
+				loader,
+				std::bind(&AssetLibrary::loaderCompleteHandler, shared_from_this(), std::placeholders::_1),
+				std::bind(&AssetLibrary::loaderErrorHandler, shared_from_this(), std::placeholders::_1)
+			);
 		}
 	}
 
 	return shared_from_this();
 }
 
+AssetLibrary::Ptr
+AssetLibrary::fetch(const std::string&				filename,
+					std::shared_ptr<file::Options>	options,
+					FetchHandler					complete,
+					FetchHandler					error)
+{
+	fetch(filename, options, nullptr, complete, error);
+
+	return shared_from_this();
+}
+
+void
+AssetLibrary::fetch(const std::string&				filename,
+					std::shared_ptr<file::Options>	options,
+					AbsLoaderPtr					loader,
+					FetchHandler					complete,
+					FetchHandler					error)
+{
+	if (!options)
+		options = _defaultOptions;
+
+	// the same filename can resolve to different files with different include paths
+	auto key = filename;
+
+	for (auto& path : options->includePaths())
+		key += '\n' + path;
+
+	auto fetchIt = _fetches.find(key);
+
+	if (fetchIt != _fetches.end())
+	{
+		auto fetch = fetchIt->second;
+
+		if (fetch->done)
+		{
+			if (complete)
+				complete(fetch->loader);
+		}
+		else
+		{
+			fetch->completeHandlers.push_back(complete);
+			fetch->errorHandlers.push_back(error);
+		}
+
+		return;
+	}
+
+	auto fetch = std::make_shared<Fetch>();
+
+	fetch->filename	= filename;
+	fetch->options	= options;
+	fetch->loader	= loader ? loader : options->loaderFunction()(filename, shared_from_this());
+	fetch->order	= _numFetches++;
+	fetch->done		= false;
+	fetch->completeHandlers.push_back(complete);
+	fetch->errorHandlers.push_back(error);
+
+	_fetches[key] = fetch;
+
+	fetch->completeSlot = fetch->loader->complete()->connect([=](AbsLoaderPtr)
+	{
+		fetchComplete(fetch, true);
+	});
+	fetch->errorSlot = fetch->loader->error()->connect([=](AbsLoaderPtr)
+	{
+		_fetches.erase(key);
+		fetchComplete(fetch, false);
+	});
+
+	_pendingFetches.push_back(fetch);
+	std::push_heap(_pendingFetches.begin(), _pendingFetches.end(), &AssetLibrary::lowerFetchPriority);
+
+	startPendingFetches();
+}
+
+bool
+AssetLibrary::lowerFetchPriority(const FetchPtr& a, const FetchPtr& b)
+{
+	auto priorityA = a->options->loadPriority();
+	auto priorityB = b->options->loadPriority();
+
+	return priorityA < priorityB || (priorityA == priorityB && a->order > b->order);
+}
+
+void
+AssetLibrary::startPendingFetches()
+{
+	// synchronous loaders complete, and can fetch more files, from within load()
+	while (!_pendingFetches.empty() && (_maxConcurrentLoads == 0 || _numRunningFetches < _maxConcurrentLoads))
+	{
+		std::pop_heap(_pendingFetches.begin(), _pendingFetches.end(), &AssetLibrary::lowerFetchPriority);
+
+		auto fetch = _pendingFetches.back();
+
+		_pendingFetches.pop_back();
+		++_numRunningFetches;
+		fetch->loader->load(fetch->filename, fetch->options);
+	}
+}
+
+void
+AssetLibrary::fetchComplete(FetchPtr fetch, bool succeeded)
+{
+	auto handlers = succeeded ? fetch->completeHandlers : fetch->errorHandlers;
+
+	--_numRunningFetches;
+	fetch->done = succeeded;
+	fetch->completeSlot = nullptr;
+	fetch->errorSlot = nullptr;
+	fetch->completeHandlers.clear();
+	fetch->errorHandlers.clear();
+
+	for (auto& handler : handlers)
+		if (handler)
+			handler(fetch->loader);
+
+	startPendingFetches();
+}
+
 void
 AssetLibrary::loaderErrorHandler(std::shared_ptr<file::AbstractLoader> loader)
 {
@@ -362,19 +820,43 @@ AssetLibrary::loaderErrorHandler(std::shared_ptr<file::AbstractLoader> loader)
 	throw std::invalid_argument(filename);
 }
 
-void
-AssetLibrary::loaderCompleteHandler(std::shared_ptr<file::AbstractLoader> loader)
+std::shared_ptr<file::AbstractParser>
+AssetLibrary::getParser(std::shared_ptr<file::AbstractLoader> loader)
 {
-	std::cerr << "AssetLibrary::loaderCompleteHandler(): " << std::endl;
-
 	auto filename = loader->filename();
+
+	if (_filenameToParser.count(filename))
+		return _filenameToParser[filename];
+
 	auto extension = filename.substr(filename.find_last_of('.') + 1);
 
 	std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
 
-	if (_parsers.count(extension))
+	return _filenameToParser[filename] = _parsers.count(extension) ? _parsers[extension]() : nullptr;
+}
+
+void
+AssetLibrary::loaderChunkHandler(std::shared_ptr<file::AbstractLoader> loader, uint offset, uint size)
+{
+	auto parser = getParser(loader);
+
+	if (parser && parser->parsesIncrementally())
+		parser->parseChunk(loader->filename(), _filenameToOptions[loader->filename()], loader->data(), offset, size);
+}
+
+void
+AssetLibrary::loaderCompleteHandler(std::shared_ptr<file::AbstractLoader> loader)
+{
+	std::cerr << "AssetLibrary::loaderCompleteHandler(): " << std::endl;
+
+	auto filename	= loader->filename();
+	auto parser		= getParser(loader);
+
+	if (parser)
 	{
-		auto parser = _parsers[extension]();
+		auto options	= _filenameToOptions[filename];
+		auto canvas		= AbstractCanvas::defaultCanvas();
+
 		_parserSlots.push_back(parser->complete()->connect([=](AbstractParser::Ptr)
 		{
 			loader->parserComplete()->execute(loader, parser, shared_from_this());
@@ -382,46 +864,130 @@ AssetLibrary::loaderCompleteHandler(std::shared_ptr<file::AbstractLoader> loader
 			finalize(filename);
 		}));
 
-        try
-        {
-            parser->parse(
-                loader->filename(),
-                loader->resolvedFilename(),
-                _filenameToOptions[filename],
-                loader->data(),
-                shared_from_this()
-            );
-        }
-        catch (ParserError parserError)
-        {
-            if (_parserError->numCallbacks() != 0)
-                _parserError->execute(shared_from_this(), parser);
-#ifdef DEBUG
-            else
-                std::cerr << parserError.what() << std::endl;
-#endif
-        }
+		if (options->loadAsynchronously() && parser->decodesAsynchronously() && canvas)
+		{
+			auto that = shared_from_this();
+
+			canvas->threadPool()->run(
+				[=]()
+				{
+					MINKO_PROFILE_SCOPE("AssetLibrary::decode");
+
+					parser->decode(filename, options, loader->data());
+				},
+				[=]()
+				{
+					that->_decodedParsers.push_back(std::make_pair(loader, parser));
+					that->scheduleParseDecoded();
+				}
+			);
+		}
+		else
+			parse(loader, parser);
 	}
 	else
 	{
-		std::cerr << "warning: no parser found for file extension '" << extension << "'" << std::endl;
+		std::cerr << "warning: no parser found for file extension '"
+			<< filename.substr(filename.find_last_of('.') + 1) << "'" << std::endl;
 		blob(filename, loader->data());
 		finalize(filename);
 	}
 }
 
+void
+AssetLibrary::parse(std::shared_ptr<AbstractLoader> loader, std::shared_ptr<AbstractParser> parser)
+{
+	MINKO_PROFILE_SCOPE("AssetLibrary::parse");
+
+	auto filename = loader->filename();
+
+	try
+	{
+		parser->parse(
+			filename,
+			loader->resolvedFilename(),
+			_filenameToOptions[filename],
+			loader->data(),
+			shared_from_this()
+		);
+	}
+	catch (ParserError parserError)
+	{
+		if (_parserError->numCallbacks() != 0)
+			_parserError->execute(shared_from_this(), parser);
+#ifdef DEBUG
+		else
+			std::cerr << parserError.what() << std::endl;
+#endif
+	}
+}
+
+void
+AssetLibrary::scheduleParseDecoded()
+{
+	if (_parseDecodedScheduled)
+		return;
+
+	auto that = shared_from_this();
+
+	// an empty task brings us back with the completions of the next frame
+	_parseDecodedScheduled = true;
+	AbstractCanvas::defaultCanvas()->threadPool()->run(
+		[]() { },
+		[that]()
+		{
+			that->_parseDecodedScheduled = false;
+			that->parseDecoded();
+		}
+	);
+}
+
+void
+AssetLibrary::parseDecoded()
+{
+	auto start = std::chrono::high_resolution_clock::now();
+
+	// at least one file per frame, then as many as the budget allows
+	while (!_decodedParsers.empty())
+	{
+		auto decoded = _decodedParsers.front();
+
+		_decodedParsers.pop_front();
+		parse(decoded.first, decoded.second);
+
+		auto elapsed = 1e-6f * std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::high_resolution_clock::now() - start
+		).count();
+
+		if (elapsed >= _parseBudget)
+			break;
+	}
+
+	if (!_decodedParsers.empty())
+		scheduleParseDecoded();
+}
+
 void
 AssetLibrary::finalize(const std::string& filename)
 {
 	_loading.erase(std::find(_loading.begin(), _loading.end(), filename));
 	_filenameToLoader.erase(filename);
+	_filenameToParser.erase(filename);
 	_filenameToOptions.erase(filename);
 
 	if (_loading.size() == 0 && _filesQueue.size() == 0)
 	{
-		_loaderSlots.clear();
+		_loaderChunkSlots.clear();
+
+		for (auto fetchIt = _fetches.begin(); fetchIt != _fetches.end();)
+			if (fetchIt->second->done)
+				fetchIt = _fetches.erase(fetchIt);
+			else
+				++fetchIt;
+
 		_parserSlots.clear();
 		_filenameToLoader.clear();
+		_filenameToParser.clear();
 		_filenameToOptions.clear();
 
 		_complete->execute(shared_from_this());
@@ -38,6 +38,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/file/FileLoader.hpp"
 #include "minko/file/Options.hpp"
 #include "minko/file/AssetLibrary.hpp"
+#include "minko/Profiler.hpp"
 #include "json/json.h"
 
 using namespace minko;
@@ -45,10 +46,24 @@ using namespace minko::data;
 using namespace minko::file;
 using namespace minko::render;
 
-std::unordered_map<std::string, unsigned int> EffectParser::_blendFactorMap = EffectParser::initializeBlendFactorMap();
+std::unordered_map<std::string, EffectParser::GLSLIncludePtr> EffectParser::_glslIncludeCache;
+std::unordered_map<std::string, std::string> EffectParser::_glslResolvedFilenames;
+std::list<EffectParser::PassShaders> EffectParser::_glslPasses;
+std::recursive_mutex EffectParser::_glslCacheMutex;
+
+std::unordered_map<std::string, unsigned int>&
+EffectParser::blendFactorMap()
+{
+	static auto m = initializeBlendFactorMap();
+
+	return m;
+}
+
 std::unordered_map<std::string, unsigned int>
 EffectParser::initializeBlendFactorMap()
 {
+	MINKO_PROFILE_SCOPE("EffectParser::initializeBlendFactorMap");
+
 	std::unordered_map<std::string, unsigned int> m;
 
 	m["src_zero"]					= static_cast<uint>(render::Blending::Source::ZERO);
@@ -76,10 +91,19 @@ EffectParser::initializeBlendFactorMap()
 	return m;
 }
 
-std::unordered_map<std::string, render::CompareMode> EffectParser::_compareFuncMap = EffectParser::initializeCompareFuncMap();
+std::unordered_map<std::string, render::CompareMode>&
+EffectParser::compareFuncMap()
+{
+	static auto m = initializeCompareFuncMap();
+
+	return m;
+}
+
 std::unordered_map<std::string, render::CompareMode>
 EffectParser::initializeCompareFuncMap()
 {
+	MINKO_PROFILE_SCOPE("EffectParser::initializeCompareFuncMap");
+
 	std::unordered_map<std::string, render::CompareMode> m;
 
 	m["always"]			= render::CompareMode::ALWAYS;
@@ -94,10 +118,19 @@ EffectParser::initializeCompareFuncMap()
 	return m;
 }
 
-std::unordered_map<std::string, render::StencilOperation> EffectParser::_stencilOpMap = EffectParser::initializeStencilOperationMap();
+std::unordered_map<std::string, render::StencilOperation>&
+EffectParser::stencilOpMap()
+{
+	static auto m = initializeStencilOperationMap();
+
+	return m;
+}
+
 std::unordered_map<std::string, render::StencilOperation>
 EffectParser::initializeStencilOperationMap()
 {
+	MINKO_PROFILE_SCOPE("EffectParser::initializeStencilOperationMap");
+
 	std::unordered_map<std::string, render::StencilOperation> m;
 
 	m["keep"]			= render::StencilOperation::KEEP;
@@ -112,10 +145,19 @@ EffectParser::initializeStencilOperationMap()
 	return m;
 }
 
-std::unordered_map<std::string, float> EffectParser::_priorityMap = EffectParser::initializePriorityMap();
+std::unordered_map<std::string, float>&
+EffectParser::priorityMap()
+{
+	static auto m = initializePriorityMap();
+
+	return m;
+}
+
 std::unordered_map<std::string, float>
 EffectParser::initializePriorityMap()
 {
+	MINKO_PROFILE_SCOPE("EffectParser::initializePriorityMap");
+
 	std::unordered_map<std::string, float> m;
 
 	// The higher the priority, the earlier the drawcall is rendered.
@@ -131,11 +173,11 @@ EffectParser::initializePriorityMap()
 float
 EffectParser::priority(const std::string& name)
 {
-	auto foundPriorityIt = _priorityMap.find(name);
+	auto foundPriorityIt = priorityMap().find(name);
 
-	return foundPriorityIt != _priorityMap.end()
+	return foundPriorityIt != priorityMap().end()
 		? foundPriorityIt->second
-		: _priorityMap["opaque"];
+		: priorityMap()["opaque"];
 }
 
 EffectParser::EffectParser() :
@@ -464,24 +506,21 @@ EffectParser::parseShader(const Json::Value& 		shaderNode,
 	auto shader = Shader::create(options->context(), type, glsl);
 	auto blocks = std::shared_ptr<GLSLBlockList>(new GLSLBlockList());
 	
-	blocks->push_front(GLSLBlock(GLSLBlockType::TEXT, ""));
 	_glslBlocks[shader] = blocks;
-	parseGLSL(glsl, options, blocks, blocks->begin());
+	parseGLSL(glsl, blocks);
+	loadGLSLDependencies(blocks, _options);
 
 	return shader;
 }
 
 void
-EffectParser::parseGLSL(std::string 			glsl,
-						file::Options::Ptr 		options,
-						GLSLBlockListPtr		blocks,
-						GLSLBlockList::iterator	insertIt)
+EffectParser::parseGLSL(const std::string& glsl, GLSLBlockListPtr blocks)
 {
 	std::string line;
 	std::stringstream stream(glsl);
+	auto insertIt = blocks->before_begin();
 	auto i = 0;
 	auto lastBlockEnd = 0;
-	auto numIncludes = 0;
 
 	while (std::getline(stream, line))
 	{
@@ -496,82 +535,196 @@ EffectParser::parseGLSL(std::string 			glsl,
 			insertIt = blocks->insert_after(insertIt, GLSLBlock(GLSLBlockType::FILE, filename));
 
 			lastBlockEnd = i + line.size() + 1;
-
-			++numIncludes;
 		}
 		i += line.size() + 1;
 	}
 	
 	if (i != lastBlockEnd)
 		insertIt = blocks->insert_after(insertIt, GLSLBlock(GLSLBlockType::TEXT, glsl.substr(lastBlockEnd)));
+}
+
+std::string
+EffectParser::glslIncludeKey(const std::string& filename, const std::list<std::string>& includePaths)
+{
+	// the same filename can resolve to different files with different include paths
+	auto key = filename;
+
+	for (auto& path : includePaths)
+		key += '\n' + path;
 
-	if (numIncludes)
-		loadGLSLDependencies(blocks, options);
+	return key;
+}
+
+EffectParser::GLSLIncludePtr
+EffectParser::findGLSLInclude(const std::string& resolvedFilename)
+{
+	std::lock_guard<std::recursive_mutex> lock(_glslCacheMutex);
+
+	auto includeIt = _glslIncludes.find(resolvedFilename);
+
+	if (includeIt != _glslIncludes.end())
+		return includeIt->second;
+
+	auto cachedIncludeIt = _glslIncludeCache.find(resolvedFilename);
+
+	return cachedIncludeIt != _glslIncludeCache.end() ? cachedIncludeIt->second : nullptr;
 }
 
 void
 EffectParser::loadGLSLDependencies(GLSLBlockListPtr		blocks,
 								   file::Options::Ptr 	options)
 {
+	std::lock_guard<std::recursive_mutex> lock(_glslCacheMutex);
+
 	for (auto blockIt = blocks->begin(); blockIt != blocks->end(); blockIt++)
 	{
 		auto& block = *blockIt;
 
-		if (block.first == GLSLBlockType::FILE)
+		if (block.first != GLSLBlockType::FILE)
+			continue;
+
+		auto key = glslIncludeKey(block.second, options->includePaths());
+		auto resolvedFilenameIt = _glslResolvedFilenames.find(key);
+
+		// includes shared by several effects are only loaded and parsed once
+		if (resolvedFilenameIt != _glslResolvedFilenames.end() && findGLSLInclude(resolvedFilenameIt->second))
 		{
-			auto loader = _options->loaderFunction()(block.second, _assetLibrary);
+			block.first = GLSLBlockType::INCLUDE;
+			block.second = resolvedFilenameIt->second;
+
+			continue;
+		}
 
-			++_numDependencies;
+		++_numDependencies;
 
-			_loaderCompleteSlots[loader] = loader->complete()->connect(std::bind(
+		_assetLibrary->fetch(
+			block.second,
+			options,
+			std::bind(
 				&EffectParser::glslIncludeCompleteHandler,
 				std::static_pointer_cast<EffectParser>(shared_from_this()),
 				std::placeholders::_1,
 				blocks,
-				blockIt
-			));
-
-			_loaderErrorSlots[loader] = loader->error()->connect(std::bind(
+				blockIt,
+				key
+			),
+			std::bind(
 				&EffectParser::dependencyErrorHandler,
 				std::static_pointer_cast<EffectParser>(shared_from_this()),
 				std::placeholders::_1
-			));
-
-			loader->load(block.second, _options);
-		}
+			)
+		);
 	}
 }
 
 void
 EffectParser::glslIncludeCompleteHandler(LoaderPtr 					loader,
 										 GLSLBlockListPtr 			blocks,
-	 								     GLSLBlockList::iterator 	blockIt)
+	 								     GLSLBlockList::iterator 	blockIt,
+										 const std::string&			includeKey)
 {
+	std::lock_guard<std::recursive_mutex> lock(_glslCacheMutex);
+
+	const auto& resolvedFilename = loader->resolvedFilename();
 	auto& block = *blockIt;
 
-	block.first = GLSLBlockType::TEXT;
-#ifdef DEBUG
-	block.second = "//#pragma include(\"" + loader->resolvedFilename() + "\")\n";
-#else
-	block.second = "\n";
-#endif
+	block.first = GLSLBlockType::INCLUDE;
+	block.second = resolvedFilename;
+	_glslResolvedFilenames[includeKey] = resolvedFilename;
 
 	++_numLoadedDependencies;
 
-	auto options = _options;
-	auto pos = loader->resolvedFilename().find_last_of('/');
-	if (pos != std::string::npos)
+	if (!findGLSLInclude(resolvedFilename))
 	{
-		options = file::Options::create(options);
-		options->includePaths().push_back(loader->resolvedFilename().substr(0, pos));
-	}
+		auto include = std::make_shared<GLSLInclude>();
+		auto options = _options;
+		auto pos = resolvedFilename.find_last_of('/');
 
-	parseGLSL(std::string((const char*)&loader->data()[0], loader->data().size()), options, blocks, blockIt);
+		if (pos != std::string::npos)
+		{
+			options = file::Options::create(options);
+			options->includePaths().push_back(resolvedFilename.substr(0, pos));
+		}
+
+		include->blocks = std::shared_ptr<GLSLBlockList>(new GLSLBlockList());
+		include->includePaths = options->includePaths();
+		_glslIncludes[resolvedFilename] = include;
+
+		parseGLSL(std::string((const char*)&loader->data()[0], loader->data().size()), include->blocks);
+		loadGLSLDependencies(include->blocks, options);
+	}
 
 	if (_numDependencies == _numLoadedDependencies && _effect)
 		finalize();
 }
 
+std::vector<Pass::Ptr>
+EffectParser::reloadGLSL(const std::string& resolvedFilename, const std::vector<unsigned char>& data)
+{
+	std::lock_guard<std::recursive_mutex> lock(_glslCacheMutex);
+
+	auto includeIt = _glslIncludeCache.find(resolvedFilename);
+
+	if (includeIt == _glslIncludeCache.end())
+		throw std::invalid_argument("resolvedFilename");
+
+	auto include = includeIt->second;
+	auto blocks = std::shared_ptr<GLSLBlockList>(new GLSLBlockList());
+
+	parseGLSL(data.empty() ? std::string() : std::string((const char*)&data[0], data.size()), blocks);
+
+	// there is no effect to load new files with, so all the includes must already be cached
+	for (auto& block : *blocks)
+		if (block.first == GLSLBlockType::FILE)
+		{
+			auto resolvedFilenameIt = _glslResolvedFilenames.find(glslIncludeKey(block.second, include->includePaths));
+
+			if (resolvedFilenameIt == _glslResolvedFilenames.end() || !hasCachedGLSL(resolvedFilenameIt->second))
+				throw std::logic_error("The file '" + block.second + "' included by '" + resolvedFilename + "' is not loaded.");
+
+			block.first = GLSLBlockType::INCLUDE;
+			block.second = resolvedFilenameIt->second;
+		}
+
+	include->blocks = blocks;
+
+	std::vector<Pass::Ptr> passes;
+
+	for (auto passIt = _glslPasses.begin(); passIt != _glslPasses.end(); )
+	{
+		auto pass = passIt->pass.lock();
+
+		if (!pass)
+		{
+			passIt = _glslPasses.erase(passIt);
+			continue;
+		}
+
+		if (includesGLSL(passIt->vertexBlocks, resolvedFilename) || includesGLSL(passIt->fragmentBlocks, resolvedFilename))
+		{
+			pass->reload(
+				"#define VERTEX_SHADER\r\n" + concatenateGLSLBlocks(passIt->vertexBlocks),
+				"#define FRAGMENT_SHADER\r\n" + concatenateGLSLBlocks(passIt->fragmentBlocks)
+			);
+			passes.push_back(pass);
+		}
+
+		++passIt;
+	}
+
+	return passes;
+}
+
+void
+EffectParser::clearGLSLCache()
+{
+	std::lock_guard<std::recursive_mutex> lock(_glslCacheMutex);
+
+	_glslIncludeCache.clear();
+	_glslResolvedFilenames.clear();
+	_glslPasses.clear();
+}
+
 void
 EffectParser::dependencyErrorHandler(std::shared_ptr<AbstractLoader> loader)
 {
@@ -592,20 +745,20 @@ EffectParser::parseBlendMode(const Json::Value&				contextNode,
 	if (blendModeArray.isArray())
 	{
 		auto blendSrcFactorString = "src_" + blendModeArray[0].asString();
-		if (_blendFactorMap.count(blendSrcFactorString))
-			srcFactor = static_cast<render::Blending::Source>(_blendFactorMap[blendSrcFactorString]);
+		if (blendFactorMap().count(blendSrcFactorString))
+			srcFactor = static_cast<render::Blending::Source>(blendFactorMap()[blendSrcFactorString]);
 
 		auto blendDstFactorString = "dst_" + blendModeArray[1].asString();
-		if (_blendFactorMap.count(blendDstFactorString))
-			dstFactor = static_cast<render::Blending::Destination>(_blendFactorMap[blendDstFactorString]);
+		if (blendFactorMap().count(blendDstFactorString))
+			dstFactor = static_cast<render::Blending::Destination>(blendFactorMap()[blendDstFactorString]);
 	}
 	else if (blendModeArray.isString())
 	{
 		auto blendModeString = blendModeArray.asString();
 
-		if (_blendFactorMap.count(blendModeString))
+		if (blendFactorMap().count(blendModeString))
 		{
-			auto blendMode = _blendFactorMap[blendModeString];
+			auto blendMode = blendFactorMap()[blendModeString];
 
 			srcFactor = static_cast<render::Blending::Source>(blendMode & 0x00ff);
 			dstFactor = static_cast<render::Blending::Destination>(blendMode & 0xff00);
@@ -649,12 +802,12 @@ EffectParser::parseDepthTest(const Json::Value& contextNode,
             depthMask = depthMaskValue.asBool();
 
         if (depthFuncValue.isString())
-    		depthFunc = _compareFuncMap[depthFuncValue.asString()];
+    		depthFunc = compareFuncMap()[depthFuncValue.asString()];
 	}
     else if (depthTest.isArray())
     {
         depthMask = depthTest[0].asBool();
-		depthFunc = _compareFuncMap[depthTest[1].asString()];
+		depthFunc = compareFuncMap()[depthTest[1].asString()];
     }
     else
     {
@@ -664,7 +817,7 @@ EffectParser::parseDepthTest(const Json::Value& contextNode,
     	if (depthMaskValue.isBool())
     		depthMask = depthMaskValue.asBool();
     	if (depthFuncValue.isString())
-    		depthFunc = _compareFuncMap[depthFuncValue.asString()];
+    		depthFunc = compareFuncMap()[depthFuncValue.asString()];
     }
 }
 
@@ -930,42 +1083,57 @@ EffectParser::loadTexture(const std::string&	textureFilename,
 						  UniformTypeAndValue&	uniformTypeAndValue,
 						  Options::Ptr			options)
 {
-	auto loader = _options->loaderFunction()(textureFilename, _assetLibrary);
+	auto that		= std::static_pointer_cast<EffectParser>(shared_from_this());
+	auto uniform	= &uniformTypeAndValue;
 
 	_numDependencies++;
 
-	_loaderCompleteSlots[loader] = loader->complete()->connect([&](file::AbstractLoader::Ptr loader)
-	{
-		auto pos = loader->resolvedFilename().find_last_of('.');
-		auto extension = loader->resolvedFilename().substr(pos + 1);
-		auto parser = _assetLibrary->getParser(extension);
-
-		auto completeSlot = parser->complete()->connect([&](file::AbstractParser::Ptr parser)
+	_assetLibrary->fetch(
+		textureFilename,
+		options,
+		[=](file::AbstractLoader::Ptr loader)
 		{
-			uniformTypeAndValue.second.textureValue = _assetLibrary->texture(textureFilename);
-			uniformTypeAndValue.second.textureValue->upload();
+			auto textureLoaded = [=]()
+			{
+				uniform->second.textureValue = that->_assetLibrary->texture(textureFilename);
+				uniform->second.textureValue->upload();
 
-			_numLoadedDependencies++;
+				that->_numLoadedDependencies++;
 
-			if (_numDependencies == _numLoadedDependencies && _effect)
-				finalize();
-		});
+				if (that->_numDependencies == that->_numLoadedDependencies && that->_effect)
+					that->finalize();
+			};
 
-		parser->parse(
-			loader->filename(),
-			loader->resolvedFilename(),
-			loader->options(), loader->data(),
-			_assetLibrary
-		);
-	});
+			// already parsed for another effect
+			if (that->_assetLibrary->texture(textureFilename))
+			{
+				textureLoaded();
+
+				return;
+			}
 
-	_loaderErrorSlots[loader] = loader->error()->connect(std::bind(
-		&EffectParser::dependencyErrorHandler,
-		std::static_pointer_cast<EffectParser>(shared_from_this()),
-		std::placeholders::_1
-	));
+			auto pos = loader->resolvedFilename().find_last_of('.');
+			auto extension = loader->resolvedFilename().substr(pos + 1);
+			auto parser = that->_assetLibrary->getParser(extension);
 
-	loader->load(textureFilename, options);
+			auto completeSlot = parser->complete()->connect([=](file::AbstractParser::Ptr parser)
+			{
+				textureLoaded();
+			});
+
+			parser->parse(
+				loader->filename(),
+				loader->resolvedFilename(),
+				loader->options(), loader->data(),
+				that->_assetLibrary
+			);
+		},
+		std::bind(
+			&EffectParser::dependencyErrorHandler,
+			that,
+			std::placeholders::_1
+		)
+	);
 }
 
 void
@@ -1016,7 +1184,7 @@ EffectParser::parseStencilState(const Json::Value& contextNode,
 		auto stencilOpsValue	= stencilTest.get("stencilOps", 0);
 
 		if (stencilFuncValue.isString())
-			stencilFunc	= _compareFuncMap[stencilFuncValue.asString()];
+			stencilFunc	= compareFuncMap()[stencilFuncValue.asString()];
 		if (stencilRefValue.isInt())
 			stencilRef	= stencilRefValue.asInt();
 		if (stencilMaskValue.isUInt())
@@ -1025,7 +1193,7 @@ EffectParser::parseStencilState(const Json::Value& contextNode,
 	}
     else if (stencilTest.isArray())
     {
-		stencilFunc = _compareFuncMap[stencilTest[0].asString()];
+		stencilFunc = compareFuncMap()[stencilTest[0].asString()];
 		stencilRef	= stencilTest[1].asInt();
 		stencilMask	= stencilTest[2].asUInt();
 		parseStencilOperations(stencilTest[3], stencilFailOp, stencilZFailOp, stencilZPassOp);
@@ -1066,11 +1234,11 @@ EffectParser::parseStencilOperations(const Json::Value& contextNode,
 	if (contextNode.isArray())
 	{
 		if (contextNode[0].isString())
-			stencilFailOp = _stencilOpMap[contextNode[0].asString()];
+			stencilFailOp = stencilOpMap()[contextNode[0].asString()];
 		if (contextNode[1].isString())
-			stencilZFailOp = _stencilOpMap[contextNode[1].asString()];
+			stencilZFailOp = stencilOpMap()[contextNode[1].asString()];
 		if (contextNode[2].isString())
-			stencilZPassOp = _stencilOpMap[contextNode[2].asString()];
+			stencilZPassOp = stencilOpMap()[contextNode[2].asString()];
 	}
 	else
 	{
@@ -1079,11 +1247,11 @@ EffectParser::parseStencilOperations(const Json::Value& contextNode,
 		auto zpassValue	= contextNode.get("zpass", 0);
 
 		if (failValue.isString())
-			stencilFailOp = _stencilOpMap[failValue.asString()];
+			stencilFailOp = stencilOpMap()[failValue.asString()];
 		if (zfailValue.isString())
-			stencilZFailOp = _stencilOpMap[zfailValue.asString()];
+			stencilZFailOp = stencilOpMap()[zfailValue.asString()];
 		if (zpassValue.isString())
-			stencilZPassOp = _stencilOpMap[zpassValue.asString()];
+			stencilZPassOp = stencilOpMap()[zpassValue.asString()];
 	}
 }
 
@@ -1253,17 +1421,52 @@ EffectParser::parseConfiguration(const Json::Value&	root)
 std::string
 EffectParser::concatenateGLSLBlocks(GLSLBlockListPtr blocks)
 {
+	std::lock_guard<std::recursive_mutex> lock(_glslCacheMutex);
+
 	std::string glsl = "";
 
 	for (auto& block : *blocks)
-		glsl += block.second;
+	{
+		if (block.first != GLSLBlockType::INCLUDE)
+		{
+			glsl += block.second;
+			continue;
+		}
+
+#ifdef DEBUG
+		glsl += "//#pragma include(\"" + block.second + "\")\n";
+#else
+		glsl += "\n";
+#endif
+		glsl += concatenateGLSLBlocks(_glslIncludeCache[block.second]->blocks);
+	}
 
 	return glsl;
 }
 
+bool
+EffectParser::includesGLSL(GLSLBlockListPtr blocks, const std::string& resolvedFilename)
+{
+	std::lock_guard<std::recursive_mutex> lock(_glslCacheMutex);
+
+	for (auto& block : *blocks)
+		if (block.first == GLSLBlockType::INCLUDE
+			&& (block.second == resolvedFilename || includesGLSL(_glslIncludeCache[block.second]->blocks, resolvedFilename)))
+			return true;
+
+	return false;
+}
+
 void
 EffectParser::finalize()
 {
+	std::lock_guard<std::recursive_mutex> lock(_glslCacheMutex);
+
+	// every include is loaded, the other effects can use them
+	for (auto& include : _glslIncludes)
+		_glslIncludeCache[include.first] = include.second;
+	_glslIncludes.clear();
+
 	for (auto& technique : _techniquePasses)
     {
     	auto techniqueName = technique.first;
@@ -1272,15 +1475,21 @@ EffectParser::finalize()
 		for (auto& pass : passes)
 		{
 			auto program = pass->program();
+			PassShaders shaders;
+
+			shaders.pass = pass;
+			shaders.vertexBlocks = _glslBlocks[program->vertexShader()];
+			shaders.fragmentBlocks = _glslBlocks[program->fragmentShader()];
+			_glslPasses.push_back(shaders);
 
 			program->vertexShader()->source(
 				"#define VERTEX_SHADER\r\n"
-				+ concatenateGLSLBlocks(_glslBlocks[program->vertexShader()])
+				+ concatenateGLSLBlocks(shaders.vertexBlocks)
 			);
 
 			program->fragmentShader()->source(
 				"#define FRAGMENT_SHADER\r\n"
-				+ concatenateGLSLBlocks(_glslBlocks[program->fragmentShader()])
+				+ concatenateGLSLBlocks(shaders.fragmentBlocks)
 			);
 		}
 
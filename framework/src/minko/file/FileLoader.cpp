@@ -20,6 +20,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/file/FileLoader.hpp"
 
 #include "minko/file/Options.hpp"
+#include "minko/file/PackedArchive.hpp"
 #include "minko/Signal.hpp"
 #include "minko/AbstractCanvas.hpp"
 #include "minko/async/Worker.hpp"
@@ -30,6 +31,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 using namespace minko;
 using namespace minko::file;
 
+const uint FileLoader::CHUNK_SIZE = 64 * 1024;
+
 FileLoader::FileLoader()
 {
 }
@@ -56,7 +59,10 @@ FileLoader::load(const std::string& filename, std::shared_ptr<Options> options)
 	_filename = filename;
 	_resolvedFilename = options->uriFunction()(sanitizeFilename(cleanFilename));
 	_options = options;
-	
+
+	if (!_options->archives().empty() && loadFromArchive(sanitizeFilename(cleanFilename)))
+		return;
+
 	std::fstream file(cleanFilename, flags);
 
 	if (!file.is_open())
@@ -82,6 +88,7 @@ FileLoader::load(const std::string& filename, std::shared_ptr<Options> options)
 			_workerSlots.push_back(worker->complete()->connect([=](async::Worker::MessagePtr data) {
 				void* charData = &*data->begin();
 				_data.assign(static_cast<unsigned char*>(charData), static_cast<unsigned char*>(charData) + data->size());
+				_chunk->execute(shared_from_this(), 0, _data.size());
 				_complete->execute(shared_from_this());
 			}));
 
@@ -94,18 +101,25 @@ FileLoader::load(const std::string& filename, std::shared_ptr<Options> options)
 		else
 		{
 			unsigned int size = (unsigned int)file.tellg();
+			auto loader = shared_from_this();
 
-			// FIXME: use fixed size buffers and call _progress accordingly
-
-			_progress->execute(shared_from_this(), 0.0);
+			_progress->execute(loader, 0.0);
 
 			_data.resize(size);
 
 			file.seekg(0, std::ios::beg);
-			file.read((char*)&_data[0], size);
+			for (uint offset = 0; offset < size; offset += CHUNK_SIZE)
+			{
+				auto readSize = std::min(CHUNK_SIZE, size - offset);
+
+				file.read((char*)&_data[offset], readSize);
+				_chunk->execute(loader, offset, readSize);
+				_progress->execute(loader, (float)(offset + readSize) / (float)size);
+			}
 			file.close();
 
-			_progress->execute(shared_from_this(), 1.0);
+			if (size == 0)
+				_progress->execute(loader, 1.0);
 
 			_complete->execute(shared_from_this());
 		}
@@ -113,3 +127,53 @@ FileLoader::load(const std::string& filename, std::shared_ptr<Options> options)
 	else
 		_error->execute(shared_from_this());
 }
+
+bool
+FileLoader::loadFromArchive(const std::string& filename)
+{
+	for (auto& archive : _options->archives())
+	{
+		auto name = PackedArchive::normalize(filename);
+
+		if (!archive->hasEntry(name))
+		{
+			auto pathIt = std::find_if(
+				_options->includePaths().begin(),
+				_options->includePaths().end(),
+				[&](const std::string& path) { return archive->hasEntry(path + '/' + filename); }
+			);
+
+			if (pathIt == _options->includePaths().end())
+				continue;
+
+			name = PackedArchive::normalize(*pathIt + '/' + filename);
+		}
+
+		if (!archive->read(name, _data))
+			continue;
+
+		auto loader = shared_from_this();
+		auto size = (uint)_data.size();
+
+		_resolvedFilename = name;
+		_progress->execute(loader, 0.0);
+
+		// the data is already there but incremental parsers still expect it in CHUNK_SIZE blocks
+		for (uint offset = 0; offset < size; offset += CHUNK_SIZE)
+		{
+			auto readSize = std::min(CHUNK_SIZE, size - offset);
+
+			_chunk->execute(loader, offset, readSize);
+			_progress->execute(loader, (float)(offset + readSize) / (float)size);
+		}
+
+		if (size == 0)
+			_progress->execute(loader, 1.0);
+
+		_complete->execute(loader);
+
+		return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,157 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/file/KTXParser.hpp"
+
+#include "minko/file/Options.hpp"
+#include "minko/file/AssetLibrary.hpp"
+#include "minko/render/AbstractContext.hpp"
+#include "minko/render/Texture.hpp"
+#include "minko/render/TextureStreamer.hpp"
+
+using namespace minko;
+using namespace minko::file;
+
+namespace
+{
+	const unsigned char KTX_IDENTIFIER[12] = {
+		0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'
+	};
+
+	const uint KTX_HEADER_SIZE	= 64;
+	const uint KTX_ENDIANNESS	= 0x04030201;
+
+	uint
+	readUint(const std::vector<unsigned char>& data, uint offset, bool swap)
+	{
+		if (offset + 4 > data.size())
+			throw std::invalid_argument("data");
+
+		uint value = data[offset] | (data[offset + 1] << 8) | (data[offset + 2] << 16) | (data[offset + 3] << 24);
+
+		if (swap)
+			value = (value >> 24) | ((value >> 8) & 0xff00) | ((value << 8) & 0xff0000) | (value << 24);
+
+		return value;
+	}
+}
+
+/*static*/
+render::TextureFormat
+KTXParser::textureFormat(uint glInternalFormat)
+{
+	switch (glInternalFormat)
+	{
+	case 0x83F0: return render::TextureFormat::RGB_DXT1;
+	case 0x83F1: return render::TextureFormat::RGBA_DXT1;
+	case 0x83F2: return render::TextureFormat::RGBA_DXT3;
+	case 0x83F3: return render::TextureFormat::RGBA_DXT5;
+	case 0x8D64: return render::TextureFormat::RGB_ETC1;
+	case 0x9274: return render::TextureFormat::RGB_ETC2;
+	case 0x9278: return render::TextureFormat::RGBA_ETC2;
+	case 0x8C00: return render::TextureFormat::RGB_PVRTC_4BPP;
+	case 0x8C01: return render::TextureFormat::RGB_PVRTC_2BPP;
+	case 0x8C02: return render::TextureFormat::RGBA_PVRTC_4BPP;
+	case 0x8C03: return render::TextureFormat::RGBA_PVRTC_2BPP;
+	case 0x93B0: return render::TextureFormat::RGBA_ASTC_4x4;
+	}
+
+	throw std::invalid_argument("glInternalFormat");
+}
+
+void
+KTXParser::parse(const std::string&                 filename,
+                 const std::string&                 resolvedFilename,
+                 std::shared_ptr<Options>           options,
+                 const std::vector<unsigned char>&  data,
+                 std::shared_ptr<AssetLibrary>      assetLibrary)
+{
+	if (data.size() < KTX_HEADER_SIZE || !std::equal(KTX_IDENTIFIER, KTX_IDENTIFIER + 12, data.begin()))
+		throw std::invalid_argument("file " + filename + " is not a valid KTX file");
+
+	const bool swap = readUint(data, 12, false) != KTX_ENDIANNESS;
+	const auto glType = readUint(data, 16, swap);
+	const auto glInternalFormat = readUint(data, 28, swap);
+	const auto width = readUint(data, 36, swap);
+	const auto height = readUint(data, 40, swap);
+	const auto depth = readUint(data, 44, swap);
+	const auto numArrayElements = readUint(data, 48, swap);
+	const auto numFaces = readUint(data, 52, swap);
+	const auto numMipLevels = std::max(1u, readUint(data, 56, swap));
+	const auto keyValueDataSize = readUint(data, 60, swap);
+
+	if (glType != 0)
+		throw std::invalid_argument("file " + filename + " is not a compressed KTX texture");
+	if (depth > 1 || numArrayElements > 0 || numFaces != 1)
+		throw std::invalid_argument("file " + filename + ": only 2D KTX textures are supported");
+
+	const auto format = textureFormat(glInternalFormat);
+
+	if (!options->context()->supportsTextureFormat(format))
+		throw std::invalid_argument("file " + filename + ": texture format is not supported by the context");
+
+	// mipmaps are never generated from compressed data: use the ones of the file or none
+	const bool mipMapping = options->generateMipmaps() && numMipLevels > 1;
+	auto texture = render::Texture::create(
+		options->context(),
+		width,
+		height,
+		mipMapping,
+		false,
+		options->resizeSmoothly(),
+		filename
+	);
+
+	auto streamer = options->textureStreamer();
+	std::vector<std::vector<unsigned char>> streamedLevels;
+	uint offset = KTX_HEADER_SIZE + keyValueDataSize;
+
+	for (uint level = 0; level < (mipMapping ? numMipLevels : 1); ++level)
+	{
+		const auto imageSize = readUint(data, offset, swap);
+
+		offset += 4;
+		if (offset + imageSize > data.size())
+			throw std::invalid_argument("file " + filename + " is truncated");
+
+		auto levelData = const_cast<unsigned char*>(&data[offset]);
+
+		if (level == 0)
+		{
+			texture->data(levelData, format);
+			if (streamer)
+				texture->disposeData();
+			texture->upload();
+		}
+		else if (!streamer)
+			texture->uploadMipLevel(level, levelData);
+
+		if (streamer)
+			streamedLevels.push_back(std::vector<unsigned char>(levelData, levelData + imageSize));
+
+		offset += (imageSize + 3) & ~3u;
+	}
+
+	if (streamer)
+		streamer->stream(texture, streamedLevels);
+
+	assetLibrary->texture(filename, texture);
+
+	complete()->execute(shared_from_this());
+}
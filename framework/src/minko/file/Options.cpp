@@ -33,6 +33,7 @@ using namespace minko::file;
 Options::Options(std::shared_ptr<render::AbstractContext> context) :
 	_context(context),
 	_includePaths(),
+	_archives(),
 	_platforms(),
 	_userFlags(),
 	_generateMipMaps(false),
@@ -40,10 +41,18 @@ Options::Options(std::shared_ptr<render::AbstractContext> context) :
 	_isCubeTexture(false),
 	_startAnimation(true),
 	_loadAsynchronously(false),
+	_optimizeGeometries(false),
+	_compressGeometries(false),
+	_disposeGeometryData(false),
+	_shareMaterials(true),
+	_loadPriority(0),
+	_maxTextureSize(0),
 	_skinningFramerate(30),
 	_skinningMethod(component::SkinningMethod::HARDWARE),
+	_skinningCompressionTolerance(0.0f),
+	_effect(nullptr),
 	_material(nullptr),
-	_effect(nullptr)
+	_textureStreamer(nullptr)
 {
     includePaths().push_back("asset");
 
@@ -0,0 +1,303 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/file/PackedArchive.hpp"
+
+#if !defined(_WIN32) && !defined(EMSCRIPTEN)
+# define MINKO_PACKED_ARCHIVE_MMAP
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <fcntl.h>
+# include <unistd.h>
+#endif
+
+using namespace minko;
+using namespace minko::file;
+
+// "MKPK"
+const uint PackedArchive::MAGIC		= 0x4b504b4d;
+const uint PackedArchive::VERSION	= 1;
+const uint PackedArchive::ALIGNMENT	= 16;
+
+namespace
+{
+	const uint HEADER_SIZE = 16;
+
+	template <typename T>
+	void
+	writeValue(std::vector<unsigned char>& output, T value)
+	{
+		for (uint i = 0; i < sizeof(T); ++i)
+			output.push_back((unsigned char)((uint64_t)value >> (i * 8)));
+	}
+
+	template <typename T>
+	bool
+	readValue(const unsigned char* data, uint64_t size, uint64_t& offset, T& value)
+	{
+		if (offset + sizeof(T) > size)
+			return false;
+
+		uint64_t result = 0;
+
+		for (uint i = 0; i < sizeof(T); ++i)
+			result |= (uint64_t)data[offset + i] << (i * 8);
+		value = (T)result;
+		offset += sizeof(T);
+
+		return true;
+	}
+
+	uint64_t
+	align(uint64_t offset)
+	{
+		return (offset + PackedArchive::ALIGNMENT - 1) / PackedArchive::ALIGNMENT * PackedArchive::ALIGNMENT;
+	}
+}
+
+PackedArchive::PackedArchive(const std::string& filename) :
+	_filename(filename),
+	_mapping(nullptr),
+	_mappingSize(0)
+{
+}
+
+PackedArchive::~PackedArchive()
+{
+#ifdef MINKO_PACKED_ARCHIVE_MMAP
+	if (_mapping != nullptr && _buffer.empty())
+		munmap(const_cast<unsigned char*>(_mapping), _mappingSize);
+#endif
+}
+
+PackedArchive::Ptr
+PackedArchive::open(const std::string& filename)
+{
+	auto archive = std::shared_ptr<PackedArchive>(new PackedArchive(filename));
+
+	if (!archive->map() || !archive->readTableOfContents())
+		return nullptr;
+
+	return archive;
+}
+
+bool
+PackedArchive::map()
+{
+#ifdef MINKO_PACKED_ARCHIVE_MMAP
+	auto fd = ::open(_filename.c_str(), O_RDONLY);
+
+	if (fd < 0)
+		return false;
+
+	struct stat info;
+
+	if (fstat(fd, &info) == 0 && info.st_size > 0)
+	{
+		auto mapping = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+		if (mapping != MAP_FAILED)
+		{
+			_mapping = static_cast<const unsigned char*>(mapping);
+			_mappingSize = info.st_size;
+		}
+	}
+	close(fd);
+
+	if (_mapping != nullptr)
+		return true;
+#endif
+
+	// no mmap, the whole archive is kept in memory instead
+	std::ifstream file(_filename, std::ios::in | std::ios::ate | std::ios::binary);
+
+	if (!file.is_open())
+		return false;
+
+	_buffer.resize((uint)file.tellg());
+	if (_buffer.empty())
+		return false;
+	file.seekg(0, std::ios::beg);
+	file.read((char*)&_buffer[0], _buffer.size());
+
+	_mapping = &_buffer[0];
+	_mappingSize = _buffer.size();
+
+	return true;
+}
+
+bool
+PackedArchive::readTableOfContents()
+{
+	uint64_t offset = 0;
+	uint magic = 0;
+	uint version = 0;
+	uint numEntries = 0;
+	uint tocSize = 0;
+
+	if (!readValue(_mapping, _mappingSize, offset, magic) || magic != MAGIC
+		|| !readValue(_mapping, _mappingSize, offset, version) || version != VERSION
+		|| !readValue(_mapping, _mappingSize, offset, numEntries)
+		|| !readValue(_mapping, _mappingSize, offset, tocSize))
+		return false;
+
+	auto dataOffset = align(HEADER_SIZE + tocSize);
+
+	_entries.reserve(numEntries);
+	for (uint i = 0; i < numEntries; ++i)
+	{
+		unsigned short nameLength = 0;
+		unsigned char compression = 0;
+		Entry entry;
+
+		if (!readValue(_mapping, _mappingSize, offset, nameLength) || offset + nameLength > _mappingSize)
+			return false;
+
+		std::string name(reinterpret_cast<const char*>(_mapping + offset), nameLength);
+
+		offset += nameLength;
+		if (!readValue(_mapping, _mappingSize, offset, entry.offset)
+			|| !readValue(_mapping, _mappingSize, offset, entry.size)
+			|| !readValue(_mapping, _mappingSize, offset, entry.storedSize)
+			|| !readValue(_mapping, _mappingSize, offset, compression))
+			return false;
+
+		entry.offset += dataOffset;
+		entry.compression = static_cast<Compression>(compression);
+		if (entry.offset + entry.storedSize > _mappingSize)
+			return false;
+
+		_entries[name] = entry;
+	}
+
+	return true;
+}
+
+const unsigned char*
+PackedArchive::slice(const std::string& name, uint& size) const
+{
+	auto entryIt = _entries.find(normalize(name));
+
+	if (entryIt == _entries.end() || entryIt->second.compression != Compression::NONE)
+		return nullptr;
+
+	size = entryIt->second.size;
+
+	return _mapping + entryIt->second.offset;
+}
+
+bool
+PackedArchive::read(const std::string& name, std::vector<unsigned char>& output) const
+{
+	auto entryIt = _entries.find(normalize(name));
+
+	if (entryIt == _entries.end())
+		return false;
+
+	const auto& entry = entryIt->second;
+	auto data = _mapping + entry.offset;
+
+	if (entry.compression == Compression::NONE)
+	{
+		output.assign(data, data + entry.size);
+
+		return true;
+	}
+
+	if (!_decompressor)
+		return false;
+
+	output.resize(entry.size);
+
+	return _decompressor(data, entry.storedSize, output) && output.size() == entry.size;
+}
+
+bool
+PackedArchive::write(const std::string&											filename,
+					 const std::map<std::string, std::vector<unsigned char>>&	files,
+					 Compressor													compressor)
+{
+	std::vector<unsigned char> toc;
+	std::vector<unsigned char> data;
+	std::vector<unsigned char> compressed;
+
+	for (const auto& file : files)
+	{
+		auto name = normalize(file.first);
+		auto compression = Compression::NONE;
+		const std::vector<unsigned char>* stored = &file.second;
+
+		if (name.size() > USHRT_MAX)
+			return false;
+
+		compressed.clear();
+		if (compressor && !file.second.empty() && compressor(file.second, compressed)
+			&& compressed.size() < file.second.size())
+		{
+			compression = Compression::DEFLATE;
+			stored = &compressed;
+		}
+
+		data.resize(align(data.size()), 0);
+
+		writeValue(toc, (unsigned short)name.size());
+		toc.insert(toc.end(), name.begin(), name.end());
+		writeValue(toc, (uint64_t)data.size());
+		writeValue(toc, (uint)file.second.size());
+		writeValue(toc, (uint)stored->size());
+		writeValue(toc, (unsigned char)compression);
+
+		data.insert(data.end(), stored->begin(), stored->end());
+	}
+
+	std::vector<unsigned char> header;
+
+	writeValue(header, MAGIC);
+	writeValue(header, VERSION);
+	writeValue(header, (uint)files.size());
+	writeValue(header, (uint)toc.size());
+	header.insert(header.end(), toc.begin(), toc.end());
+	header.resize(align(header.size()), 0);
+
+	std::ofstream file(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+
+	if (!file.is_open())
+		return false;
+
+	file.write((const char*)&header[0], header.size());
+	if (!data.empty())
+		file.write((const char*)&data[0], data.size());
+
+	return file.good();
+}
+
+std::string
+PackedArchive::normalize(const std::string& name)
+{
+	auto result = name;
+
+	std::replace(result.begin(), result.end(), '\\', '/');
+
+	while (result.compare(0, 2, "./") == 0)
+		result.erase(0, 2);
+	while (!result.empty() && result[0] == '/')
+		result.erase(0, 1);
+
+	return result;
+}
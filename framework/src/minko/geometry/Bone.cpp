@@ -29,7 +29,7 @@ using namespace minko::scene;
 
 Bone::Bone(Node::Ptr							node, 
 		   Matrix4x4::Ptr						offsetMatrix, 
-		   const std::vector<unsigned short>&	vertexIds, 
+		   const std::vector<uint>&				vertexIds, 
 		   const std::vector<float>&			vertexWeights) :
 	_node(node),
 	_offsetMatrix(Matrix4x4::create()->copyFrom(offsetMatrix)),
@@ -22,8 +22,13 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/math/Vector2.hpp"
 #include "minko/math/Vector3.hpp"
 #include "minko/math/Ray.hpp"
+#include "minko/math/Box.hpp"
 #include "minko/render/IndexBuffer.hpp"
 #include "minko/render/VertexBuffer.hpp"
+#include "minko/geometry/TriangleBVH.hpp"
+#include "minko/geometry/MeshAdjacency.hpp"
+#include "minko/geometry/MeshOptimizer.hpp"
+#include "minko/async/Parallel.hpp"
 
 using namespace minko;
 using namespace minko::math;
@@ -34,7 +39,10 @@ Geometry::Geometry() :
 	_data(data::ArrayProvider::create("geometry")),
 	_vertexSize(0),
 	_numVertices(0),
-	_indexBuffer(nullptr)
+	_indexBuffer(nullptr),
+	_bvh(nullptr),
+	_adjacency(nullptr),
+	_boundingBox(nullptr)
 {
 }
 
@@ -59,6 +67,19 @@ Geometry::addVertexBuffer(render::VertexBuffer::Ptr vertexBuffer)
 
 	_vertexBuffers.push_back(vertexBuffer);
 
+	if (vertexBuffer->hasAttribute("position"))
+	{
+		_bvh = nullptr;
+		_adjacency = nullptr;
+		_boundingBox = nullptr;
+		_positionChangedSlot = vertexBuffer->dataChanged()->connect([&](VertexBuffer::Ptr)
+		{
+			_bvh = nullptr;
+			_adjacency = nullptr;
+			_boundingBox = nullptr;
+		});
+	}
+
 	_vbToVertexSizeChangedSlot[vertexBuffer] = vertexBuffer->vertexSizeChanged()->connect(std::bind(
 		&Geometry::vertexSizeChanged,
 		shared_from_this(),
@@ -85,6 +106,14 @@ Geometry::removeVertexBuffer(std::list<render::VertexBuffer::Ptr>::iterator vert
 		_numVertices = 0;
 
 	_vbToVertexSizeChangedSlot.erase(vertexBuffer);	
+
+	if (vertexBuffer->hasAttribute("position"))
+	{
+		_bvh = nullptr;
+		_adjacency = nullptr;
+		_boundingBox = nullptr;
+		_positionChangedSlot = nullptr;
+	}
 }
 
 void
@@ -125,56 +154,18 @@ Geometry::computeNormals()
 	if (!_data->hasProperty("position"))
 		throw std::logic_error("Computation of normals requires positions.");
 
-	const std::vector<unsigned short>& indices	= this->indices()->data();
-	const unsigned int numFaces					= indices.size() / 3;
-
-	unsigned short vertexIds[3] = { 0, 0, 0 };
-	std::vector<Vector3::Ptr> xyz(3);
-
 	VertexBuffer::Ptr xyzBuffer			= _data->get<VertexBuffer::Ptr>("position");
-	const unsigned int xyzSize			= xyzBuffer->vertexSize();
-	const unsigned int xyzOffset		= std::get<2>(*xyzBuffer->attribute("position"));
-	const std::vector<float>& xyzData	= xyzBuffer->data();
-
-	std::vector<float> normalsData(3 * numVertices, 0.0f);
-
-	for (unsigned int i = 0, offset = 0; i < numFaces; ++i)
-	{
-		for (unsigned int k = 0; k < 3; ++k)
-		{
-			vertexIds[k] = indices[offset++];
-			const unsigned int index = xyzOffset + vertexIds[k] * xyzSize;
-			xyz[k] = Vector3::create(xyzData[index], xyzData[index + 1], xyzData[index + 2]);
-		}
-
-		Vector3::Ptr faceNormal = Vector3::create()
-			->copyFrom(xyz[0] - xyz[1])
-			->cross(xyz[0] - xyz[2]);
-
- 		for (unsigned int k = 0; k < 3; ++k)
-		{
-			const unsigned int index = 3 * vertexIds[k];
-
-			normalsData[index]		+= faceNormal->x();
-			normalsData[index + 1]	+= faceNormal->y();
-			normalsData[index + 2]	+= faceNormal->z();
-		}
-	}
-
-	for (unsigned int i = 0, index = 0; i < numVertices; ++i, index += 3)
-	{
-		const float x				= normalsData[index];
-		const float y				= normalsData[index + 1];
-		const float z				= normalsData[index + 2];
-		const float lengthSquared	= x * x + y * y + z * z;
-		const float invLength		= lengthSquared > 1e-6f ? 1.0f / sqrtf(lengthSquared) : 1.0f;
-
-		normalsData[index]		*= invLength;
-		normalsData[index + 1]	*= invLength;
-		normalsData[index + 2]	*= invLength;
-	}
+	std::vector<float> normalsData;
+
+	computeNormals(
+		xyzBuffer->data(),
+		xyzBuffer->vertexSize(),
+		std::get<2>(*xyzBuffer->attribute("position")),
+		this->indices()->data(),
+		normalsData
+	);
 
-	VertexBuffer::Ptr normalsBuffer = VertexBuffer::create(xyzBuffer->context(), normalsData);
+	VertexBuffer::Ptr normalsBuffer = VertexBuffer::create(xyzBuffer->context(), std::move(normalsData));
 	normalsBuffer->addAttribute("normal", 3, 0);
 	addVertexBuffer(normalsBuffer);
 
@@ -196,71 +187,198 @@ Geometry::computeTangentSpace(bool doNormals)
 	if (doNormals)
 		computeNormals();
 
-	const std::vector<unsigned short>& indices (this->indices()->data());
-	const unsigned int numFaces = indices.size() / 3;
-
-	unsigned short vertexIds[3] = { 0, 0, 0 };
-	std::vector<Vector3::Ptr> xyz(3);
-	std::vector<Vector2::Ptr> uv(3);
-
 	VertexBuffer::Ptr xyzBuffer			= _data->get<VertexBuffer::Ptr>("position");
-	const unsigned int xyzSize			= xyzBuffer->vertexSize();
-	const unsigned int xyzOffset		= std::get<2>(*xyzBuffer->attribute("position"));
-	const std::vector<float>& xyzData	= xyzBuffer->data();
-
 	VertexBuffer::Ptr uvBuffer			= _data->get<VertexBuffer::Ptr>("uv");
-	const unsigned int uvSize			= uvBuffer->vertexSize();
-	const unsigned int uvOffset			= std::get<2>(*uvBuffer->attribute("uv"));
-	const std::vector<float>& uvData	= uvBuffer->data();
+	std::vector<float> tangentsData;
+
+	computeTangents(
+		xyzBuffer->data(),
+		xyzBuffer->vertexSize(),
+		std::get<2>(*xyzBuffer->attribute("position")),
+		uvBuffer->data(),
+		uvBuffer->vertexSize(),
+		std::get<2>(*uvBuffer->attribute("uv")),
+		this->indices()->data(),
+		tangentsData
+	);
 
-	std::vector<float> tangentsData(3 * numVertices, 0.0f);
+	VertexBuffer::Ptr tangentsBuffer = VertexBuffer::create(xyzBuffer->context(), std::move(tangentsData));
+	tangentsBuffer->addAttribute("tangent", 3, 0);
+	addVertexBuffer(tangentsBuffer);
+
+	return shared_from_this();
+}
 
-	for (unsigned int i = 0, offset = 0; i < numFaces; ++i)
+namespace
+{
+	uint
+	numWorkers(uint numTriangles)
+	{
+#if defined(MINKO_NO_THREADS)
+		return 1;
+#else
+		if (numTriangles < Geometry::PARALLEL_MIN_NUM_TRIANGLES)
+			return 1;
+
+		return std::max(1u, std::thread::hardware_concurrency());
+#endif
+	}
+
+	// sums the per worker vectors into the first one and normalizes them
+	void
+	reduceAndNormalize(std::vector<std::vector<float>>& partials, uint numVertices, uint numWorkers)
 	{
-		for (unsigned int k = 0; k < 3; ++k)
+		auto& result = partials[0];
+
+		async::runInParallel(numVertices, numWorkers, [&](uint begin, uint end, uint worker)
 		{
-			vertexIds[k] = indices[offset++];
-			unsigned int index = xyzOffset + vertexIds[k] * xyzSize;
-			xyz[k] = Vector3::create(xyzData[index], xyzData[index + 1], xyzData[index + 2]);
-			index = uvOffset + vertexIds[k] * uvSize;
-			uv[k] = Vector2::create(uvData[index], uvData[index + 1]);
-		}
+			for (uint i = begin, index = begin * 3; i < end; ++i, index += 3)
+			{
+				float x = result[index];
+				float y = result[index + 1];
+				float z = result[index + 2];
+
+				for (uint p = 1; p < partials.size(); ++p)
+				{
+					x += partials[p][index];
+					y += partials[p][index + 1];
+					z += partials[p][index + 2];
+				}
 
-		Vector2::Ptr uv02		= uv[0] - uv[2];
-		Vector2::Ptr uv12		= uv[1] - uv[2];
-		const float denom		= uv02->x() * uv12->y() - uv12->x() * uv02->y();
-		const float invDenom	= fabsf(denom) > 1e-6f ? 1.0f/denom : 1.0f;
+				const float lengthSquared	= x * x + y * y + z * z;
+				const float invLength		= lengthSquared > 1e-6f ? 1.0f / sqrtf(lengthSquared) : 1.0f;
 
-		Vector3::Ptr faceTangent = ((xyz[0]-xyz[2]) * uv12->y() - (xyz[1]-xyz[2]) * uv02->y()) * invDenom;
+				result[index]		= x * invLength;
+				result[index + 1]	= y * invLength;
+				result[index + 2]	= z * invLength;
+			}
+		});
+	}
+}
+
+void
+Geometry::computeNormals(const std::vector<float>&	xyzData,
+						 uint						xyzSize,
+						 uint						xyzOffset,
+						 const std::vector<uint>&	indices,
+						 std::vector<float>&		normals)
+{
+	const uint numVertices	= xyzData.size() / xyzSize;
+	const uint numFaces		= indices.size() / 3;
+	const uint numWorkers	= ::numWorkers(numFaces);
+
+	// each worker accumulates its triangles in its own buffer
+	std::vector<std::vector<float>> partials(numWorkers);
+
+	async::runInParallel(numFaces, numWorkers, [&](uint begin, uint end, uint worker)
+	{
+		auto& normalsData = partials[worker];
 
-		for (unsigned int k=0; k<3; ++k)
+		normalsData.assign(3 * numVertices, 0.0f);
+
+		for (uint i = begin; i < end; ++i)
 		{
-			const unsigned int index = 3 * vertexIds[k];
+			const uint		v0 = indices[i * 3];
+			const uint		v1 = indices[i * 3 + 1];
+			const uint		v2 = indices[i * 3 + 2];
+			const float*	p0 = &xyzData[xyzOffset + v0 * xyzSize];
+			const float*	p1 = &xyzData[xyzOffset + v1 * xyzSize];
+			const float*	p2 = &xyzData[xyzOffset + v2 * xyzSize];
+
+			const float e1x = p0[0] - p1[0], e1y = p0[1] - p1[1], e1z = p0[2] - p1[2];
+			const float e2x = p0[0] - p2[0], e2y = p0[1] - p2[1], e2z = p0[2] - p2[2];
 
-			tangentsData[index]		+= faceTangent->x();
-			tangentsData[index + 1]	+= faceTangent->y();
-			tangentsData[index + 2]	+= faceTangent->z();
+			const float nx = e1y * e2z - e1z * e2y;
+			const float ny = e1z * e2x - e1x * e2z;
+			const float nz = e1x * e2y - e1y * e2x;
+
+			for (auto v : { v0, v1, v2 })
+			{
+				normalsData[v * 3]		+= nx;
+				normalsData[v * 3 + 1]	+= ny;
+				normalsData[v * 3 + 2]	+= nz;
+			}
 		}
-	}
+	});
+
+	partials.erase(
+		std::remove_if(partials.begin() + 1, partials.end(), [](const std::vector<float>& p) { return p.empty(); }),
+		partials.end()
+	);
+
+	if (partials[0].empty())
+		partials[0].assign(3 * numVertices, 0.0f);
+
+	reduceAndNormalize(partials, numVertices, numWorkers);
+
+	normals.swap(partials[0]);
+}
+
+void
+Geometry::computeTangents(const std::vector<float>&	xyzData,
+						  uint						xyzSize,
+						  uint						xyzOffset,
+						  const std::vector<float>&	uvData,
+						  uint						uvSize,
+						  uint						uvOffset,
+						  const std::vector<uint>&	indices,
+						  std::vector<float>&		tangents)
+{
+	const uint numVertices	= xyzData.size() / xyzSize;
+	const uint numFaces		= indices.size() / 3;
+	const uint numWorkers	= ::numWorkers(numFaces);
 
-	for (unsigned int i = 0, index = 0; i < numVertices; ++i, index += 3)
+	std::vector<std::vector<float>> partials(numWorkers);
+
+	async::runInParallel(numFaces, numWorkers, [&](uint begin, uint end, uint worker)
 	{
-		const float x				= tangentsData[index];
-		const float y				= tangentsData[index + 1];
-		const float z				= tangentsData[index + 2];
-		const float lengthSquared	= x * x + y * y + z * z;
-		const float invLength		= lengthSquared > 1e-6f ? 1.0f / sqrtf(lengthSquared) : 1.0f;
-
-		tangentsData[index]		*= invLength;
-		tangentsData[index + 1]	*= invLength;
-		tangentsData[index + 2]	*= invLength;
-	}
+		auto& tangentsData = partials[worker];
 
-	VertexBuffer::Ptr tangentsBuffer = VertexBuffer::create(xyzBuffer->context(), tangentsData);
-	tangentsBuffer->addAttribute("tangent", 3, 0);
-	addVertexBuffer(tangentsBuffer);
+		tangentsData.assign(3 * numVertices, 0.0f);
 
-	return shared_from_this();
+		for (uint i = begin; i < end; ++i)
+		{
+			const uint		v0	= indices[i * 3];
+			const uint		v1	= indices[i * 3 + 1];
+			const uint		v2	= indices[i * 3 + 2];
+			const float*	p0	= &xyzData[xyzOffset + v0 * xyzSize];
+			const float*	p1	= &xyzData[xyzOffset + v1 * xyzSize];
+			const float*	p2	= &xyzData[xyzOffset + v2 * xyzSize];
+			const float*	uv0	= &uvData[uvOffset + v0 * uvSize];
+			const float*	uv1	= &uvData[uvOffset + v1 * uvSize];
+			const float*	uv2	= &uvData[uvOffset + v2 * uvSize];
+
+			const float uv02x		= uv0[0] - uv2[0];
+			const float uv02y		= uv0[1] - uv2[1];
+			const float uv12x		= uv1[0] - uv2[0];
+			const float uv12y		= uv1[1] - uv2[1];
+			const float denom		= uv02x * uv12y - uv12x * uv02y;
+			const float invDenom	= fabsf(denom) > 1e-6f ? 1.0f / denom : 1.0f;
+
+			const float tx = ((p0[0] - p2[0]) * uv12y - (p1[0] - p2[0]) * uv02y) * invDenom;
+			const float ty = ((p0[1] - p2[1]) * uv12y - (p1[1] - p2[1]) * uv02y) * invDenom;
+			const float tz = ((p0[2] - p2[2]) * uv12y - (p1[2] - p2[2]) * uv02y) * invDenom;
+
+			for (auto v : { v0, v1, v2 })
+			{
+				tangentsData[v * 3]		+= tx;
+				tangentsData[v * 3 + 1]	+= ty;
+				tangentsData[v * 3 + 2]	+= tz;
+			}
+		}
+	});
+
+	partials.erase(
+		std::remove_if(partials.begin() + 1, partials.end(), [](const std::vector<float>& p) { return p.empty(); }),
+		partials.end()
+	);
+
+	if (partials[0].empty())
+		partials[0].assign(3 * numVertices, 0.0f);
+
+	reduceAndNormalize(partials, numVertices, numWorkers);
+
+	tangents.swap(partials[0]);
 }
 
 void
@@ -270,74 +388,308 @@ Geometry::vertexSizeChanged(VertexBuffer::Ptr vertexBuffer, int offset)
 }
 
 void
-Geometry::removeDuplicatedVertices()
+Geometry::removeDuplicatedVertices(float epsilon)
 {
 	std::vector<std::vector<float>> vertices;
 
 	for (auto vb : _vertexBuffers)
 		vertices.push_back(vb->data());
 
-	removeDuplicatedVertices(_indexBuffer->data(),	vertices, numVertices());
+	removeDuplicatedVertices(_indexBuffer->data(),	vertices, numVertices(), epsilon);
+
+	auto vertexIt = vertices.begin();
+
+	for (auto vb : _vertexBuffers)
+		vb->data().swap(*vertexIt++);
+
+	_numVertices = _vertexBuffers.empty() ? 0 : _vertexBuffers.front()->numVertices();
+	_bvh = nullptr;
+	_adjacency = nullptr;
+	upload();
 }
 
-void
-Geometry::removeDuplicatedVertices(std::vector<unsigned short>&		indices,
-								   std::vector<std::vector<float>>&	vertices,
-								   uint								numVertices)
+Geometry::Ptr
+Geometry::interleave()
 {
-	auto newVertexCount = 0;
-	auto newLimit = 0;
+	std::list<VertexBuffer::Ptr> vertexBuffers;
 
-	std::unordered_map<std::string, uint> hashToNewVertexId;
-	std::unordered_map<uint, uint> oldVertexIdToNewVertexId;
+	// buffers updated at runtime are kept apart, they are re-uploaded on their own
+	for (auto vb : _vertexBuffers)
+		if (vb->usage() == BufferUsage::STATIC && vb->vertexSize() > 0)
+			vertexBuffers.push_back(vb);
 
-	for (uint oldVertexId = 0; oldVertexId < numVertices; ++oldVertexId)
+	if (vertexBuffers.size() < 2)
+		return shared_from_this();
+
+	uint vertexSize = 0;
+
+	for (auto vb : vertexBuffers)
+		vertexSize += vb->vertexSize();
+
+	const auto			numVertices = _numVertices;
+	std::vector<float>	data(vertexSize * numVertices);
+	uint				offset = 0;
+
+	for (auto vb : vertexBuffers)
 	{
-		std::string hash;
+		const auto	vbVertexSize	= vb->vertexSize();
+		const auto&	vbData			= vb->data();
+
+		for (uint v = 0; v < numVertices; ++v)
+			std::copy(
+				vbData.begin() + v * vbVertexSize,
+				vbData.begin() + (v + 1) * vbVertexSize,
+				data.begin() + v * vertexSize + offset
+			);
+		offset += vbVertexSize;
+	}
 
-		for (auto& vb : vertices)
+	auto interleaved = VertexBuffer::create(vertexBuffers.front()->context(), std::move(data));
+
+	offset = 0;
+	for (auto vb : vertexBuffers)
+	{
+		for (auto attribute : vb->attributes())
 		{
-			auto vertexSize = vb.size() / numVertices;
+			const auto& name = std::get<0>(*attribute);
 
-			for (uint i = 0; i < vertexSize; ++i)
-				hash += std::to_string(vb[oldVertexId * vertexSize + i]) + " ";
+			interleaved->addAttribute(
+				name,
+				std::get<1>(*attribute),
+				offset + std::get<2>(*attribute),
+				vb->attributeType(name)
+			);
 		}
+		offset += vb->vertexSize();
+
+		removeVertexBuffer(vb);
+	}
+
+	addVertexBuffer(interleaved);
 
-		auto newVertexId = 0;
+	return shared_from_this();
+}
+
+Geometry::Ptr
+Geometry::optimize(uint cacheSize)
+{
+	if (_indexBuffer == nullptr || _numVertices == 0)
+		return interleave();
+
+	removeDuplicatedVertices();
+
+	auto& indices = _indexBuffer->data();
+
+	MeshOptimizer::optimizeVertexCache(indices, _numVertices, cacheSize);
+
+	if (hasVertexAttribute("position"))
+	{
+		auto xyzBuffer = vertexBuffer("position");
+
+		MeshOptimizer::optimizeOverdraw(
+			indices,
+			xyzBuffer->data(),
+			xyzBuffer->vertexSize(),
+			std::get<2>(*xyzBuffer->attribute("position")),
+			cacheSize
+		);
+	}
+
+	auto remap = MeshOptimizer::optimizeVertexFetch(indices, _numVertices);
+
+	for (auto vb : _vertexBuffers)
+		MeshOptimizer::remapVertices(vb->data(), vb->vertexSize(), remap);
+
+	_bvh = nullptr;
+	_adjacency = nullptr;
+	upload();
+
+	return interleave();
+}
+
+void
+Geometry::removeDuplicatedVertices(std::vector<uint>&					indices,
+								   std::vector<std::vector<float>>&	vertices,
+								   uint								numVertices,
+								   float							epsilon)
+{
+	if (numVertices == 0)
+		return;
+
+	const uint unused = std::numeric_limits<uint>::max();
+
+	std::vector<uint> vertexSizes;
+
+	for (auto& vb : vertices)
+		vertexSizes.push_back(vb.size() / numVertices);
 
-		if (!hashToNewVertexId.count(hash))
+	// components are compared on a grid of epsilon wide cells, or bit for bit (-0 aside) when epsilon is 0
+	const float invEpsilon = epsilon > 0.f ? 1.f / epsilon : 0.f;
+
+	auto quantize = [&](float value) -> uint
+	{
+		if (invEpsilon > 0.f)
+			return uint(int(floorf(value * invEpsilon + .5f)));
+
+		uint bits;
+
+		value = value == 0.f ? 0.f : value;
+		std::memcpy(&bits, &value, sizeof(uint));
+
+		return bits;
+	};
+
+	auto hash = [&](uint vertexId) -> uint64_t
+	{
+		uint64_t h = 14695981039346656037ULL;
+
+		for (uint i = 0; i < vertices.size(); ++i)
+			for (uint j = 0; j < vertexSizes[i]; ++j)
+				h = (h ^ quantize(vertices[i][vertexId * vertexSizes[i] + j])) * 1099511628211ULL;
+
+		return h ^ (h >> 32);
+	};
+
+	auto equals = [&](uint v1, uint v2) -> bool
+	{
+		for (uint i = 0; i < vertices.size(); ++i)
+			for (uint j = 0; j < vertexSizes[i]; ++j)
+				if (quantize(vertices[i][v1 * vertexSizes[i] + j]) != quantize(vertices[i][v2 * vertexSizes[i] + j]))
+					return false;
+
+		return true;
+	};
+
+	// open addressing table of the new vertex ids, kept at most half full
+	uint tableSize = 1;
+
+	while (tableSize < numVertices * 2)
+		tableSize <<= 1;
+
+	std::vector<uint>	table(tableSize, unused);
+	std::vector<uint>	oldVertexIdToNewVertexId(numVertices);
+	uint				newVertexCount = 0;
+
+	for (uint oldVertexId = 0; oldVertexId < numVertices; ++oldVertexId)
+	{
+		auto slot = uint(hash(oldVertexId)) & (tableSize - 1);
+
+		while (table[slot] != unused && !equals(table[slot], oldVertexId))
+			slot = (slot + 1) & (tableSize - 1);
+
+		if (table[slot] == unused)
 		{
-			newVertexId = newVertexCount++;
-			hashToNewVertexId[hash] = newVertexId;
-			newLimit = 1 + newVertexId;
+			const auto newVertexId = newVertexCount++;
 
+			// vertices only move backward, the ones already in the table stay where they are
 			if (newVertexId != oldVertexId)
-			{
-				for (auto& vb : vertices)
-				{
-					auto vertexSize = vb.size() / numVertices;
-
+				for (uint i = 0; i < vertices.size(); ++i)
 					std::copy(
-						vb.begin() + oldVertexId * vertexSize,
-						vb.begin() + (oldVertexId + 1) * vertexSize,
-						vb.begin() + newVertexId * vertexSize
+						vertices[i].begin() + oldVertexId * vertexSizes[i],
+						vertices[i].begin() + (oldVertexId + 1) * vertexSizes[i],
+						vertices[i].begin() + newVertexId * vertexSizes[i]
 					);
-				}
-			}
+
+			table[slot] = newVertexId;
 		}
-		else
-			newVertexId = hashToNewVertexId[hash];
 
-		oldVertexIdToNewVertexId[oldVertexId] = newVertexId;
+		oldVertexIdToNewVertexId[oldVertexId] = table[slot];
 	}
 
-	for (auto& vb : vertices)
-		vb.resize(newLimit * vb.size() / numVertices);
+	for (uint i = 0; i < vertices.size(); ++i)
+		vertices[i].resize(newVertexCount * vertexSizes[i]);
 
 	for (auto& index : indices)
 		index = oldVertexIdToNewVertexId[index];
 }
 
+Geometry::Ptr
+Geometry::simplify(float ratio)
+{
+	if (ratio <= 0.0f || ratio > 1.0f)
+		throw std::invalid_argument("ratio");
+
+	if (!_indexBuffer || !_data->hasProperty("position"))
+		throw std::logic_error("Simplification requires positions and indices.");
+
+	auto		xyzBuffer		= vertexBuffer("position");
+	const auto&	indices			= _indexBuffer->data();
+	const uint	targetNumIndices	= uint(ratio * (indices.size() / 3)) * 3;
+
+	auto simplifiedIndices = MeshOptimizer::simplify(
+		indices,
+		xyzBuffer->data(),
+		xyzBuffer->vertexSize(),
+		std::get<2>(*xyzBuffer->attribute("position")),
+		targetNumIndices
+	);
+
+	auto geometry = Geometry::create();
+
+	for (auto vb : _vertexBuffers)
+		geometry->addVertexBuffer(vb);
+	geometry->indices(IndexBuffer::create(_indexBuffer->context(), std::move(simplifiedIndices)));
+
+	return geometry;
+}
+
+TriangleBVH::Ptr
+Geometry::bvh()
+{
+	if (!_bvh)
+	{
+		auto xyzBuffer = vertexBuffer("position");
+
+		_bvh = TriangleBVH::create(
+			xyzBuffer->data(),
+			xyzBuffer->vertexSize(),
+			std::get<2>(*xyzBuffer->attribute("position")),
+			_indexBuffer->data()
+		);
+	}
+
+	return _bvh;
+}
+
+MeshAdjacency::Ptr
+Geometry::adjacency()
+{
+	if (!_adjacency)
+	{
+		if (_indexBuffer == nullptr || _indexBuffer->dataDisposed())
+			throw std::logic_error("the adjacency is built from the CPU-side copy of the indices");
+
+		auto xyzBuffer = hasVertexAttribute("position") ? vertexBuffer("position") : nullptr;
+
+		if (xyzBuffer && xyzBuffer->dataDisposed())
+			throw std::logic_error("the adjacency is built from the CPU-side copy of the positions");
+
+		_adjacency = xyzBuffer
+			? MeshAdjacency::create(
+				_indexBuffer->data(),
+				_numVertices,
+				&xyzBuffer->data()[std::get<2>(*xyzBuffer->attribute("position"))],
+				xyzBuffer->vertexSize()
+			)
+			: MeshAdjacency::create(_indexBuffer->data(), _numVertices);
+	}
+
+	return _adjacency;
+}
+
+Box::Ptr
+Geometry::boundingBox()
+{
+	if (!_boundingBox)
+	{
+		auto xyzBuffer = vertexBuffer("position");
+
+		_boundingBox = Box::create(xyzBuffer->maxPosition(), xyzBuffer->minPosition());
+	}
+
+	return _boundingBox;
+}
+
 bool
 Geometry::cast(std::shared_ptr<math::Ray>	ray,
 			   float&						distance,
@@ -346,95 +698,63 @@ Geometry::cast(std::shared_ptr<math::Ray>	ray,
 			   std::shared_ptr<Vector2>		hitUv,
 			   std::shared_ptr<Vector3>		hitNormal)
 {
-	static const auto EPSILON = 0.00001f;
+	if (!_indexBuffer || !hasVertexAttribute("position"))
+		return false;
 
-	auto hit = false;
-	auto& indicesData = _indexBuffer->data();
-	auto numIndices = indicesData.size();
-
-	auto xyzBuffer = vertexBuffer("position");
-	auto& xyzData = xyzBuffer->data();
-	auto xyzPtr = &xyzData[0];
-	auto xyzVertexSize = xyzBuffer->vertexSize();
-	auto xyzOffset = std::get<2>(*xyzBuffer->attribute("position"));
-
-	auto minDistance = std::numeric_limits<float>::lowest();
-	auto lambda = hitUv ? Vector2::create() : nullptr;
-	auto triangleIndice = -3;
-
-	auto v0 = Vector3::create();
-	auto v1 = Vector3::create();
-	auto v2 = Vector3::create();
-	auto edge1 = Vector3::create();
-	auto edge2 = Vector3::create();
-	auto pvec = Vector3::create();
-	auto tvec = Vector3::create();
-	auto qvec = Vector3::create();
-	auto dot = 0.f;
-	auto invDot = 0.f;
-	auto u = 0.f;
-	auto v = 0.f;
-	auto t = 0.f;
-
-	for (uint i = 0; i < numIndices; i += 3)
-	{
-		v0->copyFrom(xyzPtr + indicesData[i] * xyzVertexSize);
-		v1->copyFrom(xyzPtr + indicesData[i + 1] * xyzVertexSize);
-		v2->copyFrom(xyzPtr + indicesData[i + 2] * xyzVertexSize);
+	auto	origin		= ray->origin();
+	auto	direction	= ray->direction();
+	float	xyz[3]		= { origin->x(), origin->y(), origin->z() };
+	float	dir[3]		= { direction->x(), direction->y(), direction->z() };
+	float	u			= 0.f;
+	float	v			= 0.f;
 
-		edge1->copyFrom(v1)->subtract(v0);
-		edge2->copyFrom(v2)->subtract(v0);
+	if (!bvh()->cast(xyz, dir, distance, triangle, u, v))
+		return false;
 
-		pvec->copyFrom(ray->direction())->cross(edge2);
-		dot = edge1->dot(pvec);
+	if (hitXyz)
+		hitXyz->setTo(
+			xyz[0] + distance * dir[0],
+			xyz[1] + distance * dir[1],
+			xyz[2] + distance * dir[2]
+		);
 
-		if (dot > -EPSILON && dot < EPSILON)
-			continue;
+	// the BVH outlives the disposed data of the buffers
+	const bool hasData = !_indexBuffer->dataDisposed();
 
-		invDot = 1.f / dot;
+	if (hitUv && hasData)
+		getHitUv(triangle, Vector2::create(u, v), hitUv);
 
-		tvec->copyFrom(ray->origin())->subtract(v0);
-		u = tvec->dot(pvec) * invDot;
-		if (u < 0.f || u > 1.f)
-			continue;
+	if (hitNormal && hasData)
+		getHitNormal(triangle, hitNormal);
 
-		qvec->copyFrom(tvec)->cross(edge1);
-		v = ray->origin()->dot(qvec) * invDot;
-		if (v < 0.f || u + v > 1.f)
-			continue;
+	return true;
+}
 
-		t = edge2->dot(qvec) * invDot;
-		if (t < minDistance)
-		{
-			minDistance = t;
-			distance = t;
-			triangle = i;
-			hit = true;
+uint
+Geometry::cast(const std::vector<std::shared_ptr<math::Ray>>&	rays,
+			   std::vector<float>&								distances,
+			   std::vector<int>&								triangles)
+{
+	distances.assign(rays.size(), -1.f);
+	triangles.assign(rays.size(), -1);
 
-			if (hitUv)
-			{
-				lambda->x(u);
-				lambda->y(v);
-			}
-		}
+	if (rays.empty() || !_indexBuffer || !hasVertexAttribute("position"))
+		return 0;
 
-		if (hitXyz)
-		{
-			hitXyz->setTo(
-				ray->origin()->x() + minDistance * ray->direction()->x(),
-				ray->origin()->y() + minDistance * ray->direction()->y(),
-				ray->origin()->z() + minDistance * ray->direction()->z()
-			);
-		}
-
-		if (hitUv)
-			getHitUv(triangle, lambda, hitUv);
+	std::vector<float> origins(rays.size() * 3);
+	std::vector<float> directions(rays.size() * 3);
 
-		if (hitNormal)
-			getHitNormal(triangle, hitNormal);
+	for (uint i = 0; i < rays.size(); ++i)
+	{
+		origins[i * 3] = rays[i]->origin()->x();
+		origins[i * 3 + 1] = rays[i]->origin()->y();
+		origins[i * 3 + 2] = rays[i]->origin()->z();
+		directions[i * 3] = rays[i]->direction()->x();
+		directions[i * 3 + 1] = rays[i]->direction()->y();
+		directions[i * 3 + 2] = rays[i]->direction()->z();
 	}
 
-	return hit;
+	return bvh()->cast(rays.size(), &origins[0], &directions[0], &distances[0], &triangles[0]);
 }
 
 void
@@ -492,3 +812,21 @@ Geometry::upload()
 
 	_indexBuffer->upload();
 }
+
+void
+Geometry::disposeData(bool keepCastData)
+{
+	if (keepCastData && hasVertexAttribute("position"))
+	{
+		boundingBox();
+		if (_indexBuffer)
+			bvh();
+	}
+
+	for (const auto& vb : _vertexBuffers)
+		if (!vb->dataDisposed())
+			vb->disposeData();
+
+	if (_indexBuffer && !_indexBuffer->dataDisposed())
+		_indexBuffer->disposeData();
+}
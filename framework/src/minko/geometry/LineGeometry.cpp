@@ -29,7 +29,49 @@ using namespace minko::geometry;
 using namespace minko::render;
 using namespace minko::math;
 
-/*static*/ const uint			LineGeometry::MAX_NUM_LINES			= 16000;
+namespace
+{
+	const uint LINE_VERTEX_SIZE	= 9;
+	const uint LINE_SIZE		= 4 * LINE_VERTEX_SIZE;
+
+	// start weight, stop weight and spread of the 4 vertices of a line
+	const float LINE_WEIGHTS[12] = {
+		1.0f, 0.0f, -1.0f,
+		1.0f, 0.0f, 1.0f,
+		0.0f, 1.0f, 1.0f,
+		0.0f, 1.0f, -1.0f
+	};
+
+	// fixed size loops without branches, unrolled and vectorized by the compiler
+	inline
+	void
+	writeLine(const float* start, const float* stop, uint lineId, float* vertices, uint* indices)
+	{
+		for (uint k = 0; k < 4; ++k)
+		{
+			float* vertex = vertices + k * LINE_VERTEX_SIZE;
+
+			for (uint i = 0; i < 3; ++i)
+			{
+				vertex[i]		= start[i];
+				vertex[3 + i]	= stop[i];
+				vertex[6 + i]	= LINE_WEIGHTS[3 * k + i];
+			}
+		}
+
+		const uint iOffset = lineId << 2;
+
+		indices[0] = iOffset;
+		indices[1] = iOffset + 2;
+		indices[2] = iOffset + 1;
+		indices[3] = iOffset;
+		indices[4] = iOffset + 3;
+		indices[5] = iOffset + 2;
+	}
+}
+
+/*static*/ const uint			LineGeometry::MIN_CAPACITY					= 256;
+/*static*/ const uint			LineGeometry::MAX_NUM_SHORT_INDEXED_LINES	= 0x10000 >> 2;
 /*static*/ const std::string	LineGeometry::ATTRNAME_START_POS	= "startPosition";
 /*static*/ const std::string	LineGeometry::ATTRNAME_STOP_POS		= "stopPosition";
 /*static*/ const std::string	LineGeometry::ATTRNAME_WEIGHTS		= "weights";
@@ -54,6 +96,9 @@ LineGeometry::initialize(AbstractContext::Ptr context)
 	_vertexBuffer	= VertexBuffer::create(context);
 	_indexBuffer	= IndexBuffer::create(context);
 
+	_vertexBuffer->usage(BufferUsage::DYNAMIC);
+	_indexBuffer->usage(BufferUsage::DYNAMIC);
+
 	_vertexBuffer->addAttribute(ATTRNAME_START_POS,	3, 0);
 	_vertexBuffer->addAttribute(ATTRNAME_STOP_POS,	3, 3);
 	_vertexBuffer->addAttribute(ATTRNAME_WEIGHTS,	3, 6);
@@ -94,83 +139,141 @@ LineGeometry::lineTo(float x, float y, float z, unsigned int numSegments)
 	if (numSegments == 0)
 		return moveTo(x, y, z);
 
-	const uint					vertexSize			= _vertexBuffer->vertexSize();
-	const unsigned int			oldVertexDataSize	= _vertexBuffer->data().size();
-	const unsigned int			oldIndexDataSize	= _indexBuffer->data().size();
+	const uint	firstLine		= _numLines;
+	auto		buffers			= appendLines(numSegments);
+	const float	invNumSegments	= 1.0f / (float)numSegments;
+	const float	step[3]			= {
+		(x - _currentX) * invNumSegments,
+		(y - _currentY) * invNumSegments,
+		(z - _currentZ) * invNumSegments
+	};
 
-	std::vector<float>			vertexData	(oldVertexDataSize	+ 4 * numSegments * vertexSize);
-	std::vector<unsigned short>	indexData	(oldIndexDataSize	+ 6 * numSegments);
+	for (unsigned int segmentId = 0; segmentId < numSegments; ++segmentId)
+	{
+		const float current[3]	= { _currentX, _currentY, _currentZ };
+		const float next[3]		= { _currentX + step[0], _currentY + step[1], _currentZ + step[2] };
 
-	if (oldVertexDataSize > 0)
-		memcpy(&vertexData[0], &_vertexBuffer->data()[0], sizeof(float) * oldVertexDataSize);
-	if (oldIndexDataSize > 0)
-		memcpy(&indexData[0], &_indexBuffer->data()[0], sizeof(unsigned short) * oldIndexDataSize);
+		writeLine(current, next, firstLine + segmentId, buffers.first, buffers.second);
+		buffers.first	+= LINE_SIZE;
+		buffers.second	+= 6;
 
-	_vertexBuffer->dispose();
-	_indexBuffer->dispose();
+		_currentX	= next[0];
+		_currentY	= next[1];
+		_currentZ	= next[2];
+	}
 
-	const float invNumSegments	= 1.0f / (float)numSegments;
-	const float stepX			= (x - _currentX) * invNumSegments;
-	const float stepY			= (y - _currentY) * invNumSegments;
-	const float stepZ			= (z - _currentZ) * invNumSegments;
-	unsigned int vid			= oldVertexDataSize;
-	unsigned int iid			= oldIndexDataSize;
+	uploadLines(firstLine);
 
-	for (unsigned int segmentId = 0; segmentId < numSegments; ++segmentId)
-	{
-		if (_numLines >= MAX_NUM_LINES)
-			throw std::logic_error("Maximal number of segments (" + std::to_string(_numLines) + ") for line geometry reached.");
+	return std::static_pointer_cast<LineGeometry>(shared_from_this());
+}
 
-		const float nextX = _currentX + stepX;
-		const float nextY = _currentY + stepY;
-		const float nextZ = _currentZ + stepZ;
+LineGeometry::Ptr
+LineGeometry::lines(const float* points, uint numLines)
+{
+	if (numLines == 0)
+		return std::static_pointer_cast<LineGeometry>(shared_from_this());
+	if (points == nullptr)
+		throw std::invalid_argument("points");
 
-		for (unsigned int k = 0; k < 4; ++k)
-		{
-			const float wStart		= k < 2 ? 1.0f : 0.0f;
-			const float	wStop		= k < 2 ? 0.0f : 1.0f;
-			const float lineSpread	= 0 < k && k < 3 ? 1.0f : -1.0f;
-
-			// start position
-			vertexData[vid++] = _currentX;
-			vertexData[vid++] = _currentY;
-			vertexData[vid++] = _currentZ;
-
-			// stop position
-			vertexData[vid++] = nextX;
-			vertexData[vid++] = nextY;
-			vertexData[vid++] = nextZ;
-
-			// weights attribute
-			vertexData[vid++] = wStart;
-			vertexData[vid++] = wStop;
-			vertexData[vid++] = lineSpread;
-		}
+	const uint	firstLine	= _numLines;
+	auto		buffers		= appendLines(numLines);
 
-		const unsigned int iOffset = (_numLines << 2);
-		indexData[iid++] = iOffset;
-		indexData[iid++] = iOffset + 2;
-		indexData[iid++] = iOffset + 1;
+	for (uint lineId = 0; lineId < numLines; ++lineId)
+		writeLine(
+			points + 6 * lineId,
+			points + 6 * lineId + 3,
+			firstLine + lineId,
+			buffers.first + lineId * LINE_SIZE,
+			buffers.second + lineId * 6
+		);
 
-		indexData[iid++] = iOffset;
-		indexData[iid++] = iOffset + 3;
-		indexData[iid++] = iOffset + 2;
+	const float* last = points + 6 * numLines - 3;
 
-		_currentX	= nextX;
-		_currentY	= nextY;
-		_currentZ	= nextZ;
-		++_numLines;
-	}
+	moveTo(last[0], last[1], last[2]);
+	uploadLines(firstLine);
+
+	return std::static_pointer_cast<LineGeometry>(shared_from_this());
+}
+
+LineGeometry::Ptr
+LineGeometry::clear()
+{
+	_numLines = 0;
+	_vertexBuffer->data().clear();
+	_indexBuffer->data().clear();
+
+	// the draw calls read the new number of indices
+	indices(_indexBuffer);
+
+	return std::static_pointer_cast<LineGeometry>(shared_from_this());
+}
 
-	assert(vid == vertexData.size());
-	assert(iid == indexData.size());
+uint
+LineGeometry::capacity() const
+{
+	return _vertexBuffer->capacity() >> 2;
+}
 
-	std::swap(_vertexBuffer->data(), vertexData);
-	std::swap(_indexBuffer->data(), indexData);
+LineGeometry::Ptr
+LineGeometry::reserve(uint numLines)
+{
+	numLines = std::max(numLines, _numLines);
 
-	_vertexBuffer->upload();
-	_indexBuffer->upload();
+	_vertexBuffer->reserve(numLines << 2);
+	_indexBuffer->reserve(6 * numLines);
+	_vertexBuffer->data().reserve(numLines * LINE_SIZE);
+	_indexBuffer->data().reserve(6 * numLines);
 
 	return std::static_pointer_cast<LineGeometry>(shared_from_this());
 }
 
+std::pair<float*, uint*>
+LineGeometry::appendLines(uint numLines)
+{
+	const uint numTotalLines = _numLines + numLines;
+
+	if (numTotalLines > MAX_NUM_SHORT_INDEXED_LINES && !_vertexBuffer->context()->supportsUnsignedIntIndices())
+		throw std::logic_error("Maximal number of segments (" + std::to_string(_numLines) + ") for line geometry reached.");
+
+	if (numTotalLines > capacity())
+	{
+		uint newCapacity = std::max(capacity(), MIN_CAPACITY);
+
+		while (newCapacity < numTotalLines)
+			newCapacity <<= 1;
+		if (!_vertexBuffer->context()->supportsUnsignedIntIndices())
+			newCapacity = std::min(newCapacity, MAX_NUM_SHORT_INDEXED_LINES);
+
+		reserve(newCapacity);
+	}
+
+	auto& vertexData	= _vertexBuffer->data();
+	auto& indexData		= _indexBuffer->data();
+
+	vertexData.resize(numTotalLines * LINE_SIZE);
+	indexData.resize(6 * numTotalLines);
+
+	auto buffers = std::make_pair(&vertexData[_numLines * LINE_SIZE], &indexData[6 * _numLines]);
+
+	_numLines = numTotalLines;
+
+	return buffers;
+}
+
+void
+LineGeometry::uploadLines(uint firstLine)
+{
+	const auto vertexBufferId	= _vertexBuffer->id();
+	const uint numLines			= _numLines - firstLine;
+
+	// only the appended lines are uploaded unless the buffers had to grow
+	_vertexBuffer->upload(firstLine << 2, numLines << 2);
+	_indexBuffer->upload(6 * firstLine, 6 * numLines);
+
+	// the draw calls bind the new buffer when it was re-created
+	if (_vertexBuffer->id() != vertexBufferId)
+		for (auto& attribute : _vertexBuffer->attributes())
+			data()->set(std::get<0>(*attribute), _vertexBuffer);
+
+	indices(_indexBuffer);
+}
@@ -0,0 +1,177 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/geometry/MeshAdjacency.hpp"
+
+using namespace minko;
+using namespace minko::geometry;
+
+/*static*/ const int MeshAdjacency::NO_HALF_EDGE;
+
+MeshAdjacency::MeshAdjacency() :
+	_numBoundaryEdges(0),
+	_numNonManifoldEdges(0)
+{
+}
+
+void
+MeshAdjacency::build(const std::vector<uint>& indices, uint numVertices, const float* positions, uint vertexSize)
+{
+	if (indices.size() % 3 != 0)
+		throw std::invalid_argument("indices");
+
+	_indices = indices;
+	weldVertices(numVertices, positions, vertexSize);
+
+	const uint numHalfEdges = indices.size();
+
+	_opposites.assign(numHalfEdges, NO_HALF_EDGE);
+	_vertexHalfEdges.assign(numVertices, NO_HALF_EDGE);
+	_numBoundaryEdges = 0;
+	_numNonManifoldEdges = 0;
+
+	// unpaired half-edges by welded start and end vertices
+	std::unordered_map<uint64_t, uint> unpaired;
+
+	unpaired.reserve(numHalfEdges);
+	for (uint halfEdge = 0; halfEdge < numHalfEdges; ++halfEdge)
+	{
+		if (indices[halfEdge] >= numVertices)
+			throw std::invalid_argument("indices");
+
+		const uint start	= _weldedVertices[indices[halfEdge]];
+		const uint end		= _weldedVertices[indices[next(halfEdge)]];
+
+		if (_vertexHalfEdges[start] == NO_HALF_EDGE)
+			_vertexHalfEdges[start] = halfEdge;
+
+		auto oppositeIt = unpaired.find((uint64_t(end) << 32) | start);
+
+		if (oppositeIt != unpaired.end())
+		{
+			_opposites[halfEdge] = oppositeIt->second;
+			_opposites[oppositeIt->second] = halfEdge;
+			unpaired.erase(oppositeIt);
+		}
+		else if (!unpaired.emplace((uint64_t(start) << 32) | end, halfEdge).second)
+			++_numNonManifoldEdges;
+	}
+
+	for (auto opposite : _opposites)
+		if (opposite == NO_HALF_EDGE)
+			++_numBoundaryEdges;
+
+	// a boundary vertex starts from its boundary half-edge so that turning around it visits all of them
+	for (uint halfEdge = 0; halfEdge < numHalfEdges; ++halfEdge)
+		if (_opposites[halfEdge] == NO_HALF_EDGE)
+			_vertexHalfEdges[_weldedVertices[indices[halfEdge]]] = halfEdge;
+}
+
+void
+MeshAdjacency::weldVertices(uint numVertices, const float* positions, uint vertexSize)
+{
+	_weldedVertices.resize(numVertices);
+	for (uint vertex = 0; vertex < numVertices; ++vertex)
+		_weldedVertices[vertex] = vertex;
+
+	if (positions == nullptr)
+		return;
+
+	// the vertices sorted by position are equal to their predecessor or the first of a new position
+	std::vector<uint> sorted(_weldedVertices);
+
+	std::sort(sorted.begin(), sorted.end(), [&](uint a, uint b)
+	{
+		const float* p = positions + a * vertexSize;
+		const float* q = positions + b * vertexSize;
+
+		return std::lexicographical_compare(p, p + 3, q, q + 3) || (std::equal(p, p + 3, q) && a < b);
+	});
+
+	for (uint i = 1; i < numVertices; ++i)
+	{
+		const float* p = positions + sorted[i - 1] * vertexSize;
+		const float* q = positions + sorted[i] * vertexSize;
+
+		if (std::equal(p, p + 3, q))
+			_weldedVertices[sorted[i]] = _weldedVertices[sorted[i - 1]];
+	}
+}
+
+void
+MeshAdjacency::vertexHalfEdges(uint vertex, std::vector<uint>& halfEdges) const
+{
+	halfEdges.clear();
+
+	const int first = vertexHalfEdge(vertex);
+
+	if (first == NO_HALF_EDGE)
+		return;
+
+	// the half-edge leaving the vertex after h is the opposite of the half-edge entering it in the same triangle
+	int halfEdge = first;
+
+	do
+	{
+		halfEdges.push_back(halfEdge);
+		halfEdge = _opposites[previous(halfEdge)];
+	}
+	while (halfEdge != NO_HALF_EDGE && halfEdge != first && halfEdges.size() < _opposites.size());
+}
+
+uint
+MeshAdjacency::connectedComponents(std::vector<uint>& triangleComponents) const
+{
+	const uint	numTriangles	= this->numTriangles();
+	const uint	unvisited		= numTriangles;
+	uint		numComponents	= 0;
+
+	std::vector<uint> stack;
+
+	triangleComponents.assign(numTriangles, unvisited);
+	for (uint seed = 0; seed < numTriangles; ++seed)
+	{
+		if (triangleComponents[seed] != unvisited)
+			continue;
+
+		triangleComponents[seed] = numComponents;
+		stack.push_back(seed);
+
+		while (!stack.empty())
+		{
+			const uint triangle = stack.back();
+
+			stack.pop_back();
+			for (uint edge = 0; edge < 3; ++edge)
+			{
+				const int adjacent = adjacentTriangle(triangle, edge);
+
+				if (adjacent >= 0 && triangleComponents[adjacent] == unvisited)
+				{
+					triangleComponents[adjacent] = numComponents;
+					stack.push_back(adjacent);
+				}
+			}
+		}
+
+		++numComponents;
+	}
+
+	return numComponents;
+}
@@ -0,0 +1,617 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/geometry/MeshOptimizer.hpp"
+
+using namespace minko;
+using namespace minko::geometry;
+
+namespace
+{
+	// scoring constants from Tom Forsyth's "Linear-Speed Vertex Cache Optimisation"
+	const float CACHE_DECAY_POWER	= 1.5f;
+	const float LAST_TRIANGLE_SCORE	= 0.75f;
+	const float VALENCE_BOOST_SCALE	= 2.0f;
+	const float VALENCE_BOOST_POWER	= 0.5f;
+
+	float
+	vertexScore(int cachePosition, uint remainingValence, uint cacheSize)
+	{
+		if (remainingValence == 0)
+			return -1.0f;
+
+		float score = 0.0f;
+
+		if (cachePosition >= 0)
+		{
+			if (cachePosition < 3)
+				score = LAST_TRIANGLE_SCORE;
+			else
+				score = powf(1.0f - float(cachePosition - 3) / float(cacheSize - 3), CACHE_DECAY_POWER);
+		}
+
+		return score + VALENCE_BOOST_SCALE * powf(float(remainingValence), -VALENCE_BOOST_POWER);
+	}
+
+	// symmetric 4x4 matrix of a squared distance to planes, stored as its 10 upper coefficients
+	struct Quadric
+	{
+		double q[10];
+
+		Quadric()
+		{
+			std::fill(q, q + 10, 0.0);
+		}
+
+		void
+		addPlane(double a, double b, double c, double d, double weight)
+		{
+			q[0] += weight * a * a;	q[1] += weight * a * b;	q[2] += weight * a * c;	q[3] += weight * a * d;
+			q[4] += weight * b * b;	q[5] += weight * b * c;	q[6] += weight * b * d;
+			q[7] += weight * c * c;	q[8] += weight * c * d;
+			q[9] += weight * d * d;
+		}
+
+		void
+		add(const Quadric& other)
+		{
+			for (uint i = 0; i < 10; ++i)
+				q[i] += other.q[i];
+		}
+
+		double
+		error(const float* p) const
+		{
+			const double x = p[0], y = p[1], z = p[2];
+
+			return x * x * q[0] + 2.0 * x * y * q[1] + 2.0 * x * z * q[2] + 2.0 * x * q[3]
+				+ y * y * q[4] + 2.0 * y * z * q[5] + 2.0 * y * q[6]
+				+ z * z * q[7] + 2.0 * z * q[8]
+				+ q[9];
+		}
+	};
+
+	void
+	triangleNormal(const float* p0, const float* p1, const float* p2, float* n)
+	{
+		const float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+		const float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+
+		n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+		n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+		n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+	}
+
+	uint64_t
+	edgeKey(uint a, uint b)
+	{
+		return a < b ? (uint64_t(a) << 32) | b : (uint64_t(b) << 32) | a;
+	}
+}
+
+void
+MeshOptimizer::optimizeVertexCache(std::vector<uint>& indices, uint numVertices, uint cacheSize)
+{
+	if (cacheSize < 4)
+		throw std::invalid_argument("cacheSize");
+
+	const uint numTriangles = indices.size() / 3;
+
+	if (numTriangles == 0)
+		return;
+
+	std::vector<uint> valence(numVertices, 0);
+
+	for (uint i = 0; i < numTriangles * 3; ++i)
+	{
+		if (indices[i] >= numVertices)
+			throw std::invalid_argument("indices");
+
+		++valence[indices[i]];
+	}
+
+	// triangles of each vertex, the ones not emitted yet are kept at the beginning of their range
+	std::vector<uint> trianglesOffset(numVertices + 1, 0);
+	std::vector<uint> vertexTriangles(numTriangles * 3);
+	std::vector<uint> remainingValence(numVertices, 0);
+
+	for (uint v = 0; v < numVertices; ++v)
+		trianglesOffset[v + 1] = trianglesOffset[v] + valence[v];
+	for (uint i = 0; i < numTriangles * 3; ++i)
+	{
+		const auto v = indices[i];
+
+		vertexTriangles[trianglesOffset[v] + remainingValence[v]++] = i / 3;
+	}
+
+	std::vector<int>	cachePosition(numVertices, -1);
+	std::vector<float>	vertexScores(numVertices);
+	std::vector<float>	triangleScores(numTriangles, 0.0f);
+	std::vector<bool>	emitted(numTriangles, false);
+
+	for (uint v = 0; v < numVertices; ++v)
+		vertexScores[v] = vertexScore(-1, remainingValence[v], cacheSize);
+	for (uint i = 0; i < numTriangles * 3; ++i)
+		triangleScores[i / 3] += vertexScores[indices[i]];
+
+	std::vector<uint>	cache;
+	std::vector<uint>	newCache;
+	std::vector<uint>	output;
+	int					bestTriangle	= -1;
+	uint				cursor			= 0;
+
+	cache.reserve(cacheSize + 3);
+	newCache.reserve(cacheSize + 3);
+	output.reserve(numTriangles * 3);
+
+	for (uint n = 0; n < numTriangles; ++n)
+	{
+		// nothing left around the cached vertices: restart from the first triangle not emitted yet
+		if (bestTriangle < 0)
+		{
+			while (emitted[cursor])
+				++cursor;
+			bestTriangle = cursor;
+		}
+
+		const uint triangle = bestTriangle;
+
+		emitted[triangle] = true;
+		newCache.clear();
+
+		for (uint k = 0; k < 3; ++k)
+		{
+			const auto v		= indices[triangle * 3 + k];
+			auto begin			= vertexTriangles.begin() + trianglesOffset[v];
+			auto end			= begin + remainingValence[v];
+			auto triangleIt		= std::find(begin, end, triangle);
+
+			output.push_back(v);
+
+			if (triangleIt != end)
+			{
+				std::iter_swap(triangleIt, end - 1);
+				--remainingValence[v];
+			}
+
+			if (std::find(newCache.begin(), newCache.end(), v) == newCache.end())
+				newCache.push_back(v);
+		}
+
+		for (auto v : cache)
+			if (std::find(newCache.begin(), newCache.end(), v) == newCache.end())
+				newCache.push_back(v);
+
+		cache.swap(newCache);
+
+		// update the scores of the cached and evicted vertices and of their remaining triangles
+		for (uint i = 0; i < cache.size(); ++i)
+		{
+			const auto v		= cache[i];
+			const auto position	= i < cacheSize ? int(i) : -1;
+			const auto score	= vertexScore(position, remainingValence[v], cacheSize);
+			const auto delta	= score - vertexScores[v];
+
+			cachePosition[v] = position;
+			vertexScores[v] = score;
+
+			for (uint j = 0; j < remainingValence[v]; ++j)
+				triangleScores[vertexTriangles[trianglesOffset[v] + j]] += delta;
+		}
+
+		if (cache.size() > cacheSize)
+			cache.resize(cacheSize);
+
+		bestTriangle = -1;
+
+		float bestScore = -1.0f;
+
+		for (auto v : cache)
+			for (uint j = 0; j < remainingValence[v]; ++j)
+			{
+				const auto candidate = vertexTriangles[trianglesOffset[v] + j];
+
+				if (triangleScores[candidate] > bestScore)
+				{
+					bestScore = triangleScores[candidate];
+					bestTriangle = candidate;
+				}
+			}
+	}
+
+	indices.swap(output);
+}
+
+void
+MeshOptimizer::optimizeOverdraw(std::vector<uint>&			indices,
+								const std::vector<float>&	vertices,
+								uint						vertexSize,
+								uint						positionOffset,
+								uint						cacheSize)
+{
+	const uint numTriangles = indices.size() / 3;
+
+	if (numTriangles < 2 || vertexSize == 0)
+		return;
+
+	const uint numVertices = vertices.size() / vertexSize;
+
+	// a new cluster starts where a triangle misses the cache on all its vertices
+	std::vector<uint>	clusters(1, 0);
+	std::vector<uint>	timestamps(numVertices, 0);
+	uint				time = cacheSize + 1;
+
+	for (uint t = 0; t < numTriangles; ++t)
+	{
+		uint misses = 0;
+
+		for (uint k = 0; k < 3; ++k)
+		{
+			const auto v = indices[t * 3 + k];
+
+			if (v >= numVertices)
+				throw std::invalid_argument("indices");
+
+			if (time - timestamps[v] > cacheSize)
+			{
+				timestamps[v] = time++;
+				++misses;
+			}
+		}
+
+		if (t > 0 && misses == 3)
+			clusters.push_back(t);
+	}
+
+	if (clusters.size() < 2)
+		return;
+
+	clusters.push_back(numTriangles);
+
+	const uint numClusters = clusters.size() - 1;
+
+	// area weighted centroid and normal of each cluster
+	std::vector<float>	clusterData(numClusters * 7, 0.0f);
+	float				meshCentroid[3] = { 0.0f, 0.0f, 0.0f };
+	float				meshArea = 0.0f;
+
+	for (uint c = 0; c < numClusters; ++c)
+	{
+		auto data = &clusterData[c * 7];
+
+		for (uint t = clusters[c]; t < clusters[c + 1]; ++t)
+		{
+			const float* p0 = &vertices[indices[t * 3] * vertexSize + positionOffset];
+			const float* p1 = &vertices[indices[t * 3 + 1] * vertexSize + positionOffset];
+			const float* p2 = &vertices[indices[t * 3 + 2] * vertexSize + positionOffset];
+
+			const float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+			const float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+			const float n[3] = {
+				e1[1] * e2[2] - e1[2] * e2[1],
+				e1[2] * e2[0] - e1[0] * e2[2],
+				e1[0] * e2[1] - e1[1] * e2[0]
+			};
+			const float area = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+			for (uint i = 0; i < 3; ++i)
+			{
+				data[i] += area * (p0[i] + p1[i] + p2[i]) / 3.0f;
+				data[3 + i] += n[i];
+			}
+			data[6] += area;
+		}
+
+		for (uint i = 0; i < 3; ++i)
+			meshCentroid[i] += data[i];
+		meshArea += data[6];
+	}
+
+	if (meshArea <= 0.0f)
+		return;
+
+	for (uint i = 0; i < 3; ++i)
+		meshCentroid[i] /= meshArea;
+
+	std::vector<float> sortKeys(numClusters, 0.0f);
+	std::vector<uint> order(numClusters);
+
+	for (uint c = 0; c < numClusters; ++c)
+	{
+		const auto	data			= &clusterData[c * 7];
+		const float	area			= data[6] > 0.0f ? data[6] : 1.0f;
+		const float	normalLength	= sqrtf(data[3] * data[3] + data[4] * data[4] + data[5] * data[5]);
+
+		order[c] = c;
+
+		if (normalLength > 0.0f)
+			for (uint i = 0; i < 3; ++i)
+				sortKeys[c] += (data[i] / area - meshCentroid[i]) * data[3 + i] / normalLength;
+	}
+
+	std::stable_sort(order.begin(), order.end(), [&](uint a, uint b) { return sortKeys[a] > sortKeys[b]; });
+
+	std::vector<uint> output;
+
+	output.reserve(numTriangles * 3);
+	for (auto c : order)
+		output.insert(output.end(), indices.begin() + clusters[c] * 3, indices.begin() + clusters[c + 1] * 3);
+
+	indices.swap(output);
+}
+
+std::vector<uint>
+MeshOptimizer::optimizeVertexFetch(std::vector<uint>& indices, uint numVertices)
+{
+	const uint unused = std::numeric_limits<uint>::max();
+
+	std::vector<uint>	remap(numVertices, unused);
+	uint				nextVertex = 0;
+
+	for (auto& index : indices)
+	{
+		if (index >= numVertices)
+			throw std::invalid_argument("indices");
+
+		if (remap[index] == unused)
+			remap[index] = nextVertex++;
+		index = remap[index];
+	}
+
+	for (auto& newVertex : remap)
+		if (newVertex == unused)
+			newVertex = nextVertex++;
+
+	return remap;
+}
+
+std::vector<uint>
+MeshOptimizer::simplify(const std::vector<uint>&	indices,
+						const std::vector<float>&	vertices,
+						uint						vertexSize,
+						uint						positionOffset,
+						uint						targetNumIndices)
+{
+	struct Collapse
+	{
+		uint	from;
+		uint	to;
+		double	cost;
+	};
+
+	if (vertexSize == 0)
+		throw std::invalid_argument("vertexSize");
+
+	const uint			numVertices	= vertices.size() / vertexSize;
+	std::vector<uint>	result(indices.begin(), indices.begin() + (indices.size() / 3) * 3);
+
+	auto position = [&](uint v) { return &vertices[v * vertexSize + positionOffset]; };
+
+	for (auto index : result)
+		if (index >= numVertices)
+			throw std::invalid_argument("indices");
+
+	std::vector<Quadric>					quadrics(numVertices);
+	std::unordered_map<uint64_t, uint>		edgeTriangles;
+
+	for (uint i = 0; i < result.size(); i += 3)
+	{
+		float n[3];
+
+		triangleNormal(position(result[i]), position(result[i + 1]), position(result[i + 2]), n);
+
+		const float	length	= sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+		if (length > 0.0f)
+		{
+			const float*	p		= position(result[i]);
+			const double	a		= n[0] / length;
+			const double	b		= n[1] / length;
+			const double	c		= n[2] / length;
+			const double	d		= -(a * p[0] + b * p[1] + c * p[2]);
+
+			for (uint k = 0; k < 3; ++k)
+				quadrics[result[i + k]].addPlane(a, b, c, d, length * 0.5f);
+		}
+
+		for (uint k = 0; k < 3; ++k)
+			++edgeTriangles[edgeKey(result[i + k], result[i + (k + 1) % 3])];
+	}
+
+	// borders and attribute seams, where the same position is split over several vertices, stay in place
+	std::vector<bool> locked(numVertices, false);
+
+	for (auto& edge : edgeTriangles)
+		if (edge.second == 1)
+		{
+			locked[uint(edge.first >> 32)] = true;
+			locked[uint(edge.first & 0xffffffff)] = true;
+		}
+
+	std::vector<uint>		remap(numVertices);
+	std::vector<bool>		collapsed(numVertices);
+	std::vector<uint>		trianglesOffset(numVertices + 1);
+	std::vector<uint>		vertexTriangles;
+	std::vector<Collapse>	collapses;
+
+	while (result.size() > targetNumIndices)
+	{
+		collapses.clear();
+
+		// interior edges show up once in each winding, only the increasing one is kept
+		for (uint i = 0; i < result.size(); i += 3)
+			for (uint k = 0; k < 3; ++k)
+			{
+				const auto a = result[i + k];
+				const auto b = result[i + (k + 1) % 3];
+
+				if (a > b || (locked[a] && locked[b]))
+					continue;
+
+				Quadric q = quadrics[a];
+
+				q.add(quadrics[b]);
+
+				const double costAB = locked[a] ? std::numeric_limits<double>::max() : q.error(position(b));
+				const double costBA = locked[b] ? std::numeric_limits<double>::max() : q.error(position(a));
+
+				if (costAB <= costBA)
+					collapses.push_back({ a, b, costAB });
+				else
+					collapses.push_back({ b, a, costBA });
+			}
+
+		if (collapses.empty())
+			break;
+
+		std::sort(collapses.begin(), collapses.end(), [](const Collapse& x, const Collapse& y) { return x.cost < y.cost; });
+
+		std::fill(trianglesOffset.begin(), trianglesOffset.end(), 0);
+		for (auto index : result)
+			++trianglesOffset[index + 1];
+		for (uint v = 0; v < numVertices; ++v)
+			trianglesOffset[v + 1] += trianglesOffset[v];
+
+		vertexTriangles.resize(result.size());
+
+		std::vector<uint> fill(trianglesOffset.begin(), trianglesOffset.end() - 1);
+
+		for (uint i = 0; i < result.size(); ++i)
+			vertexTriangles[fill[result[i]]++] = i / 3;
+
+		for (uint v = 0; v < numVertices; ++v)
+			remap[v] = v;
+		std::fill(collapsed.begin(), collapsed.end(), false);
+
+		const uint	trianglesToRemove	= (result.size() - targetNumIndices + 2) / 3;
+		uint		removedTriangles	= 0;
+		uint		numCollapses		= 0;
+
+		for (auto& collapse : collapses)
+		{
+			if (collapsed[collapse.from] || collapsed[collapse.to])
+				continue;
+
+			// reject the collapses that flip a triangle around the moved vertex
+			bool	flips		= false;
+			uint	removed		= 0;
+
+			for (uint j = trianglesOffset[collapse.from]; j < trianglesOffset[collapse.from + 1] && !flips; ++j)
+			{
+				const auto	triangle	= &result[vertexTriangles[j] * 3];
+
+				if (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to)
+				{
+					++removed;
+					continue;
+				}
+
+				const float*	p[3];
+				const float*	q[3];
+
+				for (uint k = 0; k < 3; ++k)
+				{
+					p[k] = position(triangle[k]);
+					q[k] = triangle[k] == collapse.from ? position(collapse.to) : p[k];
+				}
+
+				float n0[3];
+				float n1[3];
+
+				triangleNormal(p[0], p[1], p[2], n0);
+				triangleNormal(q[0], q[1], q[2], n1);
+
+				flips = n0[0] * n1[0] + n0[1] * n1[1] + n0[2] * n1[2] <= 0.0f;
+			}
+
+			if (flips)
+				continue;
+
+			remap[collapse.from] = collapse.to;
+			collapsed[collapse.from] = true;
+			collapsed[collapse.to] = true;
+			quadrics[collapse.to].add(quadrics[collapse.from]);
+
+			++numCollapses;
+			removedTriangles += removed;
+			if (removedTriangles >= trianglesToRemove)
+				break;
+		}
+
+		if (numCollapses == 0)
+			break;
+
+		uint numIndices = 0;
+
+		for (uint i = 0; i < result.size(); i += 3)
+		{
+			const auto a = remap[result[i]];
+			const auto b = remap[result[i + 1]];
+			const auto c = remap[result[i + 2]];
+
+			if (a != b && b != c && a != c)
+			{
+				result[numIndices++] = a;
+				result[numIndices++] = b;
+				result[numIndices++] = c;
+			}
+		}
+
+		result.resize(numIndices);
+	}
+
+	return result;
+}
+
+void
+MeshOptimizer::remapVertices(std::vector<float>& vertices, uint vertexSize, const std::vector<uint>& remap)
+{
+	std::vector<float> output(vertices.size());
+
+	for (uint v = 0; v < remap.size(); ++v)
+		std::copy(
+			vertices.begin() + v * vertexSize,
+			vertices.begin() + (v + 1) * vertexSize,
+			output.begin() + remap[v] * vertexSize
+		);
+
+	vertices.swap(output);
+}
+
+float
+MeshOptimizer::averageCacheMissRatio(const std::vector<uint>& indices, uint numVertices, uint cacheSize)
+{
+	const uint numTriangles = indices.size() / 3;
+
+	if (numTriangles == 0)
+		return 0.0f;
+
+	std::vector<uint>	timestamps(numVertices, 0);
+	uint				time	= cacheSize + 1;
+	uint				misses	= 0;
+
+	for (auto v : indices)
+		if (time - timestamps[v] > cacheSize)
+		{
+			timestamps[v] = time++;
+			++misses;
+		}
+
+	return float(misses) / float(numTriangles);
+}
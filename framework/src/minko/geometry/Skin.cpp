@@ -33,7 +33,10 @@ Skin::Skin(unsigned int numBones, unsigned int duration, unsigned int numFrames)
 	_numBones(numBones),
 	_duration(duration),
 	_timeFactor(duration > 0 ? numFrames / float(duration) : 0.0f),
+	_numFrames(numFrames),
 	_boneMatricesPerFrame(numFrames, std::vector<float>(numBones << 4, 0.0f)),
+	_tracks(),
+	_cachedMatrices(),
 	_maxNumVertexBones(0),
 	_numVertexBones(),
 	_vertexBones(),
@@ -79,13 +82,13 @@ Skin::reorganizeByVertices()
 	{
 		auto bone = _bones[boneId];
 
-		const std::vector<unsigned short>&	vertexIds		= bone->vertexIds();
+		const std::vector<uint>&				vertexIds		= bone->vertexIds();
 		const std::vector<float>&			vertexWeights	= bone->vertexWeights();
 
 		for (unsigned int i = 0; i < vertexIds.size(); ++i)
 			if (vertexWeights[i] > 0.0f)
 			{
-				const unsigned short	vId		= vertexIds[i];
+				const uint				vId		= vertexIds[i];
 #ifdef DEBUG_SKINNING
 				assert(vId < numVertices);
 #endif // DEBUG_SKINNING
@@ -108,14 +111,14 @@ Skin::reorganizeByVertices()
 	return shared_from_this();
 }
 
-unsigned short
+uint
 Skin::lastVertexId() const
 {
-	unsigned short lastId = 0;
+	uint lastId = 0;
 
 	for (unsigned int boneId = 0; boneId < _bones.size(); ++boneId)
 	{
-		const std::vector<unsigned short>& vertexId = _bones[boneId]->vertexIds();
+		const std::vector<uint>& vertexId = _bones[boneId]->vertexIds();
 
 		for (unsigned int i = 0; i < vertexId.size(); ++i)
 			lastId = std::max(lastId, vertexId[i]);
@@ -168,6 +171,9 @@ Skin::disposeBones()
 Skin::Ptr
 Skin::transposeMatrices()
 {	
+	if (compressed())
+		throw std::logic_error("The matrices of a compressed skin cannot be transposed.");
+
 	for (auto& frameMatrices : _boneMatricesPerFrame)
 	{
 		assert(frameMatrices.size() % 16 == 0);
@@ -186,4 +192,282 @@ Skin::transposeMatrices()
 		}
 	}
 	return shared_from_this();
-}
\ No newline at end of file
+}
+Skin::Ptr
+Skin::compressMatrices(float tolerance)
+{
+	// frame ids are stored on 16 bits
+	if (compressed() || _numFrames < 2 || _numFrames > 0xffff)
+		return shared_from_this();
+
+	std::vector<float> translations(_numFrames * 3);
+	std::vector<float> rotations(_numFrames * 4);
+	std::vector<float> scales(_numFrames * 3);
+
+	_tracks.resize(_numBones * 3);
+
+	for (unsigned int boneId = 0; boneId < _numBones; ++boneId)
+	{
+		for (unsigned int frameId = 0; frameId < _numFrames; ++frameId)
+		{
+			const float*	m	= &_boneMatricesPerFrame[frameId][boneId << 4];
+			float*			t	= &translations[frameId * 3];
+			float*			q	= &rotations[frameId << 2];
+			float*			s	= &scales[frameId * 3];
+
+			s[0] = sqrtf(m[0] * m[0] + m[1] * m[1] + m[2] * m[2]);
+			s[1] = sqrtf(m[4] * m[4] + m[5] * m[5] + m[6] * m[6]);
+			s[2] = sqrtf(m[8] * m[8] + m[9] * m[9] + m[10] * m[10]);
+
+			const float det = m[0] * (m[5] * m[10] - m[6] * m[9])
+				- m[4] * (m[1] * m[10] - m[2] * m[9])
+				+ m[8] * (m[1] * m[6] - m[2] * m[5]);
+
+			if (det < 0.0f)
+				s[0] = -s[0];
+
+			const float r00 = s[0] != 0.0f ? m[0] / s[0] : 1.0f;
+			const float r10 = s[0] != 0.0f ? m[1] / s[0] : 0.0f;
+			const float r20 = s[0] != 0.0f ? m[2] / s[0] : 0.0f;
+			const float r01 = s[1] != 0.0f ? m[4] / s[1] : 0.0f;
+			const float r11 = s[1] != 0.0f ? m[5] / s[1] : 1.0f;
+			const float r21 = s[1] != 0.0f ? m[6] / s[1] : 0.0f;
+			const float r02 = s[2] != 0.0f ? m[8] / s[2] : 0.0f;
+			const float r12 = s[2] != 0.0f ? m[9] / s[2] : 0.0f;
+			const float r22 = s[2] != 0.0f ? m[10] / s[2] : 1.0f;
+			const float trace = r00 + r11 + r22;
+
+			if (trace > 0.0f)
+			{
+				const float k = 0.5f / sqrtf(trace + 1.0f);
+
+				q[0] = (r21 - r12) * k;
+				q[1] = (r02 - r20) * k;
+				q[2] = (r10 - r01) * k;
+				q[3] = 0.25f / k;
+			}
+			else if (r00 > r11 && r00 > r22)
+			{
+				const float k = 2.0f * sqrtf(std::max(0.0f, 1.0f + r00 - r11 - r22));
+
+				q[0] = 0.25f * k;
+				q[1] = (r01 + r10) / k;
+				q[2] = (r02 + r20) / k;
+				q[3] = (r21 - r12) / k;
+			}
+			else if (r11 > r22)
+			{
+				const float k = 2.0f * sqrtf(std::max(0.0f, 1.0f + r11 - r00 - r22));
+
+				q[0] = (r01 + r10) / k;
+				q[1] = 0.25f * k;
+				q[2] = (r12 + r21) / k;
+				q[3] = (r02 - r20) / k;
+			}
+			else
+			{
+				const float k = 2.0f * sqrtf(std::max(0.0f, 1.0f + r22 - r00 - r11));
+
+				q[0] = (r02 + r20) / k;
+				q[1] = (r12 + r21) / k;
+				q[2] = 0.25f * k;
+				q[3] = (r10 - r01) / k;
+			}
+
+			// consecutive rotations stay in the same hemisphere to interpolate along the shortest path
+			if (frameId > 0 && q[0] * q[-4] + q[1] * q[-3] + q[2] * q[-2] + q[3] * q[-1] < 0.0f)
+				for (unsigned int i = 0; i < 4; ++i)
+					q[i] = -q[i];
+
+			t[0] = m[12];
+			t[1] = m[13];
+			t[2] = m[14];
+		}
+
+		compressTrack(translations, 3, tolerance, _tracks[boneId * 3]);
+		compressTrack(rotations, 4, tolerance, _tracks[boneId * 3 + 1]);
+		compressTrack(scales, 3, tolerance, _tracks[boneId * 3 + 2]);
+	}
+
+	_boneMatricesPerFrame.clear();
+	_boneMatricesPerFrame.shrink_to_fit();
+	_cachedMatrices.clear();
+
+	return shared_from_this();
+}
+
+uint
+Skin::memorySize() const
+{
+	uint size = (_numVertexBones.size() + _vertexBones.size() + _vertexBoneWeights.size()) * 4;
+
+	for (const auto& frameMatrices : _boneMatricesPerFrame)
+		size += frameMatrices.size() * sizeof(float);
+	for (const auto& track : _tracks)
+		size += (track.frames.size() + track.values.size()) * sizeof(unsigned short)
+			+ (track.min.size() + track.step.size()) * sizeof(float);
+
+	return size;
+}
+
+void
+Skin::compressTrack(const std::vector<float>&	values,
+					unsigned int				numComponents,
+					float						tolerance,
+					Track&						track)
+{
+	const unsigned int			numFrames = values.size() / numComponents;
+	std::vector<unsigned int>	keys(1, 0);
+
+	// a frame becomes a key when the interpolation between the previous key and the next frame drifts too much
+	for (unsigned int start = 0, end = 2; end < numFrames; ++end)
+	{
+		bool keep = false;
+
+		for (unsigned int frameId = start + 1; frameId < end && !keep; ++frameId)
+		{
+			const float ratio = (frameId - start) / float(end - start);
+
+			for (unsigned int i = 0; i < numComponents && !keep; ++i)
+			{
+				const float a = values[start * numComponents + i];
+				const float b = values[end * numComponents + i];
+
+				keep = fabsf(a + (b - a) * ratio - values[frameId * numComponents + i]) > tolerance;
+			}
+		}
+
+		if (keep)
+		{
+			start = end - 1;
+			keys.push_back(start);
+		}
+	}
+	if (numFrames > 1)
+		keys.push_back(numFrames - 1);
+
+	track.min.assign(numComponents, std::numeric_limits<float>::max());
+	track.step.assign(numComponents, 0.0f);
+
+	std::vector<float> max(numComponents, -std::numeric_limits<float>::max());
+
+	for (auto key : keys)
+		for (unsigned int i = 0; i < numComponents; ++i)
+		{
+			track.min[i] = std::min(track.min[i], values[key * numComponents + i]);
+			max[i] = std::max(max[i], values[key * numComponents + i]);
+		}
+
+	for (unsigned int i = 0; i < numComponents; ++i)
+		track.step[i] = (max[i] - track.min[i]) / 65535.0f;
+
+	track.frames.resize(keys.size());
+	track.values.resize(keys.size() * numComponents);
+
+	for (unsigned int keyId = 0; keyId < keys.size(); ++keyId)
+	{
+		track.frames[keyId] = static_cast<unsigned short>(keys[keyId]);
+
+		for (unsigned int i = 0; i < numComponents; ++i)
+			track.values[keyId * numComponents + i] = track.step[i] > 0.0f
+				? static_cast<unsigned short>((values[keys[keyId] * numComponents + i] - track.min[i]) / track.step[i] + 0.5f)
+				: 0;
+	}
+}
+
+void
+Skin::interpolateTrack(const Track& track, float frame, unsigned int numComponents, float* output)
+{
+	auto			next	= std::upper_bound(track.frames.begin(), track.frames.end(), frame);
+	unsigned int	keyB	= std::min<unsigned int>(next - track.frames.begin(), track.frames.size() - 1);
+	unsigned int	keyA	= keyB > 0 ? keyB - 1 : 0;
+	const float		length	= float(track.frames[keyB] - track.frames[keyA]);
+	const float		ratio	= length > 0.0f ? std::min(1.0f, (frame - track.frames[keyA]) / length) : 0.0f;
+
+	for (unsigned int i = 0; i < numComponents; ++i)
+	{
+		const float a = track.values[keyA * numComponents + i];
+		const float b = track.values[keyB * numComponents + i];
+
+		output[i] = track.min[i] + (a + (b - a) * ratio) * track.step[i];
+	}
+}
+
+void
+Skin::interpolateMatrices(uint time, std::vector<float>& output) const
+{
+	output.resize(_numBones << 4);
+
+	if (!compressed())
+	{
+		const auto& frameMatrices = _boneMatricesPerFrame[getFrameId(time)];
+
+		std::copy(frameMatrices.begin(), frameMatrices.end(), output.begin());
+
+		return;
+	}
+
+	// instances playing this skin in sync are only evaluated once
+	auto cached = std::find_if(_cachedMatrices.begin(), _cachedMatrices.end(), [&](const CachedMatrices& c)
+	{
+		return c.first == time;
+	});
+
+	if (cached != _cachedMatrices.end())
+		_cachedMatrices.splice(_cachedMatrices.begin(), _cachedMatrices, cached);
+	else
+	{
+		if (_cachedMatrices.size() < NUM_CACHED_MATRICES)
+			_cachedMatrices.push_front(CachedMatrices(time, std::vector<float>(_numBones << 4)));
+		else
+			_cachedMatrices.splice(_cachedMatrices.begin(), _cachedMatrices, std::prev(_cachedMatrices.end()));
+
+		_cachedMatrices.front().first = time;
+		evaluateMatrices(time, &_cachedMatrices.front().second[0]);
+	}
+
+	const auto& matrices = _cachedMatrices.front().second;
+
+	std::copy(matrices.begin(), matrices.end(), output.begin());
+}
+
+void
+Skin::evaluateMatrices(uint time, float* output) const
+{
+	// the frames were sampled from 0 to the duration included
+	const float frame = _duration > 0
+		? std::min(float(_numFrames - 1), time * (_numFrames - 1) / float(_duration))
+		: 0.0f;
+
+	for (unsigned int boneId = 0; boneId < _numBones; ++boneId)
+	{
+		float	t[3];
+		float	q[4];
+		float	s[3];
+		float*	m = output + (boneId << 4);
+
+		interpolateTrack(_tracks[boneId * 3], frame, 3, t);
+		interpolateTrack(_tracks[boneId * 3 + 1], frame, 4, q);
+		interpolateTrack(_tracks[boneId * 3 + 2], frame, 3, s);
+
+		const float length = sqrtf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+		const float x = q[0] / length, y = q[1] / length, z = q[2] / length, w = q[3] / length;
+
+		m[0]	= (1.0f - 2.0f * (y * y + z * z)) * s[0];
+		m[1]	= 2.0f * (x * y + w * z) * s[0];
+		m[2]	= 2.0f * (x * z - w * y) * s[0];
+		m[3]	= 0.0f;
+		m[4]	= 2.0f * (x * y - w * z) * s[1];
+		m[5]	= (1.0f - 2.0f * (x * x + z * z)) * s[1];
+		m[6]	= 2.0f * (y * z + w * x) * s[1];
+		m[7]	= 0.0f;
+		m[8]	= 2.0f * (x * z + w * y) * s[2];
+		m[9]	= 2.0f * (y * z - w * x) * s[2];
+		m[10]	= (1.0f - 2.0f * (x * x + y * y)) * s[2];
+		m[11]	= 0.0f;
+		m[12]	= t[0];
+		m[13]	= t[1];
+		m[14]	= t[2];
+		m[15]	= 1.0f;
+	}
+}
@@ -97,7 +97,7 @@ SphereGeometry::initializeVertices(std::shared_ptr<AbstractContext>	context,
 		data.push_back(0.f);
 	}
 
-	auto stream = VertexBuffer::create(context, data);
+	auto stream = VertexBuffer::create(context, std::move(data));
 
 	stream->addAttribute("position", 3, 0);
 	stream->addAttribute("uv", 2, 3);
@@ -143,5 +143,5 @@ SphereGeometry::initializeIndices(std::shared_ptr<AbstractContext>	context,
 		data[c++] = (numParallels - 3) * numMeridians + i;
 	}
 
-	indices(IndexBuffer::create(context, data));
+	indices(IndexBuffer::create(context, std::move(data)));
 }
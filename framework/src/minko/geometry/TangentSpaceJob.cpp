@@ -0,0 +1,146 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/geometry/TangentSpaceJob.hpp"
+
+#include "minko/geometry/Geometry.hpp"
+#include "minko/render/VertexBuffer.hpp"
+#include "minko/render/IndexBuffer.hpp"
+
+using namespace minko;
+using namespace minko::geometry;
+using namespace minko::render;
+
+TangentSpaceJob::TangentSpaceJob(GeometryPtr geometry, bool computeNormals, bool computeTangents) :
+	_geometry(geometry),
+	_computeNormals(computeNormals),
+	_computeTangents(computeTangents),
+	_done(false),
+	_finished(Signal<Ptr, GeometryPtr>::create())
+{
+	if (!geometry)
+		throw std::invalid_argument("geometry");
+
+	if (!geometry->hasVertexAttribute("position") || !geometry->indices())
+		throw std::logic_error("Computation of tangent space requires positions and indices.");
+
+	if (computeNormals && geometry->hasVertexAttribute("normal"))
+		throw std::logic_error("The geometry already stores precomputed normals.");
+
+	if (computeTangents && !geometry->hasVertexAttribute("uv"))
+		throw std::logic_error("Computation of tangent space requires positions and uv.");
+}
+
+bool
+TangentSpaceJob::complete()
+{
+	if (!_done && _result.valid())
+		_done = _result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+
+	return _done;
+}
+
+void
+TangentSpaceJob::beforeFirstStep()
+{
+	auto xyzBuffer	= _geometry->vertexBuffer("position");
+	auto uvBuffer	= _computeTangents ? _geometry->vertexBuffer("uv") : nullptr;
+
+	// the workers get their own copies, the geometry can keep changing meanwhile
+	auto xyzData	= xyzBuffer->data();
+	auto xyzSize	= xyzBuffer->vertexSize();
+	auto xyzOffset	= std::get<2>(*xyzBuffer->attribute("position"));
+	auto uvData		= uvBuffer ? uvBuffer->data() : std::vector<float>();
+	auto uvSize		= uvBuffer ? uvBuffer->vertexSize() : 0;
+	auto uvOffset	= uvBuffer ? std::get<2>(*uvBuffer->attribute("uv")) : 0;
+	auto indices	= _geometry->indices()->data();
+
+	_done = false;
+
+#if defined(MINKO_NO_THREADS)
+	compute(xyzData, xyzSize, xyzOffset, uvData, uvSize, uvOffset, indices);
+	_done = true;
+#else
+	_result = std::async(
+		std::launch::async,
+		&TangentSpaceJob::compute,
+		this,
+		std::move(xyzData), xyzSize, xyzOffset,
+		std::move(uvData), uvSize, uvOffset,
+		std::move(indices)
+	);
+#endif
+}
+
+void
+TangentSpaceJob::step()
+{
+}
+
+float
+TangentSpaceJob::priority()
+{
+	return 1.f;
+}
+
+void
+TangentSpaceJob::afterLastStep()
+{
+	if (_result.valid())
+		_result.get();
+
+	auto context = _geometry->vertexBuffer("position")->context();
+
+	if (_computeNormals && !_geometry->hasVertexAttribute("normal"))
+	{
+		auto normalsBuffer = VertexBuffer::create(context, _normals);
+
+		normalsBuffer->addAttribute("normal", 3, 0);
+		_geometry->addVertexBuffer(normalsBuffer);
+	}
+
+	if (_computeTangents && !_geometry->hasVertexAttribute("tangent"))
+	{
+		auto tangentsBuffer = VertexBuffer::create(context, _tangents);
+
+		tangentsBuffer->addAttribute("tangent", 3, 0);
+		_geometry->addVertexBuffer(tangentsBuffer);
+	}
+
+	_normals.clear();
+	_tangents.clear();
+
+	_finished->execute(shared_from_this(), _geometry);
+}
+
+void
+TangentSpaceJob::compute(std::vector<float>	xyzData,
+						 uint				xyzSize,
+						 uint				xyzOffset,
+						 std::vector<float>	uvData,
+						 uint				uvSize,
+						 uint				uvOffset,
+						 std::vector<uint>	indices)
+{
+	if (_computeNormals)
+		Geometry::computeNormals(xyzData, xyzSize, xyzOffset, indices, _normals);
+
+	if (_computeTangents)
+		Geometry::computeTangents(xyzData, xyzSize, xyzOffset, uvData, uvSize, uvOffset, indices, _tangents);
+}
@@ -173,7 +173,7 @@ TeapotGeometry::TeapotGeometry()
 void
 TeapotGeometry::initialize(std::shared_ptr<render::AbstractContext> context, const uint divs)
 {
-	std::vector<unsigned short> indicesData;
+	std::vector<uint> indicesData;
 	std::vector<std::vector<float>> vertices(1, std::vector<float>());
 	std::vector<std::vector<float>> patch(16, std::vector<float>(16, 0.f));
 	uint currentVertexId = 0;
@@ -256,7 +256,7 @@ TeapotGeometry::bernstein(float					u,
 }
 
 void
-TeapotGeometry::genPatchIndices(const uint offset, const uint divs, std::vector<unsigned short>& indices)
+TeapotGeometry::genPatchIndices(const uint offset, const uint divs, std::vector<uint>& indices)
 {
 	for (uint u = 0; u < divs; ++u)
 	{
@@ -0,0 +1,387 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/geometry/TriangleBVH.hpp"
+
+#include "../math/SIMD.hpp"
+
+using namespace minko;
+using namespace minko::geometry;
+
+static const float	EPSILON			= 0.00001f;
+static const uint	MAX_STACK_SIZE	= 64;
+
+static inline
+bool
+intersectBox(const float* min, const float* max, const float* origin, const float* invDirection, float maxDistance, float& distance)
+{
+	float tMin = 0.f;
+	float tMax = maxDistance;
+
+	for (uint i = 0; i < 3; ++i)
+	{
+		float t0 = (min[i] - origin[i]) * invDirection[i];
+		float t1 = (max[i] - origin[i]) * invDirection[i];
+
+		if (t0 > t1)
+			std::swap(t0, t1);
+
+		tMin = t0 > tMin ? t0 : tMin;
+		tMax = t1 < tMax ? t1 : tMax;
+
+		if (tMin > tMax)
+			return false;
+	}
+
+	distance = tMin;
+
+	return true;
+}
+
+TriangleBVH::TriangleBVH() :
+	_numTriangles(0)
+{
+}
+
+void
+TriangleBVH::build(const std::vector<float>&	vertices,
+				   uint							vertexSize,
+				   uint							positionOffset,
+				   const std::vector<uint>&		indices)
+{
+	if (vertexSize < positionOffset + 3)
+		throw std::invalid_argument("vertexSize");
+
+	const uint numVertices = vertices.size() / vertexSize;
+
+	_numTriangles = indices.size() / 3;
+	_nodes.clear();
+	_packets.clear();
+
+	if (_numTriangles == 0)
+		return;
+
+	std::vector<float>	bounds(_numTriangles * 6);
+	std::vector<float>	centroids(_numTriangles * 3);
+	std::vector<float>	edges(_numTriangles * 9);
+	std::vector<uint>	triangles(_numTriangles);
+
+	for (uint i = 0; i < _numTriangles; ++i)
+	{
+		if (indices[i * 3] >= numVertices || indices[i * 3 + 1] >= numVertices || indices[i * 3 + 2] >= numVertices)
+			throw std::invalid_argument("indices");
+
+		const float* p0 = &vertices[indices[i * 3] * vertexSize + positionOffset];
+		const float* p1 = &vertices[indices[i * 3 + 1] * vertexSize + positionOffset];
+		const float* p2 = &vertices[indices[i * 3 + 2] * vertexSize + positionOffset];
+
+		for (uint j = 0; j < 3; ++j)
+		{
+			bounds[i * 6 + j]		= std::min(p0[j], std::min(p1[j], p2[j]));
+			bounds[i * 6 + 3 + j]	= std::max(p0[j], std::max(p1[j], p2[j]));
+			centroids[i * 3 + j]	= (p0[j] + p1[j] + p2[j]) / 3.f;
+			edges[i * 9 + j]		= p0[j];
+			edges[i * 9 + 3 + j]	= p1[j] - p0[j];
+			edges[i * 9 + 6 + j]	= p2[j] - p0[j];
+		}
+
+		triangles[i] = i;
+	}
+
+	_nodes.reserve(2 * (_numTriangles / PACKET_SIZE + 1));
+	_packets.reserve(_numTriangles / PACKET_SIZE + 1);
+
+	buildNode(bounds, centroids, edges, triangles, 0, _numTriangles);
+}
+
+void
+TriangleBVH::buildNode(const std::vector<float>&	bounds,
+					   const std::vector<float>&	centroids,
+					   const std::vector<float>&	edges,
+					   std::vector<uint>&			triangles,
+					   uint							begin,
+					   uint							end)
+{
+	const uint	nodeId			= _nodes.size();
+	float		min[3]			= { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+	float		max[3]			= { -min[0], -min[1], -min[2] };
+	float		centroidsMin[3]	= { min[0], min[1], min[2] };
+	float		centroidsMax[3]	= { max[0], max[1], max[2] };
+
+	_nodes.push_back(Node());
+
+	for (uint i = begin; i < end; ++i)
+		for (uint j = 0; j < 3; ++j)
+		{
+			min[j] = std::min(min[j], bounds[triangles[i] * 6 + j]);
+			max[j] = std::max(max[j], bounds[triangles[i] * 6 + 3 + j]);
+			centroidsMin[j] = std::min(centroidsMin[j], centroids[triangles[i] * 3 + j]);
+			centroidsMax[j] = std::max(centroidsMax[j], centroids[triangles[i] * 3 + j]);
+		}
+
+	std::copy(min, min + 3, _nodes[nodeId].min);
+	std::copy(max, max + 3, _nodes[nodeId].max);
+
+	if (end - begin <= PACKET_SIZE)
+	{
+		Packet packet;
+
+		// unused lanes are degenerate triangles that never hit
+		std::memset(&packet, 0, sizeof(Packet));
+
+		for (uint i = begin; i < end; ++i)
+		{
+			const uint lane = i - begin;
+			const float* triangleEdges = &edges[triangles[i] * 9];
+
+			for (uint j = 0; j < 3; ++j)
+			{
+				packet.v0[j][lane] = triangleEdges[j];
+				packet.e1[j][lane] = triangleEdges[3 + j];
+				packet.e2[j][lane] = triangleEdges[6 + j];
+			}
+			packet.triangle[lane] = triangles[i] * 3;
+		}
+
+		_nodes[nodeId].leaf = true;
+		_nodes[nodeId].offset = _packets.size();
+		_packets.push_back(packet);
+
+		return;
+	}
+
+	// median split along the largest extent of the centroids
+	uint axis = 0;
+
+	for (uint j = 1; j < 3; ++j)
+		if (centroidsMax[j] - centroidsMin[j] > centroidsMax[axis] - centroidsMin[axis])
+			axis = j;
+
+	const uint middle = (begin + end) / 2;
+
+	std::nth_element(
+		triangles.begin() + begin,
+		triangles.begin() + middle,
+		triangles.begin() + end,
+		[&](uint a, uint b) { return centroids[a * 3 + axis] < centroids[b * 3 + axis]; }
+	);
+
+	_nodes[nodeId].leaf = false;
+	buildNode(bounds, centroids, edges, triangles, begin, middle);
+	_nodes[nodeId].offset = _nodes.size();
+	buildNode(bounds, centroids, edges, triangles, middle, end);
+}
+
+void
+TriangleBVH::intersectPacket(const Packet&	packet,
+							 const float*	origin,
+							 const float*	direction,
+							 float&			distance,
+							 int&			lane,
+							 float&			u,
+							 float&			v) const
+{
+	float	t[PACKET_SIZE];
+	float	us[PACKET_SIZE];
+	float	vs[PACKET_SIZE];
+	uint	hits = 0;
+
+#if defined(MINKO_SIMD_SSE)
+	const __m128 dx		= _mm_set1_ps(direction[0]);
+	const __m128 dy		= _mm_set1_ps(direction[1]);
+	const __m128 dz		= _mm_set1_ps(direction[2]);
+	const __m128 e1x	= _mm_loadu_ps(packet.e1[0]);
+	const __m128 e1y	= _mm_loadu_ps(packet.e1[1]);
+	const __m128 e1z	= _mm_loadu_ps(packet.e1[2]);
+	const __m128 e2x	= _mm_loadu_ps(packet.e2[0]);
+	const __m128 e2y	= _mm_loadu_ps(packet.e2[1]);
+	const __m128 e2z	= _mm_loadu_ps(packet.e2[2]);
+
+	const __m128 px		= _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+	const __m128 py		= _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+	const __m128 pz		= _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+	const __m128 det	= _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+	const __m128 invDet	= _mm_div_ps(_mm_set1_ps(1.f), det);
+
+	const __m128 tx		= _mm_sub_ps(_mm_set1_ps(origin[0]), _mm_loadu_ps(packet.v0[0]));
+	const __m128 ty		= _mm_sub_ps(_mm_set1_ps(origin[1]), _mm_loadu_ps(packet.v0[1]));
+	const __m128 tz		= _mm_sub_ps(_mm_set1_ps(origin[2]), _mm_loadu_ps(packet.v0[2]));
+	const __m128 lu		= _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, px), _mm_mul_ps(ty, py)), _mm_mul_ps(tz, pz)), invDet);
+
+	const __m128 qx		= _mm_sub_ps(_mm_mul_ps(ty, e1z), _mm_mul_ps(tz, e1y));
+	const __m128 qy		= _mm_sub_ps(_mm_mul_ps(tz, e1x), _mm_mul_ps(tx, e1z));
+	const __m128 qz		= _mm_sub_ps(_mm_mul_ps(tx, e1y), _mm_mul_ps(ty, e1x));
+	const __m128 lv		= _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)), invDet);
+	const __m128 lt		= _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), invDet);
+
+	const __m128 zero	= _mm_setzero_ps();
+	__m128 mask			= _mm_cmpgt_ps(_mm_andnot_ps(_mm_set1_ps(-0.f), det), _mm_set1_ps(EPSILON));
+
+	mask = _mm_and_ps(mask, _mm_cmpge_ps(lu, zero));
+	mask = _mm_and_ps(mask, _mm_cmpge_ps(lv, zero));
+	mask = _mm_and_ps(mask, _mm_cmple_ps(_mm_add_ps(lu, lv), _mm_set1_ps(1.f)));
+	mask = _mm_and_ps(mask, _mm_cmpgt_ps(lt, zero));
+	mask = _mm_and_ps(mask, _mm_cmplt_ps(lt, _mm_set1_ps(distance)));
+
+	hits = _mm_movemask_ps(mask);
+	if (hits == 0)
+		return;
+
+	_mm_storeu_ps(t, lt);
+	_mm_storeu_ps(us, lu);
+	_mm_storeu_ps(vs, lv);
+#else
+	for (uint i = 0; i < PACKET_SIZE; ++i)
+	{
+		const float px	= direction[1] * packet.e2[2][i] - direction[2] * packet.e2[1][i];
+		const float py	= direction[2] * packet.e2[0][i] - direction[0] * packet.e2[2][i];
+		const float pz	= direction[0] * packet.e2[1][i] - direction[1] * packet.e2[0][i];
+		const float det	= packet.e1[0][i] * px + packet.e1[1][i] * py + packet.e1[2][i] * pz;
+
+		if (det > -EPSILON && det < EPSILON)
+			continue;
+
+		const float invDet	= 1.f / det;
+		const float tx		= origin[0] - packet.v0[0][i];
+		const float ty		= origin[1] - packet.v0[1][i];
+		const float tz		= origin[2] - packet.v0[2][i];
+
+		us[i] = (tx * px + ty * py + tz * pz) * invDet;
+		if (us[i] < 0.f || us[i] > 1.f)
+			continue;
+
+		const float qx = ty * packet.e1[2][i] - tz * packet.e1[1][i];
+		const float qy = tz * packet.e1[0][i] - tx * packet.e1[2][i];
+		const float qz = tx * packet.e1[1][i] - ty * packet.e1[0][i];
+
+		vs[i] = (direction[0] * qx + direction[1] * qy + direction[2] * qz) * invDet;
+		if (vs[i] < 0.f || us[i] + vs[i] > 1.f)
+			continue;
+
+		t[i] = (packet.e2[0][i] * qx + packet.e2[1][i] * qy + packet.e2[2][i] * qz) * invDet;
+		if (t[i] > 0.f && t[i] < distance)
+			hits |= 1u << i;
+	}
+#endif
+
+	for (uint i = 0; i < PACKET_SIZE; ++i)
+		if ((hits & (1u << i)) && t[i] < distance)
+		{
+			distance = t[i];
+			lane = i;
+			u = us[i];
+			v = vs[i];
+		}
+}
+
+bool
+TriangleBVH::cast(const float*	origin,
+				  const float*	direction,
+				  float&		distance,
+				  uint&			triangle,
+				  float&		u,
+				  float&		v) const
+{
+	if (_nodes.empty())
+		return false;
+
+	const float invDirection[3] = { 1.f / direction[0], 1.f / direction[1], 1.f / direction[2] };
+	uint		stack[MAX_STACK_SIZE];
+	uint		stackSize	= 0;
+	float		closest		= std::numeric_limits<float>::max();
+	bool		hit			= false;
+	float		boxDistance	= 0.f;
+
+	if (!intersectBox(_nodes[0].min, _nodes[0].max, origin, invDirection, closest, boxDistance))
+		return false;
+
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		const auto& node = _nodes[stack[--stackSize]];
+
+		if (node.leaf)
+		{
+			const auto& packet	= _packets[node.offset];
+			int			lane	= -1;
+
+			intersectPacket(packet, origin, direction, closest, lane, u, v);
+			if (lane >= 0)
+			{
+				triangle = packet.triangle[lane];
+				hit = true;
+			}
+
+			continue;
+		}
+
+		const uint	first			= &node - &_nodes[0] + 1;
+		const uint	second			= node.offset;
+		float		firstDistance	= 0.f;
+		float		secondDistance	= 0.f;
+		const bool	hitFirst		= intersectBox(_nodes[first].min, _nodes[first].max, origin, invDirection, closest, firstDistance);
+		const bool	hitSecond		= intersectBox(_nodes[second].min, _nodes[second].max, origin, invDirection, closest, secondDistance);
+
+		// the nearest child is popped first so that it shrinks the search distance
+		if (hitFirst && hitSecond)
+		{
+			stack[stackSize++] = firstDistance < secondDistance ? second : first;
+			stack[stackSize++] = firstDistance < secondDistance ? first : second;
+		}
+		else if (hitFirst)
+			stack[stackSize++] = first;
+		else if (hitSecond)
+			stack[stackSize++] = second;
+	}
+
+	if (hit)
+		distance = closest;
+
+	return hit;
+}
+
+uint
+TriangleBVH::cast(uint			numRays,
+				  const float*	origins,
+				  const float*	directions,
+				  float*		distances,
+				  int*			triangles) const
+{
+	uint	numHits		= 0;
+	uint	triangle	= 0;
+	float	u			= 0.f;
+	float	v			= 0.f;
+
+	for (uint i = 0; i < numRays; ++i)
+	{
+		if (cast(origins + i * 3, directions + i * 3, distances[i], triangle, u, v))
+		{
+			triangles[i] = triangle;
+			++numHits;
+		}
+		else
+		{
+			distances[i] = -1.f;
+			triangles[i] = -1;
+		}
+	}
+
+	return numHits;
+}
@@ -28,6 +28,40 @@ Joystick::Joystick(std::shared_ptr<AbstractCanvas> canvas, int joystickId) :
 	_joystickHatMotion(Signal<Ptr, int, int, int>::create()),
 	_joystickButtonUp(Signal<Ptr, int, int>::create()),
 	_joystickButtonDown(Signal<Ptr, int, int>::create()),
-	_joystickId(joystickId)
+	_joystickId(joystickId),
+	_coalesceAxisMotion(true),
+	_pendingAxisMotion()
 {
+}
+
+void
+Joystick::coalesceAxisMotion(bool value)
+{
+	if (!value)
+		flushAxisMotion();
+
+	_coalesceAxisMotion = value;
+}
+
+void
+Joystick::axisMotion(int axis, int value)
+{
+	if (_coalesceAxisMotion)
+		_pendingAxisMotion[axis] = value;
+	else
+		_joystickAxisMotion->execute(shared_from_this(), _joystickId, axis, value);
+}
+
+void
+Joystick::flushAxisMotion()
+{
+	if (_pendingAxisMotion.empty())
+		return;
+
+	std::map<int, int> axisMotion;
+
+	axisMotion.swap(_pendingAxisMotion);
+
+	for (auto& axisAndValue : axisMotion)
+		_joystickAxisMotion->execute(shared_from_this(), _joystickId, axisAndValue.first, axisAndValue.second);
 }
\ No newline at end of file
@@ -34,7 +34,14 @@ Mouse::Mouse(std::shared_ptr<AbstractCanvas> canvas) :
 	_mouseRightButtonDown(Signal<Ptr>::create()),
 	_mouseRightButtonUp(Signal<Ptr>::create()),
 	_mouseMiddleButtonDown(Signal<Ptr>::create()),
-	_mouseMiddleButtonUp(Signal<Ptr>::create())
+	_mouseMiddleButtonUp(Signal<Ptr>::create()),
+	_coalesceMoves(true),
+	_movePending(false),
+	_pendingDx(0),
+	_pendingDy(0),
+	_recordHistory(false),
+	_history(),
+	_pendingHistory()
 {
 	_slots.push_front(_mouseLeftButtonDown->connect([&](Ptr mouse)
 	{
@@ -54,3 +61,61 @@ Mouse::Mouse(std::shared_ptr<AbstractCanvas> canvas) :
 		_rightButtonIsDown = false;
 	}));
 }
+
+void
+Mouse::coalesceMoves(bool value)
+{
+	if (!value)
+		flushMove();
+
+	_coalesceMoves = value;
+}
+
+void
+Mouse::motion(int x, int y, uint time)
+{
+	const int dx = x - int(_x);
+	const int dy = y - int(_y);
+
+	_x = x;
+	_y = y;
+
+	if (_recordHistory)
+		_pendingHistory.push_back({ x, y, time });
+
+	if (!_coalesceMoves)
+	{
+		_mouseMove->execute(shared_from_this(), dx, dy);
+
+		return;
+	}
+
+	_movePending = true;
+	_pendingDx += dx;
+	_pendingDy += dy;
+}
+
+void
+Mouse::flushMove()
+{
+	if (!_movePending)
+		return;
+
+	const int dx = _pendingDx;
+	const int dy = _pendingDy;
+
+	_movePending = false;
+	_pendingDx = 0;
+	_pendingDy = 0;
+
+	_mouseMove->execute(shared_from_this(), dx, dy);
+}
+
+void
+Mouse::nextFrame()
+{
+	_history.swap(_pendingHistory);
+	_pendingHistory.clear();
+
+	flushMove();
+}
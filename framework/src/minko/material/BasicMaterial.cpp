@@ -24,6 +24,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/render/AbstractTexture.hpp"
 #include "minko/render/Texture.hpp"
 #include "minko/render/CubeTexture.hpp"
+#include "minko/render/TextureAtlas.hpp"
 #include "minko/render/Priority.hpp"
 #include "minko/render/States.hpp"
 
@@ -72,6 +73,8 @@ BasicMaterial::diffuseMap(render::AbstractTexture::Ptr texture)
 	assert(texture->type() == TextureType::Texture2D);
 
 	set("diffuseMap", texture);
+	if (hasProperty("diffuseMapUVRect"))
+		unset("diffuseMapUVRect");
 
 	return std::dynamic_pointer_cast<BasicMaterial>(shared_from_this());
 }
@@ -84,6 +87,24 @@ BasicMaterial::diffuseMap() const
 		: nullptr;
 }
 
+BasicMaterial::Ptr
+BasicMaterial::diffuseMap(TextureAtlas::Ptr atlas, Texture::Ptr texture)
+{
+	if (!atlas || !atlas->texture())
+		throw std::invalid_argument("atlas");
+
+	set("diffuseMap", std::static_pointer_cast<AbstractTexture>(atlas->texture()));
+	set("diffuseMapUVRect", atlas->uvRect(texture));
+
+	return std::dynamic_pointer_cast<BasicMaterial>(shared_from_this());
+}
+
+Vector4::Ptr
+BasicMaterial::diffuseMapUVRect() const
+{
+	return hasProperty("diffuseMapUVRect") ? get<Vector4::Ptr>("diffuseMapUVRect") : nullptr;
+}
+
 BasicMaterial::Ptr
 BasicMaterial::diffuseCubeMap(std::shared_ptr<render::AbstractTexture> texture)
 {
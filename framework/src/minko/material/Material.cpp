@@ -19,11 +19,148 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/material/Material.hpp"
 
+#include "minko/math/Vector2.hpp"
+#include "minko/math/Vector3.hpp"
+#include "minko/math/Vector4.hpp"
+#include "minko/math/Matrix4x4.hpp"
+#include "minko/render/AbstractTexture.hpp"
+#include "minko/render/Texture.hpp"
+#include "minko/render/CubeTexture.hpp"
+#include "minko/render/Blending.hpp"
+#include "minko/render/CompareMode.hpp"
+#include "minko/render/StencilOperation.hpp"
+#include "minko/render/TriangleCulling.hpp"
+
 using namespace minko;
 using namespace minko::material;
 
+namespace
+{
+	template <typename T>
+	bool
+	appendBytes(const Any& value, char tag, std::string& key)
+	{
+		auto held = Any::cast<T>(&value);
+
+		if (!held)
+			return false;
+
+		key += tag;
+		key.append(reinterpret_cast<const char*>(held), sizeof(T));
+
+		return true;
+	}
+
+	void
+	components(math::Vector2& v, std::vector<float>& output)
+	{
+		output.assign({ v.x(), v.y() });
+	}
+
+	void
+	components(math::Vector3& v, std::vector<float>& output)
+	{
+		output.assign({ v.x(), v.y(), v.z() });
+	}
+
+	void
+	components(math::Vector4& v, std::vector<float>& output)
+	{
+		output.assign({ v.x(), v.y(), v.z(), v.w() });
+	}
+
+	void
+	components(const math::Matrix4x4& m, std::vector<float>& output)
+	{
+		output = m.data();
+	}
+
+	template <typename T>
+	bool
+	appendFloats(const Any& value, char tag, std::string& key)
+	{
+		auto held = Any::cast<std::shared_ptr<T>>(&value);
+
+		if (!held)
+			return false;
+
+		key += tag;
+		if (*held)
+		{
+			std::vector<float> floats;
+
+			components(**held, floats);
+			key.append(reinterpret_cast<const char*>(floats.data()), floats.size() * sizeof(float));
+		}
+
+		return true;
+	}
+
+	template <typename T>
+	bool
+	appendReference(const Any& value, char tag, std::string& key)
+	{
+		auto held = Any::cast<std::shared_ptr<T>>(&value);
+
+		if (!held)
+			return false;
+
+		auto pointer = static_cast<const void*>(held->get());
+
+		key += tag;
+		key.append(reinterpret_cast<const char*>(&pointer), sizeof(pointer));
+
+		return true;
+	}
+
+	bool
+	appendValue(const Any& value, std::string& key)
+	{
+		return appendBytes<bool>(value, 'b', key)
+			|| appendBytes<int>(value, 'i', key)
+			|| appendBytes<uint>(value, 'u', key)
+			|| appendBytes<float>(value, 'f', key)
+			|| appendBytes<render::Blending::Mode>(value, 'B', key)
+			|| appendBytes<render::CompareMode>(value, 'C', key)
+			|| appendBytes<render::StencilOperation>(value, 'S', key)
+			|| appendBytes<render::TriangleCulling>(value, 'T', key)
+			|| appendFloats<math::Vector2>(value, '2', key)
+			|| appendFloats<math::Vector3>(value, '3', key)
+			|| appendFloats<math::Vector4>(value, '4', key)
+			|| appendFloats<math::Matrix4x4>(value, 'M', key)
+			|| appendReference<render::AbstractTexture>(value, 'A', key)
+			|| appendReference<render::Texture>(value, 't', key)
+			|| appendReference<render::CubeTexture>(value, 'c', key);
+	}
+}
+
 Material::Material() :
 	data::ArrayProvider("material", 0)
 {
 	
 }
+
+bool
+Material::propertiesKey(std::string& key) const
+{
+	std::vector<std::string> names(propertyNames());
+
+	// the order in which the properties were set does not matter
+	std::sort(names.begin(), names.end());
+
+	key = typeid(*this).name();
+	key += '\0';
+	key += arrayName();
+
+	for (auto& name : names)
+	{
+		key += '\0';
+		key += name;
+		key += '\0';
+
+		if (!appendValue(values().find(name)->second, key))
+			return false;
+	}
+
+	return true;
+}
@@ -21,6 +21,9 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/math/Ray.hpp"
 #include "minko/math/Vector3.hpp"
+#include "minko/math/Matrix4x4.hpp"
+
+#include "SIMD.hpp"
 
 using namespace minko;
 using namespace minko::math;
@@ -85,6 +88,10 @@ Box::cast(Ray::Ptr ray, float& distance)
 	if (t1z < tmax)
 		tmax = t1z;
 
+	// behind the origin of the ray
+	if (tmax < 0.f)
+		return false;
+
 	distance = tmin;
 
 	return true;
@@ -168,6 +175,78 @@ Box::testBoundingBox(std::shared_ptr<math::Box> box)
 	return ShapePosition::AROUND;
 }
 
+float
+Box::squaredDistance(std::shared_ptr<Vector3> point) const
+{
+	auto dx = std::max(0.f, std::max(std::min(_bottomLeft->x(), _topRight->x()) - point->x(), point->x() - std::max(_bottomLeft->x(), _topRight->x())));
+	auto dy = std::max(0.f, std::max(std::min(_bottomLeft->y(), _topRight->y()) - point->y(), point->y() - std::max(_bottomLeft->y(), _topRight->y())));
+	auto dz = std::max(0.f, std::max(std::min(_bottomLeft->z(), _topRight->z()) - point->z(), point->z() - std::max(_bottomLeft->z(), _topRight->z())));
+
+	return dx * dx + dy * dy + dz * dz;
+}
+
+Box::Ptr
+Box::transform(std::shared_ptr<Matrix4x4> matrix, Ptr output)
+{
+	if (!output)
+		output = create();
+
+	const float*	m			= &matrix->data()[0];
+	const float		center[3]	= {
+		(_topRight->x() + _bottomLeft->x()) * .5f,
+		(_topRight->y() + _bottomLeft->y()) * .5f,
+		(_topRight->z() + _bottomLeft->z()) * .5f
+	};
+	const float		extents[3]	= {
+		fabsf(_topRight->x() - _bottomLeft->x()) * .5f,
+		fabsf(_topRight->y() - _bottomLeft->y()) * .5f,
+		fabsf(_topRight->z() - _bottomLeft->z()) * .5f
+	};
+	float			worldCenter[4];
+	float			worldExtents[4];
+
+#if defined(MINKO_SIMD_SSE)
+	// columns of the row-major matrix, the 4th row is ignored
+	__m128 c0 = _mm_loadu_ps(m);
+	__m128 c1 = _mm_loadu_ps(m + 4);
+	__m128 c2 = _mm_loadu_ps(m + 8);
+	__m128 c3 = _mm_loadu_ps(m + 12);
+
+	_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+	const __m128 signMask = _mm_set1_ps(-0.f);
+
+	_mm_storeu_ps(worldCenter, _mm_add_ps(
+		_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(center[0])), _mm_mul_ps(c1, _mm_set1_ps(center[1]))),
+		_mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(center[2])), c3)
+	));
+	_mm_storeu_ps(worldExtents, _mm_add_ps(
+		_mm_add_ps(
+			_mm_mul_ps(_mm_andnot_ps(signMask, c0), _mm_set1_ps(extents[0])),
+			_mm_mul_ps(_mm_andnot_ps(signMask, c1), _mm_set1_ps(extents[1]))
+		),
+		_mm_mul_ps(_mm_andnot_ps(signMask, c2), _mm_set1_ps(extents[2]))
+	));
+#else
+	for (uint i = 0; i < 3; ++i)
+	{
+		const float* row = m + i * 4;
+
+		worldCenter[i] = row[0] * center[0] + row[1] * center[1] + row[2] * center[2] + row[3];
+		worldExtents[i] = fabsf(row[0]) * extents[0] + fabsf(row[1]) * extents[1] + fabsf(row[2]) * extents[2];
+	}
+#endif
+
+	output->_topRight->setTo(
+		worldCenter[0] + worldExtents[0], worldCenter[1] + worldExtents[1], worldCenter[2] + worldExtents[2]
+	);
+	output->_bottomLeft->setTo(
+		worldCenter[0] - worldExtents[0], worldCenter[1] - worldExtents[1], worldCenter[2] - worldExtents[2]
+	);
+
+	return output;
+}
+
 void
 Box::updateFromMatrix(std::shared_ptr<math::Matrix4x4> matrix)
 {
@@ -0,0 +1,134 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/math/CPUFeatures.hpp"
+
+#include "SIMD.hpp"
+
+#if defined(MINKO_SIMD_SSE)
+# if defined(_MSC_VER)
+#  include <intrin.h>
+# else
+#  include <cpuid.h>
+# endif
+#endif
+
+using namespace minko;
+using namespace minko::math;
+
+// the kernels called before the detection, by other static initializers, run the scalar code
+InstructionSet CPUFeatures::_best = CPUFeatures::detect();
+InstructionSet CPUFeatures::_instructionSet = CPUFeatures::_best;
+
+InstructionSet
+CPUFeatures::detect()
+{
+#if defined(MINKO_SIMD_SSE)
+	unsigned int eax = 0;
+	unsigned int ebx = 0;
+	unsigned int ecx = 0;
+	unsigned int edx = 0;
+	unsigned int maxLeaf = 0;
+
+# if defined(_MSC_VER)
+	int registers[4];
+
+	__cpuid(registers, 0);
+	maxLeaf = registers[0];
+	__cpuid(registers, 1);
+	ecx = registers[2];
+	edx = registers[3];
+# else
+	maxLeaf = __get_cpuid_max(0, nullptr);
+	__cpuid(1, eax, ebx, ecx, edx);
+# endif
+
+	if ((edx & (1u << 26)) == 0)
+		return InstructionSet::SCALAR;
+	if ((ecx & (1u << 19)) == 0)
+		return InstructionSet::SSE2;
+
+# if defined(MINKO_SIMD_AVX2)
+	// the YMM registers must also be saved by the OS, which enables XGETBV with OSXSAVE
+	const bool osxsave = (ecx & (1u << 27)) != 0;
+
+	if (osxsave && maxLeaf >= 7)
+	{
+		unsigned long long xcr0 = 0;
+
+#  if defined(_MSC_VER)
+		xcr0 = _xgetbv(0);
+		__cpuidex(registers, 7, 0);
+		ebx = registers[1];
+#  else
+		unsigned int xcr0Low = 0;
+		unsigned int xcr0High = 0;
+
+		__asm__ ("xgetbv" : "=a" (xcr0Low), "=d" (xcr0High) : "c" (0));
+		xcr0 = ((unsigned long long)xcr0High << 32) | xcr0Low;
+		__cpuid_count(7, 0, eax, ebx, ecx, edx);
+#  endif
+
+		if ((xcr0 & 6) == 6 && (ebx & (1u << 5)) != 0)
+			return InstructionSet::AVX2;
+	}
+# endif
+
+	return InstructionSet::SSE41;
+#elif defined(MINKO_SIMD_NEON)
+	return InstructionSet::NEON;
+#else
+	return InstructionSet::SCALAR;
+#endif
+}
+
+bool
+CPUFeatures::supports(InstructionSet instructionSet)
+{
+	if (instructionSet == InstructionSet::SCALAR)
+		return true;
+	if (instructionSet == InstructionSet::NEON || _best == InstructionSet::NEON)
+		return instructionSet == _best;
+
+	return instructionSet <= _best;
+}
+
+void
+CPUFeatures::instructionSet(InstructionSet instructionSet)
+{
+	if (!supports(instructionSet))
+		throw std::invalid_argument("instructionSet");
+
+	_instructionSet = instructionSet;
+}
+
+std::string
+CPUFeatures::name(InstructionSet instructionSet)
+{
+	switch (instructionSet)
+	{
+	case InstructionSet::SCALAR:	return "scalar";
+	case InstructionSet::SSE2:		return "SSE2";
+	case InstructionSet::SSE41:		return "SSE4.1";
+	case InstructionSet::AVX2:		return "AVX2";
+	case InstructionSet::NEON:		return "NEON";
+	}
+
+	return "unknown";
+}
@@ -22,6 +22,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/math/Matrix4x4.hpp"
 #include "minko/math/Box.hpp"
 
+#include "SIMD.hpp"
+
 using namespace minko;
 using namespace minko::math;
 
@@ -126,6 +128,171 @@ Frustum::testBoundingBox(math::Box::Ptr box)
 	return ShapePosition::INSIDE;
 }
 
+ShapePosition
+Frustum::testBoundingBox(math::Box::Ptr box, uint& planeMask, uint& firstPlane)
+{
+	const auto& bottomLeft	= box->bottomLeft();
+	const auto& topRight	= box->topRight();
+
+	for (uint i = 0; i < 6; ++i)
+	{
+		uint planeId = (firstPlane + i) % 6;
+
+		if ((planeMask & (1u << planeId)) == 0)
+			continue;
+
+		const auto& plane = _planes[planeId];
+
+		// the corners the furthest along and against the plane normal
+		float pDistance = plane->w()
+			+ plane->x() * (plane->x() >= 0.f ? topRight->x() : bottomLeft->x())
+			+ plane->y() * (plane->y() >= 0.f ? topRight->y() : bottomLeft->y())
+			+ plane->z() * (plane->z() >= 0.f ? topRight->z() : bottomLeft->z());
+
+		if (pDistance < 0.f)
+		{
+			firstPlane = planeId;
+
+			return static_cast<ShapePosition>(planeId);
+		}
+
+		float nDistance = plane->w()
+			+ plane->x() * (plane->x() >= 0.f ? bottomLeft->x() : topRight->x())
+			+ plane->y() * (plane->y() >= 0.f ? bottomLeft->y() : topRight->y())
+			+ plane->z() * (plane->z() >= 0.f ? bottomLeft->z() : topRight->z());
+
+		if (nDistance >= 0.f)
+			planeMask &= ~(1u << planeId);
+	}
+
+	return planeMask == 0 ? ShapePosition::INSIDE : ShapePosition::AROUND;
+}
+
+#if defined(MINKO_SIMD_AVX2)
+namespace
+{
+	// sets the bits of the boxes outside of the plane 8 at a time, returns the index of the first box left
+	MINKO_SIMD_TARGET_AVX2
+	uint
+	testPlaneAVX2(float a, float b, float c, float d,
+				  const float* x, const float* y, const float* z,
+				  uint numBoxes, uint* visibility)
+	{
+		const __m256	va		= _mm256_set1_ps(a);
+		const __m256	vb		= _mm256_set1_ps(b);
+		const __m256	vc		= _mm256_set1_ps(c);
+		const __m256	vd		= _mm256_set1_ps(d);
+		const __m256	zero	= _mm256_setzero_ps();
+		uint			i		= 0;
+
+		for (; i + 8 <= numBoxes; i += 8)
+		{
+			__m256 distance = _mm256_add_ps(
+				_mm256_add_ps(_mm256_mul_ps(va, _mm256_loadu_ps(x + i)), _mm256_mul_ps(vb, _mm256_loadu_ps(y + i))),
+				_mm256_add_ps(_mm256_mul_ps(vc, _mm256_loadu_ps(z + i)), vd)
+			);
+
+			visibility[i >> 5] |= uint(_mm256_movemask_ps(_mm256_cmp_ps(distance, zero, _CMP_LT_OQ))) << (i & 31);
+		}
+
+		return i;
+	}
+}
+#endif
+
+void
+Frustum::testBoundingBoxes(const float*			minX,
+						   const float*			minY,
+						   const float*			minZ,
+						   const float*			maxX,
+						   const float*			maxY,
+						   const float*			maxZ,
+						   uint					numBoxes,
+						   std::vector<uint>&	visibility,
+						   uint					planeMask)
+{
+	uint numWords = (numBoxes + 31) >> 5;
+
+	// the bits are first set for the boxes outside of at least one plane
+	visibility.assign(numWords, 0);
+
+	for (uint planeId = 0; planeId < 6; ++planeId)
+	{
+		if ((planeMask & (1u << planeId)) == 0)
+			continue;
+
+		const auto& plane = _planes[planeId];
+		float a = plane->x();
+		float b = plane->y();
+		float c = plane->z();
+		float d = plane->w();
+
+		// the sign of the plane normal picks the same corner for every box
+		const float* x = a >= 0.f ? maxX : minX;
+		const float* y = b >= 0.f ? maxY : minY;
+		const float* z = c >= 0.f ? maxZ : minZ;
+		uint i = 0;
+
+#if defined(MINKO_SIMD_AVX2)
+		if (numBoxes >= 8 && CPUFeatures::enabled(InstructionSet::AVX2))
+			i = testPlaneAVX2(a, b, c, d, x, y, z, numBoxes, &visibility[0]);
+#endif
+
+#if defined(MINKO_SIMD_SSE)
+		if (CPUFeatures::enabled(InstructionSet::SSE2))
+		{
+			const __m128 va		= _mm_set1_ps(a);
+			const __m128 vb		= _mm_set1_ps(b);
+			const __m128 vc		= _mm_set1_ps(c);
+			const __m128 vd		= _mm_set1_ps(d);
+			const __m128 zero	= _mm_setzero_ps();
+
+			for (; i + 4 <= numBoxes; i += 4)
+			{
+				__m128 distance = _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(va, _mm_loadu_ps(x + i)), _mm_mul_ps(vb, _mm_loadu_ps(y + i))),
+					_mm_add_ps(_mm_mul_ps(vc, _mm_loadu_ps(z + i)), vd)
+				);
+
+				visibility[i >> 5] |= uint(_mm_movemask_ps(_mm_cmplt_ps(distance, zero))) << (i & 31);
+			}
+		}
+#elif defined(MINKO_SIMD_NEON)
+		if (CPUFeatures::enabled(InstructionSet::NEON))
+		{
+			const float32x4_t	vd		= vdupq_n_f32(d);
+			const float32x4_t	zero	= vdupq_n_f32(0.f);
+			static const uint32_t bitsData[4] = { 1, 2, 4, 8 };
+			const uint32x4_t	bits	= vld1q_u32(bitsData);
+
+			for (; i + 4 <= numBoxes; i += 4)
+			{
+				float32x4_t distance = vmlaq_n_f32(vd, vld1q_f32(x + i), a);
+
+				distance = vmlaq_n_f32(distance, vld1q_f32(y + i), b);
+				distance = vmlaq_n_f32(distance, vld1q_f32(z + i), c);
+
+				uint32x4_t outside = vandq_u32(vcltq_f32(distance, zero), bits);
+				uint32x2_t sum = vadd_u32(vget_low_u32(outside), vget_high_u32(outside));
+
+				visibility[i >> 5] |= (vget_lane_u32(sum, 0) | vget_lane_u32(sum, 1)) << (i & 31);
+			}
+		}
+#endif
+
+		for (; i < numBoxes; ++i)
+			if (a * x[i] + b * y[i] + c * z[i] + d < 0.f)
+				visibility[i >> 5] |= 1u << (i & 31);
+	}
+
+	for (uint i = 0; i < numWords; ++i)
+		visibility[i] = ~visibility[i];
+
+	// clear the bits past the last box
+	if (numBoxes & 31)
+		visibility[numWords - 1] &= (1u << (numBoxes & 31)) - 1;
+}
+
 bool
 Frustum::cast(std::shared_ptr<Ray> ray, float& distance)
 {
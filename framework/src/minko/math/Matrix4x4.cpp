@@ -21,17 +21,26 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/Signal.hpp"
 
+#include "SIMD.hpp"
+
 using namespace minko;
 using namespace minko::math;
 
 Matrix4x4::Matrix4x4() :
 	_m(16),
-	_lock(false)
+	_lock(false),
+	_hasChanged(false),
+	_changeEpsilon(-1.f),
+	_notifiedM()
 {
 }
 
 Matrix4x4::Matrix4x4(Matrix4x4::Ptr value) :
-	_m(value->_m)
+	_m(value->_m),
+	_lock(false),
+	_hasChanged(false),
+	_changeEpsilon(value->_changeEpsilon),
+	_notifiedM(value->_notifiedM)
 {
 }
 
@@ -41,24 +50,16 @@ Matrix4x4::prepend(float m00, float m01, float m02, float m03,
 			 	   float m20, float m21, float m22, float m23,
 			 	   float m30, float m31, float m32, float m33)
 {
-	return initialize(
-		_m[0] * m00 + _m[1] * m10 + _m[2] * m20 + _m[3] * m30,
-		_m[0] * m01 + _m[1] * m11 + _m[2] * m21 + _m[3] * m31,
-		_m[0] * m02 + _m[1] * m12 + _m[2] * m22 + _m[3] * m32,
-		_m[0] * m03 + _m[1] * m13 + _m[2] * m23 + _m[3] * m33,
-		_m[4] * m00 + _m[5] * m10 + _m[6] * m20 + _m[7] * m30,
-		_m[4] * m01 + _m[5] * m11 + _m[6] * m21 + _m[7] * m31,
-		_m[4] * m02 + _m[5] * m12 + _m[6] * m22 + _m[7] * m32,
-		_m[4] * m03 + _m[5] * m13 + _m[6] * m23 + _m[7] * m33,
-		_m[8] * m00 + _m[9] * m10 + _m[10] * m20 + _m[11] * m30,
-		_m[8] * m01 + _m[9] * m11 + _m[10] * m21 + _m[11] * m31,
-		_m[8] * m02 + _m[9] * m12 + _m[10] * m22 + _m[11] * m32,
-		_m[8] * m03 + _m[9] * m13 + _m[10] * m23 + _m[11] * m33,
-		_m[12] * m00 + _m[13] * m10 + _m[14] * m20 + _m[15] * m30,
-		_m[12] * m01 + _m[13] * m11 + _m[14] * m21 + _m[15] * m31,
-		_m[12] * m02 + _m[13] * m12 + _m[14] * m22 + _m[15] * m32,
-		_m[12] * m03 + _m[13] * m13 + _m[14] * m23 + _m[15] * m33
-	);
+	float m[16] = {
+		m00, m01, m02, m03,
+		m10, m11, m12, m13,
+		m20, m21, m22, m23,
+		m30, m31, m32, m33
+	};
+
+	multiply(m, &_m[0], m);
+
+	return setRaw(m);
 }
 
 Matrix4x4::Ptr
@@ -67,24 +68,16 @@ Matrix4x4::append(float m00, float m01, float m02, float m03,
 			 	  float m20, float m21, float m22, float m23,
 			 	  float m30, float m31, float m32, float m33)
 {
-	return initialize(
-		m00 * _m[0] + m01 * _m[4] + m02 * _m[8] + m03 * _m[12],
-		m00 * _m[1] + m01 * _m[5] + m02 * _m[9] + m03 * _m[13],
-		m00 * _m[2] + m01 * _m[6] + m02 * _m[10] + m03 * _m[14],
-		m00 * _m[3] + m01 * _m[7] + m02 * _m[11] + m03 * _m[15],
-		m10 * _m[0] + m11 * _m[4] + m12 * _m[8] + m13 * _m[12],
-		m10 * _m[1] + m11 * _m[5] + m12 * _m[9] + m13 * _m[13],
-		m10 * _m[2] + m11 * _m[6] + m12 * _m[10] + m13 * _m[14],
-		m10 * _m[3] + m11 * _m[7] + m12 * _m[11] + m13 * _m[15],
-		m20 * _m[0] + m21 * _m[4] + m22 * _m[8] + m23 * _m[12],
-		m20 * _m[1] + m21 * _m[5] + m22 * _m[9] + m23 * _m[13],
-		m20 * _m[2] + m21 * _m[6] + m22 * _m[10] + m23 * _m[14],
-		m20 * _m[3] + m21 * _m[7] + m22 * _m[11] + m23 * _m[15],
-		m30 * _m[0] + m31 * _m[4] + m32 * _m[8] + m33 * _m[12],
-		m30 * _m[1] + m31 * _m[5] + m32 * _m[9] + m33 * _m[13],
-		m30 * _m[2] + m31 * _m[6] + m32 * _m[10] + m33 * _m[14],
-		m30 * _m[3] + m31 * _m[7] + m32 * _m[11] + m33 * _m[15]
-	);
+	float m[16] = {
+		m00, m01, m02, m03,
+		m10, m11, m12, m13,
+		m20, m21, m22, m23,
+		m30, m31, m32, m33
+	};
+
+	multiply(&_m[0], m, m);
+
+	return setRaw(m);
 }
 
 Matrix4x4::Ptr
@@ -93,16 +86,14 @@ Matrix4x4::initialize(float m00, float m01, float m02, float m03,
 			  		  float m20, float m21, float m22, float m23,
 			  		  float m30, float m31, float m32, float m33)
 {
-	_m[0] = m00;	_m[1] = m01; 	_m[2] = m02; 	_m[3] = m03;
-	_m[4] = m10;	_m[5] = m11; 	_m[6] = m12; 	_m[7] = m13;
-	_m[8] = m20;	_m[9] = m21; 	_m[10] = m22; 	_m[11] = m23;
-	_m[12] = m30; 	_m[13] = m31; 	_m[14] = m32; 	_m[15] = m33;
-
-	if (!_lock)
-		changed()->execute(shared_from_this());
-	_hasChanged = true;
+	const float values[16] = {
+		m00, m01, m02, m03,
+		m10, m11, m12, m13,
+		m20, m21, m22, m23,
+		m30, m31, m32, m33
+	};
 
-	return shared_from_this();
+	return setRaw(values);
 }
 
 Matrix4x4::Ptr
@@ -153,45 +144,11 @@ Matrix4x4::determinant3x3() const
 Matrix4x4::Ptr
 Matrix4x4::invert()
 {
-	float s0 =_m[0] * _m[5] - _m[4] * _m[1];
-    float s1 =_m[0] * _m[6] - _m[4] * _m[2];
-    float s2 =_m[0] * _m[7] - _m[4] * _m[3];
-    float s3 =_m[1] * _m[6] - _m[5] * _m[2];
-    float s4 =_m[1] * _m[7] - _m[5] * _m[3];
-    float s5 =_m[2] * _m[7] - _m[6] * _m[3];
-
-    float c5 =_m[10] * _m[15] - _m[14] * _m[11];
-    float c4 =_m[9] * _m[15] - _m[13] * _m[11];
-    float c3 =_m[9] * _m[14] - _m[13] * _m[10];
-    float c2 =_m[8] * _m[15] - _m[12] * _m[11];
-    float c1 =_m[8] * _m[14] - _m[12] * _m[10];
-    float c0 =_m[8] * _m[13] - _m[12] * _m[9];
-
-    float det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+	float m[16];
 
-	if (det == 0.)
-		throw std::logic_error("matrix is not invertible (determinant = 0).");
+	invert(&_m[0], m);
 
-    float invdet = 1.f / det;
-
-	return initialize(
-		(_m[5] * c5 - _m[6] * c4 + _m[7] * c3) * invdet,
-		(-_m[1] * c5 + _m[2] * c4 - _m[3] * c3) * invdet,
-		(_m[13] * s5 - _m[14] * s4 + _m[15] * s3) * invdet,
-		(-_m[9] * s5 + _m[10] * s4 - _m[11] * s3) * invdet,
-		(-_m[4] * c5 + _m[6] * c2 - _m[7] * c1) * invdet,
-		(_m[0] * c5 - _m[2] * c2 + _m[3] * c1) * invdet,
-		(-_m[12] * s5 + _m[14] * s2 - _m[15] * s1) * invdet,
-		(_m[8] * s5 - _m[10] * s2 + _m[11] * s1) * invdet,
-		(_m[4] * c4 - _m[5] * c2 + _m[7] * c0) * invdet,
-		(-_m[0] * c4 + _m[1] * c2 - _m[3] * c0) * invdet,
-		(_m[12] * s4 - _m[13] * s2 + _m[15] * s0) * invdet,
-		(-_m[8] * s4 + _m[9] * s2 - _m[11] * s0) * invdet,
-		(-_m[4] * c3 + _m[5] * c1 - _m[6] * c0) * invdet,
-		(_m[0] * c3 - _m[1] * c1 + _m[2] * c0) * invdet,
-		(-_m[12] * s3 + _m[13] * s1 - _m[14] * s0) * invdet,
-		(_m[8] * s3 - _m[9] * s1 + _m[10] * s0) * invdet
-	);
+	return setRaw(m);
 }
 
 Matrix4x4::Ptr
@@ -211,11 +168,10 @@ Matrix4x4::transform(std::shared_ptr<Vector3> v, std::shared_ptr<Vector3> output
     if (!output)
         output = Vector3::create();
 
-	output->setTo(
-        v->x() * _m[0] + v->y() * _m[1] + v->z() * _m[2] + _m[3],
-        v->x() * _m[4] + v->y() * _m[5] + v->z() * _m[6] + _m[7],
-        v->x() * _m[8] + v->y() * _m[9] + v->z() * _m[10] + _m[11]
-    );
+	float xyz[3] = { v->x(), v->y(), v->z() };
+
+	transform(&_m[0], xyz, 1.f, xyz);
+	output->setTo(xyz[0], xyz[1], xyz[2]);
 
     return output;
 }
@@ -226,11 +182,10 @@ Matrix4x4::deltaTransform(std::shared_ptr<Vector3> v, std::shared_ptr<Vector3> o
     if (!output)
         output = Vector3::create();
 
-	output->setTo(
-        v->x() * _m[0] + v->y() * _m[1] + v->z() * _m[2],
-        v->x() * _m[4] + v->y() * _m[5] + v->z() * _m[6],
-        v->x() * _m[8] + v->y() * _m[9] + v->z() * _m[10]
-    );
+	float xyz[3] = { v->x(), v->y(), v->z() };
+
+	transform(&_m[0], xyz, 0.f, xyz);
+	output->setTo(xyz[0], xyz[1], xyz[2]);
 
     return output;
 }
@@ -238,27 +193,220 @@ Matrix4x4::deltaTransform(std::shared_ptr<Vector3> v, std::shared_ptr<Vector3> o
 Matrix4x4::Ptr
 Matrix4x4::append(Matrix4x4::Ptr matrix)
 {
-	std::vector<float>& mv = matrix->_m;
+	float m[16];
 
-	return append(
-		mv[0],	mv[1], 	mv[2], 	mv[3],
-		mv[4], 	mv[5], 	mv[6], 	mv[7],
-		mv[8], 	mv[9], 	mv[10], mv[11],
-		mv[12], mv[13], mv[14], mv[15]
-	);
+	multiply(&_m[0], &matrix->_m[0], m);
+
+	return setRaw(m);
 }
 
 Matrix4x4::Ptr
 Matrix4x4::prepend(Matrix4x4::Ptr matrix)
 {
-	std::vector<float>& mv = matrix->_m;
+	float m[16];
 
-	return prepend(
-		mv[0],	mv[1], 	mv[2], 	mv[3],
-		mv[4], 	mv[5], 	mv[6], 	mv[7],
-		mv[8], 	mv[9], 	mv[10], mv[11],
-		mv[12], mv[13], mv[14], mv[15]
-	);
+	multiply(&matrix->_m[0], &_m[0], m);
+
+	return setRaw(m);
+}
+
+void
+Matrix4x4::multiply(const float* lhs, const float* rhs, float* out)
+{
+#if defined(MINKO_SIMD_SSE)
+	if (CPUFeatures::enabled(InstructionSet::SSE2))
+	{
+		const __m128 r0 = _mm_loadu_ps(lhs);
+		const __m128 r1 = _mm_loadu_ps(lhs + 4);
+		const __m128 r2 = _mm_loadu_ps(lhs + 8);
+		const __m128 r3 = _mm_loadu_ps(lhs + 12);
+
+		for (auto i = 0; i < 16; i += 4)
+		{
+			__m128 row = _mm_mul_ps(_mm_set1_ps(rhs[i]), r0);
+
+			row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(rhs[i + 1]), r1));
+			row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(rhs[i + 2]), r2));
+			row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(rhs[i + 3]), r3));
+
+			_mm_storeu_ps(out + i, row);
+		}
+
+		return;
+	}
+#elif defined(MINKO_SIMD_NEON)
+	if (CPUFeatures::enabled(InstructionSet::NEON))
+	{
+		const float32x4_t r0 = vld1q_f32(lhs);
+		const float32x4_t r1 = vld1q_f32(lhs + 4);
+		const float32x4_t r2 = vld1q_f32(lhs + 8);
+		const float32x4_t r3 = vld1q_f32(lhs + 12);
+
+		for (auto i = 0; i < 16; i += 4)
+		{
+			float32x4_t row = vmulq_n_f32(r0, rhs[i]);
+
+			row = vmlaq_n_f32(row, r1, rhs[i + 1]);
+			row = vmlaq_n_f32(row, r2, rhs[i + 2]);
+			row = vmlaq_n_f32(row, r3, rhs[i + 3]);
+
+			vst1q_f32(out + i, row);
+		}
+
+		return;
+	}
+#endif
+
+	float m[16];
+
+	for (auto i = 0; i < 16; i += 4)
+		for (auto j = 0; j < 4; ++j)
+			m[i + j] = rhs[i] * lhs[j] + rhs[i + 1] * lhs[4 + j]
+				+ rhs[i + 2] * lhs[8 + j] + rhs[i + 3] * lhs[12 + j];
+
+	std::copy(m, m + 16, out);
+}
+
+void
+Matrix4x4::invert(const float* m, float* out)
+{
+	float s0 = m[0] * m[5] - m[4] * m[1];
+	float s1 = m[0] * m[6] - m[4] * m[2];
+	float s2 = m[0] * m[7] - m[4] * m[3];
+	float s3 = m[1] * m[6] - m[5] * m[2];
+	float s4 = m[1] * m[7] - m[5] * m[3];
+	float s5 = m[2] * m[7] - m[6] * m[3];
+
+	float c5 = m[10] * m[15] - m[14] * m[11];
+	float c4 = m[9] * m[15] - m[13] * m[11];
+	float c3 = m[9] * m[14] - m[13] * m[10];
+	float c2 = m[8] * m[15] - m[12] * m[11];
+	float c1 = m[8] * m[14] - m[12] * m[10];
+	float c0 = m[8] * m[13] - m[12] * m[9];
+
+	float det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+
+	if (det == 0.)
+		throw std::logic_error("matrix is not invertible (determinant = 0).");
+
+	float invdet = 1.f / det;
+	float r[16] = {
+		m[5] * c5 - m[6] * c4 + m[7] * c3,
+		-m[1] * c5 + m[2] * c4 - m[3] * c3,
+		m[13] * s5 - m[14] * s4 + m[15] * s3,
+		-m[9] * s5 + m[10] * s4 - m[11] * s3,
+		-m[4] * c5 + m[6] * c2 - m[7] * c1,
+		m[0] * c5 - m[2] * c2 + m[3] * c1,
+		-m[12] * s5 + m[14] * s2 - m[15] * s1,
+		m[8] * s5 - m[10] * s2 + m[11] * s1,
+		m[4] * c4 - m[5] * c2 + m[7] * c0,
+		-m[0] * c4 + m[1] * c2 - m[3] * c0,
+		m[12] * s4 - m[13] * s2 + m[15] * s0,
+		-m[8] * s4 + m[9] * s2 - m[11] * s0,
+		-m[4] * c3 + m[5] * c1 - m[6] * c0,
+		m[0] * c3 - m[1] * c1 + m[2] * c0,
+		-m[12] * s3 + m[13] * s1 - m[14] * s0,
+		m[8] * s3 - m[9] * s1 + m[10] * s0
+	};
+
+	// the cofactors are all computed before out is written, so out may be m
+#if defined(MINKO_SIMD_SSE)
+	if (CPUFeatures::enabled(InstructionSet::SSE2))
+	{
+		const __m128 scale = _mm_set1_ps(invdet);
+
+		for (auto i = 0; i < 16; i += 4)
+			_mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(r + i), scale));
+
+		return;
+	}
+#elif defined(MINKO_SIMD_NEON)
+	if (CPUFeatures::enabled(InstructionSet::NEON))
+	{
+		for (auto i = 0; i < 16; i += 4)
+			vst1q_f32(out + i, vmulq_n_f32(vld1q_f32(r + i), invdet));
+
+		return;
+	}
+#endif
+
+	for (auto i = 0; i < 16; ++i)
+		out[i] = r[i] * invdet;
+}
+
+void
+Matrix4x4::transform(const float* m, const float* v, float w, float* out)
+{
+#if defined(MINKO_SIMD_SSE)
+	if (CPUFeatures::enabled(InstructionSet::SSE2))
+	{
+		// transposed, columns become rows and a single multiply-add chain computes x, y and z
+		__m128 c0 = _mm_loadu_ps(m);
+		__m128 c1 = _mm_loadu_ps(m + 4);
+		__m128 c2 = _mm_loadu_ps(m + 8);
+		__m128 c3 = _mm_loadu_ps(m + 12);
+
+		_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+		__m128 r = _mm_mul_ps(c0, _mm_set1_ps(v[0]));
+
+		r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(v[1])));
+		r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(v[2])));
+		r = _mm_add_ps(r, _mm_mul_ps(c3, _mm_set1_ps(w)));
+
+		float xyzw[4];
+
+		_mm_storeu_ps(xyzw, r);
+		out[0] = xyzw[0];
+		out[1] = xyzw[1];
+		out[2] = xyzw[2];
+
+		return;
+	}
+#endif
+
+	const float x = v[0];
+	const float y = v[1];
+	const float z = v[2];
+
+	out[0] = x * m[0] + y * m[1] + z * m[2] + w * m[3];
+	out[1] = x * m[4] + y * m[5] + z * m[6] + w * m[7];
+	out[2] = x * m[8] + y * m[9] + z * m[10] + w * m[11];
+}
+
+void
+Matrix4x4::lerp(const float* from, const float* to, float ratio, float* out)
+{
+#if defined(MINKO_SIMD_SSE)
+	if (CPUFeatures::enabled(InstructionSet::SSE2))
+	{
+		const __m128 t = _mm_set1_ps(ratio);
+
+		for (auto i = 0; i < 16; i += 4)
+		{
+			const __m128 a = _mm_loadu_ps(from + i);
+
+			_mm_storeu_ps(out + i, _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(to + i), a), t)));
+		}
+
+		return;
+	}
+#elif defined(MINKO_SIMD_NEON)
+	if (CPUFeatures::enabled(InstructionSet::NEON))
+	{
+		for (auto i = 0; i < 16; i += 4)
+		{
+			const float32x4_t a = vld1q_f32(from + i);
+
+			vst1q_f32(out + i, vmlaq_n_f32(a, vsubq_f32(vld1q_f32(to + i), a), ratio));
+		}
+
+		return;
+	}
+#endif
+
+	for (auto i = 0; i < 16; ++i)
+		out[i] = from[i] + (to[i] - from[i]) * ratio;
 }
 
 Matrix4x4::Ptr
@@ -502,14 +650,11 @@ Matrix4x4::lookAt(Vector3::Ptr lookAt, Vector3::Ptr	position, Vector3::Ptr up)
 Matrix4x4::Ptr
 Matrix4x4::lerp(Matrix4x4::Ptr target, float ratio)
 {
-	for (auto i = 0; i < 16; ++i)
-		_m[i] = _m[i] + (target->_m[i] - _m[i]) * ratio;
-	
-	if (!_lock)
-		changed()->execute(shared_from_this());
-	_hasChanged = true;
+	float values[16];
 
-	return shared_from_this();
+	lerp(&_m[0], &target->_m[0], ratio, values);
+
+	return setRaw(values);
 }
 
 Matrix4x4::Ptr
@@ -531,7 +676,16 @@ Matrix4x4::rotationQuaternion(Quaternion::Ptr output) const
 Matrix4x4::Ptr
 Matrix4x4::copyFrom(Matrix4x4::Ptr source)
 {
-	std::copy(source->_m.begin(), source->_m.end(), _m.begin());
+	return setRaw(&source->_m[0]);
+}
+
+Matrix4x4::Ptr
+Matrix4x4::setRaw(const float* values)
+{
+	std::copy(values, values + 16, _m.begin());
+
+	if (!exceedsChangeEpsilon())
+		return shared_from_this();
 
 	if (!_lock)
 		changed()->execute(shared_from_this());
@@ -540,6 +694,24 @@ Matrix4x4::copyFrom(Matrix4x4::Ptr source)
 	return shared_from_this();
 }
 
+bool
+Matrix4x4::exceedsChangeEpsilon()
+{
+	if (_changeEpsilon < 0.f)
+		return true;
+
+	// compared to the last notified values rather than the previous write to avoid any drift
+	for (uint i = 0; i < 16; ++i)
+		if (fabsf(_m[i] - _notifiedM[i]) > _changeEpsilon)
+		{
+			_notifiedM = _m;
+
+			return true;
+		}
+
+	return false;
+}
+
 std::pair<Matrix4x4::Ptr, Matrix4x4::Ptr>
 Matrix4x4::decomposeQR(Matrix4x4::Ptr matQ, Matrix4x4::Ptr matR) const
 {	
@@ -0,0 +1,270 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/math/OcclusionBuffer.hpp"
+
+#include "minko/math/Matrix4x4.hpp"
+#include "minko/math/Vector3.hpp"
+#include "minko/math/Box.hpp"
+
+using namespace minko;
+using namespace minko::math;
+
+// vertices closer than this to the eye plane are not projected
+static const float MIN_W = 1e-5f;
+
+OcclusionBuffer::OcclusionBuffer(uint width, uint height) :
+	_width(width),
+	_height(height),
+	_worldToScreen(16, 0.f),
+	_invalidPyramid(true)
+{
+}
+
+void
+OcclusionBuffer::initialize()
+{
+	uint width	= _width;
+	uint height	= _height;
+
+	while (true)
+	{
+		_levels.push_back(std::vector<float>(width * height, std::numeric_limits<float>::max()));
+		_levelWidth.push_back(width);
+		_levelHeight.push_back(height);
+
+		if (width == 1 && height == 1)
+			break;
+
+		width = std::max(1u, (width + 1) >> 1);
+		height = std::max(1u, (height + 1) >> 1);
+	}
+}
+
+float
+OcclusionBuffer::depth(uint x, uint y, uint level)
+{
+	if (level >= _levels.size() || x >= _levelWidth[level] || y >= _levelHeight[level])
+		throw std::invalid_argument("x, y, level");
+
+	if (_invalidPyramid)
+		buildPyramid();
+
+	return _levels[level][x + y * _levelWidth[level]];
+}
+
+OcclusionBuffer::Ptr
+OcclusionBuffer::clear(MatrixPtr worldToScreen)
+{
+	std::copy(worldToScreen->data().begin(), worldToScreen->data().end(), _worldToScreen.begin());
+	std::fill(_levels[0].begin(), _levels[0].end(), std::numeric_limits<float>::max());
+	_invalidPyramid = true;
+
+	return shared_from_this();
+}
+
+OcclusionBuffer::Ptr
+OcclusionBuffer::rasterize(const std::vector<float>&	vertices,
+						   uint							vertexSize,
+						   uint							positionOffset,
+						   const std::vector<uint>&		indices,
+						   MatrixPtr					modelToWorld)
+{
+	if (vertexSize < positionOffset + 3)
+		throw std::invalid_argument("vertexSize");
+
+	float			modelToScreen[16];
+	const uint		numVertices	= vertices.size() / vertexSize;
+
+	Matrix4x4::multiply(&modelToWorld->data()[0], &_worldToScreen[0], modelToScreen);
+
+	// screen space x, y, depth and w of each vertex
+	_clipVertices.resize(numVertices * 4);
+	for (uint i = 0; i < numVertices; ++i)
+	{
+		const float*	p	= &vertices[i * vertexSize + positionOffset];
+		float*			out	= &_clipVertices[i * 4];
+		const float		w	= modelToScreen[12] * p[0] + modelToScreen[13] * p[1] + modelToScreen[14] * p[2] + modelToScreen[15];
+
+		out[3] = w;
+		if (w < MIN_W)
+			continue;
+
+		const float invW = 1.f / w;
+
+		out[0] = ((modelToScreen[0] * p[0] + modelToScreen[1] * p[1] + modelToScreen[2] * p[2] + modelToScreen[3]) * invW * .5f + .5f) * _width;
+		out[1] = ((modelToScreen[4] * p[0] + modelToScreen[5] * p[1] + modelToScreen[6] * p[2] + modelToScreen[7]) * invW * .5f + .5f) * _height;
+		out[2] = (modelToScreen[8] * p[0] + modelToScreen[9] * p[1] + modelToScreen[10] * p[2] + modelToScreen[11]) * invW;
+	}
+
+	for (uint i = 0; i + 2 < indices.size(); i += 3)
+	{
+		if (indices[i] >= numVertices || indices[i + 1] >= numVertices || indices[i + 2] >= numVertices)
+			throw std::invalid_argument("indices");
+
+		const float* v0 = &_clipVertices[indices[i] * 4];
+		const float* v1 = &_clipVertices[indices[i + 1] * 4];
+		const float* v2 = &_clipVertices[indices[i + 2] * 4];
+
+		// triangles crossing the eye plane are dropped: fewer occluders never hide a visible box
+		if (v0[3] < MIN_W || v1[3] < MIN_W || v2[3] < MIN_W)
+			continue;
+
+		rasterizeTriangle(v0, v1, v2);
+	}
+
+	_invalidPyramid = true;
+
+	return shared_from_this();
+}
+
+void
+OcclusionBuffer::rasterizeTriangle(const float* v0, const float* v1, const float* v2)
+{
+	const float area = (v1[0] - v0[0]) * (v2[1] - v0[1]) - (v1[1] - v0[1]) * (v2[0] - v0[0]);
+
+	if (area == 0.f)
+		return;
+
+	const float	invArea	= 1.f / area;
+	const int	minX	= std::max(0, (int)floor(std::min(v0[0], std::min(v1[0], v2[0]))));
+	const int	maxX	= std::min((int)_width - 1, (int)ceil(std::max(v0[0], std::max(v1[0], v2[0]))));
+	const int	minY	= std::max(0, (int)floor(std::min(v0[1], std::min(v1[1], v2[1]))));
+	const int	maxY	= std::min((int)_height - 1, (int)ceil(std::max(v0[1], std::max(v1[1], v2[1]))));
+	auto&		depth	= _levels[0];
+
+	// samples at texel centers, both windings are rasterized
+	for (int y = minY; y <= maxY; ++y)
+	{
+		const float py = y + .5f;
+
+		for (int x = minX; x <= maxX; ++x)
+		{
+			const float px = x + .5f;
+			const float w0 = ((v1[0] - px) * (v2[1] - py) - (v1[1] - py) * (v2[0] - px)) * invArea;
+			const float w1 = ((v2[0] - px) * (v0[1] - py) - (v2[1] - py) * (v0[0] - px)) * invArea;
+			const float w2 = 1.f - w0 - w1;
+
+			if (w0 < 0.f || w1 < 0.f || w2 < 0.f)
+				continue;
+
+			const float z		= w0 * v0[2] + w1 * v1[2] + w2 * v2[2];
+			float&		texel	= depth[x + y * _width];
+
+			if (z < texel)
+				texel = z;
+		}
+	}
+}
+
+void
+OcclusionBuffer::buildPyramid()
+{
+	for (uint level = 1; level < _levels.size(); ++level)
+	{
+		const auto&	source			= _levels[level - 1];
+		const uint	sourceWidth		= _levelWidth[level - 1];
+		const uint	sourceHeight	= _levelHeight[level - 1];
+		auto&		target			= _levels[level];
+
+		for (uint y = 0; y < _levelHeight[level]; ++y)
+		{
+			const uint y0 = std::min(y * 2, sourceHeight - 1);
+			const uint y1 = std::min(y * 2 + 1, sourceHeight - 1);
+
+			for (uint x = 0; x < _levelWidth[level]; ++x)
+			{
+				const uint x0 = std::min(x * 2, sourceWidth - 1);
+				const uint x1 = std::min(x * 2 + 1, sourceWidth - 1);
+
+				target[x + y * _levelWidth[level]] = std::max(
+					std::max(source[x0 + y0 * sourceWidth], source[x1 + y0 * sourceWidth]),
+					std::max(source[x0 + y1 * sourceWidth], source[x1 + y1 * sourceWidth])
+				);
+			}
+		}
+	}
+
+	_invalidPyramid = false;
+}
+
+bool
+OcclusionBuffer::occluded(std::shared_ptr<Box> box)
+{
+	if (_invalidPyramid)
+		buildPyramid();
+
+	const float*	m			= &_worldToScreen[0];
+	auto			min			= box->bottomLeft();
+	auto			max			= box->topRight();
+	float			minX		= std::numeric_limits<float>::max();
+	float			minY		= std::numeric_limits<float>::max();
+	float			maxX		= -std::numeric_limits<float>::max();
+	float			maxY		= -std::numeric_limits<float>::max();
+	float			minDepth	= std::numeric_limits<float>::max();
+
+	for (uint i = 0; i < 8; ++i)
+	{
+		const float x = i & 1 ? max->x() : min->x();
+		const float y = i & 2 ? max->y() : min->y();
+		const float z = i & 4 ? max->z() : min->z();
+		const float w = m[12] * x + m[13] * y + m[14] * z + m[15];
+
+		// the box reaches the eye plane
+		if (w < MIN_W)
+			return false;
+
+		const float invW	= 1.f / w;
+		const float sx		= ((m[0] * x + m[1] * y + m[2] * z + m[3]) * invW * .5f + .5f) * _width;
+		const float sy		= ((m[4] * x + m[5] * y + m[6] * z + m[7]) * invW * .5f + .5f) * _height;
+
+		minX = std::min(minX, sx);
+		maxX = std::max(maxX, sx);
+		minY = std::min(minY, sy);
+		maxY = std::max(maxY, sy);
+		minDepth = std::min(minDepth, (m[8] * x + m[9] * y + m[10] * z + m[11]) * invW);
+	}
+
+	if (maxX < 0.f || maxY < 0.f || minX >= _width || minY >= _height)
+		return false;
+
+	uint x0 = (uint)std::max(0.f, floorf(minX));
+	uint y0 = (uint)std::max(0.f, floorf(minY));
+	uint x1 = (uint)std::min((float)_width - 1.f, floorf(maxX));
+	uint y1 = (uint)std::min((float)_height - 1.f, floorf(maxY));
+	uint level = 0;
+
+	// the first level where the screen rectangle covers at most 2x2 texels
+	while (level + 1 < _levels.size() && ((x1 >> level) - (x0 >> level) > 1 || (y1 >> level) - (y0 >> level) > 1))
+		++level;
+
+	x0 >>= level;
+	x1 >>= level;
+	y0 >>= level;
+	y1 >>= level;
+
+	const auto& depth = _levels[level];
+
+	for (uint y = y0; y <= y1; ++y)
+		for (uint x = x0; x <= x1; ++x)
+			if (depth[x + y * _levelWidth[level]] >= minDepth)
+				return false;
+
+	return true;
+}
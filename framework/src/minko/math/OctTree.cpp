@@ -38,19 +38,34 @@ using namespace minko::math;
 OctTree::OctTree(float							worldSize,
 			 	 uint							maxDepth,
 				 std::shared_ptr<math::Vector3>	center,
-				 uint							depth)
+				 uint							depth,
+				 bool							loose)
 {
 	_worldSize  = worldSize;
 	_depth		= depth;
 	_center		= center;
 	_splitted	= false;
 	_maxDepth	= maxDepth;
+	_loose			= loose;
+	_revision		= 0;
+	_outsidePlane	= 0;
 
+	updateOctantBoxes();
+}
+
+void
+OctTree::updateOctantBoxes()
+{
 	float edgel = edgeLength();
 
 	_octantBox = math::Box::create(
 		math::Vector3::create(_center->x() + edgel, _center->y() + edgel, _center->z() + edgel),
 		math::Vector3::create(_center->x() - edgel, _center->y() - edgel, _center->z() - edgel));
+
+	if (_loose)
+		_looseBox = math::Box::create(
+			math::Vector3::create(_center->x() + 2.f * edgel, _center->y() + 2.f * edgel, _center->z() + 2.f * edgel),
+			math::Vector3::create(_center->x() - 2.f * edgel, _center->y() - 2.f * edgel, _center->z() - 2.f * edgel));
 }
 
 std::shared_ptr<scene::Node>
@@ -108,7 +123,8 @@ OctTree::split()
 						_center->x() + (x == 0 ? -size / 2 : size / 2),
 						_center->y() + (y == 0 ? -size / 2 : size / 2),
 						_center->z() + (z == 0 ? -size / 2 : size / 2)),
-					_depth + 1);
+					_depth + 1,
+					_loose);
 				_children[index]->_parent = shared_from_this();
 			}
 		}
@@ -116,6 +132,53 @@ OctTree::split()
 	_splitted = true;
 }
 
+bool
+OctTree::contains(std::shared_ptr<math::Box> box)
+{
+	auto bottomLeft	= _octantBox->bottomLeft();
+	auto topRight	= _octantBox->topRight();
+
+	return box->bottomLeft()->x() >= bottomLeft->x() && box->topRight()->x() <= topRight->x()
+		&& box->bottomLeft()->y() >= bottomLeft->y() && box->topRight()->y() <= topRight->y()
+		&& box->bottomLeft()->z() >= bottomLeft->z() && box->topRight()->z() <= topRight->z();
+}
+
+void
+OctTree::grow(std::shared_ptr<math::Box> box)
+{
+	std::vector<NodePtr> nodes;
+
+	for (auto& nodeAndOctant : _nodeToOctant)
+		nodes.push_back(nodeAndOctant.first);
+
+	// double the size toward the box so that the old root becomes one of the new root's octants
+	while (!contains(box))
+	{
+		float edgel = edgeLength();
+
+		_center = math::Vector3::create(
+			_center->x() + ((box->bottomLeft()->x() + box->topRight()->x()) / 2.f < _center->x() ? -edgel : edgel),
+			_center->y() + ((box->bottomLeft()->y() + box->topRight()->y()) / 2.f < _center->y() ? -edgel : edgel),
+			_center->z() + ((box->bottomLeft()->z() + box->topRight()->z()) / 2.f < _center->z() ? -edgel : edgel)
+		);
+		_worldSize *= 2.f;
+		// keeps the same leaf size
+		++_maxDepth;
+
+		updateOctantBoxes();
+	}
+
+	_children.clear();
+	_splitted = false;
+	_content.clear();
+	_childrenContent.clear();
+	_nodeToOctant.clear();
+	_matrixToNode.clear();
+
+	for (auto& node : nodes)
+		insert(node);
+}
+
 OctTree::Ptr
 OctTree::insert(std::shared_ptr<scene::Node> node)
 {
@@ -129,6 +192,10 @@ OctTree::insert(std::shared_ptr<scene::Node> node)
 	std::shared_ptr<component::BoundingBox> nodeBoundingBox = node->component<component::BoundingBox>();
 	std::shared_ptr<math::Matrix4x4>		modelToWorld	= node->component<component::Transform>()->modelToWorldMatrix(true);
 
+	// only the root can be re-rooted to cover the new bounds
+	if (!_parent && !contains(nodeBoundingBox->box()))
+		grow(nodeBoundingBox->box());
+
 	// insert
 	uint								optimalDepth	= std::min(computeDepth(node), _maxDepth);
 	uint								currentDepth	= 0;
@@ -165,47 +232,62 @@ OctTree::insert(std::shared_ptr<scene::Node> node)
 	_nodeToOctant[node] = octant;
 	_matrixToNode[node->data()->get<std::shared_ptr<math::Matrix4x4>>("transform.modelToWorldMatrix")] = node;
 
-	if (_nodeToTransformChangedSlot.find(node) == _nodeToTransformChangedSlot.end())
-	{
-		_nodeToTransformChangedSlot[node] = node->data()->propertyValueChanged("transform.modelToWorldMatrix")->connect(std::bind(
-			&OctTree::nodeModelToWorldChanged,
-			shared_from_this(),
-			std::placeholders::_1,
-			std::placeholders::_2));
-	}
-
 	return shared_from_this();
 }
 
 bool
 OctTree::nodeChangedOctant(std::shared_ptr<scene::Node> node)
 {
-	Ptr										octant			= _nodeToOctant[node];
-	std::shared_ptr<component::BoundingBox> nodeBoundingBox = node->component<component::BoundingBox>();
-	std::shared_ptr<math::Vector3>			nodeCenter		= math::Vector3::create(
-		(nodeBoundingBox->box()->bottomLeft()->x() + nodeBoundingBox->box()->topRight()->x()) / 2,
-		(nodeBoundingBox->box()->bottomLeft()->y() + nodeBoundingBox->box()->topRight()->y()) / 2,
-		(nodeBoundingBox->box()->bottomLeft()->z() + nodeBoundingBox->box()->topRight()->z()) / 2);
+	auto octant	= _nodeToOctant[node];
+	auto box	= node->component<component::BoundingBox>()->box();
+
+	// a loose octant keeps the node as long as its whole box stays inside the inflated bounds
+	if (octant->_loose)
+	{
+		auto bottomLeft	= octant->_looseBox->bottomLeft();
+		auto topRight	= octant->_looseBox->topRight();
+
+		return box->bottomLeft()->x() < bottomLeft->x() || box->topRight()->x() > topRight->x()
+			|| box->bottomLeft()->y() < bottomLeft->y() || box->topRight()->y() > topRight->y()
+			|| box->bottomLeft()->z() < bottomLeft->z() || box->topRight()->z() > topRight->z();
+	}
 
-	if (sqrt(pow(nodeCenter->x() - octant->_center->x(), 2) + pow(nodeCenter->y() - octant->_center->y(), 2) + pow(nodeCenter->z() - octant->_center->z(), 2)) < octant->edgeLength())
-		return false;
-	return true;
+	auto bottomLeft	= octant->_octantBox->bottomLeft();
+	auto topRight	= octant->_octantBox->topRight();
+	auto x			= (box->bottomLeft()->x() + box->topRight()->x()) * .5f;
+	auto y			= (box->bottomLeft()->y() + box->topRight()->y()) * .5f;
+	auto z			= (box->bottomLeft()->z() + box->topRight()->z()) * .5f;
+
+	return x < bottomLeft->x() || x > topRight->x()
+		|| y < bottomLeft->y() || y > topRight->y()
+		|| z < bottomLeft->z() || z > topRight->z();
 }
 
 void
-OctTree::nodeModelToWorldChanged(data::Container::Ptr	data,
-								 const std::string&		propertyName)
+OctTree::nodesModelToWorldChanged(const std::vector<NodePtr>& nodes)
+{
+	for (auto& node : nodes)
+		if (_nodeToOctant.count(node) != 0)
+			_invalidNodes.push_back(node);
+}
+
+bool
+OctTree::update()
 {
-	/*auto node		= _matrixToNode[data->get<std::shared_ptr<math::Matrix4x4>>(propertyName)];
-	auto octant		= _nodeToOctant[node];
+	auto revision = _revision;
 
-	if (node && nodeChangedOctant(node)) // node is no more in the octant
+	for (auto& node : _invalidNodes)
 	{
-		_matrixToNode.erase(data->get<std::shared_ptr<math::Matrix4x4>>(propertyName));
-		_nodeToOctant.erase(node);
-		octant->_content.remove(node);
+		if (_nodeToOctant.count(node) == 0 || !nodeChangedOctant(node))
+			continue;
+
+		remove(node);
 		insert(node);
-	}*/
+		++_revision;
+	}
+	_invalidNodes.clear();
+
+	return revision != _revision;
 }
 
 void
@@ -213,7 +295,52 @@ OctTree::testFrustum(std::shared_ptr<math::AbstractShape>				frustum,
 					 std::function<void(std::shared_ptr<scene::Node>)>	insideFrustumCallback,
 					 std::function<void(std::shared_ptr<scene::Node>)>	outsideFustumCallback)
 {
-	ShapePosition result					= frustum->testBoundingBox(_octantBox);
+	auto mathFrustum = std::dynamic_pointer_cast<math::Frustum>(frustum);
+
+	if (mathFrustum)
+	{
+		_candidates.clear();
+		testFrustum(mathFrustum, Frustum::ALL_PLANES, _candidates, insideFrustumCallback, outsideFustumCallback);
+
+		auto numCandidates = _candidates.size();
+
+		for (auto& bounds : _candidateBounds)
+			bounds.resize(numCandidates);
+
+		for (uint candidateId = 0; candidateId < numCandidates; ++candidateId)
+		{
+			auto box		= _candidates[candidateId]->component<component::BoundingBox>()->box();
+			auto bottomLeft	= box->bottomLeft();
+			auto topRight	= box->topRight();
+
+			_candidateBounds[0][candidateId] = bottomLeft->x();
+			_candidateBounds[1][candidateId] = bottomLeft->y();
+			_candidateBounds[2][candidateId] = bottomLeft->z();
+			_candidateBounds[3][candidateId] = topRight->x();
+			_candidateBounds[4][candidateId] = topRight->y();
+			_candidateBounds[5][candidateId] = topRight->z();
+		}
+
+		// the boxes of the nodes left by the octants are tested in a single pass
+		mathFrustum->testBoundingBoxes(
+			_candidateBounds[0].data(), _candidateBounds[1].data(), _candidateBounds[2].data(),
+			_candidateBounds[3].data(), _candidateBounds[4].data(), _candidateBounds[5].data(),
+			numCandidates,
+			_candidateVisibility
+		);
+
+		for (uint candidateId = 0; candidateId < numCandidates; ++candidateId)
+			if ((_candidateVisibility[candidateId >> 5] & (1u << (candidateId & 31))) != 0)
+				insideFrustumCallback(_candidates[candidateId]);
+			else
+				outsideFustumCallback(_candidates[candidateId]);
+
+		_candidates.clear();
+
+		return;
+	}
+
+	ShapePosition result					= frustum->testBoundingBox(_loose ? _looseBox : _octantBox);
 	
 	if (result == ShapePosition::AROUND || result == ShapePosition::INSIDE)
 	{
@@ -235,6 +362,92 @@ OctTree::testFrustum(std::shared_ptr<math::AbstractShape>				frustum,
 	}
 }
 
+void
+OctTree::testFrustum(std::shared_ptr<math::Frustum>						frustum,
+					 uint												planeMask,
+					 std::vector<NodePtr>&								candidates,
+					 std::function<void(std::shared_ptr<scene::Node>)>&	insideFrustumCallback,
+					 std::function<void(std::shared_ptr<scene::Node>)>&	outsideFustumCallback)
+{
+	// a parent fully inside the frustum has nothing left to test
+	if (planeMask != 0)
+	{
+		auto result = frustum->testBoundingBox(_loose ? _looseBox : _octantBox, planeMask, _outsidePlane);
+
+		if (result != ShapePosition::INSIDE && result != ShapePosition::AROUND)
+		{
+			// a tight octant does not contain the boxes of its nodes, they might still be visible
+			for (auto& node : _childrenContent)
+				if (_loose)
+					outsideFustumCallback(node);
+				else
+					candidates.push_back(node);
+			for (auto& node : _content)
+				if (_loose)
+					outsideFustumCallback(node);
+				else
+					candidates.push_back(node);
+
+			return;
+		}
+	}
+
+	if (planeMask == 0)
+	{
+		for (auto& node : _childrenContent)
+			insideFrustumCallback(node);
+		for (auto& node : _content)
+			insideFrustumCallback(node);
+
+		return;
+	}
+
+	if (_splitted)
+		for (auto& octantChild : _children)
+			octantChild->testFrustum(frustum, planeMask, candidates, insideFrustumCallback, outsideFustumCallback);
+
+	candidates.insert(candidates.end(), _content.begin(), _content.end());
+}
+
+void
+OctTree::testRay(std::shared_ptr<math::Ray>					ray,
+				 std::vector<std::pair<float, NodePtr>>&	hits)
+{
+	auto distance = 0.f;
+
+	// same octant bounds as testFrustum(): the inflated box when loose, the octant box otherwise
+	if (!(_loose ? _looseBox : _octantBox)->cast(ray, distance))
+		return;
+
+	for (auto& node : _content)
+		if (node->component<component::BoundingBox>()->box()->cast(ray, distance))
+			hits.push_back(std::pair<float, NodePtr>(std::max(0.f, distance), node));
+
+	if (_splitted)
+		for (auto& octantChild : _children)
+			octantChild->testRay(ray, hits);
+}
+
+void
+OctTree::testSphere(std::shared_ptr<math::Vector3>	center,
+					float							radius,
+					std::vector<NodePtr>&			nodes)
+{
+	const auto squaredRadius = radius * radius;
+
+	// same octant bounds as testFrustum(): the inflated box when loose, the octant box otherwise
+	if ((_loose ? _looseBox : _octantBox)->squaredDistance(center) > squaredRadius)
+		return;
+
+	for (auto& node : _content)
+		if (node->component<component::BoundingBox>()->box()->squaredDistance(center) <= squaredRadius)
+			nodes.push_back(node);
+
+	if (_splitted)
+		for (auto& octantChild : _children)
+			octantChild->testSphere(center, radius, nodes);
+}
+
 OctTree::Ptr
 OctTree::remove(std::shared_ptr<scene::Node> node)
 {
@@ -245,6 +458,7 @@ OctTree::remove(std::shared_ptr<scene::Node> node)
 	Ptr octant = _nodeToOctant[node];
 
 	octant->_content.remove(node);
+	octant->removeChildContent(node);
 
 	_nodeToOctant.erase(node);
 	_matrixToNode.erase(node->data()->get<math::Matrix4x4::Ptr>("transform.modelToWorldMatrix"));
@@ -21,6 +21,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include <minko/math/Matrix4x4.hpp>
 
+#include "SIMD.hpp"
+
 using namespace minko;
 using namespace minko::math;
 
@@ -167,10 +169,24 @@ Quaternion::toMatrix(Matrix4x4::Ptr output)const
 		std::cerr << "Warning: quaternion not normalized prior conversion to rotation matrix." << std::endl;
 #endif // DEBUG
 
-	float qx	= _i;
-	float qy	= _j;
-	float qz	= _k;
-	float qw	= _r;
+	if (output == nullptr)
+		output	= Matrix4x4::create();
+
+	const float q[4] = { _i, _j, _k, _r };
+	float m[16];
+
+	toMatrix(q, m);
+
+	return output->setRaw(m);
+}
+
+void
+Quaternion::toMatrix(const float* q, float* out)
+{
+	float qx	= q[0];
+	float qy	= q[1];
+	float qz	= q[2];
+	float qw	= q[3];
 	float qxx2	= qx*qx*2.0f;
 	float qxy2	= qx*qy*2.0f;
 	float qxz2	= qx*qz*2.0f;
@@ -180,47 +196,32 @@ Quaternion::toMatrix(Matrix4x4::Ptr output)const
 	float qyw2	= qy*qw*2.0f;
 	float qzz2	= qz*qz*2.0f;
 	float qzw2	= qz*qw*2.0f;
-	float qww2	= qw*qw*2.0f;
-
-	if (output == nullptr)
-		output	= Matrix4x4::create();
 
-	return output->initialize(
+	const float m[16] = {
 		1.0f - qyy2 - qzz2,	qxy2 - qzw2,		qxz2 + qyw2,		0.0f,
 		qxy2 + qzw2,		1.0f - qxx2 - qzz2,	qyz2 - qxw2,		0.0f,
 		qxz2 - qyw2,		qyz2 + qxw2,		1.0f - qxx2 - qyy2,	0.0f,
 		0.0f,				0.0f,				0.0f,				1.0f
-	);
+	};
+
+	std::copy(m, m + 16, out);
 }
 
 Quaternion::Ptr
 Quaternion::slerp(Quaternion::Ptr target, float ratio)
 {
-	const float q1x = _i;
-	const float q1y = _j;
-	const float q1z = _k;
-	const float q1w = _r;
-
-	float q2x = target->_i;
-	float q2y = target->_j;
-	float q2z = target->_k;
-	float q2w = target->_r;
-		
-	float cosOmega = q1x * q2x + q1y * q2y + q1z * q2z + q1w * q2w;
-
-	// adjust signs (if necessary)
-	if (cosOmega < 0.0f)
-	{
-		cosOmega	= -cosOmega;
-		q2x			= -q2x;   
-		q2y			= -q2y;
-		q2z			= -q2z;
-		q2w			= -q2w;
-	} 
+	float q[4] = { _i, _j, _k, _r };
+	const float q2[4] = { target->_i, target->_j, target->_k, target->_r };
+
+	slerp(1, q, q2, &ratio, q);
 
-	float weight1 = 0.0f;
-	float weight2 = 1.0f;
+	return setTo(q[0], q[1], q[2], q[3]);
+}
 
+static inline
+void
+slerpWeights(float cosOmega, float ratio, float& weight1, float& weight2)
+{
 	if ((1.0f - cosOmega) > 1e-4f)
 	{
 		// slerp
@@ -229,17 +230,141 @@ Quaternion::slerp(Quaternion::Ptr target, float ratio)
 
 		weight1  = sinf((1.0f - ratio) * omega)	/ sinOmega;
 		weight2  = sinf(ratio * omega)			/ sinOmega;
-	} else
+	}
+	else
 	{
 		// lerp for small angles
 		weight1 = 1.0f - ratio;
 		weight2 = ratio;
 	}
+}
 
-	_i = weight1 * q1x + weight2 * q2x;
-	_j = weight1 * q1y + weight2 * q2y;
-	_k = weight1 * q1z + weight2 * q2z;
-	_r = weight1 * q1w + weight2 * q2w;
-	
-	return shared_from_this();
-}
\ No newline at end of file
+void
+Quaternion::slerp(uint numQuaternions, const float* from, const float* to, const float* ratios, float* out)
+{
+	const uint n = numQuaternions;
+	uint q = 0;
+
+#if defined(MINKO_SIMD_SSE)
+	// 4 quaternions per iteration, only the weights need scalar trigonometry
+	for (; q + 4 <= n; q += 4)
+	{
+		const __m128 x1 = _mm_loadu_ps(from + q);
+		const __m128 y1 = _mm_loadu_ps(from + n + q);
+		const __m128 z1 = _mm_loadu_ps(from + 2 * n + q);
+		const __m128 w1 = _mm_loadu_ps(from + 3 * n + q);
+		__m128 x2 = _mm_loadu_ps(to + q);
+		__m128 y2 = _mm_loadu_ps(to + n + q);
+		__m128 z2 = _mm_loadu_ps(to + 2 * n + q);
+		__m128 w2 = _mm_loadu_ps(to + 3 * n + q);
+
+		__m128 cosOmega = _mm_add_ps(
+			_mm_add_ps(_mm_mul_ps(x1, x2), _mm_mul_ps(y1, y2)),
+			_mm_add_ps(_mm_mul_ps(z1, z2), _mm_mul_ps(w1, w2))
+		);
+
+		// adjust signs (if necessary)
+		const __m128 sign = _mm_and_ps(cosOmega, _mm_set1_ps(-0.0f));
+
+		cosOmega = _mm_xor_ps(cosOmega, sign);
+		x2 = _mm_xor_ps(x2, sign);
+		y2 = _mm_xor_ps(y2, sign);
+		z2 = _mm_xor_ps(z2, sign);
+		w2 = _mm_xor_ps(w2, sign);
+
+		float c[4];
+		float weights1[4];
+		float weights2[4];
+
+		_mm_storeu_ps(c, cosOmega);
+		for (uint i = 0; i < 4; ++i)
+			slerpWeights(c[i], ratios[q + i], weights1[i], weights2[i]);
+
+		const __m128 a = _mm_loadu_ps(weights1);
+		const __m128 b = _mm_loadu_ps(weights2);
+
+		_mm_storeu_ps(out + q, _mm_add_ps(_mm_mul_ps(a, x1), _mm_mul_ps(b, x2)));
+		_mm_storeu_ps(out + n + q, _mm_add_ps(_mm_mul_ps(a, y1), _mm_mul_ps(b, y2)));
+		_mm_storeu_ps(out + 2 * n + q, _mm_add_ps(_mm_mul_ps(a, z1), _mm_mul_ps(b, z2)));
+		_mm_storeu_ps(out + 3 * n + q, _mm_add_ps(_mm_mul_ps(a, w1), _mm_mul_ps(b, w2)));
+	}
+#elif defined(MINKO_SIMD_NEON)
+	for (; q + 4 <= n; q += 4)
+	{
+		const float32x4_t x1 = vld1q_f32(from + q);
+		const float32x4_t y1 = vld1q_f32(from + n + q);
+		const float32x4_t z1 = vld1q_f32(from + 2 * n + q);
+		const float32x4_t w1 = vld1q_f32(from + 3 * n + q);
+		float32x4_t x2 = vld1q_f32(to + q);
+		float32x4_t y2 = vld1q_f32(to + n + q);
+		float32x4_t z2 = vld1q_f32(to + 2 * n + q);
+		float32x4_t w2 = vld1q_f32(to + 3 * n + q);
+
+		float32x4_t cosOmega = vmulq_f32(x1, x2);
+
+		cosOmega = vmlaq_f32(cosOmega, y1, y2);
+		cosOmega = vmlaq_f32(cosOmega, z1, z2);
+		cosOmega = vmlaq_f32(cosOmega, w1, w2);
+
+		// adjust signs (if necessary)
+		const uint32x4_t sign = vandq_u32(vreinterpretq_u32_f32(cosOmega), vdupq_n_u32(0x80000000));
+
+		cosOmega = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(cosOmega), sign));
+		x2 = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(x2), sign));
+		y2 = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(y2), sign));
+		z2 = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(z2), sign));
+		w2 = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(w2), sign));
+
+		float c[4];
+		float weights1[4];
+		float weights2[4];
+
+		vst1q_f32(c, cosOmega);
+		for (uint i = 0; i < 4; ++i)
+			slerpWeights(c[i], ratios[q + i], weights1[i], weights2[i]);
+
+		const float32x4_t a = vld1q_f32(weights1);
+		const float32x4_t b = vld1q_f32(weights2);
+
+		vst1q_f32(out + q, vmlaq_f32(vmulq_f32(a, x1), b, x2));
+		vst1q_f32(out + n + q, vmlaq_f32(vmulq_f32(a, y1), b, y2));
+		vst1q_f32(out + 2 * n + q, vmlaq_f32(vmulq_f32(a, z1), b, z2));
+		vst1q_f32(out + 3 * n + q, vmlaq_f32(vmulq_f32(a, w1), b, w2));
+	}
+#endif
+
+	for (; q < n; ++q)
+	{
+		const float q1x = from[q];
+		const float q1y = from[n + q];
+		const float q1z = from[2 * n + q];
+		const float q1w = from[3 * n + q];
+
+		float q2x = to[q];
+		float q2y = to[n + q];
+		float q2z = to[2 * n + q];
+		float q2w = to[3 * n + q];
+
+		float cosOmega = q1x * q2x + q1y * q2y + q1z * q2z + q1w * q2w;
+
+		// adjust signs (if necessary)
+		if (cosOmega < 0.0f)
+		{
+			cosOmega	= -cosOmega;
+			q2x			= -q2x;
+			q2y			= -q2y;
+			q2z			= -q2z;
+			q2w			= -q2w;
+		}
+
+		float weight1;
+		float weight2;
+
+		slerpWeights(cosOmega, ratios[q], weight1, weight2);
+
+		out[q]			= weight1 * q1x + weight2 * q2x;
+		out[n + q]		= weight1 * q1y + weight2 * q2y;
+		out[2 * n + q]	= weight1 * q1z + weight2 * q2z;
+		out[3 * n + q]	= weight1 * q1w + weight2 * q2w;
+	}
+}
@@ -0,0 +1,43 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/math/CPUFeatures.hpp"
+
+// vector instruction sets usable by the math kernels, a scalar fallback is always provided and the kernels
+// only run the vector code enabled by CPUFeatures::instructionSet()
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+# include <xmmintrin.h>
+# define MINKO_SIMD_SSE
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+# include <arm_neon.h>
+# define MINKO_SIMD_NEON
+#endif
+
+// AVX2 kernels are compiled for their own function only, whatever the flags of the rest of the build
+#if defined(MINKO_SIMD_SSE) && (defined(_MSC_VER) || defined(__GNUC__)) && !defined(EMSCRIPTEN)
+# include <immintrin.h>
+# define MINKO_SIMD_AVX2
+# if defined(_MSC_VER)
+#  define MINKO_SIMD_TARGET_AVX2
+# else
+#  define MINKO_SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+# endif
+#endif
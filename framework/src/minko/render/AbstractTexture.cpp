@@ -46,6 +46,46 @@ AbstractTexture::AbstractTexture(TextureType			type,
 {
 }
 
+/*static*/
+bool
+AbstractTexture::isCompressed(TextureFormat format)
+{
+	return format != TextureFormat::RGB && format != TextureFormat::RGBA;
+}
+
+/*static*/
+uint
+AbstractTexture::dataSize(TextureFormat format, uint width, uint height)
+{
+	const uint numBlocks = std::max(1u, (width + 3) >> 2) * std::max(1u, (height + 3) >> 2);
+
+	switch (format)
+	{
+	case TextureFormat::RGB:
+		return width * height * 3;
+	case TextureFormat::RGBA:
+		return width * height * 4;
+	case TextureFormat::RGB_DXT1:
+	case TextureFormat::RGBA_DXT1:
+	case TextureFormat::RGB_ETC1:
+	case TextureFormat::RGB_ETC2:
+		return numBlocks * 8;
+	case TextureFormat::RGBA_DXT3:
+	case TextureFormat::RGBA_DXT5:
+	case TextureFormat::RGBA_ETC2:
+	case TextureFormat::RGBA_ASTC_4x4:
+		return numBlocks * 16;
+	case TextureFormat::RGB_PVRTC_2BPP:
+	case TextureFormat::RGBA_PVRTC_2BPP:
+		return (std::max(width, 16u) * std::max(height, 8u) * 2) >> 3;
+	case TextureFormat::RGB_PVRTC_4BPP:
+	case TextureFormat::RGBA_PVRTC_4BPP:
+		return (std::max(width, 8u) * std::max(height, 8u) * 4) >> 3;
+	}
+
+	throw std::invalid_argument("format");
+}
+
 /*static*/
 void
 AbstractTexture::resizeData(unsigned int width, 
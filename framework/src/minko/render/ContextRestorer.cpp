@@ -0,0 +1,308 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/render/ContextRestorer.hpp"
+
+#include "minko/render/AbstractContext.hpp"
+#include "minko/render/Texture.hpp"
+#include "minko/render/CubeTexture.hpp"
+#include "minko/render/VertexBuffer.hpp"
+#include "minko/render/IndexBuffer.hpp"
+#include "minko/render/Effect.hpp"
+#include "minko/render/Pass.hpp"
+#include "minko/file/AssetLibrary.hpp"
+#include "minko/geometry/Geometry.hpp"
+#include "minko/data/Provider.hpp"
+#include "minko/component/Surface.hpp"
+#include "minko/scene/Node.hpp"
+#include "minko/scene/NodeSet.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+ContextRestorer::ContextRestorer(AbstractContextPtr context, uint bytesPerFrame) :
+	_context(context),
+	_bytesPerFrame(bytesPerFrame),
+	_frameBytes(0),
+	_resources(),
+	_effects(),
+	_pendingResources(),
+	_numRestored(0),
+	_dataLost(Signal<Ptr, AbstractResourcePtr>::create()),
+	_restored(Signal<Ptr, uint>::create())
+{
+	if (!context)
+		throw std::invalid_argument("context");
+}
+
+void
+ContextRestorer::track(AbstractResourcePtr resource)
+{
+	if (!resource)
+		throw std::invalid_argument("resource");
+
+	_resources.push_back(resource);
+}
+
+void
+ContextRestorer::track(EffectPtr effect)
+{
+	if (!effect)
+		throw std::invalid_argument("effect");
+
+	_effects.push_back(effect);
+}
+
+void
+ContextRestorer::track(std::shared_ptr<file::AssetLibrary> assets)
+{
+	if (!assets)
+		throw std::invalid_argument("assets");
+
+	for (const auto& nameAndTexture : assets->textures())
+		track(nameAndTexture.second);
+
+	for (const auto& nameAndGeometry : assets->geometries())
+	{
+		for (const auto& vertexBuffer : nameAndGeometry.second->vertexBuffers())
+			track(vertexBuffer);
+		if (nameAndGeometry.second->indices())
+			track(nameAndGeometry.second->indices());
+	}
+
+	for (const auto& nameAndEffect : assets->effects())
+		track(nameAndEffect.second);
+}
+
+void
+ContextRestorer::contextRestored(NodePtr root)
+{
+	_context->contextRestored();
+
+	// resources and passes can be reached several times but must be allocated again only once
+	std::set<AbstractResource*> restoredResources;
+	std::set<Pass*> restoredPasses;
+	std::list<std::weak_ptr<AbstractResource>> visibleResources;
+	std::list<std::weak_ptr<AbstractResource>> otherResources;
+
+	auto restoreResource = [&](AbstractResourcePtr resource, std::list<std::weak_ptr<AbstractResource>>& pending)
+	{
+		if (!resource || !restoredResources.insert(resource.get()).second)
+			return;
+
+		resource->contextRestored();
+		// the resources which were never uploaded are left as they are
+		if (resource->isReady())
+			pending.push_back(resource);
+	};
+
+	auto restoreEffect = [&](EffectPtr effect)
+	{
+		if (!effect)
+			return;
+
+		for (const auto& nameAndTechnique : effect->techniques())
+			for (const auto& pass : nameAndTechnique.second)
+				if (restoredPasses.insert(pass.get()).second)
+					pass->contextRestored();
+	};
+
+	std::vector<std::shared_ptr<component::Surface>> surfaces;
+
+	if (root)
+		for (const auto& descendant : scene::NodeSet::create(root)->descendants(true)->nodes())
+			for (const auto& surface : descendant->components<component::Surface>())
+				surfaces.push_back(surface);
+
+	// the resources of the visible surfaces are queued first, whatever refers to them as well
+	for (auto visible : { true, false })
+		for (const auto& surface : surfaces)
+		{
+			if (surface->computedVisibility() != visible)
+				continue;
+
+			auto& pending = visible ? visibleResources : otherResources;
+			auto geometry = surface->geometry();
+
+			if (geometry)
+			{
+				for (const auto& vertexBuffer : geometry->vertexBuffers())
+					restoreResource(vertexBuffer, pending);
+				restoreResource(geometry->indices(), pending);
+			}
+
+			if (surface->material())
+				for (const auto& nameAndValue : surface->material()->values())
+				{
+					auto texture = Any::cast<std::shared_ptr<AbstractTexture>>(&nameAndValue.second);
+
+					if (texture)
+						restoreResource(*texture, pending);
+				}
+
+			restoreEffect(surface->effect());
+		}
+
+	for (auto resourceIt = _resources.begin(); resourceIt != _resources.end();)
+	{
+		auto resource = resourceIt->lock();
+
+		if (resource)
+		{
+			restoreResource(resource, otherResources);
+			++resourceIt;
+		}
+		else
+			resourceIt = _resources.erase(resourceIt);
+	}
+
+	for (auto effectIt = _effects.begin(); effectIt != _effects.end();)
+	{
+		auto effect = effectIt->lock();
+
+		if (effect)
+		{
+			restoreEffect(effect);
+			++effectIt;
+		}
+		else
+			effectIt = _effects.erase(effectIt);
+	}
+
+	const bool wasComplete = complete();
+
+	// a context lost again while restoring: everything is allocated again above
+	_pendingResources.swap(visibleResources);
+	_pendingResources.splice(_pendingResources.end(), otherResources);
+	_numRestored = 0;
+
+	// the job manager drops completed jobs: queue this one again
+	if (wasComplete && !complete() && jobManager() && !running())
+		jobManager()->pushJob(shared_from_this());
+}
+
+bool
+ContextRestorer::complete()
+{
+	return _pendingResources.empty();
+}
+
+void
+ContextRestorer::beforeFirstStep()
+{
+	_frameBytes = 0;
+}
+
+void
+ContextRestorer::step()
+{
+	// yieldFrame() returned true during the previous frame
+	if (_frameBytes >= _bytesPerFrame)
+		_frameBytes = 0;
+
+	// released or disposed resources are skipped
+	while (!_pendingResources.empty())
+	{
+		auto resource = _pendingResources.front().lock();
+
+		_pendingResources.pop_front();
+
+		if (!resource || !resource->isReady())
+			continue;
+
+		uint numBytes = 0;
+
+		if (uploadData(resource, numBytes))
+		{
+			++_numRestored;
+			_frameBytes += numBytes;
+		}
+		else
+			_dataLost->execute(shared_from_this(), resource);
+
+		break;
+	}
+}
+
+float
+ContextRestorer::priority()
+{
+	// nothing renders right until the resources are back
+	return 2.f;
+}
+
+bool
+ContextRestorer::yieldFrame()
+{
+	return _frameBytes >= _bytesPerFrame;
+}
+
+void
+ContextRestorer::afterLastStep()
+{
+	running(false);
+
+	_restored->execute(shared_from_this(), _numRestored);
+}
+
+bool
+ContextRestorer::uploadData(AbstractResourcePtr resource, uint& numBytes)
+{
+	if (auto texture = std::dynamic_pointer_cast<Texture>(resource))
+	{
+		// render targets are drawn again, the compressed mipmaps cannot be generated again
+		if (texture->data().empty())
+			return texture->optimizeForRenderToTexture();
+		if (texture->mipMapping() && AbstractTexture::isCompressed(texture->format()))
+			return false;
+
+		texture->upload();
+		numBytes = texture->data().size();
+	}
+	else if (auto cubeTexture = std::dynamic_pointer_cast<CubeTexture>(resource))
+	{
+		if (cubeTexture->memorySize() == 0)
+			return cubeTexture->optimizeForRenderToTexture();
+
+		cubeTexture->upload();
+		numBytes = cubeTexture->memorySize();
+	}
+	else if (auto vertexBuffer = std::dynamic_pointer_cast<VertexBuffer>(resource))
+	{
+		if (vertexBuffer->dataDisposed())
+			return false;
+
+		if (!vertexBuffer->data().empty())
+			vertexBuffer->upload();
+		numBytes = vertexBuffer->data().size() * sizeof(float);
+	}
+	else if (auto indexBuffer = std::dynamic_pointer_cast<IndexBuffer>(resource))
+	{
+		if (indexBuffer->dataDisposed())
+			return false;
+
+		if (!indexBuffer->data().empty())
+			indexBuffer->upload();
+		numBytes = indexBuffer->data().size() * sizeof(uint);
+	}
+	else
+		resource->upload();
+
+	return true;
+}
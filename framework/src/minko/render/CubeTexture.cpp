@@ -45,6 +45,9 @@ CubeTexture::data(unsigned char*	data,
 				  int				,
 				  int				)
 {
+	if (isCompressed(format))
+		throw std::invalid_argument("format: compressed cube textures are not supported");
+
 	const unsigned int faceWidth	= _width >> 2;
 	const unsigned int faceHeight	= _height / 3;
 	const unsigned int faceSize		= faceWidth * faceHeight * sizeof(int);
@@ -99,6 +102,19 @@ CubeTexture::data(unsigned char*	data,
 	}
 }
 
+void
+CubeTexture::data(Face face, std::vector<unsigned char>&& rgba)
+{
+	const unsigned int faceWidth	= _width >> 2;
+	const unsigned int faceHeight	= _height / 3;
+
+	if (rgba.size() != faceWidth * faceHeight * sizeof(int))
+		throw std::invalid_argument("rgba");
+
+	resizeData(faceWidth, faceHeight, rgba, _widthGPU, _heightGPU, _resizeSmoothly, _data[static_cast<int>(face)]);
+	std::vector<unsigned char>().swap(rgba);
+}
+
 void
 CubeTexture::upload()
 {
@@ -119,6 +135,10 @@ CubeTexture::upload()
 	{
 		std::vector<unsigned char>& faceData = _data[faceId];
 
+		// the faces without data are only allocated, to be rendered or copied into
+		if (faceData.empty())
+			continue;
+
 		assert(faceData.size() == (numFacePixels << 2));
 
 		const auto face = static_cast<Face>(faceId);
@@ -137,6 +157,21 @@ CubeTexture::upload()
 		_context->generateMipmaps(_id);
 }
 
+void
+CubeTexture::contextRestored()
+{
+	if (_id == -1)
+		return;
+
+	_id = _context->createTexture(
+		_type,
+		_widthGPU,
+		_heightGPU,
+		_mipMapping,
+		_optimizeForRenderToTexture
+	);
+}
+
 void
 CubeTexture::dispose()
 {
@@ -47,6 +47,7 @@ using namespace minko::render;
 SamplerState DrawCall::_defaultSamplerState = SamplerState(WrapMode::CLAMP, TextureFilter::NEAREST, MipFilter::NONE);
 /*static*/ const unsigned int	DrawCall::MAX_NUM_TEXTURES		= 8;
 /*static*/ const unsigned int	DrawCall::MAX_NUM_VERTEXBUFFERS	= 8;
+/*static*/ MINKO_DRAW_CALL_THREAD_LOCAL unsigned int	DrawCall::_pass	= 1;
 
 DrawCall::DrawCall(const data::BindingMap&	attributeBindings,
 				   const data::BindingMap&	uniformBindings,
@@ -67,13 +68,32 @@ DrawCall::DrawCall(const data::BindingMap&	attributeBindings,
     _vertexSizes(MAX_NUM_VERTEXBUFFERS, -1),
     _vertexAttributeSizes(MAX_NUM_VERTEXBUFFERS, -1),
     _vertexAttributeOffsets(MAX_NUM_VERTEXBUFFERS, -1),
+	_vertexAttributeTypes(MAX_NUM_VERTEXBUFFERS, VertexAttributeType::FLOAT),
 	_target(nullptr),
+	_enabled(true),
+	_layouts(1),
+	_profileName(nullptr),
+	_instanceAttributeLocation(-1),
+	_instanceMatrix(nullptr),
+	_instances(),
+	_instanceBuffer(nullptr),
+	_renderedFallbacks(false),
+	_vertexArray(0),
+	_vertexArrayChanged(false),
 	_referenceChangedSlots(),
 	_zsortNeeded(Signal<Ptr>::create()),
 	_zSorter(nullptr)
 {
 }
 
+DrawCall::~DrawCall()
+{
+	if (_vertexArray != 0 && _program)
+		_program->context()->deleteVertexArray(_vertexArray);
+	if (_instanceBuffer)
+		_instanceBuffer->dispose();
+}
+
 void
 DrawCall::initialize()
 {
@@ -84,12 +104,77 @@ void
 DrawCall::configure(std::shared_ptr<Program>  program,
 					ContainerPtr              data,
 					ContainerPtr              rendererData,
-                    ContainerPtr              rootData)
+                    ContainerPtr              rootData,
+					BindingPlanPtr			  bindingPlan)
 {
     _program = program;
+	_bindingPlan = bindingPlan ? bindingPlan : createBindingPlan(program, _attributeBindings, _uniformBindings);
     bind(data, rendererData, rootData);
 }
 
+/*static*/
+DrawCall::BindingPlanPtr
+DrawCall::createBindingPlan(std::shared_ptr<Program>	program,
+							const data::BindingMap&		attributeBindings,
+							const data::BindingMap&		uniformBindings)
+{
+	auto plan = std::make_shared<BindingPlan>();
+
+	if (program == nullptr || program->inputs() == nullptr)
+		return plan;
+
+	auto							programInputs	= program->inputs();
+	const std::vector<std::string>&	inputNames		= programInputs->names();
+
+	plan->resize(inputNames.size());
+
+	for (unsigned int inputId = 0; inputId < inputNames.size(); ++inputId)
+	{
+		auto&	input		= (*plan)[inputId];
+		auto	bindingName	= inputNames[inputId];
+
+		input.inputName	= inputNames[inputId];
+		input.type		= programInputs->type(input.inputName);
+		input.location	= programInputs->location(input.inputName);
+		input.isArray	= false;
+
+		if (input.type != ProgramInputs::Type::attribute
+			&& input.type != ProgramInputs::Type::sampler2d
+			&& input.type != ProgramInputs::Type::samplerCube)
+		{
+			auto pos = input.inputName.find_first_of('[');
+
+			if (pos != std::string::npos)
+			{
+				bindingName			= input.inputName.substr(0, pos);
+				input.arraySuffix	= input.inputName.substr(pos);
+				input.isArray		= true;
+			}
+		}
+
+		const auto& bindings	= input.type == ProgramInputs::Type::attribute ? attributeBindings : uniformBindings;
+		const auto	bindingIt	= bindings.find(bindingName);
+
+		input.bound			= bindingIt != bindings.end();
+		input.hasVariables	= false;
+		input.propertyId	= 0;
+
+		if (!input.bound)
+			continue;
+
+		input.binding		= bindingIt->second;
+		input.hasVariables	= input.binding.first.find("${") != std::string::npos;
+
+		if (!input.hasVariables)
+		{
+			input.propertyName	= input.binding.first + input.arraySuffix;
+			input.propertyId	= data::PropertyName::id(input.propertyName);
+		}
+	}
+
+	return plan;
+}
+
 void
 DrawCall::bind(ContainerPtr data, ContainerPtr rendererData, ContainerPtr rootData)
 {
@@ -120,7 +205,7 @@ DrawCall::bindIndexBuffer()
 	{
 		auto indexBuffer	= _targetData->get<IndexBuffer::Ptr>(propertyName);
 		_indexBuffer		= indexBuffer->id();
-		_numIndices			= indexBuffer->data().size();
+		_numIndices			= indexBuffer->numIndices();
 	}
 
 	if (_referenceChangedSlots.count(propertyName) == 0)
@@ -137,45 +222,38 @@ DrawCall::bindIndexBuffer()
 void
 DrawCall::bindProgramInputs()
 {
-	if (_program == nullptr || _program->inputs() == nullptr)
+	if (_program == nullptr || _bindingPlan == nullptr)
 		return;
 
-	auto							programInputs		= _program->inputs();
-	const std::vector<std::string>&	inputNames			= programInputs->names();
-	unsigned int					numTextures			= 0;
-    unsigned int					numVertexBuffers	= 0;
-	
 	unsigned int					vertexBufferIndex	= 0;
 	unsigned int					textureIndex		= 0;
 	
-	for (unsigned int inputId = 0; inputId < inputNames.size(); ++inputId)
+	for (unsigned int inputId = 0; inputId < _bindingPlan->size(); ++inputId)
 	{
-		const std::string&	inputName	= inputNames[inputId];
-		const auto			type		= programInputs->type(inputName);
-		const int			location	= programInputs->location(inputName);
+		const auto& input = (*_bindingPlan)[inputId];
 
-		switch (type)
+		switch (input.type)
 		{
 		case ProgramInputs::Type::attribute:
 			{
-				bindVertexAttribute(inputName, location, vertexBufferIndex);
+				bindVertexAttribute(inputId, vertexBufferIndex);
 				break;
 			}
 	
 		case ProgramInputs::Type::sampler2d:
 		case ProgramInputs::Type::samplerCube:
 			{
-				auto& samplerState = _states->samplers().count(inputName)
-					? _states->samplers().at(inputName)
+				auto& samplerState = _states->samplers().count(input.inputName)
+					? _states->samplers().at(input.inputName)
 					: _defaultSamplerState;
 
-				bindTextureSampler(inputName, location, textureIndex, samplerState);
+				bindTextureSampler(inputId, textureIndex, samplerState);
 				break;
 			}
 	
 		default:
 			{
-				bindUniform(inputName, type, location);
+				bindUniform(inputId);
 				break;
 			}
 	
@@ -186,10 +264,12 @@ DrawCall::bindProgramInputs()
 }
 
 void
-DrawCall::bindVertexAttribute(const std::string&	inputName,
-							  int					location,
-							  uint&					vertexBufferIndex)
+DrawCall::bindVertexAttribute(uint	inputId,
+							  uint&	vertexBufferIndex)
 {
+	const auto& input		= (*_bindingPlan)[inputId];
+	const int	location	= input.location;
+
 #ifdef DEBUG
 	if (location < 0)
 		throw std::invalid_argument("location");
@@ -197,14 +277,20 @@ DrawCall::bindVertexAttribute(const std::string&	inputName,
 		throw std::invalid_argument("vertexBufferIndex");
 #endif // DEBUG
 	
-	if (_attributeBindings.count(inputName))
+	if (input.bound)
 	{
-		auto propertyName		= formatPropertyName(std::get<0>(_attributeBindings.at(inputName)));
-		const auto& container	= getDataContainer(std::get<1>(_attributeBindings.at(inputName)));
+		auto propertyName		= input.hasVariables ? formatPropertyName(input.binding.first) : input.propertyName;
+		const auto& container	= getDataContainer(input.binding.second);
 
 		++vertexBufferIndex;
 
-		if (container && container->hasProperty(propertyName))
+		if (container && container->propertyHasType<Matrix4x4::Ptr>(propertyName))
+		{
+			// a mat4 attribute bound to a matrix is fed once per instance by renderInstances()
+			_instanceAttributeLocation	= location;
+			_instanceMatrix				= container->get<Matrix4x4::Ptr>(propertyName);
+		}
+		else if (container && container->hasProperty(propertyName))
 		{
 			auto vertexBuffer = container->get<VertexBuffer::Ptr>(propertyName);
 			auto attributeName = propertyName.substr(propertyName.find_last_of('.') + 1);
@@ -219,8 +305,10 @@ DrawCall::bindVertexAttribute(const std::string&	inputName,
 			_vertexBufferIds		[vertexBufferIndex]	= vertexBuffer->id();
 			_vertexBufferLocations	[vertexBufferIndex]	= location;
 			_vertexAttributeSizes	[vertexBufferIndex]	= std::get<1>(*attribute);
-			_vertexSizes			[vertexBufferIndex]	= vertexBuffer->vertexSize();
-			_vertexAttributeOffsets	[vertexBufferIndex]	= std::get<2>(*attribute);
+			_vertexSizes			[vertexBufferIndex]	= vertexBuffer->gpuVertexSize();
+			_vertexAttributeOffsets	[vertexBufferIndex]	= vertexBuffer->gpuAttributeOffset(attributeName);
+			_vertexAttributeTypes	[vertexBufferIndex]	= vertexBuffer->attributeType(attributeName);
+			_vertexArrayChanged = true;
 		}
 
 
@@ -229,12 +317,12 @@ DrawCall::bindVertexAttribute(const std::string&	inputName,
 #if defined(EMSCRIPTEN)
 			// See issue #1848 in Emscripten: https://github.com/kripken/emscripten/issues/1848
 			auto that = shared_from_this();
-			_referenceChangedSlots[propertyName].push_back(container->propertyReferenceChanged(propertyName)->connect([&, that](data::Container::Ptr, const std::string&) {
-				that->bindVertexAttribute(inputName, location, vertexBufferIndex);
+			_referenceChangedSlots[propertyName].push_back(container->propertyReferenceChanged(propertyName)->connect([&, that, inputId](data::Container::Ptr, const std::string&) {
+				that->bindVertexAttribute(inputId, vertexBufferIndex);
 			}));
 #else
 			_referenceChangedSlots[propertyName].push_back(container->propertyReferenceChanged(propertyName)->connect(std::bind(
-				&DrawCall::bindVertexAttribute, shared_from_this(), inputName, location, vertexBufferIndex
+				&DrawCall::bindVertexAttribute, shared_from_this(), inputId, vertexBufferIndex
 			)));
 #endif
 		}
@@ -242,12 +330,14 @@ DrawCall::bindVertexAttribute(const std::string&	inputName,
 }
 
 void
-DrawCall::bindTextureSampler(const std::string&		inputName,
-							 int					location,
+DrawCall::bindTextureSampler(uint					inputId,
 							 uint&					textureIndex,
    							 const SamplerState&	samplerState, 
 							 bool					incrementTextureIndex)
 {
+	const auto& input		= (*_bindingPlan)[inputId];
+	const int	location	= input.location;
+
 #ifdef DEBUG
 	if (location < 0)
 		throw std::invalid_argument("location");
@@ -255,13 +345,13 @@ DrawCall::bindTextureSampler(const std::string&		inputName,
 		throw std::invalid_argument("textureIndex");
 #endif // DEBUG
 
-	if (_uniformBindings.count(inputName))
+	if (input.bound)
 	{
 		if (incrementTextureIndex)
 			++textureIndex;
 
-		auto propertyName		= formatPropertyName(std::get<0>(_uniformBindings.at(inputName)));
-		const auto& container	= getDataContainer(std::get<1>(_uniformBindings.at(inputName)));
+		auto propertyName		= input.hasVariables ? formatPropertyName(input.binding.first) : input.propertyName;
+		const auto& container	= getDataContainer(input.binding.second);
 
 		if (container && container->hasProperty(propertyName))
 		{
@@ -279,12 +369,12 @@ DrawCall::bindTextureSampler(const std::string&		inputName,
 #if defined(EMSCRIPTEN)
 			// See issue #1848 in Emscripten: https://github.com/kripken/emscripten/issues/1848
 			auto that = shared_from_this();
-			_referenceChangedSlots[propertyName].push_back(container->propertyReferenceChanged(propertyName)->connect([&, that](Container::Ptr, const std::string&) {
-				that->bindTextureSampler(inputName, location, textureIndex, samplerState, false);
+			_referenceChangedSlots[propertyName].push_back(container->propertyReferenceChanged(propertyName)->connect([&, that, inputId](Container::Ptr, const std::string&) {
+				that->bindTextureSampler(inputId, textureIndex, samplerState, false);
 			}));
 #else
 			_referenceChangedSlots[propertyName].push_back(container->propertyReferenceChanged(propertyName)->connect(std::bind(
-				&DrawCall::bindTextureSampler, shared_from_this(), inputName, location, textureIndex, samplerState, false
+				&DrawCall::bindTextureSampler, shared_from_this(), inputId, textureIndex, samplerState, false
 			)));
 #endif
 		}
@@ -292,10 +382,12 @@ DrawCall::bindTextureSampler(const std::string&		inputName,
 }
 
 void
-DrawCall::bindUniform(const std::string&	inputName,
-					  ProgramInputs::Type	type,
-					  int					location)
+DrawCall::bindUniform(uint inputId)
 {
+	const auto&	input		= (*_bindingPlan)[inputId];
+	const auto	type		= input.type;
+	const int	location	= input.location;
+
 #ifdef DEBUG
 	if (type == ProgramInputs::Type::sampler2d || type == ProgramInputs::Type::attribute)
 		throw std::invalid_argument("type");
@@ -303,58 +395,53 @@ DrawCall::bindUniform(const std::string&	inputName,
 		throw std::invalid_argument("location");
 #endif // DEBUG
 
-	bool		isArray		= false;
-	auto		pos			= inputName.find_first_of('[');
-	std::string	bindingName	= inputName;
+	// rebinding an already resolved uniform skips the property name formatting
+	auto propertyIt = _uniformLocationToProperty.find(location);
 
-	if (pos != std::string::npos)
+	if (propertyIt != _uniformLocationToProperty.end())
 	{
-		bindingName = inputName.substr(0, pos);
-		isArray = true;
+		const auto& container	= getDataContainer(std::get<0>(propertyIt->second));
+		const auto	propertyId	= std::get<1>(propertyIt->second);
+
+		if (container && container->hasProperty(propertyId))
+		{
+			bindUniformValue(
+				std::get<2>(propertyIt->second) ? _sharedUniforms : _uniforms, container, propertyId, type, location
+			);
+
+			return;
+		}
 	}
-	
-	if (_uniformBindings.count(bindingName))
+
+	if (input.bound)
 	{	
-		std::string	propertyName	= formatPropertyName(std::get<0>(_uniformBindings.at(bindingName)));
-		auto&		source			= std::get<1>(_uniformBindings.at(bindingName));
+		const auto&	rawPropertyName	= input.binding.first;
+		std::string	propertyName	= input.hasVariables ? formatPropertyName(rawPropertyName) : rawPropertyName;
+		auto&		source			= input.binding.second;
 		const auto&	container		= getDataContainer(source);
+		// names that depend on the draw call variables can differ between draw calls of the same program
+		const bool	isShared		= source != BindingSource::TARGET && !input.hasVariables;
+		auto&		uniforms		= isShared ? _sharedUniforms : _uniforms;
 
 		if (container)
 		{
-			if (isArray)
-				propertyName += inputName.substr(pos); // way to handle array of GLSL structs
+			if (input.isArray)
+				propertyName += input.arraySuffix; // way to handle array of GLSL structs
+
+			auto propertyId = input.hasVariables ? data::PropertyName::id(propertyName) : input.propertyId;
 
-			if (container->hasProperty(propertyName))
+			if (container->hasProperty(propertyId))
 			{
 				// This case corresponds to base types uniforms or individual members of an GLSL struct array.
-
-				if (type == ProgramInputs::Type::float1)
-					_uniformFloat[location]		= container->get<float>(propertyName);
-				else if (type == ProgramInputs::Type::float2)
-					_uniformFloat2[location]	= container->get<Vector2::Ptr>(propertyName);
-				else if (type == ProgramInputs::Type::float3)
-					_uniformFloat3[location]	= container->get<Vector3::Ptr>(propertyName);
-				else if (type == ProgramInputs::Type::float4)
-					_uniformFloat4[location]	= container->get<Vector4::Ptr>(propertyName);
-				else if (type == ProgramInputs::Type::float16)
-					_uniformFloat16[location]	= &(container->get<Matrix4x4::Ptr>(propertyName)->data()[0]);
-				else if (type == ProgramInputs::Type::int1)
-					_uniformInt[location]		= container->get<int>(propertyName);
-				else if (type == ProgramInputs::Type::int2)
-					_uniformInt2[location]		= container->get<Int2>(propertyName);
-				else if (type == ProgramInputs::Type::int3)
-					_uniformInt3[location]		= container->get<Int3>(propertyName); 
-				else if (type == ProgramInputs::Type::int4)
-					_uniformInt4[location]		= container->get<Int4>(propertyName);
-				else
-					throw std::logic_error("unsupported uniform type.");
+				bindUniformValue(uniforms, container, propertyId, type, location);
+				_uniformLocationToProperty[location] = std::make_tuple(source, propertyId, isShared);
 			}
-			else if (isArray)
+			else if (input.isArray)
 			{
 				// This case corresponds to continuous base type arrays that are stored in data providers as std::vector<float>.
-				propertyName = formatPropertyName(std::get<0>(_uniformBindings.at(bindingName)));
+				propertyName = input.hasVariables ? formatPropertyName(rawPropertyName) : rawPropertyName;
 				
-				bindUniformArray(propertyName, container, type, location);
+				bindUniformArray(uniforms, propertyName, container, type, location);
 			}
 		}
 
@@ -363,12 +450,12 @@ DrawCall::bindUniform(const std::string&	inputName,
 #if defined(EMSCRIPTEN)
 			// See issue #1848 in Emscripten: https://github.com/kripken/emscripten/issues/1848
 			auto that = shared_from_this();
-			_referenceChangedSlots[propertyName].push_back(container->propertyReferenceChanged(propertyName)->connect([&, that, type, location](Container::Ptr, const std::string&) {
-				that->bindUniform(inputName, type, location);
+			_referenceChangedSlots[propertyName].push_back(container->propertyReferenceChanged(propertyName)->connect([&, that, inputId](Container::Ptr, const std::string&) {
+				that->bindUniform(inputId);
 			}));
 #else
 			_referenceChangedSlots[propertyName].push_back(container->propertyReferenceChanged(propertyName)->connect(std::bind(
-				&DrawCall::bindUniform, shared_from_this(), inputName, type, location
+				&DrawCall::bindUniform, shared_from_this(), inputId
 			)));
 #endif		
 		}
@@ -376,7 +463,37 @@ DrawCall::bindUniform(const std::string&	inputName,
 }
 
 void
-DrawCall::bindUniformArray(const std::string&	propertyName,
+DrawCall::bindUniformValue(UniformValues&			uniforms,
+						   Container::Ptr			container,
+						   data::PropertyName::Id	propertyId,
+						   ProgramInputs::Type		type,
+						   int						location)
+{
+	if (type == ProgramInputs::Type::float1)
+		setUniformValue(uniforms.float1, location, container->get<float>(propertyId));
+	else if (type == ProgramInputs::Type::float2)
+		setUniformValue(uniforms.float2, location, container->get<Vector2::Ptr>(propertyId));
+	else if (type == ProgramInputs::Type::float3)
+		setUniformValue(uniforms.float3, location, container->get<Vector3::Ptr>(propertyId));
+	else if (type == ProgramInputs::Type::float4)
+		setUniformValue(uniforms.float4, location, container->get<Vector4::Ptr>(propertyId));
+	else if (type == ProgramInputs::Type::float16)
+		setUniformValue(uniforms.float16, location, &(container->get<Matrix4x4::Ptr>(propertyId)->data()[0]));
+	else if (type == ProgramInputs::Type::int1)
+		setUniformValue(uniforms.int1, location, container->get<int>(propertyId));
+	else if (type == ProgramInputs::Type::int2)
+		setUniformValue(uniforms.int2, location, container->get<Int2>(propertyId));
+	else if (type == ProgramInputs::Type::int3)
+		setUniformValue(uniforms.int3, location, container->get<Int3>(propertyId));
+	else if (type == ProgramInputs::Type::int4)
+		setUniformValue(uniforms.int4, location, container->get<Int4>(propertyId));
+	else
+		throw std::logic_error("unsupported uniform type.");
+}
+
+void
+DrawCall::bindUniformArray(UniformValues&		uniforms,
+						   const std::string&	propertyName,
 						   Container::Ptr		container,
 						   ProgramInputs::Type	type,
 						   int					location)
@@ -388,13 +505,14 @@ DrawCall::bindUniformArray(const std::string&	propertyName,
 		type == ProgramInputs::Type::int2 ||
 		type == ProgramInputs::Type::int3 ||
 		type == ProgramInputs::Type::int4)
-		bindIntegerUniformArray(propertyName, container, type, location);
+		bindIntegerUniformArray(uniforms, propertyName, container, type, location);
 	else
-		bindFloatUniformArray(propertyName, container, type, location);
+		bindFloatUniformArray(uniforms, propertyName, container, type, location);
 }
 
 void
-DrawCall::bindFloatUniformArray(const std::string&	propertyName,
+DrawCall::bindFloatUniformArray(UniformValues&		uniforms,
+								const std::string&	propertyName,
 								Container::Ptr		container,
 								ProgramInputs::Type	type,
 								int					location)
@@ -407,21 +525,22 @@ DrawCall::bindFloatUniformArray(const std::string&	propertyName,
 		return;
 
 	if (type == ProgramInputs::Type::float1)
-		_uniformFloats[location] = uniformArray;
+		setUniformValue(uniforms.floats, location, uniformArray);
 	else if (type == ProgramInputs::Type::float2)
-		_uniformFloats2[location] = uniformArray;
+		setUniformValue(uniforms.floats2, location, uniformArray);
 	else if (type == ProgramInputs::Type::float3)
-		_uniformFloats3[location] = uniformArray;
+		setUniformValue(uniforms.floats3, location, uniformArray);
 	else if (type == ProgramInputs::Type::float4)
-		_uniformFloats4[location] = uniformArray;
+		setUniformValue(uniforms.floats4, location, uniformArray);
 	else if (type == ProgramInputs::Type::float16)
-		_uniformFloats16[location] = uniformArray;
+		setUniformValue(uniforms.floats16, location, uniformArray);
 	else
 		throw std::logic_error("unsupported uniform type.");
 }
 
 void
-DrawCall::bindIntegerUniformArray(const std::string&	propertyName,
+DrawCall::bindIntegerUniformArray(UniformValues&		uniforms,
+								  const std::string&	propertyName,
 								  Container::Ptr		container,
 							 	  ProgramInputs::Type	type,
 								  int					location)
@@ -434,44 +553,75 @@ DrawCall::bindIntegerUniformArray(const std::string&	propertyName,
 		return;
 
 	if (type == ProgramInputs::Type::int1)
-		_uniformInts[location] = uniformArray;
+		setUniformValue(uniforms.ints, location, uniformArray);
 	else if (type == ProgramInputs::Type::int2)
-		_uniformInts2[location] = uniformArray;
+		setUniformValue(uniforms.ints2, location, uniformArray);
 	else if (type == ProgramInputs::Type::int3)
-		_uniformInts3[location] = uniformArray;
+		setUniformValue(uniforms.ints3, location, uniformArray);
 	else if (type == ProgramInputs::Type::int4)
-		_uniformInts4[location] = uniformArray;
+		setUniformValue(uniforms.ints4, location, uniformArray);
 	else
 		throw std::logic_error("unsupported uniform type.");
 }
 
+void
+DrawCall::UniformValues::clear()
+{
+	float1.clear();
+	float2.clear();
+	float3.clear();
+	float4.clear();
+	float16.clear();
+
+	int1.clear();
+	int2.clear();
+	int3.clear();
+	int4.clear();
+
+	floats.clear();
+	floats2.clear();
+	floats3.clear();
+	floats4.clear();
+	floats16.clear();
+
+	ints.clear();
+	ints2.clear();
+	ints3.clear();
+	ints4.clear();
+}
+
+bool
+DrawCall::UniformValues::operator==(const UniformValues& other) const
+{
+	return float1		== other.float1
+		&& float2		== other.float2
+		&& float3		== other.float3
+		&& float4		== other.float4
+		&& float16		== other.float16
+		&& int1			== other.int1
+		&& int2			== other.int2
+		&& int3			== other.int3
+		&& int4			== other.int4
+		&& floats		== other.floats
+		&& floats2		== other.floats2
+		&& floats3		== other.floats3
+		&& floats4		== other.floats4
+		&& floats16		== other.floats16
+		&& ints			== other.ints
+		&& ints2		== other.ints2
+		&& ints3		== other.ints3
+		&& ints4		== other.ints4;
+}
 
 void
 DrawCall::reset()
 {
 	_target = nullptr;
 
-	_uniformFloat.clear();
-	_uniformFloat2.clear();
-	_uniformFloat3.clear();
-	_uniformFloat4.clear();
-	_uniformFloat16.clear();
+	_uniformLocationToProperty.clear();
 
-	_uniformInt.clear();
-	_uniformInt2.clear();
-	_uniformInt3.clear();
-	_uniformInt4.clear();
-
-	_uniformFloats.clear();
-	_uniformFloats2.clear();
-	_uniformFloats3.clear();
-	_uniformFloats4.clear();
-	_uniformFloats16.clear();
-
-	_uniformInts.clear();
-	_uniformInts2.clear();
-	_uniformInts3.clear();
-	_uniformInts4.clear();
+	_uniforms.clear();
+	_sharedUniforms.clear();
 
 	_textureIds			.clear();
 	_textureLocations	.clear();
@@ -490,12 +640,25 @@ DrawCall::reset()
 	_vertexSizes			.clear();
 	_vertexAttributeSizes	.clear();
 	_vertexAttributeOffsets	.clear();
+	_vertexAttributeTypes	.clear();
 
 	_vertexBufferIds			.resize(MAX_NUM_VERTEXBUFFERS, 0);
 	_vertexBufferLocations	.resize(MAX_NUM_VERTEXBUFFERS, -1);
 	_vertexSizes			.resize(MAX_NUM_VERTEXBUFFERS, -1);
 	_vertexAttributeSizes	.resize(MAX_NUM_VERTEXBUFFERS, -1);
 	_vertexAttributeOffsets	.resize(MAX_NUM_VERTEXBUFFERS, -1);
+	_vertexAttributeTypes	.resize(MAX_NUM_VERTEXBUFFERS, VertexAttributeType::FLOAT);
+
+	_instanceAttributeLocation = -1;
+	_instanceMatrix = nullptr;
+	_instances.clear();
+	if (_instanceBuffer)
+	{
+		_instanceBuffer->dispose();
+		_instanceBuffer = nullptr;
+	}
+
+	_vertexArrayChanged = true;
 
 	_referenceChangedSlots.clear();
 	_zSorter->clear();
@@ -526,17 +689,79 @@ DrawCall::bindStates()
 }
 
 void
-DrawCall::render(const AbstractContext::Ptr& context, AbstractTexture::Ptr renderTarget)
+DrawCall::recordChanges(const DrawCall*				previous,
+						const AbstractTexture::Ptr&	renderTarget,
+						Changes&				changes) const
 {
-	if (!renderTarget)
-		renderTarget = _target;
+	// switching to another program or render target invalidates everything the previous draw call did
+	changes.full = previous == nullptr
+		|| previous->_program != _program
+		|| (!renderTarget && previous->_target != _target);
 
-    if (renderTarget)
+	if (changes.full)
+	{
+		changes.textures		= ~0u;
+		changes.vertexBuffers	= ~0u;
+		changes.states			= true;
+
+		return;
+	}
+
+	changes.textures		= 0;
+	changes.vertexBuffers	= 0;
+
+	for (uint i = 0; i < _textureIds.size(); ++i)
+		if (previous->_textureIds[i] != _textureIds[i]
+			|| previous->_textureLocations[i] != _textureLocations[i]
+			|| previous->_textureWrapMode[i] != _textureWrapMode[i]
+			|| previous->_textureFilters[i] != _textureFilters[i]
+			|| previous->_textureMipFilters[i] != _textureMipFilters[i])
+			changes.textures |= 1u << i;
+
+	for (uint i = 0; i < _vertexBufferIds.size(); ++i)
+		if (previous->_vertexBufferIds[i] != _vertexBufferIds[i]
+			|| previous->_vertexBufferLocations[i] != _vertexBufferLocations[i]
+			|| previous->_vertexAttributeSizes[i] != _vertexAttributeSizes[i]
+			|| previous->_vertexSizes[i] != _vertexSizes[i]
+			|| previous->_vertexAttributeOffsets[i] != _vertexAttributeOffsets[i]
+			|| previous->_vertexAttributeTypes[i] != _vertexAttributeTypes[i])
+			changes.vertexBuffers |= 1u << i;
+
+	changes.states = !hasSameStates(*previous);
+}
+
+void
+DrawCall::render(const AbstractContext::Ptr&	context,
+				 const AbstractTexture::Ptr&	renderTarget,
+				 const DrawCall*				previous,
+				 const ScissorBox*				scissorBox,
+				 const Changes*					changes)
+{
+	Changes recordedChanges;
+
+	if (!changes)
+	{
+		recordChanges(previous, renderTarget, recordedChanges);
+		changes = &recordedChanges;
+	}
+
+	if (changes->full)
+		previous = nullptr;
+
+	_renderedFallbacks = false;
+
+	// the references avoid touching the reference counts of the targets on every draw call
+	const auto& target = renderTarget ? renderTarget : _target;
+
+    if (target)
     {
-    	if (renderTarget->id() != context->renderTarget())
+    	if (target->id() != context->renderTarget())
     	{
-	        context->setRenderToTexture(renderTarget->id(), true);
+	        context->setRenderToTexture(target->id(), true);
 	        context->clear();
+
+			// clearing resets some of the states (depth mask...)
+			previous = nullptr;
 	    }
     }
     else
@@ -544,73 +769,18 @@ DrawCall::render(const AbstractContext::Ptr& context, AbstractTexture::Ptr rende
 
     context->setProgram(_program->id());
 
-	// float uniforms
-    for (auto& uniformFloat : _uniformFloat)
-        context->setUniform(uniformFloat.first, uniformFloat.second);
-    for (auto& uniformFloat2 : _uniformFloat2)
-    {
-        auto& float2 = uniformFloat2.second;
-
-        context->setUniform(uniformFloat2.first, float2->x(), float2->y());
-    }
-    for (auto& uniformFloat3 : _uniformFloat3)
-    {
-        auto& float3 = uniformFloat3.second;
-
-        context->setUniform(uniformFloat3.first, float3->x(), float3->y(), float3->z());
-    }
-    for (auto& uniformFloat4 : _uniformFloat4)
-    {
-        auto& float4 = uniformFloat4.second;
-
-        context->setUniform(uniformFloat4.first, float4->x(), float4->y(), float4->z(), float4->w());
-    }
-    for (auto& uniformFloat16 : _uniformFloat16)
-        context->setUniform(uniformFloat16.first, 1, true, uniformFloat16.second);
+	applyUniformValues(context, _uniforms, previous ? &previous->_uniforms : nullptr);
 
-	// integer uniforms
-	for (auto& uniformInt : _uniformInt)
-		context->setUniform(uniformInt.first, uniformInt.second);
-	for (auto& uniformInt2 : _uniformInt2)
-	{
-		const auto& int2 = uniformInt2.second;
-		context->setUniform(uniformInt2.first, std::get<0>(int2), std::get<1>(int2));
-	}
-	for (auto& uniformInt3 : _uniformInt3)
-	{
-		const auto& int3 = uniformInt3.second;
-		context->setUniform(uniformInt3.first, std::get<0>(int3), std::get<1>(int3), std::get<2>(int3));
-	}
-	for (auto& uniformInt4 : _uniformInt4)
+	// the first draw call of the pass to use the program uploads the shared uniforms for all the others,
+	// without diffing: a new pass can point to the same values with other contents (views...)
+	if (_program->sharedUniformsPass() != _pass)
 	{
-		const auto& int4 = uniformInt4.second;
-		context->setUniform(uniformInt4.first, std::get<0>(int4), std::get<1>(int4), std::get<2>(int4), std::get<3>(int4));
+		applyUniformValues(context, _sharedUniforms, nullptr);
+		_program->sharedUniformsPass(_pass);
 	}
 
-	// arrays of float uniforms
-	for (auto& uniformFloats : _uniformFloats)
-		context->setUniforms	(uniformFloats.first,	uniformFloats.second->first,			uniformFloats.second->second);
-	for (auto& uniformFloats2 : _uniformFloats2)
-		context->setUniforms2	(uniformFloats2.first,	uniformFloats2.second->first,			uniformFloats2.second->second);
-	for (auto& uniformFloats3 : _uniformFloats3)
-		context->setUniforms3	(uniformFloats3.first,	uniformFloats3.second->first,			uniformFloats3.second->second);
-	for (auto& uniformFloats4 : _uniformFloats4)
-		context->setUniforms4	(uniformFloats4.first,	uniformFloats4.second->first,			uniformFloats4.second->second);
-	for (auto& uniformFloats16 : _uniformFloats16)
-		context->setUniform		(uniformFloats16.first,	uniformFloats16.second->first, false,	uniformFloats16.second->second);
-
-	// arrays of integer uniforms
-	for (auto& uniformInts: _uniformInts)
-		context->setUniforms	(uniformInts.first,		uniformInts.second->first,			uniformInts.second->second);
-	for (auto& uniformInts2 : _uniformInts2)
-		context->setUniforms2	(uniformInts2.first,	uniformInts2.second->first,			uniformInts2.second->second);
-	for (auto& uniformInts3 : _uniformInts3)
-		context->setUniforms3	(uniformInts3.first,	uniformInts3.second->first,			uniformInts3.second->second);
-	for (auto& uniformInts4 : _uniformInts4)
-		context->setUniforms4	(uniformInts4.first,	uniformInts4.second->first,			uniformInts4.second->second);
-
 	auto textureOffset = 0;
-	for (auto textureLocationAndPtr : _program->textures())
+	for (const auto& textureLocationAndPtr : _program->textures())
 		context->setTextureAt(
 			textureOffset++, 
 			textureLocationAndPtr.second->id(), 
@@ -621,6 +791,9 @@ DrawCall::render(const AbstractContext::Ptr& context, AbstractTexture::Ptr rende
     {
         auto textureId = _textureIds[i];
 
+		if (previous && (changes->textures & (1u << i)) == 0)
+			continue;
+
         context->setTextureAt(
 			textureOffset + i, 
 			textureId, 
@@ -635,11 +808,32 @@ DrawCall::render(const AbstractContext::Ptr& context, AbstractTexture::Ptr rende
             );
     }
 
+	// the vertex attributes are recorded once in the vertex array of the draw call, which is rebuilt when
+	// they are bound again; the default vertex array is left as is by the previous draw call only if it used it
+	const bool useVertexArray = context->supportsVertexArrays() && !instanced() && _program->vertexBuffers().empty();
+	const bool vertexArrayReady = useVertexArray && _vertexArray != 0 && !_vertexArrayChanged;
+	const bool setAllVertexBuffers = !previous || previous->_vertexArray != 0;
+
+	if (_vertexArray != 0 && (!useVertexArray || _vertexArrayChanged))
+	{
+		context->deleteVertexArray(_vertexArray);
+		_vertexArray = 0;
+	}
+	if (useVertexArray && _vertexArray == 0)
+		_vertexArray = context->createVertexArray();
+	_vertexArrayChanged = false;
+
+	if (context->supportsVertexArrays())
+		context->setVertexArray(_vertexArray);
+
 	// first, hand over to the context bound vertex attributes
-	for (uint i = 0; i < _vertexBufferIds.size(); ++i)
+	for (uint i = 0; i < _vertexBufferIds.size() && !vertexArrayReady; ++i)
 	{
 		auto vertexBufferId = _vertexBufferIds[i];
 	
+		if (!setAllVertexBuffers && !useVertexArray && (changes->vertexBuffers & (1u << i)) == 0)
+			continue;
+
 		if (vertexBufferId > 0 && 
 			!_program->hasVertexBufferLocation(_vertexBufferLocations[i]))
 			context->setVertexBufferAt(
@@ -647,11 +841,12 @@ DrawCall::render(const AbstractContext::Ptr& context, AbstractTexture::Ptr rende
 			     vertexBufferId,
 			     _vertexAttributeSizes[i],
 			     _vertexSizes[i],
-			     _vertexAttributeOffsets[i]
+			     _vertexAttributeOffsets[i],
+			     _vertexAttributeTypes[i]
 			);
 	}
 	// second, hand over explicitly user defined vertex attributes (possible replacement of )
-	for (auto vertexBufferLocationAndPtr : _program->vertexBuffers())
+	for (const auto& vertexBufferLocationAndPtr : _program->vertexBuffers())
 	{
 		const int	location		= vertexBufferLocationAndPtr.first;
 		auto&		vertexBuffer	= vertexBufferLocationAndPtr.second;
@@ -661,28 +856,243 @@ DrawCall::render(const AbstractContext::Ptr& context, AbstractTexture::Ptr rende
 			assert(vertexBuffer->attributes().size() == 1);
 	
 			const auto& vertexAttribute = vertexBuffer->attributes().front();
+			const auto& attributeName	= std::get<0>(*vertexAttribute);
 	
 			context->setVertexBufferAt(
 				location,
 				vertexBuffer->id(),
 				std::get<1>(*vertexAttribute),
-				vertexBuffer->vertexSize(),
-				std::get<2>(*vertexAttribute)
+				vertexBuffer->gpuVertexSize(),
+				vertexBuffer->gpuAttributeOffset(attributeName),
+				vertexBuffer->attributeType(attributeName)
 			);
 		}
 	}
 	
-	context->setColorMask(_colorMask);
-	context->setBlendMode(_blendMode);
-	context->setDepthTest(_depthMask, _depthFunc);
-	context->setStencilTest(_stencilFunc, _stencilRef, _stencilMask, _stencilFailOp, _stencilZFailOp, _stencilZPassOp);
-	context->setScissorTest(_scissorTest, _scissorBox);
-    context->setTriangleCulling(_triangleCulling);
+	if (previous == nullptr || changes->states)
+	{
+		context->setColorMask(_colorMask);
+		context->setBlendMode(_blendMode);
+		context->setDepthTest(_depthMask, _depthFunc);
+		context->setStencilTest(_stencilFunc, _stencilRef, _stencilMask, _stencilFailOp, _stencilZFailOp, _stencilZPassOp);
+		// the scissor box of the renderer, if any, replaces the one of the draw call
+		if (scissorBox)
+			context->setScissorTest(true, *scissorBox);
+		else
+			context->setScissorTest(_scissorTest, _scissorBox);
+		context->setTriangleCulling(_triangleCulling);
+	}
 
 	if (_program->indexBuffer() && _program->indexBuffer()->isReady())
-		context->drawTriangles(_program->indexBuffer()->id(), _program->indexBuffer()->data().size() / 3);
+	{
+		if (instanced())
+			renderInstances(context, target, _program->indexBuffer()->id(), _program->indexBuffer()->numIndices() / 3);
+		else
+			context->drawTriangles(_program->indexBuffer()->id(), _program->indexBuffer()->numIndices() / 3);
+	}
 	else if (_indexBuffer != -1)
-		context->drawTriangles(_indexBuffer, _numIndices / 3);
+	{
+		if (instanced())
+			renderInstances(context, target, _indexBuffer, _numIndices / 3);
+		else
+			context->drawTriangles(_indexBuffer, _numIndices / 3);
+	}
+}
+
+void
+DrawCall::applyUniformValues(const AbstractContext::Ptr&	context,
+							 const UniformValues&			uniforms,
+							 const UniformValues*			previous)
+{
+	// float uniforms
+	applyUniforms(uniforms.float1, previous ? &previous->float1 : nullptr, [&](uint location, float value)
+	{
+		context->setUniform(location, value);
+	});
+	applyUniforms(uniforms.float2, previous ? &previous->float2 : nullptr, [&](uint location, const Vector2::Ptr& float2)
+	{
+		context->setUniform(location, float2->x(), float2->y());
+	});
+	applyUniforms(uniforms.float3, previous ? &previous->float3 : nullptr, [&](uint location, const Vector3::Ptr& float3)
+	{
+		context->setUniform(location, float3->x(), float3->y(), float3->z());
+	});
+	applyUniforms(uniforms.float4, previous ? &previous->float4 : nullptr, [&](uint location, const Vector4::Ptr& float4)
+	{
+		context->setUniform(location, float4->x(), float4->y(), float4->z(), float4->w());
+	});
+	applyUniforms(uniforms.float16, previous ? &previous->float16 : nullptr, [&](uint location, const float* float16)
+	{
+		context->setUniform(location, 1, true, float16);
+	});
+
+	// integer uniforms
+	applyUniforms(uniforms.int1, previous ? &previous->int1 : nullptr, [&](uint location, int value)
+	{
+		context->setUniform(location, value);
+	});
+	applyUniforms(uniforms.int2, previous ? &previous->int2 : nullptr, [&](uint location, const Int2& int2)
+	{
+		context->setUniform(location, std::get<0>(int2), std::get<1>(int2));
+	});
+	applyUniforms(uniforms.int3, previous ? &previous->int3 : nullptr, [&](uint location, const Int3& int3)
+	{
+		context->setUniform(location, std::get<0>(int3), std::get<1>(int3), std::get<2>(int3));
+	});
+	applyUniforms(uniforms.int4, previous ? &previous->int4 : nullptr, [&](uint location, const Int4& int4)
+	{
+		context->setUniform(location, std::get<0>(int4), std::get<1>(int4), std::get<2>(int4), std::get<3>(int4));
+	});
+
+	// arrays of float uniforms
+	applyUniforms(uniforms.floats, previous ? &previous->floats : nullptr, [&](uint location, const UniformArrayPtr<float>& floats)
+	{
+		context->setUniforms(location, floats->first, floats->second);
+	});
+	applyUniforms(uniforms.floats2, previous ? &previous->floats2 : nullptr, [&](uint location, const UniformArrayPtr<float>& floats)
+	{
+		context->setUniforms2(location, floats->first, floats->second);
+	});
+	applyUniforms(uniforms.floats3, previous ? &previous->floats3 : nullptr, [&](uint location, const UniformArrayPtr<float>& floats)
+	{
+		context->setUniforms3(location, floats->first, floats->second);
+	});
+	applyUniforms(uniforms.floats4, previous ? &previous->floats4 : nullptr, [&](uint location, const UniformArrayPtr<float>& floats)
+	{
+		context->setUniforms4(location, floats->first, floats->second);
+	});
+	applyUniforms(uniforms.floats16, previous ? &previous->floats16 : nullptr, [&](uint location, const UniformArrayPtr<float>& floats)
+	{
+		context->setUniform(location, floats->first, false, floats->second);
+	});
+
+	// arrays of integer uniforms
+	applyUniforms(uniforms.ints, previous ? &previous->ints : nullptr, [&](uint location, const UniformArrayPtr<int>& ints)
+	{
+		context->setUniforms(location, ints->first, ints->second);
+	});
+	applyUniforms(uniforms.ints2, previous ? &previous->ints2 : nullptr, [&](uint location, const UniformArrayPtr<int>& ints)
+	{
+		context->setUniforms2(location, ints->first, ints->second);
+	});
+	applyUniforms(uniforms.ints3, previous ? &previous->ints3 : nullptr, [&](uint location, const UniformArrayPtr<int>& ints)
+	{
+		context->setUniforms3(location, ints->first, ints->second);
+	});
+	applyUniforms(uniforms.ints4, previous ? &previous->ints4 : nullptr, [&](uint location, const UniformArrayPtr<int>& ints)
+	{
+		context->setUniforms4(location, ints->first, ints->second);
+	});
+}
+
+void
+DrawCall::renderInstances(const AbstractContext::Ptr&	context,
+						  const AbstractTexture::Ptr&	renderTarget,
+						  uint							indexBuffer,
+						  uint							numTriangles)
+{
+	const uint numFloats = (1 + _instances.size()) << 4;
+
+	if (!_instanceBuffer || _instanceBuffer->data().size() < numFloats)
+	{
+		_instanceBuffer = VertexBuffer::create(context, std::vector<float>(numFloats, 0.f));
+		_instanceBuffer->addAttribute("instanceModelToWorldMatrix", 16);
+	}
+
+	auto&	instanceData	= _instanceBuffer->data();
+	uint	numInstances	= 0;
+
+	// matrices are stored row-major: each row ends up in one column of the mat4 attribute
+	std::copy(_instanceMatrix->data().begin(), _instanceMatrix->data().end(), instanceData.begin());
+	++numInstances;
+
+	// bindings might have changed since the instances were grouped by the DrawCallPool
+	for (auto& instance : _instances)
+		if (canBeInstancedWith(*instance))
+		{
+			auto& matrix = instance->_instanceMatrix->data();
+
+			std::copy(matrix.begin(), matrix.end(), instanceData.begin() + (numInstances << 4));
+			++numInstances;
+		}
+
+	_instanceBuffer->upload(0, numInstances);
+
+	for (uint i = 0; i < 4; ++i)
+	{
+		context->setVertexBufferAt(_instanceAttributeLocation + i, _instanceBuffer->id(), 4, 16, i << 2);
+		context->setVertexAttributeDivisor(_instanceAttributeLocation + i, 1);
+	}
+
+	context->drawTrianglesInstanced(indexBuffer, numTriangles, numInstances);
+
+	for (uint i = 0; i < 4; ++i)
+		context->setVertexAttributeDivisor(_instanceAttributeLocation + i, 0);
+
+	// each fallback is diffed against the draw call rendered just before it
+	const DrawCall* previous = this;
+
+	for (auto& instance : _instances)
+		if (!canBeInstancedWith(*instance))
+		{
+			instance->render(context, renderTarget, previous);
+			previous = instance.get();
+			_renderedFallbacks = true;
+		}
+}
+
+bool
+DrawCall::canBeInstancedWith(const DrawCall& other) const
+{
+	return instanced()
+		&& _instanceAttributeLocation	== other._instanceAttributeLocation
+		&& _program						== other._program
+		&& _indexBuffer					== other._indexBuffer
+		&& _numIndices					== other._numIndices
+		&& _target						== other._target
+		&& _priority					== other._priority
+		&& _layouts						== other._layouts
+		&& _vertexBufferIds				== other._vertexBufferIds
+		&& _vertexBufferLocations		== other._vertexBufferLocations
+		&& _vertexSizes					== other._vertexSizes
+		&& _vertexAttributeSizes		== other._vertexAttributeSizes
+		&& _vertexAttributeOffsets		== other._vertexAttributeOffsets
+		&& _vertexAttributeTypes		== other._vertexAttributeTypes
+		&& _textureIds					== other._textureIds
+		&& _textureLocations			== other._textureLocations
+		&& _textureWrapMode				== other._textureWrapMode
+		&& _textureFilters				== other._textureFilters
+		&& _textureMipFilters			== other._textureMipFilters
+		&& hasSameStates(other)
+		&& hasSameUniforms(other);
+}
+
+bool
+DrawCall::hasSameUniforms(const DrawCall& other) const
+{
+	return _uniforms			== other._uniforms
+		&& _sharedUniforms	== other._sharedUniforms;
+}
+
+bool
+DrawCall::hasSameStates(const DrawCall& other) const
+{
+	return _colorMask			== other._colorMask
+		&& _blendMode			== other._blendMode
+		&& _depthMask			== other._depthMask
+		&& _depthFunc			== other._depthFunc
+		&& _stencilFunc			== other._stencilFunc
+		&& _stencilRef			== other._stencilRef
+		&& _stencilMask			== other._stencilMask
+		&& _stencilFailOp		== other._stencilFailOp
+		&& _stencilZFailOp		== other._stencilZFailOp
+		&& _stencilZPassOp		== other._stencilZPassOp
+		&& _scissorTest			== other._scissorTest
+		&& _scissorBox.x		== other._scissorBox.x
+		&& _scissorBox.y		== other._scissorBox.y
+		&& _scissorBox.width	== other._scissorBox.width
+		&& _scissorBox.height	== other._scissorBox.height
+		&& _triangleCulling		== other._triangleCulling;
 }
 
 Container::Ptr
@@ -703,3 +1113,9 @@ DrawCall::getEyeSpacePosition(Vector3::Ptr output)
 {
 	return _zSorter->getEyeSpacePosition(output);
 }
+
+float
+DrawCall::getEyeSpaceDepth()
+{
+	return _zSorter->getEyeSpaceDepth();
+}
@@ -28,6 +28,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/render/Blending.hpp"
 #include "minko/geometry/Geometry.hpp"
 #include "minko/data/ArrayProvider.hpp"
+#include "minko/Profiler.hpp"
 
 using namespace minko;
 using namespace minko::math;
@@ -36,23 +37,27 @@ using namespace minko::component;
 using namespace minko::data;
 
 /*static*/ const unsigned int								DrawCallPool::NUM_FALLBACK_ATTEMPTS		= 32;
-/*static*/ std::unordered_map<DrawCall::Ptr, Vector3::Ptr>	DrawCallPool::_cachedDrawcallPositions;
 
-std::unordered_map<std::string, std::pair<std::string, int>> DrawCallPool::_variablePropertyNameToPosition;
-
-
-DrawCallPool::DrawCallPool(Renderer::Ptr renderer):
+DrawCallPool::DrawCallPool(Renderer::Ptr renderer, Effect::Ptr effect):
 	_renderer(renderer),
-	_mustZSort(true)
+	_effect(effect ? effect : renderer->effect()),
+	_mustZSort(true),
+	_mustSort(true),
+	_renderQueue(),
+	_sortKeys(),
+	_sortKeysBuffer(),
+	_layouts(),
+	_mustUpdateLayouts(false)
 {
 }
 
-const std::list<DrawCall::Ptr>&
+const std::vector<DrawCall::Ptr>&
 DrawCallPool::drawCalls()
 {
-	const bool doZSort = _mustZSort || !_toCollect.empty();
-	//if (_toCollect.empty() && _toRemove.empty())
-		//return _drawCalls;
+	MINKO_PROFILE_SCOPE("DrawCallPool::drawCalls");
+
+	if (!_pendingPrograms.empty())
+		updatePendingPrograms();
 
 	for (auto& surface : _toRemove)
 	{
@@ -61,78 +66,256 @@ DrawCallPool::drawCalls()
 	}
 	_toRemove.clear();
 
-	for (auto& surface : _toCollect)
-	{
-		auto& newDrawCalls = generateDrawCall(surface, NUM_FALLBACK_ATTEMPTS);
-		_drawCalls.insert(_drawCalls.end(), newDrawCalls.begin(), newDrawCalls.end());
-	}
-	_toCollect.clear();
+	if (!_toRetarget.empty())
+		retargetDrawCalls();
+
+	const bool doSort = _mustZSort || _mustSort || !_toCollect.empty();
 
-	if (doZSort)
+	if (!_toCollect.empty())
 	{
-		_cachedDrawcallPositions.empty();
-		_drawCalls.sort(&DrawCallPool::compareDrawCalls);
+		std::vector<SurfacePtr> surfaces(_toCollect.begin(), _toCollect.end());
+
+		_toCollect.clear();
+
+		// surfaces sharing an effect and a technique are generated together to reuse the program
+		// variants and binding plans of their passes as soon as they are created
+		if (!_effect)
+			std::stable_sort(surfaces.begin(), surfaces.end(), [](const SurfacePtr& a, const SurfacePtr& b)
+			{
+				return a->effect() != b->effect() ? a->effect() < b->effect() : a->technique() < b->technique();
+			});
+
+		for (auto& surface : surfaces)
+		{
+			auto& newDrawCalls = generateDrawCall(surface, NUM_FALLBACK_ATTEMPTS);
+			_drawCalls.insert(_drawCalls.end(), newDrawCalls.begin(), newDrawCalls.end());
+			updateDrawCallsEnabled(surface);
+		}
 	}
+
+	if (doSort)
+		buildRenderQueue();
+	if (doSort || _mustUpdateLayouts)
+		updateLayouts();
 	_mustZSort = false;
+	_mustSort = false;
 
-	return _drawCalls;
+	return _renderQueue;
 }
 
-/*static*/
-bool
-DrawCallPool::compareDrawCalls(DrawCall::Ptr a, 
-							   DrawCall::Ptr b)
+void
+DrawCallPool::buildRenderQueue()
 {
-	const float	aPriority			= a->priority();
-	const float	bPriority			= b->priority();
-	const bool	arePrioritiesEqual	= fabsf(aPriority - bPriority) < 1e-3f;
+	// Sort key layout (most significant bits first):
+	// [63..56] priority rank (higher priorities first)
+	// [55..48] render target rank (render to texture before the back buffer)
+	// [47]     z-sorted flag
+	// z-sorted:     [46..23] depth bucket (back to front), [22..7] program, [6..0] texture
+	// not z-sorted: [46..31] program, [30..15] texture, [14..0] index buffer
+	// front to back: [46..39] coarse depth bucket (front to back), [38..23] program, [22..7] texture, [6..0] index buffer
+
+	std::vector<float>	priorities;
+	std::vector<uint>	targets;
+	const bool			frontToBack		= _renderer->frontToBack();
+	float				minDepth		= std::numeric_limits<float>::max();
+	float				maxDepth		= -std::numeric_limits<float>::max();
+	float				minOpaqueDepth	= std::numeric_limits<float>::max();
+	float				maxOpaqueDepth	= -std::numeric_limits<float>::max();
+	uint				drawCallIndex	= 0;
+
+	_depths.assign(_drawCalls.size(), 0.f);
+
+	_renderQueue.assign(_drawCalls.begin(), _drawCalls.end());
+
+	for (auto& drawCall : _renderQueue)
+	{
+		priorities.push_back(drawCall->priority());
+		if (drawCall->target())
+			targets.push_back(drawCall->target()->id());
+
+		if (drawCall->zSorted())
+		{
+			const float depth = drawCall->getEyeSpaceDepth();
 
-	if (!arePrioritiesEqual)
-		return aPriority > bPriority;
+			_depths[drawCallIndex] = depth;
+			minDepth = std::min(minDepth, depth);
+			maxDepth = std::max(maxDepth, depth);
+		}
+		else if (frontToBack)
+		{
+			const float depth = drawCall->getEyeSpaceDepth();
 
-	if (a->zSorted() || b->zSorted())
+			_depths[drawCallIndex] = depth;
+			minOpaqueDepth = std::min(minOpaqueDepth, depth);
+			maxOpaqueDepth = std::max(maxOpaqueDepth, depth);
+		}
+		++drawCallIndex;
+	}
+
+	std::sort(priorities.begin(), priorities.end(), std::greater<float>());
+	priorities.erase(
+		std::unique(priorities.begin(), priorities.end(), [](float a, float b){ return fabsf(a - b) < 1e-3f; }),
+		priorities.end()
+	);
+	std::sort(targets.begin(), targets.end(), std::greater<uint>());
+	targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+
+	const float depthScale			= maxDepth > minDepth ? float(0xffffff) / (maxDepth - minDepth) : 0.f;
+	const float opaqueDepthScale	= maxOpaqueDepth > minOpaqueDepth ? float(0xff) / (maxOpaqueDepth - minOpaqueDepth) : 0.f;
+
+	_sortKeys.resize(_renderQueue.size());
+
+	for (uint i = 0; i < _renderQueue.size(); ++i)
 	{
-		static Vector3::Ptr aPosition = Vector3::create();
-		static Vector3::Ptr bPosition = Vector3::create();
+		const auto&	drawCall		= _renderQueue[i];
+		const float	priority		= drawCall->priority();
+		const auto	priorityIt		= std::find_if(priorities.begin(), priorities.end(), [&](float p){ return fabsf(p - priority) < 1e-3f; });
+		uint64_t	priorityRank	= std::min<uint64_t>(priorityIt - priorities.begin(), 0xff);
+		uint64_t	targetRank		= 0xff;
+		uint64_t	programId		= drawCall->program() ? drawCall->program()->id() & 0xffff : 0;
+		uint64_t	textureId		= 0;
+
+		if (drawCall->target())
+			targetRank = std::min<uint64_t>(
+				std::lower_bound(targets.begin(), targets.end(), drawCall->target()->id(), std::greater<uint>()) - targets.begin(),
+				0xfe
+			);
+
+		for (auto id : drawCall->textureIds())
+			if (id > 0)
+			{
+				textureId = id;
+				break;
+			}
 
-		getDrawcallEyePosition(a, aPosition);
-		getDrawcallEyePosition(b, bPosition);
+		uint64_t key = (priorityRank << 56) | (targetRank << 48);
 
-		return aPosition->z() > bPosition->z();
+		if (drawCall->zSorted())
+		{
+			const uint64_t depthBucket = uint64_t((maxDepth - _depths[i]) * depthScale) & 0xffffff;
+
+			key |= (uint64_t(1) << 47) | (depthBucket << 23) | (programId << 7) | (textureId & 0x7f);
+		}
+		else if (frontToBack)
+		{
+			// a few buckets keep most of the state sorting while the nearest occluders are drawn first
+			const uint64_t depthBucket = uint64_t((_depths[i] - minOpaqueDepth) * opaqueDepthScale) & 0xff;
+
+			key |= (depthBucket << 39) | (programId << 23) | ((textureId & 0xffff) << 7) | (drawCall->indexBuffer() & 0x7f);
+		}
+		else
+			key |= (programId << 31) | ((textureId & 0xffff) << 15) | (drawCall->indexBuffer() & 0x7fff);
+
+		_sortKeys[i] = SortKeyAndIndex(key, i);
 	}
-	else
+
+	radixSort(_sortKeys, _sortKeysBuffer);
+
+	DrawCallQueue	sorted;
+	DrawCallPtr		instancesLeader = nullptr;
+
+	sorted.reserve(_renderQueue.size());
+
+	for (uint i = 0; i < _sortKeys.size(); ++i)
 	{
-		// ordered by target texture id, if any
-		return a->target() && (!b->target() || (a->target()->id() > b->target()->id()));
+		auto& drawCall = _renderQueue[_sortKeys[i].second];
+
+		drawCall->clearInstances();
+
+		// adjacent draw calls with the same bindings but their transform are rendered by a single instanced draw
+		if (!drawCall->enabled())
+			sorted.push_back(drawCall);
+		else if (instancesLeader && !drawCall->zSorted() && instancesLeader->canBeInstancedWith(*drawCall))
+			instancesLeader->addInstance(drawCall);
+		else
+		{
+			sorted.push_back(drawCall);
+			instancesLeader = drawCall->instanced() && !drawCall->zSorted() ? drawCall : nullptr;
+		}
 	}
+
+	_renderQueue.swap(sorted);
+}
+
+void
+DrawCallPool::updateLayouts()
+{
+	_layouts.resize(_renderQueue.size());
+	for (uint i = 0; i < _renderQueue.size(); ++i)
+		_layouts[i] = _renderQueue[i]->layouts();
+
+	_mustUpdateLayouts = false;
 }
 
 /*static*/
-Vector3::Ptr
-DrawCallPool::getDrawcallEyePosition(DrawCall::Ptr drawcall, 
-									 Vector3::Ptr output)
+void
+DrawCallPool::radixSort(std::vector<SortKeyAndIndex>& keys,
+						std::vector<SortKeyAndIndex>& buffer)
 {
-	const auto foundPositionIt = _cachedDrawcallPositions.find(drawcall);
+	const uint numKeys = keys.size();
+
+	if (numKeys < 2)
+		return;
+
+	buffer.resize(numKeys);
 
-	if (foundPositionIt != _cachedDrawcallPositions.end())
+	// LSD radix sort on 8-bit digits, skipping digits shared by all the keys
+	for (uint shift = 0; shift < 64; shift += 8)
 	{
-		if (output == nullptr)
-			output = Vector3::create(foundPositionIt->second);
-		else
-			output->copyFrom(foundPositionIt->second);
+		uint offsets[257] = { 0 };
+
+		for (auto& key : keys)
+			++offsets[((key.first >> shift) & 0xff) + 1];
+
+		if (offsets[((keys[0].first >> shift) & 0xff) + 1] == numKeys)
+			continue;
 
-		return output;
+		for (uint i = 1; i < 257; ++i)
+			offsets[i] += offsets[i - 1];
+
+		for (auto& key : keys)
+			buffer[offsets[(key.first >> shift) & 0xff]++] = key;
+
+		keys.swap(buffer);
 	}
-	else
-		return drawcall->getEyeSpacePosition(output);
 }
 
 void
 DrawCallPool::addSurface(Surface::Ptr surface)
+{
+	watchSurface(surface, shared_from_this());
+
+	// invisible surfaces get disabled draw calls, showing them later does not generate anything
+	_toCollect.insert(surface);
+}
+
+void
+DrawCallPool::addSurfaces(const std::vector<Surface::Ptr>& surfaces)
+{
+	if (surfaces.empty())
+		return;
+
+	auto that = shared_from_this();
+
+	_surfaceToTechniqueChangedSlot.reserve(_surfaceToTechniqueChangedSlot.size() + surfaces.size());
+	_surfaceToVisibilityChangedSlot.reserve(_surfaceToVisibilityChangedSlot.size() + 2 * surfaces.size());
+	_surfaceToIndexChangedSlot.reserve(_surfaceToIndexChangedSlot.size() + 2 * surfaces.size());
+	_techniqueToMacroNames.reserve(_techniqueToMacroNames.size() + surfaces.size());
+	_surfaceToDrawCalls.reserve(_surfaceToDrawCalls.size() + surfaces.size());
+
+	for (auto& surface : surfaces)
+	{
+		watchSurface(surface, that);
+		_toCollect.insert(surface);
+	}
+}
+
+void
+DrawCallPool::watchSurface(Surface::Ptr surface, Ptr that)
 {
 	_surfaceToTechniqueChangedSlot[surface] = surface->techniqueChanged()->connect(std::bind(
 		&DrawCallPool::techniqueChanged,
-		shared_from_this(),
+		that,
 		std::placeholders::_1,
 		std::placeholders::_2,
 		std::placeholders::_3));
@@ -141,42 +324,43 @@ DrawCallPool::addSurface(Surface::Ptr surface)
 
 	_surfaceToVisibilityChangedSlot.insert(std::pair<SurfacePtr, VisibilityChangedSlot>(surface, surface->visibilityChanged()->connect(std::bind(
 		&DrawCallPool::visibilityChanged,
-		shared_from_this(),
+		that,
 		std::placeholders::_1,
 		std::placeholders::_2,
 		std::placeholders::_3))));
 
 	_surfaceToVisibilityChangedSlot.insert(std::pair<SurfacePtr, VisibilityChangedSlot>(surface, surface->computedVisibilityChanged()->connect(std::bind(
 		&DrawCallPool::visibilityChanged,
-		shared_from_this(),
+		that,
 		std::placeholders::_1,
 		std::placeholders::_2,
 		std::placeholders::_3))));
 
 	_surfaceToIndexChangedSlot.insert(std::pair<SurfacePtr, ArrayProviderIndexChangedSlot>(surface, surface->geometry()->data()->indexChanged()->connect(std::bind(
 		&DrawCallPool::dataProviderIndexChanged,
-		shared_from_this(),
+		that,
 		std::placeholders::_1,
 		std::placeholders::_2,
 		surface
 		))));
 
+	if (!surface->targets().empty())
+		_surfaceToLayoutsChangedSlot[surface] = surface->targets()[0]->layoutsChanged()->connect(std::bind(
+			&DrawCallPool::layoutsChanged,
+			that,
+			surface
+		));
+
 	auto arrayProviderMaterial = std::dynamic_pointer_cast<data::ArrayProvider>(surface->material());
 
 	if (arrayProviderMaterial)
 		_surfaceToIndexChangedSlot.insert(std::pair<SurfacePtr, ArrayProviderIndexChangedSlot>(surface, arrayProviderMaterial->indexChanged()->connect(std::bind(
 		&DrawCallPool::dataProviderIndexChanged,
-		shared_from_this(),
+		that,
 		std::placeholders::_1,
 		std::placeholders::_2,
 		surface
 		))));
-
-	//if (std::find(_toCollect.begin(), _toCollect.end(), surface) == _toCollect.end())
-	if (surface->visible(_renderer))
-		_toCollect.insert(surface);
-	else
-		_invisibleSurfaces.insert(surface);
 }
 
 void
@@ -193,7 +377,7 @@ DrawCallPool::dataProviderIndexChanged(std::shared_ptr<data::ArrayProvider> prov
 void
 DrawCallPool::removeSurface(Surface::Ptr surface)
 {
-	auto surfaceToCollectIt = std::find(_toCollect.begin(), _toCollect.end(), surface);
+	auto surfaceToCollectIt = _toCollect.find(surface);
 
 	if (surfaceToCollectIt == _toCollect.end())
 		_toRemove.insert(surface);
@@ -211,6 +395,8 @@ DrawCallPool::cleanSurface(Surface::Ptr	surface)
 	_numMacroListeners[surface].clear();
 	_drawcallToZSortNeededSlots.erase(surface);
 	_surfaceToIndexChangedSlot.erase(surface);
+	_surfaceToLayoutsChangedSlot.erase(surface);
+	_toRetarget.erase(surface);
 }
 
 void
@@ -219,7 +405,7 @@ DrawCallPool::techniqueChanged(Surface::Ptr			surface,
 							   bool					updateDrawCall)
 {
 	deleteDrawCalls(surface);
-	if (updateDrawCall && std::find(_toCollect.begin(), _toCollect.end(), surface) == _toCollect.end())
+	if (updateDrawCall && _toCollect.count(surface) == 0)
 		_toCollect.insert(surface);
 }
 
@@ -231,19 +417,48 @@ DrawCallPool::visibilityChanged(Surface::Ptr	surface,
 	if (renderer != _renderer && renderer != nullptr)
 		return;
 
-	bool visible = surface->visible(_renderer) && surface->computedVisibility(_renderer);
+	updateDrawCallsEnabled(surface);
+}
 
-	if (visible && _invisibleSurfaces.find(surface) != _invisibleSurfaces.end()) // visible and already wasn't visible before
-	{
-		_toCollect.insert(surface);
-		_invisibleSurfaces.erase(surface);
-	}
-	else if (!visible && _invisibleSurfaces.find(surface) == _invisibleSurfaces.end()) // not visible but was visible before
-	{
-		_toRemove.insert(surface);
-		_invisibleSurfaces.insert(surface);
-	}
-	
+void
+DrawCallPool::updateDrawCallsEnabled(Surface::Ptr surface)
+{
+	auto drawCallsIt = _surfaceToDrawCalls.find(surface);
+
+	if (drawCallsIt == _surfaceToDrawCalls.end())
+		return;
+
+	const bool visible = surface->visible(_renderer) && surface->computedVisibility(_renderer);
+
+	for (auto& drawCall : drawCallsIt->second)
+		if (drawCall->enabled() != visible)
+		{
+			drawCall->enabled(visible);
+			// instances are grouped when the queue is built
+			if (drawCall->instanced())
+				_mustSort = true;
+		}
+}
+
+void
+DrawCallPool::layoutsChanged(Surface::Ptr surface)
+{
+	auto drawCallsIt = _surfaceToDrawCalls.find(surface);
+
+	if (drawCallsIt == _surfaceToDrawCalls.end() || surface->targets().empty())
+		return;
+
+	const auto layouts = surface->targets()[0]->layouts();
+
+	for (auto& drawCall : drawCallsIt->second)
+		if (drawCall->layouts() != layouts)
+		{
+			drawCall->layouts(layouts);
+			_mustUpdateLayouts = true;
+			// instances are grouped by layouts when the queue is built
+			if (drawCall->instanced())
+				_mustSort = true;
+		}
 }
 
 DrawCallPool::DrawCallList&
@@ -257,13 +472,13 @@ DrawCallPool::generateDrawCall(Surface::Ptr	surface,
 	std::shared_ptr<render::Effect> drawCallEffect			= surface->effect();
 	std::string						technique				= surface->technique();
 
-	if (_renderer->effect())
+	if (_effect)
 	{
-		drawCallEffect	= _renderer->effect();
-		technique		= _renderer->effect()->techniques().begin()->first;
+		drawCallEffect	= _effect;
+		technique		= _effect->techniques().begin()->first;
 	}
 
-	_surfaceToDrawCalls	[surface] = std::list<DrawCall::Ptr>();
+	_surfaceToDrawCalls	[surface] = DrawCallList();
 
 	for (const auto& pass : drawCallEffect->technique(technique))
 	{
@@ -271,6 +486,7 @@ DrawCallPool::generateDrawCall(Surface::Ptr	surface,
 
 		if (drawCall)
 		{
+			drawCall->layouts(surface->targets()[0]->layouts());
 			_surfaceToDrawCalls[surface].push_back(drawCall);
 
 			_drawcallToZSortNeededSlots[surface][drawCall] = drawCall->zsortNeeded()->connect(std::bind(	
@@ -324,10 +540,11 @@ DrawCallPool::initializeDrawCall(Pass::Ptr		pass,
 	const auto	rootData	= target->root()->data();
 	bool		firstInit	= false;
 
-	Effect::Ptr						effect = _renderer->effect() ? _renderer->effect() : surface->effect();
+	Effect::Ptr						effect = _effect ? _effect : surface->effect();
 	std::list<ContainerProperty>	booleanMacros;
 	std::list<ContainerProperty>	integerMacros;
 	std::list<ContainerProperty>	incorrectIntegerMacros;
+	Program::Ptr					pendingProgram;
 	std::unordered_map<std::string, std::string> drawCallVariables;
 
 	if (drawcall)
@@ -348,6 +565,7 @@ DrawCallPool::initializeDrawCall(Pass::Ptr		pass,
 			_formatFunction,
 			drawCallVariables
 		);
+		drawcall->profileName(Profiler::intern("Pass " + pass->name()));
 
 		firstInit = true;
 	}
@@ -361,10 +579,14 @@ DrawCallPool::initializeDrawCall(Pass::Ptr		pass,
 		rootData,
 		booleanMacros,
 		integerMacros,
-		incorrectIntegerMacros);
+		incorrectIntegerMacros,
+		pendingProgram);
 
 	if (!program)
 		return nullptr;
+
+	if (pendingProgram)
+		_pendingPrograms.push_back(std::make_tuple(pendingProgram, surface, drawcall));
 	
 	if (firstInit)
 	{
@@ -372,6 +594,13 @@ DrawCallPool::initializeDrawCall(Pass::Ptr		pass,
 		_drawCallToPass[surface][drawcall]			= pass;
 		_drawCallToRendererData[surface][drawcall]	= rendererData;
 
+		if (_passToReloadedSlot.count(pass) == 0)
+			_passToReloadedSlot[pass] = pass->reloaded()->connect(std::bind(
+				&DrawCallPool::passReloadedHandler,
+				shared_from_this(),
+				std::placeholders::_1
+			));
+
 		for (auto& technique : effect->techniques())
 		{
 			auto& techniqueName = technique.first;
@@ -405,7 +634,9 @@ DrawCallPool::initializeDrawCall(Pass::Ptr		pass,
 		}
 	}
 
-	drawcall->configure(program, targetData, rendererData, rootData);
+	// the bindings of a draw call kept on the same program variant are still valid
+	if (firstInit || program != drawcall->program())
+		drawcall->configure(program, targetData, rendererData, rootData, pass->bindingPlan(program));
 
 	return drawcall;
 }
@@ -419,7 +650,8 @@ DrawCallPool::getWorkingProgram(Surface::Ptr					surface,
 								ContainerPtr					rootData,
 								std::list<ContainerProperty>&	booleanMacros,
 								std::list<ContainerProperty>&	integerMacros,
-								std::list<ContainerProperty>&	incorrectIntegerMacros)
+								std::list<ContainerProperty>&	incorrectIntegerMacros,
+								Program::Ptr&					pendingProgram)
 {
 	Program::Ptr program = nullptr;
 
@@ -432,7 +664,8 @@ DrawCallPool::getWorkingProgram(Surface::Ptr					surface,
 			rootData,
 			booleanMacros, 
 			integerMacros, 
-			incorrectIntegerMacros
+			incorrectIntegerMacros,
+			pendingProgram
 		);
 
 #ifdef DEBUG_FALLBACK
@@ -471,6 +704,92 @@ DrawCallPool::getWorkingProgram(Surface::Ptr					surface,
 	return program;
 }
 
+void
+DrawCallPool::updatePendingPrograms()
+{
+	for (auto it = _pendingPrograms.begin(); it != _pendingPrograms.end(); )
+	{
+		auto& program	= std::get<0>(*it);
+		auto& surface	= std::get<1>(*it);
+		auto& drawCall	= std::get<2>(*it);
+
+		auto drawCallToPassIt = _drawCallToPass.find(surface);
+
+		// the draw call was deleted or reinitialized with another program meanwhile
+		if (drawCallToPassIt == _drawCallToPass.end() || drawCallToPassIt->second.count(drawCall) == 0
+			|| drawCall->program() == program)
+		{
+			it = _pendingPrograms.erase(it);
+			continue;
+		}
+
+		if (!program->isLinked())
+		{
+			++it;
+			continue;
+		}
+
+		auto pass = drawCallToPassIt->second[drawCall];
+
+		it = _pendingPrograms.erase(it);
+		initializeDrawCall(pass, surface, drawCall);
+		_mustSort = true;
+	}
+}
+
+void
+DrawCallPool::retargetDrawCalls()
+{
+	for (auto& surfaceAndDrawCalls : _toRetarget)
+	{
+		auto surface = surfaceAndDrawCalls.first;
+
+		// draw calls of the surface will be regenerated anyway
+		if (_toCollect.count(surface) != 0)
+			continue;
+
+		auto	drawCallToPassIt	= _drawCallToPass.find(surface);
+		bool	failed				= false;
+
+		if (drawCallToPassIt == _drawCallToPass.end())
+			continue;
+
+		for (auto& drawCall : surfaceAndDrawCalls.second)
+		{
+			auto passIt = drawCallToPassIt->second.find(drawCall);
+
+			if (passIt == drawCallToPassIt->second.end())
+				continue;
+
+			auto previousProgram = drawCall->program();
+
+			if (!initializeDrawCall(passIt->second, surface, drawCall))
+				failed = true;
+			else if (drawCall->program() != previousProgram)
+				_mustSort = true;
+		}
+
+		if (failed)
+		{
+			auto effect = _effect ? _effect : surface->effect();
+
+			if (effect->hasFallback(surface->technique()))
+				surface->setTechnique(effect->fallback(surface->technique()), true);
+		}
+	}
+	_toRetarget.clear();
+}
+
+void
+DrawCallPool::passReloadedHandler(Pass::Ptr pass)
+{
+	// the draw calls select their program among the new variants at next frame
+	for (auto& surfaceAndDrawCalls : _drawCallToPass)
+		for (auto& drawCallAndPass : surfaceAndDrawCalls.second)
+			if (drawCallAndPass.second == pass)
+				_toRetarget[surfaceAndDrawCalls.first].insert(drawCallAndPass.first);
+}
+
 void
 DrawCallPool::deleteDrawCalls(Surface::Ptr surface)
 {
@@ -498,6 +817,7 @@ DrawCallPool::deleteDrawCalls(Surface::Ptr surface)
 		}
 
 		_drawCalls.remove(drawCall);
+		_mustSort = true;
 	}
 
 	// erase in a subsequent step the entries corresponding to macro names which do not monitor any drawcall anymore.
@@ -517,27 +837,15 @@ DrawCallPool::macroChangedHandler(Container::Ptr		container,
 								  MacroChange			change)
 {
 	const ContainerProperty	macro(propertyName, container);
-	Effect::Ptr				effect = (_renderer->effect() ? _renderer->effect() : surface->effect());
 
 	if (change == MacroChange::REF_CHANGED && !_surfaceToDrawCalls[surface].empty())
 	{
-		const DrawCallList					drawCalls = _macroNameToDrawCalls[surface][macro.name()];
-		std::unordered_set<Container::Ptr>	failedDrawcallRendererData;
-
-		for (auto& drawCall : drawCalls)
-		{
-			auto rendererData	= _drawCallToRendererData[surface][drawCall];
-			auto pass			= _drawCallToPass[surface][drawCall];
-	
-			if (!initializeDrawCall(pass, surface, drawCall))
-				failedDrawcallRendererData.insert(rendererData);
-		}
+		// several macros usually change together (ie. when a light is added): only the last
+		// program variant is selected, once per draw call
+		const auto drawCallsIt = _macroNameToDrawCalls[surface].find(macro.name());
 
-		if (!failedDrawcallRendererData.empty())
-		{
-			if (effect->hasFallback(surface->technique()))
-				surface->setTechnique(effect->fallback(surface->technique()), true);
-		}
+		if (drawCallsIt != _macroNameToDrawCalls[surface].end())
+			_toRetarget[surface].insert(drawCallsIt->second.begin(), drawCallsIt->second.end());
 	}
 	else if (_techniqueToMacroNames[surface].count(surface->technique()) != 0 
 		&&   _techniqueToMacroNames[surface][surface->technique()].find(macro.name()) != _techniqueToMacroNames[surface][surface->technique()].end())
@@ -739,7 +1047,8 @@ void
 DrawCallPool::zsortNeededHandler(Surface::Ptr	surface, 
 								 DrawCall::Ptr	drawcall)
 {
-	_mustZSort = true;
+	if (drawcall->zSorted() || _renderer->frontToBack())
+		_mustZSort = true;
 }
 
 
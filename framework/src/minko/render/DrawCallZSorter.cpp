@@ -31,7 +31,14 @@ using namespace minko::render;
 using namespace minko::math;
 
 // names of the properties that may cause a z-sort change between drawcalls
-/*static*/ const DrawCallZSorter::PropertyInfos	DrawCallZSorter::_rawProperties = initializeRawProperties();
+/*static*/
+const DrawCallZSorter::PropertyInfos&
+DrawCallZSorter::rawProperties()
+{
+	static const auto props = initializeRawProperties();
+
+	return props;
+}
 
 /*static*/
 DrawCallZSorter::PropertyInfos
@@ -74,7 +81,7 @@ DrawCallZSorter::initialize(Container::Ptr targetData,
 	clear();
 
 	// format raw property name to fit with the current
-	for (auto& prop : _rawProperties)
+	for (auto& prop : rawProperties())
 		_properties[_drawcall->formatPropertyName(prop.first)] = prop.second;
 
 	_vertexPositions.first		= _drawcall->formatPropertyName("geometry[${geometryId}].position");
@@ -192,8 +199,8 @@ DrawCallZSorter::propertyRemovedHandler(Container::Ptr		container,
 void
 DrawCallZSorter::requestZSort()
 {
-	if (_drawcall->zSorted())
-		_drawcall->zsortNeeded()->execute(_drawcall); // temporary ugly solution
+	// opaque draw calls are sorted as well when their renderer renders front to back
+	_drawcall->zsortNeeded()->execute(_drawcall); // temporary ugly solution
 }
 
 void
@@ -244,4 +251,28 @@ DrawCallZSorter::getEyeSpacePosition(Vector3::Ptr output)  const
 	output = modelView->transform(localPos, output);
 	
 	return output;
-}
\ No newline at end of file
+}
+
+float
+DrawCallZSorter::getEyeSpaceDepth() const
+{
+	static auto center		= Vector3::create();
+	float		position[4]	= { 0.0f, 0.0f, 0.0f, 1.0f };
+
+	if (_vertexPositions.second)
+	{
+		_vertexPositions.second->centerPosition(center);
+		position[0] = center->x();
+		position[1] = center->y();
+		position[2] = center->z();
+	}
+
+	// same as getEyeSpacePosition() without the model to view matrix product
+	if (_modelToWorldMatrix.second)
+		Matrix4x4::transform(&_modelToWorldMatrix.second->data()[0], position, 1.0f, position);
+
+	if (_worldToScreenMatrix.second)
+		Matrix4x4::transform(&_worldToScreenMatrix.second->data()[0], position, 1.0f, position);
+
+	return position[2];
+}
@@ -58,7 +58,6 @@ namespace minko
 			typedef std::unordered_map<std::string, PropertyInfo>	PropertyInfos;								
 
 		private:	
-			static const PropertyInfos								_rawProperties;
 
 			const DrawCallPtr										_drawcall;
 
@@ -93,9 +92,17 @@ namespace minko
 			std::shared_ptr<math::Vector3>
 			getEyeSpacePosition(std::shared_ptr<math::Vector3> output = nullptr) const;
 
+			float
+			getEyeSpaceDepth() const;
+
 		private:
 			DrawCallZSorter(DrawCallPtr drawcall);
 
+			// built on the first use rather than during the static initialization
+			static
+			const PropertyInfos&
+			rawProperties();
+
 			static
 			PropertyInfos
 			initializeRawProperties();
@@ -0,0 +1,145 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/render/DynamicResolution.hpp"
+
+#include "minko/render/Texture.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+const uint DynamicResolution::NUM_COOLDOWN_FRAMES = 8;
+#if defined(__ANDROID_API__) || defined(TARGET_OS_IPHONE)
+// fill rate bound devices
+const float DynamicResolution::DEFAULT_MIN_SCALE = .5f;
+#else
+const float DynamicResolution::DEFAULT_MIN_SCALE = .7f;
+#endif
+const float DynamicResolution::DEFAULT_MAX_SCALE = 1.f;
+
+namespace
+{
+	// weight of the last frame time in the average
+	const float SMOOTHING = .2f;
+}
+
+DynamicResolution::DynamicResolution(EffectPtr effect, float targetFrameTime) :
+	_effect(effect),
+	_targetFrameTime(targetFrameTime),
+	_minScale(DEFAULT_MIN_SCALE),
+	_maxScale(DEFAULT_MAX_SCALE),
+	_step(.05f),
+	_hysteresis(.15f),
+	_scale(DEFAULT_MAX_SCALE),
+	_averageFrameTime(0.f),
+	_numFrames(0),
+	_cooldown(0),
+	_target(nullptr),
+	_targetWidth(0),
+	_targetHeight(0)
+{
+}
+
+DynamicResolution::~DynamicResolution()
+{
+	if (_target)
+		_target->dispose();
+}
+
+void
+DynamicResolution::minScale(float value)
+{
+	if (value <= 0.f || value > _maxScale)
+		throw std::invalid_argument("value");
+
+	_minScale = value;
+	_scale = std::max(_scale, value);
+}
+
+void
+DynamicResolution::maxScale(float value)
+{
+	if (value < _minScale || value > 1.f)
+		throw std::invalid_argument("value");
+
+	_maxScale = value;
+	_scale = std::min(_scale, value);
+}
+
+void
+DynamicResolution::scale(float value)
+{
+	_scale = std::max(_minScale, std::min(_maxScale, value));
+	_cooldown = NUM_COOLDOWN_FRAMES;
+	_numFrames = 0;
+}
+
+void
+DynamicResolution::update(float frameTime)
+{
+	// the frames measured meanwhile may have been rendered at the previous scale
+	if (_cooldown != 0)
+	{
+		--_cooldown;
+
+		return;
+	}
+
+	_averageFrameTime = _numFrames == 0
+		? frameTime
+		: _averageFrameTime + (frameTime - _averageFrameTime) * SMOOTHING;
+	++_numFrames;
+
+	auto scale = _scale;
+
+	if (_averageFrameTime > _targetFrameTime)
+	{
+		// the fill cost is proportional to the number of pixels, i.e. to the square of the scale
+		scale = std::floor(_scale * std::sqrt(_targetFrameTime / _averageFrameTime) / _step) * _step;
+		scale = std::min(scale, _scale - _step);
+	}
+	else if (_averageFrameTime < _targetFrameTime * (1.f - _hysteresis))
+		scale = _scale + _step;
+
+	scale = std::max(_minScale, std::min(_maxScale, scale));
+
+	if (scale != _scale)
+	{
+		_scale = scale;
+		_cooldown = NUM_COOLDOWN_FRAMES;
+		_numFrames = 0;
+	}
+}
+
+Texture::Ptr
+DynamicResolution::target(AbstractContextPtr context, uint width, uint height)
+{
+	if (_target && _targetWidth == width && _targetHeight == height)
+		return _target;
+
+	if (_target)
+		_target->dispose();
+
+	_target = Texture::create(context, width, height, false, true);
+	_target->upload();
+	_targetWidth = width;
+	_targetHeight = height;
+
+	return _target;
+}
@@ -22,6 +22,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/render/Pass.hpp"
 #include "minko/data/Provider.hpp"
 
+#include "json/json.h"
+
 using namespace minko;
 using namespace minko::render;
 
@@ -74,3 +76,111 @@ Effect::removeTechnique(const std::string& name)
 	_techniques.erase(name);
 	_fallback.erase(name);
 }
+
+// the macro layout gives the meaning of each signature bit: variants recorded with a different
+// layout (ie. another pass definition) cannot be replayed
+static
+Json::Value
+macroLayout(Pass::Ptr pass)
+{
+	Json::Value layout(Json::arrayValue);
+
+	for (auto& macroBinding : pass->macroBindings())
+		layout.append(macroBinding.first);
+
+	return layout;
+}
+
+std::string
+Effect::variantsManifest()
+{
+	Json::Value root(Json::objectValue);
+
+	for (auto& technique : _techniques)
+	{
+		Json::Value passes(Json::arrayValue);
+
+		for (auto& pass : technique.second)
+		{
+			Json::Value passValue(Json::objectValue);
+			Json::Value variants(Json::arrayValue);
+
+			passValue["macros"] = macroLayout(pass);
+
+			for (auto& signatureAndDefines : pass->variants())
+			{
+				Json::Value variant(Json::objectValue);
+				Json::Value values(Json::arrayValue);
+				const auto& signature = signatureAndDefines.first;
+
+				for (auto value : signature.values())
+					values.append(value);
+
+				variant["mask"] = signature.mask();
+				variant["values"] = values;
+				variant["defines"] = signatureAndDefines.second;
+				variants.append(variant);
+			}
+
+			passValue["variants"] = variants;
+			passes.append(passValue);
+		}
+
+		root[technique.first] = passes;
+	}
+
+	return Json::FastWriter().write(root);
+}
+
+std::list<Effect::Variant>
+Effect::variantsFromManifest(const std::string& manifest)
+{
+	Json::Value root;
+	Json::Reader reader;
+	std::list<Variant> variants;
+
+	if (!reader.parse(manifest, root, false) || !root.isObject())
+		throw std::invalid_argument("manifest");
+
+	for (auto& technique : _techniques)
+	{
+		auto passes = root.get(technique.first, Json::Value(Json::arrayValue));
+
+		for (uint i = 0; i < technique.second.size() && i < passes.size(); ++i)
+		{
+			auto pass = technique.second[i];
+			auto passValue = passes[i];
+
+			if (passValue.get("macros", Json::Value()) != macroLayout(pass))
+				continue;
+
+			for (auto& variant : passValue.get("variants", Json::Value(Json::arrayValue)))
+			{
+				std::vector<int> values;
+
+				for (auto& value : variant.get("values", Json::Value(Json::arrayValue)))
+					values.push_back(value.asInt());
+
+				variants.push_back(Variant(
+					pass,
+					ProgramSignature(variant.get("mask", 0u).asUInt(), values),
+					variant.get("defines", "").asString()
+				));
+			}
+		}
+	}
+
+	return variants;
+}
+
+uint
+Effect::precompileVariants(const std::string& manifest)
+{
+	uint numCompiled = 0;
+
+	for (auto& variant : variantsFromManifest(manifest))
+		if (std::get<0>(variant)->precompileVariant(std::get<1>(variant), std::get<2>(variant)))
+			++numCompiled;
+
+	return numCompiled;
+}
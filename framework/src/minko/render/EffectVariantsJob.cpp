@@ -0,0 +1,79 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/render/EffectVariantsJob.hpp"
+
+#include "minko/render/Pass.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+EffectVariantsJob::EffectVariantsJob(EffectPtr effect, const std::string& manifest) :
+	_effect(effect),
+	_manifest(manifest),
+	_variants(),
+	_numCompiled(0),
+	_finished(Signal<Ptr, uint>::create())
+{
+	if (!effect)
+		throw std::invalid_argument("effect");
+}
+
+bool
+EffectVariantsJob::complete()
+{
+	return _variants.empty();
+}
+
+void
+EffectVariantsJob::beforeFirstStep()
+{
+	_numCompiled = 0;
+	_variants = _effect->variantsFromManifest(_manifest);
+}
+
+void
+EffectVariantsJob::step()
+{
+	// some variants may have been created since the manifest was loaded: skip to the next missing one
+	while (!_variants.empty())
+	{
+		auto variant = _variants.front();
+
+		_variants.pop_front();
+
+		if (std::get<0>(variant)->precompileVariant(std::get<1>(variant), std::get<2>(variant)))
+		{
+			++_numCompiled;
+			break;
+		}
+	}
+}
+
+float
+EffectVariantsJob::priority()
+{
+	return 1.f;
+}
+
+void
+EffectVariantsJob::afterLastStep()
+{
+	_finished->execute(shared_from_this(), _numCompiled);
+}
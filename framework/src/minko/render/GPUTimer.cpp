@@ -0,0 +1,131 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/render/GPUTimer.hpp"
+
+#include "minko/render/AbstractContext.hpp"
+#include "minko/Profiler.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+const uint GPUTimer::MAX_NUM_PENDING_QUERIES = 256;
+
+GPUTimer::GPUTimer(AbstractContextPtr context) :
+	_context(context),
+	_freeQueries(),
+	_pendingQueries(),
+	_running(false),
+	_gpuTime(0),
+	_frameId(0),
+	_accumulatedFrameId(0),
+	_accumulatedTime(0),
+	_frameTime(0)
+{
+	if (!context->supportsTimerQueries())
+		throw std::logic_error("timer queries are not supported.");
+}
+
+GPUTimer::~GPUTimer()
+{
+	if (_running)
+		_context->endTimerQuery();
+
+	for (auto query : _freeQueries)
+		_context->deleteTimerQuery(query);
+	for (auto& query : _pendingQueries)
+		_context->deleteTimerQuery(query.id);
+}
+
+void
+GPUTimer::begin(const char* name)
+{
+	end();
+
+	// the GPU is too far behind to keep timing it
+	if (_pendingQueries.size() >= MAX_NUM_PENDING_QUERIES)
+		return;
+
+	Query query;
+
+	if (_freeQueries.empty())
+		query.id = _context->createTimerQuery();
+	else
+	{
+		query.id = _freeQueries.back();
+		_freeQueries.pop_back();
+	}
+	query.name = name;
+	query.start = Profiler::time();
+	query.frame = _frameId;
+
+	_context->beginTimerQuery(query.id);
+	_pendingQueries.push_back(query);
+	_running = true;
+}
+
+void
+GPUTimer::end()
+{
+	if (!_running)
+		return;
+
+	_context->endTimerQuery();
+	_running = false;
+}
+
+void
+GPUTimer::update()
+{
+	// the running query is the last pending one and cannot be available yet
+	while (_pendingQueries.size() > (_running ? 1u : 0u))
+	{
+		auto& query = _pendingQueries.front();
+
+		if (!_context->isTimerQueryAvailable(query.id))
+			break;
+
+		uint64_t duration = 0;
+
+		// the GPU executes the commands in order: the events are laid out one after the other,
+		// starting no sooner than their commands were issued
+		if (_context->getTimerQueryResult(query.id, duration))
+		{
+			auto start = std::max(query.start, _gpuTime);
+
+			if (Profiler::enabled())
+				Profiler::gpuEvent(query.name, start, duration);
+			_gpuTime = start + duration;
+		}
+
+		// the first result of a frame completes the time of the previous one
+		if (query.frame != _accumulatedFrameId)
+		{
+			if (_accumulatedTime != 0)
+				_frameTime = _accumulatedTime;
+			_accumulatedFrameId = query.frame;
+			_accumulatedTime = 0;
+		}
+		_accumulatedTime += duration;
+
+		_freeQueries.push_back(query.id);
+		_pendingQueries.pop_front();
+	}
+}
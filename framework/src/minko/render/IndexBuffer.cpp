@@ -20,17 +20,119 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/render/IndexBuffer.hpp"
 
 #include "minko/render/AbstractContext.hpp"
+#include "minko/render/UploadThread.hpp"
 
 using namespace minko;
 using namespace minko::render;
 
 void
 IndexBuffer::upload(uint offset, uint count)
-{   
-	if (_id == -1)
-    	_id = _context->createIndexBuffer(_data.size());
-	
-	_context->uploaderIndexBufferData(_id, offset, count == 0 ? _data.size() : count, &_data[0]);
+{
+	if (dataDisposed())
+		throw std::logic_error("the indices were disposed, they have to be set again before being uploaded");
+
+	_numDisposedIndices = 0;
+	if (count == 0)
+		count = _data.size() - offset;
+
+	const bool useUnsignedInt = std::any_of(
+		_data.begin() + offset, _data.begin() + offset + count, [](uint index){ return index > 0xffff; }
+	);
+
+	if (allocate(useUnsignedInt))
+	{
+		offset = 0;
+		count = _data.size();
+	}
+
+	if (count == 0)
+		return;
+
+	if (_indexSize == sizeof(uint))
+		_context->uploaderIndexBufferData(_id, offset, count, &_data[offset]);
+	else
+	{
+		std::vector<unsigned short> shortData(_data.begin() + offset, _data.begin() + offset + count);
+
+		_context->uploaderIndexBufferData(_id, offset, count, &shortData[0]);
+	}
+}
+
+void
+IndexBuffer::uploadAsync(std::shared_ptr<UploadThread> uploadThread, std::function<void()> complete)
+{
+	if (uploadThread == nullptr || dataDisposed() || _data.empty())
+	{
+		upload();
+		if (complete)
+			complete();
+
+		return;
+	}
+
+	allocate(std::any_of(_data.begin(), _data.end(), [](uint index){ return index > 0xffff; }));
+
+	// the converted indices are kept alive by the completion callback until the GPU is done with them
+	std::shared_ptr<std::vector<unsigned char>> gpuData;
+
+	if (_indexSize == sizeof(uint))
+		gpuData = std::make_shared<std::vector<unsigned char>>(
+			reinterpret_cast<const unsigned char*>(&_data[0]),
+			reinterpret_cast<const unsigned char*>(&_data[0] + _data.size())
+		);
+	else
+	{
+		gpuData = std::make_shared<std::vector<unsigned char>>(_data.size() * sizeof(unsigned short));
+
+		std::copy(_data.begin(), _data.end(), reinterpret_cast<unsigned short*>(&(*gpuData)[0]));
+	}
+
+	uploadThread->uploadBufferData(
+		true,
+		_id,
+		0,
+		gpuData->size(),
+		&(*gpuData)[0],
+		[gpuData, complete]()
+		{
+			if (complete)
+				complete();
+		}
+	);
+}
+
+bool
+IndexBuffer::allocate(bool useUnsignedInt)
+{
+	const uint gpuSize = std::max((uint)_data.size(), _capacity);
+
+	// appending indices beyond the capacity changes the size of the buffer
+	if (_id != -1 && gpuSize != _gpuSize)
+		dispose();
+
+	// the buffer has to be re-created when uploading indices that do not fit in 16 bits anymore
+	if (_id != -1 && useUnsignedInt && _indexSize != sizeof(uint))
+		dispose();
+
+	if (_id != -1)
+		return false;
+
+	useUnsignedInt = std::any_of(_data.begin(), _data.end(), [](uint index){ return index > 0xffff; });
+
+	_indexSize = useUnsignedInt ? sizeof(uint) : sizeof(unsigned short);
+	_id = _context->createIndexBuffer(gpuSize, useUnsignedInt, _usage);
+	_gpuSize = gpuSize;
+
+	return true;
+}
+
+void
+IndexBuffer::usage(BufferUsage value)
+{
+	_usage = value;
+
+	if (_id != -1)
+		_context->setBufferUsage(_id, value);
 }
 
 void
@@ -40,5 +142,27 @@ IndexBuffer::dispose()
     {
 	    _context->deleteIndexBuffer(_id);
 	    _id = -1;
+		_indexSize = 0;
+		_gpuSize = 0;
     }
 }
+
+void
+IndexBuffer::contextRestored()
+{
+	if (_id == -1)
+		return;
+
+	_id = _context->createIndexBuffer(_gpuSize, _indexSize == sizeof(uint), _usage);
+}
+
+void
+IndexBuffer::disposeData()
+{
+	if (_id == -1)
+		throw std::logic_error("the indices have to be uploaded before their CPU-side copy is disposed");
+
+	_numDisposedIndices = numIndices();
+	_data.clear();
+	_data.shrink_to_fit();
+}
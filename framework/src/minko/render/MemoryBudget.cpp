@@ -0,0 +1,219 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/render/MemoryBudget.hpp"
+
+#include "minko/render/Texture.hpp"
+#include "minko/render/VertexBuffer.hpp"
+#include "minko/render/IndexBuffer.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+MemoryBudget::MemoryBudget(uint budget) :
+	_budget(budget),
+	_usedBytes(0),
+	_frameId(0),
+	_textures(),
+	_buffers()
+{
+}
+
+/*static*/
+uint
+MemoryBudget::textureSize(AbsTexturePtr texture)
+{
+	auto texture2d	= std::dynamic_pointer_cast<Texture>(texture);
+	auto format		= texture2d ? texture2d->format() : TextureFormat::RGBA;
+	auto size		= AbstractTexture::dataSize(format, texture->width(), texture->height());
+
+	if (texture->type() == TextureType::CubeTexture)
+		size *= 6;
+	// a full mip chain takes one third of the size of level 0
+	if (texture->mipMapping())
+		size += size / 3;
+
+	return size;
+}
+
+void
+MemoryBudget::track(AbsTexturePtr texture)
+{
+	if (!texture || !texture->isReady())
+		throw std::invalid_argument("texture: only uploaded textures can be tracked");
+
+	auto& residency = _textures[texture->id()];
+
+	if (residency.texture)
+		return;
+
+	residency.texture	= texture;
+	residency.size		= textureSize(texture);
+	residency.lastFrame	= _frameId;
+	residency.resident	= true;
+
+	_usedBytes += residency.size;
+}
+
+void
+MemoryBudget::track(std::shared_ptr<VertexBuffer> vertexBuffer)
+{
+	if (!vertexBuffer)
+		throw std::invalid_argument("vertexBuffer");
+
+	if (_buffers.count(vertexBuffer) == 0)
+	{
+		const uint size = vertexBuffer->numVertices() * vertexBuffer->vertexSize() * sizeof(float);
+
+		_buffers[vertexBuffer] = size;
+		_usedBytes += size;
+	}
+}
+
+void
+MemoryBudget::track(std::shared_ptr<IndexBuffer> indexBuffer)
+{
+	if (!indexBuffer)
+		throw std::invalid_argument("indexBuffer");
+
+	if (_buffers.count(indexBuffer) == 0)
+	{
+		const uint size = indexBuffer->numIndices() * std::max(2u, indexBuffer->indexSize());
+
+		_buffers[indexBuffer] = size;
+		_usedBytes += size;
+	}
+}
+
+void
+MemoryBudget::untrack(AbsResourcePtr resource)
+{
+	auto bufferIt = _buffers.find(resource);
+
+	if (bufferIt != _buffers.end())
+	{
+		_usedBytes -= bufferIt->second;
+		_buffers.erase(bufferIt);
+
+		return;
+	}
+
+	auto texture = std::dynamic_pointer_cast<AbstractTexture>(resource);
+	auto residencyIt = std::find_if(_textures.begin(), _textures.end(), [&](const std::pair<const int, TextureResidency>& r)
+	{
+		return r.second.texture == texture;
+	});
+
+	if (residencyIt == _textures.end())
+		return;
+
+	if (residencyIt->second.resident)
+		_usedBytes -= residencyIt->second.size;
+	_textures.erase(residencyIt);
+}
+
+bool
+MemoryBudget::tracked(AbsResourcePtr resource) const
+{
+	if (_buffers.count(resource) != 0)
+		return true;
+
+	auto residencyIt = _textures.find(resource->id());
+
+	return residencyIt != _textures.end() && residencyIt->second.texture == resource;
+}
+
+bool
+MemoryBudget::resident(AbsTexturePtr texture) const
+{
+	for (auto& residency : _textures)
+		if (residency.second.texture == texture)
+			return residency.second.resident;
+
+	return texture->isReady();
+}
+
+void
+MemoryBudget::touch(int textureId)
+{
+	auto residencyIt = _textures.find(textureId);
+
+	if (residencyIt == _textures.end())
+		return;
+
+	auto& residency = residencyIt->second;
+
+	residency.lastFrame = _frameId;
+	if (!residency.resident)
+	{
+		residency.texture->upload();
+		residency.resident = true;
+		_usedBytes += residency.size;
+	}
+}
+
+void
+MemoryBudget::nextFrame()
+{
+	if (_usedBytes > _budget)
+	{
+		std::vector<TextureResidency*> candidates;
+
+		// forget the textures disposed since they were tracked
+		for (auto residencyIt = _textures.begin(); residencyIt != _textures.end();)
+		{
+			auto texture = residencyIt->second.texture;
+
+			if (!texture->isReady() || texture->id() != residencyIt->first)
+			{
+				if (residencyIt->second.resident)
+					_usedBytes -= residencyIt->second.size;
+				residencyIt = _textures.erase(residencyIt);
+			}
+			else
+				++residencyIt;
+		}
+
+		for (auto& residency : _textures)
+		{
+			auto texture = std::dynamic_pointer_cast<Texture>(residency.second.texture);
+
+			// the textures of the current frame are never evicted
+			if (residency.second.resident && residency.second.lastFrame != _frameId && texture && texture->evictable())
+				candidates.push_back(&residency.second);
+		}
+
+		std::sort(candidates.begin(), candidates.end(), [](TextureResidency* a, TextureResidency* b)
+		{
+			return a->lastFrame < b->lastFrame;
+		});
+
+		for (auto residency : candidates)
+		{
+			if (_usedBytes <= _budget)
+				break;
+
+			std::static_pointer_cast<Texture>(residency->texture)->evict();
+			residency->resident = false;
+			_usedBytes -= residency->size;
+		}
+	}
+
+	++_frameId;
+}
@@ -25,6 +25,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/render/MipFilter.hpp"
 #include "minko/render/TriangleCulling.hpp"
 #include "minko/render/StencilOperation.hpp"
+#include "minko/render/AbstractTexture.hpp"
 #include "minko/math/Matrix4x4.hpp"
 
 #include <iomanip>
@@ -54,10 +55,167 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 # include <GL/glu.h>
 #endif
 
+// instanced rendering is an extension in OpenGL ES 2.0/WebGL 1.0 and OpenGL 2.1
+#if EMSCRIPTEN || MINKO_ANGLE
+# include <GLES2/gl2ext.h>
+# define glVertexAttribDivisorInstancing	glVertexAttribDivisorANGLE
+# define glDrawElementsInstancing			glDrawElementsInstancedANGLE
+#elif __APPLE__ && (TARGET_IPHONE_SIMULATOR || TARGET_OS_IPHONE)
+# include <OpenGLES/ES2/glext.h>
+# define glVertexAttribDivisorInstancing	glVertexAttribDivisorEXT
+# define glDrawElementsInstancing			glDrawElementsInstancedEXT
+#elif __ANDROID__
+# define MINKO_NO_INSTANCING
+#else
+# define glVertexAttribDivisorInstancing	glVertexAttribDivisorARB
+# define glDrawElementsInstancing			glDrawElementsInstancedARB
+#endif
+
+// vertex array objects are exposed by OES_vertex_array_object with OpenGL ES 2.0/WebGL 1.0, APPLE_vertex_array_object
+// with the legacy OpenGL contexts of OS X and ARB_vertex_array_object (core since OpenGL 3.0) otherwise
+#if EMSCRIPTEN || MINKO_ANGLE || (__APPLE__ && (TARGET_IPHONE_SIMULATOR || TARGET_OS_IPHONE))
+# define glGenVertexArraysCompatible		glGenVertexArraysOES
+# define glBindVertexArrayCompatible		glBindVertexArrayOES
+# define glDeleteVertexArraysCompatible		glDeleteVertexArraysOES
+#elif __APPLE__
+# define glGenVertexArraysCompatible		glGenVertexArraysAPPLE
+# define glBindVertexArrayCompatible		glBindVertexArrayAPPLE
+# define glDeleteVertexArraysCompatible		glDeleteVertexArraysAPPLE
+#elif __ANDROID__
+# define MINKO_NO_VERTEX_ARRAY
+#else
+# define glGenVertexArraysCompatible		glGenVertexArrays
+# define glBindVertexArrayCompatible		glBindVertexArray
+# define glDeleteVertexArraysCompatible		glDeleteVertexArrays
+#endif
+
+// GL_PIXEL_PACK_BUFFER is not available with OpenGL ES 2.0/WebGL 1.0
+#if EMSCRIPTEN || MINKO_ANGLE || __ANDROID__ || (__APPLE__ && (TARGET_IPHONE_SIMULATOR || TARGET_OS_IPHONE))
+# define MINKO_NO_PIXEL_BUFFER
+#endif
+
+// sync objects are core since OpenGL 3.2 (ARB_sync) and OpenGL ES 3.0, the legacy OS X headers do not declare them
+#if EMSCRIPTEN || MINKO_ANGLE || __ANDROID__ || __APPLE__
+# define MINKO_NO_FENCE
+#endif
+
+// KHR_parallel_shader_compile and ARB_parallel_shader_compile share the same enum
+#ifndef GL_COMPLETION_STATUS_KHR
+# define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+#ifndef GL_NUM_PROGRAM_BINARY_FORMATS_OES
+# define GL_NUM_PROGRAM_BINARY_FORMATS_OES 0x87FE
+#endif
+
+// compressed texture formats, see EXT_texture_compression_s3tc, OES_compressed_ETC1_RGB8_texture,
+// OpenGL ES 3.0/ARB_ES3_compatibility, IMG_texture_compression_pvrtc and KHR_texture_compression_astc_ldr
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+# define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+# define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+# define GL_COMPRESSED_RGBA_S3TC_DXT3_EXT 0x83F2
+# define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_ETC1_RGB8_OES
+# define GL_ETC1_RGB8_OES 0x8D64
+#endif
+#ifndef GL_COMPRESSED_RGB8_ETC2
+# define GL_COMPRESSED_RGB8_ETC2 0x9274
+# define GL_COMPRESSED_RGBA8_ETC2_EAC 0x9278
+#endif
+#ifndef GL_COMPRESSED_RGB_PVRTC_4BPPV1_IMG
+# define GL_COMPRESSED_RGB_PVRTC_4BPPV1_IMG 0x8C00
+# define GL_COMPRESSED_RGB_PVRTC_2BPPV1_IMG 0x8C01
+# define GL_COMPRESSED_RGBA_PVRTC_4BPPV1_IMG 0x8C02
+# define GL_COMPRESSED_RGBA_PVRTC_2BPPV1_IMG 0x8C03
+#endif
+#ifndef GL_COMPRESSED_RGBA_ASTC_4x4_KHR
+# define GL_COMPRESSED_RGBA_ASTC_4x4_KHR 0x93B0
+#endif
+
+// half float vertex attributes are exposed by OES_vertex_half_float with OpenGL ES 2.0
+#if EMSCRIPTEN || MINKO_ANGLE || __ANDROID__ || (__APPLE__ && (TARGET_IPHONE_SIMULATOR || TARGET_OS_IPHONE))
+# define MINKO_GL_HALF_FLOAT 0x8D61
+#else
+# define MINKO_GL_HALF_FLOAT 0x140B
+#endif
+
+// OES_texture_float uses the unsized RGBA internal format with OpenGL ES 2.0
+#ifndef GL_RGBA32F
+# define GL_RGBA32F 0x8814
+#endif
+#if EMSCRIPTEN || MINKO_ANGLE || __ANDROID__ || (__APPLE__ && (TARGET_IPHONE_SIMULATOR || TARGET_OS_IPHONE))
+# define MINKO_GL_FLOAT_TEXTURE_FORMAT GL_RGBA
+#else
+# define MINKO_GL_FLOAT_TEXTURE_FORMAT GL_RGBA32F
+#endif
+
+#ifndef GL_INT_2_10_10_10_REV
+# define GL_INT_2_10_10_10_REV 0x8D9F
+#endif
+
+// GL_TEXTURE_BASE_LEVEL is not available with OpenGL ES 2.0/WebGL 1.0
+#if EMSCRIPTEN || MINKO_ANGLE || __ANDROID__ || (__APPLE__ && (TARGET_IPHONE_SIMULATOR || TARGET_OS_IPHONE))
+# define MINKO_NO_TEXTURE_BASE_LEVEL
+#endif
+
+// program binaries are exposed by OES_get_program_binary with OpenGL ES 2.0 and unavailable with WebGL
+#if EMSCRIPTEN || __APPLE__
+# define MINKO_NO_PROGRAM_BINARY
+#elif MINKO_ANGLE || __ANDROID__
+# include <GLES2/gl2ext.h>
+# define glProgramBinaryCompatible			glProgramBinaryOES
+# define glGetProgramBinaryCompatible		glGetProgramBinaryOES
+# define GL_PROGRAM_BINARY_LENGTH_COMPATIBLE	GL_PROGRAM_BINARY_LENGTH_OES
+#else
+# define glProgramBinaryCompatible			glProgramBinary
+# define glGetProgramBinaryCompatible		glGetProgramBinary
+# define GL_PROGRAM_BINARY_LENGTH_COMPATIBLE	GL_PROGRAM_BINARY_LENGTH
+#endif
+
+// GPU timers are exposed by EXT_disjoint_timer_query with OpenGL ES 2.0 and ARB_timer_query with desktop OpenGL,
+// occlusion queries by EXT_occlusion_query_boolean and ARB_occlusion_query2 through the same query entry points
+#if EMSCRIPTEN || __APPLE__
+# define MINKO_NO_TIMER_QUERY
+# define MINKO_NO_OCCLUSION_QUERY
+#elif MINKO_ANGLE || __ANDROID__
+# include <GLES2/gl2ext.h>
+# include <EGL/egl.h>
+// the entry points of the extensions are not exported by every OpenGL ES library
+static PFNGLGENQUERIESEXTPROC					glGenQueriesTimer				= nullptr;
+static PFNGLDELETEQUERIESEXTPROC				glDeleteQueriesTimer			= nullptr;
+static PFNGLBEGINQUERYEXTPROC					glBeginQueryTimer				= nullptr;
+static PFNGLENDQUERYEXTPROC						glEndQueryTimer					= nullptr;
+static PFNGLGETQUERYOBJECTUIVEXTPROC			glGetQueryObjectuivTimer		= nullptr;
+static PFNGLGETQUERYOBJECTUI64VEXTPROC			glGetQueryObjectui64vTimer		= nullptr;
+# define MINKO_TIMER_QUERY_PROC_ADDRESSES
+#else
+# define glGenQueriesTimer						glGenQueries
+# define glDeleteQueriesTimer					glDeleteQueries
+# define glBeginQueryTimer						glBeginQuery
+# define glEndQueryTimer						glEndQuery
+# define glGetQueryObjectuivTimer				glGetQueryObjectuiv
+# define glGetQueryObjectui64vTimer				glGetQueryObjectui64v
+#endif
+
+#ifndef GL_TIME_ELAPSED
+# define GL_TIME_ELAPSED 0x88BF
+#endif
+#ifndef GL_QUERY_RESULT
+# define GL_QUERY_RESULT 0x8866
+# define GL_QUERY_RESULT_AVAILABLE 0x8867
+#endif
+#ifndef GL_GPU_DISJOINT_EXT
+# define GL_GPU_DISJOINT_EXT 0x8FBB
+#endif
+#ifndef GL_ANY_SAMPLES_PASSED
+# define GL_ANY_SAMPLES_PASSED 0x8C2F
+#endif
+
 using namespace minko;
 using namespace minko::render;
 
-OpenGLES2Context::BlendFactorsMap OpenGLES2Context::_blendingFactors = OpenGLES2Context::initializeBlendFactorsMap();
+const OpenGLES2Context::BlendFactorsMap OpenGLES2Context::_blendingFactors = OpenGLES2Context::initializeBlendFactorsMap();
 OpenGLES2Context::BlendFactorsMap
 OpenGLES2Context::initializeBlendFactorsMap()
 {
@@ -76,6 +234,7 @@ OpenGLES2Context::initializeBlendFactorsMap()
 	m[static_cast<uint>(Blending::Destination::ONE)]                   = GL_ONE;
 	m[static_cast<uint>(Blending::Destination::DST_COLOR)]             = GL_DST_COLOR;
 	m[static_cast<uint>(Blending::Destination::ONE_MINUS_DST_COLOR)]   = GL_ONE_MINUS_DST_COLOR;
+	m[static_cast<uint>(Blending::Destination::SRC_ALPHA_SATURATE)]    = GL_SRC_ALPHA_SATURATE;
 	m[static_cast<uint>(Blending::Destination::ONE_MINUS_DST_ALPHA)]   = GL_ONE_MINUS_DST_ALPHA;
 	m[static_cast<uint>(Blending::Destination::ONE_MINUS_SRC_ALPHA)]   = GL_ONE_MINUS_SRC_ALPHA;
 	m[static_cast<uint>(Blending::Destination::DST_ALPHA)]             = GL_DST_ALPHA;
@@ -84,7 +243,7 @@ OpenGLES2Context::initializeBlendFactorsMap()
 	return m;
 }
 
-OpenGLES2Context::CompareFuncsMap OpenGLES2Context::_compareFuncs = OpenGLES2Context::initializeDepthFuncsMap();
+const OpenGLES2Context::CompareFuncsMap OpenGLES2Context::_compareFuncs = OpenGLES2Context::initializeDepthFuncsMap();
 OpenGLES2Context::CompareFuncsMap
 OpenGLES2Context::initializeDepthFuncsMap()
 {
@@ -102,7 +261,7 @@ OpenGLES2Context::initializeDepthFuncsMap()
 	return m;
 }
 
-OpenGLES2Context::StencilOperationMap OpenGLES2Context::_stencilOps = OpenGLES2Context::initializeStencilOperationsMap();
+const OpenGLES2Context::StencilOperationMap OpenGLES2Context::_stencilOps = OpenGLES2Context::initializeStencilOperationsMap();
 OpenGLES2Context::StencilOperationMap
 OpenGLES2Context::initializeStencilOperationsMap()
 {
@@ -122,36 +281,65 @@ OpenGLES2Context::initializeStencilOperationsMap()
 
 OpenGLES2Context::OpenGLES2Context() :
 	_errorsEnabled(false),
+	_instancingSupported(false),
+	_unsignedIntIndicesSupported(false),
+	_pixelBuffersSupported(false),
+	_fencesSupported(false),
+	_parallelShaderCompileSupported(false),
+	_programBinariesSupported(false),
+	_timerQueriesSupported(false),
+	_disjointTimerQueries(false),
+	_occlusionQueriesSupported(false),
+	_npotTexturesSupported(false),
+	_halfFloatVerticesSupported(false),
+	_packedVerticesSupported(false),
+	_vertexArraysSupported(false),
+	_floatTexturesSupported(false),
+	_compressedTextureFormats(),
+	_dynamicBuffers(),
 	_textures(),
 	_textureSizes(),
 	_textureHasMipmaps(),
+	_nextPixelBufferId(0),
+	_fences(),
+	_nextFenceId(0),
 	_viewportX(0),
 	_viewportY(0),
 	_viewportWidth(0),
 	_viewportHeight(0),
 	_currentTarget(0),
 	_currentIndexBuffer(0),
+	_currentIndexSize(sizeof(GLushort)),
+	_indexBufferIndexSize(),
 	_currentVertexBuffer(8, 0),
 	_currentVertexSize(8, -1),
 	_currentVertexStride(8, -1),
 	_currentVertexOffset(8, -1),
+	_currentVertexType(8, VertexAttributeType::FLOAT),
+	_currentVertexDivisor(8, 0),
+	_currentVertexArray(0),
 	_currentBoundTexture(0),
 	_currentTexture(8, 0),
+	_textureSamplers(),
+	_currentSampler(8, std::pair<int, TextureSampler*>(0, nullptr)),
 	_currentProgram(0),
-	_currentTriangleCulling(TriangleCulling::BACK),
-	_currentWrapMode(),
-	_currentTextureFilter(),
-	_currentMipFilter(),
 	_currentBlendMode(Blending::Mode::DEFAULT),
 	_currentColorMask(true),
 	_currentDepthMask(true),
 	_currentDepthFunc(CompareMode::UNSET),
+	_currentTriangleCulling(TriangleCulling::BACK),
 	_currentStencilFunc(CompareMode::UNSET),
 	_currentStencilRef(0),
 	_currentStencilMask(0x1),
 	_currentStencilFailOp(StencilOperation::UNSET),
 	_currentStencilZFailOp(StencilOperation::UNSET),
-	_currentStencilZPassOp(StencilOperation::UNSET)
+	_currentStencilZPassOp(StencilOperation::UNSET),
+	_programUniformValues(),
+	_currentUniformValues(nullptr),
+	_bufferMemorySizes(),
+	_textureMemorySizes(),
+	_bufferMemory(0),
+	_textureMemory(0)
 {
 #if defined _WIN32 && !defined MINKO_ANGLE
 	glewInit();
@@ -174,6 +362,141 @@ OpenGLES2Context::OpenGLES2Context() :
 		+ " " + std::string(glRenderer ? glRenderer : "(unknown renderer)")
 		+ " " + std::string(glVersion ? glVersion : "(unknown version)");
 
+	// the instanced model matrix alone takes 4 locations, the caches cover every attribute of the driver
+	int maxVertexAttributes = 0;
+
+	glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, &maxVertexAttributes);
+
+	const auto numVertexAttributes = (uint)std::max(8, maxVertexAttributes);
+
+	_currentVertexBuffer.resize(numVertexAttributes, 0);
+	_currentVertexSize.resize(numVertexAttributes, -1);
+	_currentVertexStride.resize(numVertexAttributes, -1);
+	_currentVertexOffset.resize(numVertexAttributes, -1);
+	_currentVertexType.resize(numVertexAttributes, VertexAttributeType::FLOAT);
+	_currentVertexDivisor.resize(numVertexAttributes, 0);
+
+	const char* glExtensions = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+
+#ifndef MINKO_NO_INSTANCING
+	// matches GL_ARB_instanced_arrays, GL_EXT_instanced_arrays and (GL_)ANGLE_instanced_arrays
+	_instancingSupported = glExtensions && std::string(glExtensions).find("instanced_arrays") != std::string::npos;
+#endif
+
+	// 32 bits indices are core in desktop OpenGL but require OES_element_index_uint with OpenGL ES 2.0/WebGL
+#if EMSCRIPTEN || MINKO_ANGLE || __ANDROID__ || (__APPLE__ && (TARGET_IPHONE_SIMULATOR || TARGET_OS_IPHONE))
+	_unsignedIntIndicesSupported = glExtensions && std::string(glExtensions).find("OES_element_index_uint") != std::string::npos;
+#else
+	_unsignedIntIndicesSupported = true;
+#endif
+
+#ifndef MINKO_NO_PIXEL_BUFFER
+	// matches GL_ARB_pixel_buffer_object and GL_EXT_pixel_buffer_object, core since OpenGL 2.1
+	_pixelBuffersSupported = glExtensions && std::string(glExtensions).find("pixel_buffer_object") != std::string::npos;
+#endif
+
+#ifndef MINKO_NO_FENCE
+	// matches GL_ARB_sync
+	_fencesSupported = glExtensions && std::string(glExtensions).find("_sync") != std::string::npos;
+#endif
+
+#ifndef MINKO_NO_PARALLEL_SHADER_COMPILE
+	// matches GL_KHR_parallel_shader_compile and GL_ARB_parallel_shader_compile
+	_parallelShaderCompileSupported = glExtensions && std::string(glExtensions).find("parallel_shader_compile") != std::string::npos;
+#endif
+
+#ifndef MINKO_NO_PROGRAM_BINARY
+	// matches GL_OES_get_program_binary and GL_ARB_get_program_binary, some drivers expose no format
+	if (glExtensions && std::string(glExtensions).find("get_program_binary") != std::string::npos)
+	{
+		int numFormats = 0;
+
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS_OES, &numFormats);
+		_programBinariesSupported = numFormats > 0;
+	}
+#endif
+
+#ifndef MINKO_NO_TIMER_QUERY
+# ifdef MINKO_TIMER_QUERY_PROC_ADDRESSES
+	if (glExtensions && std::string(glExtensions).find("disjoint_timer_query") != std::string::npos)
+	{
+		glGenQueriesTimer = (PFNGLGENQUERIESEXTPROC)eglGetProcAddress("glGenQueriesEXT");
+		glDeleteQueriesTimer = (PFNGLDELETEQUERIESEXTPROC)eglGetProcAddress("glDeleteQueriesEXT");
+		glBeginQueryTimer = (PFNGLBEGINQUERYEXTPROC)eglGetProcAddress("glBeginQueryEXT");
+		glEndQueryTimer = (PFNGLENDQUERYEXTPROC)eglGetProcAddress("glEndQueryEXT");
+		glGetQueryObjectuivTimer = (PFNGLGETQUERYOBJECTUIVEXTPROC)eglGetProcAddress("glGetQueryObjectuivEXT");
+		glGetQueryObjectui64vTimer = (PFNGLGETQUERYOBJECTUI64VEXTPROC)eglGetProcAddress("glGetQueryObjectui64vEXT");
+
+		_timerQueriesSupported = glGenQueriesTimer && glDeleteQueriesTimer && glBeginQueryTimer
+			&& glEndQueryTimer && glGetQueryObjectuivTimer && glGetQueryObjectui64vTimer;
+		_disjointTimerQueries = true;
+	}
+# else
+	// matches GL_ARB_timer_query, core since OpenGL 3.3
+	_timerQueriesSupported = glExtensions && std::string(glExtensions).find("timer_query") != std::string::npos;
+# endif
+#endif
+
+#ifndef MINKO_NO_OCCLUSION_QUERY
+# ifdef MINKO_TIMER_QUERY_PROC_ADDRESSES
+	if (glExtensions && std::string(glExtensions).find("occlusion_query_boolean") != std::string::npos)
+	{
+		if (!glGenQueriesTimer)
+		{
+			glGenQueriesTimer = (PFNGLGENQUERIESEXTPROC)eglGetProcAddress("glGenQueriesEXT");
+			glDeleteQueriesTimer = (PFNGLDELETEQUERIESEXTPROC)eglGetProcAddress("glDeleteQueriesEXT");
+			glBeginQueryTimer = (PFNGLBEGINQUERYEXTPROC)eglGetProcAddress("glBeginQueryEXT");
+			glEndQueryTimer = (PFNGLENDQUERYEXTPROC)eglGetProcAddress("glEndQueryEXT");
+			glGetQueryObjectuivTimer = (PFNGLGETQUERYOBJECTUIVEXTPROC)eglGetProcAddress("glGetQueryObjectuivEXT");
+		}
+
+		_occlusionQueriesSupported = glGenQueriesTimer && glDeleteQueriesTimer && glBeginQueryTimer
+			&& glEndQueryTimer && glGetQueryObjectuivTimer;
+	}
+# else
+	// matches GL_ARB_occlusion_query2, core since OpenGL 3.3
+	_occlusionQueriesSupported = glExtensions && std::string(glExtensions).find("occlusion_query2") != std::string::npos;
+# endif
+#endif
+
+#if EMSCRIPTEN || MINKO_ANGLE || __ANDROID__ || (__APPLE__ && (TARGET_IPHONE_SIMULATOR || TARGET_OS_IPHONE))
+	// matches GL_OES_texture_npot and GL_ARB_texture_non_power_of_two
+	_npotTexturesSupported = glExtensions
+		&& (std::string(glExtensions).find("texture_npot") != std::string::npos
+			|| std::string(glExtensions).find("texture_non_power_of_two") != std::string::npos);
+#else
+	// core since OpenGL 2.0
+	_npotTexturesSupported = true;
+#endif
+
+#if EMSCRIPTEN || MINKO_ANGLE || __ANDROID__ || (__APPLE__ && (TARGET_IPHONE_SIMULATOR || TARGET_OS_IPHONE))
+	// OES_vertex_half_float, the OES 10_10_10_2 layout is not the one of 2_10_10_10_REV
+	_halfFloatVerticesSupported = glExtensions && std::string(glExtensions).find("vertex_half_float") != std::string::npos;
+#else
+	// matches GL_ARB_half_float_vertex and GL_ARB_vertex_type_2_10_10_10_rev, both core since OpenGL 3.3
+	_halfFloatVerticesSupported = glExtensions && std::string(glExtensions).find("half_float_vertex") != std::string::npos;
+	_packedVerticesSupported = glExtensions && std::string(glExtensions).find("vertex_type_2_10_10_10_rev") != std::string::npos;
+#endif
+
+	// matches GL_OES_texture_float and GL_ARB_texture_float, the latter is core since OpenGL 3.0
+	_floatTexturesSupported = glExtensions && std::string(glExtensions).find("texture_float") != std::string::npos;
+	if (_floatTexturesSupported)
+	{
+		// vertex texture fetch is optional with OpenGL ES 2.0 and WebGL
+		int numVertexTextureUnits = 0;
+
+		glGetIntegerv(GL_MAX_VERTEX_TEXTURE_IMAGE_UNITS, &numVertexTextureUnits);
+		_floatTexturesSupported = numVertexTextureUnits > 0;
+	}
+
+#ifndef MINKO_NO_VERTEX_ARRAY
+	// matches GL_OES_vertex_array_object, GL_APPLE_vertex_array_object and GL_ARB_vertex_array_object
+	_vertexArraysSupported = glExtensions && std::string(glExtensions).find("vertex_array_object") != std::string::npos;
+#endif
+
+	if (glExtensions)
+		initializeCompressedTextureFormats(glExtensions);
+
 	// init. viewport x, y, width and height
 	std::vector<int> viewportSettings(4);
 	glGetIntegerv(GL_VIEWPORT, &viewportSettings[0]);
@@ -206,6 +529,106 @@ OpenGLES2Context::~OpenGLES2Context()
 
 	for (auto& fragmentShader : _fragmentShaders)
 		glDeleteShader(fragmentShader);
+
+#ifndef MINKO_NO_PIXEL_BUFFER
+	if (_pixelBuffersSupported)
+		for (auto& pixelBuffer : _pixelBuffers)
+			glDeleteBuffers(1, &pixelBuffer.first);
+#endif
+
+#ifndef MINKO_NO_FENCE
+	if (_fencesSupported)
+		for (auto& fence : _fences)
+			glDeleteSync(static_cast<GLsync>(fence.second));
+#endif
+
+#ifndef MINKO_NO_TIMER_QUERY
+	for (auto& timerQuery : _timerQueries)
+		glDeleteQueriesTimer(1, &timerQuery);
+#endif
+
+#ifndef MINKO_NO_OCCLUSION_QUERY
+	for (auto& occlusionQuery : _occlusionQueries)
+		glDeleteQueriesTimer(1, &occlusionQuery);
+#endif
+
+#ifndef MINKO_NO_VERTEX_ARRAY
+	for (auto& vertexArray : _vertexArrays)
+		glDeleteVertexArraysCompatible(1, &vertexArray);
+#endif
+}
+
+void
+OpenGLES2Context::contextRestored()
+{
+	// the objects died with the context: nothing to delete, only ids to forget
+	_dynamicBuffers.clear();
+	_textures.clear();
+	_textureSizes.clear();
+	_textureHasMipmaps.clear();
+	_textureTypes.clear();
+	_textureSamplers.clear();
+	_vertexBuffers.clear();
+	_indexBuffers.clear();
+	_indexBufferIndexSize.clear();
+	_programs.clear();
+	_vertexShaders.clear();
+	_fragmentShaders.clear();
+	_programUniformValues.clear();
+	_pixelBuffers.clear();
+	_fences.clear();
+	_timerQueries.clear();
+	_occlusionQueries.clear();
+	_vertexArrays.clear();
+	_vertexArrayIndexBuffers.clear();
+	_frameBuffers.clear();
+	_renderBuffers.clear();
+	_depthBuffers.clear();
+	_bufferMemorySizes.clear();
+	_textureMemorySizes.clear();
+	_bufferMemory = 0;
+	_textureMemory = 0;
+
+	// a new context starts with the default GL states
+	_currentTarget = 0;
+	_currentIndexBuffer = 0;
+	_currentIndexSize = sizeof(GLushort);
+	std::fill(_currentVertexBuffer.begin(), _currentVertexBuffer.end(), 0);
+	std::fill(_currentVertexSize.begin(), _currentVertexSize.end(), -1);
+	std::fill(_currentVertexStride.begin(), _currentVertexStride.end(), -1);
+	std::fill(_currentVertexOffset.begin(), _currentVertexOffset.end(), -1);
+	std::fill(_currentVertexType.begin(), _currentVertexType.end(), VertexAttributeType::FLOAT);
+	std::fill(_currentVertexDivisor.begin(), _currentVertexDivisor.end(), 0);
+	_currentVertexArray = 0;
+	_currentBoundTexture = 0;
+	std::fill(_currentTexture.begin(), _currentTexture.end(), 0);
+	std::fill(_currentSampler.begin(), _currentSampler.end(), std::pair<int, TextureSampler*>(0, nullptr));
+	_currentProgram = 0;
+	_currentUniformValues = nullptr;
+	_currentTriangleCulling = TriangleCulling::BACK;
+	_currentBlendMode = Blending::Mode::DEFAULT;
+	_currentColorMask = true;
+	_currentDepthMask = true;
+	_currentDepthFunc = CompareMode::UNSET;
+	_currentStencilFunc = CompareMode::UNSET;
+	_currentStencilRef = 0;
+	_currentStencilMask = 0x1;
+	_currentStencilFailOp = StencilOperation::UNSET;
+	_currentStencilZFailOp = StencilOperation::UNSET;
+	_currentStencilZPassOp = StencilOperation::UNSET;
+
+	glEnable(GL_DEPTH_TEST);
+#ifndef MINKO_NO_STENCIL
+	glEnable(GL_STENCIL_TEST);
+#endif
+	glEnable(GL_BLEND);
+	glEnable(GL_CULL_FACE);
+	glCullFace(GL_BACK);
+	glFrontFace(GL_CCW);
+	glViewport(_viewportX, _viewportY, _viewportWidth, _viewportHeight);
+
+	setDepthTest(true, CompareMode::LESS);
+	setStencilTest(CompareMode::ALWAYS, 0, 0x1, StencilOperation::KEEP, StencilOperation::KEEP, StencilOperation::KEEP);
 }
 
 void
@@ -297,8 +720,10 @@ OpenGLES2Context::drawTriangles(const uint indexBuffer, const int numTriangles)
 	if (_currentIndexBuffer != indexBuffer)
 	{
 		_currentIndexBuffer = indexBuffer;
+		_currentIndexSize = _indexBufferIndexSize[indexBuffer];
 
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+		++_stats.numBufferBinds;
 	}
 
 	// http://www.opengl.org/sdk/docs/man/xhtml/glDrawElements.xml
@@ -310,13 +735,52 @@ OpenGLES2Context::drawTriangles(const uint indexBuffer, const int numTriangles)
 	// indices Specifies a pointer to the location where the indices are stored.
 	//
 	// glDrawElements render primitives from array data
-	glDrawElements(GL_TRIANGLES, numTriangles * 3, GL_UNSIGNED_SHORT, (void*)0);
+	glDrawElements(
+		GL_TRIANGLES,
+		numTriangles * 3,
+		_currentIndexSize == sizeof(GLuint) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT,
+		(void*)0
+	);
+
+	++_stats.numDrawCalls;
+	_stats.numTriangles += numTriangles;
+
+	checkForErrors();
+}
+
+void
+OpenGLES2Context::drawTrianglesInstanced(const uint indexBuffer, const int numTriangles, const uint numInstances)
+{
+	if (!_instancingSupported)
+		throw std::logic_error("instanced rendering is not supported by this context");
+
+	if (_currentIndexBuffer != static_cast<int>(indexBuffer))
+	{
+		_currentIndexBuffer = indexBuffer;
+		_currentIndexSize = _indexBufferIndexSize[indexBuffer];
+
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+		++_stats.numBufferBinds;
+	}
+
+#ifndef MINKO_NO_INSTANCING
+	glDrawElementsInstancing(
+		GL_TRIANGLES,
+		numTriangles * 3,
+		_currentIndexSize == sizeof(GLuint) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT,
+		(void*)0,
+		numInstances
+	);
+#endif
+
+	++_stats.numDrawCalls;
+	_stats.numTriangles += (unsigned long long)numTriangles * numInstances;
 
 	checkForErrors();
 }
 
 const uint
-OpenGLES2Context::createVertexBuffer(const uint size)
+OpenGLES2Context::createVertexBuffer(const uint size, BufferUsage usage)
 {
 	uint vertexBuffer;
 
@@ -350,9 +814,17 @@ OpenGLES2Context::createVertexBuffer(const uint size)
 	// usage Specifies the expected usage pattern of the data store.
 	//
 	// glBufferData creates and initializes a buffer object's data store
-	glBufferData(GL_ARRAY_BUFFER, size * sizeof(GLfloat), 0, GL_STATIC_DRAW);
+	glBufferData(
+		GL_ARRAY_BUFFER,
+		size * sizeof(GLfloat),
+		0,
+		usage == BufferUsage::STATIC ? GL_STATIC_DRAW : usage == BufferUsage::DYNAMIC ? GL_DYNAMIC_DRAW : GL_STREAM_DRAW
+	);
 
 	_vertexBuffers.push_back(vertexBuffer);
+	if (usage != BufferUsage::STATIC)
+		_dynamicBuffers[vertexBuffer] = std::make_pair(size * sizeof(GLfloat), usage);
+	setMemorySize(_bufferMemorySizes, _bufferMemory, vertexBuffer, size * sizeof(GLfloat));
 
 	checkForErrors();
 
@@ -366,6 +838,7 @@ OpenGLES2Context::uploadVertexBufferData(const uint vertexBuffer,
 										 void* 				data)
 {
 	glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+	++_stats.numBufferBinds;
 
 	// http://www.opengl.org/sdk/docs/man/xhtml/glBufferSubData.xml
 	//
@@ -376,11 +849,78 @@ OpenGLES2Context::uploadVertexBufferData(const uint vertexBuffer,
 	// data Specifies a pointer to the new data that will be copied into the data store.
 	//
 	// glBufferSubData updates a subset of a buffer object's data store
-	glBufferSubData(GL_ARRAY_BUFFER, offset * sizeof(GLfloat), size * sizeof(GLfloat), data);
+	uploadBufferData(GL_ARRAY_BUFFER, vertexBuffer, offset * sizeof(GLfloat), size * sizeof(GLfloat), data);
+
+	checkForErrors();
+}
+
+void
+OpenGLES2Context::uploadBufferData(uint target, uint buffer, uint offset, uint size, void* data)
+{
+	auto dynamicBufferIt = _dynamicBuffers.find(buffer);
+
+	_stats.numBytesUploaded += size;
+
+	if (dynamicBufferIt == _dynamicBuffers.end() || offset != 0)
+	{
+		glBufferSubData(target, offset, size, data);
+
+		return;
+	}
+
+	const auto bufferSize	= dynamicBufferIt->second.first;
+	const auto usage		= dynamicBufferIt->second.second;
+
+	// orphaning: the update gets a new storage instead of waiting for the GPU to be done with the current one,
+	// streamed buffers are orphaned even when only their first part is updated
+	if (size == bufferSize)
+		glBufferData(target, size, data, usage == BufferUsage::STREAM ? GL_STREAM_DRAW : GL_DYNAMIC_DRAW);
+	else if (usage == BufferUsage::STREAM)
+	{
+		glBufferData(target, bufferSize, 0, GL_STREAM_DRAW);
+		glBufferSubData(target, 0, size, data);
+	}
+	else
+		glBufferSubData(target, offset, size, data);
+}
+
+void
+OpenGLES2Context::setBufferUsage(uint buffer, BufferUsage usage)
+{
+	if (usage == BufferUsage::STATIC)
+	{
+		_dynamicBuffers.erase(buffer);
+
+		return;
+	}
+
+	const auto target = _indexBufferIndexSize.count(buffer) ? GL_ELEMENT_ARRAY_BUFFER : GL_ARRAY_BUFFER;
+	int size = 0;
+
+	glBindBuffer(target, buffer);
+	glGetBufferParameteriv(target, GL_BUFFER_SIZE, &size);
+
+	if (target == GL_ELEMENT_ARRAY_BUFFER)
+		_currentIndexBuffer = buffer;
+
+	// applied the next time the storage is orphaned
+	_dynamicBuffers[buffer] = std::make_pair(uint(size), usage);
 
 	checkForErrors();
 }
 
+void
+OpenGLES2Context::setMemorySize(std::unordered_map<uint, unsigned long long>&	sizes,
+								unsigned long long&								total,
+								uint											id,
+								unsigned long long								size)
+{
+	auto& currentSize = sizes[id];
+
+	total = total - currentSize + size;
+	currentSize = size;
+}
+
 void
 OpenGLES2Context::deleteVertexBuffer(const uint vertexBuffer)
 {
@@ -389,6 +929,9 @@ OpenGLES2Context::deleteVertexBuffer(const uint vertexBuffer)
 			currentVertexBuffer = 0;
 
 	_vertexBuffers.erase(std::find(_vertexBuffers.begin(), _vertexBuffers.end(), vertexBuffer));
+	_dynamicBuffers.erase(vertexBuffer);
+	setMemorySize(_bufferMemorySizes, _bufferMemory, vertexBuffer, 0);
+	_bufferMemorySizes.erase(vertexBuffer);
 
 	// http://www.opengl.org/sdk/docs/man/xhtml/glDeleteBuffers.xml
 	//
@@ -405,24 +948,30 @@ OpenGLES2Context::deleteVertexBuffer(const uint vertexBuffer)
 }
 
 void
-OpenGLES2Context::setVertexBufferAt(const uint	position,
-									const uint	vertexBuffer,
-									const uint	size,
-									const uint	stride,
-									const uint	offset)
+OpenGLES2Context::setVertexBufferAt(const uint			position,
+									const uint			vertexBuffer,
+									const uint			size,
+									const uint			stride,
+									const uint			offset,
+									VertexAttributeType	type)
 {
+	if (position >= _currentVertexBuffer.size())
+		throw std::invalid_argument("position");
+
 	auto currentVertexBuffer = _currentVertexBuffer[position];
 
 	if (currentVertexBuffer == vertexBuffer
 		&& _currentVertexSize[position] == size
 		&& _currentVertexStride[position] == stride
-		&& _currentVertexOffset[position] == position)
+		&& _currentVertexOffset[position] == offset
+		&& _currentVertexType[position] == type)
 		return ;
 
 	_currentVertexBuffer[position] = vertexBuffer;
 	_currentVertexSize[position] = size;
 	_currentVertexStride[position] = stride;
 	_currentVertexOffset[position] = offset;
+	_currentVertexType[position] = type;
 
 	if (vertexBuffer > 0)
 		glEnableVertexAttribArray(position);
@@ -434,13 +983,27 @@ OpenGLES2Context::setVertexBufferAt(const uint	position,
 	}
 
 	glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+	++_stats.numBufferBinds;
+
+	GLenum glType = GL_FLOAT;
+
+	switch (type)
+	{
+	case VertexAttributeType::FLOAT:						glType = GL_FLOAT;					break;
+	case VertexAttributeType::HALF_FLOAT:					glType = MINKO_GL_HALF_FLOAT;		break;
+	case VertexAttributeType::UNSIGNED_BYTE_NORMALIZED:		glType = GL_UNSIGNED_BYTE;			break;
+	case VertexAttributeType::BYTE_NORMALIZED:				glType = GL_BYTE;					break;
+	case VertexAttributeType::UNSIGNED_SHORT_NORMALIZED:	glType = GL_UNSIGNED_SHORT;			break;
+	case VertexAttributeType::SHORT_NORMALIZED:				glType = GL_SHORT;					break;
+	case VertexAttributeType::INT_2_10_10_10_NORMALIZED:	glType = GL_INT_2_10_10_10_REV;		break;
+	}
 
 	// http://www.khronos.org/opengles/sdk/docs/man/xhtml/glVertexAttribPointer.xml
 	glVertexAttribPointer(
 		position,
-		size,
-		GL_FLOAT,
-		GL_FALSE,
+		type == VertexAttributeType::INT_2_10_10_10_NORMALIZED ? 4 : size,
+		glType,
+		type == VertexAttributeType::FLOAT || type == VertexAttributeType::HALF_FLOAT ? GL_FALSE : GL_TRUE,
 		sizeof(GLfloat) * stride,
 		(void*)(sizeof(GLfloat) * offset)
 	);
@@ -448,19 +1011,119 @@ OpenGLES2Context::setVertexBufferAt(const uint	position,
 	checkForErrors();
 }
 
+void
+OpenGLES2Context::setVertexAttributeDivisor(const uint position, const uint divisor)
+{
+	if (position >= _currentVertexDivisor.size())
+		throw std::invalid_argument("position");
+
+	if (_currentVertexDivisor[position] == divisor)
+		return;
+
+	if (!_instancingSupported)
+		throw std::logic_error("instanced rendering is not supported by this context");
+
+	_currentVertexDivisor[position] = divisor;
+
+#ifndef MINKO_NO_INSTANCING
+	glVertexAttribDivisorInstancing(position, divisor);
+#endif
+
+	checkForErrors();
+}
+
 const uint
-OpenGLES2Context::createIndexBuffer(const uint size)
+OpenGLES2Context::createVertexArray()
 {
+	if (!_vertexArraysSupported)
+		throw std::logic_error("vertex array objects are not supported by this context");
+
+	uint vertexArray = 0;
+
+#ifndef MINKO_NO_VERTEX_ARRAY
+	glGenVertexArraysCompatible(1, &vertexArray);
+	checkForErrors();
+#endif
+
+	_vertexArrays.push_back(vertexArray);
+
+	return vertexArray;
+}
+
+void
+OpenGLES2Context::setVertexArray(const uint vertexArray)
+{
+	if (_currentVertexArray == vertexArray)
+		return;
+
+	if (!_vertexArraysSupported)
+		throw std::logic_error("vertex array objects are not supported by this context");
+
+#ifndef MINKO_NO_VERTEX_ARRAY
+	glBindVertexArrayCompatible(vertexArray);
+	checkForErrors();
+#endif
+
+	// the index buffer is part of the state of the vertex array, the attributes are only known again once set
+	_vertexArrayIndexBuffers[_currentVertexArray] = _currentIndexBuffer;
+	_currentVertexArray = vertexArray;
+
+	auto indexBufferIt = _vertexArrayIndexBuffers.find(vertexArray);
+
+	_currentIndexBuffer = indexBufferIt != _vertexArrayIndexBuffers.end() ? indexBufferIt->second : 0;
+	if (_currentIndexBuffer > 0)
+		_currentIndexSize = _indexBufferIndexSize[_currentIndexBuffer];
+
+	std::fill(_currentVertexBuffer.begin(), _currentVertexBuffer.end(), -1);
+}
+
+void
+OpenGLES2Context::deleteVertexArray(const uint vertexArray)
+{
+	auto vertexArrayIt = std::find(_vertexArrays.begin(), _vertexArrays.end(), vertexArray);
+
+	if (vertexArrayIt == _vertexArrays.end())
+		throw std::invalid_argument("vertexArray");
+
+	// deleting the bound vertex array binds the default one
+	if (_currentVertexArray == vertexArray)
+		setVertexArray(0);
+
+	_vertexArrays.erase(vertexArrayIt);
+	_vertexArrayIndexBuffers.erase(vertexArray);
+
+#ifndef MINKO_NO_VERTEX_ARRAY
+	glDeleteVertexArraysCompatible(1, &vertexArray);
+	checkForErrors();
+#endif
+}
+
+const uint
+OpenGLES2Context::createIndexBuffer(const uint size, const bool useUnsignedInt, BufferUsage usage)
+{
+	if (useUnsignedInt && !_unsignedIntIndicesSupported)
+		throw std::logic_error("32 bits indices are not supported by this context");
+
 	uint indexBuffer;
 
 	glGenBuffers(1, &indexBuffer);
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
 
 	_currentIndexBuffer = indexBuffer;
-
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, size * sizeof(GLushort), 0, GL_STATIC_DRAW);
+	_currentIndexSize = useUnsignedInt ? sizeof(GLuint) : sizeof(GLushort);
+	_indexBufferIndexSize[indexBuffer] = _currentIndexSize;
+
+	glBufferData(
+		GL_ELEMENT_ARRAY_BUFFER,
+		size * _currentIndexSize,
+		0,
+		usage == BufferUsage::STATIC ? GL_STATIC_DRAW : usage == BufferUsage::DYNAMIC ? GL_DYNAMIC_DRAW : GL_STREAM_DRAW
+	);
 
 	_indexBuffers.push_back(indexBuffer);
+	if (usage != BufferUsage::STATIC)
+		_dynamicBuffers[indexBuffer] = std::make_pair(size * _currentIndexSize, usage);
+	setMemorySize(_bufferMemorySizes, _bufferMemory, indexBuffer, size * _currentIndexSize);
 
 	checkForErrors();
 
@@ -474,10 +1137,12 @@ OpenGLES2Context::uploaderIndexBufferData(const uint 	indexBuffer,
 										  void*					data)
 {
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+	++_stats.numBufferBinds;
 
 	_currentIndexBuffer = indexBuffer;
-	
-	glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset * sizeof(GLushort), size * sizeof(GLushort), data);
+	_currentIndexSize = _indexBufferIndexSize[indexBuffer];
+
+	uploadBufferData(GL_ELEMENT_ARRAY_BUFFER, indexBuffer, offset * _currentIndexSize, size * _currentIndexSize, data);
 
 	checkForErrors();
 }
@@ -488,7 +1153,15 @@ OpenGLES2Context::deleteIndexBuffer(const uint indexBuffer)
 	if (_currentIndexBuffer == indexBuffer)
 		_currentIndexBuffer = 0;
 
+	for (auto& vertexArrayIndexBuffer : _vertexArrayIndexBuffers)
+		if (vertexArrayIndexBuffer.second == static_cast<int>(indexBuffer))
+			vertexArrayIndexBuffer.second = 0;
+
 	_indexBuffers.erase(std::find(_indexBuffers.begin(), _indexBuffers.end(), indexBuffer));
+	_indexBufferIndexSize.erase(indexBuffer);
+	_dynamicBuffers.erase(indexBuffer);
+	setMemorySize(_bufferMemorySizes, _bufferMemory, indexBuffer, 0);
+	_bufferMemorySizes.erase(indexBuffer);
 
 	glDeleteBuffers(1, &indexBuffer);
 
@@ -504,14 +1177,15 @@ OpenGLES2Context::createTexture(TextureType	type,
 {
 	uint texture;
 
-	// make sure width is a power of 2
-	if (!((width != 0) && !(width & (width - 1))))
+	if (width == 0)
 		throw std::invalid_argument("width");
-
-	// make sure height is a power of 2
-	if (!((height != 0) && !(height & (height - 1))))
+	if (height == 0)
 		throw std::invalid_argument("height");
 
+	// NPOT sizes are only valid with mipmaps when fully supported
+	if (!supportsNonPowerOfTwoTextures(mipMapping) && !(math::isp2(width) && math::isp2(height)))
+		throw std::invalid_argument("width and height must be powers of 2");
+
 	// http://www.opengl.org/sdk/docs/man/xhtml/glGenTextures.xml
 	//
 	// void glGenTextures(GLsizei n, GLuint* textures)
@@ -547,9 +1221,22 @@ OpenGLES2Context::createTexture(TextureType	type,
 	_textureHasMipmaps[texture]		= mipMapping;
 	_textureTypes[texture]			= type;
 
-	_currentWrapMode[texture]		= WrapMode::CLAMP;
-	_currentTextureFilter[texture]	= TextureFilter::NEAREST;
-	_currentMipFilter[texture]		= MipFilter::NONE;
+	// a mipmap chain adds a third of the base level
+	auto textureMemory = (unsigned long long)width * height * 4 * (type == TextureType::Texture2D ? 1 : 6);
+
+	setMemorySize(_textureMemorySizes, _textureMemory, texture, mipMapping ? textureMemory * 4 / 3 : textureMemory);
+
+	TextureSampler sampler;
+
+	sampler.glTarget		= glTarget;
+	sampler.hasMipmaps		= mipMapping;
+	// NPOT textures cannot repeat without full NPOT support
+	sampler.repeatable		= _npotTexturesSupported || (math::isp2(width) && math::isp2(height));
+	sampler.wrapMode		= WrapMode::CLAMP;
+	sampler.textureFilter	= TextureFilter::NEAREST;
+	sampler.mipFilter		= MipFilter::NONE;
+
+	_textureSamplers[texture] = sampler;
 
 	// http://www.opengl.org/sdk/docs/man/xhtml/glTexImage2D.xml
 	//
@@ -640,59 +1327,232 @@ OpenGLES2Context::uploadTexture2dData(uint 		texture,
 	glTexImage2D(GL_TEXTURE_2D, mipLevel, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
 	
 	_currentBoundTexture = texture;
+	if (mipLevel == 0)
+	{
+		const auto textureMemory = (unsigned long long)width * height * 4;
+
+		setMemorySize(
+			_textureMemorySizes, _textureMemory, texture,
+			_textureHasMipmaps[texture] ? textureMemory * 4 / 3 : textureMemory
+		);
+	}
+	++_stats.numTextureBinds;
+	_stats.numBytesUploaded += width * height * 4;
 
 	checkForErrors();
 }
 
 void
-OpenGLES2Context::uploadCubeTextureData(uint				texture,
-										CubeTexture::Face	face,
-										unsigned int 		width,
-										unsigned int 		height,
-										unsigned int 		mipLevel,
-										void*				data)
+OpenGLES2Context::uploadFloatTexture2dData(uint			texture,
+										   uint			width,
+										   uint			height,
+										   const float*	data)
 {
-	assert(getTextureType(texture) == TextureType::CubeTexture);
+	assert(getTextureType(texture) == TextureType::Texture2D);
 
-	glBindTexture(GL_TEXTURE_CUBE_MAP, texture);
+	if (!_floatTexturesSupported)
+		throw std::logic_error("float textures are not supported");
 
-	GLenum cubeFace;
-	switch (face)
-	{
-	case minko::render::CubeTexture::Face::POSITIVE_X:
-		cubeFace = GL_TEXTURE_CUBE_MAP_POSITIVE_X;
-		break;
-	case minko::render::CubeTexture::Face::NEGATIVE_X:
-		cubeFace = GL_TEXTURE_CUBE_MAP_NEGATIVE_X;
-		break;
-	case minko::render::CubeTexture::Face::POSITIVE_Y:
-		cubeFace = GL_TEXTURE_CUBE_MAP_POSITIVE_Y;
-		break;
-	case minko::render::CubeTexture::Face::NEGATIVE_Y:
-		cubeFace = GL_TEXTURE_CUBE_MAP_NEGATIVE_Y;
-		break;
-	case minko::render::CubeTexture::Face::POSITIVE_Z:
-		cubeFace = GL_TEXTURE_CUBE_MAP_POSITIVE_Z;
-		break;
-	case minko::render::CubeTexture::Face::NEGATIVE_Z:
-		cubeFace = GL_TEXTURE_CUBE_MAP_NEGATIVE_Z;
-		break;
-	default:
-		throw;
-		break;
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glTexImage2D(GL_TEXTURE_2D, 0, MINKO_GL_FLOAT_TEXTURE_FORMAT, width, height, 0, GL_RGBA, GL_FLOAT, data);
+
+	_currentBoundTexture = texture;
+	setMemorySize(_textureMemorySizes, _textureMemory, texture, (unsigned long long)width * height * 16);
+	++_stats.numTextureBinds;
+	_stats.numBytesUploaded += width * height * 16;
+
+	checkForErrors();
+}
+
+void
+OpenGLES2Context::initializeCompressedTextureFormats(const std::string& extensions)
+{
+	auto& m = _compressedTextureFormats;
+
+	// WEBGL_compressed_texture_s3tc and the likes are matched as well
+	if (extensions.find("texture_compression_s3tc") != std::string::npos)
+	{
+		m[TextureFormat::RGB_DXT1]	= GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+		m[TextureFormat::RGBA_DXT1]	= GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+		m[TextureFormat::RGBA_DXT3]	= GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+		m[TextureFormat::RGBA_DXT5]	= GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+	}
+
+	if (extensions.find("compressed_ETC1_RGB8_texture") != std::string::npos)
+		m[TextureFormat::RGB_ETC1] = GL_ETC1_RGB8_OES;
+
+	if (extensions.find("ES3_compatibility") != std::string::npos
+		|| extensions.find("compressed_texture_etc") != std::string::npos)
+	{
+		m[TextureFormat::RGB_ETC2]	= GL_COMPRESSED_RGB8_ETC2;
+		m[TextureFormat::RGBA_ETC2]	= GL_COMPRESSED_RGBA8_ETC2_EAC;
+		// ETC2 decoders are backward compatible with ETC1
+		if (m.count(TextureFormat::RGB_ETC1) == 0)
+			m[TextureFormat::RGB_ETC1] = GL_COMPRESSED_RGB8_ETC2;
+	}
+
+	if (extensions.find("texture_compression_pvrtc") != std::string::npos)
+	{
+		m[TextureFormat::RGB_PVRTC_2BPP]	= GL_COMPRESSED_RGB_PVRTC_2BPPV1_IMG;
+		m[TextureFormat::RGB_PVRTC_4BPP]	= GL_COMPRESSED_RGB_PVRTC_4BPPV1_IMG;
+		m[TextureFormat::RGBA_PVRTC_2BPP]	= GL_COMPRESSED_RGBA_PVRTC_2BPPV1_IMG;
+		m[TextureFormat::RGBA_PVRTC_4BPP]	= GL_COMPRESSED_RGBA_PVRTC_4BPPV1_IMG;
 	}
 
-	glTexImage2D(cubeFace, mipLevel, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+	if (extensions.find("texture_compression_astc") != std::string::npos)
+		m[TextureFormat::RGBA_ASTC_4x4] = GL_COMPRESSED_RGBA_ASTC_4x4_KHR;
+}
+
+void
+OpenGLES2Context::uploadCompressedTexture2dData(uint			texture,
+												TextureFormat	format,
+												uint			width,
+												uint			height,
+												uint			mipLevel,
+												void*			data)
+{
+	assert(getTextureType(texture) == TextureType::Texture2D);
+
+	auto formatIt = _compressedTextureFormats.find(format);
+
+	if (formatIt == _compressedTextureFormats.end())
+		throw std::invalid_argument("format: unsupported compressed texture format");
+
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glCompressedTexImage2D(
+		GL_TEXTURE_2D,
+		mipLevel,
+		formatIt->second,
+		width,
+		height,
+		0,
+		AbstractTexture::dataSize(format, width, height),
+		data
+	);
+
+	_currentBoundTexture = texture;
+	++_stats.numTextureBinds;
+	_stats.numBytesUploaded += AbstractTexture::dataSize(format, width, height);
+	// the compressed storage replaces the RGBA one allocated by createTexture()
+	if (mipLevel == 0)
+	{
+		const auto textureMemory = (unsigned long long)AbstractTexture::dataSize(format, width, height);
+
+		setMemorySize(
+			_textureMemorySizes, _textureMemory, texture,
+			_textureHasMipmaps[texture] ? textureMemory * 4 / 3 : textureMemory
+		);
+	}
+
+	checkForErrors();
+}
+
+void
+OpenGLES2Context::releaseTextureStorage(uint texture)
+{
+	assert(getTextureType(texture) == TextureType::Texture2D);
+
+	const unsigned char pixel[4] = { 0, 0, 0, 0 };
+	const auto& size = _textureSizes[texture];
+
+	glBindTexture(GL_TEXTURE_2D, texture);
+	// a 1x1 level 0 keeps the texture complete whatever its filtering, the other levels are freed
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+	if (_textureHasMipmaps[texture])
+	{
+		uint level = 1;
+
+		for (uint s = std::max(size.first, size.second) >> 1; s > 0; s >>= 1)
+			glTexImage2D(GL_TEXTURE_2D, level++, GL_RGBA, 0, 0, 0, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+	}
+
+	_currentBoundTexture = texture;
+	setMemorySize(_textureMemorySizes, _textureMemory, texture, 4);
+
+	checkForErrors();
+}
+
+void
+OpenGLES2Context::setTextureBaseLevel(uint texture, uint level)
+{
+#ifndef MINKO_NO_TEXTURE_BASE_LEVEL
+	assert(getTextureType(texture) == TextureType::Texture2D);
+
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level);
 
 	_currentBoundTexture = texture;
 
 	checkForErrors();
+#endif
+}
+
+void
+OpenGLES2Context::uploadCubeTextureData(uint				texture,
+										CubeTexture::Face	face,
+										unsigned int 		width,
+										unsigned int 		height,
+										unsigned int 		mipLevel,
+										void*				data)
+{
+	assert(getTextureType(texture) == TextureType::CubeTexture);
+
+	glBindTexture(GL_TEXTURE_CUBE_MAP, texture);
+	glTexImage2D(getGLCubeFace(face), mipLevel, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+
+	_currentBoundTexture = texture;
+	++_stats.numTextureBinds;
+	_stats.numBytesUploaded += width * height * 4;
+
+	checkForErrors();
+}
+
+void
+OpenGLES2Context::copyToCubeTexture(uint				texture,
+									CubeTexture::Face	face,
+									unsigned int		width,
+									unsigned int		height)
+{
+	assert(getTextureType(texture) == TextureType::CubeTexture);
+
+	glBindTexture(GL_TEXTURE_CUBE_MAP, texture);
+	// the pixels stay on the GPU
+	glCopyTexSubImage2D(getGLCubeFace(face), 0, 0, 0, 0, 0, width, height);
+
+	_currentBoundTexture = texture;
+	++_stats.numTextureBinds;
+
+	checkForErrors();
+}
+
+uint
+OpenGLES2Context::getGLCubeFace(CubeTexture::Face face)
+{
+	switch (face)
+	{
+	case CubeTexture::Face::POSITIVE_X:
+		return GL_TEXTURE_CUBE_MAP_POSITIVE_X;
+	case CubeTexture::Face::NEGATIVE_X:
+		return GL_TEXTURE_CUBE_MAP_NEGATIVE_X;
+	case CubeTexture::Face::POSITIVE_Y:
+		return GL_TEXTURE_CUBE_MAP_POSITIVE_Y;
+	case CubeTexture::Face::NEGATIVE_Y:
+		return GL_TEXTURE_CUBE_MAP_NEGATIVE_Y;
+	case CubeTexture::Face::POSITIVE_Z:
+		return GL_TEXTURE_CUBE_MAP_POSITIVE_Z;
+	case CubeTexture::Face::NEGATIVE_Z:
+		return GL_TEXTURE_CUBE_MAP_NEGATIVE_Z;
+	default:
+		throw std::invalid_argument("face");
+	}
 }
 
 void
 OpenGLES2Context::deleteTexture(uint texture)
 {
 	_textures.erase(std::find(_textures.begin(), _textures.end(), texture));
+	setMemorySize(_textureMemorySizes, _textureMemory, texture, 0);
+	_textureMemorySizes.erase(texture);
 
 	glDeleteTextures(1, &texture);
 
@@ -701,7 +1561,14 @@ OpenGLES2Context::deleteTexture(uint texture)
 		glDeleteFramebuffers(1, &_frameBuffers[texture]);
 		_frameBuffers.erase(texture);
 
-		glDeleteRenderbuffers(1, &_renderBuffers[texture]);
+		const auto& size			= _textureSizes[texture];
+		const auto	depthBufferIt	= _depthBuffers.find((uint64_t(size.first) << 32) | size.second);
+
+		if (depthBufferIt != _depthBuffers.end() && --depthBufferIt->second.second == 0)
+		{
+			glDeleteRenderbuffers(1, &depthBufferIt->second.first);
+			_depthBuffers.erase(depthBufferIt);
+		}
 		_renderBuffers.erase(texture);
 	}
 
@@ -709,12 +1576,13 @@ OpenGLES2Context::deleteTexture(uint texture)
 	_textureHasMipmaps.erase(texture);
 	_textureTypes.erase(texture);
 
-	_currentWrapMode.erase(texture);
-	_currentTextureFilter.erase(texture);
-	_currentMipFilter.erase(texture);
+	_textureSamplers.erase(texture);
 
 	for (unsigned int pos = 0; pos < _currentTexture.size(); ++pos)
 		_currentTexture[pos] = (_currentTexture[pos] == texture ? 0 : _currentTexture[pos]);
+	for (auto& textureAndSampler : _currentSampler)
+		if (textureAndSampler.first == (int)texture)
+			textureAndSampler = std::pair<int, TextureSampler*>(0, nullptr);
 	_currentBoundTexture = (_currentBoundTexture == texture ? 0 : _currentBoundTexture);
 
 	checkForErrors();
@@ -733,113 +1601,125 @@ OpenGLES2Context::setTextureAt(uint	position,
 	if (position >= _currentTexture.size())
 		return;
 
-	const auto glTarget	= getTextureType(texture) == TextureType::Texture2D 
-		? GL_TEXTURE_2D 
-		: GL_TEXTURE_CUBE_MAP;
-
 	if (_currentTexture[position] != texture || 
 		_currentBoundTexture != texture)
 	{
+		const auto glTarget	= getTextureType(texture) == TextureType::Texture2D 
+			? GL_TEXTURE_2D 
+			: GL_TEXTURE_CUBE_MAP;
+
 		glActiveTexture(GL_TEXTURE0 + position);
 		glBindTexture(glTarget, texture);
 
 		_currentTexture[position]	= texture;
 		_currentBoundTexture		= texture;
+		++_stats.numTextureBinds;
 	}
 
-	if (textureIsValid && location >= 0)
-		glUniform1i(location, position);
+	const int unit = position;
+
+	if (textureIsValid && location >= 0 && uniformValueChanged(location, &unit, sizeof(int)))
+		glUniform1i(location, unit);
 
 	checkForErrors();
 }
 
+OpenGLES2Context::TextureSampler*
+OpenGLES2Context::currentSampler(uint position, WrapMode& wrapping, MipFilter& mipFiltering)
+{
+	if (position >= _currentTexture.size() || _currentTexture[position] <= 0)
+		return nullptr;
+
+	auto& textureAndSampler = _currentSampler[position];
+
+	if (textureAndSampler.first != _currentTexture[position])
+	{
+		auto samplerIt = _textureSamplers.find(_currentTexture[position]);
+
+		if (samplerIt == _textureSamplers.end())
+			return nullptr;
+
+		textureAndSampler = std::make_pair(_currentTexture[position], &samplerIt->second);
+	}
+
+	auto sampler = textureAndSampler.second;
+
+	// disable mip mapping if mip maps are not available
+	if (!sampler->hasMipmaps)
+		mipFiltering = MipFilter::NONE;
+
+	if (!sampler->repeatable && wrapping == WrapMode::REPEAT)
+		wrapping = WrapMode::CLAMP;
+
+	return sampler;
+}
+
+int
+OpenGLES2Context::getGLWrapMode(WrapMode wrapping)
+{
+	return wrapping == WrapMode::REPEAT ? GL_REPEAT : GL_CLAMP_TO_EDGE;
+}
+
+int
+OpenGLES2Context::getGLMinFilter(TextureFilter filtering, MipFilter mipFiltering)
+{
+	switch (mipFiltering)
+	{
+	case MipFilter::NEAREST :
+		return filtering == TextureFilter::NEAREST ? GL_NEAREST_MIPMAP_NEAREST : GL_LINEAR_MIPMAP_NEAREST;
+	case MipFilter::LINEAR :
+		return filtering == TextureFilter::NEAREST ? GL_NEAREST_MIPMAP_LINEAR : GL_LINEAR_MIPMAP_LINEAR;
+	default :
+		return filtering == TextureFilter::NEAREST ? GL_NEAREST : GL_LINEAR;
+	}
+}
+
+int
+OpenGLES2Context::getGLMagFilter(TextureFilter filtering)
+{
+	return filtering == TextureFilter::NEAREST ? GL_NEAREST : GL_LINEAR;
+}
+
 void
 OpenGLES2Context::setSamplerStateAt(uint			position, 
 									WrapMode		wrapping, 
 									TextureFilter	filtering, 
 									MipFilter		mipFiltering)
 {
-	const auto	texture		= _currentTexture[position];
-	const auto	glTarget	= getTextureType(texture) == TextureType::Texture2D 
-		? GL_TEXTURE_2D 
-		: GL_TEXTURE_CUBE_MAP; 
+	// the state is stored with the texture object: no lookup as long as the same texture stays bound
+	auto sampler = currentSampler(position, wrapping, mipFiltering);
 
-	auto active	= false;
+	if (!sampler)
+		return;
 
-	// disable mip mapping if mip maps are not available
-	if (!_textureHasMipmaps[texture])
-		mipFiltering = MipFilter::NONE;
+	const bool wrapModeChanged	= sampler->wrapMode != wrapping;
+	const bool filterChanged	= sampler->textureFilter != filtering || sampler->mipFilter != mipFiltering;
 
-	if (_currentWrapMode[texture] != wrapping)
-	{
-		_currentWrapMode[texture] = wrapping;
+	if (!wrapModeChanged && !filterChanged)
+		return;
 
-		glActiveTexture(GL_TEXTURE0 + position);
-		active = true;
+	glActiveTexture(GL_TEXTURE0 + position);
 
-		switch (wrapping)
-		{
-		case WrapMode::CLAMP :
-			glTexParameteri(glTarget, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-			glTexParameteri(glTarget, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-			break;
-		case WrapMode::REPEAT :
-			glTexParameteri(glTarget, GL_TEXTURE_WRAP_S, GL_REPEAT);
-			glTexParameteri(glTarget, GL_TEXTURE_WRAP_T, GL_REPEAT);
-			break;
-		}
+	if (wrapModeChanged)
+	{
+		sampler->wrapMode = wrapping;
+
+		glTexParameteri(sampler->glTarget, GL_TEXTURE_WRAP_S, getGLWrapMode(wrapping));
+		glTexParameteri(sampler->glTarget, GL_TEXTURE_WRAP_T, getGLWrapMode(wrapping));
 	}
 	
-	if (_currentTextureFilter[texture] != filtering || _currentMipFilter[texture] != mipFiltering)
+	if (filterChanged)
 	{
-		_currentTextureFilter[texture] = filtering;
-		_currentMipFilter[texture] = mipFiltering;
-
-		if (!active)
-			glActiveTexture(GL_TEXTURE0 + position);
-
-		switch (filtering)
-		{
-		case TextureFilter::NEAREST :
-			switch (mipFiltering)
-			{
-			case MipFilter::NONE :
-				glTexParameteri(glTarget, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-				break;
-			case MipFilter::NEAREST :
-				glTexParameteri(glTarget, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
-				break;
-			case MipFilter::LINEAR :
-				glTexParameteri(glTarget, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR);
-				break;
-			}
+		sampler->textureFilter = filtering;
+		sampler->mipFilter = mipFiltering;
 
-			glTexParameteri(glTarget, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-			break;
-		case TextureFilter::LINEAR :
-			switch (mipFiltering)
-			{
-			case MipFilter::NONE :
-				glTexParameteri(glTarget, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-				break;
-			case MipFilter::NEAREST :
-				glTexParameteri(glTarget, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_NEAREST);
-				break;
-			case MipFilter::LINEAR :
-				glTexParameteri(glTarget, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-				break;
-			}
-
-			glTexParameteri(glTarget, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-			break;
-		}
+		glTexParameteri(sampler->glTarget, GL_TEXTURE_MIN_FILTER, getGLMinFilter(filtering, mipFiltering));
+		glTexParameteri(sampler->glTarget, GL_TEXTURE_MAG_FILTER, getGLMagFilter(filtering));
 	}
 
 	checkForErrors();
 }
 
-
-
 const uint
 OpenGLES2Context::createProgram()
 {
@@ -864,6 +1744,9 @@ OpenGLES2Context::linkProgram(const uint program)
 {
 	glLinkProgram(program);
 
+	// linking resets the values of all the uniforms of the program
+	_programUniformValues[program].clear();
+
 #ifdef DEBUG
 	auto errors = getProgramInfoLogs(program);
 
@@ -876,11 +1759,78 @@ OpenGLES2Context::linkProgram(const uint program)
 	checkForErrors();
 }
 
+bool
+OpenGLES2Context::isProgramLinked(const uint program)
+{
+	if (!_parallelShaderCompileSupported)
+		return true;
+
+	int completionStatus = GL_FALSE;
+
+	glGetProgramiv(program, GL_COMPLETION_STATUS_KHR, &completionStatus);
+
+	return completionStatus == GL_TRUE;
+}
+
+bool
+OpenGLES2Context::getProgramBinary(const uint program, uint& format, std::vector<unsigned char>& binary)
+{
+#ifndef MINKO_NO_PROGRAM_BINARY
+	if (!_programBinariesSupported)
+		return false;
+
+	int length = 0;
+
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH_COMPATIBLE, &length);
+
+	if (length <= 0)
+		return false;
+
+	GLenum binaryFormat = 0;
+
+	binary.resize(length);
+	glGetProgramBinaryCompatible(program, length, &length, &binaryFormat, &binary[0]);
+	binary.resize(length);
+	format = binaryFormat;
+
+	return glGetError() == GL_NO_ERROR;
+#else
+	return false;
+#endif
+}
+
+bool
+OpenGLES2Context::setProgramBinary(const uint program, const uint format, const std::vector<unsigned char>& binary)
+{
+#ifndef MINKO_NO_PROGRAM_BINARY
+	if (!_programBinariesSupported || binary.empty())
+		return false;
+
+	glProgramBinaryCompatible(program, format, &binary[0], binary.size());
+
+	// loading a binary (re)links the program
+	_programUniformValues[program].clear();
+
+	int linkStatus = GL_FALSE;
+
+	glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
+
+	// an outdated binary raises GL_INVALID_ENUM or fails to link, the caller then compiles the sources
+	return glGetError() == GL_NO_ERROR && linkStatus == GL_TRUE;
+#else
+	return false;
+#endif
+}
+
 void
 OpenGLES2Context::deleteProgram(const uint program)
 {
 	_programs.erase(std::find(_programs.begin(), _programs.end(), program));
 
+	if (_currentUniformValues == &_programUniformValues[program])
+		_currentUniformValues = nullptr;
+	_programUniformValues.erase(program);
+
 	glDeleteProgram(program);
 
 	checkForErrors();
@@ -919,8 +1869,10 @@ OpenGLES2Context::setProgram(const uint program)
 		return;
 
 	_currentProgram = program;
+	_currentUniformValues = &_programUniformValues[program];
 
 	glUseProgram(program);
+	++_stats.numProgramSwitches;
 
 	checkForErrors();
 }
@@ -1225,6 +2177,9 @@ OpenGLES2Context::getProgramInfoLogs(const uint program)
 void
 OpenGLES2Context::setUniform(uint location, int value)
 {
+	if (!uniformValueChanged(location, &value, sizeof(int)))
+		return;
+
 	glUniform1i(location, value);
 	checkForErrors();
 }
@@ -1232,6 +2187,11 @@ OpenGLES2Context::setUniform(uint location, int value)
 void
 OpenGLES2Context::setUniform(uint location, int v1, int v2)
 {
+	const int values[2] = { v1, v2 };
+
+	if (!uniformValueChanged(location, values, sizeof(values)))
+		return;
+
 	glUniform2i(location, v1, v2);
 	checkForErrors();
 }
@@ -1239,6 +2199,11 @@ OpenGLES2Context::setUniform(uint location, int v1, int v2)
 void
 OpenGLES2Context::setUniform(uint location, int v1, int v2, int v3)
 {
+	const int values[3] = { v1, v2, v3 };
+
+	if (!uniformValueChanged(location, values, sizeof(values)))
+		return;
+
 	glUniform3i(location, v1, v2, v3);
 	checkForErrors();
 }
@@ -1246,6 +2211,11 @@ OpenGLES2Context::setUniform(uint location, int v1, int v2, int v3)
 void
 OpenGLES2Context::setUniform(uint location, int v1, int v2, int v3, int v4)
 {
+	const int values[4] = { v1, v2, v3, v4 };
+
+	if (!uniformValueChanged(location, values, sizeof(values)))
+		return;
+
 	glUniform4i(location, v1, v2, v3, v4);
 	checkForErrors();
 }
@@ -1253,6 +2223,9 @@ OpenGLES2Context::setUniform(uint location, int v1, int v2, int v3, int v4)
 void
 OpenGLES2Context::setUniform(uint location, float value)
 {
+	if (!uniformValueChanged(location, &value, sizeof(float)))
+		return;
+
 	glUniform1f(location, value);
 	checkForErrors();
 }
@@ -1260,6 +2233,11 @@ OpenGLES2Context::setUniform(uint location, float value)
 void
 OpenGLES2Context::setUniform(uint location, float v1, float v2)
 {
+	const float values[2] = { v1, v2 };
+
+	if (!uniformValueChanged(location, values, sizeof(values)))
+		return;
+
 	glUniform2f(location, v1, v2);
 	checkForErrors();
 }
@@ -1267,6 +2245,11 @@ OpenGLES2Context::setUniform(uint location, float v1, float v2)
 void
 OpenGLES2Context::setUniform(uint location, float v1, float v2, float v3)
 {
+	const float values[3] = { v1, v2, v3 };
+
+	if (!uniformValueChanged(location, values, sizeof(values)))
+		return;
+
 	glUniform3f(location, v1, v2, v3);
 	checkForErrors();
 }
@@ -1274,6 +2257,11 @@ OpenGLES2Context::setUniform(uint location, float v1, float v2, float v3)
 void
 OpenGLES2Context::setUniform(uint location, float v1, float v2, float v3, float v4)
 {
+	const float values[4] = { v1, v2, v3, v4 };
+
+	if (!uniformValueChanged(location, values, sizeof(values)))
+		return;
+
 	glUniform4f(location, v1, v2, v3, v4);
 	checkForErrors();
 }
@@ -1281,6 +2269,9 @@ OpenGLES2Context::setUniform(uint location, float v1, float v2, float v3, float
 void
 OpenGLES2Context::setUniforms(uint location, uint size, const float* values)
 {
+	if (!uniformValueChanged(location, values, size * sizeof(float)))
+		return;
+
 	glUniform1fv(location, size, values);
 	checkForErrors();
 }
@@ -1288,6 +2279,9 @@ OpenGLES2Context::setUniforms(uint location, uint size, const float* values)
 void
 OpenGLES2Context::setUniforms2(uint location, uint size, const float* values)
 {
+	if (!uniformValueChanged(location, values, size * 2 * sizeof(float)))
+		return;
+
 	glUniform2fv(location, size, values);
 	checkForErrors();
 }
@@ -1295,6 +2289,9 @@ OpenGLES2Context::setUniforms2(uint location, uint size, const float* values)
 void
 OpenGLES2Context::setUniforms3(uint location, uint size, const float* values)
 {
+	if (!uniformValueChanged(location, values, size * 3 * sizeof(float)))
+		return;
+
 	glUniform3fv(location, size, values);
 	checkForErrors();
 }
@@ -1302,6 +2299,9 @@ OpenGLES2Context::setUniforms3(uint location, uint size, const float* values)
 void
 OpenGLES2Context::setUniforms4(uint location, uint size, const float* values)
 {
+	if (!uniformValueChanged(location, values, size * 4 * sizeof(float)))
+		return;
+
 	glUniform4fv(location, size, values);
 	checkForErrors();
 }
@@ -1309,6 +2309,9 @@ OpenGLES2Context::setUniforms4(uint location, uint size, const float* values)
 void
 OpenGLES2Context::setUniforms(uint location, uint size, const int* values)
 {
+	if (!uniformValueChanged(location, values, size * sizeof(int)))
+		return;
+
 	glUniform1iv(location, size, values);
 	checkForErrors();
 }
@@ -1316,6 +2319,9 @@ OpenGLES2Context::setUniforms(uint location, uint size, const int* values)
 void
 OpenGLES2Context::setUniforms2(uint location, uint size, const int* values)
 {
+	if (!uniformValueChanged(location, values, size * 2 * sizeof(int)))
+		return;
+
 	glUniform2iv(location, size, values);
 	checkForErrors();
 }
@@ -1323,6 +2329,9 @@ OpenGLES2Context::setUniforms2(uint location, uint size, const int* values)
 void
 OpenGLES2Context::setUniforms3(uint location, uint size, const int* values)
 {
+	if (!uniformValueChanged(location, values, size * 3 * sizeof(int)))
+		return;
+
 	glUniform3iv(location, size, values);
 	checkForErrors();
 }
@@ -1330,6 +2339,9 @@ OpenGLES2Context::setUniforms3(uint location, uint size, const int* values)
 void
 OpenGLES2Context::setUniforms4(uint location, uint size, const int* values)
 {
+	if (!uniformValueChanged(location, values, size * 4 * sizeof(int)))
+		return;
+
 	glUniform4iv(location, size, values);
 	checkForErrors();
 }
@@ -1337,6 +2349,9 @@ OpenGLES2Context::setUniforms4(uint location, uint size, const int* values)
 void
 OpenGLES2Context::setUniform(const uint& location, const uint& size, bool transpose, const float* values)
 {
+	if (!uniformValueChanged(location, values, (size << 4) * sizeof(float), transpose ? 1 : 0))
+		return;
+
 #ifdef GL_ES_VERSION_2_0
 
 	if (transpose)
@@ -1390,8 +2405,8 @@ OpenGLES2Context::setBlendMode(Blending::Source source, Blending::Destination de
 		_currentBlendMode = (Blending::Mode)((uint)source | (uint)destination);
 
 		glBlendFunc(
-			_blendingFactors[static_cast<uint>(source) & 0x00ff],
-			_blendingFactors[static_cast<uint>(destination) & 0xff00]
+			_blendingFactors.at(static_cast<uint>(source) & 0x00ff),
+			_blendingFactors.at(static_cast<uint>(destination) & 0xff00)
 		);
 	}
 
@@ -1406,8 +2421,8 @@ OpenGLES2Context::setBlendMode(Blending::Mode blendMode)
 		_currentBlendMode = blendMode;
 
 		glBlendFunc(
-			_blendingFactors[static_cast<uint>(blendMode) & 0x00ff],
-			_blendingFactors[static_cast<uint>(blendMode) & 0xff00]
+			_blendingFactors.at(static_cast<uint>(blendMode) & 0x00ff),
+			_blendingFactors.at(static_cast<uint>(blendMode) & 0xff00)
 		);
 	}
 
@@ -1423,7 +2438,7 @@ OpenGLES2Context::setDepthTest(bool depthMask, CompareMode depthFunc)
 		_currentDepthFunc = depthFunc;
 
 		glDepthMask(depthMask);
-		glDepthFunc(_compareFuncs[depthFunc]);
+		glDepthFunc(_compareFuncs.at(depthFunc));
 	}
 
 	checkForErrors();
@@ -1459,7 +2474,7 @@ OpenGLES2Context::setStencilTest(CompareMode stencilFunc,
 		_currentStencilRef	= stencilRef;
 		_currentStencilMask	= stencilMask;
 
-		glStencilFunc(_compareFuncs[stencilFunc], stencilRef, stencilMask);
+		glStencilFunc(_compareFuncs.at(stencilFunc), stencilRef, stencilMask);
 	}
 
 	checkForErrors();
@@ -1472,7 +2487,7 @@ OpenGLES2Context::setStencilTest(CompareMode stencilFunc,
 		_currentStencilZFailOp	= stencilZFailOp;
 		_currentStencilZPassOp	= stencilZPassOp;
 
-		glStencilOp(_stencilOps[stencilFailOp], _stencilOps[stencilZFailOp], _stencilOps[stencilZPassOp]);
+		glStencilOp(_stencilOps.at(stencilFailOp), _stencilOps.at(stencilZFailOp), _stencilOps.at(stencilZPassOp));
 	}
 
 	checkForErrors();
@@ -1532,6 +2547,423 @@ OpenGLES2Context::readPixels(unsigned char* pixels)
 	checkForErrors();
 }
 
+const uint
+OpenGLES2Context::createPixelBuffer(const uint size)
+{
+	uint pixelBuffer = 0;
+
+#ifndef MINKO_NO_PIXEL_BUFFER
+	if (_pixelBuffersSupported)
+	{
+		glGenBuffers(1, &pixelBuffer);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, pixelBuffer);
+		glBufferData(GL_PIXEL_PACK_BUFFER, size, 0, GL_STREAM_READ);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		// only the size is kept
+		_pixelBuffers[pixelBuffer].resize(0);
+
+		checkForErrors();
+
+		return pixelBuffer;
+	}
+#endif
+
+	pixelBuffer = ++_nextPixelBufferId;
+	_pixelBuffers[pixelBuffer].resize(size);
+
+	return pixelBuffer;
+}
+
+void
+OpenGLES2Context::deletePixelBuffer(const uint pixelBuffer)
+{
+	if (_pixelBuffers.erase(pixelBuffer) == 0)
+		throw std::invalid_argument("pixelBuffer");
+
+#ifndef MINKO_NO_PIXEL_BUFFER
+	if (_pixelBuffersSupported)
+	{
+		glDeleteBuffers(1, &pixelBuffer);
+
+		checkForErrors();
+	}
+#endif
+}
+
+void
+OpenGLES2Context::readPixelsAsync(unsigned int	x,
+								  unsigned int	y,
+								  unsigned int	width,
+								  unsigned int	height,
+								  const uint	pixelBuffer)
+{
+	auto pixelBufferIt = _pixelBuffers.find(pixelBuffer);
+
+	if (pixelBufferIt == _pixelBuffers.end())
+		throw std::invalid_argument("pixelBuffer");
+
+#ifndef MINKO_NO_PIXEL_BUFFER
+	if (_pixelBuffersSupported)
+	{
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, pixelBuffer);
+		glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		checkForErrors();
+
+		return;
+	}
+#endif
+
+	if (pixelBufferIt->second.size() < width * height * 4)
+		throw std::invalid_argument("width, height");
+
+	readPixels(x, y, width, height, &pixelBufferIt->second[0]);
+}
+
+void
+OpenGLES2Context::pixelBufferData(const uint pixelBuffer, const uint size, unsigned char* pixels)
+{
+	auto pixelBufferIt = _pixelBuffers.find(pixelBuffer);
+
+	if (pixelBufferIt == _pixelBuffers.end())
+		throw std::invalid_argument("pixelBuffer");
+
+#ifndef MINKO_NO_PIXEL_BUFFER
+	if (_pixelBuffersSupported)
+	{
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, pixelBuffer);
+
+		auto data = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+
+		if (data)
+		{
+			std::memcpy(pixels, data, size);
+			glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+		}
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		checkForErrors();
+
+		return;
+	}
+#endif
+
+	if (pixelBufferIt->second.size() < size)
+		throw std::invalid_argument("size");
+
+	std::memcpy(pixels, &pixelBufferIt->second[0], size);
+}
+
+const uint
+OpenGLES2Context::createFence()
+{
+	const uint fence = ++_nextFenceId;
+
+#ifndef MINKO_NO_FENCE
+	if (_fencesSupported)
+	{
+		_fences[fence] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+		// the fence has to reach the GPU for glClientWaitSync() to ever return GL_ALREADY_SIGNALED
+		glFlush();
+		checkForErrors();
+
+		return fence;
+	}
+#endif
+
+	_fences[fence] = nullptr;
+
+	return fence;
+}
+
+void
+OpenGLES2Context::deleteFence(const uint fence)
+{
+	auto fenceIt = _fences.find(fence);
+
+	if (fenceIt == _fences.end())
+		throw std::invalid_argument("fence");
+
+#ifndef MINKO_NO_FENCE
+	if (_fencesSupported)
+	{
+		glDeleteSync(static_cast<GLsync>(fenceIt->second));
+		checkForErrors();
+	}
+#endif
+
+	_fences.erase(fenceIt);
+}
+
+bool
+OpenGLES2Context::fenceSignaled(const uint fence)
+{
+	auto fenceIt = _fences.find(fence);
+
+	if (fenceIt == _fences.end())
+		throw std::invalid_argument("fence");
+
+#ifndef MINKO_NO_FENCE
+	if (_fencesSupported)
+	{
+		auto status = glClientWaitSync(static_cast<GLsync>(fenceIt->second), 0, 0);
+
+		checkForErrors();
+
+		return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+	}
+#endif
+
+	return true;
+}
+
+/*static*/
+void
+OpenGLES2Context::uploadTexture2dDataShared(uint		texture,
+											uint		width,
+											uint		height,
+											uint		mipLevel,
+											const void*	data,
+											bool		generateMipmaps)
+{
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glTexSubImage2D(GL_TEXTURE_2D, mipLevel, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, data);
+	if (generateMipmaps)
+		glGenerateMipmap(GL_TEXTURE_2D);
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+/*static*/
+void
+OpenGLES2Context::uploadBufferDataShared(bool indices, uint buffer, uint offset, uint size, const void* data)
+{
+	const auto target = indices ? GL_ELEMENT_ARRAY_BUFFER : GL_ARRAY_BUFFER;
+
+	glBindBuffer(target, buffer);
+	glBufferSubData(target, offset, size, data);
+	glBindBuffer(target, 0);
+}
+
+/*static*/
+void*
+OpenGLES2Context::createFenceShared(bool fencesSupported)
+{
+#ifndef MINKO_NO_FENCE
+	if (fencesSupported)
+	{
+		auto fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+		glFlush();
+
+		return fence;
+	}
+#endif
+
+	// the other contexts only see the objects once their commands were executed
+	glFinish();
+
+	return nullptr;
+}
+
+/*static*/
+bool
+OpenGLES2Context::fenceSignaledShared(void* fence)
+{
+#ifndef MINKO_NO_FENCE
+	if (fence)
+	{
+		auto status = glClientWaitSync(static_cast<GLsync>(fence), 0, 0);
+
+		return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+	}
+#endif
+
+	return true;
+}
+
+/*static*/
+void
+OpenGLES2Context::deleteFenceShared(void* fence)
+{
+#ifndef MINKO_NO_FENCE
+	if (fence)
+		glDeleteSync(static_cast<GLsync>(fence));
+#endif
+}
+
+const uint
+OpenGLES2Context::createTimerQuery()
+{
+	if (!_timerQueriesSupported)
+		throw std::logic_error("timer queries are not supported.");
+
+	uint query = 0;
+
+#ifndef MINKO_NO_TIMER_QUERY
+	glGenQueriesTimer(1, &query);
+	checkForErrors();
+#endif
+
+	_timerQueries.push_back(query);
+
+	return query;
+}
+
+void
+OpenGLES2Context::deleteTimerQuery(const uint query)
+{
+	auto queryIt = std::find(_timerQueries.begin(), _timerQueries.end(), query);
+
+	if (queryIt == _timerQueries.end())
+		throw std::invalid_argument("query");
+
+	_timerQueries.erase(queryIt);
+
+#ifndef MINKO_NO_TIMER_QUERY
+	glDeleteQueriesTimer(1, &query);
+	checkForErrors();
+#endif
+}
+
+void
+OpenGLES2Context::beginTimerQuery(const uint query)
+{
+#ifndef MINKO_NO_TIMER_QUERY
+	glBeginQueryTimer(GL_TIME_ELAPSED, query);
+	checkForErrors();
+#endif
+}
+
+void
+OpenGLES2Context::endTimerQuery()
+{
+#ifndef MINKO_NO_TIMER_QUERY
+	glEndQueryTimer(GL_TIME_ELAPSED);
+	checkForErrors();
+#endif
+}
+
+bool
+OpenGLES2Context::isTimerQueryAvailable(const uint query)
+{
+	GLuint available = 0;
+
+#ifndef MINKO_NO_TIMER_QUERY
+	glGetQueryObjectuivTimer(query, GL_QUERY_RESULT_AVAILABLE, &available);
+	checkForErrors();
+#endif
+
+	return available != 0;
+}
+
+bool
+OpenGLES2Context::getTimerQueryResult(const uint query, uint64_t& nanoseconds)
+{
+	nanoseconds = 0;
+
+#ifndef MINKO_NO_TIMER_QUERY
+	GLuint64 elapsed = 0;
+
+	glGetQueryObjectui64vTimer(query, GL_QUERY_RESULT, &elapsed);
+	checkForErrors();
+	nanoseconds = elapsed;
+
+	// reading GL_GPU_DISJOINT_EXT also resets it
+	if (_disjointTimerQueries)
+	{
+		GLint disjoint = 0;
+
+		glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+
+		return disjoint == 0;
+	}
+#endif
+
+	return true;
+}
+
+const uint
+OpenGLES2Context::createOcclusionQuery()
+{
+	if (!_occlusionQueriesSupported)
+		throw std::logic_error("occlusion queries are not supported.");
+
+	uint query = 0;
+
+#ifndef MINKO_NO_OCCLUSION_QUERY
+	glGenQueriesTimer(1, &query);
+	checkForErrors();
+#endif
+
+	_occlusionQueries.push_back(query);
+
+	return query;
+}
+
+void
+OpenGLES2Context::deleteOcclusionQuery(const uint query)
+{
+	auto queryIt = std::find(_occlusionQueries.begin(), _occlusionQueries.end(), query);
+
+	if (queryIt == _occlusionQueries.end())
+		throw std::invalid_argument("query");
+
+	_occlusionQueries.erase(queryIt);
+
+#ifndef MINKO_NO_OCCLUSION_QUERY
+	glDeleteQueriesTimer(1, &query);
+	checkForErrors();
+#endif
+}
+
+void
+OpenGLES2Context::beginOcclusionQuery(const uint query)
+{
+#ifndef MINKO_NO_OCCLUSION_QUERY
+	glBeginQueryTimer(GL_ANY_SAMPLES_PASSED, query);
+	checkForErrors();
+#endif
+}
+
+void
+OpenGLES2Context::endOcclusionQuery()
+{
+#ifndef MINKO_NO_OCCLUSION_QUERY
+	glEndQueryTimer(GL_ANY_SAMPLES_PASSED);
+	checkForErrors();
+#endif
+}
+
+bool
+OpenGLES2Context::isOcclusionQueryAvailable(const uint query)
+{
+	GLuint available = 0;
+
+#ifndef MINKO_NO_OCCLUSION_QUERY
+	glGetQueryObjectuivTimer(query, GL_QUERY_RESULT_AVAILABLE, &available);
+	checkForErrors();
+#endif
+
+	return available != 0;
+}
+
+bool
+OpenGLES2Context::getOcclusionQueryResult(const uint query)
+{
+	// without occlusion queries, nothing is ever considered as hidden
+	GLuint anySamplesPassed = 1;
+
+#ifndef MINKO_NO_OCCLUSION_QUERY
+	glGetQueryObjectuivTimer(query, GL_QUERY_RESULT, &anySamplesPassed);
+	checkForErrors();
+#endif
+
+	return anySamplesPassed != 0;
+}
+
 void
 OpenGLES2Context::setTriangleCulling(TriangleCulling triangleCulling)
 {
@@ -1572,6 +3004,7 @@ OpenGLES2Context::setRenderToBackBuffer()
 	glViewport(_viewportX, _viewportY, _viewportWidth, _viewportHeight);
 
 	_currentTarget = 0;
+	++_stats.numFrameBufferSwitches;
 
 	checkForErrors();
 }
@@ -1588,6 +3021,7 @@ OpenGLES2Context::setRenderToTexture(uint texture, bool enableDepthAndStencil)
 	_currentTarget = texture;
 
 	glBindFramebuffer(GL_FRAMEBUFFER, _frameBuffers[texture]);
+	++_stats.numFrameBufferSwitches;
 	checkForErrors();
 
 	if (enableDepthAndStencil)
@@ -1627,19 +3061,26 @@ OpenGLES2Context::createRTTBuffers(TextureType	type,
 	}
 
 
-	uint renderBuffer = -1;
+	// switching to a render target clears it, so render targets of the same size can share their depth buffer
+	auto& depthBuffer	= _depthBuffers[(uint64_t(width) << 32) | height];
+	uint renderBuffer	= depthBuffer.first;
 
-	// gen renderbuffer
-	glGenRenderbuffers(1, &renderBuffer);
-	// bind renderbuffer
-	glBindRenderbuffer(GL_RENDERBUFFER, renderBuffer);
-	// init as a depth buffer
+	if (depthBuffer.second++ == 0)
+	{
+		// gen renderbuffer
+		glGenRenderbuffers(1, &renderBuffer);
+		// bind renderbuffer
+		glBindRenderbuffer(GL_RENDERBUFFER, renderBuffer);
+		// init as a depth buffer
 #ifdef GL_ES_VERSION_2_0
-	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT16, width, height);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT16, width, height);
 #else
-	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
 #endif
-	// FIXME: create & attach stencil buffer
+		// FIXME: create & attach stencil buffer
+
+		depthBuffer.first = renderBuffer;
+	}
 
 	// attach to the FBO for depth
 	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, renderBuffer);
@@ -52,7 +52,8 @@ Pass::Pass(const std::string&				name,
 	_indexFunction(nullptr),
 	_undefinedMacros(),
 	_definedBoolMacros(),
-	_definedIntMacros()
+	_definedIntMacros(),
+	_reloaded(ReloadedSignal::create())
 {
 }
 
@@ -63,11 +64,13 @@ Pass::selectProgram(DrawCall::Ptr						drawCall,
 					std::shared_ptr<data::Container>	rootData,
 					std::list<data::ContainerProperty>&	booleanMacros,
 					std::list<data::ContainerProperty>&	integerMacros,
-					std::list<data::ContainerProperty>&	incorrectIntegerMacros)
+					std::list<data::ContainerProperty>&	incorrectIntegerMacros,
+					Program::Ptr&						pendingProgram)
 {
 	booleanMacros.clear();
 	integerMacros.clear();
 	incorrectIntegerMacros.clear();
+	pendingProgram = nullptr;
 
 	Program::Ptr program;
 
@@ -75,8 +78,7 @@ Pass::selectProgram(DrawCall::Ptr						drawCall,
 		program = _programTemplate;
 	else
 	{
-		std::string			defines = "";
-		ProgramSignature	signature;
+		ProgramSignature signature;
 
 		signature.build(
 			shared_from_this(),
@@ -84,7 +86,7 @@ Pass::selectProgram(DrawCall::Ptr						drawCall,
 			targetData,
 			rendererData,
 			rootData,
-			defines, 
+			nullptr,
 			booleanMacros,
 			integerMacros,
 			incorrectIntegerMacros
@@ -94,39 +96,65 @@ Pass::selectProgram(DrawCall::Ptr						drawCall,
 		if (!incorrectIntegerMacros.empty())
 			for (auto& m : incorrectIntegerMacros)
 				std::cout << "- incorrect macro\t'" << m.name() << "' from container[" << m.container().get() << "]" << std::endl;
-		if (!defines.empty())
-			std::cout << "MACRO DEFINES\n" << defines << std::endl;
 #endif // DEBUG_FALLBACK
 
 		if (!incorrectIntegerMacros.empty())
 			return nullptr;
 
+		// the same setup already failed on another surface: fallback right away
+		if (_failedSignatures.count(signature) != 0)
+			return nullptr;
+
 		const auto foundProgramIt = _signatureToProgram.find(signature);
 
 		if (foundProgramIt != _signatureToProgram.end())
 			program = foundProgramIt->second;
 		else
 		{
-			// compile a new shader program from template with macros
-
-#ifdef MINKO_NO_GLSL_STRUCT
-			defines += "#define MINKO_NO_GLSL_STRUCT\n";
-#endif // MINKO_NO_GLSL_STRUCT
+			std::string defines;
 
-			auto vs = Shader::create(
-				_programTemplate->context(),
-				Shader::Type::VERTEX_SHADER,
-				defines + _programTemplate->vertexShader()->source()
-			);
-			auto fs = Shader::create(
-				_programTemplate->context(),
-				Shader::Type::FRAGMENT_SHADER,
-				defines + _programTemplate->fragmentShader()->source()
+			// the defines are only needed to compile a new variant
+			signature.build(
+				shared_from_this(),
+				drawCall,
+				targetData,
+				rendererData,
+				rootData,
+				&defines,
+				booleanMacros,
+				integerMacros,
+				incorrectIntegerMacros
 			);
 
-			program							= Program::create(_programTemplate->context(), vs, fs);
-			_signatureToProgram[signature]	= program;
+#ifdef DEBUG_FALLBACK
+			if (!defines.empty())
+				std::cout << "MACRO DEFINES\n" << defines << std::endl;
+#endif // DEBUG_FALLBACK
+
+			program = createVariant(signature, defines);
+		}
+
+		if (!program->isReady() && program->context()->supportsParallelShaderCompile())
+		{
+			auto fallbackProgram = linkInBackground(program);
+
+			if (fallbackProgram)
+			{
+				pendingProgram = program;
+
+				return fallbackProgram;
+			}
+		}
+
+		program = finalizeProgram(program);
+
+		if (!program)
+		{
+			_failedSignatures.insert(signature);
+			_signatureToProgram.erase(signature);
 		}
+
+		return program;
 	}
 
 	return finalizeProgram(program);
@@ -139,10 +167,7 @@ Pass::finalizeProgram(Program::Ptr program)
 	{
 		try
 		{
-			if (!program->vertexShader()->isReady())
-				program->vertexShader()->upload();
-			if (!program->fragmentShader()->isReady())
-				program->fragmentShader()->upload();
+			// the shaders are compiled by Program::link(), unless a cached binary is used
 			if (!program->isReady())
 			{
 				program->upload();
@@ -167,6 +192,123 @@ Pass::finalizeProgram(Program::Ptr program)
 	return program;
 }
 
+Program::Ptr
+Pass::createVariant(const ProgramSignature& signature, std::string defines)
+{
+	// compile a new shader program from template with macros
+	_signatureToDefines[signature] = defines;
+
+#ifdef MINKO_NO_GLSL_STRUCT
+	defines += "#define MINKO_NO_GLSL_STRUCT\n";
+#endif // MINKO_NO_GLSL_STRUCT
+
+	auto vs = Shader::create(
+		_programTemplate->context(),
+		Shader::Type::VERTEX_SHADER,
+		defines + _programTemplate->vertexShader()->source()
+	);
+	auto fs = Shader::create(
+		_programTemplate->context(),
+		Shader::Type::FRAGMENT_SHADER,
+		defines + _programTemplate->fragmentShader()->source()
+	);
+
+	auto program					= Program::create(_programTemplate->context(), vs, fs);
+	_signatureToProgram[signature]	= program;
+
+	return program;
+}
+
+DrawCall::BindingPlanPtr
+Pass::bindingPlan(Program::Ptr program)
+{
+	auto planIt = _programToBindingPlan.find(program);
+
+	if (planIt != _programToBindingPlan.end())
+		return planIt->second;
+
+	auto plan = DrawCall::createBindingPlan(program, _attributeBindings, _uniformBindings);
+
+	// inputs are only known once the program is linked
+	if (program->inputs())
+		_programToBindingPlan[program] = plan;
+
+	return plan;
+}
+
+void
+Pass::reload(const std::string& vertexShaderSource, const std::string& fragmentShaderSource)
+{
+	auto context = _programTemplate->context();
+
+	// the previous programs are still used by the draw calls until they select again
+	_programTemplate = Program::create(
+		context,
+		Shader::create(context, Shader::Type::VERTEX_SHADER, vertexShaderSource),
+		Shader::create(context, Shader::Type::FRAGMENT_SHADER, fragmentShaderSource)
+	);
+	_signatureToProgram.clear();
+	_failedSignatures.clear();
+	_programToBindingPlan.clear();
+
+	_reloaded->execute(shared_from_this());
+}
+
+void
+Pass::contextRestored()
+{
+	// the lost programs are forgotten rather than deleted, the draw calls select new ones before rendering
+	_programTemplate->contextRestored();
+	for (auto& signatureAndProgram : _signatureToProgram)
+		signatureAndProgram.second->contextRestored();
+
+	reload(_programTemplate->vertexShader()->source(), _programTemplate->fragmentShader()->source());
+}
+
+bool
+Pass::precompileVariant(const ProgramSignature& signature, const std::string& defines)
+{
+	if (_signatureToProgram.count(signature) != 0 || _failedSignatures.count(signature) != 0)
+		return false;
+
+	auto program = createVariant(signature, defines);
+
+	// with parallel compilation the link is only started, selectProgram() completes it
+	if (program->context()->supportsParallelShaderCompile())
+		program->link();
+	else
+		finalizeProgram(program);
+
+	return true;
+}
+
+Program::Ptr
+Pass::linkInBackground(Program::Ptr program)
+{
+	try
+	{
+		program->link();
+	}
+	catch (std::exception&)
+	{
+		// let finalizeProgram() handle the failure synchronously
+		return nullptr;
+	}
+
+	if (program->isLinked())
+		return nullptr;
+
+	// the template has no macro defined, if it cannot be used the variant is waited for
+	try
+	{
+		return finalizeProgram(_programTemplate);
+	}
+	catch (std::exception&)
+	{
+		return nullptr;
+	}
+}
+
 void
 Pass::getExplicitDefinitions(std::unordered_map<std::string, data::MacroBindingDefault>& macroNameToValue) const
 {
@@ -0,0 +1,186 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/render/PixelReadback.hpp"
+
+#include "minko/render/AbstractContext.hpp"
+#include "minko/async/ThreadPool.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+/*static*/ const uint PixelReadback::DEFAULT_RING_SIZE = 3;
+
+PixelReadback::PixelReadback(ContextPtr context, std::shared_ptr<async::ThreadPool> threadPool, uint ringSize) :
+	_context(context),
+	_threadPool(threadPool),
+	_reads(ringSize),
+	_nextRead(0),
+	_frame(0),
+	_numStalls(0)
+{
+	for (auto& read : _reads)
+	{
+		read.size = 0;
+		read.fence = -1;
+		read.pending = false;
+	}
+}
+
+PixelReadback::~PixelReadback()
+{
+	for (auto& read : _reads)
+	{
+		if (read.fence >= 0)
+			_context->deleteFence(read.fence);
+		if (read.size > 0)
+			_context->deletePixelBuffer(read.pixelBuffer);
+	}
+}
+
+uint
+PixelReadback::numPendingReads() const
+{
+	return std::count_if(_reads.begin(), _reads.end(), [](const Read& read) { return read.pending; });
+}
+
+void
+PixelReadback::read(Callback callback, Callback encoder)
+{
+	read(0, 0, _context->viewportWidth(), _context->viewportHeight(), callback, encoder);
+}
+
+void
+PixelReadback::read(uint x, uint y, uint width, uint height, Callback callback, Callback encoder)
+{
+	if (!callback)
+		throw std::invalid_argument("callback");
+	if (width == 0 || height == 0)
+		throw std::invalid_argument("width, height");
+
+	auto& read = _reads[_nextRead];
+
+	// the oldest read is still in flight: the ring is too small for the latency of the GPU
+	if (read.pending)
+	{
+		++_numStalls;
+		resolve(read);
+	}
+
+	const uint size = width * height * 4;
+
+	if (read.size < size)
+	{
+		if (read.size > 0)
+			_context->deletePixelBuffer(read.pixelBuffer);
+		read.pixelBuffer = _context->createPixelBuffer(size);
+		read.size = size;
+	}
+
+	_context->readPixelsAsync(x, y, width, height, read.pixelBuffer);
+
+	read.fence = _context->supportsFences() ? _context->createFence() : -1;
+	read.frame = _frame;
+	read.pending = true;
+	read.image = std::make_shared<Image>();
+	read.image->x = x;
+	read.image->y = y;
+	read.image->width = width;
+	read.image->height = height;
+	read.encoder = encoder;
+	read.callback = callback;
+
+	_nextRead = (_nextRead + 1) % _reads.size();
+}
+
+bool
+PixelReadback::done(const Read& read)
+{
+	// the copy is done by readPixelsAsync() when the pixel buffers are emulated
+	if (!_context->supportsPixelBuffers())
+		return true;
+	if (read.fence >= 0)
+		return _context->fenceSignaled(read.fence);
+
+	return _frame - read.frame >= _reads.size() - 1;
+}
+
+void
+PixelReadback::update()
+{
+	++_frame;
+
+	// the reads are resolved in order, starting with the oldest one
+	const uint firstRead = _nextRead;
+
+	for (uint i = 0; i < _reads.size(); ++i)
+	{
+		auto& read = _reads[(firstRead + i) % _reads.size()];
+
+		if (!read.pending)
+			continue;
+		if (!done(read))
+			break;
+
+		resolve(read);
+	}
+}
+
+void
+PixelReadback::flush()
+{
+	const uint firstRead = _nextRead;
+
+	for (uint i = 0; i < _reads.size(); ++i)
+	{
+		auto& read = _reads[(firstRead + i) % _reads.size()];
+
+		if (read.pending)
+			resolve(read);
+	}
+}
+
+void
+PixelReadback::resolve(Read& read)
+{
+	auto image		= read.image;
+	auto encoder	= read.encoder;
+	auto callback	= read.callback;
+
+	image->pixels.resize(image->width * image->height * 4);
+	_context->pixelBufferData(read.pixelBuffer, image->pixels.size(), &image->pixels[0]);
+
+	if (read.fence >= 0)
+		_context->deleteFence(read.fence);
+	read.fence = -1;
+	read.pending = false;
+	read.image = nullptr;
+	read.encoder = nullptr;
+	read.callback = nullptr;
+
+	if (!encoder)
+		callback(image);
+	else if (_threadPool)
+		_threadPool->run([=]() { encoder(image); }, [=]() { callback(image); });
+	else
+	{
+		encoder(image);
+		callback(image);
+	}
+}
@@ -26,38 +26,116 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/render/Texture.hpp"
 #include "minko/render/CubeTexture.hpp"
 #include "minko/render/IndexBuffer.hpp"
+#include "minko/render/ProgramCache.hpp"
+#include "minko/render/ShaderOptimizer.hpp"
 
 
 using namespace minko;
 using namespace minko::render;
 
+ProgramCache::Ptr Program::_binaryCache = nullptr;
+ShaderOptimizer::Ptr Program::_optimizer = nullptr;
+
 Program::Program(Program::AbstractContextPtr context) :
 	AbstractResource(context),
-	_indexBuffer(nullptr)
+	_indexBuffer(nullptr),
+	_sharedUniformsPass(0),
+	_linkingId(-1)
+{
+}
+
+void
+Program::link()
+{
+	if (_linkingId != -1)
+		return;
+
+	_linkingId = _context->createProgram();
+	_binaryKey.clear();
+
+	if (_binaryCache && _context->supportsProgramBinaries())
+	{
+		auto key = ProgramCache::key(_context, _vertexShader->source(), _fragmentShader->source());
+
+		// the shaders do not even have to be compiled
+		if (_binaryCache->load(_context, _linkingId, key))
+			return;
+
+		_binaryKey = key;
+	}
+
+	// shaders shared by several programs are only optimized by the first one to compile them
+	if (_optimizer)
+	{
+		if (!_vertexShader->isReady())
+			_vertexShader->source(_optimizer->optimize(_vertexShader->source(), Shader::Type::VERTEX_SHADER));
+		if (!_fragmentShader->isReady())
+			_fragmentShader->source(_optimizer->optimize(_fragmentShader->source(), Shader::Type::FRAGMENT_SHADER));
+	}
+
+	if (!_vertexShader->isReady())
+		_vertexShader->upload();
+	if (!_fragmentShader->isReady())
+		_fragmentShader->upload();
+
+	_context->attachShader(_linkingId, _vertexShader->id());
+	_context->attachShader(_linkingId, _fragmentShader->id());
+	_context->linkProgram(_linkingId);
+}
+
+bool
+Program::isLinked()
 {
+	if (_linkingId == -1)
+		return isReady();
+
+	return _context->isProgramLinked(_linkingId);
 }
 
 void
 Program::upload()
 {
-	_id = context()->createProgram();
-	_context->attachShader(_id, _vertexShader->id());
-	_context->attachShader(_id, _fragmentShader->id());
-	_context->linkProgram(_id);
+	link();
+
+	_id = _linkingId;
+	_linkingId = -1;
 
 	_inputs = _context->getProgramInputs(_id);
+	_sharedUniformsPass = 0;
+
+	if (!_binaryKey.empty() && _binaryCache)
+		_binaryCache->store(_context, _id, _binaryKey);
+	_binaryKey.clear();
 }
 
 void
 Program::dispose()
 {
-	_context->deleteProgram(_id);
+	if (_linkingId != -1)
+		_context->deleteProgram(_linkingId);
+	_linkingId = -1;
+
+	if (_id != -1)
+		_context->deleteProgram(_id);
 	_id = -1;
 
 	_vertexShader = nullptr;
 	_fragmentShader = nullptr;
 }
 
+void
+Program::contextRestored()
+{
+	_id = -1;
+	_linkingId = -1;
+	_binaryKey.clear();
+
+	if (_vertexShader)
+		_vertexShader->contextRestored();
+	if (_fragmentShader)
+		_fragmentShader->contextRestored();
+}
+
 void
 Program::setUniform(const std::string& name, AbstractTexture::Ptr texture)
 {
@@ -92,7 +170,7 @@ Program::setVertexAttribute(const std::string& name, unsigned int attributeSize,
 }
 
 void
-Program::setIndexBuffer(const std::vector<unsigned short>& indices)
+Program::setIndexBuffer(const std::vector<uint>& indices)
 {
 	if (indices.empty())
 	{
@@ -0,0 +1,114 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/render/ProgramCache.hpp"
+
+#include "minko/render/AbstractContext.hpp"
+
+#include <iomanip>
+
+using namespace minko;
+using namespace minko::render;
+
+std::string
+ProgramCache::key(AbstractContextPtr	context,
+				  const std::string&	vertexShaderSource,
+				  const std::string&	fragmentShaderSource)
+{
+	// 64 bits FNV-1a, unlike std::hash it does not change between builds
+	uint64_t hash = 14695981039346656037ull;
+
+	auto append = [&](const std::string& value)
+	{
+		for (auto c : value)
+		{
+			hash ^= static_cast<unsigned char>(c);
+			hash *= 1099511628211ull;
+		}
+		hash ^= 0xff;
+		hash *= 1099511628211ull;
+	};
+
+	append(context->driverInfo());
+	append(vertexShaderSource);
+	append(fragmentShaderSource);
+
+	std::stringstream stream;
+
+	stream << std::hex << std::setw(16) << std::setfill('0') << hash;
+
+	return stream.str();
+}
+
+std::string
+ProgramCache::filename(const std::string& key) const
+{
+	if (_directory.empty())
+		return key + ".bin";
+
+	const auto last = _directory[_directory.size() - 1];
+
+	return _directory + (last == '/' || last == '\\' ? "" : "/") + key + ".bin";
+}
+
+bool
+ProgramCache::load(AbstractContextPtr context, const uint program, const std::string& key)
+{
+	std::ifstream file(filename(key), std::ios::in | std::ios::binary | std::ios::ate);
+
+	if (!file.is_open())
+		return false;
+
+	const auto size = static_cast<std::size_t>(file.tellg());
+
+	if (size <= sizeof(uint32_t))
+		return false;
+
+	uint32_t					format;
+	std::vector<unsigned char>	binary(size - sizeof(uint32_t));
+
+	file.seekg(0, std::ios::beg);
+	file.read(reinterpret_cast<char*>(&format), sizeof(uint32_t));
+	file.read(reinterpret_cast<char*>(&binary[0]), binary.size());
+
+	if (!file)
+		return false;
+
+	return context->setProgramBinary(program, format, binary);
+}
+
+void
+ProgramCache::store(AbstractContextPtr context, const uint program, const std::string& key)
+{
+	uint						format;
+	std::vector<unsigned char>	binary;
+
+	if (!context->getProgramBinary(program, format, binary) || binary.empty())
+		return;
+
+	std::ofstream file(filename(key), std::ios::out | std::ios::binary | std::ios::trunc);
+
+	if (!file.is_open())
+		return;
+
+	const uint32_t format32 = format;
+
+	file.write(reinterpret_cast<const char*>(&format32), sizeof(uint32_t));
+	file.write(reinterpret_cast<const char*>(&binary[0]), binary.size());
+}
@@ -28,7 +28,7 @@ using namespace minko;
 using namespace minko::render;
 using namespace minko::data;
 
-/*static*/ const uint ProgramSignature::MAX_NUM_BINDINGS = 32;
+/*static*/ const uint ProgramSignature::MAX_NUM_BINDINGS;
 
 void
 ProgramSignature::build(std::shared_ptr<render::Pass>	pass,
@@ -36,16 +36,16 @@ ProgramSignature::build(std::shared_ptr<render::Pass>	pass,
 						Container::Ptr					targetData,
 						Container::Ptr					rendererData,
 						Container::Ptr					rootData,
-						std::string&					defines,
+						std::string*					defines,
 						std::list<ContainerProperty>&	booleanMacros,
 						std::list<ContainerProperty>&	integerMacros,
 						std::list<ContainerProperty>&	incorrectIntegerMacros)
 {
 	_mask = 0;
-	_values.clear();
-	_values.resize(MAX_NUM_BINDINGS, 0);
+	_values.fill(0);
 
-	defines.clear();
+	if (defines)
+		defines->clear();
 
 	booleanMacros.clear();
 	integerMacros.clear();
@@ -129,7 +129,8 @@ ProgramSignature::build(std::shared_ptr<render::Pass>	pass,
 				}
 				else
 				{
-					defines += "#define " + macroName + " " + std::to_string(value) + "\n";
+					if (defines)
+						*defines += "#define " + macroName + " " + std::to_string(value) + "\n";
 				
 					if (macroExists && value > 0) // FIXME
 						integerMacros.push_back(macro);
@@ -137,7 +138,8 @@ ProgramSignature::build(std::shared_ptr<render::Pass>	pass,
 			}
 			else if (macroExists || defaultMacroExists)
 			{
-				defines += "#define " + macroName + "\n";
+				if (defines)
+					*defines += "#define " + macroName + "\n";
 
 				if (macroExists)
 					booleanMacros.push_back(macro);
@@ -158,26 +160,29 @@ ProgramSignature::build(std::shared_ptr<render::Pass>	pass,
 		const auto& macroName		= macroNameAndDefault.first;
 		const auto& macroDefault	= macroNameAndDefault.second;
 
-		if (macroDefault.semantic == data::MacroBindingDefaultValueSemantic::VALUE)
-			defines += "#define " + macroName + " " + std::to_string(macroDefault.value.value) + "\n";
-		else
-			defines += "#define " + macroName + "\n";
+		if (defines)
+		{
+			if (macroDefault.semantic == data::MacroBindingDefaultValueSemantic::VALUE)
+				*defines += "#define " + macroName + " " + std::to_string(macroDefault.value.value) + "\n";
+			else
+				*defines += "#define " + macroName + "\n";
+		}
 
 		++macroId;
 	}
+
+	updateHash();
 }
 
-bool 
-ProgramSignature::operator==(const ProgramSignature& x) const
+void
+ProgramSignature::updateHash()
 {
-	if (_mask != x._mask)
-		return false;
+	// 64 bits FNV-1a over the mask and the values, unset bindings are always 0
+	uint64_t hash = 14695981039346656037ull;
 
-	for (unsigned int i = 0; i < MAX_NUM_BINDINGS; ++i)
-	{
-		if ((_mask >> i) != 0 
-			&& _values[i] != x._values[i])
-			return false;
-	}
-	return true;
+	hash = (hash ^ _mask) * 1099511628211ull;
+	for (auto value : _values)
+		hash = (hash ^ static_cast<uint>(value)) * 1099511628211ull;
+
+	_hash = hash;
 }
@@ -0,0 +1,365 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/render/RenderGraph.hpp"
+
+#include "minko/render/AbstractContext.hpp"
+#include "minko/render/Texture.hpp"
+#include "minko/render/Effect.hpp"
+#include "minko/render/RenderTargetPool.hpp"
+#include "minko/component/Renderer.hpp"
+#include "minko/component/Surface.hpp"
+#include "minko/geometry/QuadGeometry.hpp"
+#include "minko/material/Material.hpp"
+#include "minko/scene/Node.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+const std::string RenderGraph::BACK_BUFFER = "backBuffer";
+
+RenderGraph::RenderGraph(AbstractContextPtr context) :
+	_context(context),
+	_pool(RenderTargetPool::create(context)),
+	_resources(),
+	_passes(),
+	_compiled(false),
+	_compiledPasses()
+{
+}
+
+void
+RenderGraph::addResource(const std::string& name, const Resource& resource)
+{
+	if (name == BACK_BUFFER || _resources.count(name) != 0)
+		throw std::invalid_argument("name");
+
+	_resources[name] = resource;
+	_compiled = false;
+}
+
+const RenderGraph::Resource&
+RenderGraph::resource(const std::string& name) const
+{
+	auto resourceIt = _resources.find(name);
+
+	if (resourceIt == _resources.end())
+		throw std::invalid_argument("name");
+
+	return resourceIt->second;
+}
+
+RenderGraph::Ptr
+RenderGraph::transientTexture(const std::string& name, uint width, uint height)
+{
+	Resource resource = { width, height, nullptr, true, false };
+
+	addResource(name, resource);
+
+	return shared_from_this();
+}
+
+RenderGraph::Ptr
+RenderGraph::importTexture(const std::string& name, TexturePtr texture)
+{
+	if (!texture)
+		throw std::invalid_argument("texture");
+
+	Resource resource = { texture->width(), texture->height(), texture, false, true };
+
+	addResource(name, resource);
+
+	return shared_from_this();
+}
+
+RenderGraph::Ptr
+RenderGraph::output(const std::string& name)
+{
+	if (name != BACK_BUFFER)
+	{
+		resource(name);
+		_resources[name].output = true;
+		_compiled = false;
+	}
+
+	return shared_from_this();
+}
+
+RenderGraph::Ptr
+RenderGraph::addPass(const std::string&					name,
+					 const std::vector<std::string>&	reads,
+					 const std::string&					write,
+					 const ExecuteFunction&				execute)
+{
+	for (auto& pass : _passes)
+		if (pass.name == name)
+			throw std::invalid_argument("name");
+
+	RenderPass pass = { name, reads, write, execute };
+
+	_passes.push_back(pass);
+	_compiled = false;
+
+	return shared_from_this();
+}
+
+RenderGraph::Ptr
+RenderGraph::addPass(const std::string&					name,
+					 RendererPtr						renderer,
+					 const std::vector<std::string>&	reads,
+					 const std::string&					write)
+{
+	// the graph decides where the renderer renders
+	if (!renderer || renderer->target())
+		throw std::invalid_argument("renderer");
+
+	auto context = _context;
+
+	renderer->enabled(false);
+
+	return addPass(name, reads, write, [=](Ptr graph, TexturePtr target, bool clear)
+	{
+		renderer->render(context, target, clear);
+	});
+}
+
+RenderGraph::Ptr
+RenderGraph::addPass(const std::string&							name,
+					 EffectPtr									effect,
+					 const std::map<std::string, std::string>&	uniformToTexture,
+					 const std::string&							write)
+{
+	if (!effect)
+		throw std::invalid_argument("effect");
+
+	std::vector<std::string> reads;
+
+	for (auto& uniformAndTexture : uniformToTexture)
+		reads.push_back(uniformAndTexture.second);
+
+	auto context	= _context;
+	auto quad		= scene::Node::create()
+		->addComponent(component::Renderer::create(0))
+		->addComponent(component::Surface::create(
+			geometry::QuadGeometry::create(context),
+			material::Material::create(),
+			effect
+		));
+
+	return addPass(name, reads, write, [=](Ptr graph, TexturePtr target, bool clear)
+	{
+		// aliasing can give another render target to the same resource at every execution
+		for (auto& uniformAndTexture : uniformToTexture)
+			effect->setUniform(uniformAndTexture.first, graph->texture(uniformAndTexture.second));
+
+		quad->component<component::Renderer>()->render(context, target, clear);
+	});
+}
+
+RenderGraph::Ptr
+RenderGraph::removePass(const std::string& name)
+{
+	auto passIt = std::find_if(_passes.begin(), _passes.end(), [&](const RenderPass& pass)
+	{
+		return pass.name == name;
+	});
+
+	if (passIt == _passes.end())
+		throw std::invalid_argument("name");
+
+	_passes.erase(passIt);
+	_compiled = false;
+
+	return shared_from_this();
+}
+
+uint
+RenderGraph::numExecutedPasses()
+{
+	if (!_compiled)
+		compile();
+
+	return _compiledPasses.size();
+}
+
+uint
+RenderGraph::numMergedPasses()
+{
+	if (!_compiled)
+		compile();
+
+	uint numMergedPasses = 0;
+
+	for (auto& compiledPass : _compiledPasses)
+		if (compiledPass.merged)
+			++numMergedPasses;
+
+	return numMergedPasses;
+}
+
+bool
+RenderGraph::culled(const std::string& passName)
+{
+	if (!_compiled)
+		compile();
+
+	for (auto& compiledPass : _compiledPasses)
+		if (_passes[compiledPass.pass].name == passName)
+			return false;
+
+	for (auto& pass : _passes)
+		if (pass.name == passName)
+			return true;
+
+	throw std::invalid_argument("passName");
+}
+
+RenderGraph::TexturePtr
+RenderGraph::texture(const std::string& name) const
+{
+	return name == BACK_BUFFER ? nullptr : resource(name).texture;
+}
+
+void
+RenderGraph::compile()
+{
+	const uint numPasses = _passes.size();
+	std::unordered_set<std::string> written;
+
+	for (auto& pass : _passes)
+	{
+		if (pass.write != BACK_BUFFER)
+			resource(pass.write);
+
+		for (auto& read : pass.reads)
+		{
+			if (read == pass.write)
+				throw std::logic_error("Pass '" + pass.name + "' cannot read the render target it writes.");
+			if (read == BACK_BUFFER || (resource(read).transient && written.count(read) == 0))
+				throw std::logic_error("Pass '" + pass.name + "' reads '" + read + "' before it is written.");
+		}
+
+		written.insert(pass.write);
+	}
+
+	// a pass is kept only when something kept after it reads what it writes
+	std::unordered_set<std::string> needed;
+	std::vector<bool> kept(numPasses, false);
+
+	needed.insert(BACK_BUFFER);
+	for (auto& nameAndResource : _resources)
+		if (nameAndResource.second.output)
+			needed.insert(nameAndResource.first);
+
+	for (int passId = numPasses - 1; passId >= 0; --passId)
+	{
+		auto& pass = _passes[passId];
+
+		if (needed.count(pass.write) == 0)
+			continue;
+
+		kept[passId] = true;
+		needed.insert(pass.reads.begin(), pass.reads.end());
+	}
+
+	_compiledPasses.clear();
+
+	std::unordered_set<std::string> cleared;
+	std::unordered_map<std::string, uint> lastUse;
+
+	for (uint passId = 0; passId < numPasses; ++passId)
+	{
+		if (!kept[passId])
+			continue;
+
+		auto& pass = _passes[passId];
+		CompiledPass compiledPass;
+
+		compiledPass.pass	= passId;
+		// the following passes writing the same target add to what the first one rendered
+		compiledPass.clear	= cleared.insert(pass.write).second;
+		compiledPass.merged	= !_compiledPasses.empty() && _passes[_compiledPasses.back().pass].write == pass.write;
+
+		lastUse[pass.write] = _compiledPasses.size();
+		for (auto& read : pass.reads)
+			lastUse[read] = _compiledPasses.size();
+
+		_compiledPasses.push_back(compiledPass);
+	}
+
+	for (auto& nameAndLastUse : lastUse)
+	{
+		if (nameAndLastUse.first == BACK_BUFFER)
+			continue;
+
+		auto& resource = _resources[nameAndLastUse.first];
+
+		if (resource.transient && !resource.output)
+			_compiledPasses[nameAndLastUse.second].released.push_back(nameAndLastUse.first);
+	}
+
+	_compiled = true;
+}
+
+void
+RenderGraph::execute()
+{
+	if (!_compiled)
+		compile();
+
+	// the outputs of the previous execution are not needed anymore
+	_pool->nextFrame();
+	for (auto& nameAndResource : _resources)
+		if (nameAndResource.second.transient)
+			nameAndResource.second.texture = nullptr;
+
+	auto that = shared_from_this();
+
+	for (auto& compiledPass : _compiledPasses)
+	{
+		auto&		pass	= _passes[compiledPass.pass];
+		TexturePtr	target	= nullptr;
+
+		if (pass.write != BACK_BUFFER)
+		{
+			auto& resource = _resources[pass.write];
+
+			if (!resource.texture)
+				resource.texture = _pool->acquire(resource.width, resource.height);
+			target = resource.texture;
+		}
+
+		if (target)
+			_context->setRenderToTexture(target->id(), true);
+		else
+			_context->setRenderToBackBuffer();
+
+		pass.execute(that, target, compiledPass.clear);
+
+		// the later transient targets of the same size alias the released ones
+		for (auto& name : compiledPass.released)
+		{
+			auto& resource = _resources[name];
+
+			_pool->release(resource.texture);
+			resource.texture = nullptr;
+		}
+	}
+}
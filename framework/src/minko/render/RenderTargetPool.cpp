@@ -0,0 +1,125 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/render/RenderTargetPool.hpp"
+
+#include "minko/render/AbstractContext.hpp"
+#include "minko/render/Texture.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+RenderTargetPool::RenderTargetPool(AbstractContextPtr context, uint maxUnusedFrames) :
+	_context(context),
+	_maxUnusedFrames(maxUnusedFrames),
+	_frameId(0),
+	_available(),
+	_acquired()
+{
+}
+
+uint
+RenderTargetPool::numAvailable() const
+{
+	uint numTextures = 0;
+
+	for (auto& sizeAndTextures : _available)
+		numTextures += sizeAndTextures.second.size();
+
+	return numTextures;
+}
+
+Texture::Ptr
+RenderTargetPool::acquire(uint width, uint height)
+{
+	const auto	key			= (uint64_t(width) << 32) | height;
+	auto&		available	= _available[key];
+
+	if (!available.empty())
+	{
+		// most recently used first
+		auto texture = available.back().first;
+
+		available.pop_back();
+		_acquired.push_back(std::make_pair(key, texture));
+
+		return texture;
+	}
+
+	auto texture = Texture::create(_context, width, height, false, true);
+
+	texture->upload();
+	_acquired.push_back(std::make_pair(key, texture));
+
+	return texture;
+}
+
+void
+RenderTargetPool::release(Texture::Ptr texture)
+{
+	auto acquiredIt = std::find_if(
+		_acquired.begin(),
+		_acquired.end(),
+		[&](const std::pair<uint64_t, TexturePtr>& keyAndTexture) { return keyAndTexture.second == texture; }
+	);
+
+	if (acquiredIt == _acquired.end())
+		throw std::invalid_argument("texture");
+
+	_available[acquiredIt->first].push_back(TextureAndFrame(texture, _frameId));
+	_acquired.erase(acquiredIt);
+}
+
+void
+RenderTargetPool::nextFrame()
+{
+	for (auto& keyAndTexture : _acquired)
+		_available[keyAndTexture.first].push_back(TextureAndFrame(keyAndTexture.second, _frameId));
+	_acquired.clear();
+
+	++_frameId;
+
+	for (auto sizeAndTexturesIt = _available.begin(); sizeAndTexturesIt != _available.end(); )
+	{
+		auto& textures = sizeAndTexturesIt->second;
+
+		// textures are sorted by last use
+		while (!textures.empty() && _frameId - textures.front().second > _maxUnusedFrames)
+		{
+			textures.front().first->dispose();
+			textures.pop_front();
+		}
+
+		if (textures.empty())
+			sizeAndTexturesIt = _available.erase(sizeAndTexturesIt);
+		else
+			++sizeAndTexturesIt;
+	}
+}
+
+void
+RenderTargetPool::clear()
+{
+	for (auto& sizeAndTextures : _available)
+		for (auto& textureAndFrame : sizeAndTextures.second)
+			textureAndFrame.first->dispose();
+
+	_available.clear();
+	_acquired.clear();
+}
@@ -0,0 +1,865 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/render/ShaderOptimizer.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+namespace
+{
+	enum class MacroState
+	{
+		DEFINED,
+		UNDEFINED,
+		// defined by the driver or in a conditional block that could not be resolved
+		UNKNOWN
+	};
+
+	struct Macro
+	{
+		MacroState	state;
+		std::string	value;
+	};
+
+	typedef std::unordered_map<std::string, Macro> MacroMap;
+
+	struct Value
+	{
+		bool	known;
+		long	value;
+	};
+
+	inline
+	bool
+	isIdentifierChar(char c)
+	{
+		return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+	}
+
+	std::string
+	trim(const std::string& value)
+	{
+		auto begin = value.find_first_not_of(" \t\r");
+
+		if (begin == std::string::npos)
+			return "";
+
+		return value.substr(begin, value.find_last_not_of(" \t\r") + 1 - begin);
+	}
+
+	// replaces the comments with spaces, keeping the line breaks
+	std::string
+	stripComments(const std::string& source)
+	{
+		std::string result;
+
+		result.reserve(source.size());
+		for (std::size_t i = 0; i < source.size(); ++i)
+		{
+			if (source[i] == '/' && i + 1 < source.size() && source[i + 1] == '/')
+			{
+				while (i < source.size() && source[i] != '\n')
+					++i;
+				if (i < source.size())
+					result += '\n';
+			}
+			else if (source[i] == '/' && i + 1 < source.size() && source[i + 1] == '*')
+			{
+				result += ' ';
+				for (i += 2; i < source.size() && !(source[i] == '*' && i + 1 < source.size() && source[i + 1] == '/'); ++i)
+					if (source[i] == '\n')
+						result += '\n';
+				++i;
+			}
+			else
+				result += source[i];
+		}
+
+		return result;
+	}
+
+	std::vector<std::string>
+	splitLines(const std::string& source)
+	{
+		std::vector<std::string> lines;
+		std::stringstream stream(source);
+		std::string line;
+
+		while (std::getline(stream, line))
+		{
+			if (!line.empty() && line[line.size() - 1] == '\r')
+				line.resize(line.size() - 1);
+			lines.push_back(line);
+		}
+
+		return lines;
+	}
+
+	// splits "#  name rest" into name and rest, returns false if line is not a directive
+	bool
+	parseDirective(const std::string& line, std::string& name, std::string& rest)
+	{
+		auto trimmed = trim(line);
+
+		if (trimmed.empty() || trimmed[0] != '#')
+			return false;
+
+		auto begin = trimmed.find_first_not_of(" \t", 1);
+
+		if (begin == std::string::npos)
+			begin = trimmed.size();
+
+		auto end = begin;
+
+		while (end < trimmed.size() && isIdentifierChar(trimmed[end]))
+			++end;
+
+		name = trimmed.substr(begin, end - begin);
+		rest = trim(trimmed.substr(end));
+
+		return true;
+	}
+
+	std::string
+	firstIdentifier(const std::string& value)
+	{
+		auto end = 0u;
+
+		while (end < value.size() && isIdentifierChar(value[end]))
+			++end;
+
+		return value.substr(0, end);
+	}
+
+	Macro
+	macro(const MacroMap& macros, const std::string& name)
+	{
+		auto macroIt = macros.find(name);
+
+		if (macroIt != macros.end())
+			return macroIt->second;
+
+		// GL_ES, GL_FRAGMENT_PRECISION_HIGH, extensions, __VERSION__...
+		if (name.compare(0, 3, "GL_") == 0 || name.compare(0, 2, "__") == 0)
+			return Macro { MacroState::UNKNOWN, "" };
+
+		return Macro { MacroState::UNDEFINED, "" };
+	}
+
+	// evaluates #if expressions, a value depending on an unknown macro is unknown
+	class ExpressionEvaluator
+	{
+	private:
+		const std::string&	_expression;
+		const MacroMap&		_macros;
+		std::size_t			_position;
+		bool				_failed;
+
+	public:
+		ExpressionEvaluator(const std::string& expression, const MacroMap& macros) :
+			_expression(expression),
+			_macros(macros),
+			_position(0),
+			_failed(false)
+		{
+		}
+
+		Value
+		evaluate()
+		{
+			auto value = parseOr();
+
+			skipSpaces();
+			if (_failed || _position != _expression.size())
+				return Value { false, 0 };
+
+			return value;
+		}
+
+	private:
+		void
+		skipSpaces()
+		{
+			while (_position < _expression.size() && (_expression[_position] == ' ' || _expression[_position] == '\t'))
+				++_position;
+		}
+
+		bool
+		accept(const std::string& token)
+		{
+			skipSpaces();
+			if (_expression.compare(_position, token.size(), token) != 0)
+				return false;
+
+			// do not mistake "<" for "<=" or "!" for "!="
+			if (token.size() == 1 && _position + 1 < _expression.size() && _expression[_position + 1] == '='
+				&& (token == "<" || token == ">" || token == "!" || token == "="))
+				return false;
+
+			_position += token.size();
+
+			return true;
+		}
+
+		Value
+		parseOr()
+		{
+			auto value = parseAnd();
+
+			while (accept("||"))
+			{
+				auto right = parseAnd();
+
+				if ((value.known && value.value) || (right.known && right.value))
+					value = Value { true, 1 };
+				else if (!value.known || !right.known)
+					value = Value { false, 0 };
+				else
+					value = Value { true, 0 };
+			}
+
+			return value;
+		}
+
+		Value
+		parseAnd()
+		{
+			auto value = parseComparison();
+
+			while (accept("&&"))
+			{
+				auto right = parseComparison();
+
+				if ((value.known && !value.value) || (right.known && !right.value))
+					value = Value { true, 0 };
+				else if (!value.known || !right.known)
+					value = Value { false, 0 };
+				else
+					value = Value { true, 1 };
+			}
+
+			return value;
+		}
+
+		Value
+		parseComparison()
+		{
+			static const std::vector<std::string> operators = { "==", "!=", "<=", ">=", "<", ">" };
+
+			auto value = parseAdditive();
+
+			while (true)
+			{
+				std::string op;
+
+				for (auto& candidate : operators)
+					if (accept(candidate))
+					{
+						op = candidate;
+						break;
+					}
+
+				if (op.empty())
+					return value;
+
+				auto right = parseAdditive();
+				auto result = 0l;
+
+				if (op == "==")			result = value.value == right.value;
+				else if (op == "!=")	result = value.value != right.value;
+				else if (op == "<=")	result = value.value <= right.value;
+				else if (op == ">=")	result = value.value >= right.value;
+				else if (op == "<")		result = value.value < right.value;
+				else					result = value.value > right.value;
+
+				value = Value { value.known && right.known, result };
+			}
+		}
+
+		Value
+		parseAdditive()
+		{
+			auto value = parseMultiplicative();
+
+			while (true)
+			{
+				if (accept("+"))
+				{
+					auto right = parseMultiplicative();
+					value = Value { value.known && right.known, value.value + right.value };
+				}
+				else if (accept("-"))
+				{
+					auto right = parseMultiplicative();
+					value = Value { value.known && right.known, value.value - right.value };
+				}
+				else
+					return value;
+			}
+		}
+
+		Value
+		parseMultiplicative()
+		{
+			auto value = parseUnary();
+
+			while (true)
+			{
+				if (accept("*"))
+				{
+					auto right = parseUnary();
+					value = Value { value.known && right.known, value.value * right.value };
+				}
+				else if (accept("/") || accept("%"))
+				{
+					auto modulo = _expression[_position - 1] == '%';
+					auto right = parseUnary();
+
+					if (!right.known || right.value == 0)
+						value = Value { false, 0 };
+					else
+						value = Value { value.known, modulo ? value.value % right.value : value.value / right.value };
+				}
+				else
+					return value;
+			}
+		}
+
+		Value
+		parseUnary()
+		{
+			if (accept("!"))
+			{
+				auto value = parseUnary();
+				return Value { value.known, !value.value };
+			}
+			if (accept("-"))
+			{
+				auto value = parseUnary();
+				return Value { value.known, -value.value };
+			}
+			if (accept("+"))
+				return parseUnary();
+
+			return parsePrimary();
+		}
+
+		Value
+		parsePrimary()
+		{
+			skipSpaces();
+
+			if (accept("("))
+			{
+				auto value = parseOr();
+
+				if (!accept(")"))
+					_failed = true;
+
+				return value;
+			}
+
+			if (_position < _expression.size() && std::isdigit(static_cast<unsigned char>(_expression[_position])))
+			{
+				auto begin = _position;
+
+				while (_position < _expression.size() && isIdentifierChar(_expression[_position]))
+					++_position;
+
+				return parseNumber(_expression.substr(begin, _position - begin));
+			}
+
+			auto name = firstIdentifier(_expression.substr(_position));
+
+			if (name.empty())
+			{
+				_failed = true;
+
+				return Value { false, 0 };
+			}
+
+			_position += name.size();
+
+			if (name == "defined")
+			{
+				auto parenthesis = accept("(");
+
+				skipSpaces();
+
+				auto macroName = firstIdentifier(_expression.substr(_position));
+
+				_position += macroName.size();
+				if (macroName.empty() || (parenthesis && !accept(")")))
+				{
+					_failed = true;
+
+					return Value { false, 0 };
+				}
+
+				auto state = macro(_macros, macroName).state;
+
+				return Value { state != MacroState::UNKNOWN, state == MacroState::DEFINED };
+			}
+
+			auto m = macro(_macros, name);
+
+			if (m.state == MacroState::UNDEFINED)
+				return Value { true, 0 };
+			if (m.state == MacroState::UNKNOWN)
+				return Value { false, 0 };
+
+			return parseNumber(trim(m.value));
+		}
+
+		Value
+		parseNumber(const std::string& value)
+		{
+			if (value.empty() || !std::isdigit(static_cast<unsigned char>(value[0])))
+				return Value { false, 0 };
+
+			char* end = nullptr;
+			auto number = std::strtol(value.c_str(), &end, 0);
+
+			// floats and macros defined as expressions are not evaluated
+			return Value { *end == '\0' || ((*end == 'u' || *end == 'U') && end[1] == '\0'), number };
+		}
+	};
+
+	struct Conditional
+	{
+		// lines of the enclosing block are emitted
+		bool parentActive;
+		// lines of the current branch are emitted
+		bool active;
+		// a branch known to be compiled was found, the others are dropped
+		bool taken;
+		// a branch could not be resolved, the directives are kept from there
+		bool verbatim;
+	};
+
+	Value
+	evaluateCondition(const std::string& name, const std::string& rest, const MacroMap& macros)
+	{
+		if (name == "ifdef" || name == "ifndef")
+		{
+			auto state = macro(macros, firstIdentifier(rest)).state;
+
+			if (state == MacroState::UNKNOWN)
+				return Value { false, 0 };
+
+			return Value { true, (state == MacroState::DEFINED) == (name == "ifdef") };
+		}
+
+		return ExpressionEvaluator(rest, macros).evaluate();
+	}
+
+	std::vector<std::string>
+	resolveConditionals(const std::vector<std::string>& lines)
+	{
+		std::vector<std::string>	result;
+		std::vector<Conditional>	conditionals;
+		MacroMap					macros;
+		std::string					name;
+		std::string					rest;
+
+		for (auto& line : lines)
+		{
+			const auto active = conditionals.empty() || conditionals.back().active;
+
+			if (!parseDirective(line, name, rest))
+			{
+				if (active)
+					result.push_back(line);
+				continue;
+			}
+
+			if (name == "if" || name == "ifdef" || name == "ifndef")
+			{
+				Conditional conditional = { active, false, false, false };
+
+				if (active)
+				{
+					auto condition = evaluateCondition(name, rest, macros);
+
+					if (!condition.known)
+					{
+						conditional.verbatim = true;
+						conditional.active = true;
+						result.push_back(line);
+					}
+					else
+						conditional.active = conditional.taken = condition.value != 0;
+				}
+				conditionals.push_back(conditional);
+			}
+			else if ((name == "elif" || name == "else") && !conditionals.empty())
+			{
+				auto& conditional = conditionals.back();
+
+				if (!conditional.parentActive)
+					continue;
+
+				if (conditional.taken)
+				{
+					conditional.active = false;
+					continue;
+				}
+
+				auto condition = name == "else" ? Value { true, 1 } : evaluateCondition("if", rest, macros);
+
+				if (!condition.known)
+				{
+					// the previous branches were dropped, this one opens the kept conditional
+					result.push_back(conditional.verbatim ? "#elif " + rest : "#if " + rest);
+					conditional.verbatim = true;
+					conditional.active = true;
+				}
+				else if (condition.value)
+				{
+					if (conditional.verbatim)
+						result.push_back("#else");
+					conditional.active = conditional.taken = true;
+				}
+				else
+					conditional.active = false;
+			}
+			else if (name == "endif" && !conditionals.empty())
+			{
+				if (conditionals.back().verbatim)
+					result.push_back("#endif");
+				conditionals.pop_back();
+			}
+			else if (active)
+			{
+				result.push_back(line);
+
+				if (name != "define" && name != "undef")
+					continue;
+
+				// a macro (re)defined in a block that might not be compiled cannot be relied on
+				auto uncertain = std::any_of(conditionals.begin(), conditionals.end(), [](const Conditional& c)
+				{
+					return c.verbatim;
+				});
+				auto macroName = firstIdentifier(rest);
+				auto& m = macros[macroName];
+
+				if (uncertain)
+					m.state = MacroState::UNKNOWN;
+				else if (name == "define")
+				{
+					m.state = MacroState::DEFINED;
+					// function-like macros are not evaluated
+					m.value = rest.size() > macroName.size() && rest[macroName.size()] == '(' ? "" : rest.substr(macroName.size());
+				}
+				else
+					m.state = MacroState::UNDEFINED;
+			}
+		}
+
+		return result;
+	}
+
+	std::size_t
+	countWord(const std::string& text, const std::string& word)
+	{
+		std::size_t count = 0;
+
+		for (auto pos = text.find(word); pos != std::string::npos; pos = text.find(word, pos + word.size()))
+			if ((pos == 0 || !isIdentifierChar(text[pos - 1]))
+				&& (pos + word.size() == text.size() || !isIdentifierChar(text[pos + word.size()])))
+				++count;
+
+		return count;
+	}
+
+	std::string
+	joinLines(const std::vector<std::string>& lines)
+	{
+		std::string text;
+
+		for (auto& line : lines)
+			text += line + '\n';
+
+		return text;
+	}
+
+	// returns the name of the function defined by header, such as "vec3 foo(float a)", or ""
+	std::string
+	functionName(const std::string& header)
+	{
+		auto trimmed = trim(header);
+
+		if (trimmed.empty() || trimmed[trimmed.size() - 1] != ')' || trimmed.find_first_of("#=") != std::string::npos)
+			return "";
+
+		auto open = trimmed.find('(');
+		auto end = trimmed.find_last_not_of(" \t\r\n", open - 1);
+
+		if (open == std::string::npos || open == 0 || end == std::string::npos)
+			return "";
+
+		auto begin = end;
+
+		while (begin > 0 && isIdentifierChar(trimmed[begin - 1]))
+			--begin;
+
+		// a return type is expected before the name
+		if (begin == 0 || trim(trimmed.substr(0, begin)).empty())
+			return "";
+
+		return trimmed.substr(begin, end + 1 - begin);
+	}
+
+	// removes the functions never called, which can make others unused in turn
+	std::string
+	stripUnusedFunctions(std::string text)
+	{
+		auto removed = true;
+
+		while (removed)
+		{
+			removed = false;
+
+			std::size_t segmentStart = 0;
+			auto lineStart = true;
+
+			for (std::size_t i = 0; i < text.size(); ++i)
+			{
+				auto c = text[i];
+
+				if (c == '#' && lineStart)
+				{
+					// directives end the declaration that follows them
+					i = text.find('\n', i);
+					if (i == std::string::npos)
+						break;
+					segmentStart = i + 1;
+					continue;
+				}
+
+				lineStart = c == '\n' || (lineStart && (c == ' ' || c == '\t'));
+
+				if (c == ';' || c == '}')
+					segmentStart = i + 1;
+				else if (c == '{')
+				{
+					auto name = functionName(text.substr(segmentStart, i - segmentStart));
+					auto depth = 0;
+					auto end = i;
+
+					for (; end < text.size(); ++end)
+					{
+						if (text[end] == '{')
+							++depth;
+						else if (text[end] == '}' && --depth == 0)
+							break;
+					}
+
+					if (end == text.size())
+						break;
+
+					auto body = text.substr(i, end + 1 - i);
+
+					if (!name.empty() && name != "main" && body.find('#') == std::string::npos
+						&& countWord(text, name) == 1)
+					{
+						text.erase(segmentStart, end + 1 - segmentStart);
+						removed = true;
+						break;
+					}
+
+					// struct and function bodies are skipped
+					i = end;
+					segmentStart = end + 1;
+				}
+			}
+		}
+
+		return text;
+	}
+
+	std::vector<std::string>
+	stripUnusedUniforms(const std::vector<std::string>& lines)
+	{
+		auto text = joinLines(lines);
+		std::vector<std::string> result;
+
+		for (auto& line : lines)
+		{
+			auto trimmed = trim(line);
+
+			if (trimmed.compare(0, 8, "uniform ") == 0 && trimmed[trimmed.size() - 1] == ';'
+				&& trimmed.find(',') == std::string::npos)
+			{
+				auto declaration = trimmed.substr(0, std::min(trimmed.find('['), trimmed.size() - 1));
+				auto end = declaration.find_last_not_of(" \t");
+				auto begin = end;
+
+				while (begin > 0 && isIdentifierChar(declaration[begin - 1]))
+					--begin;
+
+				if (countWord(text, declaration.substr(begin, end + 1 - begin)) == 1)
+					continue;
+			}
+
+			result.push_back(line);
+		}
+
+		return result;
+	}
+
+	bool
+	hasFloatPrecision(const std::vector<std::string>& lines)
+	{
+		for (auto& line : lines)
+		{
+			auto trimmed = trim(line);
+
+			if (trimmed.compare(0, 10, "precision ") == 0 && countWord(trimmed, "float") != 0)
+				return true;
+		}
+
+		return false;
+	}
+
+	void
+	declarePrecision(std::vector<std::string>& lines, const std::string& precision)
+	{
+		std::string name;
+		std::string rest;
+		std::size_t position = 0;
+
+		// after #version and #extension, which cannot follow any declaration
+		for (std::size_t i = 0; i < lines.size(); ++i)
+		{
+			if (trim(lines[i]).empty())
+				continue;
+			if (!parseDirective(lines[i], name, rest))
+				break;
+			if (name == "version" || name == "extension")
+				position = i + 1;
+		}
+
+		lines.insert(lines.begin() + position, {
+			"#ifdef GL_ES",
+			"precision " + precision + " float;",
+			"#endif"
+		});
+	}
+
+	std::string
+	minifyCode(const std::string& code)
+	{
+		static const std::string separators = "{}()[];,";
+
+		std::string result;
+		auto space = false;
+
+		for (auto c : code)
+		{
+			if (c == ' ' || c == '\t' || c == '\r' || c == '\n')
+			{
+				space = true;
+				continue;
+			}
+
+			if (space && !result.empty() && separators.find(c) == std::string::npos
+				&& separators.find(result[result.size() - 1]) == std::string::npos)
+				result += ' ';
+
+			result += c;
+			space = false;
+		}
+
+		return result;
+	}
+
+	// directives keep their own line, the code between them is merged into one
+	std::vector<std::string>
+	minify(const std::vector<std::string>& lines)
+	{
+		std::vector<std::string>	result;
+		std::string					code;
+		std::string					name;
+		std::string					rest;
+
+		for (auto& line : lines)
+		{
+			if (!parseDirective(line, name, rest))
+			{
+				code += line + ' ';
+				continue;
+			}
+
+			code = minifyCode(code);
+			if (!code.empty())
+				result.push_back(code);
+			code.clear();
+
+			// spaces are meaningful in directives, "#define A (1)" is not "#define A(1)"
+			std::string directive = "#" + name;
+			auto space = true;
+
+			for (auto c : rest)
+			{
+				if (c == ' ' || c == '\t')
+				{
+					space = true;
+					continue;
+				}
+				if (space)
+					directive += ' ';
+				directive += c;
+				space = false;
+			}
+
+			result.push_back(directive);
+		}
+
+		code = minifyCode(code);
+		if (!code.empty())
+			result.push_back(code);
+
+		return result;
+	}
+}
+
+std::string
+ShaderOptimizer::optimize(const std::string& source, Shader::Type type) const
+{
+	auto lines = splitLines(stripComments(source));
+
+	if (_stripDeadCode)
+		lines = splitLines(stripUnusedFunctions(joinLines(resolveConditionals(lines))));
+
+	if (_stripUnusedUniforms)
+		lines = ::stripUnusedUniforms(lines);
+
+	// vertex shaders have a highp default precision
+	if (type == Shader::Type::FRAGMENT_SHADER && !_defaultPrecision.empty() && !hasFloatPrecision(lines))
+		declarePrecision(lines, _defaultPrecision);
+
+	if (_minify)
+		lines = ::minify(lines);
+
+	return joinLines(lines);
+}
@@ -20,6 +20,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/render/Texture.hpp"
 
 #include "minko/render/AbstractContext.hpp"
+#include "minko/render/UploadThread.hpp"
 
 using namespace minko;
 using namespace minko::render;
@@ -32,8 +33,16 @@ Texture::Texture(AbstractContext::Ptr	context,
 				 bool					resizeSmoothly,
 				 const std::string&		filename) :
 	AbstractTexture(TextureType::Texture2D, context, width, height, mipMapping, optimizeForRenderToTexture, resizeSmoothly, filename),
-	_data()
+	_data(),
+	_format(TextureFormat::RGBA)
 {
+	// resampling to a power of 2 size on the CPU is opt-in when the GPU can handle the actual size
+	if (!resizeSmoothly && width <= MAX_SIZE && height <= MAX_SIZE
+		&& context->supportsNonPowerOfTwoTextures(mipMapping))
+	{
+		_widthGPU	= width;
+		_heightGPU	= height;
+	}
 }
 
 void
@@ -59,6 +68,20 @@ Texture::data(unsigned char*	data,
 		_heightGPU	= heightGPU;
 	}
 
+	if (isCompressed(format))
+	{
+		// compressed data cannot be resized on the CPU side
+		if (_width != _widthGPU || _height != _heightGPU || !math::isp2(_width) || !math::isp2(_height))
+			throw std::invalid_argument("compressed textures must have power of 2 sizes up to " + std::to_string(MAX_SIZE));
+
+		_format = format;
+		_data.assign(data, data + dataSize(format, _widthGPU, _heightGPU));
+
+		return;
+	}
+
+	_format = TextureFormat::RGBA;
+
 	const auto size = _width * _height * sizeof(int);
 
 	std::vector<unsigned char> rgba(size, 0);
@@ -78,12 +101,24 @@ Texture::data(unsigned char*	data,
 		}
 	}
 
-	assert(math::isp2(_widthGPU) && math::isp2(_heightGPU));
+	// no-op when the data already has the GPU size
 	resizeData(_width, _height, rgba, _widthGPU, _heightGPU, _resizeSmoothly, _data);
 }
 
 void
-Texture::upload()
+Texture::data(std::vector<unsigned char>& rgba)
+{
+	if (rgba.size() != _width * _height * sizeof(int))
+		throw std::invalid_argument("rgba");
+
+	_format = TextureFormat::RGBA;
+
+	resizeData(_width, _height, rgba, _widthGPU, _heightGPU, _resizeSmoothly, _data);
+	std::vector<unsigned char>().swap(rgba);
+}
+
+void
+Texture::allocate()
 {
     if (_id == -1)
     	_id = _context->createTexture(
@@ -93,8 +128,17 @@ Texture::upload()
 			_mipMapping, 
 			_optimizeForRenderToTexture
 		);
+}
+
+void
+Texture::upload()
+{
+	allocate();
 	
-    if (!_data.empty())
+    if (!_data.empty() && isCompressed(_format))
+		// mipmaps of compressed textures cannot be generated, they are uploaded with uploadMipLevel()
+		_context->uploadCompressedTexture2dData(_id, _format, _widthGPU, _heightGPU, 0, &_data.front());
+    else if (!_data.empty())
     {
         _context->uploadTexture2dData(
 			_id, 
@@ -109,17 +153,62 @@ Texture::upload()
     }
 }
 
+void
+Texture::uploadAsync(UploadThreadPtr uploadThread, std::function<void()> complete)
+{
+	// an evicted texture has to be re-allocated, only the first upload is made asynchronously
+	if (uploadThread == nullptr || _id != -1 || _data.empty() || isCompressed(_format))
+	{
+		upload();
+		if (complete)
+			complete();
+
+		return;
+	}
+
+	// the storage is allocated (and accounted for) by the render thread, only the pixels are transferred by the
+	// upload thread
+	allocate();
+
+	// keeps the pixels alive until the GPU is done with them
+	auto self = shared_from_this();
+
+	uploadThread->uploadTexture2dData(
+		_id,
+		_widthGPU,
+		_heightGPU,
+		0,
+		&_data.front(),
+		_mipMapping,
+		[self, complete]()
+		{
+			if (complete)
+				complete();
+		}
+	);
+}
+
 void
 Texture::uploadMipLevel(uint			level,
 						unsigned char*	data)
 {
-	_context->uploadTexture2dData(
-		_id, 
-		getMipmapWidth(level),
-		getMipmapHeight(level),
-		level,
-		data
-	);		
+	if (isCompressed(_format))
+		_context->uploadCompressedTexture2dData(
+			_id,
+			_format,
+			getMipmapWidth(level),
+			getMipmapHeight(level),
+			level,
+			data
+		);
+	else
+		_context->uploadTexture2dData(
+			_id, 
+			getMipmapWidth(level),
+			getMipmapHeight(level),
+			level,
+			data
+		);		
 }
 
 void
@@ -134,6 +223,35 @@ Texture::dispose()
 	disposeData();
 }
 
+bool
+Texture::evictable() const
+{
+	// compressed mipmaps cannot be generated again
+	return _id != -1
+		&& !_data.empty()
+		&& !_optimizeForRenderToTexture
+		&& (!_mipMapping || !isCompressed(_format));
+}
+
+void
+Texture::evict()
+{
+	if (!evictable())
+		throw std::logic_error("texture cannot be evicted");
+
+	_context->releaseTextureStorage(_id);
+}
+
+void
+Texture::contextRestored()
+{
+	if (_id == -1)
+		return;
+
+	_id = -1;
+	allocate();
+}
+
 void
 Texture::disposeData()
 {
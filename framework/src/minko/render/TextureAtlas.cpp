@@ -0,0 +1,172 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/render/TextureAtlas.hpp"
+
+#include "minko/render/AbstractContext.hpp"
+#include "minko/render/Texture.hpp"
+#include "minko/render/VertexBuffer.hpp"
+#include "minko/geometry/Geometry.hpp"
+#include "minko/math/Vector4.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+TextureAtlas::TextureAtlas(AbstractContextPtr context, uint width, uint height, uint padding) :
+	_context(context),
+	_width(width),
+	_height(height),
+	_padding(padding),
+	_textures(),
+	_uvRects(),
+	_texture(nullptr)
+{
+}
+
+TextureAtlas::Ptr
+TextureAtlas::add(TexturePtr texture)
+{
+	if (!texture || texture->format() != TextureFormat::RGBA
+		|| texture->data().size() != texture->width() * texture->height() * 4)
+		throw std::invalid_argument("texture");
+
+	if (std::find(_textures.begin(), _textures.end(), texture) == _textures.end())
+		_textures.push_back(texture);
+
+	return shared_from_this();
+}
+
+bool
+TextureAtlas::build()
+{
+	std::vector<TexturePtr> textures(_textures);
+
+	// shelves of decreasing heights
+	std::stable_sort(textures.begin(), textures.end(), [](const TexturePtr& a, const TexturePtr& b)
+	{
+		return a->height() > b->height();
+	});
+
+	std::vector<std::pair<uint, uint>>	positions;
+	uint								x				= 0;
+	uint								y				= 0;
+	uint								shelfHeight		= 0;
+
+	for (auto& texture : textures)
+	{
+		const uint width	= texture->width() + 2 * _padding;
+		const uint height	= texture->height() + 2 * _padding;
+
+		if (x + width > _width)
+		{
+			x = 0;
+			y += shelfHeight;
+			shelfHeight = 0;
+		}
+
+		if (x + width > _width || y + height > _height)
+			return false;
+
+		positions.push_back(std::make_pair(x, y));
+		x += width;
+		shelfHeight = std::max(shelfHeight, height);
+	}
+
+	std::vector<unsigned char> pixels(_width * _height * 4, 0);
+
+	for (uint i = 0; i < textures.size(); ++i)
+	{
+		const auto&	texture	= textures[i];
+		const auto&	data	= texture->data();
+		const int	width	= texture->width();
+		const int	height	= texture->height();
+		const int	padding	= _padding;
+
+		// the padding repeats the borders for the linear filtering not to sample the neighbours
+		for (int j = -padding; j < height + padding; ++j)
+		{
+			const int	row			= std::min(std::max(j, 0), height - 1);
+			auto		destination	= &pixels[((positions[i].second + padding + j) * _width + positions[i].first) * 4];
+
+			for (int k = -padding; k < width + padding; ++k)
+			{
+				const int column = std::min(std::max(k, 0), width - 1);
+
+				std::copy_n(&data[(row * width + column) * 4], 4, destination);
+				destination += 4;
+			}
+		}
+
+		const float u = float(positions[i].first + padding) / float(_width);
+		const float v = float(positions[i].second + padding) / float(_height);
+		const float w = float(width) / float(_width);
+		const float h = float(height) / float(_height);
+
+		// materials holding the rect of a texture follow it when the atlas is built again
+		if (_uvRects.count(texture))
+			_uvRects[texture]->setTo(u, v, w, h);
+		else
+			_uvRects[texture] = math::Vector4::create(u, v, w, h);
+	}
+
+	if (!_texture)
+		_texture = Texture::create(_context, _width, _height, false, false, false);
+
+	_texture->data(&pixels[0]);
+	_texture->upload();
+
+	return true;
+}
+
+TextureAtlas::Vector4Ptr
+TextureAtlas::uvRect(TexturePtr texture) const
+{
+	auto uvRectIt = _uvRects.find(texture);
+
+	if (uvRectIt == _uvRects.end())
+		throw std::invalid_argument("texture");
+
+	return uvRectIt->second;
+}
+
+void
+TextureAtlas::remapUVs(GeometryPtr geometry, TexturePtr texture, const std::string& attributeName) const
+{
+	if (!geometry || !geometry->hasVertexAttribute(attributeName))
+		throw std::invalid_argument("geometry");
+
+	auto		rect			= uvRect(texture);
+	auto		vertexBuffer	= geometry->vertexBuffer(attributeName);
+	auto&		data			= vertexBuffer->data();
+	const uint	vertexSize		= vertexBuffer->vertexSize();
+	const uint	offset			= std::get<2>(*vertexBuffer->attribute(attributeName));
+	const uint	numVertices		= vertexBuffer->numVertices();
+
+	for (uint i = 0; i < numVertices; ++i)
+	{
+		auto uv = &data[i * vertexSize + offset];
+
+		uv[0] = rect->x() + uv[0] * rect->z();
+		uv[1] = rect->y() + uv[1] * rect->w();
+	}
+
+	vertexBuffer->markDirty(0, numVertices);
+	vertexBuffer->uploadDirty();
+}
@@ -0,0 +1,121 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/render/TextureStreamer.hpp"
+
+#include "minko/render/AbstractContext.hpp"
+#include "minko/render/Texture.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+TextureStreamer::TextureStreamer(uint bytesPerFrame) :
+	_bytesPerFrame(bytesPerFrame),
+	_frameBytes(0),
+	_levels(),
+	_textureStreamed(Signal<Ptr, TexturePtr>::create())
+{
+}
+
+void
+TextureStreamer::stream(TexturePtr texture, std::vector<std::vector<unsigned char>>& levels)
+{
+	if (!texture)
+		throw std::invalid_argument("texture");
+	if (levels.size() > 1 && !texture->mipMapping())
+		throw std::invalid_argument("texture: mipmapping must be enabled to stream more than one level");
+
+	// allocates the mip chain, whatever is sampled before a level is uploaded is undefined
+	if (!texture->isReady())
+		texture->upload();
+
+	const bool wasComplete = complete();
+
+	for (int level = levels.size() - 1; level >= 0; --level)
+	{
+		if (levels[level].empty())
+			continue;
+
+		const uint size = levels[level].size();
+		auto levelIt = _levels.insert(std::make_pair(size, MipLevel()));
+
+		levelIt->second.texture = texture;
+		levelIt->second.level = level;
+		levelIt->second.data.swap(levels[level]);
+	}
+
+	// the job manager drops completed jobs: queue this one again
+	if (wasComplete && !complete() && jobManager() && !running())
+		jobManager()->pushJob(shared_from_this());
+}
+
+bool
+TextureStreamer::complete()
+{
+	return _levels.empty();
+}
+
+void
+TextureStreamer::beforeFirstStep()
+{
+	_frameBytes = 0;
+}
+
+void
+TextureStreamer::step()
+{
+	// yieldFrame() returned true during the previous frame
+	if (_frameBytes >= _bytesPerFrame)
+		_frameBytes = 0;
+
+	auto levelIt = _levels.begin();
+	auto& level = levelIt->second;
+	auto texture = level.texture;
+
+	texture->uploadMipLevel(level.level, &level.data[0]);
+	// levels are uploaded from the smallest so the texture can already be sampled down to this one
+	texture->context()->setTextureBaseLevel(texture->id(), level.level);
+
+	_frameBytes += level.data.size();
+
+	const bool streamed = level.level == 0;
+
+	_levels.erase(levelIt);
+
+	if (streamed)
+		_textureStreamed->execute(shared_from_this(), texture);
+}
+
+float
+TextureStreamer::priority()
+{
+	return 1.f;
+}
+
+bool
+TextureStreamer::yieldFrame()
+{
+	return _frameBytes >= _bytesPerFrame;
+}
+
+void
+TextureStreamer::afterLastStep()
+{
+	running(false);
+}
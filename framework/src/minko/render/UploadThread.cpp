@@ -0,0 +1,154 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/render/UploadThread.hpp"
+
+#include "minko/render/OpenGLES2Context.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+UploadThread::UploadThread(std::shared_ptr<AbstractContext>	context,
+						   ContextFunction					makeCurrent,
+						   ContextFunction					releaseCurrent) :
+	_fencesSupported(context->supportsFences()),
+	_makeCurrent(makeCurrent),
+	_releaseCurrent(releaseCurrent),
+	_stopping(false),
+	_numUploads(0)
+{
+	_thread = std::thread(std::bind(&UploadThread::run, this));
+}
+
+UploadThread::~UploadThread()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		_stopping = true;
+	}
+	_wakeUp.notify_one();
+	_thread.join();
+
+	// the objects are shared: the fences can be deleted from the render thread
+	for (auto& upload : _transferred)
+		OpenGLES2Context::deleteFenceShared(upload.fence);
+	for (auto& upload : _pending)
+		OpenGLES2Context::deleteFenceShared(upload.fence);
+}
+
+void
+UploadThread::uploadTexture2dData(uint					texture,
+								  uint					width,
+								  uint					height,
+								  uint					mipLevel,
+								  const void*			data,
+								  bool					generateMipmaps,
+								  std::function<void()>	complete)
+{
+	queue([=]()
+	{
+		OpenGLES2Context::uploadTexture2dDataShared(texture, width, height, mipLevel, data, generateMipmaps);
+	}, complete);
+}
+
+void
+UploadThread::uploadBufferData(bool						indices,
+							   uint						buffer,
+							   uint						offset,
+							   uint						size,
+							   const void*				data,
+							   std::function<void()>	complete)
+{
+	queue([=]()
+	{
+		OpenGLES2Context::uploadBufferDataShared(indices, buffer, offset, size, data);
+	}, complete);
+}
+
+void
+UploadThread::queue(std::function<void()> transfer, std::function<void()> complete)
+{
+	Upload upload;
+
+	upload.transfer = transfer;
+	upload.complete = complete;
+	upload.fence = nullptr;
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		_queued.push_back(upload);
+	}
+	++_numUploads;
+	_wakeUp.notify_one();
+}
+
+void
+UploadThread::update()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		_pending.splice(_pending.end(), _transferred);
+	}
+
+	while (!_pending.empty() && OpenGLES2Context::fenceSignaledShared(_pending.front().fence))
+	{
+		auto upload = _pending.front();
+
+		_pending.pop_front();
+		OpenGLES2Context::deleteFenceShared(upload.fence);
+		--_numUploads;
+
+		if (upload.complete)
+			upload.complete();
+	}
+}
+
+void
+UploadThread::run()
+{
+	if (_makeCurrent)
+		_makeCurrent();
+
+	while (true)
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+
+		_wakeUp.wait(lock, [this]() { return _stopping || !_queued.empty(); });
+		if (_stopping)
+			break;
+
+		auto upload = _queued.front();
+
+		_queued.pop_front();
+		lock.unlock();
+
+		upload.transfer();
+		// one fence per upload: a large texture does not delay the completion of the small ones before it
+		upload.fence = OpenGLES2Context::createFenceShared(_fencesSupported);
+
+		lock.lock();
+		_transferred.push_back(upload);
+	}
+
+	if (_releaseCurrent)
+		_releaseCurrent();
+}
@@ -21,6 +21,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/Signal.hpp"
 #include "minko/render/AbstractContext.hpp"
+#include "minko/render/UploadThread.hpp"
 #include "minko/math/Vector3.hpp"
 
 using namespace minko;
@@ -29,12 +30,113 @@ using namespace minko::render;
 
 static const std::string ATTRNAME_POSITION = "position";
 
+namespace
+{
+	uint
+	attributeGPUSize(VertexAttributeType type, uint size)
+	{
+		uint numBytes = 0;
+
+		switch (type)
+		{
+		case VertexAttributeType::FLOAT:						numBytes = size << 2;	break;
+		case VertexAttributeType::HALF_FLOAT:					numBytes = size << 1;	break;
+		case VertexAttributeType::UNSIGNED_BYTE_NORMALIZED:
+		case VertexAttributeType::BYTE_NORMALIZED:				numBytes = size;		break;
+		case VertexAttributeType::UNSIGNED_SHORT_NORMALIZED:
+		case VertexAttributeType::SHORT_NORMALIZED:				numBytes = size << 1;	break;
+		case VertexAttributeType::INT_2_10_10_10_NORMALIZED:	numBytes = 4;			break;
+		}
+
+		// every attribute is aligned on 4 bytes
+		return (numBytes + 3) >> 2;
+	}
+
+	unsigned short
+	toHalfFloat(float value)
+	{
+		uint bits;
+
+		std::memcpy(&bits, &value, sizeof(float));
+
+		const uint sign		= (bits >> 16) & 0x8000;
+		const int exponent	= int((bits >> 23) & 0xff) - 127 + 15;
+		const uint mantissa	= bits & 0x7fffff;
+
+		if (exponent <= 0)
+			return sign; // flushed to zero
+		if (exponent >= 31)
+			return sign | 0x7c00; // infinity
+
+		return sign | (exponent << 10) | ((mantissa + 0x1000) >> 13);
+	}
+
+	int
+	normalize(float value, float minValue, float maxValue, int scale)
+	{
+		return (int)std::floor(std::max(minValue, std::min(maxValue, value)) * scale + .5f);
+	}
+
+	void
+	packAttribute(VertexAttributeType type, const float* src, uint size, unsigned char* dst)
+	{
+		switch (type)
+		{
+		case VertexAttributeType::FLOAT:
+			std::memcpy(dst, src, size * sizeof(float));
+			break;
+		case VertexAttributeType::HALF_FLOAT:
+			for (uint i = 0; i < size; ++i)
+				reinterpret_cast<unsigned short*>(dst)[i] = toHalfFloat(src[i]);
+			break;
+		case VertexAttributeType::UNSIGNED_BYTE_NORMALIZED:
+			for (uint i = 0; i < size; ++i)
+				dst[i] = (unsigned char)normalize(src[i], 0.f, 1.f, 255);
+			break;
+		case VertexAttributeType::BYTE_NORMALIZED:
+			for (uint i = 0; i < size; ++i)
+				reinterpret_cast<signed char*>(dst)[i] = (signed char)normalize(src[i], -1.f, 1.f, 127);
+			break;
+		case VertexAttributeType::UNSIGNED_SHORT_NORMALIZED:
+			for (uint i = 0; i < size; ++i)
+				reinterpret_cast<unsigned short*>(dst)[i] = (unsigned short)normalize(src[i], 0.f, 1.f, 65535);
+			break;
+		case VertexAttributeType::SHORT_NORMALIZED:
+			for (uint i = 0; i < size; ++i)
+				reinterpret_cast<short*>(dst)[i] = (short)normalize(src[i], -1.f, 1.f, 32767);
+			break;
+		case VertexAttributeType::INT_2_10_10_10_NORMALIZED:
+		{
+			uint packed = 0;
+
+			for (uint i = 0; i < 3 && i < size; ++i)
+				packed |= (uint(normalize(src[i], -1.f, 1.f, 511)) & 0x3ff) << (10 * i);
+			if (size > 3)
+				packed |= (uint(normalize(src[3], -1.f, 1.f, 1)) & 0x3) << 30;
+
+			std::memcpy(dst, &packed, sizeof(uint));
+			break;
+		}
+		}
+	}
+}
+
 VertexBuffer::VertexBuffer(std::shared_ptr<AbstractContext> context) :
 	AbstractResource(context),
 	std::enable_shared_from_this<VertexBuffer>(),
 	_data(),
 	_vertexSize(0),
-	_vertexSizeChanged(Signal<Ptr, int>::create())
+	_attributeTypes(),
+	_gpuAttributeOffsets(),
+	_gpuVertexSize(0),
+	_gpuSize(0),
+	_usage(BufferUsage::STATIC),
+	_dirtyBegin(0),
+	_dirtyEnd(0),
+	_numDisposedVertices(0),
+	_capacity(0),
+	_vertexSizeChanged(Signal<Ptr, int>::create()),
+	_dataChanged(Signal<Ptr>::create())
 {
 }
 
@@ -45,7 +147,17 @@ VertexBuffer::VertexBuffer(std::shared_ptr<AbstractContext>	context,
 	AbstractResource(context),
 	_data(data + offset, data + offset + size),
 	_vertexSize(0),
-	_vertexSizeChanged(Signal<Ptr, int>::create())
+	_attributeTypes(),
+	_gpuAttributeOffsets(),
+	_gpuVertexSize(0),
+	_gpuSize(0),
+	_usage(BufferUsage::STATIC),
+	_dirtyBegin(0),
+	_dirtyEnd(0),
+	_numDisposedVertices(0),
+	_capacity(0),
+	_vertexSizeChanged(Signal<Ptr, int>::create()),
+	_dataChanged(Signal<Ptr>::create())
 {
 	upload();
 }
@@ -56,7 +168,17 @@ VertexBuffer::VertexBuffer(std::shared_ptr<AbstractContext>		context,
 	AbstractResource(context),
 	_data(begin, end),
 	_vertexSize(0),
-	_vertexSizeChanged(Signal<Ptr, int>::create())
+	_attributeTypes(),
+	_gpuAttributeOffsets(),
+	_gpuVertexSize(0),
+	_gpuSize(0),
+	_usage(BufferUsage::STATIC),
+	_dirtyBegin(0),
+	_dirtyEnd(0),
+	_numDisposedVertices(0),
+	_capacity(0),
+	_vertexSizeChanged(Signal<Ptr, int>::create()),
+	_dataChanged(Signal<Ptr>::create())
 {
 	upload();
 }
@@ -65,7 +187,36 @@ VertexBuffer::VertexBuffer(std::shared_ptr<AbstractContext> context, float* begi
 	AbstractResource(context),
 	_data(begin, end),
 	_vertexSize(0),
-	_vertexSizeChanged(Signal<Ptr, int>::create())
+	_attributeTypes(),
+	_gpuAttributeOffsets(),
+	_gpuVertexSize(0),
+	_gpuSize(0),
+	_usage(BufferUsage::STATIC),
+	_dirtyBegin(0),
+	_dirtyEnd(0),
+	_numDisposedVertices(0),
+	_capacity(0),
+	_vertexSizeChanged(Signal<Ptr, int>::create()),
+	_dataChanged(Signal<Ptr>::create())
+{
+	upload();
+}
+
+VertexBuffer::VertexBuffer(std::shared_ptr<AbstractContext> context, std::vector<float>&& data) :
+	AbstractResource(context),
+	_data(std::move(data)),
+	_vertexSize(0),
+	_attributeTypes(),
+	_gpuAttributeOffsets(),
+	_gpuVertexSize(0),
+	_gpuSize(0),
+	_usage(BufferUsage::STATIC),
+	_dirtyBegin(0),
+	_dirtyEnd(0),
+	_numDisposedVertices(0),
+	_capacity(0),
+	_vertexSizeChanged(Signal<Ptr, int>::create()),
+	_dataChanged(Signal<Ptr>::create())
 {
 	upload();
 }
@@ -73,17 +224,176 @@ VertexBuffer::VertexBuffer(std::shared_ptr<AbstractContext> context, float* begi
 void
 VertexBuffer::upload(uint offset, uint numVertices)
 {
-    if (_id == -1)
-    	_id = _context->createVertexBuffer(_data.size());
+	if (dataDisposed())
+		throw std::logic_error("the vertices were disposed, they have to be set again before being uploaded");
+
+	_numDisposedVertices = 0;
+
+	if (allocate())
+	{
+		offset = 0;
+		numVertices = 0;
+	}
+
+	if (_gpuAttributeOffsets.empty())
+		_context->uploadVertexBufferData(
+    		_id,
+    		offset * _vertexSize,
+    		numVertices == 0 ? _data.size() : numVertices * _vertexSize,
+    		&_data[0]
+		);
+	else
+		uploadPacked(offset, numVertices == 0 ? this->numVertices() - offset : numVertices);
+
+	if (offset == 0 && numVertices == 0)
+		_dirtyBegin = _dirtyEnd = 0;
+
+	// rescanned the next time the bounds are read
+	invalidatePositionBounds();
+
+	// nobody can listen yet when called from the constructors
+	if (_dataChanged->numCallbacks() > 0)
+		_dataChanged->execute(shared_from_this());
+}
+
+void
+VertexBuffer::uploadAsync(std::shared_ptr<UploadThread> uploadThread, std::function<void()> complete)
+{
+	// packed attributes are converted by uploadPacked() on the render thread
+	if (uploadThread == nullptr || !_gpuAttributeOffsets.empty() || dataDisposed() || _data.empty())
+	{
+		upload();
+		if (complete)
+			complete();
+
+		return;
+	}
+
+	allocate();
+
+	_dirtyBegin = _dirtyEnd = 0;
+	invalidatePositionBounds();
+
+	// keeps the vertices alive until the GPU is done with them
+	auto self = shared_from_this();
+
+	uploadThread->uploadBufferData(
+		false,
+		_id,
+		0,
+		_data.size() * sizeof(float),
+		&_data[0],
+		[self, complete]()
+		{
+			if (self->_dataChanged->numCallbacks() > 0)
+				self->_dataChanged->execute(self);
+			if (complete)
+				complete();
+		}
+	);
+}
+
+bool
+VertexBuffer::allocate()
+{
+	const uint size = std::max(
+		_gpuAttributeOffsets.empty() ? (uint)_data.size() : numVertices() * _gpuVertexSize,
+		_capacity * _gpuVertexSize
+	);
+
+	// packing attributes or adding vertices beyond the capacity changes the size of the buffer
+	if (_id != -1 && size != _gpuSize)
+	{
+		_context->deleteVertexBuffer(_id);
+		_id = -1;
+	}
+	if (_id != -1)
+		return false;
+
+	_id = _context->createVertexBuffer(size, _usage);
+	_gpuSize = size;
+
+	return true;
+}
+
+void
+VertexBuffer::usage(BufferUsage value)
+{
+	_usage = value;
+
+	if (_id != -1)
+		_context->setBufferUsage(_id, value);
+}
+
+void
+VertexBuffer::markDirty(uint offset, uint numVertices)
+{
+	if (numVertices == 0)
+		return;
+
+	if (_dirtyBegin == _dirtyEnd)
+	{
+		_dirtyBegin = offset;
+		_dirtyEnd = offset + numVertices;
+	}
+	else
+	{
+		_dirtyBegin = std::min(_dirtyBegin, offset);
+		_dirtyEnd = std::max(_dirtyEnd, offset + numVertices);
+	}
+}
+
+void
+VertexBuffer::uploadDirty()
+{
+	if (_dirtyBegin == _dirtyEnd)
+		return;
+
+	const auto begin = _dirtyBegin;
+	const auto end = std::min(_dirtyEnd, numVertices());
+
+	_dirtyBegin = _dirtyEnd = 0;
+
+	if (begin < end)
+		upload(begin, end - begin);
+}
+
+void
+VertexBuffer::uploadPacked(uint offset, uint numVertices)
+{
+	struct PackedAttribute
+	{
+		uint				offset;
+		uint				size;
+		VertexAttributeType	type;
+		uint				gpuOffset;
+	};
+
+	std::vector<PackedAttribute> packedAttributes;
+
+	for (auto& attribute : _attributes)
+	{
+		const auto& name = std::get<0>(*attribute);
+
+		packedAttributes.push_back({
+			std::get<2>(*attribute), std::get<1>(*attribute), attributeType(name), gpuAttributeOffset(name) << 2
+		});
+	}
+
+	std::vector<uint> packed(numVertices * _gpuVertexSize, 0);
+	auto dst = reinterpret_cast<unsigned char*>(&packed[0]);
+
+	for (uint i = 0; i < numVertices; ++i)
+	{
+		const float* src = &_data[(offset + i) * _vertexSize];
 
-    _context->uploadVertexBufferData(
-    	_id,
-    	offset * _vertexSize,
-    	numVertices == 0 ? _data.size() : numVertices * _vertexSize,
-    	&_data[0]
-    );
+		for (auto& attribute : packedAttributes)
+			packAttribute(attribute.type, src + attribute.offset, attribute.size, dst + attribute.gpuOffset);
 
-	updatePositionBounds();
+		dst += _gpuVertexSize << 2;
+	}
+
+	_context->uploadVertexBufferData(_id, offset * _gpuVertexSize, packed.size(), &packed[0]);
 }
 
 void
@@ -95,22 +405,58 @@ VertexBuffer::dispose()
 	    _id = -1;
     }
 	_data.clear();
+	_numDisposedVertices = 0;
+}
+
+void
+VertexBuffer::contextRestored()
+{
+	if (_id == -1)
+		return;
+
+	_id = _context->createVertexBuffer(_gpuSize, _usage);
+}
+
+void
+VertexBuffer::disposeData()
+{
+	if (_id == -1)
+		throw std::logic_error("the vertices have to be uploaded before their CPU-side copy is disposed");
+
+	if (_minPosition == nullptr)
+		updatePositionBounds();
+
+	_numDisposedVertices = numVertices();
+	_data.clear();
+	_data.shrink_to_fit();
 }
 
 void
 VertexBuffer::addAttribute(const std::string& 	name,
 						   const unsigned int	size,
-						   const unsigned int	offset)
+						   const unsigned int	offset,
+						   VertexAttributeType	type)
 {
 	if (hasAttribute(name))
 		throw std::invalid_argument("name");
+	if (type == VertexAttributeType::INT_2_10_10_10_NORMALIZED && size != 3 && size != 4)
+		throw std::invalid_argument("size");
 
 	_attributes.push_back(
 		VertexBuffer::AttributePtr(new VertexBuffer::Attribute(name, size, offset == 0 ? _vertexSize : offset))
 	);
 
+	const bool wasPacked = !_gpuAttributeOffsets.empty();
+
+	if (type != VertexAttributeType::FLOAT && _context->supportsVertexAttributeType(type))
+		_attributeTypes[name] = type;
+
 	vertexSize(_vertexSize + size);
 
+	updateGPULayout();
+	if (_id != -1 && (wasPacked || !_gpuAttributeOffsets.empty()))
+		upload();
+
 	if (name == ATTRNAME_POSITION)
 		invalidatePositionBounds();
 }
@@ -140,6 +486,13 @@ VertexBuffer::removeAttribute(const std::string& attributeName)
 	vertexSize(_vertexSize - std::get<1>(**it));
     _attributes.erase(it);
 
+	const bool wasPacked = !_gpuAttributeOffsets.empty();
+
+	_attributeTypes.erase(attributeName);
+	updateGPULayout();
+	if (_id != -1 && wasPacked)
+		upload();
+
 	if (attributeName == ATTRNAME_POSITION)
 		invalidatePositionBounds();
 }
@@ -154,6 +507,55 @@ VertexBuffer::attribute(const std::string& attributeName) const
 	throw std::invalid_argument("attributeName = " + attributeName);
 }
 
+uint
+VertexBuffer::gpuAttributeOffset(const std::string& attributeName) const
+{
+	if (_gpuAttributeOffsets.empty())
+		return std::get<2>(*attribute(attributeName));
+
+	auto offsetIt = _gpuAttributeOffsets.find(attributeName);
+
+	if (offsetIt == _gpuAttributeOffsets.end())
+		throw std::invalid_argument("attributeName = " + attributeName);
+
+	return offsetIt->second;
+}
+
+VertexAttributeType
+VertexBuffer::attributeType(const std::string& attributeName) const
+{
+	auto typeIt = _attributeTypes.find(attributeName);
+
+	return typeIt != _attributeTypes.end() ? typeIt->second : VertexAttributeType::FLOAT;
+}
+
+void
+VertexBuffer::updateGPULayout()
+{
+	_gpuAttributeOffsets.clear();
+	_gpuVertexSize = _vertexSize;
+
+	// float only buffers keep the CPU layout as is
+	if (_attributeTypes.empty())
+		return;
+
+	std::vector<AttributePtr> attributes(_attributes.begin(), _attributes.end());
+
+	std::sort(attributes.begin(), attributes.end(), [](AttributePtr a, AttributePtr b)
+	{
+		return std::get<2>(*a) < std::get<2>(*b);
+	});
+
+	_gpuVertexSize = 0;
+	for (auto& attribute : attributes)
+	{
+		const auto& name = std::get<0>(*attribute);
+
+		_gpuAttributeOffsets[name] = _gpuVertexSize;
+		_gpuVertexSize += attributeGPUSize(attributeType(name), std::get<1>(*attribute));
+	}
+}
+
 void
 VertexBuffer::vertexSize(unsigned int value)
 {
@@ -204,7 +606,7 @@ VertexBuffer::updatePositionBounds()
 {
 	invalidatePositionBounds();
 
-	if (!hasAttribute(ATTRNAME_POSITION) || numVertices() == 0)
+	if (!hasAttribute(ATTRNAME_POSITION) || _data.empty())
 		return;
 
 	auto				xyzAttr = attribute(ATTRNAME_POSITION);
@@ -27,7 +27,7 @@ using namespace minko;
 using namespace minko::scene;
 using namespace minko::component;
 
-unsigned int Node::_id = 0;
+std::atomic<unsigned int> Node::_id(0);
 
 Node::Node() :
 	_name("Node_" + std::to_string(Node::_id++)),
@@ -35,11 +35,11 @@ Node::Node() :
 	_root(nullptr),
 	_parent(nullptr),
 	_container(data::Container::create()),
-	_added(Signal<Ptr, Ptr, Ptr>::create()),
-	_removed(Signal<Ptr, Ptr, Ptr>::create()),
-	_componentAdded(Signal<Ptr, Ptr, Node::AbsCtrlPtr>::create()),
-	_componentRemoved(Signal<Ptr, Ptr, Node::AbsCtrlPtr>::create()),
-	_layoutsChanged(Signal<Ptr, Ptr>::create())
+	_added(Signal<Ptr, Ptr, Ptr>::create()->name("Node::added")),
+	_removed(Signal<Ptr, Ptr, Ptr>::create()->name("Node::removed")),
+	_componentAdded(Signal<Ptr, Ptr, Node::AbsCtrlPtr>::create()->name("Node::componentAdded")),
+	_componentRemoved(Signal<Ptr, Ptr, Node::AbsCtrlPtr>::create()->name("Node::componentRemoved")),
+	_layoutsChanged(Signal<Ptr, Ptr>::create()->name("Node::layoutsChanged"))
 {
 }
 
@@ -139,6 +139,7 @@ Node::addComponent(std::shared_ptr<AbstractComponent> component)
 		throw std::logic_error("The same component cannot be added twice.");
 
 	_components.push_back(component);
+	_typeToComponents.clear();
 	component->_targets.push_back(shared_from_this());
 
     component->targetAdded()->execute(component, shared_from_this());
@@ -170,6 +171,7 @@ Node::removeComponent(std::shared_ptr<AbstractComponent> component)
 		throw std::invalid_argument("component");
 
 	_components.erase(it);
+	_typeToComponents.clear();
 	component->_targets.erase(
 		std::find(component->_targets.begin(), component->_targets.end(), shared_from_this())
 	);
@@ -0,0 +1,75 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/scene/NodePool.hpp"
+
+#include "minko/scene/Node.hpp"
+#include "minko/scene/Prefab.hpp"
+
+using namespace minko;
+using namespace minko::scene;
+
+void
+NodePool::reserve(uint numNodes)
+{
+	if (_freeNodes.size() >= numNodes)
+		return;
+
+	// the instances are built together so that they share a single RootTransform
+	auto instances = _prefab->instantiate(numNodes - _freeNodes.size());
+	auto children = instances->children();
+
+	instances->removeChildren();
+	_freeNodes.insert(_freeNodes.end(), children.begin(), children.end());
+}
+
+Node::Ptr
+NodePool::acquire(Node::Ptr parent)
+{
+	Node::Ptr node;
+
+	if (_freeNodes.empty())
+		node = _prefab->instantiate();
+	else
+	{
+		node = _freeNodes.back();
+		_freeNodes.pop_back();
+		_prefab->reset(node);
+	}
+
+	_acquiredNodes.insert(node);
+	if (parent)
+		parent->addChild(node);
+
+	return node;
+}
+
+void
+NodePool::release(Node::Ptr node)
+{
+	auto it = _acquiredNodes.find(node);
+
+	if (it == _acquiredNodes.end())
+		throw std::invalid_argument("node");
+
+	_acquiredNodes.erase(it);
+	if (node->parent())
+		node->parent()->removeChild(node);
+	_freeNodes.push_back(node);
+}
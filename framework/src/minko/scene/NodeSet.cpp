@@ -29,30 +29,63 @@ scene::NodeSet::descendants(bool andSelf, bool depthFirst, scene::NodeSet::Ptr r
 	if (result == nullptr)
 		result = create();
 
-	std::list<std::shared_ptr<Node>> nodesStack;
+	auto& nodes = result->_nodes;
+
+	for (const auto& node : _nodes)
+		visitDescendants(
+			node,
+			[&](const std::shared_ptr<Node>& descendant)
+			{
+				nodes.push_back(descendant);
+			},
+			andSelf,
+			depthFirst
+		);
 
-	for (auto node : _nodes)
+	return result;
+}
+
+static
+void
+visitChildrenDepthFirst(const std::shared_ptr<scene::Node>& node, const scene::NodeSet::Visitor& visitor)
+{
+	const auto& children = node->children();
+
+	for (uint i = 0; i < children.size(); ++i)
 	{
-		nodesStack.push_front(node);
+		visitor(children[i]);
+		visitChildrenDepthFirst(children[i], visitor);
+	}
+}
 
-		while (nodesStack.size() != 0)
-		{
-			auto descendant = nodesStack.front();
+void
+scene::NodeSet::visitDescendants(const std::shared_ptr<Node>&	node,
+								 const Visitor&					visitor,
+								 bool							andSelf,
+								 bool							depthFirst)
+{
+	if (andSelf)
+		visitor(node);
 
-			nodesStack.pop_front();
+	if (depthFirst)
+	{
+		visitChildrenDepthFirst(node, visitor);
 
-			if (descendant != node || andSelf)
-				result->_nodes.push_back(descendant);
+		return;
+	}
 
-			nodesStack.insert(
-				depthFirst ? nodesStack.begin() : nodesStack.end(),
-				descendant->children().begin(),
-				descendant->children().end()
-			);
+	std::vector<Node*> queue(1, node.get());
+
+	for (uint i = 0; i < queue.size(); ++i)
+	{
+		const auto& children = queue[i]->children();
+
+		for (const auto& child : children)
+		{
+			visitor(child);
+			queue.push_back(child.get());
 		}
 	}
-
-	return result;
 }
 
 scene::NodeSet::Ptr
@@ -0,0 +1,193 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/scene/Prefab.hpp"
+
+#include "minko/scene/Node.hpp"
+#include "minko/scene/NodeSet.hpp"
+#include "minko/component/Transform.hpp"
+#include "minko/component/Surface.hpp"
+
+using namespace minko;
+using namespace minko::scene;
+using namespace minko::component;
+
+Prefab::Prefab() :
+	_numTransforms(0)
+{
+}
+
+Prefab::Ptr
+Prefab::create(Node::Ptr source)
+{
+	if (!source)
+		throw std::invalid_argument("source");
+
+	auto prefab = std::shared_ptr<Prefab>(new Prefab());
+
+	prefab->initialize(source);
+
+	return prefab;
+}
+
+void
+Prefab::initialize(Node::Ptr source)
+{
+	std::unordered_map<Node::Ptr, int> nodeToEntry;
+
+	NodeSet::visitDescendants(
+		source,
+		[&](const Node::Ptr& node)
+		{
+			Entry entry;
+
+			entry.parent = node == source ? -1 : nodeToEntry[node->parent()];
+			entry.name = node->name();
+			entry.layouts = node->layouts();
+			for (auto component : node->components<AbstractComponent>())
+				entry.components.push_back(component);
+
+			if (node->hasComponent<Transform>())
+				++_numTransforms;
+
+			nodeToEntry[node] = _entries.size();
+			_entries.push_back(entry);
+		},
+		true,
+		true
+	);
+
+	cloner<Transform>([](Transform::Ptr transform)
+	{
+		auto clone = Transform::create(transform->matrix());
+
+		clone->isStatic(transform->isStatic());
+
+		return clone;
+	});
+
+	cloner<Surface>([](Surface::Ptr surface)
+	{
+		auto clone = Surface::create(
+			surface->name(),
+			surface->geometry(),
+			surface->material(),
+			surface->effect(),
+			surface->technique()
+		);
+
+		clone->visible(surface->visible());
+
+		return clone;
+	});
+}
+
+Node::Ptr
+Prefab::instantiate()
+{
+	return instantiate(Node::Ptr(nullptr));
+}
+
+Node::Ptr
+Prefab::instantiate(uint numInstances, Node::Ptr parent)
+{
+	auto instances = Node::create();
+
+	for (uint i = 0; i < numInstances; ++i)
+		instantiate(instances);
+
+	if (parent)
+	{
+		auto rootTransform = parent->root()->component<Transform::RootTransform>();
+
+		if (rootTransform)
+			rootTransform->reserve(numInstances * _numTransforms);
+
+		parent->addChild(instances);
+	}
+
+	return instances;
+}
+
+Node::Ptr
+Prefab::instantiate(Node::Ptr parent)
+{
+	std::vector<Node::Ptr> nodes(_entries.size());
+
+	// the nodes are attached first so that the Transforms of the instance share the RootTransform of parent
+	for (uint i = 0; i < _entries.size(); ++i)
+	{
+		const auto& entry = _entries[i];
+		auto node = Node::create(entry.name);
+
+		node->layouts(entry.layouts);
+		if (entry.parent >= 0)
+			nodes[entry.parent]->addChild(node);
+		else if (parent)
+			parent->addChild(node);
+		nodes[i] = node;
+	}
+
+	for (uint i = 0; i < _entries.size(); ++i)
+		for (const auto& component : _entries[i].components)
+		{
+			auto it = _cloners.find(std::type_index(typeid(*component)));
+
+			if (it != _cloners.end())
+				nodes[i]->addComponent(it->second(component));
+		}
+
+	return nodes[0];
+}
+
+void
+Prefab::reset(Node::Ptr instance)
+{
+	uint i = 0;
+
+	NodeSet::visitDescendants(
+		instance,
+		[&](const Node::Ptr& node)
+		{
+			if (i >= _entries.size())
+				throw std::logic_error("The hierarchy of a prefab instance cannot be changed.");
+
+			const auto& entry = _entries[i++];
+
+			node->name(entry.name);
+			node->layouts(entry.layouts);
+
+			for (const auto& component : entry.components)
+			{
+				auto sourceTransform = std::dynamic_pointer_cast<Transform>(component);
+				auto sourceSurface = std::dynamic_pointer_cast<Surface>(component);
+
+				if (sourceTransform && node->hasComponent<Transform>())
+					node->component<Transform>()->matrix()->copyFrom(sourceTransform->matrix());
+				else if (sourceSurface && node->hasComponent<Surface>())
+					node->component<Surface>()->visible(sourceSurface->visible());
+			}
+		},
+		true,
+		true
+	);
+
+	if (i != _entries.size())
+		throw std::logic_error("The hierarchy of a prefab instance cannot be changed.");
+}
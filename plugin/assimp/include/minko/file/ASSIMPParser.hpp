@@ -75,6 +75,20 @@ namespace minko
 			typedef std::unordered_map<LoaderPtr, LoaderSignalSlot>	LoaderToSlotMap;
 			typedef std::unordered_map<uint, std::string>			TextureTypeToName;
 
+			// channel to sample, with the sample times of its animation
+			struct ChannelSampling
+			{
+				const aiNodeAnim*					channel;
+				std::shared_ptr<std::vector<float>>	times;
+			};
+
+			// CPU side conversion of a mesh, computed by the workers before the buffers are created
+			struct MeshData
+			{
+				std::vector<float>	vertices;
+				std::vector<uint>	indices;
+			};
+
         private:
 			static const TextureTypeToName							_textureTypeToName;
 			static const std::string								PNAME_TRANSFORM;
@@ -92,9 +106,7 @@ namespace minko
 			std::unordered_map<std::string, NodePtr>				_nameToNode;
 			std::unordered_map<std::string, Matrices4x4>			_nameToAnimMatrices;
 			std::set<NodePtr>										_alreadyAnimatedNodes;
-
-			LoaderToSlotMap											_loaderCompleteSlots;
-			LoaderToSlotMap											_loaderErrorSlots;
+			std::unordered_map<const aiMesh*, MeshData>				_aiMeshToMeshData;
 
 		public:
 			inline static
@@ -128,6 +140,13 @@ namespace minko
             void
 			createSceneTree(NodePtr minkoNode, const aiScene* scene, aiNode* ainode, std::shared_ptr<AssetLibrary> assets);
 
+			void
+			convertMeshes(const aiScene*);
+
+			static
+			void
+			convertMesh(const aiMesh*, bool optimize, MeshData&);
+
             GeometryPtr
             createMeshGeometry(NodePtr, aiMesh*);
             
@@ -185,7 +204,7 @@ namespace minko
 			sampleAnimations(const aiScene*);
 
 			void
-			sampleAnimation(const aiAnimation*);
+			sampleAnimation(const aiAnimation*, std::unordered_map<std::string, ChannelSampling>&);
 
 			static
 			Vector3Ptr
@@ -25,6 +25,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "assimp/scene.h"           // Output data structure
 #include "assimp/postprocess.h"     // Post processing flags
 #include "assimp/material.h"
+#include "assimp/config.h"
 
 #include "minko/scene/Node.hpp"
 #include "minko/scene/NodeSet.hpp"
@@ -42,9 +43,11 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/animation/Matrix4x4Timeline.hpp"
 #include "minko/render/VertexBuffer.hpp"
 #include "minko/render/IndexBuffer.hpp"
+#include "minko/render/AbstractContext.hpp"
 #include "minko/geometry/Geometry.hpp"
 #include "minko/geometry/Skin.hpp"
 #include "minko/geometry/Bone.hpp"
+#include "minko/geometry/MeshOptimizer.hpp"
 #include "minko/material/Material.hpp"
 #include "minko/file/AssetLibrary.hpp"
 #include "minko/render/Effect.hpp"
@@ -53,6 +56,9 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/material/PhongMaterial.hpp"
 #include "minko/render/Effect.hpp"
 #include "minko/render/Priority.hpp"
+#include "minko/async/Parallel.hpp"
+
+#include <atomic>
 
 using namespace minko;
 using namespace minko::component;
@@ -77,6 +83,27 @@ using namespace minko::geometry;
 	printNode(std::ostream& out, Node::Ptr node, uint depth)
 #endif // DEBUG_ASSIMP
 
+namespace
+{
+	// meshes and channels have very different sizes: the workers pick the next item when they are done
+	void
+	forEachInParallel(uint numItems, const std::function<void(uint)>& f)
+	{
+#if defined(EMSCRIPTEN)
+		const uint numWorkers = 1;
+#else
+		const uint numWorkers = std::max(1u, std::min(numItems, std::thread::hardware_concurrency()));
+#endif
+		std::atomic<uint> nextItem(0);
+
+		async::runInParallel(numWorkers, numWorkers, [&](uint begin, uint end, uint worker)
+		{
+			for (uint item = nextItem++; item < numItems; item = nextItem++)
+				f(item);
+		});
+	}
+}
+
 /*static*/ const ASSIMPParser::TextureTypeToName	ASSIMPParser::_textureTypeToName	= ASSIMPParser::initializeTextureTypeToName();
 /*static*/ const std::string						ASSIMPParser::PNAME_TRANSFORM		= "transform.matrix";
 
@@ -106,9 +133,7 @@ ASSIMPParser::ASSIMPParser() :
 	_aiMeshToNode(),
 	_nameToNode(),
 	_nameToAnimMatrices(),
-	_alreadyAnimatedNodes(),
-	_loaderCompleteSlots(),
-	_loaderErrorSlots()
+	_alreadyAnimatedNodes()
 {
 }
 
@@ -164,6 +189,10 @@ ASSIMPParser::parse(const std::string&					filename,
 	options->loadAsynchronously(false);
 	importer.SetIOHandler(new IOHandler(options, _assetLibrary));
 
+	// meshes only have to be split when the context cannot draw with 32 bits indices
+	if (!_assetLibrary->context()->supportsUnsignedIntIndices())
+		importer.SetPropertyInteger(AI_CONFIG_PP_SLM_VERTEX_LIMIT, 0xffff);
+
 	const aiScene* scene = importer.ReadFileFromMemory(
 		&data[0],
 		data.size(),
@@ -186,6 +215,9 @@ ASSIMPParser::parse(const std::string&					filename,
     
     parseDependencies(resolvedFilename, scene);
 
+	// only the node tree and the buffers are created serially
+	convertMeshes(scene);
+
 	_symbol = scene::Node::create(_filename);
 	createSceneTree(_symbol, scene, scene->mRootNode, assetLibrary);
 
@@ -285,8 +317,30 @@ ASSIMPParser::getTransformFromAssimp(aiNode* ainode)
 	return Transform::create(convert(ainode->mTransformation));
 }
 
-Geometry::Ptr
-ASSIMPParser::createMeshGeometry(scene::Node::Ptr minkoNode, aiMesh* mesh)
+void
+ASSIMPParser::convertMeshes(const aiScene* scene)
+{
+	std::vector<const aiMesh*> meshes;
+
+	// the entries are inserted before the workers fill them
+	for (uint meshId = 0; meshId < scene->mNumMeshes; ++meshId)
+		if (scene->mMeshes[meshId] != nullptr && _aiMeshToMeshData.count(scene->mMeshes[meshId]) == 0)
+		{
+			meshes.push_back(scene->mMeshes[meshId]);
+			_aiMeshToMeshData[scene->mMeshes[meshId]] = MeshData();
+		}
+
+	const auto optimize = _options->optimizeGeometries();
+
+	forEachInParallel(meshes.size(), [&](uint i)
+	{
+		convertMesh(meshes[i], optimize, _aiMeshToMeshData[meshes[i]]);
+	});
+}
+
+/*static*/
+void
+ASSIMPParser::convertMesh(const aiMesh* mesh, bool optimize, MeshData& meshData)
 {
 	unsigned int vertexSize = 0; 
 
@@ -297,8 +351,10 @@ ASSIMPParser::createMeshGeometry(scene::Node::Ptr minkoNode, aiMesh* mesh)
     if (mesh->GetNumUVChannels() > 0)
         vertexSize += 2;
 
-	std::vector<float>	vertexData	(vertexSize * mesh->mNumVertices, 0.0f);
-	unsigned int		vId			= 0;
+	auto&			vertexData	= meshData.vertices;
+	unsigned int	vId			= 0;
+
+	vertexData.assign(vertexSize * mesh->mNumVertices, 0.0f);
 	for (unsigned int vertexId = 0; vertexId < mesh->mNumVertices; ++vertexId)
 	{
 		if (mesh->HasPositions())
@@ -329,8 +385,9 @@ ASSIMPParser::createMeshGeometry(scene::Node::Ptr minkoNode, aiMesh* mesh)
 	}
 
 	// make sure the flag 'aiProcess_Triangulate' is specified before importing the scene
-	std::vector<unsigned short>	indexData	(3 * mesh->mNumFaces, 0);
+	auto& indexData = meshData.indices;
 
+	indexData.assign(3 * mesh->mNumFaces, 0);
 	for (unsigned int faceId = 0; faceId < mesh->mNumFaces; ++faceId)
 	{
 		const aiFace& face = mesh->mFaces[faceId];
@@ -339,9 +396,39 @@ ASSIMPParser::createMeshGeometry(scene::Node::Ptr minkoNode, aiMesh* mesh)
 			indexData[j + 3*faceId] = face.mIndices[j];
 	}
 
-	// create the geometry's vertex and index buffers
+	if (!optimize || vertexSize == 0 || indexData.empty())
+		return;
+
+	// same passes as Geometry::optimize(), the only vertex buffer is already interleaved
+	std::vector<std::vector<float>> vertices(1);
+
+	vertices[0].swap(vertexData);
+	Geometry::removeDuplicatedVertices(indexData, vertices, mesh->mNumVertices);
+	vertices[0].swap(vertexData);
+
+	const uint numVertices = vertexData.size() / vertexSize;
+
+	MeshOptimizer::optimizeVertexCache(indexData, numVertices);
+	if (mesh->HasPositions())
+		MeshOptimizer::optimizeOverdraw(indexData, vertexData, vertexSize, 0);
+	MeshOptimizer::remapVertices(vertexData, vertexSize, MeshOptimizer::optimizeVertexFetch(indexData, numVertices));
+}
+
+Geometry::Ptr
+ASSIMPParser::createMeshGeometry(scene::Node::Ptr minkoNode, aiMesh* mesh)
+{
+	auto& meshData = _aiMeshToMeshData[mesh];
+
+	if (meshData.vertices.empty() && mesh->mNumVertices != 0)
+		convertMesh(mesh, _options->optimizeGeometries(), meshData);
+
+	auto& vertexData	= meshData.vertices;
+	auto& indexData		= meshData.indices;
+
+	// create the geometry's vertex and index buffers, the data is moved into them: a mesh referenced by
+	// another node is converted again
 	auto geometry		= Geometry::create();
-	auto vertexBuffer	= render::VertexBuffer::create(_assetLibrary->context(), vertexData);
+	auto vertexBuffer	= render::VertexBuffer::create(_assetLibrary->context(), std::move(vertexData));
 
 	unsigned int attrOffset = 0;
 	if (mesh->HasPositions())
@@ -361,11 +448,13 @@ ASSIMPParser::createMeshGeometry(scene::Node::Ptr minkoNode, aiMesh* mesh)
 	}
 
 	geometry->addVertexBuffer(vertexBuffer);
-	geometry->indices(render::IndexBuffer::create(_assetLibrary->context(), indexData));
+	geometry->indices(render::IndexBuffer::create(_assetLibrary->context(), std::move(indexData)));
 
 	const auto meshName = std::string(mesh->mName.data);
 
 	geometry = _options->geometryFunction()(meshName, geometry);
+	if (_options->disposeGeometryData())
+		geometry->disposeData();
 
 	// save the geometry in the assets library
 	if (!meshName.empty())
@@ -388,6 +477,10 @@ ASSIMPParser::createMeshSurface(scene::Node::Ptr 	minkoNode,
 	auto		material	= createMaterial(aiMat);
 	auto		effect		= chooseEffectByShadingMode(aiMat);
 
+	// meshes with identical materials share a single provider
+	if (_options->shareMaterials())
+		material = std::static_pointer_cast<material::Material>(_assetLibrary->internMaterial(material));
+
 	if (effect)
 	{
 		minkoNode->addComponent(
@@ -601,9 +694,6 @@ ASSIMPParser::parseDependencies(const std::string& 	filename,
 void
 ASSIMPParser::finalize()
 {
-	_loaderErrorSlots.clear();
-	_loaderCompleteSlots.clear();
-
 	_assetLibrary->symbol(_filename, _symbol);
 
 	complete()->execute(shared_from_this());
@@ -614,66 +704,67 @@ ASSIMPParser::loadTexture(const std::string&	textureFilename,
 						  const std::string&	assetName,
 						  Options::Ptr			options)
 {
-	auto loader = _options->loaderFunction()(textureFilename, _assetLibrary);
+	auto that = std::static_pointer_cast<ASSIMPParser>(shared_from_this());
 
-	_loaderCompleteSlots[loader] = loader->complete()->connect([&](file::AbstractLoader::Ptr loader)
-	{
-		auto pos		= loader->resolvedFilename().find_last_of('.');
-		auto extension	= loader->resolvedFilename().substr(pos + 1);
-		auto parser		= _assetLibrary->getParser(extension);
+	_assetLibrary->fetch(
+		textureFilename,
+		options,
+		[=](file::AbstractLoader::Ptr loader)
+		{
+			auto pos		= loader->resolvedFilename().find_last_of('.');
+			auto extension	= loader->resolvedFilename().substr(pos + 1);
+			auto parser		= that->_assetLibrary->getParser(extension);
 
 #ifdef DEBUG
-		if (parser == nullptr)
-			std::cerr << "No parser for extension '" << extension << "' found in asset library" << std::endl;
+			if (parser == nullptr)
+				std::cerr << "No parser for extension '" << extension << "' found in asset library" << std::endl;
 #endif // DEBUG
 
-		if (!parser)
-		{
-			++_numLoadedDependencies;
-			if (_numDependencies == _numLoadedDependencies && _symbol)
-				finalize();
+			if (!parser)
+			{
+				++that->_numLoadedDependencies;
+				if (that->_numDependencies == that->_numLoadedDependencies && that->_symbol)
+					that->finalize();
 
-			return;
-		}
+				return;
+			}
 
-		auto complete = parser->complete()->connect([&](file::AbstractParser::Ptr parser)
-		{
+			auto complete = parser->complete()->connect([=](file::AbstractParser::Ptr parser)
+			{
 #ifdef DEBUG
-			std::cout << "ASSIMParser: texture '" << textureFilename << "' loaded" << std::endl;
+				std::cout << "ASSIMParser: texture '" << textureFilename << "' loaded" << std::endl;
 #endif
 
-			_numLoadedDependencies++;
-			if (_numDependencies == _numLoadedDependencies && _symbol)
-				finalize();
-		});
-
-		parser->parse(
-			assetName,
-			loader->resolvedFilename(),
-			loader->options(),
-			loader->data(),
-			_assetLibrary
-		);
-	});
-
-	_loaderErrorSlots[loader] = loader->error()->connect([&](file::AbstractLoader::Ptr loader)
-	{
-		auto pos = loader->filename().find_last_of("\\/");
-
-		if (pos != std::string::npos)
-		{
-			loadTexture(loader->filename().substr(pos + 1), assetName, options);
-		}
-		else
+				that->_numLoadedDependencies++;
+				if (that->_numDependencies == that->_numLoadedDependencies && that->_symbol)
+					that->finalize();
+			});
+
+			parser->parse(
+				assetName,
+				loader->resolvedFilename(),
+				loader->options(),
+				loader->data(),
+				that->_assetLibrary
+			);
+		},
+		[=](file::AbstractLoader::Ptr loader)
 		{
-			++_numLoadedDependencies;
+			auto pos = loader->filename().find_last_of("\\/");
+
+			if (pos != std::string::npos)
+			{
+				that->loadTexture(loader->filename().substr(pos + 1), assetName, options);
+			}
+			else
+			{
+				++that->_numLoadedDependencies;
 #ifdef DEBUG
-			std::cerr << "unable to find texture with filename '" << loader->filename() << "'" << std::endl;
+				std::cerr << "unable to find texture with filename '" << loader->filename() << "'" << std::endl;
 #endif // DEBUG
+			}
 		}
-	});
-
-	loader->load(textureFilename, options);
+	);
 }
 
 void
@@ -694,6 +785,7 @@ ASSIMPParser::disposeNodeMaps()
 	_nameToNode.clear();
 	_nameToAnimMatrices.clear();
 	_alreadyAnimatedNodes.clear();
+	_aiMeshToMeshData.clear();
 }
 
 unsigned int
@@ -849,9 +941,13 @@ ASSIMPParser::createSkin(const aiMesh* aimesh)
 		skeletonRoot->addChild(n);
 	}
 
+	skin->reorganizeByVertices()->transposeMatrices()->disposeBones();
+	if (_options->skinningCompressionTolerance() > 0.0f)
+		skin->compressMatrices(_options->skinningCompressionTolerance());
+
 	// add skinning component to mesh
 	meshNode->addComponent(Skinning::create(
-		skin->reorganizeByVertices()->transposeMatrices()->disposeBones(), 
+		skin, 
 		_options->skinningMethod(), 
 		_assetLibrary->context(),
 		slaveAnimations
@@ -1018,12 +1114,12 @@ ASSIMPParser::createBone(const aiBone* aibone) const
 	auto node			= _nameToNode.find(boneName)->second;
 	auto offsetMatrix	= convert(aibone->mOffsetMatrix);
 
-	std::vector<unsigned short> boneVertexIds		(aibone->mNumWeights, 0);
+	std::vector<uint>			boneVertexIds		(aibone->mNumWeights, 0);
 	std::vector<float>			boneVertexWeights	(aibone->mNumWeights, 0.0f);
 
 	for (unsigned int i = 0; i < aibone->mNumWeights; ++i)
 	{
-		boneVertexIds[i]		= (unsigned short)aibone->mWeights[i].mVertexId;
+		boneVertexIds[i]		= aibone->mWeights[i].mVertexId;
 		boneVertexWeights[i]	= aibone->mWeights[i].mWeight; 
 	}
 
@@ -1038,12 +1134,27 @@ ASSIMPParser::sampleAnimations(const aiScene* scene)
 	if (scene == nullptr)
 		return;
 
+	// a node animated by several animations keeps the last one
+	std::unordered_map<std::string, ChannelSampling> nameToSampling;
+
 	for (unsigned int animId = 0; animId < scene->mNumAnimations; ++animId)
-		sampleAnimation(scene->mAnimations[animId]);
+		sampleAnimation(scene->mAnimations[animId], nameToSampling);
+
+	std::vector<std::pair<const ChannelSampling*, std::vector<Matrix4x4::Ptr>*>> jobs;
+
+	jobs.reserve(nameToSampling.size());
+	for (auto& nameAndSampling : nameToSampling)
+		jobs.push_back(std::make_pair(&nameAndSampling.second, &_nameToAnimMatrices[nameAndSampling.first]));
+
+	forEachInParallel(jobs.size(), [&](uint i)
+	{
+		sample(jobs[i].first->channel, *jobs[i].first->times, *jobs[i].second);
+	});
 }
 
 void
-ASSIMPParser::sampleAnimation(const aiAnimation* animation)
+ASSIMPParser::sampleAnimation(const aiAnimation*									animation,
+							  std::unordered_map<std::string, ChannelSampling>&	nameToSampling)
 {
 	if (animation == nullptr || animation->mTicksPerSecond < 1e-6 || _options->skinningFramerate() == 0)
 		return;
@@ -1051,11 +1162,11 @@ ASSIMPParser::sampleAnimation(const aiAnimation* animation)
 	unsigned int numFrames	= (unsigned int)floorf(float(_options->skinningFramerate() * animation->mDuration / animation->mTicksPerSecond));
 	numFrames				= numFrames < 2 ? 2 : numFrames;
 
-	const float			timeStep	= (float)animation->mDuration / (float)(numFrames - 1);
-	std::vector<float>	sampleTimes	(numFrames, 0.0f);
+	const float	timeStep	= (float)animation->mDuration / (float)(numFrames - 1);
+	auto		sampleTimes	= std::make_shared<std::vector<float>>(numFrames, 0.0f);
 	for (unsigned int frameId = 1; frameId < numFrames; ++frameId)
 	{
-		sampleTimes[frameId] = sampleTimes[frameId - 1] + timeStep; 
+		(*sampleTimes)[frameId] = (*sampleTimes)[frameId - 1] + timeStep; 
 	}
 
 	for (unsigned int channelId = 0; channelId < animation->mNumChannels; ++channelId)
@@ -1066,8 +1177,10 @@ ASSIMPParser::sampleAnimation(const aiAnimation* animation)
 
 		if (!nodeName.empty())
 		{
-			_nameToAnimMatrices[nodeName] = std::vector<Matrix4x4::Ptr>();
-			sample(nodeAnimation, sampleTimes, _nameToAnimMatrices[nodeName]);
+			auto& sampling = nameToSampling[nodeName];
+
+			sampling.channel	= nodeAnimation;
+			sampling.times		= sampleTimes;
 		}
 	}
 }
@@ -1080,10 +1193,11 @@ ASSIMPParser::sample(const aiNodeAnim*				nodeAnimation,
 {
 	assert(nodeAnimation);
 
-	static auto position		= Vector3::create();
-	static auto scaling			= Vector3::create();
-	static auto rotation		= Quaternion::create();
-	static auto rotationMatrix	= Matrix4x4::create();
+	// no static temporaries, the channels are sampled by several workers
+	auto position		= Vector3::create();
+	auto scaling		= Vector3::create();
+	auto rotation		= Quaternion::create();
+	auto rotationMatrix	= Matrix4x4::create();
 
 #ifdef DEBUG
 	//std::cout << "\nsample animation of mesh('" << nodeAnimation->mNodeName.C_Str() << "')" << std::endl;
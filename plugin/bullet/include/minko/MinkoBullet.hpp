@@ -27,5 +27,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/component/bullet/BoxShape.hpp"
 #include "minko/component/bullet/ConeShape.hpp"
 #include "minko/component/bullet/CylinderShape.hpp"
+#include "minko/component/bullet/TriangleMeshShape.hpp"
+#include "minko/component/bullet/HeightfieldShape.hpp"
 #include "minko/extension/PhysicsExtension.hpp"
 #include "minko/lua/BulletLuaBindingsCollection.hpp"
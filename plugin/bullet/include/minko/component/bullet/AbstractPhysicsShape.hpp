@@ -39,7 +39,9 @@ namespace minko
 					SPHERE,
 					BOX,
 					CONE,
-					CYLINDER
+					CYLINDER,
+					TRIANGLE_MESH,
+					HEIGHTFIELD
 				};
 
 			private:
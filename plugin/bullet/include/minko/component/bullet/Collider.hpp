@@ -65,11 +65,10 @@ namespace minko
 				Signal<AbsCtrlPtr, NodePtr>::Slot				_targetRemovedSlot;
 				Signal<NodePtr, NodePtr, NodePtr>::Slot			_addedSlot;
 				Signal<NodePtr, NodePtr, NodePtr>::Slot			_removedSlot;
-				Signal<ColliderDataPtr, Matrix4x4Ptr>::Slot		_graphicsTransformChangedSlot;
 				Signal<ColliderDataPtr, ColliderDataPtr>::Slot	_collisionStartedHandlerSlot;
 				Signal<ColliderDataPtr, ColliderDataPtr>::Slot	_collisionEndedHandlerSlot;
 
-				static Matrix4x4Ptr								_TMP_MATRIX;
+				Matrix4x4Ptr									_tmpMatrix;
 
 			public:
 				inline static
@@ -118,9 +117,6 @@ namespace minko
 				void
 				removedHandler(NodePtr, NodePtr, NodePtr);
 
-				void
-				graphicsWorldTransformChangedHandler(ColliderDataPtr, Matrix4x4Ptr);
-
 				void
 				collisionStartedHandler(ColliderDataPtr, ColliderDataPtr);
 
@@ -77,6 +77,7 @@ namespace minko
 				float			                            _rollingFriction;
 
 				bool			                            _deactivationDisabled;
+				bool			                            _kinematic;
 				bool			                            _triggerCollisions;
 
 				std::shared_ptr<Signal<Ptr, Matrix4x4Ptr>>	_graphicsWorldTransformChanged;
@@ -257,6 +258,21 @@ namespace minko
 					_deactivationDisabled = value;
 				}
 
+				// moved by its Transform instead of the simulation, the mass is ignored; set before the collider is added
+				inline
+				bool
+				kinematic() const
+				{
+					return _kinematic;
+				}
+
+				inline
+				void
+				kinematic(bool value)
+				{
+					_kinematic = value;
+				}
+
 				inline
 				bool 
 				triggerCollisions() const
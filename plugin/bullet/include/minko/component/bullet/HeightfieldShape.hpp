@@ -0,0 +1,136 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+#include <minko/component/bullet/AbstractPhysicsShape.hpp>
+#include <minko/component/Terrain.hpp>
+#include <minko/math/Matrix4x4.hpp>
+
+namespace minko
+{
+	namespace component
+	{
+		namespace bullet
+		{
+			// static grid of heights, its first height is at the origin of the node, the next ones being separated by
+			// spacing on the x and z axes: the delta transform moves the shape centered by Bullet accordingly
+			class HeightfieldShape:
+				public AbstractPhysicsShape
+			{
+			public:
+				typedef std::shared_ptr<HeightfieldShape> Ptr;
+
+			private:
+				std::vector<float>	_heights;
+				uint				_width;
+				uint				_depth;
+				float				_minHeight;
+				float				_maxHeight;
+
+			public:
+				// width x depth heights stored row by row
+				inline static
+				Ptr
+				create(const std::vector<float>& heights, uint width, uint depth, float spacing)
+				{
+					if (width < 2 || depth < 2 || heights.size() != width * depth)
+						throw std::invalid_argument("heights");
+					if (spacing <= 0.f)
+						throw std::invalid_argument("spacing");
+
+					return std::shared_ptr<HeightfieldShape>(new HeightfieldShape(heights, width, depth, spacing));
+				}
+
+				inline static
+				Ptr
+				create(std::shared_ptr<Terrain> terrain)
+				{
+					if (terrain == nullptr)
+						throw std::invalid_argument("terrain");
+
+					return create(terrain->heights(), terrain->width(), terrain->depth(), terrain->spacing());
+				}
+
+				inline
+				const std::vector<float>&
+				heights() const
+				{
+					return _heights;
+				}
+
+				inline
+				uint
+				width() const
+				{
+					return _width;
+				}
+
+				inline
+				uint
+				depth() const
+				{
+					return _depth;
+				}
+
+				inline
+				float
+				minHeight() const
+				{
+					return _minHeight;
+				}
+
+				inline
+				float
+				maxHeight() const
+				{
+					return _maxHeight;
+				}
+
+				// heightfields can only be used for static colliders
+				inline
+				float
+				volume() const
+				{
+					return 0.f;
+				}
+
+			private:
+				HeightfieldShape(const std::vector<float>& heights, uint width, uint depth, float spacing):
+					AbstractPhysicsShape(HEIGHTFIELD),
+					_heights(heights),
+					_width(width),
+					_depth(depth),
+					_minHeight(*std::min_element(heights.begin(), heights.end())),
+					_maxHeight(*std::max_element(heights.begin(), heights.end()))
+				{
+					localScaling(spacing, 1.f, spacing);
+
+					_deltaTransform->appendTranslation(
+						.5f * (width - 1) * spacing,
+						.5f * (_minHeight + _maxHeight),
+						.5f * (depth - 1) * spacing
+					);
+					_deltaTransformInverse->copyFrom(_deltaTransform)->invert();
+				}
+			};
+		}
+	}
+}
@@ -33,6 +33,7 @@ struct btDefaultMotionState;
 class btCollisionObject;
 class btTransform;
 class btRigidBody;
+class btVector3;
 
 namespace minko
 {
@@ -41,11 +42,14 @@ namespace minko
 		namespace bullet
 		{
 			class LinearIdAllocator; 
+			class CollisionPairSet;
 			class AbstractPhysicsShape;
 			class SphereShape;
 			class BoxShape;
 			class ConeShape;
 			class CylinderShape;
+			class TriangleMeshShape;
+			class HeightfieldShape;
 			class ColliderData;
 
 			class PhysicsWorld:
@@ -54,15 +58,49 @@ namespace minko
 			{
 			public:
 				typedef std::shared_ptr<PhysicsWorld>                                   Ptr;
+				typedef std::shared_ptr<ColliderData>				                    ColliderDataPtr; 
+				typedef Signal<Ptr, const std::vector<ColliderDataPtr>&>                CollidersUpdatedSignal;
+
+				static const uint                                                       PARALLEL_SYNC_MIN_NUM_BODIES = 256;
+				static const uint                                                       PARALLEL_MIN_NUM_QUERIES = 64;
+
+				// segment of a ray or a shape sweep; like the colliders, the query only hits the colliders
+				// whose group is in its mask and whose mask contains its group
+				struct RayQuery
+				{
+					float	from[3];
+					float	to[3];
+					short	group;
+					short	mask;
+
+					RayQuery(std::shared_ptr<math::Vector3> from, std::shared_ptr<math::Vector3> to, short group = 1, short mask = short((1 << 16) - 1));
+				};
+
+				struct QueryHit
+				{
+					uint	query;		// index of the query in the batch
+					uint	collider;	// uid of the ColliderData, see collider()
+					float	fraction;	// from 0 at the start of the segment to 1 at its end
+					float	point[3];
+					float	normal[3];
+				};
+
+				enum BroadphaseType
+				{
+					DBVT,
+					// sweep-and-prune, requires the bounds of the world
+					AXIS_SWEEP
+				};
 
 			private:
 				typedef std::shared_ptr<LinearIdAllocator>			                    LinearIdAllocatorPtr;
+				typedef std::shared_ptr<CollisionPairSet>			                    CollisionPairSetPtr;
 				typedef std::shared_ptr<AbstractComponent>			                    AbsCtrlPtr;
 				typedef std::shared_ptr<scene::Node>				                    NodePtr;
-				typedef std::shared_ptr<ColliderData>				                    ColliderDataPtr; 
 				typedef std::shared_ptr<Renderer>					                    RendererPtr;
 				typedef std::shared_ptr<math::Vector3>				                    Vector3Ptr;
 				typedef std::shared_ptr<math::Matrix4x4>			                    Matrix4x4Ptr;
+				typedef std::shared_ptr<Transform>					                    TransformPtr;
 				typedef std::shared_ptr<math::Quaternion>			                    QuaternionPtr;
 
 				typedef std::shared_ptr<btTransform>				                    btTransformPtr;
@@ -71,13 +109,13 @@ namespace minko
 				typedef std::shared_ptr<btConstraintSolver>			                    btConstraintSolverPtr;
 				typedef std::shared_ptr<btDispatcher>				                    btDispatcherPtr;
 				typedef std::shared_ptr<btDynamicsWorld>			                    btDynamicsWorldPtr;
+				typedef std::function<void(uint, std::vector<QueryHit>&)>				QueryFunction;
 
 				class BulletCollider;
 				typedef std::shared_ptr<BulletCollider>									BulletColliderPtr;
 				typedef std::unordered_map<ColliderDataPtr, BulletColliderPtr>			ColliderMap;
 				typedef std::unordered_map<const btCollisionObject*, ColliderDataPtr>	ColliderReverseMap;
 
-				typedef std::set<std::pair<uint, uint>>									CollisionSet;
                 typedef Signal<NodePtr, NodePtr>                                        NodeLayoutsChanged;
                 typedef Signal<ColliderDataPtr>                                         ColliderChanged;
 
@@ -86,7 +124,28 @@ namespace minko
 				ColliderMap										                        _colliderMap;
 				ColliderReverseMap								                        _colliderReverseMap;
 				std::unordered_map<uint, ColliderDataPtr>		                        _uidToCollider;
-				CollisionSet									                        _collisions;
+				CollisionPairSetPtr								                        _collisions;
+				CollisionPairSetPtr								                        _currentCollisions;
+				std::vector<uint>								                        _lostCollisions;
+
+				// dynamic bodies synchronized with the graphics after each step
+				std::vector<ColliderDataPtr>					                        _dynamicColliders;
+				std::vector<BulletColliderPtr>					                        _dynamicBulletColliders;
+				std::vector<TransformPtr>						                        _dynamicTargets;
+				// sleeping bodies whose last state was already synchronized
+				std::vector<unsigned char>						                        _dynamicAtRest;
+				// computed by the workers then flushed serially: graphics world and local matrices, 32 floats per body
+				std::vector<float>								                        _dynamicMatrices;
+				std::vector<unsigned char>						                        _dynamicUpdated;
+				bool											                        _multithreaded;
+				// kinematic bodies synchronized with their Transform before each step, when it changed
+				std::vector<ColliderDataPtr>					                        _kinematicColliders;
+				std::vector<TransformPtr>						                        _kinematicTargets;
+				// world matrices of the targets at the last synchronization, 16 floats per body
+				std::vector<float>								                        _kinematicWorldMatrices;
+				Matrix4x4Ptr									                        _kinematicTransform;
+				std::vector<ColliderDataPtr>					                        _updatedColliders;
+				std::shared_ptr<CollidersUpdatedSignal>			                        _collidersUpdated;
 
 				btBroadphasePtr									                        _bulletBroadphase;
 				btCollisionConfigurationPtr						                        _bulletCollisionConfiguration;
@@ -94,27 +153,41 @@ namespace minko
 				btDispatcherPtr									                        _bulletDispatcher;
 				btDynamicsWorldPtr								                        _bulletDynamicsWorld;
 
+				BroadphaseType									                        _broadphaseType;
+				Vector3Ptr										                        _worldAabbMin;
+				Vector3Ptr										                        _worldAabbMax;
+
 				std::shared_ptr<SceneManager>					                        _sceneManager;
 
 				Signal<AbsCtrlPtr, NodePtr>::Slot				                        _targetAddedSlot;
 				Signal<AbsCtrlPtr, NodePtr>::Slot				                        _targetRemovedSlot;
 				Signal<AbsCtrlPtr, NodePtr>::Slot				                        _exitFrameSlot;
-				Signal<std::shared_ptr<SceneManager>>::Slot		                        _frameEndSlot;
+				Signal<std::shared_ptr<SceneManager>, float, float>::Slot               _frameEndSlot;
 				Signal<NodePtr, NodePtr, NodePtr>::Slot			                        _addedOrRemovedSlot;
 				Signal<NodePtr, NodePtr, AbsCtrlPtr>::Slot		                        _componentAddedOrRemovedSlot;
                 std::unordered_map<ColliderDataPtr, NodeLayoutsChanged::Slot>           _colliderGroupChangedSlot;
                 std::unordered_map<ColliderDataPtr, ColliderChanged::Slot>              _colliderMaskChangedSlot;
 
+				float											                        _fixedTimeStep;
+				uint											                        _maxNumSubSteps;
+				bool											                        _interpolate;
+				float											                        _accumulatedTime;
+
 				static const uint								                        _MAX_BODIES;
-				static Matrix4x4Ptr								                        _TMP_MATRIX;
-				static btTransform								                        _TMP_BTTRANSFORM;
+				// per world so that the worlds of different threads never share it
+				Matrix4x4Ptr									                        _tmpMatrix;
 
 			public:
 				static
 				Ptr
-				create()
+				create(BroadphaseType	broadphaseType	= DBVT,
+					   Vector3Ptr		worldAabbMin	= nullptr,
+					   Vector3Ptr		worldAabbMax	= nullptr)
 				{
-					Ptr ptr(new PhysicsWorld());
+					if (broadphaseType == AXIS_SWEEP && (worldAabbMin == nullptr || worldAabbMax == nullptr))
+						throw std::invalid_argument("The axis sweep broadphase requires the world bounds.");
+
+					Ptr ptr(new PhysicsWorld(broadphaseType, worldAabbMin, worldAabbMax));
 
 					ptr->initialize();
 
@@ -125,6 +198,13 @@ namespace minko
 				{
 				}
 
+				inline
+				BroadphaseType
+				broadphaseType() const
+				{
+					return _broadphaseType;
+				}
+
 				bool
 				hasCollider(ColliderDataPtr) const;
 
@@ -137,12 +217,112 @@ namespace minko
 				void
 				setGravity(Vector3Ptr);
 
+				inline
+				float
+				fixedTimeStep() const
+				{
+					return _fixedTimeStep;
+				}
+
+				inline
+				Ptr
+				fixedTimeStep(float value)
+				{
+					if (value <= 0.f)
+						throw std::invalid_argument("value");
+
+					_fixedTimeStep = value;
+
+					return shared_from_this();
+				}
+
+				inline
+				uint
+				maxNumSubSteps() const
+				{
+					return _maxNumSubSteps;
+				}
+
+				inline
+				Ptr
+				maxNumSubSteps(uint value)
+				{
+					if (value == 0)
+						throw std::invalid_argument("value");
+
+					_maxNumSubSteps = value;
+
+					return shared_from_this();
+				}
+
+				inline
+				bool
+				interpolate() const
+				{
+					return _interpolate;
+				}
+
+				inline
+				Ptr
+				interpolate(bool value)
+				{
+					_interpolate = value;
+
+					return shared_from_this();
+				}
+
+				// executed once per step with the colliders whose graphics transform was updated
+				inline
+				std::shared_ptr<CollidersUpdatedSignal>
+				collidersUpdated() const
+				{
+					return _collidersUpdated;
+				}
+
+				inline
+				bool
+				multithreaded() const
+				{
+					return _multithreaded;
+				}
+
+				// synchronize the graphics with the dynamic bodies on several threads if there are enough of them
+				inline
+				Ptr
+				multithreaded(bool value)
+				{
+					_multithreaded = value;
+
+					return shared_from_this();
+				}
+
 				void 
 				update(float timeStep = 1.0f/60.0f);
 
+				void
+				step(float elapsedTime);
+
 				void
 				synchronizePhysicsWithGraphics(ColliderDataPtr, Matrix4x4Ptr);
 
+				// nullptr once the collider was removed
+				ColliderDataPtr
+				collider(uint uid) const;
+
+				// the closest hit of each ray, the hits are sorted by query; returns the number of hits
+				uint
+				raycast(const std::vector<RayQuery>& queries, std::vector<QueryHit>& hits);
+
+				// all the hits of each ray sorted by query then by distance, 0 for no limit per query
+				uint
+				rayTestAll(const std::vector<RayQuery>& queries, std::vector<QueryHit>& hits, uint maxHitsPerQuery = 0);
+
+				// the first hit of a convex shape moved without rotation along each segment
+				uint
+				convexSweep(std::shared_ptr<AbstractPhysicsShape>	shape,
+							const std::vector<RayQuery>&			queries,
+							std::vector<QueryHit>&					hits);
+
 				static
 				Matrix4x4Ptr
 				removeScalingShear(Matrix4x4Ptr, Matrix4x4Ptr output = nullptr, Matrix4x4Ptr correction = nullptr);
@@ -156,7 +336,7 @@ namespace minko
 				print(std::ostream&, Matrix4x4Ptr);
 
 			private:
-				PhysicsWorld();
+				PhysicsWorld(BroadphaseType, Vector3Ptr worldAabbMin, Vector3Ptr worldAabbMax);
 
 				void 
 				initialize();
@@ -171,18 +351,41 @@ namespace minko
 				addedHandler(NodePtr node, NodePtr target, NodePtr ancestor);
 
 				void
-				frameEndHandler(std::shared_ptr<SceneManager> sceneManager);
+				frameEndHandler(std::shared_ptr<SceneManager> sceneManager, float time, float deltaTime);
+
+				void
+				savePreviousWorldTransforms();
+
+				void
+				synchronizeKinematicColliders();
 
 				void
-				updateColliders();
+				updateColliders(float interpolationFactor = 1.f);
+
+				bool
+				computeColliderMatrices(uint index, float interpolationFactor);
 
 				void
 				notifyCollisions();
 
+				// the queries run on several threads with the DBVT broadphase, whose trees can be traversed concurrently
+				uint
+				runQueries(uint numQueries, std::vector<QueryHit>& hits, const QueryFunction& query);
+
+				void
+				collectCandidates(const RayQuery& query, std::vector<btCollisionObject*>& candidates) const;
+
+				void
+				collectCandidates(const RayQuery& query, const btVector3& aabbMin, const btVector3& aabbMax, std::vector<btCollisionObject*>& candidates) const;
+
 				static
 				Matrix4x4Ptr
 				fromBulletTransform(const btTransform&, Matrix4x4Ptr output = nullptr);
 
+				static
+				void
+				fromBulletTransform(const btTransform&, float* output);
+
 				static
 				void
 				toBulletTransform(Matrix4x4Ptr, btTransform&);
@@ -212,6 +415,8 @@ namespace minko
 					typedef std::shared_ptr<BoxShape>				BoxShapePtr;
 					typedef std::shared_ptr<ConeShape>				ConeShapePtr;
 					typedef std::shared_ptr<CylinderShape>			CylinderShapePtr;
+					typedef std::shared_ptr<TriangleMeshShape>		TriangleMeshShapePtr;
+					typedef std::shared_ptr<HeightfieldShape>		HeightfieldShapePtr;
 
 					typedef std::shared_ptr<btCollisionShape>		btCollisionShapePtr;
 					typedef std::shared_ptr<btMotionState>			btMotionStatePtr;
@@ -223,18 +428,30 @@ namespace minko
 					btCollisionShapePtr		_bulletCollisionShape;
 					btMotionStatePtr		_bulletMotionState;
 					btCollisionObjectPtr	_bulletCollisionObject;
+					btTransformPtr			_previousWorldTransform;
 
 				public:
 					static
 					BulletColliderPtr
 					create(ColliderDataPtr);
 
+					// a collision shape that is not attached to a body, for the queries
+					static
+					btCollisionShapePtr
+					createCollisionShape(AbsShapePtr);
+
 					btRigidBodyPtr
 					rigidBody() const;
 
 					void 
 					setWorldTransform(Matrix4x4Ptr);
 
+					void
+					savePreviousWorldTransform();
+
+					void
+					interpolatedWorldTransform(float, btTransform&) const;
+
 					void
 					setLinearVelocity(Vector3Ptr);
 
@@ -268,6 +485,12 @@ namespace minko
 					btCollisionShapePtr
 					initializeCylinderShape(CylinderShapePtr) const;
 
+					btCollisionShapePtr
+					initializeTriangleMeshShape(TriangleMeshShapePtr) const;
+
+					btCollisionShapePtr
+					initializeHeightfieldShape(HeightfieldShapePtr) const;
+
 					btMotionStatePtr
 					initializeMotionState(ColliderDataPtr) const;
 
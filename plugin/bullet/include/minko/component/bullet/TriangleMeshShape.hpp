@@ -0,0 +1,108 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "minko/Common.hpp"
+#include <minko/component/bullet/AbstractPhysicsShape.hpp>
+
+namespace minko
+{
+	namespace component
+	{
+		namespace bullet
+		{
+			// static concave shape, its bounding volume hierarchy is built when added to a world unless it was loaded with it
+			class TriangleMeshShape:
+				public AbstractPhysicsShape
+			{
+			public:
+				typedef std::shared_ptr<TriangleMeshShape> Ptr;
+
+			private:
+				std::vector<float>	_vertices;
+				std::vector<uint>	_indices;
+				std::string			_bvh;
+
+			public:
+				inline static
+				Ptr
+				create(const std::vector<float>& vertices, const std::vector<uint>& indices)
+				{
+					if (vertices.size() % 3 != 0)
+						throw std::invalid_argument("vertices");
+					if (indices.empty() || indices.size() % 3 != 0)
+						throw std::invalid_argument("indices");
+
+					return std::shared_ptr<TriangleMeshShape>(new TriangleMeshShape(vertices, indices));
+				}
+
+				// 3 floats per vertex
+				inline
+				const std::vector<float>&
+				vertices() const
+				{
+					return _vertices;
+				}
+
+				// 3 indices per triangle
+				inline
+				const std::vector<uint>&
+				indices() const
+				{
+					return _indices;
+				}
+
+				// serialized quantized BVH, see PhysicsExtension::serializeTriangleMeshBvh()
+				inline
+				const std::string&
+				bvh() const
+				{
+					return _bvh;
+				}
+
+				inline
+				void
+				bvh(const std::string& bvh)
+				{
+					_bvh = bvh;
+					shapeChanged()->execute(shared_from_this());
+				}
+
+				// triangle meshes can only be used for static colliders
+				inline
+				float
+				volume() const
+				{
+					return 0.f;
+				}
+
+			private:
+				TriangleMeshShape(const std::vector<float>& vertices, const std::vector<uint>& indices):
+					AbstractPhysicsShape(TRIANGLE_MESH),
+					_vertices(vertices),
+					_indices(indices),
+					_bvh()
+				{
+				}
+			};
+		}
+	}
+}
@@ -25,6 +25,14 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 namespace minko
 {
+	namespace component
+	{
+		namespace bullet
+		{
+			class TriangleMeshShape;
+		}
+	}
+
 	namespace extension
 	{
 		class PhysicsExtension :
@@ -47,6 +55,11 @@ namespace minko
 				return extention;
 			}
 
+			// build the quantized BVH of a triangle mesh shape so that it can be saved along with the scene
+			static
+			std::string
+			serializeTriangleMeshBvh(std::shared_ptr<component::bullet::TriangleMeshShape> shape);
+
 			static
 			std::shared_ptr<component::AbstractComponent>
 			deserializePhysics(std::string&								serializedAnimation,
@@ -29,6 +29,9 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include <minko/component/bullet/BoxShape.hpp>
 #include <minko/component/bullet/ConeShape.hpp>
 #include <minko/component/bullet/CylinderShape.hpp>
+#include <minko/component/bullet/TriangleMeshShape.hpp>
+#include <minko/component/bullet/HeightfieldShape.hpp>
+#include <BulletCollision/CollisionShapes/btHeightfieldTerrainShape.h>
 
 using namespace minko;
 using namespace minko::math;
@@ -37,10 +40,18 @@ using namespace minko::component;
 bullet::PhysicsWorld::BulletCollider::BulletCollider():
 	_bulletCollisionShape(nullptr),
 	_bulletMotionState(nullptr),
-	_bulletCollisionObject(nullptr)
+	_bulletCollisionObject(nullptr),
+	_previousWorldTransform(new btTransform(btTransform::getIdentity()))
 {
 }
 
+/*static*/
+std::shared_ptr<btCollisionShape>
+bullet::PhysicsWorld::BulletCollider::createCollisionShape(AbstractPhysicsShape::Ptr shape)
+{
+	return BulletCollider().initializeCollisionShape(shape);
+}
+
 std::shared_ptr<btRigidBody>
 bullet::PhysicsWorld::BulletCollider::rigidBody() const
 {
@@ -93,6 +104,14 @@ bullet::PhysicsWorld::BulletCollider::initializeCollisionShape(AbstractPhysicsSh
 		bulletShape = initializeCylinderShape(std::dynamic_pointer_cast<CylinderShape>(shape));
 		break;
 
+	case AbstractPhysicsShape::TRIANGLE_MESH:
+		bulletShape = initializeTriangleMeshShape(std::dynamic_pointer_cast<TriangleMeshShape>(shape));
+		break;
+
+	case AbstractPhysicsShape::HEIGHTFIELD:
+		bulletShape = initializeHeightfieldShape(std::dynamic_pointer_cast<HeightfieldShape>(shape));
+		break;
+
 	default:
 		throw std::logic_error("Unsupported physics shape");
 	}
@@ -136,6 +155,71 @@ bullet::PhysicsWorld::BulletCollider::initializeCylinderShape(CylinderShape::Ptr
 	return std::shared_ptr<btCylinderShape>(new btCylinderShape(halfExtents));
 }
 
+std::shared_ptr<btCollisionShape>
+bullet::PhysicsWorld::BulletCollider::initializeTriangleMeshShape(TriangleMeshShape::Ptr mesh) const
+{
+	// Bullet does not copy the triangles: the mesh interface points to the shape's own buffers
+	auto&	vertices		= const_cast<std::vector<float>&>(mesh->vertices());
+	auto&	indices			= const_cast<std::vector<uint>&>(mesh->indices());
+	auto	meshInterface	= std::make_shared<btTriangleIndexVertexArray>(
+		int(indices.size() / 3), reinterpret_cast<int*>(&indices[0]), int(3 * sizeof(uint)),
+		int(vertices.size() / 3), &vertices[0], int(3 * sizeof(float))
+	);
+
+	const auto&	serializedBvh	= mesh->bvh();
+	auto		bulletShape		= new btBvhTriangleMeshShape(meshInterface.get(), true, serializedBvh.empty());
+	void*		bvhBuffer		= nullptr;
+
+	if (!serializedBvh.empty())
+	{
+		// the BVH is deserialized in place, its buffer must be aligned and outlive the shape
+		bvhBuffer = btAlignedAlloc(serializedBvh.size(), 16);
+		std::memcpy(bvhBuffer, serializedBvh.data(), serializedBvh.size());
+
+		auto bvh = static_cast<btOptimizedBvh*>(btOptimizedBvh::deSerializeInPlace(bvhBuffer, serializedBvh.size(), false));
+
+		if (bvh == nullptr)
+		{
+			btAlignedFree(bvhBuffer);
+			bvhBuffer = nullptr;
+			bulletShape->buildOptimizedBvh();
+		}
+		else
+			bulletShape->setOptimizedBvh(bvh);
+	}
+
+	// the mesh interface and the BVH buffer are released with the shape
+	return std::shared_ptr<btBvhTriangleMeshShape>(bulletShape, [meshInterface, bvhBuffer](btBvhTriangleMeshShape* shape)
+	{
+		delete shape;
+
+		if (bvhBuffer)
+			btAlignedFree(bvhBuffer);
+	});
+}
+
+std::shared_ptr<btCollisionShape>
+bullet::PhysicsWorld::BulletCollider::initializeHeightfieldShape(HeightfieldShape::Ptr heightfield) const
+{
+	// Bullet does not copy the heights either, the shape owning them is released with the Bullet one
+	auto bulletShape = new btHeightfieldTerrainShape(
+		int(heightfield->width()),
+		int(heightfield->depth()),
+		&heightfield->heights()[0],
+		1.f,
+		heightfield->minHeight(),
+		heightfield->maxHeight(),
+		1,
+		PHY_FLOAT,
+		false
+	);
+
+	return std::shared_ptr<btHeightfieldTerrainShape>(bulletShape, [heightfield](btHeightfieldTerrainShape* shape)
+	{
+		delete shape;
+	});
+}
+
 std::shared_ptr<btMotionState>
 bullet::PhysicsWorld::BulletCollider::initializeMotionState(ColliderData::Ptr collider) const
 {
@@ -152,11 +236,14 @@ bullet::PhysicsWorld::BulletCollider::initializeCollisionObject(ColliderData::Pt
 {
 	// only rigid objects are considerered for the moment
 
+	// kinematic bodies have an infinite mass for the simulation
+	const float mass = data->kinematic() ? 0.0f : data->mass();
+
 	btVector3 inertia (0.0, 0.0, 0.0);
 	if (data->inertia() == nullptr)
 	{
-		if (data->mass() > 0.0f)
-			bulletCollisionShape->calculateLocalInertia(data->mass(), inertia);
+		if (mass > 0.0f)
+			bulletCollisionShape->calculateLocalInertia(mass, inertia);
 	}
 	else
 	{
@@ -167,7 +254,7 @@ bullet::PhysicsWorld::BulletCollider::initializeCollisionObject(ColliderData::Pt
 
 	// construction of a new rigid collision object
 	auto info = btRigidBody::btRigidBodyConstructionInfo(
-		data->mass(),
+		mass,
 		bulletMotionState.get(),
 		bulletCollisionShape.get(),
 		inertia
@@ -204,14 +291,18 @@ bullet::PhysicsWorld::BulletCollider::initializeCollisionObject(ColliderData::Pt
 		data->angularFactor()->z()
 		));
 
-	bulletRigidBody->setActivationState(data->deactivationDisabled() 
+	bulletRigidBody->setActivationState(data->deactivationDisabled() || data->kinematic()
 		? DISABLE_DEACTIVATION 
 		: ACTIVE_TAG
 	);
+	if (data->kinematic())
+		bulletRigidBody->setCollisionFlags(bulletRigidBody->getCollisionFlags() | btCollisionObject::CF_KINEMATIC_OBJECT);
 
 	_bulletCollisionShape	= bulletCollisionShape;
 	_bulletMotionState		= bulletMotionState;
 	_bulletCollisionObject	= bulletRigidBody;
+
+	savePreviousWorldTransform();
 }
 
 void
@@ -252,6 +343,21 @@ bullet::PhysicsWorld::BulletCollider::setWorldTransform(Matrix4x4::Ptr physicsNo
 	}
 }
 
+void
+bullet::PhysicsWorld::BulletCollider::savePreviousWorldTransform()
+{
+	*_previousWorldTransform = _bulletCollisionObject->getWorldTransform();
+}
+
+void
+bullet::PhysicsWorld::BulletCollider::interpolatedWorldTransform(float t, btTransform& output) const
+{
+	const btTransform& current = _bulletCollisionObject->getWorldTransform();
+
+	output.setOrigin(_previousWorldTransform->getOrigin().lerp(current.getOrigin(), t));
+	output.setRotation(_previousWorldTransform->getRotation().slerp(current.getRotation(), t));
+}
+
 void
 bullet::PhysicsWorld::BulletCollider::applyRelativeImpulse(Vector3::Ptr relativeImpulse)
 {
@@ -32,9 +32,6 @@ using namespace minko::math;
 using namespace minko::scene;
 using namespace minko::component;
 
-/*static*/
-Matrix4x4::Ptr bullet::Collider::_TMP_MATRIX = Matrix4x4::create();
-
 bullet::Collider::Collider(ColliderData::Ptr data):
 	AbstractComponent(),
 	_colliderData(data),
@@ -44,9 +41,9 @@ bullet::Collider::Collider(ColliderData::Ptr data):
 	_targetRemovedSlot(nullptr),
 	_addedSlot(nullptr),
 	_removedSlot(nullptr),
-	_graphicsTransformChangedSlot(nullptr),
 	_collisionStartedHandlerSlot(nullptr),
-	_collisionEndedHandlerSlot(nullptr)
+	_collisionEndedHandlerSlot(nullptr),
+	_tmpMatrix(Matrix4x4::create())
 {
 	if (data == nullptr)
 		throw std::invalid_argument("data");
@@ -68,13 +65,6 @@ bullet::Collider::initialize()
 		std::placeholders::_1,
 		std::placeholders::_2
 		));
-
-	_graphicsTransformChangedSlot	= _colliderData->graphicsWorldTransformChanged()->connect(std::bind(
-		&bullet::Collider::graphicsWorldTransformChangedHandler,
-		shared_from_this(),
-		std::placeholders::_1,
-		std::placeholders::_2
-		));
 }
 
 void
@@ -219,35 +209,16 @@ bullet::Collider::synchronizePhysicsWithGraphics()
 	// remove the scaling/shear from the graphics transform, but record it to restitute it during rendering
 	PhysicsWorld::removeScalingShear(
 		graphicsTransform, 
-		_TMP_MATRIX, 
+		_tmpMatrix, 
 		_colliderData->correction()
 	);
-	// _TMP_MATRIX = graphicsNoScaleTransform
+	// _tmpMatrix = graphicsNoScaleTransform
 
 #ifdef DEBUG_PHYSICS
 	std::cout << "[" << _colliderData->name() << "]\tsynchro graphics->physics" << std::endl;
 	PhysicsWorld::print(std::cout << "- correction =\n", _colliderData->correction()) << std::endl;
-	PhysicsWorld::print(std::cout << "- scalefree(graphics) =\n", _TMP_MATRIX) << std::endl;
+	PhysicsWorld::print(std::cout << "- scalefree(graphics) =\n", _tmpMatrix) << std::endl;
 #endif // DEBUG_PHYSICS
 
-	_physicsWorld->synchronizePhysicsWithGraphics(_colliderData, _TMP_MATRIX);
-}
-
-void
-bullet::Collider::graphicsWorldTransformChangedHandler(ColliderData::Ptr collider, 
-													   Matrix4x4::Ptr graphicsTransform)
-{
-	if (_targetTransform == nullptr)
-		return;
-
-	// get the world-to-parent matrix in order to update the target's Transform
-	_TMP_MATRIX
-		->copyFrom(_targetTransform->modelToWorldMatrix(true))
-		->invert()
-		->append(_targetTransform->matrix());
-	// _TMP_MATRIX = worldToParent
-
-	_targetTransform->matrix()
-		->copyFrom(graphicsTransform)
-		->append(_TMP_MATRIX);
+	_physicsWorld->synchronizePhysicsWithGraphics(_colliderData, _tmpMatrix);
 }
\ No newline at end of file
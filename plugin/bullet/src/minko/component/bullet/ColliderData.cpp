@@ -56,6 +56,7 @@ bullet::ColliderData::ColliderData(float						mass,
 	_friction(0.5f),
 	_rollingFriction(0.0f),
 	_deactivationDisabled(false),
+	_kinematic(false),
 	_graphicsWorldTransformChanged(Signal<Ptr, Matrix4x4Ptr>::create()),
 	_collisionStarted(Signal<Ptr, Ptr>::create()),
 	_collisionEnded(Signal<Ptr, Ptr>::create()),
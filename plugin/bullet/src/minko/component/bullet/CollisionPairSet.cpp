@@ -0,0 +1,161 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "CollisionPairSet.hpp"
+
+using namespace minko;
+using namespace component;
+
+bullet::CollisionPairSet::CollisionPairSet(uint initialCapacity):
+	_keys(),
+	_size(0),
+	_shift(32)
+{
+	uint capacity = 16;
+
+	while (capacity < initialCapacity)
+		capacity <<= 1;
+
+	rehash(capacity);
+}
+
+bool
+bullet::CollisionPairSet::contains(uint key) const
+{
+	const uint mask = _keys.size() - 1;
+
+	for (auto i = home(key); _keys[i] != EMPTY_KEY; i = (i + 1) & mask)
+		if (_keys[i] == key)
+			return true;
+
+	return false;
+}
+
+bool
+bullet::CollisionPairSet::insert(uint key)
+{
+	// keep the load factor under 1/2 so that probe sequences remain short
+	if ((_size + 1) << 1 > _keys.size())
+		rehash(_keys.size() << 1);
+
+	const uint	mask	= _keys.size() - 1;
+	auto		i		= home(key);
+
+	for (; _keys[i] != EMPTY_KEY; i = (i + 1) & mask)
+		if (_keys[i] == key)
+			return false;
+
+	_keys[i] = key;
+	++_size;
+
+	return true;
+}
+
+bool
+bullet::CollisionPairSet::erase(uint key)
+{
+	const uint	mask	= _keys.size() - 1;
+	auto		i		= home(key);
+
+	for (; _keys[i] != key; i = (i + 1) & mask)
+		if (_keys[i] == EMPTY_KEY)
+			return false;
+
+	_keys[i] = EMPTY_KEY;
+	--_size;
+
+	// shift back the following keys of the cluster that cannot be reached anymore from their home slot
+	for (auto j = (i + 1) & mask; _keys[j] != EMPTY_KEY; j = (j + 1) & mask)
+	{
+		const auto h = home(_keys[j]);
+
+		if ((j > i && (h <= i || h > j)) || (j < i && h <= i && h > j))
+		{
+			_keys[i] = _keys[j];
+			_keys[j] = EMPTY_KEY;
+			i = j;
+		}
+	}
+
+	return true;
+}
+
+void
+bullet::CollisionPairSet::eraseAll(uint uid)
+{
+	if (_size == 0)
+		return;
+
+	// erasing shifts keys backward, so a slot is only skipped once it no longer holds a matching key
+	for (uint i = 0; i < _keys.size(); )
+	{
+		const auto key = _keys[i];
+
+		if (key != EMPTY_KEY && (first(key) == uid || second(key) == uid))
+			erase(key);
+		else
+			++i;
+	}
+}
+
+void
+bullet::CollisionPairSet::clear()
+{
+	if (_size == 0)
+		return;
+
+	std::fill(_keys.begin(), _keys.end(), EMPTY_KEY);
+	_size = 0;
+}
+
+void
+bullet::CollisionPairSet::swap(CollisionPairSet& other)
+{
+	_keys.swap(other._keys);
+	std::swap(_size, other._size);
+	std::swap(_shift, other._shift);
+}
+
+void
+bullet::CollisionPairSet::rehash(uint capacity)
+{
+	std::vector<uint> keys(capacity, EMPTY_KEY);
+
+	keys.swap(_keys);
+
+	_shift = 32;
+	for (auto c = capacity; c > 1; c >>= 1)
+		--_shift;
+
+	const uint mask = capacity - 1;
+
+	for (auto key : keys)
+	{
+		if (key == EMPTY_KEY)
+			continue;
+
+		auto i = home(key);
+
+		while (_keys[i] != EMPTY_KEY)
+			i = (i + 1) & mask;
+
+		_keys[i] = key;
+	}
+}
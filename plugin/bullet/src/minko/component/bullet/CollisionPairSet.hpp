@@ -0,0 +1,122 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+	namespace component
+	{
+		namespace bullet
+		{
+			// flat open-addressing set of collision pairs, each pair packed as a 32-bit key made of two 16-bit uids
+			class CollisionPairSet
+			{
+			public:
+				typedef std::shared_ptr<CollisionPairSet> Ptr;
+
+				static const uint	EMPTY_KEY	= 0xffffffff;
+				static const uint	MAX_UID		= 0xffff;
+
+			private:
+				std::vector<uint>	_keys;
+				uint				_size;
+				uint				_shift;
+
+			public:
+				inline static
+				Ptr
+				create(uint initialCapacity = 64)
+				{
+					return std::shared_ptr<CollisionPairSet>(new CollisionPairSet(initialCapacity));
+				}
+
+				inline static
+				uint
+				key(uint uid1, uint uid2)
+				{
+					return uid1 < uid2 ? (uid1 << 16) | uid2 : (uid2 << 16) | uid1;
+				}
+
+				inline static
+				uint
+				first(uint key)
+				{
+					return key >> 16;
+				}
+
+				inline static
+				uint
+				second(uint key)
+				{
+					return key & MAX_UID;
+				}
+
+				inline
+				uint
+				size() const
+				{
+					return _size;
+				}
+
+				// the slots of the table, empty slots are set to EMPTY_KEY
+				inline
+				const std::vector<uint>&
+				slots() const
+				{
+					return _keys;
+				}
+
+				bool
+				contains(uint key) const;
+
+				bool
+				insert(uint key);
+
+				bool
+				erase(uint key);
+
+				void
+				eraseAll(uint uid);
+
+				void
+				clear();
+
+				void
+				swap(CollisionPairSet& other);
+
+			private:
+				CollisionPairSet(uint initialCapacity);
+
+				inline
+				uint
+				home(uint key) const
+				{
+					return (key * 2654435769u) >> _shift;
+				}
+
+				void
+				rehash(uint capacity);
+			};
+		}
+	}
+}
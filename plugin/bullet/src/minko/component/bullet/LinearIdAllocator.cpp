@@ -22,17 +22,36 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 using namespace minko;
 using namespace component;
 
-bullet::LinearIdAllocator::LinearIdAllocator(uint maxUid):
+bullet::LinearIdAllocator::LinearIdAllocator(uint maxUid, uint initialNumUids):
 	_uids(),
 	_uidToIndex(),
 	_numUsedUids(0),
 	_MAX_UID(maxUid)
 {
-	_uids.resize(_MAX_UID);
-	_uidToIndex.resize(_MAX_UID);
+	const uint numUids = std::min(initialNumUids, _MAX_UID);
 
-	for (uint i = 0; i < _MAX_UID; ++i)
-		_uids[i] = _uidToIndex[i] = i;
+	_uids.reserve(numUids);
+	_uidToIndex.reserve(numUids);
+
+	for (uint i = 0; i < numUids; ++i)
+	{
+		_uids.push_back(i);
+		_uidToIndex.push_back(i);
+	}
+}
+
+void
+bullet::LinearIdAllocator::grow()
+{
+	const uint numUids		= _uids.size();
+	const uint newNumUids	= std::min(_MAX_UID, std::max(1u, numUids << 1));
+
+	// all the existing ids are used, the new ones simply follow them
+	for (uint i = numUids; i < newNumUids; ++i)
+	{
+		_uids.push_back(i);
+		_uidToIndex.push_back(i);
+	}
 }
 
 uint
@@ -41,6 +60,9 @@ bullet::LinearIdAllocator::allocate()
 	if (_numUsedUids == _MAX_UID)
 		throw std::logic_error("failed to allocate a new unique id (max number of ids reached).");
 
+	if (_numUsedUids == _uids.size())
+		grow();
+
 	const uint ret = _uids[_numUsedUids];
 
 	++_numUsedUids;
@@ -51,7 +73,7 @@ bullet::LinearIdAllocator::allocate()
 void
 bullet::LinearIdAllocator::free(uint uid)
 {
-	if (uid > _MAX_UID || _uidToIndex[uid] >= _numUsedUids)
+	if (uid >= _uids.size() || _uidToIndex[uid] >= _numUsedUids)
 		throw std::invalid_argument("uid");
 
 	const unsigned int pos	= _uidToIndex[uid];
@@ -39,11 +39,19 @@ namespace minko
 				const uint			_MAX_UID;
 
 			public:
+				// ids are created on demand, doubling their number each time they are all used, up to maxUid
 				inline static
 				Ptr
-				create(uint maxUid = 2048)
+				create(uint maxUid = 2048, uint initialNumUids = 256)
 				{
-					return std::shared_ptr<LinearIdAllocator>(new LinearIdAllocator(maxUid));
+					return std::shared_ptr<LinearIdAllocator>(new LinearIdAllocator(maxUid, initialNumUids));
+				}
+
+				inline
+				uint
+				numUsedUids() const
+				{
+					return _numUsedUids;
 				}
 
 				uint
@@ -53,7 +61,10 @@ namespace minko
 				free(uint uid);
 
 			private:
-				LinearIdAllocator(uint maxUid);
+				LinearIdAllocator(uint maxUid, uint initialNumUids);
+
+				void
+				grow();
 			};
 		}
 	}
@@ -21,11 +21,15 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include <btBulletDynamicsCommon.h>
 #include <minko/math/Matrix4x4.hpp>
+#include <minko/async/Parallel.hpp>
 #include <minko/scene/Node.hpp>
 #include <minko/scene/NodeSet.hpp>
 #include <minko/component/SceneManager.hpp>
 #include <minko/component/Renderer.hpp>
+#include <minko/component/Transform.hpp>
+#include <minko/Profiler.hpp>
 #include <minko/component/bullet/LinearIdAllocator.hpp>
+#include <minko/component/bullet/CollisionPairSet.hpp>
 #include <minko/component/bullet/ColliderData.hpp>
 #include <minko/component/bullet/AbstractPhysicsShape.hpp>
 
@@ -35,31 +39,118 @@ using namespace minko::scene;
 using namespace minko::component;
 
 /*static*/
-const uint		bullet::PhysicsWorld::_MAX_BODIES	= 2048;
-/*static*/
-Matrix4x4::Ptr	bullet::PhysicsWorld::_TMP_MATRIX	= Matrix4x4::create();
-/*static*/
-btTransform		bullet::PhysicsWorld::_TMP_BTTRANSFORM;
+const uint		bullet::PhysicsWorld::_MAX_BODIES	= CollisionPairSet::MAX_UID;
+
+namespace
+{
+	typedef bullet::PhysicsWorld::RayQuery	RayQuery;
+	typedef bullet::PhysicsWorld::QueryHit	QueryHit;
+
+	// gathers the broadphase proxies passing the filter of a query, the traversal keeps its stack on the calling thread
+	struct CandidateCollector :
+		public btDbvt::ICollide
+	{
+		const RayQuery&						query;
+		std::vector<btCollisionObject*>&	candidates;
+
+		CandidateCollector(const RayQuery& query, std::vector<btCollisionObject*>& candidates) :
+			query(query),
+			candidates(candidates)
+		{
+		}
+
+		void
+		Process(const btDbvtNode* leaf)
+		{
+			auto proxy = static_cast<btBroadphaseProxy*>(leaf->data);
+
+			if ((proxy->m_collisionFilterGroup & query.mask) && (query.group & proxy->m_collisionFilterMask))
+				candidates.push_back(static_cast<btCollisionObject*>(proxy->m_clientObject));
+		}
+	};
+
+	inline
+	void
+	writeHit(QueryHit&			hit,
+			 uint				query,
+			 uint				collider,
+			 float				fraction,
+			 const btVector3&	point,
+			 const btVector3&	normal)
+	{
+		hit.query		= query;
+		hit.collider	= collider;
+		hit.fraction	= fraction;
+		hit.point[0]	= point.x();
+		hit.point[1]	= point.y();
+		hit.point[2]	= point.z();
+		hit.normal[0]	= normal.x();
+		hit.normal[1]	= normal.y();
+		hit.normal[2]	= normal.z();
+	}
+}
+
+bullet::PhysicsWorld::RayQuery::RayQuery(Vector3::Ptr from, Vector3::Ptr to, short group, short mask) :
+	group(group),
+	mask(mask)
+{
+	if (from == nullptr)
+		throw std::invalid_argument("from");
+	if (to == nullptr)
+		throw std::invalid_argument("to");
+
+	this->from[0]	= from->x();
+	this->from[1]	= from->y();
+	this->from[2]	= from->z();
+	this->to[0]		= to->x();
+	this->to[1]		= to->y();
+	this->to[2]		= to->z();
+}
 
-bullet::PhysicsWorld::PhysicsWorld():
+bullet::PhysicsWorld::PhysicsWorld(BroadphaseType	broadphaseType,
+								   Vector3::Ptr		worldAabbMin,
+								   Vector3::Ptr		worldAabbMax):
 	AbstractComponent(),
 	_uidAllocator(LinearIdAllocator::create(_MAX_BODIES)),
 	_colliderMap(),
 	_colliderReverseMap(),
 	_uidToCollider(),
-	_collisions(),
+	_collisions(CollisionPairSet::create()),
+	_currentCollisions(CollisionPairSet::create()),
+	_lostCollisions(),
+	_dynamicColliders(),
+	_dynamicBulletColliders(),
+	_dynamicTargets(),
+	_dynamicAtRest(),
+	_dynamicMatrices(),
+	_dynamicUpdated(),
+	_multithreaded(true),
+	_kinematicColliders(),
+	_kinematicTargets(),
+	_kinematicWorldMatrices(),
+	_kinematicTransform(Matrix4x4::create()),
+	_updatedColliders(),
+	_collidersUpdated(CollidersUpdatedSignal::create()),
 	_bulletBroadphase(nullptr),
 	_bulletCollisionConfiguration(nullptr),
 	_bulletConstraintSolver(nullptr),
 	_bulletDispatcher(nullptr),
 	_bulletDynamicsWorld(nullptr),
+	_broadphaseType(broadphaseType),
+	_worldAabbMin(worldAabbMin),
+	_worldAabbMax(worldAabbMax),
 	_targetAddedSlot(nullptr),
 	_targetRemovedSlot(nullptr),
 	_frameEndSlot(nullptr),
 	_componentAddedOrRemovedSlot(nullptr),
 	_addedOrRemovedSlot(nullptr),
     _colliderGroupChangedSlot(),
-    _colliderMaskChangedSlot()
+    _colliderMaskChangedSlot(),
+	_fixedTimeStep(1.f / 60.f),
+	_maxNumSubSteps(4),
+	_interpolate(true),
+	_accumulatedTime(0.f),
+	_tmpMatrix(Matrix4x4::create())
 {
 }
 
@@ -68,7 +159,17 @@ void
 bullet::PhysicsWorld::initialize()
 {
 	// straightforward physics world initialization for the time being
-	_bulletBroadphase				= std::shared_ptr<btDbvtBroadphase>(new btDbvtBroadphase());
+	if (_broadphaseType == AXIS_SWEEP)
+	{
+		// the 32-bit version is required to handle more than 16384 bodies
+		_bulletBroadphase			= std::shared_ptr<bt32BitAxisSweep3>(new bt32BitAxisSweep3(
+			btVector3(_worldAabbMin->x(), _worldAabbMin->y(), _worldAabbMin->z()),
+			btVector3(_worldAabbMax->x(), _worldAabbMax->y(), _worldAabbMax->z()),
+			_MAX_BODIES + 1
+		));
+	}
+	else
+		_bulletBroadphase			= std::shared_ptr<btDbvtBroadphase>(new btDbvtBroadphase());
 	_bulletCollisionConfiguration	= std::shared_ptr<btDefaultCollisionConfiguration>(new btDefaultCollisionConfiguration());
 	_bulletConstraintSolver			= std::shared_ptr<btSequentialImpulseConstraintSolver>(new btSequentialImpulseConstraintSolver());
 	_bulletDispatcher				= std::shared_ptr<btCollisionDispatcher>(new btCollisionDispatcher(_bulletCollisionConfiguration.get()));
@@ -118,6 +219,13 @@ bullet::PhysicsWorld::targetRemovedHandler(AbstractComponent::Ptr	controller,
 	_colliderMap.clear();
 	_colliderReverseMap.clear();
 	_uidToCollider.clear();
+	_dynamicColliders.clear();
+	_dynamicBulletColliders.clear();
+	_dynamicTargets.clear();
+	_dynamicAtRest.clear();
+	_kinematicColliders.clear();
+	_kinematicTargets.clear();
+	_kinematicWorldMatrices.clear();
 }
 
 void
@@ -138,8 +246,8 @@ bullet::PhysicsWorld::setSceneManager(std::shared_ptr<SceneManager> sceneManager
 		if (sceneManager)
 		{
 			_sceneManager = sceneManager;
-			_frameEndSlot = sceneManager->cullingBegin()->connect(std::bind(
-				&PhysicsWorld::frameEndHandler, shared_from_this(), std::placeholders::_1
+			_frameEndSlot = sceneManager->frameEnd()->connect(std::bind(
+				&PhysicsWorld::frameEndHandler, shared_from_this(), std::placeholders::_1, std::placeholders::_2, std::placeholders::_3
 			));
 
 			_componentAddedOrRemovedSlot = target->componentRemoved()->connect(componentCallback);
@@ -173,6 +281,21 @@ bullet::PhysicsWorld::addChild(ColliderData::Ptr data)
 	_colliderMap.insert(std::pair<ColliderData::Ptr, BulletCollider::Ptr>(data, bulletCollider));
 	_colliderReverseMap.insert(std::pair<btCollisionObject*, ColliderData::Ptr>(bulletCollider->rigidBody().get(), data));
 
+	if (data->kinematic())
+	{
+		_kinematicColliders.push_back(data);
+		_kinematicTargets.push_back(data->node()->component<Transform>());
+		// never a valid world matrix: the body is synchronized by the first step
+		_kinematicWorldMatrices.resize(_kinematicWorldMatrices.size() + 16, 0.f);
+	}
+	else if (!data->isStatic())
+	{
+		_dynamicColliders.push_back(data);
+		_dynamicBulletColliders.push_back(bulletCollider);
+		_dynamicTargets.push_back(data->node()->component<Transform>());
+		_dynamicAtRest.push_back(false);
+	}
+
 	_colliderGroupChangedSlot[data]	= data->node()->layoutsChanged()->connect([&](Node::Ptr, Node::Ptr){ updateCollisionFilter(data); });
     _colliderMaskChangedSlot[data]	= data->collisionFilterChanged()->connect([&](ColliderData::Ptr){ updateCollisionFilter(data); });
 
@@ -228,6 +351,42 @@ bullet::PhysicsWorld::removeChild(ColliderData::Ptr data)
 		_colliderMap.erase(bulletColliderIt);
 	}
 
+	auto dynamicIt = std::find(_dynamicColliders.begin(), _dynamicColliders.end(), data);
+	if (dynamicIt != _dynamicColliders.end())
+	{
+		const auto index	= dynamicIt - _dynamicColliders.begin();
+		const auto last		= _dynamicColliders.size() - 1;
+
+		_dynamicColliders[index]		= _dynamicColliders[last];
+		_dynamicBulletColliders[index]	= _dynamicBulletColliders[last];
+		_dynamicTargets[index]			= _dynamicTargets[last];
+		_dynamicAtRest[index]			= _dynamicAtRest[last];
+
+		_dynamicColliders.pop_back();
+		_dynamicBulletColliders.pop_back();
+		_dynamicTargets.pop_back();
+		_dynamicAtRest.pop_back();
+	}
+
+	auto kinematicIt = std::find(_kinematicColliders.begin(), _kinematicColliders.end(), data);
+	if (kinematicIt != _kinematicColliders.end())
+	{
+		const auto index	= kinematicIt - _kinematicColliders.begin();
+		const auto last		= _kinematicColliders.size() - 1;
+
+		_kinematicColliders[index]	= _kinematicColliders[last];
+		_kinematicTargets[index]	= _kinematicTargets[last];
+		std::copy(
+			_kinematicWorldMatrices.begin() + (last << 4),
+			_kinematicWorldMatrices.begin() + ((last + 1) << 4),
+			_kinematicWorldMatrices.begin() + (index << 4)
+		);
+
+		_kinematicColliders.pop_back();
+		_kinematicTargets.pop_back();
+		_kinematicWorldMatrices.resize(last << 4);
+	}
+
 	auto uidIt = _uidToCollider.find(data->uid());
 	if (uidIt != _uidToCollider.end())
 	{
@@ -235,13 +394,8 @@ bullet::PhysicsWorld::removeChild(ColliderData::Ptr data)
 		_uidToCollider.erase(uidIt);
 	}
 
-	// remove all current collision pairs the collider appears in (warning: it is an ordered set, remove_if won't work).
-	for (auto collisionIt = _collisions.begin(); collisionIt != _collisions.end(); )
-		if (collisionIt->first == data->uid() ||
-			collisionIt->second == data->uid())
-			collisionIt = _collisions.erase(collisionIt);
-		else
-			++collisionIt;
+	// remove all current collision pairs the collider appears in
+	_collisions->eraseAll(data->uid());
 }
 
 bool
@@ -250,6 +404,13 @@ bullet::PhysicsWorld::hasCollider(ColliderData::Ptr data) const
 	return _colliderMap.find(data) != _colliderMap.end();
 }
 
+bullet::ColliderData::Ptr
+bullet::PhysicsWorld::collider(uint uid) const
+{
+	auto colliderIt = _uidToCollider.find(uid);
+
+	return colliderIt != _uidToCollider.end() ? colliderIt->second : nullptr;
+}
 
 void
 bullet::PhysicsWorld::setGravity(Vector3::Ptr gravity)
@@ -258,48 +419,195 @@ bullet::PhysicsWorld::setGravity(Vector3::Ptr gravity)
 }
 
 void
-bullet::PhysicsWorld::frameEndHandler(std::shared_ptr<SceneManager> sceneManager)
+bullet::PhysicsWorld::frameEndHandler(std::shared_ptr<SceneManager> sceneManager, float time, float deltaTime)
 {
-	update();
+	// frame durations are given in milliseconds
+	step(deltaTime * 1e-3f);
 }
 
 void
 bullet::PhysicsWorld::update(float timeStep)
 {
-	_bulletDynamicsWorld->stepSimulation(timeStep);
+	MINKO_PROFILE_SCOPE("PhysicsWorld::update");
+
+	synchronizeKinematicColliders();
+	savePreviousWorldTransforms();
+	_bulletDynamicsWorld->stepSimulation(timeStep, 0);
 	updateColliders();
 	notifyCollisions();
 }
 
 void
-bullet::PhysicsWorld::updateColliders()
+bullet::PhysicsWorld::step(float elapsedTime)
+{
+	MINKO_PROFILE_SCOPE("PhysicsWorld::step");
+
+	// the time that cannot be simulated within _maxNumSubSteps is dropped: a slow frame
+	// slows the simulation down instead of making the next frames even slower
+	_accumulatedTime = std::min(
+		_accumulatedTime + std::max(0.f, elapsedTime),
+		_fixedTimeStep * _maxNumSubSteps
+	);
+
+	const uint numSubSteps = std::min(_maxNumSubSteps, uint(_accumulatedTime / _fixedTimeStep));
+
+	if (numSubSteps)
+		synchronizeKinematicColliders();
+
+	for (uint i = 0; i < numSubSteps; ++i)
+	{
+		// only the state preceding the last substep is needed for interpolation
+		if (i == numSubSteps - 1)
+			savePreviousWorldTransforms();
+
+		_bulletDynamicsWorld->stepSimulation(_fixedTimeStep, 0);
+	}
+
+	_accumulatedTime = std::max(0.f, _accumulatedTime - numSubSteps * _fixedTimeStep);
+
+	// render the state lagging by at most one step to blend between the last two states
+	updateColliders(_interpolate ? _accumulatedTime / _fixedTimeStep : 1.f);
+
+	if (numSubSteps)
+		notifyCollisions();
+}
+
+void
+bullet::PhysicsWorld::savePreviousWorldTransforms()
+{
+	for (auto& bulletCollider : _dynamicBulletColliders)
+		if (bulletCollider->rigidBody()->isActive())
+			bulletCollider->savePreviousWorldTransform();
+}
+
+void
+bullet::PhysicsWorld::synchronizeKinematicColliders()
 {
-	for (ColliderMap::iterator it = _colliderMap.begin(); it != _colliderMap.end(); ++it)
+	for (uint i = 0; i < _kinematicColliders.size(); ++i)
 	{
-		ColliderData::Ptr	collider(it->first);
-		if (collider->isStatic())
+		const auto& target = _kinematicTargets[i];
+
+		if (target == nullptr || target->targets().empty())
 			continue;
 
-		fromBulletTransform(
-			it->second->rigidBody()->getWorldTransform(),
-			_TMP_MATRIX
-		);
-		// _TMP_MATRIX = physicsTransform
+		// the world matrices computed by the last frame, unchanged for most of the bodies
+		const float*	modelToWorld	= &target->modelToWorldMatrix(false)->data()[0];
+		float*			previous		= &_kinematicWorldMatrices[i << 4];
+
+		if (std::equal(modelToWorld, modelToWorld + 16, previous))
+			continue;
+
+		std::copy(modelToWorld, modelToWorld + 16, previous);
 
-		_TMP_MATRIX
-			->prepend(collider->shape()->deltaTransformInverse())
-			->prepend(collider->correction());
-		// _TMP_MATRIX = graphicsTransform = physicsTransform * deltaInverse * correction
+		const auto& collider = _kinematicColliders[i];
 
-		collider->graphicsWorldTransformChanged()
-			->execute(collider, _TMP_MATRIX);
+		removeScalingShear(target->modelToWorldMatrix(false), _kinematicTransform, collider->correction());
+		synchronizePhysicsWithGraphics(collider, _kinematicTransform);
 	}
 }
 
+void
+bullet::PhysicsWorld::updateColliders(float interpolationFactor)
+{
+	const uint numColliders = _dynamicColliders.size();
+
+	_dynamicMatrices.resize(numColliders << 5);
+	_dynamicUpdated.resize(numColliders);
+	_updatedColliders.clear();
+
+#if defined(EMSCRIPTEN)
+	const uint numWorkers = 1;
+#else
+	const uint numWorkers = !_multithreaded || numColliders < PARALLEL_SYNC_MIN_NUM_BODIES
+		? 1
+		: std::max(1u, std::thread::hardware_concurrency());
+#endif
+
+	// the workers only read the bodies, the transforms and the colliders
+	async::runInParallel(numColliders, numWorkers, [&](uint begin, uint end, uint worker)
+	{
+		for (auto i = begin; i < end; ++i)
+			_dynamicUpdated[i] = computeColliderMatrices(i, interpolationFactor);
+	});
+
+	for (uint i = 0; i < numColliders; ++i)
+	{
+		if (!_dynamicUpdated[i])
+			continue;
+
+		const auto& collider	= _dynamicColliders[i];
+		const auto& target		= _dynamicTargets[i];
+		const float* matrices	= &_dynamicMatrices[i << 5];
+
+		if (target != nullptr && !target->targets().empty())
+			target->matrix()->setRaw(matrices + 16);
+
+		if (collider->graphicsWorldTransformChanged()->numCallbacks())
+			collider->graphicsWorldTransformChanged()->execute(collider, _tmpMatrix->setRaw(matrices));
+
+		_updatedColliders.push_back(collider);
+	}
+
+	if (!_updatedColliders.empty())
+		_collidersUpdated->execute(shared_from_this(), _updatedColliders);
+}
+
+bool
+bullet::PhysicsWorld::computeColliderMatrices(uint index, float interpolationFactor)
+{
+	const auto& bulletCollider	= _dynamicBulletColliders[index];
+	const auto& rigidBody		= bulletCollider->rigidBody();
+	btTransform	physicsTransform;
+
+	// a sleeping body does not move: it is synchronized once with its final state, then skipped
+	if (rigidBody->isActive())
+	{
+		_dynamicAtRest[index] = false;
+
+		if (interpolationFactor < 1.f)
+			bulletCollider->interpolatedWorldTransform(interpolationFactor, physicsTransform);
+		else
+			physicsTransform = rigidBody->getWorldTransform();
+	}
+	else if (!_dynamicAtRest[index])
+	{
+		_dynamicAtRest[index] = true;
+		physicsTransform = rigidBody->getWorldTransform();
+	}
+	else
+		return false;
+
+	const auto& collider	= _dynamicColliders[index];
+	float*		graphics	= &_dynamicMatrices[index << 5];
+	float*		local		= graphics + 16;
+
+	fromBulletTransform(physicsTransform, graphics);
+	// graphics = physicsTransform
+
+	Matrix4x4::multiply(&collider->shape()->deltaTransformInverse()->data()[0], graphics, graphics);
+	Matrix4x4::multiply(&collider->correction()->data()[0], graphics, graphics);
+	// graphics = graphicsTransform = physicsTransform * deltaInverse * correction
+
+	const auto& target = _dynamicTargets[index];
+	if (target != nullptr && !target->targets().empty())
+	{
+		// the world matrices computed by the last frame are used as is: forcing the update
+		// of the whole hierarchy for each body would cost more than the simulation itself
+		float worldToParent[16];
+
+		Matrix4x4::invert(&target->modelToWorldMatrix(false)->data()[0], worldToParent);
+		Matrix4x4::multiply(worldToParent, &target->matrix()->data()[0], worldToParent);
+		// worldToParent = modelToWorld^-1 * local
+
+		Matrix4x4::multiply(graphics, worldToParent, local);
+	}
+
+	return true;
+}
+
 void
 bullet::PhysicsWorld::notifyCollisions()
 {
-	CollisionSet		currentCollisions;
 	ColliderData::Ptr	colliderData[2]	= { nullptr, nullptr };
 	const int			numManifolds	= _bulletDynamicsWorld->getDispatcher()->getNumManifolds();
 
@@ -323,38 +631,33 @@ bullet::PhysicsWorld::notifyCollisions()
 			continue;
 		
 		// a collision exists between to valid colliders
-		auto collision = std::make_pair(colliderData[0]->uid(),  colliderData[1]->uid());
+		const auto collision = CollisionPairSet::key(colliderData[0]->uid(), colliderData[1]->uid());
 
-		if (collision.first > collision.second)
-			std::swap(collision.first, collision.second);
+		if (!_currentCollisions->insert(collision))
+			continue;
 
-		if (_collisions.find(collision) == _collisions.end())
+		if (!_collisions->contains(collision))
 		{
 			colliderData[0]->collisionStarted()->execute(colliderData[0], colliderData[1]);
 			colliderData[1]->collisionStarted()->execute(colliderData[1], colliderData[0]);
 		}
-
-		currentCollisions.insert(collision);
 	}
 
-	// find and notify collisions that are not present anymore as the difference with the intersection
-	// between the previous collision set and the current one.
+	// find the collisions that are not present anymore before notifying them, since the
+	// callbacks might remove colliders from the world.
+	_lostCollisions.clear();
+	for (auto collision : _collisions->slots())
+		if (collision != CollisionPairSet::EMPTY_KEY && !_currentCollisions->contains(collision))
+			_lostCollisions.push_back(collision);
 
-	CollisionSet lostCollisions;
-	std::set_difference(
-		_collisions.begin(), _collisions.end(), 
-		currentCollisions.begin(), currentCollisions.end(), 
-		std::inserter(lostCollisions, lostCollisions.end())
-	);
-
-	for (auto& collision : lostCollisions)
+	for (auto collision : _lostCollisions)
 	{
-		auto colliderDataIt = _uidToCollider.find(collision.first);
+		auto colliderDataIt = _uidToCollider.find(CollisionPairSet::first(collision));
 		colliderData[0]		= colliderDataIt != _uidToCollider.end()
 			? colliderDataIt->second
 			: nullptr;
 
-		colliderDataIt		= _uidToCollider.find(collision.second);
+		colliderDataIt		= _uidToCollider.find(CollisionPairSet::second(collision));
 		colliderData[1]		= colliderDataIt != _uidToCollider.end()
 			? colliderDataIt->second
 			: nullptr;
@@ -367,7 +670,239 @@ bullet::PhysicsWorld::notifyCollisions()
 		colliderData[1]->collisionEnded()->execute(colliderData[1], colliderData[0]);
 	}
 	
-	_collisions.swap(currentCollisions);
+	_collisions->swap(*_currentCollisions);
+	_currentCollisions->clear();
+}
+
+uint
+bullet::PhysicsWorld::runQueries(uint numQueries, std::vector<QueryHit>& hits, const QueryFunction& query)
+{
+	hits.clear();
+
+#if defined(EMSCRIPTEN)
+	const uint numWorkers = 1;
+#else
+	const uint numWorkers = !_multithreaded || numQueries < PARALLEL_MIN_NUM_QUERIES || _broadphaseType != DBVT
+		? 1
+		: std::max(1u, std::thread::hardware_concurrency());
+#endif
+
+	if (numWorkers == 1)
+	{
+		for (uint i = 0; i < numQueries; ++i)
+			query(i, hits);
+
+		return hits.size();
+	}
+
+	// the ranges of the workers are contiguous: appending their hits in order keeps them sorted by query
+	std::vector<std::vector<QueryHit>> workerHits(numWorkers);
+
+	async::runInParallel(numQueries, numWorkers, [&](uint begin, uint end, uint worker)
+	{
+		for (auto i = begin; i < end; ++i)
+			query(i, workerHits[worker]);
+	});
+
+	for (auto& h : workerHits)
+		hits.insert(hits.end(), h.begin(), h.end());
+
+	return hits.size();
+}
+
+void
+bullet::PhysicsWorld::collectCandidates(const RayQuery& query, std::vector<btCollisionObject*>& candidates) const
+{
+	auto broadphase = std::static_pointer_cast<btDbvtBroadphase>(_bulletBroadphase);
+	CandidateCollector collector(query, candidates);
+	const btVector3	from(query.from[0], query.from[1], query.from[2]);
+	const btVector3	to(query.to[0], query.to[1], query.to[2]);
+
+	candidates.clear();
+	// the static version of rayTest allocates its own stack, unlike the one of the broadphase
+	btDbvt::rayTest(broadphase->m_sets[0].m_root, from, to, collector);
+	btDbvt::rayTest(broadphase->m_sets[1].m_root, from, to, collector);
+}
+
+void
+bullet::PhysicsWorld::collectCandidates(const RayQuery&					query,
+										const btVector3&				aabbMin,
+										const btVector3&				aabbMax,
+										std::vector<btCollisionObject*>&	candidates) const
+{
+	auto broadphase = std::static_pointer_cast<btDbvtBroadphase>(_bulletBroadphase);
+	CandidateCollector collector(query, candidates);
+	const auto volume = btDbvtVolume::FromMM(aabbMin, aabbMax);
+
+	candidates.clear();
+	broadphase->m_sets[0].collideTV(broadphase->m_sets[0].m_root, volume, collector);
+	broadphase->m_sets[1].collideTV(broadphase->m_sets[1].m_root, volume, collector);
+}
+
+uint
+bullet::PhysicsWorld::raycast(const std::vector<RayQuery>& queries, std::vector<QueryHit>& hits)
+{
+	MINKO_PROFILE_SCOPE("PhysicsWorld::raycast");
+
+	return runQueries(queries.size(), hits, [&](uint i, std::vector<QueryHit>& output)
+	{
+		const auto&		query	= queries[i];
+		const btVector3	from(query.from[0], query.from[1], query.from[2]);
+		const btVector3	to(query.to[0], query.to[1], query.to[2]);
+		const btTransform fromTransform(btQuaternion::getIdentity(), from);
+		const btTransform toTransform(btQuaternion::getIdentity(), to);
+
+		btCollisionWorld::ClosestRayResultCallback callback(from, to);
+
+		callback.m_collisionFilterGroup	= query.group;
+		callback.m_collisionFilterMask	= query.mask;
+
+		if (_broadphaseType == DBVT)
+		{
+			std::vector<btCollisionObject*> candidates;
+
+			collectCandidates(query, candidates);
+			for (auto object : candidates)
+				btCollisionWorld::rayTestSingle(
+					fromTransform, toTransform, object, object->getCollisionShape(), object->getWorldTransform(), callback
+				);
+		}
+		else
+			_bulletDynamicsWorld->rayTest(from, to, callback);
+
+		if (!callback.hasHit())
+			return;
+
+		auto colliderIt = _colliderReverseMap.find(callback.m_collisionObject);
+		if (colliderIt == _colliderReverseMap.end())
+			return;
+
+		output.emplace_back();
+		writeHit(
+			output.back(), i, colliderIt->second->uid(),
+			callback.m_closestHitFraction, callback.m_hitPointWorld, callback.m_hitNormalWorld
+		);
+	});
+}
+
+uint
+bullet::PhysicsWorld::rayTestAll(const std::vector<RayQuery>& queries, std::vector<QueryHit>& hits, uint maxHitsPerQuery)
+{
+	MINKO_PROFILE_SCOPE("PhysicsWorld::rayTestAll");
+
+	return runQueries(queries.size(), hits, [&](uint i, std::vector<QueryHit>& output)
+	{
+		const auto&		query	= queries[i];
+		const btVector3	from(query.from[0], query.from[1], query.from[2]);
+		const btVector3	to(query.to[0], query.to[1], query.to[2]);
+		const btTransform fromTransform(btQuaternion::getIdentity(), from);
+		const btTransform toTransform(btQuaternion::getIdentity(), to);
+
+		btCollisionWorld::AllHitsRayResultCallback callback(from, to);
+
+		callback.m_collisionFilterGroup	= query.group;
+		callback.m_collisionFilterMask	= query.mask;
+
+		if (_broadphaseType == DBVT)
+		{
+			std::vector<btCollisionObject*> candidates;
+
+			collectCandidates(query, candidates);
+			for (auto object : candidates)
+				btCollisionWorld::rayTestSingle(
+					fromTransform, toTransform, object, object->getCollisionShape(), object->getWorldTransform(), callback
+				);
+		}
+		else
+			_bulletDynamicsWorld->rayTest(from, to, callback);
+
+		const auto begin = output.size();
+
+		for (int j = 0; j < callback.m_collisionObjects.size(); ++j)
+		{
+			auto colliderIt = _colliderReverseMap.find(callback.m_collisionObjects[j]);
+			if (colliderIt == _colliderReverseMap.end())
+				continue;
+
+			output.emplace_back();
+			writeHit(
+				output.back(), i, colliderIt->second->uid(),
+				callback.m_hitFractions[j], callback.m_hitPointWorld[j], callback.m_hitNormalWorld[j]
+			);
+		}
+
+		std::sort(output.begin() + begin, output.end(), [](const QueryHit& a, const QueryHit& b)
+		{
+			return a.fraction < b.fraction;
+		});
+
+		if (maxHitsPerQuery != 0 && output.size() - begin > maxHitsPerQuery)
+			output.resize(begin + maxHitsPerQuery);
+	});
+}
+
+uint
+bullet::PhysicsWorld::convexSweep(AbstractPhysicsShape::Ptr		shape,
+								  const std::vector<RayQuery>&	queries,
+								  std::vector<QueryHit>&		hits)
+{
+	MINKO_PROFILE_SCOPE("PhysicsWorld::convexSweep");
+
+	auto bulletShape = BulletCollider::createCollisionShape(shape);
+
+	if (!bulletShape->isConvex())
+		throw std::invalid_argument("shape");
+
+	auto castShape = static_cast<const btConvexShape*>(bulletShape.get());
+
+	return runQueries(queries.size(), hits, [&](uint i, std::vector<QueryHit>& output)
+	{
+		const auto&		query	= queries[i];
+		const btVector3	from(query.from[0], query.from[1], query.from[2]);
+		const btVector3	to(query.to[0], query.to[1], query.to[2]);
+		const btTransform fromTransform(btQuaternion::getIdentity(), from);
+		const btTransform toTransform(btQuaternion::getIdentity(), to);
+
+		btCollisionWorld::ClosestConvexResultCallback callback(from, to);
+
+		callback.m_collisionFilterGroup	= query.group;
+		callback.m_collisionFilterMask	= query.mask;
+
+		if (_broadphaseType == DBVT)
+		{
+			std::vector<btCollisionObject*> candidates;
+			btVector3 fromMin, fromMax, toMin, toMax;
+
+			// the bounds of the shape at both ends of the segment enclose the whole sweep
+			castShape->getAabb(fromTransform, fromMin, fromMax);
+			castShape->getAabb(toTransform, toMin, toMax);
+			fromMin.setMin(toMin);
+			fromMax.setMax(toMax);
+
+			collectCandidates(query, fromMin, fromMax, candidates);
+			for (auto object : candidates)
+				btCollisionWorld::objectQuerySingle(
+					castShape, fromTransform, toTransform,
+					object, object->getCollisionShape(), object->getWorldTransform(),
+					callback, 0.f
+				);
+		}
+		else
+			_bulletDynamicsWorld->convexSweepTest(castShape, fromTransform, toTransform, callback);
+
+		if (!callback.hasHit())
+			return;
+
+		auto colliderIt = _colliderReverseMap.find(callback.m_hitCollisionObject);
+		if (colliderIt == _colliderReverseMap.end())
+			return;
+
+		output.emplace_back();
+		writeHit(
+			output.back(), i, colliderIt->second->uid(),
+			callback.m_closestHitFraction, callback.m_hitPointWorld, callback.m_hitNormalWorld
+		);
+	});
 }
 
 void
@@ -389,14 +924,14 @@ bullet::PhysicsWorld::synchronizePhysicsWithGraphics(ColliderDataPtr collider,
 	if (bulletMotionState == nullptr)
 		return;
 
-	_TMP_MATRIX
+	_tmpMatrix
 		->copyFrom(graphicsNoScaleTransform)->invert()
 		->append(collider->shape()->deltaTransform())
 		->append(graphicsNoScaleTransform)
 		->invert();
 
 	toBulletTransform(
-		_TMP_MATRIX, 
+		_tmpMatrix, 
 		bulletMotionState->m_centerOfMassOffset
 	);
 
@@ -407,8 +942,12 @@ bullet::PhysicsWorld::synchronizePhysicsWithGraphics(ColliderDataPtr collider,
 	);
 
 	// synchronize bullet
-	bulletMotionState->getWorldTransform(_TMP_BTTRANSFORM);
-	it->second->rigidBody()->setWorldTransform(_TMP_BTTRANSFORM);
+	btTransform worldTransform;
+
+	bulletMotionState->getWorldTransform(worldTransform);
+	it->second->rigidBody()->setWorldTransform(worldTransform);
+	// a teleported body must not be interpolated from its former location
+	it->second->savePreviousWorldTransform();
 
 #ifdef DEBUG_PHYSICS
 	std::cout << "[" << it->first->name() << "] synchro graphics -> physics" << std::endl;
@@ -435,8 +974,9 @@ bullet::PhysicsWorld::removeScalingShear(Matrix4x4::Ptr input,
 {
 	auto translation	= input->translation();
 
-	// remove translational component, then perform QR decomposition
-	_TMP_MATRIX
+	// remove translational component, then perform QR decomposition; no shared temporary matrix since
+	// the physics worlds of different threads can call it at the same time
+	auto matrix			= Matrix4x4::create()
 		->copyFrom(input)
 		->appendTranslation(-(*translation));
 
@@ -445,7 +985,7 @@ bullet::PhysicsWorld::removeScalingShear(Matrix4x4::Ptr input,
 	if (correction == nullptr)
 		correction = Matrix4x4::create();
 
-	_TMP_MATRIX->decomposeQR(output, correction);
+	matrix->decomposeQR(output, correction);
 
 	return output->appendTranslation(translation);
 }
@@ -469,6 +1009,27 @@ bullet::PhysicsWorld::fromBulletTransform(const btTransform& transform,
 		);
 }
 
+/*static*/
+void
+bullet::PhysicsWorld::fromBulletTransform(const btTransform& transform, float* output)
+{
+	const auto& basis		= transform.getBasis();
+	const auto& translation	= transform.getOrigin();
+
+	for (uint i = 0; i < 3; ++i)
+	{
+		output[(i << 2)]		= basis[i][0];
+		output[(i << 2) + 1]	= basis[i][1];
+		output[(i << 2) + 2]	= basis[i][2];
+		output[(i << 2) + 3]	= translation[i];
+	}
+
+	output[12] = 0.f;
+	output[13] = 0.f;
+	output[14] = 0.f;
+	output[15] = 1.f;
+}
+
 /*static*/
 void
 bullet::PhysicsWorld::toBulletTransform(Matrix4x4::Ptr transform,
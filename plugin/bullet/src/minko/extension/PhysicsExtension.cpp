@@ -28,12 +28,15 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/component/bullet/BoxShape.hpp"
 #include "minko/component/bullet/ConeShape.hpp"
 #include "minko/component/bullet/CylinderShape.hpp"
+#include "minko/component/bullet/TriangleMeshShape.hpp"
 #include "minko/deserialize/TypeDeserializer.hpp"
 #include "minko/math/Matrix4x4.hpp"
 #include "minko/Any.hpp"
 #include "minko/component/bullet/ColliderData.hpp"
 #include "minko/component/bullet/Collider.hpp"
 
+#include <btBulletDynamicsCommon.h>
+
 using namespace minko;
 using namespace minko::extension;
 
@@ -64,6 +67,25 @@ PhysicsExtension::deserializePhysics(std::string&							serializedAnimation,
 
 	uint shapeType = dst.a0;
 
+	if (shapeType == 5) // Mesh
+	{
+		// same fields followed by the vertices, the indices and the serialized BVH
+		msgpack::type::tuple<int, std::string, msgpack::type::tuple<uint, std::string>, float, float, float, bool, bool, uint, uint,
+			msgpack::type::tuple<std::string, std::string, std::string>> meshDst;
+
+		deserialized.convert(&meshDst);
+
+		auto mesh = component::bullet::TriangleMeshShape::create(
+			deserialize::TypeDeserializer::deserializeVector<float>(meshDst.a10.a0),
+			deserialize::TypeDeserializer::deserializeVector<uint>(meshDst.a10.a1)
+		);
+
+		if (!meshDst.a10.a2.empty())
+			mesh->bvh(meshDst.a10.a2);
+
+		deserializedShape = mesh;
+	}
+
 	if (shapeType == 1) // Ball
 		deserializedShape = component::bullet::SphereShape::create(shapedata[0]);
 	else if (shapeType == 2) // Box
@@ -99,4 +121,30 @@ PhysicsExtension::deserializePhysics(std::string&							serializedAnimation,
     data->collisionMask(filterMask);
 
 	return component::bullet::Collider::create(data);
-}
\ No newline at end of file
+}
+
+std::string
+PhysicsExtension::serializeTriangleMeshBvh(std::shared_ptr<component::bullet::TriangleMeshShape> shape)
+{
+	auto&	vertices	= const_cast<std::vector<float>&>(shape->vertices());
+	auto&	indices		= const_cast<std::vector<uint>&>(shape->indices());
+
+	btTriangleIndexVertexArray	meshInterface(
+		int(indices.size() / 3), reinterpret_cast<int*>(&indices[0]), int(3 * sizeof(uint)),
+		int(vertices.size() / 3), &vertices[0], int(3 * sizeof(float))
+	);
+	btBvhTriangleMeshShape		bulletShape(&meshInterface, true, true);
+
+	auto		bvh		= bulletShape.getOptimizedBvh();
+	const auto	size	= bvh->calculateSerializeBufferSize();
+	void*		buffer	= btAlignedAlloc(size, 16);
+
+	// little endian, as expected by the BulletCollider when deserializing it in place
+	bvh->serialize(buffer, size, false);
+
+	std::string serialized(static_cast<const char*>(buffer), size);
+
+	btAlignedFree(buffer);
+
+	return serialized;
+}
@@ -0,0 +1,76 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+	namespace file
+	{
+		// persistent copies of downloaded files, with the validators (ETag, Last-Modified) sent by the server
+		class HTTPCache
+		{
+		public:
+			typedef std::shared_ptr<HTTPCache>	Ptr;
+
+		private:
+			std::string	_directory;
+
+		public:
+			inline static
+			Ptr
+			create(const std::string& directory)
+			{
+				return std::shared_ptr<HTTPCache>(new HTTPCache(directory));
+			}
+
+			inline
+			const std::string&
+			directory() const
+			{
+				return _directory;
+			}
+
+			// false when url is not in the cache
+			bool
+			validators(const std::string& url, std::string& etag, std::string& lastModified) const;
+
+			bool
+			load(const std::string& url, std::vector<unsigned char>& data) const;
+
+			void
+			store(const std::string&	url,
+				  const char*			data,
+				  uint					size,
+				  const std::string&	etag,
+				  const std::string&	lastModified);
+
+			void
+			remove(const std::string& url);
+
+		private:
+			HTTPCache(const std::string& directory);
+
+			std::string
+			filename(const std::string& url) const;
+		};
+	}
+}
@@ -22,6 +22,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/Common.hpp"
 #include "minko/file/AbstractLoader.hpp"
 #include "minko/Any.hpp"
+#include "minko/file/HTTPCache.hpp"
 
 #include <stdarg.h>  
 
@@ -43,6 +44,32 @@ namespace minko
 				return std::shared_ptr<HTTPLoader>(new HTTPLoader());
 			}
 
+			// when set, downloaded files are kept on disk and revalidated with the server instead of downloaded again
+			inline static
+			std::shared_ptr<HTTPCache>
+			cache()
+			{
+				return _cache;
+			}
+
+			inline static
+			void
+			cache(std::shared_ptr<HTTPCache> cache)
+			{
+				_cache = cache;
+			}
+
+			// only loads size bytes from offset, size 0 loads the whole file
+			inline
+			Ptr
+			range(uint offset, uint size)
+			{
+				_rangeOffset = offset;
+				_rangeSize = size;
+
+				return std::static_pointer_cast<HTTPLoader>(shared_from_this());
+			}
+
 			void
 			load(const std::string& filename, std::shared_ptr<Options> options);
 
@@ -69,12 +96,22 @@ namespace minko
 			_workerSlots;
 
 			static
-			std::list<std::shared_ptr<HTTPLoader>>
+			std::unordered_map<void*, std::shared_ptr<HTTPLoader>>
 			_runningLoaders;
 
 			static uint
 			_uid;
 
+			static
+			std::shared_ptr<HTTPCache>
+			_cache;
+
+			uint
+			_rangeOffset;
+
+			uint
+			_rangeSize;
+
 #if !defined(EMSCRIPTEN)
 			static size_t
 			curlWriteMemoryHandler(void*, size_t, size_t, void*);
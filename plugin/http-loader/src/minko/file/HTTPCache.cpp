@@ -0,0 +1,133 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/file/HTTPCache.hpp"
+
+#include <fstream>
+#include <cstdio>
+#include <sys/stat.h>
+
+#if defined(_WIN32)
+# include <direct.h>
+#endif
+
+using namespace minko;
+using namespace minko::file;
+
+HTTPCache::HTTPCache(const std::string& directory) :
+	_directory(directory)
+{
+	if (directory.empty())
+		throw std::invalid_argument("directory");
+
+#if defined(_WIN32)
+	_mkdir(directory.c_str());
+#else
+	mkdir(directory.c_str(), 0755);
+#endif
+}
+
+std::string
+HTTPCache::filename(const std::string& url) const
+{
+	// FNV-1a
+	uint64_t hash = 14695981039346656037ull;
+
+	for (auto c : url)
+		hash = (hash ^ (unsigned char)c) * 1099511628211ull;
+
+	char name[17];
+
+	std::snprintf(name, sizeof(name), "%016llx", (unsigned long long)hash);
+
+	return _directory + "/" + name;
+}
+
+bool
+HTTPCache::validators(const std::string& url, std::string& etag, std::string& lastModified) const
+{
+	std::ifstream meta(filename(url) + ".meta");
+	std::string cachedUrl;
+
+	// the url is stored too, to tell hash collisions apart
+	if (!std::getline(meta, cachedUrl) || cachedUrl != url)
+		return false;
+
+	std::getline(meta, etag);
+	std::getline(meta, lastModified);
+
+	return true;
+}
+
+bool
+HTTPCache::load(const std::string& url, std::vector<unsigned char>& data) const
+{
+	std::string etag;
+	std::string lastModified;
+
+	if (!validators(url, etag, lastModified))
+		return false;
+
+	std::ifstream file(filename(url) + ".data", std::ios::in | std::ios::ate | std::ios::binary);
+
+	if (!file.is_open())
+		return false;
+
+	auto size = (uint)file.tellg();
+
+	data.resize(size);
+	file.seekg(0, std::ios::beg);
+	if (size)
+		file.read((char*)&data[0], size);
+
+	return file.good();
+}
+
+void
+HTTPCache::store(const std::string&	url,
+				 const char*		data,
+				 uint				size,
+				 const std::string&	etag,
+				 const std::string&	lastModified)
+{
+	auto name = filename(url);
+
+	// the meta file is written last: an interrupted write leaves the entry missing, not corrupted
+	std::remove((name + ".meta").c_str());
+
+	std::ofstream file(name + ".data", std::ios::out | std::ios::trunc | std::ios::binary);
+
+	file.write(data, size);
+	file.close();
+	if (!file)
+		return;
+
+	std::ofstream meta(name + ".meta", std::ios::out | std::ios::trunc);
+
+	meta << url << '\n' << etag << '\n' << lastModified << '\n';
+}
+
+void
+HTTPCache::remove(const std::string& url)
+{
+	auto name = filename(url);
+
+	std::remove((name + ".meta").c_str());
+	std::remove((name + ".data").c_str());
+}
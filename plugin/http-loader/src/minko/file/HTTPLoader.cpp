@@ -26,20 +26,25 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #if defined(EMSCRIPTEN)
 # include "emscripten/emscripten.h"
 #else
-# include "minko/async/HTTPWorker.hpp"
+# include "minko/async/HTTPClient.hpp"
 #endif
 
 using namespace minko;
 using namespace minko::file;
 using namespace minko::async;
 
-std::list<std::shared_ptr<HTTPLoader>>
+std::unordered_map<void*, std::shared_ptr<HTTPLoader>>
 HTTPLoader::_runningLoaders;
 
 uint
 HTTPLoader::_uid = 0;
 
-HTTPLoader::HTTPLoader()
+std::shared_ptr<HTTPCache>
+HTTPLoader::_cache;
+
+HTTPLoader::HTTPLoader() :
+	_rangeOffset(0),
+	_rangeSize(0)
 {
 }
 
@@ -47,11 +52,7 @@ void
 HTTPLoader::progressHandler(void* arg, int progress)
 {
 	std::cout << "HTTPLoader::progressHandler(): " << progress << std::endl;
-	auto iterator = std::find_if(HTTPLoader::_runningLoaders.begin(),
-								 HTTPLoader::_runningLoaders.end(),
-								 [=](std::shared_ptr<HTTPLoader> loader) -> bool {
-		return loader.get() == arg;
-	});
+	auto iterator = HTTPLoader::_runningLoaders.find(arg);
 
 	if (iterator == HTTPLoader::_runningLoaders.end())
 	{
@@ -59,7 +60,7 @@ HTTPLoader::progressHandler(void* arg, int progress)
 		return;
 	}
 	std::cout << "HTTPLoader::progressHandler(): found loader " << format("%d", progress) << "%"  << std::endl;
-	std::shared_ptr<HTTPLoader> loader = *iterator;
+	std::shared_ptr<HTTPLoader> loader = iterator->second;
 
 	loader->_progress->execute(loader, float(progress) / 100.0f);
 }
@@ -68,11 +69,7 @@ void
 HTTPLoader::completeHandler(void* arg, void* data, int size)
 {
 	std::cout << "HTTPLoader::completeHandler(): size: " << size << std::endl;
-	auto iterator = std::find_if(HTTPLoader::_runningLoaders.begin(),
-								 HTTPLoader::_runningLoaders.end(),
-								 [=](std::shared_ptr<HTTPLoader> loader) -> bool {
-		return loader.get() == arg;
-	});
+	auto iterator = HTTPLoader::_runningLoaders.find(arg);
 
 	if (iterator == HTTPLoader::_runningLoaders.end())
 	{
@@ -81,17 +78,18 @@ HTTPLoader::completeHandler(void* arg, void* data, int size)
 	}
 
 	std::cout << "HTTPLoader::completeHandler(): found loader" << std::endl;
-	std::shared_ptr<HTTPLoader> loader = *iterator;
+	std::shared_ptr<HTTPLoader> loader = iterator->second;
 
 	std::cout << "HTTPLoader::completeHandler(): set data" << std::endl;
 	loader->_data.assign(static_cast<unsigned char*>(data), static_cast<unsigned char*>(data) + size);
 
+	loader->_chunk->execute(loader, 0, size);
 	loader->_progress->execute(loader, 1.0);
 	std::cout << "HTTPLoader::completeHandler(): call execute" << std::endl;
 	loader->_complete->execute(loader);
 
 	std::cout << "HTTPLoader::completeHandler(): remove loader" << std::endl;
-	// HTTPLoader::_runningLoaders.remove(loader);
+	HTTPLoader::_runningLoaders.erase(arg);
 	std::cout << "HTTPLoader::completeHandler(): complete" << std::endl;
 }
 
@@ -99,11 +97,7 @@ void
 HTTPLoader::errorHandler(void* arg)
 {
 	std::cout << "HTTPLoader::errorHandler(): " << std::endl;
-	auto iterator = std::find_if(HTTPLoader::_runningLoaders.begin(),
-								 HTTPLoader::_runningLoaders.end(),
-								 [=](std::shared_ptr<HTTPLoader> loader) -> bool {
-		return loader.get() == arg;
-	});
+	auto iterator = HTTPLoader::_runningLoaders.find(arg);
 
 	if (iterator == HTTPLoader::_runningLoaders.end())
 	{
@@ -112,13 +106,13 @@ HTTPLoader::errorHandler(void* arg)
 	}
 
 	std::cout << "HTTPLoader::errorHandler(): found loader" << std::endl;
-	std::shared_ptr<HTTPLoader> loader = *iterator;
+	std::shared_ptr<HTTPLoader> loader = iterator->second;
 
 	std::cout << "HTTPLoader::errorHandler(): call execute" << std::endl;
 	loader->_error->execute(loader);
 
 	std::cout << "HTTPLoader::completeHandler(): remove loader" << std::endl;
-	// HTTPLoader::_runningLoaders.remove(loader);
+	HTTPLoader::_runningLoaders.erase(arg);
 	std::cout << "HTTPLoader::errorHandler(): complete" << std::endl;
 }
 
@@ -150,7 +144,7 @@ HTTPLoader::load(const std::string& filename, std::shared_ptr<Options> options)
 	
 	auto loader = shared_from_this();
 
-	_runningLoaders.push_back(std::static_pointer_cast<HTTPLoader>(loader));
+	_runningLoaders[loader.get()] = std::static_pointer_cast<HTTPLoader>(loader);
 
 	loader->progress()->execute(loader, 0.0);
 
@@ -162,24 +156,73 @@ HTTPLoader::load(const std::string& filename, std::shared_ptr<Options> options)
 	std::cout << "HTTPLoader::load(): " << "call emscripten_async_wget_data " << std::endl;
 	emscripten_async_wget_data(_filename.c_str(), loader.get(), &completeHandler, &errorHandler);
 #else
-	/*if (options->loadAsynchronously())
-	{*/
-		auto worker = AbstractCanvas::defaultCanvas()->getWorker("http");
+	auto arg			= loader.get();
+	auto url			= _resolvedFilename;
+	auto cache			= _cache;
+	auto rangeOffset	= _rangeOffset;
+	auto rangeSize		= _rangeSize;
+	auto cached			= false;
+	std::string etag;
+	std::string lastModified;
+	HTTPClient::Headers headers;
+
+	if (cache)
+		cached = cache->validators(url, etag, lastModified);
+
+	// ranges of cached files are served from the cache once the whole file is validated
+	if (cached)
+	{
+		if (!etag.empty())
+			headers["If-None-Match"] = etag;
+		if (!lastModified.empty())
+			headers["If-Modified-Since"] = lastModified;
+	}
+	else if (rangeSize != 0)
+		headers["Range"] = "bytes=" + std::to_string(rangeOffset) + "-" + std::to_string(rangeOffset + rangeSize - 1);
 
-		_workerSlots.push_back(worker->complete()->connect([=](Worker::MessagePtr data) {
-			completeHandler(loader.get(), &*data->begin(), data->size());
-		}));
+	HTTPClient::instance()->request(
+		url,
+		[=](float ratio) { progressHandler(arg, int(ratio * 100)); },
+		[=](const std::vector<char>& body, long status, const HTTPClient::Headers& responseHeaders)
+		{
+			std::vector<unsigned char> cachedData;
+			auto data = body.data();
+			uint size = body.size();
 
-		_workerSlots.push_back(worker->progress()->connect([=](float ratio) {
-			progressHandler(loader.get(), ratio * 100);
-		}));
+			if (status == 304)
+			{
+				if (!cached || !cache->load(url, cachedData))
+				{
+					errorHandler(arg);
+					return;
+				}
+
+				data = reinterpret_cast<const char*>(cachedData.data());
+				size = cachedData.size();
+			}
+			else if (cache && status == 200 && (responseHeaders.count("etag") || responseHeaders.count("last-modified")))
+				cache->store(
+					url,
+					data,
+					size,
+					responseHeaders.count("etag") ? responseHeaders.at("etag") : "",
+					responseHeaders.count("last-modified") ? responseHeaders.at("last-modified") : ""
+				);
+
+			// whole file, from the cache or from a server ignoring the range
+			if (rangeSize != 0 && status != 206)
+			{
+				auto offset = std::min(rangeOffset, size);
 
-		worker->input(std::make_shared<std::vector<char>>(_resolvedFilename.begin(), _resolvedFilename.end()));
-	/*}
-	else
-	{
-		//fixme: handle synchronous HTTP loading
-	}*/
+				data += offset;
+				size = std::min(rangeSize, size - offset);
+			}
+
+			completeHandler(arg, const_cast<char*>(data), size);
+		},
+		[=](const std::string& error) { errorHandler(arg); },
+		headers
+	);
 #endif
 }
 
@@ -0,0 +1,166 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+namespace minko
+{
+	namespace async
+	{
+		// single cURL multi handle shared by all the HTTP requests: transfers run concurrently on one thread
+		// and reuse the pooled connections, callbacks are executed on the main thread by the thread pool
+		class HTTPClient
+		{
+		public:
+			typedef std::shared_ptr<HTTPClient>						Ptr;
+
+			// header names are lower case
+			typedef std::map<std::string, std::string>				Headers;
+
+			typedef std::function<void(float)>						ProgressHandler;
+			typedef std::function<void(const std::vector<char>&, long, const Headers&)>	CompleteHandler;
+			typedef std::function<void(const std::string&)>			ErrorHandler;
+
+			static const uint DEFAULT_MAX_CONCURRENT_REQUESTS;
+
+		private:
+			struct Request :
+				public std::enable_shared_from_this<Request>
+			{
+				HTTPClient*				client;
+				uint					id;
+				std::string				url;
+				std::vector<char>		data;
+				Headers					headers;
+				Headers					responseHeaders;
+				float					progress;
+				std::atomic<bool>		cancelled;
+				bool					finished;
+				ProgressHandler			progressHandler;
+				CompleteHandler			completeHandler;
+				ErrorHandler			errorHandler;
+				void*					handle;
+				void*					headerList;
+			};
+
+			typedef std::shared_ptr<Request>	RequestPtr;
+
+		private:
+			std::shared_ptr<ThreadPool>					_dispatcher;
+			std::atomic<uint>							_maxConcurrentRequests;
+
+			void*										_multi;
+			std::vector<void*>							_idleHandles;
+			std::unordered_map<void*, RequestPtr>		_running;
+
+			std::mutex									_mutex;
+			std::condition_variable						_wakeUp;
+			std::list<RequestPtr>						_waiting;
+			std::unordered_map<uint, RequestPtr>		_requests;
+			uint										_nextId;
+			std::atomic<uint>							_numRequests;
+			std::atomic<bool>							_stopping;
+			std::thread									_thread;
+
+		public:
+			// client shared by the HTTP loaders, dispatching on the thread pool of the default canvas
+			static
+			Ptr
+			instance();
+
+			inline static
+			Ptr
+			create(std::shared_ptr<ThreadPool> dispatcher, uint maxConcurrentRequests = DEFAULT_MAX_CONCURRENT_REQUESTS)
+			{
+				return std::shared_ptr<HTTPClient>(new HTTPClient(dispatcher, maxConcurrentRequests));
+			}
+
+			~HTTPClient();
+
+			inline
+			uint
+			maxConcurrentRequests() const
+			{
+				return _maxConcurrentRequests;
+			}
+
+			void
+			maxConcurrentRequests(uint value);
+
+			// waiting and running requests
+			inline
+			uint
+			numRequests() const
+			{
+				return _numRequests;
+			}
+
+			// the completion handler receives the body, the status code and the headers of the response
+			uint
+			request(const std::string&	url,
+					ProgressHandler		progress,
+					CompleteHandler		complete,
+					ErrorHandler		error,
+					const Headers&		headers = Headers());
+
+			// neither the completion nor the error handler of a cancelled request is executed
+			void
+			cancel(uint requestId);
+
+		private:
+			HTTPClient(std::shared_ptr<ThreadPool> dispatcher, uint maxConcurrentRequests);
+
+			void
+			transferLoop();
+
+			void
+			startWaitingRequests();
+
+			void
+			removeCancelledRequests();
+
+			void
+			finishRequest(void* handle, bool succeeded, const std::string& error);
+
+			void
+			recycle(void* handle);
+
+			void
+			dispatch(std::function<void()> callback);
+
+			static
+			size_t
+			curlWriteHandler(void* data, size_t size, size_t chunks, void* arg);
+
+			static
+			size_t
+			curlHeaderHandler(void* data, size_t size, size_t chunks, void* arg);
+
+			static
+			int
+			curlProgressHandler(void* arg, double total, double current, double, double);
+		};
+	}
+}
@@ -0,0 +1,401 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/async/HTTPClient.hpp"
+
+#include "minko/AbstractCanvas.hpp"
+#include "minko/async/ThreadPool.hpp"
+
+#if defined(EMSCRIPTEN)
+# error "HTTPClient should not be used in HTML5"
+#endif
+
+#include "curl/curl.h"
+
+using namespace minko;
+using namespace minko::async;
+
+const uint HTTPClient::DEFAULT_MAX_CONCURRENT_REQUESTS = 16;
+
+HTTPClient::HTTPClient(std::shared_ptr<ThreadPool> dispatcher, uint maxConcurrentRequests) :
+	_dispatcher(dispatcher),
+	_maxConcurrentRequests(maxConcurrentRequests),
+	_multi(nullptr),
+	_nextId(0),
+	_numRequests(0),
+	_stopping(false)
+{
+	if (!dispatcher)
+		throw std::invalid_argument("dispatcher");
+	if (maxConcurrentRequests == 0)
+		throw std::invalid_argument("maxConcurrentRequests");
+
+	curl_global_init(CURL_GLOBAL_DEFAULT);
+
+	_multi = curl_multi_init();
+	if (!_multi)
+		throw std::runtime_error("cURL not enabled");
+
+	curl_multi_setopt(_multi, CURLMOPT_MAX_HOST_CONNECTIONS, (long)maxConcurrentRequests);
+#if LIBCURL_VERSION_NUM >= 0x072b00
+	curl_multi_setopt(_multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+#endif
+
+	_thread = std::thread(&HTTPClient::transferLoop, this);
+}
+
+HTTPClient::~HTTPClient()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		_stopping = true;
+	}
+	_wakeUp.notify_all();
+	_thread.join();
+
+	for (auto& running : _running)
+	{
+		curl_multi_remove_handle(_multi, running.first);
+		curl_easy_cleanup(running.first);
+		curl_slist_free_all(static_cast<curl_slist*>(running.second->headerList));
+	}
+	for (auto handle : _idleHandles)
+		curl_easy_cleanup(handle);
+
+	curl_multi_cleanup(_multi);
+	curl_global_cleanup();
+}
+
+HTTPClient::Ptr
+HTTPClient::instance()
+{
+	static Ptr client;
+
+	if (!client)
+	{
+		auto canvas = AbstractCanvas::defaultCanvas();
+
+		if (!canvas)
+			throw std::logic_error("HTTPClient::instance() requires a default canvas.");
+
+		client = create(canvas->threadPool());
+	}
+
+	return client;
+}
+
+void
+HTTPClient::maxConcurrentRequests(uint value)
+{
+	if (value == 0)
+		throw std::invalid_argument("value");
+
+	_maxConcurrentRequests = value;
+	_wakeUp.notify_all();
+}
+
+uint
+HTTPClient::request(const std::string&	url,
+					ProgressHandler		progress,
+					CompleteHandler		complete,
+					ErrorHandler		error,
+					const Headers&		headers)
+{
+	auto request = std::make_shared<Request>();
+
+	request->client				= this;
+	request->url				= url;
+	request->headers			= headers;
+	request->progress			= 0.f;
+	request->cancelled			= false;
+	request->finished			= false;
+	request->progressHandler	= progress;
+	request->completeHandler	= complete;
+	request->errorHandler		= error;
+	request->handle				= nullptr;
+	request->headerList			= nullptr;
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		request->id = _nextId++;
+		_requests[request->id] = request;
+		_waiting.push_back(request);
+		++_numRequests;
+	}
+	_wakeUp.notify_all();
+
+	return request->id;
+}
+
+void
+HTTPClient::cancel(uint requestId)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	auto request = _requests.find(requestId);
+
+	if (request != _requests.end())
+		request->second->cancelled = true;
+}
+
+void
+HTTPClient::transferLoop()
+{
+	while (!_stopping)
+	{
+		removeCancelledRequests();
+		startWaitingRequests();
+
+		if (_running.empty())
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+
+			_wakeUp.wait(lock, [this]() { return _stopping || !_waiting.empty(); });
+
+			continue;
+		}
+
+		int numRunning = 0;
+		int numMessages = 0;
+		int numFds = 0;
+
+		curl_multi_perform(_multi, &numRunning);
+
+		while (auto message = curl_multi_info_read(_multi, &numMessages))
+			if (message->msg == CURLMSG_DONE)
+				finishRequest(
+					message->easy_handle,
+					message->data.result == CURLE_OK,
+					curl_easy_strerror(message->data.result)
+				);
+
+		// returns as soon as a socket is ready, the timeout lets new and cancelled requests in
+		curl_multi_wait(_multi, nullptr, 0, 50, &numFds);
+	}
+}
+
+void
+HTTPClient::startWaitingRequests()
+{
+	std::list<RequestPtr> started;
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		while (!_waiting.empty() && _running.size() + started.size() < _maxConcurrentRequests)
+		{
+			auto request = _waiting.front();
+
+			_waiting.pop_front();
+			if (request->cancelled)
+			{
+				_requests.erase(request->id);
+				--_numRequests;
+			}
+			else
+				started.push_back(request);
+		}
+	}
+
+	for (auto& request : started)
+	{
+		CURL* handle = nullptr;
+
+		// reusing the easy handles keeps their DNS cache and SSL session ids
+		if (_idleHandles.empty())
+			handle = curl_easy_init();
+		else
+		{
+			handle = _idleHandles.back();
+			_idleHandles.pop_back();
+			curl_easy_reset(handle);
+		}
+
+		curl_easy_setopt(handle, CURLOPT_URL, request->url.c_str());
+		curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, &curlWriteHandler);
+		curl_easy_setopt(handle, CURLOPT_WRITEDATA, request.get());
+		curl_easy_setopt(handle, CURLOPT_HEADERFUNCTION, &curlHeaderHandler);
+		curl_easy_setopt(handle, CURLOPT_WRITEHEADER, request.get());
+		curl_easy_setopt(handle, CURLOPT_NOPROGRESS, 0L);
+		curl_easy_setopt(handle, CURLOPT_PROGRESSFUNCTION, &curlProgressHandler);
+		curl_easy_setopt(handle, CURLOPT_PROGRESSDATA, request.get());
+		curl_easy_setopt(handle, CURLOPT_FOLLOWLOCATION, 1L);
+		curl_easy_setopt(handle, CURLOPT_FAILONERROR, 1L);
+		curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+		curl_easy_setopt(handle, CURLOPT_SSL_VERIFYPEER, 0L);
+		curl_easy_setopt(handle, CURLOPT_USERAGENT, "libcurl-agent/1.0");
+#if LIBCURL_VERSION_NUM >= 0x072b00
+		curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2_0);
+		curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L);
+#endif
+
+		curl_slist* headerList = nullptr;
+
+		for (auto& header : request->headers)
+			headerList = curl_slist_append(headerList, (header.first + ": " + header.second).c_str());
+		if (headerList)
+			curl_easy_setopt(handle, CURLOPT_HTTPHEADER, headerList);
+
+		request->headerList = headerList;
+		request->handle = handle;
+		_running[handle] = request;
+		curl_multi_add_handle(_multi, handle);
+	}
+}
+
+void
+HTTPClient::removeCancelledRequests()
+{
+	std::vector<void*> cancelled;
+
+	for (auto& running : _running)
+		if (running.second->cancelled)
+			cancelled.push_back(running.first);
+
+	for (auto handle : cancelled)
+	{
+		auto request = _running[handle];
+
+		_running.erase(handle);
+		recycle(handle);
+		curl_slist_free_all(static_cast<curl_slist*>(request->headerList));
+
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		_requests.erase(request->id);
+		--_numRequests;
+	}
+}
+
+void
+HTTPClient::finishRequest(void* handle, bool succeeded, const std::string& error)
+{
+	auto request = _running[handle];
+	long status = 0;
+
+	curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &status);
+
+	_running.erase(handle);
+	recycle(handle);
+	curl_slist_free_all(static_cast<curl_slist*>(request->headerList));
+	request->headerList = nullptr;
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		_requests.erase(request->id);
+		--_numRequests;
+	}
+
+	dispatch([=]()
+	{
+		if (request->cancelled)
+			return;
+
+		request->finished = true;
+		if (succeeded)
+		{
+			if (request->progressHandler)
+				request->progressHandler(1.f);
+			if (request->completeHandler)
+				request->completeHandler(request->data, status, request->responseHeaders);
+		}
+		else if (request->errorHandler)
+			request->errorHandler(error);
+	});
+}
+
+void
+HTTPClient::recycle(void* handle)
+{
+	curl_multi_remove_handle(_multi, handle);
+	_idleHandles.push_back(handle);
+}
+
+void
+HTTPClient::dispatch(std::function<void()> callback)
+{
+	// the empty task completes right away: the callback is executed by ThreadPool::update() on the main thread
+	_dispatcher->run([]() { }, callback);
+}
+
+size_t
+HTTPClient::curlWriteHandler(void* data, size_t size, size_t chunks, void* arg)
+{
+	auto request = static_cast<Request*>(arg);
+	auto source = static_cast<char*>(data);
+
+	size *= chunks;
+	request->data.insert(request->data.end(), source, source + size);
+
+	return request->cancelled ? 0 : size;
+}
+
+size_t
+HTTPClient::curlHeaderHandler(void* data, size_t size, size_t chunks, void* arg)
+{
+	auto request = static_cast<Request*>(arg);
+	auto line = std::string(static_cast<char*>(data), size * chunks);
+	auto separator = line.find(':');
+
+	// a status line starts a new response, after a redirection for example
+	if (line.compare(0, 5, "HTTP/") == 0)
+		request->responseHeaders.clear();
+	else if (separator != std::string::npos)
+	{
+		auto name = line.substr(0, separator);
+		auto value = line.substr(separator + 1);
+		auto begin = value.find_first_not_of(" \t");
+		auto end = value.find_last_not_of(" \t\r\n");
+
+		std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+		request->responseHeaders[name] = begin == std::string::npos ? "" : value.substr(begin, end - begin + 1);
+	}
+
+	return size * chunks;
+}
+
+int
+HTTPClient::curlProgressHandler(void* arg, double total, double current, double, double)
+{
+	auto request = static_cast<Request*>(arg);
+
+	if (total <= 0. || request->cancelled || !request->progressHandler)
+		return 0;
+
+	auto progress = float(current / total);
+
+	// at most one callback per percent
+	if (progress - request->progress < .01f)
+		return 0;
+
+	auto that = request->shared_from_this();
+
+	request->progress = progress;
+	request->client->dispatch([=]()
+	{
+		// the dispatched callbacks can complete out of order
+		if (!that->cancelled && !that->finished)
+			that->progressHandler(progress);
+	});
+
+	return 0;
+}
@@ -34,6 +34,8 @@ namespace minko
 		public:
 			typedef std::shared_ptr<JPEGParser> Ptr;
 
+			static const uint MAX_DECODING_SCALE = 8;
+
 		public:
 			inline static
 			Ptr
@@ -42,6 +44,18 @@ namespace minko
 				return std::shared_ptr<JPEGParser>(new JPEGParser());
 			}
 
+			inline
+			bool
+			decodesAsynchronously() const
+			{
+				return true;
+			}
+
+			void
+			decode(const std::string&					filename,
+				   std::shared_ptr<Options>				options,
+				   const std::vector<unsigned char>&	data);
+
 			void
 			parse(const std::string&				filename,
 				  const std::string&                resolvedFilename,
@@ -50,7 +64,20 @@ namespace minko
 				  std::shared_ptr<AssetLibrary>	AssetLibrary);
 
 		private:
-			JPEGParser()
+			std::vector<unsigned char>	_pixels;
+			uint						_width;
+			uint						_height;
+			bool						_decoded;
+			bool						_valid;
+			uint						_numComponents;
+
+		private:
+			JPEGParser() :
+				_width(0),
+				_height(0),
+				_decoded(false),
+				_valid(false),
+				_numComponents(0)
 			{
 			}
 		};
@@ -29,6 +29,101 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 using namespace minko;
 using namespace minko::file;
 
+void
+JPEGParser::decode(const std::string&					filename,
+				   std::shared_ptr<Options>				options,
+				   const std::vector<unsigned char>&	data)
+{
+	_decoded = true;
+	_valid = false;
+
+	if (data.empty())
+		return;
+
+	jpgd::jpeg_decoder_mem_stream	stream(&data[0], data.size());
+	jpgd::jpeg_decoder				decoder(&stream);
+
+	if (decoder.get_error_code() != jpgd::JPGD_SUCCESS || decoder.begin_decoding() != jpgd::JPGD_SUCCESS)
+		return;
+
+	// scan lines are either 8 bits luminance or 32 bits RGBA
+	const uint width			= decoder.get_width();
+	const uint height			= decoder.get_height();
+	const uint bytesPerPixel	= decoder.get_bytes_per_pixel();
+	const uint maxSize			= options->maxTextureSize();
+	uint scale					= 1;
+
+	// images too large for maxTextureSize() are reduced by 1/2, 1/4 or 1/8 while the scan lines are read
+	while (maxSize != 0 && scale < MAX_DECODING_SCALE && std::max(width, height) > maxSize * scale)
+		scale <<= 1;
+
+	_width = (width + scale - 1) / scale;
+	_height = (height + scale - 1) / scale;
+	_numComponents = decoder.get_num_components();
+	_pixels.resize(_width * _height * 4);
+
+	std::vector<uint> sums(scale == 1 ? 0 : _width * 3, 0);
+
+	for (uint y = 0; y < height; ++y)
+	{
+		const unsigned char*	scanLine	= nullptr;
+		uint					scanLineSize = 0;
+
+		if (decoder.decode((const void**)&scanLine, &scanLineSize) != jpgd::JPGD_SUCCESS)
+		{
+			std::vector<unsigned char>().swap(_pixels);
+
+			return;
+		}
+
+		if (scale == 1)
+		{
+			auto dst = &_pixels[y * _width * 4];
+
+			if (bytesPerPixel == 4)
+				std::memcpy(dst, scanLine, width * 4);
+			else
+				for (uint x = 0; x < width; ++x, dst += 4)
+				{
+					dst[0] = dst[1] = dst[2] = scanLine[x];
+					dst[3] = 255;
+				}
+
+			continue;
+		}
+
+		for (uint x = 0; x < width; ++x)
+		{
+			auto sum = &sums[(x / scale) * 3];
+			auto src = &scanLine[x * bytesPerPixel];
+
+			sum[0] += src[0];
+			sum[1] += src[bytesPerPixel == 4 ? 1 : 0];
+			sum[2] += src[bytesPerPixel == 4 ? 2 : 0];
+		}
+
+		// each output row averages the blocks of the last scale rows (fewer at the bottom)
+		if ((y + 1) % scale != 0 && y + 1 != height)
+			continue;
+
+		const uint	numRows	= y % scale + 1;
+		auto		dst		= &_pixels[(y / scale) * _width * 4];
+
+		for (uint x = 0; x < _width; ++x, dst += 4)
+		{
+			const uint numPixels = numRows * std::min(scale, width - x * scale);
+
+			dst[0] = sums[x * 3] / numPixels;
+			dst[1] = sums[x * 3 + 1] / numPixels;
+			dst[2] = sums[x * 3 + 2] / numPixels;
+			dst[3] = 255;
+		}
+		std::fill(sums.begin(), sums.end(), 0);
+	}
+
+	_valid = true;
+}
+
 void
 JPEGParser::parse(const std::string&				filename,
 				  const std::string&                resolvedFilename,
@@ -36,29 +131,19 @@ JPEGParser::parse(const std::string&				filename,
 				  const std::vector<unsigned char>&	data,
 				  std::shared_ptr<AssetLibrary>	AssetLibrary)
 {
-	int width;
-	int height;
-	int comps;
-
-	// Loads a JPEG image from a memory buffer.
-	// req_comps can be 1 (grayscale), 3 (RGB), or 4 (RGBA).
-	// On return, width/height will be set to the image's dimensions, and actual_comps will be set 
-	// to either 1 (grayscale) or 3 (RGB).
-	auto bmpData = jpgd::decompress_jpeg_image_from_memory(
-		(const unsigned char*)&data[0], data.size(), &width, &height, &comps, 3
-	);
-
-	auto format = render::TextureFormat::RGBA;
-	if (comps == 3 || comps == 1)
-		format	= render::TextureFormat::RGB;
+	if (!_decoded)
+		decode(filename, options, data);
+
+	if (!_valid)
+		throw std::invalid_argument("file " + filename + " is not a valid JPEG file");
 
 	render::AbstractTexture::Ptr texture = nullptr;
 
 	if (!options->isCubeTexture())
 		texture	= render::Texture::create(
 			options->context(), 
-			width, 
-			height, 
+			_width, 
+			_height, 
 			options->generateMipmaps(), 
 			false, 
 			options->resizeSmoothly(), 
@@ -67,20 +152,23 @@ JPEGParser::parse(const std::string&				filename,
 	else
 		texture = render::CubeTexture::create(
 			options->context(), 
-			width, 
-			height, 
+			_width, 
+			_height, 
 			options->generateMipmaps(), 
 			false, 
 			options->resizeSmoothly(), 
 			filename
 		);
 
-	texture->data(bmpData, format);
+	if (texture->type() == render::TextureType::Texture2D)
+		std::static_pointer_cast<render::Texture>(texture)->data(_pixels);
+	else
+		texture->data(&_pixels[0]);
 	texture->upload();
 
 	AssetLibrary->texture(filename, texture);
 
-	free(bmpData);
+	std::vector<unsigned char>().swap(_pixels);
 
 	complete()->execute(shared_from_this());
 }
@@ -25,6 +25,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/input/leap/Gesture.hpp"
 
+#include <atomic>
+
 namespace Leap
 {
 	class Controller;
@@ -63,6 +65,11 @@ namespace minko
 
 				std::shared_ptr<LeapToMinkoDispatcher>		_leapListener;
 
+				std::atomic<bool>							_coalesceFrames;
+				std::atomic<uint>							_numPendingFrames; // tracked by the Leap thread
+				uint										_numFramesSinceLastDispatch;
+				Signal<AbstractCanvas::Ptr>::Slot			_inputsPolledSlot;
+
 			public:
 				inline static
 				Ptr
@@ -87,6 +94,31 @@ namespace minko
 				bool
 				isGestureEnabled(Gesture::Type) const;
 
+				// when enabled, enterFrame() is executed on the main thread once per frame of the canvas instead
+				// of on the Leap thread for each tracking frame
+				inline
+				bool
+				coalesceFrames() const
+				{
+					return _coalesceFrames;
+				}
+
+				inline
+				void
+				coalesceFrames(bool value)
+				{
+					_coalesceFrames = value;
+				}
+
+				// tracking frames received since the previous enterFrame(), frame(i) returns each of them for
+				// i lower than this number
+				inline
+				uint
+				numFramesSinceLastDispatch() const
+				{
+					return _numFramesSinceLastDispatch;
+				}
+
 				inline
 				std::shared_ptr<Signal<Ptr>>
 				initialized() const
@@ -148,6 +180,12 @@ namespace minko
 
 				void
 				initialize();
+
+				void
+				frameTracked();
+
+				void
+				dispatchPendingFrames();
 			};
 		}
 	}
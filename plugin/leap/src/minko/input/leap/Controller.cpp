@@ -58,7 +58,7 @@ public:
 	void 
 	onFrame(const Leap::Controller&)
 	{
-		_controller->enterFrame()->execute(_controller);
+		_controller->frameTracked();
 	}
 
 	virtual 
@@ -112,7 +112,10 @@ Controller::Controller(AbstractCanvas::Ptr canvas):
 	_omit			(Signal<Controller::Ptr>::create()),
 	_disconnected	(Signal<Controller::Ptr>::create()),
 	_exit			(Signal<Controller::Ptr>::create()),
-	_leapListener(nullptr)
+	_leapListener(nullptr),
+	_coalesceFrames(true),
+	_numPendingFrames(0),
+	_numFramesSinceLastDispatch(0)
 {
 	if (_canvas == nullptr)
 		throw std::invalid_argument("_canvas");
@@ -122,6 +125,39 @@ void
 Controller::initialize()
 {
 	_leapListener = std::shared_ptr<LeapToMinkoDispatcher>(new LeapToMinkoDispatcher(shared_from_this()));
+
+	_inputsPolledSlot = _canvas->inputsPolled()->connect([&](AbstractCanvas::Ptr canvas)
+	{
+		dispatchPendingFrames();
+	});
+}
+
+void
+Controller::frameTracked()
+{
+	if (!_coalesceFrames)
+	{
+		_numFramesSinceLastDispatch = 1;
+		_enterFrame->execute(shared_from_this());
+
+		return;
+	}
+
+	// the Leap thread only counts the frames, the canvas dispatches them with its next frame
+	++_numPendingFrames;
+	_canvas->requestFrame();
+}
+
+void
+Controller::dispatchPendingFrames()
+{
+	const uint numFrames = _numPendingFrames.exchange(0);
+
+	if (numFrames == 0)
+		return;
+
+	_numFramesSinceLastDispatch = numFrames;
+	_enterFrame->execute(shared_from_this());
 }
 
 void
@@ -0,0 +1,96 @@
+--[[
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+]]--
+
+minko = minko or {}
+minko.update = {}
+
+local mu = minko.update
+
+mu.ENTRIES = {}
+mu.REMOVED = {}
+mu.CURSOR = 1
+
+function mu.add(f, script, target, interval, scope)
+    local entry = { f = f, script = script, target = target, interval = interval, countdown = 1, scope = scope }
+
+    table.insert(mu.ENTRIES, entry)
+    entry.index = #mu.ENTRIES
+
+    return entry
+end
+
+function mu.remove(entry)
+    if entry.removed then
+        return
+    end
+
+    -- entries are removed at the beginning of the next dispatch to keep the iteration stable
+    entry.removed = true
+    table.insert(mu.REMOVED, entry)
+end
+
+-- profile is true when each update is to be timed in its own profiler scope
+function mu.dispatch(budget, profile)
+    local entries = mu.ENTRIES
+
+    for _, entry in ipairs(mu.REMOVED) do
+        local last = entries[#entries]
+
+        entries[entry.index] = last
+        last.index = entry.index
+        entries[#entries] = nil
+    end
+    mu.REMOVED = {}
+
+    local numEntries = #entries
+
+    if numEntries == 0 then
+        return
+    end
+
+    local deadline = budget > 0 and os.clock() + budget / 1000 or nil
+    local i = mu.CURSOR > numEntries and 1 or mu.CURSOR
+
+    for _ = 1, numEntries do
+        local entry = entries[i]
+
+        if not entry.removed then
+            entry.countdown = entry.countdown - 1
+            if entry.countdown <= 0 then
+                entry.countdown = entry.interval
+                if profile then
+                    mu.beginScope(entry.scope)
+                    entry.f(entry.script, entry.target)
+                    mu.endScope()
+                else
+                    entry.f(entry.script, entry.target)
+                end
+            end
+        end
+
+        i = i % numEntries + 1
+
+        -- the entries that did not fit in the budget are updated first on the next frame
+        if deadline and os.clock() >= deadline then
+            break
+        end
+    end
+
+    mu.CURSOR = i
+end
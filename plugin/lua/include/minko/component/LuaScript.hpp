@@ -26,6 +26,14 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 class LuaGlue;
 class LuaGlueClassBase;
 
+namespace minko
+{
+    namespace component
+    {
+        class LuaScriptManager;
+    }
+}
+
 namespace minko
 {
     namespace component
@@ -41,7 +49,7 @@ namespace minko
                 friend class LuaScript;
 
             public:
-                LuaStub() : _running(true) {}
+                LuaStub() : _running(true), _selfRef(-1), _targetRef(-1), _updateRef(-1) {}
 
                 bool
                 running()
@@ -51,6 +59,10 @@ namespace minko
 
             private:
                 bool _running;
+                // registry references to the userdata passed to the script methods
+                int  _selfRef;
+                int  _targetRef;
+                int  _updateRef;
             };
 
         private:
@@ -61,12 +73,18 @@ namespace minko
             std::string                             _scriptName;
             std::string                             _script;
 
+            LuaScriptManager*                       _scriptManager;
             LuaGlue*                                _state;
             LuaGlueClassBase*                       _class;
             std::unordered_map<NodePtr, LuaStub*>   _targetToStub;
-            bool                                    _hasStartMethod;
-            bool                                    _hasUpdateMethod;
-            bool                                    _hasStopMethod;
+            int                                     _startFunction;
+            int                                     _updateFunction;
+            int                                     _stopFunction;
+            uint                                    _updateInterval;
+            // profiler scopes of the script methods
+            const char*                             _startScope;
+            const char*                             _updateScope;
+            const char*                             _stopScope;
 
         public:
             static inline
@@ -80,15 +98,22 @@ namespace minko
                 return s;
             }
 
+            inline
+            uint
+            updateInterval()
+            {
+                return _updateInterval;
+            }
+
+            // the update method of the script is called every 'interval' frames
+            Ptr
+            updateInterval(uint interval);
+
         protected:
             virtual
 			void
 			start(NodePtr target);
 
-			virtual
-			void
-			update(NodePtr target);
-
             virtual
             void
             stop(NodePtr target);
@@ -104,6 +129,12 @@ namespace minko
             void
             initializeLuaBindings();
 
+            int
+            getFunctionRef(const char* name);
+
+            void
+            invoke(int functionRef, LuaStub* stub, const char* scope);
+
         };
     }
 }
@@ -31,6 +31,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 class LuaGlue;
 struct lua_State;
+struct lua_Debug;
 
 namespace minko
 {
@@ -57,6 +58,21 @@ namespace minko
 			time_point								_previousTime;
 			std::list<Signal<AbsLoaderPtr>::Slot>	_dependencySlots;
 
+			float									_updateBudget;
+			float									_gcBudget;
+			float									_gcPause;
+			uint									_gcHeapAfterCycle;
+			bool									_gcCollecting; // a cycle is in progress
+			float									_gcTime;
+			uint									_gcNumCycles;
+			int										_addUpdateFunction;
+			int										_removeUpdateFunction;
+			int										_dispatchUpdatesFunction;
+			bool									_profileFunctions;
+			// one entry per Lua function running on the main thread, true when it opened a profiler scope
+			std::vector<bool>						_profileStack;
+			std::map<std::pair<const char*, int>, const char*>	_profileNames;
+
 		public:
 			inline static
 			Ptr
@@ -90,6 +106,9 @@ namespace minko
 			void
 			update(std::shared_ptr<scene::Node> target);
 
+			void
+			end(std::shared_ptr<scene::Node> target);
+
 			inline
 			LuaGlue*
 			state()
@@ -97,11 +116,106 @@ namespace minko
 				return &_state;
 			}
 
+			inline
+			float
+			updateBudget()
+			{
+				return _updateBudget;
+			}
+
+			// maximum time (in milliseconds) spent in the scripts updates every frame, 0 for no limit
+			inline
+			Ptr
+			updateBudget(float budget)
+			{
+				if (budget < 0.f)
+					throw std::invalid_argument("budget");
+
+				_updateBudget = budget;
+
+				return std::static_pointer_cast<LuaScriptManager>(shared_from_this());
+			}
+
+			inline
+			float
+			gcBudget()
+			{
+				return _gcBudget;
+			}
+
+			// maximum time (in milliseconds) spent in incremental garbage collection steps at the end of every
+			// frame, 0 lets the VM collect whenever it allocates
+			Ptr
+			gcBudget(float budget);
+
+			inline
+			float
+			gcPause()
+			{
+				return _gcPause;
+			}
+
+			// a new collection cycle starts once the heap grew by this factor since the end of the previous one
+			inline
+			Ptr
+			gcPause(float pause)
+			{
+				if (pause < 1.f)
+					throw std::invalid_argument("pause");
+
+				_gcPause = pause;
+
+				return std::static_pointer_cast<LuaScriptManager>(shared_from_this());
+			}
+
+			// bytes allocated by the VM
+			uint
+			heapSize();
+
+			// milliseconds spent collecting during the last frame
+			inline
+			float
+			gcTime()
+			{
+				return _gcTime;
+			}
+
+			inline
+			uint
+			gcNumCycles()
+			{
+				return _gcNumCycles;
+			}
+
+			inline
+			bool
+			profileFunctions()
+			{
+				return _profileFunctions;
+			}
+
+			// installs a call hook timing every Lua function running on the main thread while the Profiler is
+			// enabled, named after their script and line; the start, update and stop methods of the scripts are
+			// always timed when the Profiler is enabled, but the hook slows down every call
+			Ptr
+			profileFunctions(bool value);
+
 		private:
 			LuaScriptManager() :
 				_ready(false),
 				_numDependencies(0),
-				_numLoadedDependencies(0)
+				_numLoadedDependencies(0),
+				_updateBudget(0.f),
+				_gcBudget(1.f),
+				_gcPause(2.f),
+				_gcHeapAfterCycle(0),
+				_gcCollecting(false),
+				_gcTime(0.f),
+				_gcNumCycles(0),
+				_addUpdateFunction(LUA_NOREF),
+				_removeUpdateFunction(LUA_NOREF),
+				_dispatchUpdatesFunction(LUA_NOREF),
+				_profileFunctions(false)
 			{
 
 			}
@@ -123,6 +237,37 @@ namespace minko
 
 			void
 			dependencyLoadedHandler(AbsLoaderPtr loader);
+
+			int
+			getUpdateFunctionRef(const char* name);
+
+			int
+			addScriptUpdate(int functionRef, int scriptRef, int targetRef, uint interval, const char* scope);
+
+			void
+			removeScriptUpdate(int updateRef);
+
+			void
+			scriptUpdateInterval(int updateRef, uint interval);
+
+			void
+			collectGarbage();
+
+			// closes the scopes of the functions left without a return event by an error
+			void
+			profileUnwind(uint depth);
+
+			static
+			void
+			profileHook(lua_State* state, lua_Debug* ar);
+
+			static
+			int
+			beginProfileScope(lua_State* state);
+
+			static
+			int
+			endProfileScope(lua_State* state);
 		};
 	}
 }
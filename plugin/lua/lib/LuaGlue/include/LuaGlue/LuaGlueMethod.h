@@ -16,6 +16,29 @@
 template<typename _Class>
 class LuaGlueClass;
 
+// a method returning its own instance (chaining) pushes the userdata it was called on
+// back instead of wrapping the shared_ptr into a new userdata
+template<typename _Ret, typename _Class>
+struct LuaGlueReturnValue
+{
+	static void put(LuaGlueBase *luaGlue, lua_State *state, _Class *, _Ret &ret)
+	{
+		stack<_Ret>::put(luaGlue, state, ret);
+	}
+};
+
+template<typename _Class>
+struct LuaGlueReturnValue<std::shared_ptr<_Class>, _Class>
+{
+	static void put(LuaGlueBase *luaGlue, lua_State *state, _Class *self, std::shared_ptr<_Class> &ret)
+	{
+		if(self && ret.get() == self)
+			lua_pushvalue(state, 1);
+		else
+			stack<std::shared_ptr<_Class>>::put(luaGlue, state, ret);
+	}
+};
+
 template<typename _Ret, typename _Class, typename... _Args>
 class LuaGlueMethod : public LuaGlueMethodBase
 {
@@ -55,22 +78,25 @@ class LuaGlueMethod : public LuaGlueMethodBase
 			LG_Debug("invoke: %s::%s", typeid(*glueClass).name(), name_.c_str());
 
 			ReturnType ret;
+			ClassType *self = nullptr;
 			
 			auto base = GetLuaUdata(state, 1, glueClass->name().c_str());
 			if(base->isSharedPtr())
 			{
 				auto obj = *CastLuaGlueObjectShared(ClassType, base);
 				ret = applyTuple(glueClass->luaGlue(), state, obj, fn, args);
+				self = obj.ptr();
 			}
 			else
 			{
 				auto obj = *CastLuaGlueObject(ClassType, base);
 				ret = applyTuple(glueClass->luaGlue(), state, obj, fn, args);
+				self = obj.ptr();
 			}
 			
 			if(Arg_Count_) lua_pop(state, (int)Arg_Count_);
 			
-			stack<ReturnType>::put(glueClass->luaGlue(), state, ret);
+			LuaGlueReturnValue<ReturnType, ClassType>::put(glueClass->luaGlue(), state, self, ret);
 			return 1;
 		}
 		
@@ -182,21 +208,24 @@ class LuaGlueConstMethod : public LuaGlueMethodBase
 			//printf("invoker: %s::%s\n", typeid(*glueClass).name(), name_.c_str());
 			
 			ReturnType ret;
+			ClassType *self = nullptr;
 			auto base = GetLuaUdata(state, 1, glueClass->name().c_str());
 			if(base->isSharedPtr())
 			{
 				LuaGlueObject<std::shared_ptr<ClassType>> obj = *CastLuaGlueObjectShared(ClassType, base);
 				ret = applyTuple(glueClass->luaGlue(), state, obj, fn, args);
+				self = obj.ptr();
 			}
 			else
 			{
 				auto obj = *CastLuaGlueObject(ClassType, base);
 				ret = applyTuple(glueClass->luaGlue(), state, obj, fn, args);
+				self = obj.ptr();
 			}
 			
 			if(Arg_Count_) lua_pop(state, (int)Arg_Count_);
 			
-			stack<ReturnType>::put(glueClass->luaGlue(), state, ret);
+			LuaGlueReturnValue<ReturnType, ClassType>::put(glueClass->luaGlue(), state, self, ret);
 			return 1;
 		}
 		
@@ -312,21 +341,24 @@ class LuaGlueMethod<_Ret, std::shared_ptr<_Class>, _Args...> : public LuaGlueMet
 			//printf("invoker: %s::%s\n", typeid(*glueClass).name(), name_.c_str());
 
 			ReturnType ret;
+			ClassType *self = nullptr;
 			auto base = GetLuaUdata(state, 1, glueClass->name().c_str());
 			if(base->isSharedPtr())
 			{
 				auto obj = *CastLuaGlueObjectShared(ClassType, base);
 				ret = applyTuple(glueClass->luaGlue(), state, obj, fn, args);
+				self = obj.ptr();
 			}
 			else
 			{
 				auto obj = *CastLuaGlueObject(ClassType, base);
 				ret = applyTuple(glueClass->luaGlue(), state, obj, fn, args);
+				self = obj.ptr();
 			}
 			
 			if(Arg_Count_) lua_pop(state, (int)Arg_Count_);
 			
-			stack<ReturnType>::put(glueClass->luaGlue(), state, ret);
+			LuaGlueReturnValue<ReturnType, ClassType>::put(glueClass->luaGlue(), state, self, ret);
 			return 1;
 		}
 		
@@ -21,6 +21,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/scene/Node.hpp"
 #include "minko/component/LuaScriptManager.hpp"
+#include "minko/Profiler.hpp"
 
 #include "LuaGlue/LuaGlue.h"
 
@@ -30,9 +31,16 @@ using namespace minko::component;
 LuaScript::LuaScript(const std::string& name, const std::string& script) :
     _scriptName(name),
     _script(script),
-    _hasStartMethod(false),
-    _hasUpdateMethod(false),
-    _hasStopMethod(false)
+    _scriptManager(nullptr),
+    _state(nullptr),
+    _class(nullptr),
+    _startFunction(LUA_NOREF),
+    _updateFunction(LUA_NOREF),
+    _stopFunction(LUA_NOREF),
+    _updateInterval(1),
+    _startScope(nullptr),
+    _updateScope(nullptr),
+    _stopScope(nullptr)
 {
 }
 
@@ -47,7 +55,8 @@ LuaScript::start(scene::Node::Ptr node)
 {
     if (!_script.empty())
     {
-        _state = &(node->root()->component<LuaScriptManager>()->_state);
+        _scriptManager = node->root()->component<LuaScriptManager>().get();
+        _state = &_scriptManager->_state;
 
         auto name = _scriptName.c_str();
 
@@ -56,42 +65,119 @@ LuaScript::start(scene::Node::Ptr node)
         _class = _state->lookupClass(name);
         _class->glue(_state);
 
-        if(!_state->doString(_script))
-            printf("err: %s\n", _state->lastError().c_str());
+        auto state = _state->state();
+        // named after the script so that the functions it defines can be told apart when profiling
+        auto chunkName = "=" + _scriptName;
+
+        if (luaL_loadbuffer(state, _script.c_str(), _script.size(), chunkName.c_str())
+            || lua_pcall(state, 0, 0, 0))
+        {
+            printf("err: %s\n", lua_tostring(state, -1));
+            lua_pop(state, 1);
+        }
         _script.clear();
 
-        auto c = dynamic_cast<LuaGlueClass<LuaScript::LuaStub>*>(_class);
-        _hasStartMethod = c->hasMethod("start");
-        _hasUpdateMethod = c->hasMethod("update");
-        _hasStopMethod = c->hasMethod("stop");
+        _startScope = Profiler::intern(_scriptName + ".start");
+        _updateScope = Profiler::intern(_scriptName + ".update");
+        _stopScope = Profiler::intern(_scriptName + ".stop");
+
+        // the script methods are looked up once and then called through the registry
+        _startFunction = getFunctionRef("start");
+        _updateFunction = getFunctionRef("update");
+        _stopFunction = getFunctionRef("stop");
     }
 
     auto stub = _targetToStub.count(node) == 0
         ? _targetToStub[node] = new LuaStub()
         : _targetToStub[node];
+    auto state = _state->state();
 
-    if (_hasStartMethod)
-        dynamic_cast<LuaGlueClass<LuaScript::LuaStub>*>(_class)->invokeVoidMethod("start", stub, node);
+    if (stub->_selfRef == LUA_REFNIL)
+    {
+        static_cast<LuaGlueClass<LuaStub>*>(_class)->pushInstance(state, stub);
+        stub->_selfRef = luaL_ref(state, LUA_REGISTRYINDEX);
+        stack<NodePtr>::put(_state, state, node);
+        stub->_targetRef = luaL_ref(state, LUA_REGISTRYINDEX);
+    }
+
+    if (_startFunction != LUA_NOREF)
+        invoke(_startFunction, stub, _startScope);
+
+    // updates are dispatched by the LuaScriptManager for all the scripts at once
+    if (_updateFunction != LUA_NOREF && stub->_updateRef == LUA_REFNIL)
+        stub->_updateRef = _scriptManager->addScriptUpdate(
+            _updateFunction, stub->_selfRef, stub->_targetRef, _updateInterval, _updateScope
+        );
 }
 
 void
-LuaScript::update(scene::Node::Ptr node)
+LuaScript::stop(scene::Node::Ptr node)
 {
     auto stub = _targetToStub[node];
+    auto state = _state->state();
+
+    stub->_running = false;
+
+    if (stub->_updateRef != LUA_REFNIL)
+        _scriptManager->removeScriptUpdate(stub->_updateRef);
+
+    if (_stopFunction != LUA_NOREF)
+        invoke(_stopFunction, stub, _stopScope);
+
+    luaL_unref(state, LUA_REGISTRYINDEX, stub->_selfRef);
+    luaL_unref(state, LUA_REGISTRYINDEX, stub->_targetRef);
+    _targetToStub.erase(node);
+
+    delete stub;
+}
 
-    if (_hasUpdateMethod)
-        dynamic_cast<LuaGlueClass<LuaScript::LuaStub>*>(_class)->invokeVoidMethod("update", stub, node);
+LuaScript::Ptr
+LuaScript::updateInterval(uint interval)
+{
+    if (interval == 0)
+        throw std::invalid_argument("interval");
+
+    _updateInterval = interval;
+
+    for (auto& targetAndStub : _targetToStub)
+        if (targetAndStub.second->_updateRef != LUA_REFNIL)
+            _scriptManager->scriptUpdateInterval(targetAndStub.second->_updateRef, interval);
+
+    return std::static_pointer_cast<LuaScript>(shared_from_this());
+}
+
+int
+LuaScript::getFunctionRef(const char* name)
+{
+    auto state = _state->state();
+    auto ref = LUA_NOREF;
+
+    lua_getglobal(state, _scriptName.c_str());
+    if (lua_istable(state, -1))
+    {
+        lua_getfield(state, -1, name);
+        if (lua_isfunction(state, -1))
+            ref = luaL_ref(state, LUA_REGISTRYINDEX);
+        else
+            lua_pop(state, 1);
+    }
+    lua_pop(state, 1);
+
+    return ref;
 }
 
 void
-LuaScript::stop(scene::Node::Ptr node)
+LuaScript::invoke(int functionRef, LuaStub* stub, const char* scope)
 {
-    auto stub = _targetToStub[node];
+    MINKO_PROFILE_SCOPE(scope);
 
-    _targetToStub[node]->_running = false;
+    auto state = _state->state();
+    auto profileDepth = _scriptManager->_profileStack.size();
 
-    if (_hasStopMethod)
-        dynamic_cast<LuaGlueClass<LuaScript::LuaStub>*>(_class)->invokeVoidMethod("stop", stub, node);
+    lua_rawgeti(state, LUA_REGISTRYINDEX, functionRef);
+    lua_rawgeti(state, LUA_REGISTRYINDEX, stub->_selfRef);
+    lua_rawgeti(state, LUA_REGISTRYINDEX, stub->_targetRef);
+    lua_call(state, 2, 0);
 
-    delete stub;
+    _scriptManager->profileUnwind(profileDepth);
 }
@@ -20,6 +20,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/component/LuaScriptManager.hpp"
 #include "minko/component/LuaScript.hpp"
 
+#include "minko/Profiler.hpp"
 #include "minko/file/Options.hpp"
 #include "minko/file/FileLoader.hpp"
 #include "minko/render/AbstractContext.hpp"
@@ -63,6 +64,9 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 using namespace minko;
 using namespace minko::component;
 
+// address of the registry entry holding the manager of a state, for the profiling hook
+static const char profileHookKey = 0;
+
 void
 LuaScriptManager::initialize()
 {
@@ -76,6 +80,12 @@ LuaScriptManager::initialize()
 		.func("getOption", &LuaContext::getOption);
 
 	_state.open().glue();
+
+	// the collection is driven by steps at the end of the frames instead of the allocations of the scripts
+	lua_gc(_state.state(), LUA_GCINC, 0);
+	if (_gcBudget > 0.f)
+		lua_gc(_state.state(), LUA_GCSTOP, 0);
+	_gcHeapAfterCycle = heapSize();
 }
 
 void
@@ -106,7 +116,8 @@ LuaScriptManager::loadStandardLibrary()
     auto createLoader = assets->defaultOptions()->loaderFunction();
     auto filesToLoad = {
         "script/minko.coroutine.lua",
-        "script/minko.time.lua"
+        "script/minko.time.lua",
+        "script/minko.update.lua"
     };
 
     _numDependencies = filesToLoad.size();
@@ -132,6 +143,79 @@ LuaScriptManager::dependencyLoadedHandler(AbsLoaderPtr loader)
     _state.doString(std::string((char*)&data[0], data.size()));
 
     ++_numLoadedDependencies;
+
+    if (_numLoadedDependencies == _numDependencies)
+    {
+        _addUpdateFunction = getUpdateFunctionRef("add");
+        _removeUpdateFunction = getUpdateFunctionRef("remove");
+        _dispatchUpdatesFunction = getUpdateFunctionRef("dispatch");
+
+        auto state = _state.state();
+
+        // lets the dispatch time each script update
+        lua_getglobal(state, "minko");
+        lua_getfield(state, -1, "update");
+        lua_pushcfunction(state, &LuaScriptManager::beginProfileScope);
+        lua_setfield(state, -2, "beginScope");
+        lua_pushcfunction(state, &LuaScriptManager::endProfileScope);
+        lua_setfield(state, -2, "endScope");
+        lua_pop(state, 2);
+    }
+}
+
+int
+LuaScriptManager::getUpdateFunctionRef(const char* name)
+{
+    auto state = _state.state();
+
+    lua_getglobal(state, "minko");
+    lua_getfield(state, -1, "update");
+    lua_getfield(state, -1, name);
+
+    auto ref = luaL_ref(state, LUA_REGISTRYINDEX);
+
+    lua_pop(state, 2);
+
+    return ref;
+}
+
+int
+LuaScriptManager::addScriptUpdate(int functionRef, int scriptRef, int targetRef, uint interval, const char* scope)
+{
+    auto state = _state.state();
+
+    lua_rawgeti(state, LUA_REGISTRYINDEX, _addUpdateFunction);
+    lua_rawgeti(state, LUA_REGISTRYINDEX, functionRef);
+    lua_rawgeti(state, LUA_REGISTRYINDEX, scriptRef);
+    lua_rawgeti(state, LUA_REGISTRYINDEX, targetRef);
+    lua_pushunsigned(state, interval);
+    lua_pushlightuserdata(state, const_cast<char*>(scope));
+    lua_call(state, 5, 1);
+
+    return luaL_ref(state, LUA_REGISTRYINDEX);
+}
+
+void
+LuaScriptManager::removeScriptUpdate(int updateRef)
+{
+    auto state = _state.state();
+
+    lua_rawgeti(state, LUA_REGISTRYINDEX, _removeUpdateFunction);
+    lua_rawgeti(state, LUA_REGISTRYINDEX, updateRef);
+    lua_call(state, 1, 0);
+
+    luaL_unref(state, LUA_REGISTRYINDEX, updateRef);
+}
+
+void
+LuaScriptManager::scriptUpdateInterval(int updateRef, uint interval)
+{
+    auto state = _state.state();
+
+    lua_rawgeti(state, LUA_REGISTRYINDEX, updateRef);
+    lua_pushunsigned(state, interval);
+    lua_setfield(state, -2, "interval");
+    lua_pop(state, 1);
 }
 
 void
@@ -139,9 +223,205 @@ LuaScriptManager::update(scene::Node::Ptr target)
 {
     time_point t = std::chrono::high_resolution_clock::now();
     std::chrono::duration<float> deltaT = t - _previousTime;
+    auto profileDepth = _profileStack.size();
 
     _state.invokeVoidFunction("wakeUpWaitingThreads", deltaT.count() * 1000.f);
     _previousTime = t;
+
+    profileUnwind(profileDepth);
+}
+
+void
+LuaScriptManager::end(scene::Node::Ptr target)
+{
+    // all the scripts are updated in a single call, the iteration happens inside the VM
+    if (_dispatchUpdatesFunction == LUA_NOREF)
+        return;
+
+    auto state = _state.state();
+    auto profileDepth = _profileStack.size();
+
+    lua_rawgeti(state, LUA_REGISTRYINDEX, _dispatchUpdatesFunction);
+    lua_pushnumber(state, _updateBudget);
+    lua_pushboolean(state, Profiler::enabled());
+    lua_call(state, 2, 0);
+
+    profileUnwind(profileDepth);
+    collectGarbage();
+}
+
+LuaScriptManager::Ptr
+LuaScriptManager::gcBudget(float budget)
+{
+	if (budget < 0.f)
+		throw std::invalid_argument("budget");
+
+	_gcBudget = budget;
+	lua_gc(_state.state(), budget > 0.f ? LUA_GCSTOP : LUA_GCRESTART, 0);
+
+	return std::static_pointer_cast<LuaScriptManager>(shared_from_this());
+}
+
+uint
+LuaScriptManager::heapSize()
+{
+	auto state = _state.state();
+
+	return (uint)lua_gc(state, LUA_GCCOUNT, 0) * 1024 + lua_gc(state, LUA_GCCOUNTB, 0);
+}
+
+void
+LuaScriptManager::collectGarbage()
+{
+	_gcTime = 0.f;
+
+	if (_gcBudget == 0.f)
+		return;
+
+	MINKO_PROFILE_SCOPE("LuaScriptManager::collectGarbage");
+
+	auto state = _state.state();
+	auto heap = heapSize();
+
+	// between two cycles the collector waits for the heap to grow, like the pause of the VM
+	if (_gcCollecting || heap >= _gcHeapAfterCycle * _gcPause)
+	{
+		_gcCollecting = true;
+
+		auto start = std::chrono::high_resolution_clock::now();
+		auto budget = std::chrono::duration<float, std::milli>(_gcBudget);
+
+		do
+		{
+			// each basic step traverses a bounded amount of objects, 1 when it finished a cycle
+			if (lua_gc(state, LUA_GCSTEP, 0))
+			{
+				++_gcNumCycles;
+				_gcCollecting = false;
+				_gcHeapAfterCycle = heapSize();
+				break;
+			}
+		}
+		while (std::chrono::high_resolution_clock::now() - start < budget);
+
+		_gcTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		heap = heapSize();
+	}
+
+	if (Profiler::enabled())
+	{
+		Profiler::counter("luaHeap", heap);
+		Profiler::counter("luaGCTime", (unsigned long long)(_gcTime * 1e6f));
+	}
+}
+
+LuaScriptManager::Ptr
+LuaScriptManager::profileFunctions(bool value)
+{
+	auto state = _state.state();
+
+	if (value != _profileFunctions)
+	{
+		_profileFunctions = value;
+
+		if (value)
+		{
+			lua_pushlightuserdata(state, this);
+			lua_rawsetp(state, LUA_REGISTRYINDEX, &profileHookKey);
+			lua_sethook(state, &LuaScriptManager::profileHook, LUA_MASKCALL | LUA_MASKRET, 0);
+		}
+		else
+		{
+			lua_sethook(state, nullptr, 0, 0);
+			profileUnwind(0);
+		}
+	}
+
+	return std::static_pointer_cast<LuaScriptManager>(shared_from_this());
+}
+
+void
+LuaScriptManager::profileUnwind(uint depth)
+{
+	while (_profileStack.size() > depth)
+	{
+		if (_profileStack.back())
+			Profiler::end();
+		_profileStack.pop_back();
+	}
+}
+
+void
+LuaScriptManager::profileHook(lua_State* state, lua_Debug* ar)
+{
+	// coroutines can yield without return events, what they run is accounted to the call resuming them
+	if (!lua_pushthread(state))
+	{
+		lua_pop(state, 1);
+		return;
+	}
+	lua_pop(state, 1);
+
+	lua_getinfo(state, "S", ar);
+	if (ar->what[0] == 'C')
+		return;
+
+	lua_rawgetp(state, LUA_REGISTRYINDEX, &profileHookKey);
+	auto manager = static_cast<LuaScriptManager*>(lua_touserdata(state, -1));
+	lua_pop(state, 1);
+
+	auto& stack = manager->_profileStack;
+
+	if (ar->event == LUA_HOOKRET)
+	{
+		if (!stack.empty())
+			manager->profileUnwind(stack.size() - 1);
+
+		return;
+	}
+
+	// a tail call reuses the frame of the caller, that will not return
+	if (ar->event == LUA_HOOKTAILCALL && !stack.empty())
+		manager->profileUnwind(stack.size() - 1);
+
+	if (!Profiler::enabled())
+	{
+		stack.push_back(false);
+
+		return;
+	}
+
+	auto key = std::make_pair(ar->source, ar->linedefined);
+	auto nameIt = manager->_profileNames.find(key);
+
+	if (nameIt == manager->_profileNames.end())
+	{
+		auto name = std::string(ar->short_src);
+
+		if (ar->linedefined > 0)
+			name += ":" + std::to_string(ar->linedefined);
+
+		nameIt = manager->_profileNames.insert(std::make_pair(key, Profiler::intern(name))).first;
+	}
+
+	Profiler::begin(nameIt->second);
+	stack.push_back(true);
+}
+
+int
+LuaScriptManager::beginProfileScope(lua_State* state)
+{
+	Profiler::begin(static_cast<const char*>(lua_touserdata(state, 1)));
+
+	return 0;
+}
+
+int
+LuaScriptManager::endProfileScope(lua_State* state)
+{
+	Profiler::end();
+
+	return 0;
 }
 
 void
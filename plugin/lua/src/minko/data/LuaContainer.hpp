@@ -47,13 +47,13 @@ namespace minko
                     .method("hasProvider",              static_cast<bool (Container::*)(Provider::Ptr) const>(&Container::hasProvider))
 					.method("propertyValueChanged",		&Container::propertyValueChanged)
 					.method("propertyReferenceChanged",	&Container::propertyReferenceChanged)
-		            .method("getFloat",     			&Container::get<float>)
-		            .method("getVector2",     			&Container::get<std::shared_ptr<math::Vector2>>)
-		            .method("getVector3",     			&Container::get<std::shared_ptr<math::Vector3>>)
-		            .method("getVector4",     			&Container::get<std::shared_ptr<math::Vector4>>)
-		            .method("getInt",       			&Container::get<int>)
-		            .method("getUint",      			&Container::get<unsigned int>)
-		            .method("getMatrix4x4", 			&Container::get<std::shared_ptr<math::Matrix4x4>>);
+		            .method("getFloat",     			static_cast<float (Container::*)(const std::string&) const>(&Container::get<float>))
+		            .method("getVector2",     			static_cast<std::shared_ptr<math::Vector2> (Container::*)(const std::string&) const>(&Container::get<std::shared_ptr<math::Vector2>>))
+		            .method("getVector3",     			static_cast<std::shared_ptr<math::Vector3> (Container::*)(const std::string&) const>(&Container::get<std::shared_ptr<math::Vector3>>))
+		            .method("getVector4",     			static_cast<std::shared_ptr<math::Vector4> (Container::*)(const std::string&) const>(&Container::get<std::shared_ptr<math::Vector4>>))
+		            .method("getInt",       			static_cast<int (Container::*)(const std::string&) const>(&Container::get<int>))
+		            .method("getUint",      			static_cast<unsigned int (Container::*)(const std::string&) const>(&Container::get<unsigned int>))
+		            .method("getMatrix4x4", 			static_cast<std::shared_ptr<math::Matrix4x4> (Container::*)(const std::string&) const>(&Container::get<std::shared_ptr<math::Matrix4x4>>));
 			}
 		};
 	}
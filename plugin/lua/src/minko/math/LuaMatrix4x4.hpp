@@ -40,7 +40,7 @@ namespace minko
 					.method("copyFrom",				&Matrix4x4::copyFrom)
 		            .method("lookAt",               &Matrix4x4::lookAt)
 		            .method("identity",             &Matrix4x4::identity)
-		            .method("invert",				&Matrix4x4::invert)
+		            .method("invert",				static_cast<Matrix4x4::Ptr (Matrix4x4::*)()>(&Matrix4x4::invert))
 					.method("translation",			static_cast<Matrix4x4::Ptr (Matrix4x4::*)(float, float, float)>(&Matrix4x4::translation))
 					.method("transform",			static_cast<Vector3::Ptr (Matrix4x4::*)(Vector3::Ptr) const>(&Matrix4x4::transform))
 					.method("deltaTransform",		static_cast<Vector3::Ptr(Matrix4x4::*)(Vector3::Ptr) const>(&Matrix4x4::deltaTransform))
@@ -52,11 +52,8 @@ main(void)
 		gl_FragColor 	= vec4(0.0, 0.0, 0.0, 1.0);
 	else
 	{
-		// scale the texture coordinates to handle the fact
-		// the split screens take the whole screen.
-		vec2 finalUV	= vec2(2.0, 1.0) * (uv - uScreenCorner);
-		
-		gl_FragColor	= texture2D(uTex, finalUV);
-		//gl_FragColor	= fxaa_texture2D(uTex, finalUV, uPixelOffset);
+		// both eyes are side by side in the texture, as on the screen
+		gl_FragColor	= texture2D(uTex, uv);
+		//gl_FragColor	= fxaa_texture2D(uTex, uv, uPixelOffset);
 	}
 }
@@ -63,6 +63,7 @@ namespace minko
 			typedef std::shared_ptr<AbstractComponent>			AbsCmpPtr;
 			typedef std::shared_ptr<SceneManager>				SceneMgrPtr;
 			typedef std::shared_ptr<render::AbstractTexture>	AbsTexturePtr;
+			typedef std::shared_ptr<Renderer>					RendererPtr;
 
 		private:
 			static const float								WORLD_UNIT;
@@ -81,11 +82,20 @@ namespace minko
 			std::shared_ptr<Transform>						_targetTransform;
 			std::shared_ptr<math::Vector3>					_eyePosition;
 			std::shared_ptr<math::Matrix4x4>				_eyeOrientation;
+			float											_predictionDelta;
+			bool											_lateLatching;
+			std::shared_ptr<math::Matrix4x4>				_lateOrientation;
+			std::shared_ptr<math::Matrix4x4>				_lateCorrection;
 
 			SceneMgrPtr										_sceneManager;
 			NodePtr											_root;
-			std::shared_ptr<PerspectiveCamera>				_leftCamera;
-			std::shared_ptr<PerspectiveCamera>				_rightCamera;
+			// culls with a frustum containing the ones of both eyes
+			std::shared_ptr<PerspectiveCamera>				_camera;
+			std::shared_ptr<math::Matrix4x4>				_leftView;
+			std::shared_ptr<math::Matrix4x4>				_rightView;
+			float											_halfIPD;
+			// renders both eyes side by side, each draw call being issued for one eye then the other
+			std::shared_ptr<Renderer>						_stereoRenderer;
 			std::shared_ptr<Renderer>						_renderer;
 
 			Signal<AbsCmpPtr, NodePtr>::Slot				_targetAddedSlot;
@@ -95,6 +105,7 @@ namespace minko
 			Signal<NodePtr, NodePtr, AbsCmpPtr>::Slot		_targetComponentAddedHandler;
 			Signal<NodePtr, NodePtr, AbsCmpPtr>::Slot		_targetComponentRemovedHandler;
 			Signal<SceneMgrPtr, uint, AbsTexturePtr>::Slot	_renderEndSlot;
+			Signal<RendererPtr>::Slot						_stereoRenderingBeginSlot;
 
 		public:
 			inline static
@@ -131,6 +142,34 @@ namespace minko
 				return _zFar;
 			}
 
+			inline
+			float
+			predictionDelta() const
+			{
+				return _predictionDelta;
+			}
+
+			// expected delay in seconds between the sampling of the head orientation and its display,
+			// 0 disables the prediction
+			void
+			predictionDelta(float seconds);
+
+			inline
+			bool
+			lateLatching() const
+			{
+				return _lateLatching;
+			}
+
+			// the head orientation is sampled again just before the eyes are rendered and only replaces
+			// the view matrices of the eyes: the draw calls recorded during the frame are left as they are
+			inline
+			void
+			lateLatching(bool value)
+			{
+				_lateLatching = value;
+			}
+
 			void
 			resetHeadTracking();
 
@@ -170,6 +209,9 @@ namespace minko
 			void
 			removedHandler(NodePtr, NodePtr, NodePtr);
 
+			void
+			stereoRenderingBeginHandler(RendererPtr renderer);
+
 			void
 			renderEndHandler(SceneMgrPtr sceneManager, uint frameId, AbsTexturePtr	renderTarget);
 
@@ -42,7 +42,7 @@ using namespace minko::component;
 using namespace minko::math;
 
 /*static*/ const float					OculusVRCamera::WORLD_UNIT	= 1.0f;
-/*static*/ const unsigned int			OculusVRCamera::TARGET_SIZE	= 1024;
+/*static*/ const unsigned int			OculusVRCamera::TARGET_SIZE	= 1024; // per eye
 
 OculusVRCamera::OculusVRCamera(float aspectRatio, float zNear, float zFar) :
 	_aspectRatio(aspectRatio),
@@ -55,10 +55,17 @@ OculusVRCamera::OculusVRCamera(float aspectRatio, float zNear, float zFar) :
 	_targetTransform(nullptr),
 	_eyePosition(Vector3::create(0.0f, 0.0f, 0.0f)),
 	_eyeOrientation(Matrix4x4::create()),
+	_predictionDelta(0.03f),
+	_lateLatching(true),
+	_lateOrientation(Matrix4x4::create()),
+	_lateCorrection(Matrix4x4::create()),
 	_sceneManager(nullptr),
 	_root(nullptr),
-	_leftCamera(nullptr),
-	_rightCamera(nullptr),
+	_camera(nullptr),
+	_leftView(Matrix4x4::create()),
+	_rightView(Matrix4x4::create()),
+	_halfIPD(0.0f),
+	_stereoRenderer(nullptr),
 	_renderer(nullptr),
 	_targetAddedSlot(nullptr),
 	_targetRemovedSlot(nullptr),
@@ -66,7 +73,8 @@ OculusVRCamera::OculusVRCamera(float aspectRatio, float zNear, float zFar) :
 	_removedSlot(nullptr),
 	_targetComponentAddedHandler(nullptr),
 	_targetComponentRemovedHandler(nullptr),
-	_renderEndSlot(nullptr)
+	_renderEndSlot(nullptr),
+	_stereoRenderingBeginSlot(nullptr)
 {
 
 }
@@ -212,7 +220,19 @@ OculusVRCamera::initializeOVRDevice()
 	}
 
 	_ovrSensorFusion->AttachToSensor(_ovrSensorDevice.get());
-	_ovrSensorFusion->SetPredictionEnabled(true);
+	_ovrSensorFusion->SetPrediction(_predictionDelta, _predictionDelta > 0.0f);
+}
+
+void
+OculusVRCamera::predictionDelta(float seconds)
+{
+	if (seconds < 0.0f)
+		throw std::invalid_argument("seconds");
+
+	_predictionDelta = seconds;
+
+	if (_ovrSensorFusion)
+		_ovrSensorFusion->SetPrediction(_predictionDelta, _predictionDelta > 0.0f);
 }
 
 void
@@ -276,14 +296,15 @@ OculusVRCamera::setSceneManager(SceneManager::Ptr sceneManager)
 	{
 		_sceneManager	= nullptr;
 		_renderer		= nullptr;
-		_leftCamera		= nullptr;
-		_rightCamera	= nullptr;
+		_stereoRenderer	= nullptr;
+		_camera			= nullptr;
 
 		if (_root)
 			targets().front()->removeChild(_root);
 
-		_root			= nullptr;
-		_renderEndSlot	= nullptr;
+		_root						= nullptr;
+		_renderEndSlot				= nullptr;
+		_stereoRenderingBeginSlot	= nullptr;
 
 		return;
 	}
@@ -295,7 +316,7 @@ OculusVRCamera::setSceneManager(SceneManager::Ptr sceneManager)
 	getHMDInfo(hmdInfo);
 
 	// ffxa
-	auto	pixelOffset					= Vector2::create(1.0f / TARGET_SIZE, 1.0f / TARGET_SIZE);
+	auto	pixelOffset					= Vector2::create(0.5f / TARGET_SIZE, 1.0f / TARGET_SIZE);
 
 	// distortion scale
 	const auto distortionLensShift		= 1.0f - 2.0f * hmdInfo.lensSeparationDistance / hmdInfo.hScreenSize;
@@ -311,42 +332,56 @@ OculusVRCamera::setSceneManager(SceneManager::Ptr sceneManager)
 	const auto projectionCenterOffset	= 4.0f * eyeProjectionShift / hmdInfo.hScreenSize; // in clip coordinates
 
 	// view transform translation in world units
-	const auto halfIPD					= 0.5f * hmdInfo.interpupillaryDistance * WORLD_UNIT;
-
-	// left eye
-	render::AbstractTexture::Ptr	leftEyeTexture		= render::Texture::create(context, TARGET_SIZE, TARGET_SIZE, false, true);
-	auto							leftEye				= scene::Node::create("oculusvr.leftEye");
-	auto							leftRenderer		= Renderer::create();
-	auto							leftPostProjection	= Matrix4x4::create()->appendTranslation(+ projectionCenterOffset, 0.0f, 0.0f);
-
-	_leftCamera = PerspectiveCamera::create(screenAspectRatio, screenFOV, _zNear, _zFar, leftPostProjection);
-
-	leftEyeTexture->upload();
-	leftRenderer->target(leftEyeTexture);
-	leftEye->addComponent(leftRenderer);
-	leftEye->addComponent(_leftCamera);
-	leftEye->addComponent(Transform::create(
-		Matrix4x4::create()->appendTranslation(- halfIPD, 0.0f, 0.0f) // view transform
+	_halfIPD							= 0.5f * hmdInfo.interpupillaryDistance * WORLD_UNIT;
+
+	// both eyes are rendered side by side in the same texture, each eye projection maps to its half
+	const auto						eyeTextureWidth		= 2 * TARGET_SIZE;
+	render::AbstractTexture::Ptr	eyeTexture			= render::Texture::create(context, eyeTextureWidth, TARGET_SIZE, false, true);
+	auto							leftProjection		= Matrix4x4::create()
+		->perspective(screenFOV, screenAspectRatio, _zNear, _zFar)
+		->appendTranslation(+ projectionCenterOffset, 0.0f, 0.0f)
+		->appendScale(0.5f, 1.0f, 1.0f)
+		->appendTranslation(- 0.5f, 0.0f, 0.0f);
+	auto							rightProjection		= Matrix4x4::create()
+		->perspective(screenFOV, screenAspectRatio, _zNear, _zFar)
+		->appendTranslation(- projectionCenterOffset, 0.0f, 0.0f)
+		->appendScale(0.5f, 1.0f, 1.0f)
+		->appendTranslation(+ 0.5f, 0.0f, 0.0f);
+
+	Renderer::View leftView;
+	leftView.region.x			= 0;
+	leftView.region.y			= 0;
+	leftView.region.width		= TARGET_SIZE;
+	leftView.region.height		= TARGET_SIZE;
+	leftView.viewMatrix			= _leftView;
+	leftView.projectionMatrix	= leftProjection;
+
+	Renderer::View rightView	= leftView;
+	rightView.region.x			= TARGET_SIZE;
+	rightView.viewMatrix		= _rightView;
+	rightView.projectionMatrix	= rightProjection;
+
+	eyeTexture->upload();
+
+	// the frustum of the camera contains the ones of both eyes, shifted by their projection center
+	// (the interpupillary translation being neglected)
+	_camera = PerspectiveCamera::create(screenAspectRatio * (1.0f + fabsf(projectionCenterOffset)), screenFOV, _zNear, _zFar);
+	_stereoRenderer = Renderer::create();
+	_stereoRenderer->target(eyeTexture);
+	_stereoRenderer->views({ leftView, rightView });
+	_stereoRenderingBeginSlot = _stereoRenderer->renderingBegin()->connect(std::bind(
+		&OculusVRCamera::stereoRenderingBeginHandler,
+		shared_from_this(),
+		std::placeholders::_1
 	));
 
-	// right eye
-	render::AbstractTexture::Ptr	rightEyeTexture		= render::Texture::create(context, TARGET_SIZE, TARGET_SIZE, false, true);
-	auto							rightEye			= scene::Node::create("oculusvr.rightEye");
-	auto							rightRenderer		= Renderer::create();
-	auto							rightPostProjection	= Matrix4x4::create()->appendTranslation(- projectionCenterOffset, 0.0f, 0.0f);
-
-	_rightCamera = PerspectiveCamera::create(screenAspectRatio, screenFOV, _zNear, _zFar, rightPostProjection);
-
-	rightEyeTexture->upload();
-	rightRenderer->target(rightEyeTexture);
-	rightEye->addComponent(rightRenderer);
-	rightEye->addComponent(_rightCamera);
-	rightEye->addComponent(Transform::create(
-		Matrix4x4::create()->appendTranslation(+ halfIPD, 0.0f, 0.0f) // view transform
-	));
+	auto eyes = scene::Node::create("oculusvr.eyes")
+		->addComponent(_stereoRenderer)
+		->addComponent(_camera)
+		->addComponent(Transform::create());
 
 	_root = scene::Node::create("oculusvr");
-	_root->addChild(leftEye)->addChild(rightEye);
+	_root->addChild(eyes);
 
 	targets().front()->addChild(_root);
 
@@ -396,11 +431,10 @@ OculusVRCamera::setSceneManager(SceneManager::Ptr sceneManager)
 				->set("pixelOffset",			pixelOffset)
 				->set("scalePriorDistortion",	scalePriorDistortion)
 				->set("scaleAfterDistortion",	scaleAfterDistortion)
-				->set("leftEyeTexture",			leftEyeTexture)
+				->set("eyeTexture",				eyeTexture)
 				->set("leftLensCenter",			leftLensCenter)
 				->set("leftScreenCorner",		leftScreenCorner)
 				->set("leftScreenCenter",		leftScreenCenter)
-				->set("rightEyeTexture",		rightEyeTexture)
 				->set("rightLensCenter",		rightLensCenter)
 				->set("rightScreenCorner",		rightScreenCorner)
 				->set("rightScreenCenter",		rightScreenCenter),
@@ -416,6 +450,33 @@ OculusVRCamera::setSceneManager(SceneManager::Ptr sceneManager)
 	));
 }
 
+void
+OculusVRCamera::stereoRenderingBeginHandler(Renderer::Ptr renderer)
+{
+	// in eye space, the left eye sees the scene shifted to the right
+	const auto& view = _camera->data()->get<Matrix4x4::Ptr>("viewMatrix");
+
+	_leftView->lock()->copyFrom(view);
+	_rightView->lock()->copyFrom(view);
+
+	// the view of the head orientation used for the frame is rotated to the one sampled now:
+	// inverse(R_new * T * P) = inverse(R_old * T * P) * R_old * inverse(R_new)
+	if (_lateLatching && _ovrSensorFusion && _targetTransform)
+	{
+		const OVR::Quatf& measurement = _ovrSensorFusion->GetPredictedOrientation();
+
+		math::Quaternion::create(measurement.x, measurement.y, measurement.z, measurement.w)
+			->toMatrix(_lateOrientation);
+
+		_lateCorrection->lock()->copyFrom(_eyeOrientation)->append(_lateOrientation->transpose())->unlock();
+		_leftView->append(_lateCorrection);
+		_rightView->append(_lateCorrection);
+	}
+
+	_leftView->appendTranslation(+ _halfIPD, 0.0f, 0.0f)->unlock();
+	_rightView->appendTranslation(- _halfIPD, 0.0f, 0.0f)->unlock();
+}
+
 void
 OculusVRCamera::renderEndHandler(std::shared_ptr<SceneManager>	sceneManager,
 								 uint							frameId,
@@ -22,6 +22,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/Minko.hpp"
 #include "minko/Signal.hpp"
 #include "minko/render/AbstractContext.hpp"
+#include "minko/offscreen/OffscreenContext.hpp"
+#include "minko/offscreen/RenderService.hpp"
 
 #include <GL/osmesa.h>
 
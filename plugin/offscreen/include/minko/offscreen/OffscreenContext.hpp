@@ -0,0 +1,93 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include <GL/osmesa.h>
+
+namespace minko
+{
+	namespace offscreen
+	{
+		// an OSMesa context with its own back buffer: each thread of a process can render with its own one,
+		// as long as it is made current by that thread before being used
+		class OffscreenContext
+		{
+		public:
+			typedef std::shared_ptr<OffscreenContext>	Ptr;
+
+		private:
+			OSMesaContext								_offscreenContext;
+			std::unique_ptr<GLfloat[]>					_backBuffer;
+			uint										_width;
+			uint										_height;
+			std::shared_ptr<render::AbstractContext>	_context;
+
+		public:
+			// makes the new context current on the calling thread
+			inline static
+			Ptr
+			create(uint width, uint height)
+			{
+				if (width == 0 || height == 0)
+					throw std::invalid_argument("width and height must not be 0");
+
+				auto context = std::shared_ptr<OffscreenContext>(new OffscreenContext(width, height));
+
+				context->initialize();
+
+				return context;
+			}
+
+			~OffscreenContext();
+
+			inline
+			std::shared_ptr<render::AbstractContext>
+			context() const
+			{
+				return _context;
+			}
+
+			inline
+			uint
+			width() const
+			{
+				return _width;
+			}
+
+			inline
+			uint
+			height() const
+			{
+				return _height;
+			}
+
+			void
+			makeCurrent();
+
+		private:
+			OffscreenContext(uint width, uint height);
+
+			void
+			initialize();
+		};
+	}
+}
@@ -0,0 +1,177 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+#include "minko/async/ThreadPool.hpp"
+
+namespace minko
+{
+	namespace offscreen
+	{
+		// long-running offscreen rendering: the context, the scene manager and its asset library are kept
+		// from one job to the other, the jobs of a step are rendered in pooled render targets and read back
+		// asynchronously, their pixels are handed over to the encoding threads during the next step
+		class RenderService :
+			public std::enable_shared_from_this<RenderService>
+		{
+		public:
+			typedef std::shared_ptr<RenderService>	Ptr;
+
+			// executed by an encoding thread with the RGBA pixels of the job, top row first,
+			// ex: [=](const std::vector<unsigned char>& pixels, uint w, uint h) { writer->write(filename, pixels, w, h); }
+			typedef std::function<void(const std::vector<unsigned char>&, uint, uint)>	CompleteFunction;
+
+		private:
+			typedef std::shared_ptr<render::AbstractContext>	AbstractContextPtr;
+			typedef std::shared_ptr<scene::Node>				NodePtr;
+			typedef std::shared_ptr<render::Texture>			TexturePtr;
+
+			struct Job
+			{
+				NodePtr				scene;
+				uint				width;
+				uint				height;
+				CompleteFunction	complete;
+			};
+
+			struct Readback
+			{
+				Job					job;
+				TexturePtr			target;
+				uint				pixelBuffer;
+			};
+
+		private:
+			AbstractContextPtr									_context;
+			std::shared_ptr<component::SceneManager>			_sceneManager;
+			NodePtr												_root;
+			std::shared_ptr<render::RenderTargetPool>			_renderTargets;
+			async::ThreadPool::Ptr								_encoders;
+			uint												_maxJobsPerStep;
+			float												_time;
+			uint												_numRenderedJobs;
+			std::list<Job>										_jobs;
+			std::list<Readback>									_readbacks;
+			// available pixel buffers, by size in bytes
+			std::unordered_map<uint, std::list<uint>>			_pixelBuffers;
+
+		public:
+			inline static
+			Ptr
+			create(AbstractContextPtr context, uint numEncodingThreads = async::ThreadPool::defaultNumThreads())
+			{
+				if (!context)
+					throw std::invalid_argument("context");
+
+				auto service = std::shared_ptr<RenderService>(new RenderService(context, numEncodingThreads));
+
+				service->initialize();
+
+				return service;
+			}
+
+			~RenderService();
+
+			inline
+			AbstractContextPtr
+			context() const
+			{
+				return _context;
+			}
+
+			inline
+			std::shared_ptr<component::SceneManager>
+			sceneManager() const
+			{
+				return _sceneManager;
+			}
+
+			// shared by all the jobs: the assets are loaded once for the lifetime of the service
+			std::shared_ptr<file::AssetLibrary>
+			assets() const;
+
+			inline
+			uint
+			maxJobsPerStep() const
+			{
+				return _maxJobsPerStep;
+			}
+
+			inline
+			void
+			maxJobsPerStep(uint value)
+			{
+				if (value == 0)
+					throw std::invalid_argument("value");
+
+				_maxJobsPerStep = value;
+			}
+
+			inline
+			uint
+			numQueuedJobs() const
+			{
+				return _jobs.size();
+			}
+
+			inline
+			uint
+			numPendingReadbacks() const
+			{
+				return _readbacks.size();
+			}
+
+			inline
+			uint
+			numRenderedJobs() const
+			{
+				return _numRenderedJobs;
+			}
+
+			// the scene must hold a camera with a Renderer, it is added to the root of the service while rendered
+			void
+			queue(NodePtr scene, uint width, uint height, CompleteFunction complete);
+
+			// hands over the readbacks of the previous step to the encoding threads, then renders the next jobs
+			void
+			step();
+
+			// blocks until all the queued jobs are rendered and encoded
+			void
+			finish();
+
+		private:
+			RenderService(AbstractContextPtr context, uint numEncodingThreads);
+
+			void
+			initialize();
+
+			void
+			render(const Job& job);
+
+			void
+			encodeReadbacks();
+
+			uint
+			acquirePixelBuffer(uint size);
+		};
+	}
+}
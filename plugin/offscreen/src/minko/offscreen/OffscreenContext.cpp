@@ -0,0 +1,63 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/offscreen/OffscreenContext.hpp"
+
+#include "minko/render/OpenGLES2Context.hpp"
+
+using namespace minko;
+using namespace minko::offscreen;
+
+OffscreenContext::OffscreenContext(uint width, uint height) :
+	_offscreenContext(nullptr),
+	_backBuffer(new GLfloat[width * height * 4]),
+	_width(width),
+	_height(height),
+	_context(nullptr)
+{
+}
+
+void
+OffscreenContext::initialize()
+{
+	_offscreenContext = OSMesaCreateContextExt(GL_RGBA, 32, 0, 0, NULL);
+
+	if (!_offscreenContext)
+		throw std::runtime_error("Could not create offscreen context");
+
+	makeCurrent();
+
+	_context = render::OpenGLES2Context::create();
+}
+
+OffscreenContext::~OffscreenContext()
+{
+	// the GL resources are released while the context is still there
+	_context = nullptr;
+
+	if (_offscreenContext)
+		OSMesaDestroyContext(_offscreenContext);
+}
+
+void
+OffscreenContext::makeCurrent()
+{
+	if (!OSMesaMakeCurrent(_offscreenContext, _backBuffer.get(), GL_FLOAT, _width, _height))
+		throw std::runtime_error("Could not make offscreen context current");
+}
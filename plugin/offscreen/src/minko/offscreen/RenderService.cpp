@@ -0,0 +1,186 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/offscreen/RenderService.hpp"
+
+#include "minko/component/SceneManager.hpp"
+#include "minko/file/AssetLibrary.hpp"
+#include "minko/render/AbstractContext.hpp"
+#include "minko/render/RenderTargetPool.hpp"
+#include "minko/render/Texture.hpp"
+#include "minko/scene/Node.hpp"
+
+using namespace minko;
+using namespace minko::offscreen;
+
+static const float FRAME_TIME = 1000.f / 60.f; // milliseconds, only matters to the animations of the scenes
+
+RenderService::RenderService(AbstractContextPtr context, uint numEncodingThreads) :
+	_context(context),
+	_sceneManager(nullptr),
+	_root(nullptr),
+	_renderTargets(render::RenderTargetPool::create(context)),
+	_encoders(async::ThreadPool::create(numEncodingThreads)),
+	_maxJobsPerStep(16),
+	_time(0.f),
+	_numRenderedJobs(0),
+	_jobs(),
+	_readbacks(),
+	_pixelBuffers()
+{
+}
+
+void
+RenderService::initialize()
+{
+	_sceneManager = component::SceneManager::create(_context);
+	_root = scene::Node::create("root")->addComponent(_sceneManager);
+}
+
+RenderService::~RenderService()
+{
+	for (auto& readback : _readbacks)
+		_context->deletePixelBuffer(readback.pixelBuffer);
+
+	for (auto& sizeAndPixelBuffers : _pixelBuffers)
+		for (auto pixelBuffer : sizeAndPixelBuffers.second)
+			_context->deletePixelBuffer(pixelBuffer);
+
+	_renderTargets->clear();
+}
+
+std::shared_ptr<file::AssetLibrary>
+RenderService::assets() const
+{
+	return _sceneManager->assets();
+}
+
+void
+RenderService::queue(NodePtr scene, uint width, uint height, CompleteFunction complete)
+{
+	if (!scene)
+		throw std::invalid_argument("scene");
+	if (width == 0 || height == 0)
+		throw std::invalid_argument("width and height must not be 0");
+	if (!complete)
+		throw std::invalid_argument("complete");
+
+	Job job = { scene, width, height, complete };
+
+	_jobs.push_back(job);
+}
+
+void
+RenderService::step()
+{
+	// the GPU had a whole step to execute the readbacks, collecting them does not wait for it
+	encodeReadbacks();
+
+	// nothing is acquired anymore: disposes the render targets of the sizes that are not rendered anymore
+	_renderTargets->nextFrame();
+
+	for (uint i = 0; i < _maxJobsPerStep && !_jobs.empty(); ++i)
+	{
+		render(_jobs.front());
+		_jobs.pop_front();
+	}
+
+	_encoders->update();
+}
+
+void
+RenderService::finish()
+{
+	while (!_jobs.empty() || !_readbacks.empty())
+		step();
+
+	while (_encoders->waitForCompletion())
+		;
+}
+
+void
+RenderService::render(const Job& job)
+{
+	auto target = _renderTargets->acquire(job.width, job.height);
+
+	_root->addChild(job.scene);
+	_sceneManager->nextFrame(_time, FRAME_TIME, target);
+	_root->removeChild(job.scene);
+	_time += FRAME_TIME;
+
+	auto pixelBuffer = acquirePixelBuffer(job.width * job.height * 4);
+
+	_context->setRenderToTexture(target->id());
+	_context->readPixelsAsync(0, 0, job.width, job.height, pixelBuffer);
+	_context->setRenderToBackBuffer();
+
+	Readback readback = { job, target, pixelBuffer };
+
+	_readbacks.push_back(readback);
+	++_numRenderedJobs;
+}
+
+void
+RenderService::encodeReadbacks()
+{
+	for (auto& readback : _readbacks)
+	{
+		const auto	width	= readback.job.width;
+		const auto	height	= readback.job.height;
+		const auto	size	= width * height * 4;
+		auto		pixels	= std::make_shared<std::vector<unsigned char>>(size);
+		auto		complete	= readback.job.complete;
+
+		_context->pixelBufferData(readback.pixelBuffer, size, &(*pixels)[0]);
+		_pixelBuffers[size].push_back(readback.pixelBuffer);
+		_renderTargets->release(readback.target);
+
+		_encoders->run([=]()
+		{
+			// read back pixels start with the bottom row
+			const auto rowSize = width * 4;
+
+			for (uint y = 0; y < height / 2; ++y)
+				std::swap_ranges(
+					pixels->begin() + y * rowSize,
+					pixels->begin() + (y + 1) * rowSize,
+					pixels->begin() + (height - 1 - y) * rowSize
+				);
+
+			complete(*pixels, width, height);
+		});
+	}
+
+	_readbacks.clear();
+}
+
+uint
+RenderService::acquirePixelBuffer(uint size)
+{
+	auto& available = _pixelBuffers[size];
+
+	if (available.empty())
+		return _context->createPixelBuffer(size);
+
+	auto pixelBuffer = available.back();
+
+	available.pop_back();
+
+	return pixelBuffer;
+}
@@ -1,5 +1,9 @@
 #ifdef GL_ES
-	precision mediump float;
+	#if defined(GPU_SIMULATION)
+		precision highp float;
+	#else
+		precision mediump float;
+	#endif
 #endif
 
 attribute vec2	offset;
@@ -10,6 +14,10 @@ attribute float	time;
 attribute vec3	oldPosition;
 attribute float	rotation;
 attribute float	spriteIndex;
+attribute vec3	velocity;
+attribute vec3	force;
+attribute vec2	birth;
+attribute float	angularVelocity;
 
 uniform mat4	modelToWorldMatrix;
 uniform mat4	viewMatrix;
@@ -17,6 +25,7 @@ uniform mat4	projectionMatrix;
 uniform vec2	spritesheetSize;
 
 uniform float 	timeStep;
+uniform float	systemTime;
 uniform vec4	sizeOverTime;
 uniform	vec4	sizeBySpeed;
 
@@ -33,17 +42,33 @@ void main(void)
 	float	particleTime 		= 0.0;
 	float 	particleVelocity 	= 0.0;
 	vec3	particleColor		= vec3(1.0);
+	vec3	particlePosition	= position;
+	vec3	particleOldPosition	= oldPosition;
+	float	particleRotation	= rotation;
+
+	#if defined(GPU_SIMULATION)
+
+		// the attributes are only written when a particle is emitted, birth is (emission time, lifetime)
+		float	age	= systemTime - birth.x;
 
+		particlePosition	= position + age * (velocity + 0.5 * age * force);
+		particleOldPosition	= particlePosition - timeStep * (velocity + age * force);
+
+	#endif // defined(GPU_SIMULATION)
 
 	#if defined(PARTICLE_TIME)
 
 		particleTime = time;
 
+		#if defined(GPU_SIMULATION)
+			particleTime = age / max(birth.y, 1e-6);
+		#endif
+
 	#endif // defined(PARTICLE_TIME)
 
 	#if defined(PARTICLE_OLD_POSITION)
 
-		particleVelocity = particles_velocity(position, oldPosition, timeStep);
+		particleVelocity = particles_velocity(particlePosition, particleOldPosition, timeStep);
 
 	#endif // defined(PARTICLE_OLD_POSITION)
 
@@ -72,7 +97,7 @@ void main(void)
 	#endif // defined(SPRITE_SHEET)
 
 
-	vec4 pos = vec4(position, 1.0);
+	vec4 pos = vec4(particlePosition, 1.0);
 
 	#if !defined(WORLDSPACE_PARTICLES) && defined(MODEL_TO_WORLD)
 
@@ -87,7 +112,11 @@ void main(void)
 
 	#if defined(PARTICLE_ROTATION)
 
-		vec4 offXY_cos_sin = vec4(particleOffset.x, particleOffset.y, cos(rotation), sin(rotation)); // less temp registers !
+		#if defined(GPU_SIMULATION) && defined(PARTICLE_ANGULAR_VELOCITY)
+			particleRotation += angularVelocity * age;
+		#endif
+
+		vec4 offXY_cos_sin = vec4(particleOffset.x, particleOffset.y, cos(particleRotation), sin(particleRotation)); // less temp registers !
 
 		particleOffset.xy = vec2(
 			offXY_cos_sin.z * offXY_cos_sin.x - offXY_cos_sin.w * offXY_cos_sin.y, // cos * x - sin * y
@@ -133,4 +162,12 @@ void main(void)
 	vColor 		= particleColor;
 
 	gl_Position	= projectionMatrix * (pos + vec4(particleOffset, 0.0, 0.0));
+
+	#if defined(GPU_SIMULATION)
+
+		// dead particles are moved outside of the clip volume
+		if (age >= birth.y)
+			gl_Position = vec4(0.0, 0.0, 2.0, 1.0);
+
+	#endif // defined(GPU_SIMULATION)
 }
\ No newline at end of file
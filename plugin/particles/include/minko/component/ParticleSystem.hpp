@@ -76,6 +76,8 @@ namespace minko
 
 		private:
 			static const unsigned int 								    COUNT_LIMIT;
+			static const unsigned int									UPDATE_BLOCK_SIZE;
+			static const unsigned int									PARALLEL_MIN_NUM_PARTICLES;
 
 			GeometryPtr									                _geometry;
 			ParticlesProviderPtr						                _material;
@@ -98,6 +100,11 @@ namespace minko
 			float 										                _localToWorld[16];
 			bool										                _isZSorted;
 			float 										                _cameraCoords[3];
+			// viewpoint of the last sort, the order is kept until it moves further than _sortThreshold
+			float														_sortThreshold;
+			float														_sortedLocalToWorld[16];
+			float														_sortedCameraCoords[3];
+			bool														_invalidParticleOrder;
 			ParticleDistanceToCameraComparison			                _comparisonObject;
 			bool										                _useOldPosition;
 
@@ -108,6 +115,9 @@ namespace minko
 			FloatSamplerPtr 							                _emissionVelocity;
 
 			float										                _createTimer;
+			// the particles emitted during the current update, sampled by the shape in one batch
+			std::vector<unsigned int>									_spawnIndices;
+			std::vector<float>											_spawnTimes;
 
 			int											                _format;
 
@@ -116,6 +126,15 @@ namespace minko
 			bool										                _emitting;
 			float										                _time;
 
+			bool														_gpuSimulation;
+			float														_simulationTime;
+			bool														_invalidGpuParticles;
+			unsigned int												_streamsCapacity;
+			unsigned int												_streamsVertexSize;
+			// constant ForceOverTime and VelocityOverTime modifiers, added to each emitted particle
+			float														_gpuForce[3];
+			float														_gpuVelocity[3];
+
 			Signal<std::shared_ptr<SceneManager>, float, float>::Slot	_frameBeginSlot;
 			Signal<AbsCompPtr, NodePtr>::Slot			                _targetAddedSlot;
 			Signal<AbsCompPtr, NodePtr>::Slot			                _targetRemovedSlot;
@@ -237,6 +256,16 @@ namespace minko
                 return shared_from_this();
 			}
 
+			inline
+			bool
+			emitting() const
+			{
+				return _emitting;
+			}
+
+			unsigned int
+			numLiveParticles() const;
+
 			inline
 			Ptr
 			play()
@@ -280,6 +309,19 @@ namespace minko
 			fastForward(float           time,
 						unsigned int    updatesPerSecond = 0);
 
+			// same as fastForward(), but computes the state of each particle in closed form when all the updaters
+			// allow it: constant ForceOverTime and VelocityOverTime, or the ones evaluated by the vertex shader
+			void
+			prewarm(float			time,
+					unsigned int	updatesPerSecond = 0);
+
+			// the systems without closed form are fast-forwarded on several threads
+			static
+			void
+			prewarm(const std::vector<Ptr>&	systems,
+					float					time,
+					unsigned int			updatesPerSecond = 0);
+
 			void
 			reset();
 
@@ -300,9 +342,39 @@ namespace minko
 			Ptr
 			isZSorted(bool);
 
+			// particles are only sorted again once the camera or the emitter moved by more than value
+			inline
+			Ptr
+			zSortThreshold(float value)
+			{
+				_sortThreshold = value;
+
+				return shared_from_this();
+			}
+
+			inline
+			float
+			zSortThreshold() const
+			{
+				return _sortThreshold;
+			}
+
 			Ptr
 			useOldPosition(bool);
 
+			// particles are only written to the vertex buffer when they are emitted and move in the
+			// vertex shader, only the modifiers which can be evaluated there are supported and the
+			// particles cannot be z-sorted
+			Ptr
+			gpuSimulation(bool);
+
+			inline
+			bool
+			gpuSimulation() const
+			{
+				return _gpuSimulation;
+			}
+
         /**
 			inline
 			void
@@ -347,6 +419,9 @@ namespace minko
 			void
 			updateParticleDistancesToCamera();
 
+			void
+			sortParticles();
+
 		public:
 			inline
 			unsigned int
@@ -382,6 +457,13 @@ namespace minko
 						   const particle::shape::EmitterShape&	emitter,
 						   float								timeLived);
 
+			// emits the particles of _spawnIndices, with the shape sampled once for all of them
+			void
+			createParticles();
+
+			void
+			initParticle(particle::ParticleData& particle, float timeLived);
+
 			//void
 			//killParticle(unsigned int							particleIndex);
 
@@ -418,6 +500,49 @@ namespace minko
 			void
 			updateVertexBuffer();
 
+			void
+			initStreams();
+
+			void
+			simulate(float timeStep, bool emit);
+
+			bool
+			hasClosedForm() const;
+
+			void
+			advanceParticle(particle::ParticleData& particle, float time, float updateStep);
+
+			bool
+			sortViewpointMoved() const;
+
+			static inline
+			void
+			integrateParticle(particle::ParticleData& particle, float timeStep)
+			{
+				particle.rotation   += particle.startAngularVelocity * timeStep;
+
+				particle.startvx    += particle.startfx * timeStep;
+				particle.startvy    += particle.startfy * timeStep;
+				particle.startvz    += particle.startfz * timeStep;
+
+				particle.x          += particle.startvx * timeStep;
+				particle.y          += particle.startvy * timeStep;
+				particle.z          += particle.startvz * timeStep;
+			}
+
+			void
+			updateGpuSystem(float timeStep, bool emit);
+
+			void
+			writeGpuParticle(unsigned int particleIndex);
+
+			void
+			updateGpuModifiers();
+
+			static
+			bool
+			canBeSimulatedOnGpu(IUpdaterPtr updater);
+
 		protected:
 			ParticleSystem(AssetLibraryPtr,
 						   float					rate,
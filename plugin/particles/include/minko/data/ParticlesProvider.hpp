@@ -72,6 +72,12 @@ namespace minko
             bool
             isInWorldSpace() const;
 
+            Ptr
+            gpuSimulation(bool);
+
+            bool
+            gpuSimulation() const;
+
             Vector4Ptr
             diffuseColor() const;
 
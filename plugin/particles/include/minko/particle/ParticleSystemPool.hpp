@@ -0,0 +1,91 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "minko/ParticlesCommon.hpp"
+
+namespace minko
+{
+	namespace particle
+	{
+		// recycles the particle systems of short lived effects (sparks, impacts...): a released system
+		// keeps its geometry, modifiers and buffers and is played again by the next acquisition
+		class ParticleSystemPool :
+			public std::enable_shared_from_this<ParticleSystemPool>
+		{
+		public:
+			typedef std::shared_ptr<ParticleSystemPool>				Ptr;
+
+		private:
+			typedef std::shared_ptr<component::ParticleSystem>		ParticleSystemPtr;
+			typedef std::function<ParticleSystemPtr()>				Factory;
+
+		private:
+			Factory							_factory;
+			std::list<ParticleSystemPtr>	_available;
+			std::list<ParticleSystemPtr>	_acquired;
+
+		public:
+			inline static
+			Ptr
+			create(const Factory& factory)
+			{
+				if (!factory)
+					throw std::invalid_argument("factory");
+
+				return std::shared_ptr<ParticleSystemPool>(new ParticleSystemPool(factory));
+			}
+
+			inline
+			uint
+			numAcquired() const
+			{
+				return _acquired.size();
+			}
+
+			inline
+			uint
+			numAvailable() const
+			{
+				return _available.size();
+			}
+
+			// creates systems ahead of time so that acquiring them later does not allocate
+			void
+			reserve(uint numSystems);
+
+			// a playing and emitting system, to be added to a node by the caller
+			ParticleSystemPtr
+			acquire();
+
+			// removes the system from its targets and makes it available again
+			void
+			release(ParticleSystemPtr system);
+
+			// releases the acquired systems which stopped emitting and have no live particle left
+			void
+			releaseFinished();
+
+		private:
+			ParticleSystemPool(const Factory& factory);
+		};
+	}
+}
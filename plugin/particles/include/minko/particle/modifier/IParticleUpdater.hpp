@@ -34,9 +34,17 @@ namespace minko
 				typedef std::shared_ptr<IParticleUpdater> Ptr;
 
 			public:
+				inline
+				void
+				update(std::vector<ParticleData>& particles, float timeStep) const
+				{
+					update(particles, timeStep, 0, particles.size());
+				}
+
+				// only updates the particles in [begin, end), ranges can be updated concurrently
 				virtual
 				void
-				update(std::vector<ParticleData>&, float timeStep) const = 0;
+				update(std::vector<ParticleData>&, float timeStep, unsigned int begin, unsigned int end) const = 0;
 			};
 		}
 	}
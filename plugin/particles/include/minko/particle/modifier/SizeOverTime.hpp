@@ -54,7 +54,7 @@ namespace minko
 				};
 
 				void
-				update(std::vector<ParticleData>&, float) const;
+				update(std::vector<ParticleData>&, float timeStep, unsigned int begin, unsigned int end) const;
 
 				unsigned int
 				getNeededComponents() const;
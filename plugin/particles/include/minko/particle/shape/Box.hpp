@@ -87,6 +87,12 @@ namespace minko
 				void
 				initPosition(ParticleData& particle) const;
 
+				virtual
+				void
+				initPositions(std::vector<ParticleData>&		particles,
+							  const std::vector<unsigned int>&	indices,
+							  bool								direction) const;
+
 			protected:
 				Box(float	width,
 					float 	height,
@@ -91,6 +91,12 @@ namespace minko
 				void
 				initPosition(ParticleData& particle) const;
 
+				virtual
+				void
+				initPositions(std::vector<ParticleData>&		particles,
+							  const std::vector<unsigned int>&	indices,
+							  bool								direction) const;
+
 			private:
 				void
 				initParticle(ParticleData& particle,
@@ -76,6 +76,12 @@ namespace minko
 				void
 				initPosition(ParticleData& particle) const;
 
+				virtual
+				void
+				initPositions(std::vector<ParticleData>&		particles,
+							  const std::vector<unsigned int>&	indices,
+							  bool								direction) const;
+
 			protected:
 				Cylinder(float	height,
 						 float	radius,
@@ -42,6 +42,19 @@ namespace minko
 				void
 				initPosition(ParticleData& particle) const = 0;
 
+				// samples the particles[indices[i]] at once, with their direction when direction is true
+				virtual
+				void
+				initPositions(std::vector<ParticleData>&		particles,
+							  const std::vector<unsigned int>&	indices,
+							  bool								direction) const;
+
+			protected:
+				// numPerParticle random numbers for each of the numParticles particles
+				static
+				void
+				randoms(std::vector<float>& values, unsigned int numParticles, unsigned int numPerParticle);
+
 			private:
 				virtual
 				void
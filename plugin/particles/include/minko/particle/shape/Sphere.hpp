@@ -66,6 +66,12 @@ namespace minko
 				void
 				initPosition(ParticleData& particle) const;
 
+				virtual
+				void
+				initPositions(std::vector<ParticleData>&		particles,
+							  const std::vector<unsigned int>&	indices,
+							  bool								direction) const;
+
 			protected:
 				Sphere(float	radius,
 	  				   float 	innerRadius = 0);
@@ -19,8 +19,14 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #pragma once
 
-#include <random>
 #include <chrono>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+# define MINKO_PARTICLES_THREAD_LOCAL	__declspec(thread)
+#else
+# define MINKO_PARTICLES_THREAD_LOCAL	__thread
+#endif
 
 namespace minko
 {
@@ -28,15 +34,114 @@ namespace minko
 	{
 		namespace tools
 		{
+			// 4 independent xorshift128 generators stepped together so the compiler can keep them in one SIMD register;
+			// a POD so that each thread can own one
+			struct Xorshift4
+			{
+				static const unsigned int NUM_LANES = 4;
+
+				uint32_t	x[NUM_LANES];
+				uint32_t	y[NUM_LANES];
+				uint32_t	z[NUM_LANES];
+				uint32_t	w[NUM_LANES];
+				bool		seeded;
+
+				inline
+				void
+				seed(uint32_t value)
+				{
+					for (unsigned int lane = 0; lane < NUM_LANES; ++lane)
+					{
+						// splitmix32 to spread the seed over the lanes, a zero state would never leave zero
+						x[lane] = mix(value + lane * 4 + 0);
+						y[lane] = mix(value + lane * 4 + 1);
+						z[lane] = mix(value + lane * 4 + 2);
+						w[lane] = mix(value + lane * 4 + 3) | 1;
+					}
+					seeded = true;
+				}
+
+				inline
+				void
+				next(float* values)
+				{
+					for (unsigned int lane = 0; lane < NUM_LANES; ++lane)
+					{
+						const uint32_t t = x[lane] ^ (x[lane] << 11);
+
+						x[lane] = y[lane];
+						y[lane] = z[lane];
+						z[lane] = w[lane];
+						w[lane] = w[lane] ^ (w[lane] >> 19) ^ t ^ (t >> 8);
+
+						// the 24 high bits fit exactly in the mantissa, the values are in [0, 1)
+						values[lane] = (float)(w[lane] >> 8) * (1.0f / 16777216.0f);
+					}
+				}
+
+				static inline
+				uint32_t
+				mix(uint32_t value)
+				{
+					value += 0x9e3779b9u;
+					value = (value ^ (value >> 16)) * 0x85ebca6bu;
+					value = (value ^ (value >> 13)) * 0xc2b2ae35u;
+
+					return value ^ (value >> 16);
+				}
+			};
+
+			inline
+			Xorshift4&
+			generator()
+			{
+				static MINKO_PARTICLES_THREAD_LOCAL Xorshift4 threadGenerator;
+
+				if (!threadGenerator.seeded)
+					threadGenerator.seed((uint32_t)std::chrono::system_clock::now().time_since_epoch().count()
+						^ Xorshift4::mix((uint32_t)(uintptr_t)&threadGenerator));
+
+				return threadGenerator;
+			}
+
+			// fills values with numValues uniform numbers in [0, 1), much faster than calling rand01() for each one
+			inline
+			void
+			rand01(float* values, unsigned int numValues)
+			{
+				const unsigned int	numLanes	= Xorshift4::NUM_LANES;
+				auto&				random		= generator();
+				unsigned int		i			= 0;
+
+				for (; i + numLanes <= numValues; i += numLanes)
+					random.next(values + i);
+
+				if (i < numValues)
+				{
+					float last[numLanes];
+
+					random.next(last);
+					for (unsigned int j = 0; i < numValues; ++i, ++j)
+						values[i] = last[j];
+				}
+			}
+
+			// each thread draws from its own generator
 			inline
 			float
 			rand01()
 			{
-				static std::default_random_engine				generator((unsigned int)std::chrono::system_clock::now().time_since_epoch().count());
-				static std::uniform_real_distribution<float>	distribution (0.0f, 1.0f);
-			
-				return distribution(generator);
+				static MINKO_PARTICLES_THREAD_LOCAL float			values[Xorshift4::NUM_LANES];
+				static MINKO_PARTICLES_THREAD_LOCAL unsigned int	numValues;
+
+				if (numValues == 0)
+				{
+					generator().next(values);
+					numValues = Xorshift4::NUM_LANES;
+				}
+
+				return values[--numValues];
 			}
 		}
 	}
-}
\ No newline at end of file
+}
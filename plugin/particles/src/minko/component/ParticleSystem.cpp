@@ -36,16 +36,28 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/particle/modifier/IParticleModifier.hpp"
 #include "minko/particle/modifier/IParticleInitializer.hpp"
 #include "minko/particle/modifier/IParticleUpdater.hpp"
+#include "minko/particle/modifier/ForceOverTime.hpp"
+#include "minko/particle/modifier/VelocityOverTime.hpp"
+#include "minko/particle/modifier/ColorOverTime.hpp"
+#include "minko/particle/modifier/ColorBySpeed.hpp"
+#include "minko/particle/modifier/SizeOverTime.hpp"
+#include "minko/particle/modifier/SizeBySpeed.hpp"
 #include "minko/particle/shape/Sphere.hpp"
 #include "minko/particle/sampler/Sampler.hpp"
 #include "minko/particle/sampler/Constant.hpp"
+#include "minko/particle/sampler/RandomValue.hpp"
+#include "minko/particle/modifier/Modifier3.hpp"
+#include "minko/async/Parallel.hpp"
 #include "minko/particle/tools/VertexComponentFlags.hpp"
+#include "minko/Profiler.hpp"
 
 using namespace minko;
 using namespace minko::component;
 using namespace minko::particle;
 
 /*static*/ const unsigned int ParticleSystem::COUNT_LIMIT = 16384;
+/*static*/ const unsigned int ParticleSystem::UPDATE_BLOCK_SIZE = 256;
+/*static*/ const unsigned int ParticleSystem::PARALLEL_MIN_NUM_PARTICLES = 4096;
 
 ParticleSystem::ParticleSystem(AssetLibraryPtr		assets,
 							   float				rate,
@@ -64,6 +76,8 @@ ParticleSystem::ParticleSystem(AssetLibraryPtr		assets,
 	_particles			(),
 	_isInWorldSpace		(false),
 	_isZSorted			(false),
+	_sortThreshold		(0.f),
+	_invalidParticleOrder(true),
 	_useOldPosition		(false),
 	_rate				(1.0f / rate),
 	_lifetime			(lifetime			? lifetime			: sampler::Constant<float>::create(1.0f)),
@@ -71,13 +85,26 @@ ParticleSystem::ParticleSystem(AssetLibraryPtr		assets,
 	_emissionDirection	(emissionDirection),
 	_emissionVelocity	(emissionVelocity	? emissionVelocity	: sampler::Constant<float>::create(1.0f)),
 	_createTimer		(0.0f),
+	_spawnIndices		(),
+	_spawnTimes			(),
 	_format				(VertexComponentFlags::DEFAULT),
 	_updateStep			(0),
 	_playing			(false),
 	_emitting			(true),
 	_time				(0.0f),
+	_gpuSimulation		(false),
+	_simulationTime		(0.0f),
+	_invalidGpuParticles(false),
+	_streamsCapacity	(0),
+	_streamsVertexSize	(0),
     _frameBeginSlot     (nullptr)
 {
+	std::fill(_gpuForce, _gpuForce + 3, 0.f);
+	std::fill(_gpuVelocity, _gpuVelocity + 3, 0.f);
+	std::fill(_cameraCoords, _cameraCoords + 3, 0.f);
+	std::fill(_localToWorld, _localToWorld + 16, 0.f);
+	_localToWorld[0] = _localToWorld[5] = _localToWorld[10] = _localToWorld[15] = 1.f;
+
 	if (_effect == nullptr)
 		throw new std::logic_error("Effect 'particles' is not available in the asset library.");
 
@@ -173,6 +200,9 @@ ParticleSystem::frameBeginHandler(SceneManager::Ptr sceneManager, float time, fl
 	if (!_playing)
 		return;
 
+	// a playing system changes every frame
+	sceneManager->invalidate();
+
 	if (_isInWorldSpace)
 		_toWorld = targets()[0]->components<Transform>()[0];
 
@@ -203,6 +233,11 @@ ParticleSystem::frameBeginHandler(SceneManager::Ptr sceneManager, float time, fl
 ParticleSystem::Ptr
 ParticleSystem::add(ModifierPtr	modifier)
 {
+	auto updater = std::dynamic_pointer_cast<modifier::IParticleUpdater>(modifier);
+
+	if (_gpuSimulation && updater && !canBeSimulatedOnGpu(updater))
+		throw std::logic_error("This modifier cannot be evaluated when particles are simulated on the GPU.");
+
 	addComponents(modifier->getNeededComponents());
 
 	modifier->setProperties(_material);
@@ -219,7 +254,10 @@ ParticleSystem::add(ModifierPtr	modifier)
 	IUpdaterPtr u = std::dynamic_pointer_cast<modifier::IParticleUpdater> (modifier);
 
 	if (u != 0)
+	{
 		_updaters.push_back(u);
+		updateGpuModifiers();
+	}
 
     return shared_from_this();	
 }
@@ -256,6 +294,7 @@ ParticleSystem::remove(ModifierPtr	modifier)
 			{
 				_updaters.erase(it);
 				modifier->unsetProperties(_material);
+				updateGpuModifiers();
 				updateVertexFormat();
 
 				return shared_from_this();
@@ -319,58 +358,244 @@ ParticleSystem::fastForward(float time, unsigned int updatesPerSecond)
 	}
 }
 
+void
+ParticleSystem::prewarm(float time, unsigned int updatesPerSecond)
+{
+	if (_gpuSimulation || !hasClosedForm())
+	{
+		fastForward(time, updatesPerSecond);
+
+		return;
+	}
+
+	MINKO_PROFILE_SCOPE("ParticleSystem::prewarm");
+
+	const float updateStep = updatesPerSecond != 0 ? 1.f / updatesPerSecond : _updateStep;
+
+	for (auto& particle : _particles)
+		if (particle.alive())
+			advanceParticle(particle, time, updateStep);
+
+	if (!_emitting)
+		return;
+
+	// the k-th particle emitted during the prewarm is emitted at (k + 1) * rate - createTimer, the most
+	// recent ones are created first in case the dead particles cannot hold all the live ones
+	const float			elapsedTime	= _createTimer + time;
+	const unsigned int	numEmitted	= (unsigned int)(elapsedTime / _rate);
+	const float			maxLifetime	= _lifetime->max();
+
+	_createTimer = elapsedTime - numEmitted * _rate;
+
+	_spawnIndices.clear();
+	_spawnTimes.clear();
+
+	for (unsigned int emitted = 0, particleIndex = 0; emitted < numEmitted; ++emitted)
+	{
+		const float timeLived = _createTimer + emitted * _rate;
+
+		if (!(timeLived < maxLifetime))
+			break;
+
+		while (particleIndex < _particles.size() && _particles[particleIndex].alive())
+			++particleIndex;
+		if (particleIndex == _particles.size())
+			break;
+
+		_spawnIndices.push_back(particleIndex++);
+		_spawnTimes.push_back(0.f);
+	}
+
+	createParticles();
+
+	for (unsigned int i = 0; i < _spawnIndices.size(); ++i)
+	{
+		ParticleData& particle = _particles[_spawnIndices[i]];
+
+		particle.lifetime = _lifetime->value();
+
+		advanceParticle(particle, _createTimer + i * _rate, updateStep);
+	}
+
+	_material->set<float>("particles.timeStep", updateStep);
+}
+
+/*static*/
+void
+ParticleSystem::prewarm(const std::vector<Ptr>& systems, float time, unsigned int updatesPerSecond)
+{
+	std::vector<Ptr> simulatedSystems;
+
+	for (auto& system : systems)
+		if (system->_gpuSimulation || system->hasClosedForm())
+			system->prewarm(time, updatesPerSecond);
+		else
+			simulatedSystems.push_back(system);
+
+	if (simulatedSystems.empty())
+		return;
+
+#if defined(EMSCRIPTEN)
+	const unsigned int numWorkers = 1;
+#else
+	const unsigned int numWorkers = std::max(1u, std::thread::hardware_concurrency());
+#endif
+
+	// the random generators are per thread and the material is only touched back on the calling thread
+	async::runInParallel(simulatedSystems.size(), numWorkers, [&](unsigned int begin, unsigned int end, unsigned int)
+	{
+		for (auto systemIndex = begin; systemIndex < end; ++systemIndex)
+		{
+			auto&		system		= simulatedSystems[systemIndex];
+			const float	updateStep	= updatesPerSecond != 0 ? 1.f / updatesPerSecond : system->_updateStep;
+
+			for (float remainingTime = time; remainingTime > updateStep; remainingTime -= updateStep)
+				system->simulate(updateStep, system->_emitting);
+		}
+	});
+
+	for (auto& system : simulatedSystems)
+		system->_material->set<float>("particles.timeStep",
+			updatesPerSecond != 0 ? 1.f / updatesPerSecond : system->_updateStep);
+}
+
+bool
+ParticleSystem::hasClosedForm() const
+{
+	// constant forces and velocities, the other updaters that can run on the GPU do not move the particles
+	for (auto& updater : _updaters)
+		if (!canBeSimulatedOnGpu(updater))
+			return false;
+
+	return true;
+}
+
+void
+ParticleSystem::advanceParticle(ParticleData& particle, float time, float updateStep)
+{
+	// the sum of the semi-implicit Euler steps of integrateParticle() over time, ForceOverTime adds its force
+	// times the square of the step at each step
+	const float drift = 0.5f * (time * time + time * updateStep);
+
+	particle.x += (particle.startvx + _gpuVelocity[0] + _gpuForce[0] * updateStep) * time + particle.startfx * drift;
+	particle.y += (particle.startvy + _gpuVelocity[1] + _gpuForce[1] * updateStep) * time + particle.startfy * drift;
+	particle.z += (particle.startvz + _gpuVelocity[2] + _gpuForce[2] * updateStep) * time + particle.startfz * drift;
+
+	particle.startvx += particle.startfx * time;
+	particle.startvy += particle.startfy * time;
+	particle.startvz += particle.startfz * time;
+
+	particle.oldx = particle.x;
+	particle.oldy = particle.y;
+	particle.oldz = particle.z;
+
+	particle.rotation	+= particle.startAngularVelocity * time;
+	particle.timeLived	+= time;
+}
+
 void
 ParticleSystem::updateSystem(float timeStep, bool emit)
 {
+	if (_gpuSimulation)
+	{
+		updateGpuSystem(timeStep, emit);
+
+		return;
+	}
+
     _material->set<float>("particles.timeStep", timeStep);
 
+	simulate(timeStep, emit);
+}
+
+void
+ParticleSystem::simulate(float timeStep, bool emit)
+{
+	MINKO_PROFILE_SCOPE("ParticleSystem::updateSystem");
+
 	if (emit && _createTimer < _rate)
 		_createTimer += timeStep;
 
-	for (unsigned particleIndex = 0; particleIndex < _particles.size(); ++particleIndex)
-	{
-		ParticleData& particle = _particles[particleIndex];
+	const unsigned int numParticles = _particles.size();
 
-		if (particle.alive())
+#if defined(EMSCRIPTEN)
+	const unsigned int numWorkers = 1;
+#else
+	const unsigned int numWorkers = numParticles < PARALLEL_MIN_NUM_PARTICLES
+		? 1
+		: std::max(1u, std::thread::hardware_concurrency());
+#endif
+
+	// the live particles go through all the updaters one block at a time while it is still in cache
+	async::runInParallel(numParticles, numWorkers, [&](unsigned int begin, unsigned int end, unsigned int worker)
+	{
+		for (auto blockBegin = begin; blockBegin < end; blockBegin += UPDATE_BLOCK_SIZE)
 		{
-			particle.timeLived  += timeStep;
+			const auto blockEnd = std::min(blockBegin + UPDATE_BLOCK_SIZE, end);
+
+			for (auto particleIndex = blockBegin; particleIndex < blockEnd; ++particleIndex)
+			{
+				ParticleData& particle = _particles[particleIndex];
+
+				if (particle.alive())
+				{
+					particle.timeLived  += timeStep;
+
+					particle.oldx       = particle.x;
+					particle.oldy       = particle.y;
+					particle.oldz       = particle.z;
+				}
+			}
 
-			particle.oldx       = particle.x;
-			particle.oldy       = particle.y;
-			particle.oldz       = particle.z;
+			for (auto& updater : _updaters)
+				updater->update(_particles, timeStep, blockBegin, blockEnd);
 
-			//if (part)
-			//if (!(particle.timeLived < particle.lifetime))
-			//	killParticle(particleIndex);
+			for (auto particleIndex = blockBegin; particleIndex < blockEnd; ++particleIndex)
+				if (_particles[particleIndex].alive())
+					integrateParticle(_particles[particleIndex], timeStep);
 		}
+	});
+
+	// emitting samples the shape and the initializers, which are not thread safe
+	if (!emit)
+		return;
+
+	_spawnIndices.clear();
+	_spawnTimes.clear();
+
+	for (unsigned int particleIndex = 0; particleIndex < numParticles && !(_createTimer < _rate); ++particleIndex)
+	{
+		if (_particles[particleIndex].alive())
+			continue;
+
+		_createTimer -= _rate;
+
+		_spawnIndices.push_back(particleIndex);
+		_spawnTimes.push_back(_createTimer);
 	}
 
-	for (auto& updater : _updaters)
-		updater->update(_particles, timeStep);
+	createParticles();
 
-	for (unsigned particleIndex = 0; particleIndex < _particles.size(); ++particleIndex)
+	for (auto particleIndex : _spawnIndices)
 	{
 		ParticleData& particle = _particles[particleIndex];
-		
-		if (!particle.alive() && emit && !(_createTimer < _rate))
-		{
-			_createTimer -= _rate;
 
-			createParticle(particleIndex, *_shape, _createTimer);
+		particle.lifetime = _lifetime->value();
 
-			particle.lifetime = _lifetime->value();
-		}
-		
-		particle.rotation   += particle.startAngularVelocity * timeStep;
+		integrateParticle(particle, timeStep);
+	}
+}
 
-		particle.startvx    += particle.startfx * timeStep;
-		particle.startvy    += particle.startfy * timeStep;
-		particle.startvz    += particle.startfz * timeStep;
+unsigned int
+ParticleSystem::numLiveParticles() const
+{
+	unsigned int numLiveParticles = 0;
 
-		particle.x          += particle.startvx * timeStep;
-		particle.y          += particle.startvy * timeStep;
-		particle.z          += particle.startvz * timeStep;
-	}
+	for (auto& particle : _particles)
+		if (particle.alive())
+			++numLiveParticles;
+
+	return numLiveParticles;
 }
 
 void
@@ -380,34 +605,43 @@ ParticleSystem::createParticle(unsigned int 				particleIndex,
 {
 	ParticleData& particle = _particles[particleIndex];
 
-	if (_emissionDirection == StartDirection::NONE)
-	{
+	if (_emissionDirection == StartDirection::SHAPE)
+		shape.initPositionAndDirection(particle);
+	else
 		shape.initPosition(particle);
 
+	initParticle(particle, timeLived);
+}
+
+void
+ParticleSystem::createParticles()
+{
+	if (_spawnIndices.empty())
+		return;
+
+	_shape->initPositions(_particles, _spawnIndices, _emissionDirection == StartDirection::SHAPE);
+
+	for (unsigned int i = 0; i < _spawnIndices.size(); ++i)
+		initParticle(_particles[_spawnIndices[i]], _spawnTimes[i]);
+}
+
+void
+ParticleSystem::initParticle(ParticleData& particle, float timeLived)
+{
+	if (_emissionDirection == StartDirection::NONE)
+	{
 		particle.startvx 	= 0.0f;
 		particle.startvy 	= 0.0f;
 		particle.startvz 	= 0.0f;
 	}
-	else if (_emissionDirection == StartDirection::SHAPE)
-	{
-		shape.initPositionAndDirection(particle);
-	}
-	else if (_emissionDirection == StartDirection::RANDOM)
-	{
-		shape.initPosition(particle);
-	}
 	else if (_emissionDirection == StartDirection::UP)
 	{
-		shape.initPosition(particle);
-
 		particle.startvx 	= 0.f;
 		particle.startvy 	= 1.0f;
 		particle.startvz 	= 0.0f;
 	}
 	else if (_emissionDirection == StartDirection::OUTWARD)
 	{
-		shape.initPosition(particle);
-
 		particle.startvx 	= particle.x;
 		particle.startvy 	= particle.y;
 		particle.startvz 	= particle.z;
@@ -529,7 +763,7 @@ ParticleSystem::updateMaxParticlesCount()
 	//	}
 	//}
 	resizeParticlesVector();
-	_geometry->initStreams(_maxCount);
+	initStreams();
 }
 
 void
@@ -542,6 +776,7 @@ ParticleSystem::resizeParticlesVector()
 		_particleOrder.resize(_maxCount);
 		for (unsigned int i = 0; i < _particleOrder.size(); ++i)
 			_particleOrder[i] = i;
+		_invalidParticleOrder = true;
 	}
 	else
 	{
@@ -557,15 +792,26 @@ ParticleSystem::updateParticleDistancesToCamera()
 	{
 		const ParticleData& particle = _particles[i];
 
+		// dead particles are moved to the end of the order
+		if (!particle.alive())
+		{
+			_particleDistanceToCamera[i] = -1.f;
+			continue;
+		}
+
 		float x = particle.x;
 		float y = particle.y;
 		float z = particle.z;
 		
 		if (!_isInWorldSpace)
 		{
-			x = _localToWorld[0] * x + _localToWorld[4] * y + _localToWorld[8] * z + _localToWorld[12];
-			y = _localToWorld[1] * x + _localToWorld[5] * y + _localToWorld[9] * z + _localToWorld[13];
-			z = _localToWorld[2] * x + _localToWorld[6] * y + _localToWorld[10] * z + _localToWorld[14];
+			const float localX = x;
+			const float localY = y;
+			const float localZ = z;
+
+			x = _localToWorld[0] * localX + _localToWorld[4] * localY + _localToWorld[8] * localZ + _localToWorld[12];
+			y = _localToWorld[1] * localX + _localToWorld[5] * localY + _localToWorld[9] * localZ + _localToWorld[13];
+			z = _localToWorld[2] * localX + _localToWorld[6] * localY + _localToWorld[10] * localZ + _localToWorld[14];
 		}
 
 		float deltaX = _cameraCoords[0] - x;
@@ -576,12 +822,70 @@ ParticleSystem::updateParticleDistancesToCamera()
 	}
 }
 
+bool
+ParticleSystem::sortViewpointMoved() const
+{
+	for (unsigned int i = 0; i < 3; ++i)
+		if (fabsf(_cameraCoords[i] - _sortedCameraCoords[i]) > _sortThreshold)
+			return true;
+
+	if (!_isInWorldSpace)
+		for (unsigned int i = 0; i < 16; ++i)
+			if (fabsf(_localToWorld[i] - _sortedLocalToWorld[i]) > _sortThreshold)
+				return true;
+
+	return false;
+}
+
+void
+ParticleSystem::sortParticles()
+{
+	if (!_invalidParticleOrder && _sortThreshold > 0.f && !sortViewpointMoved())
+		return;
+
+	_invalidParticleOrder = false;
+	std::copy(_cameraCoords, _cameraCoords + 3, _sortedCameraCoords);
+	std::copy(_localToWorld, _localToWorld + 16, _sortedLocalToWorld);
+
+	updateParticleDistancesToCamera();
+
+	// the order of the previous frame is nearly sorted: insertion sort is linear until too many
+	// particles have swapped places, then the remaining part is fully sorted
+	const unsigned int	numParticles	= _particleOrder.size();
+	const unsigned int	maxNumMoves		= numParticles << 3;
+	unsigned int		numMoves		= 0;
+
+	for (unsigned int i = 1; i < numParticles; ++i)
+	{
+		const unsigned int	particleIndex	= _particleOrder[i];
+		const float			distance		= _particleDistanceToCamera[particleIndex];
+		unsigned int		j				= i;
+
+		while (j > 0 && _particleDistanceToCamera[_particleOrder[j - 1]] < distance)
+		{
+			_particleOrder[j] = _particleOrder[j - 1];
+			--j;
+			++numMoves;
+		}
+		_particleOrder[j] = particleIndex;
+
+		if (numMoves > maxNumMoves)
+		{
+			std::sort(_particleOrder.begin(), _particleOrder.end(), _comparisonObject);
+
+			return;
+		}
+	}
+}
+
 void
 ParticleSystem::reset()
 {
 	for (auto& particle : _particles)
 		particle.kill();
 
+	_invalidGpuParticles = _gpuSimulation;
+
 	//if (_liveCount == 0)
 	//	return;
 
@@ -596,14 +900,18 @@ void
 ParticleSystem::addComponents(unsigned int components, bool blockVSInit)
 {
     typedef std::tuple<std::string, VertexComponentFlags, unsigned int> ComponentInfo;
-    static const std::array<ComponentInfo, 6> OPTIONAL_COMPONENTS = 
+    static const std::array<ComponentInfo, 10> OPTIONAL_COMPONENTS = 
     {
-        std::make_tuple("size",          VertexComponentFlags::SIZE,            1),
-        std::make_tuple("color",         VertexComponentFlags::COLOR,           3),
-        std::make_tuple("time",          VertexComponentFlags::TIME,            1),
-        std::make_tuple("oldPosition",   VertexComponentFlags::OLD_POSITION,    3),
-        std::make_tuple("rotation",      VertexComponentFlags::ROTATION,        1),
-        std::make_tuple("spriteIndex",   VertexComponentFlags::SPRITE_INDEX,    1)
+        std::make_tuple("size",             VertexComponentFlags::SIZE,            1),
+        std::make_tuple("color",            VertexComponentFlags::COLOR,           3),
+        std::make_tuple("time",             VertexComponentFlags::TIME,            1),
+        std::make_tuple("oldPosition",      VertexComponentFlags::OLD_POSITION,    3),
+        std::make_tuple("rotation",         VertexComponentFlags::ROTATION,        1),
+        std::make_tuple("spriteIndex",      VertexComponentFlags::SPRITE_INDEX,    1),
+        std::make_tuple("velocity",         VertexComponentFlags::VELOCITY,        3),
+        std::make_tuple("force",            VertexComponentFlags::FORCE,           3),
+        std::make_tuple("birth",            VertexComponentFlags::BIRTH,           2),
+        std::make_tuple("angularVelocity",  VertexComponentFlags::ANG_VELOCITY,    1)
     };
     
 	if (_format == components)
@@ -643,7 +951,7 @@ ParticleSystem::addComponents(unsigned int components, bool blockVSInit)
     _geometry->addVertexBuffer(vertexBuffer);
 
 	if (!blockVSInit)
-		_geometry->initStreams(_maxCount);
+		initStreams();
 }
 
 unsigned int
@@ -675,8 +983,15 @@ ParticleSystem::updateVertexFormat()
 
 	if (_useOldPosition)
 		addComponents(VertexComponentFlags::OLD_POSITION, true);
+
+	if (_gpuSimulation)
+		addComponents(
+			VertexComponentFlags::VELOCITY | VertexComponentFlags::FORCE | VertexComponentFlags::BIRTH
+			| ((_format & VertexComponentFlags::ROTATION) ? VertexComponentFlags::ANG_VELOCITY : 0),
+			true
+		);
 	
-	_geometry->initStreams(_maxCount);
+	initStreams();
 
 	return _format;
 }
@@ -687,11 +1002,29 @@ ParticleSystem::updateVertexBuffer()
 	//if (_liveCount == 0)
 	//	return;
 
-	if (_isZSorted)
+	if (_gpuSimulation)
 	{
-		updateParticleDistancesToCamera();
-		std::sort(_particleOrder.begin(), _particleOrder.end(), _comparisonObject);
+		if (_invalidGpuParticles)
+		{
+			for (unsigned int particleIndex = 0; particleIndex < _maxCount; ++particleIndex)
+				writeGpuParticle(particleIndex);
+			_invalidGpuParticles = false;
+		}
+
+		_geometry->particleVertices()->uploadDirty();
+
+		// dead particles are discarded by the vertex shader, all of them are drawn
+		if (_previousLiveCount != _maxCount)
+		{
+			_geometry->indices()->upload();
+			_previousLiveCount = _maxCount;
+		}
+
+		return;
 	}
+
+	if (_isZSorted)
+		sortParticles();
 	
 	std::vector<float>&	vsData			= _geometry->particleVertices()->data();
 	float*				vertexIterator	= &(*vsData.begin());
@@ -770,6 +1103,9 @@ ParticleSystem::isInWorldSpace(bool value)
 ParticleSystem::Ptr
 ParticleSystem::isZSorted(bool value)
 {
+	if (value && _gpuSimulation)
+		throw std::logic_error("Particles simulated on the GPU cannot be z-sorted.");
+
 	_isZSorted = value;
 
 	resizeParticlesVector();
@@ -787,4 +1123,202 @@ ParticleSystem::useOldPosition(bool value)
     }
 
     return std::static_pointer_cast<ParticleSystem>(shared_from_this());
-};
\ No newline at end of file
+};
+
+ParticleSystem::Ptr
+ParticleSystem::gpuSimulation(bool value)
+{
+	if (value == _gpuSimulation)
+		return shared_from_this();
+
+	if (value)
+	{
+		if (_isZSorted)
+			throw std::logic_error("Particles simulated on the GPU cannot be z-sorted.");
+
+		for (auto& updater : _updaters)
+			if (!canBeSimulatedOnGpu(updater))
+				throw std::logic_error("Some modifiers cannot be evaluated when particles are simulated on the GPU.");
+	}
+
+	_gpuSimulation = value;
+	_simulationTime = 0.f;
+	_material->gpuSimulation(value);
+	_material->set<float>("particles.time", 0.f);
+	_geometry->particleVertices()->usage(value ? render::BufferUsage::DYNAMIC : render::BufferUsage::STREAM);
+	_previousLiveCount = 0;
+
+	updateGpuModifiers();
+	updateVertexFormat();
+	reset();
+
+	return shared_from_this();
+}
+
+void
+ParticleSystem::initStreams()
+{
+	const unsigned int vertexSize = _geometry->vertexSize();
+
+	// streams only grow so that changing the rate or the lifetime of a (pooled) system does not
+	// reallocate them, except on the GPU where every particle of the vertex buffer is drawn
+	if (_gpuSimulation || _maxCount > _streamsCapacity || vertexSize != _streamsVertexSize)
+	{
+		_geometry->initStreams(_maxCount);
+		_streamsCapacity = _maxCount;
+		_streamsVertexSize = vertexSize;
+	}
+
+	// the vertex layout or the number of particles changed
+	_invalidGpuParticles = _gpuSimulation;
+}
+
+/*static*/
+bool
+ParticleSystem::canBeSimulatedOnGpu(IUpdaterPtr updater)
+{
+	typedef sampler::Constant<float> ConstantSampler;
+
+	auto force		= std::dynamic_pointer_cast<modifier::ForceOverTime>(updater);
+	auto velocity	= std::dynamic_pointer_cast<modifier::VelocityOverTime>(updater);
+
+	if (force)
+		return std::dynamic_pointer_cast<ConstantSampler>(force->x())
+			&& std::dynamic_pointer_cast<ConstantSampler>(force->y())
+			&& std::dynamic_pointer_cast<ConstantSampler>(force->z());
+	if (velocity)
+		return std::dynamic_pointer_cast<ConstantSampler>(velocity->x())
+			&& std::dynamic_pointer_cast<ConstantSampler>(velocity->y())
+			&& std::dynamic_pointer_cast<ConstantSampler>(velocity->z());
+
+	// evaluated in the vertex shader already
+	return std::dynamic_pointer_cast<modifier::ColorOverTime>(updater)
+		|| std::dynamic_pointer_cast<modifier::ColorBySpeed>(updater)
+		|| std::dynamic_pointer_cast<modifier::SizeOverTime>(updater)
+		|| std::dynamic_pointer_cast<modifier::SizeBySpeed>(updater);
+}
+
+void
+ParticleSystem::updateGpuModifiers()
+{
+	std::fill(_gpuForce, _gpuForce + 3, 0.f);
+	std::fill(_gpuVelocity, _gpuVelocity + 3, 0.f);
+
+	for (auto& updater : _updaters)
+	{
+		auto force		= std::dynamic_pointer_cast<modifier::ForceOverTime>(updater);
+		auto velocity	= std::dynamic_pointer_cast<modifier::VelocityOverTime>(updater);
+
+		if (force)
+		{
+			_gpuForce[0] += force->x()->value();
+			_gpuForce[1] += force->y()->value();
+			_gpuForce[2] += force->z()->value();
+		}
+		else if (velocity)
+		{
+			_gpuVelocity[0] += velocity->x()->value();
+			_gpuVelocity[1] += velocity->y()->value();
+			_gpuVelocity[2] += velocity->z()->value();
+		}
+	}
+}
+
+void
+ParticleSystem::updateGpuSystem(float timeStep, bool emit)
+{
+	_material->set<float>("particles.timeStep", timeStep);
+
+	if (emit && _createTimer < _rate)
+		_createTimer += timeStep;
+
+	_simulationTime += timeStep;
+	_material->set<float>("particles.time", _simulationTime);
+
+	_spawnIndices.clear();
+	_spawnTimes.clear();
+
+	for (unsigned particleIndex = 0; particleIndex < _particles.size(); ++particleIndex)
+	{
+		ParticleData& particle = _particles[particleIndex];
+
+		if (particle.alive())
+			particle.timeLived += timeStep;
+		else if (emit && !(_createTimer < _rate))
+		{
+			_createTimer -= _rate;
+
+			_spawnIndices.push_back(particleIndex);
+			_spawnTimes.push_back(_createTimer);
+		}
+	}
+
+	createParticles();
+
+	for (auto particleIndex : _spawnIndices)
+	{
+		_particles[particleIndex].lifetime = _lifetime->value();
+
+		writeGpuParticle(particleIndex);
+	}
+}
+
+void
+ParticleSystem::writeGpuParticle(unsigned int particleIndex)
+{
+	const ParticleData&	particle		= _particles[particleIndex];
+	auto				vertexBuffer	= _geometry->particleVertices();
+
+	if (((particleIndex + 1) << 2) > vertexBuffer->numVertices())
+		return;
+
+	float*			vertexIterator	= &vertexBuffer->data()[(particleIndex << 2) * _geometry->vertexSize()];
+	unsigned int	i				= 5;
+
+	setInVertexBuffer(vertexIterator, 2, particle.x);
+	setInVertexBuffer(vertexIterator, 3, particle.y);
+	setInVertexBuffer(vertexIterator, 4, particle.z);
+
+	if (_format & VertexComponentFlags::SIZE)
+		setInVertexBuffer(vertexIterator, i++, particle.size);
+
+	if (_format & VertexComponentFlags::COLOR)
+	{
+		setInVertexBuffer(vertexIterator, i++, particle.r);
+		setInVertexBuffer(vertexIterator, i++, particle.g);
+		setInVertexBuffer(vertexIterator, i++, particle.b);
+	}
+
+	// time and old position are computed by the vertex shader
+	if (_format & VertexComponentFlags::TIME)
+		setInVertexBuffer(vertexIterator, i++, 0.f);
+
+	if (_format & VertexComponentFlags::OLD_POSITION)
+	{
+		setInVertexBuffer(vertexIterator, i++, particle.x);
+		setInVertexBuffer(vertexIterator, i++, particle.y);
+		setInVertexBuffer(vertexIterator, i++, particle.z);
+	}
+
+	if (_format & VertexComponentFlags::ROTATION)
+		setInVertexBuffer(vertexIterator, i++, particle.rotation);
+
+	if (_format & VertexComponentFlags::SPRITE_INDEX)
+		setInVertexBuffer(vertexIterator, i++, particle.spriteIndex);
+
+	setInVertexBuffer(vertexIterator, i++, particle.startvx + _gpuVelocity[0]);
+	setInVertexBuffer(vertexIterator, i++, particle.startvy + _gpuVelocity[1]);
+	setInVertexBuffer(vertexIterator, i++, particle.startvz + _gpuVelocity[2]);
+
+	setInVertexBuffer(vertexIterator, i++, particle.startfx + _gpuForce[0]);
+	setInVertexBuffer(vertexIterator, i++, particle.startfy + _gpuForce[1]);
+	setInVertexBuffer(vertexIterator, i++, particle.startfz + _gpuForce[2]);
+
+	setInVertexBuffer(vertexIterator, i++, _simulationTime - particle.timeLived);
+	setInVertexBuffer(vertexIterator, i++, particle.alive() ? particle.lifetime : 0.f);
+
+	if (_format & VertexComponentFlags::ANG_VELOCITY)
+		setInVertexBuffer(vertexIterator, i++, particle.startAngularVelocity);
+
+	vertexBuffer->markDirty(particleIndex << 2, 4);
+}
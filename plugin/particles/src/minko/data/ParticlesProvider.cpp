@@ -37,6 +37,7 @@ void
 ParticlesProvider::initialize()
 {
     set<float>("particles.timeStep", 0.0f);
+    set<float>("particles.time", 0.0f);
     diffuseColor(0xffffffff);
 }
 
@@ -111,6 +112,23 @@ ParticlesProvider::isInWorldSpace() const
     return hasProperty("particles.worldspace");
 }
 
+ParticlesProvider::Ptr
+ParticlesProvider::gpuSimulation(bool value)
+{
+    if (value)
+        set<bool>("particles.gpuSimulation", true);
+    else if (hasProperty("particles.gpuSimulation"))
+        unset("particles.gpuSimulation");
+
+    return std::static_pointer_cast<ParticlesProvider>(shared_from_this());
+}
+
+bool
+ParticlesProvider::gpuSimulation() const
+{
+    return hasProperty("particles.gpuSimulation");
+}
+
 Vector4::Ptr
 ParticlesProvider::diffuseColor() const
 {
@@ -0,0 +1,89 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/particle/ParticleSystemPool.hpp"
+
+#include "minko/component/ParticleSystem.hpp"
+#include "minko/scene/Node.hpp"
+
+using namespace minko;
+using namespace minko::particle;
+using namespace minko::component;
+
+ParticleSystemPool::ParticleSystemPool(const Factory& factory) :
+	_factory(factory),
+	_available(),
+	_acquired()
+{
+}
+
+void
+ParticleSystemPool::reserve(uint numSystems)
+{
+	while (_available.size() + _acquired.size() < numSystems)
+		_available.push_back(_factory());
+}
+
+ParticleSystem::Ptr
+ParticleSystemPool::acquire()
+{
+	if (_available.empty())
+		_available.push_back(_factory());
+
+	// the list node is moved along with the system
+	_acquired.splice(_acquired.end(), _available, _available.begin());
+
+	auto system = _acquired.back();
+
+	system->emitting(true);
+	system->play();
+
+	return system;
+}
+
+void
+ParticleSystemPool::release(ParticleSystem::Ptr system)
+{
+	auto systemIt = std::find(_acquired.begin(), _acquired.end(), system);
+
+	if (systemIt == _acquired.end())
+		throw std::invalid_argument("system");
+
+	auto targets = system->targets();
+
+	for (auto& target : targets)
+		target->removeComponent(system);
+
+	system->stop();
+
+	_available.splice(_available.end(), _acquired, systemIt);
+}
+
+void
+ParticleSystemPool::releaseFinished()
+{
+	for (auto systemIt = _acquired.begin(); systemIt != _acquired.end();)
+	{
+		auto system = *systemIt++;
+
+		if (!system->emitting() && system->numLiveParticles() == 0)
+			release(system);
+	}
+}
@@ -44,7 +44,7 @@ ColorBySpeed::ColorBySpeed(LinearlyInterpolatedValue<math::Vector3>::Ptr color):
 }
 
 void
-ColorBySpeed::update(std::vector<ParticleData>&, float) const
+ColorBySpeed::update(std::vector<ParticleData>&, float, unsigned int, unsigned int) const
 {
 
 }
@@ -37,11 +37,16 @@ ForceOverTime::ForceOverTime(SamplerPtr fx,
 
 void
 ForceOverTime::update(std::vector<ParticleData>& 	particles,
-		 		   	  float							timeStep) const
+		 		   	  float							timeStep,
+					  unsigned int					begin,
+					  unsigned int					end) const
 {
 	float sqTime = timeStep * timeStep;
 
-	for (auto& particle : particles)
+	for (auto particleIndex = begin; particleIndex < end; ++particleIndex)
+	{
+		auto& particle = particles[particleIndex];
+
         if (particle.alive())
 		    {
                 const float t = particle.lifetime > 0.0f 
@@ -52,6 +57,7 @@ ForceOverTime::update(std::vector<ParticleData>& 	particles,
 			    particle.y += _y->value(t) * sqTime;
 			    particle.z += _z->value(t) * sqTime;
 		    }
+	}
 }
 
 
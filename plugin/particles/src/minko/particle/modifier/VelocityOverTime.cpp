@@ -37,9 +37,14 @@ VelocityOverTime::VelocityOverTime(SamplerPtr vx,
 
 void
 VelocityOverTime::update(std::vector<ParticleData>& particles,
-		 		   		 float                      timeStep) const
+		 		   		 float                      timeStep,
+						 unsigned int				begin,
+						 unsigned int				end) const
 {
-	for (auto& particle : particles)
+	for (auto particleIndex = begin; particleIndex < end; ++particleIndex)
+	{
+		auto& particle = particles[particleIndex];
+
     	if (particle.alive())
 	    	{
                 const float t = particle.lifetime > 0.0f
@@ -54,6 +59,7 @@ VelocityOverTime::update(std::vector<ParticleData>& particles,
 			    particle.y += dy;
 			    particle.z += dz;
 		    }
+	}
 }
 
 
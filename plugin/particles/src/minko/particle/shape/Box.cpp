@@ -52,3 +52,40 @@ Box::initPosition(ParticleData& particle) const
 	}
 }
 
+void
+Box::initPositions(std::vector<ParticleData>&		particles,
+                   const std::vector<unsigned int>&	indices,
+                   bool								direction) const
+{
+	const unsigned int numParticles = indices.size();
+	std::vector<float> values;
+
+	randoms(values, numParticles, 3);
+
+	const float* random = values.data();
+
+	for (unsigned int i = 0; i < numParticles; ++i, random += 3)
+	{
+		ParticleData& particle = particles[indices[i]];
+
+		if (_limitToSides)
+		{
+			particle.x = (random[0] < 0.5f ? -_width : _width) * 0.5f;
+			particle.y = (random[1] < 0.5f ? -_height : _height) * 0.5f;
+			particle.z = (random[2] < 0.5f ? -_length : _length) * 0.5f;
+		}
+		else
+		{
+			particle.x = (random[0] - 0.5f) * _width;
+			particle.y = (random[1] - 0.5f) * _height;
+			particle.z = (random[2] - 0.5f) * _length;
+		}
+
+		if (direction)
+		{
+			particle.startvx = particle.x;
+			particle.startvy = particle.y;
+			particle.startvz = particle.z;
+		}
+	}
+}
@@ -81,4 +81,44 @@ Cone::initParticle(ParticleData& particle,
 	particle.z = r * sinTheta;
 }
 
+void
+Cone::initPositions(std::vector<ParticleData>&		particles,
+                    const std::vector<unsigned int>&	indices,
+                    bool								direction) const
+{
+	const unsigned int numParticles = indices.size();
+	std::vector<float> values;
+
+	randoms(values, numParticles, 4);
+
+	const float* random = values.data();
+
+	for (unsigned int i = 0; i < numParticles; ++i, random += 4)
+	{
+		ParticleData& particle = particles[indices[i]];
+
+		float theta		= (random[0] * 2.f - 1.f) * (float)PI;
+		float cosTheta	= cosf(theta);
+		float sinTheta	= sinf(theta);
+		float r			= _innerRadius + sqrtf(random[1]) * (_baseRadius - _innerRadius);
 
+		r = random[2] > .5f ? r : -r;
+
+		float angle		= _angle * r / _baseRadius;
+		float height	= random[3] * _length * cosf(angle);
+		float spread	= height * tanf(angle);
+
+		if (direction)
+		{
+			particle.startvx = spread * cosTheta;
+			particle.startvy = height;
+			particle.startvz = spread * sinTheta;
+		}
+
+		r += spread;
+
+		particle.x = r * cosTheta;
+		particle.y = height;
+		particle.z = r * sinTheta;
+	}
+}
@@ -51,4 +51,36 @@ Cylinder::initPosition(ParticleData& particle) const
 	particle.z = r * sinTheta;
 }
 
+void
+Cylinder::initPositions(std::vector<ParticleData>&		particles,
+                        const std::vector<unsigned int>&	indices,
+                        bool								direction) const
+{
+	const unsigned int numParticles = indices.size();
+	std::vector<float> values;
+
+	randoms(values, numParticles, 4);
+
+	const float* random = values.data();
+
+	for (unsigned int i = 0; i < numParticles; ++i, random += 4)
+	{
+		ParticleData& particle = particles[indices[i]];
 
+		float theta		= (random[0] * 2.f - 1.f) * (float)PI;
+		float r			= _innerRadius + sqrtf(random[1]) * (_radius - _innerRadius);
+
+		r = random[2] > .5f ? r : -r;
+
+		particle.x = r * cosf(theta);
+		particle.y = random[3] * _height;
+		particle.z = r * sinf(theta);
+
+		if (direction)
+		{
+			particle.startvx = particle.x;
+			particle.startvy = particle.y;
+			particle.startvz = particle.z;
+		}
+	}
+}
@@ -38,3 +38,25 @@ EmitterShape::initDirection(ParticleData& particle) const
 	particle.startvy 	= particle.y;
 	particle.startvz 	= particle.z;
 }
+
+void
+EmitterShape::initPositions(std::vector<ParticleData>&			particles,
+							const std::vector<unsigned int>&	indices,
+							bool								direction) const
+{
+	for (auto index : indices)
+		if (direction)
+			initPositionAndDirection(particles[index]);
+		else
+			initPosition(particles[index]);
+}
+
+/*static*/
+void
+EmitterShape::randoms(std::vector<float>& values, unsigned int numParticles, unsigned int numPerParticle)
+{
+	values.resize(numParticles * numPerParticle);
+
+	if (!values.empty())
+		tools::rand01(&values[0], values.size());
+}
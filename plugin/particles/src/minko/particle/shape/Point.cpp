@@ -37,3 +37,25 @@ Point::initPosition(ParticleData& particle) const
 	particle.y = 0;
 	particle.z = 0;
 }
+
+void
+Point::initPositions(std::vector<ParticleData>&		particles,
+                     const std::vector<unsigned int>&	indices,
+                     bool								direction) const
+{
+	for (auto index : indices)
+	{
+		ParticleData& particle = particles[index];
+
+		particle.x = 0;
+		particle.y = 0;
+		particle.z = 0;
+
+		if (direction)
+		{
+			particle.startvx = 0;
+			particle.startvy = 0;
+			particle.startvz = 0;
+		}
+	}
+}
@@ -52,5 +52,38 @@ Sphere::initPosition(ParticleData& particle) const
 	particle.z = r * u;
 }
 
+void
+Sphere::initPositions(std::vector<ParticleData>&		particles,
+                      const std::vector<unsigned int>&	indices,
+                      bool								direction) const
+{
+	const unsigned int numParticles = indices.size();
+	std::vector<float> values;
+
+	randoms(values, numParticles, 4);
+
+	const float* random = values.data();
 
+	for (unsigned int i = 0; i < numParticles; ++i, random += 4)
+	{
+		ParticleData& particle = particles[indices[i]];
 
+		float u			= random[0];
+		float sqrt1mu2	= sqrtf(1.0f - u * u);
+		float theta		= (random[1] * 2.0f - 1.0f) * (float)PI;
+		float r			= _innerRadius + sqrtf(random[2]) * (_radius - _innerRadius);
+
+		r = random[3] > 0.5f ? r : -r;
+
+		particle.x = r * sqrt1mu2 * cosf(theta);
+		particle.y = r * sqrt1mu2 * sinf(theta);
+		particle.z = r * u;
+
+		if (direction)
+		{
+			particle.startvx = particle.x;
+			particle.startvy = particle.y;
+			particle.startvz = particle.z;
+		}
+	}
+}
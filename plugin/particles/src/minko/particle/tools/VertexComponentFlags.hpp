@@ -32,7 +32,11 @@ namespace minko
 			OLD_POSITION	= (0x1 << 3),
 			ROTATION		= (0x1 << 4),
 			ANG_VELOCITY	= (0x1 << 5),
-			SPRITE_INDEX	= (0x1 << 6)
+			SPRITE_INDEX	= (0x1 << 6),
+			// only used when the particles are simulated on the GPU
+			VELOCITY		= (0x1 << 7),
+			FORCE			= (0x1 << 8),
+			BIRTH			= (0x1 << 9)
 		};
 	}
 }
\ No newline at end of file
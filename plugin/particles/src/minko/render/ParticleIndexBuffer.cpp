@@ -38,7 +38,7 @@ using namespace minko::render;
 void 
 ParticleIndexBuffer::resize(unsigned int nParticles)
 {	
-	std::vector<unsigned short>& isData = data();
+	std::vector<uint>& isData = data();
 	unsigned int oldSize = isData.size();
 	unsigned int size = nParticles * 6;
 
@@ -34,7 +34,7 @@ namespace minko
 			typedef std::shared_ptr<ParticleIndexBuffer>	Ptr;
 			
 		private:
-			std::vector<unsigned short> _padding;
+			std::vector<uint> _padding;
 
 		public:
 			inline static
@@ -53,7 +53,7 @@ namespace minko
 
 		private:
 			ParticleIndexBuffer(std::shared_ptr<render::AbstractContext>	context) :
-				IndexBuffer(context, std::vector<unsigned short> (6)),
+				IndexBuffer(context, std::vector<uint> (6)),
 				_padding (6, 0)
 			{
 			}
@@ -35,6 +35,9 @@ ParticleVertexBuffer::initialize()
 {
 	addAttribute("offset",      2, 0);
 	addAttribute("position",    3, 2);
+
+	// only the live particles are uploaded, every frame
+	usage(BufferUsage::STREAM);
 }
 
 // void 
@@ -41,6 +41,18 @@ namespace minko
 				return std::shared_ptr<PNGParser>(new PNGParser());
 			}
 
+			inline
+			bool
+			decodesAsynchronously() const
+			{
+				return true;
+			}
+
+			void
+			decode(const std::string&					filename,
+				   std::shared_ptr<Options>				options,
+				   const std::vector<unsigned char>&	data);
+
 			void
 			parse(const std::string&				filename,
 				  const std::string&                resolvedFilename,
@@ -49,7 +61,18 @@ namespace minko
 				  std::shared_ptr<AssetLibrary>	AssetLibrary);
 
 		private:
-			PNGParser()
+			std::vector<unsigned char>	_pixels;
+			uint						_width;
+			uint						_height;
+			bool						_decoded;
+			bool						_valid;
+
+		private:
+			PNGParser() :
+				_width(0),
+				_height(0),
+				_decoded(false),
+				_valid(false)
 			{
 			}
 		};
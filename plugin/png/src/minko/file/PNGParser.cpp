@@ -29,6 +29,31 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 using namespace minko;
 using namespace minko::file;
 
+void
+PNGParser::decode(const std::string&                filename,
+                  std::shared_ptr<Options>          options,
+                  const std::vector<unsigned char>& data)
+{
+	_valid = !data.empty() && lodepng::decode(_pixels, _width, _height, &data[0], data.size()) == 0;
+	_decoded = true;
+
+	auto maxSize = options->maxTextureSize();
+
+	if (!_valid || maxSize == 0 || std::max(_width, _height) <= maxSize)
+		return;
+
+	// PNG has no reduced decoding: the image is resampled by the worker instead
+	auto scale	= (float)maxSize / (float)std::max(_width, _height);
+	auto width	= std::max(1u, (uint)(_width * scale));
+	auto height	= std::max(1u, (uint)(_height * scale));
+	std::vector<unsigned char> pixels;
+
+	render::AbstractTexture::resizeData(_width, _height, _pixels, width, height, true, pixels);
+	_pixels.swap(pixels);
+	_width = width;
+	_height = height;
+}
+
 void
 PNGParser::parse(const std::string&                 filename,
                  const std::string&                 resolvedFilename,
@@ -36,13 +61,10 @@ PNGParser::parse(const std::string&                 filename,
                  const std::vector<unsigned char>&  data,
                  std::shared_ptr<AssetLibrary>      AssetLibrary)
 {
-	std::vector<unsigned char> out;
-	unsigned int width;
-	unsigned int height;
-
-	unsigned error = lodepng::decode(out, width, height, &data[0], data.size());
+	if (!_decoded)
+		decode(filename, options, data);
 
-	if (error)
+	if (!_valid)
 		throw std::invalid_argument("file " + filename + " is not a valid PNG file");
 
 	render::AbstractTexture::Ptr texture = nullptr;
@@ -50,8 +72,8 @@ PNGParser::parse(const std::string&                 filename,
 	if (!options->isCubeTexture())
 		texture	= render::Texture::create(
 			options->context(), 
-			width, 
-			height, 
+			_width, 
+			_height, 
 			options->generateMipmaps(), 
 			false, 
 			options->resizeSmoothly(), 
@@ -60,17 +82,22 @@ PNGParser::parse(const std::string&                 filename,
 	else
 		texture = render::CubeTexture::create(
 			options->context(), 
-			width, 
-			height, 
+			_width, 
+			_height, 
 			options->generateMipmaps(), 
 			false, 
 			options->resizeSmoothly(), 
 			filename
 		);
 
-	texture->data(&out[0]);
+	if (texture->type() == render::TextureType::Texture2D)
+		std::static_pointer_cast<render::Texture>(texture)->data(_pixels);
+	else
+		texture->data(&_pixels[0]);
 	texture->upload();
 
+	std::vector<unsigned char>().swap(_pixels);
+
 	AssetLibrary->texture(filename, texture);
 
 	complete()->execute(shared_from_this());
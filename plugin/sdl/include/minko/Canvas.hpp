@@ -72,18 +72,6 @@ namespace minko
 				input::Mouse(canvas)
 			{
 			}
-
-			void
-			x(uint x)
-			{
-				_x = x;
-			}
-
-			void
-			y(uint y)
-			{
-				_y = y;
-			}
 		};
 
 		class SDLKeyboard :
@@ -197,11 +185,18 @@ namespace minko
 		SDL_Surface*											_screen;
 #else
 		SDL_Window*												_window;
+		void*													_glContext;
 #endif
+		std::shared_ptr<render::UploadThread>					_uploadThread;
+		bool													_uploadThreadUnsupported;
         time_point                                              _previousTime;
         time_point                                              _startTime;
+        time_point                                              _nextFrameTime;
 		float													_framerate;
 		float													_desiredFramerate;
+		int														_swapInterval;
+		int														_displayRefreshRate;
+		std::atomic<bool>										_waitingForEvents;
 
 		std::shared_ptr<SDLMouse>								_mouse;
 		std::unordered_map<int, std::shared_ptr<SDLJoystick>>	_joysticks;
@@ -351,9 +346,27 @@ namespace minko
 			_desiredFramerate = desiredFramerate;
 		}
 
+		inline
+		int
+		swapInterval()
+		{
+			return _swapInterval;
+		}
+
+		// 0 disables vsync, 1 enables it and -1 enables adaptive vsync when it is supported
+		void
+		swapInterval(int swapInterval);
+
+		void
+		requestFrame();
+
 		WorkerPtr
 		getWorker(const std::string& name);
 
+		// the upload thread renders in a second SDL context sharing its objects with the one of the window
+		std::shared_ptr<render::UploadThread>
+		uploadThread();
+
 		bool
 		isWorkerRegistered(const std::string& name)
 		{
@@ -397,6 +410,9 @@ namespace minko
 		void
 		initializeContext(const std::string& windowTitle, unsigned int width, unsigned int height, bool useStencil);
 
+		void
+		waitForNextFrame();
+
 #ifdef MINKO_ANGLE
 		ESContext*
 		initContext(SDL_Window* window, unsigned int width, unsigned int height);
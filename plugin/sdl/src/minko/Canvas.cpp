@@ -23,6 +23,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/data/Provider.hpp"
 #include "minko/math/Vector4.hpp"
 #include "minko/async/Worker.hpp"
+#include "minko/FrameTimeHistogram.hpp"
+#include "minko/render/UploadThread.hpp"
 
 #if !defined(EMSCRIPTEN)
 #include "minko/async/FileLoaderWorker.hpp"
@@ -59,10 +61,18 @@ Canvas::Canvas(const std::string& name, const uint width, const uint height, boo
 	_chromeless(chromeless),
 	_data(data::Provider::create()),
 	_active(false),
+#ifndef EMSCRIPTEN
+	_glContext(nullptr),
+#endif
+	_uploadThreadUnsupported(false),
     _previousTime(std::chrono::high_resolution_clock::now()),
     _startTime(std::chrono::high_resolution_clock::now()),
+    _nextFrameTime(std::chrono::high_resolution_clock::now()),
 	_framerate(0.f),
 	_desiredFramerate(60.f),
+	_swapInterval(0),
+	_displayRefreshRate(0),
+	_waitingForEvents(false),
 	_enterFrame(Signal<Canvas::Ptr, float, float>::create()),
 	_resized(Signal<AbstractCanvas::Ptr, uint, uint>::create()),
 	_joystickAdded(Signal<AbstractCanvas::Ptr, std::shared_ptr<input::Joystick>>::create()),
@@ -135,15 +145,24 @@ Canvas::initializeContext(const std::string& windowTitle, unsigned int width, un
         throw std::runtime_error("Could not create Angle context");
 # elif TARGET_IPHONE_SIMULATOR
 //    SDL_CreateRenderer(_window, -1, 0);
-    SDL_GLContext glContext = SDL_GL_CreateContext(_window);
-    if (!glContext)
+    _glContext = SDL_GL_CreateContext(_window);
+    if (!_glContext)
         throw std::runtime_error("Could not create iOS context");
 # else
-    SDL_GLContext glContext = SDL_GL_CreateContext(_window);
-    if (!glContext)
+    _glContext = SDL_GL_CreateContext(_window);
+    if (!_glContext)
         throw std::runtime_error("Could not create a window context from SDL");
 # endif // MINKO_ANGLE
 
+# if !MINKO_ANGLE
+    _swapInterval = SDL_GL_GetSwapInterval();
+# endif
+
+    SDL_DisplayMode displayMode;
+
+    if (SDL_GetWindowDisplayMode(_window, &displayMode) == 0)
+        _displayRefreshRate = displayMode.refresh_rate;
+
     _context = minko::render::OpenGLES2Context::create();
 #else // if defined(EMSCRIPTEN)
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_JOYSTICK) < 0)
@@ -320,6 +339,27 @@ Canvas::height(uint value)
 void
 Canvas::step()
 {
+#if !defined(EMSCRIPTEN)
+    if (_onDemand)
+    {
+        // nothing requested a frame: keep the previous one until an event arrives
+        _waitingForEvents = true;
+        if (!_frameRequested)
+        {
+            // the completions of the running tasks still have to be executed
+            if (_threadPool && _threadPool->numPendingTasks() + _threadPool->numRunningTasks() != 0)
+                SDL_WaitEventTimeout(nullptr, 10);
+            else
+                SDL_WaitEvent(nullptr);
+            _previousTime = std::chrono::high_resolution_clock::now();
+        }
+        _waitingForEvents = false;
+    }
+
+    // the inputs are sampled after waiting, right before the frame is simulated
+    waitForNextFrame();
+#endif
+
 #if defined(EMSCRIPTEN)
     // Detect new joystick
     for (int i = 0; i < SDL_NumJoysticks(); i++) 
@@ -375,6 +415,10 @@ Canvas::step()
 
     while (SDL_PollEvent(&event))
     {
+        // any input or window event shows a new frame
+        if (event.type != SDL_USEREVENT)
+            _frameRequested = true;
+
         switch (event.type)
         {
         case SDL_QUIT:
@@ -406,20 +450,13 @@ Canvas::step()
         }
 
         case SDL_MOUSEMOTION:
-        {
-            auto oldX = mouse()->x();
-            auto oldY = mouse()->y();
-
-            _mouse->x(event.motion.x);
-            _mouse->y(event.motion.y);
-            _mouse->move()->execute(_mouse, event.motion.x - oldX, event.motion.y - oldY);
-            //_mouseX = event.motion.x;
-            //_mouseY = event.motion.y;
-            //_mouseMove->execute(shared_from_this(), _mouseX, _mouseY);
+            // coalesced until the end of the frame or the next button or wheel event
+            _mouse->motion(event.motion.x, event.motion.y, SDL_GetTicks());
             break;
-        }
+
         case SDL_MOUSEBUTTONDOWN:
         {
+            _mouse->flushMove();
             switch( event.button.button ) 
             {
             case SDL_BUTTON_LEFT:
@@ -433,6 +470,7 @@ Canvas::step()
         }
         case SDL_MOUSEBUTTONUP:
         {
+            _mouse->flushMove();
             switch( event.button.button ) 
 	    {
 	    case SDL_BUTTON_LEFT:
@@ -445,6 +483,7 @@ Canvas::step()
             break;
         }
         case SDL_MOUSEWHEEL:
+            _mouse->flushMove();
             _mouse->wheel()->execute(_mouse, event.wheel.x, event.wheel.y);
             //_mouseWheel->execute(shared_from_this(), event.wheel.x, event.wheel.y);
             break;
@@ -456,9 +495,7 @@ Canvas::step()
                 event.jaxis.axis,
                 event.jaxis.value);
 #endif // DEBUG
-            _joysticks[event.jaxis.which]->joystickAxisMotion()->execute(
-                _joysticks[event.jaxis.which], event.jaxis.which, event.jaxis.axis, event.jaxis.value
-                );
+            _joysticks[event.jaxis.which]->axisMotion(event.jaxis.axis, event.jaxis.value);
             break;
 
         case SDL_JOYHATMOTION:
@@ -489,6 +526,7 @@ Canvas::step()
                 event.jbutton.which,
                 event.jbutton.button);
 #endif
+            _joysticks[event.jbutton.which]->flushAxisMotion();
             _joysticks[event.jbutton.which]->joystickButtonDown()->execute(
                 _joysticks[event.jbutton.which], event.jbutton.which, event.jbutton.button
                 );
@@ -500,6 +538,7 @@ Canvas::step()
                 event.jbutton.which,
                 event.jbutton.button);
 #endif
+            _joysticks[event.jbutton.which]->flushAxisMotion();
             _joysticks[event.jbutton.which]->joystickButtonUp()->execute(
                 _joysticks[event.jbutton.which], event.jbutton.which, event.jbutton.button
                 );
@@ -577,10 +616,29 @@ Canvas::step()
         }
     }
 
-#if !defined(EMSCRIPTEN)
+    // one move per frame whatever the polling rate of the mouse, before the picking of the frame
+    _mouse->nextFrame();
+    for (auto& joystick : _joysticks)
+        joystick.second->flushAxisMotion();
+    _inputsPolled->execute(shared_from_this());
+
+#if !defined(MINKO_NO_THREADS)
+    if (_threadPool)
+        _threadPool->update();
+    if (_uploadThread)
+        _uploadThread->update();
+
     for (auto worker : _activeWorkers)
         worker->update();
+
+    // once started, the workers report their progress and completion through the thread pool
+    _activeWorkers.remove_if([](WorkerPtr worker) { return worker->busy() || worker->finished(); });
 #endif
+
+    if (_onDemand && !_frameRequested)
+        return;
+    _frameRequested = false;
+
     auto time           = std::chrono::high_resolution_clock::now();
     auto relativeTime   = 1e-6f * std::chrono::duration_cast<std::chrono::nanoseconds>(time - _startTime).count(); // in milliseconds
     auto frameDuration  = 1e-6f * std::chrono::duration_cast<std::chrono::nanoseconds>(time - _previousTime).count(); // in milliseconds
@@ -600,13 +658,67 @@ Canvas::step()
     // framerate in seconds
     _framerate = 1000.f / frameDuration;
 
-#if !defined(EMSCRIPTEN)
-    if (_framerate > _desiredFramerate)
+    if (_frameTimeHistogram)
+        _frameTimeHistogram->record(frameDuration);
+}
+
+void
+Canvas::waitForNextFrame()
+{
+    // SDL_Delay() is only accurate to the OS timer granularity: the end of the wait is spent spinning
+    static const float spinDuration = 2.f; // in milliseconds
+
+    auto frameDuration  = std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+        std::chrono::duration<float, std::milli>(1000.f / _desiredFramerate)
+    );
+    auto time           = std::chrono::high_resolution_clock::now();
+
+    // the swap already blocks on a display that cannot go faster than the desired framerate
+    if (_swapInterval != 0 && _displayRefreshRate > 0 && _desiredFramerate >= (float)_displayRefreshRate)
     {
-        SDL_Delay((uint) ((1000.f / _desiredFramerate) - frameDuration));
+        _nextFrameTime = time;
+        return;
+    }
+
+    if (time < _nextFrameTime)
+    {
+        auto remaining = 1e-6f * std::chrono::duration_cast<std::chrono::nanoseconds>(_nextFrameTime - time).count(); // in milliseconds
 
-        _framerate = _desiredFramerate;
+        if (remaining > spinDuration)
+            SDL_Delay((uint)(remaining - spinDuration));
+
+        while ((time = std::chrono::high_resolution_clock::now()) < _nextFrameTime)
+            std::this_thread::yield();
     }
+
+    // the frame deadlines do not drift, but a late frame does not make the next ones run faster
+    _nextFrameTime = time - _nextFrameTime > frameDuration ? time + frameDuration : _nextFrameTime + frameDuration;
+}
+
+void
+Canvas::requestFrame()
+{
+    // wake the canvas up if it is waiting for events
+    if (!_frameRequested.exchange(true) && _waitingForEvents)
+    {
+        SDL_Event event;
+
+        event.type = SDL_USEREVENT;
+        SDL_PushEvent(&event);
+    }
+}
+
+void
+Canvas::swapInterval(int swapInterval)
+{
+#if defined(MINKO_ANGLE)
+    if (eglSwapInterval(_angleContext->eglDisplay, swapInterval) == EGL_TRUE)
+        _swapInterval = swapInterval;
+#elif !defined(EMSCRIPTEN)
+    if (SDL_GL_SetSwapInterval(swapInterval) == 0)
+        _swapInterval = swapInterval;
+    else if (swapInterval < 0 && SDL_GL_SetSwapInterval(1) == 0)
+        _swapInterval = 1;
 #endif
 }
 
@@ -647,6 +759,43 @@ Canvas::quit()
     _active = false;
 }
 
+render::UploadThread::Ptr
+Canvas::uploadThread()
+{
+#if !defined(EMSCRIPTEN) && !MINKO_ANGLE
+    if (_uploadThread || _uploadThreadUnsupported)
+        return _uploadThread;
+
+    SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 1);
+    SDL_GLContext sharedContext = SDL_GL_CreateContext(_window);
+    SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 0);
+
+    // creating a context makes it current
+    SDL_GL_MakeCurrent(_window, _glContext);
+
+    if (!sharedContext)
+    {
+        _uploadThreadUnsupported = true;
+
+        return nullptr;
+    }
+
+    auto window = _window;
+
+    _uploadThread = render::UploadThread::create(
+        _context,
+        [=]() { SDL_GL_MakeCurrent(window, sharedContext); },
+        [=]()
+        {
+            SDL_GL_MakeCurrent(window, nullptr);
+            SDL_GL_DeleteContext(sharedContext);
+        }
+    );
+#endif
+
+    return _uploadThread;
+}
+
 Canvas::SDLKeyboard::SDLKeyboard()
 {
     _keyboardState = SDL_GetKeyboardState(NULL);
@@ -675,7 +824,6 @@ Canvas::getWorker(const std::string& name)
     _activeWorkers.push_back(worker);
 
     _workerCompleteSlots.push_back(worker->complete()->connect([worker, this](Worker::MessagePtr) {
-        std::cout << "Canvas::getWorker(): " << "remove worker" << std::endl;
         //_activeWorkers.remove(worker);
     }));
 
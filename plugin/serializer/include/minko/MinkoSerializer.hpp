@@ -8,5 +8,7 @@
 #include "minko/file/GeometryParser.hpp"
 #include "minko/file/MaterialParser.hpp"
 #include "minko/file/MaterialWriter.hpp"
+#include "minko/file/SceneTableOfContents.hpp"
+#include "minko/component/SceneStreamer.hpp"
 
 
@@ -26,6 +26,9 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/file/AbstractWriter.hpp"
 #include "minko/render/AbstractContext.hpp"
 #include "minko/file/Options.hpp"
+#include "minko/file/Dependency.hpp"
+#include "minko/file/GeometryWriter.hpp"
+#include "minko/geometry/Geometry.hpp"
 
 namespace minko
 {
@@ -36,12 +39,82 @@ namespace minko
 		public:
 			typedef std::shared_ptr<MkStats> Ptr;
 
+			// size of the data once compressed for the transport, for example with deflate
+			typedef std::function<uint(const std::vector<unsigned char>&)>	CompressedSizeFunction;
+
+			struct EncodingStats
+			{
+				std::string									asset;
+				std::string									encoding;
+				uint										size;
+				uint										compressedSize; // 0 without compressed size function
+				std::vector<std::pair<std::string, uint>>	streams; // geometries only
+				double										encodeTime; // milliseconds per run
+				double										decodeTime;
+				int											exact; // -1 when the assets cannot be compared
+			};
+
+		private:
+			typedef std::chrono::high_resolution_clock	Clock;
+
+			CompressedSizeFunction _compressedSize;
+
 		public:
 			inline static
 			Ptr
-			create()
+			create(CompressedSizeFunction compressedSize = nullptr)
 			{
-				return std::shared_ptr<MkStats>(new MkStats());
+				return std::shared_ptr<MkStats>(new MkStats(compressedSize));
+			}
+
+			// encodes and decodes asset numRuns times with the options of one encoding
+			template <typename AssetT, typename ParserT, typename WriterT>
+			EncodingStats
+			encodingStats(render::AbstractContext::Ptr			context,
+						  std::shared_ptr<file::AssetLibrary>	assets,
+						  const std::string&					assetName,
+						  AssetT								asset,
+						  const std::string&					encoding,
+						  std::shared_ptr<file::Options>		options,
+						  uint									numRuns = 10)
+			{
+				if (numRuns == 0)
+					throw std::invalid_argument("numRuns");
+
+				auto						writer	= WriterT::create();
+				std::vector<unsigned char>	data;
+				EncodingStats				stats;
+
+				writer->data(asset);
+
+				auto start = Clock::now();
+
+				for (uint i = 0; i < numRuns; ++i)
+					data = pack(writer, assets, options);
+
+				stats.encodeTime = milliseconds(start) / numRuns;
+
+				// decoded with the effect and the functions of the loaded assets
+				auto parserOptions	= file::Options::create(assets->defaultOptions())->loadAsynchronously(false);
+				auto decoded		= assets;
+
+				start = Clock::now();
+
+				for (uint i = 0; i < numRuns; ++i)
+				{
+					decoded = file::AssetLibrary::create(context);
+					ParserT::create()->parse(assetName, assetName, parserOptions, data, decoded);
+				}
+
+				stats.decodeTime		= milliseconds(start) / numRuns;
+				stats.asset				= assetName;
+				stats.encoding			= encoding;
+				stats.size				= data.size();
+				stats.compressedSize	= _compressedSize ? _compressedSize(data) : 0;
+				stats.streams			= streamSizes(asset, options);
+				stats.exact				= compare(asset, assetName, decoded);
+
+				return stats;
 			}
 
 			template <typename T, typename SerializedT>
@@ -108,6 +181,57 @@ namespace minko
 			}
 
 		private:
+			template <typename WriterT>
+			static
+			std::vector<unsigned char>
+			pack(std::shared_ptr<WriterT>				writer,
+				 std::shared_ptr<file::AssetLibrary>	assets,
+				 std::shared_ptr<file::Options>			options)
+			{
+				const auto packed = writer->serialize(assets, options);
+
+				return std::vector<unsigned char>(packed.begin(), packed.end());
+			}
+
+			static
+			double
+			milliseconds(Clock::time_point start)
+			{
+				return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+			}
+
+			template <typename AssetT>
+			static
+			std::vector<std::pair<std::string, uint>>
+			streamSizes(AssetT, std::shared_ptr<file::Options>)
+			{
+				return std::vector<std::pair<std::string, uint>>();
+			}
+
+			static
+			std::vector<std::pair<std::string, uint>>
+			streamSizes(std::shared_ptr<geometry::Geometry> geometry, std::shared_ptr<file::Options> options)
+			{
+				return file::GeometryWriter::streamSizes(geometry, options && options->compressGeometries());
+			}
+
+			template <typename AssetT>
+			static
+			int
+			compare(AssetT, const std::string&, file::AssetLibrary::Ptr)
+			{
+				return -1;
+			}
+
+			static
+			int
+			compare(std::shared_ptr<geometry::Geometry> geometry, const std::string& assetName, file::AssetLibrary::Ptr decoded)
+			{
+				auto decodedGeometry = decoded->geometry(assetName);
+
+				return decodedGeometry ? (int)geometry->equals(decodedGeometry) : -1;
+			}
+
 			template <typename AssetT>
 			void
 			printValidation(AssetT originalAsset, std::string assetName, file::AssetLibrary::Ptr assets)
@@ -127,7 +251,8 @@ namespace minko
 				std::cout << "	Valid : ??????" << std::endl;
 			}
 
-			MkStats()
+			MkStats(CompressedSizeFunction compressedSize) :
+				_compressedSize(compressedSize)
 			{
 			}
 		};
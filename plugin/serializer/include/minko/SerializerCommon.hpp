@@ -33,6 +33,12 @@ namespace minko
 		class MaterialParser;
 		class MaterialWriter;
 		class Dependency;
+		class SceneTableOfContents;
+	}
+
+	namespace component
+	{
+		class SceneStreamer;
 	}
 
 	namespace serialize
@@ -66,5 +66,13 @@ namespace minko
 			EFFECT_ASSET			= 3,
 			EMBED_EFFECT_ASSET		= 13
 		};
+
+		// storage of each attribute of a compressed vertex stream
+		enum StreamEncoding
+		{
+			RAW_FLOAT		= 0,
+			QUANTIZED_16	= 1, // unsigned 16 bits within the [min, max] range of each component
+			OCTAHEDRAL_16	= 2  // unit vectors, 2 signed 16 bits components
+		};
 	}
 }
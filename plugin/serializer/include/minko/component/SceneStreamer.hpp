@@ -0,0 +1,217 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+#include "minko/SerializerCommon.hpp"
+
+#include "minko/component/AbstractComponent.hpp"
+#include "minko/Signal.hpp"
+
+namespace minko
+{
+	namespace component
+	{
+		// loads the cells of a streamed scene closer than loadDistance() to the eye and adds them to the target,
+		// removes them once they are farther than unloadDistance(); cells are fetched by increasing distance then
+		// added at most maxCellsPerUpdate() at a time, the textureStreamer() of the options bounds their uploads
+		class SceneStreamer :
+			public AbstractComponent,
+			public std::enable_shared_from_this<SceneStreamer>
+		{
+		public:
+			typedef std::shared_ptr<SceneStreamer>	Ptr;
+
+		private:
+			typedef std::shared_ptr<scene::Node>					NodePtr;
+			typedef std::shared_ptr<AbstractComponent>				AbsCmpPtr;
+			typedef std::shared_ptr<file::AssetLibrary>				AssetLibraryPtr;
+			typedef std::shared_ptr<file::Options>					OptionsPtr;
+			typedef std::shared_ptr<file::SceneTableOfContents>		TableOfContentsPtr;
+
+			enum class CellState
+			{
+				UNLOADED,
+				LOADING,
+				LOADED,
+				ADDED
+			};
+
+			struct Cell
+			{
+				CellState	state;
+				NodePtr		node;
+				bool		cancelled; // the cell got out of range while loading
+			};
+
+		private:
+			AssetLibraryPtr							_assets;
+			TableOfContentsPtr						_tableOfContents;
+			OptionsPtr								_options;
+			float									_loadDistance;
+			float									_unloadDistance;
+			uint									_maxConcurrentLoads;
+			uint									_maxCellsPerUpdate;
+			std::vector<Cell>						_cells;
+			uint									_numLoadingCells;
+			std::list<uint>							_loadedCells; // waiting to be added to the target
+			std::vector<uint>						_cellsInRange;
+
+			std::shared_ptr<Signal<Ptr, uint>>		_cellAdded;
+			std::shared_ptr<Signal<Ptr, uint>>		_cellRemoved;
+
+			Signal<AbsCmpPtr, NodePtr>::Slot		_targetAddedSlot;
+			Signal<AbsCmpPtr, NodePtr>::Slot		_targetRemovedSlot;
+
+		public:
+			inline static
+			Ptr
+			create(AssetLibraryPtr assets, TableOfContentsPtr tableOfContents, OptionsPtr options = nullptr)
+			{
+				if (!assets)
+					throw std::invalid_argument("assets");
+				if (!tableOfContents)
+					throw std::invalid_argument("tableOfContents");
+
+				auto streamer = std::shared_ptr<SceneStreamer>(new SceneStreamer(assets, tableOfContents, options));
+
+				streamer->initialize();
+
+				return streamer;
+			}
+
+			inline
+			TableOfContentsPtr
+			tableOfContents() const
+			{
+				return _tableOfContents;
+			}
+
+			inline
+			float
+			loadDistance() const
+			{
+				return _loadDistance;
+			}
+
+			inline
+			float
+			unloadDistance() const
+			{
+				return _unloadDistance;
+			}
+
+			// the cells between the two distances are kept as they are, so that they do not come and go
+			void
+			distances(float loadDistance, float unloadDistance);
+
+			inline
+			uint
+			maxConcurrentLoads() const
+			{
+				return _maxConcurrentLoads;
+			}
+
+			inline
+			void
+			maxConcurrentLoads(uint value)
+			{
+				if (value == 0)
+					throw std::invalid_argument("value");
+
+				_maxConcurrentLoads = value;
+			}
+
+			inline
+			uint
+			maxCellsPerUpdate() const
+			{
+				return _maxCellsPerUpdate;
+			}
+
+			inline
+			void
+			maxCellsPerUpdate(uint value)
+			{
+				if (value == 0)
+					throw std::invalid_argument("value");
+
+				_maxCellsPerUpdate = value;
+			}
+
+			inline
+			uint
+			numLoadingCells() const
+			{
+				return _numLoadingCells;
+			}
+
+			uint
+			numAddedCells() const;
+
+			// the root of the cell while it is added to the target
+			inline
+			NodePtr
+			cellNode(uint cell) const
+			{
+				return _cells.at(cell).node;
+			}
+
+			inline
+			std::shared_ptr<Signal<Ptr, uint>>
+			cellAdded() const
+			{
+				return _cellAdded;
+			}
+
+			inline
+			std::shared_ptr<Signal<Ptr, uint>>
+			cellRemoved() const
+			{
+				return _cellRemoved;
+			}
+
+			// usually once per frame with the position of the camera in world space
+			void
+			update(std::shared_ptr<math::Vector3> eyePosition);
+
+		private:
+			SceneStreamer(AssetLibraryPtr assets, TableOfContentsPtr tableOfContents, OptionsPtr options);
+
+			void
+			initialize();
+
+			void
+			targetAddedHandler(AbsCmpPtr cmp, NodePtr target);
+
+			void
+			targetRemovedHandler(AbsCmpPtr cmp, NodePtr target);
+
+			void
+			loadCell(uint cell, float distance);
+
+			void
+			cellLoadedHandler(uint cell, std::shared_ptr<file::AbstractLoader> loader);
+
+			void
+			removeCell(uint cell);
+		};
+	}
+}
@@ -31,9 +31,9 @@ namespace minko
 		struct pair_hash
 		{
 			long 
-			operator()(const std::pair<unsigned short, unsigned short> pair) const 
+			operator()(const std::pair<uint, uint> pair) const 
 			{ 
-				return pair.first * 10000 + pair.second;
+				return (long(pair.first) << 16) ^ pair.second;
 			}
 
 		};
@@ -41,8 +41,8 @@ namespace minko
 		struct pair_comparer
 		{
 			bool 
-			operator()(const std::pair<unsigned short, unsigned short> left, 
-					   const std::pair<unsigned short, unsigned short> right) const
+			operator()(const std::pair<uint, uint> left, 
+					   const std::pair<uint, uint> right) const
 			{
 				return (left.first == right.first) && (left.second == right.second);
 			}
@@ -52,7 +52,7 @@ namespace minko
 		{
 		private:
 			typedef std::shared_ptr<minko::render::IndexBuffer>							IndexStreamPtr;
-			typedef std::pair<unsigned short, unsigned short>								PairOfShort;
+			typedef std::pair<uint, uint>													PairOfShort;
 			typedef std::shared_ptr<HalfEdge>												HalfEdgePtr;
 			typedef std::unordered_map<PairOfShort, HalfEdgePtr, pair_hash, pair_comparer>	HalfEdgeMap;
 			typedef std::list<HalfEdgePtr>													HalfEdgeList;
@@ -21,6 +21,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/SerializerCommon.hpp"
 
+#include <cstring>
+
 namespace minko
 {
 	namespace deserialize
@@ -43,18 +45,39 @@ namespace minko
 			std::vector<T>
 			deserializeVector(std::string& serializedValue)
 			{
-				std::stringstream	stream;
-				std::vector<T>		result(serializedValue.size() / sizeof(ST));
-				uint				i = 0;
-
-				stream << serializedValue;
+				std::vector<T> result;
 
-				while (i < result.size())
-					read<T, ST>(stream, result[i++]);
+				deserializeVector<T, ST>(serializedValue.data(), serializedValue.size(), result);
 
 				return result;
 			}
 
+			// straight from the unpacked data, for example a msgpack::type::raw_ref
+			template <typename T, typename ST = T>
+			static
+			void
+			deserializeVector(const char* serializedValue, uint size, std::vector<T>& result)
+			{
+				result.resize(size / sizeof(ST));
+
+				// same layout as read(), without copying the whole string into a stream first
+				if (sizeof(T) == sizeof(ST))
+					std::memcpy(result.data(), serializedValue, result.size() * sizeof(T));
+				else
+					for (uint i = 0; i < result.size(); ++i)
+					{
+						ST value;
+
+						std::memcpy(&value, serializedValue + i * sizeof(ST), sizeof(ST));
+						result[i] = static_cast<T>(value);
+					}
+			}
+
+			// reverse of TypeSerializer::serializeDeltaVector()
+			static
+			void
+			deserializeDeltaVector(const char* serializedValue, uint size, std::vector<uint>& result);
+
 			static
 			Any
 			deserializeVector4(std::tuple<uint, std::string&>& serializedVector);
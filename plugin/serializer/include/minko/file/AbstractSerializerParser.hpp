@@ -33,7 +33,8 @@ namespace minko
 		{
 		public:
 			typedef std::shared_ptr<AbstractSerializerParser>				Ptr;
-			typedef msgpack::type::tuple<unsigned int, short, std::string>	SerializedAsset;
+			// the last field is the file name or the embedded content, referenced in the unpacked data
+			typedef msgpack::type::tuple<unsigned int, short, msgpack::type::raw_ref>	SerializedAsset;
 			typedef std::shared_ptr<file::AssetLibrary>						AssetLibraryPtr;
 		
 		private:
@@ -41,6 +42,15 @@ namespace minko
 			typedef std::shared_ptr<Dependency>																DependencyPtr;
 			typedef std::function<void(unsigned char, AssetLibraryPtr, std::string&, DependencyPtr, short, std::list<JobPtr>&)>	AssetDeserializeFunction;
 
+			// an asset read and decoded by a worker thread, only its resources are left to create
+			struct PreparedAsset
+			{
+				std::vector<unsigned char>		data;
+				std::shared_ptr<AbstractParser>	parser;
+				uint64_t						contentHash; // 0 for the files written before the hashes
+				std::string						loadedName; // the asset already loaded with the same content
+			};
+
 		protected:
 			DependencyPtr						_dependencies;
 			std::shared_ptr<GeometryParser>		_geometryParser;
@@ -70,7 +80,35 @@ namespace minko
 			registerAssetFunction(uint assetTypeId, AssetDeserializeFunction f);
 
 		protected:
-			std::string
+			// one of the msgpack zones of the calling thread, cleared when the scope ends: nested parsers borrow
+			// the next one, so the chunks of the zones are allocated once per thread instead of once per asset
+			class ScopedZone
+			{
+			private:
+				msgpack::zone* _zone;
+
+			public:
+				ScopedZone();
+
+				~ScopedZone();
+
+				inline
+				msgpack::zone*
+				get()
+				{
+					return _zone;
+				}
+
+			private:
+				ScopedZone(const ScopedZone&);
+
+				ScopedZone&
+				operator=(const ScopedZone&);
+			};
+
+		protected:
+			// the returned reference points into data and is only valid as long as data is
+			msgpack::type::raw_ref
 			extractDependencies(AssetLibraryPtr						assetLibrary,
 								const std::vector<unsigned char>&	data,
 								std::shared_ptr<Options>			options,
@@ -87,10 +125,29 @@ namespace minko
 			AbstractSerializerParser();
 
 			void
-			deserializedAsset(SerializedAsset					asset,
+			deserializedAsset(const SerializedAsset&			asset,
 							  AssetLibraryPtr					assetLibrary,
 							  std::shared_ptr<Options>			options,
-							  std::string&						assetFilePath);
+							  std::string&						assetFilePath,
+							  PreparedAsset&					prepared);
+
+			void
+			prepareAssets(std::vector<SerializedAsset>&		assets,
+						  const msgpack::object&			serializedAssets,
+						  AssetLibraryPtr					assetLibrary,
+						  std::shared_ptr<Options>			options,
+						  const std::string&				assetFilePath,
+						  std::vector<PreparedAsset>&		prepared);
+
+			static
+			bool
+			hasAsset(uint type, const std::string& name, AssetLibraryPtr assetLibrary);
+
+			static
+			void
+			readAssetData(const SerializedAsset&		asset,
+						  const std::string&			assetCompletePath,
+						  std::vector<unsigned char>&	data);
 
 			std::string
 			extractFolderPath(const std::string& filepath);
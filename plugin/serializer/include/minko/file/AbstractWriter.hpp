@@ -35,9 +35,6 @@ namespace minko
 		public:
 			typedef std::shared_ptr<AbstractWriter> Ptr;
 
-		private:
-			typedef std::vector<msgpack::type::tuple<short, short, std::string>> SerializedDependency;
-
 		protected :
 			std::shared_ptr<Signal<Ptr>>	_complete;
 			T								_data;
@@ -73,16 +70,15 @@ namespace minko
 
 				if (file)
 				{
-					Dependency::Ptr			dependencies			= Dependency::create();
-					std::string				serializedData			= embed(assetLibrary, options, dependencies);
-					SerializedDependency	serializedDependencies	= dependencies->serialize(assetLibrary, options);
-
-					msgpack::type::tuple<SerializedDependency, std::string> res(serializedDependencies, serializedData);
-
-					std::stringstream sbuf;
-					msgpack::pack(sbuf, res);
-
-					file.write(sbuf.str().c_str(), sbuf.str().size());
+					Dependency::Ptr					dependencies	= Dependency::create();
+					const auto						content			= embed(assetLibrary, options, dependencies);
+					msgpack::packer<std::ofstream>	packer(file);
+
+					// same layout as serialize(), packed straight to the file rather than assembled in memory
+					packer.pack_array(2);
+					packer.pack(dependencies->serialize(assetLibrary, options));
+					packer.pack_raw(content.size());
+					packer.pack_raw_body(content.c_str(), content.size());
 					file.close();
 				}
 				else
@@ -91,6 +87,23 @@ namespace minko
 				complete()->execute(this->shared_from_this());
 			}
 
+			// the content of the file written by write(): the dependencies, then the data
+			std::string
+			serialize(std::shared_ptr<AssetLibrary>	assetLibrary,
+					  std::shared_ptr<Options>		options)
+			{
+				Dependency::Ptr					dependencies			= Dependency::create();
+				std::string						serializedData			= embed(assetLibrary, options, dependencies);
+				Dependency::SerializedAssets	serializedDependencies	= dependencies->serialize(assetLibrary, options);
+
+				msgpack::type::tuple<Dependency::SerializedAssets, std::string> res(serializedDependencies, serializedData);
+
+				std::stringstream sbuf;
+				msgpack::pack(sbuf, res);
+
+				return sbuf.str();
+			}
+
 			virtual
 			std::string
 			embed(std::shared_ptr<AssetLibrary>		assetLibrary,
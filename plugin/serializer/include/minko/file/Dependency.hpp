@@ -31,10 +31,15 @@ namespace minko
 		public:
 			typedef std::shared_ptr<Dependency> Ptr;
 			typedef std::shared_ptr<render::AbstractTexture> AbsTexturePtr;
+			// type, id, file name and 64 bits FNV-1a hash of the serialized content, 0 for the effects
+			typedef msgpack::type::tuple<short, short, std::string, uint64_t>	SerializedAsset;
+			typedef std::vector<SerializedAsset>								SerializedAssets;
 
 		private:
 			std::unordered_map<AbsTexturePtr, uint>							_textureDependencies;
 			std::unordered_map<std::shared_ptr<data::Provider>, uint>		_materialDependencies;
+			// id of the first registered material of each properties key
+			std::unordered_map<std::string, uint>							_materialKeyToId;
 			std::unordered_map<std::shared_ptr<scene::Node>, uint>			_subSceneDependencies;
 			std::unordered_map<std::shared_ptr<geometry::Geometry>, uint>	_geometryDependencies;
 			std::unordered_map<std::shared_ptr<render::Effect>, uint>		_effectDependencies;
@@ -145,11 +150,26 @@ namespace minko
 			void
 			registerReference(uint referenceId, std::shared_ptr<scene::Node> subScene);
 
-			std::vector<msgpack::type::tuple<short, short, std::string>>
+			SerializedAssets
 			serialize(std::shared_ptr<file::AssetLibrary>	assetLibrary, 
 					  std::shared_ptr<file::Options>		options);
 
+			static
+			uint64_t
+			contentHash(const std::string& content);
+
 		private:
+			// copies source to destination and returns the contentHash() of the copied bytes
+			static
+			uint64_t
+			copyFile(const std::string& source, const std::string& destination);
+
+			// writes the geometries on several threads, in the order of their ids
+			void
+			serializeGeometries(std::shared_ptr<file::AssetLibrary>	assetLibrary,
+								std::shared_ptr<file::Options>		options,
+								SerializedAssets&					serializedAssets);
+
 			void
 			copyEffectDependency(std::string effectFile, std::shared_ptr<render::Effect> effect);
 
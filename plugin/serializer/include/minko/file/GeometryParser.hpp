@@ -38,11 +38,26 @@ namespace minko
 	private:
 		typedef unsigned char																	uchar;
 		typedef msgpack::type::tuple<std::string, uchar, uchar>									SerializeAttribute;
-		typedef msgpack::type::tuple<uchar, std::string, std::string, std::vector<std::string>> SerializedGeometry;
+		// the streams are referenced in the unpacked data and copied once, into their buffer
+		typedef msgpack::type::tuple<uchar, std::string, msgpack::type::raw_ref, std::vector<msgpack::type::raw_ref>> SerializedGeometry;
+
+		struct DecodedVertexBuffer
+		{
+			std::vector<float>				data;
+			std::vector<SerializeAttribute>	attributes;
+			std::vector<unsigned char>		attributeTypes;
+		};
 
 	private:
 		static std::function<IndexBufferPtr(std::string&, AbstractContextPtr)>	indexBufferParserFunction;
 		static std::function<VertexBufferPtr(std::string&, AbstractContextPtr)>	vertexBufferParserFunction;
+		static bool																_customBufferParsers;
+
+		// filled by decode(), off the main thread
+		bool																	_decoded;
+		std::string																_decodedName;
+		std::vector<uint>														_decodedIndices;
+		std::vector<DecodedVertexBuffer>										_decodedVertexBuffers;
 
 	public:
 		inline static
@@ -52,6 +67,20 @@ namespace minko
 			return std::shared_ptr<GeometryParser>(new GeometryParser());
 		}
 
+		// custom buffer parser functions create their buffers themselves, on the main thread
+		inline
+		bool
+		decodesAsynchronously() const
+		{
+			return !_customBufferParsers;
+		}
+
+		// geometries without dependencies only, the others are decoded by parse()
+		void
+		decode(const std::string&					filename,
+			   std::shared_ptr<Options>				options,
+			   const std::vector<unsigned char>&	data);
+
 		void
 		parse(const std::string&				filename,
 			  const std::string&                resolvedFilename,
@@ -65,6 +94,7 @@ namespace minko
 		registerIndexBufferParserFunction(std::function<IndexBufferPtr(std::string&, AbstractContextPtr)> f)
 		{
 			indexBufferParserFunction = f;
+			_customBufferParsers = true;
 		}
 
 		inline
@@ -73,10 +103,12 @@ namespace minko
 		registerVertexBufferParserFunction(std::function<VertexBufferPtr(std::string&, AbstractContextPtr)> f)
 		{
 			vertexBufferParserFunction = f;
+			_customBufferParsers = true;
 		}
 
 	private:
-		GeometryParser()
+		GeometryParser() :
+			_decoded(false)
 		{
 			initialize();
 		}
@@ -87,6 +119,33 @@ namespace minko
 		void
 		initialize();
 
+		static
+		void
+		decodeIndices(uchar metaByte, const char* stream, uint size, std::vector<uint>& indices);
+
+		static
+		void
+		decodeVertexBuffer(const char* serializedVertexBuffer, uint size, DecodedVertexBuffer& vertexBuffer);
+
+		static
+		void
+		decodeCompressedVertexStream(const char*							stream,
+									 uint									size,
+									 const std::vector<SerializeAttribute>&	attributes,
+									 const std::vector<unsigned char>&		encodings,
+									 const std::vector<float>&				bounds,
+									 std::vector<float>&					data);
+
+		// consumes the decoded data
+		static
+		VertexBufferPtr
+		createVertexBuffer(DecodedVertexBuffer& vertexBuffer, AbstractContextPtr context);
+
+		// consumes the decoded indices
+		static
+		IndexBufferPtr
+		createIndexBuffer(std::vector<uint>& indices, AbstractContextPtr context);
+
 		static
 		VertexBufferPtr
 		deserializeVertexBuffer(std::string&		serializedVertexBuffer, 
@@ -102,6 +161,16 @@ namespace minko
 		deserializeIndexBufferChar(std::string&			serializedIndexBuffer, 
 								   AbstractContextPtr	context);
 
+		static
+		IndexBufferPtr
+		deserializeIndexBufferCompressed(std::string&		serializedIndexBuffer, 
+										 AbstractContextPtr	context);
+
+		static
+		IndexBufferPtr
+		deserializeIndexBufferInt(std::string&			serializedIndexBuffer, 
+								  AbstractContextPtr	context);
+
 	};
 	}
 }
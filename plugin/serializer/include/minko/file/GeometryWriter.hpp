@@ -25,6 +25,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "msgpack.hpp"
 #include "minko/file/AssetLibrary.hpp"
 #include "minko/file/Dependency.hpp"
+#include "minko/file/Options.hpp"
 
 namespace minko
 {
@@ -54,13 +55,24 @@ namespace minko
 				  Dependency::Ptr					dependency)
 			{
 				geometry::Geometry::Ptr		geometry = data();
-				uint						metaByte = computeMetaByte(geometry);
-				const std::string&			serializedIndexBuffer = indexBufferWriterFunction(geometry->indices());
+
+				if (options && options->optimizeGeometries())
+					geometry->optimize();
+
+				std::function<std::string(std::shared_ptr<render::IndexBuffer>)>	indexWriter;
+
+				const bool					compress = options && options->compressGeometries();
+				uint						metaByte = computeMetaByte(geometry, indexWriter) | (compress ? 1u << 5 : 0u);
+				const std::string&			serializedIndexBuffer = compress
+					? serializeIndexStreamCompressed(geometry->indices())
+					: indexWriter(geometry->indices());
 				std::vector<std::string>	serializedVertexBuffers;
 				std::stringstream			sbuf;
 
 				for (std::shared_ptr<render::VertexBuffer> vertexBuffer : geometry->vertexBuffers())
-					serializedVertexBuffers.push_back(vertexBufferWriterFunction(vertexBuffer));
+					serializedVertexBuffers.push_back(
+						compress ? serializeVertexStreamCompressed(vertexBuffer) : vertexBufferWriterFunction(vertexBuffer)
+					);
 
 				msgpack::type::tuple<unsigned char, std::string, std::string, std::vector<std::string>> res(
 					metaByte,
@@ -72,6 +84,11 @@ namespace minko
 				return sbuf.str();
 			}
 
+			// encoded size of the index stream, then of each vertex stream named after its attributes
+			static
+			std::vector<std::pair<std::string, uint>>
+			streamSizes(std::shared_ptr<geometry::Geometry> geometry, bool compress);
+
 			inline
 			static
 			void
@@ -94,7 +111,8 @@ namespace minko
 			initialize();
 
 			unsigned char
-			computeMetaByte(std::shared_ptr<geometry::Geometry> geometry);
+			computeMetaByte(std::shared_ptr<geometry::Geometry>								geometry,
+							std::function<std::string(std::shared_ptr<render::IndexBuffer>)>&	indexWriter);
 
 			static
 			std::string
@@ -104,10 +122,23 @@ namespace minko
 			std::string
 			serializeIndexStreamChar(std::shared_ptr<render::IndexBuffer> indexBuffer);
 
+			static
+			std::string
+			serializeIndexStreamInt(std::shared_ptr<render::IndexBuffer> indexBuffer);
+
+			static
+			std::string
+			serializeIndexStreamCompressed(std::shared_ptr<render::IndexBuffer> indexBuffer);
+
 			static
 			std::string
 			serializeVertexStream(std::shared_ptr<render::VertexBuffer> vertexBuffer);
 
+			// attributes are stored one after the other, quantized and delta encoded when possible
+			static
+			std::string
+			serializeVertexStreamCompressed(std::shared_ptr<render::VertexBuffer> vertexBuffer);
+
 			GeometryWriter()
 			{
 				initialize();
@@ -0,0 +1,117 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+	namespace file
+	{
+		// table of contents of a streamed scene: the bounding box and the filename of each of its cells, every
+		// cell being a scene file with its own asset references; cells are indexed on a grid of the XZ plane
+		class SceneTableOfContents :
+			public std::enable_shared_from_this<SceneTableOfContents>
+		{
+		public:
+			typedef std::shared_ptr<SceneTableOfContents>	Ptr;
+
+		private:
+			typedef std::shared_ptr<math::Box>				BoxPtr;
+
+			struct Cell
+			{
+				std::string		filename;
+				BoxPtr			box;
+			};
+
+		private:
+			static const uint								VERSION;
+
+			std::vector<Cell>								_cells;
+			// cells overlapping each square of the grid, built on the first query after a change
+			float											_gridSize;
+			std::unordered_map<uint64_t, std::vector<uint>>	_grid;
+			std::vector<uint>								_cellQueries;
+			uint											_queryId;
+
+		public:
+			inline static
+			Ptr
+			create()
+			{
+				return std::shared_ptr<SceneTableOfContents>(new SceneTableOfContents());
+			}
+
+			// reads a table of contents written by serialize()
+			static
+			Ptr
+			create(const std::vector<unsigned char>& data);
+
+			inline
+			uint
+			numCells() const
+			{
+				return _cells.size();
+			}
+
+			inline
+			const std::string&
+			cellFilename(uint cell) const
+			{
+				return _cells.at(cell).filename;
+			}
+
+			inline
+			BoxPtr
+			cellBox(uint cell) const
+			{
+				return _cells.at(cell).box;
+			}
+
+			uint
+			addCell(const std::string& filename, BoxPtr box);
+
+			// cells whose bounding box is closer than distance to position, by increasing index
+			void
+			cellsWithin(std::shared_ptr<math::Vector3> position, float distance, std::vector<uint>& cells);
+
+			static
+			float
+			distance(BoxPtr box, std::shared_ptr<math::Vector3> position);
+
+			std::string
+			serialize() const;
+
+		private:
+			SceneTableOfContents();
+
+			void
+			buildGrid();
+
+			inline
+			uint64_t
+			gridKey(int x, int z) const
+			{
+				return (uint64_t(uint(x)) << 32) | uint(z);
+			}
+		};
+	}
+}
@@ -50,6 +50,11 @@ namespace minko
 				return stream.str();
 			}
 
+			// zigzag encoded differences between consecutive values, as variable length integers
+			static
+			std::string
+			serializeDeltaVector(const std::vector<uint>& vect);
+
 			static
 			std::tuple<uint, std::string>
 			serializeVector4(Any value);
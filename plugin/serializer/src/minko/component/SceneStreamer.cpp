@@ -0,0 +1,236 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/component/SceneStreamer.hpp"
+
+#include "minko/scene/Node.hpp"
+#include "minko/math/Vector3.hpp"
+#include "minko/file/AbstractLoader.hpp"
+#include "minko/file/AssetLibrary.hpp"
+#include "minko/file/Options.hpp"
+#include "minko/file/SceneParser.hpp"
+#include "minko/file/SceneTableOfContents.hpp"
+
+using namespace minko;
+using namespace minko::component;
+
+SceneStreamer::SceneStreamer(AssetLibraryPtr assets, TableOfContentsPtr tableOfContents, OptionsPtr options) :
+	_assets(assets),
+	_tableOfContents(tableOfContents),
+	_options(options ? options : assets->defaultOptions()),
+	_loadDistance(100.f),
+	_unloadDistance(120.f),
+	_maxConcurrentLoads(2),
+	_maxCellsPerUpdate(1),
+	_cells(tableOfContents->numCells()),
+	_numLoadingCells(0),
+	_loadedCells(),
+	_cellsInRange(),
+	_cellAdded(Signal<Ptr, uint>::create()),
+	_cellRemoved(Signal<Ptr, uint>::create())
+{
+	for (auto& cell : _cells)
+	{
+		cell.state = CellState::UNLOADED;
+		cell.cancelled = false;
+	}
+}
+
+void
+SceneStreamer::initialize()
+{
+	_targetAddedSlot = targetAdded()->connect(std::bind(
+		&SceneStreamer::targetAddedHandler,
+		shared_from_this(),
+		std::placeholders::_1,
+		std::placeholders::_2
+	));
+
+	_targetRemovedSlot = targetRemoved()->connect(std::bind(
+		&SceneStreamer::targetRemovedHandler,
+		shared_from_this(),
+		std::placeholders::_1,
+		std::placeholders::_2
+	));
+}
+
+void
+SceneStreamer::targetAddedHandler(AbsCmpPtr cmp, NodePtr target)
+{
+	if (targets().size() > 1)
+		throw std::logic_error("The same SceneStreamer cannot have 2 different targets");
+}
+
+void
+SceneStreamer::targetRemovedHandler(AbsCmpPtr cmp, NodePtr target)
+{
+	for (uint i = 0; i < _cells.size(); ++i)
+		if (_cells[i].state == CellState::ADDED)
+			removeCell(i);
+}
+
+void
+SceneStreamer::distances(float loadDistance, float unloadDistance)
+{
+	if (loadDistance < 0.f)
+		throw std::invalid_argument("loadDistance");
+	if (unloadDistance < loadDistance)
+		throw std::invalid_argument("unloadDistance must not be smaller than loadDistance");
+
+	_loadDistance = loadDistance;
+	_unloadDistance = unloadDistance;
+}
+
+uint
+SceneStreamer::numAddedCells() const
+{
+	return std::count_if(_cells.begin(), _cells.end(), [](const Cell& cell) { return cell.state == CellState::ADDED; });
+}
+
+void
+SceneStreamer::update(std::shared_ptr<math::Vector3> eyePosition)
+{
+	if (targets().empty())
+		return;
+
+	// removes the cells out of range first so that their memory can be used by the next ones
+	for (uint i = 0; i < _cells.size(); ++i)
+	{
+		auto& cell = _cells[i];
+
+		if (cell.state == CellState::UNLOADED
+			|| file::SceneTableOfContents::distance(_tableOfContents->cellBox(i), eyePosition) <= _unloadDistance)
+			continue;
+
+		if (cell.state == CellState::LOADING)
+			cell.cancelled = true;
+		else
+			removeCell(i);
+	}
+
+	// nearest cells first
+	std::vector<std::pair<float, uint>> cellsToLoad;
+
+	_tableOfContents->cellsWithin(eyePosition, _loadDistance, _cellsInRange);
+	for (auto cell : _cellsInRange)
+	{
+		_cells[cell].cancelled = false;
+		if (_cells[cell].state == CellState::UNLOADED)
+			cellsToLoad.push_back(std::make_pair(
+				file::SceneTableOfContents::distance(_tableOfContents->cellBox(cell), eyePosition),
+				cell
+			));
+	}
+	std::sort(cellsToLoad.begin(), cellsToLoad.end());
+
+	for (auto& distanceAndCell : cellsToLoad)
+	{
+		if (_numLoadingCells >= _maxConcurrentLoads)
+			break;
+
+		loadCell(distanceAndCell.second, distanceAndCell.first);
+	}
+
+	// what a cell uploads to the GPU is spread over several updates
+	for (uint i = 0; i < _maxCellsPerUpdate && !_loadedCells.empty(); ++i)
+	{
+		auto	cellId	= _loadedCells.front();
+		auto&	cell	= _cells[cellId];
+
+		_loadedCells.pop_front();
+
+		cell.state = CellState::ADDED;
+		targets()[0]->addChild(cell.node);
+		_cellAdded->execute(shared_from_this(), cellId);
+	}
+}
+
+void
+SceneStreamer::loadCell(uint cell, float distance)
+{
+	auto options = file::Options::create(_options);
+
+	// the dependencies of the nearest cells are fetched first
+	options->loadPriority(_options->loadPriority() - (int)distance);
+
+	_cells[cell].state = CellState::LOADING;
+	++_numLoadingCells;
+
+	auto that = shared_from_this();
+
+	_assets->fetch(
+		_tableOfContents->cellFilename(cell),
+		options,
+		[=](std::shared_ptr<file::AbstractLoader> loader)
+		{
+			that->cellLoadedHandler(cell, loader);
+		},
+		[=](std::shared_ptr<file::AbstractLoader> loader)
+		{
+			--that->_numLoadingCells;
+			that->_cells[cell].state = CellState::UNLOADED;
+		}
+	);
+}
+
+void
+SceneStreamer::cellLoadedHandler(uint cellId, std::shared_ptr<file::AbstractLoader> loader)
+{
+	auto&	cell		= _cells[cellId];
+	auto	filename	= _tableOfContents->cellFilename(cellId);
+
+	--_numLoadingCells;
+
+	if (cell.cancelled)
+	{
+		cell.cancelled = false;
+		cell.state = CellState::UNLOADED;
+
+		return;
+	}
+
+	auto parser = file::SceneParser::create();
+
+	parser->parse(filename, loader->resolvedFilename(), loader->options(), loader->data(), _assets);
+
+	cell.node = _assets->symbol(filename);
+	// the cell belongs to the streamer: the library does not keep it once removed
+	_assets->symbol(filename, nullptr);
+
+	cell.state = CellState::LOADED;
+	_loadedCells.push_back(cellId);
+}
+
+void
+SceneStreamer::removeCell(uint cellId)
+{
+	auto& cell = _cells[cellId];
+
+	if (cell.state == CellState::ADDED)
+	{
+		if (cell.node->parent())
+			cell.node->parent()->removeChild(cell.node);
+		_cellRemoved->execute(shared_from_this(), cellId);
+	}
+	else
+		_loadedCells.remove(cellId);
+
+	cell.node = nullptr;
+	cell.state = CellState::UNLOADED;
+}
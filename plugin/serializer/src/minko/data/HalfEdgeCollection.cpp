@@ -32,15 +32,15 @@ void
 HalfEdgeCollection::initialize()
 {
 	unsigned int					id		= 0;
-	std::vector<unsigned short>		data	= _indexStream->data();
+	const std::vector<uint>&		data	= _indexStream->data();
 
 	HalfEdgeMap map;
 
 	for (unsigned int i = 0; i < data.size(); i += 3)
 	{
-		unsigned short t1 = data[i];
-		unsigned short t2 = data[i + 1];
-		unsigned short t3 = data[i + 2];
+		uint t1 = data[i];
+		uint t2 = data[i + 1];
+		uint t3 = data[i + 2];
 
 		HalfEdgePtr he1 = HalfEdge::create(t1, t2, id++);
 		HalfEdgePtr he2 = HalfEdge::create(t2, t3, id++);
@@ -275,7 +275,6 @@ ComponentDeserializer::deserializeSkinning(std::string&		serializedAnimation,
 		std::tuple<uint, std::string&>	serializedMatrixTuple(serializedBone.a3.a0, serializedBone.a3.a1);
 		std::string						nodeName		= serializedBone.a0;
 		std::vector<uint>				vertexIntIds	= TypeDeserializer::deserializeVector<uint, uint>(serializedBone.a1);
-		std::vector<unsigned short>		vertexShortIds(vertexIntIds.begin(), vertexIntIds.end());
 		std::vector<float>				boneWeight		= TypeDeserializer::deserializeVector<float>(serializedBone.a2);
 		auto							offsetMatrix	= Any::cast<Matrix4x4Ptr>(deserialize::TypeDeserializer::deserializeMatrix4x4(serializedMatrixTuple));
 
@@ -284,7 +283,7 @@ ComponentDeserializer::deserializeSkinning(std::string&		serializedAnimation,
 			return n->name() == nodeName;
 		});
 
-		bones.push_back(geometry::Bone::create(nodeSet->nodes()[0], offsetMatrix, vertexShortIds, boneWeight));
+		bones.push_back(geometry::Bone::create(nodeSet->nodes()[0], offsetMatrix, vertexIntIds, boneWeight));
 
 	}
 
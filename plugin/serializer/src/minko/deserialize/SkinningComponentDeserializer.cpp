@@ -125,8 +125,12 @@ SkinningComponentDeserializer::computeSkinning(file::Options::Ptr						options,
     // Transform and Animation components.
     cleanNode(skeletonRoot, false);
 
+    skin->reorganizeByVertices()->transposeMatrices()->disposeBones();
+    if (options->skinningCompressionTolerance() > 0.0f)
+        skin->compressMatrices(options->skinningCompressionTolerance());
+
 	return Skinning::create(
-        skin->reorganizeByVertices()->transposeMatrices()->disposeBones(),
+        skin,
         options->skinningMethod(),
         context,
         std::vector<Animation::Ptr>()
@@ -32,6 +32,37 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 using namespace minko;
 using namespace minko::deserialize;
 
+void
+TypeDeserializer::deserializeDeltaVector(const char* serializedValue, uint size, std::vector<uint>& result)
+{
+	auto	data		= reinterpret_cast<const unsigned char*>(serializedValue);
+	auto	end			= data + size;
+	uint	previous	= 0;
+
+	result.clear();
+	result.reserve(size);
+
+	while (data != end)
+	{
+		uint zigzag = 0;
+
+		for (uint shift = 0; ; shift += 7)
+		{
+			if (data == end || shift > 28)
+				throw std::invalid_argument("serializedValue");
+
+			const auto byte = *data++;
+
+			zigzag |= static_cast<uint>(byte & 0x7f) << shift;
+			if (!(byte & 0x80))
+				break;
+		}
+
+		previous += (zigzag >> 1) ^ (0u - (zigzag & 1));
+		result.push_back(previous);
+	}
+}
+
 Any
 TypeDeserializer::deserializeVector4(std::tuple<uint, std::string&>& serializedVector)
 {
@@ -30,10 +30,53 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/Types.hpp"
 #include "minko/render/Texture.hpp"
 
+#if !defined(EMSCRIPTEN)
+# include <atomic>
+# include <future>
+# include <thread>
+#endif
+
+#if defined(_MSC_VER)
+# define MINKO_SERIALIZER_THREAD_LOCAL	__declspec(thread)
+#else
+# define MINKO_SERIALIZER_THREAD_LOCAL	__thread
+#endif
 
 using namespace minko;
 using namespace minko::file;
 
+namespace
+{
+	// the zones of each thread, stacked as the parsers nest; they live as long as their thread
+	struct ZonePool
+	{
+		std::vector<msgpack::zone*>	zones;
+		uint						numUsed;
+	};
+
+	MINKO_SERIALIZER_THREAD_LOCAL ZonePool* zonePool = nullptr;
+}
+
+AbstractSerializerParser::ScopedZone::ScopedZone()
+{
+	if (!zonePool)
+	{
+		zonePool = new ZonePool();
+		zonePool->numUsed = 0;
+	}
+
+	if (zonePool->numUsed == zonePool->zones.size())
+		zonePool->zones.push_back(new msgpack::zone());
+
+	_zone = zonePool->zones[zonePool->numUsed++];
+}
+
+AbstractSerializerParser::ScopedZone::~ScopedZone()
+{
+	_zone->clear();
+	--zonePool->numUsed;
+}
+
 std::unordered_map<uint, std::function<void(unsigned char, 
 											AbstractSerializerParser::AssetLibraryPtr, 
 											std::string&, 
@@ -70,44 +113,39 @@ AbstractSerializerParser::parse(const std::string&					filename,
 {
 }
 
-std::string
+msgpack::type::raw_ref
 AbstractSerializerParser::extractDependencies(AssetLibraryPtr						assetLibrary,
 											  const std::vector<unsigned char>&		data,
 											  std::shared_ptr<Options>				options,
 											  std::string&							assetFilePath)
 {
 	msgpack::object			msgpackObject;
-	msgpack::zone			mempool;
-	std::string				str(data.begin(), data.end());
-	msgpack::type::tuple<std::vector<SerializedAsset>, std::string> serilizedAssets;
+	ScopedZone				mempool;
+	msgpack::type::tuple<std::vector<SerializedAsset>, msgpack::type::raw_ref> serilizedAssets;
+
+	if (data.empty())
+		throw std::invalid_argument("data");
 
-	msgpack::unpack(str.data(), str.size(), NULL, &mempool, &msgpackObject);
+	// unpacked raw objects reference data directly: neither the file nor its embedded content is copied
+	msgpack::unpack(reinterpret_cast<const char*>(&data[0]), data.size(), NULL, mempool.get(), &msgpackObject);
 	msgpackObject.convert(&serilizedAssets);
 
+	std::vector<PreparedAsset> prepared;
+
+	prepareAssets(serilizedAssets.a0, msgpackObject.via.array.ptr[0], assetLibrary, options, assetFilePath, prepared);
+
 	for (uint index = 0; index < serilizedAssets.a0.size(); ++index)
-		deserializedAsset(serilizedAssets.a0[index], assetLibrary, options, assetFilePath);
+		deserializedAsset(serilizedAssets.a0[index], assetLibrary, options, assetFilePath, prepared[index]);
 
 	return serilizedAssets.a1;
 }
 
 void
-AbstractSerializerParser::deserializedAsset(SerializedAsset				asset,
-											AssetLibraryPtr				assetLibrary,
-											std::shared_ptr<Options>	options,
-											std::string&				assetFilePath)
+AbstractSerializerParser::readAssetData(const SerializedAsset&			asset,
+										const std::string&				assetCompletePath,
+										std::vector<unsigned char>&		data)
 {
-
-	std::vector<unsigned char>	data;
-	std::string					assetCompletePath	= assetFilePath + "/";
-	std::string					resolvedPath		= "";
-	unsigned char				metaByte			= (asset.a0 & 0xFF00) >> 8;
-
-	asset.a0 = asset.a0 & 0x00FF;
-
-	assetCompletePath += asset.a2;
-	resolvedPath = asset.a2;
-
-	if (asset.a0 < 10) // external
+	if ((asset.a0 & 0x00FF) < 10) // external
 	{
 		auto							flags = std::ios::in | std::ios::ate | std::ios::binary;
 		std::fstream					file(assetCompletePath, flags);
@@ -116,8 +154,6 @@ AbstractSerializerParser::deserializedAsset(SerializedAsset				asset,
 		{
 			unsigned int size = (unsigned int)file.tellg();
 
-			// FIXME: use fixed size buffers and call _progress accordingly
-
 			data.resize(size);
 
 			file.seekg(0, std::ios::beg);
@@ -128,48 +164,193 @@ AbstractSerializerParser::deserializedAsset(SerializedAsset				asset,
 			throw std::invalid_argument("file already open");
 	}
 	else
-		std::copy(asset.a2.begin(), asset.a2.end(), back_inserter(data));
+		data.assign(asset.a2.ptr, asset.a2.ptr + asset.a2.size); // the parsers take their input as a vector
+}
 
-	if (asset.a0 == serialize::AssetType::GEOMETRY_ASSET || asset.a0 == serialize::AssetType::EMBED_GEOMETRY_ASSET) // geometry
+void
+AbstractSerializerParser::prepareAssets(std::vector<SerializedAsset>&	assets,
+										const msgpack::object&			serializedAssets,
+										AssetLibraryPtr					assetLibrary,
+										std::shared_ptr<Options>		options,
+										const std::string&				assetFilePath,
+										std::vector<PreparedAsset>&		prepared)
+{
+	std::vector<uint> decodedAssets;
+
+	prepared.resize(assets.size());
+
+	// parsers are created here, on the main thread, the workers only call decode()
+	for (uint index = 0; index < assets.size(); ++index)
 	{
-		_geometryParser->dependecy(_dependencies);
-		if (asset.a0 == serialize::AssetType::EMBED_GEOMETRY_ASSET)
+		auto type = assets[index].a0 & 0x00FF;
+		std::shared_ptr<AbstractParser> parser;
+
+		// the content hash is an optional fourth field of each asset
+		const auto& serializedAsset = serializedAssets.via.array.ptr[index];
+
+		prepared[index].contentHash = 0;
+		if (serializedAsset.type == msgpack::type::ARRAY && serializedAsset.via.array.size > 3)
+			serializedAsset.via.array.ptr[3].convert(&prepared[index].contentHash);
+
+		if (prepared[index].contentHash != 0)
+		{
+			auto loadedName = assetLibrary->hashedAssetName(prepared[index].contentHash);
+
+			// another file already loaded the same content: it is neither read nor decoded again
+			if (!loadedName.empty() && hasAsset(type, loadedName, assetLibrary))
+			{
+				prepared[index].loadedName = loadedName;
+
+				continue;
+			}
+		}
+
+		if (type == serialize::AssetType::GEOMETRY_ASSET || type == serialize::AssetType::EMBED_GEOMETRY_ASSET)
+			parser = GeometryParser::create();
+		else if (type == serialize::AssetType::TEXTURE_ASSET || type == serialize::AssetType::EMBED_TEXUTRE_ASSET)
+			parser = assetLibrary->getParser("png");
+
+		if (parser && parser->decodesAsynchronously())
+		{
+			prepared[index].parser = parser;
+			decodedAssets.push_back(index);
+		}
+	}
+
+	auto decodeAsset = [&](uint index)
+	{
+		auto& asset = assets[index];
+		auto& preparedAsset = prepared[index];
+
+		const std::string name(asset.a2.ptr, asset.a2.size);
+
+		readAssetData(asset, assetFilePath + "/" + name, preparedAsset.data);
+		preparedAsset.parser->decode(name, options, preparedAsset.data);
+	};
+
+#if defined(EMSCRIPTEN)
+	for (auto index : decodedAssets)
+		decodeAsset(index);
+#else
+	std::atomic<uint> next(0);
+	auto work = [&]()
+	{
+		for (uint i = next++; i < decodedAssets.size(); i = next++)
+			decodeAsset(decodedAssets[i]);
+	};
+
+	auto numWorkers = std::min<uint>(std::max(1u, std::thread::hardware_concurrency()), decodedAssets.size());
+	std::vector<std::future<void>> workers;
+
+	for (uint i = 1; i < numWorkers; ++i)
+		workers.push_back(std::async(std::launch::async, work));
+	work();
+
+	for (auto& worker : workers)
+		worker.get();
+#endif
+}
+
+/*static*/
+bool
+AbstractSerializerParser::hasAsset(uint type, const std::string& name, AssetLibraryPtr assetLibrary)
+{
+	if (type == serialize::AssetType::GEOMETRY_ASSET || type == serialize::AssetType::EMBED_GEOMETRY_ASSET)
+		return assetLibrary->geometry(name) != nullptr;
+	if (type == serialize::AssetType::MATERIAL_ASSET || type == serialize::AssetType::EMBED_MATERIAL_ASSET)
+		return assetLibrary->material(name) != nullptr;
+	if (type == serialize::AssetType::TEXTURE_ASSET || type == serialize::AssetType::EMBED_TEXUTRE_ASSET)
+		return assetLibrary->texture(name) != nullptr;
+
+	return false;
+}
+
+void
+AbstractSerializerParser::deserializedAsset(const SerializedAsset&		asset,
+											AssetLibraryPtr				assetLibrary,
+											std::shared_ptr<Options>	options,
+											std::string&				assetFilePath,
+											PreparedAsset&				prepared)
+{
+
+	std::vector<unsigned char>	data;
+	std::string					assetCompletePath	= assetFilePath + "/";
+	std::string					resolvedPath		= "";
+	unsigned char				metaByte			= (asset.a0 & 0xFF00) >> 8;
+	const uint					type				= asset.a0 & 0x00FF;
+
+	if (!prepared.loadedName.empty())
+	{
+		if (type == serialize::AssetType::GEOMETRY_ASSET || type == serialize::AssetType::EMBED_GEOMETRY_ASSET)
+			_dependencies->registerReference(asset.a1, assetLibrary->geometry(prepared.loadedName));
+		else if (type == serialize::AssetType::MATERIAL_ASSET || type == serialize::AssetType::EMBED_MATERIAL_ASSET)
+			_dependencies->registerReference(asset.a1, std::dynamic_pointer_cast<data::Provider>(assetLibrary->material(prepared.loadedName)));
+		else
+			_dependencies->registerReference(asset.a1, assetLibrary->texture(prepared.loadedName));
+
+		return;
+	}
+
+	// the embedded geometries, materials and textures are named after their id: their content is not copied
+	if (type < serialize::AssetType::EMBED_GEOMETRY_ASSET || type > serialize::AssetType::EMBED_TEXUTRE_ASSET)
+		resolvedPath.assign(asset.a2.ptr, asset.a2.size);
+	assetCompletePath += resolvedPath;
+
+	if (prepared.parser)
+		data.swap(prepared.data);
+	else
+		readAssetData(asset, assetCompletePath, data);
+
+	if (type == serialize::AssetType::GEOMETRY_ASSET || type == serialize::AssetType::EMBED_GEOMETRY_ASSET) // geometry
+	{
+		auto geometryParser = prepared.parser
+			? std::static_pointer_cast<GeometryParser>(prepared.parser)
+			: _geometryParser;
+
+		geometryParser->dependecy(_dependencies);
+		if (type == serialize::AssetType::EMBED_GEOMETRY_ASSET)
 			resolvedPath = "geometry_" + std::to_string(asset.a1);
-		_geometryParser->parse(resolvedPath, assetCompletePath, options, data, assetLibrary);
-		_dependencies->registerReference(asset.a1, assetLibrary->geometry(_geometryParser->_lastParsedAssetName));
+		geometryParser->parse(resolvedPath, assetCompletePath, options, data, assetLibrary);
+		_dependencies->registerReference(asset.a1, assetLibrary->geometry(geometryParser->_lastParsedAssetName));
+		if (prepared.contentHash != 0)
+			assetLibrary->hashedAssetName(prepared.contentHash, geometryParser->_lastParsedAssetName);
 		_jobList.merge(_materialParser->_jobList);
 	}
-	else if (asset.a0 == serialize::AssetType::MATERIAL_ASSET || asset.a0 == serialize::AssetType::EMBED_MATERIAL_ASSET) // material
+	else if (type == serialize::AssetType::MATERIAL_ASSET || type == serialize::AssetType::EMBED_MATERIAL_ASSET) // material
 	{
 		_materialParser->dependecy(_dependencies);
-		if (asset.a0 == serialize::AssetType::EMBED_MATERIAL_ASSET)
+		if (type == serialize::AssetType::EMBED_MATERIAL_ASSET)
 			resolvedPath = "material_" + std::to_string(asset.a1);
 		_materialParser->parse(resolvedPath, assetCompletePath, options, data, assetLibrary);
 		_dependencies->registerReference(asset.a1, std::dynamic_pointer_cast<data::Provider>(assetLibrary->material(_materialParser->_lastParsedAssetName)));
+		if (prepared.contentHash != 0)
+			assetLibrary->hashedAssetName(prepared.contentHash, _materialParser->_lastParsedAssetName);
 		_jobList.merge(_materialParser->_jobList);
 	}
-	else if (asset.a0 == serialize::AssetType::TEXTURE_ASSET || asset.a0 == serialize::AssetType::EMBED_TEXUTRE_ASSET) // texture
+	else if (type == serialize::AssetType::TEXTURE_ASSET || type == serialize::AssetType::EMBED_TEXUTRE_ASSET) // texture
 	{
-		if (asset.a0 == serialize::AssetType::EMBED_TEXUTRE_ASSET)
+		if (type == serialize::AssetType::EMBED_TEXUTRE_ASSET)
 		{
 			resolvedPath = std::to_string(asset.a1) + ".png";
 			assetCompletePath += resolvedPath;
 		}
 
-		std::shared_ptr<file::AbstractParser> parser = assetLibrary->getParser("png");
+		std::shared_ptr<file::AbstractParser> parser = prepared.parser ? prepared.parser : assetLibrary->getParser("png");
 
 		parser->parse(resolvedPath, assetCompletePath, options, data, assetLibrary);
 		_dependencies->registerReference(asset.a1, assetLibrary->texture(resolvedPath));
+		if (prepared.contentHash != 0)
+			assetLibrary->hashedAssetName(prepared.contentHash, resolvedPath);
 	}
-	else if (asset.a0 == serialize::AssetType::EFFECT_ASSET) // effect
+	else if (type == serialize::AssetType::EFFECT_ASSET) // effect
 	{
 		assetLibrary->load(assetCompletePath, nullptr, nullptr, false);
 		_dependencies->registerReference(asset.a1, assetLibrary->effect(assetCompletePath));
 	}
 	else
 	{
-		if (_assetTypeToFunction.find(asset.a0) != _assetTypeToFunction.end())
-			_assetTypeToFunction[asset.a0](metaByte, assetLibrary, assetCompletePath, _dependencies, asset.a1, _jobList);
+		if (_assetTypeToFunction.find(type) != _assetTypeToFunction.end())
+			_assetTypeToFunction[type](metaByte, assetLibrary, assetCompletePath, _dependencies, asset.a1, _jobList);
 	}
 }
 
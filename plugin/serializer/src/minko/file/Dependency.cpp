@@ -21,10 +21,32 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/file/GeometryWriter.hpp"
 #include "minko/geometry/Geometry.hpp"
 #include "minko/file/MaterialWriter.hpp"
+#include "minko/material/Material.hpp"
+
+#if !defined(EMSCRIPTEN)
+# include <atomic>
+# include <future>
+# include <thread>
+#endif
 
 using namespace minko;
 using namespace minko::file;
 
+static const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+
+static
+uint64_t
+hashBytes(uint64_t hash, const char* data, size_t size)
+{
+	for (size_t i = 0; i < size; ++i)
+	{
+		hash ^= static_cast<unsigned char>(data[i]);
+		hash *= 1099511628211ull;
+	}
+
+	return hash;
+}
+
 
 bool
 Dependency::hasDependency(std::shared_ptr<render::Effect> effect)
@@ -65,8 +87,24 @@ Dependency::hasDependency(std::shared_ptr<data::Provider> material)
 uint
 Dependency::registerDependency(std::shared_ptr<data::Provider> material)
 {
-	if (!hasDependency(material))
-		_materialDependencies[material] = _currentId++;
+	if (hasDependency(material))
+		return _materialDependencies[material];
+
+	auto		mat = std::dynamic_pointer_cast<material::Material>(material);
+	std::string	key;
+
+	// identical materials are written once and referenced by all the surfaces using them
+	if (mat && mat->propertiesKey(key))
+	{
+		auto sharedIt = _materialKeyToId.find(key);
+
+		if (sharedIt != _materialKeyToId.end())
+			return sharedIt->second;
+
+		_materialKeyToId[key] = _currentId;
+	}
+
+	_materialDependencies[material] = _currentId++;
 
 	return _materialDependencies[material];
 }
@@ -161,40 +199,145 @@ Dependency::getEffectReference(uint effectId)
 	return _effectReferences[effectId];
 }
 
-std::vector<msgpack::type::tuple<short, short, std::string>>
+/*static*/
+uint64_t
+Dependency::contentHash(const std::string& content)
+{
+	// 64 bits FNV-1a, stable between builds and platforms
+	auto hash = hashBytes(FNV_OFFSET_BASIS, content.c_str(), content.size());
+
+	// 0 is kept for the assets without hash
+	return hash != 0 ? hash : 1;
+}
+
+static
+void
+writeFile(const std::string& filename, const std::string& content)
+{
+	std::ofstream file(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+
+	if (file)
+		file.write(content.c_str(), content.size());
+	else
+		std::cerr << "File " << filename << " can't be opened" << std::endl;
+}
+
+/*static*/
+uint64_t
+Dependency::copyFile(const std::string& source, const std::string& destination)
+{
+	std::ifstream	input(source, std::ios::binary);
+	std::ofstream	output(destination, std::ios::out | std::ios::binary | std::ios::trunc);
+	auto			hash = FNV_OFFSET_BASIS;
+	char			buffer[1 << 16];
+
+	if (!output)
+		std::cerr << "File " << destination << " can't be opened" << std::endl;
+
+	// the content goes through a fixed size buffer instead of being loaded whole
+	while (input)
+	{
+		input.read(buffer, sizeof(buffer));
+
+		const auto size = static_cast<size_t>(input.gcount());
+
+		hash = hashBytes(hash, buffer, size);
+		if (output)
+			output.write(buffer, size);
+	}
+
+	return hash != 0 ? hash : 1;
+}
+
+void
+Dependency::serializeGeometries(std::shared_ptr<file::AssetLibrary>	assetLibrary,
+								std::shared_ptr<file::Options>		options,
+								SerializedAssets&					serializedAssets)
+{
+	std::vector<std::pair<std::shared_ptr<geometry::Geometry>, uint>>	geometries(
+		_geometryDependencies.begin(), _geometryDependencies.end()
+	);
+	std::vector<std::string>											filenames;
+	std::vector<uint64_t>												hashes(geometries.size());
+	std::vector<GeometryWriter::Ptr>									writers;
+
+	if (geometries.empty())
+		return;
+
+	for (auto& geometry : geometries)
+		filenames.push_back(assetLibrary->geometryName(geometry.first) + ".geometry");
+
+	// each geometry is encoded, written and released by the worker that picked it: at most one encoded
+	// geometry per worker is in memory at once
+	auto writeGeometry = [&](GeometryWriter::Ptr writer, uint index)
+	{
+		writer->data(geometries[index].first);
+
+		const auto content = writer->serialize(assetLibrary, options);
+
+		writeFile(filenames[index], content);
+		hashes[index] = contentHash(content);
+	};
+
+#if defined(EMSCRIPTEN)
+	auto writer = GeometryWriter::create();
+
+	for (uint i = 0; i < geometries.size(); ++i)
+		writeGeometry(writer, i);
+#else
+	auto numWorkers = std::min<uint>(std::max(1u, std::thread::hardware_concurrency()), geometries.size());
+	std::atomic<uint> next(0);
+	std::vector<std::future<void>> workers;
+
+	// the writers are created here, on the calling thread
+	for (uint i = 0; i < numWorkers; ++i)
+		writers.push_back(GeometryWriter::create());
+
+	auto work = [&](uint worker)
+	{
+		for (uint i = next++; i < geometries.size(); i = next++)
+			writeGeometry(writers[worker], i);
+	};
+
+	for (uint i = 1; i < numWorkers; ++i)
+		workers.push_back(std::async(std::launch::async, work, i));
+	work(0);
+
+	for (auto& worker : workers)
+		worker.get();
+#endif
+
+	for (uint i = 0; i < geometries.size(); ++i)
+		serializedAssets.push_back(SerializedAsset(0, geometries[i].second, filenames[i], hashes[i]));
+}
+
+Dependency::SerializedAssets
 Dependency::serialize(std::shared_ptr<file::AssetLibrary>	assetLibrary, 
 					  std::shared_ptr<file::Options>		options)
 {
-	GeometryWriter::Ptr geometryWriter = GeometryWriter::create();
-	MaterialWriter::Ptr materialWriter = MaterialWriter::create();
+	// the writers fill static tables when created: the geometry workers serialize empty dependencies,
+	// that must not create any
+	MaterialWriter::Ptr materialWriter = _materialDependencies.empty() ? nullptr : MaterialWriter::create();
 
-	std::vector<msgpack::type::tuple<short, short, std::string>> serializedAsset;
+	SerializedAssets serializedAsset;
 
-	auto itGeometry = _geometryDependencies.begin();
 	auto itMaterial = _materialDependencies.begin();
 	auto itTexture	= _textureDependencies.begin();
 	auto itEffect	= _effectDependencies.begin();
 
-	while (itGeometry != _geometryDependencies.end())
-	{
-		std::string filename = assetLibrary->geometryName(itGeometry->first) + ".geometry";
-
-		geometryWriter->data(itGeometry->first);
-		geometryWriter->write(filename, assetLibrary, options);
-
-		msgpack::type::tuple<short, short, std::string> res(0, itGeometry->second, filename);
-		serializedAsset.push_back(res);
-		itGeometry++;
-	}
+	serializeGeometries(assetLibrary, options, serializedAsset);
 
 	while (itMaterial != _materialDependencies.end())
 	{
 		std::string filename = assetLibrary->materialName(itMaterial->first) + ".material";
 
 		materialWriter->data(itMaterial->first);
-		materialWriter->write(filename, assetLibrary, options);
 
-		msgpack::type::tuple<short, short, std::string> res(1, itMaterial->second, filename);
+		const auto content = materialWriter->serialize(assetLibrary, options);
+
+		writeFile(filename, content);
+
+		SerializedAsset res(1, itMaterial->second, filename, contentHash(content));
 		serializedAsset.push_back(res);
 		itMaterial++;
 	}
@@ -210,16 +353,9 @@ Dependency::serialize(std::shared_ptr<file::AssetLibrary>	assetLibrary,
 
 		for (int charIndex = filenameInput.size() - 1; charIndex >= 0 && filenameInput[charIndex] != '/'; --charIndex)
 			filenameOutput.insert(0, filenameInput.substr(charIndex, 1));
-		std::ifstream source(filenameInput, std::ios::binary);
-		std::ofstream dst(filenameOutput, std::ios::binary);
-
-		dst << source.rdbuf();
 
-		source.close();
-		dst.close();
+		SerializedAsset res(2, itTexture->second, filenameOutput, copyFile(filenameInput, filenameOutput));
 
-		msgpack::type::tuple<short, short, std::string> res(2, itTexture->second, filenameOutput);
-		
 		serializedAsset.insert(serializedAsset.begin(), res);
 		itTexture++;
 	}
@@ -244,7 +380,7 @@ Dependency::serialize(std::shared_ptr<file::AssetLibrary>	assetLibrary,
 		source.close();
 		dst.close();
 
-		msgpack::type::tuple<short, short, std::string> res(3, itEffect->second, filenameOutput);
+		SerializedAsset res(3, itEffect->second, filenameOutput, 0);
 		serializedAsset.insert(serializedAsset.begin(), res);
 		itEffect++;
 	}
@@ -25,12 +25,14 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/file/AssetLibrary.hpp"
 #include "minko/deserialize/TypeDeserializer.hpp"
 #include "minko/file/Options.hpp"
+#include "minko/Types.hpp"
 
 using namespace minko;
 using namespace minko::file;
 
 std::function<std::shared_ptr<render::IndexBuffer>(std::string&, std::shared_ptr<render::AbstractContext>)>		GeometryParser::indexBufferParserFunction;
 std::function<std::shared_ptr<render::VertexBuffer>(std::string&, std::shared_ptr<render::AbstractContext>)>	GeometryParser::vertexBufferParserFunction;
+bool GeometryParser::_customBufferParsers = false;
 
 void
 GeometryParser::initialize()
@@ -39,47 +41,279 @@ GeometryParser::initialize()
 	vertexBufferParserFunction	= std::bind(&GeometryParser::deserializeVertexBuffer, std::placeholders::_1, std::placeholders::_2);
 }
 
-std::shared_ptr<render::VertexBuffer>
-GeometryParser::deserializeVertexBuffer(std::string&								serializedVertexBuffer, 
-										std::shared_ptr<render::AbstractContext>	context)
+void
+GeometryParser::decodeIndices(uchar metaByte, const char* stream, uint size, std::vector<uint>& indices)
+{
+	// same choice as computeMetaByte(), without touching the shared parser functions
+	if (metaByte & (1u << 5))
+		deserialize::TypeDeserializer::deserializeDeltaVector(stream, size, indices);
+	else if (metaByte & (1u << 7))
+		deserialize::TypeDeserializer::deserializeVector<uint, unsigned char>(stream, size, indices);
+	else if (metaByte & (1u << 6))
+		deserialize::TypeDeserializer::deserializeVector<uint>(stream, size, indices);
+	else
+		deserialize::TypeDeserializer::deserializeVector<uint, unsigned short>(stream, size, indices);
+}
+
+void
+GeometryParser::decodeVertexBuffer(const char* serializedVertexBuffer, uint size, DecodedVertexBuffer& vertexBuffer)
 {
-	msgpack::object														msgpackObject;
-	msgpack::zone														mempool;
-	msgpack::type::tuple<std::string, std::vector<SerializeAttribute>>	deserializedVertex;
+	msgpack::object																msgpackObject;
+	ScopedZone																	mempool;
+	msgpack::type::tuple<msgpack::type::raw_ref, std::vector<SerializeAttribute>>	deserializedVertex;
 
-	msgpack::unpack(serializedVertexBuffer.data(), serializedVertexBuffer.size(), NULL, &mempool, &msgpackObject);
+	msgpack::unpack(serializedVertexBuffer, size, NULL, mempool.get(), &msgpackObject);
 	msgpackObject.convert(&deserializedVertex);
 
-	std::vector<float>		vector			= deserialize::TypeDeserializer::deserializeVector<float>(deserializedVertex.a0);
-	VertexBufferPtr			vertexBuffer	= render::VertexBuffer::create(context, vector);
+	// files written before typed attributes have no attribute types
+	vertexBuffer.attributeTypes.clear();
+	if (msgpackObject.type == msgpack::type::ARRAY && msgpackObject.via.array.size > 2)
+		msgpackObject.via.array.ptr[2].convert(&vertexBuffer.attributeTypes);
+
+	vertexBuffer.attributes	= deserializedVertex.a1;
+
+	// compressed streams also have the encoding of each attribute and their quantization bounds
+	if (msgpackObject.type == msgpack::type::ARRAY && msgpackObject.via.array.size > 4)
+	{
+		std::vector<unsigned char>	encodings;
+		std::vector<float>			bounds;
+
+		msgpackObject.via.array.ptr[3].convert(&encodings);
+		msgpackObject.via.array.ptr[4].convert(&bounds);
+
+		decodeCompressedVertexStream(
+			deserializedVertex.a0.ptr, deserializedVertex.a0.size, vertexBuffer.attributes, encodings, bounds, vertexBuffer.data
+		);
+	}
+	else
+		deserialize::TypeDeserializer::deserializeVector<float>(
+			deserializedVertex.a0.ptr, deserializedVertex.a0.size, vertexBuffer.data
+		);
+}
+
+static
+unsigned short
+readDelta16(const unsigned char*& stream, unsigned short& previous)
+{
+	previous = static_cast<unsigned short>(previous + (stream[0] | (stream[1] << 8)));
+	stream += 2;
+
+	return previous;
+}
+
+void
+GeometryParser::decodeCompressedVertexStream(const char*							stream,
+											 uint									size,
+											 const std::vector<SerializeAttribute>&	attributes,
+											 const std::vector<unsigned char>&		encodings,
+											 const std::vector<float>&				bounds,
+											 std::vector<float>&					data)
+{
+	uint vertexSize			= 0;
+	uint streamVertexSize	= 0;
+	uint numBounds			= 0;
+
+	if (encodings.size() != attributes.size())
+		throw std::invalid_argument("encodings");
 
-	uint numAttributes = deserializedVertex.a1.size();
+	for (uint i = 0; i < attributes.size(); ++i)
+	{
+		const uint attributeSize = attributes[i].a1;
+
+		vertexSize += attributeSize;
+		if (encodings[i] == serialize::StreamEncoding::QUANTIZED_16)
+		{
+			streamVertexSize += attributeSize * 2;
+			numBounds += attributeSize * 2;
+		}
+		else if (encodings[i] == serialize::StreamEncoding::OCTAHEDRAL_16)
+			streamVertexSize += 4;
+		else
+			streamVertexSize += attributeSize * sizeof(float);
+	}
+
+	if (bounds.size() != numBounds || (streamVertexSize != 0 && size % streamVertexSize != 0))
+		throw std::invalid_argument("stream");
+
+	const uint	numVertices	= streamVertexSize != 0 ? size / streamVertexSize : 0;
+	auto		bytes		= reinterpret_cast<const unsigned char*>(stream);
+	auto		bound		= bounds.begin();
+
+	// written in place, this vector becomes the data of the vertex buffer
+	data.resize(numVertices * vertexSize);
+
+	for (uint i = 0; i < attributes.size(); ++i)
+	{
+		const uint attributeSize	= attributes[i].a1;
+		const uint offset			= attributes[i].a2;
+
+		if (encodings[i] == serialize::StreamEncoding::QUANTIZED_16)
+		{
+			for (uint j = 0; j < attributeSize; ++j, bound += 2)
+			{
+				const float		min			= bound[0];
+				const float		scale		= (bound[1] - min) / 65535.f;
+				unsigned short	previous	= 0;
+
+				for (uint vertexId = 0; vertexId < numVertices; ++vertexId)
+					data[vertexId * vertexSize + offset + j] = min + readDelta16(bytes, previous) * scale;
+			}
+		}
+		else if (encodings[i] == serialize::StreamEncoding::OCTAHEDRAL_16)
+		{
+			unsigned short previousX = 0;
+			unsigned short previousY = 0;
+
+			for (uint vertexId = 0; vertexId < numVertices; ++vertexId)
+			{
+				float*	n	= &data[vertexId * vertexSize + offset];
+				float	x	= std::max(-1.f, static_cast<short>(readDelta16(bytes, previousX)) / 32767.f);
+				float	y	= std::max(-1.f, static_cast<short>(readDelta16(bytes, previousY)) / 32767.f);
+				float	z	= 1.f - fabsf(x) - fabsf(y);
+
+				if (z < 0.f)
+				{
+					const float unfoldedX = (1.f - fabsf(y)) * (x >= 0.f ? 1.f : -1.f);
+					const float unfoldedY = (1.f - fabsf(x)) * (y >= 0.f ? 1.f : -1.f);
+
+					x = unfoldedX;
+					y = unfoldedY;
+				}
+
+				const float length = sqrtf(x * x + y * y + z * z);
+
+				n[0] = x / length;
+				n[1] = y / length;
+				n[2] = z / length;
+			}
+		}
+		else
+		{
+			for (uint vertexId = 0; vertexId < numVertices; ++vertexId, bytes += attributeSize * sizeof(float))
+				std::memcpy(&data[vertexId * vertexSize + offset], bytes, attributeSize * sizeof(float));
+		}
+	}
+}
+
+std::shared_ptr<render::VertexBuffer>
+GeometryParser::createVertexBuffer(DecodedVertexBuffer&						decoded,
+								   std::shared_ptr<render::AbstractContext>	context)
+{
+	VertexBufferPtr	vertexBuffer	= render::VertexBuffer::create(context);
+	uint			numAttributes	= decoded.attributes.size();
 
 	for (unsigned int attributesIndex = 0; attributesIndex < numAttributes; ++attributesIndex)
 		vertexBuffer->addAttribute(
-			deserializedVertex.a1[attributesIndex].a0, 
-			deserializedVertex.a1[attributesIndex].a1,
-			deserializedVertex.a1[attributesIndex].a2);
+			decoded.attributes[attributesIndex].a0, 
+			decoded.attributes[attributesIndex].a1,
+			decoded.attributes[attributesIndex].a2,
+			attributesIndex < decoded.attributeTypes.size()
+				? static_cast<render::VertexAttributeType>(decoded.attributeTypes[attributesIndex])
+				: render::VertexAttributeType::FLOAT);
+
+	// the decoded data is moved into the buffer and uploaded once, with its final layout
+	vertexBuffer->data().swap(decoded.data);
+	vertexBuffer->upload();
 
 	return vertexBuffer;
 }
 
+GeometryParser::IndexBufferPtr
+GeometryParser::createIndexBuffer(std::vector<uint>&						indices,
+								  std::shared_ptr<render::AbstractContext>	context)
+{
+	auto indexBuffer = render::IndexBuffer::create(context);
+
+	indexBuffer->data().swap(indices);
+	indexBuffer->upload();
+
+	return indexBuffer;
+}
+
+std::shared_ptr<render::VertexBuffer>
+GeometryParser::deserializeVertexBuffer(std::string&								serializedVertexBuffer, 
+										std::shared_ptr<render::AbstractContext>	context)
+{
+	DecodedVertexBuffer decoded;
+
+	decodeVertexBuffer(serializedVertexBuffer.data(), serializedVertexBuffer.size(), decoded);
+
+	return createVertexBuffer(decoded, context);
+}
+
 GeometryParser::IndexBufferPtr
 GeometryParser::deserializeIndexBuffer(std::string&								serializedIndexBuffer, 
 									   std::shared_ptr<render::AbstractContext> context)
 {
-	std::vector<unsigned short> vector = deserialize::TypeDeserializer::deserializeVector<unsigned short>(serializedIndexBuffer);
+	std::vector<uint> vector = deserialize::TypeDeserializer::deserializeVector<uint, unsigned short>(serializedIndexBuffer);
 
-	return render::IndexBuffer::create(context, vector);
+	return render::IndexBuffer::create(context, std::move(vector));
+}
+
+GeometryParser::IndexBufferPtr
+GeometryParser::deserializeIndexBufferInt(std::string&								serializedIndexBuffer, 
+										  std::shared_ptr<render::AbstractContext>	context)
+{
+	std::vector<uint> vector = deserialize::TypeDeserializer::deserializeVector<uint>(serializedIndexBuffer);
+
+	return render::IndexBuffer::create(context, std::move(vector));
+}
+
+GeometryParser::IndexBufferPtr
+GeometryParser::deserializeIndexBufferCompressed(std::string&								serializedIndexBuffer, 
+												 std::shared_ptr<render::AbstractContext>	context)
+{
+	std::vector<uint> vector;
+
+	deserialize::TypeDeserializer::deserializeDeltaVector(serializedIndexBuffer.data(), serializedIndexBuffer.size(), vector);
+
+	return render::IndexBuffer::create(context, std::move(vector));
 }
 
 GeometryParser::IndexBufferPtr
 GeometryParser::deserializeIndexBufferChar(std::string&								serializedIndexBuffer, 
 										   std::shared_ptr<render::AbstractContext> context)
 {
-	std::vector<unsigned short> vector = deserialize::TypeDeserializer::deserializeVector<unsigned short, unsigned char>(serializedIndexBuffer);
+	std::vector<uint> vector = deserialize::TypeDeserializer::deserializeVector<uint, unsigned char>(serializedIndexBuffer);
 
-	return render::IndexBuffer::create(context, vector);
+	return render::IndexBuffer::create(context, std::move(vector));
+}
+
+void
+GeometryParser::decode(const std::string&					filename,
+					   std::shared_ptr<Options>				options,
+					   const std::vector<unsigned char>&	data)
+{
+	msgpack::object		msgpackObject;
+	ScopedZone			mempool;
+	msgpack::type::tuple<std::vector<SerializedAsset>, msgpack::type::raw_ref> serializedAssets;
+
+	_decoded = false;
+	if (data.empty())
+		return;
+
+	msgpack::unpack(reinterpret_cast<const char*>(&data[0]), data.size(), NULL, mempool.get(), &msgpackObject);
+	msgpackObject.convert(&serializedAssets);
+
+	// dependencies are added to the asset library, which only parse() can do
+	if (!serializedAssets.a0.empty())
+		return;
+
+	msgpack::object		geometryObject;
+	ScopedZone			geometryMempool;
+	SerializedGeometry	serializedGeometry;
+
+	msgpack::unpack(serializedAssets.a1.ptr, serializedAssets.a1.size, NULL, geometryMempool.get(), &geometryObject);
+	geometryObject.convert(&serializedGeometry);
+
+	decodeIndices(serializedGeometry.a0, serializedGeometry.a2.ptr, serializedGeometry.a2.size, _decodedIndices);
+
+	_decodedName = serializedGeometry.a1;
+	_decodedVertexBuffers.resize(serializedGeometry.a3.size());
+	for (uint i = 0; i < serializedGeometry.a3.size(); ++i)
+		decodeVertexBuffer(serializedGeometry.a3[i].ptr, serializedGeometry.a3[i].size, _decodedVertexBuffers[i]);
+
+	_decoded = true;
 }
 
 void
@@ -89,24 +323,72 @@ GeometryParser::parse(const std::string&				filename,
 					  const std::vector<unsigned char>&	data,
 					  std::shared_ptr<AssetLibrary>		assetLibrary)
 {
+	if (_decoded)
+	{
+		auto geom = geometry::Geometry::create();
+
+		geom->indices(createIndexBuffer(_decodedIndices, options->context()));
+		for (auto& decodedVertexBuffer : _decodedVertexBuffers)
+			geom->addVertexBuffer(createVertexBuffer(decodedVertexBuffer, options->context()));
+
+		geom = options->geometryFunction()(_decodedName, geom);
+		if (options->disposeGeometryData())
+			geom->disposeData();
+
+		assetLibrary->geometry(_decodedName, geom);
+		_lastParsedAssetName = _decodedName;
+
+		_decoded = false;
+		std::vector<uint>().swap(_decodedIndices);
+		std::vector<DecodedVertexBuffer>().swap(_decodedVertexBuffers);
+
+		return;
+	}
+
 	msgpack::object			msgpackObject;
-	msgpack::zone			mempool;
+	ScopedZone				mempool;
 	std::string				folderPathName = extractFolderPath(resolvedFilename);
-	std::string				str		= extractDependencies(assetLibrary, data, options, folderPathName);
+	msgpack::type::raw_ref	content		= extractDependencies(assetLibrary, data, options, folderPathName);
 	geometry::Geometry::Ptr geom	= geometry::Geometry::create();
 	SerializedGeometry		serializedGeometry;
 
-	msgpack::unpack(str.data(), str.size(), NULL, &mempool, &msgpackObject);
+	msgpack::unpack(content.ptr, content.size, NULL, mempool.get(), &msgpackObject);
 	msgpackObject.convert(&serializedGeometry);
 
-	computeMetaByte(serializedGeometry.a0);
+	if (_customBufferParsers)
+	{
+		// the registered functions take their streams as strings
+		std::string serializedIndexBuffer(serializedGeometry.a2.ptr, serializedGeometry.a2.size);
+
+		computeMetaByte(serializedGeometry.a0);
+		geom->indices(indexBufferParserFunction(serializedIndexBuffer, options->context()));
+
+		for (auto& stream : serializedGeometry.a3)
+		{
+			std::string serializedVertexBuffer(stream.ptr, stream.size);
+
+			geom->addVertexBuffer(vertexBufferParserFunction(serializedVertexBuffer, options->context()));
+		}
+	}
+	else
+	{
+		std::vector<uint>	indices;
+		DecodedVertexBuffer	decoded;
+
+		decodeIndices(serializedGeometry.a0, serializedGeometry.a2.ptr, serializedGeometry.a2.size, indices);
+		geom->indices(createIndexBuffer(indices, options->context()));
+
+		for (auto& stream : serializedGeometry.a3)
+		{
+			decodeVertexBuffer(stream.ptr, stream.size, decoded);
+			geom->addVertexBuffer(createVertexBuffer(decoded, options->context()));
+		}
+	}
+
 
-	geom->indices(indexBufferParserFunction(serializedGeometry.a2, options->context()));
-	
-	for (std::string serializedVertexBuffer : serializedGeometry.a3)
-		geom->addVertexBuffer(vertexBufferParserFunction(serializedVertexBuffer, options->context()));
-		
 	geom = options->geometryFunction()(serializedGeometry.a1, geom);
+	if (options->disposeGeometryData())
+		geom->disposeData();
 
 	assetLibrary->geometry(serializedGeometry.a1, geom);
 	_lastParsedAssetName = serializedGeometry.a1;
@@ -115,8 +397,12 @@ GeometryParser::parse(const std::string&				filename,
 void
 GeometryParser::computeMetaByte(unsigned char byte)
 {
-	if (byte & (1u << 7))
+	if (byte & (1u << 5))
+		indexBufferParserFunction = std::bind(&GeometryParser::deserializeIndexBufferCompressed, std::placeholders::_1, std::placeholders::_2);
+	else if (byte & (1u << 7))
 		indexBufferParserFunction = std::bind(&GeometryParser::deserializeIndexBufferChar, std::placeholders::_1, std::placeholders::_2);
+	else if (byte & (1u << 6))
+		indexBufferParserFunction = std::bind(&GeometryParser::deserializeIndexBufferInt, std::placeholders::_1, std::placeholders::_2);
 	else
 		indexBufferParserFunction = std::bind(&GeometryParser::deserializeIndexBuffer, std::placeholders::_1, std::placeholders::_2);
 
@@ -20,6 +20,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/file/GeometryWriter.hpp"
 #include "minko/serialize/TypeSerializer.hpp"
 #include "minko/render/IndexBuffer.hpp"
+#include "minko/render/VertexBuffer.hpp"
+#include "minko/Types.hpp"
 
 using namespace minko;
 using namespace minko::file;
@@ -30,20 +32,194 @@ std::function<std::string(std::shared_ptr<render::VertexBuffer>)>	GeometryWriter
 void
 GeometryWriter::initialize()
 {
-	indexBufferWriterFunction	= std::bind(&GeometryWriter::serializeIndexStream, std::placeholders::_1);
-	vertexBufferWriterFunction	= std::bind(&GeometryWriter::serializeVertexStream, std::placeholders::_1);
+	// keeps the functions registered before the creation of the writer
+	if (!indexBufferWriterFunction)
+		indexBufferWriterFunction	= std::bind(&GeometryWriter::serializeIndexStream, std::placeholders::_1);
+	if (!vertexBufferWriterFunction)
+		vertexBufferWriterFunction	= std::bind(&GeometryWriter::serializeVertexStream, std::placeholders::_1);
+}
+
+/*static*/
+std::vector<std::pair<std::string, uint>>
+GeometryWriter::streamSizes(std::shared_ptr<geometry::Geometry> geometry, bool compress)
+{
+	std::vector<std::pair<std::string, uint>> sizes;
+
+	// the writer functions are only registered once a writer was created
+	const auto indexStream = compress
+		? serializeIndexStreamCompressed(geometry->indices())
+		: (indexBufferWriterFunction ? indexBufferWriterFunction : serializeIndexStream)(geometry->indices());
+
+	sizes.push_back(std::make_pair(std::string("indices"), (uint)indexStream.size()));
+
+	for (auto& vertexBuffer : geometry->vertexBuffers())
+	{
+		std::string name;
+
+		for (auto& attribute : vertexBuffer->attributes())
+			name += (name.empty() ? "" : "+") + std::get<0>(*attribute);
+
+		const auto vertexStream = compress
+			? serializeVertexStreamCompressed(vertexBuffer)
+			: (vertexBufferWriterFunction ? vertexBufferWriterFunction : serializeVertexStream)(vertexBuffer);
+
+		sizes.push_back(std::make_pair(name, (uint)vertexStream.size()));
+	}
+
+	return sizes;
 }
 
 std::string
 GeometryWriter::serializeIndexStream(std::shared_ptr<render::IndexBuffer> indexBuffer)
 {
-	return serialize::TypeSerializer::serializeVector<unsigned short>(indexBuffer->data());
+	return serialize::TypeSerializer::serializeVector<uint, unsigned short>(indexBuffer->data());
+}
+
+std::string
+GeometryWriter::serializeIndexStreamInt(std::shared_ptr<render::IndexBuffer> indexBuffer)
+{
+	return serialize::TypeSerializer::serializeVector<uint>(indexBuffer->data());
 }
 
 std::string
 GeometryWriter::serializeIndexStreamChar(std::shared_ptr<render::IndexBuffer> indexBuffer)
 {
-	return serialize::TypeSerializer::serializeVector<unsigned short, unsigned char>(indexBuffer->data());
+	return serialize::TypeSerializer::serializeVector<uint, unsigned char>(indexBuffer->data());
+}
+
+std::string
+GeometryWriter::serializeIndexStreamCompressed(std::shared_ptr<render::IndexBuffer> indexBuffer)
+{
+	return serialize::TypeSerializer::serializeDeltaVector(indexBuffer->data());
+}
+
+static
+void
+writeDelta16(std::string& stream, unsigned short& previous, unsigned short value)
+{
+	const unsigned short delta = static_cast<unsigned short>(value - previous);
+
+	stream.push_back(static_cast<char>(delta & 0xff));
+	stream.push_back(static_cast<char>(delta >> 8));
+	previous = value;
+}
+
+static
+serialize::StreamEncoding
+attributeEncoding(const std::string& name, uint size)
+{
+	if (name == "position" || name.compare(0, 2, "uv") == 0)
+		return serialize::StreamEncoding::QUANTIZED_16;
+	if ((name == "normal" || name == "tangent") && size == 3)
+		return serialize::StreamEncoding::OCTAHEDRAL_16;
+
+	return serialize::StreamEncoding::RAW_FLOAT;
+}
+
+std::string
+GeometryWriter::serializeVertexStreamCompressed(std::shared_ptr<render::VertexBuffer> vertexBuffer)
+{
+	std::list<render::VertexBuffer::AttributePtr>									attributes			= vertexBuffer->attributes();
+	std::vector<msgpack::type::tuple<std::string, unsigned char, unsigned char>>	serializedAttributes;
+	std::vector<unsigned char>														attributeTypes;
+	std::vector<unsigned char>														encodings;
+	std::vector<float>																bounds;
+	std::string																		stream;
+	const std::vector<float>&														data				= vertexBuffer->data();
+	const uint																		vertexSize			= vertexBuffer->vertexSize();
+	const uint																		numVertices			= vertexBuffer->numVertices();
+
+	for (auto& attribute : attributes)
+	{
+		const auto& name	= std::get<0>(*attribute);
+		const uint	size	= std::get<1>(*attribute);
+		const uint	offset	= std::get<2>(*attribute);
+		const auto	encoding = attributeEncoding(name, size);
+
+		serializedAttributes.push_back(msgpack::type::tuple<std::string, unsigned char, unsigned char>(name, size, offset));
+		attributeTypes.push_back(static_cast<unsigned char>(vertexBuffer->attributeType(name)));
+		encodings.push_back(static_cast<unsigned char>(encoding));
+
+		if (encoding == serialize::StreamEncoding::QUANTIZED_16)
+		{
+			for (uint i = 0; i < size; ++i)
+			{
+				float min = std::numeric_limits<float>::max();
+				float max = -std::numeric_limits<float>::max();
+
+				for (uint vertexId = 0; vertexId < numVertices; ++vertexId)
+				{
+					min = std::min(min, data[vertexId * vertexSize + offset + i]);
+					max = std::max(max, data[vertexId * vertexSize + offset + i]);
+				}
+
+				if (numVertices == 0)
+					min = max = 0.f;
+
+				const float			scale		= max > min ? 65535.f / (max - min) : 0.f;
+				unsigned short		previous	= 0;
+
+				bounds.push_back(min);
+				bounds.push_back(max);
+
+				for (uint vertexId = 0; vertexId < numVertices; ++vertexId)
+				{
+					const float value = (data[vertexId * vertexSize + offset + i] - min) * scale + .5f;
+
+					writeDelta16(stream, previous, static_cast<unsigned short>(std::min(value, 65535.f)));
+				}
+			}
+		}
+		else if (encoding == serialize::StreamEncoding::OCTAHEDRAL_16)
+		{
+			unsigned short previousX = 0;
+			unsigned short previousY = 0;
+
+			for (uint vertexId = 0; vertexId < numVertices; ++vertexId)
+			{
+				const float*	n		= &data[vertexId * vertexSize + offset];
+				const float		length	= fabsf(n[0]) + fabsf(n[1]) + fabsf(n[2]);
+				float			x		= length > 0.f ? n[0] / length : 0.f;
+				float			y		= length > 0.f ? n[1] / length : 0.f;
+
+				// the lower hemisphere is folded over the diagonals
+				if (length > 0.f && n[2] < 0.f)
+				{
+					const float foldedX = (1.f - fabsf(y)) * (x >= 0.f ? 1.f : -1.f);
+					const float foldedY = (1.f - fabsf(x)) * (y >= 0.f ? 1.f : -1.f);
+
+					x = foldedX;
+					y = foldedY;
+				}
+
+				writeDelta16(stream, previousX, static_cast<unsigned short>(static_cast<short>(roundf(x * 32767.f))));
+				writeDelta16(stream, previousY, static_cast<unsigned short>(static_cast<short>(roundf(y * 32767.f))));
+			}
+		}
+		else
+		{
+			for (uint vertexId = 0; vertexId < numVertices; ++vertexId)
+				stream.append(reinterpret_cast<const char*>(&data[vertexId * vertexSize + offset]), size * sizeof(float));
+		}
+	}
+
+	std::stringstream			sbuf;
+	msgpack::type::tuple<
+		std::string,
+		std::vector<msgpack::type::tuple<std::string, unsigned char, unsigned char>>,
+		std::vector<unsigned char>,
+		std::vector<unsigned char>,
+		std::vector<float>
+	> res(
+		stream,
+		serializedAttributes,
+		attributeTypes,
+		encodings,
+		bounds);
+
+	msgpack::pack(sbuf, res);
+
+	return sbuf.str();
 }
 
 std::string
@@ -51,6 +227,7 @@ GeometryWriter::serializeVertexStream(std::shared_ptr<render::VertexBuffer> vert
 {
 	std::list<render::VertexBuffer::AttributePtr>									attributes			= vertexBuffer->attributes();
 	std::vector<msgpack::type::tuple<std::string, unsigned char, unsigned char>>	serializedAttributes;
+	std::vector<unsigned char>														attributeTypes;
 	
 	auto attributesIt = attributes.begin();
 	
@@ -60,6 +237,7 @@ GeometryWriter::serializeVertexStream(std::shared_ptr<render::VertexBuffer> vert
 			std::get<0>((**attributesIt)), 
 			std::get<1>((**attributesIt)), 
 			std::get<2>((**attributesIt))));
+		attributeTypes.push_back(static_cast<unsigned char>(vertexBuffer->attributeType(std::get<0>(**attributesIt))));
 
 		attributesIt++;
 	}
@@ -67,9 +245,14 @@ GeometryWriter::serializeVertexStream(std::shared_ptr<render::VertexBuffer> vert
 	std::string serializedVector = serialize::TypeSerializer::serializeVector<float>(vertexBuffer->data());
 
 	std::stringstream			sbuf;
-	msgpack::type::tuple<std::string, std::vector<msgpack::type::tuple<std::string, unsigned char, unsigned char>>> res(
+	msgpack::type::tuple<
+		std::string,
+		std::vector<msgpack::type::tuple<std::string, unsigned char, unsigned char>>,
+		std::vector<unsigned char>
+	> res(
 		serializedVector,
-		serializedAttributes);
+		serializedAttributes,
+		attributeTypes);
 
 	msgpack::pack(sbuf, res);
 
@@ -77,19 +260,26 @@ GeometryWriter::serializeVertexStream(std::shared_ptr<render::VertexBuffer> vert
 }
 
 unsigned char
-GeometryWriter::computeMetaByte(std::shared_ptr<geometry::Geometry> geometry)
+GeometryWriter::computeMetaByte(std::shared_ptr<geometry::Geometry>								geometry,
+								std::function<std::string(std::shared_ptr<render::IndexBuffer>)>&	indexWriter)
 {
-	std::vector<unsigned short>::iterator maxIndice = std::max_element(geometry->indices()->data().begin(), geometry->indices()->data().end());
+	std::vector<uint>::iterator maxIndice = std::max_element(geometry->indices()->data().begin(), geometry->indices()->data().end());
 
 	unsigned char metaByte = 0x00;
-	
+
+	// chosen per geometry rather than stored in the static function, geometries are written concurrently
 	if (*maxIndice <= 255)
 	{
 		metaByte += 1u << 7;
-		indexBufferWriterFunction	= std::bind(&GeometryWriter::serializeIndexStreamChar, std::placeholders::_1);
+		indexWriter	= std::bind(&GeometryWriter::serializeIndexStreamChar, std::placeholders::_1);
+	}
+	else if (*maxIndice > 0xffff)
+	{
+		metaByte += 1u << 6;
+		indexWriter	= std::bind(&GeometryWriter::serializeIndexStreamInt, std::placeholders::_1);
 	}
 	else
-		indexBufferWriterFunction	= std::bind(&GeometryWriter::serializeIndexStream, std::placeholders::_1);
+		indexWriter	= std::bind(&GeometryWriter::serializeIndexStream, std::placeholders::_1);
 
 	return metaByte;
-}
\ No newline at end of file
+}
@@ -62,27 +62,31 @@ MaterialParser::parse(const std::string&				filename,
 					  AssetLibraryPtr					assetLibrary)
 {
 	msgpack::object		msgpackObject;
-	msgpack::zone		mempool;
+	ScopedZone			mempool;
 	std::string 		folderpath = extractFolderPath(resolvedFilename);
-	std::string			str = extractDependencies(assetLibrary, data, options, folderpath);
+	msgpack::type::raw_ref	content = extractDependencies(assetLibrary, data, options, folderpath);
 
 	msgpack::type::tuple<std::vector<ComplexProperty>, std::vector<BasicProperty>> serializedMaterial;
-	msgpack::unpack(str.data(), str.size(), NULL, &mempool, &msgpackObject);
+	msgpack::unpack(content.ptr, content.size, NULL, mempool.get(), &msgpackObject);
 	msgpackObject.convert(&serializedMaterial);
 
-	std::vector<ComplexProperty> complexProperties	= serializedMaterial.a0;
-	std::vector<BasicProperty>	 basicProperties	= serializedMaterial.a1;
+	std::vector<ComplexProperty>&	complexProperties	= serializedMaterial.a0;
+	std::vector<BasicProperty>&		basicProperties		= serializedMaterial.a1;
 
 	MaterialPtr material = material::Material::create();
 
-	for (auto serializedComplexProperty : complexProperties)
+	for (auto& serializedComplexProperty : complexProperties)
 		deserializeComplexProperty(material, serializedComplexProperty);
 
-	for (auto serializedBasicProperty : basicProperties)
+	for (auto& serializedBasicProperty : basicProperties)
 		deserializeBasicProperty(material, serializedBasicProperty);
 
 	material = options->materialFunction()(material->arrayName(), material);
 
+	// identical materials of different files are parsed as the same reference
+	if (options->shareMaterials())
+		material = std::static_pointer_cast<material::Material>(assetLibrary->internMaterial(material));
+
 	assetLibrary->material(filename, material);
 	_lastParsedAssetName = filename;
 }
@@ -118,11 +118,11 @@ SceneParser::parse(const std::string&					filename,
 	_dependencies->options(options);
 
 	msgpack::object		deserialized;
-	msgpack::zone		mempool;
+	ScopedZone			mempool;
 	std::string 		folderPath = extractFolderPath(resolvedFilename);
-	std::string			str = extractDependencies(assetLibrary, data, options, folderPath);
+	msgpack::type::raw_ref	content = extractDependencies(assetLibrary, data, options, folderPath);
 
-	msgpack::unpack(str.data(), str.size(), NULL, &mempool, &deserialized);
+	msgpack::unpack(content.ptr, content.size, NULL, mempool.get(), &deserialized);
 	msgpack::type::tuple<std::vector<std::string>, std::vector<SerializedNode>> dst;
 	deserialized.convert(&dst);
 
@@ -0,0 +1,195 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/file/SceneTableOfContents.hpp"
+
+#include "minko/math/Box.hpp"
+#include "minko/math/Vector3.hpp"
+#include "msgpack.hpp"
+
+using namespace minko;
+using namespace minko::file;
+using namespace minko::math;
+
+const uint SceneTableOfContents::VERSION = 1;
+
+typedef msgpack::type::tuple<std::string, std::vector<float>>		SerializedCell;
+typedef msgpack::type::tuple<uint, std::vector<SerializedCell>>		SerializedTableOfContents;
+
+SceneTableOfContents::SceneTableOfContents() :
+	_cells(),
+	_gridSize(0.f),
+	_grid(),
+	_cellQueries(),
+	_queryId(0)
+{
+}
+
+SceneTableOfContents::Ptr
+SceneTableOfContents::create(const std::vector<unsigned char>& data)
+{
+	if (data.empty())
+		throw std::invalid_argument("data");
+
+	msgpack::object				deserialized;
+	msgpack::zone				mempool;
+	SerializedTableOfContents	dst;
+
+	msgpack::unpack(reinterpret_cast<const char*>(&data[0]), data.size(), NULL, &mempool, &deserialized);
+	deserialized.convert(&dst);
+
+	if (dst.a0 != VERSION)
+		throw std::logic_error("unsupported scene table of contents version: " + std::to_string(dst.a0));
+
+	auto tableOfContents = create();
+
+	for (auto& cell : dst.a1)
+	{
+		auto& bounds = cell.a1;
+
+		if (bounds.size() != 6)
+			throw std::logic_error("invalid bounds for the scene cell " + cell.a0);
+
+		tableOfContents->addCell(cell.a0, Box::create(
+			Vector3::create(bounds[3], bounds[4], bounds[5]),
+			Vector3::create(bounds[0], bounds[1], bounds[2])
+		));
+	}
+
+	return tableOfContents;
+}
+
+uint
+SceneTableOfContents::addCell(const std::string& filename, BoxPtr box)
+{
+	if (filename.empty())
+		throw std::invalid_argument("filename");
+	if (!box)
+		throw std::invalid_argument("box");
+
+	Cell cell = { filename, box };
+
+	_cells.push_back(cell);
+	_cellQueries.push_back(0);
+	_grid.clear();
+
+	return _cells.size() - 1;
+}
+
+void
+SceneTableOfContents::buildGrid()
+{
+	// the squares are as large as the largest cell: cells overlap a few squares, queries visit a few squares
+	_gridSize = 0.f;
+	for (auto& cell : _cells)
+		_gridSize = std::max(_gridSize, std::max(
+			cell.box->topRight()->x() - cell.box->bottomLeft()->x(),
+			cell.box->topRight()->z() - cell.box->bottomLeft()->z()
+		));
+	if (_gridSize <= 0.f)
+		_gridSize = 1.f;
+
+	for (uint i = 0; i < _cells.size(); ++i)
+	{
+		auto& box = _cells[i].box;
+
+		const int minX = (int)floorf(box->bottomLeft()->x() / _gridSize);
+		const int maxX = (int)floorf(box->topRight()->x() / _gridSize);
+		const int minZ = (int)floorf(box->bottomLeft()->z() / _gridSize);
+		const int maxZ = (int)floorf(box->topRight()->z() / _gridSize);
+
+		for (int x = minX; x <= maxX; ++x)
+			for (int z = minZ; z <= maxZ; ++z)
+				_grid[gridKey(x, z)].push_back(i);
+	}
+}
+
+void
+SceneTableOfContents::cellsWithin(Vector3::Ptr position, float distance, std::vector<uint>& cells)
+{
+	cells.clear();
+
+	if (_cells.empty())
+		return;
+	if (_grid.empty())
+		buildGrid();
+
+	// a cell overlapping several squares is only tested once per query
+	++_queryId;
+
+	const int minX = (int)floorf((position->x() - distance) / _gridSize);
+	const int maxX = (int)floorf((position->x() + distance) / _gridSize);
+	const int minZ = (int)floorf((position->z() - distance) / _gridSize);
+	const int maxZ = (int)floorf((position->z() + distance) / _gridSize);
+
+	for (int x = minX; x <= maxX; ++x)
+		for (int z = minZ; z <= maxZ; ++z)
+		{
+			auto squareIt = _grid.find(gridKey(x, z));
+
+			if (squareIt == _grid.end())
+				continue;
+
+			for (auto cell : squareIt->second)
+			{
+				if (_cellQueries[cell] == _queryId)
+					continue;
+
+				_cellQueries[cell] = _queryId;
+				if (this->distance(_cells[cell].box, position) <= distance)
+					cells.push_back(cell);
+			}
+		}
+
+	std::sort(cells.begin(), cells.end());
+}
+
+float
+SceneTableOfContents::distance(BoxPtr box, Vector3::Ptr position)
+{
+	const float dx = std::max(0.f, std::max(box->bottomLeft()->x() - position->x(), position->x() - box->topRight()->x()));
+	const float dy = std::max(0.f, std::max(box->bottomLeft()->y() - position->y(), position->y() - box->topRight()->y()));
+	const float dz = std::max(0.f, std::max(box->bottomLeft()->z() - position->z(), position->z() - box->topRight()->z()));
+
+	return sqrtf(dx * dx + dy * dy + dz * dz);
+}
+
+std::string
+SceneTableOfContents::serialize() const
+{
+	std::vector<SerializedCell> cells;
+
+	for (auto& cell : _cells)
+	{
+		auto bottomLeft	= cell.box->bottomLeft();
+		auto topRight	= cell.box->topRight();
+
+		cells.push_back(SerializedCell(cell.filename, {
+			bottomLeft->x(), bottomLeft->y(), bottomLeft->z(),
+			topRight->x(), topRight->y(), topRight->z()
+		}));
+	}
+
+	std::stringstream			sbuf;
+	SerializedTableOfContents	res(VERSION, cells);
+
+	msgpack::pack(sbuf, res);
+
+	return sbuf.str();
+}
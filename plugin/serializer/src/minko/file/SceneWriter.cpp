@@ -122,28 +122,38 @@ SceneWriter::embed(AssetLibraryPtr		assetLibrary,
 				  DependencyPtr			dependency)
 {
 	std::stringstream								sbuf;
+	std::stringstream								nodeBuffer;
+	msgpack::packer<std::stringstream>				nodePacker(nodeBuffer);
+	uint											numNodes = 0;
 	std::queue<std::shared_ptr<scene::Node>>		queue;
-	std::vector<SerializedNode>						nodePack;
 	std::vector<std::string>						serializedControllerList;
 	std::map<AbsComponentPtr, int>					controllerMap;
 
 	queue.push(data());
 
+	// the nodes are packed as they are visited instead of being gathered first
 	while (queue.size() > 0)
 	{
 		std::shared_ptr<scene::Node>	currentNode = queue.front();
 
-		nodePack.push_back(writeNode(currentNode, serializedControllerList, controllerMap, assetLibrary, dependency));
-		
+		nodePacker.pack(writeNode(currentNode, serializedControllerList, controllerMap, assetLibrary, dependency));
+		++numNodes;
+
 		for (uint i = 0; i < currentNode->children().size(); ++i)
 			queue.push(currentNode->children()[i]);
 
 		queue.pop();
 	}
 
-	msgpack::type::tuple<std::vector<std::string>, std::vector<SerializedNode>> res(serializedControllerList, nodePack);
-	msgpack::pack(sbuf, res);
-	
+	// the controllers come first: the layout of a tuple of the controllers and the nodes
+	msgpack::packer<std::stringstream> packer(sbuf);
+
+	packer.pack_array(2);
+	packer.pack(serializedControllerList);
+	packer.pack_array(numNodes);
+	if (numNodes > 0)
+		sbuf << nodeBuffer.rdbuf();
+
 	return sbuf.str();
 }
 
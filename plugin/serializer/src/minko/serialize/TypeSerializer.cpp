@@ -30,6 +30,32 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 using namespace minko;
 using namespace minko::serialize;
 
+std::string
+TypeSerializer::serializeDeltaVector(const std::vector<uint>& vect)
+{
+	std::string	result;
+	uint		previous = 0;
+
+	result.reserve(vect.size() * 2);
+
+	for (auto value : vect)
+	{
+		const int	delta	= static_cast<int>(value - previous);
+		uint		zigzag	= (static_cast<uint>(delta) << 1) ^ static_cast<uint>(delta >> 31);
+
+		while (zigzag >= 0x80)
+		{
+			result.push_back(static_cast<char>((zigzag & 0x7f) | 0x80));
+			zigzag >>= 7;
+		}
+		result.push_back(static_cast<char>(zigzag));
+
+		previous = value;
+	}
+
+	return result;
+}
+
 std::tuple<uint, std::string>
 TypeSerializer::serializeVector4(Any value)
 {
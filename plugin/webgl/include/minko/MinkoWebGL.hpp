@@ -20,3 +20,4 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #pragma once
 
 #include "minko/render/WebGLContext.hpp"
+#include "minko/render/WebGL2Context.hpp"
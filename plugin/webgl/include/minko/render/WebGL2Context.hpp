@@ -0,0 +1,176 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include "minko/render/WebGLContext.hpp"
+
+namespace minko
+{
+	namespace render
+	{
+		// WebGL 2.0/OpenGL ES 3.0 context: the shaders are compiled as GLSL ES 3.00, instancing and 32 bits
+		// indices are core, the vertex attributes of each draw call are bound with a single vertex array
+		// object and the uncompressed textures get an immutable storage
+		class WebGL2Context :
+			public WebGLContext
+		{
+		public:
+			typedef std::shared_ptr<WebGL2Context> Ptr;
+
+		private:
+			typedef std::vector<int> VertexArrayKey;
+
+		private:
+			// the index buffer then the buffer, size, stride, offset, type and divisor of each enabled attribute
+			std::map<VertexArrayKey, uint>	_vertexArrays;
+			VertexArrayKey					_vertexArrayKey;
+			bool							_vertexArrayChanged;
+			uint							_drawVertexArray;
+			bool							_immutableTextureStorage;
+			std::set<uint>					_immutableTextures;
+			// sampler objects, created once per sampler state and shared by all the textures
+			std::map<SamplerState, uint>	_samplers;
+			std::vector<uint>				_currentSamplerObject;
+
+		public:
+			static
+			Ptr
+			create()
+			{
+				return std::shared_ptr<WebGL2Context>(new WebGL2Context());
+			}
+
+			~WebGL2Context();
+
+			inline
+			uint
+			numVertexArrays() const
+			{
+				return _vertexArrays.size();
+			}
+
+			inline
+			uint
+			numSamplers() const
+			{
+				return _samplers.size();
+			}
+
+			inline
+			bool
+			immutableTextureStorage() const
+			{
+				return _immutableTextureStorage;
+			}
+
+			// the storage of a texture is allocated once for all its levels on its first upload, its
+			// storage cannot be released afterwards
+			inline
+			void
+			immutableTextureStorage(bool value)
+			{
+				_immutableTextureStorage = value;
+			}
+
+			void
+			setVertexBufferAt(const uint			position,
+							  const uint			vertexBuffer,
+							  const uint			size,
+							  const uint			stride,
+							  const uint			offset,
+							  VertexAttributeType	type = VertexAttributeType::FLOAT);
+
+			void
+			setVertexAttributeDivisor(const uint position, const uint divisor);
+
+			// the vertex arrays are already keyed on the attributes of each draw
+			inline
+			bool
+			supportsVertexArrays()
+			{
+				return false;
+			}
+
+			void
+			drawTriangles(const uint indexBuffer, const int numTriangles);
+
+			void
+			drawTrianglesInstanced(const uint indexBuffer, const int numTriangles, const uint numInstances);
+
+			const uint
+			createIndexBuffer(const uint size, const bool useUnsignedInt = false, BufferUsage usage = BufferUsage::STATIC);
+
+			void
+			uploaderIndexBufferData(const uint indexBuffer, const uint offset, const uint size, void* data);
+
+			void
+			deleteVertexBuffer(const uint vertexBuffer);
+
+			void
+			deleteIndexBuffer(const uint indexBuffer);
+
+			void
+			uploadTexture2dData(uint texture, unsigned int width, unsigned int height, unsigned int mipLevel, void* data);
+
+			void
+			uploadCubeTextureData(uint				texture,
+								  CubeTexture::Face	face,
+								  unsigned int		width,
+								  unsigned int		height,
+								  unsigned int		mipLevel,
+								  void*				data);
+
+			void
+			releaseTextureStorage(uint texture);
+
+			void
+			deleteTexture(uint texture);
+
+			void
+			setSamplerStateAt(uint position, WrapMode wrapping, TextureFilter filtering, MipFilter mipFiltering);
+
+			void
+			contextRestored();
+
+		protected:
+			WebGL2Context();
+
+			void
+			setShaderSource(const unsigned int shader,
+							const std::string& source);
+
+		private:
+			void
+			bindVertexArray(uint indexBuffer);
+
+			void
+			unbindVertexArray();
+
+			void
+			deleteVertexArrays(uint buffer);
+
+			bool
+			allocateImmutableStorage(uint texture);
+		};
+	}
+}
@@ -0,0 +1,141 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+	namespace render
+	{
+		// GL calls encoded in a flat array of 32 bits words (the command then its arguments) and replayed
+		// by a single JavaScript loop, instead of crossing the boundary with JavaScript for each of them
+		class WebGLCommandBuffer
+		{
+		public:
+			typedef std::shared_ptr<WebGLCommandBuffer> Ptr;
+
+			enum class Command
+			{
+				ENABLE,					// cap
+				DISABLE,				// cap
+				CULL_FACE,				// mode
+				BLEND_FUNC,				// source, destination
+				DEPTH_MASK,				// flag
+				DEPTH_FUNC,				// func
+				COLOR_MASK,				// flag
+				USE_PROGRAM,			// program
+				UNIFORM_1I,				// location, x
+				UNIFORM_2I,				// location, x, y
+				UNIFORM_3I,				// location, x, y, z
+				UNIFORM_4I,				// location, x, y, z, w
+				UNIFORM_1F,				// location, x
+				UNIFORM_2F,				// location, x, y
+				UNIFORM_3F,				// location, x, y, z
+				UNIFORM_4F,				// location, x, y, z, w
+				UNIFORM_MATRIX_4F,		// location, 16 floats in column-major order
+				BIND_TEXTURE,			// unit, target, texture
+				ENABLE_ATTRIBUTE,		// index
+				DISABLE_ATTRIBUTE,		// index
+				ATTRIBUTE_POINTER,		// index, buffer, size, type, normalized, stride, offset
+				BIND_ELEMENT_BUFFER,	// buffer
+				DRAW_ELEMENTS			// count, type
+			};
+
+		private:
+			std::vector<int>	_words;
+			uint				_numCommands;
+
+		public:
+			inline static
+			Ptr
+			create()
+			{
+				return std::shared_ptr<WebGLCommandBuffer>(new WebGLCommandBuffer());
+			}
+
+			inline
+			uint
+			numCommands() const
+			{
+				return _numCommands;
+			}
+
+			inline
+			const std::vector<int>&
+			words() const
+			{
+				return _words;
+			}
+
+			inline
+			WebGLCommandBuffer&
+			command(Command command)
+			{
+				++_numCommands;
+				_words.push_back(static_cast<int>(command));
+
+				return *this;
+			}
+
+			inline
+			WebGLCommandBuffer&
+			operator<<(int value)
+			{
+				_words.push_back(value);
+
+				return *this;
+			}
+
+			// floats are stored bit for bit and read back with a Float32Array view of the same memory
+			inline
+			WebGLCommandBuffer&
+			operator<<(float value)
+			{
+				int word;
+
+				std::memcpy(&word, &value, sizeof(float));
+				_words.push_back(word);
+
+				return *this;
+			}
+
+			// replays the commands in order and empties the buffer
+			void
+			flush();
+
+			// drops the pending commands without replaying them
+			inline
+			void
+			clear()
+			{
+				_words.clear();
+				_numCommands = 0;
+			}
+
+		private:
+			WebGLCommandBuffer() :
+				_numCommands(0)
+			{
+			}
+		};
+	}
+}
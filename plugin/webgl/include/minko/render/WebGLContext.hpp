@@ -22,6 +22,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/Common.hpp"
 
 #include "minko/render/OpenGLES2Context.hpp"
+#include "minko/render/WebGLCommandBuffer.hpp"
 
 namespace minko
 {
@@ -33,6 +34,10 @@ namespace minko
 		public:
 			typedef std::shared_ptr<WebGLContext> Ptr;
 
+		private:
+			// null unless the command buffer mode is enabled
+			WebGLCommandBuffer::Ptr	_commandBuffer;
+
 		public:
 			static
 			Ptr
@@ -41,6 +46,298 @@ namespace minko
 				return std::shared_ptr<WebGLContext>(new WebGLContext());
 			}
 
+			inline
+			bool
+			commandBufferEnabled() const
+			{
+				return _commandBuffer != nullptr;
+			}
+
+			// the calls issued for each draw call (program, uniforms, textures, vertex attributes, states
+			// and draws) are encoded once the redundant ones are skipped, and replayed by a single JavaScript
+			// loop: any other call replays the pending commands first to keep the GL calls in order
+			void
+			commandBufferEnabled(bool enabled);
+
+			// replays the pending commands, if any
+			inline
+			void
+			flush()
+			{
+				if (_commandBuffer)
+					_commandBuffer->flush();
+			}
+
+			// encoded calls
+
+			void
+			setProgram(const uint program);
+
+			void
+			setUniform(uint location, int value);
+
+			void
+			setUniform(uint location, int v1, int v2);
+
+			void
+			setUniform(uint location, int v1, int v2, int v3);
+
+			void
+			setUniform(uint location, int v1, int v2, int v3, int v4);
+
+			void
+			setUniform(uint location, float value);
+
+			void
+			setUniform(uint location, float v1, float v2);
+
+			void
+			setUniform(uint location, float v1, float v2, float v3);
+
+			void
+			setUniform(uint location, float v1, float v2, float v3, float v4);
+
+			void
+			setUniform(const unsigned int&	location,
+					   const unsigned int&	size,
+					   bool					transpose,
+					   const float*			values);
+
+			void
+			setTextureAt(uint position, int texture = 0, int location = -1);
+
+			void
+			setVertexBufferAt(const uint			position,
+							  const uint			vertexBuffer,
+							  const uint			size,
+							  const uint			stride,
+							  const uint			offset,
+							  VertexAttributeType	type = VertexAttributeType::FLOAT);
+
+			void
+			drawTriangles(const uint indexBuffer, const int numTriangles);
+
+			void
+			setBlendMode(Blending::Source source, Blending::Destination destination);
+
+			void
+			setBlendMode(Blending::Mode blendMode);
+
+			void
+			setDepthTest(bool depthMask, CompareMode depthFunc);
+
+			void
+			setColorMask(bool colorMask);
+
+			void
+			setTriangleCulling(TriangleCulling triangleCulling);
+
+			// calls replaying the pending commands first
+
+			void
+			configureViewport(const uint x, const uint y, const uint width, const uint height);
+
+			void
+			clear(float red = 0.f, float green = 0.f, float blue = 0.f, float alpha = 0.f, float depth = 1.f, unsigned int stencil = 0, unsigned int mask = 0xffffffff);
+
+			void
+			present();
+
+			void
+			drawTrianglesInstanced(const uint indexBuffer, const int numTriangles, const uint numInstances);
+
+			const uint
+			createVertexBuffer(const uint size, BufferUsage usage = BufferUsage::STATIC);
+
+			void
+			setVertexAttributeDivisor(const uint position, const uint divisor);
+
+			const uint
+			createVertexArray();
+
+			void
+			setVertexArray(const uint vertexArray);
+
+			void
+			deleteVertexArray(const uint vertexArray);
+
+			void
+			uploadVertexBufferData(const uint vertexBuffer, const uint offset, const uint size, void* data);
+
+			void
+			deleteVertexBuffer(const uint vertexBuffer);
+
+			const uint
+			createIndexBuffer(const uint size, const bool useUnsignedInt = false, BufferUsage usage = BufferUsage::STATIC);
+
+			void
+			setBufferUsage(uint buffer, BufferUsage usage);
+
+			void
+			uploaderIndexBufferData(const uint indexBuffer, const uint offset, const uint size, void* data);
+
+			void
+			deleteIndexBuffer(const uint indexBuffer);
+
+			uint
+			createTexture(TextureType type, unsigned int width, unsigned int height, bool mipMapping, bool optimizeForRenderToTexture = false);
+
+			void
+			uploadTexture2dData(uint texture, unsigned int width, unsigned int height, unsigned int mipLevel, void* data);
+
+			void
+			uploadFloatTexture2dData(uint texture, unsigned int width, unsigned int height, const float* data);
+
+			void
+			uploadCompressedTexture2dData(uint texture, TextureFormat format, unsigned int width, unsigned int height, unsigned int mipLevel, void* data);
+
+			void
+			setTextureBaseLevel(uint texture, uint level);
+
+			void
+			releaseTextureStorage(uint texture);
+
+			void
+			uploadCubeTextureData(uint texture, CubeTexture::Face face, unsigned int width, unsigned int height, unsigned int mipLevel, void* data);
+
+			void
+			copyToCubeTexture(uint texture, CubeTexture::Face face, unsigned int width, unsigned int height);
+
+			void
+			deleteTexture(uint texture);
+
+			void
+			setSamplerStateAt(uint position, WrapMode wrapping, TextureFilter filtering, MipFilter mipFiltering);
+
+			const uint
+			createProgram();
+
+			void
+			attachShader(const uint program, const uint shader);
+
+			void
+			linkProgram(const uint program);
+
+			bool
+			isProgramLinked(const uint program);
+
+			bool
+			getProgramBinary(const uint program, uint& format, std::vector<unsigned char>& binary);
+
+			bool
+			setProgramBinary(const uint program, const uint format, const std::vector<unsigned char>& binary);
+
+			void
+			deleteProgram(const uint program);
+
+			void
+			compileShader(const uint shader);
+
+			const uint
+			createVertexShader();
+
+			void
+			deleteVertexShader(const uint vertexShader);
+
+			const uint
+			createFragmentShader();
+
+			void
+			deleteFragmentShader(const uint fragmentShader);
+
+			std::shared_ptr<ProgramInputs>
+			getProgramInputs(const uint program);
+
+			void
+			setUniforms(uint location, uint size, const int* values);
+
+			void
+			setUniforms2(uint location, uint size, const int* values);
+
+			void
+			setUniforms3(uint location, uint size, const int* values);
+
+			void
+			setUniforms4(uint location, uint size, const int* values);
+
+			void
+			setUniforms(uint location, uint size, const float* values);
+
+			void
+			setUniforms2(uint location, uint size, const float* values);
+
+			void
+			setUniforms3(uint location, uint size, const float* values);
+
+			void
+			setUniforms4(uint location, uint size, const float* values);
+
+			void
+			setStencilTest(CompareMode stencilFunc, int stencilRef, uint stencilMask, StencilOperation stencilFailOp, StencilOperation stencilZFailOp, StencilOperation stencilZPassOp);
+
+			void
+			setScissorTest(bool scissorTest, const render::ScissorBox& scissorBox);
+
+			void
+			readPixels(unsigned int x, unsigned int y, unsigned int width, unsigned int height, unsigned char* pixels);
+
+			void
+			readPixels(unsigned char* pixels);
+
+			void
+			readPixelsAsync(unsigned int x, unsigned int y, unsigned int width, unsigned int height, const uint pixelBuffer);
+
+			void
+			pixelBufferData(const uint pixelBuffer, const uint size, unsigned char* pixels);
+
+			const uint
+			createTimerQuery();
+
+			void
+			deleteTimerQuery(const uint query);
+
+			void
+			beginTimerQuery(const uint query);
+
+			void
+			endTimerQuery();
+
+			bool
+			isTimerQueryAvailable(const uint query);
+
+			bool
+			getTimerQueryResult(const uint query, uint64_t& nanoseconds);
+
+			const uint
+			createOcclusionQuery();
+
+			void
+			deleteOcclusionQuery(const uint query);
+
+			void
+			beginOcclusionQuery(const uint query);
+
+			void
+			endOcclusionQuery();
+
+			bool
+			isOcclusionQueryAvailable(const uint query);
+
+			bool
+			getOcclusionQueryResult(const uint query);
+
+			void
+			setRenderToBackBuffer();
+
+			void
+			setRenderToTexture(unsigned int texture, bool enableDepthAndStencil = false);
+
+			void
+			generateMipmaps(unsigned int texture);
+
+			void
+			contextRestored();
+
 		protected:
 			WebGLContext();
 			
@@ -60,11 +357,10 @@ namespace minko
 								std::vector<ProgramInputs::Type>&	types,
 								std::vector<unsigned int>&			locations);
 
+		private:
+			static
 			void
-			setUniform(const unsigned int&	location,
-					   const unsigned int&	size,
-					   bool			transpose,
-					   const float*	values);
+			transposeMatrices(const float* values, uint numMatrices, float* transposed);
 		};
 	}
 }
@@ -0,0 +1,460 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/render/WebGL2Context.hpp"
+
+#include "minko/render/VertexAttributeType.hpp"
+
+#ifdef EMSCRIPTEN
+# include <GLES3/gl3.h>
+#endif // EMSCRIPTEN
+
+using namespace minko::render;
+
+WebGL2Context::WebGL2Context() :
+	WebGLContext(),
+	_vertexArrays(),
+	_vertexArrayKey(),
+	_vertexArrayChanged(true),
+	_drawVertexArray(0),
+	_immutableTextureStorage(true),
+	_immutableTextures(),
+	_samplers(),
+	_currentSamplerObject(_currentTexture.size(), 0)
+{
+	// extensions with WebGL 1.0, core with WebGL 2.0
+	_instancingSupported = true;
+	_unsignedIntIndicesSupported = true;
+	_npotTexturesSupported = true;
+	_halfFloatVerticesSupported = true;
+	_packedVerticesSupported = true;
+}
+
+WebGL2Context::~WebGL2Context()
+{
+	glBindVertexArray(0);
+	for (auto& keyAndVertexArray : _vertexArrays)
+		glDeleteVertexArrays(1, &keyAndVertexArray.second);
+
+	for (uint position = 0; position < _currentSamplerObject.size(); ++position)
+		if (_currentSamplerObject[position] != 0)
+			glBindSampler(position, 0);
+	for (auto& stateAndSampler : _samplers)
+		glDeleteSamplers(1, &stateAndSampler.second);
+}
+
+void
+WebGL2Context::setShaderSource(const unsigned int shader,
+							   const std::string& source)
+{
+	int type = 0;
+
+	glGetShaderiv(shader, GL_SHADER_TYPE, &type);
+
+	// the GLSL ES 1.00 sources of the effects are compiled as GLSL ES 3.00
+	std::string src = "#version 300 es\n"
+		"#define texture2D texture\n"
+		"#define textureCube texture\n"
+		"#define texture2DLodEXT textureLod\n"
+		"#define textureCubeLodEXT textureLod\n";
+
+	if (type == GL_VERTEX_SHADER)
+		src += "#define attribute in\n"
+			"#define varying out\n";
+	else
+		src += "#define varying in\n"
+			"#define gl_FragDepthEXT gl_FragDepth\n"
+			"out highp vec4 minko_FragColor;\n"
+			"#define gl_FragColor minko_FragColor\n";
+
+	src += source;
+
+	const char* sourceString = src.c_str();
+
+	glShaderSource(shader, 1, &sourceString, 0);
+
+	checkForErrors();
+}
+
+void
+WebGL2Context::setVertexBufferAt(const uint			position,
+								 const uint			vertexBuffer,
+								 const uint			size,
+								 const uint			stride,
+								 const uint			offset,
+								 VertexAttributeType	type)
+{
+	if (_currentVertexBuffer[position] == vertexBuffer
+		&& _currentVertexSize[position] == size
+		&& _currentVertexStride[position] == stride
+		&& _currentVertexOffset[position] == offset
+		&& _currentVertexType[position] == type)
+		return;
+
+	// the attributes are only recorded: the draw binds the vertex array matching all of them
+	_currentVertexBuffer[position] = vertexBuffer;
+	_currentVertexSize[position] = size;
+	_currentVertexStride[position] = stride;
+	_currentVertexOffset[position] = offset;
+	_currentVertexType[position] = type;
+	_vertexArrayChanged = true;
+}
+
+void
+WebGL2Context::setVertexAttributeDivisor(const uint position, const uint divisor)
+{
+	if (_currentVertexDivisor[position] == divisor)
+		return;
+
+	_currentVertexDivisor[position] = divisor;
+	_vertexArrayChanged = true;
+}
+
+void
+WebGL2Context::drawTriangles(const uint indexBuffer, const int numTriangles)
+{
+	flush();
+	bindVertexArray(indexBuffer);
+
+	OpenGLES2Context::drawTriangles(indexBuffer, numTriangles);
+}
+
+void
+WebGL2Context::drawTrianglesInstanced(const uint indexBuffer, const int numTriangles, const uint numInstances)
+{
+	flush();
+	bindVertexArray(indexBuffer);
+
+	OpenGLES2Context::drawTrianglesInstanced(indexBuffer, numTriangles, numInstances);
+}
+
+void
+WebGL2Context::bindVertexArray(uint indexBuffer)
+{
+	if (!_vertexArrayChanged && _drawVertexArray != 0 && _vertexArrayKey[0] == (int)indexBuffer)
+		return;
+
+	_vertexArrayKey.clear();
+	_vertexArrayKey.push_back(indexBuffer);
+	for (uint i = 0; i < _currentVertexBuffer.size(); ++i)
+		if (_currentVertexBuffer[i] > 0)
+			_vertexArrayKey.insert(_vertexArrayKey.end(), {
+				(int)i,
+				_currentVertexBuffer[i],
+				_currentVertexSize[i],
+				_currentVertexStride[i],
+				_currentVertexOffset[i],
+				(int)_currentVertexType[i],
+				(int)_currentVertexDivisor[i]
+			});
+	_vertexArrayChanged = false;
+
+	auto vertexArrayIt = _vertexArrays.find(_vertexArrayKey);
+
+	if (vertexArrayIt != _vertexArrays.end())
+	{
+		if (vertexArrayIt->second != _drawVertexArray)
+		{
+			glBindVertexArray(vertexArrayIt->second);
+			++_stats.numBufferBinds;
+		}
+		_drawVertexArray = vertexArrayIt->second;
+	}
+	else
+	{
+		uint vertexArray;
+
+		glGenVertexArrays(1, &vertexArray);
+		glBindVertexArray(vertexArray);
+
+		for (uint i = 1; i < _vertexArrayKey.size(); i += 7)
+		{
+			const auto position	= _vertexArrayKey[i];
+			const auto type		= static_cast<VertexAttributeType>(_vertexArrayKey[i + 5]);
+			GLenum glType		= GL_FLOAT;
+
+			switch (type)
+			{
+			case VertexAttributeType::FLOAT:						glType = GL_FLOAT;					break;
+			case VertexAttributeType::HALF_FLOAT:					glType = GL_HALF_FLOAT;				break;
+			case VertexAttributeType::UNSIGNED_BYTE_NORMALIZED:		glType = GL_UNSIGNED_BYTE;			break;
+			case VertexAttributeType::BYTE_NORMALIZED:				glType = GL_BYTE;					break;
+			case VertexAttributeType::UNSIGNED_SHORT_NORMALIZED:	glType = GL_UNSIGNED_SHORT;			break;
+			case VertexAttributeType::SHORT_NORMALIZED:				glType = GL_SHORT;					break;
+			case VertexAttributeType::INT_2_10_10_10_NORMALIZED:	glType = GL_INT_2_10_10_10_REV;		break;
+			}
+
+			glEnableVertexAttribArray(position);
+			glBindBuffer(GL_ARRAY_BUFFER, _vertexArrayKey[i + 1]);
+			glVertexAttribPointer(
+				position,
+				type == VertexAttributeType::INT_2_10_10_10_NORMALIZED ? 4 : _vertexArrayKey[i + 2],
+				glType,
+				type == VertexAttributeType::FLOAT || type == VertexAttributeType::HALF_FLOAT ? GL_FALSE : GL_TRUE,
+				sizeof(GLfloat) * _vertexArrayKey[i + 3],
+				(void*)(sizeof(GLfloat) * _vertexArrayKey[i + 4])
+			);
+			glVertexAttribDivisor(position, _vertexArrayKey[i + 6]);
+		}
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+
+		_vertexArrays[_vertexArrayKey] = vertexArray;
+		_drawVertexArray = vertexArray;
+		++_stats.numBufferBinds;
+
+		checkForErrors();
+	}
+
+	// the index buffer is part of the state of the vertex array
+	_currentIndexBuffer = indexBuffer;
+	_currentIndexSize = _indexBufferIndexSize[indexBuffer];
+}
+
+void
+WebGL2Context::unbindVertexArray()
+{
+	if (_drawVertexArray == 0)
+		return;
+
+	// binding an index buffer otherwise changes the bound vertex array
+	glBindVertexArray(0);
+	_drawVertexArray = 0;
+	_currentIndexBuffer = -1;
+	_vertexArrayChanged = true;
+}
+
+void
+WebGL2Context::deleteVertexArrays(uint buffer)
+{
+	for (auto vertexArrayIt = _vertexArrays.begin(); vertexArrayIt != _vertexArrays.end();)
+	{
+		const auto& key	= vertexArrayIt->first;
+		bool		used	= key[0] == (int)buffer;
+
+		for (uint i = 2; i < key.size() && !used; i += 7)
+			used = key[i] == (int)buffer;
+
+		if (!used)
+		{
+			++vertexArrayIt;
+			continue;
+		}
+
+		if (vertexArrayIt->second == _drawVertexArray)
+			unbindVertexArray();
+		glDeleteVertexArrays(1, &vertexArrayIt->second);
+		vertexArrayIt = _vertexArrays.erase(vertexArrayIt);
+	}
+}
+
+const uint
+WebGL2Context::createIndexBuffer(const uint size, const bool useUnsignedInt, BufferUsage usage)
+{
+	flush();
+	unbindVertexArray();
+
+	return WebGLContext::createIndexBuffer(size, useUnsignedInt, usage);
+}
+
+void
+WebGL2Context::uploaderIndexBufferData(const uint indexBuffer, const uint offset, const uint size, void* data)
+{
+	flush();
+	unbindVertexArray();
+
+	WebGLContext::uploaderIndexBufferData(indexBuffer, offset, size, data);
+}
+
+void
+WebGL2Context::deleteVertexBuffer(const uint vertexBuffer)
+{
+	flush();
+	deleteVertexArrays(vertexBuffer);
+
+	WebGLContext::deleteVertexBuffer(vertexBuffer);
+}
+
+void
+WebGL2Context::deleteIndexBuffer(const uint indexBuffer)
+{
+	flush();
+	deleteVertexArrays(indexBuffer);
+	unbindVertexArray();
+
+	WebGLContext::deleteIndexBuffer(indexBuffer);
+}
+
+bool
+WebGL2Context::allocateImmutableStorage(uint texture)
+{
+	if (_immutableTextures.count(texture))
+		return true;
+
+	// the render targets keep the storage they were created with
+	if (!_immutableTextureStorage || _frameBuffers.count(texture))
+		return false;
+
+	const auto& size	= _textureSizes[texture];
+	const auto	target	= getTextureType(texture) == TextureType::Texture2D ? GL_TEXTURE_2D : GL_TEXTURE_CUBE_MAP;
+	int			levels	= 1;
+
+	if (_textureHasMipmaps[texture])
+		for (uint s = std::max(size.first, size.second) >> 1; s > 0; s >>= 1)
+			++levels;
+
+	glBindTexture(target, texture);
+	glTexStorage2D(target, levels, GL_RGBA8, size.first, size.second);
+
+	_currentBoundTexture = texture;
+	_immutableTextures.insert(texture);
+
+	checkForErrors();
+
+	return true;
+}
+
+void
+WebGL2Context::uploadTexture2dData(uint texture, unsigned int width, unsigned int height, unsigned int mipLevel, void* data)
+{
+	flush();
+
+	if (!allocateImmutableStorage(texture))
+		return WebGLContext::uploadTexture2dData(texture, width, height, mipLevel, data);
+
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glTexSubImage2D(GL_TEXTURE_2D, mipLevel, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, data);
+
+	_currentBoundTexture = texture;
+	if (mipLevel == 0)
+	{
+		const auto textureMemory = (unsigned long long)width * height * 4;
+
+		setMemorySize(
+			_textureMemorySizes, _textureMemory, texture,
+			_textureHasMipmaps[texture] ? textureMemory * 4 / 3 : textureMemory
+		);
+	}
+	++_stats.numTextureBinds;
+	_stats.numBytesUploaded += width * height * 4;
+
+	checkForErrors();
+}
+
+void
+WebGL2Context::uploadCubeTextureData(uint				texture,
+									 CubeTexture::Face	face,
+									 unsigned int		width,
+									 unsigned int		height,
+									 unsigned int		mipLevel,
+									 void*				data)
+{
+	flush();
+
+	if (!allocateImmutableStorage(texture))
+		return WebGLContext::uploadCubeTextureData(texture, face, width, height, mipLevel, data);
+
+	GLenum cubeFace = GL_TEXTURE_CUBE_MAP_POSITIVE_X;
+
+	switch (face)
+	{
+	case CubeTexture::Face::POSITIVE_X:	cubeFace = GL_TEXTURE_CUBE_MAP_POSITIVE_X;	break;
+	case CubeTexture::Face::NEGATIVE_X:	cubeFace = GL_TEXTURE_CUBE_MAP_NEGATIVE_X;	break;
+	case CubeTexture::Face::POSITIVE_Y:	cubeFace = GL_TEXTURE_CUBE_MAP_POSITIVE_Y;	break;
+	case CubeTexture::Face::NEGATIVE_Y:	cubeFace = GL_TEXTURE_CUBE_MAP_NEGATIVE_Y;	break;
+	case CubeTexture::Face::POSITIVE_Z:	cubeFace = GL_TEXTURE_CUBE_MAP_POSITIVE_Z;	break;
+	case CubeTexture::Face::NEGATIVE_Z:	cubeFace = GL_TEXTURE_CUBE_MAP_NEGATIVE_Z;	break;
+	}
+
+	glBindTexture(GL_TEXTURE_CUBE_MAP, texture);
+	glTexSubImage2D(cubeFace, mipLevel, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, data);
+
+	_currentBoundTexture = texture;
+	++_stats.numTextureBinds;
+	_stats.numBytesUploaded += width * height * 4;
+
+	checkForErrors();
+}
+
+void
+WebGL2Context::releaseTextureStorage(uint texture)
+{
+	// an immutable storage cannot be shrunk
+	if (_immutableTextures.count(texture))
+		return;
+
+	WebGLContext::releaseTextureStorage(texture);
+}
+
+void
+WebGL2Context::deleteTexture(uint texture)
+{
+	_immutableTextures.erase(texture);
+
+	WebGLContext::deleteTexture(texture);
+}
+
+void
+WebGL2Context::setSamplerStateAt(uint position, WrapMode wrapping, TextureFilter filtering, MipFilter mipFiltering)
+{
+	// the sampler object overrides the parameters of the texture: nothing is stored per texture
+	if (!currentSampler(position, wrapping, mipFiltering))
+		return;
+
+	const auto	state		= SamplerState(wrapping, filtering, mipFiltering);
+	auto		samplerIt	= _samplers.find(state);
+
+	if (samplerIt == _samplers.end())
+	{
+		uint sampler;
+
+		glGenSamplers(1, &sampler);
+		glSamplerParameteri(sampler, GL_TEXTURE_WRAP_S, getGLWrapMode(wrapping));
+		glSamplerParameteri(sampler, GL_TEXTURE_WRAP_T, getGLWrapMode(wrapping));
+		glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, getGLMinFilter(filtering, mipFiltering));
+		glSamplerParameteri(sampler, GL_TEXTURE_MAG_FILTER, getGLMagFilter(filtering));
+
+		samplerIt = _samplers.insert(std::make_pair(state, sampler)).first;
+	}
+
+	if (_currentSamplerObject[position] != samplerIt->second)
+	{
+		// the draws already recorded must use the previous sampler
+		flush();
+
+		glBindSampler(position, samplerIt->second);
+		_currentSamplerObject[position] = samplerIt->second;
+	}
+
+	checkForErrors();
+}
+
+void
+WebGL2Context::contextRestored()
+{
+	_vertexArrays.clear();
+	_vertexArrayKey.clear();
+	_vertexArrayChanged = true;
+	_drawVertexArray = 0;
+	_immutableTextures.clear();
+	_samplers.clear();
+	std::fill(_currentSamplerObject.begin(), _currentSamplerObject.end(), 0);
+
+	WebGLContext::contextRestored();
+}
@@ -0,0 +1,88 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/render/WebGLCommandBuffer.hpp"
+
+#ifdef EMSCRIPTEN
+# include <emscripten.h>
+#endif // EMSCRIPTEN
+
+using namespace minko::render;
+
+void
+WebGLCommandBuffer::flush()
+{
+	if (_words.empty())
+		return;
+
+#ifdef EMSCRIPTEN
+	// the cases follow the order of the Command enum, the GL objects are looked up in the tables
+	// where the GL library of Emscripten maps them to their names
+	EM_ASM_ARGS({
+		var gl = GLctx;
+		var words = HEAP32;
+		var floats = HEAPF32;
+		var i = $0 >> 2;
+		var end = i + $1;
+
+		while (i < end)
+		{
+			switch (words[i++])
+			{
+			case 0: gl.enable(words[i]); i += 1; break;
+			case 1: gl.disable(words[i]); i += 1; break;
+			case 2: gl.cullFace(words[i]); i += 1; break;
+			case 3: gl.blendFunc(words[i], words[i + 1]); i += 2; break;
+			case 4: gl.depthMask(!!words[i]); i += 1; break;
+			case 5: gl.depthFunc(words[i]); i += 1; break;
+			case 6: gl.colorMask(!!words[i], !!words[i], !!words[i], !!words[i]); i += 1; break;
+			case 7: gl.useProgram(words[i] ? GL.programs[words[i]] : null); i += 1; break;
+			case 8: gl.uniform1i(GL.uniforms[words[i]], words[i + 1]); i += 2; break;
+			case 9: gl.uniform2i(GL.uniforms[words[i]], words[i + 1], words[i + 2]); i += 3; break;
+			case 10: gl.uniform3i(GL.uniforms[words[i]], words[i + 1], words[i + 2], words[i + 3]); i += 4; break;
+			case 11: gl.uniform4i(GL.uniforms[words[i]], words[i + 1], words[i + 2], words[i + 3], words[i + 4]); i += 5; break;
+			case 12: gl.uniform1f(GL.uniforms[words[i]], floats[i + 1]); i += 2; break;
+			case 13: gl.uniform2f(GL.uniforms[words[i]], floats[i + 1], floats[i + 2]); i += 3; break;
+			case 14: gl.uniform3f(GL.uniforms[words[i]], floats[i + 1], floats[i + 2], floats[i + 3]); i += 4; break;
+			case 15: gl.uniform4f(GL.uniforms[words[i]], floats[i + 1], floats[i + 2], floats[i + 3], floats[i + 4]); i += 5; break;
+			case 16: gl.uniformMatrix4fv(GL.uniforms[words[i]], false, floats.subarray(i + 1, i + 17)); i += 17; break;
+			case 17:
+				gl.activeTexture(gl.TEXTURE0 + words[i]);
+				gl.bindTexture(words[i + 1], words[i + 2] ? GL.textures[words[i + 2]] : null);
+				i += 3;
+				break;
+			case 18: gl.enableVertexAttribArray(words[i]); i += 1; break;
+			case 19: gl.disableVertexAttribArray(words[i]); i += 1; break;
+			case 20:
+				gl.bindBuffer(gl.ARRAY_BUFFER, GL.buffers[words[i + 1]]);
+				gl.vertexAttribPointer(words[i], words[i + 2], words[i + 3], !!words[i + 4], words[i + 5], words[i + 6]);
+				i += 7;
+				break;
+			case 21: gl.bindBuffer(gl.ELEMENT_ARRAY_BUFFER, words[i] ? GL.buffers[words[i]] : null); i += 1; break;
+			case 22: gl.drawElements(gl.TRIANGLES, words[i], words[i + 1], 0); i += 2; break;
+			default: throw 'unknown WebGL command ' + words[i - 1];
+			}
+		}
+	}, &_words[0], _words.size());
+#endif // EMSCRIPTEN
+
+	_words.clear();
+	_numCommands = 0;
+}
@@ -19,6 +19,9 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/render/WebGLContext.hpp"
 
+#include "minko/render/TriangleCulling.hpp"
+#include "minko/render/VertexAttributeType.hpp"
+
 #ifdef EMSCRIPTEN
 # include <GLES2/gl2.h>
 # include <EGL/egl.h>
@@ -27,7 +30,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 using namespace minko::render;
 
 WebGLContext::WebGLContext() :
-	OpenGLES2Context()
+	OpenGLES2Context(),
+	_commandBuffer(nullptr)
 {
 }
 
@@ -114,36 +118,65 @@ WebGLContext::fillAttributeInputs(const unsigned int							program,
 	}
 }
 
+/*static*/
+void
+WebGLContext::transposeMatrices(const float* values, uint numMatrices, float* transposed)
+{
+	for (uint i = 0; i < numMatrices; ++i)
+	{
+		const float*	matrix	= values		+ (i << 4);
+		float*			tmatrix	= transposed	+ (i << 4);
+
+		tmatrix[0]	= matrix[0];
+		tmatrix[1]	= matrix[4];
+		tmatrix[2]	= matrix[8];
+		tmatrix[3]	= matrix[12];
+		tmatrix[4]	= matrix[1];
+		tmatrix[5]	= matrix[5];
+		tmatrix[6]	= matrix[9];
+		tmatrix[7]	= matrix[13];
+		tmatrix[8]	= matrix[2];
+		tmatrix[9]	= matrix[6];
+		tmatrix[10] = matrix[10];
+		tmatrix[11] = matrix[14];
+		tmatrix[12] = matrix[3];
+		tmatrix[13] = matrix[7];
+		tmatrix[14] = matrix[11];
+		tmatrix[15] = matrix[15];
+	}
+}
+
 void
 WebGLContext::setUniform(const unsigned int& location, const unsigned int& size, bool transpose, const float* values)
 {
+	// arrays of matrices cannot be addressed element by element by location in WebGL
+	if (_commandBuffer && size != 1)
+		flush();
+
+	if (!uniformValueChanged(location, values, (size << 4) * sizeof(float), transpose ? 1 : 0))
+		return;
+
+	if (_commandBuffer && size == 1)
+	{
+		float transposed[16];
+
+		if (transpose)
+			transposeMatrices(values, 1, transposed);
+		else
+			std::memcpy(transposed, values, sizeof(transposed));
+
+		_commandBuffer->command(WebGLCommandBuffer::Command::UNIFORM_MATRIX_4F) << (int)location;
+		for (auto value : transposed)
+			*_commandBuffer << value;
+
+		return;
+	}
+
 	if (transpose)
 	{
 		float* transposed = new float[size << 4];
 
-		for (uint i = 0; i < size; ++i)
-		{
-			const float*	matrix	= values		+ (i << 4);
-			float*			tmatrix	= transposed	+ (i << 4);
-
-			tmatrix[0]	= matrix[0];
-			tmatrix[1]	= matrix[4];
-			tmatrix[2]	= matrix[8];
-			tmatrix[3]	= matrix[12];
-			tmatrix[4]	= matrix[1];
-			tmatrix[5]	= matrix[5];
-			tmatrix[6]	= matrix[9];
-			tmatrix[7]	= matrix[13];
-			tmatrix[8]	= matrix[2];
-			tmatrix[9]	= matrix[6];
-			tmatrix[10] = matrix[10];
-			tmatrix[11] = matrix[14];
-			tmatrix[12] = matrix[3];
-			tmatrix[13] = matrix[7];
-			tmatrix[14] = matrix[11];
-			tmatrix[15] = matrix[15];
-		}
-
+		transposeMatrices(values, size, transposed);
 		glUniformMatrix4fv(location, size, false, transposed);
 
 		delete[] transposed;
@@ -151,3 +184,871 @@ WebGLContext::setUniform(const unsigned int& location, const unsigned int& size,
 	else
 		glUniformMatrix4fv(location, size, false, values);
 }
+
+void
+WebGLContext::commandBufferEnabled(bool enabled)
+{
+	if (enabled == commandBufferEnabled())
+		return;
+
+	flush();
+	_commandBuffer = enabled ? WebGLCommandBuffer::create() : nullptr;
+}
+
+void
+WebGLContext::setProgram(const uint program)
+{
+	if (!_commandBuffer)
+		return OpenGLES2Context::setProgram(program);
+
+	if (_currentProgram == program)
+		return;
+
+	_currentProgram = program;
+	_currentUniformValues = &_programUniformValues[program];
+
+	_commandBuffer->command(WebGLCommandBuffer::Command::USE_PROGRAM) << (int)program;
+	++_stats.numProgramSwitches;
+}
+
+void
+WebGLContext::setUniform(uint location, int value)
+{
+	if (!_commandBuffer)
+		return OpenGLES2Context::setUniform(location, value);
+
+	if (uniformValueChanged(location, &value, sizeof(int)))
+		_commandBuffer->command(WebGLCommandBuffer::Command::UNIFORM_1I) << (int)location << value;
+}
+
+void
+WebGLContext::setUniform(uint location, int v1, int v2)
+{
+	if (!_commandBuffer)
+		return OpenGLES2Context::setUniform(location, v1, v2);
+
+	const int values[2] = { v1, v2 };
+
+	if (uniformValueChanged(location, values, sizeof(values)))
+		_commandBuffer->command(WebGLCommandBuffer::Command::UNIFORM_2I) << (int)location << v1 << v2;
+}
+
+void
+WebGLContext::setUniform(uint location, int v1, int v2, int v3)
+{
+	if (!_commandBuffer)
+		return OpenGLES2Context::setUniform(location, v1, v2, v3);
+
+	const int values[3] = { v1, v2, v3 };
+
+	if (uniformValueChanged(location, values, sizeof(values)))
+		_commandBuffer->command(WebGLCommandBuffer::Command::UNIFORM_3I) << (int)location << v1 << v2 << v3;
+}
+
+void
+WebGLContext::setUniform(uint location, int v1, int v2, int v3, int v4)
+{
+	if (!_commandBuffer)
+		return OpenGLES2Context::setUniform(location, v1, v2, v3, v4);
+
+	const int values[4] = { v1, v2, v3, v4 };
+
+	if (uniformValueChanged(location, values, sizeof(values)))
+		_commandBuffer->command(WebGLCommandBuffer::Command::UNIFORM_4I) << (int)location << v1 << v2 << v3 << v4;
+}
+
+void
+WebGLContext::setUniform(uint location, float value)
+{
+	if (!_commandBuffer)
+		return OpenGLES2Context::setUniform(location, value);
+
+	if (uniformValueChanged(location, &value, sizeof(float)))
+		_commandBuffer->command(WebGLCommandBuffer::Command::UNIFORM_1F) << (int)location << value;
+}
+
+void
+WebGLContext::setUniform(uint location, float v1, float v2)
+{
+	if (!_commandBuffer)
+		return OpenGLES2Context::setUniform(location, v1, v2);
+
+	const float values[2] = { v1, v2 };
+
+	if (uniformValueChanged(location, values, sizeof(values)))
+		_commandBuffer->command(WebGLCommandBuffer::Command::UNIFORM_2F) << (int)location << v1 << v2;
+}
+
+void
+WebGLContext::setUniform(uint location, float v1, float v2, float v3)
+{
+	if (!_commandBuffer)
+		return OpenGLES2Context::setUniform(location, v1, v2, v3);
+
+	const float values[3] = { v1, v2, v3 };
+
+	if (uniformValueChanged(location, values, sizeof(values)))
+		_commandBuffer->command(WebGLCommandBuffer::Command::UNIFORM_3F) << (int)location << v1 << v2 << v3;
+}
+
+void
+WebGLContext::setUniform(uint location, float v1, float v2, float v3, float v4)
+{
+	if (!_commandBuffer)
+		return OpenGLES2Context::setUniform(location, v1, v2, v3, v4);
+
+	const float values[4] = { v1, v2, v3, v4 };
+
+	if (uniformValueChanged(location, values, sizeof(values)))
+		_commandBuffer->command(WebGLCommandBuffer::Command::UNIFORM_4F) << (int)location << v1 << v2 << v3 << v4;
+}
+
+void
+WebGLContext::setTextureAt(uint position, int texture, int location)
+{
+	if (!_commandBuffer)
+		return OpenGLES2Context::setTextureAt(position, texture, location);
+
+	if (texture <= 0 || position >= _currentTexture.size())
+		return;
+
+	if (_currentTexture[position] != texture || _currentBoundTexture != texture)
+	{
+		const int glTarget = getTextureType(texture) == TextureType::Texture2D ? GL_TEXTURE_2D : GL_TEXTURE_CUBE_MAP;
+
+		_commandBuffer->command(WebGLCommandBuffer::Command::BIND_TEXTURE) << (int)position << glTarget << texture;
+
+		_currentTexture[position]	= texture;
+		_currentBoundTexture		= texture;
+		++_stats.numTextureBinds;
+	}
+
+	const int unit = position;
+
+	if (location >= 0 && uniformValueChanged(location, &unit, sizeof(int)))
+		_commandBuffer->command(WebGLCommandBuffer::Command::UNIFORM_1I) << location << unit;
+}
+
+void
+WebGLContext::setVertexBufferAt(const uint			position,
+								const uint			vertexBuffer,
+								const uint			size,
+								const uint			stride,
+								const uint			offset,
+								VertexAttributeType	type)
+{
+	int glType = 0;
+
+	switch (type)
+	{
+	case VertexAttributeType::FLOAT:						glType = GL_FLOAT;			break;
+	case VertexAttributeType::UNSIGNED_BYTE_NORMALIZED:		glType = GL_UNSIGNED_BYTE;	break;
+	case VertexAttributeType::BYTE_NORMALIZED:				glType = GL_BYTE;			break;
+	case VertexAttributeType::UNSIGNED_SHORT_NORMALIZED:	glType = GL_UNSIGNED_SHORT;	break;
+	case VertexAttributeType::SHORT_NORMALIZED:				glType = GL_SHORT;			break;
+	default:																			break;
+	}
+
+	// the types that depend on an extension are left to the base implementation
+	if (!_commandBuffer || glType == 0)
+	{
+		flush();
+
+		return OpenGLES2Context::setVertexBufferAt(position, vertexBuffer, size, stride, offset, type);
+	}
+
+	if (_currentVertexBuffer[position] == vertexBuffer
+		&& _currentVertexSize[position] == size
+		&& _currentVertexStride[position] == stride
+		&& _currentVertexOffset[position] == offset
+		&& _currentVertexType[position] == type)
+		return;
+
+	_currentVertexBuffer[position] = vertexBuffer;
+	_currentVertexSize[position] = size;
+	_currentVertexStride[position] = stride;
+	_currentVertexOffset[position] = offset;
+	_currentVertexType[position] = type;
+
+	if (vertexBuffer == 0)
+	{
+		_commandBuffer->command(WebGLCommandBuffer::Command::DISABLE_ATTRIBUTE) << (int)position;
+
+		return;
+	}
+
+	_commandBuffer->command(WebGLCommandBuffer::Command::ENABLE_ATTRIBUTE) << (int)position;
+	_commandBuffer->command(WebGLCommandBuffer::Command::ATTRIBUTE_POINTER)
+		<< (int)position
+		<< (int)vertexBuffer
+		<< (int)size
+		<< glType
+		<< (type == VertexAttributeType::FLOAT ? 0 : 1)
+		<< (int)(sizeof(float) * stride)
+		<< (int)(sizeof(float) * offset);
+	++_stats.numBufferBinds;
+}
+
+void
+WebGLContext::drawTriangles(const uint indexBuffer, const int numTriangles)
+{
+	if (!_commandBuffer)
+		return OpenGLES2Context::drawTriangles(indexBuffer, numTriangles);
+
+	if (_currentIndexBuffer != indexBuffer)
+	{
+		_currentIndexBuffer = indexBuffer;
+		_currentIndexSize = _indexBufferIndexSize[indexBuffer];
+
+		_commandBuffer->command(WebGLCommandBuffer::Command::BIND_ELEMENT_BUFFER) << (int)indexBuffer;
+		++_stats.numBufferBinds;
+	}
+
+	_commandBuffer->command(WebGLCommandBuffer::Command::DRAW_ELEMENTS)
+		<< numTriangles * 3
+		<< (_currentIndexSize == sizeof(uint) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT);
+
+	++_stats.numDrawCalls;
+	_stats.numTriangles += numTriangles;
+}
+
+void
+WebGLContext::setBlendMode(Blending::Source source, Blending::Destination destination)
+{
+	if (!_commandBuffer)
+		return OpenGLES2Context::setBlendMode(source, destination);
+
+	if ((static_cast<uint>(source) | static_cast<uint>(destination)) == static_cast<uint>(_currentBlendMode))
+		return;
+
+	_currentBlendMode = (Blending::Mode)((uint)source | (uint)destination);
+
+	_commandBuffer->command(WebGLCommandBuffer::Command::BLEND_FUNC)
+		<< (int)_blendingFactors.at(static_cast<uint>(source) & 0x00ff)
+		<< (int)_blendingFactors.at(static_cast<uint>(destination) & 0xff00);
+}
+
+void
+WebGLContext::setBlendMode(Blending::Mode blendMode)
+{
+	if (!_commandBuffer)
+		return OpenGLES2Context::setBlendMode(blendMode);
+
+	if (blendMode == _currentBlendMode)
+		return;
+
+	_currentBlendMode = blendMode;
+
+	_commandBuffer->command(WebGLCommandBuffer::Command::BLEND_FUNC)
+		<< (int)_blendingFactors.at(static_cast<uint>(blendMode) & 0x00ff)
+		<< (int)_blendingFactors.at(static_cast<uint>(blendMode) & 0xff00);
+}
+
+void
+WebGLContext::setDepthTest(bool depthMask, CompareMode depthFunc)
+{
+	if (!_commandBuffer)
+		return OpenGLES2Context::setDepthTest(depthMask, depthFunc);
+
+	if (depthMask == _currentDepthMask && depthFunc == _currentDepthFunc)
+		return;
+
+	_currentDepthMask = depthMask;
+	_currentDepthFunc = depthFunc;
+
+	_commandBuffer->command(WebGLCommandBuffer::Command::DEPTH_MASK) << (depthMask ? 1 : 0);
+	_commandBuffer->command(WebGLCommandBuffer::Command::DEPTH_FUNC) << (int)_compareFuncs.at(depthFunc);
+}
+
+void
+WebGLContext::setColorMask(bool colorMask)
+{
+	if (!_commandBuffer)
+		return OpenGLES2Context::setColorMask(colorMask);
+
+	if (colorMask == _currentColorMask)
+		return;
+
+	_currentColorMask = colorMask;
+
+	_commandBuffer->command(WebGLCommandBuffer::Command::COLOR_MASK) << (colorMask ? 1 : 0);
+}
+
+void
+WebGLContext::setTriangleCulling(TriangleCulling triangleCulling)
+{
+	if (!_commandBuffer)
+		return OpenGLES2Context::setTriangleCulling(triangleCulling);
+
+	if (triangleCulling == _currentTriangleCulling)
+		return;
+
+	if (_currentTriangleCulling == TriangleCulling::NONE)
+		_commandBuffer->command(WebGLCommandBuffer::Command::ENABLE) << GL_CULL_FACE;
+	_currentTriangleCulling = triangleCulling;
+
+	switch (triangleCulling)
+	{
+	case TriangleCulling::NONE:
+		_commandBuffer->command(WebGLCommandBuffer::Command::DISABLE) << GL_CULL_FACE;
+		break;
+	case TriangleCulling::BACK:
+		_commandBuffer->command(WebGLCommandBuffer::Command::CULL_FACE) << GL_BACK;
+		break;
+	case TriangleCulling::FRONT:
+		_commandBuffer->command(WebGLCommandBuffer::Command::CULL_FACE) << GL_FRONT;
+		break;
+	case TriangleCulling::BOTH:
+		_commandBuffer->command(WebGLCommandBuffer::Command::CULL_FACE) << GL_FRONT_AND_BACK;
+		break;
+	}
+}
+
+void
+WebGLContext::configureViewport(const uint x, const uint y, const uint width, const uint height)
+{
+	flush();
+
+	OpenGLES2Context::configureViewport(x, y, width, height);
+}
+
+void
+WebGLContext::clear(float red, float green, float blue, float alpha, float depth, unsigned int stencil, unsigned int mask)
+{
+	flush();
+
+	OpenGLES2Context::clear(red, green, blue, alpha, depth, stencil, mask);
+}
+
+void
+WebGLContext::present()
+{
+	flush();
+
+	OpenGLES2Context::present();
+}
+
+void
+WebGLContext::drawTrianglesInstanced(const uint indexBuffer, const int numTriangles, const uint numInstances)
+{
+	flush();
+
+	OpenGLES2Context::drawTrianglesInstanced(indexBuffer, numTriangles, numInstances);
+}
+
+const uint
+WebGLContext::createVertexBuffer(const uint size, BufferUsage usage)
+{
+	flush();
+
+	return OpenGLES2Context::createVertexBuffer(size, usage);
+}
+
+void
+WebGLContext::setVertexAttributeDivisor(const uint position, const uint divisor)
+{
+	flush();
+
+	OpenGLES2Context::setVertexAttributeDivisor(position, divisor);
+}
+
+const uint
+WebGLContext::createVertexArray()
+{
+	flush();
+
+	return OpenGLES2Context::createVertexArray();
+}
+
+void
+WebGLContext::setVertexArray(const uint vertexArray)
+{
+	// the draw calls sharing a vertex array stay in the command buffer
+	if (vertexArray != _currentVertexArray)
+		flush();
+
+	OpenGLES2Context::setVertexArray(vertexArray);
+}
+
+void
+WebGLContext::deleteVertexArray(const uint vertexArray)
+{
+	flush();
+
+	OpenGLES2Context::deleteVertexArray(vertexArray);
+}
+
+void
+WebGLContext::uploadVertexBufferData(const uint vertexBuffer, const uint offset, const uint size, void* data)
+{
+	flush();
+
+	OpenGLES2Context::uploadVertexBufferData(vertexBuffer, offset, size, data);
+}
+
+void
+WebGLContext::deleteVertexBuffer(const uint vertexBuffer)
+{
+	flush();
+
+	OpenGLES2Context::deleteVertexBuffer(vertexBuffer);
+}
+
+const uint
+WebGLContext::createIndexBuffer(const uint size, const bool useUnsignedInt, BufferUsage usage)
+{
+	flush();
+
+	return OpenGLES2Context::createIndexBuffer(size, useUnsignedInt, usage);
+}
+
+void
+WebGLContext::setBufferUsage(uint buffer, BufferUsage usage)
+{
+	flush();
+
+	OpenGLES2Context::setBufferUsage(buffer, usage);
+}
+
+void
+WebGLContext::uploaderIndexBufferData(const uint indexBuffer, const uint offset, const uint size, void* data)
+{
+	flush();
+
+	OpenGLES2Context::uploaderIndexBufferData(indexBuffer, offset, size, data);
+}
+
+void
+WebGLContext::deleteIndexBuffer(const uint indexBuffer)
+{
+	flush();
+
+	OpenGLES2Context::deleteIndexBuffer(indexBuffer);
+}
+
+uint
+WebGLContext::createTexture(TextureType type, unsigned int width, unsigned int height, bool mipMapping, bool optimizeForRenderToTexture)
+{
+	flush();
+
+	return OpenGLES2Context::createTexture(type, width, height, mipMapping, optimizeForRenderToTexture);
+}
+
+void
+WebGLContext::uploadTexture2dData(uint texture, unsigned int width, unsigned int height, unsigned int mipLevel, void* data)
+{
+	flush();
+
+	OpenGLES2Context::uploadTexture2dData(texture, width, height, mipLevel, data);
+}
+
+void
+WebGLContext::uploadFloatTexture2dData(uint texture, unsigned int width, unsigned int height, const float* data)
+{
+	flush();
+
+	OpenGLES2Context::uploadFloatTexture2dData(texture, width, height, data);
+}
+
+void
+WebGLContext::uploadCompressedTexture2dData(uint texture, TextureFormat format, unsigned int width, unsigned int height, unsigned int mipLevel, void* data)
+{
+	flush();
+
+	OpenGLES2Context::uploadCompressedTexture2dData(texture, format, width, height, mipLevel, data);
+}
+
+void
+WebGLContext::setTextureBaseLevel(uint texture, uint level)
+{
+	flush();
+
+	OpenGLES2Context::setTextureBaseLevel(texture, level);
+}
+
+void
+WebGLContext::releaseTextureStorage(uint texture)
+{
+	flush();
+
+	OpenGLES2Context::releaseTextureStorage(texture);
+}
+
+void
+WebGLContext::uploadCubeTextureData(uint texture, CubeTexture::Face face, unsigned int width, unsigned int height, unsigned int mipLevel, void* data)
+{
+	flush();
+
+	OpenGLES2Context::uploadCubeTextureData(texture, face, width, height, mipLevel, data);
+}
+
+void
+WebGLContext::copyToCubeTexture(uint texture, CubeTexture::Face face, unsigned int width, unsigned int height)
+{
+	// the draw calls rendering the copied pixels may still be pending
+	flush();
+
+	OpenGLES2Context::copyToCubeTexture(texture, face, width, height);
+}
+
+void
+WebGLContext::deleteTexture(uint texture)
+{
+	flush();
+
+	OpenGLES2Context::deleteTexture(texture);
+}
+
+void
+WebGLContext::setSamplerStateAt(uint position, WrapMode wrapping, TextureFilter filtering, MipFilter mipFiltering)
+{
+	flush();
+
+	OpenGLES2Context::setSamplerStateAt(position, wrapping, filtering, mipFiltering);
+}
+
+const uint
+WebGLContext::createProgram()
+{
+	flush();
+
+	return OpenGLES2Context::createProgram();
+}
+
+void
+WebGLContext::attachShader(const uint program, const uint shader)
+{
+	flush();
+
+	OpenGLES2Context::attachShader(program, shader);
+}
+
+void
+WebGLContext::linkProgram(const uint program)
+{
+	flush();
+
+	OpenGLES2Context::linkProgram(program);
+}
+
+bool
+WebGLContext::isProgramLinked(const uint program)
+{
+	flush();
+
+	return OpenGLES2Context::isProgramLinked(program);
+}
+
+bool
+WebGLContext::getProgramBinary(const uint program, uint& format, std::vector<unsigned char>& binary)
+{
+	flush();
+
+	return OpenGLES2Context::getProgramBinary(program, format, binary);
+}
+
+bool
+WebGLContext::setProgramBinary(const uint program, const uint format, const std::vector<unsigned char>& binary)
+{
+	flush();
+
+	return OpenGLES2Context::setProgramBinary(program, format, binary);
+}
+
+void
+WebGLContext::deleteProgram(const uint program)
+{
+	flush();
+
+	OpenGLES2Context::deleteProgram(program);
+}
+
+void
+WebGLContext::compileShader(const uint shader)
+{
+	flush();
+
+	OpenGLES2Context::compileShader(shader);
+}
+
+const uint
+WebGLContext::createVertexShader()
+{
+	flush();
+
+	return OpenGLES2Context::createVertexShader();
+}
+
+void
+WebGLContext::deleteVertexShader(const uint vertexShader)
+{
+	flush();
+
+	OpenGLES2Context::deleteVertexShader(vertexShader);
+}
+
+const uint
+WebGLContext::createFragmentShader()
+{
+	flush();
+
+	return OpenGLES2Context::createFragmentShader();
+}
+
+void
+WebGLContext::deleteFragmentShader(const uint fragmentShader)
+{
+	flush();
+
+	OpenGLES2Context::deleteFragmentShader(fragmentShader);
+}
+
+std::shared_ptr<ProgramInputs>
+WebGLContext::getProgramInputs(const uint program)
+{
+	flush();
+
+	return OpenGLES2Context::getProgramInputs(program);
+}
+
+void
+WebGLContext::setUniforms(uint location, uint size, const int* values)
+{
+	flush();
+
+	OpenGLES2Context::setUniforms(location, size, values);
+}
+
+void
+WebGLContext::setUniforms2(uint location, uint size, const int* values)
+{
+	flush();
+
+	OpenGLES2Context::setUniforms2(location, size, values);
+}
+
+void
+WebGLContext::setUniforms3(uint location, uint size, const int* values)
+{
+	flush();
+
+	OpenGLES2Context::setUniforms3(location, size, values);
+}
+
+void
+WebGLContext::setUniforms4(uint location, uint size, const int* values)
+{
+	flush();
+
+	OpenGLES2Context::setUniforms4(location, size, values);
+}
+
+void
+WebGLContext::setUniforms(uint location, uint size, const float* values)
+{
+	flush();
+
+	OpenGLES2Context::setUniforms(location, size, values);
+}
+
+void
+WebGLContext::setUniforms2(uint location, uint size, const float* values)
+{
+	flush();
+
+	OpenGLES2Context::setUniforms2(location, size, values);
+}
+
+void
+WebGLContext::setUniforms3(uint location, uint size, const float* values)
+{
+	flush();
+
+	OpenGLES2Context::setUniforms3(location, size, values);
+}
+
+void
+WebGLContext::setUniforms4(uint location, uint size, const float* values)
+{
+	flush();
+
+	OpenGLES2Context::setUniforms4(location, size, values);
+}
+
+void
+WebGLContext::setStencilTest(CompareMode stencilFunc, int stencilRef, uint stencilMask, StencilOperation stencilFailOp, StencilOperation stencilZFailOp, StencilOperation stencilZPassOp)
+{
+	flush();
+
+	OpenGLES2Context::setStencilTest(stencilFunc, stencilRef, stencilMask, stencilFailOp, stencilZFailOp, stencilZPassOp);
+}
+
+void
+WebGLContext::setScissorTest(bool scissorTest, const render::ScissorBox& scissorBox)
+{
+	flush();
+
+	OpenGLES2Context::setScissorTest(scissorTest, scissorBox);
+}
+
+void
+WebGLContext::readPixels(unsigned int x, unsigned int y, unsigned int width, unsigned int height, unsigned char* pixels)
+{
+	flush();
+
+	OpenGLES2Context::readPixels(x, y, width, height, pixels);
+}
+
+void
+WebGLContext::readPixels(unsigned char* pixels)
+{
+	flush();
+
+	OpenGLES2Context::readPixels(pixels);
+}
+
+void
+WebGLContext::readPixelsAsync(unsigned int x, unsigned int y, unsigned int width, unsigned int height, const uint pixelBuffer)
+{
+	flush();
+
+	OpenGLES2Context::readPixelsAsync(x, y, width, height, pixelBuffer);
+}
+
+void
+WebGLContext::pixelBufferData(const uint pixelBuffer, const uint size, unsigned char* pixels)
+{
+	flush();
+
+	OpenGLES2Context::pixelBufferData(pixelBuffer, size, pixels);
+}
+
+const uint
+WebGLContext::createTimerQuery()
+{
+	flush();
+
+	return OpenGLES2Context::createTimerQuery();
+}
+
+void
+WebGLContext::deleteTimerQuery(const uint query)
+{
+	flush();
+
+	OpenGLES2Context::deleteTimerQuery(query);
+}
+
+void
+WebGLContext::beginTimerQuery(const uint query)
+{
+	flush();
+
+	OpenGLES2Context::beginTimerQuery(query);
+}
+
+void
+WebGLContext::endTimerQuery()
+{
+	flush();
+
+	OpenGLES2Context::endTimerQuery();
+}
+
+bool
+WebGLContext::isTimerQueryAvailable(const uint query)
+{
+	flush();
+
+	return OpenGLES2Context::isTimerQueryAvailable(query);
+}
+
+bool
+WebGLContext::getTimerQueryResult(const uint query, uint64_t& nanoseconds)
+{
+	flush();
+
+	return OpenGLES2Context::getTimerQueryResult(query, nanoseconds);
+}
+
+const uint
+WebGLContext::createOcclusionQuery()
+{
+	flush();
+
+	return OpenGLES2Context::createOcclusionQuery();
+}
+
+void
+WebGLContext::deleteOcclusionQuery(const uint query)
+{
+	flush();
+
+	OpenGLES2Context::deleteOcclusionQuery(query);
+}
+
+void
+WebGLContext::beginOcclusionQuery(const uint query)
+{
+	flush();
+
+	OpenGLES2Context::beginOcclusionQuery(query);
+}
+
+void
+WebGLContext::endOcclusionQuery()
+{
+	flush();
+
+	OpenGLES2Context::endOcclusionQuery();
+}
+
+bool
+WebGLContext::isOcclusionQueryAvailable(const uint query)
+{
+	flush();
+
+	return OpenGLES2Context::isOcclusionQueryAvailable(query);
+}
+
+bool
+WebGLContext::getOcclusionQueryResult(const uint query)
+{
+	flush();
+
+	return OpenGLES2Context::getOcclusionQueryResult(query);
+}
+
+void
+WebGLContext::setRenderToBackBuffer()
+{
+	flush();
+
+	OpenGLES2Context::setRenderToBackBuffer();
+}
+
+void
+WebGLContext::setRenderToTexture(unsigned int texture, bool enableDepthAndStencil)
+{
+	flush();
+
+	OpenGLES2Context::setRenderToTexture(texture, enableDepthAndStencil);
+}
+
+void
+WebGLContext::generateMipmaps(unsigned int texture)
+{
+	flush();
+
+	OpenGLES2Context::generateMipmaps(texture);
+}
+
+void
+WebGLContext::contextRestored()
+{
+	// the pending commands refer to the objects of the lost context
+	if (_commandBuffer)
+		_commandBuffer->clear();
+
+	OpenGLES2Context::contextRestored();
+}
@@ -18,6 +18,16 @@ newoption {
 	description = 'Disable tests.'
 }
 
+newoption {
+	trigger	= 'no-benchmark',
+	description = 'Disable benchmarks.'
+}
+
+newoption {
+	trigger	= 'no-tool',
+	description = 'Disable tools.'
+}
+
 newoption {
 	trigger = 'dist-dir',
 	description = 'Output folder for the redistributable SDK built with the \'dist\' action.'
@@ -116,11 +126,23 @@ solution "minko"
 		include 'example/joystick'
 	end
 
+	-- tool
+	if not _OPTIONS['no-tool'] then
+		include 'tool/conditioner'
+		include 'tool/mkstats'
+	end
+
 	-- test
 	if not _OPTIONS['no-test'] then
 		include 'test'
 	end
 
+	-- benchmark
+	if not _OPTIONS['no-benchmark'] then
+		include 'benchmark'
+		include 'benchmark/scene'
+	end
+
 newaction {
 	trigger		= 'dist',
 	description	= 'Generate the distributable version of the Minko SDK.',
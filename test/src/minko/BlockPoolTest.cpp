@@ -0,0 +1,90 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BlockPoolTest.hpp"
+
+using namespace minko;
+
+namespace
+{
+	struct Pooled
+	{
+		MINKO_POOLED_ALLOCATION(Pooled)
+
+		float values[5];
+	};
+
+	struct Derived :
+		public Pooled
+	{
+		float more[3];
+	};
+}
+
+TEST_F(BlockPoolTest, ReleasedBlocksAreReused)
+{
+	auto first = new Pooled();
+	auto numFreeBlocks = BlockPool<sizeof(Pooled)>::numFreeBlocks();
+
+	delete first;
+
+	ASSERT_EQ(BlockPool<sizeof(Pooled)>::numFreeBlocks(), numFreeBlocks + 1);
+
+	auto second = new Pooled();
+
+	ASSERT_EQ(second, first);
+	ASSERT_EQ(BlockPool<sizeof(Pooled)>::numFreeBlocks(), numFreeBlocks);
+
+	delete second;
+}
+
+TEST_F(BlockPoolTest, DerivedClassesUseTheGlobalOperators)
+{
+	auto numFreeBlocks = BlockPool<sizeof(Pooled)>::numFreeBlocks();
+	auto derived = new Derived();
+
+	delete derived;
+
+	ASSERT_EQ(BlockPool<sizeof(Pooled)>::numFreeBlocks(), numFreeBlocks);
+}
+
+TEST_F(BlockPoolTest, ListNodes)
+{
+	std::list<int, BlockAllocator<int>> list;
+
+	for (int i = 0; i < 100; ++i)
+		list.push_back(i);
+	list.clear();
+
+	for (int i = 0; i < 100; ++i)
+		list.push_back(i);
+
+	ASSERT_EQ(list.size(), 100u);
+	ASSERT_EQ(list.back(), 99);
+}
+
+TEST_F(BlockPoolTest, PooledMathObjects)
+{
+	auto v = math::Vector3::create(1.f, 2.f, 3.f);
+	auto block = v.get();
+
+	v = nullptr;
+
+	ASSERT_EQ(math::Vector3::create().get(), block);
+}
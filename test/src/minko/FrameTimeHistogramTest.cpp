@@ -0,0 +1,82 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "FrameTimeHistogramTest.hpp"
+
+using namespace minko;
+
+TEST_F(FrameTimeHistogramTest, Create)
+{
+	auto h = FrameTimeHistogram::create();
+
+	ASSERT_EQ(h->numFrames(), 0);
+	ASSERT_EQ(h->numBuckets(), 100);
+	ASSERT_FLOAT_EQ(h->percentile(.5f), 0.f);
+}
+
+TEST_F(FrameTimeHistogramTest, CreateInvalid)
+{
+	ASSERT_THROW(FrameTimeHistogram::create(0.f), std::invalid_argument);
+	ASSERT_THROW(FrameTimeHistogram::create(1.f, 0), std::invalid_argument);
+}
+
+TEST_F(FrameTimeHistogramTest, Record)
+{
+	auto h = FrameTimeHistogram::create(1.f, 10);
+
+	h->record(16.2f);
+	h->record(16.8f);
+	h->record(2.5f);
+	h->record(40.f);
+
+	ASSERT_EQ(h->numFrames(), 4);
+	ASSERT_EQ(h->bucket(2), 1);
+	ASSERT_EQ(h->bucket(9), 3);
+	ASSERT_FLOAT_EQ(h->minTime(), 2.5f);
+	ASSERT_FLOAT_EQ(h->maxTime(), 40.f);
+	ASSERT_FLOAT_EQ(h->averageTime(), 18.875f);
+}
+
+TEST_F(FrameTimeHistogramTest, Percentile)
+{
+	auto h = FrameTimeHistogram::create(1.f, 100);
+
+	for (auto i = 0; i < 99; ++i)
+		h->record(16.5f);
+	h->record(50.5f);
+
+	ASSERT_FLOAT_EQ(h->percentile(0.f), 17.f);
+	ASSERT_FLOAT_EQ(h->percentile(.5f), 17.f);
+	ASSERT_FLOAT_EQ(h->percentile(.99f), 17.f);
+	ASSERT_FLOAT_EQ(h->percentile(1.f), 50.5f);
+	ASSERT_THROW(h->percentile(2.f), std::invalid_argument);
+}
+
+TEST_F(FrameTimeHistogramTest, Reset)
+{
+	auto h = FrameTimeHistogram::create();
+
+	h->record(16.f);
+	h->reset();
+
+	ASSERT_EQ(h->numFrames(), 0);
+	ASSERT_EQ(h->bucket(16), 0);
+	ASSERT_FLOAT_EQ(h->maxTime(), 0.f);
+}
@@ -0,0 +1,203 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "ProfilerTest.hpp"
+
+using namespace minko;
+
+TEST_F(ProfilerTest, DisabledScopesAreNotRecorded)
+{
+	Profiler::enabled(false);
+
+	{
+		MINKO_PROFILE_SCOPE("disabled");
+	}
+
+	ASSERT_TRUE(Profiler::events().empty());
+}
+
+TEST_F(ProfilerTest, NestedScopes)
+{
+	{
+		MINKO_PROFILE_SCOPE("frame");
+
+		{
+			MINKO_PROFILE_SCOPE("update");
+		}
+		{
+			MINKO_PROFILE_SCOPE("render");
+		}
+	}
+
+	auto events = Profiler::events();
+
+	ASSERT_EQ(3u, events.size());
+	ASSERT_STREQ("frame", events[0].name);
+	ASSERT_EQ(0u, events[0].depth);
+	ASSERT_STREQ("update", events[1].name);
+	ASSERT_EQ(1u, events[1].depth);
+	ASSERT_STREQ("render", events[2].name);
+	ASSERT_EQ(1u, events[2].depth);
+	ASSERT_TRUE(events[1].start >= events[0].start);
+	ASSERT_TRUE(events[2].start + events[2].duration <= events[0].start + events[0].duration);
+}
+
+TEST_F(ProfilerTest, RingBufferKeepsTheLastEvents)
+{
+	auto bufferSize = Profiler::bufferSize();
+
+	Profiler::bufferSize(2);
+
+	for (auto name : { "a", "b", "c" })
+	{
+		MINKO_PROFILE_SCOPE(name);
+	}
+
+	auto events = Profiler::events();
+
+	Profiler::bufferSize(bufferSize);
+
+	ASSERT_EQ(2u, events.size());
+	ASSERT_STREQ("b", events[0].name);
+	ASSERT_STREQ("c", events[1].name);
+	ASSERT_THROW(Profiler::bufferSize(0), std::invalid_argument);
+}
+
+TEST_F(ProfilerTest, ThreadsHaveTheirOwnBuffer)
+{
+	{
+		MINKO_PROFILE_SCOPE("main");
+	}
+
+	std::thread thread([]()
+	{
+		MINKO_PROFILE_SCOPE("thread");
+	});
+
+	thread.join();
+
+	auto events = Profiler::events();
+
+	ASSERT_EQ(2u, events.size());
+	ASSERT_NE(events[0].thread, events[1].thread);
+	ASSERT_EQ(0u, events[0].depth);
+	ASSERT_EQ(0u, events[1].depth);
+}
+
+TEST_F(ProfilerTest, LastFrame)
+{
+	for (auto i = 0; i < 2; ++i)
+	{
+		MINKO_PROFILE_SCOPE("frame");
+		MINKO_PROFILE_SCOPE(i == 0 ? "first" : "second");
+	}
+
+	auto frame = Profiler::lastFrame("frame");
+
+	ASSERT_EQ(2u, frame.size());
+	ASSERT_STREQ("frame", frame[0].name);
+	ASSERT_STREQ("second", frame[1].name);
+	ASSERT_TRUE(Profiler::lastFrame("unknown").empty());
+	ASSERT_EQ(0u, Profiler::report("frame").find("frame "));
+	ASSERT_NE(std::string::npos, Profiler::report("frame").find("\n  second "));
+}
+
+TEST_F(ProfilerTest, ExportChromeTrace)
+{
+	{
+		MINKO_PROFILE_SCOPE(Profiler::intern("quoted \"name\""));
+	}
+
+	auto trace = Profiler::exportChromeTrace();
+
+	ASSERT_EQ(0u, trace.find("{\"traceEvents\":[{\"name\":\"quoted \\\"name\\\"\",\"cat\":\"minko\",\"ph\":\"X\""));
+	ASSERT_NE(std::string::npos, trace.find("\"displayTimeUnit\":\"ms\"}"));
+}
+
+TEST_F(ProfilerTest, GpuEventsHaveTheirOwnThread)
+{
+	{
+		MINKO_PROFILE_SCOPE("cpu");
+	}
+
+	Profiler::gpuEvent("gpu", 10, 20);
+
+	auto events = Profiler::events();
+
+	ASSERT_EQ(2u, events.size());
+	ASSERT_STREQ("gpu", events[0].name);
+	ASSERT_EQ(Profiler::gpuThread(), events[0].thread);
+	ASSERT_EQ(0u, events[0].depth);
+	ASSERT_EQ(10u, events[0].start);
+	ASSERT_EQ(20u, events[0].duration);
+	ASSERT_NE(Profiler::gpuThread(), events[1].thread);
+}
+
+TEST_F(ProfilerTest, InternedNamesAreShared)
+{
+	ASSERT_EQ(Profiler::intern("name"), Profiler::intern(std::string("na") + "me"));
+}
+
+TEST_F(ProfilerTest, Counters)
+{
+	Profiler::counter("numDrawCalls", 12);
+	Profiler::counter("numDrawCalls", 15);
+
+	auto samples = Profiler::counters();
+
+	ASSERT_EQ(2u, samples.size());
+	ASSERT_EQ(12u, samples[0].value);
+	ASSERT_EQ(15u, samples[1].value);
+	ASSERT_LE(samples[0].time, samples[1].time);
+	ASSERT_NE(std::string::npos, Profiler::exportChromeTrace().find("\"ph\":\"C\",\"pid\":0"));
+
+	Profiler::clear();
+
+	ASSERT_TRUE(Profiler::counters().empty());
+}
+
+TEST_F(ProfilerTest, StartupStopsAfterTheFirstFrame)
+{
+	{
+		MINKO_PROFILE_SCOPE("initialize");
+	}
+	{
+		MINKO_PROFILE_SCOPE("SceneManager::nextFrame");
+	}
+	{
+		MINKO_PROFILE_SCOPE("SceneManager::nextFrame");
+	}
+
+	auto events = Profiler::startup();
+
+	ASSERT_EQ(2u, events.size());
+	ASSERT_STREQ("initialize", events[0].name);
+	ASSERT_STREQ("SceneManager::nextFrame", events[1].name);
+	ASSERT_NE(std::string::npos, Profiler::startupReport().find("time to first frame"));
+}
+
+TEST_F(ProfilerTest, NoStartupWithoutAFrame)
+{
+	{
+		MINKO_PROFILE_SCOPE("initialize");
+	}
+
+	ASSERT_TRUE(Profiler::startup().empty());
+}
@@ -187,3 +187,101 @@ TEST_F(SignalTest, LockRemove)
 	ASSERT_EQ(v, 42);
 	ASSERT_EQ(w, 42);
 }
+
+TEST_F(SignalTest, Priority)
+{
+	auto s = Signal<int>::create();
+	std::vector<int> order;
+
+	auto slot1 = s->connect([&](int i) { order.push_back(1); });
+	auto slot2 = s->connect([&](int i) { order.push_back(2); }, 10.f);
+	auto slot3 = s->connect([&](int i) { order.push_back(3); });
+	auto slot4 = s->connect([&](int i) { order.push_back(4); }, 10.f);
+
+	s->execute(42);
+
+	ASSERT_EQ(order, std::vector<int>({ 2, 4, 1, 3 }));
+}
+
+TEST_F(SignalTest, LockRemoveNested)
+{
+	auto s = Signal<int>::create();
+	auto v = 0;
+	Signal<int>::Slot slot2;
+	auto slot1 = s->connect([&](int i)
+	{
+		if (i == 0)
+			return;
+
+		slot2 = nullptr;
+		s->execute(0);
+	});
+
+	slot2 = s->connect([&](int i)
+	{
+		++v;
+	});
+
+	s->execute(42);
+
+	ASSERT_EQ(s->numCallbacks(), 1);
+
+	s->execute(42);
+
+	ASSERT_EQ(s->numCallbacks(), 1);
+}
+
+TEST_F(SignalTest, StatsDisabled)
+{
+	auto s = Signal<int>::create()->name("SignalTest::disabled");
+	auto slot = s->connect([](int i) {});
+
+	SignalStats::enabled(false);
+	SignalStats::clear();
+
+	s->execute(42);
+	SignalStats::nextFrame();
+
+	ASSERT_TRUE(SignalStats::lastFrame().empty());
+}
+
+TEST_F(SignalTest, StatsPerFrame)
+{
+	auto named = Signal<int>::create()->name("SignalTest::named");
+	auto unnamed = Signal<int>::create();
+	auto slot1 = named->connect([&](int i)
+	{
+		unnamed->execute(i);
+	});
+	auto slot2 = named->connect([](int i) {});
+	auto slot3 = unnamed->connect([](int i) {});
+
+	SignalStats::enabled(true);
+	SignalStats::clear();
+
+	named->execute(1);
+	named->execute(2);
+	unnamed->execute(3);
+	SignalStats::nextFrame();
+	SignalStats::enabled(false);
+
+	auto frame = SignalStats::lastFrame();
+
+	ASSERT_EQ(frame.size(), 2);
+
+	auto& namedStats = std::string(frame[0].name) == "SignalTest::named" ? frame[0] : frame[1];
+	auto& unnamedStats = &namedStats == &frame[0] ? frame[1] : frame[0];
+
+	ASSERT_STREQ(namedStats.name, "SignalTest::named");
+	ASSERT_EQ(namedStats.numExecutions, 2);
+	ASSERT_EQ(namedStats.numCallbacks, 4);
+	ASSERT_STREQ(unnamedStats.name, typeid(Signal<int>).name());
+	ASSERT_EQ(unnamedStats.numExecutions, 3);
+	ASSERT_EQ(unnamedStats.numCallbacks, 3);
+	ASSERT_GE(frame[0].time, frame[1].time);
+	ASSERT_NE(SignalStats::report().find("SignalTest::named"), std::string::npos);
+
+	SignalStats::nextFrame();
+
+	ASSERT_TRUE(SignalStats::lastFrame().empty());
+}
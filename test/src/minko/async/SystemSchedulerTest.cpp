@@ -0,0 +1,145 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SystemSchedulerTest.hpp"
+
+#include "minko/async/SystemScheduler.hpp"
+#include "minko/async/ThreadPool.hpp"
+
+#include <atomic>
+
+using namespace minko;
+using namespace minko::async;
+
+TEST_F(SystemSchedulerTest, OrderFromDeclaredData)
+{
+	auto scheduler = SystemScheduler::create();
+	auto update = [](float, float) { };
+
+	scheduler->addSystem("animation", update, {}, { "transform" });
+	scheduler->addSystem("physics", update, { "transform" }, { "transform", "physics" });
+	scheduler->addSystem("particles", update, {}, { "particles" });
+	scheduler->addSystem("transforms", update, { "transform" }, { "worldTransform" });
+
+	ASSERT_EQ(scheduler->dependencies("animation"), std::vector<std::string>());
+	ASSERT_EQ(scheduler->dependencies("physics"), std::vector<std::string>({ "animation" }));
+	ASSERT_EQ(scheduler->dependencies("particles"), std::vector<std::string>());
+	ASSERT_EQ(scheduler->dependencies("transforms"), std::vector<std::string>({ "animation", "physics" }));
+	ASSERT_EQ(
+		scheduler->order(),
+		std::vector<std::string>({ "animation", "physics", "particles", "transforms" })
+	);
+}
+
+TEST_F(SystemSchedulerTest, ExplicitOrderWins)
+{
+	auto scheduler = SystemScheduler::create();
+	auto update = [](float, float) { };
+
+	scheduler->addSystem("a", update, {}, { "data" }, { "b" });
+	scheduler->addSystem("b", update, { "data" }, {}, { "missing" });
+
+	ASSERT_EQ(scheduler->order(), std::vector<std::string>({ "b", "a" }));
+}
+
+TEST_F(SystemSchedulerTest, Cycle)
+{
+	auto scheduler = SystemScheduler::create();
+	auto update = [](float, float) { };
+
+	scheduler->addSystem("a", update, {}, {}, { "b" });
+	scheduler->addSystem("b", update, {}, {}, { "a" });
+
+	ASSERT_THROW(scheduler->execute(0.f, 0.f), std::logic_error);
+}
+
+TEST_F(SystemSchedulerTest, DuplicateName)
+{
+	auto scheduler = SystemScheduler::create();
+
+	scheduler->addSystem("a", [](float, float) { }, {}, {});
+
+	ASSERT_THROW(scheduler->addSystem("a", [](float, float) { }, {}, {}), std::invalid_argument);
+}
+
+TEST_F(SystemSchedulerTest, ExecuteInParallel)
+{
+	auto scheduler = SystemScheduler::create(ThreadPool::create(4));
+	auto mainThreadId = std::this_thread::get_id();
+	std::atomic<uint> numIndependent(0);
+	uint numMainThread = 0;
+	auto dependentAfterAll = false;
+
+	for (uint i = 0; i < 16; ++i)
+	{
+		std::stringstream name;
+
+		name << "independent" << i;
+		scheduler->addSystem(name.str(), [&](float, float) { ++numIndependent; }, {}, {}, {});
+	}
+	scheduler->addSystem(
+		"mainThread",
+		[&](float, float)
+		{
+			if (std::this_thread::get_id() == mainThreadId)
+				++numMainThread;
+		},
+		{}, { "scene" }, {}, true
+	);
+
+	std::vector<std::string> after;
+
+	for (uint i = 0; i < 16; ++i)
+	{
+		std::stringstream name;
+
+		name << "independent" << i;
+		after.push_back(name.str());
+	}
+	scheduler->addSystem(
+		"dependent",
+		[&](float, float) { dependentAfterAll = numIndependent == 16 && numMainThread == 1; },
+		{ "scene" }, {}, after
+	);
+
+	for (uint frame = 0; frame < 10; ++frame)
+	{
+		numIndependent = 0;
+		numMainThread = 0;
+		dependentAfterAll = false;
+
+		scheduler->execute(0.f, 16.f);
+
+		ASSERT_EQ(numIndependent, 16u);
+		ASSERT_EQ(numMainThread, 1u);
+		ASSERT_TRUE(dependentAfterAll);
+	}
+}
+
+TEST_F(SystemSchedulerTest, ExceptionRethrown)
+{
+	auto scheduler = SystemScheduler::create(ThreadPool::create(2));
+	auto executed = false;
+
+	scheduler->addSystem("throw", [](float, float) { throw std::runtime_error("system"); }, {}, { "data" });
+	scheduler->addSystem("next", [&](float, float) { executed = true; }, { "data" }, {});
+
+	ASSERT_THROW(scheduler->execute(0.f, 0.f), std::runtime_error);
+	ASSERT_TRUE(executed);
+}
@@ -0,0 +1,131 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ThreadPoolTest.hpp"
+
+#include "minko/async/ThreadPool.hpp"
+
+using namespace minko;
+using namespace minko::async;
+
+TEST_F(ThreadPoolTest, RunAndComplete)
+{
+	auto pool = ThreadPool::create(4);
+	std::atomic<uint> numRun(0);
+	uint numCompleted = 0;
+
+	for (uint i = 0; i < 100; ++i)
+		pool->run([&]() { ++numRun; }, [&]() { ++numCompleted; });
+
+	auto start = std::chrono::steady_clock::now();
+
+	while (numCompleted < 100 && std::chrono::steady_clock::now() - start < std::chrono::seconds(10))
+		pool->update();
+
+	ASSERT_EQ(pool->numThreads(), 4u);
+	ASSERT_EQ(numRun, 100u);
+	ASSERT_EQ(numCompleted, 100u);
+}
+
+TEST_F(ThreadPoolTest, Priorities)
+{
+	auto pool = ThreadPool::create(0);
+	std::vector<int> order;
+
+	pool->run([&]() { order.push_back(0); }, nullptr, 0);
+	pool->run([&]() { order.push_back(2); }, nullptr, 2);
+	pool->run([&]() { order.push_back(1); }, nullptr, 1);
+	pool->run([&]() { order.push_back(3); }, nullptr, 2);
+
+	ASSERT_EQ(pool->numPendingTasks(), 4u);
+
+	pool->update();
+
+	ASSERT_EQ(order, std::vector<int>({ 2, 3, 1, 0 }));
+}
+
+TEST_F(ThreadPoolTest, Cancel)
+{
+	auto pool = ThreadPool::create(0);
+	auto run = false;
+	auto completed = false;
+
+	auto task = pool->run([&]() { run = true; }, [&]() { completed = true; });
+
+	task->cancel();
+	pool->update();
+
+	ASSERT_TRUE(task->cancelled());
+	ASSERT_FALSE(run);
+	ASSERT_FALSE(completed);
+}
+
+TEST_F(ThreadPoolTest, ExceptionRethrownOnUpdate)
+{
+	auto pool = ThreadPool::create(0);
+
+	pool->run([]() { throw std::runtime_error("task"); });
+
+	ASSERT_THROW(pool->update(), std::runtime_error);
+}
+
+TEST_F(ThreadPoolTest, Post)
+{
+	auto pool = ThreadPool::create(2);
+	std::atomic<bool> posted(false);
+	auto numCallbacks = 0;
+
+	pool->run([&]() { pool->post([&]() { ++numCallbacks; }); posted = true; });
+
+	while (!posted)
+		std::this_thread::yield();
+
+	ASSERT_EQ(numCallbacks, 0);
+
+	pool->update();
+
+	ASSERT_EQ(numCallbacks, 1);
+}
+
+TEST_F(ThreadPoolTest, WaitForCompletion)
+{
+	auto pool = ThreadPool::create(2);
+	uint numCompleted = 0;
+
+	for (uint i = 0; i < 10; ++i)
+		pool->run([]() { std::this_thread::sleep_for(std::chrono::milliseconds(1)); }, [&]() { ++numCompleted; });
+
+	while (pool->waitForCompletion())
+		;
+
+	ASSERT_EQ(numCompleted, 10u);
+	ASSERT_FALSE(pool->waitForCompletion());
+}
+
+TEST_F(ThreadPoolTest, WaitForCompletionWithoutThreads)
+{
+	auto pool = ThreadPool::create(0);
+	auto completed = false;
+
+	pool->run([]() { }, [&]() { completed = true; });
+
+	ASSERT_TRUE(pool->waitForCompletion());
+	ASSERT_TRUE(completed);
+	ASSERT_FALSE(pool->waitForCompletion());
+}
@@ -0,0 +1,84 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "AnimationBatcherTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::scene;
+
+static
+animation::Matrix4x4Timeline::Ptr
+createTranslationTimeline()
+{
+	return animation::Matrix4x4Timeline::create(
+		"transform.matrix",
+		1000,
+		{ 0, 1000 },
+		{ math::Matrix4x4::create(), math::Matrix4x4::create()->appendTranslation(10.f, 0.f, 0.f) },
+		true
+	);
+}
+
+TEST_F(AnimationBatcherTest, EvaluateBatchedAnimation)
+{
+	auto root = Node::create()
+		->addComponent(SceneManager::create(MinkoTests::context()))
+		->addComponent(AnimationBatcher::create());
+	auto timeline = createTranslationTimeline();
+	auto node = Node::create()
+		->addComponent(Transform::create())
+		->addComponent(Animation::create({ timeline }));
+
+	root->addChild(node);
+	root->component<SceneManager>()->nextFrame(500.f, 500.f);
+
+	auto batcher = root->component<AnimationBatcher>();
+
+	ASSERT_EQ(1u, batcher->numAnimations());
+	ASSERT_EQ(1u, batcher->numTimelines());
+
+	auto expected = timeline->interpolate(500);
+	auto matrix = node->component<Transform>()->matrix();
+
+	for (uint i = 0; i < 16; ++i)
+		ASSERT_FLOAT_EQ(expected->data()[i], matrix->data()[i]);
+	ASSERT_FLOAT_EQ(5.f, matrix->data()[3]);
+}
+
+TEST_F(AnimationBatcherTest, UnbindRemovedAnimation)
+{
+	auto root = Node::create()
+		->addComponent(SceneManager::create(MinkoTests::context()))
+		->addComponent(AnimationBatcher::create());
+	auto node = Node::create()
+		->addComponent(Transform::create())
+		->addComponent(Animation::create({ createTranslationTimeline() }));
+	auto animation = node->component<Animation>();
+
+	root->addChild(node);
+	root->component<SceneManager>()->nextFrame(100.f, 100.f);
+	ASSERT_EQ(1u, root->component<AnimationBatcher>()->numAnimations());
+
+	node->removeComponent(animation);
+	root->component<SceneManager>()->nextFrame(200.f, 100.f);
+	ASSERT_EQ(0u, root->component<AnimationBatcher>()->numAnimations());
+}
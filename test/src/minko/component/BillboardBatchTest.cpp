@@ -0,0 +1,127 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BillboardBatchTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::math;
+using namespace minko::scene;
+
+static
+BillboardBatch::Ptr
+createBatch()
+{
+	std::vector<render::Pass::Ptr> passes;
+
+	return BillboardBatch::create(MinkoTests::context(), render::Effect::create(passes));
+}
+
+TEST_F(BillboardBatchTest, AddRemove)
+{
+	auto batch = createBatch();
+	auto a = batch->add(Vector3::create(1.f, 2.f, 3.f), Vector2::create(2.f, 1.f));
+	auto b = batch->add(Vector3::create(), Vector2::create(1.f, 1.f), Vector4::create(1.f, 0.f, 0.f, .5f));
+
+	ASSERT_EQ(2u, batch->numBillboards());
+	ASSERT_EQ(2.f, batch->position(a)->y());
+	ASSERT_EQ(.5f, batch->color(b)->w());
+	ASSERT_EQ(1.f, batch->uvRect(a)->z());
+
+	batch->remove(a);
+
+	ASSERT_EQ(1u, batch->numBillboards());
+	ASSERT_FALSE(batch->contains(a));
+	ASSERT_THROW(batch->position(a), std::invalid_argument);
+
+	// the id of the removed billboard is reused
+	ASSERT_EQ(a, batch->add(Vector3::create(), Vector2::create(1.f, 1.f)));
+}
+
+TEST_F(BillboardBatchTest, UpdateIndices)
+{
+	auto batch = createBatch();
+	auto root = Node::create("root")->addComponent(Transform::create());
+
+	root->addComponent(batch);
+
+	for (uint i = 0; i < 100; ++i)
+		batch->add(Vector3::create(float(i), 0.f, 0.f), Vector2::create(1.f, 1.f));
+	batch->update();
+
+	ASSERT_EQ(1u, root->children().size());
+	ASSERT_EQ(100u, batch->numVisible());
+	ASSERT_EQ(600u, batch->geometry()->indices()->data().size());
+	ASSERT_EQ(400u, batch->geometry()->vertexBuffer("position")->numVertices());
+
+	batch->remove(10);
+	batch->update();
+
+	ASSERT_EQ(99u, batch->numVisible());
+	ASSERT_EQ(594u, batch->geometry()->indices()->data().size());
+
+	batch->clear();
+	batch->update();
+
+	ASSERT_EQ(0u, batch->numVisible());
+}
+
+TEST_F(BillboardBatchTest, FrustumCulling)
+{
+	auto batch = createBatch();
+	auto root = Node::create("root")->addComponent(Transform::create());
+	auto worldToScreen = Matrix4x4::create()
+		->view(Vector3::create(0.f, 0.f, -5.f), Vector3::create())
+		->append(Matrix4x4::create()->perspective(.8f, 1.f, .1f, 100.f));
+
+	root->addComponent(batch);
+
+	auto inside = batch->add(Vector3::create(0.f, 0.f, 10.f), Vector2::create(1.f, 1.f));
+
+	batch->add(Vector3::create(0.f, 0.f, -20.f), Vector2::create(1.f, 1.f));
+	batch->add(Vector3::create(500.f, 0.f, 10.f), Vector2::create(1.f, 1.f));
+	batch->update(worldToScreen);
+
+	ASSERT_EQ(1u, batch->numVisible());
+	ASSERT_EQ(inside << 2, batch->geometry()->indices()->data()[0]);
+
+	// moving the target moves the frustum in the space of the billboards
+	root->component<Transform>()->matrix()->appendTranslation(-500.f, 0.f, 0.f);
+	batch->update(worldToScreen);
+
+	ASSERT_EQ(1u, batch->numVisible());
+	ASSERT_EQ(2u, batch->geometry()->indices()->data()[0] >> 2);
+}
+
+TEST_F(BillboardBatchTest, RemoveBatchNodeWithTarget)
+{
+	auto batch = createBatch();
+	auto root = Node::create("root")->addComponent(Transform::create());
+
+	root->addComponent(batch);
+
+	ASSERT_EQ(1u, root->children().size());
+	ASSERT_TRUE(root->children()[0]->hasComponent<Surface>());
+
+	root->removeComponent(batch);
+
+	ASSERT_EQ(0u, root->children().size());
+}
@@ -0,0 +1,91 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "ClusteredLightingTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::scene;
+
+TEST_F(ClusteredLightingTest, PackHalf)
+{
+	for (auto value : { 0.f, 1.f, -2.5f, .1f, 1000.f, -1.f, .001f })
+		ASSERT_NEAR(value, ClusteredLighting::unpackHalf(ClusteredLighting::packHalf(value)), fabsf(value) / 1024.f);
+
+	ASSERT_EQ(0x3c00, ClusteredLighting::packHalf(1.f));
+	ASSERT_EQ(0xc000, ClusteredLighting::packHalf(-2.f));
+	ASSERT_FLOAT_EQ(65504.f, ClusteredLighting::unpackHalf(ClusteredLighting::packHalf(1e6f)));
+}
+
+TEST_F(ClusteredLightingTest, BinLightsInClusters)
+{
+	auto root = Node::create()
+		->addComponent(SceneManager::create(MinkoTests::context()));
+	auto camera = Node::create()
+		->addComponent(Transform::create())
+		->addComponent(PerspectiveCamera::create(1.f, .785f, .1f, 1000.f))
+		->addComponent(ClusteredLighting::create(MinkoTests::context()));
+	// in front of the camera, in the middle of the screen and 10 units away
+	auto light = Node::create()
+		->addComponent(Transform::create(math::Matrix4x4::create()->appendTranslation(0.f, 0.f, -10.f)))
+		->addComponent(PointLight::create(1.f, 1.f, 1.f, 0.f, 0.f));
+
+	root->addChild(camera)->addChild(light);
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	auto clusteredLighting = camera->component<ClusteredLighting>();
+
+	ASSERT_EQ(1u, clusteredLighting->numLights());
+	ASSERT_EQ(1u, clusteredLighting->numClusterLights(8, 4, 8));
+	ASSERT_EQ(0u, clusteredLighting->numClusterLights(0, 0, 8));
+	ASSERT_EQ(0u, clusteredLighting->numClusterLights(8, 4, 15));
+	ASSERT_LT(clusteredLighting->numLightIndices(), 16u);
+	ASSERT_TRUE(camera->data()->hasProperty("lightClusters.lights"));
+}
+
+TEST_F(ClusteredLightingTest, LightsWithoutRangeReachAllClusters)
+{
+	auto root = Node::create()
+		->addComponent(SceneManager::create(MinkoTests::context()));
+	auto camera = Node::create()
+		->addComponent(Transform::create())
+		->addComponent(PerspectiveCamera::create(1.f))
+		->addComponent(ClusteredLighting::create(MinkoTests::context()));
+
+	root->addChild(camera)->addChild(Node::create()->addComponent(PointLight::create()));
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	auto clusteredLighting = camera->component<ClusteredLighting>();
+
+	ASSERT_EQ(
+		ClusteredLighting::NUM_TILES_X * ClusteredLighting::NUM_TILES_Y * ClusteredLighting::NUM_SLICES,
+		clusteredLighting->numLightIndices()
+	);
+}
+
+TEST_F(ClusteredLightingTest, NotOnCamera)
+{
+	ASSERT_THROW(
+		Node::create()->addComponent(ClusteredLighting::create(MinkoTests::context())),
+		std::logic_error
+	);
+}
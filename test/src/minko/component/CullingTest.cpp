@@ -0,0 +1,69 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "CullingTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::component;
+
+TEST_F(CullingTest, OcclusionQueriesDisabledByDefault)
+{
+	auto culling = Culling::create(math::Frustum::create(), "camera.worldToScreenMatrix");
+
+	ASSERT_FALSE(culling->occlusionQueries());
+	ASSERT_TRUE(culling->occlusionQueries(true)->occlusionQueries());
+	ASSERT_FALSE(culling->occlusionQueries(false)->occlusionQueries());
+}
+
+TEST_F(CullingTest, InvalidOcclusionQueryInterval)
+{
+	auto culling = Culling::create(math::Frustum::create(), "camera.worldToScreenMatrix");
+
+	ASSERT_THROW(culling->occlusionQueryInterval(0), std::invalid_argument);
+	ASSERT_EQ(2u, culling->occlusionQueryInterval(2)->occlusionQueryInterval());
+}
+
+TEST_F(CullingTest, CreateOcclusionQueryWithoutSupport)
+{
+	if (MinkoTests::context()->supportsOcclusionQueries())
+		return;
+
+	ASSERT_THROW(MinkoTests::context()->createOcclusionQuery(), std::logic_error);
+}
+
+TEST_F(CullingTest, AddRemoveRenderer)
+{
+	auto culling = Culling::create(math::Frustum::create(), "camera.worldToScreenMatrix");
+	auto renderer = Renderer::create();
+
+	ASSERT_TRUE(culling->renderers().empty());
+	ASSERT_THROW(culling->addRenderer(nullptr), std::invalid_argument);
+
+	culling->addRenderer(renderer)->addRenderer(renderer);
+
+	ASSERT_EQ(1u, culling->renderers().size());
+	ASSERT_EQ(renderer, culling->renderers()[0]);
+
+	culling->removeRenderer(renderer);
+
+	ASSERT_TRUE(culling->renderers().empty());
+	ASSERT_THROW(culling->removeRenderer(renderer), std::invalid_argument);
+}
@@ -0,0 +1,109 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ImpostorTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::math;
+
+static
+render::Effect::Ptr
+createEffect()
+{
+	std::vector<render::Pass::Ptr> passes;
+
+	return render::Effect::create(passes);
+}
+
+static
+scene::Node::Ptr
+createNode()
+{
+	return scene::Node::create()
+		->addComponent(Transform::create())
+		->addComponent(BoundingBox::create(1.f, Vector3::create()))
+		->addComponent(Surface::create(
+			geometry::CubeGeometry::create(MinkoTests::context()),
+			material::Material::create(),
+			createEffect()
+		));
+}
+
+TEST_F(ImpostorTest, InvalidNumViews)
+{
+	ASSERT_THROW(Impostor::create(MinkoTests::context(), createEffect(), 0), std::invalid_argument);
+	ASSERT_THROW(Impostor::create(MinkoTests::context(), createEffect(), 6), std::invalid_argument);
+	ASSERT_THROW(Impostor::create(MinkoTests::context(), createEffect(), 8, 100), std::invalid_argument);
+}
+
+TEST_F(ImpostorTest, BakeWithoutSurface)
+{
+	auto impostor = Impostor::create(MinkoTests::context(), createEffect());
+
+	scene::Node::create()->addComponent(impostor);
+
+	ASSERT_THROW(impostor->bake(), std::logic_error);
+}
+
+TEST_F(ImpostorTest, Bake)
+{
+	auto impostor = Impostor::create(MinkoTests::context(), createEffect(), 4, 32);
+	auto node = createNode()->addComponent(impostor);
+
+	impostor->bake();
+
+	ASSERT_EQ(128u, impostor->atlas()->width());
+	ASSERT_EQ(32u, impostor->atlas()->height());
+	ASSERT_EQ(2u, node->components<Surface>().size());
+	ASSERT_FALSE(impostor->active());
+}
+
+TEST_F(ImpostorTest, SwapWithScreenSize)
+{
+	auto impostor = Impostor::create(MinkoTests::context(), createEffect(), 4, 32);
+	auto node = createNode()->addComponent(impostor);
+	auto surface = node->component<Surface>();
+
+	impostor->update(Vector3::create(0.f, 0.f, 2.f), 1.f);
+
+	ASSERT_FALSE(impostor->active());
+	ASSERT_TRUE(surface->visible());
+
+	// baked by the first update far enough from the camera
+	impostor->update(Vector3::create(0.f, 0.f, 100.f), 1.f);
+
+	ASSERT_TRUE(impostor->active());
+	ASSERT_NE(nullptr, impostor->atlas());
+	ASSERT_FALSE(surface->visible());
+	ASSERT_TRUE(node->component<Surface>(1)->visible());
+	ASSERT_EQ(0, impostor->view());
+
+	impostor->update(Vector3::create(100.f, 0.f, 0.f), 1.f);
+
+	ASSERT_EQ(1, impostor->view());
+
+	impostor->update(Vector3::create(0.f, 0.f, 2.f), 1.f);
+
+	ASSERT_FALSE(impostor->active());
+	ASSERT_TRUE(surface->visible());
+	ASSERT_FALSE(node->component<Surface>(1)->visible());
+}
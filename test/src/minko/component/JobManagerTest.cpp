@@ -0,0 +1,123 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "JobManagerTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::component;
+
+namespace
+{
+	class OrderJob :
+		public JobManager::Job
+	{
+	public:
+		typedef std::shared_ptr<OrderJob>	Ptr;
+
+	private:
+		float				_priority;
+		uint				_numSteps;
+		std::vector<int>&	_order;
+		std::function<void()>	_asyncTask;
+
+	public:
+		static
+		Ptr
+		create(float priority, std::vector<int>& order, std::function<void()> asyncTask = nullptr)
+		{
+			return std::shared_ptr<OrderJob>(new OrderJob(priority, order, asyncTask));
+		}
+
+		bool
+		complete()
+		{
+			return _numSteps != 0;
+		}
+
+		void
+		beforeFirstStep()
+		{
+		}
+
+		void
+		step()
+		{
+			++_numSteps;
+			if (_asyncTask)
+				runAsync(_asyncTask);
+		}
+
+		float
+		priority()
+		{
+			return _priority;
+		}
+
+		void
+		afterLastStep()
+		{
+			_order.push_back((int)_priority);
+		}
+
+	private:
+		OrderJob(float priority, std::vector<int>& order, std::function<void()> asyncTask) :
+			_priority(priority),
+			_numSteps(0),
+			_order(order),
+			_asyncTask(asyncTask)
+		{
+		}
+	};
+}
+
+TEST_F(JobManagerTest, Priorities)
+{
+	auto jobManager = JobManager::create(1);
+	std::vector<int> order;
+
+	jobManager->pushJob(OrderJob::create(1.f, order));
+	jobManager->pushJob(OrderJob::create(3.f, order));
+	jobManager->pushJob(OrderJob::create(2.f, order));
+	jobManager->pushJob(OrderJob::create(5.f, order));
+
+	ASSERT_EQ(jobManager->numJobs(), 4u);
+
+	jobManager->update(nullptr);
+	jobManager->end(nullptr);
+
+	ASSERT_EQ(order, std::vector<int>({ 5, 3, 2, 1 }));
+	ASSERT_EQ(jobManager->numJobs(), 0u);
+}
+
+TEST_F(JobManagerTest, RunAsyncWithoutCanvas)
+{
+	auto jobManager = JobManager::create(1);
+	std::vector<int> order;
+	auto run = false;
+
+	jobManager->pushJob(OrderJob::create(1.f, order, [&]() { run = true; }));
+
+	jobManager->update(nullptr);
+	jobManager->end(nullptr);
+
+	ASSERT_TRUE(run);
+	ASSERT_EQ(order, std::vector<int>({ 1 }));
+}
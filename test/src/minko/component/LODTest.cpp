@@ -0,0 +1,75 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "LODTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::scene;
+
+TEST_F(LODTest, SimplifiedChain)
+{
+	auto sphere	= geometry::SphereGeometry::create(MinkoTests::context(), 40, 40);
+	auto lod	= LOD::create(sphere, 3);
+
+	ASSERT_EQ(lod->numLevels(), 3u);
+	ASSERT_EQ(lod->levelGeometry(0), sphere);
+	ASSERT_LT(lod->levelGeometry(1)->indices()->data().size(), sphere->indices()->data().size());
+	ASSERT_LT(lod->levelGeometry(2)->indices()->data().size(), lod->levelGeometry(1)->indices()->data().size());
+	ASSERT_EQ(lod->levelGeometry(1)->vertexBuffers(), sphere->vertexBuffers());
+	ASSERT_EQ(lod->levelScreenSize(2), 0.f);
+}
+
+TEST_F(LODTest, SelectByDistance)
+{
+	std::vector<render::Pass::Ptr> passes;
+	auto sphere = geometry::SphereGeometry::create(MinkoTests::context(), 20, 20);
+	auto lod = LOD::create(sphere, 3);
+	auto node = Node::create()
+		->addComponent(Transform::create())
+		->addComponent(Surface::create(sphere, material::Material::create(), render::Effect::create(passes)))
+		->addComponent(BoundingBox::create())
+		->addComponent(lod);
+	auto surface = node->component<Surface>();
+	auto levels = std::vector<uint>();
+
+	auto _ = lod->levelChanged()->connect([&](LOD::Ptr lod, uint level)
+	{
+		levels.push_back(level);
+	});
+
+	lod->update(math::Vector3::create(0.f, 0.f, .5f), 1.f);
+	ASSERT_EQ(lod->level(), 0);
+	ASSERT_EQ(surface->geometry(), lod->levelGeometry(0));
+
+	lod->update(math::Vector3::create(0.f, 0.f, 100.f), 1.f);
+	ASSERT_EQ(lod->level(), 2);
+	ASSERT_EQ(surface->geometry(), lod->levelGeometry(2));
+	ASSERT_EQ(levels, std::vector<uint>({ 2 }));
+}
+
+TEST_F(LODTest, InvalidRatio)
+{
+	auto sphere = geometry::SphereGeometry::create(MinkoTests::context());
+
+	ASSERT_THROW(LOD::create(sphere, 2, 1.f), std::invalid_argument);
+	ASSERT_THROW(sphere->simplify(0.f), std::invalid_argument);
+}
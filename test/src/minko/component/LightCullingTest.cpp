@@ -0,0 +1,136 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "LightCullingTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::scene;
+
+static
+Node::Ptr
+createSurface(float x)
+{
+	std::vector<render::Pass::Ptr> passes;
+
+	return Node::create()
+		->addComponent(Transform::create(math::Matrix4x4::create()->appendTranslation(x, 0.f, 0.f)))
+		->addComponent(Surface::create(
+			geometry::CubeGeometry::create(MinkoTests::context()),
+			material::Material::create(),
+			render::Effect::create(passes)
+		));
+}
+
+static
+Node::Ptr
+createPointLight(float x, float range)
+{
+	// with no linear and quadratic terms the attenuation reaches 0 at the constant term
+	return Node::create()
+		->addComponent(Transform::create(math::Matrix4x4::create()->appendTranslation(x, 0.f, 0.f)))
+		->addComponent(PointLight::create(1.f, 1.f, range, 0.f, 0.f));
+}
+
+TEST_F(LightCullingTest, Range)
+{
+	ASSERT_FLOAT_EQ(2.f, LightCulling::range(math::Vector3::create(1.f, .5f, 0.f)));
+	ASSERT_EQ(FLT_MAX, LightCulling::range(math::Vector3::create(-1.f, -1.f, -1.f)));
+	ASSERT_EQ(FLT_MAX, LightCulling::range(math::Vector3::create(1.f, 0.f, .1f)));
+}
+
+TEST_F(LightCullingTest, FixedNumberOfSlots)
+{
+	auto root = Node::create()
+		->addComponent(SceneManager::create(MinkoTests::context()))
+		->addComponent(LightCulling::create());
+	auto surface = createSurface(0.f);
+
+	root->addChild(surface);
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(1u, root->component<LightCulling>()->numSurfaces());
+	ASSERT_EQ((int)LightCulling::MAX_NUM_POINT_LIGHTS, surface->data()->get<int>("localPointLights.length"));
+	ASSERT_EQ((int)LightCulling::MAX_NUM_SPOT_LIGHTS, surface->data()->get<int>("localSpotLights.length"));
+	ASSERT_EQ(nullptr, root->component<LightCulling>()->pointLight(surface, 0));
+	ASSERT_FLOAT_EQ(0.f, surface->data()->get<float>("localPointLights[0].diffuse"));
+}
+
+TEST_F(LightCullingTest, LightsOutOfRangeAreCulled)
+{
+	auto root = Node::create()
+		->addComponent(SceneManager::create(MinkoTests::context()))
+		->addComponent(LightCulling::create());
+	auto nearSurface = createSurface(0.f);
+	auto farSurface = createSurface(100.f);
+	auto light = createPointLight(2.f, 5.f);
+
+	root->addChild(nearSurface)->addChild(farSurface)->addChild(light);
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	auto lightCulling = root->component<LightCulling>();
+
+	ASSERT_EQ(light->component<PointLight>(), lightCulling->pointLight(nearSurface, 0));
+	ASSERT_EQ(nullptr, lightCulling->pointLight(farSurface, 0));
+	ASSERT_EQ(
+		light->component<PointLight>()->worldPosition(),
+		nearSurface->data()->get<math::Vector3::Ptr>("localPointLights[0].position")
+	);
+}
+
+TEST_F(LightCullingTest, MostRelevantLights)
+{
+	auto root = Node::create()
+		->addComponent(SceneManager::create(MinkoTests::context()))
+		->addComponent(LightCulling::create());
+	auto surface = createSurface(0.f);
+	std::vector<Node::Ptr> lights;
+
+	root->addChild(surface);
+	for (uint i = 0; i <= LightCulling::MAX_NUM_POINT_LIGHTS; ++i)
+	{
+		lights.push_back(createPointLight(1.f + (float)i, 10.f));
+		root->addChild(lights.back());
+	}
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	auto lightCulling = root->component<LightCulling>();
+	std::vector<PointLight::Ptr> bound;
+
+	for (uint i = 0; i < LightCulling::MAX_NUM_POINT_LIGHTS; ++i)
+		bound.push_back(lightCulling->pointLight(surface, i));
+
+	// the farthest light is the one left out
+	ASSERT_EQ(bound.end(), std::find(bound.begin(), bound.end(), lights.back()->component<PointLight>()));
+	ASSERT_NE(bound.end(), std::find(bound.begin(), bound.end(), lights.front()->component<PointLight>()));
+
+	// moving the closest light away only replaces it in its own slot
+	auto slot = std::find(bound.begin(), bound.end(), lights.front()->component<PointLight>()) - bound.begin();
+
+	lights.front()->component<Transform>()->matrix()->appendTranslation(50.f, 0.f, 0.f);
+	root->component<SceneManager>()->nextFrame(1.f, 1.f);
+
+	ASSERT_EQ(lights.back()->component<PointLight>(), lightCulling->pointLight(surface, slot));
+	for (uint i = 0; i < LightCulling::MAX_NUM_POINT_LIGHTS; ++i)
+		if (i != slot)
+			ASSERT_EQ(bound[i], lightCulling->pointLight(surface, i));
+}
@@ -0,0 +1,157 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "LightPackingTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::scene;
+
+TEST_F(LightPackingTest, EmptyArraysWithoutLights)
+{
+	auto root = Node::create()
+		->addComponent(SceneManager::create(MinkoTests::context()))
+		->addComponent(LightPacking::create());
+
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	auto directional = root->data()->get<data::UniformArrayPtr<float>>("packedLights.directional");
+
+	ASSERT_EQ(0u, directional->first);
+	ASSERT_EQ(nullptr, directional->second);
+}
+
+TEST_F(LightPackingTest, PackDirectionalLights)
+{
+	auto root = Node::create()
+		->addComponent(SceneManager::create(MinkoTests::context()))
+		->addComponent(LightPacking::create());
+	auto light = DirectionalLight::create(.5f, .25f);
+
+	light->color(math::Vector3::create(1.f, 0.f, 0.f));
+	root->addChild(Node::create()->addComponent(light));
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	auto directional	= root->data()->get<data::UniformArrayPtr<float>>("packedLights.directional");
+	auto direction		= light->worldDirection();
+
+	ASSERT_EQ(LightPacking::DIRECTIONAL_LIGHT_SIZE, directional->first);
+	ASSERT_FLOAT_EQ(1.f, directional->second[0]);
+	ASSERT_FLOAT_EQ(0.f, directional->second[1]);
+	ASSERT_FLOAT_EQ(0.f, directional->second[2]);
+	ASSERT_FLOAT_EQ(.5f, directional->second[3]);
+	ASSERT_FLOAT_EQ(direction->x(), directional->second[4]);
+	ASSERT_FLOAT_EQ(direction->y(), directional->second[5]);
+	ASSERT_FLOAT_EQ(direction->z(), directional->second[6]);
+	ASSERT_FLOAT_EQ(.25f, directional->second[7]);
+}
+
+TEST_F(LightPackingTest, PackPointLightsAtTheirArrayIndex)
+{
+	auto root = Node::create()
+		->addComponent(SceneManager::create(MinkoTests::context()))
+		->addComponent(LightPacking::create());
+	auto light0 = PointLight::create(1.f, 1.f, 1.f, 0.f, 0.f);
+	auto light1 = PointLight::create(.5f, 1.f, 2.f, 0.f, 0.f);
+
+	root->addChild(Node::create()
+		->addComponent(Transform::create(math::Matrix4x4::create()->appendTranslation(1.f, 2.f, 3.f)))
+		->addComponent(light0)
+	);
+	root->addChild(Node::create()->addComponent(light1));
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	auto point = root->data()->get<data::UniformArrayPtr<float>>("packedLights.point");
+
+	ASSERT_EQ(2 * LightPacking::POINT_LIGHT_SIZE, point->first);
+
+	auto values0 = point->second + light0->arrayIndex() * LightPacking::POINT_LIGHT_SIZE * 4;
+	auto values1 = point->second + light1->arrayIndex() * LightPacking::POINT_LIGHT_SIZE * 4;
+
+	ASSERT_FLOAT_EQ(1.f, values0[4]);
+	ASSERT_FLOAT_EQ(2.f, values0[5]);
+	ASSERT_FLOAT_EQ(3.f, values0[6]);
+	ASSERT_FLOAT_EQ(1.f, values0[8]);
+	ASSERT_FLOAT_EQ(.5f, values1[3]);
+	ASSERT_FLOAT_EQ(2.f, values1[8]);
+}
+
+TEST_F(LightPackingTest, RemovedLightsAreUnpacked)
+{
+	auto root = Node::create()
+		->addComponent(SceneManager::create(MinkoTests::context()))
+		->addComponent(LightPacking::create());
+	auto lights = Node::create()
+		->addComponent(AmbientLight::create(.5f))
+		->addComponent(SpotLight::create());
+
+	root->addChild(lights);
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(LightPacking::AMBIENT_LIGHT_SIZE, root->data()->get<data::UniformArrayPtr<float>>("packedLights.ambient")->first);
+	ASSERT_EQ(LightPacking::SPOT_LIGHT_SIZE, root->data()->get<data::UniformArrayPtr<float>>("packedLights.spot")->first);
+
+	root->removeChild(lights);
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(0u, root->data()->get<data::UniformArrayPtr<float>>("packedLights.ambient")->first);
+	ASSERT_EQ(0u, root->data()->get<data::UniformArrayPtr<float>>("packedLights.spot")->first);
+}
+
+TEST_F(LightPackingTest, DisabledLightsKeepTheirSlot)
+{
+	auto root = Node::create()
+		->addComponent(SceneManager::create(MinkoTests::context()))
+		->addComponent(LightPacking::create());
+	auto light0 = DirectionalLight::create();
+	auto light1 = DirectionalLight::create();
+	auto numLightsChanged = 0;
+
+	root->addChild(Node::create()->addComponent(light0));
+	root->addChild(Node::create()->addComponent(light1));
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	auto _ = root->data()->propertyValueChanged("directionalLights.length")->connect(
+		[&](data::Container::Ptr, const std::string&)
+		{
+			++numLightsChanged;
+		}
+	);
+
+	light0->enabled(false);
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	auto directional = root->data()->get<data::UniformArrayPtr<float>>("packedLights.directional");
+
+	ASSERT_EQ(0, numLightsChanged);
+	ASSERT_EQ(0u, light0->arrayIndex());
+	ASSERT_EQ(1u, light1->arrayIndex());
+	ASSERT_EQ(2 * LightPacking::DIRECTIONAL_LIGHT_SIZE, directional->first);
+	ASSERT_FLOAT_EQ(0.f, directional->second[0]);
+	ASSERT_FLOAT_EQ(1.f, directional->second[LightPacking::DIRECTIONAL_LIGHT_SIZE * 4]);
+
+	light0->enabled(true);
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(0, numLightsChanged);
+	ASSERT_FLOAT_EQ(1.f, directional->second[0]);
+}
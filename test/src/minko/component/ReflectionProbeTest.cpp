@@ -0,0 +1,121 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "ReflectionProbeTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::scene;
+
+static
+Node::Ptr
+createScene(render::Effect::Ptr effect, Node::Ptr& probe)
+{
+	auto root = Node::create()
+		->addComponent(SceneManager::create(MinkoTests::context()));
+
+	probe = Node::create()
+		->addComponent(Transform::create())
+		->addComponent(ReflectionProbe::create(MinkoTests::context(), 64));
+
+	root
+		->addChild(probe)
+		->addChild(Node::create()
+			->addComponent(Transform::create(math::Matrix4x4::create()->appendTranslation(0.f, 0.f, -5.f)))
+			->addComponent(Surface::create(
+				geometry::CubeGeometry::create(MinkoTests::context()),
+				material::Material::create(),
+				effect
+			))
+		);
+
+	return root;
+}
+
+TEST_F(ReflectionProbeTest, InvalidArguments)
+{
+	ASSERT_THROW(ReflectionProbe::create(MinkoTests::context(), 0), std::invalid_argument);
+	ASSERT_THROW(ReflectionProbe::create(MinkoTests::context(), 100), std::invalid_argument);
+	ASSERT_THROW(ReflectionProbe::create(MinkoTests::context())->numFacesPerUpdate(7), std::invalid_argument);
+}
+
+TEST_F(ReflectionProbeTest, StaticProbeIsRenderedOnce)
+{
+	std::vector<render::Pass::Ptr> passes;
+	Node::Ptr probe;
+	auto root = createScene(render::Effect::create(passes), probe);
+	auto reflectionProbe = probe->component<ReflectionProbe>()->dynamic(false);
+
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(6u, reflectionProbe->numRenderedFaces());
+
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(0u, reflectionProbe->numRenderedFaces());
+
+	probe->component<Transform>()->matrix()->appendTranslation(1.f, 0.f, 0.f);
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(6u, reflectionProbe->numRenderedFaces());
+}
+
+TEST_F(ReflectionProbeTest, DynamicProbeUpdatesFewFacesPerFrame)
+{
+	std::vector<render::Pass::Ptr> passes;
+	Node::Ptr probe;
+	auto root = createScene(render::Effect::create(passes), probe);
+	auto reflectionProbe = probe->component<ReflectionProbe>()->numFacesPerUpdate(2);
+
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(6u, reflectionProbe->numRenderedFaces());
+
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(2u, reflectionProbe->numRenderedFaces());
+}
+
+TEST_F(ReflectionProbeTest, FarProbeIsUpdatedLessOften)
+{
+	std::vector<render::Pass::Ptr> passes;
+	Node::Ptr probe;
+	auto root = createScene(render::Effect::create(passes), probe);
+	auto camera = Node::create()
+		->addComponent(Transform::create(math::Matrix4x4::create()->appendTranslation(40.f, 0.f, 0.f)))
+		->addComponent(PerspectiveCamera::create(1.f, .785f, .1f, 1000.f));
+	auto reflectionProbe = probe->component<ReflectionProbe>()->camera(camera)->updateDistance(10.f);
+
+	root->addChild(camera);
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	auto numRenderedFaces = 0u;
+
+	// a quarter of the updates at four times the update distance
+	for (uint frameId = 0; frameId < 8; ++frameId)
+	{
+		root->component<SceneManager>()->nextFrame(0.f, 0.f);
+		numRenderedFaces += reflectionProbe->numRenderedFaces();
+	}
+
+	ASSERT_EQ(2u, numRenderedFaces);
+}
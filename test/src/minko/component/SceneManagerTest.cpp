@@ -0,0 +1,107 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SceneManagerTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::scene;
+
+static
+Node::Ptr
+createCube(Node::Ptr root, float z, uint layouts = 1)
+{
+	std::vector<render::Pass::Ptr> passes;
+
+	auto node = Node::create()
+		->addComponent(Transform::create(math::Matrix4x4::create()->appendTranslation(0.f, 0.f, z)))
+		->addComponent(Surface::create(
+			geometry::CubeGeometry::create(MinkoTests::context()),
+			material::Material::create(),
+			render::Effect::create(passes)
+		))
+		->addComponent(BoundingBox::create());
+
+	node->layouts(layouts);
+	root->addChild(node);
+	node->component<Transform>()->modelToWorldMatrix(true);
+	root->component<SceneManager>()->octTree()->insert(node);
+
+	return node;
+}
+
+TEST_F(SceneManagerTest, RaycastClosestHits)
+{
+	auto root = Node::create()->addComponent(SceneManager::create(MinkoTests::context()));
+	auto far = createCube(root, -15.f);
+	auto near = createCube(root, -5.f);
+	auto middle = createCube(root, -10.f);
+	auto ray = math::Ray::create(math::Vector3::create(0.f, 0.f, 0.f), math::Vector3::create(0.f, 0.f, -1.f));
+	std::vector<SceneManager::RaycastHit> hits;
+
+	ASSERT_EQ(1u, root->component<SceneManager>()->raycast(ray, hits));
+	ASSERT_EQ(near, hits[0].first);
+	ASSERT_NEAR(4.5f, hits[0].second, 1e-4f);
+
+	ASSERT_EQ(3u, root->component<SceneManager>()->raycast(ray, hits, 0xffffffff, 10));
+	ASSERT_EQ(near, hits[0].first);
+	ASSERT_EQ(middle, hits[1].first);
+	ASSERT_EQ(far, hits[2].first);
+}
+
+TEST_F(SceneManagerTest, RaycastLayoutMask)
+{
+	auto root = Node::create()->addComponent(SceneManager::create(MinkoTests::context()));
+	auto near = createCube(root, -5.f, 1u);
+	auto far = createCube(root, -10.f, 2u);
+	auto ray = math::Ray::create(math::Vector3::create(0.f, 0.f, 0.f), math::Vector3::create(0.f, 0.f, -1.f));
+	std::vector<SceneManager::RaycastHit> hits;
+
+	ASSERT_EQ(1u, root->component<SceneManager>()->raycast(ray, hits, 2u));
+	ASSERT_EQ(far, hits[0].first);
+
+	ray->direction()->setTo(0.f, 1.f, 0.f);
+	ASSERT_EQ(0u, root->component<SceneManager>()->raycast(ray, hits));
+}
+
+TEST_F(SceneManagerTest, ThrottledAnimationUpdates)
+{
+	auto root = Node::create()->addComponent(SceneManager::create(MinkoTests::context()));
+	auto sceneManager = root->component<SceneManager>();
+	auto animation = Animation::create(std::vector<animation::AbstractTimeline::Ptr>());
+
+	root->addChild(Node::create()->addComponent(animation));
+	animation->lod(0.5f, 100);
+	animation->screenSize(0.1f);
+
+	sceneManager->nextFrame(50.f, 50.f);
+	ASSERT_EQ(0u, sceneManager->numAnimationUpdates());
+	ASSERT_EQ(1u, sceneManager->numSkippedAnimationUpdates());
+
+	sceneManager->nextFrame(100.f, 50.f);
+	ASSERT_EQ(1u, sceneManager->numAnimationUpdates());
+	ASSERT_EQ(0u, sceneManager->numSkippedAnimationUpdates());
+
+	animation->screenSize(1.f);
+	sceneManager->nextFrame(110.f, 10.f);
+	ASSERT_EQ(1u, sceneManager->numAnimationUpdates());
+	ASSERT_EQ(0u, sceneManager->numSkippedAnimationUpdates());
+}
@@ -0,0 +1,175 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "ShadowMappingTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::scene;
+
+static
+Node::Ptr
+createCaster(render::Effect::Ptr effect, float x, float z)
+{
+	return Node::create()
+		->addComponent(Transform::create(math::Matrix4x4::create()->appendTranslation(x, 0.f, z)))
+		->addComponent(Surface::create(
+			geometry::CubeGeometry::create(MinkoTests::context()),
+			material::Material::create(),
+			effect
+		));
+}
+
+static
+Node::Ptr
+createScene(render::Effect::Ptr effect, Node::Ptr& camera, Node::Ptr& light)
+{
+	auto root = Node::create()
+		->addComponent(SceneManager::create(MinkoTests::context()));
+
+	camera = Node::create()
+		->addComponent(Transform::create())
+		->addComponent(PerspectiveCamera::create(1.f, .785f, .1f, 1000.f));
+	// lights along -z like the camera looks
+	light = Node::create()
+		->addComponent(Transform::create())
+		->addComponent(DirectionalLight::create())
+		->addComponent(ShadowMapping::create(MinkoTests::context(), effect, 256, 2));
+	light->component<ShadowMapping>()->camera(camera);
+
+	root->addChild(camera)->addChild(light);
+
+	return root;
+}
+
+TEST_F(ShadowMappingTest, NotOnLight)
+{
+	std::vector<render::Pass::Ptr> passes;
+
+	ASSERT_THROW(
+		Node::create()->addComponent(ShadowMapping::create(MinkoTests::context(), render::Effect::create(passes))),
+		std::logic_error
+	);
+}
+
+TEST_F(ShadowMappingTest, MapsAreCachedWhenNothingMoves)
+{
+	std::vector<render::Pass::Ptr> passes;
+	auto effect = render::Effect::create(passes);
+	Node::Ptr camera;
+	Node::Ptr light;
+	auto root = createScene(effect, camera, light);
+	auto shadowMapping = light->component<ShadowMapping>();
+
+	root->addChild(createCaster(effect, 0.f, -10.f));
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(2u, shadowMapping->numMaps());
+	ASSERT_EQ(2u, shadowMapping->numRenderedMaps());
+	ASSERT_EQ(1u, shadowMapping->numCasters(0));
+	ASSERT_EQ(1u, shadowMapping->numCasters(1));
+	ASSERT_TRUE(root->data()->hasProperty("directionalShadows[0].map1"));
+
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(0u, shadowMapping->numRenderedMaps());
+}
+
+TEST_F(ShadowMappingTest, OnlyMapsWithMovingCastersAreRendered)
+{
+	std::vector<render::Pass::Ptr> passes;
+	auto effect = render::Effect::create(passes);
+	Node::Ptr camera;
+	Node::Ptr light;
+	auto root = createScene(effect, camera, light);
+	auto shadowMapping = light->component<ShadowMapping>();
+	auto caster = createCaster(effect, 0.f, -10.f);
+	auto farCaster = createCaster(effect, 1000.f, -10.f);
+
+	root->addChild(caster)->addChild(farCaster);
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(1u, shadowMapping->numCasters(0));
+
+	farCaster->component<Transform>()->matrix()->appendTranslation(100.f, 0.f, 0.f);
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(0u, shadowMapping->numRenderedMaps());
+
+	caster->component<Transform>()->matrix()->appendTranslation(1.f, 0.f, 0.f);
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(2u, shadowMapping->numRenderedMaps());
+}
+
+TEST_F(ShadowMappingTest, SmallCameraMovesKeepTheCascades)
+{
+	std::vector<render::Pass::Ptr> passes;
+	auto effect = render::Effect::create(passes);
+	Node::Ptr camera;
+	Node::Ptr light;
+	auto root = createScene(effect, camera, light);
+	auto shadowMapping = light->component<ShadowMapping>();
+
+	root->addChild(createCaster(effect, 0.f, -10.f));
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	auto viewProjection = math::Matrix4x4::create(shadowMapping->viewProjection(0));
+
+	camera->component<Transform>()->matrix()->appendTranslation(.1f, 0.f, -.1f);
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(0u, shadowMapping->numRenderedMaps());
+	ASSERT_EQ(viewProjection->data(), shadowMapping->viewProjection(0)->data());
+
+	// far enough for the first cascade to move, by a whole number of texels
+	camera->component<Transform>()->matrix()->appendTranslation(50.f, 0.f, 0.f);
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	auto texelSize	= 2.f / (256.f * shadowMapping->viewProjection(0)->data()[0]);
+	auto texels		= -shadowMapping->viewProjection(0)->data()[3] / (shadowMapping->viewProjection(0)->data()[0] * texelSize);
+
+	ASSERT_GE(shadowMapping->numRenderedMaps(), 1u);
+	ASSERT_NEAR(floorf(texels + .5f), texels, .01f);
+}
+
+TEST_F(ShadowMappingTest, SpotLightMap)
+{
+	std::vector<render::Pass::Ptr> passes;
+	auto effect = render::Effect::create(passes);
+	auto root = Node::create()
+		->addComponent(SceneManager::create(MinkoTests::context()));
+	auto light = Node::create()
+		->addComponent(Transform::create())
+		->addComponent(SpotLight::create(.5f, .6f, 1.f, 1.f, 10.f, .5f, 0.f))
+		->addComponent(ShadowMapping::create(MinkoTests::context(), effect, 256));
+
+	root->addChild(light)->addChild(createCaster(effect, 0.f, -5.f))->addChild(createCaster(effect, 100.f, -5.f));
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	auto shadowMapping = light->component<ShadowMapping>();
+
+	ASSERT_EQ(1u, shadowMapping->numMaps());
+	ASSERT_EQ(1u, shadowMapping->numRenderedMaps());
+	ASSERT_EQ(1u, shadowMapping->numCasters(0));
+	ASSERT_TRUE(root->data()->hasProperty("spotShadows[0].map"));
+}
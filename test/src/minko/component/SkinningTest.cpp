@@ -0,0 +1,119 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SkinningTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+#include "minko/component/Skinning.hpp"
+#include "minko/geometry/Skin.hpp"
+#include "minko/geometry/Bone.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::scene;
+
+namespace
+{
+	// a single bone moving all the vertices of the geometry
+	geometry::Skin::Ptr
+	createSkin(geometry::Geometry::Ptr geometry)
+	{
+		const uint numVertices = geometry->vertexBuffer("position")->numVertices();
+		std::vector<uint> vertexIds;
+
+		for (uint i = 0; i < numVertices; ++i)
+			vertexIds.push_back(i);
+
+		auto skin = geometry::Skin::create(1, 1000, 2);
+
+		skin->bone(0, geometry::Bone::create(
+			Node::create(), math::Matrix4x4::create(), vertexIds, std::vector<float>(numVertices, 1.f)
+		));
+		skin->matrix(0, 0, math::Matrix4x4::create());
+		skin->matrix(1, 0, math::Matrix4x4::create()->appendTranslation(1.f, 0.f, 0.f));
+		skin->reorganizeByVertices();
+
+		return skin;
+	}
+}
+
+TEST_F(SkinningTest, HardwareTextureFallback)
+{
+	auto context = MinkoTests::context();
+	auto skin = createSkin(geometry::CubeGeometry::create(context));
+	auto skinning = Skinning::create(skin, SkinningMethod::HARDWARE_TEXTURE, context, std::vector<Animation::Ptr>());
+
+	if (context->supportsFloatTextures())
+		ASSERT_EQ(SkinningMethod::HARDWARE_TEXTURE, skinning->method());
+	else
+		ASSERT_EQ(SkinningMethod::HARDWARE, skinning->method());
+}
+
+TEST_F(SkinningTest, BoneMatricesTextureOnTarget)
+{
+	auto context = MinkoTests::context();
+	auto cube = geometry::CubeGeometry::create(context);
+	auto skinning = Skinning::create(createSkin(cube), SkinningMethod::HARDWARE_TEXTURE, context, std::vector<Animation::Ptr>());
+	std::vector<render::Pass::Ptr> passes;
+	auto root = Node::create("root");
+	auto node = Node::create("skinned")
+		->addComponent(Surface::create(cube, material::Material::create(), render::Effect::create(passes)))
+		->addComponent(skinning);
+
+	root->addChild(node);
+
+	const bool usesTexture = skinning->method() == SkinningMethod::HARDWARE_TEXTURE;
+
+	ASSERT_TRUE(cube->data()->hasProperty(Skinning::PNAME_NUM_BONES));
+	ASSERT_EQ(usesTexture, cube->data()->hasProperty(Skinning::PNAME_BONE_MATRICES_TEXTURE));
+	ASSERT_EQ(!usesTexture, cube->data()->hasProperty(Skinning::PNAME_BONE_MATRICES));
+
+	root->removeChild(node);
+
+	ASSERT_FALSE(cube->data()->hasProperty(Skinning::PNAME_NUM_BONES));
+	ASSERT_FALSE(cube->data()->hasProperty(Skinning::PNAME_BONE_MATRICES_TEXTURE));
+	ASSERT_FALSE(cube->data()->hasProperty(Skinning::PNAME_BONE_MATRICES));
+}
+
+TEST_F(SkinningTest, TooManyVertexBonesFallBackToSoftware)
+{
+	auto context = MinkoTests::context();
+	auto cube = geometry::CubeGeometry::create(context);
+	const uint numVertices = cube->vertexBuffer("position")->numVertices();
+	const uint numBones = Skinning::MAX_NUM_BONES_PER_VERTEX + 1;
+	std::vector<uint> vertexIds;
+
+	for (uint i = 0; i < numVertices; ++i)
+		vertexIds.push_back(i);
+
+	auto skin = geometry::Skin::create(numBones, 1000, 1);
+
+	for (uint boneId = 0; boneId < numBones; ++boneId)
+	{
+		skin->bone(boneId, geometry::Bone::create(
+			Node::create(), math::Matrix4x4::create(), vertexIds, std::vector<float>(numVertices, 1.f / numBones)
+		));
+		skin->matrix(0, boneId, math::Matrix4x4::create());
+	}
+	skin->reorganizeByVertices();
+
+	auto skinning = Skinning::create(skin, SkinningMethod::HARDWARE_TEXTURE, context, std::vector<Animation::Ptr>());
+
+	ASSERT_EQ(SkinningMethod::SOFTWARE, skinning->method());
+}
@@ -0,0 +1,105 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "StaticBatcherTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::scene;
+
+static
+Node::Ptr
+createStaticCube(material::Material::Ptr material, render::Effect::Ptr effect, float x)
+{
+	auto node = Node::create()
+		->addComponent(Transform::create())
+		->addComponent(Surface::create(
+			geometry::CubeGeometry::create(MinkoTests::context()),
+			material,
+			effect
+		));
+
+	node->component<Transform>()->matrix()->appendTranslation(x, 0.f, 0.f);
+	node->component<Transform>()->isStatic(true);
+
+	return node;
+}
+
+TEST_F(StaticBatcherTest, MergeStaticSurfaces)
+{
+	std::vector<render::Pass::Ptr> passes;
+	auto effect = render::Effect::create(passes);
+	auto material = material::Material::create();
+	auto root = Node::create("root");
+
+	root->addChild(createStaticCube(material, effect, -1.f));
+	root->addChild(createStaticCube(material, effect, 1.f));
+
+	auto numIndices = 2 * geometry::CubeGeometry::create(MinkoTests::context())->indices()->data().size();
+
+	root->addComponent(StaticBatcher::create());
+
+	auto surfaces = NodeSet::create(root)->descendants(true)->where([](Node::Ptr n)
+	{
+		return n->hasComponent<Surface>();
+	});
+
+	ASSERT_EQ(root->component<StaticBatcher>()->batches().size(), 1);
+	ASSERT_EQ(surfaces->nodes().size(), 1);
+	ASSERT_EQ(surfaces->nodes()[0]->component<Surface>()->geometry()->indices()->data().size(), numIndices);
+}
+
+TEST_F(StaticBatcherTest, IgnoreDynamicSurfaces)
+{
+	std::vector<render::Pass::Ptr> passes;
+	auto effect = render::Effect::create(passes);
+	auto material = material::Material::create();
+	auto root = Node::create("root");
+	auto dynamicCube = createStaticCube(material, effect, 1.f);
+
+	dynamicCube->component<Transform>()->isStatic(false);
+	root->addChild(createStaticCube(material, effect, -1.f));
+	root->addChild(dynamicCube);
+
+	root->addComponent(StaticBatcher::create());
+
+	ASSERT_TRUE(root->component<StaticBatcher>()->batches().empty());
+	ASSERT_TRUE(dynamicCube->hasComponent<Surface>());
+}
+
+TEST_F(StaticBatcherTest, BakeWorldSpacePositions)
+{
+	std::vector<render::Pass::Ptr> passes;
+	auto effect = render::Effect::create(passes);
+	auto material = material::Material::create();
+	auto root = Node::create("root");
+
+	root->addChild(createStaticCube(material, effect, -10.f));
+	root->addChild(createStaticCube(material, effect, 10.f));
+
+	root->addComponent(StaticBatcher::create());
+
+	auto batch = root->component<StaticBatcher>()->batches().front();
+	auto vertexBuffer = batch->component<Surface>()->geometry()->vertexBuffer("position");
+
+	ASSERT_FLOAT_EQ(vertexBuffer->minPosition()->x(), -10.5f);
+	ASSERT_FLOAT_EQ(vertexBuffer->maxPosition()->x(), 10.5f);
+}
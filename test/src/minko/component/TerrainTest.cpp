@@ -0,0 +1,108 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TerrainTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::scene;
+
+static
+Terrain::Ptr
+createRamp(uint size, uint chunkResolution)
+{
+	std::vector<render::Pass::Ptr> passes;
+	std::vector<float> heights(size * size);
+
+	for (uint z = 0; z < size; ++z)
+		for (uint x = 0; x < size; ++x)
+			heights[z * size + x] = float(x);
+
+	return Terrain::create(
+		MinkoTests::context(), heights, size, size, 2.f, render::Effect::create(passes), nullptr, chunkResolution
+	);
+}
+
+TEST_F(TerrainTest, InvalidSize)
+{
+	std::vector<render::Pass::Ptr> passes;
+	std::vector<float> heights(60 * 60, 0.f);
+
+	ASSERT_THROW(
+		Terrain::create(MinkoTests::context(), heights, 60, 60, 1.f, render::Effect::create(passes), nullptr, 16),
+		std::invalid_argument
+	);
+}
+
+TEST_F(TerrainTest, Heights)
+{
+	auto terrain = createRamp(65, 16);
+
+	ASSERT_EQ(3u, terrain->numLevels());
+	ASSERT_EQ(0.f, terrain->minHeight());
+	ASSERT_EQ(64.f, terrain->maxHeight());
+	ASSERT_FLOAT_EQ(2.5f, terrain->height(5.f, 3.f));
+	ASSERT_FLOAT_EQ(64.f, terrain->height(1000.f, 0.f));
+}
+
+TEST_F(TerrainTest, SelectLevels)
+{
+	auto terrain = createRamp(65, 16);
+	auto root = Node::create("root")->addComponent(Transform::create());
+
+	terrain->lodDistance(10.f);
+	root->addComponent(terrain);
+
+	terrain->update(math::Vector3::create(10000.f, 0.f, 10000.f));
+
+	ASSERT_EQ(1u, terrain->numChunks());
+	ASSERT_EQ(2u, terrain->chunkLevel(0));
+	ASSERT_EQ(1u, root->children().size());
+
+	terrain->update(math::Vector3::create(0.f, 0.f, 0.f));
+
+	uint numFinestChunks = 0;
+
+	for (uint i = 0; i < terrain->numChunks(); ++i)
+		if (terrain->chunkLevel(i) == 0)
+			++numFinestChunks;
+
+	ASSERT_TRUE(terrain->numChunks() > 1u);
+	ASSERT_TRUE(numFinestChunks > 0u);
+	ASSERT_EQ(terrain->numChunks(), root->children().size());
+
+	terrain->update(math::Vector3::create(10000.f, 0.f, 10000.f));
+
+	ASSERT_EQ(1u, root->children().size());
+}
+
+TEST_F(TerrainTest, RemoveChunksWithTarget)
+{
+	auto terrain = createRamp(33, 16);
+	auto root = Node::create("root")->addComponent(Transform::create());
+
+	root->addComponent(terrain);
+	terrain->update(math::Vector3::create(0.f, 0.f, 0.f));
+	root->removeComponent(terrain);
+
+	ASSERT_EQ(0u, root->children().size());
+	ASSERT_EQ(0u, terrain->numChunks());
+}
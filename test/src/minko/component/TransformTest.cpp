@@ -182,3 +182,150 @@ TEST_F(TransformTest, ModelToWorldMultipleUpdatesMultipleFrames)
 	ASSERT_TRUE(updated1);
 	ASSERT_TRUE(updated2);
 }
+
+TEST_F(TransformTest, ModelToWorldAfterReparenting)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::context());
+	auto root = Node::create()->addComponent(sceneManager);
+	auto n1 = Node::create()->addComponent(Transform::create());
+	auto n2 = Node::create()->addComponent(Transform::create());
+	auto n3 = Node::create();
+	auto n4 = Node::create()->addComponent(Transform::create());
+
+	root->addChild(n1)->addChild(n2);
+	n2->addChild(n3);
+	n3->addChild(n4);
+	n1->component<Transform>()->matrix()->appendTranslation(1.f);
+	n2->component<Transform>()->matrix()->appendTranslation(0.f, 2.f);
+
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	ASSERT_FLOAT_EQ(n4->component<Transform>()->modelToWorldMatrix()->translation()->y(), 2.f);
+
+	n2->removeChild(n3);
+	n1->addChild(n3);
+
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	ASSERT_FLOAT_EQ(n4->component<Transform>()->modelToWorldMatrix()->translation()->x(), 1.f);
+	ASSERT_FLOAT_EQ(n4->component<Transform>()->modelToWorldMatrix()->translation()->y(), 0.f);
+
+	n3->addComponent(Transform::create());
+	n3->component<Transform>()->matrix()->appendTranslation(0.f, 0.f, 3.f);
+
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	ASSERT_FLOAT_EQ(n4->component<Transform>()->modelToWorldMatrix()->translation()->x(), 1.f);
+	ASSERT_FLOAT_EQ(n4->component<Transform>()->modelToWorldMatrix()->translation()->z(), 3.f);
+}
+
+TEST_F(TransformTest, ModelToWorldAfterManyRemovals)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::context());
+	auto root = Node::create()->addComponent(sceneManager);
+	auto parent = Node::create()->addComponent(Transform::create());
+	std::vector<Node::Ptr> nodes;
+
+	root->addChild(parent);
+	for (auto i = 0; i < 20; ++i)
+	{
+		auto n = Node::create()->addComponent(Transform::create());
+
+		n->component<Transform>()->matrix()->appendTranslation((float)i);
+		parent->addChild(n);
+		nodes.push_back(n);
+	}
+
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	for (auto i = 0; i < 15; ++i)
+		parent->removeChild(nodes[i]);
+	parent->component<Transform>()->matrix()->appendTranslation(0.f, 1.f);
+
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	for (auto i = 15; i < 20; ++i)
+	{
+		auto translation = nodes[i]->component<Transform>()->modelToWorldMatrix()->translation();
+
+		ASSERT_FLOAT_EQ(translation->x(), (float)i);
+		ASSERT_FLOAT_EQ(translation->y(), 1.f);
+	}
+}
+
+TEST_F(TransformTest, ModelToWorldParallelUpdate)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::context());
+	auto root = Node::create()->addComponent(sceneManager)->addComponent(Transform::create());
+	std::vector<Node::Ptr> leaves;
+
+	for (auto i = 0; i < 64; ++i)
+	{
+		auto group = Node::create()->addComponent(Transform::create());
+
+		group->component<Transform>()->matrix()->appendTranslation((float)i);
+		root->addChild(group);
+
+		for (auto j = 0; j < 64; ++j)
+		{
+			auto leaf = Node::create()->addComponent(Transform::create());
+
+			leaf->component<Transform>()->matrix()->appendTranslation(0.f, (float)j);
+			group->addChild(leaf);
+			leaves.push_back(leaf);
+		}
+	}
+
+	ASSERT_TRUE(leaves.size() >= Transform::RootTransform::PARALLEL_UPDATE_MIN_NUM_NODES);
+
+	sceneManager->nextFrame(0.0f, 0.0f);
+	root->component<Transform>()->matrix()->appendTranslation(0.f, 0.f, 1.f);
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	for (auto i = 0; i < 64; ++i)
+		for (auto j = 0; j < 64; ++j)
+		{
+			auto translation = leaves[i * 64 + j]->component<Transform>()->modelToWorldMatrix()->translation();
+
+			ASSERT_FLOAT_EQ(translation->x(), (float)i);
+			ASSERT_FLOAT_EQ(translation->y(), (float)j);
+			ASSERT_FLOAT_EQ(translation->z(), 1.f);
+		}
+}
+
+TEST_F(TransformTest, ModelToWorldChangedBatch)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::context());
+	auto root = Node::create()->addComponent(sceneManager);
+	auto n1 = Node::create()->addComponent(Transform::create());
+	auto n2 = Node::create()->addComponent(Transform::create());
+	auto n3 = Node::create()->addComponent(Transform::create());
+
+	root->addChild(n1)->addChild(n3);
+	n1->addChild(n2);
+
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	auto numBatches = 0;
+	std::vector<Node::Ptr> changedNodes;
+	auto _ = root->component<Transform::RootTransform>()->modelToWorldChanged()->connect(
+		[&](Transform::RootTransform::Ptr rootTransform, const std::vector<Node::Ptr>& nodes)
+		{
+			++numBatches;
+			changedNodes = nodes;
+		}
+	);
+
+	n1->component<Transform>()->matrix()->appendTranslation(1.f);
+
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	ASSERT_EQ(numBatches, 1);
+	ASSERT_EQ(changedNodes.size(), 2u);
+	ASSERT_EQ(changedNodes[0], n1);
+	ASSERT_EQ(changedNodes[1], n2);
+
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	ASSERT_EQ(numBatches, 1);
+}
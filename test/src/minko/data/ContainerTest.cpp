@@ -259,3 +259,102 @@ TEST_F(ContainerTest, ArrayRemoveBack)
 	ASSERT_EQ(array1->index(), 0);
 	ASSERT_EQ(array2->index(), 1);
 }
+
+TEST_F(ContainerTest, ArrayRemoveOnlyMovesLast)
+{
+	std::vector<ArrayProvider::Ptr> arrays;
+	auto c = Container::create();
+	auto numIndexChanges = 0;
+	std::vector<minko::Signal<ArrayProvider::Ptr, uint>::Slot> slots;
+
+	for (uint i = 0; i < 5; ++i)
+	{
+		arrays.push_back(ArrayProvider::create("array"));
+		c->addProvider(arrays.back());
+		slots.push_back(arrays.back()->indexChanged()->connect([&](ArrayProvider::Ptr, uint)
+		{
+			++numIndexChanges;
+		}));
+	}
+
+	c->removeProvider(arrays[1]);
+
+	ASSERT_EQ(1, numIndexChanges);
+	ASSERT_EQ(0u, arrays[0]->index());
+	ASSERT_EQ(1u, arrays[4]->index());
+	ASSERT_EQ(2u, arrays[2]->index());
+	ASSERT_EQ(3u, arrays[3]->index());
+	ASSERT_EQ(4, c->get<int>("array.length"));
+
+	c->removeProvider(arrays[4]);
+	c->removeProvider(arrays[3]);
+	c->removeProvider(arrays[0]);
+	c->removeProvider(arrays[2]);
+
+	ASSERT_FALSE(c->hasProperty("array.length"));
+
+	c->addProvider(arrays[1]);
+
+	ASSERT_EQ(0u, arrays[1]->index());
+}
+
+TEST_F(ContainerTest, ArrayGetByIdAfterRemove)
+{
+	auto array1 = ArrayProvider::create("array");
+	auto array2 = ArrayProvider::create("array");
+	auto c = Container::create();
+
+	array1->set("foo", 1);
+	array2->set("foo", 2);
+
+	c->addProvider(array1);
+	c->addProvider(array2);
+	c->removeProvider(array1);
+
+	auto id = PropertyName::id("array[0].foo");
+
+	ASSERT_TRUE(c->hasProperty(id));
+	ASSERT_EQ(c->get<int>(id), 2);
+	ASSERT_FALSE(c->hasProperty(PropertyName::id("array[1].foo")));
+}
+
+TEST_F(ContainerTest, DeferChanges)
+{
+	auto c = Container::create();
+	auto p = Provider::create();
+	int numCalls = 0;
+	int v = 0;
+
+	p->set("foo", 0);
+	c->addProvider(p);
+
+	auto _ = c->propertyValueChanged("foo")->connect(
+		[&](Container::Ptr container, const std::string& propertyName)
+		{
+			++numCalls;
+			v = container->get<int>("foo");
+		}
+	);
+
+	c->deferChanges(true);
+
+	for (int i = 1; i <= 10; ++i)
+		p->set("foo", i);
+
+	ASSERT_EQ(numCalls, 0);
+
+	Container::flushAllChanges();
+
+	ASSERT_EQ(numCalls, 1);
+	ASSERT_EQ(v, 10);
+
+	p->set("foo", 42);
+	c->deferChanges(false);
+
+	ASSERT_EQ(numCalls, 2);
+	ASSERT_EQ(v, 42);
+
+	p->set("foo", 24);
+
+	ASSERT_EQ(numCalls, 3);
+}
@@ -177,3 +177,45 @@ TEST_F(ProviderTest, Swap)
 	ASSERT_EQ(vFoo, 24);
 	ASSERT_EQ(vBar, 42);
 }
+
+TEST_F(ProviderTest, GetById)
+{
+	auto p	= Provider::create();
+	auto id	= PropertyName::id("foo");
+
+	ASSERT_FALSE(p->hasProperty(id));
+
+	p->set("foo", 42);
+
+	ASSERT_EQ(PropertyName::id("foo"), id);
+	ASSERT_EQ(PropertyName::name(id), "foo");
+	ASSERT_TRUE(p->hasProperty(id));
+	ASSERT_EQ(p->get<int>(id), 42);
+
+	p->set("foo", 24);
+
+	ASSERT_EQ(p->get<int>(id), 24);
+
+	p->unset("foo");
+
+	ASSERT_FALSE(p->hasProperty(id));
+}
+
+TEST_F(ProviderTest, SetSameTypeInPlace)
+{
+	auto p = Provider::create();
+
+	p->set("foo", 42);
+
+	auto held = Any::cast<int>(&p->values().at("foo"));
+
+	p->set("foo", 24);
+
+	ASSERT_EQ(Any::cast<int>(&p->values().at("foo")), held);
+	ASSERT_EQ(p->get<int>("foo"), 24);
+
+	p->set("foo", 1.f);
+
+	ASSERT_EQ(p->get<float>("foo"), 1.f);
+	ASSERT_EQ(p->get<float>(PropertyName::id("foo")), 1.f);
+}
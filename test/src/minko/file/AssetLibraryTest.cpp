@@ -0,0 +1,244 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "AssetLibraryTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::file;
+
+namespace
+{
+	// completes when the test says so
+	class ManualLoader :
+		public AbstractLoader
+	{
+	public:
+		typedef std::shared_ptr<ManualLoader>	Ptr;
+
+		static std::vector<Ptr>	loading;
+
+		static
+		Ptr
+		create()
+		{
+			return std::shared_ptr<ManualLoader>(new ManualLoader());
+		}
+
+		void
+		load(const std::string& filename, std::shared_ptr<Options> options)
+		{
+			_filename = filename;
+			_options = options;
+			loading.push_back(std::static_pointer_cast<ManualLoader>(shared_from_this()));
+		}
+
+		void
+		finish()
+		{
+			_data.assign(_filename.begin(), _filename.end());
+			_complete->execute(shared_from_this());
+		}
+	};
+
+	std::vector<ManualLoader::Ptr> ManualLoader::loading;
+
+	Options::Ptr
+	manualOptions()
+	{
+		auto options = Options::create(MinkoTests::context());
+
+		options->loaderFunction([](const std::string&, AssetLibrary::Ptr) -> AbstractLoader::Ptr
+		{
+			return ManualLoader::create();
+		});
+
+		return options;
+	}
+}
+
+TEST_F(AssetLibraryTest, FetchDeduplicates)
+{
+	auto assets = AssetLibrary::create(MinkoTests::context());
+	auto options = manualOptions();
+	auto numCompleted = 0;
+
+	ManualLoader::loading.clear();
+
+	assets->fetch("a.glsl", options, [&](AbstractLoader::Ptr) { ++numCompleted; }, nullptr);
+	assets->fetch("a.glsl", options, [&](AbstractLoader::Ptr) { ++numCompleted; }, nullptr);
+
+	ASSERT_EQ(ManualLoader::loading.size(), 1u);
+
+	ManualLoader::loading[0]->finish();
+
+	ASSERT_EQ(numCompleted, 2);
+
+	// already loaded
+	assets->fetch("a.glsl", options, [&](AbstractLoader::Ptr) { ++numCompleted; }, nullptr);
+
+	ASSERT_EQ(ManualLoader::loading.size(), 1u);
+	ASSERT_EQ(numCompleted, 3);
+}
+
+TEST_F(AssetLibraryTest, FetchByPriority)
+{
+	auto assets = AssetLibrary::create(MinkoTests::context());
+	auto low = manualOptions()->loadPriority(0);
+	auto high = manualOptions()->loadPriority(10);
+
+	ManualLoader::loading.clear();
+	assets->maxConcurrentLoads(1);
+
+	assets->fetch("first.png", low, nullptr, nullptr);
+	assets->fetch("low.png", low, nullptr, nullptr);
+	assets->fetch("high.png", high, nullptr, nullptr);
+
+	ASSERT_EQ(ManualLoader::loading.size(), 1u);
+
+	ManualLoader::loading[0]->finish();
+	ASSERT_EQ(ManualLoader::loading.size(), 2u);
+	ASSERT_EQ(ManualLoader::loading[1]->filename(), "high.png");
+
+	ManualLoader::loading[1]->finish();
+	ASSERT_EQ(ManualLoader::loading.size(), 3u);
+	ASSERT_EQ(ManualLoader::loading[2]->filename(), "low.png");
+}
+
+TEST_F(AssetLibraryTest, InternMaterial)
+{
+	auto assets = AssetLibrary::create(MinkoTests::context());
+	auto texture = render::Texture::create(MinkoTests::context(), 32, 32);
+	auto first = material::BasicMaterial::create()->diffuseColor(0xff0000ff)->diffuseMap(texture);
+	auto second = material::BasicMaterial::create()->diffuseMap(texture)->diffuseColor(0xff0000ff);
+	auto other = material::BasicMaterial::create()->diffuseColor(0x00ff00ff)->diffuseMap(texture);
+	auto phong = material::PhongMaterial::create()->diffuseColor(0xff0000ff)->diffuseMap(texture);
+
+	ASSERT_EQ(assets->internMaterial(first), first);
+	ASSERT_EQ(assets->internMaterial(second), first);
+	ASSERT_EQ(assets->internMaterial(other), other);
+	ASSERT_EQ(assets->internMaterial(phong), phong);
+	ASSERT_EQ(assets->numInternedMaterials(), 3u);
+
+	// the key of a modified material is not the one it was interned with anymore
+	first->diffuseColor(0x0000ffff);
+
+	ASSERT_EQ(assets->internMaterial(second), second);
+}
+
+TEST_F(AssetLibraryTest, MemoryReport)
+{
+	auto assets = AssetLibrary::create(MinkoTests::context());
+	auto cube = geometry::CubeGeometry::create(MinkoTests::context());
+	auto texture = render::Texture::create(MinkoTests::context(), 32, 32);
+	std::vector<unsigned char> pixels(32 * 32 * 4, 0);
+	unsigned long long geometryBytes = cube->indices()->data().size() * sizeof(uint);
+
+	for (const auto& vertexBuffer : cube->vertexBuffers())
+		geometryBytes += vertexBuffer->data().size() * sizeof(float);
+
+	texture->data(&pixels[0]);
+	assets
+		->geometry("cube", cube)
+		->geometry("sameCube", cube)
+		->texture("texture", texture)
+		->blob("blob", std::vector<unsigned char>(10, 0));
+
+	auto report = assets->memoryReport();
+
+	ASSERT_EQ(report.geometries, geometryBytes);
+	ASSERT_EQ(report.textures, 32u * 32u * 4u);
+	ASSERT_EQ(report.blobs, 10u);
+	ASSERT_EQ(report.cpu(), geometryBytes + 32u * 32u * 4u + 10u);
+}
+
+TEST_F(AssetLibraryTest, GPUMemory)
+{
+	auto context = MinkoTests::context();
+	const auto textureMemory = context->textureMemory();
+	const auto bufferMemory = context->bufferMemory();
+
+	auto texture = context->createTexture(render::TextureType::Texture2D, 16, 16, false);
+	auto indexBuffer = context->createIndexBuffer(6);
+
+	ASSERT_EQ(context->textureMemory() - textureMemory, 16u * 16u * 4u);
+	ASSERT_EQ(context->bufferMemory() - bufferMemory, 6u * sizeof(unsigned short));
+
+	context->deleteTexture(texture);
+	context->deleteIndexBuffer(indexBuffer);
+
+	ASSERT_EQ(context->textureMemory(), textureMemory);
+	ASSERT_EQ(context->bufferMemory(), bufferMemory);
+}
+
+TEST_F(AssetLibraryTest, UnloadUnused)
+{
+	auto assets = AssetLibrary::create(MinkoTests::context());
+	auto usedCube = geometry::CubeGeometry::create(MinkoTests::context());
+
+	assets
+		->geometry("usedCube", usedCube)
+		->geometry("unusedCube", geometry::CubeGeometry::create(MinkoTests::context()))
+		->texture("unusedTexture", render::Texture::create(MinkoTests::context(), 32, 32));
+
+	ASSERT_EQ(assets->unloadUnused(), 2u);
+	ASSERT_EQ(assets->geometry("usedCube"), usedCube);
+	ASSERT_EQ(assets->geometry("unusedCube"), nullptr);
+	ASSERT_EQ(assets->texture("unusedTexture"), nullptr);
+}
+
+TEST_F(AssetLibraryTest, UnloadUnusedKeepsMaterialTextures)
+{
+	auto assets = AssetLibrary::create(MinkoTests::context());
+	auto texture = render::Texture::create(MinkoTests::context(), 32, 32);
+	auto material = material::BasicMaterial::create()->diffuseMap(texture);
+
+	assets
+		->texture("texture", texture)
+		->material("material", material);
+	texture = nullptr;
+
+	ASSERT_EQ(assets->unloadUnused(), 0u);
+	ASSERT_NE(assets->texture("texture"), nullptr);
+
+	material = nullptr;
+
+	// the texture is only referenced by the unused material
+	ASSERT_EQ(assets->unloadUnused(), 2u);
+	ASSERT_EQ(assets->texture("texture"), nullptr);
+}
+
+TEST_F(AssetLibraryTest, UnloadBundle)
+{
+	auto assets = AssetLibrary::create(MinkoTests::context());
+
+	assets
+		->currentBundle("level1")
+		->geometry("cube", geometry::CubeGeometry::create(MinkoTests::context()))
+		->blob("blob", std::vector<unsigned char>(10, 0))
+		->currentBundle("")
+		->geometry("sharedCube", geometry::CubeGeometry::create(MinkoTests::context()));
+
+	assets->unloadBundle("level1");
+
+	ASSERT_EQ(assets->geometry("cube"), nullptr);
+	ASSERT_NE(assets->geometry("sharedCube"), nullptr);
+	ASSERT_EQ(assets->memoryReport().blobs, 0u);
+}
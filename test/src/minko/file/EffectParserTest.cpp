@@ -0,0 +1,131 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "EffectParserTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+#include <fstream>
+#include <cstdio>
+
+using namespace minko;
+using namespace minko::file;
+
+namespace
+{
+	void
+	writeFile(const std::string& filename, const std::string& content)
+	{
+		std::ofstream file(filename, std::ios::out | std::ios::binary);
+
+		file << content;
+	}
+
+	void
+	writeEffect(const std::string& filename, const std::string& shader)
+	{
+		writeFile(filename,
+			"{\n"
+			"	\"techniques\" : [{\n"
+			"		\"passes\" : [{\n"
+			"			\"vertexShader\" : \"" + shader + "\",\n"
+			"			\"fragmentShader\" : \"" + shader + "\"\n"
+			"		}]\n"
+			"	}]\n"
+			"}\n"
+		);
+	}
+
+	render::Effect::Ptr
+	loadEffect(const std::string& filename)
+	{
+		auto assets = AssetLibrary::create(MinkoTests::context());
+
+		assets->queue(filename)->load();
+
+		return assets->effect(filename);
+	}
+}
+
+TEST_F(EffectParserTest, IncludesAreCached)
+{
+	EffectParser::clearGLSLCache();
+
+	writeFile("EffectParserTest.function.glsl", "float foo() { return 1.0; }\n");
+	writeEffect("EffectParserTest1.effect", "#pragma include('EffectParserTest.function.glsl')\\nvoid main() {}");
+	writeEffect("EffectParserTest2.effect", "#pragma include('EffectParserTest.function.glsl')\\nvoid main() {}");
+
+	auto effect1 = loadEffect("EffectParserTest1.effect");
+
+	ASSERT_TRUE(EffectParser::hasCachedGLSL("EffectParserTest.function.glsl"));
+
+	// the include is not loaded again by another library
+	std::remove("EffectParserTest.function.glsl");
+
+	auto effect2 = loadEffect("EffectParserTest2.effect");
+
+	std::remove("EffectParserTest1.effect");
+	std::remove("EffectParserTest2.effect");
+
+	ASSERT_NE(effect2, nullptr);
+	auto source = effect2->technique("default")[0]->program()->vertexShader()->source();
+	ASSERT_NE(source.find("float foo()"), std::string::npos);
+	ASSERT_NE(source.find("void main()"), std::string::npos);
+}
+
+TEST_F(EffectParserTest, ReloadDependentPasses)
+{
+	EffectParser::clearGLSLCache();
+
+	writeFile("EffectParserTest.function.glsl", "float foo() { return 1.0; }\n");
+	writeEffect("EffectParserTest1.effect", "#pragma include('EffectParserTest.function.glsl')\\nvoid main() {}");
+	writeEffect("EffectParserTest2.effect", "void main() {}");
+
+	auto effect1 = loadEffect("EffectParserTest1.effect");
+	auto effect2 = loadEffect("EffectParserTest2.effect");
+
+	std::remove("EffectParserTest.function.glsl");
+	std::remove("EffectParserTest1.effect");
+	std::remove("EffectParserTest2.effect");
+
+	auto pass1 = effect1->technique("default")[0];
+	auto pass2 = effect2->technique("default")[0];
+	auto program2 = pass2->program();
+	auto numReloads = 0;
+	auto reloaded = pass1->reloaded()->connect([&](render::Pass::Ptr) { ++numReloads; });
+
+	std::string glsl = "float foo() { return 2.0; }\n";
+	auto passes = EffectParser::reloadGLSL(
+		"EffectParserTest.function.glsl",
+		std::vector<unsigned char>(glsl.begin(), glsl.end())
+	);
+
+	ASSERT_EQ(passes, std::vector<render::Pass::Ptr>({ pass1 }));
+	ASSERT_EQ(numReloads, 1);
+	ASSERT_NE(pass1->program()->vertexShader()->source().find("return 2.0;"), std::string::npos);
+	ASSERT_NE(pass1->program()->fragmentShader()->source().find("return 2.0;"), std::string::npos);
+	ASSERT_EQ(pass2->program(), program2);
+}
+
+TEST_F(EffectParserTest, ReloadUnknownFile)
+{
+	EffectParser::clearGLSLCache();
+
+	ASSERT_THROW(EffectParser::reloadGLSL("EffectParserTest.unknown.glsl", std::vector<unsigned char>()), std::invalid_argument);
+}
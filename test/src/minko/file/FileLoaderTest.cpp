@@ -0,0 +1,168 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FileLoaderTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+#include <fstream>
+#include <cstdio>
+
+using namespace minko;
+using namespace minko::file;
+
+namespace
+{
+	class ChunkParser :
+		public AbstractParser
+	{
+	public:
+		static std::vector<uint>	offsets;
+		static uint					numParsedBytes;
+
+		static
+		Ptr
+		create()
+		{
+			return std::shared_ptr<ChunkParser>(new ChunkParser());
+		}
+
+		bool
+		parsesIncrementally() const
+		{
+			return true;
+		}
+
+		void
+		parseChunk(const std::string&					filename,
+				   std::shared_ptr<Options>				options,
+				   const std::vector<unsigned char>&	data,
+				   uint									offset,
+				   uint									size)
+		{
+			offsets.push_back(offset);
+		}
+
+		void
+		parse(const std::string&				filename,
+			  const std::string&				resolvedFilename,
+			  std::shared_ptr<Options>			options,
+			  const std::vector<unsigned char>&	data,
+			  std::shared_ptr<AssetLibrary>		assetLibrary)
+		{
+			numParsedBytes = data.size();
+
+			complete()->execute(shared_from_this());
+		}
+	};
+
+	std::vector<uint> ChunkParser::offsets;
+	uint ChunkParser::numParsedBytes = 0;
+
+	std::string
+	createFile(const std::string& filename, uint size)
+	{
+		std::ofstream file(filename, std::ios::out | std::ios::binary);
+		std::vector<char> data(size, 42);
+
+		file.write(&data[0], size);
+
+		return filename;
+	}
+}
+
+TEST_F(FileLoaderTest, ChunksAndProgress)
+{
+	auto chunkSize = FileLoader::CHUNK_SIZE;
+	auto filename = createFile("FileLoaderTest.bin", chunkSize * 2 + 10);
+	auto loader = FileLoader::create();
+	std::vector<uint> offsets;
+	std::vector<uint> sizes;
+	std::vector<float> ratios;
+
+	auto chunk = loader->chunk()->connect([&](AbstractLoader::Ptr, uint offset, uint size)
+	{
+		offsets.push_back(offset);
+		sizes.push_back(size);
+	});
+	auto progress = loader->progress()->connect([&](AbstractLoader::Ptr, float ratio)
+	{
+		ratios.push_back(ratio);
+	});
+
+	loader->load(filename, Options::create(MinkoTests::context()));
+	std::remove(filename.c_str());
+
+	ASSERT_EQ(loader->data().size(), chunkSize * 2 + 10);
+	ASSERT_EQ(offsets, std::vector<uint>({ 0, chunkSize, chunkSize * 2 }));
+	ASSERT_EQ(sizes, std::vector<uint>({ chunkSize, chunkSize, 10 }));
+	ASSERT_EQ(ratios.size(), 4u);
+	ASSERT_FLOAT_EQ(ratios.front(), 0.f);
+	ASSERT_FLOAT_EQ(ratios.back(), 1.f);
+}
+
+TEST_F(FileLoaderTest, ParseChunks)
+{
+	auto chunkSize = FileLoader::CHUNK_SIZE;
+	auto filename = createFile("FileLoaderTest.chunks", chunkSize + 1);
+	auto assets = AssetLibrary::create(MinkoTests::context());
+
+	ChunkParser::offsets.clear();
+	ChunkParser::numParsedBytes = 0;
+
+	assets->registerParser<ChunkParser>("chunks")->queue(filename)->load();
+	std::remove(filename.c_str());
+
+	ASSERT_EQ(ChunkParser::offsets, std::vector<uint>({ 0, chunkSize }));
+	ASSERT_EQ(ChunkParser::numParsedBytes, chunkSize + 1);
+}
+
+TEST_F(FileLoaderTest, LoadFromArchive)
+{
+	std::map<std::string, std::vector<unsigned char>> files;
+
+	files["texture/packed.bin"] = std::vector<unsigned char>(FileLoader::CHUNK_SIZE + 3, 42);
+	PackedArchive::write("FileLoaderTest.pack", files);
+
+	auto options = Options::create(MinkoTests::context());
+	auto loader = FileLoader::create();
+	std::vector<uint> offsets;
+	auto complete = false;
+
+	options->archives().push_back(PackedArchive::open("FileLoaderTest.pack"));
+	options->includePaths().push_back("texture");
+
+	auto chunk = loader->chunk()->connect([&](AbstractLoader::Ptr, uint offset, uint size)
+	{
+		offsets.push_back(offset);
+	});
+	auto completeSlot = loader->complete()->connect([&](AbstractLoader::Ptr)
+	{
+		complete = true;
+	});
+
+	loader->load("packed.bin", options);
+	options->archives().clear();
+	std::remove("FileLoaderTest.pack");
+
+	ASSERT_TRUE(complete);
+	ASSERT_EQ(loader->resolvedFilename(), "texture/packed.bin");
+	ASSERT_EQ(loader->data().size(), FileLoader::CHUNK_SIZE + 3);
+	ASSERT_EQ(offsets, std::vector<uint>({ 0, FileLoader::CHUNK_SIZE }));
+}
@@ -0,0 +1,144 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "PackedArchiveTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+#include <cstdio>
+
+using namespace minko;
+using namespace minko::file;
+
+namespace
+{
+	std::vector<unsigned char>
+	bytes(const std::string& value)
+	{
+		return std::vector<unsigned char>(value.begin(), value.end());
+	}
+}
+
+TEST_F(PackedArchiveTest, WriteAndRead)
+{
+	std::map<std::string, std::vector<unsigned char>> files;
+
+	files["texture/a.png"] = bytes("first file");
+	files["effect\\b.effect"] = bytes("second");
+	files["empty"] = std::vector<unsigned char>();
+
+	ASSERT_TRUE(PackedArchive::write("PackedArchiveTest.pack", files));
+
+	auto archive = PackedArchive::open("PackedArchiveTest.pack");
+
+	ASSERT_NE(archive, nullptr);
+	ASSERT_EQ(archive->numEntries(), 3u);
+	ASSERT_TRUE(archive->hasEntry("./texture/a.png"));
+	ASSERT_TRUE(archive->hasEntry("effect/b.effect"));
+	ASSERT_FALSE(archive->hasEntry("texture/c.png"));
+
+	std::vector<unsigned char> data;
+
+	ASSERT_TRUE(archive->read("texture/a.png", data));
+	ASSERT_EQ(data, bytes("first file"));
+	ASSERT_TRUE(archive->read("effect/b.effect", data));
+	ASSERT_EQ(data, bytes("second"));
+	ASSERT_TRUE(archive->read("empty", data));
+	ASSERT_TRUE(data.empty());
+
+	archive = nullptr;
+	std::remove("PackedArchiveTest.pack");
+}
+
+TEST_F(PackedArchiveTest, AlignedSlices)
+{
+	std::map<std::string, std::vector<unsigned char>> files;
+
+	files["a"] = bytes("abc");
+	files["b"] = bytes("defgh");
+
+	PackedArchive::write("PackedArchiveTest.pack", files);
+
+	auto archive = PackedArchive::open("PackedArchiveTest.pack");
+	uint size = 0;
+
+	for (const auto& entry : archive->entries())
+		ASSERT_EQ(entry.second.offset % PackedArchive::ALIGNMENT, 0u);
+
+	auto slice = archive->slice("b", size);
+
+	ASSERT_NE(slice, nullptr);
+	ASSERT_EQ(std::string(slice, slice + size), "defgh");
+
+	archive = nullptr;
+	std::remove("PackedArchiveTest.pack");
+}
+
+TEST_F(PackedArchiveTest, CompressedEntries)
+{
+	std::map<std::string, std::vector<unsigned char>> files;
+
+	files["repeated"] = std::vector<unsigned char>(1000, 7);
+	files["short"] = bytes("x");
+
+	// run length encoding of a single repeated byte is enough to exercise the compressed entries
+	PackedArchive::write("PackedArchiveTest.pack", files, [](const std::vector<unsigned char>& input, std::vector<unsigned char>& output)
+	{
+		if (std::count(input.begin(), input.end(), input[0]) != (int)input.size())
+			return false;
+		output.push_back(input[0]);
+
+		return true;
+	});
+
+	auto archive = PackedArchive::open("PackedArchiveTest.pack");
+	std::vector<unsigned char> data;
+	uint size = 0;
+
+	ASSERT_EQ(archive->entries().at("repeated").compression, PackedArchive::Compression::DEFLATE);
+	ASSERT_EQ(archive->entries().at("short").compression, PackedArchive::Compression::NONE);
+	ASSERT_EQ(archive->slice("repeated", size), nullptr);
+	ASSERT_FALSE(archive->read("repeated", data));
+
+	archive->decompressor([](const unsigned char* input, uint size, std::vector<unsigned char>& output)
+	{
+		std::fill(output.begin(), output.end(), input[0]);
+
+		return size == 1;
+	});
+
+	ASSERT_TRUE(archive->read("repeated", data));
+	ASSERT_EQ(data, std::vector<unsigned char>(1000, 7));
+
+	archive = nullptr;
+	std::remove("PackedArchiveTest.pack");
+}
+
+TEST_F(PackedArchiveTest, InvalidArchive)
+{
+	std::ofstream file("PackedArchiveTest.pack", std::ios::out | std::ios::binary);
+
+	file << "not an archive";
+	file.close();
+
+	ASSERT_EQ(PackedArchive::open("PackedArchiveTest.pack"), nullptr);
+	ASSERT_EQ(PackedArchive::open("PackedArchiveTest.missing"), nullptr);
+
+	std::remove("PackedArchiveTest.pack");
+}
@@ -130,3 +130,127 @@ TEST_F(GeometryTest, VertexBufferRemovedFromData)
 
 	ASSERT_FALSE(g->data()->hasProperty("geometry.vertex.attribute.position"));
 }
+
+TEST_F(GeometryTest, RemoveDuplicatedVertices)
+{
+	std::vector<uint> indices = { 0, 1, 2, 2, 3, 0 };
+	std::vector<std::vector<float>> vertices = {
+		{ 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f, 0.f, 1.f, 0.f, 0.f },
+		{ 0.f, 0.f, 1.f, 0.f, 0.f, 1.f, 1.f, 0.f }
+	};
+
+	Geometry::removeDuplicatedVertices(indices, vertices, 4);
+
+	ASSERT_EQ(vertices[0].size(), 9u);
+	ASSERT_EQ(vertices[1].size(), 6u);
+	ASSERT_EQ(indices, std::vector<uint>({ 0, 1, 2, 2, 1, 0 }));
+}
+
+TEST_F(GeometryTest, RemoveDuplicatedVerticesWithEpsilon)
+{
+	std::vector<uint> indices = { 0, 1, 2 };
+	std::vector<std::vector<float>> vertices = { { 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 1.0001f, 0.f, -0.f } };
+	auto exact = vertices;
+	auto exactIndices = indices;
+
+	Geometry::removeDuplicatedVertices(exactIndices, exact, 3);
+	Geometry::removeDuplicatedVertices(indices, vertices, 3, .001f);
+
+	ASSERT_EQ(exact[0].size(), 9u);
+	ASSERT_EQ(vertices[0].size(), 6u);
+	ASSERT_EQ(indices, std::vector<uint>({ 0, 1, 1 }));
+}
+
+static
+Geometry::Ptr
+createGrid(uint size)
+{
+	std::vector<float> vertices;
+	std::vector<uint> indices;
+
+	for (uint y = 0; y <= size; ++y)
+		for (uint x = 0; x <= size; ++x)
+			vertices.insert(vertices.end(), { float(x), float(y), 0.f, float(x) / size, float(y) / size });
+
+	for (uint y = 0; y < size; ++y)
+		for (uint x = 0; x < size; ++x)
+		{
+			uint i = y * (size + 1) + x;
+
+			indices.insert(indices.end(), { i, i + 1, i + size + 1, i + 1, i + size + 2, i + size + 1 });
+		}
+
+	auto geometry = Geometry::create();
+	auto vb = render::VertexBuffer::create(MinkoTests::context(), vertices);
+
+	vb->addAttribute("position", 3, 0);
+	vb->addAttribute("uv", 2, 3);
+	geometry->addVertexBuffer(vb);
+	geometry->indices(render::IndexBuffer::create(MinkoTests::context(), indices));
+
+	return geometry;
+}
+
+TEST_F(GeometryTest, ComputeNormalsInParallel)
+{
+	auto grid = createGrid(200);
+	const uint minNumTriangles = Geometry::PARALLEL_MIN_NUM_TRIANGLES;
+
+	ASSERT_GE(grid->indices()->data().size() / 3, minNumTriangles);
+
+	grid->computeTangentSpace(true);
+
+	auto& normals = grid->vertexBuffer("normal")->data();
+	auto& tangents = grid->vertexBuffer("tangent")->data();
+
+	for (uint i = 0; i < normals.size(); i += 3)
+	{
+		ASSERT_FLOAT_EQ(fabsf(normals[i + 2]), 1.f);
+		ASSERT_FLOAT_EQ(fabsf(tangents[i]), 1.f);
+	}
+}
+
+TEST_F(GeometryTest, TangentSpaceJob)
+{
+	auto grid = createGrid(10);
+	auto job = TangentSpaceJob::create(grid, true, true);
+	auto finished = false;
+
+	auto _ = job->finished()->connect([&](TangentSpaceJob::Ptr job, Geometry::Ptr geometry)
+	{
+		finished = true;
+	});
+
+	job->beforeFirstStep();
+	while (!job->complete())
+		std::this_thread::yield();
+	job->afterLastStep();
+
+	ASSERT_TRUE(finished);
+	ASSERT_TRUE(grid->hasVertexAttribute("normal"));
+	ASSERT_TRUE(grid->hasVertexAttribute("tangent"));
+	ASSERT_EQ(grid->vertexBuffer("normal")->numVertices(), grid->numVertices());
+}
+
+TEST_F(GeometryTest, DisposeDataKeepsCastData)
+{
+	auto grid = createGrid(10);
+	auto vertexBuffer = grid->vertexBuffer("position");
+	auto numVertices = grid->numVertices();
+	auto numIndices = grid->indices()->numIndices();
+	auto ray = math::Ray::create(math::Vector3::create(2.5f, 2.5f, 1.f), math::Vector3::create(0.f, 0.f, -1.f));
+	float distance = 0.f;
+	uint triangle = 0;
+
+	grid->disposeData();
+
+	ASSERT_TRUE(vertexBuffer->data().empty());
+	ASSERT_TRUE(grid->indices()->data().empty());
+	ASSERT_EQ(vertexBuffer->numVertices(), numVertices);
+	ASSERT_EQ(grid->indices()->numIndices(), numIndices);
+	ASSERT_EQ(vertexBuffer->maxPosition()->x(), 10.f);
+	ASSERT_EQ(grid->boundingBox()->topRight()->y(), 10.f);
+	ASSERT_TRUE(grid->cast(ray, distance, triangle, nullptr, math::Vector2::create()));
+	ASSERT_FLOAT_EQ(distance, 1.f);
+	ASSERT_THROW(vertexBuffer->upload(), std::logic_error);
+}
@@ -0,0 +1,95 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "LineGeometryTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::geometry;
+
+TEST_F(LineGeometryTest, LineToSegments)
+{
+	auto lines = LineGeometry::create(MinkoTests::context());
+
+	lines->moveTo(0.f, 0.f, 0.f)->lineTo(4.f, 0.f, 0.f, 4);
+
+	auto vertices = lines->vertexBuffer("startPosition");
+
+	ASSERT_EQ(4u, lines->numLines());
+	ASSERT_EQ(16u, vertices->numVertices());
+	ASSERT_EQ(24u, lines->indices()->numIndices());
+	ASSERT_EQ(3.f, vertices->data()[12 * 9]);
+	ASSERT_EQ(4.f, vertices->data()[12 * 9 + 3]);
+	ASSERT_EQ(4.f, lines->currentXYZ()->x());
+}
+
+TEST_F(LineGeometryTest, BulkLines)
+{
+	auto lines = LineGeometry::create(MinkoTests::context());
+	std::vector<float> points = {
+		0.f, 0.f, 0.f, 1.f, 0.f, 0.f,
+		0.f, 1.f, 0.f, 0.f, 1.f, 1.f
+	};
+
+	lines->lines(points)->lines(points);
+
+	auto& vertexData = lines->vertexBuffer("startPosition")->data();
+	auto& indexData = lines->indices()->data();
+
+	ASSERT_EQ(4u, lines->numLines());
+	ASSERT_EQ(4u * 4 * 9, vertexData.size());
+	ASSERT_EQ(1.f, vertexData[3 * 4 * 9 + 1]);
+	ASSERT_EQ(1.f, vertexData[3 * 4 * 9 + 5]);
+	ASSERT_EQ(12u, indexData[18]);
+	ASSERT_EQ(1.f, lines->currentXYZ()->z());
+}
+
+TEST_F(LineGeometryTest, GrowCapacity)
+{
+	auto lines = LineGeometry::create(MinkoTests::context());
+	std::vector<float> points(6 * 1000, 1.f);
+
+	lines->lines(points);
+
+	const auto capacity = lines->capacity();
+
+	ASSERT_TRUE(capacity >= 1000u);
+
+	lines->lines(&points[0], capacity - 1000);
+
+	ASSERT_EQ(capacity, lines->capacity());
+
+	lines->lines(&points[0], 1);
+
+	ASSERT_EQ(2 * capacity, lines->capacity());
+	ASSERT_EQ(capacity + 1, lines->numLines());
+}
+
+TEST_F(LineGeometryTest, ClearKeepsCapacity)
+{
+	auto lines = LineGeometry::create(MinkoTests::context());
+
+	lines->reserve(5000)->lineTo(1.f, 1.f, 1.f, 10);
+	lines->clear();
+
+	ASSERT_EQ(0u, lines->numLines());
+	ASSERT_EQ(0u, lines->indices()->numIndices());
+	ASSERT_EQ(5000u, lines->capacity());
+}
@@ -0,0 +1,98 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MeshAdjacencyTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::geometry;
+
+TEST_F(MeshAdjacencyTest, Quad)
+{
+	std::vector<uint> indices = { 0, 1, 2, 2, 1, 3 };
+	auto adjacency = MeshAdjacency::create(indices, 4);
+
+	ASSERT_EQ(2u, adjacency->numTriangles());
+	ASSERT_EQ(4u, adjacency->numBoundaryEdges());
+	ASSERT_EQ(0u, adjacency->numNonManifoldEdges());
+	ASSERT_EQ(3, adjacency->opposite(1));
+	ASSERT_EQ(1, adjacency->opposite(3));
+	ASSERT_EQ(1, adjacency->adjacentTriangle(0, 1));
+	ASSERT_EQ(-1, adjacency->adjacentTriangle(0, 0));
+	ASSERT_TRUE(adjacency->isBoundary(0));
+}
+
+TEST_F(MeshAdjacencyTest, WeldSeams)
+{
+	// the second triangle does not share any vertex of the first one but has 2 of their positions
+	std::vector<float> positions = {
+		0.f, 0.f, 0.f,	1.f, 0.f, 0.f,	0.f, 1.f, 0.f,
+		0.f, 1.f, 0.f,	1.f, 0.f, 0.f,	1.f, 1.f, 0.f
+	};
+	std::vector<uint> indices = { 0, 1, 2, 3, 4, 5 };
+
+	auto split = MeshAdjacency::create(indices, 6);
+	auto welded = MeshAdjacency::create(indices, 6, &positions[0], 3);
+
+	ASSERT_EQ(6u, split->numBoundaryEdges());
+	ASSERT_EQ(4u, welded->numBoundaryEdges());
+	ASSERT_EQ(2u, welded->weldedVertex(3));
+	ASSERT_EQ(1u, welded->weldedVertex(4));
+	ASSERT_EQ(1, welded->adjacentTriangle(0, 1));
+}
+
+TEST_F(MeshAdjacencyTest, VertexHalfEdges)
+{
+	// fan of 4 triangles around the vertex 0, open between 1 and 5
+	std::vector<uint> indices = { 0, 1, 2, 0, 2, 3, 0, 3, 4, 0, 4, 5 };
+	auto adjacency = MeshAdjacency::create(indices, 6);
+	std::vector<uint> halfEdges;
+
+	adjacency->vertexHalfEdges(0, halfEdges);
+
+	ASSERT_EQ(4u, halfEdges.size());
+	for (auto halfEdge : halfEdges)
+		ASSERT_EQ(0u, adjacency->startVertex(halfEdge));
+
+	adjacency->vertexHalfEdges(5, halfEdges);
+
+	ASSERT_EQ(1u, halfEdges.size());
+}
+
+TEST_F(MeshAdjacencyTest, ConnectedComponents)
+{
+	std::vector<uint> indices = { 0, 1, 2, 2, 1, 3, 4, 5, 6 };
+	auto adjacency = MeshAdjacency::create(indices, 7);
+	std::vector<uint> components;
+
+	ASSERT_EQ(2u, adjacency->connectedComponents(components));
+	ASSERT_EQ(components[0], components[1]);
+	ASSERT_NE(components[0], components[2]);
+}
+
+TEST_F(MeshAdjacencyTest, ClosedCube)
+{
+	auto cube = CubeGeometry::create(MinkoTests::context());
+	auto adjacency = cube->adjacency();
+
+	ASSERT_EQ(12u, adjacency->numTriangles());
+	ASSERT_EQ(0u, adjacency->numBoundaryEdges());
+	ASSERT_EQ(adjacency, cube->adjacency());
+}
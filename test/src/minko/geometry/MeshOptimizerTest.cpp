@@ -0,0 +1,100 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MeshOptimizerTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::geometry;
+
+TEST_F(MeshOptimizerTest, VertexCacheKeepsTriangles)
+{
+	auto sphere		= SphereGeometry::create(MinkoTests::context(), 20, 20);
+	auto indices	= sphere->indices()->data();
+	auto numVertices = sphere->numVertices();
+
+	MeshOptimizer::optimizeVertexCache(indices, numVertices);
+
+	ASSERT_EQ(indices.size(), sphere->indices()->data().size());
+	ASSERT_LE(
+		MeshOptimizer::averageCacheMissRatio(indices, numVertices),
+		MeshOptimizer::averageCacheMissRatio(sphere->indices()->data(), numVertices)
+	);
+
+	auto before = sphere->indices()->data();
+
+	std::sort(before.begin(), before.end());
+	std::sort(indices.begin(), indices.end());
+
+	ASSERT_EQ(indices, before);
+}
+
+TEST_F(MeshOptimizerTest, VertexFetchOrder)
+{
+	std::vector<uint> indices = { 3, 1, 2, 2, 1, 0 };
+
+	auto remap = MeshOptimizer::optimizeVertexFetch(indices, 5);
+
+	ASSERT_EQ(indices, std::vector<uint>({ 0, 1, 2, 2, 1, 3 }));
+	ASSERT_EQ(remap, std::vector<uint>({ 3, 1, 2, 0, 4 }));
+}
+
+TEST_F(MeshOptimizerTest, InvalidIndices)
+{
+	std::vector<uint> indices = { 0, 1, 3 };
+
+	ASSERT_THROW(MeshOptimizer::optimizeVertexCache(indices, 3), std::invalid_argument);
+}
+
+TEST_F(MeshOptimizerTest, GeometryInterleave)
+{
+	auto sphere = SphereGeometry::create(MinkoTests::context(), 10, 10);
+
+	sphere->computeTangentSpace(false);
+
+	ASSERT_EQ(sphere->vertexBuffers().size(), 2u);
+
+	auto numVertices	= sphere->numVertices();
+	auto tangents		= sphere->vertexBuffer("tangent")->data();
+
+	sphere->interleave();
+
+	auto vb = sphere->vertexBuffer("tangent");
+
+	ASSERT_EQ(sphere->vertexBuffers().size(), 1u);
+	ASSERT_EQ(sphere->numVertices(), numVertices);
+	ASSERT_EQ(vb->vertexSize(), 11u);
+	ASSERT_EQ(std::get<2>(*vb->attribute("tangent")), 8u);
+	ASSERT_EQ(vb->data()[11 + 8], tangents[3]);
+	ASSERT_EQ(sphere->vertexSize(), 11u);
+}
+
+TEST_F(MeshOptimizerTest, GeometryOptimize)
+{
+	auto sphere			= SphereGeometry::create(MinkoTests::context(), 20, 20);
+	auto numTriangles	= sphere->indices()->data().size() / 3;
+
+	sphere->optimize();
+
+	ASSERT_EQ(sphere->indices()->data().size() / 3, numTriangles);
+	ASSERT_LE(sphere->numVertices(), sphere->vertexBuffer("position")->numVertices());
+	for (auto index : sphere->indices()->data())
+		ASSERT_LT(index, sphere->numVertices());
+}
@@ -0,0 +1,121 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "SkinTest.hpp"
+
+#include "minko/geometry/Skin.hpp"
+
+using namespace minko;
+using namespace minko::geometry;
+
+namespace
+{
+	// rotation around z, uniform scale and translation, in the transposed layout used by Skinning
+	std::vector<float>
+	boneMatrix(uint frameId, uint boneId)
+	{
+		const float angle	= frameId * 0.05f * (boneId + 1);
+		const float scale	= 1.0f + 0.01f * frameId;
+		const float c		= cosf(angle) * scale;
+		const float s		= sinf(angle) * scale;
+
+		return {
+			c,				s,		0.0f,	0.0f,
+			-s,				c,		0.0f,	0.0f,
+			0.0f,			0.0f,	scale,	0.0f,
+			0.1f * frameId,	0.5f,	sinf(frameId * 0.2f) * (boneId + 1.0f), 1.0f
+		};
+	}
+}
+
+TEST_F(SkinTest, CompressMatrices)
+{
+	const uint numBones		= 2;
+	const uint numFrames	= 31;
+	const uint duration		= 3000;
+	auto skin = Skin::create(numBones, duration, numFrames);
+
+	for (uint frameId = 0; frameId < numFrames; ++frameId)
+		for (uint boneId = 0; boneId < numBones; ++boneId)
+			skin->matrix(frameId, boneId, math::Matrix4x4::create()->initialize(boneMatrix(frameId, boneId)));
+
+	skin->compressMatrices(1e-3f);
+
+	ASSERT_TRUE(skin->compressed());
+	ASSERT_EQ(numFrames, skin->numFrames());
+
+	std::vector<float> matrices;
+
+	for (uint frameId = 0; frameId < numFrames; ++frameId)
+	{
+		skin->interpolateMatrices(frameId * duration / (numFrames - 1), matrices);
+
+		for (uint boneId = 0; boneId < numBones; ++boneId)
+		{
+			auto expected = boneMatrix(frameId, boneId);
+
+			for (uint i = 0; i < 16; ++i)
+				ASSERT_NEAR(expected[i], matrices[(boneId << 4) + i], 1e-3f);
+		}
+	}
+}
+
+TEST_F(SkinTest, InterpolateUncompressedMatrices)
+{
+	auto skin = Skin::create(1, 1000, 10);
+
+	for (uint frameId = 0; frameId < 10; ++frameId)
+		skin->matrix(frameId, 0, math::Matrix4x4::create()->initialize(boneMatrix(frameId, 0)));
+
+	std::vector<float> matrices;
+
+	skin->interpolateMatrices(500, matrices);
+
+	ASSERT_FALSE(skin->compressed());
+	ASSERT_EQ(skin->matrices(skin->getFrameId(500)), matrices);
+}
+
+TEST_F(SkinTest, InterpolateMatricesAlternatingTimes)
+{
+	const uint numFrames = 31;
+	auto skin = Skin::create(1, 3000, numFrames);
+
+	for (uint frameId = 0; frameId < numFrames; ++frameId)
+		skin->matrix(frameId, 0, math::Matrix4x4::create()->initialize(boneMatrix(frameId, 0)));
+
+	skin->compressMatrices(1e-3f);
+
+	std::vector<float> first;
+	std::vector<float> second;
+	std::vector<float> matrices;
+
+	skin->interpolateMatrices(1000, first);
+	skin->interpolateMatrices(2000, second);
+
+	// instances at different times share the skin without overwriting each other's matrices
+	for (uint i = 0; i < 20; ++i)
+	{
+		skin->interpolateMatrices(i * 100, matrices);
+		skin->interpolateMatrices(1000, matrices);
+		ASSERT_EQ(first, matrices);
+		skin->interpolateMatrices(2000, matrices);
+		ASSERT_EQ(second, matrices);
+	}
+}
@@ -0,0 +1,127 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TriangleBVHTest.hpp"
+
+using namespace minko;
+using namespace minko::geometry;
+
+static
+bool
+bruteForceCast(std::vector<float>&		vertices,
+			   const std::vector<uint>&		indices,
+			   const float*					o,
+			   const float*					d,
+			   float&						distance,
+			   uint&						triangle)
+{
+	auto hit = false;
+
+	distance = std::numeric_limits<float>::max();
+	for (uint i = 0; i < indices.size(); i += 3)
+	{
+		auto v0 = math::Vector3::create(&vertices[indices[i] * 3]);
+		auto e1 = math::Vector3::create(&vertices[indices[i + 1] * 3])->subtract(v0);
+		auto e2 = math::Vector3::create(&vertices[indices[i + 2] * 3])->subtract(v0);
+		auto dir = math::Vector3::create(d[0], d[1], d[2]);
+		auto p = math::Vector3::create(dir)->cross(e2);
+		auto det = e1->dot(p);
+
+		if (fabsf(det) < 0.00001f)
+			continue;
+
+		auto t = math::Vector3::create(o[0], o[1], o[2])->subtract(v0);
+		auto u = t->dot(p) / det;
+		auto q = math::Vector3::create(t)->cross(e1);
+		auto v = dir->dot(q) / det;
+		auto dist = e2->dot(q) / det;
+
+		if (u >= 0.f && v >= 0.f && u + v <= 1.f && dist > 0.f && dist < distance)
+		{
+			distance = dist;
+			triangle = i;
+			hit = true;
+		}
+	}
+
+	return hit;
+}
+
+TEST_F(TriangleBVHTest, CastVsBruteForce)
+{
+	std::vector<float>	vertices;
+	std::vector<uint>	indices;
+
+	for (uint i = 0; i < 500; ++i)
+	{
+		auto center = math::Vector3::create(random(-10.f, 10.f), random(-10.f, 10.f), random(-10.f, 10.f));
+
+		for (uint j = 0; j < 3; ++j)
+		{
+			vertices.push_back(center->x() + random());
+			vertices.push_back(center->y() + random());
+			vertices.push_back(center->z() + random());
+			indices.push_back(i * 3 + j);
+		}
+	}
+
+	auto	bvh		= TriangleBVH::create(vertices, 3, 0, indices);
+	uint	numHits	= 0;
+
+	for (uint i = 0; i < 1000; ++i)
+	{
+		float	origin[3]		= { random(-20.f, 20.f), random(-20.f, 20.f), -30.f };
+		float	direction[3]	= { random(-.5f, .5f), random(-.5f, .5f), 1.f };
+		float	expectedDistance = 0.f;
+		uint	expectedTriangle = 0;
+		float	distance		= 0.f;
+		uint	triangle		= 0;
+		float	u				= 0.f;
+		float	v				= 0.f;
+		auto	expected		= bruteForceCast(vertices, indices, origin, direction, expectedDistance, expectedTriangle);
+
+		ASSERT_EQ(expected, bvh->cast(origin, direction, distance, triangle, u, v));
+		if (expected)
+		{
+			ASSERT_NEAR(expectedDistance, distance, 1e-3f);
+			++numHits;
+		}
+	}
+
+	ASSERT_GT(numHits, 0u);
+}
+
+TEST_F(TriangleBVHTest, BatchedCast)
+{
+	std::vector<float>	vertices({ -1.f, -1.f, 0.f, 1.f, -1.f, 0.f, 1.f, 1.f, 0.f, -1.f, 1.f, 0.f });
+	std::vector<uint>	indices({ 0, 1, 2, 0, 2, 3 });
+	auto				bvh = TriangleBVH::create(vertices, 3, 0, indices);
+	float				origins[9]		= { .5f, -.5f, -2.f, -.5f, .5f, -2.f, 5.f, 5.f, -2.f };
+	float				directions[9]	= { 0.f, 0.f, 1.f, 0.f, 0.f, 1.f, 0.f, 0.f, 1.f };
+	float				distances[3];
+	int					triangles[3];
+
+	ASSERT_EQ(2u, bvh->cast(3, origins, directions, distances, triangles));
+	ASSERT_FLOAT_EQ(2.f, distances[0]);
+	ASSERT_EQ(0, triangles[0]);
+	ASSERT_FLOAT_EQ(2.f, distances[1]);
+	ASSERT_EQ(3, triangles[1]);
+	ASSERT_EQ(-1.f, distances[2]);
+	ASSERT_EQ(-1, triangles[2]);
+}
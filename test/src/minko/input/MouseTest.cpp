@@ -0,0 +1,134 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MouseTest.hpp"
+
+using namespace minko;
+using namespace minko::input;
+
+namespace
+{
+	// exposes the methods the canvas calls for each event
+	class CanvasMouse :
+		public Mouse
+	{
+	public:
+		static
+		std::shared_ptr<CanvasMouse>
+		create()
+		{
+			return std::shared_ptr<CanvasMouse>(new CanvasMouse());
+		}
+
+		using Mouse::motion;
+		using Mouse::flushMove;
+		using Mouse::nextFrame;
+
+	private:
+		CanvasMouse() :
+			Mouse(nullptr)
+		{
+		}
+	};
+}
+
+TEST_F(MouseTest, CoalesceMoves)
+{
+	auto mouse = CanvasMouse::create();
+	auto numMoves = 0;
+	auto dx = 0;
+	auto dy = 0;
+	auto _ = mouse->move()->connect([&](Mouse::Ptr m, int x, int y)
+	{
+		++numMoves;
+		dx += x;
+		dy += y;
+	});
+
+	mouse->motion(10, 5, 0);
+	mouse->motion(12, 2, 1);
+	mouse->motion(20, 4, 2);
+
+	ASSERT_EQ(0, numMoves);
+	ASSERT_EQ(20u, mouse->x());
+
+	mouse->nextFrame();
+
+	ASSERT_EQ(1, numMoves);
+	ASSERT_EQ(20, dx);
+	ASSERT_EQ(4, dy);
+
+	mouse->nextFrame();
+
+	ASSERT_EQ(1, numMoves);
+}
+
+TEST_F(MouseTest, MoveBeforeButton)
+{
+	auto mouse = CanvasMouse::create();
+	auto numMoves = 0;
+	auto _ = mouse->move()->connect([&](Mouse::Ptr m, int x, int y)
+	{
+		++numMoves;
+	});
+
+	mouse->motion(10, 5, 0);
+	mouse->flushMove();
+	mouse->motion(11, 5, 1);
+	mouse->nextFrame();
+
+	ASSERT_EQ(2, numMoves);
+}
+
+TEST_F(MouseTest, DoNotCoalesceMoves)
+{
+	auto mouse = CanvasMouse::create();
+	auto numMoves = 0;
+	auto _ = mouse->move()->connect([&](Mouse::Ptr m, int x, int y)
+	{
+		++numMoves;
+	});
+
+	mouse->coalesceMoves(false);
+	mouse->motion(10, 5, 0);
+	mouse->motion(12, 2, 1);
+
+	ASSERT_EQ(2, numMoves);
+}
+
+TEST_F(MouseTest, History)
+{
+	auto mouse = CanvasMouse::create();
+
+	mouse->recordHistory(true);
+	mouse->motion(10, 5, 3);
+	mouse->motion(12, 2, 4);
+
+	ASSERT_TRUE(mouse->history().empty());
+
+	mouse->nextFrame();
+
+	ASSERT_EQ(2u, mouse->history().size());
+	ASSERT_EQ(12, mouse->history()[1].x);
+	ASSERT_EQ(4u, mouse->history()[1].time);
+
+	mouse->nextFrame();
+
+	ASSERT_TRUE(mouse->history().empty());
+}
@@ -0,0 +1,72 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BoxTest.hpp"
+
+using namespace minko;
+using namespace minko::math;
+
+TEST_F(BoxTest, TransformIdentity)
+{
+	auto box	= Box::create(Vector3::create(1.f, 2.f, 3.f), Vector3::create(-1.f, 0.f, -3.f));
+	auto result	= box->transform(Matrix4x4::create());
+
+	ASSERT_FLOAT_EQ(result->topRight()->x(), 1.f);
+	ASSERT_FLOAT_EQ(result->topRight()->y(), 2.f);
+	ASSERT_FLOAT_EQ(result->topRight()->z(), 3.f);
+	ASSERT_FLOAT_EQ(result->bottomLeft()->x(), -1.f);
+	ASSERT_FLOAT_EQ(result->bottomLeft()->y(), 0.f);
+	ASSERT_FLOAT_EQ(result->bottomLeft()->z(), -3.f);
+}
+
+TEST_F(BoxTest, TransformMatchesTransformedVertices)
+{
+	auto box	= Box::create(Vector3::create(2.f, 1.f, .5f), Vector3::create(-1.f, -3.f, -.5f));
+	auto matrix	= Matrix4x4::create()
+		->appendScale(2.f, -1.f, .5f)
+		->appendRotationY(.7f)
+		->appendRotationX(-1.2f)
+		->appendTranslation(10.f, -5.f, 3.f);
+	auto result	= box->transform(matrix, Box::create());
+	auto min	= Vector3::create(FLT_MAX, FLT_MAX, FLT_MAX);
+	auto max	= Vector3::create(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+	for (auto& vertex : box->getVertices())
+	{
+		matrix->transform(vertex, vertex);
+		min->setTo(std::min(min->x(), vertex->x()), std::min(min->y(), vertex->y()), std::min(min->z(), vertex->z()));
+		max->setTo(std::max(max->x(), vertex->x()), std::max(max->y(), vertex->y()), std::max(max->z(), vertex->z()));
+	}
+
+	ASSERT_NEAR(result->topRight()->x(), max->x(), 1e-4f);
+	ASSERT_NEAR(result->topRight()->y(), max->y(), 1e-4f);
+	ASSERT_NEAR(result->topRight()->z(), max->z(), 1e-4f);
+	ASSERT_NEAR(result->bottomLeft()->x(), min->x(), 1e-4f);
+	ASSERT_NEAR(result->bottomLeft()->y(), min->y(), 1e-4f);
+	ASSERT_NEAR(result->bottomLeft()->z(), min->z(), 1e-4f);
+}
+
+TEST_F(BoxTest, SquaredDistance)
+{
+	auto box = Box::create(Vector3::create(1.f, 1.f, 1.f), Vector3::create(-1.f, -1.f, -1.f));
+
+	ASSERT_FLOAT_EQ(box->squaredDistance(Vector3::create(.5f, 0.f, -.5f)), 0.f);
+	ASSERT_FLOAT_EQ(box->squaredDistance(Vector3::create(3.f, 0.f, 0.f)), 4.f);
+	ASSERT_FLOAT_EQ(box->squaredDistance(Vector3::create(-2.f, 3.f, 1.f)), 5.f);
+}
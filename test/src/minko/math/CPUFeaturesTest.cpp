@@ -0,0 +1,125 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "CPUFeaturesTest.hpp"
+
+using namespace minko;
+using namespace minko::math;
+
+TEST_F(CPUFeaturesTest, ScalarIsAlwaysSupported)
+{
+	ASSERT_TRUE(CPUFeatures::supports(InstructionSet::SCALAR));
+	ASSERT_TRUE(CPUFeatures::supports(CPUFeatures::best()));
+	ASSERT_EQ(CPUFeatures::best(), CPUFeatures::instructionSet());
+
+	CPUFeatures::instructionSet(InstructionSet::SCALAR);
+
+	ASSERT_EQ(InstructionSet::SCALAR, CPUFeatures::instructionSet());
+	ASSERT_TRUE(CPUFeatures::enabled(InstructionSet::SCALAR));
+	ASSERT_FALSE(CPUFeatures::enabled(InstructionSet::SSE2));
+	ASSERT_FALSE(CPUFeatures::enabled(InstructionSet::NEON));
+}
+
+TEST_F(CPUFeaturesTest, UnsupportedInstructionSet)
+{
+	auto unsupported = CPUFeatures::best() == InstructionSet::NEON ? InstructionSet::SSE2 : InstructionSet::NEON;
+
+	ASSERT_FALSE(CPUFeatures::supports(unsupported));
+	ASSERT_THROW(CPUFeatures::instructionSet(unsupported), std::invalid_argument);
+}
+
+TEST_F(CPUFeaturesTest, ScalarMatrixKernels)
+{
+	for (uint i = 0; i < 100; ++i)
+	{
+		float lhs[16];
+		float rhs[16];
+		float v[3] = { random(), random(), random() };
+		float vector[16];
+		float scalar[16];
+
+		for (uint j = 0; j < 16; ++j)
+		{
+			lhs[j] = random();
+			rhs[j] = random();
+		}
+
+		CPUFeatures::instructionSet(CPUFeatures::best());
+		Matrix4x4::multiply(lhs, rhs, vector);
+		CPUFeatures::instructionSet(InstructionSet::SCALAR);
+		Matrix4x4::multiply(lhs, rhs, scalar);
+
+		for (uint j = 0; j < 16; ++j)
+			ASSERT_NEAR(scalar[j], vector[j], fabsf(scalar[j]) * 1e-5f);
+
+		CPUFeatures::instructionSet(CPUFeatures::best());
+		Matrix4x4::transform(lhs, v, 1.f, vector);
+		CPUFeatures::instructionSet(InstructionSet::SCALAR);
+		Matrix4x4::transform(lhs, v, 1.f, scalar);
+
+		for (uint j = 0; j < 3; ++j)
+			ASSERT_NEAR(scalar[j], vector[j], fabsf(scalar[j]) * 1e-5f);
+	}
+}
+
+TEST_F(CPUFeaturesTest, ScalarFrustumKernel)
+{
+	auto frustum = Frustum::create();
+
+	frustum->updateFromMatrix(
+		Matrix4x4::create()
+			->view(Vector3::create(0.f, 0.f, -5.f), Vector3::create(0.3f, 0.f, 0.f))
+			->append(Matrix4x4::create()->perspective(.8f, 1.3f, .1f, 100.f))
+	);
+
+	// not a multiple of the width of the vector kernels, for the scalar tail to be tested too
+	const uint numBoxes = 1003;
+	std::array<std::vector<float>, 6> bounds;
+	std::vector<uint> vector;
+	std::vector<uint> scalar;
+
+	for (auto& b : bounds)
+		b.resize(numBoxes);
+
+	for (uint i = 0; i < numBoxes; ++i)
+	{
+		auto x = random(200.f) - 100.f;
+		auto y = random(200.f) - 100.f;
+		auto z = random(200.f) - 100.f;
+		auto r = random(5.f);
+
+		bounds[0][i] = x - r;
+		bounds[1][i] = y - r;
+		bounds[2][i] = z - r;
+		bounds[3][i] = x + r;
+		bounds[4][i] = y + r;
+		bounds[5][i] = z + r;
+	}
+
+	CPUFeatures::instructionSet(CPUFeatures::best());
+	frustum->testBoundingBoxes(
+		&bounds[0][0], &bounds[1][0], &bounds[2][0], &bounds[3][0], &bounds[4][0], &bounds[5][0], numBoxes, vector
+	);
+	CPUFeatures::instructionSet(InstructionSet::SCALAR);
+	frustum->testBoundingBoxes(
+		&bounds[0][0], &bounds[1][0], &bounds[2][0], &bounds[3][0], &bounds[4][0], &bounds[5][0], numBoxes, scalar
+	);
+
+	ASSERT_EQ(scalar, vector);
+}
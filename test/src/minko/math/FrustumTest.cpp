@@ -0,0 +1,143 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FrustumTest.hpp"
+
+using namespace minko;
+using namespace minko::math;
+
+TEST_F(FrustumTest, TestBoundingBoxesVsTestBoundingBox)
+{
+	auto frustum = Frustum::create();
+
+	frustum->updateFromMatrix(
+		Matrix4x4::create()
+			->view(Vector3::create(0.f, 0.f, -5.f), Vector3::create(0.3f, 0.f, 0.f))
+			->append(Matrix4x4::create()->perspective(.8f, 1.3f, .1f, 100.f))
+	);
+
+	const uint numBoxes = 1000;
+	std::array<std::vector<float>, 6> bounds;
+	std::vector<uint> visibility;
+
+	for (auto& b : bounds)
+		b.resize(numBoxes);
+
+	for (uint i = 0; i < numBoxes; ++i)
+	{
+		auto x = random(200.f) - 100.f;
+		auto y = random(200.f) - 100.f;
+		auto z = random(200.f) - 100.f;
+		auto r = random(5.f);
+
+		bounds[0][i] = x - r;
+		bounds[1][i] = y - r;
+		bounds[2][i] = z - r;
+		bounds[3][i] = x + r;
+		bounds[4][i] = y + r;
+		bounds[5][i] = z + r;
+	}
+
+	frustum->testBoundingBoxes(
+		&bounds[0][0], &bounds[1][0], &bounds[2][0], &bounds[3][0], &bounds[4][0], &bounds[5][0],
+		numBoxes,
+		visibility
+	);
+
+	ASSERT_EQ(visibility.size(), (numBoxes + 31) / 32);
+
+	for (uint i = 0; i < numBoxes; ++i)
+	{
+		auto box = Box::create(
+			Vector3::create(bounds[3][i], bounds[4][i], bounds[5][i]),
+			Vector3::create(bounds[0][i], bounds[1][i], bounds[2][i])
+		);
+		uint planeMask = Frustum::ALL_PLANES;
+		uint firstPlane = 0;
+		auto result = frustum->testBoundingBox(box, planeMask, firstPlane);
+		auto visible = result == ShapePosition::INSIDE || result == ShapePosition::AROUND;
+
+		ASSERT_EQ(visible, (visibility[i >> 5] & (1u << (i & 31))) != 0);
+	}
+}
+
+TEST_F(FrustumTest, TestBoundingBoxPlaneMask)
+{
+	auto frustum = Frustum::create();
+
+	frustum->updateFromMatrix(
+		Matrix4x4::create()
+			->view(Vector3::create(0.f, 0.f, -5.f), Vector3::create(0.f, 0.f, 0.f))
+			->append(Matrix4x4::create()->perspective(.8f, 1.f, .1f, 100.f))
+	);
+
+	uint planeMask = Frustum::ALL_PLANES;
+	uint firstPlane = 0;
+	auto inside = Box::create(Vector3::create(.1f, .1f, .1f), Vector3::create(-.1f, -.1f, -.1f));
+
+	ASSERT_EQ(frustum->testBoundingBox(inside, planeMask, firstPlane), ShapePosition::INSIDE);
+	ASSERT_EQ(planeMask, 0u);
+
+	planeMask = Frustum::ALL_PLANES;
+	auto behind = Box::create(Vector3::create(.1f, .1f, -10.f), Vector3::create(-.1f, -.1f, -10.2f));
+	auto result = frustum->testBoundingBox(behind, planeMask, firstPlane);
+
+	ASSERT_NE(result, ShapePosition::INSIDE);
+	ASSERT_NE(result, ShapePosition::AROUND);
+	ASSERT_EQ(static_cast<uint>(result), firstPlane);
+}
+
+TEST_F(FrustumTest, OctTreeTestsTheBoxesOfItsNodes)
+{
+	auto frustum = Frustum::create();
+
+	// looks along -z from the origin
+	frustum->updateFromMatrix(
+		Matrix4x4::create()
+			->view(Vector3::create(0.f, 0.f, 0.f), Vector3::create(0.f, 0.f, -1.f))
+			->append(Matrix4x4::create()->perspective(.8f, 1.f, .1f, 100.f))
+	);
+
+	auto root = scene::Node::create()->addComponent(component::Transform::create());
+	auto front = scene::Node::create()
+		->addComponent(component::Transform::create())
+		->addComponent(component::BoundingBox::create(1.f, Vector3::create(0.f, 0.f, -10.f)));
+	auto behind = scene::Node::create()
+		->addComponent(component::Transform::create())
+		->addComponent(component::BoundingBox::create(1.f, Vector3::create(0.f, 0.f, 10.f)));
+
+	root->addChild(front)->addChild(behind);
+
+	// without depth, both nodes are in the root octant, which crosses the frustum
+	auto octTree = OctTree::create(100.f, 0, Vector3::create(), 0, false);
+	std::vector<scene::Node::Ptr> inside;
+	std::vector<scene::Node::Ptr> outside;
+
+	octTree->insert(front)->insert(behind);
+	octTree->testFrustum(
+		frustum,
+		[&](scene::Node::Ptr node) { inside.push_back(node); },
+		[&](scene::Node::Ptr node) { outside.push_back(node); }
+	);
+
+	ASSERT_EQ(1u, inside.size());
+	ASSERT_EQ(front, inside[0]);
+	ASSERT_EQ(1u, outside.size());
+	ASSERT_EQ(behind, outside[0]);
+}
@@ -706,4 +706,148 @@ TEST_F(Matrix4x4Test, DecomposeRecompose)
 
 		ASSERT_TRUE(nearEqual(mat1, mat2, epsilon));
 	}
-}
\ No newline at end of file
+}
+
+TEST_F(Matrix4x4Test, AppendVsRowMajorProduct)
+{
+	for (uint n = 0; n < 50; ++n)
+	{
+		auto m1 = Matrix4x4::create();
+		auto m2 = Matrix4x4::create();
+
+		for (uint i = 0; i < 16; ++i)
+		{
+			m1->data()[i] = random(10.f);
+			m2->data()[i] = random(10.f);
+		}
+
+		std::vector<float> expected(16);
+
+		for (uint i = 0; i < 4; ++i)
+			for (uint j = 0; j < 4; ++j)
+				for (uint k = 0; k < 4; ++k)
+					expected[i * 4 + j] += m2->data()[i * 4 + k] * m1->data()[k * 4 + j];
+
+		auto m3 = Matrix4x4::create();
+
+		Matrix4x4::multiply(&m1->data()[0], &m2->data()[0], &m3->data()[0]);
+		m1->append(m2);
+
+		for (uint i = 0; i < 16; ++i)
+		{
+			ASSERT_NEAR(m1->data()[i], expected[i], 1e-3f);
+			ASSERT_NEAR(m3->data()[i], expected[i], 1e-3f);
+		}
+	}
+}
+
+TEST_F(Matrix4x4Test, ChangeEpsilon)
+{
+	auto m = Matrix4x4::create()->appendTranslation(1.f, 2.f, 3.f);
+	auto numChanges = 0;
+	auto _ = m->changed()->connect([&](data::Value::Ptr) { ++numChanges; });
+
+	m->copyFrom(Matrix4x4::create(m));
+
+	ASSERT_EQ(numChanges, 1);
+
+	m->changeEpsilon(1e-3f);
+	m->copyFrom(Matrix4x4::create(m));
+	m->translation(1.f, 2.f, 3.0001f);
+	m->setRaw(&Matrix4x4::create(m)->data()[0]);
+
+	ASSERT_EQ(numChanges, 1);
+
+	m->translation(1.f, 2.f, 4.f);
+
+	ASSERT_EQ(numChanges, 2);
+	ASSERT_FLOAT_EQ(m->data()[11], 4.f);
+
+	m->lerp(Matrix4x4::create(), 0.5f);
+
+	ASSERT_EQ(numChanges, 3);
+}
+
+TEST_F(Matrix4x4Test, ChangeEpsilonAccumulatesSmallWrites)
+{
+	auto m = Matrix4x4::create()->identity()->changeEpsilon(1e-3f);
+	auto numChanges = 0;
+	auto _ = m->changed()->connect([&](data::Value::Ptr) { ++numChanges; });
+
+	for (auto i = 0; i < 5; ++i)
+		m->appendTranslation(0.f, 0.f, 3e-4f);
+
+	ASSERT_EQ(numChanges, 1);
+	ASSERT_NEAR(m->data()[11], 1.5e-3f, 1e-6f);
+}
+
+TEST_F(Matrix4x4Test, RawKernelsInPlace)
+{
+	auto m = Matrix4x4::create()
+		->appendRotationY(0.7f)
+		->appendScale(2.f, 3.f, 4.f)
+		->appendTranslation(1.f, -2.f, 5.f);
+	auto inverse = Matrix4x4::create(m)->invert();
+	float values[16];
+	float v[3] = { 1.f, 2.f, 3.f };
+
+	std::copy(m->data().begin(), m->data().end(), values);
+	Matrix4x4::invert(values, values);
+	for (uint i = 0; i < 16; ++i)
+		ASSERT_NEAR(values[i], inverse->data()[i], 1e-5f);
+
+	Matrix4x4::multiply(&m->data()[0], values, values);
+	for (uint i = 0; i < 16; ++i)
+		ASSERT_NEAR(values[i], i % 5 == 0 ? 1.f : 0.f, 1e-5f);
+
+	auto expected = m->transform(Vector3::create(v[0], v[1], v[2]));
+
+	Matrix4x4::transform(&m->data()[0], v, 1.f, v);
+	ASSERT_NEAR(v[0], expected->x(), 1e-5f);
+	ASSERT_NEAR(v[1], expected->y(), 1e-5f);
+	ASSERT_NEAR(v[2], expected->z(), 1e-5f);
+
+	std::copy(m->data().begin(), m->data().end(), values);
+	Matrix4x4::lerp(values, &inverse->data()[0], 0.25f, values);
+	for (uint i = 0; i < 16; ++i)
+		ASSERT_NEAR(values[i], m->data()[i] + (inverse->data()[i] - m->data()[i]) * 0.25f, 1e-5f);
+}
+
+TEST_F(Matrix4x4Test, QuaternionBatchSlerp)
+{
+	const uint numQuaternions = 6;
+	std::vector<Quaternion::Ptr> from;
+	std::vector<Quaternion::Ptr> to;
+	float ratios[numQuaternions];
+	float soaFrom[numQuaternions * 4];
+	float soaTo[numQuaternions * 4];
+
+	for (uint q = 0; q < numQuaternions; ++q)
+	{
+		from.push_back(Quaternion::create()->initialize(0.3f * q, Vector3::create(1.f, q, 2.f)->normalize()));
+		// every other target is in the opposite hemisphere to exercise the sign adjustment
+		to.push_back(Quaternion::create()->initialize(q % 2 ? 5.f : 1.f + 0.2f * q, Vector3::create(q, 1.f, -1.f)->normalize()));
+		ratios[q] = q / (float)numQuaternions;
+
+		soaFrom[q] = from[q]->i();
+		soaFrom[numQuaternions + q] = from[q]->j();
+		soaFrom[2 * numQuaternions + q] = from[q]->k();
+		soaFrom[3 * numQuaternions + q] = from[q]->r();
+		soaTo[q] = to[q]->i();
+		soaTo[numQuaternions + q] = to[q]->j();
+		soaTo[2 * numQuaternions + q] = to[q]->k();
+		soaTo[3 * numQuaternions + q] = to[q]->r();
+	}
+
+	Quaternion::slerp(numQuaternions, soaFrom, soaTo, ratios, soaFrom);
+
+	for (uint q = 0; q < numQuaternions; ++q)
+	{
+		auto expected = from[q]->slerp(to[q], ratios[q]);
+
+		ASSERT_NEAR(soaFrom[q], expected->i(), 1e-5f);
+		ASSERT_NEAR(soaFrom[numQuaternions + q], expected->j(), 1e-5f);
+		ASSERT_NEAR(soaFrom[2 * numQuaternions + q], expected->k(), 1e-5f);
+		ASSERT_NEAR(soaFrom[3 * numQuaternions + q], expected->r(), 1e-5f);
+	}
+}
@@ -0,0 +1,70 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "OcclusionBufferTest.hpp"
+
+using namespace minko;
+using namespace minko::math;
+
+static
+OcclusionBuffer::Ptr
+createBufferWithQuad(float halfSize, float z)
+{
+	auto buffer		= OcclusionBuffer::create(128, 64);
+	auto vertices	= std::vector<float>({
+		-halfSize, -halfSize, z,
+		halfSize, -halfSize, z,
+		halfSize, halfSize, z,
+		-halfSize, halfSize, z
+	});
+	auto indices	= std::vector<uint>({ 0, 1, 2, 0, 2, 3 });
+
+	buffer->clear(Matrix4x4::create()->perspective((float)PI * .5f, 2.f, .1f, 1000.f));
+	buffer->rasterize(vertices, 3, 0, indices, Matrix4x4::create());
+
+	return buffer;
+}
+
+TEST_F(OcclusionBufferTest, Occluded)
+{
+	auto buffer = createBufferWithQuad(5.f, -10.f);
+
+	ASSERT_TRUE(buffer->occluded(Box::create(Vector3::create(1.f, 1.f, -19.f), Vector3::create(-1.f, -1.f, -20.f))));
+	ASSERT_FALSE(buffer->occluded(Box::create(Vector3::create(1.f, 1.f, -4.f), Vector3::create(-1.f, -1.f, -5.f))));
+	ASSERT_FALSE(buffer->occluded(Box::create(Vector3::create(21.f, 1.f, -19.f), Vector3::create(20.f, -1.f, -20.f))));
+}
+
+TEST_F(OcclusionBufferTest, PartiallyOccluded)
+{
+	auto buffer = createBufferWithQuad(5.f, -10.f);
+
+	// sticks out of the occluder on the right
+	ASSERT_FALSE(buffer->occluded(Box::create(Vector3::create(15.f, 1.f, -19.f), Vector3::create(0.f, -1.f, -20.f))));
+	// crosses the eye plane
+	ASSERT_FALSE(buffer->occluded(Box::create(Vector3::create(1.f, 1.f, 1.f), Vector3::create(-1.f, -1.f, -20.f))));
+}
+
+TEST_F(OcclusionBufferTest, PyramidKeepsFarthestDepth)
+{
+	auto buffer = createBufferWithQuad(5.f, -10.f);
+	auto top	= buffer->numLevels() - 1;
+
+	ASSERT_EQ(buffer->depth(0, 0, top), std::numeric_limits<float>::max());
+	ASSERT_LT(buffer->depth(buffer->width() / 2, buffer->height() / 2), 1.f);
+}
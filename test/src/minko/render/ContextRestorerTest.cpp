@@ -0,0 +1,112 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ContextRestorerTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+TEST_F(ContextRestorerTest, RestoreRetainedData)
+{
+	auto context = MinkoTests::context();
+	auto texture = Texture::create(context, 2, 2);
+	std::vector<unsigned char> pixels(2 * 2 * 4, 255);
+
+	texture->data(&pixels[0]);
+	texture->upload();
+
+	auto vertexBuffer = VertexBuffer::create(context, std::vector<float>(12, 1.f));
+	auto indexBuffer = IndexBuffer::create(context, std::vector<unsigned short>({ 0, 1, 2 }));
+	auto disposedBuffer = VertexBuffer::create(context, std::vector<float>(12, 1.f));
+
+	disposedBuffer->disposeData();
+
+	auto restorer = ContextRestorer::create(context);
+	std::vector<AbstractResource::Ptr> lost;
+	auto numRestored = -1;
+	auto _ = restorer->dataLost()->connect([&](ContextRestorer::Ptr, AbstractResource::Ptr resource)
+	{
+		lost.push_back(resource);
+	});
+	auto __ = restorer->restored()->connect([&](ContextRestorer::Ptr, uint n)
+	{
+		numRestored = n;
+	});
+
+	restorer->track(texture);
+	restorer->track(vertexBuffer);
+	restorer->track(indexBuffer);
+	restorer->track(disposedBuffer);
+	restorer->contextRestored();
+
+	// allocated at once so that they can be bound before their content is uploaded
+	ASSERT_TRUE(texture->isReady());
+	ASSERT_TRUE(vertexBuffer->isReady());
+	ASSERT_TRUE(indexBuffer->isReady());
+	ASSERT_TRUE(disposedBuffer->isReady());
+	ASSERT_EQ(restorer->numPendingResources(), 4u);
+
+	restorer->beforeFirstStep();
+	while (!restorer->complete())
+		restorer->step();
+	restorer->afterLastStep();
+
+	ASSERT_EQ(numRestored, 3);
+	ASSERT_EQ(lost.size(), 1u);
+	ASSERT_EQ(lost[0], disposedBuffer);
+}
+
+TEST_F(ContextRestorerTest, FrameBudget)
+{
+	auto context = MinkoTests::context();
+	auto restorer = ContextRestorer::create(context, 16);
+	std::vector<unsigned char> pixels(2 * 2 * 4, 255);
+	std::vector<Texture::Ptr> textures;
+
+	for (auto i = 0; i < 2; ++i)
+	{
+		textures.push_back(Texture::create(context, 2, 2));
+		textures.back()->data(&pixels[0]);
+		textures.back()->upload();
+		restorer->track(textures.back());
+	}
+
+	restorer->contextRestored();
+	restorer->beforeFirstStep();
+
+	// 2x2 RGBA texture: 16 bytes
+	restorer->step();
+	ASSERT_TRUE(restorer->yieldFrame());
+	ASSERT_EQ(restorer->numPendingResources(), 1u);
+}
+
+TEST_F(ContextRestorerTest, ReleasedResourcesAreSkipped)
+{
+	auto context = MinkoTests::context();
+	auto restorer = ContextRestorer::create(context);
+	auto vertexBuffer = VertexBuffer::create(context, std::vector<float>(12, 1.f));
+
+	restorer->track(vertexBuffer);
+	vertexBuffer = nullptr;
+	restorer->contextRestored();
+
+	ASSERT_TRUE(restorer->complete());
+}
@@ -0,0 +1,112 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DynamicResolutionTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+TEST_F(DynamicResolutionTest, CreateWithoutEffect)
+{
+	ASSERT_THROW(DynamicResolution::create(nullptr), std::invalid_argument);
+}
+
+TEST_F(DynamicResolutionTest, DecreaseWhenTooSlow)
+{
+	auto resolution = DynamicResolution::create(Effect::create(), 16.f);
+
+	resolution->minScale(.5f);
+	resolution->update(32.f);
+
+	// half the time is reached with about 0.7 times the pixels in both directions
+	ASSERT_LT(resolution->scale(), .75f);
+	ASSERT_GE(resolution->scale(), .65f);
+
+	for (auto i = 0; i < 100; ++i)
+		resolution->update(100.f);
+
+	ASSERT_FLOAT_EQ(resolution->scale(), .5f);
+}
+
+TEST_F(DynamicResolutionTest, IncreaseWithHysteresis)
+{
+	auto resolution = DynamicResolution::create(Effect::create(), 16.f);
+
+	resolution->minScale(.5f);
+	resolution->scale(.5f);
+
+	// under the target but within the hysteresis
+	for (uint i = 0; i < DynamicResolution::NUM_COOLDOWN_FRAMES + 10; ++i)
+		resolution->update(15.f);
+
+	ASSERT_FLOAT_EQ(resolution->scale(), .5f);
+
+	for (uint i = 0; i < DynamicResolution::NUM_COOLDOWN_FRAMES + 1; ++i)
+		resolution->update(8.f);
+
+	ASSERT_FLOAT_EQ(resolution->scale(), .5f + resolution->step());
+}
+
+TEST_F(DynamicResolutionTest, CooldownAfterChange)
+{
+	auto resolution = DynamicResolution::create(Effect::create(), 16.f);
+
+	resolution->update(32.f);
+
+	auto scale = resolution->scale();
+
+	// the GPU times of the frames in flight were measured at the previous scale
+	for (uint i = 0; i < DynamicResolution::NUM_COOLDOWN_FRAMES; ++i)
+		resolution->update(32.f);
+
+	ASSERT_FLOAT_EQ(resolution->scale(), scale);
+}
+
+TEST_F(DynamicResolutionTest, ScaleBounds)
+{
+	auto resolution = DynamicResolution::create(Effect::create(), 16.f);
+
+	ASSERT_THROW(resolution->minScale(0.f), std::invalid_argument);
+	ASSERT_THROW(resolution->maxScale(2.f), std::invalid_argument);
+
+	resolution->maxScale(.8f);
+
+	ASSERT_FLOAT_EQ(resolution->scale(), .8f);
+
+	resolution->scale(.1f);
+
+	ASSERT_FLOAT_EQ(resolution->scale(), resolution->minScale());
+}
+
+TEST_F(DynamicResolutionTest, Region)
+{
+	auto resolution = DynamicResolution::create(Effect::create(), 16.f);
+	auto target = resolution->target(MinkoTests::context(), 200, 100);
+
+	ASSERT_EQ(resolution->target(MinkoTests::context(), 200, 100), target);
+
+	resolution->minScale(.5f);
+	resolution->scale(.5f);
+
+	ASSERT_EQ(resolution->regionWidth(), 100u);
+	ASSERT_EQ(resolution->regionHeight(), 50u);
+	ASSERT_NE(resolution->target(MinkoTests::context(), 400, 100), target);
+}
@@ -0,0 +1,73 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "GPUTimerTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+TEST_F(GPUTimerTest, CreateWithoutTimerQueries)
+{
+	if (MinkoTests::context()->supportsTimerQueries())
+		return;
+
+	ASSERT_THROW(GPUTimer::create(MinkoTests::context()), std::logic_error);
+}
+
+TEST_F(GPUTimerTest, CreateWithoutContext)
+{
+	ASSERT_THROW(GPUTimer::create(nullptr), std::invalid_argument);
+}
+
+TEST_F(GPUTimerTest, ResultsAreRecordedInTheProfiler)
+{
+	if (!MinkoTests::context()->supportsTimerQueries())
+		return;
+
+	auto timer = GPUTimer::create(MinkoTests::context());
+
+	Profiler::clear();
+	timer->begin("first");
+	MinkoTests::context()->clear();
+	timer->begin("second");
+	MinkoTests::context()->clear();
+	timer->end();
+
+	ASSERT_FALSE(timer->running());
+	ASSERT_EQ(2u, timer->numPendingQueries());
+
+	// reading the pixels waits for the GPU
+	std::vector<unsigned char> pixels(4);
+	MinkoTests::context()->readPixels(0, 0, 1, 1, &pixels[0]);
+
+	for (auto i = 0; i < 1000 && timer->numPendingQueries() != 0; ++i)
+		timer->update();
+
+	// the results of a disjoint GPU timer are dropped
+	auto events = Profiler::events();
+
+	ASSERT_TRUE(events.size() + timer->numPendingQueries() <= 2u);
+	for (auto& event : events)
+		ASSERT_EQ(Profiler::gpuThread(), event.thread);
+
+	Profiler::clear();
+}
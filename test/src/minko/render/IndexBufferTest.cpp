@@ -0,0 +1,84 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "IndexBufferTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+TEST_F(IndexBufferTest, ShortIndices)
+{
+	std::vector<unsigned short> data = { 0, 1, 2, 2, 1, 3 };
+	auto indices = IndexBuffer::create(MinkoTests::context(), data);
+
+	ASSERT_EQ(indices->indexSize(), sizeof(unsigned short));
+	ASSERT_EQ(indices->data().size(), data.size());
+	ASSERT_EQ(indices->data()[5], 3);
+}
+
+TEST_F(IndexBufferTest, UnsignedIntIndices)
+{
+	if (!MinkoTests::context()->supportsUnsignedIntIndices())
+		return;
+
+	std::vector<uint> data = { 0, 1, 70000 };
+	auto indices = IndexBuffer::create(MinkoTests::context(), data);
+
+	ASSERT_EQ(indices->indexSize(), sizeof(uint));
+	ASSERT_EQ(indices->data()[2], 70000);
+}
+
+TEST_F(IndexBufferTest, GrowToUnsignedIntIndices)
+{
+	if (!MinkoTests::context()->supportsUnsignedIntIndices())
+		return;
+
+	auto indices = IndexBuffer::create(MinkoTests::context(), std::vector<uint>(3, 0));
+
+	ASSERT_EQ(indices->indexSize(), sizeof(unsigned short));
+
+	indices->data().push_back(100000);
+	indices->upload();
+
+	ASSERT_EQ(indices->indexSize(), sizeof(uint));
+}
+
+TEST_F(IndexBufferTest, UploadAsyncWithoutUploadThread)
+{
+	auto indices = IndexBuffer::create(MinkoTests::context());
+	auto completed = false;
+
+	indices->data().assign({ 0, 1, 2 });
+	indices->uploadAsync(nullptr, [&]() { completed = true; });
+
+	ASSERT_TRUE(completed);
+	ASSERT_EQ(indices->indexSize(), sizeof(unsigned short));
+}
+
+TEST_F(IndexBufferTest, CreateFromMovedData)
+{
+	std::vector<uint> data = { 0, 1, 2, 2, 1, 3 };
+	const auto pointer = data.data();
+	auto indices = IndexBuffer::create(MinkoTests::context(), std::move(data));
+
+	ASSERT_EQ(indices->numIndices(), 6u);
+	ASSERT_EQ(indices->data().data(), pointer);
+}
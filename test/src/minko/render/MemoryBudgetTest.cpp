@@ -0,0 +1,93 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MemoryBudgetTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+namespace
+{
+	Texture::Ptr
+	createTexture(uint size)
+	{
+		auto texture = Texture::create(MinkoTests::context(), size, size);
+		std::vector<unsigned char> data(size * size * 4, 255);
+
+		texture->data(&data[0]);
+		texture->upload();
+
+		return texture;
+	}
+}
+
+TEST_F(MemoryBudgetTest, TrackTextureSize)
+{
+	auto budget = MemoryBudget::create(1 << 20);
+	auto texture = createTexture(16);
+
+	budget->track(texture);
+
+	ASSERT_EQ(budget->usedBytes(), 16u * 16u * 4u);
+
+	budget->untrack(texture);
+
+	ASSERT_EQ(budget->usedBytes(), 0u);
+}
+
+TEST_F(MemoryBudgetTest, EvictLeastRecentlyUsed)
+{
+	auto budget = MemoryBudget::create(16 * 16 * 4);
+	auto oldTexture = createTexture(16);
+	auto newTexture = createTexture(16);
+
+	budget->track(oldTexture);
+	budget->track(newTexture);
+	budget->nextFrame();
+
+	// both textures were used during the previous frame
+	ASSERT_TRUE(budget->resident(oldTexture));
+
+	budget->touch(newTexture->id());
+	budget->nextFrame();
+
+	ASSERT_FALSE(budget->resident(oldTexture));
+	ASSERT_TRUE(budget->resident(newTexture));
+	ASSERT_EQ(budget->usedBytes(), 16u * 16u * 4u);
+	ASSERT_TRUE(oldTexture->isReady());
+}
+
+TEST_F(MemoryBudgetTest, ReloadOnTouch)
+{
+	auto budget = MemoryBudget::create(0);
+	auto texture = createTexture(16);
+
+	budget->track(texture);
+	budget->nextFrame();
+	budget->nextFrame();
+
+	ASSERT_FALSE(budget->resident(texture));
+
+	budget->touch(texture->id());
+
+	ASSERT_TRUE(budget->resident(texture));
+	ASSERT_EQ(budget->usedBytes(), 16u * 16u * 4u);
+}
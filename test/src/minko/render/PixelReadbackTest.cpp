@@ -0,0 +1,92 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "PixelReadbackTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+TEST_F(PixelReadbackTest, CreateWithoutContext)
+{
+	ASSERT_THROW(PixelReadback::create(nullptr), std::invalid_argument);
+}
+
+TEST_F(PixelReadbackTest, ReadClearColor)
+{
+	auto readback = PixelReadback::create(MinkoTests::context());
+	auto numReads = 0;
+	PixelReadback::ImagePtr image = nullptr;
+
+	MinkoTests::context()->clear(1.f, 0.f, 0.f, 1.f);
+	readback->read(0, 0, 2, 2, [&](PixelReadback::ImagePtr result)
+	{
+		++numReads;
+		image = result;
+	});
+
+	ASSERT_EQ(1u, readback->numPendingReads());
+
+	for (auto i = 0; i < 1000 && numReads == 0; ++i)
+		readback->update();
+
+	ASSERT_EQ(1, numReads);
+	ASSERT_EQ(0u, readback->numPendingReads());
+	ASSERT_EQ(2u, image->width);
+	ASSERT_EQ(16u, image->pixels.size());
+	ASSERT_EQ(255, image->pixels[0]);
+	ASSERT_EQ(0, image->pixels[1]);
+}
+
+TEST_F(PixelReadbackTest, CallbacksInOrder)
+{
+	auto readback = PixelReadback::create(MinkoTests::context(), nullptr, 2);
+	std::vector<int> reads;
+
+	for (auto i = 0; i < 3; ++i)
+		readback->read(0, 0, 1, 1, [&, i](PixelReadback::ImagePtr) { reads.push_back(i); });
+
+	// the third read waited for the first one to free its pixel buffer
+	ASSERT_EQ(1u, readback->numStalls());
+	ASSERT_EQ(1u, reads.size());
+
+	readback->flush();
+
+	ASSERT_EQ(3u, reads.size());
+	ASSERT_EQ(0, reads[0]);
+	ASSERT_EQ(1, reads[1]);
+	ASSERT_EQ(2, reads[2]);
+}
+
+TEST_F(PixelReadbackTest, Encoder)
+{
+	auto readback = PixelReadback::create(MinkoTests::context());
+	auto encoded = false;
+	auto encodedBeforeCallback = false;
+
+	readback->read(
+		0, 0, 1, 1,
+		[&](PixelReadback::ImagePtr) { encodedBeforeCallback = encoded; },
+		[&](PixelReadback::ImagePtr) { encoded = true; }
+	);
+	readback->flush();
+
+	ASSERT_TRUE(encodedBeforeCallback);
+}
@@ -0,0 +1,59 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ProgramSignatureTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+TEST_F(ProgramSignatureTest, EqualSignaturesHaveTheSameHash)
+{
+	ProgramSignature a(5u, { 1, 0, 3 });
+	ProgramSignature b(5u, { 1, 0, 3, 0, 0 });
+
+	ASSERT_TRUE(a == b);
+	ASSERT_EQ(a.hash(), b.hash());
+	ASSERT_EQ(std::hash<ProgramSignature>()(a), std::hash<ProgramSignature>()(b));
+}
+
+TEST_F(ProgramSignatureTest, DifferentValuesOrMask)
+{
+	ProgramSignature a(5u, { 1, 0, 3 });
+	ProgramSignature b(5u, { 1, 0, 4 });
+	ProgramSignature c(7u, { 1, 0, 3 });
+
+	ASSERT_FALSE(a == b);
+	ASSERT_FALSE(a == c);
+	ASSERT_NE(a.hash(), b.hash());
+	ASSERT_NE(a.hash(), c.hash());
+}
+
+TEST_F(ProgramSignatureTest, UnorderedMapLookup)
+{
+	std::unordered_map<ProgramSignature, int> signatureToId;
+
+	for (int i = 0; i < 100; ++i)
+		signatureToId[ProgramSignature(1u, { i })] = i;
+
+	ASSERT_EQ(100u, signatureToId.size());
+	ASSERT_EQ(42, signatureToId[ProgramSignature(1u, { 42 })]);
+	ASSERT_EQ(0u, signatureToId.count(ProgramSignature(2u, { 42 })));
+}
@@ -0,0 +1,155 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "RenderGraphTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+TEST_F(RenderGraphTest, UnusedPassesAreCulled)
+{
+	auto graph = RenderGraph::create(MinkoTests::context());
+	std::vector<std::string> executed;
+	auto record = [&](const std::string& name)
+	{
+		return [&executed, name](RenderGraph::Ptr graph, Texture::Ptr target, bool clear) { executed.push_back(name); };
+	};
+
+	graph
+		->transientTexture("scene", 64, 64)
+		->transientTexture("unused", 64, 64)
+		->addPass("scene", {}, "scene", record("scene"))
+		->addPass("unused", { "scene" }, "unused", record("unused"))
+		->addPass("present", { "scene" }, RenderGraph::BACK_BUFFER, record("present"));
+
+	ASSERT_EQ(graph->numExecutedPasses(), 2);
+	ASSERT_TRUE(graph->culled("unused"));
+	ASSERT_FALSE(graph->culled("scene"));
+
+	graph->execute();
+
+	ASSERT_EQ(executed, std::vector<std::string>({ "scene", "present" }));
+
+	graph->output("unused");
+	executed.clear();
+	graph->execute();
+
+	ASSERT_EQ(executed.size(), 3);
+}
+
+TEST_F(RenderGraphTest, TransientTargetsAreAliased)
+{
+	auto graph = RenderGraph::create(MinkoTests::context());
+	std::unordered_map<std::string, Texture::Ptr> targets;
+	auto record = [&](const std::string& name)
+	{
+		return [&targets, name](RenderGraph::Ptr graph, Texture::Ptr target, bool clear) { targets[name] = target; };
+	};
+
+	graph
+		->transientTexture("scene", 64, 64)
+		->transientTexture("blurX", 64, 64)
+		->transientTexture("blurY", 64, 64)
+		->addPass("scene", {}, "scene", record("scene"))
+		->addPass("blurX", { "scene" }, "blurX", record("blurX"))
+		->addPass("blurY", { "blurX" }, "blurY", record("blurY"))
+		->addPass("present", { "blurY" }, RenderGraph::BACK_BUFFER, record("present"));
+
+	graph->execute();
+
+	ASSERT_NE(targets["scene"], nullptr);
+	ASSERT_NE(targets["scene"], targets["blurX"]);
+	ASSERT_EQ(targets["scene"], targets["blurY"]);
+	ASSERT_EQ(targets["present"], nullptr);
+	ASSERT_EQ(graph->pool()->numAcquired(), 0);
+	ASSERT_EQ(graph->texture("blurY"), nullptr);
+
+	graph->execute();
+
+	ASSERT_EQ(graph->pool()->numAvailable(), 2);
+}
+
+TEST_F(RenderGraphTest, OutputsAreKept)
+{
+	auto graph = RenderGraph::create(MinkoTests::context());
+
+	graph
+		->transientTexture("scene", 64, 64)
+		->output("scene")
+		->addPass("scene", {}, "scene", [](RenderGraph::Ptr graph, Texture::Ptr target, bool clear) { });
+
+	graph->execute();
+
+	ASSERT_NE(graph->texture("scene"), nullptr);
+	ASSERT_EQ(graph->pool()->numAcquired(), 1);
+}
+
+TEST_F(RenderGraphTest, ConsecutiveWritesAreMerged)
+{
+	auto graph = RenderGraph::create(MinkoTests::context());
+	std::vector<bool> clears;
+	auto record = [&](RenderGraph::Ptr graph, Texture::Ptr target, bool clear) { clears.push_back(clear); };
+
+	graph
+		->addPass("scene", {}, RenderGraph::BACK_BUFFER, record)
+		->addPass("overlay", {}, RenderGraph::BACK_BUFFER, record);
+
+	graph->execute();
+
+	ASSERT_EQ(graph->numMergedPasses(), 1);
+	ASSERT_EQ(clears, std::vector<bool>({ true, false }));
+}
+
+TEST_F(RenderGraphTest, ReadBeforeWrite)
+{
+	auto graph = RenderGraph::create(MinkoTests::context());
+	auto nothing = [](RenderGraph::Ptr graph, Texture::Ptr target, bool clear) { };
+
+	graph
+		->transientTexture("scene", 64, 64)
+		->addPass("present", { "scene" }, RenderGraph::BACK_BUFFER, nothing)
+		->addPass("scene", {}, "scene", nothing);
+
+	ASSERT_THROW(graph->compile(), std::logic_error);
+
+	graph->removePass("present");
+
+	ASSERT_NO_THROW(graph->compile());
+	ASSERT_THROW(graph->addPass("scene", {}, "scene", nothing), std::invalid_argument);
+}
+
+TEST_F(RenderGraphTest, ImportedTextures)
+{
+	auto graph = RenderGraph::create(MinkoTests::context());
+	auto texture = Texture::create(MinkoTests::context(), 64, 64, false, true);
+	Texture::Ptr written;
+
+	texture->upload();
+	graph
+		->importTexture("shadows", texture)
+		->addPass("shadows", {}, "shadows", [&](RenderGraph::Ptr graph, Texture::Ptr target, bool clear) { written = target; });
+
+	graph->execute();
+
+	ASSERT_EQ(written, texture);
+	ASSERT_EQ(graph->texture("shadows"), texture);
+}
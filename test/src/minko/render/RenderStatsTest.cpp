@@ -0,0 +1,70 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "RenderStatsTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+TEST_F(RenderStatsTest, Difference)
+{
+	RenderStats begin;
+	RenderStats end;
+
+	begin.numDrawCalls = 3;
+	begin.numBytesUploaded = 100;
+	end.numDrawCalls = 10;
+	end.numBytesUploaded = 164;
+	end.numUniformCalls = 2;
+
+	auto frame = end - begin;
+
+	ASSERT_EQ(7u, frame.numDrawCalls);
+	ASSERT_EQ(64u, frame.numBytesUploaded);
+	ASSERT_EQ(2u, frame.numUniformCalls);
+	ASSERT_EQ(0u, frame.numTriangles);
+}
+
+TEST_F(RenderStatsTest, UploadedBytes)
+{
+	auto context = MinkoTests::context();
+	const auto begin = context->renderStats();
+
+	auto vertexBuffer = VertexBuffer::create(context, std::vector<float>(16, 0.f));
+
+	ASSERT_EQ(16u * sizeof(float), (context->renderStats() - begin).numBytesUploaded);
+
+	vertexBuffer->dispose();
+}
+
+TEST_F(RenderStatsTest, RedundantTextureBindsAreNotCounted)
+{
+	auto context = MinkoTests::context();
+	auto texture = context->createTexture(TextureType::Texture2D, 4, 4, false);
+	const auto begin = context->renderStats();
+
+	context->setTextureAt(0, texture, -1);
+	context->setTextureAt(0, texture, -1);
+
+	ASSERT_EQ(1u, (context->renderStats() - begin).numTextureBinds);
+
+	context->deleteTexture(texture);
+}
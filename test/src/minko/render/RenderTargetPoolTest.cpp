@@ -0,0 +1,72 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "RenderTargetPoolTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+TEST_F(RenderTargetPoolTest, ReuseAfterNextFrame)
+{
+	auto pool = RenderTargetPool::create(MinkoTests::context());
+	auto first = pool->acquire(256, 256);
+	auto second = pool->acquire(256, 256);
+
+	ASSERT_NE(first, second);
+	ASSERT_EQ(pool->numAcquired(), 2);
+
+	pool->nextFrame();
+
+	ASSERT_EQ(pool->numAcquired(), 0);
+	ASSERT_EQ(pool->numAvailable(), 2);
+
+	auto reused = pool->acquire(256, 256);
+
+	ASSERT_TRUE(reused == first || reused == second);
+	ASSERT_NE(pool->acquire(128, 128), first);
+	ASSERT_EQ(pool->numAvailable(), 1);
+}
+
+TEST_F(RenderTargetPoolTest, DisposeUnused)
+{
+	auto pool = RenderTargetPool::create(MinkoTests::context(), 1);
+
+	pool->acquire(64, 64);
+	pool->nextFrame();
+
+	ASSERT_EQ(pool->numAvailable(), 1);
+
+	pool->nextFrame();
+
+	ASSERT_EQ(pool->numAvailable(), 0);
+}
+
+TEST_F(RenderTargetPoolTest, ReuseAfterRelease)
+{
+	auto pool = RenderTargetPool::create(MinkoTests::context());
+	auto first = pool->acquire(256, 256);
+
+	pool->release(first);
+
+	ASSERT_EQ(pool->numAcquired(), 0);
+	ASSERT_EQ(pool->acquire(256, 256), first);
+	ASSERT_THROW(pool->release(Texture::create(MinkoTests::context(), 256, 256, false, true)), std::invalid_argument);
+}
@@ -0,0 +1,145 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ShaderOptimizerTest.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+namespace
+{
+	ShaderOptimizer::Ptr
+	optimizer(bool deadCode, bool uniforms, const std::string& precision, bool minify)
+	{
+		auto optimizer = ShaderOptimizer::create();
+
+		optimizer->stripDeadCode(deadCode);
+		optimizer->stripUnusedUniforms(uniforms);
+		optimizer->defaultPrecision(precision);
+		optimizer->minify(minify);
+
+		return optimizer;
+	}
+}
+
+TEST_F(ShaderOptimizerTest, ResolveConditionals)
+{
+	auto source =
+		"#define NUM_LIGHTS 2\n"
+		"#define DIFFUSE_MAP\n"
+		"#ifdef DIFFUSE_MAP\n"
+		"a;\n"
+		"#else\n"
+		"b;\n"
+		"#endif\n"
+		"#if NUM_LIGHTS > 2\n"
+		"c;\n"
+		"#elif defined(DIFFUSE_MAP) && !defined(NORMAL_MAP)\n"
+		"d;\n"
+		"#endif\n"
+		"#ifndef DIFFUSE_MAP\n"
+		"#ifdef GL_ES\n"
+		"e;\n"
+		"#endif\n"
+		"#endif\n";
+
+	ASSERT_EQ(
+		optimizer(true, false, "", false)->optimize(source, Shader::Type::VERTEX_SHADER),
+		"#define NUM_LIGHTS 2\n#define DIFFUSE_MAP\na;\nd;\n"
+	);
+}
+
+TEST_F(ShaderOptimizerTest, KeepUnknownConditionals)
+{
+	auto source =
+		"#define A\n"
+		"#ifdef GL_ES\n"
+		"#define B\n"
+		"#endif\n"
+		"#ifdef B\n"
+		"b;\n"
+		"#elif defined(A)\n"
+		"a;\n"
+		"#else\n"
+		"c;\n"
+		"#endif\n";
+
+	ASSERT_EQ(
+		optimizer(true, false, "", false)->optimize(source, Shader::Type::VERTEX_SHADER),
+		"#define A\n#ifdef GL_ES\n#define B\n#endif\n#ifdef B\nb;\n#else\na;\n#endif\n"
+	);
+}
+
+TEST_F(ShaderOptimizerTest, StripUnusedFunctionsAndUniforms)
+{
+	auto source =
+		"uniform vec4 used;\n"
+		"uniform vec4 unused;\n"
+		"uniform sampler2D onlyInUnusedFunction;\n"
+		"vec4 bar() { return texture2D(onlyInUnusedFunction, vec2(0.0)); }\n"
+		"vec4 foo()\n"
+		"{\n"
+		"	return used;\n"
+		"}\n"
+		"void main() { gl_FragColor = foo(); }\n";
+
+	ASSERT_EQ(
+		optimizer(true, true, "", false)->optimize(source, Shader::Type::FRAGMENT_SHADER),
+		"uniform vec4 used;\n"
+		"vec4 foo()\n"
+		"{\n"
+		"	return used;\n"
+		"}\n"
+		"void main() { gl_FragColor = foo(); }\n"
+	);
+}
+
+TEST_F(ShaderOptimizerTest, DefaultPrecision)
+{
+	auto source = "#extension GL_OES_standard_derivatives : enable\nvoid main() {}\n";
+
+	ASSERT_EQ(
+		optimizer(false, false, "mediump", false)->optimize(source, Shader::Type::FRAGMENT_SHADER),
+		"#extension GL_OES_standard_derivatives : enable\n#ifdef GL_ES\nprecision mediump float;\n#endif\nvoid main() {}\n"
+	);
+	// vertex shaders and shaders declaring a precision are left untouched
+	ASSERT_EQ(optimizer(false, false, "mediump", false)->optimize(source, Shader::Type::VERTEX_SHADER), source);
+	ASSERT_EQ(
+		optimizer(false, false, "mediump", false)->optimize("precision highp float;\n", Shader::Type::FRAGMENT_SHADER),
+		"precision highp float;\n"
+	);
+	ASSERT_THROW(ShaderOptimizer::create()->defaultPrecision("medium"), std::invalid_argument);
+}
+
+TEST_F(ShaderOptimizerTest, Minify)
+{
+	auto source =
+		"#define  A   (1)\n"
+		"// comment\n"
+		"void main()\n"
+		"{\n"
+		"	/* comment */ float a = 1.0 - -A;\n"
+		"	gl_FragColor = vec4 ( a ) ;\n"
+		"}\n";
+
+	ASSERT_EQ(
+		optimizer(false, false, "", true)->optimize(source, Shader::Type::FRAGMENT_SHADER),
+		"#define A (1)\nvoid main(){float a = 1.0 - -A;gl_FragColor = vec4(a);}\n"
+	);
+}
@@ -0,0 +1,106 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "TextureAtlasTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+static
+Texture::Ptr
+createTexture(uint size, unsigned char red)
+{
+	auto texture = Texture::create(MinkoTests::context(), size, size);
+	std::vector<unsigned char> pixels(size * size * 4, 255);
+
+	for (uint i = 0; i < pixels.size(); i += 4)
+		pixels[i] = red;
+	texture->data(&pixels[0]);
+
+	return texture;
+}
+
+TEST_F(TextureAtlasTest, PackTextures)
+{
+	auto atlas = TextureAtlas::create(MinkoTests::context(), 32, 32, 1);
+	auto small = createTexture(4, 10);
+	auto other = createTexture(4, 20);
+	auto large = createTexture(8, 30);
+
+	atlas->add(small)->add(other)->add(large)->add(small);
+
+	ASSERT_EQ(atlas->numTextures(), 3);
+	ASSERT_TRUE(atlas->build());
+
+	auto& pixels = atlas->texture()->data();
+
+	for (auto texture : { small, other, large })
+	{
+		auto rect = atlas->uvRect(texture);
+
+		ASSERT_FLOAT_EQ(rect->z(), texture->width() / 32.f);
+		ASSERT_FLOAT_EQ(rect->w(), texture->height() / 32.f);
+
+		// the padding repeats the borders of the texture
+		for (int x = -1; x <= (int)texture->width(); ++x)
+		{
+			const uint column	= uint(rect->x() * 32.f) + x;
+			const uint row		= uint(rect->y() * 32.f) - 1;
+
+			ASSERT_EQ(pixels[(row * 32 + column) * 4], texture->data()[0]);
+		}
+	}
+
+	ASSERT_THROW(atlas->uvRect(createTexture(4, 0)), std::invalid_argument);
+}
+
+TEST_F(TextureAtlasTest, TexturesDoNotFit)
+{
+	auto atlas = TextureAtlas::create(MinkoTests::context(), 16, 16, 2);
+
+	atlas->add(createTexture(8, 0))->add(createTexture(8, 0));
+
+	ASSERT_FALSE(atlas->build());
+	ASSERT_EQ(atlas->texture(), nullptr);
+}
+
+TEST_F(TextureAtlasTest, RemapUVs)
+{
+	auto atlas = TextureAtlas::create(MinkoTests::context(), 32, 32, 0);
+	auto first = createTexture(16, 0);
+	auto second = createTexture(16, 0);
+	auto geometry = geometry::QuadGeometry::create(MinkoTests::context());
+
+	atlas->add(first)->add(second)->build();
+	atlas->remapUVs(geometry, second);
+
+	auto vertexBuffer = geometry->vertexBuffer("uv");
+	auto offset = std::get<2>(*vertexBuffer->attribute("uv"));
+
+	for (uint i = 0; i < vertexBuffer->numVertices(); ++i)
+	{
+		auto u = vertexBuffer->data()[i * vertexBuffer->vertexSize() + offset];
+
+		ASSERT_GE(u, .5f);
+		ASSERT_LE(u, 1.f);
+	}
+}
@@ -0,0 +1,80 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TextureStreamerTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+TEST_F(TextureStreamerTest, StreamFromSmallestLevel)
+{
+	auto texture = Texture::create(MinkoTests::context(), 4, 4, true);
+	auto streamer = TextureStreamer::create(0);
+	std::vector<std::vector<unsigned char>> levels = {
+		std::vector<unsigned char>(4 * 4 * 4, 255),
+		std::vector<unsigned char>(2 * 2 * 4, 128),
+		std::vector<unsigned char>(1 * 1 * 4, 0)
+	};
+	auto numStreamed = 0;
+	auto _ = streamer->textureStreamed()->connect([&](TextureStreamer::Ptr, Texture::Ptr t)
+	{
+		ASSERT_EQ(t, texture);
+		ASSERT_TRUE(streamer->complete());
+		++numStreamed;
+	});
+
+	streamer->stream(texture, levels);
+
+	ASSERT_EQ(streamer->numPendingLevels(), 3u);
+	ASSERT_TRUE(texture->isReady());
+
+	streamer->beforeFirstStep();
+	while (!streamer->complete())
+	{
+		streamer->step();
+		// a budget of 0 bytes uploads one level per frame
+		ASSERT_TRUE(streamer->yieldFrame());
+	}
+
+	ASSERT_EQ(numStreamed, 1);
+}
+
+TEST_F(TextureStreamerTest, FrameBudget)
+{
+	auto texture = Texture::create(MinkoTests::context(), 4, 4, true);
+	auto streamer = TextureStreamer::create(16);
+	std::vector<std::vector<unsigned char>> levels = {
+		std::vector<unsigned char>(4 * 4 * 4, 255),
+		std::vector<unsigned char>(2 * 2 * 4, 128),
+		std::vector<unsigned char>(1 * 1 * 4, 0)
+	};
+
+	streamer->stream(texture, levels);
+	streamer->beforeFirstStep();
+
+	// 1x1 level: 4 bytes
+	streamer->step();
+	ASSERT_FALSE(streamer->yieldFrame());
+	// 2x2 level: 16 bytes
+	streamer->step();
+	ASSERT_TRUE(streamer->yieldFrame());
+	ASSERT_EQ(streamer->numPendingLevels(), 1u);
+}
@@ -0,0 +1,118 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TextureTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+TEST_F(TextureTest, CompressedDataSize)
+{
+	ASSERT_EQ(AbstractTexture::dataSize(TextureFormat::RGBA, 64, 32), 64u * 32u * 4u);
+	ASSERT_EQ(AbstractTexture::dataSize(TextureFormat::RGB_DXT1, 64, 64), 16u * 16u * 8u);
+	ASSERT_EQ(AbstractTexture::dataSize(TextureFormat::RGBA_DXT5, 64, 64), 16u * 16u * 16u);
+	ASSERT_EQ(AbstractTexture::dataSize(TextureFormat::RGB_ETC1, 2, 2), 8u);
+	ASSERT_EQ(AbstractTexture::dataSize(TextureFormat::RGBA_ASTC_4x4, 1, 1), 16u);
+	ASSERT_EQ(AbstractTexture::dataSize(TextureFormat::RGB_PVRTC_4BPP, 4, 4), 32u);
+	ASSERT_EQ(AbstractTexture::dataSize(TextureFormat::RGBA_PVRTC_2BPP, 4, 4), 32u);
+}
+
+TEST_F(TextureTest, CompressedDataIsNotExpanded)
+{
+	auto texture = Texture::create(MinkoTests::context(), 16, 16);
+	std::vector<unsigned char> data(AbstractTexture::dataSize(TextureFormat::RGBA_DXT5, 16, 16), 42);
+
+	texture->data(&data[0], TextureFormat::RGBA_DXT5);
+
+	ASSERT_EQ(texture->format(), TextureFormat::RGBA_DXT5);
+	ASSERT_EQ(texture->data(), data);
+}
+
+TEST_F(TextureTest, CompressedDataRequiresPowerOfTwo)
+{
+	auto texture = Texture::create(MinkoTests::context(), 15, 16);
+	std::vector<unsigned char> data(AbstractTexture::dataSize(TextureFormat::RGB_ETC1, 16, 16), 0);
+
+	ASSERT_THROW(texture->data(&data[0], TextureFormat::RGB_ETC1), std::invalid_argument);
+}
+
+TEST_F(TextureTest, NonPowerOfTwoSizeIsKept)
+{
+	auto context = MinkoTests::context();
+	auto texture = Texture::create(context, 30, 20, false, false, false);
+	std::vector<unsigned char> data(30 * 20 * 4, 42);
+
+	texture->data(&data[0]);
+
+	if (context->supportsNonPowerOfTwoTextures(false))
+	{
+		ASSERT_EQ(texture->width(), 30u);
+		ASSERT_EQ(texture->height(), 20u);
+		ASSERT_EQ(texture->data(), data);
+	}
+	else
+	{
+		ASSERT_EQ(texture->width(), 32u);
+		ASSERT_EQ(texture->height(), 32u);
+	}
+}
+
+TEST_F(TextureTest, ResizeSmoothlyResamplesToPowerOfTwo)
+{
+	auto texture = Texture::create(MinkoTests::context(), 30, 20, false, false, true);
+
+	ASSERT_EQ(texture->width(), 32u);
+	ASSERT_EQ(texture->height(), 32u);
+}
+
+TEST_F(TextureTest, TakeRGBAData)
+{
+	auto texture = Texture::create(MinkoTests::context(), 16, 16);
+	std::vector<unsigned char> data(16 * 16 * 4, 42);
+	auto expected = data;
+
+	texture->data(data);
+
+	ASSERT_TRUE(data.empty());
+	ASSERT_EQ(texture->format(), TextureFormat::RGBA);
+	ASSERT_EQ(texture->data(), expected);
+}
+
+TEST_F(TextureTest, TakeRGBADataWithWrongSize)
+{
+	auto texture = Texture::create(MinkoTests::context(), 16, 16);
+	std::vector<unsigned char> data(16 * 16 * 3, 42);
+
+	ASSERT_THROW(texture->data(data), std::invalid_argument);
+}
+
+TEST_F(TextureTest, UploadAsyncWithoutUploadThread)
+{
+	auto texture = Texture::create(MinkoTests::context(), 16, 16);
+	std::vector<unsigned char> data(16 * 16 * 4, 42);
+	auto completed = false;
+
+	texture->data(data);
+	texture->uploadAsync(nullptr, [&]() { completed = true; });
+
+	ASSERT_TRUE(completed);
+	ASSERT_NE(texture->id(), -1);
+}
@@ -0,0 +1,130 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "VertexBufferTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+TEST_F(VertexBufferTest, FloatLayoutIsKept)
+{
+	auto vertexBuffer = VertexBuffer::create(MinkoTests::context(), std::vector<float>(16, 0.f));
+
+	vertexBuffer->addAttribute("position", 3);
+	vertexBuffer->addAttribute("uv", 2, 6);
+
+	ASSERT_EQ(vertexBuffer->gpuVertexSize(), vertexBuffer->vertexSize());
+	ASSERT_EQ(vertexBuffer->gpuAttributeOffset("uv"), 6u);
+	ASSERT_EQ(vertexBuffer->attributeType("uv"), VertexAttributeType::FLOAT);
+}
+
+TEST_F(VertexBufferTest, PackedLayout)
+{
+	auto vertexBuffer = VertexBuffer::create(MinkoTests::context(), std::vector<float>(8 * 4, 0.f));
+
+	vertexBuffer->addAttribute("position", 3);
+	vertexBuffer->addAttribute("normal", 3, 0, VertexAttributeType::BYTE_NORMALIZED);
+	vertexBuffer->addAttribute("uv", 2, 0, VertexAttributeType::UNSIGNED_SHORT_NORMALIZED);
+
+	ASSERT_EQ(vertexBuffer->vertexSize(), 8u);
+	ASSERT_EQ(vertexBuffer->numVertices(), 4u);
+	ASSERT_EQ(vertexBuffer->gpuVertexSize(), 5u);
+	ASSERT_EQ(vertexBuffer->gpuAttributeOffset("position"), 0u);
+	ASSERT_EQ(vertexBuffer->gpuAttributeOffset("normal"), 3u);
+	ASSERT_EQ(vertexBuffer->gpuAttributeOffset("uv"), 4u);
+	ASSERT_EQ(vertexBuffer->attributeType("normal"), VertexAttributeType::BYTE_NORMALIZED);
+	ASSERT_TRUE(vertexBuffer->isReady());
+
+	vertexBuffer->removeAttribute("normal");
+
+	ASSERT_EQ(vertexBuffer->gpuVertexSize(), 4u);
+	ASSERT_EQ(vertexBuffer->gpuAttributeOffset("uv"), 3u);
+}
+
+TEST_F(VertexBufferTest, InvalidPackedSize)
+{
+	auto vertexBuffer = VertexBuffer::create(MinkoTests::context(), std::vector<float>(8, 0.f));
+
+	ASSERT_THROW(
+		vertexBuffer->addAttribute("normal", 2, 0, VertexAttributeType::INT_2_10_10_10_NORMALIZED),
+		std::invalid_argument
+	);
+}
+
+TEST_F(VertexBufferTest, UsageChangeKeepsId)
+{
+	auto vertexBuffer = VertexBuffer::create(MinkoTests::context(), std::vector<float>(12, 0.f));
+
+	vertexBuffer->addAttribute("position", 3);
+
+	auto id = vertexBuffer->id();
+
+	ASSERT_EQ(vertexBuffer->usage(), BufferUsage::STATIC);
+
+	vertexBuffer->usage(BufferUsage::STREAM);
+	vertexBuffer->upload();
+
+	ASSERT_EQ(vertexBuffer->usage(), BufferUsage::STREAM);
+	ASSERT_EQ(vertexBuffer->id(), id);
+}
+
+TEST_F(VertexBufferTest, UploadDirty)
+{
+	auto vertexBuffer = VertexBuffer::create(MinkoTests::context(), std::vector<float>(12, 0.f));
+
+	vertexBuffer->addAttribute("position", 3);
+	vertexBuffer->usage(BufferUsage::DYNAMIC);
+
+	vertexBuffer->markDirty(3, 1);
+	vertexBuffer->markDirty(1, 1);
+	vertexBuffer->data()[3] = 1.f;
+	vertexBuffer->uploadDirty();
+	vertexBuffer->uploadDirty();
+
+	ASSERT_TRUE(vertexBuffer->isReady());
+}
+
+TEST_F(VertexBufferTest, RestoreDisposedData)
+{
+	auto vertexBuffer = VertexBuffer::create(MinkoTests::context(), std::vector<float>(12, 1.f));
+
+	vertexBuffer->addAttribute("position", 3);
+	vertexBuffer->disposeData();
+
+	ASSERT_TRUE(vertexBuffer->dataDisposed());
+	ASSERT_EQ(vertexBuffer->numVertices(), 4u);
+
+	vertexBuffer->data().assign(12, 2.f);
+	vertexBuffer->upload();
+
+	ASSERT_FALSE(vertexBuffer->dataDisposed());
+	ASSERT_EQ(vertexBuffer->maxPosition()->x(), 2.f);
+}
+
+TEST_F(VertexBufferTest, CreateFromMovedData)
+{
+	std::vector<float> data(300, 42.f);
+	const auto pointer = data.data();
+	auto vertexBuffer = VertexBuffer::create(MinkoTests::context(), std::move(data));
+
+	ASSERT_EQ(vertexBuffer->data().size(), 300u);
+	ASSERT_EQ(vertexBuffer->data().data(), pointer);
+}
@@ -0,0 +1,71 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "NodePoolTest.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::scene;
+
+TEST_F(NodePoolTest, AcquireRelease)
+{
+	auto source = Node::create("bullet")->addComponent(Transform::create());
+	auto pool = NodePool::create(Prefab::create(source), 2);
+	auto root = Node::create()->addComponent(Transform::create());
+
+	ASSERT_EQ(pool->numFreeNodes(), 2u);
+
+	auto bullet = pool->acquire(root);
+
+	ASSERT_EQ(bullet->parent(), root);
+	ASSERT_EQ(bullet->name(), "bullet");
+	ASSERT_EQ(pool->numFreeNodes(), 1u);
+	ASSERT_EQ(pool->numAcquiredNodes(), 1u);
+
+	bullet->component<Transform>()->matrix()->appendTranslation(10.f);
+	bullet->name("moved");
+	pool->release(bullet);
+
+	ASSERT_EQ(bullet->parent(), nullptr);
+	ASSERT_EQ(pool->numFreeNodes(), 2u);
+	ASSERT_EQ(pool->numAcquiredNodes(), 0u);
+
+	auto recycled = pool->acquire();
+
+	ASSERT_EQ(recycled, bullet);
+	ASSERT_EQ(recycled->name(), "bullet");
+	ASSERT_TRUE(recycled->component<Transform>()->matrix()->equals(math::Matrix4x4::create()));
+}
+
+TEST_F(NodePoolTest, AcquireEmpty)
+{
+	auto pool = NodePool::create(Prefab::create(Node::create("pickup")));
+	auto pickup = pool->acquire();
+
+	ASSERT_NE(pickup, nullptr);
+	ASSERT_EQ(pickup->name(), "pickup");
+	ASSERT_EQ(pool->numFreeNodes(), 0u);
+}
+
+TEST_F(NodePoolTest, ReleaseUnknownNode)
+{
+	auto pool = NodePool::create(Prefab::create(Node::create()));
+
+	ASSERT_THROW(pool->release(Node::create()), std::invalid_argument);
+}
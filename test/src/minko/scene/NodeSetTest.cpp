@@ -101,3 +101,35 @@ TEST_F(NodeSetTest, DescendantsBreadthFirst5)
 		scene = scene->children()[0];
 	}
 }
+
+TEST_F(NodeSetTest, VisitDescendantsOrder)
+{
+	auto scene = Node::create()
+		->addChild(Node::create()
+			->addChild(Node::create())
+			->addChild(Node::create()))
+		->addChild(Node::create()
+			->addChild(Node::create()));
+
+	for (auto depthFirst : { true, false })
+	{
+		auto nodeSet = NodeSet::create(scene)->descendants(false, depthFirst);
+		std::vector<Node::Ptr> visited;
+
+		NodeSet::visitDescendants(
+			scene,
+			[&](const Node::Ptr& descendant)
+			{
+				visited.push_back(descendant);
+			},
+			false,
+			depthFirst
+		);
+
+		ASSERT_EQ(visited.size(), 5);
+		ASSERT_EQ(visited, nodeSet->nodes());
+	}
+
+	ASSERT_EQ(NodeSet::create(scene)->descendants(false, false)->nodes()[2], scene->children()[0]->children()[0]);
+	ASSERT_EQ(NodeSet::create(scene)->descendants(false, true)->nodes()[1], scene->children()[0]->children()[0]);
+}
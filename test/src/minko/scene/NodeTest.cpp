@@ -0,0 +1,76 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/scene/NodeTest.hpp"
+
+using namespace minko;
+using namespace minko::scene;
+
+namespace
+{
+	class BaseComponent :
+		public component::AbstractComponent
+	{
+	public:
+		static
+		std::shared_ptr<BaseComponent>
+		create()
+		{
+			return std::shared_ptr<BaseComponent>(new BaseComponent());
+		}
+	};
+
+	class DerivedComponent :
+		public BaseComponent
+	{
+	public:
+		static
+		std::shared_ptr<DerivedComponent>
+		create()
+		{
+			return std::shared_ptr<DerivedComponent>(new DerivedComponent());
+		}
+	};
+}
+
+TEST_F(NodeTest, ComponentLookupAfterAddRemove)
+{
+	auto node = Node::create();
+	auto base = BaseComponent::create();
+	auto derived = DerivedComponent::create();
+
+	ASSERT_FALSE(node->hasComponent<BaseComponent>());
+
+	node->addComponent(derived);
+
+	ASSERT_EQ(node->component<BaseComponent>(), derived);
+	ASSERT_EQ(node->component<DerivedComponent>(), derived);
+
+	node->addComponent(base);
+
+	ASSERT_EQ(node->components<BaseComponent>().size(), 2);
+	ASSERT_EQ(node->component<BaseComponent>(1), base);
+	ASSERT_EQ(node->components<DerivedComponent>().size(), 1);
+	ASSERT_EQ(node->component<DerivedComponent>(1), nullptr);
+
+	node->removeComponent(derived);
+
+	ASSERT_EQ(node->component<BaseComponent>(), base);
+	ASSERT_FALSE(node->hasComponent<DerivedComponent>());
+}
@@ -0,0 +1,102 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "PrefabTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::scene;
+
+namespace
+{
+	Node::Ptr
+	createSource()
+	{
+		std::vector<render::Pass::Ptr> passes;
+		auto cube = geometry::CubeGeometry::create(MinkoTests::context());
+		auto source = Node::create("enemy")
+			->addComponent(Transform::create(math::Matrix4x4::create()->appendTranslation(1.f, 2.f, 3.f)))
+			->addChild(Node::create("body")
+				->addComponent(Surface::create(cube, material::Material::create(), render::Effect::create(passes)))
+			);
+
+		source->layouts(4);
+
+		return source;
+	}
+}
+
+TEST_F(PrefabTest, Instantiate)
+{
+	auto source = createSource();
+	auto prefab = Prefab::create(source);
+	auto instance = prefab->instantiate();
+
+	ASSERT_EQ(prefab->numNodes(), 2u);
+	ASSERT_NE(instance, source);
+	ASSERT_EQ(instance->name(), "enemy");
+	ASSERT_EQ(instance->layouts(), 4u);
+	ASSERT_EQ(instance->children().size(), 1u);
+	ASSERT_TRUE(instance->component<Transform>()->matrix()->equals(source->component<Transform>()->matrix()));
+	ASSERT_NE(instance->component<Transform>(), source->component<Transform>());
+
+	auto surface = instance->children()[0]->component<Surface>();
+	auto sourceSurface = source->children()[0]->component<Surface>();
+
+	ASSERT_NE(surface, sourceSurface);
+	ASSERT_EQ(surface->geometry(), sourceSurface->geometry());
+	ASSERT_EQ(surface->material(), sourceSurface->material());
+	ASSERT_EQ(surface->effect(), sourceSurface->effect());
+}
+
+TEST_F(PrefabTest, InstantiateMany)
+{
+	auto prefab = Prefab::create(createSource());
+	auto root = Node::create()->addComponent(Transform::create());
+	auto instances = prefab->instantiate(100, root);
+
+	ASSERT_EQ(instances->parent(), root);
+	ASSERT_EQ(instances->children().size(), 100u);
+	auto surfaces = NodeSet::create(root)->descendants(false)->where([](Node::Ptr node)
+	{
+		return node->hasComponent<Surface>();
+	});
+	auto rootTransforms = NodeSet::create(root)->descendants(true)->where([](Node::Ptr node)
+	{
+		return node->hasComponent<Transform::RootTransform>();
+	});
+
+	ASSERT_EQ(surfaces->nodes().size(), 100u);
+	ASSERT_EQ(rootTransforms->nodes().size(), 1u);
+}
+
+TEST_F(PrefabTest, Cloner)
+{
+	auto source = createSource();
+	auto prefab = Prefab::create(source);
+
+	prefab->cloner<Transform>([](Transform::Ptr transform)
+	{
+		return Transform::create();
+	});
+
+	ASSERT_TRUE(prefab->instantiate()->component<Transform>()->matrix()->equals(math::Matrix4x4::create()));
+}
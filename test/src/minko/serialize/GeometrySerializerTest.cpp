@@ -88,4 +88,47 @@ TEST_F(GeometrySerializerTest, SphereGeometrySerialization)
 
 	ASSERT_TRUE(outputAssetLibrary->geometry("Sphere") != nullptr);
 	ASSERT_TRUE(sphereGeometry->equals(outputAssetLibrary->geometry("Sphere")));
-}
\ No newline at end of file
+}
+
+TEST_F(GeometrySerializerTest, CompressedSphereGeometrySerialization)
+{
+	auto sphereGeometry		= geometry::SphereGeometry::create(MinkoTests::context(), 20, 20);
+	auto assetLibrary		= file::AssetLibrary::create(MinkoTests::context());
+	auto geometryWriter		= file::GeometryWriter::create();
+	auto outputAssetLibrary = file::AssetLibrary::create(MinkoTests::context());
+	auto geometryParser		= file::GeometryParser::create();
+	std::string	filename	= "asset.tmp";
+
+	assetLibrary->geometry("Sphere", sphereGeometry);
+	geometryWriter->data(sphereGeometry);
+	geometryWriter->write(filename, assetLibrary, file::Options::create(MinkoTests::context())->compressGeometries(true));
+
+	std::vector<unsigned char>  data;
+	auto						flags = std::ios::in | std::ios::ate | std::ios::binary;
+	std::fstream				file(filename, flags);
+	unsigned int				size = (unsigned int)file.tellg();
+
+	data.resize(size);
+	file.seekg(0, std::ios::beg);
+	file.read((char*)&data[0], size);
+	file.close();
+
+	geometryParser->parse(filename, filename, file::Options::create(MinkoTests::context()), data, outputAssetLibrary);
+
+	auto outputGeometry = outputAssetLibrary->geometry("Sphere");
+
+	ASSERT_TRUE(outputGeometry != nullptr);
+	ASSERT_EQ(sphereGeometry->indices()->data(), outputGeometry->indices()->data());
+
+	auto vertexBuffer		= sphereGeometry->vertexBuffer("position");
+	auto outputVertexBuffer = outputGeometry->vertexBuffer("position");
+
+	ASSERT_TRUE(outputVertexBuffer != nullptr);
+	ASSERT_EQ(vertexBuffer->data().size(), outputVertexBuffer->data().size());
+	ASSERT_TRUE(outputVertexBuffer->hasAttribute("uv"));
+	ASSERT_TRUE(outputVertexBuffer->hasAttribute("normal"));
+
+	// positions and uvs are quantized on 16 bits, normals are octahedral
+	for (uint i = 0; i < vertexBuffer->data().size(); ++i)
+		ASSERT_NEAR(vertexBuffer->data()[i], outputVertexBuffer->data()[i], 1e-3f);
+}
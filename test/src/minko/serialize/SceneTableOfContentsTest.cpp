@@ -0,0 +1,80 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/serialize/SceneTableOfContentsTest.hpp"
+#include "minko/file/SceneTableOfContents.hpp"
+
+using namespace minko;
+using namespace minko::math;
+using namespace minko::file;
+
+TEST_F(SceneTableOfContentsTest, SerializeDeserialize)
+{
+	auto toc = SceneTableOfContents::create();
+
+	toc->addCell("cell0.scene", Box::create(Vector3::create(10.f, 1.f, 10.f), Vector3::create(0.f, 0.f, 0.f)));
+	toc->addCell("cell1.scene", Box::create(Vector3::create(20.f, 5.f, 10.f), Vector3::create(10.f, -2.f, 0.f)));
+
+	auto serialized = toc->serialize();
+	auto result = SceneTableOfContents::create(std::vector<unsigned char>(serialized.begin(), serialized.end()));
+
+	ASSERT_EQ(result->numCells(), 2);
+	ASSERT_EQ(result->cellFilename(0), "cell0.scene");
+	ASSERT_EQ(result->cellFilename(1), "cell1.scene");
+	ASSERT_TRUE(result->cellBox(1)->topRight()->equals(Vector3::create(20.f, 5.f, 10.f)));
+	ASSERT_TRUE(result->cellBox(1)->bottomLeft()->equals(Vector3::create(10.f, -2.f, 0.f)));
+}
+
+TEST_F(SceneTableOfContentsTest, CellsWithin)
+{
+	auto toc = SceneTableOfContents::create();
+
+	for (auto x = 0; x < 10; ++x)
+		toc->addCell(
+			"cell" + std::to_string(x) + ".scene",
+			Box::create(Vector3::create(x * 10.f + 10.f, 1.f, 10.f), Vector3::create(x * 10.f, 0.f, 0.f))
+		);
+
+	std::vector<uint> cells;
+
+	toc->cellsWithin(Vector3::create(5.f, 0.f, 5.f), 1.f, cells);
+	ASSERT_EQ(cells, std::vector<uint>({ 0 }));
+
+	toc->cellsWithin(Vector3::create(25.f, 0.f, 5.f), 12.f, cells);
+	ASSERT_EQ(cells, std::vector<uint>({ 1, 2, 3 }));
+
+	toc->cellsWithin(Vector3::create(500.f, 0.f, 500.f), 10.f, cells);
+	ASSERT_TRUE(cells.empty());
+}
+
+TEST_F(SceneTableOfContentsTest, CellsWithinLargeCell)
+{
+	auto toc = SceneTableOfContents::create();
+
+	toc->addCell("small.scene", Box::create(Vector3::create(1.f, 1.f, 1.f), Vector3::create(0.f, 0.f, 0.f)));
+	toc->addCell("large.scene", Box::create(Vector3::create(100.f, 1.f, 100.f), Vector3::create(-100.f, 0.f, -100.f)));
+
+	std::vector<uint> cells;
+
+	toc->cellsWithin(Vector3::create(90.f, 0.f, -90.f), 5.f, cells);
+	ASSERT_EQ(cells, std::vector<uint>({ 1 }));
+
+	toc->cellsWithin(Vector3::create(0.5f, 0.f, 0.5f), 0.f, cells);
+	ASSERT_EQ(cells, std::vector<uint>({ 0, 1 }));
+}
@@ -0,0 +1,20 @@
+if minko.platform.supports("linux") then
+
+minko.project.application "minko-conditioner"
+
+	removeplatforms { "android", "ios", "win", "osx", "html5" }
+
+	files {
+		"src/**.hpp",
+		"src/**.cpp"
+	}
+	includedirs { "src" }
+
+	-- plugins
+	minko.plugin.enable("offscreen")
+	minko.plugin.enable("assimp")
+	minko.plugin.enable("jpeg")
+	minko.plugin.enable("png")
+	minko.plugin.enable("serializer")
+
+end
@@ -0,0 +1,200 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/Minko.hpp"
+#include "minko/MinkoOffscreen.hpp"
+#include "minko/MinkoASSIMP.hpp"
+#include "minko/MinkoJPEG.hpp"
+#include "minko/MinkoPNG.hpp"
+#include "minko/MinkoSerializer.hpp"
+
+using namespace minko;
+using namespace minko::component;
+
+// imports a 3D file with ASSIMP once, offline, and writes it as a .scene file that ships without ASSIMP
+struct Settings
+{
+	std::string	input;
+	std::string	output;
+	std::string	effect;
+	float		weldEpsilon;
+	uint		vertexCacheSize; // 0 keeps the triangles order
+	bool		quantize;
+	bool		staticBatching;
+	float		animationTolerance;
+};
+
+static
+void
+printUsage()
+{
+	std::cerr << "usage: minko-conditioner <input> <output.scene> [options]" << std::endl
+		<< "  --effect=<file>            effect of the imported surfaces (effect/Basic.effect)" << std::endl
+		<< "  --weld=<epsilon>           weld the vertices closer than epsilon (0)" << std::endl
+		<< "  --vertex-cache=<size>      reorder the triangles for a vertex cache of that size, 0 to disable (32)" << std::endl
+		<< "  --quantize                 quantize and delta encode the vertex and index streams" << std::endl
+		<< "  --static-batching          merge the surfaces sharing a material into baked geometries" << std::endl
+		<< "  --animation-tolerance=<t>  drop the skinning matrices closer than t to the interpolated ones (0)" << std::endl;
+}
+
+static
+void
+condition(scene::Node::Ptr symbol, const Settings& settings)
+{
+	if (!settings.staticBatching)
+		return;
+
+	auto transforms = scene::NodeSet::create(symbol)
+		->descendants(true)
+		->where([](scene::Node::Ptr node) { return node->hasComponent<Transform>(); });
+
+	// the imported scene is not animated by the engine once conditioned, skinned surfaces are never batched
+	for (auto& node : transforms->nodes())
+		node->component<Transform>()->isStatic(true);
+
+	// the batches are built when the batcher is added and stay in the scene once it is removed
+	auto batcher = StaticBatcher::create();
+
+	symbol->addComponent(batcher);
+	std::cout << "static batching: " << batcher->batches().size() << " batches" << std::endl;
+	symbol->removeComponent(batcher);
+}
+
+int main(int argc, char** argv)
+{
+	Settings settings;
+
+	settings.effect = "effect/Basic.effect";
+	settings.weldEpsilon = 0.f;
+	settings.vertexCacheSize = 32;
+	settings.quantize = false;
+	settings.staticBatching = false;
+	settings.animationTolerance = 0.f;
+
+	std::vector<std::string> filenames;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string	arg		= argv[i];
+		const auto			equal	= arg.find('=');
+		const auto			key		= arg.substr(0, equal);
+		const auto			value	= equal == std::string::npos ? std::string() : arg.substr(equal + 1);
+
+		if (arg.compare(0, 2, "--") != 0)
+			filenames.push_back(arg);
+		else if (key == "--effect")
+			settings.effect = value;
+		else if (key == "--weld")
+			settings.weldEpsilon = (float)std::atof(value.c_str());
+		else if (key == "--vertex-cache")
+			settings.vertexCacheSize = std::atoi(value.c_str());
+		else if (key == "--quantize")
+			settings.quantize = true;
+		else if (key == "--static-batching")
+			settings.staticBatching = true;
+		else if (key == "--animation-tolerance")
+			settings.animationTolerance = (float)std::atof(value.c_str());
+		else
+		{
+			std::cerr << "unknown option: " << arg << std::endl;
+			printUsage();
+
+			return 1;
+		}
+	}
+
+	if (filenames.size() != 2)
+	{
+		printUsage();
+
+		return 1;
+	}
+
+	settings.input = filenames[0];
+	settings.output = filenames[1];
+
+	MinkoOffscreen::initialize("Minko Conditioner", 1, 1);
+
+	auto context	= MinkoOffscreen::context();
+	auto assets		= file::AssetLibrary::create(context);
+
+	for (auto& extension : file::ASSIMPParser::getSupportedFileExensions())
+		assets->registerParser<file::ASSIMPParser>(extension);
+	assets
+		->registerParser<file::JPEGParser>("jpg")
+		->registerParser<file::PNGParser>("png");
+
+	assets->load(settings.effect);
+	if (!assets->effect(settings.effect))
+	{
+		std::cerr << "cannot load the effect " << settings.effect << std::endl;
+
+		return 1;
+	}
+
+	auto options = assets->defaultOptions();
+
+	// the geometries are welded before being reordered; their data is kept for the writer
+	options
+		->loadAsynchronously(false)
+		->optimizeGeometries(false)
+		->disposeGeometryData(false)
+		->shareMaterials(true)
+		->startAnimation(false)
+		->skinningCompressionTolerance(settings.animationTolerance)
+		->effect(assets->effect(settings.effect))
+		->geometryFunction([&](const std::string&, geometry::Geometry::Ptr geometry)
+		{
+			geometry->removeDuplicatedVertices(settings.weldEpsilon);
+			if (settings.vertexCacheSize != 0)
+				geometry->optimize(settings.vertexCacheSize);
+
+			return geometry;
+		});
+
+	auto loaded = false;
+	auto _ = assets->complete()->connect([&](file::AssetLibrary::Ptr)
+	{
+		loaded = true;
+	});
+
+	assets->queue(settings.input)->load();
+
+	auto symbol = assets->symbol(settings.input);
+
+	if (!loaded || !symbol)
+	{
+		std::cerr << "cannot import " << settings.input << std::endl;
+
+		return 1;
+	}
+
+	condition(symbol, settings);
+
+	// written with the options of the run time loader
+	auto writerOptions = file::Options::create(context)->compressGeometries(settings.quantize);
+	auto writer = file::SceneWriter::create();
+
+	writer->data(symbol);
+	writer->write(settings.output, assets, writerOptions);
+
+	std::cout << settings.input << " -> " << settings.output << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,25 @@
+if minko.platform.supports("linux") then
+
+minko.project.application "minko-mkstats"
+
+	removeplatforms { "android", "ios", "win", "osx", "html5" }
+
+	files {
+		"src/**.hpp",
+		"src/**.cpp"
+	}
+	includedirs {
+		"src",
+		-- the statistics are written with the jsoncpp embedded in the framework
+		minko.sdk.path("/framework/lib/jsoncpp/src"),
+		-- deflate is the one of lodepng
+		minko.plugin.path("png") .. "/lib/lodepng/src"
+	}
+	defines { "JSON_IS_AMALGAMATION" }
+
+	-- plugins
+	minko.plugin.enable("offscreen")
+	minko.plugin.enable("png")
+	minko.plugin.enable("serializer")
+
+end
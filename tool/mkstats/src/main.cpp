@@ -0,0 +1,274 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/Minko.hpp"
+#include "minko/MinkoOffscreen.hpp"
+#include "minko/MinkoPNG.hpp"
+#include "minko/MinkoSerializer.hpp"
+#include "minko/MkStats.hpp"
+
+#include "json/json.h"
+#include "lodepng.h"
+
+#include <dirent.h>
+
+using namespace minko;
+
+// measures the .scene files of a directory with each encoding of the serializer and writes the results as JSON
+struct Settings
+{
+	std::string	directory;
+	std::string	output;
+	std::string	effect;
+	uint		numRuns;
+};
+
+struct Encoding
+{
+	std::string			name;
+	file::Options::Ptr	options;
+};
+
+static
+void
+printUsage()
+{
+	std::cerr << "usage: minko-mkstats <directory> [options]" << std::endl
+		<< "  --runs=<n>         encode and decode each asset n times (10)" << std::endl
+		<< "  --effect=<file>    effect of the loaded surfaces (effect/Basic.effect)" << std::endl
+		<< "  --output=<file>    write the JSON to a file instead of the standard output" << std::endl;
+}
+
+static
+void
+listScenes(const std::string& directory, std::vector<std::string>& filenames)
+{
+	auto dir = opendir(directory.c_str());
+
+	if (!dir)
+		return;
+
+	while (auto entry = readdir(dir))
+	{
+		const std::string name = entry->d_name;
+
+		if (name == "." || name == "..")
+			continue;
+
+		const auto path = directory + "/" + name;
+
+		if (entry->d_type == DT_DIR)
+			listScenes(path, filenames);
+		else if (name.size() > 6 && name.compare(name.size() - 6, 6, ".scene") == 0)
+			filenames.push_back(path);
+	}
+
+	closedir(dir);
+	std::sort(filenames.begin(), filenames.end());
+}
+
+// what HTTP gzip would roughly make of the file
+static
+uint
+deflatedSize(const std::vector<unsigned char>& data)
+{
+	unsigned char*	out		= nullptr;
+	size_t			outSize	= 0;
+
+	if (data.empty() || lodepng_zlib_compress(&out, &outSize, &data[0], data.size(), &lodepng_default_compress_settings))
+		return 0;
+
+	free(out);
+
+	return outSize;
+}
+
+static
+Json::Value
+toJSON(const serializer::MkStats::EncodingStats& stats)
+{
+	Json::Value value;
+
+	value["asset"] = stats.asset;
+	value["encoding"] = stats.encoding;
+	value["size"] = stats.size;
+	value["deflatedSize"] = stats.compressedSize;
+	value["encodeTime"] = stats.encodeTime;
+	value["decodeTime"] = stats.decodeTime;
+	// MB per second of encoded data
+	value["encodeThroughput"] = stats.encodeTime > 0. ? stats.size / (stats.encodeTime * 1e3) : 0.;
+	value["decodeThroughput"] = stats.decodeTime > 0. ? stats.size / (stats.decodeTime * 1e3) : 0.;
+	if (stats.exact >= 0)
+		value["exact"] = stats.exact == 1;
+
+	for (auto& stream : stats.streams)
+		value["streams"][stream.first] = stream.second;
+
+	return value;
+}
+
+int main(int argc, char** argv)
+{
+	Settings settings;
+
+	settings.effect = "effect/Basic.effect";
+	settings.numRuns = 10;
+
+	std::vector<std::string> directories;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string	arg		= argv[i];
+		const auto			equal	= arg.find('=');
+		const auto			key		= arg.substr(0, equal);
+		const auto			value	= equal == std::string::npos ? std::string() : arg.substr(equal + 1);
+
+		if (arg.compare(0, 2, "--") != 0)
+			directories.push_back(arg);
+		else if (key == "--runs")
+			settings.numRuns = std::max(1, std::atoi(value.c_str()));
+		else if (key == "--effect")
+			settings.effect = value;
+		else if (key == "--output")
+			settings.output = value;
+		else
+		{
+			std::cerr << "unknown option: " << arg << std::endl;
+			printUsage();
+
+			return 1;
+		}
+	}
+
+	if (directories.size() != 1)
+	{
+		printUsage();
+
+		return 1;
+	}
+
+	settings.directory = directories[0];
+
+	std::vector<std::string> filenames;
+
+	listScenes(settings.directory, filenames);
+	if (filenames.empty())
+	{
+		std::cerr << "no .scene file in " << settings.directory << std::endl;
+
+		return 1;
+	}
+
+	MinkoOffscreen::initialize("Minko MkStats", 1, 1);
+
+	auto context	= MinkoOffscreen::context();
+	auto stats		= serializer::MkStats::create(deflatedSize);
+
+	// the settings a platform can choose from when conditioning its assets
+	std::vector<Encoding> encodings;
+
+	encodings.push_back({ "raw", file::Options::create(context) });
+	encodings.push_back({ "quantized", file::Options::create(context)->compressGeometries(true) });
+
+	Json::Value root;
+
+	root["numRuns"] = settings.numRuns;
+
+	for (auto& filename : filenames)
+	{
+		auto assets = file::AssetLibrary::create(context);
+
+		assets
+			->registerParser<file::PNGParser>("png")
+			->registerParser<file::SceneParser>("scene");
+
+		assets->load(settings.effect);
+		if (!assets->effect(settings.effect))
+		{
+			std::cerr << "cannot load the effect " << settings.effect << std::endl;
+
+			return 1;
+		}
+
+		assets->defaultOptions()
+			->loadAsynchronously(false)
+			->disposeGeometryData(false)
+			->effect(assets->effect(settings.effect));
+
+		auto loaded = false;
+		auto _ = assets->complete()->connect([&](file::AssetLibrary::Ptr)
+		{
+			loaded = true;
+		});
+
+		assets->queue(filename)->load();
+
+		auto symbol = assets->symbol(filename);
+
+		if (!loaded || !symbol)
+		{
+			std::cerr << "cannot load " << filename << std::endl;
+
+			continue;
+		}
+
+		Json::Value file;
+
+		file["file"] = filename;
+
+		for (auto& encoding : encodings)
+		{
+			auto sceneStats = stats->encodingStats<scene::Node::Ptr, file::SceneParser, file::SceneWriter>(
+				context, assets, filename, symbol, encoding.name, encoding.options, settings.numRuns
+			);
+
+			file["scene"].append(toJSON(sceneStats));
+			root["totals"][encoding.name]["size"] = root["totals"][encoding.name]["size"].asUInt() + sceneStats.size;
+			root["totals"][encoding.name]["deflatedSize"] =
+				root["totals"][encoding.name]["deflatedSize"].asUInt() + sceneStats.compressedSize;
+
+			for (auto& geometry : assets->geometries())
+				file["geometries"].append(toJSON(
+					stats->encodingStats<geometry::Geometry::Ptr, file::GeometryParser, file::GeometryWriter>(
+						context, assets, geometry.first, geometry.second, encoding.name, encoding.options, settings.numRuns
+					)
+				));
+		}
+
+		// the encodings only differ for the geometries
+		for (auto& material : assets->materials())
+			file["materials"].append(toJSON(
+				stats->encodingStats<data::Provider::Ptr, file::MaterialParser, file::MaterialWriter>(
+					context, assets, material.first, material.second, "raw", encodings[0].options, settings.numRuns
+				)
+			));
+
+		root["files"].append(file);
+		std::cerr << filename << std::endl;
+	}
+
+	const auto json = Json::StyledWriter().write(root);
+
+	if (settings.output.empty())
+		std::cout << json;
+	else
+		std::ofstream(settings.output) << json;
+
+	return 0;
+}